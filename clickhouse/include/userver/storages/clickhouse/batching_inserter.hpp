@@ -0,0 +1,194 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/batching_inserter.hpp
+/// @brief @copybrief storages::clickhouse::BatchingInserter
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <boost/pfr/core.hpp>
+
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+#include <userver/storages/clickhouse/cluster.hpp>
+#include <userver/storages/clickhouse/io/impl/validate.hpp>
+#include <userver/storages/clickhouse/options.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+/// What BatchingInserter::Add does when too many rows are pending
+enum class OverflowPolicy {
+  /// Drop the added rows right away
+  kDrop,
+  /// Wait for the space up to `overflow_timeout`, then drop the added rows
+  kWait,
+};
+
+/// @brief Settings of storages::clickhouse::BatchingInserter
+struct BatchingInserterSettings final {
+  /// Flush once this many rows are buffered
+  std::size_t max_rows{100'000};
+
+  /// Flush the buffered rows this long after the first of them was added
+  std::chrono::milliseconds max_delay{1000};
+
+  /// Limit on the rows that are buffered or being inserted
+  std::size_t max_pending_rows{1'000'000};
+
+  OverflowPolicy overflow_policy{OverflowPolicy::kDrop};
+
+  /// How long `Add` waits for the space with OverflowPolicy::kWait
+  std::chrono::milliseconds overflow_timeout{100};
+
+  /// Attempts to insert a flushed block before it is dropped
+  std::size_t insert_attempts{3};
+
+  /// Delay between the attempts to insert a flushed block
+  std::chrono::milliseconds retry_delay{100};
+
+  /// Command control of a single insert attempt
+  OptionalCommandControl command_control{};
+};
+
+BatchingInserterSettings Parse(const yaml_config::YamlConfig& value,
+                               formats::parse::To<BatchingInserterSettings>);
+
+namespace impl {
+
+class InsertBuffer {
+ public:
+  virtual ~InsertBuffer();
+
+  /// Moves the contents out into a new buffer, leaving this one empty
+  virtual std::unique_ptr<InsertBuffer> Extract() = 0;
+
+  virtual void Insert(const Cluster& cluster, OptionalCommandControl cc,
+                      const std::string& table_name,
+                      const std::vector<std::string_view>& column_names)
+      const = 0;
+};
+
+class BatchingInserterImpl final {
+ public:
+  BatchingInserterImpl(std::shared_ptr<Cluster> cluster,
+                       std::string table_name,
+                       std::vector<std::string> column_names,
+                       const BatchingInserterSettings& settings,
+                       std::unique_ptr<InsertBuffer> buffer);
+  ~BatchingInserterImpl();
+
+  bool Add(std::size_t rows,
+           const std::function<void(InsertBuffer&)>& append);
+
+  void WriteStatistics(
+      USERVER_NAMESPACE::utils::statistics::Writer& writer) const;
+
+ private:
+  struct State;
+  std::unique_ptr<State> state_;
+};
+
+}  // namespace impl
+
+/// @ingroup userver_clients
+///
+/// @brief Accumulates small batches of rows into large blocks and inserts
+/// them into a ClickHouse table in background.
+///
+/// `T` is expected to be a struct of vectors of same length, exactly as for
+/// Cluster::Insert. The added rows are appended to a columnar buffer that is
+/// flushed by a background task once it holds `max_rows` rows or `max_delay`
+/// after the first buffered row was added. The producers never wait for
+/// ClickHouse: failed blocks are retried by the background task, and the
+/// memory is bounded by `max_pending_rows` according to `overflow_policy`.
+///
+/// The buffered rows are flushed on destruction.
+template <typename T>
+class BatchingInserter final {
+ public:
+  /// @param cluster cluster to insert into
+  /// @param table_name table to insert into
+  /// @param column_names names of columns of the table
+  /// @param settings flush, overflow and retry settings
+  BatchingInserter(std::shared_ptr<Cluster> cluster, std::string table_name,
+                   std::vector<std::string> column_names,
+                   const BatchingInserterSettings& settings = {});
+
+  /// @brief Add rows to the buffer.
+  /// @returns false if the rows were dropped by the overflow policy
+  bool Add(const T& rows);
+
+  /// Write flush statistics
+  void WriteStatistics(
+      USERVER_NAMESPACE::utils::statistics::Writer& writer) const;
+
+ private:
+  class Buffer final : public impl::InsertBuffer {
+   public:
+    Buffer() = default;
+    explicit Buffer(T&& data) : data_{std::move(data)} {}
+
+    void Append(const T& rows) {
+      boost::pfr::for_each_field(data_, [&rows](auto& to, auto i) {
+        const auto& from = boost::pfr::get<decltype(i)::value>(rows);
+        to.insert(to.end(), from.begin(), from.end());
+      });
+    }
+
+    std::unique_ptr<impl::InsertBuffer> Extract() override {
+      return std::make_unique<Buffer>(std::exchange(data_, T{}));
+    }
+
+    void Insert(const Cluster& cluster, OptionalCommandControl cc,
+                const std::string& table_name,
+                const std::vector<std::string_view>& column_names)
+        const override {
+      cluster.Insert(cc, table_name, column_names, data_);
+    }
+
+   private:
+    T data_{};
+  };
+
+  impl::BatchingInserterImpl impl_;
+};
+
+template <typename T>
+BatchingInserter<T>::BatchingInserter(std::shared_ptr<Cluster> cluster,
+                                      std::string table_name,
+                                      std::vector<std::string> column_names,
+                                      const BatchingInserterSettings& settings)
+    : impl_{std::move(cluster), std::move(table_name), std::move(column_names),
+            settings, std::make_unique<Buffer>()} {
+  io::impl::ValidateColumnsMapping(T{});
+}
+
+template <typename T>
+bool BatchingInserter<T>::Add(const T& rows) {
+  io::impl::ValidateRowsCount(rows);
+  const auto rows_count = boost::pfr::get<0>(rows).size();
+  if (rows_count == 0) return true;
+
+  return impl_.Add(rows_count, [&rows](impl::InsertBuffer& buffer) {
+    static_cast<Buffer&>(buffer).Append(rows);
+  });
+}
+
+template <typename T>
+void BatchingInserter<T>::WriteStatistics(
+    USERVER_NAMESPACE::utils::statistics::Writer& writer) const {
+  impl_.WriteStatistics(writer);
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
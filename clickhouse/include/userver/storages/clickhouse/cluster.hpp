@@ -60,6 +60,32 @@ class Cluster final {
   ExecutionResult Execute(OptionalCommandControl, const Query& query,
                           const Args&... args) const;
 
+  /// @brief Execute a statement at some host of the cluster
+  /// with args as query parameters and pass the result to `consumer`
+  /// block by block, as the blocks arrive.
+  ///
+  /// Every block is converted to `T` (see ExecutionResult::As) and released
+  /// once `consumer` returns, so the memory usage is bounded by a single
+  /// block. The next block is not read until `consumer` returns.
+  /// `T` is expected to be a struct of vectors of same length.
+  template <typename T, typename Consumer, typename... Args>
+  void ExecuteByBlocks(const Query& query, Consumer&& consumer,
+                       const Args&... args) const;
+
+  /// @brief Execute a statement with specified command control settings
+  /// at some host of the cluster with args as query parameters and pass the
+  /// result to `consumer` block by block, as the blocks arrive.
+  ///
+  /// Every block is converted to `T` (see ExecutionResult::As) and released
+  /// once `consumer` returns, so the memory usage is bounded by a single
+  /// block. The next block is not read until `consumer` returns.
+  /// `T` is expected to be a struct of vectors of same length.
+  /// @note The command control timeout covers the whole statement, including
+  /// the time spent in `consumer`.
+  template <typename T, typename Consumer, typename... Args>
+  void ExecuteByBlocks(OptionalCommandControl, const Query& query,
+                       Consumer&& consumer, const Args&... args) const;
+
   /// @brief Insert data at some host of the cluster;
   /// `T` is expected to be a struct of vectors of same length.
   /// @param table_name table to insert into
@@ -116,6 +142,33 @@ class Cluster final {
                   const std::vector<std::string_view>& column_names,
                   const Container& data) const;
 
+  /// @brief Insert data at some host of the cluster;
+  /// `T` is expected to be a struct of io::ColumnSpan of same length.
+  /// @param table_name table to insert into
+  /// @param column_names names of columns of the table
+  /// @param data data to insert
+  /// @note Unlike `Insert`, this version needs no mapping and copies the
+  /// fixed-width values into the request with a single bulk copy per column,
+  /// while the strings are not copied at all. Prefer it for large batches.
+  template <typename T>
+  void InsertSpans(const std::string& table_name,
+                   const std::vector<std::string_view>& column_names,
+                   const T& data) const;
+
+  /// @brief Insert data with specified command control settings
+  /// at some host of the cluster;
+  /// `T` is expected to be a struct of io::ColumnSpan of same length.
+  /// @param table_name table to insert into
+  /// @param column_names names of columns of the table
+  /// @param data data to insert
+  /// @note Unlike `Insert`, this version needs no mapping and copies the
+  /// fixed-width values into the request with a single bulk copy per column,
+  /// while the strings are not copied at all. Prefer it for large batches.
+  template <typename T>
+  void InsertSpans(OptionalCommandControl, const std::string& table_name,
+                   const std::vector<std::string_view>& column_names,
+                   const T& data) const;
+
   /// Write cluster statistics
   void WriteStatistics(
       USERVER_NAMESPACE::utils::statistics::Writer& writer) const;
@@ -131,6 +184,9 @@ class Cluster final {
 
   ExecutionResult DoExecute(OptionalCommandControl, const Query& query) const;
 
+  void DoExecuteByBlocks(OptionalCommandControl, const Query& query,
+                         const impl::BlockConsumer& consumer) const;
+
   const impl::Pool& GetPool() const;
 
   std::vector<impl::Pool> pools_;
@@ -175,6 +231,24 @@ void Cluster::InsertRows(OptionalCommandControl optional_cc,
   DoInsert(optional_cc, request);
 }
 
+template <typename T>
+void Cluster::InsertSpans(const std::string& table_name,
+                          const std::vector<std::string_view>& column_names,
+                          const T& data) const {
+  InsertSpans(OptionalCommandControl{}, table_name, column_names, data);
+}
+
+template <typename T>
+void Cluster::InsertSpans(OptionalCommandControl optional_cc,
+                          const std::string& table_name,
+                          const std::vector<std::string_view>& column_names,
+                          const T& data) const {
+  const auto request =
+      impl::InsertionRequest::CreateFromSpans(table_name, column_names, data);
+
+  DoInsert(optional_cc, request);
+}
+
 template <typename... Args>
 ExecutionResult Cluster::Execute(const Query& query,
                                  const Args&... args) const {
@@ -189,6 +263,24 @@ ExecutionResult Cluster::Execute(OptionalCommandControl optional_cc,
   return DoExecute(optional_cc, formatted_query);
 }
 
+template <typename T, typename Consumer, typename... Args>
+void Cluster::ExecuteByBlocks(const Query& query, Consumer&& consumer,
+                              const Args&... args) const {
+  ExecuteByBlocks<T>(OptionalCommandControl{}, query,
+                     std::forward<Consumer>(consumer), args...);
+}
+
+template <typename T, typename Consumer, typename... Args>
+void Cluster::ExecuteByBlocks(OptionalCommandControl optional_cc,
+                              const Query& query, Consumer&& consumer,
+                              const Args&... args) const {
+  const auto formatted_query = query.WithArgs(args...);
+  DoExecuteByBlocks(optional_cc, formatted_query,
+                    [&consumer](ExecutionResult&& block) {
+                      consumer(std::move(block).As<T>());
+                    });
+}
+
 }  // namespace storages::clickhouse
 
 USERVER_NAMESPACE_END
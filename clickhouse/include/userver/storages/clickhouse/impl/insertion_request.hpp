@@ -1,13 +1,17 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 #include <userver/utils/assert.hpp>
+#include <userver/utils/meta.hpp>
 
 #include <userver/storages/clickhouse/impl/block_wrapper_fwd.hpp>
+#include <userver/storages/clickhouse/io/column_span.hpp>
 #include <userver/storages/clickhouse/io/impl/validate.hpp>
 
 #include <userver/storages/clickhouse/io/columns/column_wrapper.hpp>
@@ -35,17 +39,51 @@ class InsertionRequest final {
       const std::string& table_name,
       const std::vector<std::string_view>& column_names, const Container& data);
 
+  template <typename T>
+  static InsertionRequest CreateFromSpans(
+      const std::string& table_name,
+      const std::vector<std::string_view>& column_names, const T& data);
+
   const std::string& GetTableName() const;
 
   const impl::BlockWrapper& GetBlock() const;
 
+  /// Approximate size of the inserted values, before the compression
+  std::size_t GetPayloadBytes() const;
+
  private:
+  template <typename T>
+  static std::size_t GetValueBytes(const T& value) {
+    if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+      return std::string_view{value}.size();
+    } else if constexpr (meta::kIsOptional<T>) {
+      return 1 + (value.has_value() ? GetValueBytes(*value) : 0);
+    } else {
+      return sizeof(T);
+    }
+  }
+
+  template <typename Container>
+  static std::size_t GetPayloadBytes(const Container& values) {
+    using Value = typename Container::value_type;
+    if constexpr (std::is_arithmetic_v<Value>) {
+      return values.size() * sizeof(Value);
+    } else {
+      std::size_t result = 0;
+      for (const auto& value : values) result += GetValueBytes(value);
+      return result;
+    }
+  }
+
   template <typename MappedType>
   class ColumnsMapper final {
    public:
     ColumnsMapper(impl::BlockWrapper& block,
-                  const std::vector<std::string_view>& column_names)
-        : block_{block}, column_names_{column_names} {}
+                  const std::vector<std::string_view>& column_names,
+                  std::size_t& payload_bytes)
+        : block_{block},
+          column_names_{column_names},
+          payload_bytes_{payload_bytes} {}
 
     template <typename Field, size_t Index>
     void operator()(const Field& field,
@@ -55,11 +93,13 @@ class InsertionRequest final {
 
       io::columns::AppendWrappedColumn(block_, ColumnType::Serialize(field),
                                        column_names_[i], i);
+      payload_bytes_ += GetPayloadBytes(field);
     }
 
    private:
     impl::BlockWrapper& block_;
     const std::vector<std::string_view>& column_names_;
+    std::size_t& payload_bytes_;
   };
 
   template <typename MappedType, typename Container>
@@ -67,8 +107,11 @@ class InsertionRequest final {
    public:
     RowsMapper(impl::BlockWrapper& block,
                const std::vector<std::string_view>& column_names,
-               const Container& data)
-        : block_{block}, column_names_{column_names}, data_{data} {}
+               const Container& data, std::size_t& payload_bytes)
+        : block_{block},
+          column_names_{column_names},
+          data_{data},
+          payload_bytes_{payload_bytes} {}
 
     template <typename Field, size_t Index>
     void operator()(const Field&, std::integral_constant<size_t, Index> i) {
@@ -83,18 +126,44 @@ class InsertionRequest final {
 
       io::columns::AppendWrappedColumn(
           block_, ColumnType::Serialize(column_data), column_names_[i], i);
+      payload_bytes_ += GetPayloadBytes(column_data);
     }
 
    private:
     impl::BlockWrapper& block_;
     const std::vector<std::string_view>& column_names_;
     const Container& data_;
+    std::size_t& payload_bytes_;
+  };
+
+  class SpansMapper final {
+   public:
+    SpansMapper(impl::BlockWrapper& block,
+                const std::vector<std::string_view>& column_names,
+                std::size_t& payload_bytes)
+        : block_{block},
+          column_names_{column_names},
+          payload_bytes_{payload_bytes} {}
+
+    template <typename Field, size_t Index>
+    void operator()(const Field& field,
+                    std::integral_constant<size_t, Index> i) {
+      io::columns::AppendWrappedColumn(
+          block_, io::columns::SerializeSpan(field), column_names_[i], i);
+      payload_bytes_ += GetPayloadBytes(field);
+    }
+
+   private:
+    impl::BlockWrapper& block_;
+    const std::vector<std::string_view>& column_names_;
+    std::size_t& payload_bytes_;
   };
 
   const std::string& table_name_;
   const std::vector<std::string_view>& column_names_;
 
   std::unique_ptr<impl::BlockWrapper> block_;
+  std::size_t payload_bytes_{0};
 };
 
 template <typename T>
@@ -109,7 +178,7 @@ InsertionRequest InsertionRequest::Create(
   InsertionRequest request{table_name, column_names};
   using MappedType = typename io::CppToClickhouse<T>::mapped_type;
   auto mapper = InsertionRequest::ColumnsMapper<MappedType>{
-      *request.block_, request.column_names_};
+      *request.block_, request.column_names_, request.payload_bytes_};
 
   boost::pfr::for_each_field(data, mapper);
   return request;
@@ -129,12 +198,33 @@ InsertionRequest InsertionRequest::CreateFromRows(
   InsertionRequest request{table_name, column_names};
   using MappedType = typename io::CppToClickhouse<T>::mapped_type;
   auto mapper = InsertionRequest::RowsMapper<MappedType, Container>{
-      *request.block_, request.column_names_, data};
+      *request.block_, request.column_names_, data, request.payload_bytes_};
 
   boost::pfr::for_each_field(data.front(), mapper);
   return request;
 }
 
+template <typename T>
+InsertionRequest InsertionRequest::CreateFromSpans(
+    const std::string& table_name,
+    const std::vector<std::string_view>& column_names, const T& data) {
+  boost::pfr::for_each_field(data, [](const auto& field) {
+    static_assert(meta::kIsInstantiationOf<io::ColumnSpan,
+                                           std::decay_t<decltype(field)>>,
+                  "Every field should be an io::ColumnSpan");
+  });
+  io::impl::ValidateRowsCount(data);
+  UINVARIANT(boost::pfr::tuple_size_v<T> == column_names.size(),
+             "Columns count mismatch.");
+
+  InsertionRequest request{table_name, column_names};
+  auto mapper = InsertionRequest::SpansMapper{
+      *request.block_, request.column_names_, request.payload_bytes_};
+
+  boost::pfr::for_each_field(data, mapper);
+  return request;
+}
+
 }  // namespace storages::clickhouse::impl
 
 USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include <userver/storages/clickhouse/execution_result.hpp>
@@ -19,6 +20,8 @@ class PoolImpl;
 struct PoolSettings;
 class InsertionRequest;
 
+using BlockConsumer = std::function<void(ExecutionResult&&)>;
+
 class Pool final {
  public:
   Pool(clients::dns::Resolver&, PoolSettings&&);
@@ -29,6 +32,9 @@ class Pool final {
 
   ExecutionResult Execute(OptionalCommandControl, const Query& query) const;
 
+  void ExecuteByBlocks(OptionalCommandControl, const Query& query,
+                       const BlockConsumer& consumer) const;
+
   void Insert(OptionalCommandControl, const InsertionRequest& request) const;
 
   void WriteStatistics(
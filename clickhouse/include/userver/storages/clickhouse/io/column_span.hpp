@@ -0,0 +1,66 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/io/column_span.hpp
+/// @brief @copybrief storages::clickhouse::io::ColumnSpan
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <userver/storages/clickhouse/io/columns/column_wrapper.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::io {
+
+/// @brief Non-owning view of contiguous column values for
+/// storages::clickhouse::Cluster::InsertSpans.
+///
+/// Supported value types are `std::uint8_t`, `std::uint16_t`,
+/// `std::uint32_t`, `std::uint64_t`, `std::int8_t`, `std::int32_t`,
+/// `std::int64_t`, `float`, `double` (mapped to the ClickHouse column of the
+/// same width) and `std::string_view` (mapped to String).
+template <typename T>
+class ColumnSpan final {
+ public:
+  using value_type = T;
+
+  ColumnSpan() = default;
+  ColumnSpan(const T* data, std::size_t size) : data_{data}, size_{size} {}
+  ColumnSpan(const std::vector<T>& data)
+      : data_{data.data()}, size_{data.size()} {}
+
+  const T* data() const noexcept { return data_; }
+  std::size_t size() const noexcept { return size_; }
+
+  const T* begin() const noexcept { return data_; }
+  const T* end() const noexcept { return data_ + size_; }
+
+ private:
+  const T* data_{nullptr};
+  std::size_t size_{0};
+};
+
+namespace columns {
+
+/// @cond
+// Fixed-width values are copied into the native column with a single bulk
+// copy, strings are referenced without copying.
+ColumnRef SerializeSpan(ColumnSpan<std::uint8_t> from);
+ColumnRef SerializeSpan(ColumnSpan<std::uint16_t> from);
+ColumnRef SerializeSpan(ColumnSpan<std::uint32_t> from);
+ColumnRef SerializeSpan(ColumnSpan<std::uint64_t> from);
+ColumnRef SerializeSpan(ColumnSpan<std::int8_t> from);
+ColumnRef SerializeSpan(ColumnSpan<std::int32_t> from);
+ColumnRef SerializeSpan(ColumnSpan<std::int64_t> from);
+ColumnRef SerializeSpan(ColumnSpan<float> from);
+ColumnRef SerializeSpan(ColumnSpan<double> from);
+ColumnRef SerializeSpan(ColumnSpan<std::string_view> from);
+/// @endcond
+
+}  // namespace columns
+
+}  // namespace storages::clickhouse::io
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,247 @@
+#include <userver/storages/clickhouse/batching_inserter.hpp>
+
+#include <optional>
+#include <stdexcept>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/percentile_format_json.hpp>
+
+#include <storages/clickhouse/stats/pool_statistics.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+namespace {
+
+struct BatchingInserterStatistics final {
+  stats::Counter rows_inserted{};
+  stats::Counter rows_dropped{};
+  stats::Counter flushes{};
+  stats::Counter insert_errors{};
+  stats::RecentPeriod flush_timings{};
+  stats::RecentPeriod flush_rows{};
+};
+
+}  // namespace
+
+BatchingInserterSettings Parse(const yaml_config::YamlConfig& value,
+                               formats::parse::To<BatchingInserterSettings>) {
+  BatchingInserterSettings settings;
+  settings.max_rows = value["max_rows"].As<std::size_t>(settings.max_rows);
+  settings.max_delay =
+      value["max_delay"].As<std::chrono::milliseconds>(settings.max_delay);
+  settings.max_pending_rows =
+      value["max_pending_rows"].As<std::size_t>(settings.max_pending_rows);
+
+  const auto policy = value["overflow_policy"].As<std::string>("drop");
+  if (policy == "drop") {
+    settings.overflow_policy = OverflowPolicy::kDrop;
+  } else if (policy == "wait") {
+    settings.overflow_policy = OverflowPolicy::kWait;
+  } else {
+    throw std::runtime_error("Unknown overflow_policy '" + policy +
+                             "', expected 'drop' or 'wait'");
+  }
+
+  settings.overflow_timeout = value["overflow_timeout"].As<
+      std::chrono::milliseconds>(settings.overflow_timeout);
+  settings.insert_attempts =
+      value["insert_attempts"].As<std::size_t>(settings.insert_attempts);
+  settings.retry_delay =
+      value["retry_delay"].As<std::chrono::milliseconds>(settings.retry_delay);
+
+  const auto timeout =
+      value["insert_timeout"].As<std::optional<std::chrono::milliseconds>>();
+  if (timeout) settings.command_control = CommandControl{*timeout};
+  return settings;
+}
+
+namespace impl {
+
+InsertBuffer::~InsertBuffer() = default;
+
+struct BatchingInserterImpl::State final {
+  State(std::shared_ptr<Cluster> cluster, std::string table_name,
+        std::vector<std::string> column_names,
+        const BatchingInserterSettings& settings,
+        std::unique_ptr<InsertBuffer> buffer)
+      : cluster{std::move(cluster)},
+        table_name{std::move(table_name)},
+        column_names{std::move(column_names)},
+        column_name_views{this->column_names.begin(),
+                          this->column_names.end()},
+        settings{settings},
+        buffer{std::move(buffer)} {
+    UINVARIANT(this->settings.insert_attempts > 0,
+               "insert_attempts should be positive");
+  }
+
+  void Run();
+  void Insert(const InsertBuffer& batch, std::size_t rows);
+
+  const std::shared_ptr<Cluster> cluster;
+  const std::string table_name;
+  const std::vector<std::string> column_names;
+  const std::vector<std::string_view> column_name_views;
+  const BatchingInserterSettings settings;
+
+  engine::Mutex mutex;
+  engine::ConditionVariable flush_cv;
+  engine::ConditionVariable space_cv;
+  std::unique_ptr<InsertBuffer> buffer;
+  std::size_t buffered_rows{0};
+  // buffered rows and the rows being inserted
+  std::size_t pending_rows{0};
+  std::chrono::steady_clock::time_point first_buffered;
+  bool stopping{false};
+
+  BatchingInserterStatistics stats;
+
+  engine::TaskWithResult<void> flush_task;
+};
+
+void BatchingInserterImpl::State::Run() {
+  std::unique_lock lock{mutex};
+  while (!engine::current_task::ShouldCancel()) {
+    if (buffered_rows == 0) {
+      if (stopping) break;
+      [[maybe_unused]] const bool ok =
+          flush_cv.Wait(lock, [this] { return buffered_rows > 0 || stopping; });
+      continue;
+    }
+
+    // Lets the buffer fill up to max_rows or max_delay, whichever comes first
+    [[maybe_unused]] const bool ok =
+        flush_cv.WaitUntil(lock, first_buffered + settings.max_delay, [this] {
+          return buffered_rows >= settings.max_rows || stopping;
+        });
+
+    auto batch = buffer->Extract();
+    const auto rows = std::exchange(buffered_rows, 0);
+
+    lock.unlock();
+    Insert(*batch, rows);
+    batch.reset();
+    lock.lock();
+
+    pending_rows -= rows;
+    space_cv.NotifyAll();
+  }
+}
+
+void BatchingInserterImpl::State::Insert(const InsertBuffer& batch,
+                                         std::size_t rows) {
+  tracing::Span span{"clickhouse_batching_insert"};
+  span.AddTag("table", table_name);
+  span.AddTag("rows", rows);
+
+  ++stats.flushes;
+  stats.flush_rows.GetCurrentCounter().Account(rows);
+
+  for (std::size_t attempt = 1;; ++attempt) {
+    const auto start = std::chrono::steady_clock::now();
+    try {
+      batch.Insert(*cluster, settings.command_control, table_name,
+                   column_name_views);
+      stats.flush_timings.GetCurrentCounter().Account(
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::steady_clock::now() - start)
+              .count());
+      stats.rows_inserted += rows;
+      return;
+    } catch (const std::exception& e) {
+      ++stats.insert_errors;
+      if (attempt >= settings.insert_attempts ||
+          engine::current_task::ShouldCancel()) {
+        LOG_ERROR() << "Dropping " << rows << " rows for '" << table_name
+                    << "' after " << attempt << " failed attempts: " << e;
+        stats.rows_dropped += rows;
+        return;
+      }
+      LOG_WARNING() << "Failed to insert " << rows << " rows into '"
+                    << table_name << "', retrying: " << e;
+    }
+    engine::InterruptibleSleepFor(settings.retry_delay);
+  }
+}
+
+BatchingInserterImpl::BatchingInserterImpl(
+    std::shared_ptr<Cluster> cluster, std::string table_name,
+    std::vector<std::string> column_names,
+    const BatchingInserterSettings& settings,
+    std::unique_ptr<InsertBuffer> buffer)
+    : state_{std::make_unique<State>(std::move(cluster), std::move(table_name),
+                                     std::move(column_names), settings,
+                                     std::move(buffer))} {
+  state_->flush_task =
+      engine::CriticalAsyncNoSpan([state = state_.get()] { state->Run(); });
+}
+
+BatchingInserterImpl::~BatchingInserterImpl() {
+  {
+    std::lock_guard lock{state_->mutex};
+    state_->stopping = true;
+  }
+  state_->flush_cv.NotifyAll();
+  // Lets the remaining rows get flushed
+  engine::TaskCancellationBlocker blocker;
+  state_->flush_task.Wait();
+}
+
+bool BatchingInserterImpl::Add(
+    std::size_t rows, const std::function<void(InsertBuffer&)>& append) {
+  auto& state = *state_;
+  std::unique_lock lock{state.mutex};
+
+  const auto fits = [&state, rows] {
+    return state.pending_rows + rows <= state.settings.max_pending_rows;
+  };
+  if (!fits()) {
+    const bool waited =
+        state.settings.overflow_policy == OverflowPolicy::kWait &&
+        state.space_cv.WaitFor(lock, state.settings.overflow_timeout, fits);
+    if (!waited) {
+      state.stats.rows_dropped += rows;
+      return false;
+    }
+  }
+
+  append(*state.buffer);
+  if (state.buffered_rows == 0) {
+    state.first_buffered = std::chrono::steady_clock::now();
+  }
+  state.buffered_rows += rows;
+  state.pending_rows += rows;
+
+  if (state.buffered_rows == rows ||
+      state.buffered_rows >= state.settings.max_rows) {
+    state.flush_cv.NotifyOne();
+  }
+  return true;
+}
+
+void BatchingInserterImpl::WriteStatistics(
+    USERVER_NAMESPACE::utils::statistics::Writer& writer) const {
+  const auto& stats = state_->stats;
+  writer["rows"]["inserted"] = stats.rows_inserted;
+  writer["rows"]["dropped"] = stats.rows_dropped;
+  writer["flushes"] = stats.flushes;
+  writer["insert-errors"] = stats.insert_errors;
+  writer["flush-timings"] = stats.flush_timings.GetStatsForPeriod();
+  writer["flush-rows"] = stats.flush_rows.GetStatsForPeriod();
+}
+
+}  // namespace impl
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
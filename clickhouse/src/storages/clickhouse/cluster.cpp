@@ -55,6 +55,12 @@ ExecutionResult Cluster::DoExecute(OptionalCommandControl optional_cc,
   return GetPool().Execute(optional_cc, query);
 }
 
+void Cluster::DoExecuteByBlocks(OptionalCommandControl optional_cc,
+                                const Query& query,
+                                const impl::BlockConsumer& consumer) const {
+  GetPool().ExecuteByBlocks(optional_cc, query, consumer);
+}
+
 void Cluster::DoInsert(OptionalCommandControl optional_cc,
                        const impl::InsertionRequest& request) const {
   GetPool().Insert(optional_cc, request);
@@ -76,9 +76,10 @@ class Connection::ConnectionBrokenGuard final {
 Connection::Connection(clients::dns::Resolver& resolver,
                        const EndpointSettings& endpoint,
                        const AuthSettings& auth,
-                       const ConnectionSettings& connection_settings)
+                       const ConnectionSettings& connection_settings,
+                       stats::PoolTransferStatistics& transfer)
     : client_{NativeClientFactory::Create(resolver, endpoint, auth,
-                                          connection_settings)} {}
+                                          connection_settings, transfer)} {}
 
 ExecutionResult Connection::Execute(OptionalCommandControl optional_cc,
                                     const Query& query) {
@@ -104,6 +105,31 @@ ExecutionResult Connection::Execute(OptionalCommandControl optional_cc,
   return ExecutionResult{BlockWrapperPtr{result_ptr.release()}};
 }
 
+void Connection::ExecuteByBlocks(OptionalCommandControl optional_cc,
+                                 const Query& query,
+                                 const BlockConsumer& consumer) {
+  clickhouse_cpp::Query native_query{query.QueryText()};
+  native_query.OnDataCancelable([]([[maybe_unused]] const auto& block) {
+    // we must return 'true' if we don't want to cancel query
+    return !engine::current_task::ShouldCancel();
+  });
+
+  auto& span = tracing::Span::CurrentSpan();
+  auto scope = span.CreateScopeTime(scopes::kExec);
+
+  // The next block is not read from the socket until the consumer is done
+  // with the current one, so a slow consumer throttles the server
+  native_query.OnData([&consumer, &scope](const NativeBlock& data) {
+    scope.Reset(scopes::kExec);
+    if (data.GetRowCount() == 0) return;
+
+    auto block_ptr = std::make_unique<BlockWrapper>(NativeBlock{data});
+    consumer(ExecutionResult{BlockWrapperPtr{block_ptr.release()}});
+  });
+
+  DoExecute(optional_cc, native_query);
+}
+
 void Connection::Insert(OptionalCommandControl optional_cc,
                         const InsertionRequest& request) {
   const auto& block = request.GetBlock();
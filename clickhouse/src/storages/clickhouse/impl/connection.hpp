@@ -4,6 +4,7 @@
 
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/storages/clickhouse/execution_result.hpp>
+#include <userver/storages/clickhouse/impl/pool.hpp>
 #include <userver/storages/clickhouse/options.hpp>
 
 #include <storages/clickhouse/impl/native_client_factory.hpp>
@@ -24,10 +25,14 @@ class InsertionRequest;
 class Connection final {
  public:
   Connection(clients::dns::Resolver&, const EndpointSettings&,
-             const AuthSettings&, const ConnectionSettings&);
+             const AuthSettings&, const ConnectionSettings&,
+             stats::PoolTransferStatistics&);
 
   ExecutionResult Execute(OptionalCommandControl, const Query&);
 
+  void ExecuteByBlocks(OptionalCommandControl, const Query&,
+                       const BlockConsumer&);
+
   void Insert(OptionalCommandControl, const InsertionRequest&);
 
   void Ping();
@@ -26,6 +26,8 @@ const std::string& InsertionRequest::GetTableName() const {
 
 const impl::BlockWrapper& InsertionRequest::GetBlock() const { return *block_; }
 
+std::size_t InsertionRequest::GetPayloadBytes() const { return payload_bytes_; }
+
 }  // namespace storages::clickhouse::impl
 
 USERVER_NAMESPACE_END
@@ -31,11 +31,14 @@ using CompressionMethod = ConnectionSettings::CompressionMethod;
 
 constexpr std::chrono::milliseconds kConnectTimeout{2000};
 
+using TransferStatistics = stats::PoolTransferStatistics;
+
 template <typename T>
 class ClickhouseSocketInput final : public clickhouse_cpp::InputStream {
  public:
-  ClickhouseSocketInput(T& socket, engine::Deadline& deadline)
-      : socket_{socket}, deadline_{deadline} {}
+  ClickhouseSocketInput(T& socket, engine::Deadline& deadline,
+                        stats::Counter& received_bytes)
+      : socket_{socket}, deadline_{deadline}, received_bytes_{received_bytes} {}
   ~ClickhouseSocketInput() override = default;
 
  protected:
@@ -48,19 +51,22 @@ class ClickhouseSocketInput final : public clickhouse_cpp::InputStream {
 
     if (!read) throw engine::io::IoException{"socket reset by peer"};
 
+    received_bytes_ += read;
     return read;
   }
 
  private:
   T& socket_;
   engine::Deadline& deadline_;
+  stats::Counter& received_bytes_;
 };
 
 template <typename T>
 class ClickhouseSocketOutput final : public clickhouse_cpp::OutputStream {
  public:
-  ClickhouseSocketOutput(T& socket, engine::Deadline& deadline)
-      : socket_{socket}, deadline_{deadline} {}
+  ClickhouseSocketOutput(T& socket, engine::Deadline& deadline,
+                         stats::Counter& sent_bytes)
+      : socket_{socket}, deadline_{deadline}, sent_bytes_{sent_bytes} {}
   ~ClickhouseSocketOutput() override = default;
 
  protected:
@@ -70,12 +76,14 @@ class ClickhouseSocketOutput final : public clickhouse_cpp::OutputStream {
     const auto sent = socket_.SendAll(data, len, deadline_);
     if (sent != len) throw engine::io::IoException{"broken pipe?"};
 
+    sent_bytes_ += sent;
     return sent;
   }
 
  private:
   T& socket_;
   engine::Deadline& deadline_;
+  stats::Counter& sent_bytes_;
 };
 
 Socket CreateSocket(engine::io::Sockaddr addr, engine::Deadline deadline) {
@@ -88,58 +96,69 @@ Socket CreateSocket(engine::io::Sockaddr addr, engine::Deadline deadline) {
 
 class ClickhouseSocketAdapter : public clickhouse_cpp::SocketBase {
  public:
-  ClickhouseSocketAdapter(engine::io::Sockaddr addr, engine::Deadline& deadline)
-      : deadline_{deadline}, socket_{CreateSocket(addr, deadline_)} {}
+  ClickhouseSocketAdapter(engine::io::Sockaddr addr, engine::Deadline& deadline,
+                          TransferStatistics& transfer)
+      : deadline_{deadline},
+        transfer_{transfer},
+        socket_{CreateSocket(addr, deadline_)} {}
 
   ~ClickhouseSocketAdapter() override { socket_.Close(); }
 
   std::unique_ptr<clickhouse_cpp::InputStream> makeInputStream()
       const override {
-    return std::make_unique<ClickhouseSocketInput<Socket>>(socket_, deadline_);
+    return std::make_unique<ClickhouseSocketInput<Socket>>(
+        socket_, deadline_, transfer_.received_bytes);
   }
 
   std::unique_ptr<clickhouse_cpp::OutputStream> makeOutputStream()
       const override {
-    return std::make_unique<ClickhouseSocketOutput<Socket>>(socket_, deadline_);
+    return std::make_unique<ClickhouseSocketOutput<Socket>>(
+        socket_, deadline_, transfer_.sent_bytes);
   }
 
  private:
   engine::Deadline& deadline_;
+  TransferStatistics& transfer_;
   mutable Socket socket_;
 };
 
 class ClickhouseTlsSocketAdapter : public clickhouse_cpp::SocketBase {
  public:
   ClickhouseTlsSocketAdapter(engine::io::Sockaddr addr,
-                             engine::Deadline& deadline)
+                             engine::Deadline& deadline,
+                             TransferStatistics& transfer)
       : deadline_{deadline},
+        transfer_{transfer},
         tls_socket_{engine::io::TlsWrapper::StartTlsClient(
             CreateSocket(addr, deadline_), {}, deadline_)} {}
 
   std::unique_ptr<clickhouse_cpp::InputStream> makeInputStream()
       const override {
-    return std::make_unique<ClickhouseSocketInput<TlsSocket>>(tls_socket_,
-                                                              deadline_);
+    return std::make_unique<ClickhouseSocketInput<TlsSocket>>(
+        tls_socket_, deadline_, transfer_.received_bytes);
   }
 
   std::unique_ptr<clickhouse_cpp::OutputStream> makeOutputStream()
       const override {
-    return std::make_unique<ClickhouseSocketOutput<TlsSocket>>(tls_socket_,
-                                                               deadline_);
+    return std::make_unique<ClickhouseSocketOutput<TlsSocket>>(
+        tls_socket_, deadline_, transfer_.sent_bytes);
   }
 
  private:
   engine::Deadline& deadline_;
+  TransferStatistics& transfer_;
   mutable TlsSocket tls_socket_;
 };
 
 class ClickhouseSocketFactory final : public clickhouse_cpp::SocketFactory {
  public:
   ClickhouseSocketFactory(clients::dns::Resolver& resolver, ConnectionMode mode,
-                          engine::Deadline& operations_deadline)
+                          engine::Deadline& operations_deadline,
+                          TransferStatistics& transfer)
       : resolver_{resolver},
         mode_{mode},
-        operations_deadline_{operations_deadline} {}
+        operations_deadline_{operations_deadline},
+        transfer_{transfer} {}
 
   ~ClickhouseSocketFactory() override = default;
 
@@ -154,10 +173,10 @@ class ClickhouseSocketFactory final : public clickhouse_cpp::SocketFactory {
         switch (mode_) {
           case ConnectionMode::kNonSecure:
             return std::make_unique<ClickhouseSocketAdapter>(
-                current_addr, operations_deadline_);
+                current_addr, operations_deadline_, transfer_);
           case ConnectionMode::kSecure:
             return std::make_unique<ClickhouseTlsSocketAdapter>(
-                current_addr, operations_deadline_);
+                current_addr, operations_deadline_, transfer_);
         }
       } catch (const std::exception&) {
       }
@@ -176,6 +195,7 @@ class ClickhouseSocketFactory final : public clickhouse_cpp::SocketFactory {
   ConnectionMode mode_;
 
   engine::Deadline& operations_deadline_;
+  TransferStatistics& transfer_;
 };
 
 clickhouse_cpp::CompressionMethod GetCompressionMethod(
@@ -192,11 +212,12 @@ clickhouse_cpp::CompressionMethod GetCompressionMethod(
 
 NativeClientWrapper::NativeClientWrapper(
     clients::dns::Resolver& resolver,
-    const clickhouse_cpp::ClientOptions& options, ConnectionMode mode) {
+    const clickhouse_cpp::ClientOptions& options, ConnectionMode mode,
+    stats::PoolTransferStatistics& transfer) {
   SetDeadline(engine::Deadline::FromDuration(kConnectTimeout));
 
   auto socket_factory = std::make_unique<ClickhouseSocketFactory>(
-      resolver, mode, operations_deadline_);
+      resolver, mode, operations_deadline_, transfer);
   native_client_ = std::make_unique<clickhouse_cpp::Client>(
       options, std::move(socket_factory));
 }
@@ -227,7 +248,8 @@ void NativeClientWrapper::SetDeadline(engine::Deadline deadline) {
 
 NativeClientWrapper NativeClientFactory::Create(
     clients::dns::Resolver& resolver, const EndpointSettings& endpoint,
-    const AuthSettings& auth, const ConnectionSettings& connection_settings) {
+    const AuthSettings& auth, const ConnectionSettings& connection_settings,
+    stats::PoolTransferStatistics& transfer) {
   const auto options = clickhouse_cpp::ClientOptions{}
                            .SetHost(endpoint.host)
                            .SetPort(endpoint.port)
@@ -239,7 +261,7 @@ NativeClientWrapper NativeClientFactory::Create(
 
   tracing::Span span{scopes::kConnect};
   return NativeClientWrapper{resolver, options,
-                             connection_settings.connection_mode};
+                             connection_settings.connection_mode, transfer};
 }
 
 }  // namespace storages::clickhouse::impl
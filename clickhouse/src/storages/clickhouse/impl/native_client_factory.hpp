@@ -8,6 +8,7 @@
 
 #include <storages/clickhouse/impl/settings.hpp>
 #include <storages/clickhouse/impl/wrap_clickhouse_cpp.hpp>
+#include <storages/clickhouse/stats/pool_statistics.hpp>
 
 namespace clickhouse {
 struct ClientOptions;
@@ -24,7 +25,8 @@ class NativeClientWrapper final {
  public:
   NativeClientWrapper(clients::dns::Resolver&,
                       const clickhouse_cpp::ClientOptions&,
-                      ConnectionSettings::ConnectionMode);
+                      ConnectionSettings::ConnectionMode,
+                      stats::PoolTransferStatistics&);
   ~NativeClientWrapper();
 
   void Execute(const clickhouse_cpp::Query& query, engine::Deadline deadline);
@@ -45,7 +47,8 @@ class NativeClientFactory final {
   static NativeClientWrapper Create(clients::dns::Resolver&,
                                     const EndpointSettings&,
                                     const AuthSettings&,
-                                    const ConnectionSettings&);
+                                    const ConnectionSettings&,
+                                    stats::PoolTransferStatistics&);
 };
 
 }  // namespace storages::clickhouse::impl
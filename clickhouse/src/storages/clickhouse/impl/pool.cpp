@@ -45,6 +45,18 @@ ExecutionResult Pool::Execute(OptionalCommandControl optional_cc,
   return conn_ptr->Execute(optional_cc, query);
 }
 
+void Pool::ExecuteByBlocks(OptionalCommandControl optional_cc,
+                           const Query& query,
+                           const BlockConsumer& consumer) const {
+  auto conn_ptr = impl_->Acquire();
+
+  auto span = PrepareExecutionSpan(impl::scopes::kQuery, impl_->GetHostName());
+  query.FillSpanTags(span);
+
+  const auto timer = impl_->GetExecuteTimer();
+  conn_ptr->ExecuteByBlocks(optional_cc, query, consumer);
+}
+
 void Pool::Insert(OptionalCommandControl optional_cc,
                   const InsertionRequest& request) const {
   auto conn_ptr = impl_->Acquire();
@@ -53,6 +65,8 @@ void Pool::Insert(OptionalCommandControl optional_cc,
 
   const auto timer = impl_->GetInsertTimer();
   conn_ptr->Insert(optional_cc, request);
+  impl_->GetStatistics().transfer.insert_payload_bytes +=
+      request.GetPayloadBytes();
 }
 
 void Pool::WriteStatistics(
@@ -124,7 +124,8 @@ Connection* PoolImpl::Create() {
   try {
     auto conn = std::make_unique<Connection>(
         resolver_, pool_settings_.endpoint_settings,
-        pool_settings_.auth_settings, pool_settings_.connection_settings);
+        pool_settings_.auth_settings, pool_settings_.connection_settings,
+        GetStatistics().transfer);
 
     auto& stats = GetStatistics().connections;
     ++stats.created;
@@ -0,0 +1,69 @@
+#include <userver/storages/clickhouse/io/column_span.hpp>
+
+#include <storages/clickhouse/impl/wrap_clickhouse_cpp.hpp>
+
+#include <clickhouse/columns/numeric.h>
+#include <clickhouse/columns/string.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::io::columns {
+
+namespace {
+
+template <typename T>
+ColumnRef SerializeNumericSpan(ColumnSpan<T> from) {
+  return std::make_shared<clickhouse::impl::clickhouse_cpp::ColumnVector<T>>(
+      std::vector<T>(from.begin(), from.end()));
+}
+
+}  // namespace
+
+ColumnRef SerializeSpan(ColumnSpan<std::uint8_t> from) {
+  return SerializeNumericSpan(from);
+}
+
+ColumnRef SerializeSpan(ColumnSpan<std::uint16_t> from) {
+  return SerializeNumericSpan(from);
+}
+
+ColumnRef SerializeSpan(ColumnSpan<std::uint32_t> from) {
+  return SerializeNumericSpan(from);
+}
+
+ColumnRef SerializeSpan(ColumnSpan<std::uint64_t> from) {
+  return SerializeNumericSpan(from);
+}
+
+ColumnRef SerializeSpan(ColumnSpan<std::int8_t> from) {
+  return SerializeNumericSpan(from);
+}
+
+ColumnRef SerializeSpan(ColumnSpan<std::int32_t> from) {
+  return SerializeNumericSpan(from);
+}
+
+ColumnRef SerializeSpan(ColumnSpan<std::int64_t> from) {
+  return SerializeNumericSpan(from);
+}
+
+ColumnRef SerializeSpan(ColumnSpan<float> from) {
+  return SerializeNumericSpan(from);
+}
+
+ColumnRef SerializeSpan(ColumnSpan<double> from) {
+  return SerializeNumericSpan(from);
+}
+
+ColumnRef SerializeSpan(ColumnSpan<std::string_view> from) {
+  auto column =
+      std::make_shared<clickhouse::impl::clickhouse_cpp::ColumnString>();
+  // The caller keeps the strings alive until the insertion is done, so the
+  // column only references them
+  for (const auto value : from) column->AppendNoManagedLifetime(value);
+  return column;
+}
+
+}  // namespace storages::clickhouse::io::columns
+
+USERVER_NAMESPACE_END
@@ -13,6 +13,7 @@ void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
   writer["connections"] = stats.connections;
   writer["queries"] = stats.queries;
   writer["inserts"] = stats.inserts;
+  writer["transfer"] = stats.transfer;
 }
 
 void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
@@ -31,6 +32,13 @@ void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
   writer["busy"] = stats.busy;
 }
 
+void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
+                const PoolTransferStatistics& stats) {
+  writer["sent-bytes"] = stats.sent_bytes;
+  writer["received-bytes"] = stats.received_bytes;
+  writer["insert-payload-bytes"] = stats.insert_payload_bytes;
+}
+
 }  // namespace storages::clickhouse::stats
 
 USERVER_NAMESPACE_END
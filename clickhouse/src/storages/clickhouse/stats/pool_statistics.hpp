@@ -30,10 +30,19 @@ struct PoolQueryStatistics final {
   RecentPeriod timings{};
 };
 
+struct PoolTransferStatistics final {
+  // bytes on the wire, after the compression
+  Counter sent_bytes{};
+  Counter received_bytes{};
+  // bytes of the inserted values, before the compression
+  Counter insert_payload_bytes{};
+};
+
 struct PoolStatistics final {
   PoolConnectionStatistics connections{};
   PoolQueryStatistics queries{};
   PoolQueryStatistics inserts{};
+  PoolTransferStatistics transfer{};
 };
 
 void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
@@ -45,6 +54,9 @@ void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
 void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
                 const PoolConnectionStatistics& stats);
 
+void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
+                const PoolTransferStatistics& stats);
+
 }  // namespace storages::clickhouse::stats
 
 USERVER_NAMESPACE_END
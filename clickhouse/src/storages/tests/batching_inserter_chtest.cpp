@@ -0,0 +1,102 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/engine/sleep.hpp>
+
+#include <userver/storages/clickhouse/batching_inserter.hpp>
+#include <userver/storages/clickhouse/cluster.hpp>
+
+#include "utils_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Data final {
+  std::vector<uint64_t> id;
+  std::vector<std::string> value;
+};
+
+}  // namespace
+
+namespace storages::clickhouse::io {
+
+template <>
+struct CppToClickhouse<Data> {
+  using mapped_type = std::tuple<columns::UInt64Column, columns::StringColumn>;
+};
+
+}  // namespace storages::clickhouse::io
+
+namespace {
+
+std::shared_ptr<storages::clickhouse::Cluster> MakeNonOwning(
+    storages::clickhouse::Cluster& cluster) {
+  return {std::shared_ptr<void>{}, &cluster};
+}
+
+}  // namespace
+
+UTEST(BatchingInserter, FlushesOnDestruction) {
+  ClusterWrapper cluster{};
+  cluster->Execute(
+      "CREATE TEMPORARY TABLE IF NOT EXISTS tmp_table (id UInt64, value "
+      "String)");
+
+  {
+    storages::clickhouse::BatchingInserterSettings settings;
+    settings.max_delay = std::chrono::hours{1};
+    storages::clickhouse::BatchingInserter<Data> inserter{
+        MakeNonOwning(*cluster), "tmp_table", {"id", "value"}, settings};
+
+    EXPECT_TRUE(inserter.Add({{1, 2}, {"first", "second"}}));
+    EXPECT_TRUE(inserter.Add({{3}, {"third"}}));
+  }
+
+  const auto result =
+      cluster->Execute("SELECT id, value FROM tmp_table ORDER BY id")
+          .As<Data>();
+  EXPECT_EQ(result.id, (std::vector<uint64_t>{1, 2, 3}));
+  EXPECT_EQ(result.value,
+            (std::vector<std::string>{"first", "second", "third"}));
+}
+
+UTEST(BatchingInserter, FlushesOnRowsCount) {
+  ClusterWrapper cluster{};
+  cluster->Execute(
+      "CREATE TEMPORARY TABLE IF NOT EXISTS tmp_table (id UInt64, value "
+      "String)");
+
+  storages::clickhouse::BatchingInserterSettings settings;
+  settings.max_rows = 2;
+  settings.max_delay = std::chrono::hours{1};
+  storages::clickhouse::BatchingInserter<Data> inserter{
+      MakeNonOwning(*cluster), "tmp_table", {"id", "value"}, settings};
+
+  EXPECT_TRUE(inserter.Add({{1, 2}, {"first", "second"}}));
+
+  for (std::size_t i = 0; i < 100; ++i) {
+    const auto result = cluster->Execute("SELECT id, value FROM tmp_table")
+                            .As<Data>();
+    if (result.id.size() == 2) return;
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+  ADD_FAILURE() << "The rows were not flushed";
+}
+
+UTEST(BatchingInserter, DropsOnOverflow) {
+  ClusterWrapper cluster{};
+  cluster->Execute(
+      "CREATE TEMPORARY TABLE IF NOT EXISTS tmp_table (id UInt64, value "
+      "String)");
+
+  storages::clickhouse::BatchingInserterSettings settings;
+  settings.max_delay = std::chrono::hours{1};
+  settings.max_pending_rows = 2;
+  storages::clickhouse::BatchingInserter<Data> inserter{
+      MakeNonOwning(*cluster), "tmp_table", {"id", "value"}, settings};
+
+  EXPECT_TRUE(inserter.Add({{1, 2}, {"first", "second"}}));
+  EXPECT_FALSE(inserter.Add({{3}, {"third"}}));
+}
+
+USERVER_NAMESPACE_END
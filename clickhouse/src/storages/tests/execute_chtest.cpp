@@ -121,4 +121,26 @@ UTEST(Execute, IterationMovesFromUnderlying) {
   }
 }
 
+UTEST(Execute, ByBlocksWorks) {
+  ClusterWrapper cluster{};
+
+  // Small blocks make the result arrive in many pieces
+  const storages::clickhouse::Query q{
+      "SELECT c.number, randomString(10), c.number as t, NOW64(9) "
+      "FROM numbers(0, 100000) c SETTINGS max_block_size = 1000"};
+
+  std::size_t blocks = 0;
+  std::size_t rows = 0;
+  uint64_t sum = 0;
+  cluster->ExecuteByBlocks<Data>(q, [&](Data&& block) {
+    ++blocks;
+    rows += block.numbers.size();
+    for (const auto number : block.numbers) sum += number;
+  });
+
+  EXPECT_GT(blocks, 1);
+  EXPECT_EQ(rows, 100000);
+  EXPECT_EQ(sum, 99999ull * 100000 / 2);
+}
+
 USERVER_NAMESPACE_END
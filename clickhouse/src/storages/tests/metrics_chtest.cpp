@@ -59,6 +59,20 @@ UTEST(Metrics, Basic) {
   EXPECT_EQ(insert_stats.SingleMetric("error").AsInt(), 1);
 }
 
+UTEST(Metrics, Transfer) {
+  ClusterWrapper cluster{true};
+
+  const DummyData data{std::vector<std::string>(1000, std::string(100, 'a'))};
+  cluster->Execute("CREATE TEMPORARY TABLE IF NOT EXISTS tmp(value String)");
+  cluster->Insert("tmp", {"value"}, data);
+
+  const auto stats = cluster.GetStatistics("clickhouse.transfer");
+  EXPECT_EQ(stats.SingleMetric("insert-payload-bytes").AsInt(), 100 * 1000);
+  EXPECT_GT(stats.SingleMetric("received-bytes").AsInt(), 0);
+  // The repetitive payload compresses well with lz4
+  EXPECT_LT(stats.SingleMetric("sent-bytes").AsInt(), 100 * 1000);
+}
+
 UTEST(Metrics, ActiveConnections) {
   PoolWrapper pool{};
 
@@ -16,6 +16,12 @@ struct SomeData final {
   std::vector<std::chrono::system_clock::time_point> vec_timepoint;
 };
 
+struct SomeDataWithoutTime final {
+  std::vector<uint64_t> vec_uint64;
+  std::vector<std::string> vec_str;
+  std::vector<uint64_t> vec_uint64_2;
+};
+
 struct SomeDataRow final {
   uint64_t uint64;
   std::string str;
@@ -50,6 +56,12 @@ struct CppToClickhouse<SomeData> {
                  columns::UInt64Column, columns::DateTime64ColumnNano>;
 };
 
+template <>
+struct CppToClickhouse<SomeDataWithoutTime> {
+  using mapped_type = std::tuple<columns::UInt64Column, columns::StringColumn,
+                                 columns::UInt64Column>;
+};
+
 template <>
 struct CppToClickhouse<SomeDataRow> {
   using mapped_type =
@@ -144,6 +156,34 @@ UTEST(Insert, AsRowsWorks) {
   EXPECT_EQ(result[1], data[1]);
 }
 
+UTEST(Insert, SpansWork) {
+  ClusterWrapper cluster{};
+  cluster->Execute(
+      "CREATE TEMPORARY TABLE IF NOT EXISTS tmp_table (id UInt64, value "
+      "String, count UInt64)");
+
+  const std::vector<uint64_t> ids{1, 3};
+  const std::string first{"first"};
+  const std::string second{"second"};
+  const std::string_view values[] = {first, second};
+  const uint64_t counts[] = {2, 4};
+
+  struct {
+    storages::clickhouse::io::ColumnSpan<uint64_t> ids;
+    storages::clickhouse::io::ColumnSpan<std::string_view> values;
+    storages::clickhouse::io::ColumnSpan<uint64_t> counts;
+  } data{ids, {values, 2}, {counts, 2}};
+  cluster->InsertSpans("tmp_table", {"id", "value", "count"}, data);
+
+  const auto result =
+      cluster->Execute("SELECT id, value, count FROM tmp_table ORDER BY id")
+          .As<SomeDataWithoutTime>();
+  ASSERT_EQ(result.vec_uint64.size(), 2);
+  EXPECT_EQ(result.vec_uint64, ids);
+  EXPECT_EQ(result.vec_str, (std::vector<std::string>{first, second}));
+  EXPECT_EQ(result.vec_uint64_2, (std::vector<uint64_t>{2, 4}));
+}
+
 UTEST(Query, AvoidUnexpectedCancellation) {
   ClusterWrapper cluster{};
   cluster->Execute(
@@ -25,4 +25,45 @@ function(add_google_benchmark_tests target)
         --benchmark_min_time=${BENCHMARK_MIN_TIME}
         --benchmark_color=no
     )
+    userver_add_benchmark_to_report(${target})
+endfunction()
+
+# Adds the benchmark executable to the userver-benchmarks-report target.
+# The optional LAUNCHER is a command that runs the executable, e.g. in
+# a testsuite environment with the databases.
+function(userver_add_benchmark_to_report target)
+    cmake_parse_arguments(ARG "" "" "LAUNCHER" ${ARGN})
+    set_property(GLOBAL APPEND PROPERTY USERVER_BENCHMARK_TARGETS ${target})
+    set_property(TARGET ${target} PROPERTY
+        USERVER_BENCHMARK_LAUNCHER ${ARG_LAUNCHER}
+    )
+endfunction()
+
+# Creates the userver-benchmarks-report target that runs all the registered
+# benchmarks and writes their JSON reports with allocs_per_iter counters to
+# ${CMAKE_BINARY_DIR}/benchmark-results. Compare two reports with
+# scripts/benchmarks/compare.py
+function(userver_add_benchmarks_report_target)
+    set(RESULTS_DIR ${CMAKE_BINARY_DIR}/benchmark-results)
+    get_property(targets GLOBAL PROPERTY USERVER_BENCHMARK_TARGETS)
+    set(commands COMMAND ${CMAKE_COMMAND} -E make_directory ${RESULTS_DIR})
+    foreach(target ${targets})
+        get_target_property(launcher ${target} USERVER_BENCHMARK_LAUNCHER)
+        if (NOT launcher)
+            set(launcher)
+        endif()
+        list(APPEND commands COMMAND ${CMAKE_COMMAND} -E env
+            USERVER_BENCHMARK_COUNT_ALLOCATIONS=1
+            ${launcher}
+            $<TARGET_FILE:${target}>
+            --benchmark_out=${RESULTS_DIR}/${target}.json
+            --benchmark_out_format=json
+            --benchmark_color=no
+        )
+    endforeach()
+
+    add_custom_target(userver-benchmarks-report ${commands} USES_TERMINAL)
+    if (targets)
+        add_dependencies(userver-benchmarks-report ${targets})
+    endif()
 endfunction()
@@ -0,0 +1,54 @@
+set(USERVER_OPENTELEMETRY_PROTOS "" CACHE PATH "Path to the folder with opentelemetry proto files")
+
+if (USERVER_OPENTELEMETRY_PROTOS)
+  set(opentelemetry-proto_SOURCE_DIR ${USERVER_OPENTELEMETRY_PROTOS})
+endif()
+
+if (NOT opentelemetry-proto_SOURCE_DIR)
+  include(FetchContent)
+  set(opentelemetry-proto_SOURCE_DIR ${USERVER_ROOT_DIR}/third_party/opentelemetry-proto)
+
+  FetchContent_Declare(
+    opentelemetry-proto_external_project
+    GIT_REPOSITORY https://github.com/open-telemetry/opentelemetry-proto.git
+    TIMEOUT 10
+    GIT_TAG v0.19.0
+    SOURCE_DIR ${opentelemetry-proto_SOURCE_DIR}
+  )
+
+  FetchContent_GetProperties(opentelemetry-proto_external_project)
+  if (NOT opentelemetry-proto_external_project_POPULATED AND
+      # POPULATED check glitches with multiple build directories
+      NOT EXISTS ${opentelemetry-proto_SOURCE_DIR})
+    message(STATUS "Downloading opentelemetry-proto from remote")
+    FetchContent_Populate(opentelemetry-proto_external_project)
+  endif()
+endif()
+
+if (NOT opentelemetry-proto_SOURCE_DIR)
+  message(FATAL_ERROR "Unable to get opentelemetry proto files. They are required for userver-grpc build.")
+endif()
+
+include(GrpcTargets)
+file(GLOB_RECURSE SOURCES
+  ${opentelemetry-proto_SOURCE_DIR}/opentelemetry/proto/*.proto)
+
+generate_grpc_files(
+  PROTOS
+    ${SOURCES}
+  INCLUDE_DIRECTORIES
+    ${opentelemetry-proto_SOURCE_DIR}
+  SOURCE_PATH
+    ${opentelemetry-proto_SOURCE_DIR}
+  GENERATED_INCLUDES include_paths
+  CPP_FILES generated_sources
+  CPP_USRV_FILES generated_usrv_sources
+)
+
+add_library(userver-opentelemetry-protos STATIC ${generated_sources})
+target_compile_options(userver-opentelemetry-protos PUBLIC -Wno-unused-parameter)
+target_include_directories(userver-opentelemetry-protos SYSTEM PUBLIC ${include_paths})
+target_link_libraries(userver-opentelemetry-protos PUBLIC userver-core userver-grpc-deps)
+
+set(opentelemetry-proto_LIBRARY userver-opentelemetry-protos)
+set(opentelemetry-proto_USRV_SOURCES ${generated_usrv_sources})
@@ -58,6 +58,7 @@ struct Config final {
   std::optional<bool> force_periodic_update;
   bool config_updates_enabled;
   std::optional<std::string> task_processor_name;
+  std::optional<std::string> update_group;
   std::chrono::milliseconds cleanup_interval;
   bool is_strong_period;
 
@@ -6,6 +6,8 @@
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <limits>
+#include <optional>
 
 #include <userver/cache/update_type.hpp>
 #include <userver/formats/json_fwd.hpp>
@@ -14,8 +16,22 @@ USERVER_NAMESPACE_BEGIN
 
 namespace cache {
 
+/// @brief Stages of an `Update`, see UpdateStatisticsScope::SetStage
+enum class UpdateStage {
+  kFetch,    ///< Receiving the data from the data source
+  kParse,    ///< Parsing the received data, may include the insertion
+  kBuild,    ///< Building the container, e.g. copying or filling it
+  kPublish,  ///< Setting the new cache value
+};
+
 namespace impl {
 
+inline constexpr std::size_t kUpdateStagesCount = 4;
+
+// The size is unknown if the cache has no size estimator
+inline constexpr std::size_t kUnknownSize =
+    std::numeric_limits<std::size_t>::max();
+
 struct UpdateStatistics final {
   std::atomic<std::size_t> update_attempt_count{0};
   std::atomic<std::size_t> update_no_changes_count{0};
@@ -28,6 +44,8 @@ struct UpdateStatistics final {
   std::atomic<std::chrono::steady_clock::time_point>
       last_successful_update_start_time{{}};
   std::atomic<std::chrono::milliseconds> last_update_duration{{}};
+  std::atomic<std::chrono::milliseconds>
+      last_update_stage_durations[kUpdateStagesCount]{};
 };
 
 formats::json::Value Serialize(const UpdateStatistics& stats,
@@ -37,6 +55,11 @@ struct Statistics final {
   UpdateStatistics full_update;
   UpdateStatistics incremental_update;
   std::atomic<std::size_t> documents_current_count{0};
+  std::atomic<std::size_t> current_size_in_bytes{kUnknownSize};
+
+  // The old cache values that are replaced by the new ones
+  std::atomic<std::chrono::milliseconds> last_retired_value_wait{{}};
+  std::atomic<std::chrono::milliseconds> last_retired_value_destruction{{}};
 };
 
 formats::json::Value Serialize(const Statistics& stats,
@@ -64,6 +87,12 @@ class UpdateStatisticsScope final {
   /// @brief Mark that the `Update` has finished without changes
   void FinishNoChanges();
 
+  /// @brief Marks the start of the next stage of the `Update`, the time until
+  /// the next call or Finish is accounted to the `stage`
+  /// @note A stage may be started multiple times per `Update`, the durations
+  /// are summed up
+  void SetStage(UpdateStage stage) noexcept;
+
   /// @brief Each item received from the data source should be accounted with
   /// this function
   /// @note This method can be called multiple times per `Update`
@@ -79,8 +108,14 @@ class UpdateStatisticsScope final {
  private:
   impl::Statistics& stats_;
   impl::UpdateStatistics& update_stats_;
+  void FinishStage(std::chrono::steady_clock::time_point now) noexcept;
+
   bool finished_{false};
   const std::chrono::steady_clock::time_point update_start_time_;
+  std::optional<UpdateStage> stage_;
+  std::chrono::steady_clock::time_point stage_start_time_;
+  std::chrono::steady_clock::duration
+      stage_durations_[impl::kUpdateStagesCount]{};
 };
 
 }  // namespace cache
@@ -0,0 +1,83 @@
+#pragma once
+
+/// @file userver/cache/cache_update_scheduler.hpp
+/// @brief @copybrief components::CacheUpdateScheduler
+
+#include <memory>
+
+#include <userver/components/component_fwd.hpp>
+#include <userver/components/loggable_component_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+class UpdateLimiter;
+}  // namespace cache::impl
+
+namespace components {
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief Limits the count of the concurrently running periodic updates of
+/// the caching components.
+///
+/// Without the component each cache is updated independently, so a service
+/// with many caches may load the CPU and the databases with the simultaneous
+/// updates, e.g. right after the start.
+///
+/// The component limits the count of the concurrently running updates
+/// globally and within the groups of caches. A cache is put into a group with
+/// its `update-group` static option, e.g. all the caches of a single DB
+/// cluster may form a group. The waiting cache with the oldest data starts
+/// first. The updates requested by testsuite are not limited.
+///
+/// Update moments are already spread by the `update-jitter` of the caches.
+///
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// max-concurrent-updates | max count of the updates running at once, 0 for no limit | 0
+/// groups | map of the group name to the max count of the updates running at once in that group | {}
+///
+/// ## Config example:
+///
+/// @code
+///   cache-update-scheduler:
+///       max-concurrent-updates: 8
+///       groups:
+///           postgres-main: 2
+///
+///   my-pg-cache:
+///       update-interval: 1m
+///       update-group: postgres-main
+/// @endcode
+
+// clang-format on
+class CacheUpdateScheduler final : public LoggableComponentBase {
+ public:
+  static constexpr auto kName = "cache-update-scheduler";
+
+  CacheUpdateScheduler(const ComponentConfig& config,
+                       const ComponentContext& context);
+
+  ~CacheUpdateScheduler() override;
+
+  /// @cond
+  // For internal use only
+  cache::impl::UpdateLimiter& GetLimiter() noexcept;
+  /// @endcond
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  std::unique_ptr<cache::impl::UpdateLimiter> limiter_;
+};
+
+template <>
+inline constexpr bool kHasValidate<CacheUpdateScheduler> = true;
+
+}  // namespace components
+
+USERVER_NAMESPACE_END
@@ -10,16 +10,12 @@
 #include <userver/components/component_fwd.hpp>
 #include <userver/dump/fwd.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/rcu/fwd.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 #include <userver/utils/flags.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
-namespace rcu {
-template <typename T>
-class ReadablePtr;
-}  // namespace rcu
-
 namespace cache {
 
 struct CacheDependencies;
@@ -80,6 +76,9 @@ class CacheUpdateTrait {
   // For internal use only
   // TODO remove after TAXICOMMON-3959
   engine::TaskProcessor& GetCacheTaskProcessor() const;
+
+  // For internal use only
+  impl::Statistics& GetStatistics() noexcept;
   /// @endcond
 
   /// @brief Must override in a subclass
@@ -99,7 +98,7 @@ class CacheUpdateTrait {
   virtual void ReadAndSet(dump::Reader& reader);
 
   class Impl;
-  utils::FastPimpl<Impl, 2672, 16> impl_;
+  utils::FastPimpl<Impl, 2896, 16> impl_;
 };
 
 }  // namespace cache
@@ -3,7 +3,9 @@
 /// @file userver/cache/caching_component_base.hpp
 /// @brief @copybrief components::CachingComponentBase
 
+#include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -52,6 +54,7 @@ namespace components {
 /// full-update-interval | interval between full updates | --
 /// first-update-fail-ok | whether first update failure is non-fatal | false
 /// task-processor | the name of the TaskProcessor for running DoWork | main-task-processor
+/// update-group | the group of components::CacheUpdateScheduler to limit the concurrent updates in | no group
 /// config-settings | enables dynamic reconfiguration with CacheConfigSet | true
 /// exception-interval | Used instead of `update-interval` in case of exception | update_interval
 /// additional-cleanup-interval | how often to run background RCU garbage collector | 10 seconds
@@ -137,7 +140,25 @@ class CachingComponentBase : public LoggableComponentBase,
   virtual std::unique_ptr<const T> ReadContents(dump::Reader& reader) const;
   /// @}
 
+  /// Override to report the approximate memory usage of the cache contents
+  /// in the `current-size-in-bytes` metric. Called on each Set.
+  virtual std::optional<std::size_t> EstimateSizeInBytes(
+      const T& contents) const;
+
  private:
+  // Destroys the old values asynchronously and accounts their statistics
+  struct Deleter final {
+    void operator()(const T* raw_ptr);
+
+    utils::impl::WaitTokenStorage::Token token;
+    engine::TaskProcessor* task_processor;
+    cache::impl::Statistics* statistics;
+    // the moment the value is replaced by a newer one
+    std::chrono::steady_clock::time_point retired_at{};
+  };
+
+  void MarkCurrentValueRetired();
+
   void OnAllComponentsLoaded() final;
 
   void Cleanup() final;
@@ -200,26 +221,55 @@ utils::SharedReadablePtr<T> CachingComponentBase<T>::GetUnsafe() const {
 }
 
 template <typename T>
-void CachingComponentBase<T>::Set(std::unique_ptr<const T> value_ptr) {
-  auto deleter = [token = wait_token_storage_.GetToken(),
-                  &cache_task_processor =
-                      GetCacheTaskProcessor()](const T* raw_ptr) mutable {
-    std::unique_ptr<const T> ptr{raw_ptr};
-
-    // Kill garbage asynchronously as T::~T() might be very slow
-    engine::CriticalAsyncNoSpan(cache_task_processor, [ptr = std::move(ptr),
-                                                       token = std::move(
-                                                           token)]() mutable {
-      // Make sure *ptr is deleted before token is destroyed
-      ptr.reset();
-    }).Detach();
-  };
+void CachingComponentBase<T>::Deleter::operator()(const T* raw_ptr) {
+  std::unique_ptr<const T> ptr{raw_ptr};
+
+  // Kill garbage asynchronously as T::~T() might be very slow
+  engine::CriticalAsyncNoSpan(
+      *task_processor, [ptr = std::move(ptr), token = std::move(token),
+                        statistics = statistics,
+                        retired_at = retired_at]() mutable {
+        const auto destruction_start = std::chrono::steady_clock::now();
+        // Make sure *ptr is deleted before token is destroyed
+        ptr.reset();
+        if (retired_at == std::chrono::steady_clock::time_point{}) return;
+
+        statistics->last_retired_value_wait =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                destruction_start - retired_at);
+        statistics->last_retired_value_destruction =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - destruction_start);
+      })
+      .Detach();
+}
+
+template <typename T>
+void CachingComponentBase<T>::MarkCurrentValueRetired() {
+  // The deleter is read after the last reference is released, so the
+  // write happens-before the read
+  const auto old_value = cache_.ReadCopy();
+  if (auto* deleter = std::get_deleter<Deleter>(old_value)) {
+    deleter->retired_at = std::chrono::steady_clock::now();
+  }
+}
 
-  const std::shared_ptr<const T> new_value(value_ptr.release(),
-                                           std::move(deleter));
+template <typename T>
+void CachingComponentBase<T>::Set(std::unique_ptr<const T> value_ptr) {
+  auto& statistics = GetStatistics();
+  const std::shared_ptr<const T> new_value(
+      value_ptr.release(),
+      Deleter{wait_token_storage_.GetToken(), &GetCacheTaskProcessor(),
+              &statistics});
+  MarkCurrentValueRetired();
   cache_.Assign(new_value);
   event_channel_.SendEvent(new_value);
   OnCacheModified();
+
+  if (new_value) {
+    statistics.current_size_in_bytes =
+        EstimateSizeInBytes(*new_value).value_or(cache::impl::kUnknownSize);
+  }
 }
 
 template <typename T>
@@ -235,6 +285,7 @@ void CachingComponentBase<T>::Emplace(Args&&... args) {
 
 template <typename T>
 void CachingComponentBase<T>::Clear() {
+  MarkCurrentValueRetired();
   cache_.Assign(std::make_unique<const T>());
 }
 
@@ -243,6 +294,12 @@ bool CachingComponentBase<T>::MayReturnNull() const {
   return false;
 }
 
+template <typename T>
+std::optional<std::size_t> CachingComponentBase<T>::EstimateSizeInBytes(
+    const T& /*contents*/) const {
+  return std::nullopt;
+}
+
 template <typename T>
 void CachingComponentBase<T>::GetAndWrite(dump::Writer& writer) const {
   const auto contents = GetUnsafe();
@@ -5,18 +5,21 @@
 
 #include <atomic>
 #include <chrono>
+#include <limits>
 #include <optional>
 
 #include <userver/cache/lru_cache_config.hpp>
 #include <userver/cache/lru_cache_statistics.hpp>
 #include <userver/cache/nway_lru_cache.hpp>
 #include <userver/concurrent/mutex_set.hpp>
+#include <userver/concurrent/single_flight.hpp>
 #include <userver/dump/common.hpp>
 #include <userver/dump/dumper.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/utils/datetime.hpp>
 #include <userver/utils/impl/cached_time.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
+#include <userver/utils/token_bucket.hpp>
 
 // TODO remove
 #include <userver/logging/log.hpp>
@@ -52,6 +55,13 @@ impl::ExpirableValue<Value> Read(dump::Reader& reader,
 
 }  // namespace impl
 
+template <typename Value>
+struct SizeOf<impl::ExpirableValue<Value>> {
+  std::size_t operator()(const impl::ExpirableValue<Value>& value) const {
+    return sizeof(value) - sizeof(Value) + SizeOf<Value>{}(value.value);
+  }
+};
+
 /// @ingroup userver_containers
 /// @brief Class for expirable LRU cache. Use cache::LruMap for not expirable
 /// LRU Cache.
@@ -69,15 +79,24 @@ class ExpirableLruCache final {
   enum class ReadMode {
     kSkipCache,  ///< Do not cache value got from update function
     kUseCache,   ///< Cache value got from update function
+    /// Like kUseCache, but an expired value that is within the stale lifetime
+    /// (see SetStaleLifetime) is returned at once and is updated in
+    /// background
+    kServeStale,
   };
 
   ExpirableLruCache(size_t ways, size_t way_size, const Hash& hash = Hash(),
-                    const Equal& equal = Equal());
+                    const Equal& equal = Equal(),
+                    CachePolicy policy = CachePolicy::kLRU);
 
   ~ExpirableLruCache();
 
   void SetWaySize(size_t way_size);
 
+  /// Limits the memory usage of each way, zero disables the limit, see
+  /// cache::SizeOf
+  void SetWaySizeInBytes(size_t way_size_in_bytes);
+
   std::chrono::milliseconds GetMaxLifetime() const noexcept;
 
   void SetMaxLifetime(std::chrono::milliseconds max_lifetime);
@@ -89,10 +108,22 @@ class ExpirableLruCache final {
    */
   void SetBackgroundUpdate(BackgroundUpdateMode background_update);
 
+  /// Sets how long after the expiration the values may be returned by
+  /// Get with ReadMode::kServeStale, zero disables serving the stale values
+  void SetStaleLifetime(std::chrono::milliseconds stale_lifetime);
+
+  /// Limits the rate of the background updates started on reads, the rest of
+  /// them are skipped. Zero disables the limit.
+  void SetBackgroundUpdatesPerSecond(std::size_t updates_per_second);
+
   /**
    * @returns GetOptional("key", update_func) if it is not std::nullopt.
    * Otherwise the result of update_func(key) is returned, and additionally
    * stored in cache if "read_mode" is kUseCache.
+   *
+   * Concurrent calls for the same missing key are coalesced unless
+   * "read_mode" is kSkipCache: update_func is called once, and all the callers
+   * get its result or its exception.
    */
   Value Get(const Key& key, const UpdateValueFunc& update_func,
             ReadMode read_mode = ReadMode::kUseCache);
@@ -134,6 +165,8 @@ class ExpirableLruCache final {
 
   size_t GetSizeApproximate() const;
 
+  size_t GetSizeInBytesApproximate() const;
+
   /// Clear cache
   void Invalidate();
 
@@ -158,21 +191,38 @@ class ExpirableLruCache final {
   bool ShouldUpdate(std::chrono::steady_clock::time_point update_time,
                     std::chrono::steady_clock::time_point now) const;
 
+  bool IsServableStale(std::chrono::steady_clock::time_point update_time,
+                       std::chrono::steady_clock::time_point now) const;
+
+  std::optional<Value> GetOptionalImpl(const Key& key,
+                                       const UpdateValueFunc& update_func,
+                                       bool serve_stale);
+
+  void TryUpdateInBackground(const Key& key,
+                             const UpdateValueFunc& update_func);
+
   cache::NWayLRU<Key, impl::ExpirableValue<Value>, Hash, Equal> lru_;
   std::atomic<std::chrono::milliseconds> max_lifetime_{
       std::chrono::milliseconds(0)};
   std::atomic<BackgroundUpdateMode> background_update_mode_{
       BackgroundUpdateMode::kDisabled};
+  std::atomic<std::chrono::milliseconds> stale_lifetime_{
+      std::chrono::milliseconds(0)};
+  utils::TokenBucket background_updates_limit_{
+      utils::TokenBucket::MakeUnbounded()};
   impl::ExpirableLruCacheStatistics stats_;
   concurrent::MutexSet<Key, Hash, Equal> mutex_set_;
+  concurrent::SingleFlight<Key, Value, Hash, Equal> single_flight_;
   utils::impl::WaitTokenStorage wait_token_storage_;
 };
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
-    size_t ways, size_t way_size, const Hash& hash, const Equal& equal)
-    : lru_(ways, way_size, hash, equal),
-      mutex_set_{ways, way_size, hash, equal} {}
+    size_t ways, size_t way_size, const Hash& hash, const Equal& equal,
+    CachePolicy policy)
+    : lru_(ways, way_size, hash, equal, policy),
+      mutex_set_{ways, way_size, hash, equal},
+      single_flight_{ways, way_size, hash, equal} {}
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::~ExpirableLruCache() {
@@ -184,6 +234,12 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::SetWaySize(size_t way_size) {
   lru_.UpdateWaySize(way_size);
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetWaySizeInBytes(
+    size_t way_size_in_bytes) {
+  lru_.UpdateWaySizeInBytes(way_size_in_bytes);
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 std::chrono::milliseconds
 ExpirableLruCache<Key, Value, Hash, Equal>::GetMaxLifetime() const noexcept {
@@ -202,35 +258,71 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::SetBackgroundUpdate(
   background_update_mode_ = background_update;
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetStaleLifetime(
+    std::chrono::milliseconds stale_lifetime) {
+  stale_lifetime_ = stale_lifetime;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetBackgroundUpdatesPerSecond(
+    std::size_t updates_per_second) {
+  if (updates_per_second == 0) {
+    background_updates_limit_.SetMaxSize(std::numeric_limits<size_t>::max());
+    background_updates_limit_.SetInstantRefillPolicy();
+    return;
+  }
+
+  background_updates_limit_.SetMaxSize(updates_per_second);
+  background_updates_limit_.SetRefillPolicy(
+      {1, utils::TokenBucket::Duration{std::chrono::seconds{1}} /
+              updates_per_second});
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
     const Key& key, const UpdateValueFunc& update_func, ReadMode read_mode) {
-  auto now = utils::datetime::SteadyNow();
-  auto opt_old_value = GetOptional(key, update_func);
+  auto now = utils::datetime::SteadyCoarseNow();
+  auto opt_old_value = GetOptionalImpl(key, update_func,
+                                       read_mode == ReadMode::kServeStale);
   if (opt_old_value) {
     return std::move(*opt_old_value);
   }
 
-  auto mutex = mutex_set_.GetMutexForKey(key);
-  std::lock_guard lock(mutex);
-  // Test one more time - concurrent ExpirableLruCache::Get()
-  // might have put the value
-  auto old_value = lru_.Get(key);
-  if (old_value && !IsExpired(old_value->update_time, now)) {
-    return std::move(old_value->value);
-  }
+  const auto update = [&] {
+    // Excludes the background updates of the key
+    auto mutex = mutex_set_.GetMutexForKey(key);
+    std::lock_guard lock(mutex);
+    // Test one more time - concurrent ExpirableLruCache::Get()
+    // might have put the value
+    auto old_value = lru_.Get(key);
+    if (old_value && !IsExpired(old_value->update_time, now)) {
+      return std::move(old_value->value);
+    }
 
-  auto value = update_func(key);
-  if (read_mode == ReadMode::kUseCache) {
-    lru_.Put(key, {value, now});
-  }
-  return value;
+    auto value = update_func(key);
+    if (read_mode != ReadMode::kSkipCache) {
+      lru_.Put(key, {value, now});
+    }
+    return value;
+  };
+
+  // The callers that skip the cache expect a value of their own update_func
+  if (read_mode == ReadMode::kSkipCache) return update();
+  return single_flight_.Do(key, update);
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptional(
     const Key& key, const UpdateValueFunc& update_func) {
-  auto now = utils::datetime::SteadyNow();
+  return GetOptionalImpl(key, update_func, false);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::optional<Value>
+ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalImpl(
+    const Key& key, const UpdateValueFunc& update_func, bool serve_stale) {
+  auto now = utils::datetime::SteadyCoarseNow();
   auto old_value = lru_.Get(key);
 
   if (old_value) {
@@ -238,12 +330,18 @@ std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptional(
       impl::CacheHit(stats_);
 
       if (ShouldUpdate(old_value->update_time, now)) {
-        UpdateInBackground(key, update_func);
+        TryUpdateInBackground(key, update_func);
       }
 
       return std::move(old_value->value);
     } else {
       impl::CacheStale(stats_);
+
+      if (serve_stale && IsServableStale(old_value->update_time, now)) {
+        impl::CacheHit(stats_);
+        TryUpdateInBackground(key, update_func);
+        return std::move(old_value->value);
+      }
     }
   }
   impl::CacheMiss(stats_);
@@ -270,14 +368,14 @@ template <typename Key, typename Value, typename Hash, typename Equal>
 std::optional<Value>
 ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalUnexpirableWithUpdate(
     const Key& key, const UpdateValueFunc& update_func) {
-  auto now = utils::datetime::SteadyNow();
+  auto now = utils::datetime::SteadyCoarseNow();
   auto old_value = lru_.Get(key);
 
   if (old_value) {
     impl::CacheHit(stats_);
 
     if (ShouldUpdate(old_value->update_time, now)) {
-      UpdateInBackground(key, update_func);
+      TryUpdateInBackground(key, update_func);
     }
 
     return old_value->value;
@@ -291,7 +389,7 @@ template <typename Key, typename Value, typename Hash, typename Equal>
 std::optional<Value>
 ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalNoUpdate(
     const Key& key) {
-  auto now = utils::datetime::SteadyNow();
+  auto now = utils::datetime::SteadyCoarseNow();
   auto old_value = lru_.Get(key);
 
   if (old_value) {
@@ -311,13 +409,13 @@ ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalNoUpdate(
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::Put(const Key& key,
                                                      const Value& value) {
-  lru_.Put(key, {value, utils::datetime::SteadyNow()});
+  lru_.Put(key, {value, utils::datetime::SteadyCoarseNow()});
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::Put(const Key& key,
                                                      Value&& value) {
-  lru_.Put(key, {std::move(value), utils::datetime::SteadyNow()});
+  lru_.Put(key, {std::move(value), utils::datetime::SteadyCoarseNow()});
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -331,6 +429,12 @@ size_t ExpirableLruCache<Key, Value, Hash, Equal>::GetSizeApproximate() const {
   return lru_.GetSize();
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+size_t ExpirableLruCache<Key, Value, Hash, Equal>::GetSizeInBytesApproximate()
+    const {
+  return lru_.GetSizeInBytes();
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::Invalidate() {
   lru_.Invalidate();
@@ -358,12 +462,20 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::UpdateInBackground(
       return;
     }
 
-    auto now = utils::datetime::SteadyNow();
+    auto now = utils::datetime::SteadyCoarseNow();
     auto value = update_func(key);
     lru_.Put(key, {value, now});
   }).Detach();
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::TryUpdateInBackground(
+    const Key& key, const UpdateValueFunc& update_func) {
+  if (background_updates_limit_.Obtain()) {
+    UpdateInBackground(key, update_func);
+  }
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 bool ExpirableLruCache<Key, Value, Hash, Equal>::IsExpired(
     std::chrono::steady_clock::time_point update_time,
@@ -381,6 +493,15 @@ bool ExpirableLruCache<Key, Value, Hash, Equal>::ShouldUpdate(
          max_lifetime.count() != 0 && update_time + max_lifetime / 2 < now;
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool ExpirableLruCache<Key, Value, Hash, Equal>::IsServableStale(
+    std::chrono::steady_clock::time_point update_time,
+    std::chrono::steady_clock::time_point now) const {
+  auto stale_lifetime = stale_lifetime_.load();
+  return stale_lifetime.count() != 0 &&
+         update_time + max_lifetime_.load() + stale_lifetime >= now;
+}
+
 template <typename Key, typename Value, typename Hash = std::hash<Key>,
           typename Equal = std::equal_to<Key>>
 class LruCacheWrapper final {
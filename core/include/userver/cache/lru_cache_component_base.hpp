@@ -22,13 +22,15 @@ namespace cache {
 namespace impl {
 
 formats::json::Value GetCacheStatisticsAsJson(
-    const ExpirableLruCacheStatistics& stats, std::size_t size);
+    const ExpirableLruCacheStatistics& stats, std::size_t size,
+    std::size_t size_in_bytes);
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 formats::json::Value GetCacheStatisticsAsJson(
     const ExpirableLruCache<Key, Value, Hash, Equal>& cache) {
   return GetCacheStatisticsAsJson(cache.GetStatistics(),
-                                  cache.GetSizeApproximate());
+                                  cache.GetSizeApproximate(),
+                                  cache.GetSizeInBytesApproximate());
 }
 
 testsuite::ComponentControl& FindComponentControl(
@@ -65,9 +67,13 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
 /// size | max amount of items to store in cache | --
+/// size-in-bytes | max memory usage of the cache, see cache::SizeOf (0 is unlimited) | 0
 /// ways | number of ways for associative cache | --
 /// lifetime | TTL for cache entries (0 is unlimited) | 0
+/// stale-lifetime | how long the expired entries are returned with cache::ExpirableLruCache::ReadMode::kServeStale while being updated in background (0 disables) | 0
+/// background-updates-per-second | rate limit of the background updates (0 is unlimited) | 0
 /// config-settings | enables dynamic reconfiguration with CacheConfigSet | true
+/// policy | eviction policy: `lru` or `tinylfu` (W-TinyLFU, see cache::CachePolicy::kTinyLFU) | lru
 ///
 /// ## Example usage:
 ///
@@ -137,7 +143,8 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
       name_(components::GetCurrentComponentName(config)),
       static_config_(config),
       cache_(std::make_shared<Cache>(static_config_.ways,
-                                     static_config_.GetWaySize())) {
+                                     static_config_.GetWaySize(), Hash{},
+                                     Equal{}, static_config_.policy)) {
   if (impl::IsDumpSupportEnabled(config)) {
     dumper_ = std::make_shared<dump::Dumper>(
         config, context, static_cast<dump::DumpableEntity&>(*this));
@@ -145,8 +152,12 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
     dumper_->ReadDump();
   }
 
+  cache_->SetWaySizeInBytes(static_config_.GetWaySizeInBytes());
   cache_->SetMaxLifetime(static_config_.config.lifetime);
+  cache_->SetStaleLifetime(static_config_.config.stale_lifetime);
   cache_->SetBackgroundUpdate(static_config_.config.background_update);
+  cache_->SetBackgroundUpdatesPerSecond(
+      static_config_.config.background_updates_per_second);
 
   if (static_config_.use_dynamic_config) {
     LOG_INFO() << "Dynamic LRU cache config is enabled, subscribing on "
@@ -215,8 +226,11 @@ template <typename Key, typename Value, typename Hash, typename Equal>
 void LruCacheComponent<Key, Value, Hash, Equal>::UpdateConfig(
     const LruCacheConfig& config) {
   cache_->SetWaySize(config.GetWaySize(static_config_.ways));
+  cache_->SetWaySizeInBytes(config.GetWaySizeInBytes(static_config_.ways));
   cache_->SetMaxLifetime(config.lifetime);
+  cache_->SetStaleLifetime(config.stale_lifetime);
   cache_->SetBackgroundUpdate(config.background_update);
+  cache_->SetBackgroundUpdatesPerSecond(config.background_updates_per_second);
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
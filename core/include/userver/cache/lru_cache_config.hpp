@@ -5,6 +5,7 @@
 #include <optional>
 #include <unordered_map>
 
+#include <userver/cache/policy.hpp>
 #include <userver/components/component_fwd.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/formats/json_fwd.hpp>
@@ -27,23 +28,37 @@ struct LruCacheConfig final {
 
   std::size_t GetWaySize(std::size_t ways) const;
 
+  std::size_t GetWaySizeInBytes(std::size_t ways) const;
+
   std::size_t size;
+  // zero if the memory usage is not limited
+  std::size_t size_in_bytes;
   std::chrono::milliseconds lifetime;
+  // zero if the stale values are not served
+  std::chrono::milliseconds stale_lifetime;
   BackgroundUpdateMode background_update;
+  // zero if the background updates are not limited
+  std::size_t background_updates_per_second;
 };
 
 LruCacheConfig Parse(const formats::json::Value& value,
                      formats::parse::To<LruCacheConfig>);
 
+CachePolicy Parse(const yaml_config::YamlConfig& config,
+                  formats::parse::To<CachePolicy>);
+
 struct LruCacheConfigStatic final {
   explicit LruCacheConfigStatic(const yaml_config::YamlConfig& config);
   explicit LruCacheConfigStatic(const components::ComponentConfig& config);
 
   std::size_t GetWaySize() const;
 
+  std::size_t GetWaySizeInBytes() const;
+
   LruCacheConfig config;
   std::size_t ways;
   bool use_dynamic_config;
+  CachePolicy policy;
 };
 
 std::unordered_map<std::string, LruCacheConfig> ParseLruCacheConfigSet(
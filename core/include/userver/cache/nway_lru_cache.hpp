@@ -1,34 +1,84 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <functional>
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <vector>
 
 #include <userver/cache/lru_map.hpp>
+#include <userver/concurrent/sharded_variable.hpp>
 #include <userver/dump/dumper.hpp>
 #include <userver/dump/operations.hpp>
-#include <userver/engine/mutex.hpp>
+#include <userver/engine/shared_mutex.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace cache {
 
+namespace impl {
+
+// Lossy buffer of the recent reads, the reads beyond the capacity are dropped
+template <typename Handle>
+class ReadBuffer final {
+ public:
+  static constexpr std::size_t kCapacity = 16;
+
+  /// @returns true if the buffer is full and should be drained
+  bool Push(Handle handle) noexcept {
+    const auto index = size_.fetch_add(1, std::memory_order_relaxed);
+    if (index < kCapacity) {
+      slots_[index].store(handle, std::memory_order_relaxed);
+    }
+    return index + 1 >= kCapacity;
+  }
+
+  /// Must not run concurrently with Push
+  template <typename Func>
+  void Drain(Func func) {
+    const auto size =
+        std::min(size_.load(std::memory_order_relaxed), kCapacity);
+    for (std::size_t i = 0; i < size; ++i) {
+      func(slots_[i].load(std::memory_order_relaxed));
+    }
+    size_.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<std::size_t> size_{0};
+  std::array<std::atomic<Handle>, kCapacity> slots_{};
+};
+
+inline constexpr std::size_t kMaxReadBufferShards = 8;
+
+}  // namespace impl
+
 /// @ingroup userver_containers
+///
+/// @brief LRU cache split into `ways` independently locked LRUs.
+///
+/// Get() without a validator takes the way lock in shared mode and records
+/// the access in a per-thread buffer, the usage is updated in batches by the
+/// next exclusive access to the way. Other methods lock the way exclusively.
 template <typename T, typename U, typename Hash = std::hash<T>,
           typename Equal = std::equal_to<T>>
 class NWayLRU final {
  public:
   NWayLRU(size_t ways, size_t way_size, const Hash& hash = Hash(),
-          const Equal& equal = Equal());
+          const Equal& equal = Equal(),
+          CachePolicy policy = CachePolicy::kLRU);
 
   void Put(const T& key, U value);
 
+  /// Returns the value if `validator(value)` is true, erases it otherwise
   template <typename Validator>
   std::optional<U> Get(const T& key, Validator validator);
 
-  std::optional<U> Get(const T& key) {
-    return Get(key, [](const U&) { return true; });
-  }
+  /// Returns the value, does not block the concurrent readers of the way
+  std::optional<U> Get(const T& key);
 
   U GetOr(const T& key, const U& default_value);
 
@@ -42,8 +92,15 @@ class NWayLRU final {
 
   size_t GetSize() const;
 
+  /// Returns the memory usage of all the ways, see cache::SizeOf
+  size_t GetSizeInBytes() const;
+
   void UpdateWaySize(size_t way_size);
 
+  /// Limits the memory usage of each way, zero disables the limit, see
+  /// cache::LruMap::SetMaxSizeInBytes
+  void UpdateWaySizeInBytes(size_t way_size_in_bytes);
+
   void Write(dump::Writer& writer) const;
   void Read(dump::Reader& reader);
 
@@ -52,18 +109,30 @@ class NWayLRU final {
   void SetDumper(std::shared_ptr<dump::Dumper> dumper);
 
  private:
+  using Cache = LruMap<T, U, Hash, Equal>;
+  using ReadBuffer = impl::ReadBuffer<typename Cache::NodeHandle>;
+
   struct Way {
     Way(Way&& other) noexcept : cache(std::move(other.cache)) {}
 
     // max_size is not used, will be reset by Resize() in NWayLRU::NWayLRU
-    Way(const Hash& hash, const Equal& equal) : cache(1, hash, equal) {}
-
-    mutable engine::Mutex mutex;
-    LruMap<T, U, Hash, Equal> cache;
+    Way(const Hash& hash, const Equal& equal, CachePolicy policy)
+        : cache(1, policy, hash, equal) {}
+
+    mutable engine::SharedMutex mutex;
+    Cache cache;
+    concurrent::ShardedVariable<ReadBuffer> reads{
+        std::min(concurrent::impl::GetDefaultShardCount(),
+                 impl::kMaxReadBufferShards)};
   };
 
   Way& GetWay(const T& key);
 
+  // Applies the buffered reads, so that they do not refer to the nodes that
+  // are going to be evicted
+  static std::unique_lock<engine::SharedMutex> LockExclusive(Way& way);
+  static void ApplyReads(Way& way);
+
   void NotifyDumper();
 
   std::vector<Way> caches_;
@@ -73,10 +142,10 @@ class NWayLRU final {
 
 template <typename T, typename U, typename Hash, typename Eq>
 NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size, const Hash& hash,
-                                 const Eq& equal)
+                                 const Eq& equal, CachePolicy policy)
     : caches_(), hash_fn_(hash) {
   caches_.reserve(ways);
-  for (size_t i = 0; i < ways; ++i) caches_.emplace_back(hash, equal);
+  for (size_t i = 0; i < ways; ++i) caches_.emplace_back(hash, equal, policy);
   if (ways == 0) throw std::logic_error("Ways must be positive");
 
   for (auto& way : caches_) way.cache.SetMaxSize(way_size);
@@ -86,7 +155,7 @@ template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::Put(const T& key, U value) {
   auto& way = GetWay(key);
   {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
+    auto lock = LockExclusive(way);
     way.cache.Put(key, std::move(value));
   }
   NotifyDumper();
@@ -97,7 +166,7 @@ template <typename Validator>
 std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key,
                                               Validator validator) {
   auto& way = GetWay(key);
-  std::unique_lock<engine::Mutex> lock(way.mutex);
+  auto lock = LockExclusive(way);
   auto* value = way.cache.Get(key);
 
   if (value) {
@@ -108,11 +177,32 @@ std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key,
   return std::nullopt;
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key) {
+  auto& way = GetWay(key);
+  std::optional<U> result;
+  bool should_apply_reads = false;
+  {
+    std::shared_lock lock(way.mutex);
+    const auto node = way.cache.Peek(key);
+    if (!node) return std::nullopt;
+
+    result.emplace(node->GetValue());
+    should_apply_reads = way.reads.GetLocal().Push(node);
+  }
+
+  if (should_apply_reads) {
+    std::unique_lock lock(way.mutex, std::try_to_lock);
+    if (lock) ApplyReads(way);
+  }
+  return result;
+}
+
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
   auto& way = GetWay(key);
   {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
+    auto lock = LockExclusive(way);
     way.cache.Erase(key);
   }
   NotifyDumper();
@@ -121,14 +211,14 @@ void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
 template <typename T, typename U, typename Hash, typename Eq>
 U NWayLRU<T, U, Hash, Eq>::GetOr(const T& key, const U& default_value) {
   auto& way = GetWay(key);
-  std::unique_lock<engine::Mutex> lock(way.mutex);
+  auto lock = LockExclusive(way);
   return way.cache.GetOr(key, default_value);
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::Invalidate() {
   for (auto& way : caches_) {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
+    auto lock = LockExclusive(way);
     way.cache.Clear();
   }
   NotifyDumper();
@@ -138,7 +228,7 @@ template <typename T, typename U, typename Hash, typename Eq>
 template <typename Function>
 void NWayLRU<T, U, Hash, Eq>::VisitAll(Function func) const {
   for (const auto& way : caches_) {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
+    std::shared_lock lock(way.mutex);
     way.cache.VisitAll(func);
   }
 }
@@ -147,20 +237,38 @@ template <typename T, typename U, typename Hash, typename Eq>
 size_t NWayLRU<T, U, Hash, Eq>::GetSize() const {
   size_t size{0};
   for (const auto& way : caches_) {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
+    std::shared_lock lock(way.mutex);
     size += way.cache.GetSize();
   }
   return size;
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+size_t NWayLRU<T, U, Hash, Eq>::GetSizeInBytes() const {
+  size_t size{0};
+  for (const auto& way : caches_) {
+    std::shared_lock lock(way.mutex);
+    size += way.cache.GetSizeInBytes();
+  }
+  return size;
+}
+
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::UpdateWaySize(size_t way_size) {
   for (auto& way : caches_) {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
+    auto lock = LockExclusive(way);
     way.cache.SetMaxSize(way_size);
   }
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::UpdateWaySizeInBytes(size_t way_size_in_bytes) {
+  for (auto& way : caches_) {
+    auto lock = LockExclusive(way);
+    way.cache.SetMaxSizeInBytes(way_size_in_bytes);
+  }
+}
+
 template <typename T, typename U, typename Hash, typename Eq>
 typename NWayLRU<T, U, Hash, Eq>::Way& NWayLRU<T, U, Hash, Eq>::GetWay(
     const T& key) {
@@ -168,12 +276,27 @@ typename NWayLRU<T, U, Hash, Eq>::Way& NWayLRU<T, U, Hash, Eq>::GetWay(
   return caches_[n];
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+std::unique_lock<engine::SharedMutex> NWayLRU<T, U, Hash, Eq>::LockExclusive(
+    Way& way) {
+  std::unique_lock lock(way.mutex);
+  ApplyReads(way);
+  return lock;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::ApplyReads(Way& way) {
+  way.reads.VisitAll([&way](ReadBuffer& reads) {
+    reads.Drain([&way](auto node) { way.cache.Touch(node); });
+  });
+}
+
 template <typename T, typename U, typename Hash, typename Equal>
 void NWayLRU<T, U, Hash, Equal>::Write(dump::Writer& writer) const {
   writer.Write(caches_.size());
 
   for (const Way& way : caches_) {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
+    std::shared_lock lock(way.mutex);
 
     writer.Write(way.cache.GetSize());
 
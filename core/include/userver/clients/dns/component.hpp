@@ -20,6 +20,10 @@ namespace clients::dns {
 /// Returned references to clients::dns::Resolver live for a lifetime
 /// of the component and are safe for concurrent use.
 ///
+/// The cached names that were requested during the last `prefetch-interval`
+/// are refreshed in background before their TTL expires. The most requested
+/// of them are reported in the `hot-names` metric with the `dns_name` label.
+///
 /// ## Static options:
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
@@ -33,6 +37,9 @@ namespace clients::dns {
 /// cache-size-per-way | size of each way of network cache | 256
 /// cache-max-reply-ttl | TTL limit for network replies caching | 5m
 /// cache-failure-ttl | TTL for network failures caching | 5s
+/// prefetch-interval | interval of the hot names prefetch, 0 to disable | 1s
+/// prefetch-min-hits | cache hits per prefetch interval for a name to be prefetched | 1
+/// hot-names-count | number of the most requested names to report in statistics | 10
 ///
 /// ## Static configuration example:
 ///
@@ -52,9 +59,11 @@ class Component final : public components::LoggableComponentBase {
 
  private:
   void Write(utils::statistics::Writer& writer);
+  void WriteHotNames(utils::statistics::Writer& writer);
 
   Resolver resolver_;
   utils::statistics::Entry statistics_holder_;
+  utils::statistics::Entry hot_names_statistics_holder_;
 };
 
 }  // namespace clients::dns
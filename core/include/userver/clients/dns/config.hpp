@@ -39,6 +39,15 @@ struct ResolverConfig {
 
   /// Network cache failure TTL
   std::chrono::milliseconds cache_failure_ttl{std::chrono::seconds{5}};
+
+  /// Interval of the hot names prefetch, disabled if zero
+  std::chrono::milliseconds prefetch_interval{std::chrono::seconds{1}};
+
+  /// Cache hits per prefetch interval for a name to be prefetched
+  size_t prefetch_min_hits{1};
+
+  /// Number of the most requested names to report
+  size_t hot_names_count{10};
 };
 
 }  // namespace clients::dns
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include <userver/clients/dns/common.hpp>
 #include <userver/clients/dns/config.hpp>
 #include <userver/clients/dns/exception.hpp>
@@ -30,6 +33,12 @@ class Resolver {
     utils::statistics::RelaxedCounter<size_t> network_failure{0};
   };
 
+  /// Name requested from the network cache during the last prefetch interval
+  struct HotName {
+    std::string name;
+    size_t hits{0};
+  };
+
   Resolver(engine::TaskProcessor& fs_task_processor,
            const ResolverConfig& config);
   Resolver(const Resolver&) = delete;
@@ -50,6 +59,15 @@ class Resolver {
   /// Returns lookup source counters.
   const LookupSourceCounters& GetLookupSourceCounters() const;
 
+  /// Returns the most requested names of the last prefetch interval, the
+  /// hottest first.
+  std::vector<HotName> GetHotNames() const;
+
+  /// Forces a prefetch round: refreshes the cache entries of the names hit
+  /// during the last prefetch interval that are about to expire.
+  /// Does not wait for the refresh to finish.
+  void PrefetchHotNames();
+
   /// Forces the reload of lookup table file. Waits until the reload is done.
   void ReloadHosts();
 
@@ -61,7 +79,7 @@ class Resolver {
 
  private:
   class Impl;
-  constexpr static size_t kSize = 1584;
+  constexpr static size_t kSize = 2352;
   constexpr static size_t kAlignment = 16;
   utils::FastPimpl<Impl, kSize, kAlignment> impl_;
 };
@@ -8,11 +8,14 @@
 #endif
 
 #include <memory>
+#include <string_view>
 
 #include <userver/moodycamel/concurrentqueue_fwd.h>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
+#include <userver/clients/http/load_balancing_settings.hpp>
 #include <userver/clients/http/request.hpp>
+#include <userver/clients/http/retry_budget_settings.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/rcu/rcu.hpp>
 #include <userver/utils/fast_pimpl.hpp>
@@ -26,6 +29,7 @@ namespace curl {
 class easy;
 class multi;
 class ConnectRateLimiter;
+class share;
 }  // namespace curl
 
 namespace engine::ev {
@@ -41,14 +45,31 @@ struct Config;
 struct TestsuiteConfig;
 struct EnforceTaskDeadlineConfig;
 class Statistics;
+class RequestStats;
 struct PoolStatistics;
 struct InstanceStatistics;
 class DestinationStatistics;
+class EndpointBalancer;
 
 struct ClientSettings final {
   std::string thread_name_prefix;
   size_t io_threads = 8;
   bool defer_events = false;
+  // Requests to the same scheme://host:port are performed by the same
+  // curl::multi to reuse its connections
+  bool destination_affinity = false;
+  // Default HTTP version of the requests, see Request::http_version()
+  HttpVersion http_version = HttpVersion::kDefault;
+  // Max HTTP/2 streams per connection, 0 for the libcurl default
+  size_t http2_max_concurrent_streams = 0;
+  // The TLS sessions and the DNS cache are shared by all the curl::multi,
+  // so a handshake made in one thread is resumed in the other ones
+  bool share_tls_sessions = false;
+  bool share_dns_cache = false;
+  // Applied to every destination of the destination statistics
+  RetryBudgetSettings retry_budget{};
+  // Balancing between the addresses of the async resolver
+  LoadBalancingSettings load_balancing{};
 };
 
 ClientSettings Parse(const yaml_config::YamlConfig& value,
@@ -130,12 +151,19 @@ class Client final {
 
   size_t FindMultiIndex(const curl::multi*) const;
 
+  size_t SelectMultiIndex(std::string_view url) const;
+
   // Functions for EasyWrapper that must be noexcept, as they are called from
   // the EasyWrapper destructor.
   friend class impl::EasyWrapper;
   void IncPending() noexcept { ++pending_tasks_; }
   void DecPending() noexcept { --pending_tasks_; }
   void PushIdleEasy(std::shared_ptr<curl::easy>&& easy) noexcept;
+  // Moves the easy to the multi of the URL destination, returns the stats of
+  // that multi or nullptr if the easy is not moved
+  std::shared_ptr<RequestStats> BindToDestination(curl::easy& easy);
+  // nullptr if the balancing is disabled
+  EndpointBalancer* GetEndpointBalancer() noexcept;
 
   std::shared_ptr<curl::easy> TryDequeueIdle() noexcept;
 
@@ -146,6 +174,8 @@ class Client final {
   std::unique_ptr<engine::ev::ThreadPool> thread_pool_;
   std::vector<Statistics> statistics_;
   std::vector<std::unique_ptr<curl::multi>> multis_;
+  const bool destination_affinity_;
+  const HttpVersion http_version_;
 
   static constexpr size_t kIdleQueueSize = 616;
   static constexpr size_t kIdleQueueAlignment = 8;
@@ -167,6 +197,8 @@ class Client final {
   rcu::Variable<std::vector<std::string>> allowed_urls_extra_;
 
   std::shared_ptr<curl::ConnectRateLimiter> connect_rate_limiter_;
+  std::shared_ptr<curl::share> share_;
+  std::unique_ptr<EndpointBalancer> endpoint_balancer_;
 
   clients::dns::Resolver* resolver_{nullptr};
 };
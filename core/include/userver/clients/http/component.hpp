@@ -11,6 +11,7 @@
 #include <userver/components/loggable_component_base.hpp>
 #include <userver/concurrent/async_event_source.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/utils/statistics/entry.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -39,6 +40,19 @@ namespace components {
 /// thread-name-prefix | set OS thread name to this value | ''
 /// threads | number of threads to process low level HTTP related IO system calls | 8
 /// defer-events | whether to defer events execution to a periodic timer; might affect timings a bit, might boost performance, use with care | false
+/// destination-affinity | whether to perform the requests to the same destination on the same thread to reuse the connections more often | false
+/// http-version | HTTP version of the requests that do not set it explicitly: default, 1.0, 1.1, 2, 2tls or 2-prior-knowledge | default
+/// retry-budget.enabled | whether the retries and the hedged attempts are limited by the per destination budget, see clients::http::RetryBudgetSettings | false
+/// retry-budget.max-tokens | max tokens of a destination, the retries are allowed while there are more than a half of them | 100
+/// retry-budget.token-ratio | tokens that a successful attempt returns to the budget, a failed one takes a token | 0.1
+/// load-balancing.policy | how to choose an address of the host for a request with the `dns_resolver: async`: none, power-of-two-choices or least-outstanding-requests; see clients::http::LoadBalancingSettings | none
+/// load-balancing.consecutive-errors | failed attempts in a row (network errors or 5xx) to eject the address | 5
+/// load-balancing.ejection-time | how long the ejected address gets no requests | 30s
+/// load-balancing.max-ejection-percent | max percent of the host addresses that are ejected at once | 50
+/// share-tls-sessions | whether to share the TLS sessions between the threads, so a handshake to an upstream made in one thread is resumed in the others | false
+/// share-dns-cache | whether to share the libcurl DNS cache between the threads | false
+/// warmup-urls | URLs to perform a HEAD request to at start in background to open the connections and to fill the TLS session cache | []
+/// http2-max-concurrent-streams | max number of the HTTP/2 streams per connection, a new connection is opened to the upstream over the limit; 0 for the libcurl default | 0
 /// fs-task-processor | task processor to run blocking HTTP related calls, like DNS resolving or hosts reading | -
 /// destination-metrics-auto-max-size | set max number of automatically created destination metrics | 100
 /// user-agent | User-Agent HTTP header to show on all requests, result of utils::GetUserverIdentifier() if empty | empty
@@ -70,10 +84,13 @@ class HttpClient final : public LoggableComponentBase {
 
   void ExtendStatistics(utils::statistics::Writer& writer);
 
+  void WarmUp(const std::vector<std::string>& urls);
+
   const bool disable_pool_stats_;
   clients::http::Client http_client_;
   concurrent::AsyncEventSubscriberScope subscriber_scope_;
   utils::statistics::Entry statistics_holder_;
+  engine::TaskWithResult<void> warmup_task_;
 };
 
 template <>
@@ -0,0 +1,66 @@
+#pragma once
+
+/// @file userver/clients/http/hedged_request.hpp
+/// @brief @copybrief clients::http::PerformHedged
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include <userver/clients/http/request.hpp>
+#include <userver/clients/http/response.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+/// @brief Settings of clients::http::PerformHedged
+struct HedgingSettings final {
+  /// Max number of the concurrent attempts, including the first one
+  std::size_t max_attempts{2};
+
+  /// Delay before starting the next attempt. If not set, the `percentile` of
+  /// the recent timings of the request destination is used, and there is no
+  /// hedging until the destination has the statistics.
+  std::optional<std::chrono::milliseconds> delay;
+
+  /// Percentile of the destination timings to use as the delay
+  double percentile{95};
+
+  /// Lower bound of the delay taken from the destination timings
+  std::chrono::milliseconds min_delay{1};
+};
+
+/// @ingroup userver_clients
+///
+/// @brief Performs a hedged request: if the attempt has no response after the
+/// delay, a backup attempt is started and the first response wins.
+///
+/// The attempts are made by `make_request`, the losers are cancelled. A
+/// response with a 5xx status code or an exception does not win while there
+/// are other attempts in flight. The backup attempts are not started while
+/// the retry budget of the destination is exhausted, see
+/// clients::http::RetryBudgetSettings.
+///
+/// @code
+/// auto response = clients::http::PerformHedged(
+///     [&] {
+///       return http_client.CreateRequest()
+///           ->get(url)
+///           ->timeout(std::chrono::milliseconds{500});
+///     },
+///     {});
+/// @endcode
+///
+/// @returns the winning response, or the last one if all of them have 5xx
+/// status codes
+/// @throws the exception of the last attempt if all of them have failed
+std::shared_ptr<Response> PerformHedged(
+    const std::function<std::shared_ptr<Request>()>& make_request,
+    const HedgingSettings& settings);
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
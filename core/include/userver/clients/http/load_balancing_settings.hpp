@@ -0,0 +1,38 @@
+#pragma once
+
+/// @file userver/clients/http/load_balancing_settings.hpp
+/// @brief @copybrief clients::http::LoadBalancingSettings
+
+#include <chrono>
+#include <cstddef>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+/// Selection of an address of the resolved host
+enum class LoadBalancing {
+  kNone,                      ///< the addresses in the resolver order
+  kPowerOfTwoChoices,         ///< the best of the two random addresses
+  kLeastOutstandingRequests,  ///< the address with the least requests
+};
+
+/// @brief Client side balancing between the addresses of a host
+///
+/// The addresses come from the clients::dns::Resolver, so the balancing works
+/// only with the `dns_resolver: async` static option of
+/// components::HttpClient.
+///
+/// An address with `consecutive-errors` failed attempts in a row (network
+/// errors or 5xx responses) is ejected for `ejection-time`. No more than
+/// `max-ejection-percent` of the host addresses are ejected at once.
+struct LoadBalancingSettings final {
+  LoadBalancing policy{LoadBalancing::kNone};
+  std::size_t consecutive_errors{5};
+  std::chrono::milliseconds ejection_time{30000};
+  std::size_t max_ejection_percent{50};
+};
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
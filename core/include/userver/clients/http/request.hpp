@@ -3,7 +3,9 @@
 /// @file userver/clients/http/request.hpp
 /// @brief @copybrief clients::http::Request
 
+#include <chrono>
 #include <memory>
+#include <optional>
 #include <string_view>
 #include <vector>
 
@@ -117,6 +119,17 @@ class Request final : public std::enable_shared_from_this<Request> {
   std::shared_ptr<Request> data(std::string data);
   /// form for POST request
   std::shared_ptr<Request> form(const Form& form);
+  /// @brief Body of the request that is sent as the producer of the `queue`
+  /// pushes its chunks, the body ends when the producers are gone.
+  ///
+  /// Without the `size` the body is sent with `Transfer-Encoding: chunked`,
+  /// so HTTP/1.1 or HTTP/2 is required. The body is not stored: the request
+  /// is not retried and may be performed only once with the queue.
+  ///
+  /// @snippet src/clients/http/client_test.cpp HTTP Client - data stream
+  std::shared_ptr<Request> data_stream(
+      const std::shared_ptr<concurrent::SpscQueue<std::string>>& queue,
+      std::optional<std::size_t> size = std::nullopt);
   /// Headers for request as map
   std::shared_ptr<Request> headers(const Headers& headers);
   /// Headers for request as list
@@ -161,7 +174,11 @@ class Request final : public std::enable_shared_from_this<Request> {
   /// Fault on that platform.
   std::shared_ptr<Request> client_key_cert(crypto::PrivateKey pkey,
                                            crypto::Certificate cert);
-  /// Set HTTP version
+  /// @brief Set HTTP version
+  ///
+  /// For the HTTP/2 versions the request waits for a connection that could be
+  /// multiplexed instead of opening a new one, so the concurrent requests to
+  /// the same upstream share a few connections.
   std::shared_ptr<Request> http_version(HttpVersion version);
 
   /// Specify number of retries on incorrect status, if on_failes is True
@@ -199,6 +216,11 @@ class Request final : public std::enable_shared_from_this<Request> {
   // Set deadline propagation settings. For internal use only.
   std::shared_ptr<Request> SetEnforceTaskDeadline(
       EnforceTaskDeadlineConfig enforce_task_deadline);
+
+  // Used by clients::http::PerformHedged. For internal use only.
+  bool IsRetryAllowedByBudget() const;
+  std::optional<std::chrono::milliseconds> GetDestinationTimingsPercentile(
+      double percent) const;
   /// @endcond
 
   /// Disable auto-decoding of received replies.
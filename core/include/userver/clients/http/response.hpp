@@ -55,7 +55,7 @@ class Response final {
   /// response string
   std::string& sink_string() { return response_; }
 
-  /// body as string
+  /// body as string, copies it; prefer body_view() or the rvalue overload
   std::string body() const& { return response_; }
   std::string&& body() && { return std::move(response_); }
 
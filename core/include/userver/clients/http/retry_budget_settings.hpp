@@ -0,0 +1,24 @@
+#pragma once
+
+/// @file userver/clients/http/retry_budget_settings.hpp
+/// @brief @copybrief clients::http::RetryBudgetSettings
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+/// @brief Per destination limit of the retries and the hedged attempts
+///
+/// Every failed attempt takes a token from the destination budget and every
+/// successful one returns `token_ratio` tokens. The retries are allowed while
+/// there are more than a half of `max_tokens`, so during an outage the
+/// retries stop instead of multiplying the load on the destination.
+struct RetryBudgetSettings final {
+  bool enabled{false};
+  double max_tokens{100};
+  double token_ratio{0.1};
+};
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
@@ -16,6 +16,7 @@ namespace components {
 ///
 /// The list contains:
 /// * components::Server
+/// * server::handlers::CpuProfiler
 /// * server::handlers::DnsClientControl
 /// * server::handlers::DynamicDebugLog
 /// * server::handlers::ImplicitOptionsHttpHandler
@@ -184,6 +184,16 @@ class ComponentContext final {
 
   void CancelComponentsLoad();
 
+  void LogLoadProfile() const;
+
+  bool WaitLazyLoading(std::string_view name) const;
+
+  void StartLazyLoading();
+
+  void OnLazyComponentLoaded(std::string_view name);
+
+  void OnLazyComponentLoadFailed(std::string_view name);
+
   [[noreturn]] void ThrowNonRegisteredComponent(std::string_view name,
                                                 std::string_view type) const;
   [[noreturn]] void ThrowComponentTypeMissmatch(
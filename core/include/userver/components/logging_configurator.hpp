@@ -4,6 +4,7 @@
 #include <userver/components/impl/component_base.hpp>
 #include <userver/concurrent/async_event_source.hpp>
 #include <userver/dynamic_config/source.hpp>
+#include <userver/utils/periodic_task.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -20,12 +21,14 @@ namespace components {
 ///
 /// ## Dynamic config
 /// * @ref USERVER_NO_LOG_SPANS
+/// * @ref USERVER_LOG_RATE_LIMIT
 ///
 /// ## Static options:
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
 /// limited-logging-enable | set to true to make LOG_LIMITED drop repeated logs | -
 /// limited-logging-interval | utils::StringToDuration suitable duration string to group repeated logs into one message | -
+/// rate-limit-summary-period | how often the counts of logs dropped by @ref USERVER_LOG_RATE_LIMIT are written | 10s
 ///
 /// ## Config example:
 ///
@@ -47,6 +50,7 @@ class LoggingConfigurator final : public impl::ComponentBase {
   void OnConfigUpdate(const dynamic_config::Snapshot& config);
 
   concurrent::AsyncEventSubscriberScope config_subscription_;
+  utils::PeriodicTask suppressed_logs_task_;
 };
 
 /// }@
@@ -12,6 +12,7 @@
 #include <userver/components/component_fwd.hpp>
 #include <userver/components/impl/component_base.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -107,6 +108,10 @@ class Manager final {
   components::ComponentContext component_context_;
   bool components_cleared_{false};
 
+  // used by the lazy components after the AddComponents() return
+  components::ComponentConfigMap component_config_map_;
+  std::vector<engine::TaskWithResult<void>> lazy_tasks_;
+
   engine::TaskProcessor* default_task_processor_{nullptr};
   const std::chrono::steady_clock::time_point start_time_;
   std::chrono::milliseconds load_duration_{0};
@@ -33,7 +33,14 @@ class Manager;
 /// coro_pool.initial_size | amount of coroutines to preallocate on startup | -
 /// coro_pool.max_size | max amount of coroutines to keep preallocated | -
 /// coro_pool.stack_size | size of a single coroutine | 256 * 1024
+/// coro_pool.local_cache_size | max amount of idle coroutines to keep in a per-thread cache in front of the shared pool, 0 disables the cache | 32
+/// coro_pool.lazy_stacks | map the coroutine stacks with MAP_NORESERVE and return the unused pages of idle stacks to the OS | false
+/// coro_pool.stack_usage_sample_rate | measure the stack usage of one in N finished coroutines and report the maximum per task processor, 0 disables the measurements | 1000
 /// event_thread_pool.threads | number of threads to process low level IO system calls (number of ev loops to start in libev) | -
+/// event_thread_pool.timer_wheel_slack | coalesce the task deadlines and sleeps within this slack in a per ev thread timer wheel instead of the libev timers, 0 disables the timer wheel | 0
+/// event_thread_pool.io_backend | `libev` or `io_uring` (Linux 5.7+, falls back to `libev` if unavailable) for the socket waits and fs:: file operations | libev
+/// event_thread_pool.affinity.cpus | CPUs to bind the event threads to in the Linux cpulist format, e.g. '0-3,8' | all the CPUs of `affinity.numa-node`
+/// event_thread_pool.affinity.numa-node | NUMA node to allocate the memory of event threads on | -
 /// components | dictionary of "component name": "options" | -
 /// default_task_processor | name of the default task processor to use in components | -
 /// task_processors.*NAME*.*OPTIONS* | dictionary of task processors to create and their options. See description below | -
@@ -45,6 +52,9 @@ class Manager;
 /// thread_name | set OS thread name to this value | -
 /// worker_threads | threads count for the task processor | -
 /// os-scheduling | OS scheduling mode for the task processor threads. 'idle' sets the lowest pririty. 'low-priority' sets the priority below 'normal' but higher than 'idle'. | normal
+/// task-processor-queue | Task queue mode for the task processor. 'global-task-queue' makes all the workers share a queue per engine::TaskPriority class, dequeued in a weighted round-robin. 'work-stealing-task-queue' gives each worker a local queue with a LIFO slot for the most recently woken task and lets idle workers steal tasks from others, engine::TaskPriority is ignored in this mode. | global-task-queue
+/// affinity.cpus | CPUs to bind the worker threads to in the Linux cpulist format, e.g. '0-3,8' | all the CPUs of `affinity.numa-node`
+/// affinity.numa-node | NUMA node to allocate the memory of worker threads on, coroutine stacks released by those threads are reused on the same node | -
 /// task-trace | optional dictionary of tracing options | empty (disabled)
 /// task-trace.every | set N to trace each Nth task | 1000
 /// task-trace.max-context-switch-count | set upper limit of context switches to trace for a single task | 1000
@@ -75,6 +85,7 @@ class ManagerControllerComponent final : public impl::ComponentBase {
 
   const components::Manager& components_manager_;
   utils::statistics::Entry statistics_holder_;
+  utils::statistics::Entry logger_statistics_holder_;
   concurrent::AsyncEventSubscriberScope config_subscription_;
 };
 
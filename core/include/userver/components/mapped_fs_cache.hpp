@@ -0,0 +1,53 @@
+#pragma once
+
+/// @file userver/components/mapped_fs_cache.hpp
+/// @brief @copybrief components::MappedFsCache
+
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/fs/mapped_fs_cache_client.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components {
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief Component for serving files from the memory mapped page cache
+///
+/// Unlike components::FsCache the files are not copied into the heap and not
+/// read at startup, see fs::MappedFsCacheClient for details.
+///
+/// ## Static options:
+///
+/// Name              | Description                                          | Default value
+/// ----------------- | ---------------------------------------------------- | -------------
+/// dir               | directory to serve files from                        | /var/www
+/// max-files         | how many recently used files to keep open and mapped | 1000
+/// fs-task-processor | task processor to do filesystem operations           | fs-task-processor
+
+// clang-format on
+
+class MappedFsCache final : public components::LoggableComponentBase {
+ public:
+  using Client = fs::MappedFsCacheClient;
+
+  MappedFsCache(const components::ComponentConfig& config,
+                const components::ComponentContext& context);
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+  const Client& GetClient() const;
+
+ private:
+  Client client_;
+};
+
+template <>
+inline constexpr bool kHasValidate<MappedFsCache> = true;
+
+}  // namespace components
+
+USERVER_NAMESPACE_END
@@ -23,6 +23,15 @@ namespace components {
 ///
 /// The component does **not** have any options for service config.
 ///
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// yield-between-writers | yield the task after each metrics writer | false
+/// writers-time-budget | skip the rest of the metrics writers once the writers of a single metrics request took that much time | 0 (no limit)
+/// report-writers-durations | write the `statistics.writers.duration-us` metrics with the time of the writers of each prefix (label `statistics_prefix`) during the previous metrics request and the `statistics.writers.budget-exceeded` counter | false
+///
+/// See utils::statistics::VisitSettings for details.
+///
 /// ## Static configuration example:
 ///
 /// @snippet components/common_component_list_test.cpp  Sample statistics storage component config
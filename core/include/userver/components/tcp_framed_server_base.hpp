@@ -0,0 +1,96 @@
+#pragma once
+
+/// @file userver/components/tcp_framed_server_base.hpp
+/// @brief @copybrief components::TcpFramedServerBase
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <userver/components/tcp_acceptor_base.hpp>
+#include <userver/utils/statistics/entry.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components {
+
+namespace impl {
+class FrameCodec;
+}  // namespace impl
+
+// clang-format off
+
+/// @ingroup userver_base_classes userver_components
+///
+/// @brief Base component for TCP servers of framed request-response protocols.
+///
+/// Each incoming frame is passed to HandleFrame of the derived class in a
+/// separate task, so up to `max_pipelined_requests` frames of a connection are
+/// handled concurrently. The responses are written in the order of the
+/// requests, the ready ones are written with a single syscall. The frames are
+/// not copied out of the receive buffer.
+///
+/// Frames are either a 4-byte big-endian payload size followed by the payload
+/// (`length-prefixed`), or the payload followed by the `delimiter`. Responses
+/// are framed the same way. A connection that sends a frame larger than
+/// `max_frame_size` is closed.
+///
+/// ## Static options:
+/// All the options of components::TcpAcceptorBase and:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// framing | `length-prefixed` or `delimiter` | length-prefixed
+/// delimiter | frame delimiter for `delimiter` framing | '\\n'
+/// max_frame_size | max size of a frame payload in bytes | 1048576
+/// max_connections | connections above the limit are closed right away | unlimited
+/// max_pipelined_requests | max count of the frames of a connection that are handled concurrently | 16
+/// read_buffer_size | size of the receive buffer chunks in bytes | 16384
+///
+/// ## Statistics:
+/// Written with the `tcp-framed-server` prefix and the `server_name` label set
+/// to the component name:
+/// - connections.active, connections.opened, connections.rejected
+/// - frames.received, frames.sent
+/// - bytes.received, bytes.sent
+/// - errors.frame-too-large, errors.handler
+
+// clang-format on
+class TcpFramedServerBase : public TcpAcceptorBase {
+ public:
+  TcpFramedServerBase(const ComponentConfig&, const ComponentContext&);
+  ~TcpFramedServerBase() override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ protected:
+  /// Override this function to handle the request frames.
+  ///
+  /// @returns the response payload
+  /// @throws std::exception to close the connection
+  /// @warning The function is called concurrently for the frames of the same
+  /// and of different connections. `frame` is valid until the function
+  /// returns.
+  virtual std::string HandleFrame(std::string_view frame) = 0;
+
+ private:
+  class Connection;
+  struct Statistics;
+
+  void ProcessSocket(engine::io::Socket&& sock) final;
+
+  void WriteStatistics(utils::statistics::Writer& writer) const;
+
+  std::unique_ptr<const impl::FrameCodec> codec_;
+  const std::optional<std::size_t> max_connections_;
+  const std::size_t max_pipelined_requests_;
+  const std::size_t read_buffer_size_;
+  std::unique_ptr<Statistics> stats_;
+  utils::statistics::Entry statistics_holder_;
+};
+
+}  // namespace components
+
+USERVER_NAMESPACE_END
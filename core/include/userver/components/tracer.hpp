@@ -26,6 +26,10 @@ namespace components {
 /// ---- | ----------- | -------------
 /// service-name | name of the service to write in traces | -
 /// tracer | type of the tracer to trace, currently supported only 'native' | 'native'
+/// sampling.head-probability | probability of a new trace to be logged, the decision is inherited by the child spans and propagated to other services | 1.0
+/// sampling.tail.enabled | buffer the spans of the traces that were not head sampled and log them if the root span was slow, errored or hit a testpoint | false
+/// sampling.tail.slow-threshold | minimal duration of the root span of a slow trace | 1s
+/// sampling.tail.max-spans | limit on the buffered spans of a single trace, spans over the limit are lost | 1000
 ///
 /// ## Static configuration example:
 ///
@@ -3,7 +3,12 @@
 /// @file userver/concurrent/async_event_channel.hpp
 /// @brief @copybrief concurrent::AsyncEventChannel
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <typeindex>
@@ -16,15 +21,63 @@
 #include <userver/engine/mutex.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/async.hpp>
 #include <userver/utils/clang_format_workarounds.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+#include <userver/utils/statistics/fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace concurrent {
 
+/// @brief Statistics of a listener of concurrent::AsyncEventChannel
+struct AsyncEventListenerStatistics final {
+  /// Name of the listener
+  std::string name;
+
+  /// Events handled by the listener
+  std::uint64_t events{0};
+
+  /// Time the listener spent on the last event
+  std::chrono::microseconds last_duration{0};
+
+  /// Max time the listener spent on an event
+  std::chrono::microseconds max_duration{0};
+};
+
+/// @brief Statistics of concurrent::AsyncEventChannel
+///
+/// DumpMetric writes the listeners with the `listener` label set to the name.
+struct AsyncEventChannelStatistics final {
+  std::vector<AsyncEventListenerStatistics> listeners;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const AsyncEventListenerStatistics& stats);
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const AsyncEventChannelStatistics& stats);
+
 namespace impl {
 
+// Updated by the listener tasks, read by the statistics without waiting for
+// the event to be handled
+class ListenerTimings final {
+ public:
+  explicit ListenerTimings(std::string name) : name_(std::move(name)) {}
+
+  void Account(std::chrono::steady_clock::duration duration) noexcept;
+
+  AsyncEventListenerStatistics GetStatistics() const;
+
+ private:
+  const std::string name_;
+  std::atomic<std::uint64_t> events_{0};
+  std::atomic<std::int64_t> last_duration_us_{0};
+  std::atomic<std::int64_t> max_duration_us_{0};
+};
+
 void WaitForTask(std::string_view name, engine::TaskWithResult<void>& task);
 
 [[noreturn]] void ReportAlreadySubscribed(std::string_view channel_name,
@@ -43,6 +96,11 @@ std::string MakeAsyncChannelName(std::string_view base, std::string_view name);
 ///
 /// AsyncEventChannel is an in-process pub-sub with strict FIFO serialization.
 ///
+/// Each listener handles an event in a separate task, so SendEvent takes
+/// about as long as the slowest listener. The count of such concurrent tasks
+/// may be limited. Use ConflatedEventChannel to skip the intermediate events
+/// for slow listeners.
+///
 /// Example usage:
 /// @snippet concurrent/async_event_channel_test.cpp  AsyncEventChannel sample
 template <typename... Args>
@@ -52,7 +110,19 @@ class AsyncEventChannel : public AsyncEventSource<Args...> {
 
   /// @brief The primary constructor
   /// @param name used for diagnostic purposes and is also accessible with Name
-  explicit AsyncEventChannel(std::string name) : name_(std::move(name)) {}
+  explicit AsyncEventChannel(std::string name)
+      : AsyncEventChannel(std::move(name),
+                          std::numeric_limits<std::size_t>::max()) {}
+
+  /// @param name used for diagnostic purposes and is also accessible with Name
+  /// @param max_parallel_listeners max count of listeners that handle an event
+  /// concurrently, the rest start as the previous ones finish
+  AsyncEventChannel(std::string name, std::size_t max_parallel_listeners)
+      : name_(std::move(name)),
+        max_parallel_listeners_(max_parallel_listeners) {
+    UINVARIANT(max_parallel_listeners_ > 0,
+               "max_parallel_listeners must be positive");
+  }
 
   /// @brief For use in `UpdateAndListen` of specific event channels
   ///
@@ -89,26 +159,53 @@ class AsyncEventChannel : public AsyncEventSource<Args...> {
     std::vector<engine::TaskWithResult<void>> tasks;
     tasks.reserve(listeners->size());
 
-    for (const auto& [_, listener] : *listeners) {
-      tasks.push_back(utils::Async(
-          listener.task_name,
-          [&, &callback = listener.callback] { callback(args...); }));
+    // Tasks are started in the order of waiting, so that at most
+    // max_parallel_listeners_ of them are running
+    auto next_listener = listeners->begin();
+    const auto start_next_task = [&] {
+      const auto& listener = next_listener->second;
+      ++next_listener;
+      tasks.push_back(utils::Async(listener.task_name, [&] {
+        const auto start = std::chrono::steady_clock::now();
+        const utils::FastScopeGuard account([&]() noexcept {
+          listener.timings->Account(std::chrono::steady_clock::now() - start);
+        });
+        listener.callback(args...);
+      }));
+    };
+
+    while (next_listener != listeners->end() &&
+           tasks.size() < max_parallel_listeners_) {
+      start_next_task();
     }
 
     std::size_t i = 0;
     for (const auto& [_, listener] : *listeners) {
       impl::WaitForTask(listener.name, tasks[i++]);
+      if (next_listener != listeners->end()) start_next_task();
     }
   }
 
   /// @returns the name of this event channel
   const std::string& Name() const noexcept { return name_; }
 
+  /// @returns the timings of the listeners, does not wait for SendEvent
+  AsyncEventChannelStatistics GetStatistics() const {
+    AsyncEventChannelStatistics stats;
+    auto timings = timings_.Lock();
+    stats.listeners.reserve(timings->size());
+    for (const auto& [_, listener_timings] : *timings) {
+      stats.listeners.push_back(listener_timings->GetStatistics());
+    }
+    return stats;
+  }
+
  private:
   struct Listener final {
     std::string name;
     Function callback;
     std::string task_name;
+    std::shared_ptr<impl::ListenerTimings> timings;
   };
 
   void RemoveListener(FunctionId id, UnsubscribingKind kind) noexcept final {
@@ -125,22 +222,35 @@ class AsyncEventChannel : public AsyncEventSource<Args...> {
       impl::ReportUnsubscribingAutomatically(name_, iter->second.name);
     }
     listeners->erase(iter);
+
+    auto timings = timings_.Lock();
+    timings->erase(id);
   }
 
   AsyncEventSubscriberScope DoAddListener(FunctionId id, std::string_view name,
                                           Function&& func) final {
     auto listeners = listeners_.Lock();
     auto task_name = impl::MakeAsyncChannelName(name_, name);
+    auto timings = std::make_shared<impl::ListenerTimings>(std::string{name});
     const auto [iterator, success] = listeners->emplace(
-        id, Listener{std::string{name}, std::move(func), std::move(task_name)});
+        id, Listener{std::string{name}, std::move(func), std::move(task_name),
+                     timings});
     if (!success) impl::ReportAlreadySubscribed(Name(), name);
+
+    auto all_timings = timings_.Lock();
+    all_timings->emplace(id, std::move(timings));
     return AsyncEventSubscriberScope(*this, id);
   }
 
   const std::string name_;
+  const std::size_t max_parallel_listeners_;
   concurrent::Variable<
       std::unordered_map<FunctionId, Listener, FunctionId::Hash>>
       listeners_;
+  // Separate from listeners_, which is locked for the whole SendEvent
+  concurrent::Variable<std::unordered_map<
+      FunctionId, std::shared_ptr<impl::ListenerTimings>, FunctionId::Hash>>
+      timings_;
   mutable engine::Mutex event_mutex_;
 };
 
@@ -3,12 +3,17 @@
 /// @file userver/concurrent/background_task_storage.hpp
 /// @brief @copybrief concurrent::BackgroundTaskStorage
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <utility>
 
 #include <userver/engine/impl/detached_tasks_sync_block.hpp>
+#include <userver/engine/semaphore.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/utils/async.hpp>
+#include <userver/utils/impl/wrapped_call.hpp>
+#include <userver/utils/statistics/fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -43,6 +48,50 @@ class BackgroundTaskStorageCore final {
   std::optional<engine::impl::DetachedTasksSyncBlock> sync_block_;
 };
 
+/// What concurrent::BackgroundTaskStorage does with a new task if
+/// BackgroundTaskStorageLimits::max_tasks tasks are already unfinished
+enum class BackgroundTaskOverflowPolicy {
+  /// Drop the task, AsyncDetach returns `false`
+  kReject,
+
+  /// Run the task synchronously in the calling task, exceptions are propagated
+  /// to the caller
+  kRunInline,
+
+  /// Wait for any of the unfinished tasks to finish
+  kWait,
+};
+
+/// Limits of concurrent::BackgroundTaskStorage
+struct BackgroundTaskStorageLimits final {
+  /// Max count of the unfinished tasks started by AsyncDetach
+  std::size_t max_tasks{0};
+
+  BackgroundTaskOverflowPolicy overflow_policy{
+      BackgroundTaskOverflowPolicy::kReject};
+};
+
+/// @brief Statistics of concurrent::BackgroundTaskStorage
+struct BackgroundTaskStorageStatistics final {
+  /// Approximate number of the unfinished tasks
+  std::int64_t active_tasks{0};
+
+  /// BackgroundTaskStorageLimits::max_tasks, zero if there is no limit
+  std::size_t max_tasks{0};
+
+  /// Tasks dropped due to BackgroundTaskOverflowPolicy::kReject
+  std::uint64_t rejected{0};
+
+  /// Tasks run due to BackgroundTaskOverflowPolicy::kRunInline
+  std::uint64_t ran_inline{0};
+
+  /// Tasks started after BackgroundTaskOverflowPolicy::kWait
+  std::uint64_t waited{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const BackgroundTaskStorageStatistics& stats);
+
 /// @ingroup userver_concurrency userver_containers
 ///
 /// A storage that allows one to start detached tasks; cancels and waits for
@@ -53,6 +102,10 @@ class BackgroundTaskStorageCore final {
 /// limited lifetime. You must guarantee that the resources are available while
 /// the BackgroundTaskStorage is alive.
 ///
+/// The count of the unfinished tasks may be bounded with
+/// BackgroundTaskStorageLimits, e.g. for fire-and-forget writes that must not
+/// pile up under load.
+///
 /// ## Usage synopsis
 /// @snippet concurrent/background_task_storage_test.cpp  Sample
 class BackgroundTaskStorage final {
@@ -64,8 +117,18 @@ class BackgroundTaskStorage final {
   /// Creates a BTS that launches tasks in the specified engine::TaskProcessor.
   explicit BackgroundTaskStorage(engine::TaskProcessor& task_processor);
 
+  /// Creates a BTS that launches at most `limits.max_tasks` unfinished tasks
+  /// in the engine::TaskProcessor used at the BTS creation.
+  explicit BackgroundTaskStorage(BackgroundTaskStorageLimits limits);
+
+  /// Creates a BTS that launches at most `limits.max_tasks` unfinished tasks
+  /// in the specified engine::TaskProcessor.
+  BackgroundTaskStorage(engine::TaskProcessor& task_processor,
+                        BackgroundTaskStorageLimits limits);
+
   BackgroundTaskStorage(const BackgroundTaskStorage&) = delete;
   BackgroundTaskStorage& operator=(const BackgroundTaskStorage&) = delete;
+  ~BackgroundTaskStorage();
 
   /// Explicitly cancel and wait for the tasks. New tasks must not be launched
   /// after this call returns. Should be called no more than once.
@@ -77,27 +140,73 @@ class BackgroundTaskStorage final {
   /// The task is started as non-Critical, it may be cancelled due to
   /// `TaskProcessor` overload. engine::TaskInheritedVariable instances are not
   /// inherited from the caller. See utils::AsyncBackground for details.
+  ///
+  /// If there are BackgroundTaskStorageLimits::max_tasks unfinished tasks,
+  /// the task is handled according to the BackgroundTaskOverflowPolicy.
+  ///
+  /// @returns `false` if the task was rejected
   template <typename... Args>
-  void AsyncDetach(std::string name, Args&&... args) {
-    core_.Detach(utils::AsyncBackground(std::move(name), task_processor_,
-                                        std::forward<Args>(args)...));
+  bool AsyncDetach(std::string name, Args&&... args) {
+    return DoAsyncDetach(task_processor_, std::move(name),
+                         std::forward<Args>(args)...);
   }
 
   /// @deprecated Pass engine::TaskProcessor to BTS constructor instead.
   template <typename... Args>
-  void AsyncDetach(engine::TaskProcessor& task_processor, std::string name,
+  bool AsyncDetach(engine::TaskProcessor& task_processor, std::string name,
                    Args&&... args) {
-    core_.Detach(utils::AsyncBackground(std::move(name), task_processor,
-                                        std::forward<Args>(args)...));
+    return DoAsyncDetach(task_processor, std::move(name),
+                         std::forward<Args>(args)...);
   }
 
   /// @deprecated Use AsyncDetach or BackgroundTaskStorageCore instead.
+  /// The task is not accounted in BackgroundTaskStorageLimits.
   void Detach(engine::Task&& task) { core_.Detach(std::move(task)); }
 
   /// Approximate number of currently active tasks
   std::int64_t ActiveTasksApprox() const noexcept;
 
+  BackgroundTaskStorageStatistics GetStatistics() const;
+
  private:
+  struct Limiter;
+
+  template <typename... Args>
+  bool DoAsyncDetach(engine::TaskProcessor& task_processor, std::string name,
+                     Args&&... args) {
+    if (!limiter_) {
+      core_.Detach(utils::AsyncBackground(std::move(name), task_processor,
+                                          std::forward<Args>(args)...));
+      return true;
+    }
+
+    auto slot = AcquireSlot();
+    if (!slot) {
+      if (!ShouldRunInline()) return false;
+      auto call = utils::impl::WrapCall(std::forward<Args>(args)...);
+      call->Perform();
+      call->Retrieve();
+      return true;
+    }
+
+    // The slot is released along with the payload of the task, before the
+    // task is considered finished by core_
+    core_.Detach(utils::AsyncBackground(
+        std::move(name), task_processor,
+        [slot = std::move(slot)](auto&& func, auto&&... func_args) {
+          return std::invoke(std::forward<decltype(func)>(func),
+                             std::forward<decltype(func_args)>(func_args)...);
+        },
+        std::forward<Args>(args)...));
+    return true;
+  }
+
+  // Returns an empty lock if the task must not be launched
+  engine::SemaphoreLock AcquireSlot();
+  bool ShouldRunInline() const noexcept;
+
+  // Must outlive core_, the tasks hold its slots
+  std::unique_ptr<Limiter> limiter_;
   BackgroundTaskStorageCore core_;
   engine::TaskProcessor& task_processor_;
 };
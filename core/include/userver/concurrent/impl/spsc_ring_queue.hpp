@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <userver/concurrent/impl/interference_shield.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent::impl {
+
+/// @brief Unbounded lock-free single producer single consumer FIFO queue.
+///
+/// Items are stored in ring buffers. In the steady state the producer and the
+/// consumer chase each other around a single ring without allocations. When
+/// the ring is full the producer links a bigger ring after it, and the consumer
+/// frees the old ring once it is drained.
+///
+/// Push* must be called from a single thread at a time, TryPop* must be called
+/// from a single thread at a time.
+template <typename T>
+class SpscRingQueue final {
+ public:
+  explicit SpscRingQueue(std::size_t capacity_hint = 0)
+      : producer_ring_(new Ring(RoundUpCapacity(capacity_hint))),
+        consumer_ring_(producer_ring_) {}
+
+  SpscRingQueue(SpscRingQueue&&) = delete;
+  SpscRingQueue& operator=(SpscRingQueue&&) = delete;
+
+  ~SpscRingQueue() {
+    Ring* ring = consumer_ring_;
+    while (ring) {
+      const auto tail = ring->tail.load(std::memory_order_acquire);
+      for (auto i = ring->head.load(std::memory_order_relaxed); i != tail;
+           ++i) {
+        ring->At(i)->~T();
+      }
+      Ring* next = ring->next.load(std::memory_order_acquire);
+      delete ring;
+      ring = next;
+    }
+  }
+
+  template <typename U>
+  void Push(U&& value) {
+    Ring* ring = producer_ring_;
+    auto tail = ring->tail.load(std::memory_order_relaxed);
+    if (GetFreeSpace(*ring, tail, 1) == 0) {
+      ring = LinkRing(1);
+      tail = 0;
+    }
+    new (ring->At(tail)) T(std::forward<U>(value));
+    ring->tail.store(tail + 1, std::memory_order_release);
+  }
+
+  /// Pushes `count` items constructed from `*first++`, making them visible to
+  /// the consumer once per ring rather than once per item
+  template <typename Iterator>
+  void PushBulk(Iterator first, std::size_t count) {
+    while (count != 0) {
+      Ring* ring = producer_ring_;
+      auto tail = ring->tail.load(std::memory_order_relaxed);
+      auto chunk = std::min(count, GetFreeSpace(*ring, tail, count));
+      if (chunk == 0) {
+        ring = LinkRing(count);
+        tail = 0;
+        chunk = std::min(count, ring->mask + 1);
+      }
+      ConstructAndPublish(*ring, tail, first, chunk);
+      count -= chunk;
+    }
+  }
+
+  [[nodiscard]] bool TryPop(T& value) { return TryPopBulk(&value, 1) == 1; }
+
+  /// Pops up to `max_count` items into `*out++`, returns the amount popped
+  template <typename OutputIterator>
+  std::size_t TryPopBulk(OutputIterator out, std::size_t max_count) {
+    std::size_t popped = 0;
+    while (popped < max_count) {
+      Ring* ring = consumer_ring_;
+      const auto head = ring->head.load(std::memory_order_relaxed);
+      const auto available = GetAvailable(*ring, head);
+      if (available == 0) {
+        Ring* next = ring->next.load(std::memory_order_acquire);
+        if (!next) break;
+
+        // The producer has moved on, but it might have pushed into the current
+        // ring right before that
+        if (GetAvailable(*ring, head) != 0) continue;
+
+        delete ring;
+        consumer_ring_ = next;
+        consumer_cached_tail_ = 0;
+        continue;
+      }
+
+      const auto chunk = std::min(available, max_count - popped);
+      for (std::size_t i = 0; i < chunk; ++i) {
+        T* item = ring->At(head + i);
+        *out = std::move(*item);
+        ++out;
+        item->~T();
+      }
+      ring->head.store(head + chunk, std::memory_order_release);
+      popped += chunk;
+    }
+    return popped;
+  }
+
+ private:
+  static constexpr std::size_t kMinRingCapacity = 32;
+  static constexpr std::size_t kMaxRingCapacity = 16384;
+
+  struct Ring final {
+    explicit Ring(std::size_t capacity)
+        : mask(capacity - 1), slots(new Slot[capacity]) {}
+
+    T* At(std::size_t index) noexcept {
+      return std::launder(reinterpret_cast<T*>(&slots[index & mask]));
+    }
+
+    using Slot = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+    // Written by the consumer only
+    alignas(kDestructiveInterferenceSize) std::atomic<std::size_t> head{0};
+    // Written by the producer only
+    alignas(kDestructiveInterferenceSize) std::atomic<std::size_t> tail{0};
+    std::atomic<Ring*> next{nullptr};
+
+    alignas(kDestructiveInterferenceSize) const std::size_t mask;
+    const std::unique_ptr<Slot[]> slots;
+  };
+
+  static std::size_t RoundUpCapacity(std::size_t capacity) noexcept {
+    std::size_t result = kMinRingCapacity;
+    while (result < capacity && result < kMaxRingCapacity) result *= 2;
+    return result;
+  }
+
+  std::size_t GetFreeSpace(Ring& ring, std::size_t tail,
+                           std::size_t required) noexcept {
+    const auto capacity = ring.mask + 1;
+    if (capacity - (tail - producer_cached_head_) < required) {
+      producer_cached_head_ = ring.head.load(std::memory_order_acquire);
+    }
+    return capacity - (tail - producer_cached_head_);
+  }
+
+  std::size_t GetAvailable(Ring& ring, std::size_t head) noexcept {
+    if (consumer_cached_tail_ == head) {
+      consumer_cached_tail_ = ring.tail.load(std::memory_order_acquire);
+    }
+    return consumer_cached_tail_ - head;
+  }
+
+  template <typename Iterator>
+  static void ConstructAndPublish(Ring& ring, std::size_t tail,
+                                  Iterator& first, std::size_t count) {
+    std::size_t constructed = 0;
+    try {
+      for (; constructed < count; ++constructed, ++first) {
+        new (ring.At(tail + constructed)) T(*first);
+      }
+    } catch (...) {
+      ring.tail.store(tail + constructed, std::memory_order_release);
+      throw;
+    }
+    ring.tail.store(tail + count, std::memory_order_release);
+  }
+
+  // The consumer may switch to the new ring before anything is published there
+  Ring* LinkRing(std::size_t required) {
+    const auto capacity = (producer_ring_->mask + 1) * 2;
+    auto* next = new Ring(RoundUpCapacity(std::max(capacity, required)));
+    producer_ring_->next.store(next, std::memory_order_release);
+    producer_ring_ = next;
+    producer_cached_head_ = 0;
+    return next;
+  }
+
+  // Accessed by the producer only
+  alignas(kDestructiveInterferenceSize) Ring* producer_ring_;
+  std::size_t producer_cached_head_{0};
+
+  // Accessed by the consumer only
+  alignas(kDestructiveInterferenceSize) Ring* consumer_ring_;
+  std::size_t consumer_cached_tail_{0};
+};
+
+}  // namespace concurrent::impl
+
+USERVER_NAMESPACE_END
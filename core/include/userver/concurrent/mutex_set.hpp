@@ -4,8 +4,10 @@
 /// @brief @copybrief concurrent::MutexSet
 
 #include <chrono>
+#include <cstddef>
 #include <functional>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
@@ -36,6 +38,34 @@ struct MutexDatum final {
   std::unordered_set<T, std::hash<T>, Equal> set;
 };
 
+struct SharedMutexState final {
+  bool IsFree() const noexcept {
+    return readers == 0 && !writer && waiting_writers == 0;
+  }
+
+  std::size_t readers{0};
+  // Readers do not take the lock while a writer waits for it, so that
+  // a stream of readers does not starve the writers
+  std::size_t waiting_writers{0};
+  bool writer{false};
+};
+
+template <typename T, typename Equal>
+struct SharedMutexDatum final {
+  explicit SharedMutexDatum(size_t way_size, const Equal& equal = Equal{})
+      : states(way_size, {}, equal) {}
+
+  ~SharedMutexDatum() {
+    UASSERT_MSG(states.empty(),
+                "SharedMutexDatum is destroyed while someone is holding the "
+                "lock");
+  }
+
+  engine::Mutex mutex;
+  engine::ConditionVariable cv;
+  std::unordered_map<T, SharedMutexState, std::hash<T>, Equal> states;
+};
+
 }  // namespace impl
 
 /// Mutex-like object associated with the key of a MutexSet. It provides the
@@ -102,6 +132,92 @@ class MutexSet final : Hash {
   utils::FixedArray<MutexDatum> mutex_data_;
 };
 
+/// SharedMutex-like object associated with the key of a SharedMutexSet. It
+/// provides the same interface as engine::SharedMutex, you may use it with
+/// std::unique_lock, std::shared_lock, etc.
+/// @note different SharedItemMutex'es of the same SharedMutexSet obtained with
+///       the same argument to GetMutexForKey() share the same critical
+///       section.
+/// @note can be used only from coroutines.
+template <typename Key, typename Equal>
+class SharedItemMutex final {
+ public:
+  using HashAndKey = utils::CachedHash<Key>;
+
+  using MutexDatum =
+      impl::SharedMutexDatum<HashAndKey, utils::CachedHashKeyEqual<Equal>>;
+
+  SharedItemMutex(MutexDatum& md, HashAndKey&& key);
+
+  void lock();
+
+  void unlock();
+
+  bool try_lock();
+
+  template <typename Rep, typename Period>
+  bool try_lock_for(std::chrono::duration<Rep, Period>);
+
+  template <typename Clock, typename Duration>
+  bool try_lock_until(std::chrono::time_point<Clock, Duration>);
+
+  void lock_shared();
+
+  void unlock_shared();
+
+  bool try_lock_shared();
+
+  template <typename Rep, typename Period>
+  bool try_lock_shared_for(std::chrono::duration<Rep, Period>);
+
+  template <typename Clock, typename Duration>
+  bool try_lock_shared_until(std::chrono::time_point<Clock, Duration>);
+
+ private:
+  impl::SharedMutexState& GetState();
+
+  bool TryFinishLocking(impl::SharedMutexState& state) noexcept;
+
+  bool TryFinishLockingShared(impl::SharedMutexState& state) noexcept;
+
+  template <typename Wait>
+  bool DoLock(Wait wait);
+
+  void ReleaseState(impl::SharedMutexState& state);
+
+  MutexDatum& md_;
+  const HashAndKey key_;
+};
+
+/// @ingroup userver_concurrency userver_containers
+///
+/// @brief A dynamic set of shared mutexes
+///
+/// Same as concurrent::MutexSet, but the per-key critical sections may be
+/// entered by multiple readers at once. Waiting writers have priority over
+/// the new readers of the same key.
+///
+/// Example:
+/// @snippet src/concurrent/mutex_set_test.cpp  Sample shared mutex set usage
+template <typename Key = std::string, typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class SharedMutexSet final : Hash {
+ public:
+  explicit SharedMutexSet(size_t ways = 1, size_t way_size = 1,
+                          const Hash& hash = Hash{},
+                          const Equal& equal = Equal{});
+
+  /// Get the shared-mutex-like object for a key. Coroutine-safe.
+  /// @note the returned object holds a reference to SharedMutexSet, so make
+  ///       sure that SharedMutexSet is alive while you're working with
+  ///       SharedItemMutex.
+  SharedItemMutex<Key, Equal> GetMutexForKey(Key key);
+
+ private:
+  using MutexDatum = typename SharedItemMutex<Key, Equal>::MutexDatum;
+  utils::FixedArray<MutexDatum> mutex_data_;
+};
+
 template <typename Key, typename Hash, typename Equal>
 MutexSet<Key, Hash, Equal>::MutexSet(size_t ways, size_t way_size,
                                      const Hash& hash, const Equal& equal)
@@ -186,6 +302,182 @@ bool ItemMutex<Key, Equal>::TryFinishLocking() {
   return md_.set.insert(key_).second;
 }
 
+template <typename Key, typename Hash, typename Equal>
+SharedMutexSet<Key, Hash, Equal>::SharedMutexSet(size_t ways, size_t way_size,
+                                                 const Hash& hash,
+                                                 const Equal& equal)
+    : Hash(hash),
+      mutex_data_(ways, way_size, utils::CachedHashKeyEqual<Equal>{equal}) {}
+
+template <typename Key, typename Hash, typename Equal>
+SharedItemMutex<Key, Equal> SharedMutexSet<Key, Hash, Equal>::GetMutexForKey(
+    Key key) {
+  const auto hash_value = Hash::operator()(key);
+  const auto size = mutex_data_.size();
+
+  const auto way = hash_value % size;
+  const auto new_hash = hash_value / size;
+
+  return SharedItemMutex<Key, Equal>(mutex_data_[way],
+                                     {new_hash, std::move(key)});
+}
+
+template <typename Key, typename Equal>
+SharedItemMutex<Key, Equal>::SharedItemMutex(MutexDatum& md, HashAndKey&& key)
+    : md_(md), key_(std::move(key)) {}
+
+template <typename Key, typename Equal>
+void SharedItemMutex<Key, Equal>::lock() {
+  engine::TaskCancellationBlocker blocker;
+  [[maybe_unused]] auto is_locked = DoLock([](auto& cv, auto& lock, auto pred) {
+    return cv.Wait(lock, std::move(pred));
+  });
+  UASSERT(is_locked);
+}
+
+template <typename Key, typename Equal>
+void SharedItemMutex<Key, Equal>::unlock() {
+  std::unique_lock lock(md_.mutex);
+  auto& state = GetState();
+  UASSERT(state.writer);
+  state.writer = false;
+  ReleaseState(state);
+  md_.cv.NotifyAll();
+}
+
+template <typename Key, typename Equal>
+bool SharedItemMutex<Key, Equal>::try_lock() {
+  std::unique_lock lock(md_.mutex);
+  auto& state = GetState();
+  if (TryFinishLocking(state)) return true;
+  ReleaseState(state);
+  return false;
+}
+
+template <typename Key, typename Equal>
+template <typename Rep, typename Period>
+bool SharedItemMutex<Key, Equal>::try_lock_for(
+    std::chrono::duration<Rep, Period> duration) {
+  return DoLock([duration](auto& cv, auto& lock, auto pred) {
+    return cv.WaitFor(lock, duration, std::move(pred));
+  });
+}
+
+template <typename Key, typename Equal>
+template <typename Clock, typename Duration>
+bool SharedItemMutex<Key, Equal>::try_lock_until(
+    std::chrono::time_point<Clock, Duration> time_point) {
+  return DoLock([time_point](auto& cv, auto& lock, auto pred) {
+    return cv.WaitUntil(lock, time_point, std::move(pred));
+  });
+}
+
+template <typename Key, typename Equal>
+void SharedItemMutex<Key, Equal>::lock_shared() {
+  engine::TaskCancellationBlocker blocker;
+  std::unique_lock lock(md_.mutex);
+  auto& state = GetState();
+
+  [[maybe_unused]] auto is_locked =
+      md_.cv.Wait(lock, [&] { return TryFinishLockingShared(state); });
+  UASSERT(is_locked);
+}
+
+template <typename Key, typename Equal>
+void SharedItemMutex<Key, Equal>::unlock_shared() {
+  std::unique_lock lock(md_.mutex);
+  auto& state = GetState();
+  UASSERT(state.readers > 0);
+  --state.readers;
+  const bool is_last_reader = state.readers == 0;
+  ReleaseState(state);
+  if (is_last_reader) md_.cv.NotifyAll();
+}
+
+template <typename Key, typename Equal>
+bool SharedItemMutex<Key, Equal>::try_lock_shared() {
+  std::unique_lock lock(md_.mutex);
+  auto& state = GetState();
+  if (TryFinishLockingShared(state)) return true;
+  ReleaseState(state);
+  return false;
+}
+
+template <typename Key, typename Equal>
+template <typename Rep, typename Period>
+bool SharedItemMutex<Key, Equal>::try_lock_shared_for(
+    std::chrono::duration<Rep, Period> duration) {
+  std::unique_lock lock(md_.mutex);
+  auto& state = GetState();
+  if (md_.cv.WaitFor(lock, duration,
+                     [&] { return TryFinishLockingShared(state); })) {
+    return true;
+  }
+  ReleaseState(state);
+  return false;
+}
+
+template <typename Key, typename Equal>
+template <typename Clock, typename Duration>
+bool SharedItemMutex<Key, Equal>::try_lock_shared_until(
+    std::chrono::time_point<Clock, Duration> time_point) {
+  std::unique_lock lock(md_.mutex);
+  auto& state = GetState();
+  if (md_.cv.WaitUntil(lock, time_point,
+                       [&] { return TryFinishLockingShared(state); })) {
+    return true;
+  }
+  ReleaseState(state);
+  return false;
+}
+
+template <typename Key, typename Equal>
+impl::SharedMutexState& SharedItemMutex<Key, Equal>::GetState() {
+  // References to the unordered_map elements are stable
+  return md_.states[key_];
+}
+
+template <typename Key, typename Equal>
+bool SharedItemMutex<Key, Equal>::TryFinishLocking(
+    impl::SharedMutexState& state) noexcept {
+  if (state.writer || state.readers != 0) return false;
+  state.writer = true;
+  return true;
+}
+
+template <typename Key, typename Equal>
+bool SharedItemMutex<Key, Equal>::TryFinishLockingShared(
+    impl::SharedMutexState& state) noexcept {
+  if (state.writer || state.waiting_writers != 0) return false;
+  ++state.readers;
+  return true;
+}
+
+template <typename Key, typename Equal>
+template <typename Wait>
+bool SharedItemMutex<Key, Equal>::DoLock(Wait wait) {
+  std::unique_lock lock(md_.mutex);
+  auto& state = GetState();
+  if (TryFinishLocking(state)) return true;
+
+  ++state.waiting_writers;
+  const bool is_locked =
+      wait(md_.cv, lock, [&] { return TryFinishLocking(state); });
+  --state.waiting_writers;
+
+  if (!is_locked) {
+    ReleaseState(state);
+    // Readers might have been waiting for us to give up
+    md_.cv.NotifyAll();
+  }
+  return is_locked;
+}
+
+template <typename Key, typename Equal>
+void SharedItemMutex<Key, Equal>::ReleaseState(impl::SharedMutexState& state) {
+  if (state.IsFree()) md_.states.erase(key_);
+}
+
 }  // namespace concurrent
 
 USERVER_NAMESPACE_END
@@ -1,12 +1,17 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <iterator>
 #include <limits>
 #include <memory>
+#include <type_traits>
+#include <vector>
 
 #include <moodycamel/concurrentqueue.h>
 
 #include <userver/concurrent/impl/semaphore_capacity_control.hpp>
+#include <userver/concurrent/impl/spsc_ring_queue.hpp>
 #include <userver/concurrent/queue_helpers.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/semaphore.hpp>
@@ -41,6 +46,13 @@ class GenericQueue final
     explicit EmplaceEnabler() = default;
   };
 
+  // SPSC queues do not need the moodycamel sub-queues and tokens machinery
+  static constexpr bool kIsSpsc = !MultipleProducer && !MultipleConsumer;
+
+  using LockFreeQueue =
+      std::conditional_t<kIsSpsc, impl::SpscRingQueue<T>,
+                         moodycamel::ConcurrentQueue<T>>;
+
   using ProducerToken =
       std::conditional_t<MultipleProducer, moodycamel::ProducerToken,
                          impl::NoToken>;
@@ -50,8 +62,8 @@ class GenericQueue final
   using MultiProducerToken = impl::MultiProducerToken;
 
   using SingleProducerToken =
-      std::conditional_t<!MultipleProducer, moodycamel::ProducerToken,
-                         impl::NoToken>;
+      std::conditional_t<!MultipleProducer && MultipleConsumer,
+                         moodycamel::ProducerToken, impl::NoToken>;
 
   friend class Producer<GenericQueue, ProducerToken, EmplaceEnabler>;
   friend class Producer<GenericQueue, MultiProducerToken, EmplaceEnabler>;
@@ -199,6 +211,32 @@ class GenericQueue final
     return consumer_side_.PopNoblock(token, value);
   }
 
+  template <typename Token, typename Iterator>
+  [[nodiscard]] std::size_t PushBatch(Token& token, Iterator first,
+                                      std::size_t count,
+                                      engine::Deadline deadline) {
+    return producer_side_.PushBatch(token, first, count, deadline);
+  }
+
+  template <typename Token, typename Iterator>
+  [[nodiscard]] std::size_t PushBatchNoblock(Token& token, Iterator first,
+                                             std::size_t count) {
+    return producer_side_.PushBatchNoblock(token, first, count);
+  }
+
+  [[nodiscard]] std::size_t PopBatch(ConsumerToken& token,
+                                     std::vector<T>& values,
+                                     std::size_t max_count,
+                                     engine::Deadline deadline) {
+    return consumer_side_.PopBatch(token, values, max_count, deadline);
+  }
+
+  [[nodiscard]] std::size_t PopBatchNoblock(ConsumerToken& token,
+                                            std::vector<T>& values,
+                                            std::size_t max_count) {
+    return consumer_side_.PopBatchNoblock(token, values, max_count);
+  }
+
   void PrepareProducer() {
     std::size_t old_producers_count{};
     utils::AtomicUpdate(producers_count_, [&](auto old_value) {
@@ -249,16 +287,45 @@ class GenericQueue final
     } else {
       static_assert(std::is_same_v<Token, impl::NoToken>);
       static_assert(!MultipleProducer);
-      queue_.enqueue(single_producer_token_, std::move(value));
+      if constexpr (kIsSpsc) {
+        queue_.Push(std::move(value));
+      } else {
+        queue_.enqueue(single_producer_token_, std::move(value));
+      }
     }
 
     consumer_side_.OnElementPushed();
   }
 
+  // Elements are moved from, the consumer is notified once for the whole batch
+  template <typename Token, typename Iterator>
+  void DoPushBatch(Token& token, Iterator first, std::size_t count) {
+    auto it = std::make_move_iterator(first);
+    if constexpr (std::is_same_v<Token, moodycamel::ProducerToken>) {
+      static_assert(MultipleProducer);
+      queue_.enqueue_bulk(token, it, count);
+    } else if constexpr (std::is_same_v<Token, MultiProducerToken>) {
+      static_assert(MultipleProducer);
+      queue_.enqueue_bulk(it, count);
+    } else {
+      static_assert(std::is_same_v<Token, impl::NoToken>);
+      static_assert(!MultipleProducer);
+      if constexpr (kIsSpsc) {
+        queue_.PushBulk(it, count);
+      } else {
+        queue_.enqueue_bulk(single_producer_token_, it, count);
+      }
+    }
+
+    consumer_side_.OnElementsPushed(count);
+  }
+
   [[nodiscard]] bool DoPop(ConsumerToken& token, T& value) {
     bool success = false;
     if constexpr (MultipleProducer) {
       success = queue_.try_dequeue(token, value);
+    } else if constexpr (kIsSpsc) {
+      success = queue_.TryPop(value);
     } else {
       // Substitute with our single producer token
       success = queue_.try_dequeue_from_producer(single_producer_token_, value);
@@ -272,7 +339,25 @@ class GenericQueue final
     return false;
   }
 
-  moodycamel::ConcurrentQueue<T> queue_{1};
+  [[nodiscard]] std::size_t DoPopBatch(ConsumerToken& token,
+                                       std::vector<T>& values,
+                                       std::size_t max_count) {
+    auto out = std::back_inserter(values);
+    std::size_t popped = 0;
+    if constexpr (MultipleProducer) {
+      popped = queue_.try_dequeue_bulk(token, out, max_count);
+    } else if constexpr (kIsSpsc) {
+      popped = queue_.TryPopBulk(out, max_count);
+    } else {
+      popped = queue_.try_dequeue_bulk_from_producer(single_producer_token_,
+                                                     out, max_count);
+    }
+
+    if (popped != 0) producer_side_.OnElementsPopped(popped);
+    return popped;
+  }
+
+  LockFreeQueue queue_{1};
   std::atomic<std::size_t> consumers_count_{0};
   std::atomic<std::size_t> producers_count_{0};
 
@@ -312,11 +397,38 @@ class GenericQueue<T, MP, MC>::SingleProducerSide final {
     return DoPush(token, std::move(value));
   }
 
+  // Pushes as much as the capacity allows, then waits for the consumer to make
+  // room for the rest
+  template <typename Token, typename Iterator>
+  [[nodiscard]] std::size_t PushBatch(Token& token, Iterator first,
+                                      std::size_t count,
+                                      engine::Deadline deadline) {
+    std::size_t pushed = 0;
+    while (true) {
+      pushed += DoPushBatch(token, std::next(first, pushed), count - pushed);
+      if (pushed == count || queue_.NoMoreConsumers() ||
+          !non_full_event_.WaitForEventUntil(deadline)) {
+        return pushed;
+      }
+    }
+  }
+
+  template <typename Token, typename Iterator>
+  [[nodiscard]] std::size_t PushBatchNoblock(Token& token, Iterator first,
+                                             std::size_t count) {
+    return DoPushBatch(token, first, count);
+  }
+
   void OnElementPopped() {
     --used_capacity_;
     non_full_event_.Send();
   }
 
+  void OnElementsPopped(std::size_t count) {
+    used_capacity_ -= count;
+    non_full_event_.Send();
+  }
+
   void StopBlockingOnPush() {
     total_capacity_ += kSemaphoreUnlockValue;
     non_full_event_.Send();
@@ -345,6 +457,23 @@ class GenericQueue<T, MP, MC>::SingleProducerSide final {
     return true;
   }
 
+  template <typename Token, typename Iterator>
+  [[nodiscard]] std::size_t DoPushBatch(Token& token, Iterator first,
+                                        std::size_t count) {
+    const auto used_capacity = used_capacity_.load();
+    const auto total_capacity = total_capacity_.load();
+    if (count == 0 || queue_.NoMoreConsumers() ||
+        used_capacity >= total_capacity) {
+      return 0;
+    }
+
+    const auto chunk = std::min(count, total_capacity - used_capacity);
+    used_capacity_ += chunk;
+    queue_.DoPushBatch(token, first, chunk);
+    non_full_event_.Reset();
+    return chunk;
+  }
+
   GenericQueue& queue_;
   engine::SingleConsumerEvent non_full_event_;
   std::atomic<std::size_t> used_capacity_;
@@ -375,8 +504,40 @@ class GenericQueue<T, MP, MC>::MultiProducerSide final {
            DoPush(token, std::move(value));
   }
 
+  // Grabs as much capacity as available at once, blocks only if there is none
+  template <typename Token, typename Iterator>
+  [[nodiscard]] std::size_t PushBatch(Token& token, Iterator first,
+                                      std::size_t count,
+                                      engine::Deadline deadline) {
+    std::size_t pushed = 0;
+    while (pushed < count) {
+      auto chunk = AcquireCapacity(count - pushed);
+      if (chunk == 0) {
+        if (engine::current_task::ShouldCancel() ||
+            !remaining_capacity_.try_lock_shared_until(deadline)) {
+          break;
+        }
+        chunk = 1 + AcquireCapacity(count - pushed - 1);
+      }
+      if (!DoPushBatch(token, std::next(first, pushed), chunk)) break;
+      pushed += chunk;
+    }
+    return pushed;
+  }
+
+  template <typename Token, typename Iterator>
+  [[nodiscard]] std::size_t PushBatchNoblock(Token& token, Iterator first,
+                                             std::size_t count) {
+    const auto chunk = AcquireCapacity(count);
+    return chunk != 0 && DoPushBatch(token, first, chunk) ? chunk : 0;
+  }
+
   void OnElementPopped() { remaining_capacity_.unlock_shared(); }
 
+  void OnElementsPopped(std::size_t count) {
+    remaining_capacity_.unlock_shared_count(count);
+  }
+
   void StopBlockingOnPush() {
     remaining_capacity_control_.SetCapacityOverride(0);
   }
@@ -405,6 +566,32 @@ class GenericQueue<T, MP, MC>::MultiProducerSide final {
     return true;
   }
 
+  template <typename Token, typename Iterator>
+  [[nodiscard]] bool DoPushBatch(Token& token, Iterator first,
+                                 std::size_t count) {
+    if (queue_.NoMoreConsumers()) {
+      remaining_capacity_.unlock_shared_count(count);
+      return false;
+    }
+
+    queue_.DoPushBatch(token, first, count);
+    return true;
+  }
+
+  std::size_t AcquireCapacity(std::size_t max_count) {
+    std::size_t acquired = 0;
+    auto chunk = max_count;
+    while (chunk != 0) {
+      if (remaining_capacity_.try_lock_shared_count(chunk)) {
+        acquired += chunk;
+        chunk = std::min(chunk, max_count - acquired);
+      } else {
+        chunk /= 2;
+      }
+    }
+    return acquired;
+  }
+
   GenericQueue& queue_;
   engine::Semaphore remaining_capacity_;
   concurrent::impl::SemaphoreCapacityControl remaining_capacity_control_;
@@ -435,11 +622,39 @@ class GenericQueue<T, MP, MC>::SingleConsumerSide final {
     return DoPop(token, value);
   }
 
+  // Blocks only if queue is empty
+  [[nodiscard]] std::size_t PopBatch(ConsumerToken& token,
+                                     std::vector<T>& values,
+                                     std::size_t max_count,
+                                     engine::Deadline deadline) {
+    if (max_count == 0) return 0;
+    while (true) {
+      if (const auto popped = DoPopBatch(token, values, max_count)) {
+        return popped;
+      }
+      if (queue_.NoMoreProducers() ||
+          !nonempty_event_.WaitForEventUntil(deadline)) {
+        return DoPopBatch(token, values, max_count);
+      }
+    }
+  }
+
+  [[nodiscard]] std::size_t PopBatchNoblock(ConsumerToken& token,
+                                            std::vector<T>& values,
+                                            std::size_t max_count) {
+    return DoPopBatch(token, values, max_count);
+  }
+
   void OnElementPushed() {
     ++size_;
     nonempty_event_.Send();
   }
 
+  void OnElementsPushed(std::size_t count) {
+    size_ += count;
+    nonempty_event_.Send();
+  }
+
   void StopBlockingOnPop() { nonempty_event_.Send(); }
 
   void ResumeBlockingOnPop() {}
@@ -456,6 +671,17 @@ class GenericQueue<T, MP, MC>::SingleConsumerSide final {
     return false;
   }
 
+  [[nodiscard]] std::size_t DoPopBatch(ConsumerToken& token,
+                                       std::vector<T>& values,
+                                       std::size_t max_count) {
+    const auto popped = queue_.DoPopBatch(token, values, max_count);
+    if (popped != 0) {
+      size_ -= popped;
+      nonempty_event_.Reset();
+    }
+    return popped;
+  }
+
   GenericQueue& queue_;
   engine::SingleConsumerEvent nonempty_event_;
   std::atomic<std::size_t> size_;
@@ -483,8 +709,31 @@ class GenericQueue<T, MP, MC>::MultiConsumerSide final {
     return size_.try_lock_shared() && DoPop(token, value);
   }
 
+  // Blocks only if queue is empty
+  [[nodiscard]] std::size_t PopBatch(ConsumerToken& token,
+                                     std::vector<T>& values,
+                                     std::size_t max_count,
+                                     engine::Deadline deadline) {
+    if (max_count == 0) return 0;
+    auto count = AcquireSize(max_count);
+    if (count == 0) {
+      if (!size_.try_lock_shared_until(deadline)) return 0;
+      count = 1 + AcquireSize(max_count - 1);
+    }
+    return DoPopBatch(token, values, count);
+  }
+
+  [[nodiscard]] std::size_t PopBatchNoblock(ConsumerToken& token,
+                                            std::vector<T>& values,
+                                            std::size_t max_count) {
+    const auto count = AcquireSize(max_count);
+    return count != 0 ? DoPopBatch(token, values, count) : 0;
+  }
+
   void OnElementPushed() { size_.unlock_shared(); }
 
+  void OnElementsPushed(std::size_t count) { size_.unlock_shared_count(count); }
+
   void StopBlockingOnPop() {
     size_control_.SetCapacityOverride(kUnbounded + kSemaphoreUnlockValue);
   }
@@ -514,6 +763,35 @@ class GenericQueue<T, MP, MC>::MultiConsumerSide final {
     }
   }
 
+  // Pops exactly `count` elements that were already accounted in `size_`
+  [[nodiscard]] std::size_t DoPopBatch(ConsumerToken& token,
+                                       std::vector<T>& values,
+                                       std::size_t count) {
+    std::size_t popped = 0;
+    while (popped < count) {
+      popped += queue_.DoPopBatch(token, values, count - popped);
+      if (popped < count && queue_.NoMoreProducers()) {
+        size_.unlock_shared_count(count - popped);
+        break;
+      }
+    }
+    return popped;
+  }
+
+  std::size_t AcquireSize(std::size_t max_count) {
+    std::size_t acquired = 0;
+    auto chunk = max_count;
+    while (chunk != 0) {
+      if (size_.try_lock_shared_count(chunk)) {
+        acquired += chunk;
+        chunk = std::min(chunk, max_count - acquired);
+      } else {
+        chunk /= 2;
+      }
+    }
+    return acquired;
+  }
+
   GenericQueue& queue_;
   engine::Semaphore size_;
   concurrent::impl::SemaphoreCapacityControl size_control_;
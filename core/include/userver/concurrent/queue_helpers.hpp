@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <iterator>
 #include <memory>
+#include <vector>
 
 #include <userver/engine/deadline.hpp>
 
@@ -54,6 +57,27 @@ class Producer final {
     return queue_->PushNoblock(token_, std::move(value));
   }
 
+  /// Push elements from [first, last) into queue. Elements are moved from.
+  /// May wait asynchronously if the queue is full. The consumer is woken up
+  /// once per pushed chunk rather than once per element.
+  /// @returns the amount of the leading elements pushed before the deadline.
+  template <typename Iterator>
+  std::size_t PushBatch(Iterator first, Iterator last,
+                        engine::Deadline deadline = {}) const {
+    UASSERT(queue_);
+    return queue_->PushBatch(token_, first, std::distance(first, last),
+                             deadline);
+  }
+
+  /// Try to push elements from [first, last) into queue without blocking.
+  /// Elements are moved from. May be used in non-coroutine environment
+  /// @returns the amount of the leading elements pushed.
+  template <typename Iterator>
+  std::size_t PushBatchNoblock(Iterator first, Iterator last) const {
+    UASSERT(queue_);
+    return queue_->PushBatchNoblock(token_, first, std::distance(first, last));
+  }
+
   void Release() && {
     if (queue_) queue_->MarkProducerIsDead();
     queue_.reset();
@@ -111,6 +135,23 @@ class Consumer final {
     return queue_->PopNoblock(token_, value);
   }
 
+  /// Pop up to `max_count` elements from queue and append them to `values`.
+  /// May wait asynchronously if the queue is empty, but the producer is alive.
+  /// @returns the amount of popped elements, 0 if nothing was popped before
+  /// the deadline or the producer is no longer alive.
+  std::size_t PopBatch(std::vector<ValueType>& values, std::size_t max_count,
+                       engine::Deadline deadline = {}) const {
+    return queue_->PopBatch(token_, values, max_count, deadline);
+  }
+
+  /// Try to pop up to `max_count` elements from queue without blocking and
+  /// append them to `values`. May be used in non-coroutine environment
+  /// @returns the amount of popped elements.
+  std::size_t PopBatchNoblock(std::vector<ValueType>& values,
+                              std::size_t max_count) const {
+    return queue_->PopBatchNoblock(token_, values, max_count);
+  }
+
   /// Const access to source queue.
   std::shared_ptr<const QueueType> Queue() const { return {queue_}; }
 
@@ -0,0 +1,98 @@
+#pragma once
+
+/// @file userver/concurrent/sharded_variable.hpp
+/// @brief @copybrief concurrent::ShardedVariable
+
+#include <cstddef>
+#include <utility>
+
+#include <userver/concurrent/impl/interference_shield.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+namespace impl {
+
+/// Returns the engine worker index of the current thread, or a dense index of
+/// the thread if it is not an engine worker
+std::size_t GetCurrentShardIndex() noexcept;
+
+/// Returns the amount of hardware threads, at least 1
+std::size_t GetDefaultShardCount() noexcept;
+
+}  // namespace impl
+
+/// @ingroup userver_concurrency
+///
+/// @brief Per-thread shards of a value that are combined on read.
+///
+/// Each shard occupies its own cache lines and the callers work with the
+/// shard of the engine worker thread they run on, so that the hot counters
+/// or read-mostly data do not bounce between the CPU caches. Reading
+/// the value as a whole visits all the shards.
+///
+/// The workers beyond the shard count and non-engine threads share shards,
+/// and a task may migrate to another worker after a suspension, so `T` must
+/// be safe for concurrent use itself, e.g. utils::statistics::RelaxedCounter,
+/// std::atomic or a structure of them.
+///
+/// ## Example usage:
+///
+/// @snippet concurrent/sharded_variable_test.cpp  Sample concurrent::ShardedVariable usage
+///
+/// @see @ref md_en_userver_synchronization
+template <typename T>
+class ShardedVariable final {
+ public:
+  /// Creates a shard per hardware thread
+  ShardedVariable() : ShardedVariable(impl::GetDefaultShardCount()) {}
+
+  /// Creates `shard_count` shards, each constructed from `args`
+  template <typename... Args>
+  explicit ShardedVariable(std::size_t shard_count, const Args&... args)
+      : shards_(shard_count, args...) {
+    UASSERT(shard_count != 0);
+  }
+
+  ShardedVariable(ShardedVariable&&) = delete;
+  ShardedVariable& operator=(ShardedVariable&&) = delete;
+
+  /// Returns the shard of the current thread
+  T& GetLocal() noexcept {
+    return *shards_[impl::GetCurrentShardIndex() % shards_.size()];
+  }
+
+  /// Calls `func(T&)` for every shard, e.g. to reset them
+  template <typename Func>
+  void VisitAll(Func&& func) {
+    for (auto& shard : shards_) func(*shard);
+  }
+
+  /// Calls `func(const T&)` for every shard
+  template <typename Func>
+  void VisitAll(Func&& func) const {
+    for (const auto& shard : shards_) func(*shard);
+  }
+
+  /// @brief Folds the shards into a single value.
+  /// @returns `combine(...combine(combine(init, shard0), shard1)..., shardN)`
+  template <typename Result, typename BinaryOp>
+  Result Combine(Result init, BinaryOp combine) const {
+    for (const auto& shard : shards_) {
+      init = combine(std::move(init), *shard);
+    }
+    return init;
+  }
+
+  std::size_t GetShardCount() const noexcept { return shards_.size(); }
+
+ private:
+  utils::FixedArray<impl::InterferenceShield<T>> shards_;
+};
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
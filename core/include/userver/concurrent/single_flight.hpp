@@ -0,0 +1,163 @@
+#pragma once
+
+/// @file userver/concurrent/single_flight.hpp
+/// @brief @copybrief concurrent::SingleFlight
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/exception.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utils/cached_hash.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+namespace impl {
+
+template <typename Value>
+struct SingleFlightCall final {
+  engine::ConditionVariable cv;
+  bool is_ready{false};
+  // The leader failed because of its own cancellation or deadline
+  bool is_interrupted{false};
+  std::optional<Value> value;
+  std::exception_ptr exception;
+};
+
+template <typename T, typename Value, typename Equal>
+struct SingleFlightWay final {
+  explicit SingleFlightWay(size_t way_size, const Equal& equal = Equal{})
+      : calls(way_size, {}, equal) {}
+
+  engine::Mutex mutex;
+  std::unordered_map<T, std::shared_ptr<SingleFlightCall<Value>>, std::hash<T>,
+                     Equal>
+      calls;
+};
+
+}  // namespace impl
+
+/// @ingroup userver_concurrency
+///
+/// @brief Coalesces the concurrent computations of a value for the same key
+///
+/// The first caller of Do() for a key runs the function, the callers that
+/// come for the same key while it runs wait for it and get a copy of its
+/// result or of its exception. That prevents the stampedes on the backends
+/// when the cached value of a hot key expires.
+///
+/// If the function fails while the task of the first caller is cancelled,
+/// e.g. by its deadline, the failure is not propagated to the waiters: one of
+/// them runs the function again and the others wait for it.
+///
+/// Unlike concurrent::MutexSet, the waiters do not run the function one after
+/// another, so one slow or failed computation is not repeated by each of them.
+///
+/// Example:
+/// @snippet src/concurrent/single_flight_test.cpp  Sample single flight usage
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class SingleFlight final : Hash {
+  static_assert(std::is_copy_constructible_v<Value>,
+                "All the waiters get a copy of the value");
+
+ public:
+  explicit SingleFlight(size_t ways = 1, size_t way_size = 1,
+                        const Hash& hash = Hash{},
+                        const Equal& equal = Equal{});
+
+  /// @brief Returns `func()`, or the result of a concurrent `func()` for
+  /// an equal key. Coroutine-safe.
+  /// @throws anything `func` throws, in all the coalesced callers unless
+  /// the caller that ran `func` was cancelled
+  /// @throws engine::WaitInterruptedException if the current task was
+  /// cancelled while waiting for the result of another caller
+  template <typename Func>
+  Value Do(const Key& key, Func&& func);
+
+ private:
+  using HashAndKey = utils::CachedHash<Key>;
+  using Call = impl::SingleFlightCall<Value>;
+  using Way = impl::SingleFlightWay<HashAndKey, Value,
+                                    utils::CachedHashKeyEqual<Equal>>;
+
+  utils::FixedArray<Way> ways_;
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+SingleFlight<Key, Value, Hash, Equal>::SingleFlight(size_t ways,
+                                                    size_t way_size,
+                                                    const Hash& hash,
+                                                    const Equal& equal)
+    : Hash(hash),
+      ways_(ways, way_size, utils::CachedHashKeyEqual<Equal>{equal}) {}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename Func>
+Value SingleFlight<Key, Value, Hash, Equal>::Do(const Key& key, Func&& func) {
+  const auto hash_value = Hash::operator()(key);
+  auto& way = ways_[hash_value % ways_.size()];
+  HashAndKey hash_and_key{hash_value / ways_.size(), key};
+
+  std::unique_lock lock(way.mutex);
+  for (auto it = way.calls.find(hash_and_key); it != way.calls.end();
+       it = way.calls.find(hash_and_key)) {
+    const auto call = it->second;
+    if (!call->cv.Wait(lock, [&call] { return call->is_ready; })) {
+      throw engine::WaitInterruptedException(
+          engine::current_task::CancellationReason());
+    }
+    if (!call->is_interrupted) {
+      if (call->exception) std::rethrow_exception(call->exception);
+      return *call->value;
+    }
+    // The leader was cancelled, the first woken up waiter takes its place
+  }
+
+  const auto call = std::make_shared<Call>();
+  way.calls.emplace(hash_and_key, call);
+  lock.unlock();
+
+  std::optional<Value> value;
+  std::exception_ptr exception;
+  try {
+    value.emplace(std::forward<Func>(func)());
+  } catch (...) {
+    exception = std::current_exception();
+  }
+
+  const bool is_interrupted =
+      exception && engine::current_task::ShouldCancel();
+
+  lock.lock();
+  way.calls.erase(hash_and_key);
+  // The waiters copy the pointer with the mutex locked
+  if (call.use_count() > 1) {
+    if (!is_interrupted) {
+      call->value = value;
+      call->exception = exception;
+    }
+    call->is_interrupted = is_interrupted;
+    call->is_ready = true;
+    call->cv.NotifyAll();
+  }
+  lock.unlock();
+
+  if (exception) std::rethrow_exception(exception);
+  return std::move(*value);
+}
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
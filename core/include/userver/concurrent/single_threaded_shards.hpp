@@ -0,0 +1,189 @@
+#pragma once
+
+/// @file userver/concurrent/single_threaded_shards.hpp
+/// @brief @copybrief concurrent::SingleThreadedShards
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/single_threaded_task_processors_pool.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/impl/wait_token_storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+/// @ingroup userver_concurrency
+///
+/// @brief Shard-per-core state: an instance of `T` per processor of
+/// engine::SingleThreadedTaskProcessorsPool, accessed only by the tasks of
+/// that processor.
+///
+/// The keys (connection ids, user ids, order book symbols...) are hashed to
+/// a shard and the work on a key is sent to its shard with SubmitTo() or
+/// SubmitByKey(), so the shard state is never touched by two threads and
+/// needs neither locks nor atomics. Moving work between shards is message
+/// passing: a task on another shard's processor.
+///
+/// The tasks of a shard run on a single thread, but they still interleave at
+/// the suspension points, so the state must be consistent whenever a task
+/// waits for something.
+///
+/// The shard states are constructed and destroyed by the tasks of their
+/// processors, so their memory is allocated and freed by the threads that use
+/// it. The destructor waits for the tasks started by SubmitTo(),
+/// SubmitByKey() and InvokeOnAll() to finish, so they must not wait for
+/// anything that is done after the destruction. The pool must outlive the
+/// shards.
+///
+/// ## Example usage:
+///
+/// @snippet concurrent/single_threaded_shards_test.cpp  Sample concurrent::SingleThreadedShards usage
+///
+/// @see @ref md_en_userver_synchronization
+template <typename T>
+class SingleThreadedShards final {
+ public:
+  /// Creates a `T` on each processor of the pool by `factory(shard_index)`,
+  /// the factory is called concurrently. Must be called from a coroutine.
+  template <typename Factory>
+  SingleThreadedShards(engine::SingleThreadedTaskProcessorsPool& pool,
+                       Factory factory);
+
+  SingleThreadedShards(SingleThreadedShards&&) = delete;
+  SingleThreadedShards& operator=(SingleThreadedShards&&) = delete;
+
+  /// Waits for the submitted tasks and destroys each `T` on its processor.
+  /// Must be called from a coroutine.
+  ~SingleThreadedShards();
+
+  std::size_t GetShardCount() const noexcept { return shards_.size(); }
+
+  /// Returns the shard of the key, the same for equal keys
+  template <typename Key, typename Hash = std::hash<Key>>
+  std::size_t GetShardIndex(const Key& key, const Hash& hash = Hash{}) const {
+    // std::hash of integers and pointers is usually the identity, spread the
+    // aligned pointers and the sequential ids over the shards
+    const auto mixed =
+        static_cast<std::uint64_t>(hash(key)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<std::size_t>(mixed >> 32) % shards_.size();
+  }
+
+  /// @brief Runs `func(T&)` on the processor of the shard.
+  /// @returns the task with the result of `func`
+  template <typename Func>
+  [[nodiscard]] auto SubmitTo(std::size_t shard_index, Func&& func) {
+    UASSERT(shard_index < shards_.size());
+    auto& shard = shards_[shard_index];
+    return engine::AsyncNoSpan(
+        *shard.processor,
+        [state = shard.state.get(), func = std::forward<Func>(func),
+         token = wait_token_storage_.GetToken()]() mutable {
+          return func(*state);
+        });
+  }
+
+  /// Runs `func(T&)` on the processor of the key's shard
+  template <typename Key, typename Func>
+  [[nodiscard]] auto SubmitByKey(const Key& key, Func&& func) {
+    return SubmitTo(GetShardIndex(key), std::forward<Func>(func));
+  }
+
+  /// @brief Runs `func(T&)` on all the shards concurrently and waits for them.
+  /// @returns the results of `func` in the order of the shards, if any
+  template <typename Func>
+  auto InvokeOnAll(const Func& func) {
+    using Result = std::invoke_result_t<const Func&, T&>;
+    std::vector<engine::TaskWithResult<Result>> tasks;
+    tasks.reserve(shards_.size());
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+      tasks.push_back(SubmitTo(i, [&func](T& state) { return func(state); }));
+    }
+
+    if constexpr (std::is_void_v<Result>) {
+      for (auto& task : tasks) task.Get();
+    } else {
+      std::vector<Result> results;
+      results.reserve(tasks.size());
+      for (auto& task : tasks) results.push_back(task.Get());
+      return results;
+    }
+  }
+
+ private:
+  struct Shard {
+    engine::TaskProcessor* processor;
+    std::unique_ptr<T> state;
+  };
+
+  void DestroyStates() noexcept;
+
+  std::vector<Shard> shards_;
+  utils::impl::WaitTokenStorage wait_token_storage_;
+};
+
+template <typename T>
+template <typename Factory>
+SingleThreadedShards<T>::SingleThreadedShards(
+    engine::SingleThreadedTaskProcessorsPool& pool, Factory factory) {
+  UASSERT(pool.GetSize() != 0);
+  std::vector<engine::TaskWithResult<std::unique_ptr<T>>> tasks;
+  tasks.reserve(pool.GetSize());
+  for (std::size_t i = 0; i < pool.GetSize(); ++i) {
+    tasks.push_back(engine::AsyncNoSpan(pool.At(i), [&factory, i] {
+      return std::make_unique<T>(factory(i));
+    }));
+  }
+
+  // The states that are constructed already are destroyed on their
+  // processors if another factory call fails
+  const engine::TaskCancellationBlocker block_cancels;
+  std::exception_ptr factory_error;
+  shards_.reserve(tasks.size());
+  for (std::size_t i = 0; i < tasks.size(); ++i) {
+    try {
+      shards_.push_back(Shard{&pool.At(i), tasks[i].Get()});
+    } catch (...) {
+      if (!factory_error) factory_error = std::current_exception();
+    }
+  }
+
+  if (factory_error) {
+    DestroyStates();
+    std::rethrow_exception(factory_error);
+  }
+}
+
+template <typename T>
+SingleThreadedShards<T>::~SingleThreadedShards() {
+  wait_token_storage_.WaitForAllTokens();
+  DestroyStates();
+}
+
+template <typename T>
+void SingleThreadedShards<T>::DestroyStates() noexcept {
+  const engine::TaskCancellationBlocker block_cancels;
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(shards_.size());
+  for (auto& shard : shards_) {
+    tasks.push_back(engine::CriticalAsyncNoSpan(
+        *shard.processor,
+        [state = std::move(shard.state)]() mutable { state.reset(); }));
+  }
+  for (auto& task : tasks) task.Wait();
+  shards_.clear();
+}
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
@@ -4,6 +4,7 @@
 /// @brief @copybrief congestion_control::Component
 
 #include <userver/components/loggable_component_base.hpp>
+#include <userver/congestion_control/limiter.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 #include <userver/utils/statistics/entry.hpp>
@@ -47,6 +48,10 @@ class Component final : public components::LoggableComponentBase {
 
   static yaml_config::Schema GetStaticConfigSchema();
 
+  /// @brief Apply the limits of the HTTP server controller to `limiter` too
+  /// @note `limiter` must be alive until the component is stopping
+  void RegisterLimiter(Limiter& limiter);
+
  private:
   void OnConfigUpdate(const dynamic_config::Snapshot& cfg);
 
@@ -4,9 +4,13 @@
 /// @brief @copybrief dist_lock::DistLockStrategyBase
 
 #include <chrono>
+#include <cstdint>
 #include <exception>
+#include <optional>
 #include <string>
 
+#include <userver/engine/deadline.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace dist_lock {
@@ -35,12 +39,32 @@ class DistLockStrategyBase {
   virtual void Acquire(std::chrono::milliseconds lock_ttl,
                        const std::string& locker_id) = 0;
 
+  /// Acquires the distributed lock, the same as Acquire(), and returns the
+  /// fencing token of the lock: a non-negative number that increases each
+  /// time the lock changes hands and stays the same while the lock is
+  /// prolonged. The storages guarded by the lock may reject the writes with
+  /// the tokens older than the last one they have seen.
+  ///
+  /// The default implementation calls Acquire() and returns std::nullopt,
+  /// override it if the strategy supports fencing tokens.
+  virtual std::optional<std::int64_t> AcquireWithFencingToken(
+      std::chrono::milliseconds lock_ttl, const std::string& locker_id);
+
   /// Releases the lock.
   ///
   /// @param locker_id Globally unique ID of the locking entity, must be the
   /// same as in Acquire().
   /// @note Exceptions are ignored.
   virtual void Release(const std::string& locker_id) = 0;
+
+  /// Waits until the lock is probably released by its holder or until the
+  /// deadline. Called instead of sleeping for the acquire interval while the
+  /// lock is busy, so the strategies that get notified on release take over
+  /// the lock right after it is released.
+  ///
+  /// The default implementation sleeps until the deadline.
+  /// @note Must return on task cancellation.
+  virtual void WaitForRelease(engine::Deadline deadline);
 };
 
 }  // namespace dist_lock
@@ -4,6 +4,7 @@
 /// @brief @copybrief dist_lock::DistLockedTask
 
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -74,6 +75,11 @@ class DistLockedTask final : public engine::TaskWithResult<void> {
   /// may be less than the real duration.
   std::optional<std::chrono::steady_clock::duration> GetLockedDuration() const;
 
+  /// Returns the fencing token of the held lock, std::nullopt if the lock is
+  /// not held or the strategy does not support fencing tokens.
+  /// @see DistLockStrategyBase::AcquireWithFencingToken
+  std::optional<std::int64_t> GetFencingToken() const;
+
  private:
   DistLockedTask(engine::TaskProcessor&, std::shared_ptr<impl::Locker>,
                  DistLockWaitingMode);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -76,6 +77,11 @@ class DistLockedWorker final {
   /// may be less than the real duration.
   std::optional<std::chrono::steady_clock::duration> GetLockedDuration() const;
 
+  /// Returns the fencing token of the held lock, std::nullopt if the lock is
+  /// not held or the strategy does not support fencing tokens.
+  /// @see DistLockStrategyBase::AcquireWithFencingToken
+  std::optional<std::int64_t> GetFencingToken() const;
+
   /// Returns lock acquisition statistics.
   const Statistics& GetStatistics() const;
 
@@ -0,0 +1,227 @@
+#pragma once
+
+/// @file userver/dump/chunked.hpp
+/// @brief Container serialization that is encoded and decoded in parallel
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/meta.hpp>
+#include <userver/dump/meta_containers.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+inline constexpr std::size_t kDefaultChunkSize = 10000;
+
+/// Compression of the chunks written by dump::WriteChunked
+enum class ChunkCompression : std::uint8_t {
+  kNone = 0,
+  /// zlib at the fastest level, trades some dump write time for its size
+  kZlib = 1,
+};
+
+/// @brief Options of dump::WriteChunked
+struct ChunkedWriteOptions final {
+  /// Elements per chunk
+  std::size_t chunk_size{kDefaultChunkSize};
+
+  ChunkCompression compression{ChunkCompression::kNone};
+
+  /// Limit for the chunks that are encoded concurrently, also bounds the
+  /// memory held by the encoded chunks that await writing
+  std::size_t max_parallel_chunks{8};
+};
+
+namespace impl {
+
+/// Appends the written data to a string
+class StringWriter final : public Writer {
+ public:
+  void Finish() override;
+
+  std::string Extract() &&;
+
+ private:
+  void WriteRaw(std::string_view data) override;
+
+  std::string data_;
+};
+
+/// Reads from a string
+class StringReader final : public Reader {
+ public:
+  explicit StringReader(std::string data);
+
+  void Finish() override;
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override;
+
+  std::string data_;
+  std::string_view unread_data_;
+};
+
+template <typename T>
+using HasMerge = decltype(std::declval<T&>().merge(std::declval<T&>()));
+
+struct EncodedChunk final {
+  std::string data;
+  std::size_t raw_size{0};
+};
+
+EncodedChunk CompressChunk(std::string data, ChunkCompression compression);
+
+std::string DecompressChunk(std::string data, ChunkCompression compression,
+                            std::size_t raw_size);
+
+ChunkCompression ReadChunkCompression(Reader& reader);
+
+template <typename T, typename Iterator>
+EncodedChunk EncodeChunk(Iterator it, std::size_t count,
+                         ChunkCompression compression) {
+  StringWriter chunk_writer;
+  chunk_writer.Write(count);
+  for (std::size_t i = 0; i < count; ++i, ++it) {
+    // explicit cast for vector<bool> shenanigans
+    chunk_writer.Write(static_cast<const meta::RangeValueType<T>&>(*it));
+  }
+  chunk_writer.Finish();
+  return CompressChunk(std::move(chunk_writer).Extract(), compression);
+}
+
+template <typename T>
+T ReadChunk(std::string data, ChunkCompression compression,
+            std::size_t raw_size) {
+  StringReader reader{DecompressChunk(std::move(data), compression, raw_size)};
+  auto chunk = reader.Read<T>();
+  reader.Finish();
+  return chunk;
+}
+
+}  // namespace impl
+
+/// @brief Writes the container as a sequence of the independently encoded
+/// chunks, see dump::ReadChunked
+///
+/// The chunks are encoded and compressed in parallel on the current task
+/// processor, and written in order as soon as they are ready.
+///
+/// @code
+/// void Write(dump::Writer& writer, const MyData& data) {
+///   dump::WriteChunked(writer, data.map);
+/// }
+///
+/// MyData Read(dump::Reader& reader, dump::To<MyData>) {
+///   return MyData{dump::ReadChunked<MyData::Map>(reader)};
+/// }
+/// @endcode
+///
+/// @note The format is not compatible with the plain container serialization
+template <typename T>
+void WriteChunked(Writer& writer, const T& container,
+                  const ChunkedWriteOptions& options) {
+  static_assert(kIsContainer<T> && kIsWritable<meta::RangeValueType<T>>);
+  const auto chunk_size = std::max<std::size_t>(options.chunk_size, 1);
+  const auto max_parallel_chunks =
+      std::max<std::size_t>(options.max_parallel_chunks, 1);
+  const auto compression = options.compression;
+
+  const std::size_t size = std::size(container);
+  writer.Write(size);
+  writer.Write((size + chunk_size - 1) / chunk_size);
+  writer.Write(static_cast<std::uint8_t>(compression));
+
+  std::deque<engine::TaskWithResult<impl::EncodedChunk>> tasks;
+  const auto write_oldest = [&] {
+    auto chunk = tasks.front().Get();
+    tasks.pop_front();
+    if (compression != ChunkCompression::kNone) writer.Write(chunk.raw_size);
+    writer.Write(chunk.data);
+  };
+
+  auto it = std::begin(container);
+  for (std::size_t written = 0; written < size;) {
+    const auto count = std::min(chunk_size, size - written);
+    if (tasks.size() >= max_parallel_chunks) write_oldest();
+    tasks.push_back(utils::Async("dump-write-chunk", [it, count, compression] {
+      return impl::EncodeChunk<T>(it, count, compression);
+    }));
+    std::advance(it, count);
+    written += count;
+  }
+  while (!tasks.empty()) write_oldest();
+}
+
+/// @overload
+template <typename T>
+void WriteChunked(Writer& writer, const T& container,
+                  std::size_t chunk_size = kDefaultChunkSize) {
+  ChunkedWriteOptions options;
+  options.chunk_size = chunk_size;
+  WriteChunked(writer, container, options);
+}
+
+/// @brief Reads the container written by dump::WriteChunked
+///
+/// The chunks are decompressed and decoded in parallel on the current task
+/// processor while the rest of the dump is being read, then they are merged
+/// in order.
+template <typename T>
+T ReadChunked(Reader& reader) {
+  static_assert(kIsContainer<T> && kIsReadable<meta::RangeValueType<T>>);
+  const auto size = reader.Read<std::size_t>();
+  const auto chunks_count = reader.Read<std::size_t>();
+  const auto compression = impl::ReadChunkCompression(reader);
+
+  std::vector<engine::TaskWithResult<T>> tasks;
+  tasks.reserve(chunks_count);
+  for (std::size_t i = 0; i < chunks_count; ++i) {
+    const auto raw_size = compression != ChunkCompression::kNone
+                              ? reader.Read<std::size_t>()
+                              : std::size_t{0};
+    tasks.push_back(utils::Async("dump-read-chunk", &impl::ReadChunk<T>,
+                                 reader.Read<std::string>(), compression,
+                                 raw_size));
+  }
+
+  T result{};
+  if constexpr (meta::kIsReservable<T>) {
+    result.reserve(size);
+  }
+  for (auto& task : tasks) {
+    auto chunk = task.Get();
+    if constexpr (meta::kIsDetected<impl::HasMerge, T>) {
+      // moves the nodes without copying the keys
+      result.merge(chunk);
+    } else {
+      using ValueType = meta::RangeValueType<T>;
+      for (auto&& item : chunk) {
+        // explicit cast for vector<bool> shenanigans
+        dump::Insert(result, static_cast<ValueType&&>(item));
+      }
+    }
+  }
+  if (std::size(result) != size) {
+    throw Error("Unexpected size of a chunked container in the dump");
+  }
+  return result;
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -32,6 +33,21 @@ struct ConfigPatch final {
 ConfigPatch Parse(const formats::json::Value& value,
                   formats::parse::To<ConfigPatch>);
 
+/// @brief Settings of the dump file I/O, see dump::FileWriter and
+/// dump::FileReader
+struct FileIoSettings final {
+  /// Size of the aligned I/O buffer, 0 keeps the buffered `std::FILE*` I/O
+  std::size_t buffer_size{0};
+
+  /// Bypass the page cache with `O_DIRECT` where the filesystem supports it,
+  /// otherwise drop the dump from the page cache once it is written or read
+  bool direct_io{false};
+
+  /// Perform the file I/O in a separate task, so that it overlaps with
+  /// the serialization, at the cost of a second buffer
+  bool async_io{false};
+};
+
 struct Config final {
   Config(std::string name, const yaml_config::YamlConfig& config,
          std::string_view dump_root);
@@ -45,6 +61,7 @@ struct Config final {
   std::optional<std::chrono::milliseconds> max_dump_age;
   bool max_dump_age_set;
   bool dump_is_encrypted;
+  FileIoSettings file_io;
 
   bool static_dumps_enabled;
   std::chrono::milliseconds static_min_dump_interval;
@@ -84,6 +84,9 @@ enum class UpdateType {
 /// `min-interval` | `string` (duration) | `WriteDumpAsync` calls performed in a fast succession are ignored | `0s`
 /// `fs-task-processor` | `string` | `TaskProcessor` for blocking disk IO | `fs-task-processor`
 /// `encrypted` | `boolean` | Whether to encrypt the dump | `false`
+/// `io-buffer-size` | `integer` | Size of the aligned buffer for reading and writing the dump in large blocks, 0 for the buffered `FILE*` I/O. Not used for the encrypted dumps | 0
+/// `direct-io` | `boolean` | Bypass the page cache with `O_DIRECT`, or drop the dump from the page cache if it is unsupported. Requires `io-buffer-size` | `false`
+/// `async-io` | `boolean` | Overlap the file I/O with (de)serialization using a second buffer. Requires `io-buffer-size` | `false`
 /// `first-update-mode` | `string` | specifies whether required or best-effort first update will be used | skip
 /// `first-update-type` | `string` | specifies whether incremental and/or full first update will be used | full
 ///
@@ -163,7 +166,7 @@ class Dumper final {
          const components::ComponentContext& context, DumpableEntity& dumpable);
 
   class Impl;
-  utils::FastPimpl<Impl, 1040, 16> impl_;
+  utils::FastPimpl<Impl, 1136, 16> impl_;
 };
 
 }  // namespace dump
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <memory>
 
 #include <boost/filesystem/operations.hpp>
 
@@ -15,13 +16,24 @@ USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
-/// A handle to a dump file. File operations block the thread.
+namespace impl {
+class BlockFileWriter;
+class BlockFileReader;
+}  // namespace impl
+
+/// @brief A handle to a dump file. File operations block the thread.
+///
+/// With a non-zero FileIoSettings::buffer_size the data is written in large
+/// aligned blocks, see dump::FileIoSettings.
 class FileWriter final : public Writer {
  public:
   /// @brief Creates a new dump file and opens it
   /// @throws `Error` on a filesystem error
   explicit FileWriter(std::string path, boost::filesystem::perms perms,
-                      tracing::ScopeTime& scope);
+                      tracing::ScopeTime& scope,
+                      const FileIoSettings& io_settings = {});
+
+  ~FileWriter() override;
 
   void Finish() override;
 
@@ -29,32 +41,42 @@ class FileWriter final : public Writer {
   void WriteRaw(std::string_view data) override;
 
   fs::blocking::CFile file_;
+  std::unique_ptr<impl::BlockFileWriter> block_writer_;
   std::string final_path_;
   std::string path_;
   boost::filesystem::perms perms_;
   utils::StreamingCpuRelax cpu_relax_;
 };
 
-/// A handle to a dump file. File operations block the thread.
+/// @brief A handle to a dump file. File operations block the thread.
+///
+/// With a non-zero FileIoSettings::buffer_size the data is read in large
+/// aligned blocks, see dump::FileIoSettings.
 class FileReader final : public Reader {
  public:
   /// @brief Opens an existing dump file
   /// @throws `Error` on a filesystem error
-  explicit FileReader(std::string path);
+  explicit FileReader(std::string path,
+                      const FileIoSettings& io_settings = {});
+
+  ~FileReader() override;
 
   void Finish() override;
 
  private:
   std::string_view ReadRaw(std::size_t max_size) override;
+  void FinishBlockReader();
 
   fs::blocking::CFile file_;
+  std::unique_ptr<impl::BlockFileReader> block_reader_;
   std::string path_;
   std::string curr_chunk_;
 };
 
 class FileOperationsFactory final : public OperationsFactory {
  public:
-  explicit FileOperationsFactory(boost::filesystem::perms perms);
+  explicit FileOperationsFactory(boost::filesystem::perms perms,
+                                 const FileIoSettings& io_settings = {});
 
   std::unique_ptr<Reader> CreateReader(std::string full_path) override;
 
@@ -63,6 +85,7 @@ class FileOperationsFactory final : public OperationsFactory {
 
  private:
   const boost::filesystem::perms perms_;
+  const FileIoSettings io_settings_;
 };
 
 }  // namespace dump
@@ -2,6 +2,7 @@
 
 #include <any>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <type_traits>
 #include <typeindex>
@@ -46,8 +47,13 @@ class SnapshotData final {
   SnapshotData(const SnapshotData& defaults,
                const std::vector<KeyValue>& overrides);
 
-  SnapshotData(SnapshotData&&) noexcept = default;
-  SnapshotData& operator=(SnapshotData&&) noexcept = default;
+  /// Parses the variables from `docs_map`, reusing the ones of `previous`
+  /// that were parsed from the same docs
+  SnapshotData(const DocsMap& docs_map, const SnapshotData& previous);
+
+  SnapshotData(SnapshotData&&) noexcept;
+  SnapshotData& operator=(SnapshotData&&) noexcept;
+  ~SnapshotData();
 
   template <typename Key>
   const auto& operator[](Key) const {
@@ -59,10 +65,19 @@ class SnapshotData final {
     }
   }
 
+  /// Changes each time the variable is parsed or overridden, 0 if the
+  /// variable is missing
+  std::uint64_t GetVersion(ConfigId id) const;
+
+  /// Checks that all the variables are the same as in `other`
+  bool HasSameVersions(const SnapshotData& other) const;
+
+  struct Variable;
+
  private:
   const std::any& Get(impl::ConfigId id) const;
 
-  std::vector<std::any> user_configs_;
+  std::vector<Variable> user_configs_;
 };
 
 struct StorageData;
@@ -29,7 +29,8 @@ using VariableOfKey = decltype(Key::Parse(std::declval<const DocsMap&>()));
 ///
 /// When a config update comes in via new `DocsMap`, configs of all
 /// the registered types are constructed and stored in `Config`. After that
-/// the `DocsMap` is dropped.
+/// the `DocsMap` is dropped. The configs whose docs did not change since
+/// the previous update are not parsed again, the previous values are reused.
 ///
 /// Config types are automatically registered if they are accessed with `Get`
 /// somewhere in the program.
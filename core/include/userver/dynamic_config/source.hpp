@@ -5,6 +5,7 @@
 
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <userver/concurrent/async_event_source.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
@@ -100,6 +101,24 @@ class Source final {
         });
   }
 
+  /// Subscribes to updates of the config variables of `keys` only, using
+  /// a member function. Also immediately invokes the function with the current
+  /// config snapshot. The updates that leave all of `keys` unchanged are
+  /// skipped.
+  template <typename Class, typename... Keys>
+  concurrent::AsyncEventSubscriberScope UpdateAndListen(
+      Class* obj, std::string_view name,
+      void (Class::*func)(const dynamic_config::Snapshot& config),
+      const Keys&... keys) {
+    static_assert(sizeof...(Keys) > 0);
+    return DoUpdateAndListen(
+        concurrent::FunctionId(obj), name,
+        [obj, func](const dynamic_config::Snapshot& config) {
+          (obj->*func)(config);
+        },
+        {impl::kConfigId<Keys>...});
+  }
+
   EventSource& GetEventChannel();
 
  private:
@@ -107,6 +126,10 @@ class Source final {
       concurrent::FunctionId id, std::string_view name,
       EventSource::Function&& func);
 
+  concurrent::AsyncEventSubscriberScope DoUpdateAndListen(
+      concurrent::FunctionId id, std::string_view name,
+      EventSource::Function&& func, std::vector<impl::ConfigId> ids);
+
   impl::StorageData* storage_;
 };
 
@@ -4,6 +4,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <userver/formats/json/serialize_container.hpp>
 #include <userver/formats/json/value.hpp>
@@ -30,9 +31,21 @@ class DocsMap final {
 
   bool AreContentsEqual(const DocsMap& other) const;
 
+  /// @cond
+  // For internal use only. Appends the names passed to `Get` to `names` until
+  // `StopRecordingRequests` is called.
+  void StartRecordingRequests(std::vector<std::string>& names) const;
+  void StopRecordingRequests() const;
+
+  // For internal use only. Returns nullptr if there is no doc for `name`,
+  // does not mark the doc as requested.
+  const formats::json::Value* Find(const std::string& name) const;
+  /// @endcond
+
  private:
   std::unordered_map<std::string, formats::json::Value> docs_;
   mutable std::unordered_set<std::string> requested_names_;
+  mutable std::vector<std::string>* recorded_names_{nullptr};
 };
 
 template <typename T>
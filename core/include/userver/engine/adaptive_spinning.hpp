@@ -0,0 +1,62 @@
+#pragma once
+
+/// @file userver/engine/adaptive_spinning.hpp
+/// @brief @copybrief engine::AdaptiveSpinning
+
+#include <cstdint>
+#include <string>
+
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+/// @ingroup userver_concurrency
+///
+/// @brief Makes engine::Mutex, engine::Semaphore or engine::SharedMutex spin
+/// for a short while before putting the coroutine to sleep.
+///
+/// Spinning is done only if the task processor of the waiting task has more
+/// than one worker thread, so that the lock could be released in parallel.
+/// Whether the owner is running right now is not checked: a sleeping owner
+/// is waited for by spinning until the spin budget is exhausted. The spin
+/// budget adapts to the observed hold times: short critical sections are
+/// waited for by spinning, long ones quickly fall back to sleeping.
+///
+/// Use it only for locks that guard very short critical sections under
+/// contention, e.g. small in-memory caches.
+struct AdaptiveSpinning final {
+  /// Name of the lock, used by the users in the statistics
+  std::string name;
+};
+
+/// @brief Contention statistics of a lock with engine::AdaptiveSpinning
+///
+/// DumpMetric writes the values with the `lock` label set to the name.
+struct LockContentionStatistics final {
+  /// AdaptiveSpinning::name of the lock
+  std::string name;
+
+  /// Acquisitions without waiting
+  std::uint64_t fast_path{0};
+
+  /// Acquisitions after spinning
+  std::uint64_t spin_acquired{0};
+
+  /// Acquisitions after going to sleep, including the timed out ones
+  std::uint64_t slept{0};
+
+  /// Total amount of spin iterations
+  std::uint64_t spin_iterations{0};
+
+  /// Current spin budget in iterations
+  std::uint64_t spin_budget{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const LockContentionStatistics& stats);
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -156,6 +156,29 @@ template <typename Function, typename... Args>
       std::forward<Function>(f), std::forward<Args>(args)...);
 }
 
+/// @brief Runs a tiny function call on the coroutine of the caller if
+/// possible, falling back to a regular asynchronous task otherwise.
+///
+/// The call is performed right away, before InlineAsyncNoSpan returns, so the
+/// returned task is already finished and no context switch or queueing
+/// happens. Inside the function current_task:: refers to the caller and a
+/// blocking function blocks the caller.
+///
+/// The fallback to AsyncNoSpan happens if the caller is cancelled or the
+/// inline calls are nested too deep.
+///
+/// Use it only for short non-blocking continuations, e.g. to avoid spawning
+/// a task just to run a callback that is expected to be an engine::Task.
+template <typename Function, typename... Args>
+[[nodiscard]] auto InlineAsyncNoSpan(Function&& f, Args&&... args) {
+  auto wrapped_call_ptr = utils::impl::WrapCall(std::forward<Function>(f),
+                                                std::forward<Args>(args)...);
+  using ResultType = decltype(wrapped_call_ptr->Retrieve());
+  return TaskWithResult<ResultType>(
+      current_task::GetTaskProcessor(), Task::Importance::kNormal, {},
+      std::move(wrapped_call_ptr), impl::TryRunInlineTag{});
+}
+
 }  // namespace engine
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,31 @@
+#pragma once
+
+/// @file userver/engine/benchmark_helpers.hpp
+/// @brief @copybrief engine::RunInSharedEngine
+
+#include <cstddef>
+#include <functional>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+/// @brief Runs a payload in a coroutine engine that is shared by the
+/// benchmarks of the executable.
+///
+/// Unlike engine::RunStandalone, the engine is not destroyed after the
+/// payload, so the engine startup and the coroutine pool growth are not
+/// measured in every run of the benchmark, and the runs with the same
+/// `worker_threads` reuse the warmed up engine. The engine is recreated when
+/// `worker_threads` changes.
+///
+/// Available in the `ubench` target only.
+///
+/// @warning Must not be mixed with engine::RunStandalone in a single
+/// benchmark, the engines should not coexist.
+void RunInSharedEngine(std::size_t worker_threads,
+                       std::function<void()> payload);
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -91,7 +91,7 @@ class Storage final {
   Storage& operator=(Storage&&) = delete;
   ~Storage();
 
-  // Copies pointers to inherited variables from 'other'
+  // Shares the inherited variables of 'other', O(1)
   // 'this' must not contain any variables
   void InheritFrom(Storage& other);
 
@@ -103,7 +103,7 @@ class Storage final {
   // Otherwise it is UB.
   template <typename T, VariableKind Kind>
   T& GetOrEmplace(Key key) {
-    DataBase* const old_data = GetGeneric(key);
+    DataBase* const old_data = GetGeneric<Kind>(key);
     if (!old_data) {
       const bool has_existing_variable = false;
       return DoEmplace<T, Kind>(key, has_existing_variable);
@@ -113,7 +113,7 @@ class Storage final {
 
   template <typename T, VariableKind Kind>
   T* GetOptional(Key key) noexcept {
-    DataBase* const data = GetGeneric(key);
+    DataBase* const data = GetGeneric<Kind>(key);
     if (!data) return nullptr;
     return &static_cast<DataImpl<T, Kind>&>(*data).Get();
   }
@@ -127,7 +127,7 @@ class Storage final {
 
   template <typename T, VariableKind Kind, typename... Args>
   T& Emplace(Key key, Args&&... args) {
-    DataBase* const old_data = GetGeneric(key);
+    DataBase* const old_data = GetGeneric<Kind>(key);
     const bool has_existing_variable = old_data != nullptr;
     auto& result = DoEmplace<T, Kind>(key, has_existing_variable,
                                       std::forward<Args>(args)...);
@@ -136,19 +136,30 @@ class Storage final {
   }
 
   template <typename T, VariableKind Kind>
-  void Erase(Key key) noexcept {
+  void Erase(Key key) {
     static_assert(Kind == VariableKind::kInherited);
     EraseInherited(key);
   }
 
  private:
-  DataBase* GetGeneric(Key key) noexcept;
+  template <VariableKind Kind>
+  DataBase* GetGeneric(Key key) noexcept {
+    if constexpr (Kind == VariableKind::kInherited) {
+      return GetInheritedGeneric(key);
+    } else {
+      return GetNormalGeneric(key);
+    }
+  }
+
+  DataBase* GetNormalGeneric(Key key) noexcept;
+
+  DataBase* GetInheritedGeneric(Key key) noexcept;
 
   void SetGeneric(Key key, NormalDataBase& node, bool has_existing_variable);
 
   void SetGeneric(Key key, InheritedDataBase& node, bool has_existing_variable);
 
-  void EraseInherited(Key key) noexcept;
+  void EraseInherited(Key key);
 
   // Provides strong exception guarantee. Does not delete the old data, if any.
   template <typename T, VariableKind Kind, typename... Args>
@@ -5,6 +5,7 @@
 
 #include <functional>
 #include <string>
+#include <string_view>
 
 #include <userver/compiler/select.hpp>
 #include <userver/engine/deadline.hpp>
@@ -71,6 +72,32 @@ class BufferedReader final {
   /// Discards the specified number of bytes from the buffer.
   void Discard(size_t num_bytes, Deadline deadline = {});
 
+  /// @name Zero-copy reading
+  /// The returned views point into the internal buffer and are invalidated by
+  /// any non-const call. Bytes stay in the buffer until consumed.
+  /// @{
+
+  /// Returns some buffered bytes, reads from the input if the buffer is empty.
+  std::string_view PeekSome(size_t max_bytes, Deadline deadline = {});
+
+  /// @brief Returns the exact number of bytes from the input stream.
+  /// @note May return less bytes than requested in case of EOF.
+  std::string_view PeekAll(size_t num_bytes, Deadline deadline = {});
+
+  /// @brief Returns the bytes up to and including the `terminator`.
+  /// @throws TerminatorNotFoundException if EOF is encountered first
+  std::string_view PeekUntil(char terminator, Deadline deadline = {});
+
+  /// @brief Skips empty lines and returns a line without line terminators.
+  /// @note The terminator is left in the buffer after consuming the line, the
+  /// next PeekLine or ReadLine skips it.
+  std::string_view PeekLine(Deadline deadline = {});
+
+  /// Removes the specified number of already buffered bytes.
+  void Consume(size_t num_bytes);
+
+  /// @}
+
  private:
   size_t FillBuffer(Deadline deadline);
 
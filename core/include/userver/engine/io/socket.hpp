@@ -103,6 +103,15 @@ class USERVER_NODISCARD Socket final : public RwBase {
   /// @note Can return less than len if socket is closed by peer.
   [[nodiscard]] size_t SendAll(const void* buf, size_t len, Deadline deadline);
 
+  /// @brief Sends exactly len bytes of the file starting at the offset to the
+  /// socket without copying them to the userspace (sendfile(2) on Linux).
+  /// @note Can return less than len if socket is closed by peer or if the file
+  /// is shorter than expected.
+  /// @warning The file is read synchronously, it should be in the page cache
+  /// for the call not to block the task processor thread.
+  [[nodiscard]] size_t SendAllFile(int file_fd, std::size_t offset,
+                                   std::size_t len, Deadline deadline);
+
   /// @brief Accepts a connection from a listening socket.
   /// @see engine::io::Listen
   [[nodiscard]] Socket Accept(Deadline);
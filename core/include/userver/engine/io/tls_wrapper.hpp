@@ -3,6 +3,7 @@
 /// @file userver/engine/io/tls_wrapper.hpp
 /// @brief TLS socket wrappers
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -18,6 +19,43 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::io {
 
+/// @brief TLS sessions shared between the TlsWrapper connections, so that the
+/// reconnects skip the full handshake.
+///
+/// A server encrypts its session tickets with the keys of the cache, so a
+/// ticket issued on one connection is accepted on the others. A client
+/// remembers the last session of each server name and offers it on the next
+/// connect.
+///
+/// Thread safe.
+class TlsSessionCache final {
+ public:
+  TlsSessionCache();
+  ~TlsSessionCache();
+
+  TlsSessionCache(const TlsSessionCache&) = delete;
+  TlsSessionCache& operator=(const TlsSessionCache&) = delete;
+
+ private:
+  friend class TlsWrapper;
+
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/// Optional TlsWrapper features
+struct TlsOptions final {
+  /// @brief Whether to offload the records encryption to the kernel after the
+  /// handshake.
+  ///
+  /// Requires Linux 4.17+ with the `tls` module loaded and OpenSSL 3.0+ built
+  /// with kTLS support, the records are encrypted in user space otherwise.
+  bool kernel_tls{false};
+
+  /// Sessions to resume, each connection makes a full handshake if not set
+  std::shared_ptr<TlsSessionCache> session_cache;
+};
+
 /// Class for TLS communications over a Socket.
 ///
 /// Not thread safe.
@@ -31,12 +69,25 @@ class USERVER_NODISCARD TlsWrapper final : public RwBase {
                                    const std::string& server_name,
                                    Deadline deadline);
 
+  /// Starts a TLS client with optional features on an opened socket
+  static TlsWrapper StartTlsClient(Socket&& socket,
+                                   const std::string& server_name,
+                                   Deadline deadline,
+                                   const TlsOptions& options);
+
   /// Starts a TLS server on an opened socket
   static TlsWrapper StartTlsServer(
       Socket&& socket, const crypto::Certificate& cert,
       const crypto::PrivateKey& key, Deadline deadline,
       const std::vector<crypto::Certificate>& cert_authorities = {});
 
+  /// Starts a TLS server with optional features on an opened socket
+  static TlsWrapper StartTlsServer(
+      Socket&& socket, const crypto::Certificate& cert,
+      const crypto::PrivateKey& key, Deadline deadline,
+      const std::vector<crypto::Certificate>& cert_authorities,
+      const TlsOptions& options);
+
   ~TlsWrapper() override;
 
   TlsWrapper(const TlsWrapper&) = delete;
@@ -48,6 +99,12 @@ class USERVER_NODISCARD TlsWrapper final : public RwBase {
   /// Whether the socket is valid.
   bool IsValid() const override;
 
+  /// Whether the session was resumed instead of the full handshake.
+  bool IsSessionReused() const;
+
+  /// Whether the records are encrypted by the kernel.
+  bool IsKernelTlsEnabled() const;
+
   /// Suspends current task until the socket has data available.
   [[nodiscard]] bool WaitReadable(Deadline) override;
 
@@ -7,6 +7,7 @@
 #include <chrono>
 #include <mutex>  // for std locks
 
+#include <userver/engine/adaptive_spinning.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/impl/wait_list_fwd.hpp>
 
@@ -26,6 +27,11 @@ namespace engine {
 class Mutex final {
  public:
   Mutex();
+
+  /// Creates a mutex that spins for a short while before going to sleep, see
+  /// engine::AdaptiveSpinning
+  explicit Mutex(AdaptiveSpinning settings);
+
   ~Mutex();
 
   Mutex(const Mutex&) = delete;
@@ -58,6 +64,10 @@ class Mutex final {
 
   bool try_lock_until(Deadline deadline);
 
+  /// Returns empty statistics if the mutex was created without
+  /// engine::AdaptiveSpinning
+  LockContentionStatistics GetContentionStatistics() const;
+
  private:
   class Impl;
 
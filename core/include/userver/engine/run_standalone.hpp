@@ -3,6 +3,7 @@
 /// @file userver/engine/run_standalone.hpp
 /// @brief @copybrief engine::RunStandalone
 
+#include <chrono>
 #include <cstddef>
 #include <functional>
 #include <string>
@@ -20,6 +21,8 @@ struct TaskProcessorPoolsConfig final {
   std::string ev_thread_name = "ev";
   bool ev_default_loop_disabled = false;
   bool defer_events = true;
+  std::chrono::milliseconds ev_timer_wheel_slack{0};
+  bool ev_use_io_uring = false;
 };
 
 /// @brief Runs a payload in a temporary coroutine engine instance.
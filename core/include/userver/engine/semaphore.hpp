@@ -8,6 +8,7 @@
 #include <shared_mutex>  // for std locks
 #include <stdexcept>
 
+#include <userver/engine/adaptive_spinning.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/impl/wait_list_fwd.hpp>
 
@@ -19,6 +20,10 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine {
 
+namespace impl {
+class AdaptiveSpinner;
+}  // namespace impl
+
 /// Thrown by engine::Semaphore when an amount of locks greater than its current
 /// capacity is requested.
 class UnreachableSemaphoreLockError final : public std::runtime_error {
@@ -44,6 +49,10 @@ class Semaphore final {
   /// @param capacity initial number of available locks
   explicit Semaphore(Counter capacity);
 
+  /// Creates a semaphore that spins for a short while before going to sleep,
+  /// see engine::AdaptiveSpinning
+  Semaphore(Counter capacity, AdaptiveSpinning settings);
+
   ~Semaphore();
 
   Semaphore(Semaphore&&) = delete;
@@ -99,16 +108,22 @@ class Semaphore final {
   [[nodiscard]] bool try_lock_shared_until_count(Deadline deadline,
                                                  Counter count);
 
+  /// Returns empty statistics if the semaphore was created without
+  /// engine::AdaptiveSpinning
+  LockContentionStatistics GetContentionStatistics() const;
+
  private:
   enum class TryLockStatus { kSuccess, kTransientFailure, kPermanentFailure };
 
   TryLockStatus DoTryLock(Counter count);
   TryLockStatus LockFastPath(Counter count);
+  bool LockSpinning(Counter count, TryLockStatus& status);
   bool LockSlowPath(Deadline, Counter count);
 
   impl::FastPimplWaitList lock_waiters_;
   std::atomic<Counter> acquired_locks_;
   std::atomic<Counter> capacity_;
+  const std::unique_ptr<impl::AdaptiveSpinner> spinner_;
 };
 
 /// A replacement for std::shared_lock that accepts Deadline arguments
@@ -23,6 +23,11 @@ namespace engine {
 class SharedMutex final {
  public:
   SharedMutex();
+
+  /// Creates a mutex that spins for a short while before going to sleep, see
+  /// engine::AdaptiveSpinning
+  explicit SharedMutex(AdaptiveSpinning settings);
+
   ~SharedMutex() = default;
 
   SharedMutex(const SharedMutex&) = delete;
@@ -55,6 +60,10 @@ class SharedMutex final {
 
   bool try_lock_shared_until(Deadline deadline);
 
+  /// Returns empty statistics if the mutex was created without
+  /// engine::AdaptiveSpinning
+  LockContentionStatistics GetContentionStatistics() const;
+
  private:
   bool HasWaitingWriter() const noexcept;
 
@@ -13,6 +13,11 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace engine::io {
+class PipeReader;
+class PipeWriter;
+}  // namespace engine::io
+
 namespace engine::subprocess {
 
 class ChildProcessImpl;
@@ -63,9 +68,22 @@ class ChildProcess final {
   /// Send a signal to the child process.
   void SendSignal(int signum);
 
+  /// @brief Writing end of the pipe connected to the child stdin, close it
+  /// to send EOF to the child.
+  /// @throws std::logic_error if the ExecOptions::pipe_stdin was not set
+  io::PipeWriter& GetStdin();
+
+  /// @brief Reading end of the pipe connected to the child stdout.
+  /// @throws std::logic_error if the ExecOptions::pipe_stdout was not set
+  io::PipeReader& GetStdout();
+
+  /// @brief Reading end of the pipe connected to the child stderr.
+  /// @throws std::logic_error if the ExecOptions::pipe_stderr was not set
+  io::PipeReader& GetStderr();
+
  private:
   static constexpr std::size_t kImplSize =
-      compiler::SelectSize().For64Bit(24).For32Bit(12);
+      compiler::SelectSize().For64Bit(96).For32Bit(48);
   static constexpr std::size_t kImplAlignment = alignof(void*);
   utils::FastPimpl<ChildProcessImpl, kImplSize, kImplAlignment> impl_;
 };
@@ -14,21 +14,50 @@
 
 USERVER_NAMESPACE_BEGIN
 
-namespace engine {
+namespace engine::subprocess {
 
-namespace ev {
-class ThreadControl;
-}  // namespace ev
+/// @brief Options of the ProcessStarter::Exec
+struct ExecOptions final {
+  /// Append the child stdout to the file
+  std::optional<std::string> stdout_file;
 
-namespace subprocess {
+  /// Append the child stderr to the file
+  std::optional<std::string> stderr_file;
+
+  /// Connect the child stdin to ChildProcess::GetStdin()
+  bool pipe_stdin{false};
+
+  /// Connect the child stdout to ChildProcess::GetStdout(), incompatible with
+  /// `stdout_file`
+  bool pipe_stdout{false};
+
+  /// Connect the child stderr to ChildProcess::GetStderr(), incompatible with
+  /// `stderr_file`
+  bool pipe_stderr{false};
+};
 
 /// @ingroup userver_clients
 ///
 /// @brief Creates a new OS subprocess and executes a command in it.
+///
+/// The subprocess is started via `posix_spawn` in the calling thread, which
+/// does not copy the page tables of the service and does not block the event
+/// loop.
 class ProcessStarter {
  public:
   explicit ProcessStarter(TaskProcessor& task_processor);
 
+  /// `env` redefines all environment variables.
+  ChildProcess Exec(const std::string& command,
+                    const std::vector<std::string>& args,
+                    const EnvironmentVariables& env,
+                    const ExecOptions& options);
+
+  /// Exec subprocess using current environment.
+  ChildProcess Exec(const std::string& command,
+                    const std::vector<std::string>& args,
+                    const ExecOptions& options);
+
   /// `env` redefines all environment variables.
   ChildProcess Exec(
       const std::string& command, const std::vector<std::string>& args,
@@ -52,12 +81,8 @@ class ProcessStarter {
       // TODO: use something like pipes instead of path to files
       const std::optional<std::string>& stdout_file = std::nullopt,
       const std::optional<std::string>& stderr_file = std::nullopt);
-
- private:
-  ev::ThreadControl& thread_control_;
 };
 
-}  // namespace subprocess
-}  // namespace engine
+}  // namespace engine::subprocess
 
 USERVER_NAMESPACE_END
@@ -4,6 +4,7 @@
 /// @brief @copybrief engine::Task
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -30,8 +31,20 @@ class TaskContext;
 class DetachedTasksSyncBlock;
 class ContextAccessor;
 using TaskPayload = std::unique_ptr<utils::impl::WrappedCallBase>;
+struct TryRunInlineTag final {};
 }  // namespace impl
 
+/// @brief Scheduling class of a task inside its TaskProcessor.
+///
+/// Workers dequeue the classes in a weighted round-robin, so a busy
+/// TaskProcessor still makes progress on all the classes, while an idle one
+/// runs everything right away.
+enum class TaskPriority {
+  kLatencyCritical,  ///< Gets the largest share of the workers
+  kNormal,           ///< Default class
+  kBackground,       ///< Gets the idle CPU, e.g. cache updates and dumps
+};
+
 /// Asynchronous task
 class USERVER_NODISCARD Task {
  public:
@@ -163,6 +176,11 @@ class USERVER_NODISCARD Task {
   Task(TaskProcessor&, Task::Importance, Task::WaitMode, Deadline,
        impl::TaskPayload&&);
 
+  /// Constructor for internal use, runs the payload on the calling coroutine
+  /// if possible, see engine::InlineAsyncNoSpan
+  Task(TaskProcessor&, Task::Importance, Task::WaitMode, Deadline,
+       impl::TaskPayload&&, impl::TryRunInlineTag);
+
   /// Marks task as invalid
   void Invalidate() noexcept;
 
@@ -183,6 +201,15 @@ class USERVER_NODISCARD Task {
   boost::intrusive_ptr<impl::TaskContext> context_;
 };
 
+/// On-CPU time and the amount of suspensions of a task
+struct TaskExecutionStatistics final {
+  /// Time the task spent executing, excluding the time in queue and waiting
+  std::chrono::nanoseconds cpu_time{};
+
+  /// Amount of times the task was suspended to wait for something
+  std::uint64_t context_switches{0};
+};
+
 namespace current_task {
 
 /// Returns reference to the task processor executing the caller
@@ -203,6 +230,21 @@ void AccountSpuriousWakeup();
 /// Returns task coroutine stack size
 size_t GetStackSize();
 
+/// Returns the scheduling class of the current task
+TaskPriority GetPriority() noexcept;
+
+/// @brief Changes the scheduling class of the current task.
+///
+/// Takes effect from the next time the task is queued. The tasks started by
+/// the current task afterwards inherit the new class.
+void SetPriority(TaskPriority priority) noexcept;
+
+/// @brief Returns the execution statistics of the current task so far.
+///
+/// The differences of two calls describe the work done between them, e.g. by
+/// a request handler.
+TaskExecutionStatistics GetExecutionStatistics() noexcept;
+
 }  // namespace current_task
 
 template <typename Rep, typename Period>
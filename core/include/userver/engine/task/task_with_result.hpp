@@ -47,6 +47,16 @@ class USERVER_NODISCARD TaskWithResult : public Task {
       : Task(task_processor, importance, Task::WaitMode::kSingleWaiter,
              deadline, std::move(wrapped_call_ptr)) {}
 
+  /// @brief Constructor, for internal use only
+  /// @see InlineAsyncNoSpan()
+  TaskWithResult(
+      TaskProcessor& task_processor, Task::Importance importance,
+      Deadline deadline,
+      std::unique_ptr<utils::impl::WrappedCall<T>>&& wrapped_call_ptr,
+      impl::TryRunInlineTag tag)
+      : Task(task_processor, importance, Task::WaitMode::kSingleWaiter,
+             deadline, std::move(wrapped_call_ptr), tag) {}
+
   TaskWithResult(const TaskWithResult&) = delete;
   TaskWithResult& operator=(const TaskWithResult&) = delete;
 
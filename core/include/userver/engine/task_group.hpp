@@ -0,0 +1,161 @@
+#pragma once
+
+/// @file userver/engine/task_group.hpp
+/// @brief @copybrief engine::TaskGroup
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace impl {
+
+class TaskGroupState;
+
+void OnTaskGroupChildFinished(TaskGroupState& state, bool failed) noexcept;
+
+// Notifies the group when the function is done with or without being invoked,
+// e.g. if the task was cancelled before its start
+template <typename Function>
+class TaskGroupCall final {
+ public:
+  TaskGroupCall(std::shared_ptr<TaskGroupState> state, Function&& func)
+      : state_(std::move(state)), func_(std::move(func)) {}
+
+  TaskGroupCall(TaskGroupCall&&) noexcept = default;
+  TaskGroupCall& operator=(TaskGroupCall&&) = delete;
+
+  ~TaskGroupCall() {
+    if (state_) OnTaskGroupChildFinished(*state_, failed_);
+  }
+
+  template <typename... Args>
+  decltype(auto) operator()(Args&&... args) {
+    try {
+      return std::invoke(std::move(func_), std::forward<Args>(args)...);
+    } catch (const std::exception&) {
+      failed_ = true;
+      throw;
+    }
+  }
+
+ private:
+  std::shared_ptr<TaskGroupState> state_;
+  Function func_;
+  bool failed_{false};
+};
+
+}  // namespace impl
+
+/// @ingroup userver_concurrency
+///
+/// @brief Tracks the completion of a batch of child tasks with a single shared
+/// counter.
+///
+/// Unlike engine::WaitAllChecked or engine::WaitAny, waiting for the group
+/// does not subscribe to the wait list of every task: a child notifies the
+/// group once it is finished, and the waiter is woken up only when the
+/// requested amount of children is finished. That makes the "wait for N of M"
+/// fan-outs O(1) in subscriptions instead of O(M).
+///
+/// The children are regular engine::TaskWithResult, their results are
+/// retrieved as usual. A child is considered finished when its function
+/// returned, threw or was dropped because the task was cancelled before
+/// its start.
+///
+/// With ErrorPolicy::kCancelOnFirstError the first child that throws an
+/// exception cancels all the other children of the group.
+///
+/// All the methods should be called from the task that owns the group.
+///
+/// ## Example usage:
+///
+/// @snippet engine/task_group_test.cpp  Sample engine::TaskGroup usage
+class TaskGroup final {
+ public:
+  enum class ErrorPolicy {
+    kIndependent,
+    kCancelOnFirstError,
+  };
+
+  explicit TaskGroup(ErrorPolicy policy = ErrorPolicy::kIndependent);
+  ~TaskGroup();
+
+  TaskGroup(TaskGroup&&) = delete;
+  TaskGroup& operator=(TaskGroup&&) = delete;
+
+  /// Reserves the space for the `count` children bookkeeping
+  void Reserve(std::size_t count);
+
+  /// Runs an asynchronous function call as a child of the group using
+  /// specified task processor
+  template <typename Function, typename... Args>
+  [[nodiscard]] auto AsyncNoSpan(TaskProcessor& task_processor, Function&& f,
+                                 Args&&... args);
+
+  /// Runs an asynchronous function call as a child of the group using
+  /// task processor of the caller
+  template <typename Function, typename... Args>
+  [[nodiscard]] auto AsyncNoSpan(Function&& f, Args&&... args);
+
+  /// Amount of children started
+  std::size_t GetSize() const noexcept;
+
+  /// Amount of finished children
+  std::size_t GetFinishedCount() const noexcept;
+
+  /// Amount of children finished with an exception
+  std::size_t GetFailedCount() const noexcept;
+
+  /// @brief Waits until `count` children are finished.
+  /// @returns false if the deadline is reached or the current task is
+  /// cancelled first.
+  [[nodiscard]] bool WaitForCount(std::size_t count, Deadline deadline = {});
+
+  /// @brief Waits until all the children are finished.
+  /// @returns false if the deadline is reached or the current task is
+  /// cancelled first.
+  [[nodiscard]] bool WaitAll(Deadline deadline = {});
+
+  /// Requests cancellation of all the children, including the ones started
+  /// later
+  void CancelAll();
+
+ private:
+  void Register(Task& task);
+
+  std::shared_ptr<impl::TaskGroupState> state_;
+};
+
+template <typename Function, typename... Args>
+auto TaskGroup::AsyncNoSpan(TaskProcessor& task_processor, Function&& f,
+                            Args&&... args) {
+  auto task = engine::AsyncNoSpan(
+      task_processor,
+      impl::TaskGroupCall<std::decay_t<Function>>{
+          state_, std::decay_t<Function>(std::forward<Function>(f))},
+      std::forward<Args>(args)...);
+  Register(task);
+  return task;
+}
+
+template <typename Function, typename... Args>
+auto TaskGroup::AsyncNoSpan(Function&& f, Args&&... args) {
+  return AsyncNoSpan(current_task::GetTaskProcessor(),
+                     std::forward<Function>(f), std::forward<Args>(args)...);
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
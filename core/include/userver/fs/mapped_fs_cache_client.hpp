@@ -0,0 +1,114 @@
+#pragma once
+
+/// @file userver/fs/mapped_fs_cache_client.hpp
+/// @brief @copybrief fs::MappedFsCacheClient
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fs {
+
+/// @brief Regular file that is open and mapped into the memory read-only
+///
+/// @warning Replace the files atomically with rename(2) instead of rewriting
+/// them in place: reading the mapping past the end of a truncated file
+/// raises SIGBUS.
+class MappedFile final {
+ public:
+  /// @brief Maps the first `size` bytes of the file
+  /// @throws std::system_error
+  MappedFile(blocking::FileDescriptor fd, std::size_t size,
+             std::string extension);
+
+  MappedFile(MappedFile&&) = delete;
+  MappedFile& operator=(MappedFile&&) = delete;
+  ~MappedFile();
+
+  /// Contents of the file as it was mapped
+  std::string_view GetData() const;
+
+  std::size_t GetSize() const { return size_; }
+
+  /// Extension of the file name with the dot, e.g. ".html"
+  const std::string& GetExtension() const { return extension_; }
+
+  /// Open descriptor of the file, e.g. for sendfile(2)
+  const blocking::FileDescriptor& GetFileDescriptor() const { return fd_; }
+
+ private:
+  blocking::FileDescriptor fd_;
+  void* data_{nullptr};
+  std::size_t size_{0};
+  std::string extension_;
+};
+
+using MappedFileConstPtr = std::shared_ptr<const MappedFile>;
+
+/// @ingroup userver_clients
+///
+/// @brief Client for serving the files of a directory without copying them
+/// into the heap. Usually retrieved from `components::MappedFsCache`
+///
+/// Unlike fs::FsCacheClient it does not read the whole directory at once: a
+/// file is opened and mapped at the first request, at most `max_files` of
+/// the least recently used ones are kept that way. On Linux the cached file
+/// is dropped as soon as it is changed, moved or removed (inotify(7)), so the
+/// next request gets the new version.
+class MappedFsCacheClient final {
+ public:
+  /// @param dir directory to serve files from
+  /// @param max_files how many files to keep open and mapped
+  /// @param tp task processor to do filesystem operations
+  MappedFsCacheClient(std::string_view dir, std::size_t max_files,
+                      engine::TaskProcessor& tp);
+
+  MappedFsCacheClient(MappedFsCacheClient&&) = delete;
+  MappedFsCacheClient& operator=(MappedFsCacheClient&&) = delete;
+  ~MappedFsCacheClient();
+
+  /// @brief get the file, map it if it is not cached
+  /// @param path path to the file relative to the directory, e.g.
+  /// "/index.html". Hidden files and directories are not served.
+  /// @return the mapped file ; `nullptr` if there's no regular file with
+  /// specified name on FS
+  MappedFileConstPtr TryGetFile(std::string_view path) const;
+
+ private:
+  struct Entry {
+    MappedFileConstPtr file;
+    std::string path;
+    int watch_descriptor;
+  };
+
+  MappedFileConstPtr LoadFile(const std::string& path) const;
+  void Forget(const std::string& path, int watch_descriptor) const;
+  void Invalidate(int watch_descriptor);
+  void WatchChanges();
+
+  const std::string dir_;
+  const std::size_t max_files_;
+  engine::TaskProcessor& tp_;
+  int inotify_fd_{-1};
+
+  mutable engine::Mutex mutex_;
+  mutable cache::LruMap<std::string, Entry> files_;
+  // Several paths may refer to the same watched file via links
+  mutable std::unordered_multimap<int, std::string> watched_paths_;
+
+  engine::TaskWithResult<void> watcher_task_;
+};
+
+}  // namespace fs
+
+USERVER_NAMESPACE_END
@@ -3,8 +3,11 @@
 /// @file userver/logging/component.hpp
 /// @brief @copybrief components::Logging
 
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <userver/components/component_fwd.hpp>
 #include <userver/components/impl/component_base.hpp>
@@ -12,6 +15,7 @@
 #include <userver/os_signals/component.hpp>
 
 #include <userver/utils/periodic_task.hpp>
+#include <userver/utils/statistics/fwd.hpp>
 
 #include "logger.hpp"
 
@@ -19,7 +23,11 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging {
 struct LoggerConfig;
-}
+
+namespace impl {
+class ThreadBufferedLogger;
+}  // namespace impl
+}  // namespace logging
 
 namespace components {
 
@@ -37,10 +45,14 @@ namespace components {
 /// ---- | ----------- | -------------
 /// file_path | path to the log file | -
 /// level | log verbosity | info
-/// format | log output format, either `tskv` or `ltsv` | tskv
+/// format | log output format, one of `tskv`, `ltsv`, `raw` or `binary` | tskv
 /// flush_level | messages of this and higher levels get flushed to the file immediately | warning
-/// message_queue_size | the size of internal message queue, must be a power of 2 | 65536
+/// message_queue_size | the size of the message queue of each thread that writes to the logger, must be a power of 2 | 4096
 /// overflow_behavior | message handling policy while the queue is full: `discard` drops messages, `block` waits until message gets into the queue | discard
+/// file_buffer_size | size of the buffer to accumulate the file writes in, 0 writes each message separately | 0
+/// fsync_period | how often the written data is fdatasync'ed, never if not set; requires file_buffer_size | -
+/// direct_io | write the file with O_DIRECT bypassing the page cache; requires file_buffer_size | false
+/// drop_page_cache | evict the synced data from the page cache; requires fsync_period | false
 /// testsuite-capture | if exists, setups additional TCP log sink for testing purposes | {}
 ///
 /// ### Logs output
@@ -51,6 +63,19 @@ namespace components {
 /// - Use `%file_name%` to write your logs in file. Use USR1 signal or `OnLogRotate` handler to reopen files after log rotation;
 /// - Use `unix:%socket_name%` to write your logs to unix socket. Socket must be created before the service starts and closed by listener afert service is shuted down.
 ///
+/// ### Buffered file writes
+/// With a non-zero `file_buffer_size` the formatted messages are accumulated
+/// in a buffer of that size, which is written to the file once it is full,
+/// on each flush (see `flush_level`) and every 2 seconds. With `direct_io` the
+/// log file does not occupy the page cache at all. `drop_page_cache` evicts
+/// the data after each `fsync_period` instead. Compress the rotated files
+/// with the log rotation tool, the service only reopens the file on SIGUSR1.
+///
+/// ### Binary format
+/// `binary` format writes the records without escaping and text formatting,
+/// use the `log-converter` tool to render them as `tskv`, `ltsv` or `raw`
+/// text, e.g. `log-converter --format=tskv < server.blog`.
+///
 /// ### testsuite-capture options:
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
@@ -62,6 +87,12 @@ namespace components {
 /// @snippet components/common_component_list_test.cpp Sample logging component config
 ///
 /// `default` section configures the default logger for LOG_*.
+///
+/// Each thread that writes to a file or a socket logger gets its own queue, so
+/// the task processor workers do not contend with each other. The messages are
+/// written to the sinks by a dedicated thread in batches. The number of
+/// dropped and queued messages of such loggers is reported in `logger` metrics
+/// with the `logger` label.
 
 // clang-format on
 
@@ -92,6 +123,9 @@ class Logging final : public impl::ComponentBase {
   void OnLogRotate();
   void TryReopenFiles();
 
+  /// Writes the queue statistics of the file and socket loggers
+  void WriteStatistics(utils::statistics::Writer& writer) const;
+
   class TestsuiteCaptureSink;
 
   static yaml_config::Schema GetStaticConfigSchema();
@@ -104,6 +138,9 @@ class Logging final : public impl::ComponentBase {
 
   engine::TaskProcessor* fs_task_processor_;
   std::unordered_map<std::string, logging::LoggerPtr> loggers_;
+  std::vector<std::pair<std::string,
+                        std::shared_ptr<logging::impl::ThreadBufferedLogger>>>
+      buffered_loggers_;
   utils::PeriodicTask flush_task_;
   std::shared_ptr<TestsuiteCaptureSink> socket_sink_;
   os_signals::Subscriber signal_subscriber_;
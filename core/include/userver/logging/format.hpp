@@ -10,7 +10,10 @@ USERVER_NAMESPACE_BEGIN
 namespace logging {
 
 /// Log formats
-enum class Format { kTskv, kLtsv, kRaw };
+///
+/// kBinary writes a compact binary record per message and defers escaping and
+/// formatting to the offline conversion with the `log-converter` tool.
+enum class Format { kTskv, kLtsv, kRaw, kBinary };
 
 /// Parse Format enum from string
 Format FormatFromString(std::string_view format_str);
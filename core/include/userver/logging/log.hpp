@@ -69,7 +69,8 @@ class RateLimiter {
   uint64_t dropped_count_{0};
 };
 
-// Register location during static initialization for dynamic debug logs.
+// Register location during static initialization for dynamic debug logs
+// and for the per-location rate limiting.
 class StaticLogEntry final {
  public:
   StaticLogEntry(const char* path, int line) noexcept;
@@ -77,12 +78,14 @@ class StaticLogEntry final {
   StaticLogEntry(StaticLogEntry&&) = delete;
   StaticLogEntry& operator=(StaticLogEntry&&) = delete;
 
-  bool ShouldLog() const noexcept;
+  /// Returns true if the log with `level` is logged at the location,
+  /// accounting the dynamic debug logs and the rate limit
+  bool ShouldLog(Level level) noexcept;
 
  private:
   static constexpr std::size_t kContentSize =
-      compiler::SelectSize().For64Bit(40).For32Bit(24);
-  alignas(void*) std::byte content[kContentSize];
+      compiler::SelectSize().For64Bit(88).For32Bit(64);
+  alignas(8) std::byte content[kContentSize];
 };
 
 template <class NameHolder, int Line>
@@ -110,15 +113,15 @@ struct EntryStorage final {
 // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
 #define LOG(lvl)                                                      \
   __builtin_expect(                                                   \
-      !USERVER_NAMESPACE::logging::ShouldLog(lvl) && []() -> bool {   \
+      [](USERVER_NAMESPACE::logging::Level level) -> bool {           \
         struct NameHolder {                                           \
           static constexpr const char* Get() noexcept {               \
             return USERVER_FILEPATH;                                  \
           }                                                           \
         };                                                            \
         return !USERVER_NAMESPACE::logging::impl::EntryStorage<       \
-                    NameHolder, __LINE__>::entry.ShouldLog();         \
-      }(),                                                            \
+                    NameHolder, __LINE__>::entry.ShouldLog(level);    \
+      }(lvl),                                                         \
       static_cast<int>(lvl) <                                         \
           static_cast<int>(USERVER_NAMESPACE::logging::Level::kInfo)) \
       ? USERVER_NAMESPACE::logging::impl::Noop{}                      \
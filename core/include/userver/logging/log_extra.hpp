@@ -5,6 +5,7 @@
 
 #include <initializer_list>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <variant>
 
@@ -38,6 +39,18 @@ class LogExtra final {
     kFrozen,  ///< Attempts to replace this value will be ignored
   };
 
+  /// @brief Key that refers to a string with static storage duration, e.g. a
+  /// string literal. Such keys are never copied, even when the LogExtra is.
+  class StaticKey final {
+   public:
+    constexpr explicit StaticKey(std::string_view key) noexcept : key_(key) {}
+
+    constexpr std::string_view GetView() const noexcept { return key_; }
+
+   private:
+    std::string_view key_;
+  };
+
   LogExtra() noexcept;
 
   LogExtra(const LogExtra&);
@@ -63,6 +76,10 @@ class LogExtra final {
   /// Adds a single key-value pair
   void Extend(Pair extra, ExtendType extend_type = ExtendType::kNormal);
 
+  /// Adds a single key-value pair without copying the key
+  void Extend(StaticKey key, Value value,
+              ExtendType extend_type = ExtendType::kNormal);
+
   /// Adds a batch of key-value pairs
   void Extend(std::initializer_list<Pair> extra,
               ExtendType extend_type = ExtendType::kNormal);
@@ -111,6 +128,21 @@ class LogExtra final {
  private:
   const Value& GetValue(std::string_view key) const;
 
+  // Either owns the key or refers to a StaticKey
+  class StoredKey final {
+   public:
+    explicit StoredKey(std::string key) noexcept : owned_(std::move(key)) {}
+    explicit StoredKey(StaticKey key) noexcept : static_(key.GetView()) {}
+
+    std::string_view GetView() const noexcept {
+      return static_.data() ? static_ : std::string_view{owned_};
+    }
+
+   private:
+    std::string owned_;
+    std::string_view static_;
+  };
+
   class ProtectedValue final {
    public:
     ProtectedValue() = default;
@@ -132,20 +164,20 @@ class LogExtra final {
 
   static constexpr std::size_t kSmallVectorSize = 24;
   static constexpr std::size_t kPimplSize = compiler::SelectSize()
-                                                .ForLibCpp32(1168)
-                                                .ForLibCpp64(1560)
-                                                .ForLibStdCpp64(1944)
-                                                .ForLibStdCpp32(1356);
-  using MapItem = std::pair<Key, ProtectedValue>;
+                                                .ForLibCpp32(1552)
+                                                .ForLibCpp64(1944)
+                                                .ForLibStdCpp64(2328)
+                                                .ForLibStdCpp32(1548);
+  using MapItem = std::pair<StoredKey, ProtectedValue>;
   using Map = boost::container::small_vector<MapItem, kSmallVectorSize>;
 
-  void Extend(std::string key, ProtectedValue protected_value,
+  void Extend(StoredKey key, ProtectedValue protected_value,
               ExtendType extend_type = ExtendType::kNormal);
   void Extend(MapItem extra, ExtendType extend_type = ExtendType::kNormal);
 
-  std::pair<Key, ProtectedValue>* Find(std::string_view);
+  MapItem* Find(std::string_view);
 
-  const std::pair<Key, ProtectedValue>* Find(std::string_view) const;
+  const MapItem* Find(std::string_view) const;
 
   utils::FastPimpl<Map, kPimplSize, alignof(void*)> extra_;
 };
@@ -13,6 +13,11 @@ namespace logging::stacktrace_cache {
 /// @see GlobalEnableStacktrace
 std::string to_string(const boost::stacktrace::stacktrace& st);
 
+/// Get cached name of a single frame, e.g. of an address collected with
+/// boost::stacktrace::safe_dump_to(). Returns an empty string for the frames
+/// that start a coroutine.
+std::string frame_to_string(const void* address);
+
 /// Enable/disable stacktraces. If disabled, stacktrace_cache::to_string()
 /// returns with a const string.
 ///
@@ -0,0 +1,37 @@
+#pragma once
+
+/// @file userver/rcu/fwd.hpp
+/// @brief Forward declarations for rcu::Variable and rcu::ReadablePtr
+
+USERVER_NAMESPACE_BEGIN
+
+namespace rcu {
+
+/// @brief Can be passed to `rcu::Variable` as the second template argument to
+/// choose how the writers find out that the old values are no longer read.
+enum class Reclamation {
+  /// Each reader publishes the pointer it reads. The writers collect the
+  /// published pointers into a set on every update. An old value is freed as
+  /// soon as nobody reads it.
+  kHazardPointers,
+
+  /// Each reader publishes the update counter of the variable at the moment
+  /// it started reading. The writers only compute the minimum over the readers
+  /// and free all the values retired before it in order, which makes frequent
+  /// updates cheaper. A long living reader delays freeing of all the values
+  /// retired after it started.
+  kEpochs,
+};
+
+template <typename T, Reclamation R = Reclamation::kHazardPointers>
+class Variable;
+
+template <typename T, Reclamation R = Reclamation::kHazardPointers>
+class ReadablePtr;
+
+template <typename T, Reclamation R = Reclamation::kHazardPointers>
+class WritablePtr;
+
+}  // namespace rcu
+
+USERVER_NAMESPACE_END
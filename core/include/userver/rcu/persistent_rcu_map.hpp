@@ -0,0 +1,583 @@
+#pragma once
+
+/// @file userver/rcu/persistent_rcu_map.hpp
+/// @brief @copybrief rcu::PersistentRcuMap
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <userver/rcu/rcu.hpp>
+#include <userver/rcu/rcu_map.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace rcu {
+
+namespace impl {
+
+template <typename Key, typename Value>
+struct HamtLeaf final {
+  std::size_t hash;
+  Key key;
+  std::shared_ptr<Value> value;
+};
+
+// Node of a hash array mapped trie, immutable once shared. A node is either a
+// branch that indexes its children by the next kBits bits of the hash, or
+// a collision node that holds the leaves with the same full hash.
+template <typename Key, typename Value>
+struct HamtNode final {
+  using Leaf = HamtLeaf<Key, Value>;
+  using NodePtr = std::shared_ptr<const HamtNode>;
+  using Child = std::variant<Leaf, NodePtr>;
+
+  static constexpr std::size_t kBits = 5;
+
+  static std::uint32_t GetBit(std::size_t hash, std::size_t depth) noexcept {
+    const auto shift = (hash >> (depth * kBits)) & ((1U << kBits) - 1);
+    return std::uint32_t{1} << shift;
+  }
+
+  std::size_t GetIndex(std::uint32_t bit) const noexcept {
+    return std::bitset<32>(bitmap & (bit - 1)).count();
+  }
+
+  bool IsCollision() const noexcept { return !collisions.empty(); }
+
+  // Branch: children for the set bits in the ascending order of bits
+  std::uint32_t bitmap{0};
+  std::vector<Child> children;
+
+  // Collision node: leaves with the same hash, `children` are empty
+  std::vector<Leaf> collisions;
+};
+
+// Persistent hash map, copying is O(1) and the modifications copy only the
+// nodes on the path to the key
+template <typename Key, typename Value, typename Hash>
+class Hamt final {
+ public:
+  using ValuePtr = std::shared_ptr<Value>;
+  using Node = HamtNode<Key, Value>;
+  using Leaf = typename Node::Leaf;
+  using NodePtr = typename Node::NodePtr;
+  using Child = typename Node::Child;
+
+  struct InsertResult {
+    ValuePtr value;
+    bool inserted{false};
+    bool modified{false};
+  };
+
+  struct EraseResult {
+    bool found{false};
+    ValuePtr value;
+    // Replaces the node in its parent, the node is removed if empty
+    std::optional<Child> replacement;
+  };
+
+  std::size_t GetSize() const noexcept { return size_; }
+
+  const NodePtr& GetRoot() const noexcept { return root_; }
+
+  const ValuePtr* Find(const Key& key) const {
+    const auto hash = Hash{}(key);
+    const Node* node = root_.get();
+    for (std::size_t depth = 0; node; ++depth) {
+      if (node->IsCollision()) {
+        for (const auto& leaf : node->collisions) {
+          if (leaf.hash == hash && leaf.key == key) return &leaf.value;
+        }
+        return nullptr;
+      }
+
+      const auto bit = Node::GetBit(hash, depth);
+      if (!(node->bitmap & bit)) return nullptr;
+
+      const auto& child = node->children[node->GetIndex(bit)];
+      if (const auto* leaf = std::get_if<Leaf>(&child)) {
+        return leaf->hash == hash && leaf->key == key ? &leaf->value : nullptr;
+      }
+      node = std::get<NodePtr>(child).get();
+    }
+    return nullptr;
+  }
+
+  // Keeps the existing value unless `assign` is set
+  InsertResult Insert(const Key& key, ValuePtr value, bool assign) {
+    InsertResult result;
+    Leaf leaf{Hash{}(key), key, std::move(value)};
+    if (!root_) {
+      auto root = std::make_shared<Node>();
+      root->bitmap = Node::GetBit(leaf.hash, 0);
+      result = {leaf.value, true, true};
+      root->children.emplace_back(std::move(leaf));
+      root_ = std::move(root);
+    } else if (auto root =
+                   DoInsert(root_, 0, std::move(leaf), assign, result)) {
+      root_ = std::move(root);
+    }
+
+    if (result.inserted) ++size_;
+    return result;
+  }
+
+  EraseResult Erase(const Key& key) {
+    if (!root_) return {};
+
+    auto result = DoErase(root_, 0, Hash{}(key), key);
+    if (!result.found) return result;
+
+    if (result.replacement) {
+      root_ = std::get<NodePtr>(std::move(*result.replacement));
+    } else {
+      root_.reset();
+    }
+    --size_;
+    return result;
+  }
+
+ private:
+  static NodePtr MakeBranch(std::size_t depth, Child first,
+                            std::size_t first_hash, Child second,
+                            std::size_t second_hash) {
+    UASSERT(first_hash != second_hash);
+    auto node = std::make_shared<Node>();
+    const auto first_bit = Node::GetBit(first_hash, depth);
+    const auto second_bit = Node::GetBit(second_hash, depth);
+    if (first_bit == second_bit) {
+      node->bitmap = first_bit;
+      node->children.emplace_back(MakeBranch(depth + 1, std::move(first),
+                                             first_hash, std::move(second),
+                                             second_hash));
+    } else {
+      node->bitmap = first_bit | second_bit;
+      if (second_bit < first_bit) std::swap(first, second);
+      node->children.push_back(std::move(first));
+      node->children.push_back(std::move(second));
+    }
+    return node;
+  }
+
+  static bool IsCollapsible(const Child& child) noexcept {
+    if (std::holds_alternative<Leaf>(child)) return true;
+    return std::get<NodePtr>(child)->IsCollision();
+  }
+
+  // Returns nullptr if nothing was changed
+  static NodePtr DoInsert(const NodePtr& node, std::size_t depth, Leaf&& leaf,
+                          bool assign, InsertResult& result) {
+    if (node->IsCollision()) {
+      const auto collision_hash = node->collisions.front().hash;
+      if (collision_hash != leaf.hash) {
+        const auto hash = leaf.hash;
+        result = {leaf.value, true, true};
+        return MakeBranch(depth, Child{node}, collision_hash,
+                          Child{std::move(leaf)}, hash);
+      }
+
+      const auto it = std::find_if(
+          node->collisions.begin(), node->collisions.end(),
+          [&](const Leaf& other) { return other.key == leaf.key; });
+      if (it != node->collisions.end() && !assign) {
+        result = {it->value, false, false};
+        return nullptr;
+      }
+
+      auto copy = std::make_shared<Node>(*node);
+      result = {leaf.value, it == node->collisions.end(), true};
+      if (result.inserted) {
+        copy->collisions.push_back(std::move(leaf));
+      } else {
+        copy->collisions[it - node->collisions.begin()] = std::move(leaf);
+      }
+      return copy;
+    }
+
+    const auto bit = Node::GetBit(leaf.hash, depth);
+    const auto index = node->GetIndex(bit);
+    if (!(node->bitmap & bit)) {
+      auto copy = std::make_shared<Node>(*node);
+      copy->bitmap |= bit;
+      result = {leaf.value, true, true};
+      copy->children.emplace(copy->children.begin() + index, std::move(leaf));
+      return copy;
+    }
+
+    const auto& child = node->children[index];
+    Child new_child;
+    if (const auto* existing = std::get_if<Leaf>(&child)) {
+      if (existing->hash != leaf.hash) {
+        const auto hash = leaf.hash;
+        result = {leaf.value, true, true};
+        new_child = MakeBranch(depth + 1, Child{*existing}, existing->hash,
+                               Child{std::move(leaf)}, hash);
+      } else if (existing->key != leaf.key) {
+        auto collision = std::make_shared<Node>();
+        result = {leaf.value, true, true};
+        collision->collisions.push_back(*existing);
+        collision->collisions.push_back(std::move(leaf));
+        new_child = std::move(collision);
+      } else if (!assign) {
+        result = {existing->value, false, false};
+        return nullptr;
+      } else {
+        result = {leaf.value, false, true};
+        new_child = std::move(leaf);
+      }
+    } else {
+      auto new_node = DoInsert(std::get<NodePtr>(child), depth + 1,
+                               std::move(leaf), assign, result);
+      if (!new_node) return nullptr;
+      new_child = std::move(new_node);
+    }
+
+    auto copy = std::make_shared<Node>(*node);
+    copy->children[index] = std::move(new_child);
+    return copy;
+  }
+
+  static EraseResult DoErase(const NodePtr& node, std::size_t depth,
+                             std::size_t hash, const Key& key) {
+    EraseResult result;
+    if (node->IsCollision()) {
+      const auto it = std::find_if(
+          node->collisions.begin(), node->collisions.end(),
+          [&](const Leaf& leaf) {
+            return leaf.hash == hash && leaf.key == key;
+          });
+      if (it == node->collisions.end()) return result;
+
+      result.found = true;
+      result.value = it->value;
+      if (node->collisions.size() == 2) {
+        result.replacement.emplace(
+            node->collisions[it == node->collisions.begin() ? 1 : 0]);
+      } else {
+        auto copy = std::make_shared<Node>(*node);
+        copy->collisions.erase(copy->collisions.begin() +
+                               (it - node->collisions.begin()));
+        result.replacement.emplace(std::move(copy));
+      }
+      return result;
+    }
+
+    const auto bit = Node::GetBit(hash, depth);
+    if (!(node->bitmap & bit)) return result;
+
+    const auto index = node->GetIndex(bit);
+    const auto& child = node->children[index];
+    std::optional<Child> new_child;
+    if (const auto* leaf = std::get_if<Leaf>(&child)) {
+      if (leaf->hash != hash || leaf->key != key) return result;
+      result.found = true;
+      result.value = leaf->value;
+    } else {
+      auto child_result =
+          DoErase(std::get<NodePtr>(child), depth + 1, hash, key);
+      if (!child_result.found) return child_result;
+      result.found = true;
+      result.value = std::move(child_result.value);
+      new_child = std::move(child_result.replacement);
+    }
+
+    if (!new_child) {
+      if (node->children.size() == 1) return result;
+
+      const auto& other = node->children[index == 0 ? 1 : 0];
+      if (depth != 0 && node->children.size() == 2 && IsCollapsible(other)) {
+        result.replacement.emplace(other);
+        return result;
+      }
+
+      auto copy = std::make_shared<Node>(*node);
+      copy->bitmap &= ~bit;
+      copy->children.erase(copy->children.begin() + index);
+      result.replacement.emplace(std::move(copy));
+      return result;
+    }
+
+    if (depth != 0 && node->children.size() == 1 && IsCollapsible(*new_child)) {
+      result.replacement = std::move(new_child);
+      return result;
+    }
+
+    auto copy = std::make_shared<Node>(*node);
+    copy->children[index] = std::move(*new_child);
+    result.replacement.emplace(std::move(copy));
+    return result;
+  }
+
+  NodePtr root_;
+  std::size_t size_{0};
+};
+
+}  // namespace impl
+
+/// @brief Forward iterator for the rcu::PersistentRcuMap
+///
+/// Use member functions of rcu::PersistentRcuMap to retrieve the iterator.
+template <typename Key, typename Value, typename IterValue>
+class PersistentRcuMapIterator final {
+  using Node = impl::HamtNode<Key, Value>;
+  using NodePtr = typename Node::NodePtr;
+  using Leaf = typename Node::Leaf;
+
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using difference_type = ptrdiff_t;
+  using value_type = std::pair<Key, std::shared_ptr<IterValue>>;
+  using reference = const value_type&;
+  using pointer = const value_type*;
+
+  PersistentRcuMapIterator() = default;
+
+  PersistentRcuMapIterator operator++(int) {
+    PersistentRcuMapIterator tmp(*this);
+    ++*this;
+    return tmp;
+  }
+
+  PersistentRcuMapIterator& operator++() {
+    UASSERT(!stack_.empty());
+    ++stack_.back().index;
+    Settle();
+    return *this;
+  }
+
+  reference operator*() const { return current_; }
+  pointer operator->() const { return &current_; }
+
+  bool operator==(const PersistentRcuMapIterator& other) const {
+    if (stack_.empty() || other.stack_.empty()) {
+      return stack_.empty() == other.stack_.empty();
+    }
+    return stack_.back().node == other.stack_.back().node &&
+           stack_.back().index == other.stack_.back().index;
+  }
+
+  bool operator!=(const PersistentRcuMapIterator& other) const {
+    return !(*this == other);
+  }
+
+  /// @cond
+  /// For internal use only
+  explicit PersistentRcuMapIterator(NodePtr root) : root_(std::move(root)) {
+    if (!root_) return;
+    stack_.push_back({root_.get(), 0});
+    Settle();
+  }
+  /// @endcond
+
+ private:
+  struct Frame {
+    const Node* node;
+    std::size_t index;
+  };
+
+  // Descends to the leaf at the current position or past it
+  void Settle() {
+    while (!stack_.empty()) {
+      auto& frame = stack_.back();
+      const auto* node = frame.node;
+      if (node->IsCollision()) {
+        if (frame.index < node->collisions.size()) {
+          return SetCurrent(node->collisions[frame.index]);
+        }
+      } else if (frame.index < node->children.size()) {
+        const auto& child = node->children[frame.index];
+        if (const auto* leaf = std::get_if<Leaf>(&child)) {
+          return SetCurrent(*leaf);
+        }
+        stack_.push_back({std::get<NodePtr>(child).get(), 0});
+        continue;
+      }
+
+      stack_.pop_back();
+      if (!stack_.empty()) ++stack_.back().index;
+    }
+    root_.reset();
+  }
+
+  void SetCurrent(const Leaf& leaf) { current_ = {leaf.key, leaf.value}; }
+
+  // Keeps the snapshot alive
+  NodePtr root_;
+  std::vector<Frame> stack_;
+  value_type current_;
+};
+
+/// @ingroup userver_concurrency userver_containers
+///
+/// @brief Map-like structure allowing RCU keyset updates, with the keyset
+/// stored in a persistent hash array mapped trie.
+///
+/// Unlike rcu::RcuMap, a keyset change does not copy the whole map: only
+/// O(log n) trie nodes on the path to the key are copied, the rest is shared
+/// with the previous versions. That makes it suitable for big maps with
+/// frequent updates, at the cost of slower lookups and iteration. The
+/// old versions are reclaimed with rcu::Reclamation::kEpochs.
+///
+/// Only keyset changes are thread-safe in scope of this class.
+/// Values are stored in `shared_ptr`s and are not copied during keyset change.
+/// @note No synchronization is provided for value access, it must be
+/// implemented by Value when necessary.
+///
+/// ## Example usage:
+///
+/// @snippet rcu/persistent_rcu_map_test.cpp  Sample rcu::PersistentRcuMap usage
+///
+/// @see @ref md_en_userver_synchronization
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class PersistentRcuMap final {
+  static_assert(!std::is_reference_v<Key>);
+  static_assert(!std::is_reference_v<Value>);
+  static_assert(!std::is_const_v<Key>);
+
+ public:
+  using ValuePtr = std::shared_ptr<Value>;
+  using Iterator = PersistentRcuMapIterator<Key, Value, Value>;
+  using ConstValuePtr = std::shared_ptr<const Value>;
+  using ConstIterator = PersistentRcuMapIterator<Key, Value, const Value>;
+  using Snapshot = std::unordered_map<Key, ConstValuePtr, Hash>;
+
+  struct InsertReturnType {
+    ValuePtr value;
+    bool inserted;
+  };
+
+  PersistentRcuMap() = default;
+
+  PersistentRcuMap(const PersistentRcuMap&) = delete;
+  PersistentRcuMap(PersistentRcuMap&&) = delete;
+  PersistentRcuMap& operator=(const PersistentRcuMap&) = delete;
+  PersistentRcuMap& operator=(PersistentRcuMap&&) = delete;
+
+  /// Returns an estimated size of the map at some point in time
+  size_t SizeApprox() const {
+    const auto snapshot = rcu_.Read();
+    return snapshot->GetSize();
+  }
+
+  /// @name Iteration support
+  /// @details Keyset is fixed at the start of the iteration and is not affected
+  /// by concurrent changes.
+  /// @{
+  ConstIterator begin() const { return ConstIterator{GetRoot()}; }
+  ConstIterator end() const { return {}; }
+  Iterator begin() { return Iterator{GetRoot()}; }
+  Iterator end() { return {}; }
+  /// @}
+
+  /// @brief Returns a readonly value pointer by its key if exists
+  /// @throws MissingKeyException if the key is not present
+  const ConstValuePtr operator[](const Key& key) const {
+    if (auto value = Get(key)) return value;
+    throw MissingKeyException("Key ") << key << " is missing";
+  }
+
+  /// @brief Returns a modifiable value pointer by key if exists or
+  /// default-creates one
+  const ValuePtr operator[](const Key& key) { return Emplace(key).value; }
+
+  /// @brief Inserts a new element into the container if there is no element
+  /// with the key in the container.
+  /// Returns a pair consisting of a pointer to the inserted element, or the
+  /// already-existing element if no insertion happened, and a bool denoting
+  /// whether the insertion took place.
+  InsertReturnType Insert(const Key& key, ValuePtr value) {
+    InsertReturnType result{Get(key), false};
+    if (result.value) return result;
+
+    return DoInsert(key, std::move(value));
+  }
+
+  /// @brief Inserts a new element into the container constructed in-place with
+  /// the given args if there is no element with the key in the container.
+  template <typename... Args>
+  InsertReturnType Emplace(const Key& key, Args&&... args) {
+    InsertReturnType result{Get(key), false};
+    if (result.value) return result;
+
+    return DoInsert(key, std::make_shared<Value>(std::forward<Args>(args)...));
+  }
+
+  /// @brief If a key equivalent to `key` already exists in the container,
+  /// replaces the associated value. Otherwise, inserts a new pair into the map.
+  void InsertOrAssign(const Key& key, ValuePtr value) {
+    auto txn = rcu_.StartWrite();
+    txn->Insert(key, std::move(value), /*assign=*/true);
+    txn.Commit();
+  }
+
+  /// @brief Returns a readonly value pointer by its key or an empty pointer
+  const ConstValuePtr Get(const Key& key) const {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    return const_cast<PersistentRcuMap*>(this)->Get(key);
+  }
+
+  /// @brief Returns a modifiable value pointer by key or an empty pointer
+  const ValuePtr Get(const Key& key) {
+    const auto snapshot = rcu_.Read();
+    const auto* value = snapshot->Find(key);
+    return value ? *value : ValuePtr{};
+  }
+
+  /// @brief Removes a key from the map
+  /// @returns whether the key was present
+  bool Erase(const Key& key) { return DoErase(key).found; }
+
+  /// @brief Removes a key from the map returning its value
+  /// @returns a value if the key was present, empty pointer otherwise
+  ValuePtr Pop(const Key& key) { return DoErase(key).value; }
+
+  /// Resets the map to an empty state
+  void Clear() { rcu_.Assign({}); }
+
+  /// @brief Returns a readonly copy of the map
+  Snapshot GetSnapshot() const { return {begin(), end()}; }
+
+ private:
+  using Trie = impl::Hamt<Key, Value, Hash>;
+
+  typename Trie::NodePtr GetRoot() const {
+    const auto snapshot = rcu_.Read();
+    return snapshot->GetRoot();
+  }
+
+  InsertReturnType DoInsert(const Key& key, ValuePtr value) {
+    auto txn = rcu_.StartWrite();
+    auto result = txn->Insert(key, std::move(value), /*assign=*/false);
+    if (result.inserted) txn.Commit();
+    return {std::move(result.value), result.inserted};
+  }
+
+  typename Trie::EraseResult DoErase(const Key& key) {
+    if (!Get(key)) return {};
+
+    auto txn = rcu_.StartWrite();
+    auto result = txn->Erase(key);
+    if (result.found) txn.Commit();
+    return result;
+  }
+
+  // Writers free only the nodes of the replaced path, so the destruction is
+  // cheap enough to do it synchronously
+  rcu::Variable<Trie, Reclamation::kEpochs> rcu_{DestructionType::kSync};
+};
+
+}  // namespace rcu
+
+USERVER_NAMESPACE_END
@@ -3,14 +3,21 @@
 /// @file userver/rcu/rcu.hpp
 /// @brief Implementation of hazard pointer
 
+#include <algorithm>
 #include <atomic>
 #include <cstdlib>
+#include <deque>
+#include <limits>
 #include <list>
+#include <memory>
+#include <type_traits>
 #include <unordered_set>
+#include <utility>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/rcu/fwd.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/clang_format_workarounds.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
@@ -24,9 +31,6 @@ USERVER_NAMESPACE_BEGIN
 /// with modified API
 namespace rcu {
 
-template <typename T>
-class Variable;
-
 namespace impl {
 
 // Hazard pointer implementation. Pointers form a linked list. \p ptr points
@@ -37,7 +41,9 @@ namespace impl {
 // std::atomic<HazardPointerRecord*> global_head' Every rcu::Variable has its
 // own list of hazard pointers. Thus, move-assignment on hazard pointers is
 // difficult to implement.
-template <typename T>
+// With Reclamation::kEpochs the same records are used, but the readers
+// publish the epoch they started reading at instead of the pointer.
+template <typename T, Reclamation R>
 struct HazardPointerRecord final {
   // You see, objects are created 'filled', that is for the purposes of hazard
   // pointer list, they contain value. This eliminates some race conditions,
@@ -46,29 +52,39 @@ struct HazardPointerRecord final {
   // somewhere into kernel space and will cause SEGFAULT
   static inline T* const kUsed = reinterpret_cast<T*>(1);
 
-  explicit HazardPointerRecord(const Variable<T>& owner) : owner(owner) {}
+  explicit HazardPointerRecord(const Variable<T, R>& owner) : owner(owner) {}
 
   std::atomic<T*> ptr = kUsed;
-  const Variable<T>& owner;
+  // Used with Reclamation::kEpochs only, meaningful while `ptr` is not nullptr
+  std::atomic<uint64_t> epoch{0};
+  const Variable<T, R>& owner;
   std::atomic<HazardPointerRecord*> next{nullptr};
 
   // Simple operation that marks this hazard pointer as no longer used.
   void Release() { ptr = nullptr; }
 };
 
-template <typename T>
+template <typename T, Reclamation R>
 struct CachedData {
-  impl::HazardPointerRecord<T>* hp{nullptr};
-  const Variable<T>* variable{nullptr};
+  impl::HazardPointerRecord<T, R>* hp{nullptr};
+  const Variable<T, R>* variable{nullptr};
   // ensures that `variable` points to the instance that filled the cache
   uint64_t variable_epoch{0};
 };
 
-template <typename T>
-thread_local CachedData<T> cache;
+template <typename T, Reclamation R>
+thread_local CachedData<T, R> cache;
 
 uint64_t GetNextEpoch() noexcept;
 
+template <typename T>
+struct EpochRetireList final {
+  // Advanced on every retirement
+  std::atomic<uint64_t> epoch{1};
+  // Ordered by the epoch of retirement
+  std::deque<std::pair<uint64_t, std::unique_ptr<T>>> values;
+};
+
 }  // namespace impl
 
 /// Reader smart pointer for rcu::Variable<T>. You may use operator*() or
@@ -76,29 +92,37 @@ uint64_t GetNextEpoch() noexcept;
 /// ReadablePtr references the same immutable value: if Variable's value is
 /// changed during ReadablePtr lifetime, it will not affect value referenced by
 /// ReadablePtr.
-template <typename T>
+template <typename T, Reclamation R>
 class USERVER_NODISCARD ReadablePtr final {
  public:
-  explicit ReadablePtr(const Variable<T>& ptr)
+  explicit ReadablePtr(const Variable<T, R>& ptr)
       : hp_record_(&ptr.MakeHazardPointer()) {
-    // This cycle guarantees that at the end of it both t_ptr_ and
-    // hp_record_->ptr will both be set to
-    // 1. something meaningful
-    // 2. and that this meaningful value was not removed between assigning to
-    //    t_ptr_ and storing  it in a hazard pointer
-    do {
+    if constexpr (R == Reclamation::kEpochs) {
+      // A value is retired before the epoch is advanced, so if we've seen
+      // the retired value, the writer also sees our epoch as not newer than
+      // the retirement one and keeps the value.
+      hp_record_->epoch.store(ptr.GetRetireEpoch());
       t_ptr_ = ptr.GetCurrent();
-
-      hp_record_->ptr.store(t_ptr_);
-    } while (t_ptr_ != ptr.GetCurrent());
+    } else {
+      // This cycle guarantees that at the end of it both t_ptr_ and
+      // hp_record_->ptr will both be set to
+      // 1. something meaningful
+      // 2. and that this meaningful value was not removed between assigning
+      //    to t_ptr_ and storing  it in a hazard pointer
+      do {
+        t_ptr_ = ptr.GetCurrent();
+
+        hp_record_->ptr.store(t_ptr_);
+      } while (t_ptr_ != ptr.GetCurrent());
+    }
   }
 
-  ReadablePtr(ReadablePtr<T>&& other) noexcept
+  ReadablePtr(ReadablePtr&& other) noexcept
       : t_ptr_(other.t_ptr_), hp_record_(other.hp_record_) {
     other.t_ptr_ = nullptr;
   }
 
-  ReadablePtr& operator=(ReadablePtr<T>&& other) noexcept {
+  ReadablePtr& operator=(ReadablePtr&& other) noexcept {
     // What do we have here?
     // 1. 'other' may point to the same variable - or to a different one.
     // 2. therefore, its hazard pointer may belong to the same list,
@@ -141,11 +165,11 @@ class USERVER_NODISCARD ReadablePtr final {
     return *this;
   }
 
-  ReadablePtr(const ReadablePtr<T>& other)
+  ReadablePtr(const ReadablePtr& other)
       : ReadablePtr(other.hp_record_->owner) {}
 
-  ReadablePtr& operator=(const ReadablePtr<T>& other) {
-    if (this != &other) *this = ReadablePtr<T>{other};
+  ReadablePtr& operator=(const ReadablePtr& other) {
+    if (this != &other) *this = ReadablePtr{other};
     return *this;
   }
 
@@ -183,7 +207,7 @@ class USERVER_NODISCARD ReadablePtr final {
   // Invariant is this: if t_ptr_ is not nullptr, then hp_record_ is also
   // not nullptr and points to hazard pointer containing same T*.
   // Thus, if t_ptr_ is nullptr, then hp_record_ is undefined.
-  impl::HazardPointerRecord<T>* hp_record_;
+  impl::HazardPointerRecord<T, R>* hp_record_;
 };
 
 /// Smart pointer for rcu::Variable<T> for changing RCU value. It stores a
@@ -196,11 +220,11 @@ class USERVER_NODISCARD ReadablePtr final {
 /// @note you may not pass WritablePtr between coroutines as it owns
 /// engine::Mutex, which must be unlocked in the same coroutine that was used to
 /// lock the mutex.
-template <typename T>
+template <typename T, Reclamation R>
 class USERVER_NODISCARD WritablePtr final {
  public:
   /// For internal use only. Use `var.StartWrite()` instead
-  explicit WritablePtr(Variable<T>& var)
+  explicit WritablePtr(Variable<T, R>& var)
       : var_(var),
         lock_(var.mutex_),
         ptr_(std::make_unique<T>(*var_.GetCurrent())) {
@@ -209,7 +233,8 @@ class USERVER_NODISCARD WritablePtr final {
 
   /// For internal use only. Use `var.Emplace(args...)` instead
   template <typename... Args>
-  WritablePtr(Variable<T>& var, std::in_place_t, Args&&... initial_value_args)
+  WritablePtr(Variable<T, R>& var, std::in_place_t,
+              Args&&... initial_value_args)
       : var_(var),
         lock_(var.mutex_),
         ptr_(std::make_unique<T>(std::forward<Args>(initial_value_args)...)) {
@@ -217,7 +242,7 @@ class USERVER_NODISCARD WritablePtr final {
                 << " with custom initial value";
   }
 
-  WritablePtr(WritablePtr<T>&& other) noexcept
+  WritablePtr(WritablePtr&& other) noexcept
       : var_(other.var_),
         lock_(std::move(other.lock_)),
         ptr_(std::move(other.ptr_)) {
@@ -262,7 +287,7 @@ class USERVER_NODISCARD WritablePtr final {
     std::abort();
   }
 
-  Variable<T>& var_;
+  Variable<T, R>& var_;
   std::unique_lock<engine::Mutex> lock_;
   std::unique_ptr<T> ptr_;
 };
@@ -288,6 +313,10 @@ enum class DestructionType { kSync, kAsync };
 /// be eventually freed when a subsequent writer identifies that nobody works
 /// with this version.
 ///
+/// The way the writers find out that nobody works with an old version is
+/// chosen by the rcu::Reclamation template argument. Prefer
+/// rcu::Reclamation::kEpochs for the values that are updated often.
+///
 /// @note There is no way to create a "null" `Variable`.
 ///
 /// ## Example usage:
@@ -295,7 +324,7 @@ enum class DestructionType { kSync, kAsync };
 /// @snippet rcu/rcu_test.cpp  Sample rcu::Variable usage
 ///
 /// @see @ref md_en_userver_synchronization
-template <typename T>
+template <typename T, Reclamation R>
 class Variable final {
  public:
   /// Create a new `Variable` with an in-place constructed initial value.
@@ -346,7 +375,7 @@ class Variable final {
   }
 
   /// Obtain a smart pointer which can be used to read the current value.
-  ReadablePtr<T> Read() const { return ReadablePtr<T>(*this); }
+  ReadablePtr<T, R> Read() const { return ReadablePtr<T, R>(*this); }
 
   /// Obtain a copy of contained value.
   T ReadCopy() const {
@@ -357,24 +386,26 @@ class Variable final {
   /// Obtain a smart pointer that will *copy* the current value. The pointer can
   /// be used to make changes to the value and to set the `Variable` to the
   /// changed value.
-  WritablePtr<T> StartWrite() { return WritablePtr<T>(*this); }
+  WritablePtr<T, R> StartWrite() { return WritablePtr<T, R>(*this); }
 
   /// Obtain a smart pointer to a newly in-place constructed value, but does
   /// not replace the current one yet (in contrast with regular `Emplace`).
   template <typename... Args>
-  WritablePtr<T> StartWriteEmplace(Args&&... args) {
-    return WritablePtr<T>(*this, std::in_place, std::forward<Args>(args)...);
+  WritablePtr<T, R> StartWriteEmplace(Args&&... args) {
+    return WritablePtr<T, R>(*this, std::in_place,
+                             std::forward<Args>(args)...);
   }
 
   /// Replaces the `Variable`'s value with the provided one.
   void Assign(T new_value) {
-    WritablePtr<T>(*this, std::in_place, std::move(new_value)).Commit();
+    WritablePtr<T, R>(*this, std::in_place, std::move(new_value)).Commit();
   }
 
   /// Replaces the `Variable`'s value with an in-place constructed one.
   template <typename... Args>
   void Emplace(Args&&... args) {
-    WritablePtr<T>(*this, std::in_place, std::forward<Args>(args)...).Commit();
+    WritablePtr<T, R>(*this, std::in_place, std::forward<Args>(args)...)
+        .Commit();
   }
 
   void Cleanup() {
@@ -385,20 +416,26 @@ class Variable final {
       return;
     }
 
-    ScanRetiredList(CollectHazardPtrs(lock));
+    if constexpr (R == Reclamation::kEpochs) {
+      ScanRetiredEpochs(lock);
+    } else {
+      ScanRetiredList(CollectHazardPtrs(lock));
+    }
   }
 
  private:
   T* GetCurrent() const { return current_.load(); }
 
-  impl::HazardPointerRecord<T>* MakeHazardPointerCached() const {
-    auto& cache = impl::cache<T>;
+  uint64_t GetRetireEpoch() const { return retire_list_head_.epoch.load(); }
+
+  impl::HazardPointerRecord<T, R>* MakeHazardPointerCached() const {
+    auto& cache = impl::cache<T, R>;
     auto* hp = cache.hp;
     T* ptr = nullptr;
     if (hp && cache.variable == this && cache.variable_epoch == epoch_) {
       if (hp->ptr.load() == nullptr &&
           hp->ptr.compare_exchange_strong(
-              ptr, impl::HazardPointerRecord<T>::kUsed)) {
+              ptr, impl::HazardPointerRecord<T, R>::kUsed)) {
         return hp;
       }
     }
@@ -406,7 +443,7 @@ class Variable final {
     return nullptr;
   }
 
-  impl::HazardPointerRecord<T>* MakeHazardPointerFast() const {
+  impl::HazardPointerRecord<T, R>* MakeHazardPointerFast() const {
     // Look for any hazard pointer with nullptr data ptr.
     // Mark it with kUsed (to reserve it for ourselves) and return it.
     auto* hp = hp_record_head_.load();
@@ -414,7 +451,7 @@ class Variable final {
       T* t_ptr = nullptr;
       if (hp->ptr.load() == nullptr &&
           hp->ptr.compare_exchange_strong(
-              t_ptr, impl::HazardPointerRecord<T>::kUsed)) {
+              t_ptr, impl::HazardPointerRecord<T, R>::kUsed)) {
         return hp;
       }
 
@@ -423,14 +460,14 @@ class Variable final {
     return nullptr;
   }
 
-  impl::HazardPointerRecord<T>& MakeHazardPointer() const {
+  impl::HazardPointerRecord<T, R>& MakeHazardPointer() const {
     auto* hp = MakeHazardPointerCached();
     if (!hp) {
       hp = MakeHazardPointerFast();
       // all buckets are full, create a new one
       if (!hp) hp = MakeHazardPointerSlow();
 
-      auto& cache = impl::cache<T>;
+      auto& cache = impl::cache<T, R>;
       cache.hp = hp;
       cache.variable = this;
       cache.variable_epoch = epoch_;
@@ -439,10 +476,10 @@ class Variable final {
     return *hp;
   }
 
-  impl::HazardPointerRecord<T>* MakeHazardPointerSlow() const {
+  impl::HazardPointerRecord<T, R>* MakeHazardPointerSlow() const {
     // allocate new pointer, and add it to the list (atomically)
-    auto hp = new impl::HazardPointerRecord<T>(*this);
-    impl::HazardPointerRecord<T>* old_hp = nullptr;
+    auto hp = new impl::HazardPointerRecord<T, R>(*this);
+    impl::HazardPointerRecord<T, R>* old_hp = nullptr;
     do {
       old_hp = hp_record_head_.load();
       hp->next = old_hp;
@@ -453,18 +490,26 @@ class Variable final {
   void Retire(std::unique_ptr<T> old_ptr,
               std::unique_lock<engine::Mutex>& lock) {
     LOG_TRACE() << "Retiring ptr=" << old_ptr.get();
-    auto hazard_ptrs = CollectHazardPtrs(lock);
-
-    if (hazard_ptrs.count(old_ptr.get()) > 0) {
-      // old_ptr is being used now, we may not delete it, delay deletion
-      LOG_TRACE() << "Not retire, still used ptr=" << old_ptr.get();
-      retire_list_head_.push_back(std::move(old_ptr));
+    if constexpr (R == Reclamation::kEpochs) {
+      // Readers that obtain the advanced epoch are guaranteed to see the
+      // new value
+      const auto epoch = retire_list_head_.epoch.fetch_add(1);
+      retire_list_head_.values.emplace_back(epoch, std::move(old_ptr));
+      ScanRetiredEpochs(lock);
     } else {
-      LOG_TRACE() << "Retire, not used ptr=" << old_ptr.get();
-      DeleteAsync(std::move(old_ptr));
-    }
+      auto hazard_ptrs = CollectHazardPtrs(lock);
+
+      if (hazard_ptrs.count(old_ptr.get()) > 0) {
+        // old_ptr is being used now, we may not delete it, delay deletion
+        LOG_TRACE() << "Not retire, still used ptr=" << old_ptr.get();
+        retire_list_head_.push_back(std::move(old_ptr));
+      } else {
+        LOG_TRACE() << "Retire, not used ptr=" << old_ptr.get();
+        DeleteAsync(std::move(old_ptr));
+      }
 
-    ScanRetiredList(hazard_ptrs);
+      ScanRetiredList(hazard_ptrs);
+    }
   }
 
   // Scan retired list and for every object that has no more hazard_ptrs
@@ -481,6 +526,26 @@ class Variable final {
     }
   }
 
+  // Destroy (asynchronously) all the objects retired before any of the current
+  // readers started reading
+  void ScanRetiredEpochs(std::unique_lock<engine::Mutex>&) {
+    auto& retired = retire_list_head_.values;
+    if (retired.empty()) return;
+
+    auto min_epoch = std::numeric_limits<uint64_t>::max();
+    for (auto* hp = hp_record_head_.load(); hp; hp = hp->next) {
+      // Reserved, but not yet published epochs are older than the actual ones
+      if (hp->ptr.load() != nullptr) {
+        min_epoch = std::min(min_epoch, hp->epoch.load());
+      }
+    }
+
+    while (!retired.empty() && retired.front().first < min_epoch) {
+      DeleteAsync(std::move(retired.front().second));
+      retired.pop_front();
+    }
+  }
+
   // Returns all T*, that have hazard ptr pointing at them. Occasionally nullptr
   // might be in result as well.
   std::unordered_set<T*> CollectHazardPtrs(std::unique_lock<engine::Mutex>&) {
@@ -512,16 +577,19 @@ class Variable final {
   const DestructionType destruction_type_;
   const uint64_t epoch_;
 
-  mutable std::atomic<impl::HazardPointerRecord<T>*> hp_record_head_{{nullptr}};
+  mutable std::atomic<impl::HazardPointerRecord<T, R>*> hp_record_head_{
+      {nullptr}};
 
   engine::Mutex mutex_;  // for current_ changes and retire_list_head_ access
   // may be read without mutex_ locked, but must be changed with held mutex_
   std::atomic<T*> current_;
-  std::list<std::unique_ptr<T>> retire_list_head_;
+  std::conditional_t<R == Reclamation::kEpochs, impl::EpochRetireList<T>,
+                     std::list<std::unique_ptr<T>>>
+      retire_list_head_;
   utils::impl::WaitTokenStorage wait_token_storage_;
 
-  friend class ReadablePtr<T>;
-  friend class WritablePtr<T>;
+  friend class ReadablePtr<T, R>;
+  friend class WritablePtr<T, R>;
 };
 
 }  // namespace rcu
@@ -43,6 +43,14 @@ namespace components {
 /// listener | (*required*) *see below* | -
 /// listener-monitor | *see below* | -
 /// set-response-server-hostname | set to true to add the `X-YaTaxi-Server-Hostname` header with instance name, set to false to not add the header | false
+/// handoff-socket | path of a unix socket to pass the listening sockets over to the next instance of the service on restart; do not set to disable the handoff | ''
+///
+/// With `handoff-socket` set, a restarted service takes the listening sockets
+/// over from the running instance instead of binding new ones. The running
+/// instance keeps serving until all the components of the new one are loaded
+/// (e.g. the caches are filled), then it stops accepting and shuts down
+/// gracefully. No connection is refused or dropped from the accept queue
+/// during the restart.
 ///
 /// Server is configured by 'listener' and 'listener-monitor' entries.
 /// 'listener' is a required entry that describes the request processing
@@ -69,7 +77,13 @@ namespace components {
 /// connection.in_buffer_size | size of the buffer to preallocate for request receive: bigger values use more RAM and less CPU | 32 * 1024
 /// connection.requests_queue_size_threshold | drop requests from handlers that allow trottling if there's more pending requests than allowed by this value | 100
 /// connection.keepalive_timeout | timeout in seconds to drop connection if there's not data received from it | 600
-/// shards | how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing | -
+/// connection.request_parser | HTTP/1.x request parser implementation: `http-parser` or `simd` that scans the request head with SSE4.2 if the CPU supports it | http-parser
+/// connection.http2_enabled | serve HTTP/2 without TLS (h2c) to the clients that start the connection with the HTTP/2 preface | false
+/// connection.http2_max_concurrent_streams | max count of concurrent HTTP/2 streams per connection | 100
+/// connection.http2_header_table_size | size in bytes of the HPACK dynamic tables for HTTP/2 headers | 4096
+/// connection.http2_initial_window_size | initial size in bytes of the HTTP/2 stream flow control window | 65535
+/// shards | how many listening SO_REUSEPORT sockets to open, each one with its own accepting coroutine; do not set if not sure what it is doing | count of the event threads
+/// cpu_steering | Linux only: pass each new connection to the socket number `CPU % shards`, where `CPU` is the one that received the SYN. Keeps the whole processing of the connection setup on a single CPU during the connection storms | false
 
 // clang-format on
 
@@ -102,6 +116,7 @@ class Server final : public LoggableComponentBase {
   std::unique_ptr<server::Server> server_;
   utils::statistics::Entry server_statistics_holder_;
   utils::statistics::Entry handler_statistics_holder_;
+  utils::statistics::Entry listener_statistics_holder_;
 };
 
 template <>
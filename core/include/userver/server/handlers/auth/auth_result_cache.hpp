@@ -0,0 +1,100 @@
+#pragma once
+
+/// @file userver/server/handlers/auth/auth_result_cache.hpp
+/// @brief @copybrief server::handlers::auth::AuthResultCache
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <userver/cache/expirable_lru_cache.hpp>
+#include <userver/crypto/hash.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers::auth {
+
+/// Options of the AuthResultCache
+struct AuthResultCacheSettings {
+  std::size_t ways{16};
+  std::size_t way_size{1000};
+  /// How long a check result is used without rechecking
+  std::chrono::milliseconds lifetime{std::chrono::seconds{60}};
+  /// How long after the `lifetime` the result is still used while the
+  /// credential is rechecked in background, zero disables
+  std::chrono::milliseconds stale_lifetime{0};
+};
+
+/// @brief TTL cache of the credential checks for the auth checkers that call
+/// out to remote services, e.g. to token introspection.
+///
+/// The results are keyed by SHA-256 of the credential, so the raw tokens are
+/// not kept in memory. Concurrent checks of the same credential are
+/// coalesced, and with a non-zero `stale_lifetime` an expired result is
+/// returned at once while the credential is rechecked in background. The
+/// exceptions of the check are not cached.
+///
+/// @warning A revoked credential stays valid for up to
+/// `lifetime + stale_lifetime`.
+///
+/// Example usage:
+///
+/// @snippet server/handlers/auth/auth_result_cache_test.cpp Sample AuthResultCache
+template <typename Value>
+class AuthResultCache final {
+ public:
+  explicit AuthResultCache(const AuthResultCacheSettings& settings);
+
+  /// @returns the cached result of the credential check, or calls
+  /// `check(credential)` and caches its result
+  /// @note `check` is copied to recheck the credential in background
+  template <typename CheckFunc>
+  Value Get(std::string_view credential, CheckFunc check);
+
+  /// Forgets the result of the credential check, e.g. after a logout
+  void Invalidate(std::string_view credential);
+
+  std::size_t GetSizeApproximate() const { return cache_.GetSizeApproximate(); }
+
+ private:
+  using Cache = cache::ExpirableLruCache<std::string, Value>;
+
+  static std::string MakeKey(std::string_view credential) {
+    return crypto::hash::Sha256(credential,
+                                crypto::hash::OutputEncoding::kBinary);
+  }
+
+  Cache cache_;
+};
+
+template <typename Value>
+AuthResultCache<Value>::AuthResultCache(
+    const AuthResultCacheSettings& settings)
+    : cache_(settings.ways, settings.way_size) {
+  cache_.SetMaxLifetime(settings.lifetime);
+  cache_.SetStaleLifetime(settings.stale_lifetime);
+}
+
+template <typename Value>
+template <typename CheckFunc>
+Value AuthResultCache<Value>::Get(std::string_view credential,
+                                  CheckFunc check) {
+  return cache_.Get(
+      MakeKey(credential),
+      [check = std::move(check),
+       credential = std::string{credential}](const std::string& /*key*/) {
+        return check(credential);
+      },
+      Cache::ReadMode::kServeStale);
+}
+
+template <typename Value>
+void AuthResultCache<Value>::Invalidate(std::string_view credential) {
+  cache_.InvalidateByKey(MakeKey(credential));
+}
+
+}  // namespace server::handlers::auth
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,62 @@
+#pragma once
+
+/// @file userver/server/handlers/cpu_profiler.hpp
+/// @brief @copybrief server::handlers::CpuProfiler
+
+#include <userver/server/handlers/http_handler_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers
+///
+/// @brief Handler that controls the sampling CPU profiler.
+///
+/// The profiler samples the native stacks of the threads that consume CPU
+/// by SIGPROF, each sample is attributed to the task processor and the span
+/// of the interrupted task. The profile is returned in the "folded" format
+/// that is accepted by FlameGraph tools:
+/// `task_processor;span;outer_frame;...;inner_frame count`.
+///
+/// The component has no service configuration except the
+/// @ref userver_http_handlers "common handler options".
+///
+/// ## Static configuration example:
+///
+/// @snippet components/common_server_component_list_test.cpp  Sample handler cpu profiler component config
+///
+/// ## Schema
+/// Set an URL path argument `command` to one of the following values:
+/// * `start` - to start sampling, optional arguments:
+///   * `frequency` - samples per second of the process CPU time, 100 by default
+///   * `task_processor` - comma-separated task processors to sample, all
+///     threads are sampled if not set
+///   * `max_samples` - samples to keep in memory, the rest are dropped
+/// * `stop` - to stop sampling and get the folded stacks
+/// * `status` - to get the number of collected and dropped samples
+
+// clang-format on
+
+class CpuProfiler final : public HttpHandlerBase {
+ public:
+  CpuProfiler(const components::ComponentConfig&,
+              const components::ComponentContext&);
+
+  static constexpr std::string_view kName = "handler-cpu-profiler";
+
+  std::string HandleRequestThrow(const http::HttpRequest&,
+                                 request::RequestContext&) const override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+};
+
+}  // namespace server::handlers
+
+template <>
+inline constexpr bool components::kHasValidate<server::handlers::CpuProfiler> =
+    true;
+
+USERVER_NAMESPACE_END
@@ -36,9 +36,21 @@ namespace server::handlers {
 /// request_body_size_log_limit | trim request to this size before logging | 512
 /// response_data_size_log_limit | trim responses to this size before logging | 512
 /// max_requests_per_second | integer to limit RPS to this handler | <no limit>
-/// decompress_request | allow decompression of the requests | false
+/// decompress_request | decompress the `gzip` and `deflate` request bodies as they are received, max_request_size limits the decompressed size | false
+/// compress_response | gzip the responses for the clients that send `Accept-Encoding: gzip`, see the options below | <no compression>
+/// compress_response.min_size | do not compress the smaller responses, the streamed responses are always compressed | 1024
+/// compress_response.level | gzip compression level, from 0 (no compression) to 9 (best compression) | 6
+/// adaptive_concurrency | limit the requests in flight of the handler by a limit that follows its latency, the requests over the limit get 429; see the options below | <no limit>
+/// adaptive_concurrency.min_limit | the limit never goes below this value | 10
+/// adaptive_concurrency.max_limit | the limit never goes above this value | 1000
+/// adaptive_concurrency.initial_limit | the limit at the start | 20
+/// adaptive_concurrency.percentile | percentile of the latency over a window that is compared with its long term baseline | 90
+/// adaptive_concurrency.window_ms | how often the limit is recalculated | 1000
+/// adaptive_concurrency.tolerance | how many times the latency may exceed the baseline before the limit goes down | 1.5
+/// adaptive_concurrency.low_priority_percent | share of the limit for the requests of server::handlers::RequestPriority::kLow | 80
 /// throttling_enabled | allow throttling of the requests by components::Server , for more info see its `max_response_size_in_flight` and `requests_queue_size_threshold` options | true
 /// set-response-server-hostname | set to true to add the `X-YaTaxi-Server-Hostname` header with instance name, set to false to not add the header | <takes the value from components::Server config>
+/// request-body-stream | pass the HTTP/1.x requests to the handler right after their headers, the handler reads the body with server::http::HttpRequest::GetBodyStream() as it arrives; `max_request_size` does not limit such bodies | false
 /// monitor-handler | Overrides the in-code `is_monitor` flag that makes the handler run either on `server.listener` or on `server.listener-monitor` | --
 /// set_tracing_headers | whether to set http tracing headers (X-YaTraceId, X-YaSpanId, X-RequestId) | true
 
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <optional>
 #include <string>
 #include <variant>
+#include <vector>
 
 #include <userver/server/handlers/auth/handler_auth_config.hpp>
 #include <userver/server/handlers/fallback_handlers.hpp>
@@ -24,6 +27,66 @@ enum class UrlTrailingSlashOption {
   kDefault = kBoth,
 };
 
+/// Options of the gzip compression of the responses
+struct ResponseCompressionConfig {
+  /// Smaller responses are sent as is, the streamed ones are always compressed
+  size_t min_size{1024};
+  /// From 0 (no compression) to 9 (best compression)
+  int level{6};
+};
+
+/// Priority of a request for the adaptive concurrency limiter
+enum class RequestPriority {
+  kLow,       ///< shed first, when the handler is close to its limit
+  kNormal,    ///< shed when the handler reaches its limit
+  kCritical,  ///< never shed by the adaptive limiter, e.g. health checks
+};
+
+/// Options of the latency based concurrency limit of the handler
+struct AdaptiveConcurrencyConfig {
+  size_t min_limit{10};
+  size_t max_limit{1000};
+  size_t initial_limit{20};
+  /// Percentile of the handler latency that is compared with its baseline
+  double percentile{90};
+  /// How often the limit is recalculated
+  std::chrono::milliseconds window{1000};
+  /// How many times the latency may exceed its baseline before the limit
+  /// goes down
+  double tolerance{1.5};
+  /// Share of the limit that the low priority requests may occupy
+  size_t low_priority_percent{80};
+};
+
+/// Request property to break down the handler statistics by
+enum class StatsLabel {
+  kPath,          ///< the request path, e.g. of a wildcard or fallback handler
+  kClient,        ///< the value of the LabeledStatsConfig::client_header
+  kResponseSize,  ///< the bucket of the response body size
+};
+
+/// Options of the handler statistics breakdown by the request properties
+struct LabeledStatsConfig {
+  std::vector<StatsLabel> labels;
+  /// Requests with the new label values beyond this count of label sets are
+  /// accounted into a single label set with all the values set to `__other__`
+  size_t max_label_sets{100};
+  std::string client_header{"User-Agent"};
+};
+
+/// Options of the per client requests limit of the handler, see
+/// utils::KeyedRateLimiter
+struct ClientRateLimitConfig {
+  /// Request header that identifies the client, the requests without it are
+  /// not limited
+  std::string client_header{"X-Client-Id"};
+  /// Max requests of a client over a sliding window
+  size_t requests{100};
+  std::chrono::milliseconds window{1000};
+  /// Requests of the new clients beyond this count share a single limit
+  size_t max_clients{10000};
+};
+
 struct HandlerConfig {
   std::variant<std::string, FallbackHandler> path;
   std::string task_processor;
@@ -36,10 +99,16 @@ struct HandlerConfig {
   std::optional<size_t> max_requests_in_flight;
   std::optional<size_t> max_requests_per_second;
   bool decompress_request{false};
+  std::optional<ResponseCompressionConfig> compress_response;
+  std::optional<AdaptiveConcurrencyConfig> adaptive_concurrency;
   bool throttling_enabled{true};
   bool response_body_stream{false};
+  bool request_body_stream{false};
   std::optional<bool> set_response_server_hostname;
   bool set_tracing_headers{true};
+  bool scope_time_stats{false};
+  std::optional<LabeledStatsConfig> labeled_stats;
+  std::optional<ClientRateLimitConfig> client_rate_limit;
 };
 
 HandlerConfig ParseHandlerConfigsWithDefaults(
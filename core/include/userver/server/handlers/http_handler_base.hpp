@@ -8,6 +8,7 @@
 #include <vector>
 
 #include <userver/dynamic_config/source.hpp>
+#include <userver/engine/deadline.hpp>
 #include <userver/logging/level.hpp>
 #include <userver/utils/statistics/entry.hpp>
 #include <userver/utils/token_bucket.hpp>
@@ -23,6 +24,14 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace utils {
+class KeyedRateLimiter;
+}  // namespace utils
+
+namespace server::congestion_control {
+class GradientLimiter;
+}  // namespace server::congestion_control
+
 /// @brief Most common \ref userver_http_handlers "userver HTTP handlers"
 namespace server::handlers {
 
@@ -30,6 +39,9 @@ class HttpHandlerStatistics;
 class HttpRequestStatistics;
 class HttpHandlerMethodStatistics;
 class HttpHandlerStatisticsScope;
+class LabeledStatistics;
+class ResponseCompressionStatistics;
+class ScopeTimeStatistics;
 
 // clang-format off
 
@@ -116,6 +128,9 @@ class HttpHandlerBase : public HandlerBase {
   ///     or downloading dependant resources).
   /// 3) The body size is huge and we want to have only a part of it
   ///    in memory.
+  /// The connection starts sending the response on
+  /// ResponseBodyStream::SetEndOfHeaders(), large JSON arrays may be written
+  /// with server::http::JsonArrayStream.
   /// @note It is used only if IsStreamed() returned `true`.
   virtual void HandleStreamRequest(const server::http::HttpRequest&,
                                    server::request::RequestContext&,
@@ -154,6 +169,12 @@ class HttpHandlerBase : public HandlerBase {
 
   virtual std::string GetMetaType(const http::HttpRequest&) const;
 
+  /// Override it to shed some of the requests before the others when the
+  /// `adaptive_concurrency` limit is reached
+  virtual RequestPriority GetRequestPriority(const http::HttpRequest&) const {
+    return RequestPriority::kNormal;
+  }
+
  private:
   void HandleRequestStream(const http::HttpRequest& http_request,
                            http::HttpResponse& response,
@@ -166,10 +187,21 @@ class HttpHandlerBase : public HandlerBase {
   void CheckAuth(const http::HttpRequest& http_request,
                  request::RequestContext& context) const;
 
+  void CheckDeadline(const http::HttpRequest& http_request,
+                     engine::Deadline deadline) const;
+
   void CheckRatelimit(const http::HttpRequest& http_request) const;
 
+  // true if the request has taken a slot of the adaptive concurrency limit
+  bool CheckConcurrencyLimit(const http::HttpRequest& http_request) const;
+
   void DecompressRequestBody(http::HttpRequest& http_request) const;
 
+  bool IsResponseCompressionAccepted(
+      const http::HttpRequest& http_request) const;
+  void CompressResponse(const http::HttpRequest& http_request,
+                        http::HttpResponse& response) const;
+
   template <typename HttpStatistics>
   void FormatStatistics(utils::statistics::Writer result,
                         const HttpStatistics& stats);
@@ -184,6 +216,11 @@ class HttpHandlerBase : public HandlerBase {
 
   std::unique_ptr<HttpHandlerStatistics> handler_statistics_;
   std::unique_ptr<HttpRequestStatistics> request_statistics_;
+  std::unique_ptr<ResponseCompressionStatistics> compression_statistics_;
+  std::unique_ptr<ScopeTimeStatistics> scope_time_statistics_;
+  std::unique_ptr<LabeledStatistics> labeled_statistics_;
+  std::unique_ptr<congestion_control::GradientLimiter> concurrency_limiter_;
+  std::unique_ptr<utils::KeyedRateLimiter> client_rate_limit_;
   std::vector<auth::AuthCheckerBasePtr> auth_checkers_;
 
   std::optional<logging::Level> log_level_;
@@ -6,6 +6,7 @@
 #include <userver/components/fs_cache.hpp>
 #include <userver/dynamic_config/source.hpp>
 #include <userver/fs/fs_cache_client.hpp>
+#include <userver/fs/mapped_fs_cache_client.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -19,6 +20,13 @@ namespace server::handlers {
 /// @brief Handler that returns HTTP 200 if file exist
 /// and returns file data with mapped content/type
 ///
+/// A single range of bytes may be requested with the `Range` header, the
+/// multiple ranges and the `If-Range` requests get the whole file.
+///
+/// With the `mapped-fs-cache-component` option the files are taken from the
+/// components::MappedFsCache and sent with sendfile(2) instead of the
+/// components::FsCache.
+///
 /// ## Dynamic config
 /// * @ref USERVER_FILES_CONTENT_TYPE_MAP
 ///
@@ -28,9 +36,10 @@ namespace server::handlers {
 /// Inherits all the options from server::handlers::HttpHandlerBase and adds the
 /// following ones:
 ///
-/// Name               | Description                   | Default value
-/// ------------------ | ----------------------------- | -------------
-/// fs-cache-component | Name of the FsCache component | fs-cache-component
+/// Name                      | Description                         | Default value
+/// ------------------------- | ----------------------------------- | -------------
+/// fs-cache-component        | Name of the FsCache component       | fs-cache-component
+/// mapped-fs-cache-component | Name of the MappedFsCache component | -
 ///
 /// ## Example usage:
 ///
@@ -54,7 +63,8 @@ class HttpHandlerStatic final : public HttpHandlerBase {
 
  private:
   dynamic_config::Source config_;
-  const fs::FsCacheClient& storage_;
+  const fs::FsCacheClient* storage_{nullptr};
+  const fs::MappedFsCacheClient* mapped_storage_{nullptr};
 };
 
 }  // namespace server::handlers
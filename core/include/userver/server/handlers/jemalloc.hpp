@@ -28,6 +28,8 @@ namespace server::handlers {
 /// * `enable` - to start memory profiling
 /// * `disable` - to stop memory profiling
 /// * `dump` - to get jemalloc profiling dump
+/// * `decay` - to return the decayed unused pages of all the arenas to the OS
+/// * `purge` - to return all the unused pages of all the arenas to the OS
 
 // clang-format on
 
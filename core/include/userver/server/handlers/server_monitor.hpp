@@ -3,6 +3,10 @@
 /// @file userver/server/handlers/server_monitor.hpp
 /// @brief @copybrief server::handlers::ServerMonitor
 
+#include <chrono>
+#include <memory>
+
+#include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/utils/statistics/fwd.hpp>
 
@@ -21,6 +25,17 @@ namespace server::handlers {
 /// 'common-labels' option that should be a map of label name to label value.
 /// Items of the map are added to each metric.
 ///
+/// With a non-zero 'cache-period' option the serialized response is reused
+/// for the same request arguments during that period, and the concurrent
+/// identical requests wait for a single serialization. That makes several
+/// scrapers of a service with a lot of metrics cost as much as one.
+///
+/// With the 'statistics-task-processor' option the metrics are collected and
+/// serialized on the specified task processor, e.g. a dedicated low priority
+/// one, while the handler task waits for the result. See also the options of
+/// components::StatisticsStorage to yield between the metrics writers and to
+/// limit the time of a single metrics collection.
+///
 /// ## Static configuration example:
 ///
 /// @snippet components/common_server_component_list_test.cpp  Sample handler server monitor component config
@@ -46,6 +61,8 @@ class ServerMonitor final : public HttpHandlerBase {
   ServerMonitor(const components::ComponentConfig& config,
                 const components::ComponentContext& component_context);
 
+  ~ServerMonitor() override;
+
   static constexpr std::string_view kName = "handler-server-monitor";
 
   std::string HandleRequestThrow(const http::HttpRequest& request,
@@ -62,6 +79,12 @@ class ServerMonitor final : public HttpHandlerBase {
 
   using CommonLabels = std::unordered_map<std::string, std::string>;
   const CommonLabels common_labels_;
+
+  struct ResponseCache;
+  const std::chrono::milliseconds cache_period_;
+  const std::unique_ptr<ResponseCache> response_cache_;
+
+  engine::TaskProcessor* const statistics_task_processor_;
 };
 
 }  // namespace server::handlers
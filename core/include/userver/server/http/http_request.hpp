@@ -5,9 +5,11 @@
 
 #include <chrono>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
+#include <userver/http/header_map.hpp>
 #include <userver/logging/log_helper_fwd.hpp>
 #include <userver/server/http/form_data_arg.hpp>
 #include <userver/server/http/http_method.hpp>
@@ -21,13 +23,12 @@ USERVER_NAMESPACE_BEGIN
 namespace server::http {
 
 class HttpRequestImpl;
+class RequestBodyStream;
 
 /// @brief HTTP Request data
 class HttpRequest final {
  public:
-  using HeadersMap =
-      std::unordered_map<std::string, std::string, utils::StrIcaseHash,
-                         utils::StrIcaseEqual>;
+  using HeadersMap = USERVER_NAMESPACE::http::headers::HeaderMap;
 
   using HeadersMapKeys = decltype(utils::impl::MakeKeysView(HeadersMap()));
 
@@ -134,11 +135,19 @@ class HttpRequest final {
 
   /// @return Value of the header with case insensitive name header_name, or an
   /// empty string if no such header.
-  const std::string& GetHeader(const std::string& header_name) const;
+  const std::string& GetHeader(std::string_view header_name) const;
+
+  /// @overload
+  const std::string& GetHeader(
+      USERVER_NAMESPACE::http::headers::PredefinedHeader header) const;
 
   /// @return true if header with case insensitive name header_name exists,
   /// false otherwise.
-  bool HasHeader(const std::string& header_name) const;
+  bool HasHeader(std::string_view header_name) const;
+
+  /// @overload
+  bool HasHeader(
+      USERVER_NAMESPACE::http::headers::PredefinedHeader header) const;
 
   /// @return Number of headers.
   size_t HeaderCount() const;
@@ -161,8 +170,25 @@ class HttpRequest final {
   CookiesMapKeys GetCookieNames() const;
 
   /// @return HTTP body.
+  /// @note Big bodies are received without copying, the first call
+  /// concatenates their parts.
   const std::string& RequestBody() const;
 
+  /// @return HTTP body as a sequence of its parts, without concatenating them.
+  /// The views are valid until the body is changed or the request is
+  /// destroyed. Use it to pass big bodies on without copying, e.g. with
+  /// engine::io::Socket::SendAll(const IoData*, std::size_t, Deadline).
+  std::vector<std::string_view> RequestBodyChunks() const;
+
+  /// @return true if the body is received while the handler runs, so it is
+  /// available only via GetBodyStream(), not via RequestBody()
+  bool IsBodyStreamed() const;
+
+  /// @brief Reader of the body that arrives while the handler runs, for the
+  /// handlers with the `request-body-stream: true` static option. For the
+  /// other requests it reads the whole RequestBody() at once.
+  RequestBodyStream& GetBodyStream() const;
+
   /// @cond
   void SetRequestBody(std::string body);
   void ParseArgsFromBody();
@@ -176,6 +202,10 @@ class HttpRequest final {
   /// @return true if the body of the request was compressed
   bool IsBodyCompressed() const;
 
+  /// @return true if the compressed body was decompressed by the server as
+  /// it was received, RequestBody() returns the decompressed body
+  bool IsBodyDecompressed() const;
+
  private:
   HttpRequestImpl& impl_;
 };
@@ -0,0 +1,62 @@
+#pragma once
+
+/// @file userver/server/http/http_request_body_stream.hpp
+/// @brief @copybrief server::http::RequestBodyStream
+
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+class HttpRequestImpl;
+
+/// Thrown by RequestBodyStream::ReadChunk() if the body was not received to
+/// its end
+class RequestBodyStreamError : public std::runtime_error {
+  using std::runtime_error::runtime_error;
+};
+
+/// @brief Reader of the request body, retrieved via
+/// server::http::HttpRequest::GetBodyStream()
+///
+/// For the handlers with the `request-body-stream: true` static option the
+/// HTTP/1.x request is passed to the handler as soon as its headers are
+/// received, and the parts of the body are read here as they arrive. The
+/// connection stops reading the socket while a few of the received parts are
+/// not read by the handler, so the whole body is never kept in memory.
+///
+/// For the other requests, e.g. the HTTP/2 ones, the whole body is read at
+/// once, so the handler code does not depend on the protocol.
+class RequestBodyStream final {
+ public:
+  RequestBodyStream(RequestBodyStream&&) = delete;
+  RequestBodyStream& operator=(RequestBodyStream&&) = delete;
+
+  /// @brief Waits for the next part of the body
+  /// @returns false if the whole body was read, `chunk` is not changed
+  /// @throws RequestBodyStreamError if the client has closed the connection
+  /// or sent a malformed body before its end, or if the deadline has expired
+  bool ReadChunk(std::string& chunk, engine::Deadline deadline = {});
+
+ private:
+  friend class HttpRequestImpl;
+
+  using Queue = concurrent::SpscQueue<std::string>;
+
+  explicit RequestBodyStream(Queue::Consumer&& consumer);
+  explicit RequestBodyStream(const std::string& body);
+
+  std::optional<Queue::Consumer> consumer_;
+  std::string body_;
+  bool is_finished_{false};
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
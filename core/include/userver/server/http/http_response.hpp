@@ -4,13 +4,17 @@
 /// @brief @copybrief server::http::HttpResponse
 
 #include <chrono>
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <userver/concurrent/queue.hpp>
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/http/content_type.hpp>
 #include <userver/server/http/http_response_cookie.hpp>
+#include <userver/server/http/http_response_prepared_headers.hpp>
 #include <userver/server/request/response_base.hpp>
 #include <userver/utils/impl/projecting_view.hpp>
 #include <userver/utils/str_icase.hpp>
@@ -19,6 +23,14 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace engine::io {
+struct IoData;
+}  // namespace engine::io
+
+namespace fs::blocking {
+class FileDescriptor;
+}  // namespace fs::blocking
+
 namespace server::http {
 
 namespace impl {
@@ -29,6 +41,7 @@ void OutputHeader(std::string& header, std::string_view key,
 }
 
 class HttpRequestImpl;
+class Http2Session;
 
 /// @brief HTTP Response data
 class HttpResponse final : public request::ResponseBase {
@@ -57,6 +70,15 @@ class HttpResponse final : public request::ResponseBase {
   /// were already sent for stream'ed response and the new header was not set.
   bool SetHeader(std::string name, std::string value);
 
+  /// @brief Sends the prepared headers along with the ones set by
+  /// SetHeader(), replaces the previously set prepared headers. For HTTP/1.x
+  /// the serialized headers are sent without copying.
+  /// @note The prepared headers are not returned by GetHeader() and
+  /// HasHeader(), they should not be set by SetHeader() too.
+  /// @returns true if the headers were set. Returns false if headers
+  /// were already sent for stream'ed response and the headers were not set.
+  bool SetPreparedHeaders(PreparedHeaders headers);
+
   /// @brief Add or rewrite the Content-Type header.
   void SetContentType(const USERVER_NAMESPACE::http::ContentType& type);
 
@@ -79,6 +101,15 @@ class HttpResponse final : public request::ResponseBase {
   /// @brief Remove all cookies from response.
   void ClearCookies();
 
+  /// @brief Makes the `size` bytes of the file starting at the `offset` the
+  /// body of the response. For HTTP/1.x the body is sent with sendfile(2)
+  /// without copying it to the userspace.
+  /// @note The file body is used only if the data of the response is empty,
+  /// e.g. the error responses replace it.
+  /// @param file open file, is kept open until the response is sent
+  void SetFileBody(std::shared_ptr<const fs::blocking::FileDescriptor> file,
+                   std::size_t offset, std::size_t size);
+
   /// @return HTTP response status
   HttpStatus GetStatus() const { return status_; }
 
@@ -103,6 +134,10 @@ class HttpResponse final : public request::ResponseBase {
   /// @cond
   // TODO: server internals. remove from public interface
   void SendResponse(engine::io::Socket& socket) override;
+
+  // Sends the responses that are not streamed with a single writev
+  static void SendResponses(engine::io::Socket& socket,
+                            const std::vector<HttpResponse*>& responses);
   /// @endcond
 
   void SetStatusServiceUnavailable() override {
@@ -116,23 +151,53 @@ class HttpResponse final : public request::ResponseBase {
 
   using Queue = concurrent::SpscQueue<std::string>;
 
+  /// Count of the streamed body chunks that may wait for sending. Pushing more
+  /// of them waits for the client to receive the data.
+  static constexpr std::size_t kMaxQueuedBodyChunks = 16;
+
   void SetStreamBody();
   bool IsBodyStreamed() const override;
   // Can be called only once
   Queue::Producer GetBodyProducer();
 
  private:
+  // Frames the response for HTTP/2 connections
+  friend class Http2Session;
+
+  struct FileBody {
+    std::shared_ptr<const fs::blocking::FileDescriptor> file;
+    std::size_t offset{0};
+    std::size_t size{0};
+  };
+
+  const FileBody* GetFileBody() const;
+  // Reads the file body for the connections that can not use sendfile(2)
+  std::string ReadFileBody() const;
+
+  std::string MakeHeader();
+  // Ends the header of the response that is not streamed, returns the body
+  // to send after it. The file body is returned via `file_body`.
+  std::string_view CompleteHeaderNotstreamed(std::string& header,
+                                             const FileBody*& file_body);
+  // Adds the header completed by CompleteHeaderNotstreamed() and the
+  // prepared headers, returns the count of the added entries
+  std::size_t AddHeaderIoData(const std::string& header,
+                              engine::io::IoData* io_data) const;
+  std::size_t GetHeaderSize(const std::string& header) const;
+
   void SetBodyStreamed(engine::io::Socket& socket, std::string& header);
   void SetBodyNotstreamed(engine::io::Socket& socket, std::string& header);
 
   const HttpRequestImpl& request_;
   HttpStatus status_ = HttpStatus::kOk;
   HeadersMap headers_;
+  PreparedHeaders prepared_headers_;
   CookiesMap cookies_;
 
   engine::SingleConsumerEvent headers_end_;
   std::optional<Queue::Consumer> body_stream_;
   std::optional<Queue::Producer> body_stream_producer_;
+  std::optional<FileBody> file_body_;
 };
 
 void SetThrottleReason(http::HttpResponse& http_response,
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <chrono>
+#include <memory>
+#include <optional>
 #include <string>
 
 #include <userver/server/http/http_response.hpp>
@@ -7,6 +10,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace compression::gzip {
+class Compressor;
+}
+
 namespace server::handlers {
 class HttpHandlerBase;
 }
@@ -15,14 +22,18 @@ namespace server::http {
 
 class ResponseBodyStream final {
  public:
-  ResponseBodyStream(ResponseBodyStream&&) = default;
+  ResponseBodyStream(ResponseBodyStream&&) noexcept;
+  ~ResponseBodyStream();
 
   // Send a chunk of response data. It may NOT generate
   // exactly one HTTP chunk per call to PushBodyChunk().
+  // Waits for a slow client if there are too many chunks not sent yet.
   void PushBodyChunk(std::string&& chunk);
 
   void SetHeader(const std::string&, const std::string&);
 
+  // The status and the headers are sent after this call, they may not be
+  // changed any more
   void SetEndOfHeaders();
 
   void SetStatusCode(int status_code);
@@ -36,7 +47,17 @@ class ResponseBodyStream final {
       server::http::HttpResponse::Queue::Producer&& queue_producer,
       server::http::HttpResponse& http_response);
 
+  // The body is gzip'ed if the handler did not set the Content-Encoding
+  // before the SetEndOfHeaders()
+  void EnableCompression(int level);
+
+  // Sends the end of the compressed data, if any
+  void FinishCompression();
+
   bool headers_ended_{false};
+  std::optional<int> compression_level_;
+  std::unique_ptr<compression::gzip::Compressor> compressor_;
+  std::chrono::steady_clock::duration compression_time_{};
   HttpResponse::Queue::Producer queue_producer_;
   server::http::HttpResponse& http_response_;
 };
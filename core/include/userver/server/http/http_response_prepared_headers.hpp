@@ -0,0 +1,70 @@
+#pragma once
+
+/// @file userver/server/http/http_response_prepared_headers.hpp
+/// @brief @copybrief server::http::PreparedHeaders
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+class HttpResponse;
+class Http2Session;
+
+/// @brief Response headers that are validated and serialized once and are
+/// sent by any count of server::http::HttpResponse without copying.
+///
+/// Useful for the headers that a handler returns on every call, e.g.
+/// Content-Type, Cache-Control or CORS ones:
+/// @code
+/// // member of the handler
+/// const server::http::PreparedHeaders headers_{{
+///     {"Content-Type", "application/json"},
+///     {"Cache-Control", "no-cache"},
+/// }};
+///
+/// // in HandleRequestThrow
+/// request.GetHttpResponse().SetPreparedHeaders(headers_);
+/// @endcode
+///
+/// The copies share the serialized headers.
+class PreparedHeaders final {
+ public:
+  using Header = std::pair<std::string, std::string>;
+
+  /// Empty headers
+  PreparedHeaders() noexcept = default;
+
+  /// @throws std::runtime_error on an invalid header name or value
+  explicit PreparedHeaders(const std::vector<Header>& headers);
+
+  bool IsEmpty() const noexcept { return !data_; }
+
+  /// @returns the headers as they are sent over HTTP/1.x, the `Name: value`
+  /// lines each ending with CRLF
+  std::string_view GetSerialized() const noexcept;
+
+ private:
+  friend class HttpResponse;
+  friend class Http2Session;
+
+  struct Data {
+    std::string serialized;
+    // lowercase names for HTTP/2
+    std::vector<Header> headers;
+    bool has_date{false};
+    bool has_content_type{false};
+    bool has_connection{false};
+  };
+
+  std::shared_ptr<const Data> data_;
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,77 @@
+#pragma once
+
+/// @file userver/server/http/json_array_stream.hpp
+/// @brief @copybrief server::http::JsonArrayStream
+
+#include <cstddef>
+#include <optional>
+
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/server/http/http_response_body_stream.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// @brief Writes a JSON array into the streamed response by chunks of about
+/// `chunk_size` bytes.
+///
+/// The elements are written with their `WriteToStream` for
+/// formats::json::StringBuilder. The memory used does not depend on the count
+/// of elements: the response keeps at most
+/// HttpResponse::kMaxQueuedBodyChunks chunks waiting for the client and Write()
+/// waits for a slow client to receive them.
+///
+/// The constructor sets the `Content-Type` and ends the headers, so the status
+/// and other headers must be set before it. The client gets a truncated array
+/// if Finish() is not called, e.g. if the handler throws.
+///
+/// ## Example usage:
+///
+/// @code
+/// void HandleStreamRequest(const server::http::HttpRequest&,
+///                          server::request::RequestContext&,
+///                          server::http::ResponseBodyStream& stream) const {
+///   stream.SetStatusCode(server::http::HttpStatus::kOk);
+///   server::http::JsonArrayStream array{stream};
+///   for (auto cursor = storage_.Select(); cursor.HasMore();) {
+///     array.Write(cursor.Next());
+///   }
+///   array.Finish();
+/// }
+/// @endcode
+class JsonArrayStream final {
+ public:
+  static constexpr std::size_t kDefaultChunkSize = 16 * 1024;
+
+  explicit JsonArrayStream(ResponseBodyStream& stream,
+                           std::size_t chunk_size = kDefaultChunkSize);
+
+  JsonArrayStream(const JsonArrayStream&) = delete;
+  JsonArrayStream& operator=(const JsonArrayStream&) = delete;
+  ~JsonArrayStream();
+
+  /// Appends the element to the array, may send a chunk
+  template <typename T>
+  void Write(const T& element) {
+    WriteToStream(element, builder_);
+    if (builder_.GetStringView().size() >= chunk_size_) Flush();
+  }
+
+  /// Sends the elements written so far, does nothing if there are none
+  void Flush();
+
+  /// Ends the array and sends the rest of it. Must be called once, no
+  /// elements may be written after it.
+  void Finish();
+
+ private:
+  ResponseBodyStream& stream_;
+  const std::size_t chunk_size_;
+  formats::json::StringBuilder builder_;
+  std::optional<formats::json::StringBuilder::ArrayGuard> array_;
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,87 @@
+#pragma once
+
+/// @file userver/server/http/multipart_form_data_stream.hpp
+/// @brief @copybrief server::http::MultipartFormDataStream
+
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/server/http/http_request_body_stream.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// Thrown by server::http::MultipartFormDataStream on a malformed
+/// multipart/form-data body
+class MultipartFormDataStreamError : public std::runtime_error {
+  using std::runtime_error::runtime_error;
+};
+
+/// @brief Headers of a part of the multipart/form-data body
+struct FormDataPart {
+  std::string name;
+  std::optional<std::string> filename;
+  std::optional<std::string> content_type;
+};
+
+/// @brief Reader of the multipart/form-data body part by part
+///
+/// Unlike the server::http::HttpRequest::GetFormDataArg() the parts are not
+/// kept in memory: the values are read in chunks as the body arrives from
+/// the server::http::RequestBodyStream, so the handlers with the
+/// `request-body-stream: true` static option may receive the files of any
+/// size.
+///
+/// @code
+/// auto& body = request.GetBodyStream();
+/// server::http::MultipartFormDataStream form{
+///     body, request.GetHeader(http::headers::kContentType)};
+/// std::string chunk;
+/// while (form.NextPart()) {
+///   while (form.ReadChunk(chunk)) Write(form.GetPart().name, chunk);
+/// }
+/// @endcode
+///
+/// Only the "\r\n" line breaks are supported, the `_charset_` part is
+/// returned as is.
+class MultipartFormDataStream final {
+ public:
+  /// @throws MultipartFormDataStreamError if the content type is not
+  /// multipart/form-data or has no boundary
+  MultipartFormDataStream(RequestBodyStream& body,
+                          std::string_view content_type);
+
+  MultipartFormDataStream(MultipartFormDataStream&&) noexcept;
+  MultipartFormDataStream& operator=(MultipartFormDataStream&&) noexcept;
+  ~MultipartFormDataStream();
+
+  /// @brief Skips the rest of the current part and reads the headers of the
+  /// next one
+  /// @returns false if there are no more parts
+  /// @throws MultipartFormDataStreamError on a malformed body
+  /// @throws RequestBodyStreamError if the body was not received to its end
+  bool NextPart(engine::Deadline deadline = {});
+
+  /// @returns the headers of the current part
+  /// @note Valid only after NextPart() returned true
+  const FormDataPart& GetPart() const;
+
+  /// @brief Reads the next chunk of the current part value
+  /// @returns false if the whole value was read, `chunk` is not changed
+  /// @throws MultipartFormDataStreamError on a malformed body
+  /// @throws RequestBodyStreamError if the body was not received to its end
+  bool ReadChunk(std::string& chunk, engine::Deadline deadline = {});
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,147 @@
+#pragma once
+
+/// @file userver/server/request/arena.hpp
+/// @brief @copybrief server::request::Arena
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::request {
+
+/// @brief Monotonic allocator for the data that lives no longer than the
+/// request processing.
+///
+/// The memory is taken from the blocks of growing size and is released all at
+/// once when the arena is destroyed, so the allocation is a pointer bump and
+/// the deallocation is free. Use it for the scratch data of the handlers via
+/// server::request::RequestContext::GetArena():
+/// @snippet server/request/arena_test.cpp  Sample Arena
+///
+/// The memory of the destroyed or reallocated objects is not reused, so the
+/// arena is not suitable for the containers that grow without a limit.
+class Arena final {
+ public:
+  Arena() noexcept = default;
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  /// Destroys the objects created with Create() in the reverse order and
+  /// releases all the memory
+  ~Arena();
+
+  /// @brief Allocates uninitialized memory
+  /// @throws std::bad_alloc
+  void* Allocate(std::size_t size,
+                 std::size_t alignment = alignof(std::max_align_t));
+
+  /// @brief Creates an object in the arena, its destructor is called when the
+  /// arena is destroyed
+  template <typename T, typename... Args>
+  T& Create(Args&&... args);
+
+  /// @brief Copies the characters into the arena
+  std::string_view Copy(std::string_view value);
+
+  /// @returns the total size of the memory blocks taken from the heap
+  std::size_t GetReservedSize() const noexcept { return reserved_size_; }
+
+ private:
+  struct Block;
+  struct Destructor {
+    void (*destroy)(void*);
+    void* object;
+    Destructor* next;
+  };
+
+  void* AllocateSlow(std::size_t size, std::size_t alignment);
+
+  Block* blocks_{nullptr};
+  std::uintptr_t current_{0};
+  std::uintptr_t end_{0};
+  Destructor* destructors_{nullptr};
+  std::size_t reserved_size_{0};
+};
+
+/// @brief STL compatible allocator that takes the memory from the
+/// server::request::Arena, e.g. for `std::vector<T, ArenaAllocator<T>>`
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena& arena) noexcept : arena_(&arena) {}
+
+  template <typename U>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+      : arena_(other.arena_) {}
+
+  T* allocate(std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T*, std::size_t) noexcept {}
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const noexcept {
+    return arena_ == other.arena_;
+  }
+
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+    return arena_ != other.arena_;
+  }
+
+ private:
+  template <typename U>
+  friend class ArenaAllocator;
+
+  Arena* arena_;
+};
+
+inline void* Arena::Allocate(std::size_t size, std::size_t alignment) {
+  UASSERT_MSG(alignment && (alignment & (alignment - 1)) == 0,
+              "alignment should be a power of 2");
+  const auto begin = (current_ + alignment - 1) & ~(alignment - 1);
+  if (current_ && begin <= end_ && size <= end_ - begin) {
+    current_ = begin + size;
+    // NOLINTNEXTLINE(performance-no-int-to-ptr)
+    return reinterpret_cast<void*>(begin);
+  }
+  return AllocateSlow(size, alignment);
+}
+
+template <typename T, typename... Args>
+T& Arena::Create(Args&&... args) {
+  if constexpr (std::is_trivially_destructible_v<T>) {
+    return *new (Allocate(sizeof(T), alignof(T)))
+        T(std::forward<Args>(args)...);
+  } else {
+    // The node is allocated first to not fail after the construction
+    auto* destructor = static_cast<Destructor*>(
+        Allocate(sizeof(Destructor), alignof(Destructor)));
+    auto* object =
+        new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    destructor->destroy = [](void* ptr) { static_cast<T*>(ptr)->~T(); };
+    destructor->object = object;
+    destructor->next = destructors_;
+    destructors_ = destructor;
+    return *object;
+  }
+}
+
+}  // namespace server::request
+
+USERVER_NAMESPACE_END
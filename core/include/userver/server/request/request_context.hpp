@@ -6,6 +6,7 @@
 #include <string>
 
 #include <userver/compiler/select.hpp>
+#include <userver/server/request/arena.hpp>
 #include <userver/utils/any_movable.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 
@@ -98,6 +99,10 @@ class RequestContext final {
   /// @brief Erase data with specified name.
   void EraseData(const std::string& name);
 
+  /// @returns The arena for the scratch data of the request processing, it
+  /// is released after the response is ready
+  Arena& GetArena() noexcept { return arena_; }
+
  private:
   class Impl;
 
@@ -117,6 +122,8 @@ class RequestContext final {
   utils::AnyMovable* GetAnyDataOptional(const std::string& name);
   void EraseAnyData(const std::string& name);
 
+  // The user data may refer to the arena, so it is destroyed first
+  Arena arena_;
   utils::FastPimpl<Impl, kPimplSize, alignof(void*), utils::kStrictMatch> impl_;
 };
 
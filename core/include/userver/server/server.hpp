@@ -38,6 +38,8 @@ class Server final {
 
   void WriteTotalHandlerStatistics(utils::statistics::Writer& writer) const;
 
+  void WriteListenerStatistics(utils::statistics::Writer& writer) const;
+
   net::Stats GetServerStats() const;
 
   void AddHandler(const handlers::HttpHandlerBase& handler,
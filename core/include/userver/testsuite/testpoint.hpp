@@ -35,6 +35,10 @@ class TestpointScope final {
   utils::FastPimpl<Impl, 24, 8> impl_;
 };
 
+/// Returns false if no testpoint is enabled, e.g. in the testsuite
+/// performance mode, costs a couple of atomic loads
+bool AreTestpointsAvailable() noexcept;
+
 bool IsTestpointEnabled(const std::string& name);
 
 void ExecuteTestpointBlocking(const std::string& name,
@@ -63,6 +67,7 @@ USERVER_NAMESPACE_END
 #define TESTPOINT_CALLBACK(name, json, callback)        \
   do {                                                  \
     namespace tp = USERVER_NAMESPACE::testsuite::impl;  \
+    if (!tp::AreTestpointsAvailable()) break;           \
     if (!tp::IsTestpointEnabled(name)) break;           \
     tp::TestpointScope tp_scope;                        \
     if (!tp_scope) break;                               \
@@ -93,6 +98,7 @@ USERVER_NAMESPACE_END
 #define TESTPOINT_CALLBACK_NONCORO(name, json, task_processor, callback) \
   do {                                                                   \
     namespace tp = USERVER_NAMESPACE::testsuite::impl;                   \
+    if (!tp::AreTestpointsAvailable()) break;                            \
     if (!tp::IsTestpointEnabled(name)) break;                            \
     tp::ExecuteTestpointBlocking(name, json, callback, task_processor);  \
   } while (false)
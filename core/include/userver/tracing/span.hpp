@@ -159,6 +159,7 @@ class Span final {
 
   std::string GetParentLink() const;
 
+  const std::string& GetName() const;
   const std::string& GetTraceId() const;
   const std::string& GetSpanId() const;
   const std::string& GetParentId() const;
@@ -169,6 +170,21 @@ class Span final {
   /// global log levels to the default logger.
   bool ShouldLogDefault() const noexcept;
 
+  /// @returns false if the trace of this span was not chosen by the head
+  /// sampling, see components::Tracer. Spans of such traces are not logged,
+  /// unless the tail sampling keeps them.
+  bool IsSampled() const noexcept;
+
+  /// @brief Overrides the head sampling decision for this span and its future
+  /// children, e.g. with the one received from the caller.
+  ///
+  /// Should be called right after the creation of a root span.
+  void SetSampled(bool sampled);
+
+  /// Makes the trace of this span logged regardless of the sampling. Spans
+  /// already dropped by the head sampling are not restored.
+  void ForceSampled();
+
   /// Detach the Span from current engine::Task so it is not
   /// returned by CurrentSpan() any more.
   void DetachFromCoroStack();
@@ -0,0 +1,57 @@
+#pragma once
+
+/// @file userver/tracing/span_exporter.hpp
+/// @brief @copybrief tracing::SpanExporter
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <userver/logging/log_extra.hpp>
+#include <userver/tracing/tracer_fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+/// @brief A finished tracing::Span passed to the tracing::SpanExporter
+struct FinishedSpan {
+  std::string service_name;
+  std::string name;
+  std::string trace_id;
+  std::string span_id;
+  std::string parent_id;
+  ReferenceType reference_type{ReferenceType::kChild};
+  std::chrono::system_clock::time_point start_time;
+  std::chrono::steady_clock::duration duration{};
+
+  /// Inheritable and non-inheritable tags of the span
+  std::vector<std::pair<std::string, logging::LogExtra::Value>> tags;
+};
+
+/// @brief Base class for sending the finished spans to an external tracing
+/// system in addition to the logs.
+///
+/// The exporter receives only the spans that are logged, see
+/// tracing::Span::ShouldLogDefault and tracing::Span::IsSampled.
+class SpanExporter {
+ public:
+  virtual ~SpanExporter();
+
+  /// @brief Called from the destructors of the spans in any thread.
+  ///
+  /// Must neither block nor throw, usually just enqueues the span.
+  virtual void Export(FinishedSpan&& span) noexcept = 0;
+};
+
+/// Returns the current span exporter or nullptr
+std::shared_ptr<SpanExporter> GetSpanExporter();
+
+/// Atomically replaces the span exporter, nullptr disables the export
+void SetSpanExporter(std::shared_ptr<SpanExporter> exporter);
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
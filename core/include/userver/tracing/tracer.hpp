@@ -12,12 +12,16 @@ USERVER_NAMESPACE_BEGIN
 namespace tracing {
 
 struct NoLogSpans;
+struct Sampling;
 
 class Tracer : public std::enable_shared_from_this<Tracer> {
  public:
   static void SetNoLogSpans(NoLogSpans&& spans);
   static bool IsNoLogSpan(const std::string& name);
 
+  static void SetSampling(Sampling&& sampling);
+  static Sampling GetSampling();
+
   static void SetTracer(TracerPtr tracer);
 
   static TracerPtr GetTracer();
@@ -0,0 +1,82 @@
+#pragma once
+
+/// @file userver/utils/keyed_rate_limiter.hpp
+/// @brief @copybrief utils::KeyedRateLimiter
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+/// @ingroup userver_concurrency
+///
+/// @brief Thread safe ratelimiter that limits each key separately, e.g. the
+/// requests of each client of a handler.
+///
+/// Unlike utils::TokenBucket, the limit is applied to a sliding window: the
+/// requests of the current fixed window are summed up with the requests of
+/// the previous one weighted by its share that is still within `window` from
+/// now. So a client can not get twice its limit on a window boundary, while
+/// each key is still a single atomic word updated without locks.
+///
+/// The keys are spread over several RCU maps, only the first request of a
+/// new key copies the map of its shard. When `max_keys` is reached, the keys
+/// idle for two windows are removed, and the requests of the new keys beyond
+/// the limit share a single overflow window.
+class KeyedRateLimiter final {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Settings {
+    /// Max requests of a key over a window, up to kMaxLimit
+    std::size_t limit{100};
+    std::chrono::milliseconds window{1000};
+    /// Max keys that are limited separately
+    std::size_t max_keys{10000};
+  };
+
+  static constexpr std::size_t kMaxLimit = (1 << 20) - 1;
+
+  explicit KeyedRateLimiter(Settings settings);
+  ~KeyedRateLimiter();
+
+  KeyedRateLimiter(const KeyedRateLimiter&) = delete;
+  KeyedRateLimiter(KeyedRateLimiter&&) = delete;
+
+  /// @returns true and accounts the request if the key has not reached
+  /// its limit, false otherwise
+  bool TryAcquire(const std::string& key, Clock::time_point now = Clock::now());
+
+  /// Removes the keys that have had no requests for two windows
+  void RemoveIdle(Clock::time_point now = Clock::now());
+
+  /// Count of the separately limited keys (might be inaccurate as the result
+  /// is stale)
+  std::size_t GetKeysCountApprox() const;
+
+  const Settings& GetSettings() const { return settings_; }
+
+ private:
+  struct Window;
+  struct Shard;
+
+  bool TryAcquire(Window& window, std::uint64_t window_index,
+                  double prev_weight) const;
+  void RemoveIdle(Shard& shard, std::uint64_t window_index);
+  Shard& GetShard(const std::string& key);
+
+  const Settings settings_;
+  const Clock::duration window_;
+  const std::size_t max_keys_per_shard_;
+  std::unique_ptr<Shard[]> shards_;
+  std::unique_ptr<Window> overflow_;
+};
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
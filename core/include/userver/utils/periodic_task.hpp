@@ -112,6 +112,9 @@ class PeriodicTask final {
     /// PeriodicTask::Start() calls engine::current_task::GetTaskProcessor()
     /// to get the TaskProcessor.
     engine::TaskProcessor* task_processor{nullptr};
+
+    /// @brief Scheduling class of the task inside its TaskProcessor.
+    engine::TaskPriority priority{engine::TaskPriority::kNormal};
   };
 
   /// Signature of the task to be executed each period.
@@ -0,0 +1,163 @@
+#pragma once
+
+/// @file userver/utils/statistics/hdr_histogram.hpp
+/// @brief @copybrief utils::statistics::HdrHistogram
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+std::string GetPercentileFieldName(double perc);
+
+/// @brief Log-linear (HDR-style) histogram with a bounded relative error.
+///
+/// Values below `2**PrecisionBits` are stored precisely. Each next power of
+/// two range is split into `2**(PrecisionBits-1)` equal buckets, so the
+/// relative error of a percentile is at most `2**-(PrecisionBits-1)`, i.e.
+/// about 3% with the default precision. Values above `2**MaxValueBits - 1`
+/// are accounted as `2**MaxValueBits - 1`.
+///
+/// Has the same interface as utils::statistics::Percentile and may replace
+/// it in utils::statistics::RecentPeriod, while taking 896 counters instead
+/// of thousands for a range of up to 4 * 10**9.
+///
+/// Recording is lock-free and wait-free, the histograms are merged with Add().
+template <std::size_t PrecisionBits = 6, std::size_t MaxValueBits = 32,
+          typename Counter = std::uint32_t>
+class HdrHistogram final {
+  static_assert(PrecisionBits >= 1 && PrecisionBits < MaxValueBits &&
+                    MaxValueBits < 64,
+                "invalid HdrHistogram precision or range");
+
+ public:
+  static constexpr std::size_t kSubBuckets = std::size_t{1} << PrecisionBits;
+  static constexpr std::size_t kHalfSubBuckets = kSubBuckets / 2;
+  static constexpr std::size_t kBucketsCount =
+      kSubBuckets + (MaxValueBits - PrecisionBits) * kHalfSubBuckets;
+  static constexpr std::uint64_t kMaxValue =
+      (std::uint64_t{1} << MaxValueBits) - 1;
+
+  HdrHistogram() noexcept { Reset(); }
+
+  HdrHistogram(const HdrHistogram& other) noexcept { *this = other; }
+
+  HdrHistogram& operator=(const HdrHistogram& rhs) noexcept {
+    if (this == &rhs) return *this;
+
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < kBucketsCount; ++i) {
+      const auto value = rhs.buckets_[i].load(std::memory_order_relaxed);
+      buckets_[i].store(value, std::memory_order_relaxed);
+      sum += value;
+    }
+    count_.store(sum, std::memory_order_release);
+    return *this;
+  }
+
+  void Account(std::uint64_t value) noexcept {
+    buckets_[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_release);
+  }
+
+  /// @brief Returns the highest value that is equivalent to the X percentile,
+  /// see utils::statistics::Percentile::GetPercentile
+  /// @param percent value in [0..100], the highest accounted value is
+  /// returned for the larger values
+  std::size_t GetPercentile(double percent) const {
+    const auto count = count_.load(std::memory_order_acquire);
+    if (count == 0) return 0;
+
+    const auto want_sum = static_cast<std::uint64_t>(count * percent);
+    std::uint64_t sum = 0;
+    std::size_t max_value = 0;
+    for (std::size_t i = 0; i < kBucketsCount; ++i) {
+      const auto value = buckets_[i].load(std::memory_order_relaxed);
+      if (!value) continue;
+
+      sum += value;
+      max_value = BucketToValue(i);
+      if (sum * 100 > want_sum) return max_value;
+    }
+    return max_value;
+  }
+
+  template <class Duration = std::chrono::seconds>
+  void Add(const HdrHistogram& other,
+           [[maybe_unused]] Duration this_epoch_duration = Duration(),
+           [[maybe_unused]] Duration before_this_epoch_duration = Duration()) {
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < kBucketsCount; ++i) {
+      const auto value = other.buckets_[i].load(std::memory_order_relaxed);
+      if (!value) continue;
+
+      sum += value;
+      buckets_[i].fetch_add(value, std::memory_order_relaxed);
+    }
+    count_.fetch_add(sum, std::memory_order_release);
+  }
+
+  void Reset() noexcept {
+    for (auto& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_release);
+  }
+
+  /// Total number of the accounted values
+  Counter Count() const noexcept {
+    return count_.load(std::memory_order_acquire);
+  }
+
+  /// @cond
+  static constexpr std::size_t BucketIndex(std::uint64_t value) noexcept {
+    if (value < kSubBuckets) return value;
+    if (value > kMaxValue) value = kMaxValue;
+
+    const std::size_t exponent = 63 - __builtin_clzll(value);
+    const std::size_t shift = exponent - PrecisionBits + 1;
+    return kSubBuckets + (exponent - PrecisionBits) * kHalfSubBuckets +
+           ((value >> shift) - kHalfSubBuckets);
+  }
+
+  // The highest value of the bucket
+  static constexpr std::size_t BucketToValue(std::size_t index) noexcept {
+    if (index < kSubBuckets) return index;
+
+    const std::size_t range = (index - kSubBuckets) / kHalfSubBuckets;
+    const std::size_t sub_bucket =
+        kHalfSubBuckets + (index - kSubBuckets) % kHalfSubBuckets;
+    const std::size_t shift = range + 1;
+    return ((sub_bucket + 1) << shift) - 1;
+  }
+  /// @endcond
+
+ private:
+  std::array<std::atomic<Counter>, kBucketsCount> buckets_;
+  std::atomic<Counter> count_;
+};
+
+template <std::size_t PrecisionBits, std::size_t MaxValueBits,
+          typename Counter>
+void DumpMetric(
+    Writer& writer,
+    const HdrHistogram<PrecisionBits, MaxValueBits, Counter>& histogram,
+    std::initializer_list<double> percents = {0, 50, 90, 95, 98, 99, 99.6, 99.9,
+                                              100}) {
+  for (double percent : percents) {
+    writer.ValueWithLabels(
+        histogram.GetPercentile(percent),
+        {"percentile", statistics::GetPercentileFieldName(percent)});
+  }
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
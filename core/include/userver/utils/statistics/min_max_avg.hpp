@@ -93,6 +93,9 @@ class MinMaxAvg final {
   void Add(const MinMaxAvg& other,
            [[maybe_unused]] Duration this_epoch_duration = Duration(),
            [[maybe_unused]] Duration before_this_epoch_duration = Duration()) {
+    // the zero minimum and maximum of an empty value must not be merged
+    if (!other.count_.load(std::memory_order_acquire)) return;
+
     ValueType current_minimum = minimum_.load(std::memory_order_relaxed);
     while (current_minimum > other.minimum_.load(std::memory_order_relaxed) ||
            !count_.load(std::memory_order_relaxed)) {
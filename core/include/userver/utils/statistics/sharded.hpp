@@ -0,0 +1,139 @@
+#pragma once
+
+/// @file userver/utils/statistics/sharded.hpp
+/// @brief @copybrief utils::statistics::ShardedMetric
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include <userver/concurrent/sharded_variable.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/utils/void_t.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace impl {
+
+template <typename T, typename = void_t<>>
+struct CanAddWithAddFunction : std::false_type {};
+
+template <typename T>
+struct CanAddWithAddFunction<
+    T, void_t<decltype(std::declval<T&>().Add(std::declval<const T&>()))>>
+    : std::true_type {};
+
+// Adds up the values of the shards, e.g. Percentile::Add or
+// RelaxedCounter::operator+=
+template <typename T>
+void AddShard(T& result, const T& shard) {
+  if constexpr (CanAddWithAddFunction<T>::value) {
+    result.Add(shard);
+  } else {
+    result += shard;
+  }
+}
+
+}  // namespace impl
+
+/// @brief Metric that is written to the shard of the current engine worker
+/// and is combined from all the shards only when it is dumped.
+///
+/// Use it instead of a hot utils::statistics::Percentile,
+/// utils::statistics::MinMaxAvg or utils::statistics::RelaxedCounter
+/// that is updated by every request on a many-core machine: the updates do
+/// not bounce the cache lines between the cores. `Metric` must be
+/// default-constructible and provide either `Add(const Metric&)` or
+/// `operator+=` to be combined.
+///
+/// Each shard is a full copy of the `Metric`, mind the memory for the large
+/// percentiles.
+///
+/// ## Example usage:
+///
+/// @snippet core/src/utils/statistics/sharded_test.cpp  ShardedMetric usage
+template <typename Metric>
+class ShardedMetric final {
+ public:
+  ShardedMetric() = default;
+
+  explicit ShardedMetric(std::size_t shard_count) : shards_(shard_count) {}
+
+  /// Returns the shard of the current thread to update
+  Metric& GetLocal() noexcept { return shards_.GetLocal(); }
+
+  /// Accounts the value in the shard of the current thread
+  template <typename... Args>
+  void Account(Args&&... args) {
+    GetLocal().Account(std::forward<Args>(args)...);
+  }
+
+  /// Combines all the shards into a single value
+  Metric Combine() const {
+    Metric result{};
+    shards_.VisitAll(
+        [&result](const Metric& shard) { impl::AddShard(result, shard); });
+    return result;
+  }
+
+  void Reset() {
+    shards_.VisitAll([](Metric& shard) { shard.Reset(); });
+  }
+
+ private:
+  concurrent::ShardedVariable<Metric> shards_;
+};
+
+template <typename Metric>
+void DumpMetric(Writer& writer, const ShardedMetric<Metric>& value) {
+  writer = value.Combine();
+}
+
+/// @brief utils::statistics::RecentPeriod that keeps a separate circular
+/// buffer per engine worker and sums up the results of all the shards on
+/// read.
+///
+/// `Result` must provide either `Add(const Result&)` or `operator+=` to be
+/// combined, utils::statistics::Percentile does.
+template <typename Counter, typename Result,
+          typename Timer = std::chrono::steady_clock>
+class ShardedRecentPeriod final {
+ public:
+  using Duration = typename Timer::duration;
+  using Shard = RecentPeriod<Counter, Result, Timer>;
+
+  /// @see utils::statistics::RecentPeriod::RecentPeriod
+  explicit ShardedRecentPeriod(
+      Duration epoch_duration = std::chrono::seconds(5),
+      Duration max_duration = std::chrono::seconds(60),
+      std::size_t shard_count = concurrent::impl::GetDefaultShardCount())
+      : shards_(shard_count, epoch_duration, max_duration) {}
+
+  /// Returns the current counter of the shard of the current thread
+  Counter& GetCurrentCounter() { return shards_.GetLocal().GetCurrentCounter(); }
+
+  /// @see utils::statistics::RecentPeriod::GetStatsForPeriod
+  Result GetStatsForPeriod(Duration duration = Duration::min(),
+                           bool with_current_epoch = false) const {
+    Result result{};
+    shards_.VisitAll([&](const Shard& shard) {
+      impl::AddShard(result,
+                     shard.GetStatsForPeriod(duration, with_current_epoch));
+    });
+    return result;
+  }
+
+  void Reset() {
+    shards_.VisitAll([](Shard& shard) { shard.Reset(); });
+  }
+
+ private:
+  concurrent::ShardedVariable<Shard> shards_;
+};
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -4,6 +4,8 @@
 /// @brief @copybrief utils::statistics::Storage
 
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
 #include <list>
@@ -17,6 +19,7 @@
 #include <userver/utils/clang_format_workarounds.hpp>
 #include <userver/utils/statistics/entry.hpp>
 #include <userver/utils/statistics/metric_value.hpp>
+#include <userver/utils/statistics/relaxed_counter.hpp>
 #include <userver/utils/statistics/writer.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -81,6 +84,22 @@ class Request final {
           std::vector<Label> require_labels_in, AddLabels add_labels_in);
 };
 
+/// @brief Settings of the writers visitation of Storage::VisitMetrics
+struct VisitSettings final {
+  /// Yield the current coroutine after each writer, so that a long metrics
+  /// dump does not occupy the thread of the task processor
+  bool yield_between_writers{false};
+
+  /// Skip the rest of the writers once the writers of a single visitation
+  /// took that much time, zero for no limit. Yields are not accounted.
+  std::chrono::microseconds writers_time_budget{0};
+
+  /// Write `statistics.writers.*` metrics with the time spent by the writers
+  /// of each prefix during the previous visitation and the count of the
+  /// visitations that ran out of the time budget
+  bool report_writers_durations{false};
+};
+
 using ExtenderFunc =
     std::function<formats::json::ValueBuilder(const StatisticsRequest&)>;
 
@@ -95,6 +114,9 @@ struct MetricsSource final {
 
   WriterFunc writer;
   std::vector<Label> writer_labels;
+
+  // Time of the writer during the previous visitation
+  mutable RelaxedCounter<std::int64_t> last_duration_us{0};
 };
 
 using StorageData = std::list<MetricsSource>;
@@ -119,6 +141,8 @@ class Storage final {
  public:
   Storage();
 
+  explicit Storage(VisitSettings settings);
+
   Storage(const Storage&) = delete;
 
   /// Creates new Json::Value and calls every deprecated registered extender
@@ -149,6 +173,10 @@ class Storage final {
  private:
   Entry DoRegisterExtender(impl::MetricsSource&& source);
 
+  void WriteWritersDurations(impl::WriterState& state) const;
+
+  const VisitSettings settings_;
+  mutable RelaxedCounter<std::uint64_t> budget_exceeded_{0};
   std::atomic<bool> may_register_extenders_;
   impl::StorageData metrics_sources_;
   mutable engine::SharedMutex mutex_;
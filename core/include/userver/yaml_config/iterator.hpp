@@ -60,10 +60,9 @@ class Iterator final {
   void UpdateValue() const;
 
   // Pointer to the 'container' yaml - because substitution parsing
-  // only works with container[index/key] statements
+  // needs the container for the config_vars and the fallbacks
   const value_type* container_{nullptr};
-  // Iterator over container. We actually only use its GetIndex/GetName
-  // members
+  // Iterator over container
   YamlIterator it_;
   mutable std::optional<value_type> current_;
 };
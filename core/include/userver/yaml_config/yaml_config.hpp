@@ -116,8 +116,13 @@ class YamlConfig {
   const_iterator end() const;
 
  private:
+  // `value` is the member `key` of *this, resolves the substitutions in it
+  YamlConfig MakeMember(formats::yaml::Value value, std::string_view key) const;
+
   formats::yaml::Value yaml_;
   formats::yaml::Value config_vars_;
+
+  friend class Iterator<IterTraits>;
 };
 
 template <typename T>
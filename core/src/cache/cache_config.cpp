@@ -23,6 +23,7 @@ constexpr std::string_view kFullUpdateIntervalMs = "full-update-interval-ms";
 constexpr std::string_view kExceptionIntervalMs = "exception-interval-ms";
 constexpr std::string_view kUpdatesEnabled = "updates-enabled";
 constexpr std::string_view kTaskProcessor = "task-processor";
+constexpr std::string_view kUpdateGroup = "update-group";
 
 constexpr std::string_view kUpdateInterval = "update-interval";
 constexpr std::string_view kUpdateJitter = "update-jitter";
@@ -123,6 +124,7 @@ Config::Config(const yaml_config::YamlConfig& config,
       config_updates_enabled(config[kConfigSettings].As<bool>(true)),
       task_processor_name(
           config[kTaskProcessor].As<std::optional<std::string>>()),
+      update_group(config[kUpdateGroup].As<std::optional<std::string>>()),
       cleanup_interval(config[kCleanupInterval].As<std::chrono::milliseconds>(
           kDefaultCleanupInterval)),
       is_strong_period(config[kIsStrongPeriod].As<bool>(false)),
@@ -1,5 +1,8 @@
 #include <cache/cache_dependencies.hpp>
 
+#include <fmt/format.h>
+
+#include <userver/cache/cache_update_scheduler.hpp>
 #include <userver/components/component.hpp>
 #include <userver/components/dump_configurator.hpp>
 #include <userver/components/statistics_storage.hpp>
@@ -36,6 +39,22 @@ std::optional<dynamic_config::Source> FindDynamicConfig(
              : std::nullopt;
 }
 
+impl::UpdateLimiter* FindUpdateLimiter(
+    const components::ComponentContext& context, const Config& static_config) {
+  auto* scheduler =
+      context.FindComponentOptional<components::CacheUpdateScheduler>();
+  if (!scheduler) {
+    if (static_config.update_group) {
+      throw ConfigError(fmt::format(
+          "'update-group' is set to '{}', but the '{}' component is missing",
+          *static_config.update_group,
+          components::CacheUpdateScheduler::kName));
+    }
+    return nullptr;
+  }
+  return &scheduler->GetLimiter();
+}
+
 }  // namespace
 
 CacheDependencies CacheDependencies::Make(
@@ -58,6 +77,7 @@ CacheDependencies CacheDependencies::Make(
       dump_config ? &context.GetTaskProcessor(dump_config->fs_task_processor)
                   : nullptr,
       context.FindComponent<components::TestsuiteSupport>().GetDumpControl(),
+      FindUpdateLimiter(context, static_config),
   };
 }
 
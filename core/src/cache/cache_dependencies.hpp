@@ -18,6 +18,10 @@ USERVER_NAMESPACE_BEGIN
 
 namespace cache {
 
+namespace impl {
+class UpdateLimiter;
+}  // namespace impl
+
 struct CacheDependencies final {
   std::string name;
   Config config;
@@ -29,6 +33,7 @@ struct CacheDependencies final {
   std::unique_ptr<dump::OperationsFactory> dump_rw_factory;
   engine::TaskProcessor* fs_task_processor;
   testsuite::DumpControl& dump_control;
+  impl::UpdateLimiter* update_limiter{nullptr};
 
   static CacheDependencies Make(const components::ComponentConfig& config,
                                 const components::ComponentContext& context);
@@ -15,6 +15,15 @@ constexpr const char* kStatisticsNameIncremental = "incremental";
 constexpr const char* kStatisticsNameAny = "any";
 constexpr const char* kStatisticsNameCurrentDocumentsCount =
     "current-documents-count";
+constexpr const char* kStatisticsNameCurrentSizeInBytes =
+    "current-size-in-bytes";
+
+constexpr const char* kStageNames[impl::kUpdateStagesCount] = {
+    "last-update-fetch-duration-ms",
+    "last-update-parse-duration-ms",
+    "last-update-build-duration-ms",
+    "last-update-publish-duration-ms",
+};
 
 template <typename Clock, typename Duration>
 std::int64_t TimeStampToMillisecondsFromNow(
@@ -42,6 +51,11 @@ void CombineStatistics(const impl::UpdateStatistics& a,
                b.last_successful_update_start_time.load());
   result.last_update_duration =
       std::max(a.last_update_duration.load(), b.last_update_duration.load());
+  for (std::size_t i = 0; i < impl::kUpdateStagesCount; ++i) {
+    result.last_update_stage_durations[i] =
+        std::max(a.last_update_stage_durations[i].load(),
+                 b.last_update_stage_durations[i].load());
+  }
 }
 
 }  // namespace
@@ -72,6 +86,10 @@ formats::json::Value Serialize(const UpdateStatistics& stats,
       std::chrono::duration_cast<std::chrono::milliseconds>(
           stats.last_update_duration.load())
           .count();
+  for (std::size_t i = 0; i < kUpdateStagesCount; ++i) {
+    age[cache::kStageNames[i]] =
+        stats.last_update_stage_durations[i].load().count();
+  }
   result["time"] = age.ExtractValue();
 
   return result.ExtractValue();
@@ -92,6 +110,16 @@ formats::json::Value Serialize(const Statistics& stats,
 
   builder[cache::kStatisticsNameCurrentDocumentsCount] =
       stats.documents_current_count.load();
+  if (const auto size = stats.current_size_in_bytes.load();
+      size != kUnknownSize) {
+    builder[cache::kStatisticsNameCurrentSizeInBytes] = size;
+  }
+
+  formats::json::ValueBuilder retired(formats::json::Type::kObject);
+  retired["last-wait-ms"] = stats.last_retired_value_wait.load().count();
+  retired["last-destruction-ms"] =
+      stats.last_retired_value_destruction.load().count();
+  builder["retired-value"] = retired.ExtractValue();
 
   return builder.ExtractValue();
 }
@@ -119,6 +147,12 @@ void UpdateStatisticsScope::Finish(size_t documents_count) {
   update_stats_.last_update_duration =
       std::chrono::duration_cast<std::chrono::milliseconds>(update_stop_time -
                                                             update_start_time_);
+  FinishStage(update_stop_time);
+  for (std::size_t i = 0; i < impl::kUpdateStagesCount; ++i) {
+    update_stats_.last_update_stage_durations[i] =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            stage_durations_[i]);
+  }
   stats_.documents_current_count = documents_count;
 
   finished_ = true;
@@ -129,6 +163,21 @@ void UpdateStatisticsScope::FinishNoChanges() {
   Finish(stats_.documents_current_count.load());
 }
 
+void UpdateStatisticsScope::SetStage(UpdateStage stage) noexcept {
+  const auto now = std::chrono::steady_clock::now();
+  FinishStage(now);
+  stage_ = stage;
+  stage_start_time_ = now;
+}
+
+void UpdateStatisticsScope::FinishStage(
+    std::chrono::steady_clock::time_point now) noexcept {
+  if (!stage_) return;
+  stage_durations_[static_cast<std::size_t>(*stage_)] +=
+      now - stage_start_time_;
+  stage_.reset();
+}
+
 void UpdateStatisticsScope::IncreaseDocumentsReadCount(size_t add) {
   update_stats_.documents_read_count += add;
 }
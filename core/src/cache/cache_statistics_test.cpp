@@ -0,0 +1,77 @@
+#include <userver/cache/cache_statistics.hpp>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::chrono::milliseconds kStageDuration{10};
+
+std::chrono::milliseconds GetStageDuration(
+    const cache::impl::UpdateStatistics& stats, cache::UpdateStage stage) {
+  return stats.last_update_stage_durations[static_cast<std::size_t>(stage)];
+}
+
+}  // namespace
+
+UTEST(CacheUpdateStatistics, Stages) {
+  cache::impl::Statistics stats;
+  {
+    cache::UpdateStatisticsScope scope(stats, cache::UpdateType::kFull);
+    scope.SetStage(cache::UpdateStage::kFetch);
+    engine::SleepFor(kStageDuration);
+    scope.SetStage(cache::UpdateStage::kParse);
+    engine::SleepFor(kStageDuration);
+    scope.SetStage(cache::UpdateStage::kFetch);
+    engine::SleepFor(kStageDuration);
+    scope.SetStage(cache::UpdateStage::kPublish);
+    scope.Finish(1);
+  }
+
+  const auto& full = stats.full_update;
+  EXPECT_GE(GetStageDuration(full, cache::UpdateStage::kFetch),
+            2 * kStageDuration);
+  EXPECT_GE(GetStageDuration(full, cache::UpdateStage::kParse),
+            kStageDuration);
+  EXPECT_LT(GetStageDuration(full, cache::UpdateStage::kBuild),
+            kStageDuration);
+  EXPECT_GE(full.last_update_duration.load(), 3 * kStageDuration);
+
+  const auto json = formats::json::ValueBuilder{stats}.ExtractValue();
+  EXPECT_GE(json["full"]["time"]["last-update-fetch-duration-ms"].As<int>(),
+            2 * kStageDuration.count());
+  EXPECT_GE(json["any"]["time"]["last-update-parse-duration-ms"].As<int>(),
+            kStageDuration.count());
+  EXPECT_EQ(
+      json["incremental"]["time"]["last-update-parse-duration-ms"].As<int>(),
+      0);
+  EXPECT_FALSE(json.HasMember("current-size-in-bytes"));
+  EXPECT_TRUE(json["retired-value"].HasMember("last-wait-ms"));
+}
+
+UTEST(CacheUpdateStatistics, FailedUpdateKeepsStages) {
+  cache::impl::Statistics stats;
+  {
+    cache::UpdateStatisticsScope scope(stats, cache::UpdateType::kIncremental);
+    scope.SetStage(cache::UpdateStage::kFetch);
+    engine::SleepFor(kStageDuration);
+    scope.Finish(1);
+  }
+  {
+    cache::UpdateStatisticsScope scope(stats, cache::UpdateType::kIncremental);
+    scope.SetStage(cache::UpdateStage::kParse);
+  }
+
+  const auto& incremental = stats.incremental_update;
+  EXPECT_EQ(incremental.update_failures_count.load(), 1);
+  EXPECT_GE(GetStageDuration(incremental, cache::UpdateStage::kFetch),
+            kStageDuration);
+  EXPECT_EQ(GetStageDuration(incremental, cache::UpdateStage::kParse),
+            std::chrono::milliseconds{0});
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,55 @@
+#include <userver/cache/cache_update_scheduler.hpp>
+
+#include <string>
+#include <unordered_map>
+
+#include <userver/components/component.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <cache/update_limiter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components {
+
+CacheUpdateScheduler::CacheUpdateScheduler(const ComponentConfig& config,
+                                           const ComponentContext& context)
+    : LoggableComponentBase(config, context),
+      limiter_(std::make_unique<cache::impl::UpdateLimiter>(
+          config["max-concurrent-updates"].As<std::size_t>(0),
+          config["groups"]
+              .As<std::unordered_map<std::string, std::size_t>>({}))) {}
+
+CacheUpdateScheduler::~CacheUpdateScheduler() = default;
+
+cache::impl::UpdateLimiter& CacheUpdateScheduler::GetLimiter() noexcept {
+  return *limiter_;
+}
+
+yaml_config::Schema CacheUpdateScheduler::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<LoggableComponentBase>(R"(
+type: object
+description: Limits the count of the concurrently running cache updates
+additionalProperties: false
+properties:
+    max-concurrent-updates:
+        type: integer
+        description: max count of the updates running at once, 0 for no limit
+        defaultDescription: 0
+        minimum: 0
+    groups:
+        type: object
+        description: map of the group name to the max count of the updates running at once in that group
+        defaultDescription: '{}'
+        additionalProperties:
+            type: integer
+            description: max count of the updates running at once in the group
+            minimum: 1
+        properties: {}
+)");
+}
+
+}  // namespace components
+
+USERVER_NAMESPACE_END
@@ -49,6 +49,10 @@ engine::TaskProcessor& CacheUpdateTrait::GetCacheTaskProcessor() const {
   return impl_->GetCacheTaskProcessor();
 }
 
+impl::Statistics& CacheUpdateTrait::GetStatistics() noexcept {
+  return impl_->GetStatistics();
+}
+
 void CacheUpdateTrait::GetAndWrite(dump::Writer&) const {
   dump::ThrowDumpUnimplemented(Name());
 }
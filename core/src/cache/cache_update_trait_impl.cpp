@@ -55,6 +55,11 @@ CacheUpdateTrait::Impl::Impl(CacheDependencies&& dependencies,
                              CacheUpdateTrait& self)
     : customized_trait_(self),
       static_config_(dependencies.config),
+      update_limiter_(dependencies.update_limiter),
+      update_group_(
+          update_limiter_
+              ? update_limiter_->FindGroup(static_config_.update_group)
+              : nullptr),
       config_(static_config_),
       cache_control_(dependencies.cache_control),
       name_(std::move(dependencies.name)),
@@ -260,6 +265,12 @@ void CacheUpdateTrait::Impl::DoPeriodicUpdate() {
     return;
   }
 
+  // Wait for the turn of this cache if the concurrent updates are limited
+  std::optional<impl::UpdateLimiter::Slot> update_slot;
+  if (update_limiter_) {
+    update_slot.emplace(update_limiter_->Acquire(update_group_, last_update_));
+  }
+
   const auto update_type = NextUpdateType(*config);
   try {
     DoUpdate(update_type);
@@ -283,6 +294,10 @@ engine::TaskProcessor& CacheUpdateTrait::Impl::GetCacheTaskProcessor() const {
   return task_processor_;
 }
 
+impl::Statistics& CacheUpdateTrait::Impl::GetStatistics() noexcept {
+  return statistics_;
+}
+
 void CacheUpdateTrait::Impl::DoUpdate(UpdateType update_type) {
   const auto steady_now = utils::datetime::SteadyNow();
   const auto now =
@@ -317,6 +332,7 @@ utils::PeriodicTask::Settings CacheUpdateTrait::Impl::GetPeriodicTaskSettings(
       config.update_interval, config.update_jitter, periodic_task_flags_};
   settings.exception_period = config.exception_interval;
   settings.task_processor = &task_processor_;
+  settings.priority = engine::TaskPriority::kBackground;
   return settings;
 }
 
@@ -23,6 +23,8 @@
 #include <userver/dump/operations.hpp>
 #include <userver/testsuite/cache_control.hpp>
 
+#include <cache/update_limiter.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace cache {
@@ -54,6 +56,8 @@ class CacheUpdateTrait::Impl final {
 
   engine::TaskProcessor& GetCacheTaskProcessor() const;
 
+  impl::Statistics& GetStatistics() noexcept;
+
  private:
   UpdateType NextUpdateType(const Config& config);
 
@@ -83,6 +87,8 @@ class CacheUpdateTrait::Impl final {
   CacheUpdateTrait& customized_trait_;
   impl::Statistics statistics_;
   const Config static_config_;
+  impl::UpdateLimiter* const update_limiter_;
+  impl::UpdateLimiter::Group* const update_group_;
   rcu::Variable<Config> config_;
   testsuite::CacheControl& cache_control_;
   const std::string name_;
@@ -40,6 +40,10 @@ properties:
         type: string
         description: the name of the TaskProcessor for running DoWork
         defaultDescription: main-task-processor
+    update-group:
+        type: string
+        description: the group of components::CacheUpdateScheduler to limit the concurrent updates in
+        defaultDescription: no group
     config-settings:
         type: boolean
         description: enables dynamic reconfiguration with CacheConfigSet
@@ -89,6 +93,18 @@ properties:
                 type: boolean
                 description: Whether to encrypt the dump
                 defaultDescription: false
+            io-buffer-size:
+                type: integer
+                description: size of the aligned buffer for reading and writing the dump in large blocks, 0 for the buffered FILE* I/O
+                defaultDescription: 0
+            direct-io:
+                type: boolean
+                description: bypass the page cache with O_DIRECT, or drop the dump from the page cache if it is unsupported
+                defaultDescription: false
+            async-io:
+                type: boolean
+                description: overlap the file I/O with (de)serialization using a second buffer
+                defaultDescription: false
             first-update-mode:
                 type: string
                 description: specifies whether required or best-effort first update will be used
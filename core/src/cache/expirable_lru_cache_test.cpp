@@ -1,9 +1,13 @@
+#include <atomic>
 #include <string>
+#include <vector>
 
 #include <userver/utest/utest.hpp>
 
 #include <userver/cache/expirable_lru_cache.hpp>
 #include <userver/dump/operations_mock.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_use_event.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/utils/mock_now.hpp>
 
@@ -209,6 +213,57 @@ UTEST(ExpirableLruCache, NoCache) {
   EXPECT_EQ(Counter::One(), *counter);
 }
 
+UTEST(ExpirableLruCache, CoalescedUpdates) {
+  constexpr std::size_t kWaiters = 4;
+  std::atomic<int> update_count{0};
+  engine::SingleUseEvent update_allowed;
+
+  auto cache = CreateSimpleCache();
+  const SimpleCache::UpdateValueFunc update_func = [&](const SimpleCacheKey&) {
+    update_allowed.WaitNonCancellable();
+    return ++update_count;
+  };
+
+  std::vector<engine::TaskWithResult<SimpleCacheValue>> tasks;
+  for (std::size_t i = 0; i < kWaiters; ++i) {
+    tasks.push_back(
+        engine::AsyncNoSpan([&] { return cache.Get("my-key", update_func); }));
+  }
+  EngineYield();
+
+  update_allowed.Send();
+  for (auto& task : tasks) EXPECT_EQ(1, task.Get());
+  EXPECT_EQ(1, update_count);
+
+  // The coalesced result is cached
+  EXPECT_EQ(1, cache.Get("my-key", update_func));
+  EXPECT_EQ(1, update_count);
+}
+
+UTEST(ExpirableLruCache, SkipCacheUpdatesAreNotCoalesced) {
+  constexpr std::size_t kCallers = 4;
+  std::atomic<int> update_count{0};
+  engine::SingleUseEvent update_allowed;
+
+  auto cache = CreateSimpleCache();
+  const auto read_mode = SimpleCache::ReadMode::kSkipCache;
+  const SimpleCache::UpdateValueFunc update_func = [&](const SimpleCacheKey&) {
+    update_allowed.WaitNonCancellable();
+    return ++update_count;
+  };
+
+  std::vector<engine::TaskWithResult<SimpleCacheValue>> tasks;
+  for (std::size_t i = 0; i < kCallers; ++i) {
+    tasks.push_back(engine::AsyncNoSpan(
+        [&] { return cache.Get("my-key", update_func, read_mode); }));
+  }
+  EngineYield();
+
+  update_allowed.Send();
+  for (auto& task : tasks) task.Get();
+  EXPECT_EQ(static_cast<int>(kCallers), update_count);
+}
+
 UTEST(ExpirableLruCache, Expire) {
   auto counter = std::make_shared<Counter>();
 
@@ -330,6 +385,85 @@ UTEST(ExpirableLruCache, BackgroundUpdate) {
   EXPECT_EQ(2, cache.Get(key, UpdateNever()));
 }
 
+UTEST(ExpirableLruCache, ServeStale) {
+  auto counter = std::make_shared<Counter>();
+
+  auto cache = CreateSimpleCache();
+  cache.SetMaxLifetime(std::chrono::seconds(2));
+  cache.SetStaleLifetime(std::chrono::seconds(2));
+  constexpr auto kServeStale = SimpleCache::ReadMode::kServeStale;
+
+  SimpleCacheKey key = "my-key";
+
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+
+  counter->Flush();
+  EXPECT_EQ(1, cache.Get(key, UpdateValue(counter, 1), kServeStale));
+  EXPECT_EQ(Counter::One(), *counter);
+
+  utils::datetime::MockSleep(std::chrono::seconds(3));
+
+  // stale value is returned and is updated in background
+  counter->Flush();
+  EXPECT_EQ(1, cache.Get(key, UpdateValue(counter, 2), kServeStale));
+  EngineYield();
+  EXPECT_EQ(Counter::One(), *counter);
+  EXPECT_EQ(2, cache.Get(key, UpdateNever(), kServeStale));
+
+  // too old to be served
+  utils::datetime::MockSleep(std::chrono::seconds(5));
+  counter->Flush();
+  EXPECT_EQ(3, cache.Get(key, UpdateValue(counter, 3), kServeStale));
+  EXPECT_EQ(Counter::One(), *counter);
+
+  // the other read modes do not return stale values
+  utils::datetime::MockSleep(std::chrono::seconds(3));
+  EXPECT_EQ(std::nullopt, cache.GetOptional(key, UpdateNever()));
+  counter->Flush();
+  EXPECT_EQ(4, cache.Get(key, UpdateValue(counter, 4)));
+  EXPECT_EQ(Counter::One(), *counter);
+}
+
+UTEST(ExpirableLruCache, BackgroundUpdatesLimit) {
+  auto counter = std::make_shared<Counter>();
+
+  SimpleCache cache(1, 10);
+  cache.SetMaxLifetime(std::chrono::seconds(2));
+  cache.SetStaleLifetime(std::chrono::seconds(10));
+  cache.SetBackgroundUpdatesPerSecond(1);
+  constexpr auto kServeStale = SimpleCache::ReadMode::kServeStale;
+
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+
+  EXPECT_EQ(1, cache.Get("a", UpdateValue(counter, 1), kServeStale));
+  EXPECT_EQ(1, cache.Get("b", UpdateValue(counter, 1), kServeStale));
+  utils::datetime::MockSleep(std::chrono::seconds(3));
+
+  // the second update within the same second is skipped
+  counter->Flush();
+  EXPECT_EQ(1, cache.Get("a", UpdateValue(counter, 2), kServeStale));
+  EXPECT_EQ(1, cache.Get("b", UpdateValue(counter, 2), kServeStale));
+  EngineYield();
+  EXPECT_EQ(Counter::One(), *counter);
+  EXPECT_EQ(2, cache.Get("a", UpdateNever(), kServeStale));
+  EXPECT_EQ(1, cache.GetStatistics().total.background_updates.load());
+
+  utils::datetime::MockSleep(std::chrono::seconds(1));
+  counter->Flush();
+  EXPECT_EQ(1, cache.Get("b", UpdateValue(counter, 2), kServeStale));
+  EngineYield();
+  EXPECT_EQ(Counter::One(), *counter);
+  EXPECT_EQ(2, cache.Get("b", UpdateNever(), kServeStale));
+
+  cache.SetBackgroundUpdatesPerSecond(0);
+  utils::datetime::MockSleep(std::chrono::seconds(3));
+  counter->Flush();
+  EXPECT_EQ(2, cache.Get("a", UpdateValue(counter, 3), kServeStale));
+  EXPECT_EQ(2, cache.Get("b", UpdateValue(counter, 3), kServeStale));
+  EngineYield();
+  EXPECT_EQ(Counter(2), *counter);
+}
+
 UTEST(ExpirableLruCache, Example) {
   /// [Sample ExpirableLruCache]
   using Key = std::string;
@@ -33,6 +33,7 @@ CacheDependencies MakeDependencies(std::string_view name,
                   : nullptr,
       &engine::current_task::GetTaskProcessor(),
       environment.dump_control,
+      nullptr,
   };
 }
 
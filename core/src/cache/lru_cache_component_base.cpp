@@ -22,15 +22,18 @@ constexpr const char* kStatisticsNameBackground = "background-updates";
 constexpr const char* kStatisticsNameHitRatio = "hit_ratio";
 constexpr const char* kStatisticsNameCurrentDocumentsCount =
     "current-documents-count";
+constexpr const char* kStatisticsNameBytes = "bytes";
 
 }  // namespace
 
 formats::json::Value GetCacheStatisticsAsJson(
-    const ExpirableLruCacheStatistics& stats, std::size_t size) {
+    const ExpirableLruCacheStatistics& stats, std::size_t size,
+    std::size_t size_in_bytes) {
   formats::json::ValueBuilder builder;
   utils::statistics::SolomonLabelValue(builder, "cache_name");
 
   builder[kStatisticsNameCurrentDocumentsCount] = size;
+  builder[kStatisticsNameBytes] = size_in_bytes;
   builder[kStatisticsNameHits] = stats.total.hits.load();
   builder[kStatisticsNameMisses] = stats.total.misses.load();
   builder[kStatisticsNameStale] = stats.total.stale.load();
@@ -84,6 +87,10 @@ properties:
     size:
         type: integer
         description: max amount of items to store in cache
+    size-in-bytes:
+        type: integer
+        description: max memory usage of the cache (0 is unlimited)
+        defaultDescription: 0
     ways:
         type: integer
         description: number of ways for associative cache
@@ -91,10 +98,27 @@ properties:
         type: string
         description: TTL for cache entries (0 is unlimited)
         defaultDescription: 0
+    stale-lifetime:
+        type: string
+        description: |
+            how long the expired entries may be returned while being
+            updated in background (0 disables)
+        defaultDescription: 0
+    background-updates-per-second:
+        type: integer
+        description: rate limit of the background updates (0 is unlimited)
+        defaultDescription: 0
     config-settings:
         type: boolean
         description: enables dynamic reconfiguration with CacheConfigSet
         defaultDescription: true
+    policy:
+        type: string
+        description: eviction policy
+        defaultDescription: lru
+        enum:
+          - lru
+          - tinylfu
 )");
 }
 
@@ -2,10 +2,13 @@
 
 #include <stdexcept>
 
+#include <fmt/format.h>
+
 #include <userver/components/component_config.hpp>
 #include <userver/dump/config.hpp>
 #include <userver/dynamic_config/value.hpp>
 #include <userver/utils/algo.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -15,9 +18,15 @@ namespace {
 
 constexpr std::string_view kWays = "ways";
 constexpr std::string_view kSize = "size";
+constexpr std::string_view kSizeInBytes = "size-in-bytes";
 constexpr std::string_view kLifetime = "lifetime";
+constexpr std::string_view kStaleLifetime = "stale-lifetime";
 constexpr std::string_view kBackgroundUpdate = "background-update";
+constexpr std::string_view kBackgroundUpdatesPerSecond =
+    "background-updates-per-second";
 constexpr std::string_view kLifetimeMs = "lifetime-ms";
+constexpr std::string_view kStaleLifetimeMs = "stale-lifetime-ms";
+constexpr std::string_view kPolicy = "policy";
 
 }  // namespace
 
@@ -25,10 +34,14 @@ using dump::impl::ParseMs;
 
 LruCacheConfig::LruCacheConfig(const yaml_config::YamlConfig& config)
     : size(config[kSize].As<std::size_t>()),
+      size_in_bytes(config[kSizeInBytes].As<std::size_t>(0)),
       lifetime(config[kLifetime].As<std::chrono::milliseconds>(0)),
+      stale_lifetime(config[kStaleLifetime].As<std::chrono::milliseconds>(0)),
       background_update(config[kBackgroundUpdate].As<bool>(false)
                             ? BackgroundUpdateMode::kEnabled
-                            : BackgroundUpdateMode::kDisabled) {
+                            : BackgroundUpdateMode::kDisabled),
+      background_updates_per_second(
+          config[kBackgroundUpdatesPerSecond].As<std::size_t>(0)) {
   if (size == 0) throw std::runtime_error("cache-size is non-positive");
 }
 
@@ -37,10 +50,15 @@ LruCacheConfig::LruCacheConfig(const components::ComponentConfig& config)
 
 LruCacheConfig::LruCacheConfig(const formats::json::Value& value)
     : size(value[kSize].As<std::size_t>()),
+      size_in_bytes(value[kSizeInBytes].As<std::size_t>(0)),
       lifetime(ParseMs(value[kLifetimeMs])),
+      stale_lifetime(
+          ParseMs(value[kStaleLifetimeMs], std::chrono::milliseconds{0})),
       background_update(value[kBackgroundUpdate].As<bool>(false)
                             ? BackgroundUpdateMode::kEnabled
-                            : BackgroundUpdateMode::kDisabled) {
+                            : BackgroundUpdateMode::kDisabled),
+      background_updates_per_second(
+          value[kBackgroundUpdatesPerSecond].As<std::size_t>(0)) {
   if (size == 0) throw std::runtime_error("cache-size is non-positive");
 }
 
@@ -49,16 +67,34 @@ std::size_t LruCacheConfig::GetWaySize(std::size_t ways) const {
   return way_size == 0 ? 1 : way_size;
 }
 
+std::size_t LruCacheConfig::GetWaySizeInBytes(std::size_t ways) const {
+  if (size_in_bytes == 0) return 0;
+  const auto way_size = size_in_bytes / ways;
+  return way_size == 0 ? 1 : way_size;
+}
+
 LruCacheConfig Parse(const formats::json::Value& value,
                      formats::parse::To<LruCacheConfig>) {
   return LruCacheConfig{value};
 }
 
+CachePolicy Parse(const yaml_config::YamlConfig& config,
+                  formats::parse::To<CachePolicy>) {
+  const auto as_string = config.As<std::string>();
+
+  if (as_string == "lru") return CachePolicy::kLRU;
+  if (as_string == "tinylfu") return CachePolicy::kTinyLFU;
+
+  throw yaml_config::ParseException(fmt::format(
+      "Invalid cache policy '{}' at '{}'", as_string, config.GetPath()));
+}
+
 LruCacheConfigStatic::LruCacheConfigStatic(
     const yaml_config::YamlConfig& config)
     : config(config),
       ways(config[kWays].As<std::size_t>()),
-      use_dynamic_config(config["config-settings"].As<bool>(true)) {
+      use_dynamic_config(config["config-settings"].As<bool>(true)),
+      policy(config[kPolicy].As<CachePolicy>(CachePolicy::kLRU)) {
   if (ways <= 0) throw std::runtime_error("cache-ways is non-positive");
 }
 
@@ -71,6 +107,10 @@ std::size_t LruCacheConfigStatic::GetWaySize() const {
   return config.GetWaySize(ways);
 }
 
+std::size_t LruCacheConfigStatic::GetWaySizeInBytes() const {
+  return config.GetWaySizeInBytes(ways);
+}
+
 std::unordered_map<std::string, LruCacheConfig> ParseLruCacheConfigSet(
     const dynamic_config::DocsMap& docs_map) {
   return docs_map.Get("USERVER_LRU_CACHES")
@@ -2,6 +2,13 @@
 
 #include <userver/cache/nway_lru_cache.hpp>
 
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 using Cache = cache::NWayLRU<int, int>;
@@ -54,4 +61,70 @@ UTEST(NWayLRU, SetMultipleWays) {
   EXPECT_EQ(1, cache.Get(1));
 }
 
+UTEST(NWayLRU, BufferedReads) {
+  Cache cache(1, 2);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+
+  // the usage is updated by the next exclusive access
+  EXPECT_EQ(1, cache.Get(1));
+  cache.Put(3, 3);
+
+  EXPECT_FALSE(cache.Get(2).has_value());
+  EXPECT_EQ(1, cache.Get(1));
+  EXPECT_EQ(3, cache.Get(3));
+}
+
+UTEST_MT(NWayLRU, ConcurrentReads, 4) {
+  constexpr int kKeys = 100;
+  Cache cache(2, kKeys / 4);
+  std::atomic<bool> stop{false};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int i = 0; i < 3; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&cache, &stop, i] {
+      for (int key = i; !stop; key = (key + 7) % kKeys) {
+        const auto value = cache.Get(key);
+        if (value) {
+          EXPECT_EQ(key, *value);
+        }
+        engine::Yield();
+      }
+    }));
+  }
+
+  for (int i = 0; i < 10000; ++i) {
+    cache.Put(i % kKeys, i % kKeys);
+    if (i % 100 == 0) engine::Yield();
+  }
+  stop = true;
+  for (auto& task : tasks) task.Get();
+  EXPECT_EQ(kKeys / 2, cache.GetSize());
+}
+
+UTEST(NWayLRU, SizeInBytes) {
+  cache::NWayLRU<int, std::string> cache(2, 100);
+  const auto empty_size = cache.GetSizeInBytes();
+  for (int i = 0; i < 10; ++i) cache.Put(i, std::string(1000, 'x'));
+  EXPECT_GT(cache.GetSizeInBytes(), empty_size + 10 * 1000);
+
+  cache.UpdateWaySizeInBytes((cache.GetSizeInBytes() - empty_size) / 4 +
+                             empty_size / 2);
+  EXPECT_EQ(4, cache.GetSize());
+  EXPECT_TRUE(cache.Get(9).has_value());
+  EXPECT_FALSE(cache.Get(1).has_value());
+}
+
+UTEST(NWayLRU, TinyLfu) {
+  Cache cache(2, 10, {}, {}, cache::CachePolicy::kTinyLFU);
+  for (int i = 0; i < 10; ++i) {
+    cache.Put(i, i);
+    for (int j = 0; j < 3; ++j) EXPECT_EQ(i, cache.Get(i));
+  }
+
+  for (int i = 10; i < 100; ++i) cache.Put(i, i);
+  EXPECT_EQ(20, cache.GetSize());
+  for (int i = 0; i < 10; ++i) EXPECT_EQ(i, cache.Get(i));
+}
+
 USERVER_NAMESPACE_END
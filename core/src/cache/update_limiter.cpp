@@ -0,0 +1,105 @@
+#include <cache/update_limiter.hpp>
+
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <userver/engine/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+UpdateLimiter::Slot::Slot(UpdateLimiter& limiter, Group* group) noexcept
+    : limiter_(&limiter), group_(group) {}
+
+UpdateLimiter::Slot::Slot(Slot&& other) noexcept
+    : limiter_(std::exchange(other.limiter_, nullptr)), group_(other.group_) {}
+
+UpdateLimiter::Slot::~Slot() {
+  if (limiter_) limiter_->Release(group_);
+}
+
+UpdateLimiter::UpdateLimiter(
+    std::size_t max_concurrent_updates,
+    const std::unordered_map<std::string, std::size_t>& group_limits)
+    : max_concurrent_updates_(max_concurrent_updates) {
+  for (const auto& [name, limit] : group_limits) {
+    UINVARIANT(limit > 0, "Group limit must be positive");
+    groups_.try_emplace(name, limit);
+  }
+}
+
+UpdateLimiter::Group* UpdateLimiter::FindGroup(
+    const std::optional<std::string>& name) {
+  if (!name) return nullptr;
+
+  const auto it = groups_.find(*name);
+  if (it == groups_.end()) {
+    throw std::runtime_error(
+        fmt::format("Cache update group '{}' is not configured", *name));
+  }
+  return &it->second;
+}
+
+UpdateLimiter::Slot UpdateLimiter::Acquire(Group* group,
+                                           TimePoint last_update) {
+  std::unique_lock lock(mutex_);
+  const auto waiter_it =
+      waiters_.insert(Waiter{last_update, next_ticket_++, group}).first;
+  const utils::FastScopeGuard erase_guard([&]() noexcept {
+    waiters_.erase(waiter_it);
+    // a cancelled waiter may have been blocking the others
+    cv_.NotifyAll();
+  });
+
+  if (!cv_.Wait(lock, [&] { return IsTurnOf(*waiter_it); })) {
+    throw engine::WaitInterruptedException(
+        engine::current_task::CancellationReason());
+  }
+
+  ++active_updates_;
+  if (group) ++group->active_updates_;
+  return Slot{*this, group};
+}
+
+std::size_t UpdateLimiter::GetActiveUpdates() const {
+  std::lock_guard lock(mutex_);
+  return active_updates_;
+}
+
+bool UpdateLimiter::CanStart(const Group* group) const noexcept {
+  return !group || group->active_updates_ < group->max_concurrent_updates_;
+}
+
+bool UpdateLimiter::IsTurnOf(const Waiter& waiter) const noexcept {
+  if (max_concurrent_updates_ != 0 &&
+      active_updates_ >= max_concurrent_updates_) {
+    return false;
+  }
+
+  // The most outdated cache that is not blocked by its group goes first
+  for (const auto& other : waiters_) {
+    if (CanStart(other.group)) return other.ticket == waiter.ticket;
+  }
+  return false;
+}
+
+void UpdateLimiter::Release(Group* group) noexcept {
+  {
+    std::lock_guard lock(mutex_);
+    UASSERT(active_updates_ > 0);
+    --active_updates_;
+    if (group) --group->active_updates_;
+  }
+  cv_.NotifyAll();
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Limits the count of the concurrently running cache updates, globally and
+/// per user-defined groups of caches (e.g. caches of a single DB cluster).
+/// When a slot is released, the most outdated of the waiting caches starts.
+class UpdateLimiter final {
+ public:
+  using TimePoint = std::chrono::system_clock::time_point;
+
+  class Group final {
+   public:
+    explicit Group(std::size_t max_concurrent_updates)
+        : max_concurrent_updates_(max_concurrent_updates) {}
+
+   private:
+    friend class UpdateLimiter;
+
+    const std::size_t max_concurrent_updates_;
+    std::size_t active_updates_{0};
+  };
+
+  /// Allows the update to run while alive
+  class Slot final {
+   public:
+    Slot(Slot&& other) noexcept;
+    Slot& operator=(Slot&&) = delete;
+    ~Slot();
+
+   private:
+    friend class UpdateLimiter;
+
+    Slot(UpdateLimiter& limiter, Group* group) noexcept;
+
+    UpdateLimiter* limiter_;
+    Group* group_;
+  };
+
+  /// 0 means no limit
+  UpdateLimiter(
+      std::size_t max_concurrent_updates,
+      const std::unordered_map<std::string, std::size_t>& group_limits);
+
+  UpdateLimiter(UpdateLimiter&&) = delete;
+  UpdateLimiter& operator=(UpdateLimiter&&) = delete;
+
+  /// @returns nullptr for std::nullopt
+  /// @throws std::runtime_error if the group is not configured
+  Group* FindGroup(const std::optional<std::string>& name);
+
+  /// Waits for the free slot in the limiter and in the `group` (may be null).
+  /// Caches with the older `last_update` are let through first.
+  /// @throws engine::WaitInterruptedException on cancellation
+  [[nodiscard]] Slot Acquire(Group* group, TimePoint last_update);
+
+  std::size_t GetActiveUpdates() const;
+
+ private:
+  struct Waiter final {
+    TimePoint last_update;
+    std::uint64_t ticket;
+    const Group* group;
+
+    bool operator<(const Waiter& other) const noexcept {
+      return std::tie(last_update, ticket) <
+             std::tie(other.last_update, other.ticket);
+    }
+  };
+
+  bool CanStart(const Group* group) const noexcept;
+
+  bool IsTurnOf(const Waiter& waiter) const noexcept;
+
+  void Release(Group* group) noexcept;
+
+  const std::size_t max_concurrent_updates_;
+  std::unordered_map<std::string, Group> groups_;
+
+  mutable engine::Mutex mutex_;
+  engine::ConditionVariable cv_;
+  std::set<Waiter> waiters_;
+  std::uint64_t next_ticket_{0};
+  std::size_t active_updates_{0};
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,104 @@
+#include <cache/update_limiter.hpp>
+
+#include <optional>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/exception.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using cache::impl::UpdateLimiter;
+
+const UpdateLimiter::TimePoint kNow{std::chrono::hours{1}};
+
+}  // namespace
+
+UTEST(CacheUpdateLimiter, GlobalLimit) {
+  UpdateLimiter limiter{2, {}};
+  std::optional<UpdateLimiter::Slot> first{limiter.Acquire(nullptr, kNow)};
+  const auto second = limiter.Acquire(nullptr, kNow);
+  EXPECT_EQ(limiter.GetActiveUpdates(), 2);
+
+  auto task = engine::AsyncNoSpan([&limiter] {
+    [[maybe_unused]] auto task_slot = limiter.Acquire(nullptr, kNow);
+  });
+  engine::Yield();
+  EXPECT_FALSE(task.IsFinished());
+
+  first.reset();
+  UEXPECT_NO_THROW(task.Get());
+  EXPECT_EQ(limiter.GetActiveUpdates(), 1);
+}
+
+UTEST(CacheUpdateLimiter, MostOutdatedFirst) {
+  UpdateLimiter limiter{1, {}};
+  std::optional<UpdateLimiter::Slot> slot{limiter.Acquire(nullptr, kNow)};
+
+  std::vector<int> order;
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (const int age : {2, 3, 1}) {
+    tasks.push_back(engine::AsyncNoSpan([&limiter, &order, age] {
+      [[maybe_unused]] auto task_slot =
+          limiter.Acquire(nullptr, kNow - std::chrono::minutes{age});
+      order.push_back(age);
+    }));
+    engine::Yield();
+  }
+
+  slot.reset();
+  for (auto& task : tasks) task.Get();
+  EXPECT_EQ(order, (std::vector<int>{3, 2, 1}));
+}
+
+UTEST(CacheUpdateLimiter, Groups) {
+  UpdateLimiter limiter{0, {{"db", 1}}};
+  auto* group = limiter.FindGroup("db");
+  ASSERT_NE(group, nullptr);
+  EXPECT_EQ(limiter.FindGroup(std::nullopt), nullptr);
+  EXPECT_THROW(limiter.FindGroup("unknown"), std::runtime_error);
+
+  std::optional<UpdateLimiter::Slot> slot{limiter.Acquire(group, kNow)};
+
+  // the most outdated cache is blocked by its group, so it lets others through
+  auto task = engine::AsyncNoSpan([&limiter, group] {
+    [[maybe_unused]] auto task_slot =
+        limiter.Acquire(group, kNow - std::chrono::minutes{1});
+  });
+  engine::Yield();
+  EXPECT_FALSE(task.IsFinished());
+  {
+    [[maybe_unused]] const auto other = limiter.Acquire(nullptr, kNow);
+    EXPECT_EQ(limiter.GetActiveUpdates(), 2);
+  }
+
+  slot.reset();
+  UEXPECT_NO_THROW(task.Get());
+}
+
+UTEST(CacheUpdateLimiter, Cancel) {
+  UpdateLimiter limiter{1, {}};
+  std::optional<UpdateLimiter::Slot> slot{limiter.Acquire(nullptr, kNow)};
+
+  auto cancelled = engine::AsyncNoSpan([&limiter] {
+    [[maybe_unused]] auto task_slot =
+        limiter.Acquire(nullptr, kNow - std::chrono::minutes{1});
+  });
+  auto waiting = engine::AsyncNoSpan([&limiter] {
+    [[maybe_unused]] auto task_slot = limiter.Acquire(nullptr, kNow);
+  });
+  engine::Yield();
+
+  cancelled.RequestCancel();
+  UEXPECT_THROW(cancelled.Get(), engine::WaitInterruptedException);
+
+  slot.reset();
+  UEXPECT_NO_THROW(waiting.Get());
+  EXPECT_EQ(limiter.GetActiveUpdates(), 0);
+}
+
+USERVER_NAMESPACE_END
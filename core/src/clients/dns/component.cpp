@@ -15,6 +15,7 @@ namespace clients::dns {
 namespace {
 
 constexpr std::string_view kDnsReplySource = "dns_reply_source";
+constexpr std::string_view kDnsName = "dns_name";
 
 ResolverConfig ParseResolverConfig(
     const components::ComponentConfig& component_config) {
@@ -42,6 +43,13 @@ ResolverConfig ParseResolverConfig(
   config.cache_failure_ttl =
       component_config["cache_failure_ttl"].As<std::chrono::milliseconds>(
           config.cache_failure_ttl);
+  config.prefetch_interval =
+      component_config["prefetch-interval"].As<std::chrono::milliseconds>(
+          config.prefetch_interval);
+  config.prefetch_min_hits = component_config["prefetch-min-hits"].As<size_t>(
+      config.prefetch_min_hits);
+  config.hot_names_count =
+      component_config["hot-names-count"].As<size_t>(config.hot_names_count);
   return config;
 }
 
@@ -57,6 +65,9 @@ Component::Component(const components::ComponentConfig& config,
       context.FindComponent<components::StatisticsStorage>().GetStorage();
   statistics_holder_ = storage.RegisterWriter(
       config.Name() + ".replies", [this](auto& writer) { Write(writer); });
+  hot_names_statistics_holder_ = storage.RegisterWriter(
+      config.Name() + ".hot-names",
+      [this](auto& writer) { WriteHotNames(writer); });
 }
 
 clients::dns::Resolver& Component::GetResolver() { return resolver_; }
@@ -74,6 +85,12 @@ void Component::Write(utils::statistics::Writer& writer) {
                          {kDnsReplySource, "network-failure"});
 }
 
+void Component::WriteHotNames(utils::statistics::Writer& writer) {
+  for (const auto& hot_name : GetResolver().GetHotNames()) {
+    writer.ValueWithLabels(hot_name.hits, {kDnsName, hot_name.name});
+  }
+}
+
 yaml_config::Schema Component::GetStaticConfigSchema() {
   return yaml_config::MergeSchemas<LoggableComponentBase>(R"(
 type: object
@@ -122,6 +139,18 @@ properties:
         type: string
         description: TTL for network failures caching
         defaultDescription: 5s
+    prefetch-interval:
+        type: string
+        description: interval of the hot names prefetch, 0 to disable
+        defaultDescription: 1s
+    prefetch-min-hits:
+        type: integer
+        description: cache hits per prefetch interval for a name to be prefetched
+        defaultDescription: 1
+    hot-names-count:
+        type: integer
+        description: number of the most requested names to report in statistics
+        defaultDescription: 10
 )");
 }
 
@@ -6,11 +6,25 @@ USERVER_NAMESPACE_BEGIN
 
 namespace clients::dns::impl {
 
+// RFC 8305 section 4: the address families are interleaved starting with
+// IPv6, so that a connection attempt to a broken family falls back to
+// the other one after a single address.
 void SortAddrs(AddrVector& addrs) {
-  std::stable_partition(
+  const auto first_v4 = std::stable_partition(
       addrs.begin(), addrs.end(), [](const engine::io::Sockaddr& addr) {
         return addr.Domain() == engine::io::AddrDomain::kInet6;
       });
+  if (first_v4 == addrs.begin() || first_v4 == addrs.end()) return;
+
+  AddrVector interleaved;
+  interleaved.reserve(addrs.size());
+  auto v6 = addrs.begin();
+  auto v4 = first_v4;
+  while (v6 != first_v4 || v4 != addrs.end()) {
+    if (v6 != first_v4) interleaved.push_back(*v6++);
+    if (v4 != addrs.end()) interleaved.push_back(*v4++);
+  }
+  addrs = std::move(interleaved);
 }
 
 }  // namespace clients::dns::impl
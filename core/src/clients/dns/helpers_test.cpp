@@ -0,0 +1,58 @@
+#include <clients/dns/helpers.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+engine::io::Sockaddr MakeAddr(const char* ip) {
+  engine::io::Sockaddr addr;
+  if (inet_pton(AF_INET6, ip, &addr.As<sockaddr_in6>()->sin6_addr) == 1) {
+    addr.Data()->sa_family = AF_INET6;
+  } else if (inet_pton(AF_INET, ip, &addr.As<sockaddr_in>()->sin_addr) == 1) {
+    addr.Data()->sa_family = AF_INET;
+  }
+  return addr;
+}
+
+std::vector<std::string> SortedAddrs(const std::vector<const char*>& ips) {
+  clients::dns::AddrVector addrs;
+  for (const auto* ip : ips) addrs.push_back(MakeAddr(ip));
+  clients::dns::impl::SortAddrs(addrs);
+
+  std::vector<std::string> result;
+  for (const auto& addr : addrs) {
+    result.push_back(addr.PrimaryAddressString());
+  }
+  return result;
+}
+
+using Expected = std::vector<std::string>;
+
+}  // namespace
+
+TEST(DnsSortAddrs, SingleFamily) {
+  EXPECT_EQ(SortedAddrs({}), Expected{});
+  EXPECT_EQ(SortedAddrs({"1.1.1.1", "2.2.2.2"}),
+            (Expected{"1.1.1.1", "2.2.2.2"}));
+  EXPECT_EQ(SortedAddrs({"::2", "::1"}), (Expected{"::2", "::1"}));
+}
+
+TEST(DnsSortAddrs, Interleaved) {
+  EXPECT_EQ(SortedAddrs({"1.1.1.1", "::1"}), (Expected{"::1", "1.1.1.1"}));
+  EXPECT_EQ(SortedAddrs({"1.1.1.1", "2.2.2.2", "::1", "::2"}),
+            (Expected{"::1", "1.1.1.1", "::2", "2.2.2.2"}));
+  EXPECT_EQ(SortedAddrs({"1.1.1.1", "::1", "::2", "::3", "2.2.2.2"}),
+            (Expected{"::1", "1.1.1.1", "::2", "2.2.2.2", "::3"}));
+  EXPECT_EQ(SortedAddrs({"::1", "1.1.1.1", "2.2.2.2", "3.3.3.3"}),
+            (Expected{"::1", "1.1.1.1", "2.2.2.2", "3.3.3.3"}));
+}
+
+USERVER_NAMESPACE_END
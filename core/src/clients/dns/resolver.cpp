@@ -2,9 +2,12 @@
 
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <algorithm>
 #include <cctype>
 #include <chrono>
+#include <mutex>
 #include <string_view>
+#include <unordered_map>
 
 #include <clients/dns/file_resolver.hpp>
 #include <clients/dns/helpers.hpp>
@@ -13,11 +16,15 @@
 #include <userver/clients/dns/exception.hpp>
 #include <userver/concurrent/mutex_set.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/rcu/rcu.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/algo.hpp>
 #include <userver/utils/from_string.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
 #include <userver/utils/mock_now.hpp>
+#include <userver/utils/periodic_task.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -146,6 +153,9 @@ class Resolver::Impl {
   ~Impl();
 
   const LookupSourceCounters& GetLookupSourceCounters() const;
+  std::vector<HotName> GetHotNames() const;
+
+  void PrefetchHotNames();
 
   void ReloadHosts();
   void FlushNetworkCache();
@@ -171,6 +181,8 @@ class Resolver::Impl {
     AddrVector addrs;
     std::chrono::steady_clock::time_point expiration;
     bool is_failure{false};
+    // not reset on updates, see PrefetchHotNames
+    size_t hits{0};
   };
 
   template <typename Mutex>
@@ -193,6 +205,15 @@ class Resolver::Impl {
   cache::NWayLRU<std::string, NetCacheEntry> net_cache_;
   concurrent::MutexSet<std::string> net_cache_update_mutexes_;
   utils::impl::WaitTokenStorage wait_token_storage_;
+
+  const std::chrono::milliseconds prefetch_interval_;
+  const size_t prefetch_min_hits_;
+  const size_t hot_names_count_;
+  engine::Mutex prefetch_mutex_;
+  // hits of the previous prefetch round, guarded by prefetch_mutex_
+  std::unordered_map<std::string, size_t> prefetch_hits_;
+  rcu::Variable<std::vector<HotName>> hot_names_;
+  utils::PeriodicTask prefetch_task_;
 };
 
 Resolver::Impl::Impl(engine::TaskProcessor& fs_task_processor,
@@ -205,15 +226,31 @@ Resolver::Impl::Impl(engine::TaskProcessor& fs_task_processor,
       net_cache_max_reply_ttl_{config.cache_max_reply_ttl},
       net_cache_failure_ttl_{config.cache_failure_ttl},
       net_cache_{config.cache_ways, config.cache_size_per_way},
-      net_cache_update_mutexes_(config.cache_ways) {}
+      net_cache_update_mutexes_(config.cache_ways),
+      prefetch_interval_{config.prefetch_interval},
+      prefetch_min_hits_{config.prefetch_min_hits},
+      hot_names_count_{config.hot_names_count} {
+  if (prefetch_interval_.count() > 0) {
+    prefetch_task_.Start("dns-resolver-prefetch",
+                         utils::PeriodicTask::Settings{prefetch_interval_, {}},
+                         [this] { PrefetchHotNames(); });
+  }
+}
 
-Resolver::Impl::~Impl() { wait_token_storage_.WaitForAllTokens(); }
+Resolver::Impl::~Impl() {
+  prefetch_task_.Stop();
+  wait_token_storage_.WaitForAllTokens();
+}
 
 const Resolver::LookupSourceCounters& Resolver::Impl::GetLookupSourceCounters()
     const {
   return source_counters_;
 }
 
+std::vector<Resolver::HotName> Resolver::Impl::GetHotNames() const {
+  return hot_names_.ReadCopy();
+}
+
 void Resolver::Impl::ReloadHosts() { file_resolver_.ReloadHosts(); }
 
 void Resolver::Impl::FlushNetworkCache() { net_cache_.Invalidate(); }
@@ -234,8 +271,11 @@ Resolver::Impl::NetCacheResult Resolver::Impl::QueryNetCache(
     const std::string& name) {
   NetCacheResult result;
 
-  const auto now = utils::datetime::MockSteadyNow();
-  const auto cached = net_cache_.Get(name);
+  const auto now = utils::datetime::MockSteadyCoarseNow();
+  const auto cached = net_cache_.Get(name, [](NetCacheEntry& entry) {
+    ++entry.hits;
+    return true;
+  });
   if (!cached) return result;
 
   if (cached->is_failure) {
@@ -364,15 +404,66 @@ void Resolver::Impl::FinishNetUpdate(
   if (addrs) *addrs = response.addrs;
   if (effective_ttl.count() > 0) {
     LOG_TRACE() << "Updating cache for '" << name << '\'';
+    const auto prev_entry = net_cache_.Get(name);
     net_cache_.Put(
         name, NetCacheEntry{std::move(response.addrs),
-                            utils::datetime::MockSteadyNow() + effective_ttl});
+                            utils::datetime::MockSteadyNow() + effective_ttl,
+                            false, prev_entry ? prev_entry->hits : 0});
   } else {
     LOG_TRACE() << "Skipping cache update for '" << name << '\'';
   }
   ++source_counters_.network;
 }
 
+// Entries are refreshed in background before they expire so that the hot
+// names are never resolved in foreground. The entries that are going to enter
+// the update margin before the next round are refreshed right away.
+void Resolver::Impl::PrefetchHotNames() {
+  std::lock_guard prefetch_lock{prefetch_mutex_};
+  const auto now = utils::datetime::MockSteadyNow();
+  const auto horizon = net_cache_update_margin_ + prefetch_interval_;
+
+  std::unordered_map<std::string, size_t> hits;
+  std::vector<HotName> hot_names;
+  std::vector<std::string> expiring;
+  net_cache_.VisitAll([&](const std::string& name,
+                          const NetCacheEntry& entry) {
+    if (entry.is_failure) return;
+    hits.emplace(name, entry.hits);
+
+    const auto prev_hits =
+        utils::FindOrDefault(prefetch_hits_, name, size_t{0});
+    // the entry may have been evicted and cached again
+    const auto period_hits =
+        entry.hits >= prev_hits ? entry.hits - prev_hits : entry.hits;
+    if (period_hits == 0) return;
+
+    hot_names.push_back({name, period_hits});
+    if (period_hits >= prefetch_min_hits_ && entry.expiration - now < horizon) {
+      expiring.push_back(name);
+    }
+  });
+  prefetch_hits_ = std::move(hits);
+
+  const auto hotter = [](const HotName& lhs, const HotName& rhs) {
+    return lhs.hits > rhs.hits;
+  };
+  if (hot_names.size() > hot_names_count_) {
+    std::partial_sort(hot_names.begin(), hot_names.begin() + hot_names_count_,
+                      hot_names.end(), hotter);
+    hot_names.resize(hot_names_count_);
+  } else {
+    std::sort(hot_names.begin(), hot_names.end(), hotter);
+  }
+  hot_names_.Assign(std::move(hot_names));
+
+  for (const auto& name : expiring) {
+    auto mutex = GetUpdateMutex(name);
+    std::unique_lock lock{mutex, std::defer_lock};
+    StartBackgroundQuery(lock, std::move(mutex), name);
+  }
+}
+
 Resolver::Resolver(engine::TaskProcessor& fs_task_processor,
                    const ResolverConfig& config)
     : impl_(fs_task_processor, config) {}
@@ -447,6 +538,12 @@ const Resolver::LookupSourceCounters& Resolver::GetLookupSourceCounters()
   return impl_->GetLookupSourceCounters();
 }
 
+std::vector<Resolver::HotName> Resolver::GetHotNames() const {
+  return impl_->GetHotNames();
+}
+
+void Resolver::PrefetchHotNames() { impl_->PrefetchHotNames(); }
+
 void Resolver::ReloadHosts() { impl_->ReloadHosts(); }
 
 void Resolver::FlushNetworkCache() { impl_->FlushNetworkCache(); }
@@ -87,6 +87,8 @@ struct MockedResolver {
               config.cache_failure_ttl = std::chrono::seconds{cache_max_ttl},
               config.cache_ways = 1;
               config.cache_size_per_way = cache_size_per_way;
+              // prefetch rounds are started by the tests
+              config.prefetch_interval = std::chrono::milliseconds::zero();
               config.network_custom_servers = {server_mock.GetServerAddress()};
               return config;
             }()} {}
@@ -517,4 +519,47 @@ UTEST(Resolver, FirstUpdateCombines) {
   EXPECT_EQ(counters.network_failure, 1);
 }
 
+UTEST(Resolver, PrefetchHotNames) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  MockedResolver resolver{1000, 2};
+
+  utils::datetime::MockNowSet({});
+
+  resolver->Resolve("hot", test_deadline);
+  resolver->Resolve("hot", test_deadline);
+  resolver->Resolve("cold", test_deadline);
+
+  // both names are close to expiration, only the requested one is refreshed
+  utils::datetime::MockSleep(std::chrono::seconds{1000} -
+                             utest::kMaxTestWaitTime / 2);
+  resolver->PrefetchHotNames();
+
+  const auto hot_names = resolver->GetHotNames();
+  ASSERT_EQ(hot_names.size(), 1);
+  EXPECT_EQ(hot_names[0].name, "hot");
+  EXPECT_EQ(hot_names[0].hits, 1);
+
+  const auto& counters = resolver->GetLookupSourceCounters();
+  while (counters.network < 3 && !test_deadline.IsReached()) {
+    engine::SleepFor(std::chrono::milliseconds{1});
+  }
+
+  // the old entry has expired
+  utils::datetime::MockSleep(utest::kMaxTestWaitTime);
+  EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("hot", test_deadline),
+                      (Expected{kNetV6String, kNetV4String}));
+
+  EXPECT_EQ(counters.file, 0);
+  EXPECT_EQ(counters.cached, 2);
+  EXPECT_EQ(counters.cached_stale, 0);
+  EXPECT_EQ(counters.cached_failure, 0);
+  EXPECT_EQ(counters.network, 3);
+  EXPECT_EQ(counters.network_failure, 0);
+
+  resolver->PrefetchHotNames();
+  EXPECT_EQ(resolver->GetHotNames().size(), 1);
+}
+
 USERVER_NAMESPACE_END
@@ -2,24 +2,32 @@
 
 #include <chrono>
 #include <cstdlib>
+#include <functional>
 #include <limits>
+#include <stdexcept>
+#include <string_view>
 
+#include <fmt/format.h>
 #include <moodycamel/concurrentqueue.h>
 
 #include <userver/logging/log.hpp>
 #include <userver/utils/async.hpp>
 #include <userver/utils/rand.hpp>
+#include <userver/utils/trivial_map.hpp>
 #include <userver/utils/userver_info.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
 
 #include <clients/http/config.hpp>
 #include <clients/http/destination_statistics.hpp>
 #include <clients/http/easy_wrapper.hpp>
+#include <clients/http/endpoint_balancer.hpp>
 #include <clients/http/enforce_task_deadline_config.hpp>
 #include <clients/http/statistics.hpp>
 #include <clients/http/testsuite.hpp>
 #include <crypto/openssl.hpp>
 #include <curl-ev/multi.hpp>
 #include <curl-ev/ratelimit.hpp>
+#include <curl-ev/share.hpp>
 #include <engine/ev/thread_pool.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -30,6 +38,59 @@ namespace {
 const std::string kIoThreadName = "curl";
 const auto kEasyReinitPeriod = std::chrono::minutes{1};
 
+// A multi is not overloaded while it has less pending requests than this, or
+// less than this times the average ones
+constexpr std::uint64_t kAffinitySpilloverMinPending = 16;
+constexpr std::uint64_t kAffinitySpilloverLoadFactor = 2;
+
+// scheme://authority part of the URL, its requests may reuse connections
+std::string_view GetDestination(std::string_view url) {
+  const auto scheme_end = url.find("://");
+  const auto authority_begin =
+      scheme_end == std::string_view::npos ? 0 : scheme_end + 3;
+  return url.substr(0, url.find_first_of("/?#", authority_begin));
+}
+
+constexpr utils::TrivialBiMap kHttpVersionMap = [](auto selector) {
+  return selector()
+      .Case("default", HttpVersion::kDefault)
+      .Case("1.0", HttpVersion::k10)
+      .Case("1.1", HttpVersion::k11)
+      .Case("2", HttpVersion::k2)
+      .Case("2tls", HttpVersion::k2Tls)
+      .Case("2-prior-knowledge", HttpVersion::k2PriorKnowledge);
+};
+
+HttpVersion ParseHttpVersion(const yaml_config::YamlConfig& value) {
+  const auto name = value.As<std::string>("default");
+  const auto version = kHttpVersionMap.TryFindByFirst(name);
+  if (!version) {
+    throw std::runtime_error(
+        fmt::format("Unknown HTTP version '{}' at '{}', expected one of: {}",
+                    name, value.GetPath(), kHttpVersionMap.DescribeFirst()));
+  }
+  return *version;
+}
+
+constexpr utils::TrivialBiMap kLoadBalancingMap = [](auto selector) {
+  return selector()
+      .Case("none", LoadBalancing::kNone)
+      .Case("power-of-two-choices", LoadBalancing::kPowerOfTwoChoices)
+      .Case("least-outstanding-requests",
+            LoadBalancing::kLeastOutstandingRequests);
+};
+
+LoadBalancing ParseLoadBalancing(const yaml_config::YamlConfig& value) {
+  const auto name = value.As<std::string>("none");
+  const auto policy = kLoadBalancingMap.TryFindByFirst(name);
+  if (!policy) {
+    throw std::runtime_error(fmt::format(
+        "Unknown load balancing policy '{}' at '{}', expected one of: {}",
+        name, value.GetPath(), kLoadBalancingMap.DescribeFirst()));
+  }
+  return *policy;
+}
+
 // cURL accepts options as long, but we use size_t to avoid writing checks.
 // Clamp too high values to LONG_MAX, it shouldn't matter for these magnitudes.
 long ClampToLong(size_t value) {
@@ -45,6 +106,41 @@ ClientSettings Parse(const yaml_config::YamlConfig& value,
       value["thread-name-prefix"].As<std::string>(settings.thread_name_prefix);
   settings.io_threads = value["threads"].As<size_t>(settings.io_threads);
   settings.defer_events = value["defer-events"].As<bool>(settings.defer_events);
+  settings.destination_affinity = value["destination-affinity"].As<bool>(
+      settings.destination_affinity);
+  settings.share_tls_sessions =
+      value["share-tls-sessions"].As<bool>(settings.share_tls_sessions);
+  settings.share_dns_cache =
+      value["share-dns-cache"].As<bool>(settings.share_dns_cache);
+  settings.http_version = ParseHttpVersion(value["http-version"]);
+  settings.http2_max_concurrent_streams =
+      value["http2-max-concurrent-streams"].As<size_t>(
+          settings.http2_max_concurrent_streams);
+
+  const auto retry_budget = value["retry-budget"];
+  auto& budget = settings.retry_budget;
+  budget.enabled = retry_budget["enabled"].As<bool>(budget.enabled);
+  budget.max_tokens = retry_budget["max-tokens"].As<double>(budget.max_tokens);
+  budget.token_ratio =
+      retry_budget["token-ratio"].As<double>(budget.token_ratio);
+
+  const auto load_balancing = value["load-balancing"];
+  auto& balancing = settings.load_balancing;
+  balancing.policy = ParseLoadBalancing(load_balancing["policy"]);
+  balancing.consecutive_errors =
+      load_balancing["consecutive-errors"].As<size_t>(
+          balancing.consecutive_errors);
+  balancing.ejection_time =
+      load_balancing["ejection-time"].As<std::chrono::milliseconds>(
+          balancing.ejection_time);
+  balancing.max_ejection_percent =
+      load_balancing["max-ejection-percent"].As<size_t>(
+          balancing.max_ejection_percent);
+  if (balancing.max_ejection_percent > 100) {
+    throw std::runtime_error(fmt::format(
+        "'{}' should not be greater than 100",
+        load_balancing["max-ejection-percent"].GetPath()));
+  }
 
   return settings;
 }
@@ -53,9 +149,24 @@ Client::Client(ClientSettings settings,
                engine::TaskProcessor& fs_task_processor)
     : destination_statistics_(std::make_shared<DestinationStatistics>()),
       statistics_(settings.io_threads),
+      destination_affinity_(settings.destination_affinity),
+      http_version_(settings.http_version),
       fs_task_processor_(fs_task_processor),
       user_agent_(utils::GetUserverIdentifier()),
       connect_rate_limiter_(std::make_shared<curl::ConnectRateLimiter>()) {
+  destination_statistics_->SetRetryBudgetSettings(settings.retry_budget);
+
+  if (settings.share_tls_sessions || settings.share_dns_cache) {
+    share_ = std::make_shared<curl::share>();
+    share_->set_share_ssl_session(settings.share_tls_sessions);
+    share_->set_share_dns(settings.share_dns_cache);
+  }
+
+  if (settings.load_balancing.policy != LoadBalancing::kNone) {
+    endpoint_balancer_ =
+        std::make_unique<EndpointBalancer>(settings.load_balancing);
+  }
+
   const auto io_threads = settings.io_threads;
   const auto& thread_name_prefix = settings.thread_name_prefix;
 
@@ -81,6 +192,13 @@ Client::Client(ClientSettings settings,
     }
   }).Get();
 
+  if (settings.http2_max_concurrent_streams != 0) {
+    for (auto& multi : multis_) {
+      multi->SetMaxConcurrentStreams(
+          ClampToLong(settings.http2_max_concurrent_streams));
+    }
+  }
+
   easy_reinit_task_.Start(
       "http_easy_reinit",
       utils::PeriodicTask::Settings(kEasyReinitPeriod,
@@ -119,6 +237,7 @@ std::shared_ptr<Request> Client::CreateRequest() {
 
   auto easy = TryDequeueIdle();
   if (easy) {
+    if (share_) easy->set_share(share_);
     auto idx = FindMultiIndex(easy->GetMulti());
     auto wrapper = std::make_shared<impl::EasyWrapper>(std::move(easy), *this);
     request = std::make_shared<Request>(std::move(wrapper),
@@ -131,8 +250,10 @@ std::shared_ptr<Request> Client::CreateRequest() {
     try {
       request = engine::AsyncNoSpan(fs_task_processor_, [this, &multi, &i] {
                   // GetBound() calls blocking Curl_resolver_init()
+                  auto bound = easy_.Get()->GetBoundBlocking(*multi);
+                  if (share_) bound->set_share(share_);
                   auto wrapper = std::make_shared<impl::EasyWrapper>(
-                      easy_.Get()->GetBoundBlocking(*multi), *this);
+                      std::move(bound), *this);
                   return std::make_shared<Request>(
                       std::move(wrapper), statistics_[i].CreateRequestStats(),
                       destination_statistics_, resolver_);
@@ -151,6 +272,9 @@ std::shared_ptr<Request> Client::CreateRequest() {
   if (user_agent_) {
     request->user_agent(*user_agent_);
   }
+  if (http_version_ != HttpVersion::kDefault) {
+    request->http_version(http_version_);
+  }
 
   {
     // Even if proxy is an empty string we should set it, because empty proxy
@@ -200,9 +324,50 @@ InstanceStatistics Client::GetMultiStatistics(size_t n) const {
   s.multi.socket_open = multi_stats.open_socket_total();
   s.multi.current_load = multi_stats.get_busy_storage().GetCurrentLoad();
   s.multi.socket_ratelimit = multi_stats.socket_ratelimited_total();
+  s.multi.socket_ratelimit_queued = multi_stats.socket_ratelimit_queued_total();
+  s.multi.socket_ratelimit_rejected =
+      multi_stats.socket_ratelimit_rejected_total();
   return s;
 }
 
+size_t Client::SelectMultiIndex(std::string_view url) const {
+  const auto multis_count = multis_.size();
+  const auto hash = std::hash<std::string_view>{}(GetDestination(url));
+  const auto preferred = hash % multis_count;
+  if (multis_count == 1) return preferred;
+
+  const auto load = statistics_[preferred].GetPendingRequests();
+  if (load < kAffinitySpilloverMinPending) return preferred;
+  std::uint64_t total_load = 0;
+  for (const auto& stats : statistics_) {
+    total_load += stats.GetPendingRequests();
+  }
+  if (load * multis_count <= total_load * kAffinitySpilloverLoadFactor) {
+    return preferred;
+  }
+
+  // The spillover multi is also the same for the destination, so its
+  // requests reuse the connections too
+  const auto spillover =
+      (preferred + 1 + (hash / multis_count) % (multis_count - 1)) %
+      multis_count;
+  return statistics_[spillover].GetPendingRequests() < load ? spillover
+                                                             : preferred;
+}
+
+std::shared_ptr<RequestStats> Client::BindToDestination(curl::easy& easy) {
+  if (!destination_affinity_) return nullptr;
+
+  const auto idx = SelectMultiIndex(easy.get_original_url());
+  if (easy.GetMulti() == multis_[idx].get()) return nullptr;
+  easy.SetMulti(*multis_[idx]);
+  return statistics_[idx].CreateRequestStats();
+}
+
+EndpointBalancer* Client::GetEndpointBalancer() noexcept {
+  return endpoint_balancer_.get();
+}
+
 size_t Client::FindMultiIndex(const curl::multi* multi) const {
   for (size_t i = 0; i < multis_.size(); i++) {
     if (multis_[i].get() == multi) return i;
@@ -276,6 +441,9 @@ void Client::SetConfig(const Config& config) {
   connect_rate_limiter_->SetPerHostLimits(
       config.per_host_connect_throttle_limit,
       config.per_host_connect_throttle_rate);
+  connect_rate_limiter_->SetWaitLimits(
+      config.connect_throttle_max_wait,
+      config.connect_throttle_max_waiting_per_host);
 
   proxy_.Assign(config.proxy);
 }
@@ -177,6 +177,49 @@ struct EchoCallback {
   }
 };
 
+// Echoes the request body, waits for the last chunk of a chunked one
+struct StreamedEchoCallback {
+  HttpResponse operator()(const HttpRequest& request) const {
+    const auto headers_end = request.find("\r\n\r\n");
+    if (headers_end == std::string::npos) {
+      return {{}, HttpResponse::kTryReadMore};
+    }
+    const std::string_view headers{request.data(), headers_end};
+    std::string_view body{request};
+    body.remove_prefix(headers_end + 4);
+
+    std::string payload;
+    if (headers.find("Transfer-Encoding: chunked") == std::string::npos) {
+      const auto length_pos = headers.find("Content-Length: ");
+      EXPECT_NE(length_pos, std::string::npos) << request;
+      const auto length =
+          std::stoul(std::string{headers.substr(length_pos + 16)});
+      if (body.size() < length) return {{}, HttpResponse::kTryReadMore};
+      payload = body;
+    } else {
+      for (;;) {
+        const auto size_end = body.find("\r\n");
+        if (size_end == std::string::npos) {
+          return {{}, HttpResponse::kTryReadMore};
+        }
+        const auto size =
+            std::stoul(std::string{body.substr(0, size_end)}, nullptr, 16);
+        if (body.size() < size_end + 2 + size + 2) {
+          return {{}, HttpResponse::kTryReadMore};
+        }
+        if (size == 0) break;
+        payload += body.substr(size_end + 2, size);
+        body.remove_prefix(size_end + 2 + size + 2);
+      }
+    }
+
+    return {
+        "HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: " +
+            std::to_string(payload.size()) + "\r\n\r\n" + payload,
+        HttpResponse::kWriteAndClose};
+  }
+};
+
 struct ValidatingSharedCallback {
   const std::shared_ptr<std::string> method_name =
       std::make_shared<std::string>();
@@ -390,6 +433,14 @@ constexpr auto kTestHosts = R"(
 ::2 localhost
 )";
 
+engine::TaskProcessorConfig MakeFsTaskProcessorConfig() {
+  engine::TaskProcessorConfig config;
+  config.name = "fs-task-processor";
+  config.worker_threads = 1;
+  config.thread_name = "fs-worker";
+  return config;
+}
+
 struct ResolverWrapper {
   ResolverWrapper()
       : hosts_file{[] {
@@ -398,16 +449,7 @@ struct ResolverWrapper {
           return file;
         }()},
         fs_task_processor{
-            {
-                "fs-task-processor",
-                false,
-                1,
-                "fs-worker",
-                engine::OsScheduling::kNormal,
-                1000,
-                0,
-                "",
-            },
+            MakeFsTaskProcessorConfig(),
             engine::current_task::GetTaskProcessor().GetTaskProcessorPools()},
         resolver{fs_task_processor, [=] {
                    clients::dns::ResolverConfig config;
@@ -578,6 +620,98 @@ UTEST(HttpClient, PostEcho) {
   }
 }
 
+UTEST(HttpClient, SharedCaches) {
+  EchoCallback cb;
+  const utest::SimpleServer http_server{cb};
+
+  clients::http::ClientSettings settings;
+  settings.io_threads = 2;
+  settings.share_tls_sessions = true;
+  settings.share_dns_cache = true;
+  clients::http::Client http_client{settings,
+                                    engine::current_task::GetTaskProcessor()};
+
+  // The idle easy handles are attached to the share again
+  for (int i = 0; i < 4; ++i) {
+    const auto res = http_client.CreateRequest()
+                         ->post(http_server.GetBaseUrl(), kTestData)
+                         ->timeout(kTimeout)
+                         ->perform();
+    EXPECT_EQ(res->body(), kTestData);
+  }
+  EXPECT_EQ(*cb.responses_200, 4);
+}
+
+UTEST(HttpClient, DataStream) {
+  const utest::SimpleServer http_server{StreamedEchoCallback{}};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  /// [HTTP Client - data stream]
+  auto queue = concurrent::SpscQueue<std::string>::Create();
+  auto producer = queue->GetProducer();
+
+  auto future = http_client_ptr->CreateRequest()
+                    ->post(http_server.GetBaseUrl())
+                    ->data_stream(queue)
+                    ->timeout(utest::kMaxTestWaitTime)
+                    ->async_perform();
+
+  std::string expected;
+  for (int i = 0; i < 10; ++i) {
+    auto chunk = fmt::format("chunk {};", i);
+    expected += chunk;
+    ASSERT_TRUE(producer.Push(std::move(chunk)));
+    // The transfer is paused while there is no data
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+  // Releasing the producer ends the body
+  std::move(producer).Release();
+
+  const auto response = future.Get();
+  /// [HTTP Client - data stream]
+  EXPECT_EQ(response->status_code(), clients::http::Status::OK);
+  EXPECT_EQ(response->body(), expected);
+}
+
+UTEST(HttpClient, DataStreamWithSize) {
+  const utest::SimpleServer http_server{StreamedEchoCallback{}};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  auto queue = concurrent::SpscQueue<std::string>::Create();
+  auto producer = queue->GetProducer();
+  const std::string data(1024 * 1024, 'x');
+  auto future = http_client_ptr->CreateRequest()
+                    ->put(http_server.GetBaseUrl())
+                    ->data_stream(queue, data.size())
+                    ->timeout(utest::kMaxTestWaitTime)
+                    ->async_perform();
+
+  constexpr std::size_t kChunkSize = 64 * 1024;
+  for (std::size_t pos = 0; pos < data.size(); pos += kChunkSize) {
+    ASSERT_TRUE(producer.Push(data.substr(pos, kChunkSize)));
+    ASSERT_TRUE(producer.Push({}));
+  }
+  std::move(producer).Release();
+
+  EXPECT_EQ(future.Get()->body(), data);
+}
+
+UTEST(HttpClient, DataStreamEmpty) {
+  const utest::SimpleServer http_server{StreamedEchoCallback{}};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  auto queue = concurrent::SpscQueue<std::string>::Create();
+  auto producer = queue->GetProducer();
+  auto future = http_client_ptr->CreateRequest()
+                    ->post(http_server.GetBaseUrl())
+                    ->data_stream(queue)
+                    ->timeout(utest::kMaxTestWaitTime)
+                    ->async_perform();
+  std::move(producer).Release();
+
+  EXPECT_EQ(future.Get()->body(), "");
+}
+
 UTEST(HttpClient, StatsOnTimeout) {
   const int kRetries = 5;
   const utest::SimpleServer http_server{&sleep_callback};
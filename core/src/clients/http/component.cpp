@@ -4,7 +4,9 @@
 #include <userver/components/component.hpp>
 #include <userver/components/statistics_storage.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
+#include <userver/logging/log.hpp>
 #include <userver/testsuite/testsuite_support.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/statistics/metadata.hpp>
 
 #include <clients/http/config.hpp>
@@ -22,6 +24,8 @@ namespace {
 
 constexpr size_t kDestinationMetricsAutoMaxSizeDefault = 100;
 
+constexpr std::chrono::seconds kWarmupTimeout{5};
+
 }  // namespace
 
 HttpClient::HttpClient(const ComponentConfig& component_config,
@@ -87,9 +91,18 @@ HttpClient::HttpClient(const ComponentConfig& component_config,
       std::move(stats_name), [this](utils::statistics::Writer& writer) {
         return ExtendStatistics(writer);
       });
+
+  auto warmup_urls =
+      component_config["warmup-urls"].As<std::vector<std::string>>({});
+  if (!warmup_urls.empty()) {
+    warmup_task_ = utils::Async(
+        "http_client_warmup",
+        [this, urls = std::move(warmup_urls)] { WarmUp(urls); });
+  }
 }
 
 HttpClient::~HttpClient() {
+  if (warmup_task_.IsValid()) warmup_task_.SyncCancel();
   subscriber_scope_.Unsubscribe();
   statistics_holder_.Unregister();
 }
@@ -100,6 +113,26 @@ void HttpClient::OnConfigUpdate(const dynamic_config::Snapshot& config) {
   http_client_.SetConfig(config.Get<clients::http::Config>());
 }
 
+void HttpClient::WarmUp(const std::vector<std::string>& urls) {
+  std::vector<clients::http::ResponseFuture> responses;
+  responses.reserve(urls.size());
+  for (const auto& url : urls) {
+    responses.push_back(http_client_.CreateRequest()
+                            ->head(url)
+                            ->timeout(kWarmupTimeout)
+                            ->async_perform());
+  }
+
+  for (std::size_t i = 0; i < urls.size(); ++i) {
+    try {
+      responses[i].Get();
+    } catch (const std::exception& e) {
+      LOG_WARNING() << "Failed to warm up the connection to " << urls[i]
+                    << ": " << e;
+    }
+  }
+}
+
 void HttpClient::ExtendStatistics(utils::statistics::Writer& writer) {
   if (!disable_pool_stats_) {
     DumpMetric(writer, http_client_.GetPoolStatistics());
@@ -129,6 +162,86 @@ properties:
         type: boolean
         description: whether to defer events execution to a periodic timer; might affect timings a bit, might boost performance, use with care
         defaultDescription: false
+    destination-affinity:
+        type: boolean
+        description: whether to perform the requests to the same destination on the same thread to reuse the connections more often
+        defaultDescription: false
+    http-version:
+        type: string
+        description: HTTP version of the requests that do not set it explicitly
+        defaultDescription: default
+        enum:
+          - default
+          - '1.0'
+          - '1.1'
+          - '2'
+          - 2tls
+          - 2-prior-knowledge
+    share-tls-sessions:
+        type: boolean
+        description: whether to share the TLS sessions between the threads, so a handshake to an upstream made in one thread is resumed in the others
+        defaultDescription: false
+    share-dns-cache:
+        type: boolean
+        description: whether to share the libcurl DNS cache between the threads
+        defaultDescription: false
+    warmup-urls:
+        type: array
+        description: URLs to perform a HEAD request to at start in background to open the connections and to fill the TLS session cache
+        defaultDescription: '[]'
+        items:
+            type: string
+            description: URL
+    http2-max-concurrent-streams:
+        type: integer
+        description: max number of the HTTP/2 streams per connection, a new connection is opened to the upstream over the limit; 0 for the libcurl default
+        defaultDescription: 0
+        minimum: 0
+    retry-budget:
+        type: object
+        description: per destination limit of the retries and the hedged attempts
+        additionalProperties: false
+        properties:
+            enabled:
+                type: boolean
+                description: whether the retries are limited by the budget
+                defaultDescription: false
+            max-tokens:
+                type: number
+                description: max tokens of a destination, the retries are allowed while there are more than a half of them
+                defaultDescription: 100
+            token-ratio:
+                type: number
+                description: tokens that a successful attempt returns to the budget, a failed one takes a token
+                defaultDescription: 0.1
+    load-balancing:
+        type: object
+        description: balancing of the requests between the addresses of a host, requires the async dns resolver
+        additionalProperties: false
+        properties:
+            policy:
+                type: string
+                description: how to choose the address of a request
+                defaultDescription: none
+                enum:
+                  - none
+                  - power-of-two-choices
+                  - least-outstanding-requests
+            consecutive-errors:
+                type: integer
+                description: failed attempts in a row to eject the address
+                defaultDescription: 5
+                minimum: 1
+            ejection-time:
+                type: string
+                description: how long the ejected address gets no requests
+                defaultDescription: 30s
+            max-ejection-percent:
+                type: integer
+                description: max percent of the host addresses that are ejected at once
+                defaultDescription: 50
+                minimum: 0
+                maximum: 100
     fs-task-processor:
         type: string
         description: task processor to run blocking HTTP related calls, like DNS resolving or hosts reading
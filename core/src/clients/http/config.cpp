@@ -1,5 +1,6 @@
 #include <clients/http/config.hpp>
 
+#include <cstdint>
 #include <string_view>
 
 #include <userver/dynamic_config/value.hpp>
@@ -54,6 +55,11 @@ Config::Config(const dynamic_config::DocsMap& docs_map)
   ParseTokenBucketSettings(throttle_settings, per_host_connect_throttle_limit,
                            per_host_connect_throttle_rate, "per-host-limit",
                            "per-host-per-second");
+  connect_throttle_max_wait = std::chrono::milliseconds{
+      throttle_settings["max-wait-ms"].As<std::int64_t>(0)};
+  connect_throttle_max_waiting_per_host =
+      throttle_settings["max-waiting-per-host"].As<size_t>(
+          kDefaultMaxWaitingPerHost);
 }
 
 }  // namespace clients::http
@@ -13,6 +13,7 @@ namespace clients::http {
 struct Config {
   static constexpr size_t kNoLimit = -1UL;
   static constexpr size_t kDefaultConnectionPoolSize = 10000;
+  static constexpr size_t kDefaultMaxWaitingPerHost = 100;
 
   Config() = default;
   explicit Config(const dynamic_config::DocsMap& docs_map);
@@ -26,6 +27,9 @@ struct Config {
   std::chrono::microseconds https_connect_throttle_rate{0};
   size_t per_host_connect_throttle_limit{kNoLimit};
   std::chrono::microseconds per_host_connect_throttle_rate{0};
+  // The throttled connects wait for the tokens instead of failing
+  std::chrono::milliseconds connect_throttle_max_wait{0};
+  size_t connect_throttle_max_waiting_per_host{kDefaultMaxWaitingPerHost};
 
   std::string proxy;
 };
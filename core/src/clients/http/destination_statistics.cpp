@@ -31,7 +31,9 @@ DestinationStatistics::GetStatisticsForDestination(
 std::shared_ptr<RequestStats>
 DestinationStatistics::CreateStatisticsForDestination(
     const std::string& destination) {
-  return std::make_shared<RequestStats>(*rcu_map_[destination]);
+  auto stats = rcu_map_[destination];
+  stats->GetRetryBudget().SetSettings(retry_budget_settings_);
+  return std::make_shared<RequestStats>(*stats);
 }
 
 std::shared_ptr<RequestStats>
@@ -79,6 +81,19 @@ void DestinationStatistics::SetAutoMaxSize(size_t max_auto_destinations) {
   max_auto_destinations_ = max_auto_destinations;
 }
 
+void DestinationStatistics::SetRetryBudgetSettings(
+    const RetryBudgetSettings& settings) {
+  retry_budget_settings_ = settings;
+  for (const auto& [destination, stats] : rcu_map_) {
+    stats->GetRetryBudget().SetSettings(settings);
+  }
+}
+
+std::shared_ptr<const Statistics> DestinationStatistics::FindStatistics(
+    const std::string& destination) const {
+  return rcu_map_.Get(destination);
+}
+
 DestinationStatistics::DestinationsMap::ConstIterator
 DestinationStatistics::begin() const {
   return rcu_map_.begin();
@@ -25,6 +25,13 @@ class DestinationStatistics final {
 
   void SetAutoMaxSize(size_t max_auto_destinations);
 
+  // Should be called before the requests are made
+  void SetRetryBudgetSettings(const RetryBudgetSettings& settings);
+
+  // Returns nullptr if there are no statistics for the destination
+  std::shared_ptr<const Statistics> FindStatistics(
+      const std::string& destination) const;
+
   using DestinationsMap = rcu::RcuMap<std::string, Statistics>;
 
   DestinationsMap::ConstIterator begin() const;
@@ -39,6 +46,7 @@ class DestinationStatistics final {
 
   rcu::RcuMap<std::string, Statistics> rcu_map_;
   size_t max_auto_destinations_{0};
+  RetryBudgetSettings retry_budget_settings_;
   std::atomic<size_t> current_auto_destinations_{0};
 };
 
@@ -17,6 +17,14 @@ EasyWrapper::~EasyWrapper() { client_.PushIdleEasy(std::move(easy_)); }
 
 curl::easy& EasyWrapper::Easy() { return *easy_; }
 
+std::shared_ptr<RequestStats> EasyWrapper::BindToDestination() {
+  return client_.BindToDestination(*easy_);
+}
+
+EndpointBalancer* EasyWrapper::GetEndpointBalancer() noexcept {
+  return client_.GetEndpointBalancer();
+}
+
 }  // namespace clients::http::impl
 
 USERVER_NAMESPACE_END
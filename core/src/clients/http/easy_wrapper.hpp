@@ -8,6 +8,8 @@ USERVER_NAMESPACE_BEGIN
 
 namespace clients::http {
 class Client;
+class RequestStats;
+class EndpointBalancer;
 }  // namespace clients::http
 
 namespace clients::http::impl {
@@ -25,6 +27,13 @@ class EasyWrapper final {
 
   curl::easy& Easy();
 
+  // Moves the easy to the multi of its URL destination if the client is
+  // configured so, returns the stats of the new multi or nullptr
+  std::shared_ptr<RequestStats> BindToDestination();
+
+  // nullptr if the client balances no addresses
+  EndpointBalancer* GetEndpointBalancer() noexcept;
+
  private:
   std::shared_ptr<curl::easy> easy_;
   Client& client_;
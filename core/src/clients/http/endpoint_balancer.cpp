@@ -0,0 +1,154 @@
+#include <clients/http/endpoint_balancer.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+namespace {
+
+// The weight of a new latency sample is 1/kLatencySmoothing
+constexpr std::int64_t kLatencySmoothing = 8;
+
+std::int64_t GetScore(const EndpointBalancer::EndpointState& state) {
+  const auto latency = state.latency_us.load(std::memory_order_relaxed);
+  return (state.outstanding.load(std::memory_order_relaxed) + 1) *
+         std::max<std::int64_t>(latency, 1);
+}
+
+}  // namespace
+
+EndpointBalancer::Lease::Lease(std::shared_ptr<EndpointState> state,
+                               const EndpointBalancer& balancer)
+    : state_(std::move(state)), balancer_(&balancer) {
+  ++state_->outstanding;
+}
+
+EndpointBalancer::Lease::Lease(Lease&& other) noexcept
+    : state_(std::move(other.state_)), balancer_(other.balancer_) {}
+
+EndpointBalancer::Lease& EndpointBalancer::Lease::operator=(
+    Lease&& other) noexcept {
+  if (this == &other) return *this;
+  if (state_) --state_->outstanding;
+  state_ = std::move(other.state_);
+  balancer_ = other.balancer_;
+  return *this;
+}
+
+EndpointBalancer::Lease::~Lease() {
+  if (state_) --state_->outstanding;
+}
+
+void EndpointBalancer::Lease::Release(bool ok,
+                                      std::chrono::microseconds latency,
+                                      Clock::time_point now) {
+  if (!state_) return;
+  balancer_->Account(*state_, ok, latency, now);
+  --state_->outstanding;
+  state_.reset();
+}
+
+EndpointBalancer::EndpointBalancer(const LoadBalancingSettings& settings)
+    : settings_(settings) {}
+
+EndpointBalancer::Lease EndpointBalancer::Select(
+    const std::string& host, std::vector<std::string>& addresses,
+    Clock::time_point now) {
+  if (!IsEnabled() || addresses.empty()) return {};
+
+  std::vector<std::shared_ptr<EndpointState>> states;
+  states.reserve(addresses.size());
+  for (const auto& address : addresses) {
+    states.push_back(endpoints_[host + '/' + address]);
+  }
+
+  const auto index = ChooseIndex(states, now);
+  UASSERT(index < addresses.size());
+  // The other addresses are left for the fallback of curl in their order
+  std::rotate(addresses.begin(), addresses.begin() + index,
+              addresses.begin() + index + 1);
+  return Lease{std::move(states[index]), *this};
+}
+
+std::size_t EndpointBalancer::ChooseIndex(
+    const std::vector<std::shared_ptr<EndpointState>>& states,
+    Clock::time_point now) const {
+  const auto now_rep = now.time_since_epoch().count();
+  std::vector<std::size_t> available;
+  available.reserve(states.size());
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    if (states[i]->ejected_until.load(std::memory_order_relaxed) <= now_rep) {
+      available.push_back(i);
+    }
+  }
+
+  // With too many addresses ejected the ejection is ignored, the rest of the
+  // addresses may not handle the whole load
+  const auto max_ejected =
+      states.size() * settings_.max_ejection_percent / 100;
+  if (states.size() - available.size() > max_ejected) {
+    available.resize(states.size());
+    for (std::size_t i = 0; i < states.size(); ++i) available[i] = i;
+  }
+
+  if (available.size() == 1) return available.front();
+
+  if (settings_.policy == LoadBalancing::kPowerOfTwoChoices) {
+    const auto first = utils::RandRange(available.size());
+    auto second = utils::RandRange(available.size() - 1);
+    if (second >= first) ++second;
+    const auto first_index = available[first];
+    const auto second_index = available[second];
+    return GetScore(*states[first_index]) <= GetScore(*states[second_index])
+               ? first_index
+               : second_index;
+  }
+
+  UASSERT(settings_.policy == LoadBalancing::kLeastOutstandingRequests);
+  // Starting from a random address not to choose the first one on ties
+  const auto offset = utils::RandRange(available.size());
+  auto best = available[offset];
+  auto best_outstanding = states[best]->outstanding.load();
+  for (std::size_t i = 1; i < available.size(); ++i) {
+    const auto index = available[(offset + i) % available.size()];
+    const auto outstanding = states[index]->outstanding.load();
+    if (outstanding < best_outstanding) {
+      best = index;
+      best_outstanding = outstanding;
+    }
+  }
+  return best;
+}
+
+void EndpointBalancer::Account(EndpointState& state, bool ok,
+                               std::chrono::microseconds latency,
+                               Clock::time_point now) const {
+  // Races of the concurrent updates only lose a sample
+  const auto old_latency = state.latency_us.load(std::memory_order_relaxed);
+  const auto sample = static_cast<std::int64_t>(latency.count());
+  const auto new_latency =
+      old_latency == 0
+          ? sample
+          : old_latency + (sample - old_latency) / kLatencySmoothing;
+  state.latency_us.store(new_latency, std::memory_order_relaxed);
+
+  if (ok) {
+    state.consecutive_errors = 0;
+    return;
+  }
+  if (++state.consecutive_errors >= settings_.consecutive_errors) {
+    state.consecutive_errors = 0;
+    state.ejected_until =
+        (now + settings_.ejection_time).time_since_epoch().count();
+  }
+}
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
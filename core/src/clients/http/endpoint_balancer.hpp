@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <userver/clients/http/load_balancing_settings.hpp>
+#include <userver/rcu/rcu_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+// Chooses the address of a host for the request, see LoadBalancingSettings
+class EndpointBalancer final {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct EndpointState {
+    std::atomic<std::int64_t> outstanding{0};
+    std::atomic<std::uint64_t> consecutive_errors{0};
+    std::atomic<std::int64_t> latency_us{0};
+    // Clock::time_point::rep, 0 if not ejected
+    std::atomic<Clock::rep> ejected_until{0};
+  };
+
+  // An in flight request to the chosen address
+  class Lease final {
+   public:
+    Lease() = default;
+    Lease(Lease&&) noexcept;
+    Lease& operator=(Lease&&) noexcept;
+    ~Lease();
+
+    bool IsValid() const noexcept { return !!state_; }
+
+    void Release(bool ok, std::chrono::microseconds latency,
+                 Clock::time_point now = Clock::now());
+
+   private:
+    friend class EndpointBalancer;
+    Lease(std::shared_ptr<EndpointState> state,
+          const EndpointBalancer& balancer);
+
+    std::shared_ptr<EndpointState> state_;
+    const EndpointBalancer* balancer_{nullptr};
+  };
+
+  explicit EndpointBalancer(const LoadBalancingSettings& settings);
+
+  bool IsEnabled() const noexcept {
+    return settings_.policy != LoadBalancing::kNone;
+  }
+
+  // Moves the chosen address of the `host` to the front of `addresses`.
+  // Returns an invalid lease if the balancing is disabled.
+  Lease Select(const std::string& host, std::vector<std::string>& addresses,
+               Clock::time_point now = Clock::now());
+
+ private:
+  std::size_t ChooseIndex(
+      const std::vector<std::shared_ptr<EndpointState>>& states,
+      Clock::time_point now) const;
+
+  void Account(EndpointState& state, bool ok,
+               std::chrono::microseconds latency, Clock::time_point now) const;
+
+  const LoadBalancingSettings settings_;
+  // "host/address"
+  rcu::RcuMap<std::string, EndpointState> endpoints_;
+};
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,131 @@
+#include <clients/http/endpoint_balancer.hpp>
+
+#include <algorithm>
+#include <set>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using clients::http::EndpointBalancer;
+using clients::http::LoadBalancing;
+
+constexpr std::chrono::milliseconds kEjectionTime{1000};
+const std::string kHost = "example.com:80";
+const std::vector<std::string> kAddresses{"10.0.0.1", "10.0.0.2",
+                                          "10.0.0.3"};
+
+clients::http::LoadBalancingSettings MakeSettings(LoadBalancing policy) {
+  clients::http::LoadBalancingSettings settings;
+  settings.policy = policy;
+  settings.consecutive_errors = 3;
+  settings.ejection_time = kEjectionTime;
+  settings.max_ejection_percent = 50;
+  return settings;
+}
+
+std::string SelectFront(EndpointBalancer& balancer,
+                        EndpointBalancer::Clock::time_point now,
+                        EndpointBalancer::Lease* lease = nullptr) {
+  auto addresses = kAddresses;
+  auto result = balancer.Select(kHost, addresses, now);
+  EXPECT_TRUE(result.IsValid());
+  EXPECT_EQ(addresses.size(), kAddresses.size());
+  if (lease) *lease = std::move(result);
+  return addresses.front();
+}
+
+}  // namespace
+
+UTEST(EndpointBalancer, Disabled) {
+  EndpointBalancer balancer{MakeSettings(LoadBalancing::kNone)};
+  auto addresses = kAddresses;
+  EXPECT_FALSE(balancer.Select(kHost, addresses).IsValid());
+  EXPECT_EQ(addresses, kAddresses);
+}
+
+UTEST(EndpointBalancer, LeastOutstandingRequests) {
+  EndpointBalancer balancer{
+      MakeSettings(LoadBalancing::kLeastOutstandingRequests)};
+  const auto now = EndpointBalancer::Clock::now();
+
+  std::vector<EndpointBalancer::Lease> leases(kAddresses.size());
+  std::vector<std::string> selected;
+  for (auto& lease : leases) {
+    selected.push_back(SelectFront(balancer, now, &lease));
+  }
+  const auto free_address = selected[1];
+  std::sort(selected.begin(), selected.end());
+  EXPECT_EQ(selected, kAddresses);
+
+  // The address of the finished request is the only one without requests
+  leases[1] = {};
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(SelectFront(balancer, now), free_address);
+  }
+}
+
+UTEST(EndpointBalancer, PowerOfTwoChoicesPrefersFast) {
+  EndpointBalancer balancer{MakeSettings(LoadBalancing::kPowerOfTwoChoices)};
+  const auto now = EndpointBalancer::Clock::now();
+
+  for (int i = 0; i < 100; ++i) {
+    EndpointBalancer::Lease lease;
+    const auto address = SelectFront(balancer, now, &lease);
+    lease.Release(true, address == "10.0.0.1" ? std::chrono::microseconds{100}
+                                               : std::chrono::seconds{1},
+                  now);
+  }
+
+  std::size_t fast = 0;
+  for (int i = 0; i < 100; ++i) {
+    if (SelectFront(balancer, now) == "10.0.0.1") ++fast;
+  }
+  // The fast address wins every choice it takes part in
+  EXPECT_GT(fast, 50);
+}
+
+UTEST(EndpointBalancer, OutlierEjection) {
+  EndpointBalancer balancer{
+      MakeSettings(LoadBalancing::kLeastOutstandingRequests)};
+  auto now = EndpointBalancer::Clock::now();
+
+  const std::string bad = "10.0.0.2";
+  for (int errors = 0; errors < 3;) {
+    EndpointBalancer::Lease lease;
+    const auto address = SelectFront(balancer, now, &lease);
+    const bool ok = address != bad;
+    if (!ok) ++errors;
+    lease.Release(ok, std::chrono::milliseconds{1}, now);
+  }
+
+  for (int i = 0; i < 100; ++i) EXPECT_NE(SelectFront(balancer, now), bad);
+
+  now += kEjectionTime;
+  bool selected = false;
+  for (int i = 0; i < 100 && !selected; ++i) {
+    selected = SelectFront(balancer, now) == bad;
+  }
+  EXPECT_TRUE(selected);
+}
+
+UTEST(EndpointBalancer, MaxEjectionPercent) {
+  EndpointBalancer balancer{
+      MakeSettings(LoadBalancing::kLeastOutstandingRequests)};
+  const auto now = EndpointBalancer::Clock::now();
+
+  // All the addresses fail, no more than one of three is ejected
+  for (int i = 0; i < 100; ++i) {
+    EndpointBalancer::Lease lease;
+    SelectFront(balancer, now, &lease);
+    lease.Release(false, std::chrono::milliseconds{1}, now);
+  }
+
+  std::set<std::string> selected;
+  for (int i = 0; i < 100; ++i) selected.insert(SelectFront(balancer, now));
+  EXPECT_EQ(selected.size(), kAddresses.size());
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,92 @@
+#include <userver/clients/http/hedged_request.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <vector>
+
+#include <userver/clients/http/error.hpp>
+#include <userver/clients/http/response_future.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/wait_any.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+namespace {
+
+constexpr int kLeastServerErrorCode = 500;
+
+std::optional<std::chrono::milliseconds> GetDelay(
+    const Request& request, const HedgingSettings& settings) {
+  if (settings.delay) return settings.delay;
+
+  const auto timings =
+      request.GetDestinationTimingsPercentile(settings.percentile);
+  if (!timings) return std::nullopt;
+  return std::max(*timings, settings.min_delay);
+}
+
+}  // namespace
+
+std::shared_ptr<Response> PerformHedged(
+    const std::function<std::shared_ptr<Request>()>& make_request,
+    const HedgingSettings& settings) {
+  UINVARIANT(settings.max_attempts > 0, "At least one attempt is required");
+
+  const auto first_request = make_request();
+  const auto delay = GetDelay(*first_request, settings);
+
+  std::vector<ResponseFuture> attempts;
+  attempts.reserve(settings.max_attempts);
+  attempts.push_back(first_request->async_perform());
+  std::size_t started = 1;
+
+  std::shared_ptr<Response> last_response;
+  std::exception_ptr last_exception;
+  while (!attempts.empty()) {
+    const bool may_hedge = delay && started < settings.max_attempts;
+    const auto ready = engine::WaitAnyUntil(
+        may_hedge ? engine::Deadline::FromDuration(*delay) : engine::Deadline{},
+        attempts);
+
+    if (!ready) {
+      if (engine::current_task::ShouldCancel()) {
+        throw CancelException("Hedged HTTP request was cancelled", {});
+      }
+      if (!may_hedge) continue;
+
+      if (first_request->IsRetryAllowedByBudget()) {
+        attempts.push_back(make_request()->async_perform());
+        ++started;
+      } else {
+        // Waiting for the attempts that are in flight
+        started = settings.max_attempts;
+      }
+      continue;
+    }
+
+    try {
+      auto response = attempts[*ready].Get();
+      if (static_cast<int>(response->status_code()) < kLeastServerErrorCode) {
+        // The destructors of the other attempts cancel them
+        return response;
+      }
+      last_response = std::move(response);
+      last_exception = nullptr;
+    } catch (const CancelException&) {
+      throw;
+    } catch (const std::exception&) {
+      last_exception = std::current_exception();
+    }
+    attempts.erase(attempts.begin() + *ready);
+  }
+
+  if (last_exception) std::rethrow_exception(last_exception);
+  return last_response;
+}
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
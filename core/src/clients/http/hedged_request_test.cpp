@@ -0,0 +1,91 @@
+#include <userver/clients/http/hedged_request.hpp>
+
+#include <atomic>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/http_client.hpp>
+#include <userver/utest/simple_server.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using HttpResponse = utest::SimpleServer::Response;
+using HttpRequest = utest::SimpleServer::Request;
+
+HttpResponse MakeResponse(int code) {
+  return {"HTTP/1.1 " + std::to_string(code) +
+              " OK\r\nConnection: close\r\nContent-Length: 0\r\n\r\n",
+          HttpResponse::kWriteAndClose};
+}
+
+}  // namespace
+
+UTEST(HttpClientHedged, BackupAttemptWins) {
+  std::atomic<int> requests{0};
+  const utest::SimpleServer http_server{[&requests](const HttpRequest&) {
+    if (requests++ == 0) {
+      engine::InterruptibleSleepFor(utest::kMaxTestWaitTime);
+    }
+    return MakeResponse(200);
+  }};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  clients::http::HedgingSettings settings;
+  settings.delay = std::chrono::milliseconds{10};
+  const auto response = clients::http::PerformHedged(
+      [&] {
+        return http_client_ptr->CreateRequest()
+            ->get(http_server.GetBaseUrl())
+            ->timeout(utest::kMaxTestWaitTime);
+      },
+      settings);
+
+  EXPECT_EQ(response->status_code(), clients::http::Status::OK);
+  EXPECT_EQ(requests, 2);
+}
+
+UTEST(HttpClientHedged, NoStatistics) {
+  std::atomic<int> requests{0};
+  const utest::SimpleServer http_server{[&requests](const HttpRequest&) {
+    ++requests;
+    engine::InterruptibleSleepFor(std::chrono::milliseconds{50});
+    return MakeResponse(200);
+  }};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  // The delay is taken from the destination timings, there are none yet
+  const auto response = clients::http::PerformHedged(
+      [&] {
+        return http_client_ptr->CreateRequest()
+            ->get(http_server.GetBaseUrl())
+            ->timeout(utest::kMaxTestWaitTime);
+      },
+      {});
+
+  EXPECT_EQ(response->status_code(), clients::http::Status::OK);
+  EXPECT_EQ(requests, 1);
+}
+
+UTEST(HttpClientHedged, ServerError) {
+  const utest::SimpleServer http_server{
+      [](const HttpRequest&) { return MakeResponse(500); }};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  clients::http::HedgingSettings settings;
+  settings.delay = utest::kMaxTestWaitTime;
+  const auto response = clients::http::PerformHedged(
+      [&] {
+        return http_client_ptr->CreateRequest()
+            ->get(http_server.GetBaseUrl())
+            ->timeout(utest::kMaxTestWaitTime);
+      },
+      settings);
+
+  EXPECT_EQ(response->status_code(),
+            clients::http::Status::InternalServerError);
+}
+
+USERVER_NAMESPACE_END
@@ -309,6 +309,7 @@ std::shared_ptr<Request> Request::unix_socket_path(const std::string& path) {
 }
 
 std::shared_ptr<Request> Request::data(std::string data) {
+  pimpl_->clear_data_stream();
   if (!data.empty())
     pimpl_->easy().add_header(kHeaderExpect, "",
                               curl::easy::EmptyHeaderAction::kDoNotSend);
@@ -317,12 +318,22 @@ std::shared_ptr<Request> Request::data(std::string data) {
 }
 
 std::shared_ptr<Request> Request::form(const Form& form) {
+  pimpl_->clear_data_stream();
   pimpl_->easy().set_http_post(form.GetNative());
   pimpl_->easy().add_header(kHeaderExpect, "",
                             curl::easy::EmptyHeaderAction::kDoNotSend);
   return shared_from_this();
 }
 
+std::shared_ptr<Request> Request::data_stream(
+    const std::shared_ptr<concurrent::SpscQueue<std::string>>& queue,
+    std::optional<std::size_t> size) {
+  pimpl_->data_stream(queue, size);
+  pimpl_->easy().add_header(kHeaderExpect, "",
+                            curl::easy::EmptyHeaderAction::kDoNotSend);
+  return shared_from_this();
+}
+
 std::shared_ptr<Request> Request::headers(const Headers& headers) {
   SetHeaders(pimpl_->easy(), headers);
   return shared_from_this();
@@ -461,6 +472,15 @@ std::shared_ptr<Request> Request::SetDestinationMetricName(
   return shared_from_this();
 }
 
+bool Request::IsRetryAllowedByBudget() const {
+  return pimpl_->IsRetryAllowedByBudget();
+}
+
+std::optional<std::chrono::milliseconds>
+Request::GetDestinationTimingsPercentile(double percent) const {
+  return pimpl_->GetDestinationTimingsPercentile(percent);
+}
+
 std::shared_ptr<Request> Request::SetTestsuiteConfig(
     const std::shared_ptr<const TestsuiteConfig>& config) {
   pimpl_->SetTestsuiteConfig(config);
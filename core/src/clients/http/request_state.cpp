@@ -1,7 +1,9 @@
 #include <clients/http/request_state.hpp>
 
 #include <algorithm>
+#include <charconv>
 #include <chrono>
+#include <cstring>
 #include <map>
 #include <string_view>
 
@@ -11,10 +13,11 @@
 #include <openssl/x509.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptor/map.hpp>
-#include <boost/range/adaptor/transformed.hpp>
 
 #include <curl-ev/error_code.hpp>
 #include <userver/clients/dns/resolver.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/server/request/task_inherited_data.hpp>
 #include <userver/utils/algo.hpp>
 #include <userver/utils/assert.hpp>
@@ -29,6 +32,32 @@ USERVER_NAMESPACE_BEGIN
 
 namespace clients::http {
 
+// The chunks are popped without blocking in the ev thread, the transfer is
+// paused while the queue is empty and a coroutine waits for the next chunk
+struct RequestState::UploadStream {
+  explicit UploadStream(Queue::Consumer&& consumer)
+      : consumer(std::move(consumer)) {}
+
+  // Wakes the waiting coroutine to let it finish
+  void Complete() {
+    completed = true;
+    data_wanted.Send();
+  }
+
+  Queue::Consumer consumer;
+  // The chunk being sent and the size of its sent part
+  std::string chunk;
+  std::size_t offset{0};
+  // Set by the coroutine before it unpauses the transfer
+  bool finished{false};
+  bool aborted{false};
+
+  std::atomic<bool> started{false};
+  std::atomic<bool> completed{false};
+  // Sent by the read function when the queue is empty
+  engine::SingleConsumerEvent data_wanted;
+};
+
 namespace {
 /// Default timeout
 constexpr auto kDefaultTimeout = std::chrono::milliseconds{100};
@@ -43,6 +72,8 @@ constexpr long kLeastBadHttpCodeForEB = 500;
 
 constexpr Status kFakeHttpErrorCode{599};
 
+constexpr std::size_t kMaxBodyReserveSize = 16 * 1024 * 1024;
+
 const std::string kTracingClientName = "external";
 
 const std::vector<std::string> ya_tracing_headers = {
@@ -87,6 +118,11 @@ bool IsSetCookie(std::string_view key) {
   return equal(key, USERVER_NAMESPACE::http::headers::kSetCookie);
 }
 
+bool IsContentLength(std::string_view key) {
+  utils::StrIcaseEqual equal;
+  return equal(key, USERVER_NAMESPACE::http::headers::kContentLength);
+}
+
 // Not a strict check, but OK for non-header line check
 bool IsHttpStatusLineStart(const char* ptr, size_t size) {
   return (size > 5 && memcmp(ptr, "HTTP/", 5) == 0);
@@ -229,6 +265,12 @@ void RequestState::client_key_cert(crypto::PrivateKey pkey,
 
 void RequestState::http_version(curl::easy::http_version_t version) {
   easy().set_http_version(version);
+  // A few multiplexed connections to an upstream instead of a connection per
+  // concurrent request
+  easy().set_pipewait(
+      version != curl::easy::http_version_t::http_version_none &&
+      version != curl::easy::http_version_t::http_version_1_0 &&
+      version != curl::easy::http_version_t::http_version_1_1);
 }
 
 void RequestState::set_timeout(long timeout_ms) {
@@ -261,6 +303,20 @@ void RequestState::Cancel() {
   easy().cancel();
 }
 
+bool RequestState::IsRetryAllowedByBudget() const {
+  if (dest_req_stats_) return dest_req_stats_->CanRetry();
+  const auto stats = dest_stats_->FindStatistics(destination_metric_name_);
+  return !stats || stats->GetRetryBudget().CanRetry();
+}
+
+std::optional<std::chrono::milliseconds>
+RequestState::GetDestinationTimingsPercentile(double percent) const {
+  if (dest_req_stats_) return dest_req_stats_->GetTimingsPercentile(percent);
+  const auto stats = dest_stats_->FindStatistics(destination_metric_name_);
+  if (!stats) return std::nullopt;
+  return stats->GetTimingsPercentile(percent);
+}
+
 void RequestState::SetDestinationMetricNameAuto(std::string destination) {
   destination_metric_name_ = std::move(destination);
 }
@@ -369,9 +425,18 @@ void RequestState::on_completed(std::shared_ptr<RequestState> holder,
   }
 
   holder->AccountResponse(err);
+  if (holder->upload_stream_) holder->upload_stream_->Complete();
   const auto sockets = easy.get_num_connects();
+  const auto http_version = easy.get_http_version();
+  // The connect time of the TLS is not reported for the reused connections
+  const bool tls_handshake =
+      sockets != 0 && easy.get_appconnect_time_usec() > 0;
   holder->WithRequestStats(
-      [sockets](RequestStats& stats) { stats.AccountOpenSockets(sockets); });
+      [sockets, http_version, tls_handshake](RequestStats& stats) {
+        stats.AccountOpenSockets(sockets);
+        stats.AccountHttpVersion(http_version);
+        if (tls_handshake) stats.AccountTlsHandshake();
+      });
 
   span.AddTag(tracing::kAttempts, holder->retry_.current);
   span.AddTag(tracing::kMaxAttempts, holder->retry_.retries);
@@ -444,7 +509,8 @@ void RequestState::on_retry(std::shared_ptr<RequestState> holder,
   bool not_need_retry =
       (!err && holder->easy().get_response_code() < kLeastBadHttpCodeForEB) ||
       (holder->retry_.current >= holder->retry_.retries) ||
-      (err && !holder->retry_.on_fails) || holder->is_cancelled_.load();
+      (err && !holder->retry_.on_fails) || holder->is_cancelled_.load() ||
+      !holder->IsRetryAllowedByBudget();
   if (not_need_retry) {
     // finish if don't need retry
     RequestState::on_completed(std::move(holder), err);
@@ -532,11 +598,23 @@ void RequestState::parse_header(char* ptr, size_t size) try {
   }
 
   std::string value(col_pos, end - col_pos);
+  if (IsContentLength(key) && !IsStreamBody()) ReserveBody(value);
   response_->headers().emplace(std::move(key), std::move(value));
 } catch (const std::exception& e) {
   LOG_ERROR() << "Failed to parse header: " << e.what();
 }
 
+void RequestState::ReserveBody(std::string_view content_length) {
+  std::size_t size = 0;
+  const auto* end = content_length.data() + content_length.size();
+  const auto [ptr, ec] = std::from_chars(content_length.data(), end, size);
+  if (ec != std::errc{} || ptr != end) return;
+
+  // The whole body is received without reallocations of the sink, the
+  // header is not trusted with too much memory
+  response_->sink_string().reserve(std::min(size, kMaxBodyReserveSize));
+}
+
 void RequestState::SetLoggedUrl(std::string url) { log_url_ = std::move(url); }
 
 engine::Future<std::shared_ptr<Response>> RequestState::async_perform() {
@@ -550,6 +628,7 @@ engine::Future<std::shared_ptr<Response>> RequestState::async_perform() {
   auto future = StartNewPromise();
   ApplyTestsuiteConfig();
   StartStats();
+  StartUploadStream();
 
   // if we need retries call with special callback
   if (retry_.retries <= 1) {
@@ -587,19 +666,129 @@ void RequestState::async_perform_stream(const std::shared_ptr<Queue>& queue) {
 
   ApplyTestsuiteConfig();
   StartStats();
+  StartUploadStream();
 
   perform_request([holder = shared_from_this()](std::error_code err) mutable {
     RequestState::on_completed(std::move(holder), err);
   });
 }
 
+void RequestState::PerformEasy(curl::easy::handler_type handler) {
+  easy().async_perform([holder = shared_from_this(),
+                        handler = std::move(handler)](
+                           std::error_code err) mutable {
+    if (holder->WaitConnectRateLimit(err, handler)) return;
+    handler(err);
+  });
+}
+
+bool RequestState::WaitConnectRateLimit(std::error_code err,
+                                        curl::easy::handler_type& handler) {
+  if (!err || !easy().rate_limit_error() || is_cancelled_) return false;
+
+  const auto time_left =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          effective_timeout_) -
+      std::chrono::microseconds{easy().get_total_time_usec()};
+  auto ticket = easy().wait_rate_limit(time_left);
+  if (!ticket) return false;
+
+  const auto delay =
+      std::chrono::ceil<std::chrono::milliseconds>(ticket->GetDelay());
+  connect_wait_ticket_.emplace(std::move(*ticket));
+  // The wait is a part of the attempt, the deadline does not move. Zero
+  // timeout means no timeout for libcurl.
+  effective_timeout_ = std::max(
+      std::chrono::duration_cast<std::chrono::milliseconds>(time_left - delay),
+      std::chrono::milliseconds{1});
+
+  retry_.timer.emplace(easy().GetThreadControl());
+  retry_.timer->SingleshotAsync(
+      delay, [holder = shared_from_this(),
+              handler = std::move(handler)](std::error_code err) mutable {
+        holder->connect_wait_ticket_.reset();
+        if (!err && holder->is_cancelled_) {
+          err = std::make_error_code(std::errc::operation_canceled);
+        }
+        if (err) {
+          handler(err);
+          return;
+        }
+        // The address is already resolved, so the easy is performed as is
+        holder->SetEasyTimeout(holder->effective_timeout_);
+        holder->PerformEasy(std::move(handler));
+      });
+  return true;
+}
+
+void RequestState::data_stream(const std::shared_ptr<Queue>& queue,
+                               std::optional<std::size_t> size) {
+  upload_stream_ = std::make_shared<UploadStream>(queue->GetConsumer());
+  std::optional<curl::native::curl_off_t> upload_size;
+  if (size) upload_size = static_cast<curl::native::curl_off_t>(*size);
+  easy().set_post_read_function(&RequestState::UploadReadFunction,
+                                upload_stream_.get(), upload_size);
+}
+
+void RequestState::StartUploadStream() {
+  if (!upload_stream_) return;
+  UINVARIANT(!upload_stream_->started.exchange(true),
+             "The streamed request body may be sent only once");
+  // The body is not stored, so it could not be sent again
+  retry_.retries = 1;
+
+  const auto deadline = engine::Deadline::FromDuration(effective_timeout_);
+  engine::CriticalAsyncNoSpan([upload = upload_stream_,
+                               weak_holder = weak_from_this(), deadline] {
+    while (upload->data_wanted.WaitForEventUntil(deadline)) {
+      if (upload->completed) return;
+
+      std::string chunk;
+      if (upload->consumer.Pop(chunk, deadline)) {
+        upload->chunk = std::move(chunk);
+        upload->offset = 0;
+      } else if (upload->consumer.Queue()->NoMoreProducers()) {
+        upload->finished = true;
+      } else {
+        upload->aborted = true;
+      }
+
+      const auto holder = weak_holder.lock();
+      if (!holder || upload->completed) return;
+      holder->easy().unpause();
+      if (upload->finished || upload->aborted) return;
+    }
+  }).Detach();
+}
+
+size_t RequestState::UploadReadFunction(void* ptr, size_t size, size_t nmemb,
+                                        void* userdata) {
+  auto& upload = *static_cast<UploadStream*>(userdata);
+  // An empty chunk would end the body
+  while (upload.offset == upload.chunk.size()) {
+    upload.chunk.clear();
+    upload.offset = 0;
+    if (!upload.consumer.PopNoblock(upload.chunk)) {
+      if (upload.aborted) return CURL_READFUNC_ABORT;
+      if (upload.finished) return 0;
+      upload.data_wanted.Send();
+      return CURL_READFUNC_PAUSE;
+    }
+  }
+
+  const auto actual_size =
+      std::min(size * nmemb, upload.chunk.size() - upload.offset);
+  std::memcpy(ptr, upload.chunk.data() + upload.offset, actual_size);
+  upload.offset += actual_size;
+  return actual_size;
+}
+
 void RequestState::perform_request(curl::easy::handler_type handler) {
   UASSERT_MSG(!cert_ || pkey_,
               "Setting certificate is useless without setting private key");
 
   UASSERT(response_);
   response_->sink_string().clear();
-  response_->body().clear();
 
   UpdateTimeoutFromDeadline();
   SetEasyTimeout(effective_timeout_);
@@ -623,7 +812,7 @@ void RequestState::perform_request(curl::easy::handler_type handler) {
                          handler = std::move(handler)]() mutable {
       try {
         ResolveTargetAddress(*resolver_);
-        easy().async_perform(std::move(handler));
+        PerformEasy(std::move(handler));
       } catch (const clients::dns::ResolverException& ex) {
         // TODO: should retry - TAXICOMMON-4932
         auto* buffered_data = std::get_if<FullBufferedData>(&data_);
@@ -638,7 +827,7 @@ void RequestState::perform_request(curl::easy::handler_type handler) {
       }
     }).Detach();
   } else {
-    easy().async_perform(std::move(handler));
+    PerformEasy(std::move(handler));
   }
 }
 
@@ -714,6 +903,12 @@ void RequestState::AccountResponse(std::error_code err) {
       std::chrono::duration_cast<std::chrono::microseconds>(
           easy().time_to_start());
 
+  if (balancer_lease_.IsValid()) {
+    const bool ok = !err && easy().get_response_code() < 500;
+    balancer_lease_.Release(
+        ok, std::chrono::microseconds{easy().get_total_time_usec()});
+  }
+
   WithRequestStats([&](RequestStats& stats) {
     stats.StoreTimeToStart(time_to_start);
     if (err)
@@ -831,6 +1026,8 @@ void RequestState::StartNewSpan() {
                    span.GetTraceId());
   SetTracingHeader(easy(), USERVER_NAMESPACE::http::headers::kXYaRequestId,
                    span.GetLink());
+  SetTracingHeader(easy(), USERVER_NAMESPACE::http::headers::kXYaSampled,
+                   span.IsSampled() ? "1" : "0");
 
   // effective url is not available yet
   span.AddTag(tracing::kHttpUrl,
@@ -841,6 +1038,9 @@ void RequestState::StartNewSpan() {
 }
 
 void RequestState::StartStats() {
+  // The multi is chosen when the URL is known
+  if (auto stats = easy_->BindToDestination()) stats_ = std::move(stats);
+
   if (!dest_req_stats_) {
     dest_req_stats_ =
         dest_stats_->GetStatisticsForDestinationAuto(destination_metric_name_);
@@ -868,12 +1068,22 @@ void RequestState::ResolveTargetAddress(clients::dns::Resolver& resolver) {
   }
 
   const auto addrs = resolver.Resolve(target.GetHostPtr().get(), deadline);
-  auto addr_strings =
-      addrs | boost::adaptors::transformed(
-                  [](const auto& addr) { return addr.PrimaryAddressString(); });
+  std::vector<std::string> addr_strings;
+  addr_strings.reserve(addrs.size());
+  for (const auto& addr : addrs) {
+    addr_strings.push_back(addr.PrimaryAddressString());
+  }
+
+  const std::string host = target.GetHostPtr().get();
+  const std::string port = target.GetPortPtr().get();
+  auto* balancer = easy_->GetEndpointBalancer();
+  if (balancer) {
+    // libcurl connects to the first address and falls back to the rest
+    balancer_lease_ =
+        balancer->Select(fmt::format("{}:{}", host, port), addr_strings);
+  }
 
-  easy().add_resolve(target.GetHostPtr().get(), target.GetPortPtr().get(),
-                     fmt::to_string(fmt::join(addr_strings, ",")));
+  easy().add_resolve(host, port, fmt::to_string(fmt::join(addr_strings, ",")));
 }
 
 }  // namespace clients::http
@@ -24,6 +24,7 @@
 
 #include <clients/http/destination_statistics.hpp>
 #include <clients/http/easy_wrapper.hpp>
+#include <clients/http/endpoint_balancer.hpp>
 #include <clients/http/enforce_task_deadline_config.hpp>
 #include <clients/http/testsuite.hpp>
 #include <crypto/helpers.hpp>
@@ -54,6 +55,12 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
   engine::Future<std::shared_ptr<Response>> async_perform();
   void async_perform_stream(const std::shared_ptr<Queue>& queue);
 
+  /// set the request body to be read from the queue as the transfer goes
+  void data_stream(const std::shared_ptr<Queue>& queue,
+                   std::optional<std::size_t> size);
+  /// forget the streamed request body, if any
+  void clear_data_stream() noexcept { upload_stream_.reset(); }
+
   /// set redirect flags
   void follow_redirects(bool follow);
   /// set verify flags
@@ -89,6 +96,12 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
   /// cancel request
   void Cancel();
 
+  /// whether the retry budget of the destination allows one more attempt
+  bool IsRetryAllowedByBudget() const;
+  /// recent timings of the destination, std::nullopt if there are none
+  std::optional<std::chrono::milliseconds> GetDestinationTimingsPercentile(
+      double percent) const;
+
   void SetDestinationMetricNameAuto(std::string destination);
 
   void SetDestinationMetricName(const std::string& destination);
@@ -127,10 +140,17 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
   /// parse one header
   void parse_header(char* ptr, size_t size);
   void ParseSingleCookie(const char* ptr, size_t size);
+  /// preallocate the body by the Content-Length header
+  void ReserveBody(std::string_view content_length);
   /// simply run perform_request if there is now errors from timer
   void on_retry_timer(std::error_code err);
   /// run curl async_request
   void perform_request(curl::easy::handler_type handler);
+  /// perform the easy, waiting for the connect rate limit if it is allowed
+  void PerformEasy(curl::easy::handler_type handler);
+  /// delay the attempt failed by the connect rate limit and perform it again
+  bool WaitConnectRateLimit(std::error_code err,
+                            curl::easy::handler_type& handler);
 
   void SetEasyTimeout(std::chrono::milliseconds timeout);
   void UpdateTimeoutFromDeadline();
@@ -140,6 +160,13 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
   static size_t StreamWriteFunction(char* ptr, size_t size, size_t nmemb,
                                     void* userdata);
 
+  struct UploadStream;
+  /// read function for the streamed request body, runs in the ev thread
+  static size_t UploadReadFunction(void* ptr, size_t size, size_t nmemb,
+                                   void* userdata);
+  /// start the coroutine that waits for the request body chunks
+  void StartUploadStream();
+
   uint64_t GetClientTimeoutMs() const;
   void UpdateClientTimeoutHeader(uint64_t client_timeout_ms);
 
@@ -207,6 +234,12 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
 
   clients::dns::Resolver* resolver_{nullptr};
   std::string proxy_url_;
+  // The request to the address chosen by the client balancer, if any
+  EndpointBalancer::Lease balancer_lease_;
+  // The attempt waiting for the connect rate limit
+  std::optional<curl::ConnectRateLimiter::WaitTicket> connect_wait_ticket_;
+  // The streamed request body, shared with the coroutine waiting for it
+  std::shared_ptr<UploadStream> upload_stream_;
 
   struct StreamData {
     StreamData(Queue::Producer&& queue_producer)
@@ -0,0 +1,60 @@
+#include <clients/http/retry_budget.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+namespace {
+
+constexpr double kScale = 1000;
+
+std::int64_t ToFixedPoint(double tokens) {
+  return static_cast<std::int64_t>(
+      std::llround(std::max(tokens, 0.0) * kScale));
+}
+
+}  // namespace
+
+void RetryBudget::SetSettings(const RetryBudgetSettings& settings) noexcept {
+  const auto max_tokens = ToFixedPoint(settings.max_tokens);
+  max_tokens_ = max_tokens;
+  token_ratio_ = ToFixedPoint(settings.token_ratio);
+  // A new budget is full, the old one is clamped to the new maximum
+  if (!enabled_.exchange(settings.enabled)) {
+    tokens_ = max_tokens;
+  } else {
+    Add(0);
+  }
+}
+
+void RetryBudget::AccountOk() noexcept {
+  if (!enabled_.load(std::memory_order_relaxed)) return;
+  Add(token_ratio_.load(std::memory_order_relaxed));
+}
+
+void RetryBudget::AccountFail() noexcept {
+  if (!enabled_.load(std::memory_order_relaxed)) return;
+  Add(-static_cast<std::int64_t>(kScale));
+}
+
+bool RetryBudget::CanRetry() const noexcept {
+  if (!enabled_.load(std::memory_order_relaxed)) return true;
+  return tokens_.load(std::memory_order_relaxed) * 2 >
+         max_tokens_.load(std::memory_order_relaxed);
+}
+
+void RetryBudget::Add(std::int64_t delta) noexcept {
+  const auto max_tokens = max_tokens_.load(std::memory_order_relaxed);
+  auto tokens = tokens_.load(std::memory_order_relaxed);
+  while (!tokens_.compare_exchange_weak(
+      tokens, std::clamp<std::int64_t>(tokens + delta, 0, max_tokens),
+      std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <userver/clients/http/retry_budget_settings.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+// Token bucket of the retries, see RetryBudgetSettings
+class RetryBudget final {
+ public:
+  RetryBudget() = default;
+
+  void SetSettings(const RetryBudgetSettings& settings) noexcept;
+
+  void AccountOk() noexcept;
+  void AccountFail() noexcept;
+
+  bool CanRetry() const noexcept;
+
+ private:
+  void Add(std::int64_t delta) noexcept;
+
+  std::atomic<bool> enabled_{false};
+  // in thousandths of a token
+  std::atomic<std::int64_t> max_tokens_{0};
+  std::atomic<std::int64_t> token_ratio_{0};
+  std::atomic<std::int64_t> tokens_{0};
+};
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
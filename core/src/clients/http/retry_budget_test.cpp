@@ -0,0 +1,70 @@
+#include <clients/http/retry_budget.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+clients::http::RetryBudgetSettings MakeSettings() {
+  clients::http::RetryBudgetSettings settings;
+  settings.enabled = true;
+  settings.max_tokens = 10;
+  settings.token_ratio = 0.5;
+  return settings;
+}
+
+}  // namespace
+
+TEST(RetryBudget, Disabled) {
+  clients::http::RetryBudget budget;
+  for (int i = 0; i < 1000; ++i) budget.AccountFail();
+  EXPECT_TRUE(budget.CanRetry());
+}
+
+TEST(RetryBudget, ExhaustedByFailures) {
+  clients::http::RetryBudget budget;
+  budget.SetSettings(MakeSettings());
+  EXPECT_TRUE(budget.CanRetry());
+
+  for (int i = 0; i < 4; ++i) budget.AccountFail();
+  EXPECT_TRUE(budget.CanRetry());
+  // 5 of 10 tokens left
+  budget.AccountFail();
+  EXPECT_FALSE(budget.CanRetry());
+
+  // Restored by the successful attempts
+  budget.AccountOk();
+  EXPECT_TRUE(budget.CanRetry());
+}
+
+TEST(RetryBudget, Clamped) {
+  clients::http::RetryBudget budget;
+  budget.SetSettings(MakeSettings());
+  for (int i = 0; i < 100; ++i) budget.AccountOk();
+  for (int i = 0; i < 5; ++i) budget.AccountFail();
+  EXPECT_FALSE(budget.CanRetry());
+
+  for (int i = 0; i < 100; ++i) budget.AccountFail();
+  budget.AccountOk();
+  budget.AccountOk();
+  EXPECT_FALSE(budget.CanRetry());
+}
+
+TEST(RetryBudget, SettingsUpdate) {
+  clients::http::RetryBudget budget;
+  auto settings = MakeSettings();
+  budget.SetSettings(settings);
+  for (int i = 0; i < 4; ++i) budget.AccountFail();
+
+  // 6 of 20 tokens
+  settings.max_tokens = 20;
+  budget.SetSettings(settings);
+  EXPECT_FALSE(budget.CanRetry());
+
+  settings.enabled = false;
+  budget.SetSettings(settings);
+  EXPECT_TRUE(budget.CanRetry());
+}
+
+USERVER_NAMESPACE_END
@@ -30,6 +30,11 @@ RequestStats::~RequestStats() { stats_.easy_handles_--; }
 void RequestStats::Start() { start_time_ = std::chrono::steady_clock::now(); }
 
 void RequestStats::FinishOk(int code, int attempts) noexcept {
+  if (code >= 500) {
+    stats_.retry_budget_.AccountFail();
+  } else {
+    stats_.retry_budget_.AccountOk();
+  }
   stats_.AccountError(Statistics::ErrorGroup::kOk);
   stats_.AccountStatus(code);
   if (attempts > 1) stats_.retries_ += attempts - 1;
@@ -37,11 +42,22 @@ void RequestStats::FinishOk(int code, int attempts) noexcept {
 }
 
 void RequestStats::FinishEc(std::error_code ec, int attempts) noexcept {
+  // e.g. the loser of the hedged requests, it says nothing about the upstream
+  if (ec != std::errc::operation_canceled) stats_.retry_budget_.AccountFail();
   stats_.AccountError(Statistics::ErrorCodeToGroup(ec));
   if (attempts > 1) stats_.retries_ += attempts - 1;
   StoreTiming();
 }
 
+bool RequestStats::CanRetry() const noexcept {
+  return stats_.retry_budget_.CanRetry();
+}
+
+std::optional<std::chrono::milliseconds> RequestStats::GetTimingsPercentile(
+    double percent) const {
+  return stats_.GetTimingsPercentile(percent);
+}
+
 void RequestStats::StoreTiming() noexcept {
   auto now = std::chrono::steady_clock::now();
   auto diff = now - start_time_;
@@ -59,8 +75,29 @@ void RequestStats::StoreTimeToStart(
 
 void RequestStats::AccountOpenSockets(size_t sockets) noexcept {
   stats_.socket_open_ += sockets;
+  if (sockets == 0) {
+    ++stats_.connections_reused_;
+  } else {
+    ++stats_.connections_new_;
+  }
 }
 
+void RequestStats::AccountHttpVersion(long version) noexcept {
+  switch (version) {
+    case curl::native::CURL_HTTP_VERSION_1_0:
+    case curl::native::CURL_HTTP_VERSION_1_1:
+      ++stats_.responses_http1_;
+      break;
+    case curl::native::CURL_HTTP_VERSION_2_0:
+      ++stats_.responses_http2_;
+      break;
+    default:
+      break;
+  }
+}
+
+void RequestStats::AccountTlsHandshake() noexcept { ++stats_.tls_handshakes_; }
+
 void RequestStats::AccountTimeoutUpdatedByDeadline() noexcept {
   ++stats_.timeout_updated_by_deadline_;
 }
@@ -131,6 +168,13 @@ void Statistics::AccountError(ErrorGroup error) {
 
 void Statistics::AccountStatus(int code) { reply_status_.Account(code); }
 
+std::optional<std::chrono::milliseconds> Statistics::GetTimingsPercentile(
+    double percent) const {
+  const auto timings = timings_percentile_.GetStatsForPeriod();
+  if (timings.Count() == 0) return std::nullopt;
+  return std::chrono::milliseconds{timings.GetPercentile(percent)};
+}
+
 void DumpMetric(utils::statistics::Writer& writer,
                 const InstanceStatistics& stats, FormatMode format_mode) {
   writer["timings"] = stats.timings_percentile;
@@ -147,6 +191,15 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["retries"] = stats.retries;
   writer["pending-requests"] = stats.easy_handles;
 
+  writer["connections"]["reused"] = stats.connections_reused;
+  writer["connections"]["new"] = stats.connections_new;
+  const auto connections = stats.connections_reused + stats.connections_new;
+  writer["connections"]["reuse-percent"] =
+      connections ? stats.connections_reused * 100 / connections : 0;
+  writer["connections"]["tls-handshakes"] = stats.tls_handshakes;
+  writer["responses-by-http-version"]["1"] = stats.responses_http1;
+  writer["responses-by-http-version"]["2"] = stats.responses_http2;
+
   writer["timeout-updated-by-deadline"] = stats.timeout_updated_by_deadline;
   writer["cancelled-by-deadline"] = stats.cancelled_by_deadline;
 
@@ -161,6 +214,10 @@ void DumpMetric(utils::statistics::Writer& writer,
     // it is very unjust to account active/closed sockets
     writer["sockets"]["close"] = stats.multi.socket_close;
     writer["sockets"]["throttled"] = stats.multi.socket_ratelimit;
+    // The throttled connects that wait for the tokens or fail right away
+    writer["sockets"]["throttled-queued"] = stats.multi.socket_ratelimit_queued;
+    writer["sockets"]["throttled-rejected"] =
+        stats.multi.socket_ratelimit_rejected;
     writer["sockets"]["active"] =
         stats.multi.socket_open - stats.multi.socket_close;
   }
@@ -184,6 +241,11 @@ InstanceStatistics::InstanceStatistics(const Statistics& other)
       last_time_to_start_us(other.last_time_to_start_us_.load()),
       timings_percentile(other.timings_percentile_.GetStatsForPeriod()),
       retries(other.retries_.load()),
+      connections_reused(other.connections_reused_.load()),
+      connections_new(other.connections_new_.load()),
+      responses_http1(other.responses_http1_.load()),
+      responses_http2(other.responses_http2_.load()),
+      tls_handshakes(other.tls_handshakes_.load()),
       timeout_updated_by_deadline(other.timeout_updated_by_deadline_.load()),
       cancelled_by_deadline(other.cancelled_by_deadline_.load()),
       reply_status(other.reply_status_) {
@@ -217,6 +279,11 @@ InstanceStatistics& InstanceStatistics::operator+=(
     error_count[i] += stat.error_count[i];
   }
   retries += stat.retries;
+  connections_reused += stat.connections_reused;
+  connections_new += stat.connections_new;
+  responses_http1 += stat.responses_http1;
+  responses_http2 += stat.responses_http2;
+  tls_handshakes += stat.tls_handshakes;
 
   timeout_updated_by_deadline += stat.timeout_updated_by_deadline;
   cancelled_by_deadline += stat.cancelled_by_deadline;
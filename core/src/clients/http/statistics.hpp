@@ -1,7 +1,10 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <system_error>
 #include <unordered_map>
 #include <vector>
 
@@ -11,6 +14,8 @@
 #include <userver/utils/statistics/writer.hpp>
 #include <utils/statistics/http_codes.hpp>
 
+#include <clients/http/retry_budget.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace clients::http {
@@ -26,9 +31,16 @@ class RequestStats final {
   void FinishOk(int code, int attempts) noexcept;
   void FinishEc(std::error_code ec, int attempts) noexcept;
 
+  bool CanRetry() const noexcept;
+  std::optional<std::chrono::milliseconds> GetTimingsPercentile(
+      double percent) const;
+
   void StoreTimeToStart(std::chrono::microseconds micro_seconds) noexcept;
 
   void AccountOpenSockets(size_t sockets) noexcept;
+  // CURLINFO_HTTP_VERSION of the response
+  void AccountHttpVersion(long version) noexcept;
+  void AccountTlsHandshake() noexcept;
 
   void AccountTimeoutUpdatedByDeadline() noexcept;
   void AccountCancelledByDeadline() noexcept;
@@ -44,12 +56,16 @@ struct MultiStats {
   uint64_t socket_open{0};
   uint64_t socket_close{0};
   uint64_t socket_ratelimit{0};
+  uint64_t socket_ratelimit_queued{0};
+  uint64_t socket_ratelimit_rejected{0};
   double current_load{0};
 
   MultiStats& operator+=(const MultiStats& other) {
     socket_open += other.socket_open;
     socket_close += other.socket_close;
     socket_ratelimit += other.socket_ratelimit;
+    socket_ratelimit_queued += other.socket_ratelimit_queued;
+    socket_ratelimit_rejected += other.socket_ratelimit_rejected;
     current_load += other.current_load;
     return *this;
   }
@@ -89,6 +105,17 @@ class Statistics {
 
   void AccountStatus(int);
 
+  std::uint64_t GetPendingRequests() const noexcept {
+    return easy_handles_.load(std::memory_order_relaxed);
+  }
+
+  // Returns std::nullopt if there were no requests recently
+  std::optional<std::chrono::milliseconds> GetTimingsPercentile(
+      double percent) const;
+
+  RetryBudget& GetRetryBudget() noexcept { return retry_budget_; }
+  const RetryBudget& GetRetryBudget() const noexcept { return retry_budget_; }
+
  private:
   std::atomic<uint64_t> easy_handles_{0};
   std::atomic<uint64_t> last_time_to_start_us_{0};
@@ -99,10 +126,16 @@ class Statistics {
       {0, 0, 0, 0, 0, 0, 0}};
   std::atomic_llong retries_{0};
   std::atomic_llong socket_open_{0};
+  std::atomic<std::uint64_t> connections_reused_{0};
+  std::atomic<std::uint64_t> connections_new_{0};
+  std::atomic<std::uint64_t> responses_http1_{0};
+  std::atomic<std::uint64_t> responses_http2_{0};
+  std::atomic<std::uint64_t> tls_handshakes_{0};
 
   std::atomic<std::uint64_t> timeout_updated_by_deadline_{0};
   std::atomic<std::uint64_t> cancelled_by_deadline_{0};
   utils::statistics::HttpCodes reply_status_;
+  RetryBudget retry_budget_;
 
   friend struct InstanceStatistics;
   friend class RequestStats;
@@ -127,6 +160,13 @@ struct InstanceStatistics {
   std::array<uint64_t, Statistics::kErrorGroupCount> error_count{
       {0, 0, 0, 0, 0, 0, 0}};
   uint64_t retries{0};
+  // attempts that have reused a connection or have opened a new one
+  std::uint64_t connections_reused{0};
+  std::uint64_t connections_new{0};
+  // responses by the negotiated HTTP version
+  std::uint64_t responses_http1{0};
+  std::uint64_t responses_http2{0};
+  std::uint64_t tls_handshakes{0};
 
   std::uint64_t timeout_updated_by_deadline{0};
   std::uint64_t cancelled_by_deadline{0};
@@ -105,6 +105,9 @@ components_manager:
       cache-size-per-way: 256
       cache-max-reply-ttl: 5m
       cache-failure-ttl: 5s
+      prefetch-interval: 1s
+      prefetch-min-hits: 1
+      hot-names-count: 10
 # /// [Sample dns client component config]
 # /// [Sample dynamic configs client component config]
 # yaml
@@ -201,6 +201,13 @@ components_manager:
         method: POST
         task_processor: monitor-task-processor
 # /// [Sample handler jemalloc component config]
+# /// [Sample handler cpu profiler component config]
+# yaml
+    handler-cpu-profiler:
+        path: /service/cpu-profiler/{command}
+        method: POST
+        task_processor: monitor-task-processor
+# /// [Sample handler cpu profiler component config]
 # /// [Sample handler dns client control component config]
 # yaml
     handler-dns-client-control:
@@ -51,6 +51,22 @@ const Manager& ComponentContext::GetManager() const {
 
 void ComponentContext::CancelComponentsLoad() { impl_->CancelComponentsLoad(); }
 
+void ComponentContext::LogLoadProfile() const { impl_->LogLoadProfile(); }
+
+bool ComponentContext::WaitLazyLoading(std::string_view name) const {
+  return impl_->WaitLazyLoading(name);
+}
+
+void ComponentContext::StartLazyLoading() { impl_->StartLazyLoading(); }
+
+void ComponentContext::OnLazyComponentLoaded(std::string_view name) {
+  impl_->OnLazyComponentLoaded(name);
+}
+
+void ComponentContext::OnLazyComponentLoadFailed(std::string_view name) {
+  impl_->OnLazyComponentLoadFailed(name);
+}
+
 bool ComponentContext::IsAnyComponentInFatalState() const {
   return impl_->IsAnyComponentInFatalState();
 }
@@ -139,6 +139,42 @@ void ComponentInfo::WaitStage(ComponentLifetimeStage stage,
     throw StageSwitchingCancelledException(method_name.append(" cancelled"));
 }
 
+void ComponentInfo::SetConstructionTimes(
+    std::chrono::steady_clock::time_point start,
+    std::chrono::steady_clock::time_point finish) {
+  std::lock_guard<engine::Mutex> lock(mutex_);
+  load_profile_ = ComponentLoadProfile{start, finish, blocked_};
+}
+
+void ComponentInfo::AddBlockedDuration(
+    std::chrono::steady_clock::duration duration) {
+  std::lock_guard<engine::Mutex> lock(mutex_);
+  blocked_ += duration;
+}
+
+std::optional<ComponentLoadProfile> ComponentInfo::GetLoadProfile() const {
+  std::lock_guard<engine::Mutex> lock(mutex_);
+  return load_profile_;
+}
+
+void ComponentInfo::StartLazyLoading() {
+  {
+    std::lock_guard<engine::Mutex> lock(mutex_);
+    if (lazy_loading_started_) return;
+    lazy_loading_started_ = true;
+  }
+  cv_.NotifyAll();
+}
+
+void ComponentInfo::WaitLazyLoadingStarted() const {
+  std::unique_lock<engine::Mutex> lock(mutex_);
+  auto ok = cv_.Wait(lock, [this]() {
+    return stage_switching_cancelled_ || lazy_loading_started_;
+  });
+  if (!ok || stage_switching_cancelled_)
+    throw ComponentsLoadCancelledException();
+}
+
 bool ComponentInfo::HasComponent() const {
   std::lock_guard<engine::Mutex> lock(mutex_);
   return !!component_;
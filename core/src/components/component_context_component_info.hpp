@@ -1,7 +1,9 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 
@@ -27,6 +29,13 @@ class StageSwitchingCancelledException : public std::runtime_error {
   explicit StageSwitchingCancelledException(const std::string& message);
 };
 
+struct ComponentLoadProfile final {
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point finish;
+  // Time spent waiting for the dependencies during the construction
+  std::chrono::steady_clock::duration blocked{};
+};
+
 class ComponentInfo final {
  public:
   explicit ComponentInfo(std::string name);
@@ -70,6 +79,16 @@ class ComponentInfo final {
   ComponentLifetimeStage GetStage() const;
   void WaitStage(ComponentLifetimeStage stage, std::string method_name) const;
 
+  void SetConstructionTimes(std::chrono::steady_clock::time_point start,
+                            std::chrono::steady_clock::time_point finish);
+  void AddBlockedDuration(std::chrono::steady_clock::duration duration);
+  // nullopt if the component has not been constructed
+  std::optional<ComponentLoadProfile> GetLoadProfile() const;
+
+  // Lets the construction of a `load-lazily` component proceed
+  void StartLazyLoading();
+  void WaitLazyLoadingStarted() const;
+
  private:
   bool HasComponent() const;
   std::unique_ptr<ComponentBase> ExtractComponent();
@@ -89,6 +108,9 @@ class ComponentInfo final {
   std::set<ComponentNameFromInfo> depends_on_it_;
   ComponentLifetimeStage stage_ = ComponentLifetimeStage::kNull;
   bool stage_switching_cancelled_{false};
+  bool lazy_loading_started_{false};
+  std::optional<ComponentLoadProfile> load_profile_;
+  std::chrono::steady_clock::duration blocked_{};
   std::atomic<bool> on_loading_cancelled_called_{false};
 };
 
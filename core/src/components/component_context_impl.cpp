@@ -15,6 +15,7 @@
 
 #include <components/component_context_component_info.hpp>
 #include <components/impl/component_name_from_info.hpp>
+#include <components/impl/startup_profile.hpp>
 #include <engine/task/task_context.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -116,7 +117,9 @@ impl::ComponentBase* ComponentContext::Impl::AddComponent(
     throw std::runtime_error("trying to add component " + std::string{name} +
                              " multiple times");
 
+  const auto start = std::chrono::steady_clock::now();
   component_info.SetComponent(factory(context));
+  component_info.SetConstructionTimes(start, std::chrono::steady_clock::now());
 
   return component_info.GetComponent();
 }
@@ -175,7 +178,11 @@ void ComponentContext::Impl::CancelComponentsLoad() {
 
 bool ComponentContext::Impl::IsAnyComponentInFatalState() const {
   for (const auto& [name, comp] : components_) {
-    switch (comp.GetComponent()->GetComponentHealth()) {
+    const auto* component = comp.GetComponent();
+    // not yet loaded lazy component
+    if (!component) continue;
+
+    switch (component->GetComponentHealth()) {
       case ComponentHealth::kFatal:
         LOG_ERROR() << "Component '" << name << "' is in kFatal state";
         return true;
@@ -333,7 +340,103 @@ impl::ComponentBase* ComponentContext::Impl::DoFindComponent(
   }
   SearchingComponentScope finder(*this, this_component_name);
 
-  return component_info.WaitAndGetComponent();
+  // A lazy component is loaded right away once something depends on it
+  component_info.StartLazyLoading();
+
+  const auto wait_start = std::chrono::steady_clock::now();
+  auto* result = component_info.WaitAndGetComponent();
+  components_.at(this_component_name)
+      .AddBlockedDuration(std::chrono::steady_clock::now() - wait_start);
+  return result;
+}
+
+void ComponentContext::Impl::LogLoadProfile() const {
+  impl::ComponentDurations own_durations;
+  impl::ComponentDurations blocked_durations;
+  const impl::ComponentInfo* last_loaded = nullptr;
+  std::optional<impl::ComponentLoadProfile> last_loaded_profile;
+
+  for (const auto& [name, component_info] : components_) {
+    const auto profile = component_info.GetLoadProfile();
+    if (!profile) continue;
+
+    const auto name_str = std::string{name.StringViewName()};
+    own_durations.emplace_back(
+        name_str, profile->finish - profile->start - profile->blocked);
+    blocked_durations.emplace_back(name_str, profile->blocked);
+
+    if (!last_loaded_profile || last_loaded_profile->finish < profile->finish) {
+      last_loaded = &component_info;
+      last_loaded_profile = profile;
+    }
+  }
+  if (!last_loaded) return;
+
+  impl::LogStartupProfile("Construction (own time)", std::move(own_durations));
+  impl::LogStartupProfile("Waiting for dependencies",
+                          std::move(blocked_durations));
+
+  // Every component on the path finished loading right before the component
+  // that depends on it could proceed
+  std::vector<std::string> critical_path;
+  while (last_loaded) {
+    const auto& profile = *last_loaded_profile;
+    critical_path.push_back(fmt::format(
+        "{} {}", last_loaded->Name().StringViewName(),
+        impl::FormatMilliseconds(profile.finish - profile.start -
+                                 profile.blocked)));
+
+    const impl::ComponentInfo* next = nullptr;
+    last_loaded->ForEachItDependsOn([&](impl::ComponentNameFromInfo name) {
+      const auto& dependency_info = components_.at(name);
+      const auto dependency_profile = dependency_info.GetLoadProfile();
+      if (!dependency_profile) return;
+      if (!next || last_loaded_profile->finish < dependency_profile->finish) {
+        next = &dependency_info;
+        last_loaded_profile = dependency_profile;
+      }
+    });
+    last_loaded = next;
+  }
+  std::reverse(critical_path.begin(), critical_path.end());
+  LOG_INFO() << "Components load critical path: "
+             << fmt::format("{}", fmt::join(critical_path, " -> "));
+}
+
+bool ComponentContext::Impl::WaitLazyLoading(std::string_view name) const {
+  components_.at(impl::ComponentNameFromInfo{name}).WaitLazyLoadingStarted();
+  return all_components_loaded_;
+}
+
+void ComponentContext::Impl::StartLazyLoading() {
+  all_components_loaded_ = true;
+  for (auto& component_item : components_) {
+    component_item.second.StartLazyLoading();
+  }
+}
+
+void ComponentContext::Impl::OnLazyComponentLoaded(std::string_view name) {
+  auto& component_info = components_.at(impl::ComponentNameFromInfo{name});
+  // params store references
+  const auto next_stage = impl::ComponentLifetimeStage::kRunning;
+  const std::string handler_name = "OnAllComponentsLoaded()";
+  ComponentLifetimeStageSwitchingParams params{
+      next_stage, &impl::ComponentInfo::OnAllComponentsLoaded, handler_name,
+      DependencyType::kNormal, false};
+  ProcessSingleComponentLifetimeStageSwitching(component_info.Name(),
+                                               component_info, params);
+}
+
+void ComponentContext::Impl::OnLazyComponentLoadFailed(
+    std::string_view name) {
+  if (!all_components_loaded_) {
+    // Some of the components are waiting for it to load
+    CancelComponentsLoad();
+    return;
+  }
+  // Wakes up the lazy components waiting for it
+  components_.at(impl::ComponentNameFromInfo{name})
+      .SetStageSwitchingCancelled(true);
 }
 
 void ComponentContext::Impl::AddDependency(impl::ComponentNameFromInfo name) {
@@ -55,6 +55,20 @@ struct ComponentContext::Impl {
 
   impl::ComponentBase* DoFindComponent(std::string_view name);
 
+  // Logs the construction and dependency waiting times of the components
+  // along with the longest dependency chain
+  void LogLoadProfile() const;
+
+  // Returns true if the component was not requested by any other component
+  // before all the components were loaded
+  bool WaitLazyLoading(std::string_view name) const;
+
+  void StartLazyLoading();
+
+  void OnLazyComponentLoaded(std::string_view name);
+
+  void OnLazyComponentLoadFailed(std::string_view name);
+
  private:
   class TaskToComponentMapScope final {
    public:
@@ -143,6 +157,7 @@ struct ComponentContext::Impl {
 
   ComponentMap components_;
   std::atomic_flag components_load_cancelled_ ATOMIC_FLAG_INIT;
+  std::atomic<bool> all_components_loaded_{false};
 
   engine::ConditionVariable print_adding_components_cv_;
   concurrent::Variable<ProtectedData> shared_data_;
@@ -21,6 +21,12 @@ properties:
         type: boolean
         description: set to `false` to disable loading of the component
         defaultDescription: true
+    load-lazily:
+        type: boolean
+        description: |
+            set to `true` to construct the component after all the other
+            components are loaded, or once another component requests it
+        defaultDescription: false
 )");
 }
 
@@ -0,0 +1,48 @@
+#include <components/impl/startup_profile.hpp>
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include <userver/logging/log.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components::impl {
+
+namespace {
+
+constexpr std::size_t kProfileTopSize = 10;
+
+}  // namespace
+
+std::string FormatMilliseconds(std::chrono::steady_clock::duration duration) {
+  return fmt::format(
+      "{:.1f}ms",
+      std::chrono::duration<double, std::milli>{duration}.count());
+}
+
+void LogStartupProfile(std::string_view stage, ComponentDurations durations) {
+  std::chrono::steady_clock::duration total{};
+  for (const auto& [name, duration] : durations) total += duration;
+
+  const auto top_size = std::min(durations.size(), kProfileTopSize);
+  std::partial_sort(
+      durations.begin(), durations.begin() + top_size, durations.end(),
+      [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+
+  std::vector<std::string> top;
+  top.reserve(top_size);
+  for (std::size_t i = 0; i < top_size; ++i) {
+    top.push_back(fmt::format("{} {}", durations[i].first,
+                              FormatMilliseconds(durations[i].second)));
+  }
+
+  LOG_INFO() << stage << " of " << durations.size() << " components took "
+             << FormatMilliseconds(total)
+             << ", the slowest: " << fmt::format("{}", fmt::join(top, ", "));
+}
+
+}  // namespace components::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components::impl {
+
+using ComponentDurations =
+    std::vector<std::pair<std::string, std::chrono::steady_clock::duration>>;
+
+std::string FormatMilliseconds(std::chrono::steady_clock::duration duration);
+
+// Logs the total time and the slowest components
+void LogStartupProfile(std::string_view stage, ComponentDurations durations);
+
+}  // namespace components::impl
+
+USERVER_NAMESPACE_END
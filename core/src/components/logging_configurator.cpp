@@ -1,5 +1,6 @@
 #include <userver/components/logging_configurator.hpp>
 
+#include <logging/dynamic_debug.hpp>
 #include <tracing/no_log_spans.hpp>
 #include <userver/components/component.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
@@ -23,6 +24,20 @@ tracing::NoLogSpans ParseNoLogSpans(const dynamic_config::DocsMap& docs_map) {
 constexpr dynamic_config::Key<ParseNoLogSpans> kNoLogSpans{};
 /// [key]
 
+logging::LogRateLimit ParseLogRateLimit(
+    const dynamic_config::DocsMap& docs_map) {
+  const auto value = docs_map.Get("USERVER_LOG_RATE_LIMIT");
+  logging::LogRateLimit result;
+  result.enabled = value["enabled"].As<bool>();
+  result.max_messages_per_second =
+      value["max-messages-per-second"].As<std::size_t>(
+          result.max_messages_per_second);
+  result.max_burst = value["max-burst"].As<std::size_t>(result.max_burst);
+  return result;
+}
+
+constexpr dynamic_config::Key<ParseLogRateLimit> kLogRateLimit{};
+
 }  // namespace
 
 LoggingConfigurator::LoggingConfigurator(const ComponentConfig& config,
@@ -36,16 +51,27 @@ LoggingConfigurator::LoggingConfigurator(const ComponentConfig& config,
       context.FindComponent<components::DynamicConfig>()
           .GetSource()
           .UpdateAndListen(this, kName, &LoggingConfigurator::OnConfigUpdate);
+
+  suppressed_logs_task_.Start(
+      "log-rate-limit-summary",
+      {config["rate-limit-summary-period"].As<std::chrono::milliseconds>(
+           std::chrono::seconds{10}),
+       {},
+       logging::Level::kDebug},
+      [] { logging::LogSuppressedMessages(); });
 }
 
 LoggingConfigurator::~LoggingConfigurator() {
+  suppressed_logs_task_.Stop();
   config_subscription_.Unsubscribe();
+  logging::SetLogRateLimit({});
 }
 
 void LoggingConfigurator::OnConfigUpdate(
     const dynamic_config::Snapshot& config) {
-  (void)this;  // silence clang-tidy
   tracing::Tracer::SetNoLogSpans(tracing::NoLogSpans{config[kNoLogSpans]});
+
+  logging::SetLogRateLimit(config[kLogRateLimit]);
 }
 
 yaml_config::Schema LoggingConfigurator::GetStaticConfigSchema() {
@@ -60,6 +86,10 @@ properties:
     limited-logging-interval:
         type: string
         description: utils::StringToDuration suitable duration string to group repeated logs into one message
+    rate-limit-summary-period:
+        type: string
+        description: how often the counts of logs dropped by USERVER_LOG_RATE_LIMIT are written
+        defaultDescription: 10s
 )");
 }
 
@@ -1,11 +1,16 @@
 #include <userver/components/manager.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <future>
 #include <set>
 #include <stdexcept>
 #include <thread>
 #include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
 
 #include <userver/components/component_list.hpp>
 #include <userver/engine/async.hpp>
@@ -16,6 +21,7 @@
 #include <userver/utils/async.hpp>
 #include <utils/internal_tag.hpp>
 
+#include <components/impl/startup_profile.hpp>
 #include <engine/task/task_processor.hpp>
 #include <engine/task/task_processor_pools.hpp>
 #include "manager_config.hpp"
@@ -73,10 +79,19 @@ std::optional<size_t> GuessCpuLimit(const std::string& tp_name) {
   return {};
 }
 
+bool IsLoadedLazily(const components::ComponentConfigMap& component_config_map,
+                    const std::string& name) {
+  const auto it = component_config_map.find(name);
+  return it != component_config_map.end() &&
+         it->second["load-enabled"].As<bool>(true) &&
+         it->second["load-lazily"].As<bool>(false);
+}
+
 void ValidateConfigs(const components::ComponentList& component_list,
                      const components::ComponentConfigMap& component_config_map,
                      components::ValidationMode validation_condition) {
   std::vector<std::string> invalid_configs;
+  components::impl::ComponentDurations durations;
 
   for (const auto& adder : component_list) {
     const auto it = component_config_map.find(adder->GetComponentName());
@@ -84,6 +99,7 @@ void ValidateConfigs(const components::ComponentList& component_list,
         it != component_config_map.cend(),
         fmt::format("Component-config map does not have name of component '{}'",
                     adder->GetComponentName()));
+    const auto start = std::chrono::steady_clock::now();
     try {
       adder->ValidateStaticConfig(it->second, validation_condition);
     } catch (const std::exception& exception) {
@@ -92,7 +108,11 @@ void ValidateConfigs(const components::ComponentList& component_list,
                   << ": incorrect config: " << exception;
       invalid_configs.push_back(std::move(component_name));
     }
+    durations.emplace_back(adder->GetComponentName(),
+                           std::chrono::steady_clock::now() - start);
   }
+  components::impl::LogStartupProfile("Static config validation",
+                                      std::move(durations));
 
   if (!invalid_configs.empty()) {
     throw std::runtime_error(
@@ -287,7 +307,8 @@ components::ComponentConfigMap Manager::MakeComponentConfigMap(
 }
 
 void Manager::AddComponents(const ComponentList& component_list) {
-  const auto component_config_map = MakeComponentConfigMap(component_list);
+  component_config_map_ = MakeComponentConfigMap(component_list);
+  const auto& component_config_map = component_config_map_;
 
   auto start_time = std::chrono::steady_clock::now();
   std::vector<engine::TaskWithResult<void>> tasks;
@@ -297,6 +318,26 @@ void Manager::AddComponents(const ComponentList& component_list) {
                     config_->validate_components_configs);
 
     for (const auto& adder : component_list) {
+      if (IsLoadedLazily(component_config_map, adder->GetComponentName())) {
+        auto task_name = "lazy/" + adder->GetComponentName();
+        lazy_tasks_.push_back(
+            utils::CriticalAsync(std::move(task_name), [this, &adder]() {
+              try {
+                (*adder)(*this, component_config_map_);
+              } catch (const ComponentsLoadCancelledException& ex) {
+                LOG_INFO() << "Lazy loading of component "
+                           << adder->GetComponentName()
+                           << " cancelled: " << ex;
+              } catch (const std::exception& ex) {
+                LOG_ERROR() << "Cannot start component "
+                            << adder->GetComponentName() << ": " << ex;
+                component_context_.OnLazyComponentLoadFailed(
+                    adder->GetComponentName());
+              }
+            }));
+        continue;
+      }
+
       auto task_name = "boot/" + adder->GetComponentName();
       tasks.push_back(utils::CriticalAsync(std::move(task_name), [&]() {
         try {
@@ -358,6 +399,12 @@ void Manager::AddComponents(const ComponentList& component_list) {
       stop_time - start_time);
 
   LOG_INFO() << "All components loaded";
+  component_context_.LogLoadProfile();
+
+  if (!lazy_tasks_.empty()) {
+    LOG_INFO() << "Starting " << lazy_tasks_.size() << " lazy components";
+    component_context_.StartLazyLoading();
+  }
 }
 
 void Manager::AddComponentImpl(
@@ -378,7 +425,16 @@ void Manager::AddComponentImpl(
     return;
   }
 
+  bool is_deferred = false;
+  if (config_it->second["load-lazily"].As<bool>(false)) {
+    LOG_INFO() << "Component " << name
+               << " is loaded lazily, waiting for it to be requested or for "
+                  "all the other components to load";
+    is_deferred = component_context_.WaitLazyLoading(name);
+  }
+
   LOG_INFO() << "Starting component " << name;
+  const auto start = std::chrono::steady_clock::now();
 
   auto* component = component_context_.AddComponent(
       name, [&factory, &config = config_it->second](
@@ -388,7 +444,12 @@ void Manager::AddComponentImpl(
   if (auto* signal_processor =
           dynamic_cast<os_signals::ProcessorComponent*>(component))
     signal_processor_ = signal_processor;
-  LOG_INFO() << "Started component " << name;
+  // includes the time spent waiting for the dependencies
+  LOG_INFO() << "Started component " << name << " in "
+             << impl::FormatMilliseconds(std::chrono::steady_clock::now() -
+                                         start);
+
+  if (is_deferred) component_context_.OnLazyComponentLoaded(name);
 }
 
 void Manager::ClearComponents() noexcept {
@@ -396,6 +457,8 @@ void Manager::ClearComponents() noexcept {
     std::unique_lock<std::shared_timed_mutex> lock(context_mutex_);
     components_cleared_ = true;
   }
+  for (auto& task : lazy_tasks_) task.SyncCancel();
+  lazy_tasks_.clear();
   try {
     component_context_.ClearComponents();
   } catch (const std::exception& ex) {
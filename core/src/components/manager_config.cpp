@@ -1,5 +1,6 @@
 #include <components/manager_config.hpp>
 
+#include <chrono>
 #include <fstream>
 
 #include <userver/components/static_config_validator.hpp>
@@ -35,6 +36,7 @@ ManagerConfig ParseFromAny(
   static const std::string kManagerConfigField = "components_manager";
   static const std::string kUserverExperimentsField = "userver_experiments";
 
+  const auto start = std::chrono::steady_clock::now();
   formats::yaml::Value config_yaml;
   try {
     config_yaml = ParseYaml(source);
@@ -66,9 +68,16 @@ ManagerConfig ParseFromAny(
 
   utils::ParseUserverExperiments(config_yaml[kUserverExperimentsField]);
 
-  return yaml_config::YamlConfig(config_yaml[kManagerConfigField],
-                                 std::move(config_vars))
-      .As<ManagerConfig>();
+  auto config = yaml_config::YamlConfig(config_yaml[kManagerConfigField],
+                                        std::move(config_vars))
+                    .As<ManagerConfig>();
+
+  LOG_INFO() << "Parsed static config from '" << source_desc << "' in "
+             << std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count()
+             << "ms";
+  return config;
 }
 
 yaml_config::Schema GetManagerConfigSchema() {
@@ -92,6 +101,24 @@ properties:
                 type: integer
                 description: size of a single coroutine, bytes
                 defaultDescription: 256 * 1024
+            local_cache_size:
+                type: integer
+                description: |
+                    max amount of idle coroutines to keep in a per-thread
+                    cache in front of the shared pool, 0 disables the cache
+                defaultDescription: 32
+            lazy_stacks:
+                type: boolean
+                description: |
+                    map the stacks with MAP_NORESERVE and return the unused
+                    pages of idle stacks to the OS
+                defaultDescription: false
+            stack_usage_sample_rate:
+                type: integer
+                description: |
+                    measure the stack usage of one in N finished coroutines,
+                    0 disables the measurements
+                defaultDescription: 1000
     event_thread_pool:
         type: object
         description: event thread pool options
@@ -107,6 +134,38 @@ properties:
                 description: >
                     Whether to defer timer events to a per-thread periodic timer
                     or notify ev-loop right away
+            timer_wheel_slack:
+                type: string
+                description: |
+                    coalesce the task deadlines and sleeps within this slack
+                    in a per ev thread timer wheel instead of the libev timers,
+                    e.g. `1ms`; 0 disables the timer wheel
+                defaultDescription: 0
+            io_backend:
+                type: string
+                description: |
+                    backend for the socket readiness waits and the fs::
+                    file operations; io_uring requires Linux 5.7+ and falls
+                    back to libev if unavailable
+                defaultDescription: libev
+                enum:
+                  - libev
+                  - io_uring
+            affinity:
+                type: object
+                description: event threads CPU and NUMA node placement
+                additionalProperties: false
+                properties:
+                    cpus:
+                        type: string
+                        description: |
+                            CPUs to bind the threads to in the Linux cpulist
+                            format, e.g. `0-3,8`
+                        defaultDescription: all the CPUs of `numa-node`
+                    numa-node:
+                        type: integer
+                        description: |
+                            NUMA node to allocate the memory of threads on
     components:
         type: object
         description: 'dictionary of "component name": "options"'
@@ -142,6 +201,62 @@ properties:
                       - normal
                       - low-priority
                       - idle
+                task-processor-queue:
+                    type: string
+                    description: |
+                        Task queue mode for the task processor.
+                        `global-task-queue` makes all the workers share
+                        a queue per engine::TaskPriority class and dequeue
+                        the classes in a weighted round-robin.
+                        `work-stealing-task-queue` gives each worker a local
+                        queue and lets idle workers steal tasks from others,
+                        engine::TaskPriority is ignored in this mode.
+                    defaultDescription: global-task-queue
+                    enum:
+                      - global-task-queue
+                      - work-stealing-task-queue
+                affinity:
+                    type: object
+                    description: worker threads CPU and NUMA node placement
+                    additionalProperties: false
+                    properties:
+                        cpus:
+                            type: string
+                            description: |
+                                CPUs to bind the threads to in the Linux cpulist
+                                format, e.g. `0-3,8`
+                            defaultDescription: all the CPUs of `numa-node`
+                        numa-node:
+                            type: integer
+                            description: |
+                                NUMA node to allocate the memory of threads on
+                jemalloc:
+                    type: object
+                    description: jemalloc settings of the worker threads
+                    additionalProperties: false
+                    properties:
+                        dedicated-arena:
+                            type: boolean
+                            description: |
+                                allocate from an arena that is not shared with
+                                the threads of other task processors
+                            defaultDescription: false
+                        tcache:
+                            type: boolean
+                            description: use the jemalloc thread cache
+                            defaultDescription: true
+                        dirty-decay:
+                            type: string
+                            description: |
+                                time for the unused dirty pages of the
+                                dedicated arena to be purged, e.g. `10s`
+                            defaultDescription: jemalloc default
+                        muzzy-decay:
+                            type: string
+                            description: |
+                                time for the unused muzzy pages of the
+                                dedicated arena to be purged, e.g. `10s`
+                            defaultDescription: jemalloc default
                 task-trace:
                     type: object
                     description: .
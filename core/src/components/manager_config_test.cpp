@@ -29,6 +29,10 @@ components_manager:
       worker_threads: $bg_worker_threads
       worker_threads#fallback: 2
       os-scheduling: low-priority
+      jemalloc:
+        dedicated-arena: true
+        tcache: false
+        dirty-decay: 1s
     fs-task-processor:
       thread_name: fs-worker
       worker_threads: $fs_worker_threads
@@ -213,6 +217,23 @@ TEST(ManagerConfig, Basic) {
       [](const auto& conf) { return conf.Name() == "logging-configurator"; }));
 }
 
+TEST(ManagerConfig, JemallocConfig) {
+  const auto mc = MakeManagerConfig();
+
+  for (const auto& task_processor : mc.task_processors) {
+    const auto& jemalloc = task_processor.jemalloc;
+    if (task_processor.name == "bg-task-processor") {
+      EXPECT_TRUE(jemalloc.dedicated_arena);
+      EXPECT_FALSE(jemalloc.tcache);
+      EXPECT_EQ(jemalloc.dirty_decay, std::chrono::seconds{1});
+      EXPECT_FALSE(jemalloc.muzzy_decay);
+    } else {
+      EXPECT_FALSE(jemalloc.dedicated_arena) << task_processor.name;
+      EXPECT_TRUE(jemalloc.tcache) << task_processor.name;
+    }
+  }
+}
+
 TEST(ManagerConfig, HandlerConfig) {
   const auto mc = MakeManagerConfig();
 
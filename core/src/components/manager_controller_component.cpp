@@ -12,11 +12,32 @@
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/logging/component.hpp>
 #include <userver/utils/statistics/metadata.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <utils/jemalloc.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace {
 
+std::optional<formats::json::ValueBuilder> GetJemallocArenaStats(
+    unsigned arena) {
+  utils::jemalloc::ArenaStats stats;
+  if (utils::jemalloc::GetArenaStats(arena, stats)) return std::nullopt;
+
+  formats::json::ValueBuilder json_arena(formats::json::Type::kObject);
+  json_arena["allocated"] = stats.allocated;
+  json_arena["active"] = stats.active;
+  json_arena["resident"] = stats.resident;
+  json_arena["mapped"] = stats.mapped;
+  // share of the active pages that is not allocated
+  json_arena["fragmentation-percent"] =
+      stats.active
+          ? (stats.active - std::min(stats.allocated, stats.active)) * 100 /
+                stats.active
+          : 0;
+  return json_arena;
+}
+
 formats::json::ValueBuilder GetTaskProcessorStats(
     const engine::TaskProcessor& task_processor) {
   const auto& counter = task_processor.GetTaskCounter();
@@ -36,6 +57,7 @@ formats::json::ValueBuilder GetTaskProcessorStats(
   json_tasks["queued"] = queued;
   json_tasks["finished"] = created - current;
   json_tasks["cancelled"] = cancelled;
+  json_tasks["inline"] = counter.GetInlineTasks();
   json_task_processor["tasks"] = std::move(json_tasks);
 
   formats::json::ValueBuilder json_errors(formats::json::Type::kObject);
@@ -54,7 +76,14 @@ formats::json::ValueBuilder GetTaskProcessorStats(
 
   json_task_processor["context_switch"] = std::move(json_context_switch);
 
+  if (const auto arena = task_processor.GetJemallocArena()) {
+    if (auto json_arena = GetJemallocArenaStats(*arena)) {
+      json_task_processor["jemalloc-arena"] = std::move(*json_arena);
+    }
+  }
+
   json_task_processor["worker-threads"] = task_processor.GetWorkerCount();
+  json_task_processor["max-stack-usage"] = counter.GetMaxStackUsage();
 
   return json_task_processor;
 }
@@ -79,6 +108,11 @@ ManagerControllerComponent::ManagerControllerComponent(
       [this](const auto& request) { return ExtendStatistics(request); });
 
   auto& logger_component = context.FindComponent<components::Logging>();
+  logger_statistics_holder_ = storage.RegisterWriter(
+      "logger", [&logger_component](utils::statistics::Writer& writer) {
+        logger_component.WriteStatistics(writer);
+      });
+
   for (const auto& [name, task_processor] :
        components_manager_.GetTaskProcessorsMap()) {
     const auto& logger_name = task_processor->GetTaskTraceLoggerName();
@@ -90,6 +124,7 @@ ManagerControllerComponent::ManagerControllerComponent(
 }
 
 ManagerControllerComponent::~ManagerControllerComponent() {
+  logger_statistics_holder_.Unregister();
   statistics_holder_.Unregister();
   config_subscription_.Unsubscribe();
 }
@@ -115,15 +150,29 @@ formats::json::Value ManagerControllerComponent::ExtendStatistics(
   // ev-threads
   {
     formats::json::ValueBuilder json_ev_threads{formats::json::Type::kObject};
+    formats::json::ValueBuilder json_ev_loops{formats::json::Type::kObject};
 
     const auto& pools_ptr = components_manager_.GetTaskProcessorPools();
     auto& ev_thread_pool = pools_ptr->EventThreadPool();
     for (auto* thread : ev_thread_pool.NextThreads(ev_thread_pool.GetSize())) {
       json_ev_threads[thread->GetName()] = thread->GetCurrentLoadPercent();
+
+      const auto stats = thread->GetStatistics();
+      formats::json::ValueBuilder json_ev_loop{formats::json::Type::kObject};
+      json_ev_loop["wakeups"] = stats.wakeups;
+      json_ev_loop["self-wakeups"] = stats.self_wakeups;
+      json_ev_loop["payloads"] = stats.payloads;
+      json_ev_loop["payload-batches"] = stats.payload_batches;
+      json_ev_loop["iterations"] = stats.iterations;
+      json_ev_loop["iterations-time-us"] = stats.iterations_time.count();
+      json_ev_loops[thread->GetName()] = std::move(json_ev_loop);
     }
     utils::statistics::SolomonChildrenAreLabelValues(json_ev_threads,
                                                      "ev_thread_name");
+    utils::statistics::SolomonChildrenAreLabelValues(json_ev_loops,
+                                                     "ev_thread_name");
     engine_data["ev-threads"]["cpu-load-percent"] = std::move(json_ev_threads);
+    engine_data["ev-threads"]["loop"] = std::move(json_ev_loops);
   }
 
   // coroutines
@@ -137,9 +186,22 @@ formats::json::Value ManagerControllerComponent::ExtendStatistics(
     json_coro_stats["total"] = coro_stats.total_coroutines;
     json_coro_pool["coroutines"] = std::move(json_coro_stats);
 
+    formats::json::ValueBuilder json_local_cache_stats(
+        formats::json::Type::kObject);
+    json_local_cache_stats["cached"] = coro_stats.local_cached_coroutines;
+    json_local_cache_stats["hits"] = coro_stats.local_cache_hits;
+    json_local_cache_stats["misses"] = coro_stats.local_cache_misses;
+    json_coro_pool["local-cache"] = std::move(json_local_cache_stats);
+
     engine_data["coro-pool"] = std::move(json_coro_pool);
   }
 
+  // jemalloc, nothing if it is disabled
+  if (auto json_arenas =
+          GetJemallocArenaStats(utils::jemalloc::kAllArenas)) {
+    engine_data["jemalloc"] = std::move(*json_arenas);
+  }
+
   // misc
   engine_data["uptime-seconds"] =
       std::chrono::duration_cast<std::chrono::seconds>(
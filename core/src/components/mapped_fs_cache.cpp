@@ -0,0 +1,46 @@
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/mapped_fs_cache.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components {
+
+const MappedFsCache::Client& MappedFsCache::GetClient() const {
+  return client_;
+}
+
+MappedFsCache::MappedFsCache(const components::ComponentConfig& config,
+                             const components::ComponentContext& context)
+    : components::LoggableComponentBase(config, context),
+      client_(
+          config["dir"].As<std::string>("/var/www"),
+          config["max-files"].As<std::size_t>(1000),
+          context.GetTaskProcessor(config["fs-task-processor"].As<std::string>(
+              "fs-task-processor"))) {}
+
+yaml_config::Schema MappedFsCache::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<components::LoggableComponentBase>(R"(
+type: object
+description: component for serving files from the memory mapped page cache
+additionalProperties: false
+properties:
+    dir:
+        type: string
+        description: directory to serve files from
+        defaultDescription: /var/www
+    max-files:
+        type: integer
+        description: how many recently used files to keep open and mapped
+        defaultDescription: 1000
+    fs-task-processor:
+        type: string
+        description: task processor to do filesystem operations
+        defaultDescription: fs-task-processor
+)");
+}
+
+}  // namespace components
+
+USERVER_NAMESPACE_END
@@ -18,6 +18,13 @@ constexpr std::string_view kConfigVarsTemplate = R"(
   logger_file_path: '@null'
 )";
 
+void ReplaceFirst(std::string& str, std::string_view from,
+                  std::string_view to) {
+  const auto pos = str.find(from);
+  ASSERT_NE(pos, std::string::npos);
+  str.replace(pos, from.size(), to);
+}
+
 }  // namespace
 
 TEST_F(ComponentList, Minimal) {
@@ -37,4 +44,28 @@ TEST_F(ComponentList, Minimal) {
                       components::MinimalComponentList());
 }
 
+TEST_F(ComponentList, MinimalLazy) {
+  const auto temp_root = fs::blocking::TempDirectory::Create();
+  const std::string runtime_config_path =
+      temp_root.GetPath() + "/runtime_config.json";
+  const std::string config_vars_path =
+      temp_root.GetPath() + "/config_vars.json";
+  std::string static_config =
+      std::string{tests::kMinimalStaticConfig} + config_vars_path + '\n';
+
+  // Nothing depends on the `manager-controller`, while `statistics-storage`
+  // is requested by other components during the start
+  ReplaceFirst(static_config, "    manager-controller:  # Nothing\n",
+               "    manager-controller:\n      load-lazily: true\n");
+  ReplaceFirst(static_config, "    statistics-storage:\n      # Nothing\n",
+               "    statistics-storage:\n      load-lazily: true\n");
+
+  fs::blocking::RewriteFileContents(runtime_config_path, tests::kRuntimeConfig);
+  fs::blocking::RewriteFileContents(
+      config_vars_path, fmt::format(kConfigVarsTemplate, runtime_config_path));
+
+  components::RunOnce(components::InMemoryConfig{static_config},
+                      components::MinimalComponentList());
+}
+
 USERVER_NAMESPACE_END
@@ -1,14 +1,34 @@
 #include <userver/components/statistics_storage.hpp>
 
+#include <userver/components/component.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace components {
 
+namespace {
+
+utils::statistics::VisitSettings ParseVisitSettings(
+    const ComponentConfig& config) {
+  utils::statistics::VisitSettings settings;
+  settings.yield_between_writers = config["yield-between-writers"].As<bool>(
+      settings.yield_between_writers);
+  settings.writers_time_budget =
+      config["writers-time-budget"].As<std::chrono::milliseconds>(
+          std::chrono::milliseconds{0});
+  settings.report_writers_durations =
+      config["report-writers-durations"].As<bool>(
+          settings.report_writers_durations);
+  return settings;
+}
+
+}  // namespace
+
 StatisticsStorage::StatisticsStorage(const ComponentConfig& config,
                                      const ComponentContext& context)
     : LoggableComponentBase(config, context),
+      storage_(ParseVisitSettings(config)),
       metrics_storage_(std::make_shared<utils::statistics::MetricsStorage>()),
       metrics_storage_registration_(metrics_storage_->RegisterIn(storage_)) {}
 
@@ -27,7 +47,25 @@ yaml_config::Schema StatisticsStorage::GetStaticConfigSchema() {
 type: object
 description: Component that keeps a utils::statistics::Storage storage for metrics.
 additionalProperties: false
-properties: {}
+properties:
+    yield-between-writers:
+        type: boolean
+        description: |
+            yield the task after each metrics writer, so that a long metrics
+            dump does not occupy the task processor thread
+        defaultDescription: false
+    writers-time-budget:
+        type: string
+        description: |
+            skip the rest of the metrics writers once the writers of a single
+            metrics request took that much time, e.g. '50ms'
+        defaultDescription: 0 (no limit)
+    report-writers-durations:
+        type: boolean
+        description: |
+            write the 'statistics.writers' metrics with the time spent by the
+            writers of each prefix during the previous metrics request
+        defaultDescription: false
 )");
 }
 
@@ -9,6 +9,8 @@
 
 #include <netinet/tcp.h>
 
+#include <stdexcept>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace components {
@@ -23,6 +25,28 @@ std::string SocketsTaskProcessorName(const ComponentConfig& config,
       acceptor_config.task_processor);
 }
 
+std::vector<engine::io::Socket> CreateListenSockets(
+    const ListenerConfig& acceptor_config) {
+  const auto count = acceptor_config.shards.value_or(1);
+  if (count == 0) {
+    throw std::runtime_error("'shards' should be positive");
+  }
+  if (count > 1 && !acceptor_config.unix_socket_path.empty()) {
+    throw std::runtime_error(
+        "Only a single shard is supported for the 'unix-socket'");
+  }
+
+  std::vector<engine::io::Socket> sockets;
+  sockets.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    sockets.push_back(server::net::CreateSocket(acceptor_config));
+    if (acceptor_config.cpu_steering) {
+      server::net::SetupCpuSteering(sockets.back(), count);
+    }
+  }
+  return sockets;
+}
+
 }  // namespace
 
 TcpAcceptorBase::TcpAcceptorBase(const ComponentConfig& config,
@@ -62,6 +86,19 @@ properties:
       type: string
       description: task processor to process accepted sockets
       defaultDescription: value of `task_processor`
+  shards:
+      type: integer
+      description: |
+          how many listening SO_REUSEPORT sockets to open, each one with its
+          own accepting coroutine; only a single one is supported for
+          `unix-socket`
+      defaultDescription: 1
+  cpu_steering:
+      type: boolean
+      description: |
+          Linux only: pass each new connection to the socket number
+          `CPU % shards`, where `CPU` is the one that received the SYN
+      defaultDescription: false
 )");
 }
 
@@ -74,11 +111,11 @@ TcpAcceptorBase::TcpAcceptorBase(const ComponentConfig& config,
           context.GetTaskProcessor(acceptor_config.task_processor)),
       sockets_task_processor_(context.GetTaskProcessor(
           SocketsTaskProcessorName(config, acceptor_config))),
-      listen_sock_(server::net::CreateSocket(acceptor_config)) {}
+      listen_socks_(CreateListenSockets(acceptor_config)) {}
 
-void TcpAcceptorBase::KeepAccepting() {
+void TcpAcceptorBase::KeepAccepting(engine::io::Socket& listen_sock) {
   while (!engine::current_task::ShouldCancel()) {
-    engine::io::Socket sock = listen_sock_.Accept({});
+    engine::io::Socket sock = listen_sock.Accept({});
 
     tasks_.Detach(engine::AsyncNoSpan(
         sockets_task_processor_,
@@ -95,14 +132,18 @@ void TcpAcceptorBase::KeepAccepting() {
 void TcpAcceptorBase::OnAllComponentsLoaded() {
   // Start handling after the derived object was fully constructed
 
-  // NOLINTNEXTLINE(cppcoreguidelines-slicing)
-  acceptor_ = engine::AsyncNoSpan(acceptor_task_processor_,
-                                  &TcpAcceptorBase::KeepAccepting, this);
+  acceptors_.reserve(listen_socks_.size());
+  for (auto& listen_sock : listen_socks_) {
+    // NOLINTNEXTLINE(cppcoreguidelines-slicing)
+    acceptors_.push_back(engine::AsyncNoSpan(acceptor_task_processor_,
+                                             &TcpAcceptorBase::KeepAccepting,
+                                             this, std::ref(listen_sock)));
+  }
 }
 
 void TcpAcceptorBase::OnAllComponentsAreStopping() {
-  acceptor_ = {};  // Cancel and wait for finish
-  listen_sock_.Close();
+  acceptors_.clear();  // Cancel and wait for finish
+  for (auto& listen_sock : listen_socks_) listen_sock.Close();
   tasks_.CancelAndWait();
 }
 
@@ -0,0 +1,309 @@
+#include <userver/components/tcp_framed_server_base.hpp>
+
+#include <limits.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <userver/components/component.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+#include <userver/utils/statistics/relaxed_counter.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <components/tcp_framing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components {
+
+namespace {
+
+// Header, payload and trailer of each response
+constexpr std::size_t kIoDataPerFrame = 3;
+constexpr std::size_t kMaxFramesPerSend = IOV_MAX / kIoDataPerFrame;
+
+impl::FramingConfig ParseFramingConfig(const ComponentConfig& config) {
+  impl::FramingConfig result;
+
+  const auto framing = config["framing"].As<std::string>("length-prefixed");
+  if (framing == "length-prefixed") {
+    result.kind = impl::FramingKind::kLengthPrefixed;
+  } else if (framing == "delimiter") {
+    result.kind = impl::FramingKind::kDelimiter;
+  } else {
+    throw std::runtime_error("Unknown framing '" + framing + "' in " +
+                             config.Name());
+  }
+
+  result.delimiter = config["delimiter"].As<std::string>(result.delimiter);
+  result.max_frame_size =
+      config["max_frame_size"].As<std::size_t>(result.max_frame_size);
+  return result;
+}
+
+std::size_t ParsePositive(const ComponentConfig& config, std::string_view name,
+                          std::size_t default_value) {
+  const auto value = config[std::string{name}].As<std::size_t>(default_value);
+  if (value == 0) {
+    throw std::runtime_error("'" + std::string{name} + "' should be positive");
+  }
+  return value;
+}
+
+}  // namespace
+
+struct TcpFramedServerBase::Statistics final {
+  std::atomic<std::int64_t> connections_active{0};
+  utils::statistics::RelaxedCounter<std::uint64_t> connections_opened;
+  utils::statistics::RelaxedCounter<std::uint64_t> connections_rejected;
+  utils::statistics::RelaxedCounter<std::uint64_t> frames_received;
+  utils::statistics::RelaxedCounter<std::uint64_t> frames_sent;
+  utils::statistics::RelaxedCounter<std::uint64_t> bytes_received;
+  utils::statistics::RelaxedCounter<std::uint64_t> bytes_sent;
+  utils::statistics::RelaxedCounter<std::uint64_t> errors_frame_too_large;
+  utils::statistics::RelaxedCounter<std::uint64_t> errors_handler;
+};
+
+class TcpFramedServerBase::Connection final {
+ public:
+  Connection(TcpFramedServerBase& server, engine::io::Socket&& socket)
+      : server_(server),
+        socket_(std::move(socket)),
+        queue_(Queue::Create(server_.max_pipelined_requests_)) {}
+
+  void Process() {
+    auto reader =
+        engine::AsyncNoSpan([this, producer = queue_->GetProducer()] {
+          ReadFrames(producer);
+        });
+
+    try {
+      WriteResponses(queue_->GetConsumer());
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "Closing connection from " << socket_.Getpeername()
+                    << ": " << ex;
+    }
+
+    reader.SyncCancel();
+  }
+
+ private:
+  using Queue = concurrent::SpscQueue<engine::TaskWithResult<std::string>>;
+
+  struct Response final {
+    std::string payload;
+    char header[impl::FrameCodec::kMaxHeaderSize]{};
+    std::size_t header_size{0};
+  };
+
+  void ReadFrames(const Queue::Producer& producer) {
+    const auto& codec = *server_.codec_;
+    auto& stats = *server_.stats_;
+    impl::ReadBuffer buffer{server_.read_buffer_size_};
+
+    try {
+      while (!engine::current_task::ShouldCancel()) {
+        std::size_t capacity = 0;
+        auto* data = buffer.PrepareWrite(1, capacity);
+        const auto received = socket_.RecvSome(data, capacity, {});
+        if (received == 0) break;
+        buffer.Commit(received);
+        stats.bytes_received += received;
+
+        while (const auto frame = codec.FindFrame(buffer.Data())) {
+          const std::string_view payload{
+              buffer.Data().data() + frame->payload_offset,
+              frame->payload_size};
+          ++stats.frames_received;
+          if (!producer.Push(StartHandler(buffer.GetChunk(), payload))) return;
+          buffer.Consume(frame->total_size);
+        }
+      }
+    } catch (const impl::FrameTooLargeError& ex) {
+      ++stats.errors_frame_too_large;
+      LOG_WARNING() << "Closing connection from " << socket_.Getpeername()
+                    << ": " << ex;
+    } catch (const std::exception& ex) {
+      LOG_INFO() << "Failed to read frames from " << socket_.Getpeername()
+                 << ": " << ex;
+    }
+  }
+
+  engine::TaskWithResult<std::string> StartHandler(
+      impl::ReadBuffer::Chunk chunk, std::string_view payload) {
+    // The chunk keeps the payload alive, no copying
+    return engine::AsyncNoSpan(
+        [this, chunk = std::move(chunk), payload] {
+          try {
+            return server_.HandleFrame(payload);
+          } catch (const std::exception&) {
+            ++server_.stats_->errors_handler;
+            throw;
+          }
+        });
+  }
+
+  void WriteResponses(const Queue::Consumer& consumer) {
+    const auto& codec = *server_.codec_;
+    auto& stats = *server_.stats_;
+    const auto trailer = codec.GetTrailer();
+
+    std::vector<Response> responses;
+    std::vector<engine::io::IoData> io_data;
+    engine::TaskWithResult<std::string> task;
+    while (consumer.Pop(task)) {
+      responses.clear();
+      responses.push_back({task.Get()});
+
+      // Responses that are ready already go out with the same syscall
+      while (responses.size() < kMaxFramesPerSend &&
+             consumer.PopNoblock(task)) {
+        responses.push_back({task.Get()});
+      }
+
+      io_data.clear();
+      std::size_t total_size = 0;
+      for (auto& response : responses) {
+        response.header_size =
+            codec.WriteHeader(response.payload.size(), response.header);
+        for (const std::string_view part :
+             {std::string_view{response.header, response.header_size},
+              std::string_view{response.payload}, trailer}) {
+          if (part.empty()) continue;
+          io_data.push_back({part.data(), part.size()});
+          total_size += part.size();
+        }
+      }
+      if (io_data.empty()) continue;
+
+      const auto sent = socket_.SendAll(io_data.data(), io_data.size(), {});
+      stats.bytes_sent += sent;
+      if (sent != total_size) {
+        LOG_INFO() << "Connection from " << socket_.Getpeername()
+                   << " was closed while writing responses";
+        return;
+      }
+      stats.frames_sent += responses.size();
+    }
+  }
+
+  TcpFramedServerBase& server_;
+  engine::io::Socket socket_;
+  std::shared_ptr<Queue> queue_;
+};
+
+TcpFramedServerBase::TcpFramedServerBase(const ComponentConfig& config,
+                                         const ComponentContext& context)
+    : TcpAcceptorBase(config, context),
+      codec_(std::make_unique<impl::FrameCodec>(ParseFramingConfig(config))),
+      max_connections_(
+          config["max_connections"].As<std::optional<std::size_t>>()),
+      max_pipelined_requests_(
+          ParsePositive(config, "max_pipelined_requests", 16)),
+      read_buffer_size_(ParsePositive(config, "read_buffer_size", 16384)),
+      stats_(std::make_unique<Statistics>()) {
+  auto& storage =
+      context.FindComponent<components::StatisticsStorage>().GetStorage();
+  statistics_holder_ = storage.RegisterWriter(
+      "tcp-framed-server",
+      [this](utils::statistics::Writer& writer) { WriteStatistics(writer); },
+      {{"server_name", config.Name()}});
+}
+
+TcpFramedServerBase::~TcpFramedServerBase() {
+  statistics_holder_.Unregister();
+}
+
+yaml_config::Schema TcpFramedServerBase::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<TcpAcceptorBase>(R"(
+type: object
+description: |
+  Component for TCP servers of framed request-response protocols
+additionalProperties: false
+properties:
+  framing:
+      type: string
+      description: frame format
+      defaultDescription: length-prefixed
+      enum:
+        - length-prefixed
+        - delimiter
+  delimiter:
+      type: string
+      description: frame delimiter for the 'delimiter' framing
+      defaultDescription: "\n"
+  max_frame_size:
+      type: integer
+      description: max size of a frame payload in bytes
+      defaultDescription: 1048576
+  max_connections:
+      type: integer
+      description: connections above the limit are closed right away
+      defaultDescription: unlimited
+  max_pipelined_requests:
+      type: integer
+      description: |
+        max count of the frames of a connection that are handled concurrently
+      defaultDescription: 16
+      minimum: 1
+  read_buffer_size:
+      type: integer
+      description: size of the receive buffer chunks in bytes
+      defaultDescription: 16384
+      minimum: 1
+)");
+}
+
+void TcpFramedServerBase::ProcessSocket(engine::io::Socket&& sock) {
+  auto& stats = *stats_;
+  const auto active = ++stats.connections_active;
+  utils::FastScopeGuard active_guard{
+      [&stats]() noexcept { --stats.connections_active; }};
+
+  if (max_connections_ &&
+      static_cast<std::size_t>(active) > *max_connections_) {
+    ++stats.connections_rejected;
+    LOG_LIMITED_WARNING() << "Rejecting connection from " << sock.Getpeername()
+                          << ": max_connections=" << *max_connections_
+                          << " reached";
+    return;
+  }
+  ++stats.connections_opened;
+
+  Connection{*this, std::move(sock)}.Process();
+}
+
+void TcpFramedServerBase::WriteStatistics(
+    utils::statistics::Writer& writer) const {
+  const auto& stats = *stats_;
+
+  auto connections = writer["connections"];
+  connections["active"] = stats.connections_active.load();
+  connections["opened"] = stats.connections_opened;
+  connections["rejected"] = stats.connections_rejected;
+
+  auto frames = writer["frames"];
+  frames["received"] = stats.frames_received;
+  frames["sent"] = stats.frames_sent;
+
+  auto bytes = writer["bytes"];
+  bytes["received"] = stats.bytes_received;
+  bytes["sent"] = stats.bytes_sent;
+
+  auto errors = writer["errors"];
+  errors["frame-too-large"] = stats.errors_frame_too_large;
+  errors["handler"] = stats.errors_handler;
+}
+
+}  // namespace components
+
+USERVER_NAMESPACE_END
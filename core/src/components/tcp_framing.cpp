@@ -0,0 +1,147 @@
+#include <components/tcp_framing.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components::impl {
+
+namespace {
+
+constexpr std::size_t kLengthPrefixSize = 4;
+constexpr std::size_t kMaxLengthPrefixed =
+    std::numeric_limits<std::uint32_t>::max();
+static_assert(kLengthPrefixSize <= FrameCodec::kMaxHeaderSize);
+
+[[noreturn]] void ThrowFrameTooLarge(std::size_t size, std::size_t max_size) {
+  throw FrameTooLargeError(fmt::format(
+      "Frame of at least {} bytes exceeds max_frame_size={}", size, max_size));
+}
+
+}  // namespace
+
+FrameCodec::FrameCodec(FramingConfig config) : config_(std::move(config)) {
+  if (config_.kind == FramingKind::kDelimiter && config_.delimiter.empty()) {
+    throw std::runtime_error("Frame delimiter must not be empty");
+  }
+  if (config_.kind == FramingKind::kLengthPrefixed &&
+      config_.max_frame_size > kMaxLengthPrefixed) {
+    throw std::runtime_error(
+        "max_frame_size must fit into the 4-byte length prefix");
+  }
+}
+
+std::optional<FrameInfo> FrameCodec::FindFrame(std::string_view data) const {
+  switch (config_.kind) {
+    case FramingKind::kLengthPrefixed: {
+      if (data.size() < kLengthPrefixSize) return std::nullopt;
+
+      std::size_t payload_size = 0;
+      for (std::size_t i = 0; i < kLengthPrefixSize; ++i) {
+        payload_size =
+            (payload_size << 8) | static_cast<unsigned char>(data[i]);
+      }
+      if (payload_size > config_.max_frame_size) {
+        ThrowFrameTooLarge(payload_size, config_.max_frame_size);
+      }
+
+      const auto total_size = kLengthPrefixSize + payload_size;
+      if (data.size() < total_size) return std::nullopt;
+      return FrameInfo{kLengthPrefixSize, payload_size, total_size};
+    }
+
+    case FramingKind::kDelimiter: {
+      const auto& delimiter = config_.delimiter;
+      const auto pos = data.find(delimiter);
+      if (pos == std::string_view::npos) {
+        // The delimiter may be partially received
+        const auto min_payload_size =
+            data.size() - std::min(data.size(), delimiter.size() - 1);
+        if (min_payload_size > config_.max_frame_size) {
+          ThrowFrameTooLarge(min_payload_size, config_.max_frame_size);
+        }
+        return std::nullopt;
+      }
+      if (pos > config_.max_frame_size) {
+        ThrowFrameTooLarge(pos, config_.max_frame_size);
+      }
+      return FrameInfo{0, pos, pos + delimiter.size()};
+    }
+  }
+
+  UINVARIANT(false, "Unexpected FramingKind");
+}
+
+std::size_t FrameCodec::WriteHeader(std::size_t payload_size,
+                                    char (&header)[kMaxHeaderSize]) const {
+  if (config_.kind != FramingKind::kLengthPrefixed) return 0;
+
+  if (payload_size > kMaxLengthPrefixed) {
+    ThrowFrameTooLarge(payload_size, kMaxLengthPrefixed);
+  }
+  for (std::size_t i = 0; i < kLengthPrefixSize; ++i) {
+    header[kLengthPrefixSize - 1 - i] =
+        static_cast<char>((payload_size >> (i * 8)) & 0xFF);
+  }
+  return kLengthPrefixSize;
+}
+
+std::string_view FrameCodec::GetTrailer() const noexcept {
+  if (config_.kind != FramingKind::kDelimiter) return {};
+  return config_.delimiter;
+}
+
+ReadBuffer::ReadBuffer(std::size_t chunk_size) : chunk_size_(chunk_size) {
+  UASSERT(chunk_size_ > 0);
+}
+
+char* ReadBuffer::PrepareWrite(std::size_t min_size, std::size_t& capacity) {
+  if (chunk_capacity_ - end_ < min_size) {
+    const auto data_size = end_ - begin_;
+
+    if (chunk_ && chunk_.use_count() == 1 &&
+        data_size + min_size <= chunk_capacity_) {
+      // No frames of the chunk are being handled, it may be reused
+      std::atomic_thread_fence(std::memory_order_acquire);
+      std::memmove(chunk_.get(), chunk_.get() + begin_, data_size);
+    } else {
+      const auto new_capacity =
+          std::max(chunk_size_, data_size * 2 + min_size);
+      Chunk new_chunk(new char[new_capacity]);
+      if (data_size != 0) {
+        std::memcpy(new_chunk.get(), chunk_.get() + begin_, data_size);
+      }
+      chunk_ = std::move(new_chunk);
+      chunk_capacity_ = new_capacity;
+    }
+
+    begin_ = 0;
+    end_ = data_size;
+  }
+
+  capacity = chunk_capacity_ - end_;
+  return chunk_.get() + end_;
+}
+
+void ReadBuffer::Commit(std::size_t size) noexcept {
+  UASSERT(end_ + size <= chunk_capacity_);
+  end_ += size;
+}
+
+void ReadBuffer::Consume(std::size_t size) noexcept {
+  UASSERT(begin_ + size <= end_);
+  begin_ += size;
+}
+
+}  // namespace components::impl
+
+USERVER_NAMESPACE_END
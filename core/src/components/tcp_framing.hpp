@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components::impl {
+
+enum class FramingKind {
+  // 4-byte big-endian payload size followed by the payload
+  kLengthPrefixed,
+  // The payload followed by the delimiter
+  kDelimiter,
+};
+
+struct FramingConfig final {
+  FramingKind kind{FramingKind::kLengthPrefixed};
+  std::string delimiter{"\n"};
+  std::size_t max_frame_size{1024 * 1024};
+};
+
+class FrameTooLargeError final : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+struct FrameInfo final {
+  std::size_t payload_offset{0};
+  std::size_t payload_size{0};
+  // Size of the payload with the header and the delimiter
+  std::size_t total_size{0};
+};
+
+class FrameCodec final {
+ public:
+  static constexpr std::size_t kMaxHeaderSize = 4;
+
+  explicit FrameCodec(FramingConfig config);
+
+  /// Finds the first frame in `data`, returns std::nullopt if it is not
+  /// complete yet. Throws FrameTooLargeError if the frame exceeds
+  /// max_frame_size.
+  std::optional<FrameInfo> FindFrame(std::string_view data) const;
+
+  /// Writes the header for a payload of `payload_size` bytes into `header`,
+  /// returns the size of the header
+  std::size_t WriteHeader(std::size_t payload_size,
+                          char (&header)[kMaxHeaderSize]) const;
+
+  std::string_view GetTrailer() const noexcept;
+
+ private:
+  const FramingConfig config_;
+};
+
+/// Keeps the received data in reference counted chunks, so that the frames
+/// can be handled without copying while more data is being received.
+class ReadBuffer final {
+ public:
+  using Chunk = std::shared_ptr<char[]>;
+
+  explicit ReadBuffer(std::size_t chunk_size);
+
+  /// Returns the free space to receive into, at least `min_size` bytes. Moves
+  /// the unconsumed data to a new chunk if the current one is referenced
+  /// elsewhere.
+  char* PrepareWrite(std::size_t min_size, std::size_t& capacity);
+
+  void Commit(std::size_t size) noexcept;
+
+  /// Unconsumed data, kept alive by GetChunk()
+  std::string_view Data() const noexcept {
+    return {chunk_.get() + begin_, end_ - begin_};
+  }
+
+  void Consume(std::size_t size) noexcept;
+
+  const Chunk& GetChunk() const noexcept { return chunk_; }
+
+ private:
+  const std::size_t chunk_size_;
+  Chunk chunk_;
+  std::size_t chunk_capacity_{0};
+  std::size_t begin_{0};
+  std::size_t end_{0};
+};
+
+}  // namespace components::impl
+
+USERVER_NAMESPACE_END
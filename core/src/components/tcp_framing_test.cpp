@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+
+#include <components/tcp_framing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using components::impl::FrameCodec;
+using components::impl::FrameTooLargeError;
+using components::impl::FramingConfig;
+using components::impl::FramingKind;
+using components::impl::ReadBuffer;
+
+std::string LengthPrefixed(const FrameCodec& codec, std::string_view payload) {
+  char header[FrameCodec::kMaxHeaderSize];
+  const auto header_size = codec.WriteHeader(payload.size(), header);
+  return std::string(header, header_size) + std::string{payload};
+}
+
+void Append(ReadBuffer& buffer, std::string_view data) {
+  std::size_t capacity = 0;
+  auto* dest = buffer.PrepareWrite(data.size(), capacity);
+  ASSERT_GE(capacity, data.size());
+  std::memcpy(dest, data.data(), data.size());
+  buffer.Commit(data.size());
+}
+
+}  // namespace
+
+TEST(TcpFraming, LengthPrefixed) {
+  const FrameCodec codec{FramingConfig{FramingKind::kLengthPrefixed, {}, 300}};
+  EXPECT_TRUE(codec.GetTrailer().empty());
+
+  const auto data = LengthPrefixed(codec, std::string(260, 'a'));
+  EXPECT_EQ(data.substr(0, 4), std::string("\0\0\x01\x04", 4));
+
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    EXPECT_FALSE(codec.FindFrame(std::string_view{data}.substr(0, i)));
+  }
+
+  const auto frame = codec.FindFrame(data + "tail");
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(frame->payload_offset, 4);
+  EXPECT_EQ(frame->payload_size, 260);
+  EXPECT_EQ(frame->total_size, data.size());
+
+  const auto empty = codec.FindFrame(LengthPrefixed(codec, ""));
+  ASSERT_TRUE(empty);
+  EXPECT_EQ(empty->payload_size, 0);
+  EXPECT_EQ(empty->total_size, 4);
+
+  // Rejected as soon as the header is received
+  EXPECT_THROW(codec.FindFrame(std::string("\0\0\x01\x2d", 4)),
+               FrameTooLargeError);
+}
+
+TEST(TcpFraming, Delimiter) {
+  const FrameCodec codec{FramingConfig{FramingKind::kDelimiter, "\r\n", 5}};
+  EXPECT_EQ(codec.GetTrailer(), "\r\n");
+
+  char header[FrameCodec::kMaxHeaderSize];
+  EXPECT_EQ(codec.WriteHeader(5, header), 0);
+
+  EXPECT_FALSE(codec.FindFrame("abc"));
+  EXPECT_FALSE(codec.FindFrame("abcde\r"));
+
+  const auto frame = codec.FindFrame("abc\r\nde\r\n");
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(frame->payload_offset, 0);
+  EXPECT_EQ(frame->payload_size, 3);
+  EXPECT_EQ(frame->total_size, 5);
+
+  EXPECT_THROW(codec.FindFrame("abcdefg"), FrameTooLargeError);
+  EXPECT_THROW(codec.FindFrame("abcdef\r\n"), FrameTooLargeError);
+
+  EXPECT_THROW(FrameCodec(FramingConfig{FramingKind::kDelimiter, "", 5}),
+               std::runtime_error);
+}
+
+TEST(TcpFraming, ReadBufferReusesChunk) {
+  ReadBuffer buffer{16};
+  Append(buffer, "0123456789");
+  EXPECT_EQ(buffer.Data(), "0123456789");
+  const auto* chunk = buffer.GetChunk().get();
+
+  buffer.Consume(8);
+  Append(buffer, "abcdefghij");
+  EXPECT_EQ(buffer.Data(), "89abcdefghij");
+  EXPECT_EQ(buffer.GetChunk().get(), chunk);
+}
+
+TEST(TcpFraming, ReadBufferKeepsReferencedChunk) {
+  ReadBuffer buffer{16};
+  Append(buffer, "0123456789");
+  const auto frame_chunk = buffer.GetChunk();
+  const std::string_view frame{buffer.Data().data(), 8};
+
+  buffer.Consume(8);
+  Append(buffer, "abcdefghij");
+  EXPECT_EQ(buffer.Data(), "89abcdefghij");
+  EXPECT_NE(buffer.GetChunk(), frame_chunk);
+  EXPECT_EQ(frame, "01234567");
+}
+
+TEST(TcpFraming, ReadBufferGrows) {
+  ReadBuffer buffer{4};
+  std::string expected;
+  for (int i = 0; i < 100; ++i) {
+    const auto part = std::to_string(i);
+    Append(buffer, part);
+    expected += part;
+  }
+  EXPECT_EQ(buffer.Data(), expected);
+}
+
+USERVER_NAMESPACE_END
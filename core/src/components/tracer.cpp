@@ -1,5 +1,6 @@
 #include <userver/components/tracer.hpp>
 
+#include <tracing/sampling.hpp>
 #include <userver/components/component.hpp>
 #include <userver/logging/component.hpp>
 #include <userver/tracing/noop.hpp>
@@ -12,9 +13,26 @@ USERVER_NAMESPACE_BEGIN
 namespace components {
 
 namespace {
+
 constexpr std::string_view kNativeTrace = "native";
+
+tracing::Sampling ParseSampling(const yaml_config::YamlConfig& config) {
+  tracing::Sampling sampling;
+  sampling.head_probability =
+      config["head-probability"].As<double>(sampling.head_probability);
+
+  const auto tail = config["tail"];
+  sampling.tail_enabled = tail["enabled"].As<bool>(sampling.tail_enabled);
+  sampling.tail_slow_threshold =
+      tail["slow-threshold"].As<std::chrono::milliseconds>(
+          sampling.tail_slow_threshold);
+  sampling.tail_max_spans =
+      tail["max-spans"].As<std::size_t>(sampling.tail_max_spans);
+  return sampling;
 }
 
+}  // namespace
+
 Tracer::Tracer(const ComponentConfig& config, const ComponentContext& context) {
   auto& logging_component = context.FindComponent<Logging>();
   auto service_name = config["service-name"].As<std::string>();
@@ -36,6 +54,7 @@ Tracer::Tracer(const ComponentConfig& config, const ComponentContext& context) {
     throw std::runtime_error("Tracer type is not supported: " + tracer_type);
   }
 
+  tracing::Tracer::SetSampling(ParseSampling(config["sampling"]));
   tracing::Tracer::SetTracer(std::move(tracer));
 }
 
@@ -52,6 +71,35 @@ properties:
         type: string
         description: type of the tracer to trace, currently supported only 'native'
         defaultDescription: 'native'
+    sampling:
+        type: object
+        description: settings of the trace sampling
+        additionalProperties: false
+        properties:
+            head-probability:
+                type: number
+                description: probability of a new trace to be logged
+                defaultDescription: 1.0
+                minimum: 0
+                maximum: 1
+            tail:
+                type: object
+                description: settings of the tail sampling of the traces that were not chosen by the head sampling
+                additionalProperties: false
+                properties:
+                    enabled:
+                        type: boolean
+                        description: buffer the spans of the trace and log them if the trace was slow, errored or hit a testpoint
+                        defaultDescription: false
+                    slow-threshold:
+                        type: string
+                        description: minimal duration of the root span of a slow trace
+                        defaultDescription: 1s
+                    max-spans:
+                        type: integer
+                        description: limit on the buffered spans of a single trace
+                        defaultDescription: 1000
+                        minimum: 1
 )");
 }
 
@@ -1,41 +1,196 @@
 #include <compression/gzip.hpp>
 
-#include <boost/iostreams/filter/gzip.hpp>
-#include <boost/iostreams/filtering_stream.hpp>
+#include <zlib.h>
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace compression::gzip {
 
 namespace {
-constexpr auto kDecompressBufferSize = 1024;
-}
+
+// Output is decompressed in chunks proportional to the input
+constexpr std::size_t kMinDecompressChunkSize = 1024;
+constexpr std::size_t kMaxDecompressChunkSize = 1024 * 1024;
+
+}  // namespace
 
 std::string Decompress(std::string_view compressed, size_t max_size) {
   std::string decompressed;
+  Decompressor decompressor{Format::kGzip, max_size};
+  decompressor.Decompress(compressed, decompressed);
+  decompressor.Finish();
+  return decompressed;
+}
+
+struct Decompressor::Impl {
+  z_stream stream{};
+  std::size_t max_size{0};
+  std::uint64_t output_size{0};
+  Format format{Format::kGzip};
+  bool finished{false};
+};
 
-  // A guess for "small" data chunk
-  // "-1" is required to avoid memory fragmentation
-  // (stdlibc++ allocates capacity+1 bytes).
-  decompressed.reserve(kDecompressBufferSize - 1);
+Decompressor::Decompressor(Format format, std::size_t max_size) {
+  impl_->max_size = max_size;
+  impl_->format = format;
 
-  namespace bio = boost::iostreams;
+  // 15 is the largest window, +16 makes zlib expect the gzip header and
+  // trailer instead of the zlib ones
+  const int window_bits = (format == Format::kGzip ? 15 + 16 : 15);
+  if (inflateInit2(&impl_->stream, window_bits) != Z_OK) {
+    throw DecompressionError("failed to initialize decompression");
+  }
+}
 
-  bio::filtering_istream stream;
-  stream.push(bio::gzip_decompressor());
-  stream.push(bio::array_source(compressed.data(), compressed.size()));
+Decompressor::~Decompressor() { inflateEnd(&impl_->stream); }
 
-  while (stream && (decompressed.size() < max_size)) {
-    char buf[kDecompressBufferSize];
-    stream.read(buf, sizeof(buf));
-    decompressed.insert(decompressed.end(), buf, buf + stream.gcount());
+void Decompressor::Decompress(std::string_view data, std::string& output) {
+  auto& stream = impl_->stream;
+
+  // zlib does not modify the input, the cast is for the old zlib API
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream.avail_in = static_cast<uInt>(data.size());
+  UINVARIANT(stream.avail_in == data.size(), "too big data to decompress");
+
+  // zlib may keep some output if the previous chunk was filled up
+  bool is_output_full = false;
+  while (stream.avail_in != 0 || is_output_full) {
+    if (impl_->finished) {
+      // gzip allows several members one after another
+      if (impl_->format != Format::kGzip) {
+        throw DecompressionError("data after the end of the compressed stream");
+      }
+      inflateReset(&stream);
+      impl_->finished = false;
+    }
+
+    // An extra byte detects that the output exceeds the limit
+    const auto chunk_size =
+        std::min<std::uint64_t>(
+            std::clamp(data.size() * 4, kMinDecompressChunkSize,
+                       kMaxDecompressChunkSize),
+            impl_->max_size - impl_->output_size) +
+        1;
+    const auto offset = output.size();
+    output.resize(offset + chunk_size);
+    stream.next_out = reinterpret_cast<Bytef*>(output.data() + offset);
+    stream.avail_out = static_cast<uInt>(chunk_size);
+
+    const int status = inflate(&stream, Z_NO_FLUSH);
+    const auto produced = chunk_size - stream.avail_out;
+    output.resize(offset + produced);
+    impl_->output_size += produced;
+    if (impl_->output_size > impl_->max_size) throw TooBigError();
+
+    if (status == Z_STREAM_END) {
+      impl_->finished = true;
+    } else if (status != Z_OK &&
+               (status != Z_BUF_ERROR || stream.avail_in != 0)) {
+      throw DecompressionError(fmt::format(
+          "failed to decompress data: {}", stream.msg ? stream.msg : "error"));
+    }
+    is_output_full = (stream.avail_out == 0 && !impl_->finished);
   }
+}
 
-  if (stream.bad())
-    throw DecompressionError("failed to decompress gzip'ed data");
-  if (stream) throw TooBigError();
+void Decompressor::Finish() const {
+  if (!impl_->finished) {
+    throw DecompressionError("compressed data is cut short");
+  }
+}
 
-  return decompressed;
+std::uint64_t Decompressor::GetOutputSize() const noexcept {
+  return impl_->output_size;
+}
+
+struct Compressor::Impl {
+  z_stream stream{};
+  bool finished{false};
+};
+
+Compressor::Compressor(int level) {
+  // 15 is the largest window, +16 makes zlib write the gzip header and trailer
+  // instead of the zlib ones
+  constexpr int kGzipWindowBits = 15 + 16;
+  constexpr int kMemLevel = 8;
+
+  if (level < Z_NO_COMPRESSION || level > Z_BEST_COMPRESSION) {
+    throw CompressionError(
+        fmt::format("invalid gzip compression level {}", level));
+  }
+  if (deflateInit2(&impl_->stream, level, Z_DEFLATED, kGzipWindowBits,
+                   kMemLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw CompressionError("failed to initialize gzip compression");
+  }
+}
+
+Compressor::~Compressor() { deflateEnd(&impl_->stream); }
+
+std::string Compressor::Compress(std::string_view data, Flush flush) {
+  auto& stream = impl_->stream;
+  if (impl_->finished) {
+    throw CompressionError("gzip stream is already finished");
+  }
+
+  int mode = Z_NO_FLUSH;
+  switch (flush) {
+    case Flush::kNone:
+      break;
+    case Flush::kSync:
+      mode = Z_SYNC_FLUSH;
+      break;
+    case Flush::kFinish:
+      mode = Z_FINISH;
+      break;
+  }
+
+  // zlib does not modify the input, the cast is for the old zlib API
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream.avail_in = static_cast<uInt>(data.size());
+  UINVARIANT(stream.avail_in == data.size(), "too big data to compress");
+
+  std::string result;
+  // Usually enough for a single pass, unless a lot of data is buffered
+  std::size_t chunk_size =
+      std::max<std::size_t>(deflateBound(&stream, data.size()), 64);
+  int status = Z_OK;
+  do {
+    const auto offset = result.size();
+    result.resize(offset + chunk_size);
+    stream.next_out = reinterpret_cast<Bytef*>(result.data() + offset);
+    stream.avail_out = static_cast<uInt>(chunk_size);
+
+    status = deflate(&stream, mode);
+    if (status == Z_STREAM_ERROR) {
+      throw CompressionError("failed to compress gzip data");
+    }
+    result.resize(offset + chunk_size - stream.avail_out);
+    chunk_size *= 2;
+  } while (stream.avail_out == 0 ||
+           (mode == Z_FINISH && status != Z_STREAM_END));
+
+  UASSERT(stream.avail_in == 0);
+  impl_->finished = (mode == Z_FINISH);
+  return result;
+}
+
+std::uint64_t Compressor::GetInputSize() const noexcept {
+  return impl_->stream.total_in;
+}
+
+std::uint64_t Compressor::GetOutputSize() const noexcept {
+  return impl_->stream.total_out;
+}
+
+std::string Compress(std::string_view data, int level) {
+  Compressor compressor{level};
+  return compressor.Compress(data, Flush::kFinish);
 }
 
 }  // namespace compression::gzip
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstdint>
+#include <string>
 #include <string_view>
 
 #include <compression/error.hpp>
+#include <userver/utils/fast_pimpl.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -12,6 +15,89 @@ namespace compression::gzip {
 /// @throws DecompressionError
 std::string Decompress(std::string_view compressed, size_t max_size);
 
+/// Format of the compressed data
+enum class Format {
+  /// gzip, `Content-Encoding: gzip`
+  kGzip,
+  /// zlib wrapped deflate, `Content-Encoding: deflate`
+  kZlib,
+};
+
+/// @brief Streaming decoder; decompresses the data as it arrives and stops
+/// as soon as the decompressed data exceeds the limit.
+class Decompressor final {
+ public:
+  /// @param max_size limit of the total size of the decompressed data
+  /// @throws DecompressionError if zlib fails to initialize
+  Decompressor(Format format, std::size_t max_size);
+  Decompressor(Decompressor&&) = delete;
+  Decompressor& operator=(Decompressor&&) = delete;
+  ~Decompressor();
+
+  /// Appends the decompressed `data` to `output`
+  /// @throws TooBigError if the decompressed data exceeds the limit
+  /// @throws DecompressionError on the malformed data
+  void Decompress(std::string_view data, std::string& output);
+
+  /// Checks that the whole compressed stream was passed to Decompress()
+  /// @throws DecompressionError if the stream is cut short
+  void Finish() const;
+
+  /// Total size of the decompressed data
+  std::uint64_t GetOutputSize() const noexcept;
+
+ private:
+  struct Impl;
+  // z_stream is 112 bytes on 64-bit platforms, plus the limit and the state
+  utils::FastPimpl<Impl, 136, 8> impl_;
+};
+
+/// Default compression level of zlib, a good balance of speed and size
+inline constexpr int kDefaultLevel = 6;
+
+/// What to output after compressing the data
+enum class Flush {
+  /// Only the blocks that are complete, the rest is buffered
+  kNone,
+  /// All the pending data, so that the receiver can decode it right away.
+  /// Used for the chunks of the streamed responses.
+  kSync,
+  /// All the pending data and the gzip trailer, ends the stream
+  kFinish,
+};
+
+/// @brief Streaming gzip encoder; outputs a single gzip member for all the
+/// data passed to Compress() until the Flush::kFinish.
+class Compressor final {
+ public:
+  /// @param level from 0 (no compression) to 9 (best compression)
+  /// @throws CompressionError on the invalid level
+  explicit Compressor(int level = kDefaultLevel);
+  Compressor(Compressor&&) = delete;
+  Compressor& operator=(Compressor&&) = delete;
+  ~Compressor();
+
+  /// @returns the compressed data that is ready, may be empty for
+  /// Flush::kNone
+  /// @throws CompressionError
+  std::string Compress(std::string_view data, Flush flush);
+
+  /// Total size of the data passed to Compress()
+  std::uint64_t GetInputSize() const noexcept;
+
+  /// Total size of the data returned from Compress()
+  std::uint64_t GetOutputSize() const noexcept;
+
+ private:
+  struct Impl;
+  // z_stream is 112 bytes on 64-bit platforms, plus a flag
+  utils::FastPimpl<Impl, 120, 8> impl_;
+};
+
+/// Compresses the string into a complete gzip stream.
+/// @throws CompressionError
+std::string Compress(std::string_view data, int level = kDefaultLevel);
+
 }  // namespace compression::gzip
 
 USERVER_NAMESPACE_END
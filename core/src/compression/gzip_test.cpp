@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <zlib.h>
+
+#include <compression/gzip.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string MakeData() {
+  std::string data;
+  for (int i = 0; i < 10000; ++i) data += std::to_string(i % 97) + ' ';
+  return data;
+}
+
+}  // namespace
+
+TEST(Gzip, Roundtrip) {
+  const auto data = MakeData();
+  for (int level = 0; level <= 9; ++level) {
+    const auto compressed = compression::gzip::Compress(data, level);
+    EXPECT_EQ(compression::gzip::Decompress(compressed, data.size()), data)
+        << level;
+    if (level > 0) {
+      EXPECT_LT(compressed.size(), data.size() / 4) << level;
+    }
+  }
+  EXPECT_EQ(compression::gzip::Decompress(compression::gzip::Compress({}), 1),
+            "");
+}
+
+TEST(Gzip, Streaming) {
+  const auto data = MakeData();
+  compression::gzip::Compressor compressor;
+
+  std::string compressed;
+  for (std::size_t pos = 0; pos < data.size(); pos += 1000) {
+    const auto chunk = compressor.Compress(data.substr(pos, 1000),
+                                           compression::gzip::Flush::kSync);
+    // The sync flush outputs all the data, ending with an empty stored block
+    ASSERT_GE(chunk.size(), 4);
+    EXPECT_EQ(chunk.substr(chunk.size() - 4), std::string("\0\0\xff\xff", 4));
+    compressed += chunk;
+  }
+  compressed += compressor.Compress({}, compression::gzip::Flush::kFinish);
+
+  EXPECT_EQ(compression::gzip::Decompress(compressed, data.size()), data);
+  EXPECT_EQ(compressor.GetInputSize(), data.size());
+  EXPECT_EQ(compressor.GetOutputSize(), compressed.size());
+  EXPECT_THROW(compressor.Compress("x", compression::gzip::Flush::kNone),
+               compression::CompressionError);
+}
+
+TEST(Gzip, NoFlush) {
+  const auto data = MakeData();
+  compression::gzip::Compressor compressor{1};
+
+  std::string compressed;
+  for (std::size_t pos = 0; pos < data.size(); pos += 100) {
+    compressed += compressor.Compress(data.substr(pos, 100),
+                                      compression::gzip::Flush::kNone);
+  }
+  compressed += compressor.Compress({}, compression::gzip::Flush::kFinish);
+  EXPECT_EQ(compression::gzip::Decompress(compressed, data.size()), data);
+}
+
+TEST(Gzip, DecompressorChunks) {
+  const auto data = MakeData();
+  const auto compressed = compression::gzip::Compress(data);
+
+  for (const std::size_t chunk_size : {1, 7, 1000, 100000}) {
+    compression::gzip::Decompressor decompressor{
+        compression::gzip::Format::kGzip, data.size()};
+    std::string decompressed;
+    for (std::size_t pos = 0; pos < compressed.size(); pos += chunk_size) {
+      EXPECT_THROW(decompressor.Finish(), compression::DecompressionError);
+      decompressor.Decompress(compressed.substr(pos, chunk_size),
+                              decompressed);
+    }
+    decompressor.Finish();
+    EXPECT_EQ(decompressed, data) << chunk_size;
+    EXPECT_EQ(decompressor.GetOutputSize(), data.size()) << chunk_size;
+  }
+}
+
+TEST(Gzip, DecompressorDeflate) {
+  const auto data = MakeData();
+  std::string compressed(compressBound(data.size()), '\0');
+  auto compressed_size = static_cast<uLongf>(compressed.size());
+  ASSERT_EQ(compress(reinterpret_cast<Bytef*>(compressed.data()),
+                     &compressed_size,
+                     reinterpret_cast<const Bytef*>(data.data()), data.size()),
+            Z_OK);
+  compressed.resize(compressed_size);
+
+  compression::gzip::Decompressor decompressor{
+      compression::gzip::Format::kZlib, data.size()};
+  std::string decompressed;
+  decompressor.Decompress(compressed, decompressed);
+  decompressor.Finish();
+  EXPECT_EQ(decompressed, data);
+
+  EXPECT_THROW(decompressor.Decompress("x", decompressed),
+               compression::DecompressionError);
+  EXPECT_THROW(compression::gzip::Decompress(compressed, data.size()),
+               compression::DecompressionError);
+}
+
+TEST(Gzip, DecompressorStopsAtLimit) {
+  const std::string data(10 * 1024 * 1024, 'a');
+  const auto compressed = compression::gzip::Compress(data);
+
+  compression::gzip::Decompressor decompressor{
+      compression::gzip::Format::kGzip, 100 * 1024};
+  std::string decompressed;
+  std::size_t pos = 0;
+  EXPECT_THROW(
+      {
+        for (; pos < compressed.size(); pos += 100) {
+          decompressor.Decompress(compressed.substr(pos, 100), decompressed);
+        }
+      },
+      compression::TooBigError);
+  // The rest of the input is not decompressed
+  EXPECT_LT(pos, compressed.size() / 2);
+  EXPECT_LE(decompressed.size(), 100 * 1024 + 1);
+
+  EXPECT_EQ(compression::gzip::Decompress(compressed, data.size()), data);
+  EXPECT_THROW(compression::gzip::Decompress(compressed, data.size() - 1),
+               compression::TooBigError);
+}
+
+TEST(Gzip, DecompressorMalformed) {
+  const auto data = MakeData();
+  const auto compressed = compression::gzip::Compress(data);
+
+  EXPECT_THROW(compression::gzip::Decompress(
+                   compressed.substr(0, compressed.size() - 1), data.size()),
+               compression::DecompressionError);
+  EXPECT_THROW(compression::gzip::Decompress("not gzip", data.size()),
+               compression::DecompressionError);
+
+  // Several gzip members make a valid stream
+  EXPECT_EQ(compression::gzip::Decompress(
+                compressed + compression::gzip::Compress("tail"),
+                data.size() + 4),
+            data + "tail");
+}
+
+TEST(Gzip, InvalidLevel) {
+  EXPECT_THROW(compression::gzip::Compressor{10},
+               compression::CompressionError);
+  EXPECT_THROW(compression::gzip::Compress("data", -2),
+               compression::CompressionError);
+}
+
+USERVER_NAMESPACE_END
@@ -6,10 +6,53 @@
 
 #include <userver/logging/log.hpp>
 #include <userver/utils/async.hpp>
+#include <userver/utils/statistics/writer.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
-namespace concurrent::impl {
+namespace concurrent {
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const AsyncEventListenerStatistics& stats) {
+  writer["events"] = stats.events;
+  writer["last-duration-us"] = stats.last_duration.count();
+  writer["max-duration-us"] = stats.max_duration.count();
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const AsyncEventChannelStatistics& stats) {
+  for (const auto& listener : stats.listeners) {
+    writer.ValueWithLabels(
+        listener, utils::statistics::LabelView{"listener", listener.name});
+  }
+}
+
+namespace impl {
+
+void ListenerTimings::Account(
+    std::chrono::steady_clock::duration duration) noexcept {
+  const auto duration_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+
+  events_.fetch_add(1, std::memory_order_relaxed);
+  last_duration_us_.store(duration_us, std::memory_order_relaxed);
+
+  // Only the listener task of the current event writes here
+  if (duration_us > max_duration_us_.load(std::memory_order_relaxed)) {
+    max_duration_us_.store(duration_us, std::memory_order_relaxed);
+  }
+}
+
+AsyncEventListenerStatistics ListenerTimings::GetStatistics() const {
+  AsyncEventListenerStatistics stats;
+  stats.name = name_;
+  stats.events = events_.load(std::memory_order_relaxed);
+  stats.last_duration = std::chrono::microseconds{
+      last_duration_us_.load(std::memory_order_relaxed)};
+  stats.max_duration = std::chrono::microseconds{
+      max_duration_us_.load(std::memory_order_relaxed)};
+  return stats;
+}
 
 void WaitForTask(std::string_view name, engine::TaskWithResult<void>& task) {
   constexpr std::chrono::seconds kSubscriberTimeout(30);
@@ -56,6 +99,8 @@ std::string MakeAsyncChannelName(std::string_view base, std::string_view name) {
   return fmt::format("async_channel/{}_{}", base, name);
 }
 
-}  // namespace concurrent::impl
+}  // namespace impl
+
+}  // namespace concurrent
 
 USERVER_NAMESPACE_END
@@ -1,9 +1,12 @@
 #include <userver/utest/utest.hpp>
 
 #include <atomic>
+#include <chrono>
 #include <stdexcept>
+#include <vector>
 
 #include <userver/concurrent/async_event_channel.hpp>
+#include <userver/engine/sleep.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -91,6 +94,58 @@ UTEST(AsyncEventChannel, PublishException) {
   sub1.Unsubscribe();
 }
 
+UTEST_MT(AsyncEventChannel, MaxParallelListeners, 4) {
+  constexpr int kListeners = 10;
+  concurrent::AsyncEventChannel<int> channel("channel", 2);
+
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+  std::atomic<int> sum{0};
+  std::vector<int> owners(kListeners);
+  std::vector<concurrent::AsyncEventSubscriberScope> subs;
+  for (auto& owner : owners) {
+    subs.push_back(channel.AddListener(
+        concurrent::FunctionId(&owner), "listener", [&](int x) {
+          const auto now_running = ++running;
+          int expected = max_running.load();
+          while (expected < now_running &&
+                 !max_running.compare_exchange_weak(expected, now_running)) {
+          }
+          engine::SleepFor(std::chrono::milliseconds{1});
+          sum += x;
+          --running;
+        }));
+  }
+
+  channel.SendEvent(1);
+  EXPECT_EQ(sum, kListeners);
+  EXPECT_LE(max_running, 2);
+
+  for (auto& sub : subs) sub.Unsubscribe();
+}
+
+UTEST(AsyncEventChannel, Statistics) {
+  concurrent::AsyncEventChannel<int> channel("channel");
+
+  int value{0};
+  Subscriber s(value);
+  auto sub = channel.AddListener(&s, "sub", &Subscriber::OnEvent);
+  EXPECT_EQ(channel.GetStatistics().listeners.size(), 1);
+
+  channel.SendEvent(1);
+  channel.SendEvent(2);
+
+  const auto stats = channel.GetStatistics();
+  ASSERT_EQ(stats.listeners.size(), 1);
+  EXPECT_EQ(stats.listeners[0].name, "sub");
+  EXPECT_EQ(stats.listeners[0].events, 2);
+  EXPECT_LE(stats.listeners[0].last_duration,
+            stats.listeners[0].max_duration);
+
+  sub.Unsubscribe();
+  EXPECT_TRUE(channel.GetStatistics().listeners.empty());
+}
+
 namespace {
 
 /// [AsyncEventChannel sample]
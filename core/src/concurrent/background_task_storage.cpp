@@ -1,13 +1,27 @@
 #include <userver/concurrent/background_task_storage.hpp>
 
+#include <atomic>
+
 #include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/task.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/writer.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace concurrent {
 
+void DumpMetric(utils::statistics::Writer& writer,
+                const BackgroundTaskStorageStatistics& stats) {
+  writer["active-tasks"] = stats.active_tasks;
+  if (stats.max_tasks == 0) return;
+
+  writer["max-tasks"] = stats.max_tasks;
+  writer["overflow"]["rejected"] = stats.rejected;
+  writer["overflow"]["ran-inline"] = stats.ran_inline;
+  writer["overflow"]["waited"] = stats.waited;
+}
+
 BackgroundTaskStorageCore::BackgroundTaskStorageCore()
     : sync_block_(
           std::in_place,
@@ -37,6 +51,19 @@ std::int64_t BackgroundTaskStorageCore::ActiveTasksApprox() const noexcept {
   return sync_block_->ActiveTasksApprox();
 }
 
+struct BackgroundTaskStorage::Limiter final {
+  explicit Limiter(BackgroundTaskStorageLimits limits)
+      : limits(limits), slots(limits.max_tasks) {}
+
+  const BackgroundTaskStorageLimits limits;
+  engine::Semaphore slots;
+
+  // Only touched on overflow, so they are not sharded
+  std::atomic<std::uint64_t> rejected{0};
+  std::atomic<std::uint64_t> ran_inline{0};
+  std::atomic<std::uint64_t> waited{0};
+};
+
 BackgroundTaskStorage::BackgroundTaskStorage()
     : BackgroundTaskStorage(engine::current_task::GetTaskProcessor()) {}
 
@@ -44,12 +71,64 @@ BackgroundTaskStorage::BackgroundTaskStorage(
     engine::TaskProcessor& task_processor)
     : task_processor_(task_processor) {}
 
+BackgroundTaskStorage::BackgroundTaskStorage(
+    BackgroundTaskStorageLimits limits)
+    : BackgroundTaskStorage(engine::current_task::GetTaskProcessor(), limits) {
+}
+
+BackgroundTaskStorage::BackgroundTaskStorage(
+    engine::TaskProcessor& task_processor, BackgroundTaskStorageLimits limits)
+    : limiter_(std::make_unique<Limiter>(limits)),
+      task_processor_(task_processor) {
+  UINVARIANT(limits.max_tasks > 0, "max_tasks must be positive");
+}
+
+BackgroundTaskStorage::~BackgroundTaskStorage() = default;
+
 void BackgroundTaskStorage::CancelAndWait() noexcept { core_.CancelAndWait(); }
 
 std::int64_t BackgroundTaskStorage::ActiveTasksApprox() const noexcept {
   return core_.ActiveTasksApprox();
 }
 
+BackgroundTaskStorageStatistics BackgroundTaskStorage::GetStatistics() const {
+  BackgroundTaskStorageStatistics stats;
+  stats.active_tasks = ActiveTasksApprox();
+  if (!limiter_) return stats;
+
+  stats.max_tasks = limiter_->limits.max_tasks;
+  stats.rejected = limiter_->rejected.load(std::memory_order_relaxed);
+  stats.ran_inline = limiter_->ran_inline.load(std::memory_order_relaxed);
+  stats.waited = limiter_->waited.load(std::memory_order_relaxed);
+  return stats;
+}
+
+engine::SemaphoreLock BackgroundTaskStorage::AcquireSlot() {
+  UASSERT(limiter_);
+  engine::SemaphoreLock slot(limiter_->slots, std::try_to_lock);
+  if (slot) return slot;
+
+  switch (limiter_->limits.overflow_policy) {
+    case BackgroundTaskOverflowPolicy::kReject:
+      limiter_->rejected.fetch_add(1, std::memory_order_relaxed);
+      break;
+    case BackgroundTaskOverflowPolicy::kRunInline:
+      limiter_->ran_inline.fetch_add(1, std::memory_order_relaxed);
+      break;
+    case BackgroundTaskOverflowPolicy::kWait:
+      limiter_->waited.fetch_add(1, std::memory_order_relaxed);
+      slot.Lock();
+      break;
+  }
+  return slot;
+}
+
+bool BackgroundTaskStorage::ShouldRunInline() const noexcept {
+  UASSERT(limiter_);
+  return limiter_->limits.overflow_policy ==
+         BackgroundTaskOverflowPolicy::kRunInline;
+}
+
 }  // namespace concurrent
 
 USERVER_NAMESPACE_END
@@ -41,4 +41,28 @@ BENCHMARK(background_task_storage)
     ->Arg(16)
     ->Arg(32);
 
+void background_task_storage_limited(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    concurrent::BackgroundTaskStorage bts(
+        concurrent::BackgroundTaskStorageLimits{
+            1024, concurrent::BackgroundTaskOverflowPolicy::kRunInline});
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (std::int64_t i = 0; i < state.range(0) - 1; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&] {
+        while (!engine::current_task::ShouldCancel()) {
+          bts.AsyncDetach("task", [] {});
+          engine::Yield();
+        }
+      }));
+    }
+
+    for (auto _ : state) {
+      bts.AsyncDetach("task", [] {});
+      engine::Yield();
+    }
+  });
+}
+BENCHMARK(background_task_storage_limited)->Arg(2)->Arg(8)->Arg(32);
+
 USERVER_NAMESPACE_END
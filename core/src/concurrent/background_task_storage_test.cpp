@@ -185,6 +185,65 @@ UTEST(BackgroundTaskStorage, Pimpl) {
   EXPECT_EQ(bts->ActiveTasksApprox(), 0);
 }
 
+UTEST(BackgroundTaskStorage, OverflowReject) {
+  concurrent::BackgroundTaskStorage bts(concurrent::BackgroundTaskStorageLimits{
+      1, concurrent::BackgroundTaskOverflowPolicy::kReject});
+  engine::SingleConsumerEvent event;
+
+  EXPECT_TRUE(bts.AsyncDetach("long", [&event] {
+    EXPECT_TRUE(event.WaitForEventFor(utest::kMaxTestWaitTime));
+  }));
+  EXPECT_FALSE(bts.AsyncDetach("rejected", [] { ADD_FAILURE(); }));
+
+  const auto stats = bts.GetStatistics();
+  EXPECT_EQ(stats.active_tasks, 1);
+  EXPECT_EQ(stats.max_tasks, 1);
+  EXPECT_EQ(stats.rejected, 1);
+  EXPECT_EQ(stats.ran_inline, 0);
+  EXPECT_EQ(stats.waited, 0);
+
+  event.Send();
+  bts.CancelAndWait();
+}
+
+UTEST(BackgroundTaskStorage, OverflowRunInline) {
+  concurrent::BackgroundTaskStorage bts(concurrent::BackgroundTaskStorageLimits{
+      1, concurrent::BackgroundTaskOverflowPolicy::kRunInline});
+  engine::SingleConsumerEvent event;
+
+  EXPECT_TRUE(bts.AsyncDetach("long", [&event] {
+    EXPECT_TRUE(event.WaitForEventFor(utest::kMaxTestWaitTime));
+  }));
+
+  bool ran = false;
+  EXPECT_TRUE(bts.AsyncDetach("inline", [&ran](int x) { ran = x == 42; }, 42));
+  EXPECT_TRUE(ran);
+  UEXPECT_THROW(bts.AsyncDetach("inline",
+                                [] { throw std::runtime_error("inline"); }),
+                std::runtime_error);
+  EXPECT_EQ(bts.GetStatistics().ran_inline, 2);
+
+  event.Send();
+  bts.CancelAndWait();
+}
+
+UTEST(BackgroundTaskStorage, OverflowWait) {
+  concurrent::BackgroundTaskStorage bts(concurrent::BackgroundTaskStorageLimits{
+      2, concurrent::BackgroundTaskOverflowPolicy::kWait});
+  std::atomic<int> finished{0};
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(bts.AsyncDetach("task", [&finished] {
+      engine::Yield();
+      ++finished;
+    }));
+  }
+  EXPECT_GE(bts.GetStatistics().waited, 1);
+
+  while (finished != 10) engine::Yield();
+  EXPECT_EQ(bts.GetStatistics().rejected, 0);
+}
+
 namespace {
 engine::TaskInheritedVariable<int> inherited_variable;
 }  // namespace
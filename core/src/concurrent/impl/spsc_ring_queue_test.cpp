@@ -0,0 +1,131 @@
+#include <userver/concurrent/impl/spsc_ring_queue.hpp>
+
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Queue = concurrent::impl::SpscRingQueue<std::size_t>;
+
+constexpr std::size_t kStressTestCount = 1'000'000;
+
+}  // namespace
+
+TEST(SpscRingQueue, Empty) {
+  Queue queue;
+  std::size_t value{};
+  EXPECT_FALSE(queue.TryPop(value));
+  EXPECT_FALSE(queue.TryPop(value));
+}
+
+TEST(SpscRingQueue, Fifo) {
+  Queue queue;
+  // Wraps around the first ring several times
+  for (std::size_t i = 0; i < 100; ++i) {
+    queue.Push(i);
+    queue.Push(i + 1);
+    std::size_t value{};
+    ASSERT_TRUE(queue.TryPop(value));
+    EXPECT_EQ(value, i);
+    ASSERT_TRUE(queue.TryPop(value));
+    EXPECT_EQ(value, i + 1);
+  }
+
+  std::size_t value{};
+  EXPECT_FALSE(queue.TryPop(value));
+}
+
+TEST(SpscRingQueue, Growth) {
+  constexpr std::size_t kCount = 1000;
+
+  Queue queue;
+  for (std::size_t i = 0; i < kCount; ++i) queue.Push(i);
+
+  for (std::size_t i = 0; i < kCount; ++i) {
+    std::size_t value{};
+    ASSERT_TRUE(queue.TryPop(value));
+    EXPECT_EQ(value, i);
+  }
+
+  std::size_t value{};
+  EXPECT_FALSE(queue.TryPop(value));
+}
+
+TEST(SpscRingQueue, Bulk) {
+  constexpr std::size_t kCount = 1000;
+
+  std::vector<std::size_t> input(kCount);
+  for (std::size_t i = 0; i < kCount; ++i) input[i] = i;
+
+  Queue queue;
+  queue.PushBulk(input.begin(), 10);
+  queue.PushBulk(input.begin() + 10, kCount - 10);
+
+  std::vector<std::size_t> output;
+  EXPECT_EQ(queue.TryPopBulk(std::back_inserter(output), 5), 5);
+  EXPECT_EQ(queue.TryPopBulk(std::back_inserter(output), kCount), kCount - 5);
+  EXPECT_EQ(queue.TryPopBulk(std::back_inserter(output), kCount), 0);
+  EXPECT_EQ(output, input);
+}
+
+TEST(SpscRingQueue, DestroysRemaining) {
+  auto item = std::make_shared<int>(42);
+  {
+    concurrent::impl::SpscRingQueue<std::shared_ptr<int>> queue;
+    for (std::size_t i = 0; i < 100; ++i) queue.Push(item);
+
+    std::shared_ptr<int> value;
+    ASSERT_TRUE(queue.TryPop(value));
+    EXPECT_EQ(value, item);
+  }
+  EXPECT_EQ(item.use_count(), 1);
+}
+
+TEST(SpscRingQueue, StressTest) {
+  Queue queue;
+
+  auto producer = std::async([&] {
+    std::vector<std::size_t> batch;
+    std::size_t i = 0;
+    while (i < kStressTestCount) {
+      if (i % 3 == 0) {
+        queue.Push(i++);
+        continue;
+      }
+
+      batch.clear();
+      for (std::size_t j = 0; j < 50 && i < kStressTestCount; ++j) {
+        batch.push_back(i++);
+      }
+      queue.PushBulk(batch.begin(), batch.size());
+    }
+  });
+
+  std::size_t expected = 0;
+  std::vector<std::size_t> batch;
+  while (expected < kStressTestCount) {
+    batch.clear();
+    if (expected % 2 == 0) {
+      std::size_t value{};
+      if (queue.TryPop(value)) batch.push_back(value);
+    } else {
+      queue.TryPopBulk(std::back_inserter(batch), 100);
+    }
+
+    for (const auto value : batch) {
+      ASSERT_EQ(value, expected);
+      ++expected;
+    }
+  }
+
+  producer.get();
+}
+
+USERVER_NAMESPACE_END
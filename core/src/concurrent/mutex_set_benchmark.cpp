@@ -2,6 +2,7 @@
 
 #include <array>
 #include <atomic>
+#include <shared_mutex>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -185,6 +186,52 @@ BENCHMARK_TEMPLATE(mutex_set_8ways_lock_unlock_contention, std::string)
     ->RangeMultiplier(2)
     ->Range(1, 8);
 
+// All the tasks read the same hot key
+template <typename T>
+void shared_mutex_set_lock_shared_hot_key(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    concurrent::SharedMutexSet<T> ms;
+
+    const std::size_t concurrent_jobs = state.range(0);
+    std::atomic<bool> keep_running{true};
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(concurrent_jobs);
+
+    for (std::size_t thread_id = 1; thread_id < concurrent_jobs; ++thread_id) {
+      tasks.push_back(engine::AsyncNoSpan([&] {
+        auto mutex = ms.GetMutexForKey(GetKeyForBenchmark<T>(0));
+
+        while (keep_running) {
+          std::shared_lock lock(mutex);
+          benchmark::DoNotOptimize(lock);
+        }
+      }));
+    }
+
+    {
+      auto mutex = ms.GetMutexForKey(GetKeyForBenchmark<T>(0));
+
+      for (auto _ : state) {
+        std::shared_lock lock(mutex);
+        benchmark::DoNotOptimize(lock);
+      }
+    }
+
+    keep_running = false;
+
+    for (auto& task : tasks) {
+      task.Get();
+    }
+  });
+}
+
+BENCHMARK_TEMPLATE(shared_mutex_set_lock_shared_hot_key, int)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+BENCHMARK_TEMPLATE(shared_mutex_set_lock_shared_hot_key, std::string)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+
 }  // namespace
 
 USERVER_NAMESPACE_END
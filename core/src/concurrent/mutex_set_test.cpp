@@ -1,5 +1,9 @@
 #include <userver/utest/utest.hpp>
 
+#include <array>
+#include <atomic>
+#include <shared_mutex>
+
 #include <userver/concurrent/mutex_set.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/utils/async.hpp>
@@ -147,4 +151,120 @@ UTEST_MT(MutexSet, HighContention, 4) {
   }
 }
 
+UTEST(SharedMutexSet, SharedAndExclusive) {
+  concurrent::SharedMutexSet<int> ms;
+  auto m1 = ms.GetMutexForKey(1);
+  auto m1_again = ms.GetMutexForKey(1);
+  auto m2 = ms.GetMutexForKey(2);
+
+  ASSERT_TRUE(m1.try_lock_shared());
+  EXPECT_TRUE(m1_again.try_lock_shared());
+  EXPECT_FALSE(m1_again.try_lock());
+  EXPECT_FALSE(m1_again.try_lock_for(std::chrono::milliseconds{10}));
+  EXPECT_TRUE(m2.try_lock());
+
+  m1.unlock_shared();
+  EXPECT_FALSE(m1_again.try_lock());
+  m1_again.unlock_shared();
+
+  EXPECT_TRUE(m1.try_lock());
+  EXPECT_FALSE(m1_again.try_lock_shared());
+  EXPECT_FALSE(m1_again.try_lock_shared_until(
+      std::chrono::steady_clock::now() + std::chrono::milliseconds{10}));
+  m1.unlock();
+  m2.unlock();
+}
+
+UTEST(SharedMutexSet, WriterPriority) {
+  concurrent::SharedMutexSet<int> ms;
+  auto mutex = ms.GetMutexForKey(1);
+  std::shared_lock reader_lock(mutex);
+
+  auto writer = engine::AsyncNoSpan([&ms] {
+    auto mutex = ms.GetMutexForKey(1);
+    std::unique_lock lock(mutex);
+  });
+  engine::Yield();
+  engine::Yield();
+  EXPECT_FALSE(writer.IsFinished());
+
+  // A waiting writer blocks the new readers
+  EXPECT_FALSE(ms.GetMutexForKey(1).try_lock_shared());
+
+  reader_lock.unlock();
+  writer.Get();
+  EXPECT_TRUE(ms.GetMutexForKey(1).try_lock_shared());
+  ms.GetMutexForKey(1).unlock_shared();
+}
+
+UTEST(SharedMutexSet, WriterTimeoutWakesReaders) {
+  concurrent::SharedMutexSet<int> ms;
+  auto mutex = ms.GetMutexForKey(1);
+  std::shared_lock reader_lock(mutex);
+
+  auto writer = engine::AsyncNoSpan([&ms] {
+    return ms.GetMutexForKey(1).try_lock_for(std::chrono::milliseconds{50});
+  });
+  engine::Yield();
+
+  auto reader = engine::AsyncNoSpan([&ms] {
+    auto mutex = ms.GetMutexForKey(1);
+    std::shared_lock lock(mutex);
+  });
+
+  EXPECT_FALSE(writer.Get());
+  reader.Get();
+}
+
+UTEST(SharedMutexSet, Sample) {
+  /// [Sample shared mutex set usage]
+  concurrent::SharedMutexSet<std::string> ms;
+  auto m1 = ms.GetMutexForKey("1");
+  auto m1_again = ms.GetMutexForKey("1");
+
+  {
+    std::shared_lock lock_first(m1);
+    // Readers of the same key do not block each other
+    std::shared_lock lock_second(m1_again);
+
+    // ...but block the writers
+    EXPECT_FALSE(ms.GetMutexForKey("1").try_lock());
+  }
+
+  std::unique_lock lock(m1_again);
+  /// [Sample shared mutex set usage]
+}
+
+UTEST_MT(SharedMutexSet, HighContention, 4) {
+  const auto concurrent_jobs = GetThreadCount();
+  constexpr std::size_t kKeysCount = 4;
+  concurrent::SharedMutexSet<std::size_t> ms;
+  std::array<std::atomic<int>, kKeysCount> writers{};
+
+  std::vector<engine::Task> tasks;
+  tasks.reserve(concurrent_jobs);
+
+  for (std::size_t thread_no = 0; thread_no < concurrent_jobs; ++thread_no) {
+    tasks.push_back(engine::AsyncNoSpan([&, thread_no]() {
+      constexpr std::size_t kIterations = 1024;
+      for (std::size_t z = 0; z < kIterations; ++z) {
+        const auto key = z % kKeysCount;
+        auto mutex = ms.GetMutexForKey(key);
+        if ((z + thread_no) % 4 == 0) {
+          std::unique_lock lock(mutex);
+          EXPECT_EQ(1, ++writers[key]);
+          --writers[key];
+        } else {
+          std::shared_lock lock(mutex);
+          EXPECT_EQ(0, writers[key].load());
+        }
+      }
+    }));
+  }
+
+  for (auto& task : tasks) {
+    task.Wait();
+  }
+}
+
 USERVER_NAMESPACE_END
@@ -1,6 +1,8 @@
 #include <userver/concurrent/queue.hpp>
 
+#include <algorithm>
 #include <optional>
+#include <vector>
 
 #include <userver/engine/mutex.hpp>
 #include <userver/utils/async.hpp>
@@ -28,6 +30,9 @@ auto GetProducerTask(const Producer& producer, std::size_t i) {
 template <typename T>
 class NonCoroutineTest : public ::testing::Test {};
 
+template <typename T>
+class QueueBatch : public ::testing::Test {};
+
 using TestMpmcTypes =
     testing::Types<concurrent::NonFifoMpmcQueue<int>,
                    concurrent::NonFifoMpmcQueue<std::unique_ptr<int>>,
@@ -80,6 +85,76 @@ TYPED_TEST(NonCoroutineTest, PushPopNoblock) {
   EXPECT_EQ(value, 2);
 }
 
+TYPED_UTEST_SUITE(QueueBatch, TestQueueTypes);
+
+TYPED_UTEST(QueueBatch, PushPop) {
+  auto queue = TypeParam::Create();
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  std::vector<std::size_t> input{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  EXPECT_EQ(producer.PushBatch(input.begin(), input.end()), input.size());
+  EXPECT_EQ(queue->GetSizeApproximate(), input.size());
+
+  std::vector<std::size_t> output;
+  EXPECT_EQ(consumer.PopBatch(output, 4), 4);
+  EXPECT_EQ(consumer.PopBatch(output, 100), 6);
+  EXPECT_EQ(consumer.PopBatchNoblock(output, 100), 0);
+  EXPECT_EQ(output, input);
+  EXPECT_EQ(queue->GetSizeApproximate(), 0);
+}
+
+TYPED_UTEST(QueueBatch, NoblockRespectsSoftMaxSize) {
+  auto queue = TypeParam::Create(3);
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  std::vector<std::size_t> input{0, 1, 2, 3, 4};
+  EXPECT_EQ(producer.PushBatchNoblock(input.begin(), input.end()), 3);
+  EXPECT_EQ(producer.PushBatchNoblock(input.begin() + 3, input.end()), 0);
+
+  std::vector<std::size_t> output;
+  EXPECT_EQ(consumer.PopBatchNoblock(output, 2), 2);
+  EXPECT_EQ(producer.PushBatchNoblock(input.begin() + 3, input.end()), 2);
+  EXPECT_EQ(consumer.PopBatchNoblock(output, 100), 3);
+  EXPECT_EQ(output, input);
+}
+
+TYPED_UTEST_MT(QueueBatch, BlocksWhileFull, 2) {
+  constexpr std::size_t kCount = 100;
+
+  auto queue = TypeParam::Create(7);
+  std::optional producer(queue->GetProducer());
+  auto consumer = queue->GetConsumer();
+
+  std::vector<std::size_t> input(kCount);
+  for (std::size_t i = 0; i < kCount; ++i) input[i] = i;
+
+  auto producer_task = utils::Async("producer", [&] {
+    EXPECT_EQ(producer->PushBatch(input.begin(), input.end()), kCount);
+    producer.reset();
+  });
+
+  std::vector<std::size_t> output;
+  while (consumer.PopBatch(output, 5) != 0) {
+    EXPECT_LE(queue->GetSizeApproximate(), 7);
+  }
+  producer_task.Get();
+
+  EXPECT_EQ(output.size(), kCount);
+  std::sort(output.begin(), output.end());
+  EXPECT_EQ(output, input);
+}
+
+TYPED_UTEST(QueueBatch, ConsumerIsDead) {
+  auto queue = TypeParam::Create();
+  auto producer = queue->GetProducer();
+  (void)(queue->GetConsumer());
+
+  std::vector<std::size_t> input{0, 1, 2};
+  EXPECT_EQ(producer.PushBatch(input.begin(), input.end()), 0);
+}
+
 UTEST(NonFifoMpmcQueue, ConsumerIsDead) {
   auto queue = concurrent::NonFifoMpmcQueue<int>::Create();
   auto producer = queue->GetProducer();
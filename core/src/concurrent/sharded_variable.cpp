@@ -0,0 +1,34 @@
+#include <userver/concurrent/sharded_variable.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include <engine/task/task_processor.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent::impl {
+
+namespace {
+
+std::atomic<std::size_t> next_foreign_thread_index{0};
+
+}  // namespace
+
+std::size_t GetCurrentShardIndex() noexcept {
+  const auto worker_index = engine::impl::GetCurrentWorkerIndex();
+  if (worker_index != engine::impl::kInvalidWorkerIndex) return worker_index;
+
+  thread_local const std::size_t foreign_thread_index =
+      next_foreign_thread_index.fetch_add(1, std::memory_order_relaxed);
+  return foreign_thread_index;
+}
+
+std::size_t GetDefaultShardCount() noexcept {
+  return std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+}  // namespace concurrent::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,60 @@
+#include <userver/concurrent/sharded_variable.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/statistics/relaxed_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Counter = utils::statistics::RelaxedCounter<std::uint64_t>;
+
+struct SingleCounter final {
+  Counter& GetLocal() noexcept { return counter; }
+
+  Counter counter;
+};
+
+template <typename Counters>
+void counter_increment(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    Counters counters;
+
+    const std::size_t concurrent_jobs = state.range(0);
+    std::atomic<bool> keep_running{true};
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(concurrent_jobs);
+
+    for (std::size_t i = 1; i < concurrent_jobs; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&] {
+        while (keep_running) ++counters.GetLocal();
+      }));
+    }
+
+    for (auto _ : state) ++counters.GetLocal();
+
+    keep_running = false;
+    for (auto& task : tasks) {
+      task.Get();
+    }
+  });
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(counter_increment, SingleCounter)
+    ->RangeMultiplier(2)
+    ->Range(1, 16);
+BENCHMARK_TEMPLATE(counter_increment, concurrent::ShardedVariable<Counter>)
+    ->RangeMultiplier(2)
+    ->Range(1, 16);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,85 @@
+#include <userver/concurrent/sharded_variable.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/statistics/relaxed_counter.hpp>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kThreads = 4;
+constexpr std::size_t kIterations = 10'000;
+
+using Counter = utils::statistics::RelaxedCounter<std::uint64_t>;
+
+std::uint64_t Sum(const concurrent::ShardedVariable<Counter>& counter) {
+  return counter.Combine(std::uint64_t{0},
+                         [](std::uint64_t sum, const Counter& shard) {
+                           return sum + shard.Load();
+                         });
+}
+
+}  // namespace
+
+UTEST(ShardedVariable, Sample) {
+  /// [Sample concurrent::ShardedVariable usage]
+  concurrent::ShardedVariable<utils::statistics::RelaxedCounter<std::uint64_t>>
+      requests;
+
+  // Hot path, touches the cache line of the current worker only
+  ++requests.GetLocal();
+  ++requests.GetLocal();
+
+  // Cold path, e.g. statistics dump
+  const auto total = requests.Combine(
+      std::uint64_t{0},
+      [](std::uint64_t sum, const auto& shard) { return sum + shard.Load(); });
+  /// [Sample concurrent::ShardedVariable usage]
+
+  EXPECT_EQ(total, 2);
+  EXPECT_GE(requests.GetShardCount(), 1);
+}
+
+UTEST_MT(ShardedVariable, ConcurrentIncrements, kThreads) {
+  concurrent::ShardedVariable<Counter> counter(kThreads * 2);
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < kThreads * 2; ++i) {
+    tasks.push_back(utils::Async("incrementer", [&counter] {
+      for (std::size_t j = 0; j < kIterations; ++j) {
+        ++counter.GetLocal();
+        if (j % 100 == 0) engine::Yield();
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_EQ(Sum(counter), kThreads * 2 * kIterations);
+
+  counter.VisitAll([](Counter& shard) { shard = 0; });
+  EXPECT_EQ(Sum(counter), 0);
+}
+
+UTEST(ShardedVariable, ForeignThreads) {
+  concurrent::ShardedVariable<Counter> counter(3);
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&counter] {
+      for (std::size_t j = 0; j < kIterations; ++j) ++counter.GetLocal();
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_EQ(Sum(counter), kThreads * kIterations);
+}
+
+USERVER_NAMESPACE_END
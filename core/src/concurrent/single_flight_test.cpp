@@ -0,0 +1,158 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <userver/concurrent/single_flight.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_use_event.hpp>
+#include <userver/engine/sleep.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(SingleFlight, Sample) {
+  /// [Sample single flight usage]
+  concurrent::SingleFlight<std::string, int> single_flight;
+
+  // Concurrent calls for "key" would wait for this one and get 42 as well
+  const auto value = single_flight.Do("key", [] { return 42; });
+  EXPECT_EQ(value, 42);
+  /// [Sample single flight usage]
+}
+
+UTEST(SingleFlight, Coalesces) {
+  constexpr std::size_t kWaiters = 5;
+  concurrent::SingleFlight<std::string, std::string> single_flight;
+  std::atomic<int> calls{0};
+  engine::SingleUseEvent allowed;
+
+  std::vector<engine::TaskWithResult<std::string>> tasks;
+  for (std::size_t i = 0; i < kWaiters; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      return single_flight.Do("key", [&] {
+        ++calls;
+        allowed.WaitNonCancellable();
+        return std::string{"value"};
+      });
+    }));
+  }
+  engine::Yield();
+  engine::Yield();
+
+  allowed.Send();
+  for (auto& task : tasks) EXPECT_EQ("value", task.Get());
+  EXPECT_EQ(1, calls);
+
+  // The finished call is forgotten
+  EXPECT_EQ("other", single_flight.Do("key", [] {
+    return std::string{"other"};
+  }));
+}
+
+UTEST(SingleFlight, DifferentKeys) {
+  concurrent::SingleFlight<int, int> single_flight;
+  engine::SingleUseEvent allowed;
+
+  auto blocked = engine::AsyncNoSpan([&] {
+    return single_flight.Do(1, [&] {
+      allowed.WaitNonCancellable();
+      return 1;
+    });
+  });
+  engine::Yield();
+
+  EXPECT_EQ(2, single_flight.Do(2, [] { return 2; }));
+  EXPECT_FALSE(blocked.IsFinished());
+
+  allowed.Send();
+  EXPECT_EQ(1, blocked.Get());
+}
+
+UTEST(SingleFlight, Exception) {
+  concurrent::SingleFlight<int, int> single_flight;
+  engine::SingleUseEvent allowed;
+
+  auto leader = engine::AsyncNoSpan([&] {
+    return single_flight.Do(1, [&]() -> int {
+      allowed.WaitNonCancellable();
+      throw std::runtime_error("failure");
+    });
+  });
+  engine::Yield();
+
+  auto waiter = engine::AsyncNoSpan(
+      [&] { return single_flight.Do(1, [] { return 1; }); });
+  engine::Yield();
+
+  allowed.Send();
+  UEXPECT_THROW(leader.Get(), std::runtime_error);
+  UEXPECT_THROW(waiter.Get(), std::runtime_error);
+}
+
+UTEST(SingleFlight, WaiterCancellation) {
+  concurrent::SingleFlight<int, int> single_flight;
+  engine::SingleUseEvent allowed;
+
+  auto leader = engine::AsyncNoSpan([&] {
+    return single_flight.Do(1, [&] {
+      allowed.WaitNonCancellable();
+      return 1;
+    });
+  });
+  engine::Yield();
+
+  auto waiter = engine::AsyncNoSpan(
+      [&] { return single_flight.Do(1, [] { return 2; }); });
+  engine::Yield();
+
+  waiter.RequestCancel();
+  UEXPECT_THROW(waiter.Get(), engine::WaitInterruptedException);
+
+  allowed.Send();
+  EXPECT_EQ(1, leader.Get());
+}
+
+UTEST(SingleFlight, LeaderCancellation) {
+  concurrent::SingleFlight<int, int> single_flight;
+
+  auto leader = engine::AsyncNoSpan([&] {
+    return single_flight.Do(1, []() -> int {
+      engine::InterruptibleSleepFor(utest::kMaxTestWaitTime);
+      throw std::runtime_error("interrupted");
+    });
+  });
+  engine::Yield();
+
+  auto waiter = engine::AsyncNoSpan(
+      [&] { return single_flight.Do(1, [] { return 2; }); });
+  engine::Yield();
+
+  // The waiter runs the function itself instead of getting the exception
+  leader.RequestCancel();
+  UEXPECT_THROW(leader.Get(), std::runtime_error);
+  EXPECT_EQ(2, waiter.Get());
+}
+
+UTEST_MT(SingleFlight, Stress, 4) {
+  constexpr int kKeys = 8;
+  concurrent::SingleFlight<int, int> single_flight;
+  std::atomic<bool> keep_running{true};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < GetThreadCount(); ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&, i] {
+      for (int j = 0; keep_running; ++j) {
+        const int key = (j + static_cast<int>(i)) % kKeys;
+        ASSERT_EQ(key * 10, single_flight.Do(key, [key] { return key * 10; }));
+      }
+    }));
+  }
+
+  engine::SleepFor(std::chrono::milliseconds{50});
+  keep_running = false;
+  for (auto& task : tasks) task.Get();
+}
+
+USERVER_NAMESPACE_END
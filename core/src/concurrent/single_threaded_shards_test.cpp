@@ -0,0 +1,151 @@
+#include <userver/concurrent/single_threaded_shards.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/async.hpp>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kShards = 4;
+
+using Pool = engine::SingleThreadedTaskProcessorsPool;
+
+struct ThreadChecked {
+  explicit ThreadChecked(std::size_t index)
+      : index(index), owner(std::this_thread::get_id()) {}
+
+  std::size_t index;
+  std::thread::id owner;
+};
+
+struct DestructionChecked {
+  explicit DestructionChecked(std::atomic<std::size_t>& foreign_destructions)
+      : foreign_destructions(foreign_destructions),
+        owner(std::this_thread::get_id()) {}
+
+  DestructionChecked(DestructionChecked&&) = default;
+
+  ~DestructionChecked() {
+    if (owner != std::this_thread::get_id()) ++foreign_destructions;
+  }
+
+  std::atomic<std::size_t>& foreign_destructions;
+  std::thread::id owner;
+};
+
+}  // namespace
+
+UTEST(SingleThreadedShards, Sample) {
+  auto pool = Pool::MakeForTests(kShards);
+
+  /// [Sample concurrent::SingleThreadedShards usage]
+  // No locks: each map is touched only by the thread of its shard
+  using Balances = std::unordered_map<std::string, std::int64_t>;
+  concurrent::SingleThreadedShards<Balances> balances{
+      pool, [](std::size_t /*shard_index*/) { return Balances{}; }};
+
+  const std::string account = "alice";
+  balances
+      .SubmitByKey(account,
+                   [&account](Balances& shard) { shard[account] += 100; })
+      .Get();
+
+  const auto balance =
+      balances
+          .SubmitByKey(account,
+                       [&account](Balances& shard) { return shard[account]; })
+          .Get();
+  /// [Sample concurrent::SingleThreadedShards usage]
+
+  EXPECT_EQ(balance, 100);
+  EXPECT_EQ(balances.GetShardCount(), kShards);
+}
+
+UTEST(SingleThreadedShards, StateStaysOnItsThread) {
+  auto pool = Pool::MakeForTests(kShards);
+  concurrent::SingleThreadedShards<ThreadChecked> shards{
+      pool, [](std::size_t index) { return ThreadChecked{index}; }};
+
+  for (std::size_t i = 0; i < kShards * 10; ++i) {
+    const auto shard_index = i % kShards;
+    shards
+        .SubmitTo(shard_index,
+                  [shard_index](ThreadChecked& state) {
+                    EXPECT_EQ(state.index, shard_index);
+                    EXPECT_EQ(state.owner, std::this_thread::get_id());
+                  })
+        .Get();
+  }
+}
+
+UTEST(SingleThreadedShards, StateIsDestroyedOnItsThread) {
+  auto pool = Pool::MakeForTests(kShards);
+  std::atomic<std::size_t> foreign_destructions{0};
+  engine::TaskWithResult<void> task;
+  {
+    concurrent::SingleThreadedShards<DestructionChecked> shards{
+        pool, [&foreign_destructions](std::size_t) {
+          return DestructionChecked{foreign_destructions};
+        }};
+    task = shards.SubmitTo(0, [](DestructionChecked&) {
+      engine::SleepFor(std::chrono::milliseconds{10});
+    });
+  }
+
+  // The destructor waits for the submitted tasks
+  EXPECT_TRUE(task.IsFinished());
+  EXPECT_EQ(foreign_destructions, 0);
+}
+
+UTEST(SingleThreadedShards, KeysAreSpread) {
+  auto pool = Pool::MakeForTests(kShards);
+  concurrent::SingleThreadedShards<int> shards{
+      pool, [](std::size_t) { return 0; }};
+
+  std::vector<std::size_t> per_shard(kShards, 0);
+  for (std::uint64_t key = 0; key < 1000; ++key) {
+    const auto index = shards.GetShardIndex(key);
+    ASSERT_LT(index, kShards);
+    EXPECT_EQ(index, shards.GetShardIndex(key));
+    ++per_shard[index];
+  }
+  for (const auto count : per_shard) EXPECT_GT(count, 1000 / kShards / 2);
+}
+
+UTEST_MT(SingleThreadedShards, ConcurrentSubmits, 4) {
+  constexpr std::uint64_t kKeys = 1000;
+  auto pool = Pool::MakeForTests(kShards);
+  concurrent::SingleThreadedShards<std::uint64_t> sums{
+      pool, [](std::size_t) { return std::uint64_t{0}; }};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < 4; ++i) {
+    tasks.push_back(utils::Async("submitter", [&sums] {
+      for (std::uint64_t key = 0; key < kKeys; ++key) {
+        sums.SubmitByKey(key, [key](std::uint64_t& sum) { sum += key; }).Get();
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  const auto results =
+      sums.InvokeOnAll([](const std::uint64_t& sum) { return sum; });
+  ASSERT_EQ(results.size(), kShards);
+  EXPECT_EQ(std::accumulate(results.begin(), results.end(), std::uint64_t{0}),
+            4 * kKeys * (kKeys - 1) / 2);
+}
+
+USERVER_NAMESPACE_END
@@ -8,6 +8,7 @@
 #include <userver/components/component.hpp>
 #include <userver/components/statistics_storage.hpp>
 #include <userver/concurrent/async_event_channel.hpp>
+#include <userver/concurrent/variable.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/dynamic_config/value.hpp>
 #include <userver/hostinfo/cpu_limit.hpp>
@@ -58,6 +59,27 @@ formats::json::Value FormatStats(const Controller& c, size_t activated_factor) {
   return builder.ExtractValue();
 }
 
+// Applies the limits of a controller to several limiters
+class LimiterGroup final : public Limiter {
+ public:
+  explicit LimiterGroup(Limiter& main_limiter) : main_limiter_(main_limiter) {}
+
+  void Add(Limiter& limiter) {
+    auto limiters = limiters_.Lock();
+    limiters->push_back(&limiter);
+  }
+
+  void SetLimit(const Limit& new_limit) override {
+    main_limiter_.SetLimit(new_limit);
+    auto limiters = limiters_.Lock();
+    for (auto* limiter : *limiters) limiter->SetLimit(new_limit);
+  }
+
+ private:
+  Limiter& main_limiter_;
+  concurrent::Variable<std::vector<Limiter*>, std::mutex> limiters_;
+};
+
 }  // namespace
 
 struct Component::Impl {
@@ -65,6 +87,7 @@ struct Component::Impl {
   server::Server& server;
   server::congestion_control::Sensor server_sensor;
   server::congestion_control::Limiter server_limiter;
+  LimiterGroup server_limiters;
   Controller server_controller;
 
   utils::statistics::Entry statistics_holder;
@@ -82,6 +105,7 @@ struct Component::Impl {
         server(server),
         server_sensor(server, tp),
         server_limiter(server),
+        server_limiters(server_limiter),
         server_controller(kServerControllerName, dynamic_config),
         fake_mode(fake_mode) {}
 };
@@ -119,7 +143,7 @@ Component::Component(const components::ComponentConfig& config,
                      "is enforced";
   }
 
-  pimpl_->wd.Register({pimpl_->server_sensor, pimpl_->server_limiter,
+  pimpl_->wd.Register({pimpl_->server_sensor, pimpl_->server_limiters,
                        pimpl_->server_controller});
 
   pimpl_->config_subscription = pimpl_->dynamic_config.UpdateAndListen(
@@ -165,6 +189,10 @@ void Component::OnAllComponentsLoaded() {
 
 void Component::OnAllComponentsAreStopping() { pimpl_->wd.Stop(); }
 
+void Component::RegisterLimiter(Limiter& limiter) {
+  pimpl_->server_limiters.Add(limiter);
+}
+
 formats::json::Value Component::ExtendStatistics(
     const utils::statistics::StatisticsRequest& /*request*/) {
   formats::json::ValueBuilder builder{formats::common::Type::kObject};
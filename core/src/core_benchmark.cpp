@@ -1,8 +1,62 @@
 #include <benchmark/benchmark.h>
 
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include <ubench/allocations.hpp>
+#include <ubench/shared_engine.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/text.hpp>
 #include <utils/impl/static_registration.hpp>
 
+namespace {
+
+// Comma separated CPUs and CPU ranges, e.g. "0-3,6"
+constexpr std::string_view kCpusEnv = "USERVER_BENCHMARK_CPUS";
+// Any non-empty value enables the allocs_per_iter counter
+constexpr std::string_view kCountAllocationsEnv =
+    "USERVER_BENCHMARK_COUNT_ALLOCATIONS";
+
+const char* GetEnv(std::string_view name) {
+  const char* value = std::getenv(name.data());
+  return value && *value ? value : nullptr;
+}
+
+// The engine threads are started later and inherit the affinity
+void PinToCpus(const std::string& cpus) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const auto& range : USERVER_NAMESPACE::utils::text::Split(cpus, ",")) {
+    const auto dash_pos = range.find('-');
+    const auto first = USERVER_NAMESPACE::utils::FromString<int>(
+        range.substr(0, dash_pos));
+    const auto last =
+        dash_pos == std::string::npos
+            ? first
+            : USERVER_NAMESPACE::utils::FromString<int>(
+                  range.substr(dash_pos + 1));
+    for (int cpu = first; cpu <= last; ++cpu) CPU_SET(cpu, &set);
+  }
+  if (::sched_setaffinity(0, sizeof(set), &set) != 0) {
+    throw std::runtime_error("sched_setaffinity failed for CPUs " + cpus);
+  }
+#else
+  throw std::runtime_error("Pinning to CPUs " + cpus +
+                           " is supported on Linux only");
+#endif
+}
+
+}  // namespace
+
 int main(int argc, char** argv) {
   USERVER_NAMESPACE::utils::impl::FinishStaticRegistration();
 
@@ -11,5 +65,20 @@ int main(int argc, char** argv) {
 
   ::benchmark::Initialize(&argc, argv);
   if (::benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+  if (const auto* cpus = GetEnv(kCpusEnv)) {
+    try {
+      PinToCpus(cpus);
+    } catch (const std::exception& ex) {
+      std::cerr << "Bad " << kCpusEnv << ": " << ex.what() << '\n';
+      return 1;
+    }
+    ::benchmark::AddCustomContext("userver_cpus", cpus);
+  }
+  if (GetEnv(kCountAllocationsEnv)) {
+    USERVER_NAMESPACE::ubench::RegisterAllocationsCounter();
+  }
+
   ::benchmark::RunSpecifiedBenchmarks();
+  USERVER_NAMESPACE::ubench::DestroySharedEngine();
 }
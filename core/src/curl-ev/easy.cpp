@@ -145,6 +145,11 @@ easy* easy::from_native(native::CURL* native_easy) {
   return easy_handle;
 }
 
+void easy::SetMulti(multi& multi_handle) {
+  UASSERT(!multi_registered_);
+  multi_ = &multi_handle;
+}
+
 engine::ev::ThreadControl& easy::GetThreadControl() {
   return multi_->GetThreadControl();
 }
@@ -214,6 +219,18 @@ void easy::cancel(size_t request_num) {
   }
 }
 
+void easy::unpause() {
+  UASSERT(multi_);
+  multi_->GetThreadControl().RunInEvLoopAsync([self = shared_from_this()] {
+    // The transfer may be already finished, e.g. by a timeout
+    if (!self->multi_registered_) return;
+    const auto code = native::curl_easy_pause(self->handle_, CURLPAUSE_CONT);
+    if (code != native::CURLE_OK) {
+      LOG_WARNING() << "curl_easy_pause failed with code " << code;
+    }
+  });
+}
+
 void easy::do_ev_cancel(size_t request_num) {
   // RunInEvLoopAsync(do_ev_async_perform) and RunInEvLoopSync(do_ev_cancel) are
   // not synchronized. So we need to count last cancelled request to prevent its
@@ -233,12 +250,14 @@ void easy::reset() {
 
   orig_url_str_.clear();
   std::string{}.swap(post_fields_);  // forced memory freeing
+  post_read_function_ = false;
   form_.reset();
   if (headers_) headers_->clear();
   if (proxy_headers_) proxy_headers_->clear();
   if (http200_aliases_) http200_aliases_->clear();
   if (resolved_hosts_) resolved_hosts_->clear();
-  share_.reset();
+  // curl_easy_reset() does not detach the share
+  if (share_) set_share(nullptr);
   retries_count_ = 0;
   sockets_opened_ = 0;
   rate_limit_error_.clear();
@@ -344,6 +363,7 @@ void easy::set_post_fields(std::string&& post_fields) {
 
 void easy::set_post_fields(std::string&& post_fields, std::error_code& ec) {
   post_fields_ = std::move(post_fields);
+  post_read_function_ = false;
   ec =
       std::error_code{static_cast<errc::EasyErrorCode>(native::curl_easy_setopt(
           handle_, native::CURLOPT_POSTFIELDS, post_fields_.c_str()))};
@@ -353,6 +373,29 @@ void easy::set_post_fields(std::string&& post_fields, std::error_code& ec) {
         static_cast<native::curl_off_t>(post_fields_.length()), ec);
 }
 
+void easy::set_post_read_function(read_function_t function, void* data,
+                                  std::optional<native::curl_off_t> size) {
+  std::error_code ec;
+  set_post_read_function(function, data, size, ec);
+  throw_error(ec, "set_post_read_function");
+}
+
+void easy::set_post_read_function(read_function_t function, void* data,
+                                  std::optional<native::curl_off_t> size,
+                                  std::error_code& ec) {
+  std::string{}.swap(post_fields_);
+  form_.reset();
+  post_read_function_ = true;
+
+  set_post(true, ec);
+  if (!ec) set_post_fields(static_cast<void*>(nullptr), ec);
+  if (!ec) set_http_post(nullptr, ec);
+  if (!ec) set_read_function(function, ec);
+  if (!ec) set_read_data(data, ec);
+  // -1 makes libcurl send the body with Transfer-Encoding: chunked
+  if (!ec) set_post_field_size_large(size.value_or(-1), ec);
+}
+
 void easy::set_http_post(std::shared_ptr<form> form) {
   std::error_code ec;
   set_http_post(std::move(form), ec);
@@ -591,7 +634,7 @@ void easy::set_share(std::shared_ptr<share> share) {
 void easy::set_share(std::shared_ptr<share> share, std::error_code& ec) {
   share_ = std::move(share);
 
-  if (share) {
+  if (share_) {
     ec = std::error_code{
         static_cast<errc::EasyErrorCode>(native::curl_easy_setopt(
             handle_, native::CURLOPT_SHARE, share_->native_handle()))};
@@ -601,7 +644,9 @@ void easy::set_share(std::shared_ptr<share> share, std::error_code& ec) {
   }
 }
 
-bool easy::has_post_data() const { return !post_fields_.empty() || form_; }
+bool easy::has_post_data() const {
+  return !post_fields_.empty() || form_ || post_read_function_;
+}
 
 const std::string& easy::get_post_data() const { return post_fields_; }
 
@@ -641,6 +686,20 @@ clients::http::LocalStats easy::get_local_stats() {
 
 std::error_code easy::rate_limit_error() const { return rate_limit_error_; }
 
+std::optional<ConnectRateLimiter::WaitTicket> easy::wait_rate_limit(
+    ConnectRateLimiter::Duration time_left) {
+  if (!multi_ || !rate_limit_error_) return std::nullopt;
+
+  std::error_code ec;
+  const auto url = get_effective_url(ec);
+  if (ec) return std::nullopt;
+
+  // The effective URL is null terminated
+  auto ticket = multi_->WaitRateLimit(url.data(), rate_limit_error_, time_left);
+  if (ticket) rate_limit_error_.clear();
+  return ticket;
+}
+
 easy::time_point::duration easy::time_to_start() const {
   if (start_performing_ts_ != time_point{}) {
     return start_performing_ts_ - construct_ts_;
@@ -170,6 +170,10 @@ class easy final : public std::enable_shared_from_this<easy> {
 
   const multi* GetMulti() const { return multi_; }
 
+  // Moves the easy that is not performing to another multi, the connections
+  // are taken from the connection cache of that multi.
+  void SetMulti(multi& multi_handle);
+
   inline native::CURL* native_handle() { return handle_; }
   engine::ev::ThreadControl& GetThreadControl();
 
@@ -178,6 +182,9 @@ class easy final : public std::enable_shared_from_this<easy> {
   void async_perform(handler_type handler);
   void cancel();
   void reset();
+  // Resumes the transfer paused by CURL_READFUNC_PAUSE, may be called from
+  // any thread
+  void unpause();
   void set_source(std::shared_ptr<std::istream> source);
   void set_source(std::shared_ptr<std::istream> source, std::error_code& ec);
   void set_sink(std::string* sink);
@@ -391,6 +398,13 @@ class easy final : public std::enable_shared_from_this<easy> {
   void set_post_fields(std::string&& post_fields);
   void set_post_fields(std::string&& post_fields, std::error_code& ec);
   IMPLEMENT_CURL_OPTION(set_post_fields, native::CURLOPT_POSTFIELDS, void*);
+  // The body is read by the function as the transfer goes, the chunked
+  // transfer encoding is used if the size is unknown
+  void set_post_read_function(read_function_t function, void* data,
+                              std::optional<native::curl_off_t> size);
+  void set_post_read_function(read_function_t function, void* data,
+                              std::optional<native::curl_off_t> size,
+                              std::error_code& ec);
   IMPLEMENT_CURL_OPTION(set_post_field_size, native::CURLOPT_POSTFIELDSIZE,
                         long);
   IMPLEMENT_CURL_OPTION(set_post_field_size_large,
@@ -460,6 +474,8 @@ class easy final : public std::enable_shared_from_this<easy> {
   };
   IMPLEMENT_CURL_OPTION_ENUM(set_http_version, native::CURLOPT_HTTP_VERSION,
                              http_version_t, long);
+  // wait for a connection that may be multiplexed instead of opening a new one
+  IMPLEMENT_CURL_OPTION_BOOLEAN(set_pipewait, native::CURLOPT_PIPEWAIT);
   IMPLEMENT_CURL_OPTION_BOOLEAN(set_ignore_content_length,
                                 native::CURLOPT_IGNORE_CONTENT_LENGTH);
   IMPLEMENT_CURL_OPTION_BOOLEAN(set_http_content_decoding,
@@ -737,6 +753,10 @@ class easy final : public std::enable_shared_from_this<easy> {
   clients::http::LocalStats get_local_stats();
 
   std::error_code rate_limit_error() const;
+  // For the transfer failed by the connect rate limit, returns the ticket to
+  // perform it again after a delay and forgets the error
+  std::optional<ConnectRateLimiter::WaitTicket> wait_rate_limit(
+      ConnectRateLimiter::Duration time_left);
 
   time_point::duration time_to_start() const;
 
@@ -780,6 +800,7 @@ class easy final : public std::enable_shared_from_this<easy> {
   std::shared_ptr<std::istream> source_;
   std::string* sink_{nullptr};
   std::string post_fields_;
+  bool post_read_function_{false};
   std::shared_ptr<form> form_;
   std::shared_ptr<string_list> headers_;
   std::shared_ptr<string_list> proxy_headers_;
@@ -37,6 +37,8 @@ const char* GetSetterName(native::CURLMoption option) {
       return "SetMaxHostConnections";
     case native::CURLMOPT_MAXCONNECTS:
       return "SetConnectionCacheSize";
+    case native::CURLMOPT_MAX_CONCURRENT_STREAMS:
+      return "SetMaxConcurrentStreams";
     default:
       return "<unknown setter>";
   }
@@ -139,8 +141,21 @@ void multi::CheckRateLimit(const char* url_str, std::error_code& ec) {
   connect_rate_limiter_->Check(url_str, ec);
 }
 
+std::optional<ConnectRateLimiter::WaitTicket> multi::WaitRateLimit(
+    const char* url_str, std::error_code ec,
+    ConnectRateLimiter::Duration time_left) {
+  auto ticket = connect_rate_limiter_->Wait(url_str, ec, time_left);
+  if (ticket) {
+    Statistics().mark_socket_ratelimit_queued();
+  } else {
+    Statistics().mark_socket_ratelimit_rejected();
+  }
+  return ticket;
+}
+
 void multi::SetMultiplexingEnabled(bool value) {
-  SetOptionAsync(native::CURLMOPT_PIPELINING, value ? 1 : 0);
+  SetOptionAsync(native::CURLMOPT_PIPELINING,
+                 value ? CURLPIPE_MULTIPLEX : CURLPIPE_NOTHING);
 }
 
 void multi::SetMaxHostConnections(long value) {
@@ -151,6 +166,10 @@ void multi::SetConnectionCacheSize(long value) {
   SetOptionAsync(native::CURLMOPT_MAXCONNECTS, value);
 }
 
+void multi::SetMaxConcurrentStreams(long value) {
+  SetOptionAsync(native::CURLMOPT_MAX_CONCURRENT_STREAMS, value);
+}
+
 void multi::add_handle(native::CURL* native_easy) {
   std::error_code ec{static_cast<errc::MultiErrorCode>(
       native::curl_multi_add_handle(handle_, native_easy))};
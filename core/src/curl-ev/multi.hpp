@@ -11,6 +11,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 
 #include <curl-ev/error_code.hpp>
@@ -53,10 +54,15 @@ class multi final {
   MultiStatistics& Statistics() { return statistics_; }
 
   void CheckRateLimit(const char* url_str, std::error_code& ec);
+  std::optional<ConnectRateLimiter::WaitTicket> WaitRateLimit(
+      const char* url_str, std::error_code ec,
+      ConnectRateLimiter::Duration time_left);
 
   void SetMultiplexingEnabled(bool);
   void SetMaxHostConnections(long);
   void SetConnectionCacheSize(long);
+  // HTTP/2 streams per connection, new connections are opened over the limit
+  void SetMaxConcurrentStreams(long);
 
  private:
   void add_handle(native::CURL* native_easy);
@@ -14,6 +14,12 @@ void MultiStatistics::mark_close_socket() { close_++; }
 
 void MultiStatistics::mark_socket_ratelimited() { ratelimited_++; }
 
+void MultiStatistics::mark_socket_ratelimit_queued() { ratelimit_queued_++; }
+
+void MultiStatistics::mark_socket_ratelimit_rejected() {
+  ratelimit_rejected_++;
+}
+
 long long MultiStatistics::open_socket_total() const { return open_.load(); }
 
 long long MultiStatistics::close_socket_total() const { return close_.load(); }
@@ -22,6 +28,14 @@ long long MultiStatistics::socket_ratelimited_total() const {
   return ratelimited_.load();
 }
 
+long long MultiStatistics::socket_ratelimit_queued_total() const {
+  return ratelimit_queued_.load();
+}
+
+long long MultiStatistics::socket_ratelimit_rejected_total() const {
+  return ratelimit_rejected_.load();
+}
+
 utils::statistics::BusyStorage& MultiStatistics::get_busy_storage() {
   return busy_storage_;
 }
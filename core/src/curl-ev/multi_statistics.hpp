@@ -16,10 +16,15 @@ class MultiStatistics final {
   void mark_open_socket();
   void mark_close_socket();
   void mark_socket_ratelimited();
+  // the throttled connect will be attempted again or has failed
+  void mark_socket_ratelimit_queued();
+  void mark_socket_ratelimit_rejected();
 
   long long open_socket_total() const;
   long long close_socket_total() const;
   long long socket_ratelimited_total() const;
+  long long socket_ratelimit_queued_total() const;
+  long long socket_ratelimit_rejected_total() const;
 
   utils::statistics::BusyStorage& get_busy_storage();
   const utils::statistics::BusyStorage& get_busy_storage() const;
@@ -28,6 +33,8 @@ class MultiStatistics final {
   std::atomic_llong open_{0};
   std::atomic_llong close_{0};
   std::atomic_llong ratelimited_{0};
+  std::atomic_llong ratelimit_queued_{0};
+  std::atomic_llong ratelimit_rejected_{0};
   utils::statistics::BusyStorage busy_storage_;
 };
 
@@ -4,6 +4,7 @@
 
 #include <curl-ev/url.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/utils/rand.hpp>
 #include <userver/utils/str_icase.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -52,12 +53,32 @@ ThrottleFactors ExtractThrottleFactors(const char* url_str) {
 
 }  // namespace
 
+// The time left to the deadlines of the waiting connects
+struct ConnectRateLimiter::HostWaiters {
+  std::mutex mutex;
+  std::multiset<Duration> time_left;
+};
+
+ConnectRateLimiter::WaitTicket::WaitTicket(
+    std::shared_ptr<HostWaiters> waiters, std::multiset<Duration>::iterator it,
+    Duration delay)
+    : waiters_(std::move(waiters)), it_(it), delay_(delay) {}
+
+ConnectRateLimiter::WaitTicket::~WaitTicket() {
+  if (!waiters_) return;
+  const std::lock_guard lock{waiters_->mutex};
+  waiters_->time_left.erase(it_);
+}
+
 ConnectRateLimiter::ConnectRateLimiter()
     : global_http_(utils::TokenBucket::MakeUnbounded()),
       global_https_(utils::TokenBucket::MakeUnbounded()),
       per_host_limit_(-1UL),
       per_host_rate_(utils::TokenBucket::Duration::zero()),
-      by_host_(kByHostThrottleLruSize) {
+      by_host_(kByHostThrottleLruSize),
+      max_wait_(std::chrono::milliseconds::zero()),
+      max_waiting_per_host_(0),
+      waiters_by_host_(kByHostThrottleLruSize) {
   static_assert(decltype(per_host_limit_)::is_always_lock_free,
                 "limit type is not lock-free atomic");
   static_assert(decltype(per_host_rate_)::is_always_lock_free,
@@ -82,6 +103,12 @@ void ConnectRateLimiter::SetPerHostLimits(size_t limit,
   per_host_rate_.store(rate, std::memory_order_relaxed);
 }
 
+void ConnectRateLimiter::SetWaitLimits(std::chrono::milliseconds max_wait,
+                                       size_t max_waiting_per_host) {
+  max_wait_.store(max_wait, std::memory_order_relaxed);
+  max_waiting_per_host_.store(max_waiting_per_host, std::memory_order_relaxed);
+}
+
 void ConnectRateLimiter::Check(const char* url_str, std::error_code& ec) {
   static constexpr std::string_view kHttpsScheme = "https";
 
@@ -124,6 +151,56 @@ void ConnectRateLimiter::Check(const char* url_str, std::error_code& ec) {
   ec = errc::RateLimitErrorCode::kSuccess;
 }
 
+std::optional<ConnectRateLimiter::WaitTicket> ConnectRateLimiter::Wait(
+    const char* url_str, std::error_code ec, Duration time_left) {
+  static constexpr std::string_view kHttpsScheme = "https";
+
+  const auto max_wait = max_wait_.load(std::memory_order_relaxed);
+  if (max_wait == std::chrono::milliseconds::zero()) return std::nullopt;
+
+  const auto factors = ExtractThrottleFactors(url_str);
+  if (!factors.host_ptr) return std::nullopt;
+
+  // A token of the bucket that rejected the connect is expected after
+  // its refill interval
+  Duration interval{};
+  if (ec == errc::RateLimitErrorCode::kPerHostSocketLimit) {
+    interval = per_host_rate_.load(std::memory_order_relaxed);
+  } else if (ec == errc::RateLimitErrorCode::kGlobalSocketLimit) {
+    const bool is_https =
+        factors.scheme_ptr &&
+        utils::StrIcaseEqual{}(factors.scheme_ptr.get(), kHttpsScheme);
+    interval = (is_https ? global_https_ : global_http_)
+                   .GetRefillIntervalApprox();
+  } else {
+    return std::nullopt;
+  }
+
+  std::shared_ptr<HostWaiters> waiters;
+  {
+    auto locked = waiters_by_host_.UniqueLock();
+    auto* found = locked->Emplace(factors.host_ptr.get(), nullptr);
+    if (!*found) *found = std::make_shared<HostWaiters>();
+    waiters = *found;
+  }
+
+  const std::lock_guard lock{waiters->mutex};
+  auto& queue = waiters->time_left;
+  if (queue.size() >= max_waiting_per_host_.load(std::memory_order_relaxed)) {
+    return std::nullopt;
+  }
+
+  // The waiters with the closer deadlines go first, the jitter spreads the
+  // connects of the waiters with the same deadline
+  const auto position =
+      std::distance(queue.begin(), queue.lower_bound(time_left));
+  auto delay = interval * (position + 1);
+  delay += Duration{utils::RandRange(interval.count() / 2 + 1)};
+  if (delay > max_wait || delay >= time_left) return std::nullopt;
+
+  return WaitTicket{waiters, queue.insert(time_left), delay};
+}
+
 }  // namespace curl
 
 USERVER_NAMESPACE_END
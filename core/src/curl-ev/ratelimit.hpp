@@ -1,7 +1,11 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <set>
 #include <string>
 
 #include <curl-ev/error_code.hpp>
@@ -14,7 +18,32 @@ USERVER_NAMESPACE_BEGIN
 namespace curl {
 
 class ConnectRateLimiter {
+  struct HostWaiters;
+
  public:
+  using Duration = utils::TokenBucket::Duration;
+
+  // A connect delayed by the limits, it is in the wait queue of its host
+  // while the ticket is alive
+  class WaitTicket final {
+   public:
+    WaitTicket(WaitTicket&&) noexcept = default;
+    WaitTicket& operator=(WaitTicket&&) = delete;
+    ~WaitTicket();
+
+    // The connect should be attempted again after the delay
+    Duration GetDelay() const { return delay_; }
+
+   private:
+    friend class ConnectRateLimiter;
+    WaitTicket(std::shared_ptr<HostWaiters> waiters,
+               std::multiset<Duration>::iterator it, Duration delay);
+
+    std::shared_ptr<HostWaiters> waiters_;
+    std::multiset<Duration>::iterator it_;
+    Duration delay_;
+  };
+
   ConnectRateLimiter();
 
   void SetGlobalHttpLimits(size_t limit, utils::TokenBucket::Duration rate);
@@ -22,8 +51,19 @@ class ConnectRateLimiter {
 
   void SetPerHostLimits(size_t limit, utils::TokenBucket::Duration rate);
 
+  // The connects over the limits wait up to `max_wait`, no more than
+  // `max_waiting_per_host` at once. Zero `max_wait` disables the waiting.
+  void SetWaitLimits(std::chrono::milliseconds max_wait,
+                     size_t max_waiting_per_host);
+
   void Check(const char* url_str, std::error_code& ec);
 
+  // For the connect that failed the Check() with `ec` returns the ticket to
+  // attempt it again later, or std::nullopt if it should fail right away.
+  // The connects with the closer deadlines get the shorter delays.
+  std::optional<WaitTicket> Wait(const char* url_str, std::error_code ec,
+                                 Duration time_left);
+
  private:
   utils::TokenBucket global_http_;
   utils::TokenBucket global_https_;
@@ -33,6 +73,12 @@ class ConnectRateLimiter {
   concurrent::Variable<cache::LruMap<std::string, utils::TokenBucket>,
                        std::mutex>
       by_host_;
+
+  std::atomic<std::chrono::milliseconds> max_wait_;
+  std::atomic<size_t> max_waiting_per_host_;
+  concurrent::Variable<
+      cache::LruMap<std::string, std::shared_ptr<HostWaiters>>, std::mutex>
+      waiters_by_host_;
 };
 
 }  // namespace curl
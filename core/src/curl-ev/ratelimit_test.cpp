@@ -162,6 +162,82 @@ TEST(CurlConnectRateLimiter, InvalidUrlFallback) {
 }
 #endif
 
+TEST(CurlConnectRateLimiter, WaitDisabled) {
+  constexpr std::chrono::seconds kAcquireInterval{1};
+  utils::datetime::MockNowSet({});
+
+  curl::ConnectRateLimiter limiter;
+  limiter.SetPerHostLimits(1, kAcquireInterval);
+
+  EXPECT_FALSE(GetCheckError(limiter, "http://test"));
+  const auto ec = GetCheckError(limiter, "http://test");
+  EXPECT_EQ(kPerHostSocketLimit, ec);
+  EXPECT_FALSE(limiter.Wait("http://test", ec, std::chrono::minutes{1}));
+}
+
+TEST(CurlConnectRateLimiter, Wait) {
+  constexpr std::chrono::milliseconds kAcquireInterval{100};
+  utils::datetime::MockNowSet({});
+
+  curl::ConnectRateLimiter limiter;
+  limiter.SetPerHostLimits(1, kAcquireInterval);
+  limiter.SetWaitLimits(std::chrono::seconds{1}, 3);
+
+  EXPECT_FALSE(GetCheckError(limiter, "http://test"));
+  const auto ec = GetCheckError(limiter, "http://test");
+  ASSERT_EQ(kPerHostSocketLimit, ec);
+
+  const auto far = limiter.Wait("http://test", ec, std::chrono::seconds{10});
+  ASSERT_TRUE(far);
+  EXPECT_GE(far->GetDelay(), kAcquireInterval);
+  EXPECT_LT(far->GetDelay(), kAcquireInterval * 2);
+
+  // The closer deadline goes first
+  const auto close =
+      limiter.Wait("http://test", ec, std::chrono::milliseconds{500});
+  ASSERT_TRUE(close);
+  EXPECT_GE(close->GetDelay(), kAcquireInterval);
+  EXPECT_LT(close->GetDelay(), kAcquireInterval * 2);
+
+  const auto next = limiter.Wait("http://test", ec, std::chrono::seconds{5});
+  ASSERT_TRUE(next);
+  EXPECT_GE(next->GetDelay(), kAcquireInterval * 2);
+  EXPECT_LT(next->GetDelay(), kAcquireInterval * 3);
+
+  // The queue is full
+  EXPECT_FALSE(limiter.Wait("http://test", ec, std::chrono::seconds{5}));
+  // The other hosts have their own queues
+  EXPECT_TRUE(limiter.Wait("http://other", ec, std::chrono::seconds{5}));
+}
+
+TEST(CurlConnectRateLimiter, WaitTooLong) {
+  constexpr std::chrono::milliseconds kAcquireInterval{100};
+  utils::datetime::MockNowSet({});
+
+  curl::ConnectRateLimiter limiter;
+  limiter.SetPerHostLimits(1, kAcquireInterval);
+  limiter.SetWaitLimits(std::chrono::milliseconds{250}, 100);
+
+  EXPECT_FALSE(GetCheckError(limiter, "http://test"));
+  const auto ec = GetCheckError(limiter, "http://test");
+
+  // The deadline is closer than the token
+  EXPECT_FALSE(limiter.Wait("http://test", ec, std::chrono::milliseconds{50}));
+
+  std::vector<curl::ConnectRateLimiter::WaitTicket> tickets;
+  for (;;) {
+    auto ticket = limiter.Wait("http://test", ec, std::chrono::seconds{1});
+    if (!ticket) break;
+    tickets.push_back(std::move(*ticket));
+  }
+  // No more than max-wait
+  EXPECT_EQ(tickets.size(), std::size_t{2});
+
+  // The ticket leaves the queue with its destruction
+  tickets.clear();
+  EXPECT_TRUE(limiter.Wait("http://test", ec, std::chrono::seconds{1}));
+}
+
 TEST(CurlConnectRateLimiter, Multithread) {
   constexpr size_t kThreadsCount = 4;
   constexpr size_t kPerHostLimit = 10000;
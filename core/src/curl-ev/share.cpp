@@ -10,6 +10,8 @@
 #include <curl-ev/share.hpp>
 #include <curl-ev/wrappers.hpp>
 
+#include <userver/utils/assert.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace curl {
@@ -83,15 +85,18 @@ void share::set_user_data(void* user_data) {
   throw_error(ec, __func__);
 }
 
-void share::lock(native::CURL*, native::curl_lock_data,
+void share::lock(native::CURL*, native::curl_lock_data data,
                  native::curl_lock_access, void* userptr) {
   auto* self = static_cast<share*>(userptr);
-  self->mutex_.lock();
+  UASSERT(static_cast<std::size_t>(data) < self->mutexes_.size());
+  self->mutexes_[data].lock();
 }
 
-void share::unlock(native::CURL*, native::curl_lock_data, void* userptr) {
+void share::unlock(native::CURL*, native::curl_lock_data data,
+                   void* userptr) {
   auto* self = static_cast<share*>(userptr);
-  self->mutex_.unlock();
+  UASSERT(static_cast<std::size_t>(data) < self->mutexes_.size());
+  self->mutexes_[data].unlock();
 }
 
 }  // namespace curl
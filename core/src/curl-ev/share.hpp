@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <mutex>
 
@@ -47,7 +48,9 @@ class share final : public std::enable_shared_from_this<share> {
                      void* userptr);
 
   native::CURLSH* handle_;
-  std::mutex mutex_;
+  // The DNS and TLS session caches are locked independently, so the easy
+  // handles of different multis rarely wait for each other
+  std::array<std::mutex, native::CURL_LOCK_DATA_LAST> mutexes_;
 };
 }  // namespace curl
 
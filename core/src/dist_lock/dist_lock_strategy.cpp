@@ -0,0 +1,21 @@
+#include <userver/dist_lock/dist_lock_strategy.hpp>
+
+#include <userver/engine/sleep.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dist_lock {
+
+std::optional<std::int64_t> DistLockStrategyBase::AcquireWithFencingToken(
+    std::chrono::milliseconds lock_ttl, const std::string& locker_id) {
+  Acquire(lock_ttl, locker_id);
+  return std::nullopt;
+}
+
+void DistLockStrategyBase::WaitForRelease(engine::Deadline deadline) {
+  engine::InterruptibleSleepUntil(deadline);
+}
+
+}  // namespace dist_lock
+
+USERVER_NAMESPACE_END
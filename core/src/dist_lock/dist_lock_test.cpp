@@ -9,6 +9,7 @@
 #include <userver/dist_lock/dist_locked_worker.hpp>
 #include <userver/engine/condition_variable.hpp>
 #include <userver/engine/mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
@@ -75,6 +76,56 @@ class MockDistLockStrategy final : public dist_lock::DistLockStrategyBase {
 
 auto MakeMockStrategy() { return std::make_shared<MockDistLockStrategy>(); }
 
+class FencingDistLockStrategy final : public dist_lock::DistLockStrategyBase {
+ public:
+  void Acquire(std::chrono::milliseconds lock_ttl,
+               const std::string& locker_id) override {
+    AcquireWithFencingToken(lock_ttl, locker_id);
+  }
+
+  std::optional<std::int64_t> AcquireWithFencingToken(
+      std::chrono::milliseconds, const std::string& locker_id) override {
+    auto state = state_var_.Lock();
+    if (!state->locked_by.empty() && state->locked_by != locker_id)
+      throw dist_lock::LockIsAcquiredByAnotherHostException();
+    if (state->locked_by != locker_id) {
+      state->locked_by = locker_id;
+      ++state->fencing_token;
+    }
+    return state->fencing_token;
+  }
+
+  void Release(const std::string& locker_id) override {
+    {
+      auto state = state_var_.Lock();
+      if (state->locked_by != locker_id) return;
+      state->locked_by.clear();
+    }
+    released_.Send();
+  }
+
+  void WaitForRelease(engine::Deadline deadline) override {
+    [[maybe_unused]] const bool is_released =
+        released_.WaitForEventUntil(deadline);
+  }
+
+  // Someone else acquires and releases the lock between the prolongations
+  void Intercept() {
+    auto state = state_var_.Lock();
+    state->locked_by.clear();
+    ++state->fencing_token;
+  }
+
+ private:
+  struct State {
+    std::string locked_by;
+    std::int64_t fencing_token{0};
+  };
+
+  concurrent::Variable<State> state_var_;
+  engine::SingleConsumerEvent released_;
+};
+
 class DistLockWorkload {
  public:
   explicit DistLockWorkload(bool abort_on_cancel = false)
@@ -244,6 +295,31 @@ UTEST_MT(LockedWorker, LockedByOther, 3) {
   locked_worker.Stop();
 }
 
+UTEST_MT(LockedWorker, FencingToken, 3) {
+  auto strategy = std::make_shared<FencingDistLockStrategy>();
+  DistLockWorkload work;
+  dist_lock::DistLockedWorker locked_worker(
+      kWorkerName, [&] { work.Work(); }, strategy, MakeSettings());
+  EXPECT_EQ(locked_worker.GetFencingToken(), std::nullopt);
+
+  locked_worker.Start();
+  EXPECT_TRUE(work.WaitForLocked(true, utest::kMaxTestWaitTime));
+  EXPECT_EQ(locked_worker.GetFencingToken(), 1);
+
+  // The worker is restarted, it may have done some work without the lock
+  strategy->Intercept();
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  while (work.GetStartedWorkCount() < 2 && !deadline.IsReached()) {
+    engine::InterruptibleSleepFor(kAttemptInterval);
+  }
+  EXPECT_EQ(work.GetStartedWorkCount(), 2);
+  EXPECT_EQ(locked_worker.GetFencingToken(), 3);
+  EXPECT_EQ(locked_worker.GetStatistics().brain_splits, 1);
+
+  locked_worker.Stop();
+  EXPECT_EQ(locked_worker.GetFencingToken(), std::nullopt);
+}
+
 UTEST_MT(LockedTask, Smoke, 3) {
   auto strategy = MakeMockStrategy();
   DistLockWorkload work;
@@ -383,6 +459,28 @@ UTEST(LockedTask, MultipleWorkers) {
   EXPECT_EQ(1, work.GetFinishedWorkCount());
 }
 
+UTEST_MT(LockedTask, WaitForRelease, 3) {
+  auto settings = MakeSettings();
+  settings.acquire_interval = utest::kMaxTestWaitTime;
+
+  auto strategy = std::make_shared<FencingDistLockStrategy>();
+  strategy->Acquire(kLockTtl, "me");
+
+  DistLockWorkload work;
+  dist_lock::DistLockedTask locked_task(
+      kWorkerName, [&] { work.Work(); }, strategy, settings);
+  EXPECT_FALSE(work.WaitForLocked(true, kAttemptTimeout));
+
+  // Acquired right after the release, not after the acquire_interval
+  strategy->Release("me");
+  EXPECT_TRUE(work.WaitForLocked(true, kAttemptTimeout));
+  EXPECT_EQ(locked_task.GetFencingToken(), 2);
+
+  work.SetWorkLoopOn(false);
+  locked_task.WaitFor(utest::kMaxTestWaitTime);
+  EXPECT_TRUE(locked_task.GetState() == engine::Task::State::kCompleted);
+}
+
 std::shared_ptr<dist_lock::DistLockStrategyBase>
 GetSomeDistLockStrategyForTheSample() {
   auto strategy = std::make_shared<MockDistLockStrategy>();
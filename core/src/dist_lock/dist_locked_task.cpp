@@ -55,6 +55,10 @@ DistLockedTask::GetLockedDuration() const {
   return locker_ptr_->GetLockedDuration();
 }
 
+std::optional<std::int64_t> DistLockedTask::GetFencingToken() const {
+  return locker_ptr_->GetFencingToken();
+}
+
 }  // namespace dist_lock
 
 USERVER_NAMESPACE_END
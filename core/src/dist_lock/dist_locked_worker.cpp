@@ -87,6 +87,10 @@ DistLockedWorker::GetLockedDuration() const {
   return locker_ptr_->GetLockedDuration();
 }
 
+std::optional<std::int64_t> DistLockedWorker::GetFencingToken() const {
+  return locker_ptr_->GetFencingToken();
+}
+
 const Statistics& DistLockedWorker::GetStatistics() const {
   return locker_ptr_->GetStatistics();
 }
@@ -1,6 +1,8 @@
 #include <dist_lock/impl/locker.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <limits>
 #include <stdexcept>
 
 #include <fmt/compile.h>
@@ -24,6 +26,10 @@ USERVER_NAMESPACE_BEGIN
 namespace dist_lock::impl {
 namespace {
 
+// Fencing tokens are non-negative
+constexpr std::int64_t kNoFencingToken =
+    std::numeric_limits<std::int64_t>::min();
+
 class WorkerFuncFailedException : public std::runtime_error {
   using std::runtime_error::runtime_error;
 };
@@ -63,7 +69,8 @@ Locker::Locker(std::string name, std::shared_ptr<DistLockStrategyBase> strategy,
       strategy_(std::move(strategy)),
       worker_func_(std::move(worker_func)),
       settings_(settings),
-      retry_mode_(retry_mode) {
+      retry_mode_(retry_mode),
+      fencing_token_(kNoFencingToken) {
   UASSERT(strategy_);
 }
 
@@ -88,6 +95,12 @@ std::optional<std::chrono::steady_clock::duration> Locker::GetLockedDuration()
          lock_acquire_since_epoch_.load();
 }
 
+std::optional<std::int64_t> Locker::GetFencingToken() const {
+  const auto fencing_token = fencing_token_.load();
+  if (!is_locked_ || fencing_token == kNoFencingToken) return {};
+  return fencing_token;
+}
+
 const Statistics& Locker::GetStatistics() const { return stats_; }
 
 void Locker::Run(LockerMode mode, dist_lock::DistLockWaitingMode waiting_mode,
@@ -97,14 +110,35 @@ void Locker::Run(LockerMode mode, dist_lock::DistLockWaitingMode waiting_mode,
   engine::TaskWithResult<void> watchdog_task;
   bool worker_succeeded = false;
 
+  const auto stop_watchdog = [&watchdog_task, this] {
+    LOG_DEBUG() << "Terminating watchdog task";
+    if (watchdog_task.IsValid()) watchdog_task.RequestCancel();
+    GetTask(watchdog_task, WatchdogName(name_));
+    LOG_DEBUG() << "Terminated watchdog task";
+  };
+
   while (!engine::current_task::ShouldCancel() &&
          (mode != LockerMode::kOneshot || !worker_succeeded)) {
     const auto settings = GetSettings();
     const auto attempt_start = utils::datetime::SteadyNow();
+    bool is_busy = false;
 
     try {
-      strategy_->Acquire(settings.lock_ttl, Id());
+      const auto fencing_token =
+          strategy_->AcquireWithFencingToken(settings.lock_ttl, Id())
+              .value_or(kNoFencingToken);
       stats_.lock_successes++;
+      if (is_locked_ && fencing_token != fencing_token_.load()) {
+        LOG_ERROR() << "DistLockedTask fencing token changed from "
+                    << fencing_token_.load() << " to " << fencing_token
+                    << " while we're assuming we're holding the lock. "
+                       "Someone else held the lock in between, restarting "
+                       "the worker.";
+        stats_.brain_splits++;
+        stop_watchdog();
+        ExchangeLockState(false, utils::datetime::SteadyNow());
+      }
+      fencing_token_ = fencing_token;
       if (!ExchangeLockState(true, attempt_start)) {
         LOG_DEBUG() << "Starting watchdog task";
         GetTask(watchdog_task, WatchdogName(name_));
@@ -121,13 +155,11 @@ void Locker::Run(LockerMode mode, dist_lock::DistLockWaitingMode waiting_mode,
                "a brain split in DB backend or missing cancellation point in "
                "worker code.";
         stats_.brain_splits++;
-        LOG_DEBUG() << "Terminating watchdog task";
-        if (watchdog_task.IsValid()) watchdog_task.RequestCancel();
-        GetTask(watchdog_task, WatchdogName(name_));
-        LOG_DEBUG() << "Terminated watchdog task";
+        stop_watchdog();
         ExchangeLockState(false, utils::datetime::SteadyNow());
       }
       if (waiting_mode == dist_lock::DistLockWaitingMode::kNoWait) break;
+      is_busy = true;
     } catch (const std::exception& ex) {
       stats_.lock_failures++;
       LOG_WARNING() << "Lock acquisition failed: " << ex;
@@ -135,8 +167,13 @@ void Locker::Run(LockerMode mode, dist_lock::DistLockWaitingMode waiting_mode,
 
     if (engine::current_task::ShouldCancel()) break;
 
-    auto delay =
+    // The interval is counted from the start of the attempt, so the round
+    // trip to the lock storage does not postpone the next prolongation
+    const auto interval =
         is_locked_ ? settings.prolong_interval : settings.acquire_interval;
+    const auto delay = std::max(
+        std::chrono::steady_clock::duration::zero(),
+        interval - (utils::datetime::SteadyNow() - attempt_start));
     if (watchdog_task.IsValid()) {
       try {
         watchdog_task.WaitFor(delay);
@@ -163,6 +200,14 @@ void Locker::Run(LockerMode mode, dist_lock::DistLockWaitingMode waiting_mode,
           engine::InterruptibleSleepFor(settings.worker_func_restart_delay);
         }
       }
+    } else if (is_busy) {
+      const auto deadline = engine::Deadline::FromDuration(delay);
+      try {
+        strategy_->WaitForRelease(deadline);
+      } catch (const std::exception& ex) {
+        LOG_WARNING() << "Waiting for the lock release failed: " << ex;
+        engine::InterruptibleSleepUntil(deadline);
+      }
     } else {
       engine::InterruptibleSleepFor(delay);
     }
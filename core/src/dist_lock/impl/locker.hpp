@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <functional>
 #include <optional>
 #include <string>
@@ -35,6 +36,8 @@ class Locker final {
 
   std::optional<std::chrono::steady_clock::duration> GetLockedDuration() const;
 
+  std::optional<std::int64_t> GetFencingToken() const;
+
   const Statistics& GetStatistics() const;
 
   engine::TaskWithResult<void> RunAsync(engine::TaskProcessor& task_processor,
@@ -63,6 +66,7 @@ class Locker final {
   std::atomic<bool> is_locked_{false};
   std::atomic<std::chrono::steady_clock::duration> lock_refresh_since_epoch_{};
   std::atomic<std::chrono::steady_clock::duration> lock_acquire_since_epoch_{};
+  std::atomic<std::int64_t> fencing_token_;
 
   Statistics stats_;
 };
@@ -0,0 +1,238 @@
+#include <dump/block_file_io.hpp>
+
+#include <fcntl.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include <userver/engine/async.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+namespace {
+
+std::size_t AlignUp(std::size_t size) {
+  return (size + kIoBlockAlignment - 1) / kIoBlockAlignment *
+         kIoBlockAlignment;
+}
+
+// Returns true if the reads and writes must be aligned from now on
+bool TryEnableDirectIo(int fd) {
+#if defined(O_DIRECT)
+  const int flags = ::fcntl(fd, F_GETFL);
+  // Fails with EINVAL on the filesystems without O_DIRECT support, e.g. tmpfs
+  if (flags == -1 || ::fcntl(fd, F_SETFL, flags | O_DIRECT) == -1) {
+    LOG_INFO() << "O_DIRECT is not supported for the dump file, falling back "
+                  "to the page cache";
+    return false;
+  }
+  return true;
+#else
+#if defined(F_NOCACHE)
+  // Bypasses the page cache without the alignment requirements
+  ::fcntl(fd, F_NOCACHE, 1);
+#endif
+  return false;
+#endif
+}
+
+void DisableDirectIo([[maybe_unused]] int fd) {
+#if defined(O_DIRECT)
+  const int flags =
+      utils::CheckSyscall(::fcntl(fd, F_GETFL), "calling ::fcntl(F_GETFL)");
+  utils::CheckSyscall(::fcntl(fd, F_SETFL, flags & ~O_DIRECT),
+                      "calling ::fcntl(F_SETFL)");
+#endif
+}
+
+void AdviseSequential([[maybe_unused]] int fd) {
+#if defined(POSIX_FADV_SEQUENTIAL)
+  // Only a hint, failures are harmless
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+}
+
+// Keeps the service working set in the page cache instead of the dump
+void DropPageCache([[maybe_unused]] int fd) {
+#if defined(POSIX_FADV_DONTNEED)
+  // Only a hint, failures are harmless
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+}
+
+}  // namespace
+
+AlignedBuffer::AlignedBuffer(std::size_t capacity)
+    : capacity_(AlignUp(std::max<std::size_t>(capacity, 1))) {
+  void* data = nullptr;
+  if (::posix_memalign(&data, kIoBlockAlignment, capacity_) != 0) {
+    throw std::bad_alloc();
+  }
+  data_.reset(static_cast<char*>(data));
+}
+
+BlockFileWriter::BlockFileWriter(const std::string& path,
+                                 boost::filesystem::perms perms,
+                                 const FileIoSettings& settings)
+    : fd_(fs::blocking::FileDescriptor::Open(
+          path,
+          {fs::blocking::OpenFlag::kWrite,
+           fs::blocking::OpenFlag::kExclusiveCreate},
+          perms)),
+      direct_io_(settings.direct_io && TryEnableDirectIo(fd_.GetNative())),
+      async_io_(settings.async_io),
+      current_(settings.buffer_size) {}
+
+BlockFileWriter::~BlockFileWriter() = default;
+
+void BlockFileWriter::Write(std::string_view data) {
+  while (!data.empty()) {
+    const auto count =
+        std::min(current_.Capacity() - current_.size, data.size());
+    std::memcpy(current_.Data() + current_.size, data.data(), count);
+    current_.size += count;
+    data.remove_prefix(count);
+
+    if (current_.size == current_.Capacity()) SubmitBuffer();
+  }
+}
+
+void BlockFileWriter::Finish() {
+  WaitPendingWrite();
+
+  if (current_.size != 0) {
+    // O_DIRECT only accepts whole blocks, the tail is written through the
+    // page cache and dropped from it below
+    if (direct_io_ && current_.size % kIoBlockAlignment != 0) {
+      DisableDirectIo(fd_.GetNative());
+      direct_io_ = false;
+    }
+    WriteBlock(current_);
+    current_.size = 0;
+  }
+
+  fd_.FSync();
+  DropPageCache(fd_.GetNative());
+  std::move(fd_).Close();
+}
+
+void BlockFileWriter::SubmitBuffer() {
+  if (!async_io_) {
+    WriteBlock(current_);
+    current_.size = 0;
+    return;
+  }
+
+  WaitPendingWrite();
+  if (!in_flight_) in_flight_.emplace(current_.Capacity());
+  std::swap(current_, *in_flight_);
+  current_.size = 0;
+
+  pending_write_ = engine::AsyncNoSpan([this] { WriteBlock(*in_flight_); });
+}
+
+void BlockFileWriter::WriteBlock(const AlignedBuffer& buffer) {
+  fd_.Write({buffer.Data(), buffer.size});
+}
+
+void BlockFileWriter::WaitPendingWrite() {
+  if (pending_write_.IsValid()) pending_write_.Get();
+}
+
+BlockFileReader::BlockFileReader(const std::string& path,
+                                 const FileIoSettings& settings)
+    : fd_(fs::blocking::FileDescriptor::Open(path,
+                                             fs::blocking::OpenFlag::kRead)),
+      direct_io_(settings.direct_io && TryEnableDirectIo(fd_.GetNative())),
+      async_io_(settings.async_io),
+      current_(settings.buffer_size) {
+  if (!direct_io_) AdviseSequential(fd_.GetNative());
+  if (async_io_) StartPrefetch();
+}
+
+BlockFileReader::~BlockFileReader() = default;
+
+std::string_view BlockFileReader::Read(std::size_t max_size) {
+  if (position_ == current_.size) FetchBlock();
+
+  const auto available = current_.size - position_;
+  if (available >= max_size) {
+    const std::string_view result{current_.Data() + position_, max_size};
+    position_ += max_size;
+    return result;
+  }
+
+  // The requested data spans several blocks
+  spliced_.assign(current_.Data() + position_, available);
+  position_ = current_.size;
+  while (spliced_.size() < max_size && FetchBlock()) {
+    const auto count = std::min(current_.size, max_size - spliced_.size());
+    spliced_.append(current_.Data(), count);
+    position_ = count;
+  }
+  return spliced_;
+}
+
+std::uint64_t BlockFileReader::GetPosition() const {
+  return block_offset_ + position_;
+}
+
+bool BlockFileReader::IsAtEnd() {
+  return position_ == current_.size && !FetchBlock();
+}
+
+void BlockFileReader::Close() {
+  if (pending_read_.IsValid()) pending_read_.Get();
+  DropPageCache(fd_.GetNative());
+  std::move(fd_).Close();
+}
+
+bool BlockFileReader::FetchBlock() {
+  block_offset_ += current_.size;
+  position_ = 0;
+
+  if (pending_read_.IsValid()) {
+    pending_read_.Get();
+    std::swap(current_, *prefetched_);
+  } else if (eof_) {
+    current_.size = 0;
+  } else {
+    ReadBlock(current_);
+  }
+
+  if (async_io_ && !eof_) StartPrefetch();
+  return current_.size != 0;
+}
+
+void BlockFileReader::ReadBlock(AlignedBuffer& buffer) {
+  buffer.size = 0;
+  while (buffer.size < buffer.Capacity()) {
+    const auto requested = buffer.Capacity() - buffer.size;
+    const auto count = fd_.Read(buffer.Data() + buffer.size, requested);
+    buffer.size += count;
+    // With O_DIRECT the next read would start at an unaligned offset, and
+    // a short read of a regular file only happens at the end of it anyway
+    if (count == 0 || (direct_io_ && count < requested)) {
+      eof_ = true;
+      return;
+    }
+  }
+}
+
+void BlockFileReader::StartPrefetch() {
+  UASSERT(!pending_read_.IsValid());
+  if (!prefetched_) prefetched_.emplace(current_.Capacity());
+  pending_read_ = engine::AsyncNoSpan([this] { ReadBlock(*prefetched_); });
+}
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/dump/config.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+/// Alignment of the buffers, offsets and sizes for `O_DIRECT`
+inline constexpr std::size_t kIoBlockAlignment = 4096;
+
+/// A buffer suitable for `O_DIRECT` reads and writes
+class AlignedBuffer final {
+ public:
+  explicit AlignedBuffer(std::size_t capacity);
+
+  char* Data() noexcept { return data_.get(); }
+  const char* Data() const noexcept { return data_.get(); }
+  std::size_t Capacity() const noexcept { return capacity_; }
+
+  std::size_t size{0};
+
+ private:
+  struct Deleter {
+    void operator()(char* data) const noexcept { std::free(data); }
+  };
+
+  std::size_t capacity_;
+  std::unique_ptr<char, Deleter> data_;
+};
+
+/// Writes the file in large aligned blocks, optionally bypassing the page
+/// cache and overlapping the writes with the caller
+class BlockFileWriter final {
+ public:
+  BlockFileWriter(const std::string& path, boost::filesystem::perms perms,
+                  const FileIoSettings& settings);
+  ~BlockFileWriter();
+
+  void Write(std::string_view data);
+
+  /// Writes the buffered data and syncs the file to disk
+  void Finish();
+
+ private:
+  void SubmitBuffer();
+  void WriteBlock(const AlignedBuffer& buffer);
+  void WaitPendingWrite();
+
+  fs::blocking::FileDescriptor fd_;
+  bool direct_io_;
+  const bool async_io_;
+  AlignedBuffer current_;
+  std::optional<AlignedBuffer> in_flight_;
+  engine::TaskWithResult<void> pending_write_;
+};
+
+/// Reads the file in large aligned blocks, optionally bypassing the page
+/// cache and prefetching the next block while the caller parses the current
+class BlockFileReader final {
+ public:
+  BlockFileReader(const std::string& path, const FileIoSettings& settings);
+  ~BlockFileReader();
+
+  /// Returns up to `max_size` bytes, less only at the end of file. The result
+  /// is valid until the next call.
+  std::string_view Read(std::size_t max_size);
+
+  /// Returns the offset of the next byte to read
+  std::uint64_t GetPosition() const;
+
+  /// Checks that the whole file has been read
+  bool IsAtEnd();
+
+  void Close();
+
+ private:
+  bool FetchBlock();
+  void ReadBlock(AlignedBuffer& buffer);
+  void StartPrefetch();
+
+  fs::blocking::FileDescriptor fd_;
+  const bool direct_io_;
+  const bool async_io_;
+  bool eof_{false};
+  AlignedBuffer current_;
+  std::uint64_t block_offset_{0};
+  std::size_t position_{0};
+  std::optional<AlignedBuffer> prefetched_;
+  engine::TaskWithResult<void> pending_read_;
+  std::string spliced_;
+};
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,100 @@
+#include <userver/dump/chunked.hpp>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <limits>
+
+#include <fmt/format.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+void StringWriter::WriteRaw(std::string_view data) { data_.append(data); }
+
+void StringWriter::Finish() {
+  // nothing to do
+}
+
+std::string StringWriter::Extract() && { return std::move(data_); }
+
+StringReader::StringReader(std::string data)
+    : data_(std::move(data)), unread_data_(data_) {}
+
+std::string_view StringReader::ReadRaw(std::size_t max_size) {
+  const auto result_size = std::min(max_size, unread_data_.size());
+  const auto result = unread_data_.substr(0, result_size);
+  unread_data_ = unread_data_.substr(result_size);
+  return result;
+}
+
+void StringReader::Finish() {
+  if (!unread_data_.empty()) {
+    throw Error(fmt::format(
+        "Unexpected extra data at the end of a dump chunk: chunk-size={}, "
+        "unread-size={}",
+        data_.size(), unread_data_.size()));
+  }
+}
+
+EncodedChunk CompressChunk(std::string data, ChunkCompression compression) {
+  const auto raw_size = data.size();
+  switch (compression) {
+    case ChunkCompression::kNone:
+      return {std::move(data), raw_size};
+    case ChunkCompression::kZlib: {
+      uLongf compressed_size = compressBound(raw_size);
+      std::string compressed(compressed_size, '\0');
+      if (compress2(reinterpret_cast<Bytef*>(compressed.data()),
+                    &compressed_size,
+                    reinterpret_cast<const Bytef*>(data.data()), raw_size,
+                    Z_BEST_SPEED) != Z_OK) {
+        throw Error("Failed to compress a dump chunk");
+      }
+      compressed.resize(compressed_size);
+      return {std::move(compressed), raw_size};
+    }
+  }
+  throw Error("Unknown dump chunk compression");
+}
+
+std::string DecompressChunk(std::string data, ChunkCompression compression,
+                            std::size_t raw_size) {
+  switch (compression) {
+    case ChunkCompression::kNone:
+      return data;
+    case ChunkCompression::kZlib: {
+      if (raw_size > std::numeric_limits<uLongf>::max()) {
+        throw Error("Unexpected size of a compressed dump chunk");
+      }
+      std::string result(raw_size, '\0');
+      uLongf result_size = raw_size;
+      if (uncompress(reinterpret_cast<Bytef*>(result.data()), &result_size,
+                     reinterpret_cast<const Bytef*>(data.data()),
+                     data.size()) != Z_OK ||
+          result_size != raw_size) {
+        throw Error(fmt::format(
+            "Failed to decompress a dump chunk: compressed-size={}, "
+            "expected-size={}",
+            data.size(), raw_size));
+      }
+      return result;
+    }
+  }
+  throw Error("Unknown dump chunk compression");
+}
+
+ChunkCompression ReadChunkCompression(Reader& reader) {
+  const auto value = reader.Read<std::uint8_t>();
+  switch (static_cast<ChunkCompression>(value)) {
+    case ChunkCompression::kNone:
+    case ChunkCompression::kZlib:
+      return static_cast<ChunkCompression>(value);
+  }
+  throw Error(fmt::format("Unknown dump chunk compression {}", value));
+}
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,117 @@
+#include <userver/dump/chunked.hpp>
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/dump/operations_mock.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+template <typename T>
+std::string WriteChunked(const T& value, std::size_t chunk_size) {
+  dump::MockWriter writer;
+  dump::WriteChunked(writer, value, chunk_size);
+  writer.Finish();
+  return std::move(writer).Extract();
+}
+
+template <typename T>
+std::string WriteChunked(const T& value,
+                         const dump::ChunkedWriteOptions& options) {
+  dump::MockWriter writer;
+  dump::WriteChunked(writer, value, options);
+  writer.Finish();
+  return std::move(writer).Extract();
+}
+
+template <typename T>
+T ReadChunked(std::string data) {
+  dump::MockReader reader{std::move(data)};
+  auto result = dump::ReadChunked<T>(reader);
+  reader.Finish();
+  return result;
+}
+
+template <typename T>
+void CheckRoundTrip(const T& value) {
+  for (const std::size_t chunk_size : {1, 2, 3, 1000}) {
+    EXPECT_EQ(ReadChunked<T>(WriteChunked(value, chunk_size)), value)
+        << "chunk_size=" << chunk_size;
+
+    for (const std::size_t max_parallel_chunks : {1, 4}) {
+      dump::ChunkedWriteOptions options;
+      options.chunk_size = chunk_size;
+      options.compression = dump::ChunkCompression::kZlib;
+      options.max_parallel_chunks = max_parallel_chunks;
+      EXPECT_EQ(ReadChunked<T>(WriteChunked(value, options)), value)
+          << "chunk_size=" << chunk_size
+          << " max_parallel_chunks=" << max_parallel_chunks;
+    }
+  }
+}
+
+}  // namespace
+
+UTEST(DumpChunked, Vector) {
+  CheckRoundTrip(std::vector<int>{});
+  CheckRoundTrip(std::vector<int>{1});
+  CheckRoundTrip(std::vector<int>{1, 2, 3, 4, 5, 6, 7});
+  CheckRoundTrip(std::vector<bool>{true, false, true});
+}
+
+UTEST(DumpChunked, Maps) {
+  std::unordered_map<std::string, int> unordered_map;
+  std::map<int, std::string> map;
+  for (int i = 0; i < 100; ++i) {
+    unordered_map.emplace(std::to_string(i), i);
+    map.emplace(i, std::to_string(i));
+  }
+  CheckRoundTrip(unordered_map);
+  CheckRoundTrip(map);
+}
+
+UTEST_MT(DumpChunked, Large, 4) {
+  std::unordered_map<int, std::string> map;
+  for (int i = 0; i < 100'000; ++i) map.emplace(i, std::to_string(i));
+  EXPECT_EQ(ReadChunked<decltype(map)>(WriteChunked(map, 1000)), map);
+}
+
+UTEST_MT(DumpChunked, LargeCompressed, 4) {
+  std::unordered_map<int, std::string> map;
+  for (int i = 0; i < 100'000; ++i) map.emplace(i, std::string(20, 'a'));
+
+  dump::ChunkedWriteOptions options;
+  options.chunk_size = 1000;
+  const auto plain = WriteChunked(map, options);
+  options.compression = dump::ChunkCompression::kZlib;
+  const auto compressed = WriteChunked(map, options);
+
+  EXPECT_LT(compressed.size(), plain.size() / 2);
+  EXPECT_EQ(ReadChunked<decltype(map)>(compressed), map);
+}
+
+UTEST(DumpChunked, Malformed) {
+  auto data = WriteChunked(std::vector<int>{1, 2, 3}, 2);
+  data.pop_back();
+  EXPECT_THROW(ReadChunked<std::vector<int>>(data), dump::Error);
+
+  // duplicate keys are merged away, which breaks the size
+  dump::MockWriter writer;
+  dump::WriteChunked(writer, std::vector<std::pair<int, int>>{{1, 1}, {1, 2}},
+                     1);
+  EXPECT_THROW((ReadChunked<std::map<int, int>>(std::move(writer).Extract())),
+               dump::Error);
+
+  dump::ChunkedWriteOptions options;
+  options.compression = dump::ChunkCompression::kZlib;
+  auto compressed = WriteChunked(std::vector<int>{1, 2, 3}, options);
+  compressed[compressed.size() - 2] ^= 0x55;
+  EXPECT_THROW(ReadChunked<std::vector<int>>(compressed), dump::Error);
+}
+
+USERVER_NAMESPACE_END
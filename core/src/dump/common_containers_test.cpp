@@ -96,6 +96,12 @@ TEST(DumpCommonContainers, UnorderedMap) {
   TestWriteReadCycle(std::unordered_map<bool, bool>{});
 }
 
+TEST(DumpCommonContainers, FlatHashMap) {
+  TestWriteReadCycle(utils::FlatHashMap<int, std::string>{{1, "a"}, {2, "b"}});
+  TestWriteReadCycle(utils::FlatHashMap<std::string, int>{{"a", 1}, {"b", 2}});
+  TestWriteReadCycle(utils::FlatHashMap<bool, bool>{});
+}
+
 TEST(DumpCommonContainers, Set) {
   TestWriteReadCycle(std::set<int>{1, 2, 5});
   TestWriteReadCycle(std::set<std::string>{"a", "b", "bb"});
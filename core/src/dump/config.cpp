@@ -18,10 +18,22 @@ constexpr std::string_view kDumpFormatVersion = "format-version";
 constexpr std::string_view kMaxDumpCount = "max-count";
 constexpr std::string_view kWorldReadable = "world-readable";
 constexpr std::string_view kEncrypted = "encrypted";
+constexpr std::string_view kIoBufferSize = "io-buffer-size";
+constexpr std::string_view kDirectIo = "direct-io";
+constexpr std::string_view kAsyncIo = "async-io";
 
 constexpr auto kDefaultFsTaskProcessor = std::string_view{"fs-task-processor"};
 constexpr auto kDefaultMaxDumpCount = uint64_t{1};
 
+FileIoSettings ParseFileIoSettings(const yaml_config::YamlConfig& config) {
+  FileIoSettings settings;
+  settings.buffer_size =
+      config[kIoBufferSize].As<std::size_t>(settings.buffer_size);
+  settings.direct_io = config[kDirectIo].As<bool>(settings.direct_io);
+  settings.async_io = config[kAsyncIo].As<bool>(settings.async_io);
+  return settings;
+}
+
 }  // namespace
 
 namespace impl {
@@ -67,6 +79,7 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config,
           config[kMaxDumpAge].As<std::optional<std::chrono::milliseconds>>()),
       max_dump_age_set(config.HasMember(kMaxDumpAge)),
       dump_is_encrypted(config[kEncrypted].As<bool>(false)),
+      file_io(ParseFileIoSettings(config)),
       static_dumps_enabled(config[kDumpsEnabled].As<bool>()),
       static_min_dump_interval(
           config[kMinDumpInterval].As<std::chrono::milliseconds>(0)) {
@@ -78,6 +91,10 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config,
     throw std::logic_error(
         fmt::format("{}: {} must not be 0", this->name, kMaxDumpCount));
   }
+  if (file_io.buffer_size == 0 && (file_io.direct_io || file_io.async_io)) {
+    throw std::logic_error(fmt::format("{}: {} and {} require {}", this->name,
+                                       kDirectIo, kAsyncIo, kIoBufferSize));
+  }
 }
 
 DynamicConfig::DynamicConfig(const Config& config, ConfigPatch&& patch)
@@ -76,6 +76,25 @@ struct UpdateData {
   std::atomic<bool>& is_current_from_dump;
 };
 
+// Records the durations of consecutive stages of a dump write or load
+class StageTimer final {
+ public:
+  explicit StageTimer(StageDurations& stages)
+      : stages_(stages), stage_start_(std::chrono::steady_clock::now()) {}
+
+  void Finish(std::atomic<std::chrono::milliseconds> StageDurations::*stage) {
+    const auto now = std::chrono::steady_clock::now();
+    (stages_.*stage) =
+        std::chrono::duration_cast<std::chrono::milliseconds>(now -
+                                                              stage_start_);
+    stage_start_ = now;
+  }
+
+ private:
+  StageDurations& stages_;
+  std::chrono::steady_clock::time_point stage_start_;
+};
+
 Config ParseConfig(const components::ComponentConfig& config,
                    const components::ComponentContext& context) {
   return Config{
@@ -196,7 +215,10 @@ Dumper::Impl::Impl(const Config& initial_config,
   if (dump_control.GetPeriodicsMode() ==
       testsuite::DumpControl::PeriodicsMode::kEnabled) {
     periodic_task_ = engine::CriticalAsyncNoSpan(
-        fs_task_processor_, [this] { PeriodicWriteTask(); });
+        fs_task_processor_, [this] {
+          engine::current_task::SetPriority(engine::TaskPriority::kBackground);
+          PeriodicWriteTask();
+        });
   }
 }
 
@@ -416,12 +438,16 @@ void Dumper::Impl::CancelWriteTaskAndWait() noexcept {
 void Dumper::Impl::DoWriteDump(TimePoint update_time, tracing::ScopeTime& scope,
                                DumpData& dump_data) {
   const auto dump_start = std::chrono::steady_clock::now();
+  StageTimer stage_timer{statistics_.last_nontrivial_write_stages};
 
   const auto dump_stats = dump_data.locator.RegisterNewDump(update_time);
   const auto& dump_path = dump_stats.full_path;
   auto writer = dump_data.rw_factory->CreateWriter(dump_path, scope);
+  stage_timer.Finish(&StageDurations::open);
   dump_data.dumpable.GetAndWrite(*writer);
+  stage_timer.Finish(&StageDurations::data);
   writer->Finish();
+  stage_timer.Finish(&StageDurations::finish);
   const auto dump_size = boost::filesystem::file_size(dump_path);
 
   LOG_INFO() << Name() << ": a new dump has been written at \"" << dump_path
@@ -450,13 +476,17 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(
         auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime();
 
         try {
+          StageTimer stage_timer{statistics_.load_stages};
           auto dump_stats = dump_data.locator.GetLatestDump();
           if (!dump_stats) return std::optional<TimePoint>{};
 
           auto reader =
               dump_data.rw_factory->CreateReader(dump_stats->full_path);
+          stage_timer.Finish(&StageDurations::open);
           dump_data.dumpable.ReadAndSet(*reader);
+          stage_timer.Finish(&StageDurations::data);
           reader->Finish();
+          stage_timer.Finish(&StageDurations::finish);
 
           LOG_INFO() << Name() << ": a dump has been loaded successfully";
           return std::optional{dump_stats->update_time};
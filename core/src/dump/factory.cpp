@@ -31,14 +31,16 @@ std::unique_ptr<dump::OperationsFactory> CreateOperationsFactory(
     return std::make_unique<dump::EncryptedOperationsFactory>(
         std::move(secret_key), dump_perms);
   } else {
-    return std::make_unique<dump::FileOperationsFactory>(dump_perms);
+    return std::make_unique<dump::FileOperationsFactory>(dump_perms,
+                                                         config.file_io);
   }
 }
 
 std::unique_ptr<dump::OperationsFactory> CreateDefaultOperationsFactory(
     const Config& config) {
   auto dump_perms = GetPerms(config);
-  return std::make_unique<dump::FileOperationsFactory>(dump_perms);
+  return std::make_unique<dump::FileOperationsFactory>(dump_perms,
+                                                       config.file_io);
 }
 
 }  // namespace dump
@@ -8,6 +8,8 @@
 
 #include <userver/fs/blocking/write.hpp>
 
+#include <dump/block_file_io.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace dump {
@@ -17,7 +19,8 @@ constexpr std::size_t kCheckTimeAfterBytes{1 << 15};
 }
 
 FileWriter::FileWriter(std::string path, boost::filesystem::perms perms,
-                       tracing::ScopeTime& scope)
+                       tracing::ScopeTime& scope,
+                       const FileIoSettings& io_settings)
     : final_path_(std::move(path)),
       path_(final_path_ + ".tmp"),
       perms_(perms),
@@ -27,16 +30,27 @@ FileWriter::FileWriter(std::string path, boost::filesystem::perms perms,
   const auto tmp_perms = perms_ | boost::filesystem::perms::owner_write;
 
   try {
-    file_ = fs::blocking::CFile{path_, mode, tmp_perms};
+    if (io_settings.buffer_size != 0) {
+      block_writer_ = std::make_unique<impl::BlockFileWriter>(path_, tmp_perms,
+                                                              io_settings);
+    } else {
+      file_ = fs::blocking::CFile{path_, mode, tmp_perms};
+    }
   } catch (const std::exception& ex) {
     throw Error(fmt::format("Failed to open the dump file for write \"{}\": {}",
                             path_, ex.what()));
   }
 }
 
+FileWriter::~FileWriter() = default;
+
 void FileWriter::WriteRaw(std::string_view data) {
   try {
-    file_.Write(data);
+    if (block_writer_) {
+      block_writer_->Write(data);
+    } else {
+      file_.Write(data);
+    }
   } catch (const std::exception& ex) {
     throw Error(fmt::format("Failed to write to the dump file \"{}\": {}",
                             path_, ex.what()));
@@ -46,8 +60,12 @@ void FileWriter::WriteRaw(std::string_view data) {
 
 void FileWriter::Finish() {
   try {
-    file_.Flush();
-    std::move(file_).Close();
+    if (block_writer_) {
+      block_writer_->Finish();
+    } else {
+      file_.Flush();
+      std::move(file_).Close();
+    }
     fs::blocking::Chmod(path_, perms_);  // drop perms::owner_write
     fs::blocking::Rename(path_, final_path_);
     fs::blocking::SyncDirectoryContents(
@@ -58,9 +76,15 @@ void FileWriter::Finish() {
   }
 }
 
-FileReader::FileReader(std::string path) : path_(std::move(path)) {
+FileReader::FileReader(std::string path, const FileIoSettings& io_settings)
+    : path_(std::move(path)) {
   try {
-    file_ = fs::blocking::CFile(path_, fs::blocking::OpenFlag::kRead);
+    if (io_settings.buffer_size != 0) {
+      block_reader_ =
+          std::make_unique<impl::BlockFileReader>(path_, io_settings);
+    } else {
+      file_ = fs::blocking::CFile(path_, fs::blocking::OpenFlag::kRead);
+    }
   } catch (const std::exception& ex) {
     throw Error(fmt::format(
         "Failed to open the dump file for reading \"{}\". Reason: {}", path_,
@@ -68,7 +92,18 @@ FileReader::FileReader(std::string path) : path_(std::move(path)) {
   }
 }
 
+FileReader::~FileReader() = default;
+
 std::string_view FileReader::ReadRaw(std::size_t max_size) {
+  if (block_reader_) {
+    try {
+      return block_reader_->Read(max_size);
+    } catch (const std::exception& ex) {
+      throw Error(fmt::format("Failed to read from the dump file \"{}\": {}",
+                              path_, ex.what()));
+    }
+  }
+
   // the storage of curr_chunk_ is reused between ReadRaw calls. It acts
   // as a buffer, with its size being the capacity of the buffer.
   if (curr_chunk_.size() < max_size) {
@@ -88,6 +123,11 @@ std::string_view FileReader::ReadRaw(std::size_t max_size) {
 }
 
 void FileReader::Finish() {
+  if (block_reader_) {
+    FinishBlockReader();
+    return;
+  }
+
   std::size_t bytes_read = 0;
 
   try {
@@ -115,17 +155,44 @@ void FileReader::Finish() {
   }
 }
 
-FileOperationsFactory::FileOperationsFactory(boost::filesystem::perms perms)
-    : perms_(perms) {}
+void FileReader::FinishBlockReader() {
+  bool at_end = false;
+  try {
+    at_end = block_reader_->IsAtEnd();
+  } catch (const std::exception& ex) {
+    throw Error(fmt::format("Failed to read from the dump file \"{}\": {}",
+                            path_, ex.what()));
+  }
+
+  if (!at_end) {
+    const auto position = block_reader_->GetPosition();
+    throw Error(
+        fmt::format("Unexpected extra data at the end of the dump file \"{}\": "
+                    "position={}",
+                    path_, position));
+  }
+
+  try {
+    block_reader_->Close();
+  } catch (const std::exception& ex) {
+    throw Error(fmt::format("Failed to finalize dump file \"{}\". Reason: {}",
+                            path_, ex.what()));
+  }
+}
+
+FileOperationsFactory::FileOperationsFactory(
+    boost::filesystem::perms perms, const FileIoSettings& io_settings)
+    : perms_(perms), io_settings_(io_settings) {}
 
 std::unique_ptr<Reader> FileOperationsFactory::CreateReader(
     std::string full_path) {
-  return std::make_unique<FileReader>(std::move(full_path));
+  return std::make_unique<FileReader>(std::move(full_path), io_settings_);
 }
 
 std::unique_ptr<Writer> FileOperationsFactory::CreateWriter(
     std::string full_path, tracing::ScopeTime& scope) {
-  return std::make_unique<FileWriter>(std::move(full_path), perms_, scope);
+  return std::make_unique<FileWriter>(std::move(full_path), perms_, scope,
+                                      io_settings_);
 }
 
 }  // namespace dump
@@ -0,0 +1,82 @@
+#include <userver/dump/operations_file.hpp>
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/dump/unsafe.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/tracing/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kDumpSize = 64 << 20;
+constexpr std::size_t kRecordSize = 100;
+
+// Arguments: io-buffer-size in KiB (0 for FILE*), direct-io, async-io
+dump::FileIoSettings MakeSettings(const benchmark::State& state) {
+  dump::FileIoSettings settings;
+  settings.buffer_size = static_cast<std::size_t>(state.range(0)) << 10;
+  settings.direct_io = state.range(1) != 0;
+  settings.async_io = state.range(2) != 0;
+  return settings;
+}
+
+void WriteDump(const std::string& path, const dump::FileIoSettings& settings) {
+  const std::string record(kRecordSize, 'a');
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                          scope_time, settings);
+  for (std::size_t i = 0; i < kDumpSize / kRecordSize; ++i) {
+    WriteStringViewUnsafe(writer, record);
+  }
+  writer.Finish();
+}
+
+}  // namespace
+
+void dump_file_write(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto settings = MakeSettings(state);
+    for (auto _ : state) {
+      const auto dir = fs::blocking::TempDirectory::Create();
+      WriteDump(dir.GetPath() + "/dump", settings);
+    }
+    state.SetBytesProcessed(state.iterations() * kDumpSize);
+  });
+}
+BENCHMARK(dump_file_write)
+    ->Args({0, 0, 0})
+    ->Args({1024, 0, 0})
+    ->Args({1024, 1, 0})
+    ->Args({1024, 0, 1})
+    ->Args({1024, 1, 1});
+
+void dump_file_read(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto settings = MakeSettings(state);
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dir.GetPath() + "/dump";
+    WriteDump(path, {});
+
+    for (auto _ : state) {
+      dump::FileReader reader(path, settings);
+      for (std::size_t i = 0; i < kDumpSize / kRecordSize; ++i) {
+        benchmark::DoNotOptimize(ReadStringViewUnsafe(reader, kRecordSize));
+      }
+      reader.Finish();
+    }
+    state.SetBytesProcessed(state.iterations() * kDumpSize);
+  });
+}
+BENCHMARK(dump_file_read)
+    ->Args({0, 0, 0})
+    ->Args({1024, 0, 0})
+    ->Args({1024, 1, 0})
+    ->Args({1024, 0, 1})
+    ->Args({1024, 1, 1});
+
+USERVER_NAMESPACE_END
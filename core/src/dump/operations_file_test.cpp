@@ -1,7 +1,11 @@
 #include <userver/dump/operations_file.hpp>
 
+#include <string>
+#include <vector>
+
 #include <boost/regex.hpp>
 
+#include <dump/block_file_io.hpp>
 #include <userver/dump/unsafe.hpp>
 #include <userver/fs/blocking/read.hpp>
 #include <userver/fs/blocking/temp_directory.hpp>
@@ -113,4 +117,56 @@ TEST(DumpOperationsFile, Underread) {
   FAIL();
 }
 
+UTEST(DumpOperationsFile, BlockIoWriteRead) {
+  for (const bool direct_io : {false, true}) {
+    for (const bool async_io : {false, true}) {
+      dump::FileIoSettings settings;
+      settings.buffer_size = dump::impl::kIoBlockAlignment;
+      settings.direct_io = direct_io;
+      settings.async_io = async_io;
+
+      const auto dir = fs::blocking::TempDirectory::Create();
+      const auto path = DumpFilePath(dir);
+
+      // Lengths below, at and above the buffer size, so that the reads and
+      // the writes span several blocks
+      std::vector<std::string> parts;
+      for (std::size_t i = 0; i < 50; ++i) {
+        parts.emplace_back(i * 331, static_cast<char>('a' + i % 26));
+      }
+
+      auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+      dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                              scope_time, settings);
+      for (const auto& part : parts) WriteStringViewUnsafe(writer, part);
+      writer.Finish();
+
+      std::string expected;
+      for (const auto& part : parts) expected += part;
+      EXPECT_EQ(fs::blocking::ReadFileContents(path), expected);
+
+      dump::FileReader reader(path, settings);
+      for (const auto& part : parts) {
+        EXPECT_EQ(ReadStringViewUnsafe(reader, part.size()), part)
+            << "direct_io=" << direct_io << " async_io=" << async_io;
+      }
+      EXPECT_NO_THROW(reader.Finish());
+    }
+  }
+}
+
+UTEST(DumpOperationsFile, BlockIoUnderread) {
+  const auto file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(file.GetPath(), std::string(10000, 'a'));
+
+  dump::FileIoSettings settings;
+  settings.buffer_size = dump::impl::kIoBlockAlignment;
+  settings.async_io = true;
+
+  dump::FileReader reader(file.GetPath(), settings);
+  EXPECT_EQ(ReadStringViewUnsafe(reader, 9000), std::string(9000, 'a'));
+  UEXPECT_THROW_MSG(reader.Finish(), dump::Error,
+                    "Unexpected extra data at the end of the dump file");
+}
+
 USERVER_NAMESPACE_END
@@ -6,6 +6,18 @@ USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
+namespace {
+
+formats::json::Value SerializeStages(const StageDurations& stages) {
+  formats::json::ValueBuilder result(formats::json::Type::kObject);
+  result["open"] = stages.open.load().count();
+  result["data"] = stages.data.load().count();
+  result["finish"] = stages.finish.load().count();
+  return result.ExtractValue();
+}
+
+}  // namespace
+
 formats::json::Value Serialize(const Statistics& stats,
                                formats::serialize::To<formats::json::Value>) {
   formats::json::ValueBuilder result(formats::json::Type::kObject);
@@ -14,6 +26,7 @@ formats::json::Value Serialize(const Statistics& stats,
   result["is-loaded-from-dump"] = is_loaded ? 1 : 0;
   if (is_loaded) {
     result["load-duration-ms"] = stats.load_duration.load().count();
+    result["load-stages-ms"] = SerializeStages(stats.load_stages);
   }
   result["is-current-from-dump"] = stats.is_current_from_dump.load() ? 1 : 0;
 
@@ -28,6 +41,7 @@ formats::json::Value Serialize(const Statistics& stats,
             .count();
     write["duration-ms"] = stats.last_nontrivial_write_duration.load().count();
     write["size-kb"] = stats.last_written_size.load() / 1024;
+    write["stages-ms"] = SerializeStages(stats.last_nontrivial_write_stages);
     result["last-nontrivial-write"] = write.ExtractValue();
   }
 
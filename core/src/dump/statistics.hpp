@@ -11,15 +11,24 @@ USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
+/// Durations of the stages of a single dump write or load
+struct StageDurations {
+  std::atomic<std::chrono::milliseconds> open{{}};
+  std::atomic<std::chrono::milliseconds> data{{}};
+  std::atomic<std::chrono::milliseconds> finish{{}};
+};
+
 struct Statistics {
   std::atomic<bool> is_loaded{false};
   std::atomic<bool> is_current_from_dump{false};
   std::atomic<std::chrono::milliseconds> load_duration{{}};
+  StageDurations load_stages;
 
   std::atomic<std::chrono::steady_clock::time_point>
       last_nontrivial_write_start_time{{}};
   std::atomic<std::chrono::milliseconds> last_nontrivial_write_duration{{}};
   std::atomic<std::size_t> last_written_size{0};
+  StageDurations last_nontrivial_write_stages;
 };
 
 formats::json::Value Serialize(const Statistics& stats,
@@ -1,5 +1,7 @@
 #include <userver/utest/utest.hpp>
 
+#include <vector>
+
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/dynamic_config/source.hpp>
 #include <userver/dynamic_config/storage_mock.hpp>
@@ -193,6 +195,41 @@ UTEST(DynamicConfig, Extend2) {
   EXPECT_EQ(config[kIntConfig], 5);
 }
 
+class IntConfigListener final {
+ public:
+  explicit IntConfigListener(dynamic_config::Source source)
+      : subscriber_(source.UpdateAndListen(
+            this, "test", &IntConfigListener::OnConfigUpdate, kIntConfig)) {}
+
+  ~IntConfigListener() { subscriber_.Unsubscribe(); }
+
+  std::vector<int> GetSeenValues() const { return seen_values_; }
+
+ private:
+  void OnConfigUpdate(const dynamic_config::Snapshot& config) {
+    seen_values_.push_back(config[kIntConfig]);
+  }
+
+  std::vector<int> seen_values_;
+  concurrent::AsyncEventSubscriberScope subscriber_;
+};
+
+UTEST(DynamicConfig, UpdateAndListenToKeys) {
+  dynamic_config::StorageMock storage{{kIntConfig, 5}, {kBoolConfig, false}};
+  IntConfigListener listener{storage.GetSource()};
+  EXPECT_EQ(listener.GetSeenValues(), std::vector<int>{5});
+
+  storage.Extend({{kBoolConfig, true}});
+  EXPECT_EQ(listener.GetSeenValues(), std::vector<int>{5});
+
+  storage.Extend({{kIntConfig, 6}});
+  EXPECT_EQ(listener.GetSeenValues(), (std::vector<int>{5, 6}));
+
+  // Any override is a new value, even if it is equal to the previous one
+  storage.Extend({{kIntConfig, 6}, {kBoolConfig, false}});
+  EXPECT_EQ(listener.GetSeenValues(), (std::vector<int>{5, 6, 6}));
+}
+
 }  // namespace
 
 USERVER_NAMESPACE_END
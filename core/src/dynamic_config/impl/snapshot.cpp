@@ -1,10 +1,19 @@
 #include <userver/dynamic_config/impl/snapshot.hpp>
 
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
 #include <fmt/format.h>
 
 #include <userver/compiler/demangle.hpp>
 #include <userver/dynamic_config/storage_mock.hpp>
+#include <userver/dynamic_config/value.hpp>
+#include <userver/formats/json/value.hpp>
 #include <userver/utils/cpu_relax.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/enumerate.hpp>
 #include <utils/impl/static_registration.hpp>
 
@@ -33,12 +42,83 @@ impl::ConfigId Register(impl::Factory factory) {
   return registry.size() - 1;
 }
 
+struct SnapshotData::Variable final {
+  std::shared_ptr<const std::any> value;
+  // The docs the value was parsed from, nullopt for the overrides
+  std::optional<std::vector<std::pair<std::string, formats::json::Value>>>
+      docs;
+  std::uint64_t version{0};
+};
+
+namespace {
+
+using Variable = SnapshotData::Variable;
+
+// Versions are unique across the snapshots, so that equal versions mean
+// the same parsed value
+std::uint64_t NextVersion() {
+  static std::atomic<std::uint64_t> last_version{0};
+  return ++last_version;
+}
+
+Variable MakeOverride(const KeyValue& config_variable) {
+  return {std::make_shared<const std::any>(config_variable.GetValue()),
+          std::nullopt, NextVersion()};
+}
+
+class RecordingScope final {
+ public:
+  RecordingScope(const DocsMap& docs_map, std::vector<std::string>& names)
+      : docs_map_(docs_map) {
+    docs_map_.StartRecordingRequests(names);
+  }
+
+  ~RecordingScope() { docs_map_.StopRecordingRequests(); }
+
+ private:
+  const DocsMap& docs_map_;
+};
+
+Variable Parse(Factory factory, const DocsMap& docs_map) {
+  std::vector<std::string> names;
+  std::any value;
+  {
+    RecordingScope recording{docs_map, names};
+    value = factory(docs_map);
+  }
+
+  std::vector<std::pair<std::string, formats::json::Value>> docs;
+  docs.reserve(names.size());
+  for (auto& name : names) {
+    const auto* doc = docs_map.Find(name);
+    UASSERT(doc);
+    docs.emplace_back(std::move(name), *doc);
+  }
+  return {std::make_shared<const std::any>(std::move(value)), std::move(docs),
+          NextVersion()};
+}
+
+bool IsParsedFrom(const Variable& variable, const DocsMap& docs_map) {
+  if (!variable.value || !variable.docs) return false;
+  for (const auto& [name, old_doc] : *variable.docs) {
+    const auto* doc = docs_map.Find(name);
+    if (!doc) return false;
+    // Unchanged docs are usually shared between the consecutive DocsMaps
+    if (!doc->DebugIsReferencingSameMemory(old_doc) && *doc != old_doc) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 SnapshotData::SnapshotData(const std::vector<KeyValue>& config_variables) {
   utils::impl::AssertStaticRegistrationFinished();
   user_configs_.resize(Registry().size());
 
   for (const auto& config_variable : config_variables) {
-    user_configs_[config_variable.GetId()] = config_variable.GetValue();
+    user_configs_[config_variable.GetId()] = MakeOverride(config_variable);
   }
 }
 
@@ -47,9 +127,9 @@ SnapshotData::SnapshotData(const DocsMap& defaults,
     : SnapshotData(overrides) {
   utils::StreamingCpuRelax relax(1, nullptr);
   for (const auto [id, factory] : utils::enumerate(Registry())) {
-    if (!user_configs_[id].has_value()) {
+    if (!user_configs_[id].value) {
       relax.Relax(1);
-      user_configs_[id] = factory(defaults);
+      user_configs_[id] = Parse(factory, defaults);
     }
   }
 }
@@ -58,16 +138,52 @@ SnapshotData::SnapshotData(const SnapshotData& defaults,
                            const std::vector<KeyValue>& overrides)
     : user_configs_(defaults.user_configs_) {
   for (const auto& config_variable : overrides) {
-    user_configs_[config_variable.GetId()] = config_variable.GetValue();
+    user_configs_[config_variable.GetId()] = MakeOverride(config_variable);
+  }
+}
+
+SnapshotData::SnapshotData(const DocsMap& docs_map,
+                           const SnapshotData& previous) {
+  utils::impl::AssertStaticRegistrationFinished();
+  const auto& registry = Registry();
+  user_configs_.reserve(registry.size());
+
+  utils::StreamingCpuRelax relax(1, nullptr);
+  for (const auto [id, factory] : utils::enumerate(registry)) {
+    if (id < previous.user_configs_.size() &&
+        IsParsedFrom(previous.user_configs_[id], docs_map)) {
+      user_configs_.push_back(previous.user_configs_[id]);
+    } else {
+      relax.Relax(1);
+      user_configs_.push_back(Parse(factory, docs_map));
+    }
+  }
+}
+
+SnapshotData::SnapshotData(SnapshotData&&) noexcept = default;
+
+SnapshotData& SnapshotData::operator=(SnapshotData&&) noexcept = default;
+
+SnapshotData::~SnapshotData() = default;
+
+std::uint64_t SnapshotData::GetVersion(ConfigId id) const {
+  return id < user_configs_.size() ? user_configs_[id].version : 0;
+}
+
+bool SnapshotData::HasSameVersions(const SnapshotData& other) const {
+  if (user_configs_.size() != other.user_configs_.size()) return false;
+  for (const auto [id, variable] : utils::enumerate(user_configs_)) {
+    if (variable.version != other.user_configs_[id].version) return false;
   }
+  return true;
 }
 
 const std::any& SnapshotData::Get(impl::ConfigId id) const {
-  const auto& config = user_configs_[id];
-  if (!config.has_value()) {
+  const auto& config = user_configs_[id].value;
+  if (!config || !config->has_value()) {
     throw std::logic_error("This type is not registered as config");
   }
-  return config;
+  return *config;
 }
 
 }  // namespace dynamic_config::impl
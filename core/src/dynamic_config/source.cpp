@@ -1,6 +1,10 @@
 #include <dynamic_config/storage_data.hpp>
 #include <userver/dynamic_config/source.hpp>
 
+#include <cstdint>
+#include <limits>
+#include <memory>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace dynamic_config {
@@ -19,6 +23,30 @@ concurrent::AsyncEventSubscriberScope Source::DoUpdateAndListen(
                                              [&] { func_copy(GetSnapshot()); });
 }
 
+concurrent::AsyncEventSubscriberScope Source::DoUpdateAndListen(
+    concurrent::FunctionId id, std::string_view name,
+    EventSource::Function&& func, std::vector<impl::ConfigId> ids) {
+  // Shared between the copies of the subscriber, so that the initial
+  // invocation is accounted for. The events are delivered one at a time.
+  auto seen_versions = std::make_shared<std::vector<std::uint64_t>>(
+      ids.size(), std::numeric_limits<std::uint64_t>::max());
+
+  return DoUpdateAndListen(
+      id, name,
+      [func = std::move(func), ids = std::move(ids),
+       seen_versions = std::move(seen_versions)](const Snapshot& config) {
+        bool changed = false;
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+          const auto version = config.GetData().GetVersion(ids[i]);
+          if ((*seen_versions)[i] != version) {
+            (*seen_versions)[i] = version;
+            changed = true;
+          }
+        }
+        if (changed) func(config);
+      });
+}
+
 }  // namespace dynamic_config
 
 USERVER_NAMESPACE_END
@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <optional>
 #include <string>
 #include <unordered_set>
 
@@ -153,13 +154,26 @@ void DynamicConfig::Impl::NotifyLoadingFailed(std::string_view updater,
 }
 
 void DynamicConfig::Impl::DoSetConfig(const dynamic_config::DocsMap& value) {
-  auto config = dynamic_config::impl::SnapshotData(value, {});
+  std::optional<dynamic_config::impl::SnapshotData> config;
+  bool changed = true;
+  {
+    const auto previous = cache_.config.Read();
+    // Only the variables with changed docs are parsed again
+    config.emplace(value, *previous);
+    changed = !Has() || !config->HasSameVersions(*previous);
+  }
   {
     std::lock_guard lock(loaded_mutex_);
-    cache_.config.Assign(std::move(config));
+    cache_.config.Assign(std::move(*config));
     is_loaded_ = true;
   }
   loaded_cv_.NotifyAll();
+
+  if (!changed) {
+    LOG_DEBUG() << "Dynamic config update does not change any variable, "
+                   "skipping the notification of subscribers";
+    return;
+  }
   cache_.channel.SendEvent(dynamic_config::Source{cache_}.GetSnapshot());
 }
 
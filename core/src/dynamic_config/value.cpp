@@ -17,6 +17,7 @@ formats::json::Value DocsMap::Get(const std::string& name) const {
   }
 
   requested_names_.insert(name);
+  if (recorded_names_) recorded_names_->push_back(name);
   return it->second;
 }
 
@@ -78,6 +79,17 @@ bool DocsMap::AreContentsEqual(const DocsMap& other) const {
   return docs_ == other.docs_;
 }
 
+void DocsMap::StartRecordingRequests(std::vector<std::string>& names) const {
+  recorded_names_ = &names;
+}
+
+void DocsMap::StopRecordingRequests() const { recorded_names_ = nullptr; }
+
+const formats::json::Value* DocsMap::Find(const std::string& name) const {
+  const auto it = docs_.find(name);
+  return it == docs_.end() ? nullptr : &it->second;
+}
+
 const std::string kValueDictDefaultName = "__default__";
 
 }  // namespace dynamic_config
@@ -3,17 +3,23 @@
 #include <algorithm>  // for std::max
 #include <atomic>
 #include <cerrno>
+#include <cstdint>
+#include <mutex>
+#include <optional>
 #include <utility>
+#include <vector>
 
 #include <moodycamel/concurrentqueue.h>
 #include <uboost_coro/coroutine2/coroutine.hpp>
-#include <uboost_coro/coroutine2/protected_fixedsize_stack.hpp>
 
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <utils/threads.hpp>
 
 #include "pool_config.hpp"
 #include "pool_stats.hpp"
+#include "stack_allocator.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -36,25 +42,134 @@ class Pool final {
   std::size_t GetStackSize() const;
 
  private:
-  Coroutine CreateCoroutine(bool quiet = false);
+  using Stack = StackAllocator::Stack;
+
+  struct CoroutineAndStack {
+    Coroutine coroutine;
+    Stack stack;
+  };
+
+  using Queue = moodycamel::ConcurrentQueue<CoroutineAndStack>;
+  class LocalCache;
+
+  // Suspended frames of the executor, the coroutine control block and the
+  // fiber record reside at the top of the stack, the pages are kept
+  static constexpr std::size_t kKeptStackTopBytes = 16 * 1024;
+
+  CoroutineAndStack CreateCoroutine(bool quiet = false);
   void OnCoroutineDestruction() noexcept;
+  std::optional<std::size_t> TrySampleStackUsage(const Stack& stack) const;
 
   template <typename Token>
   Token& GetToken();
 
+  static utils::FixedArray<Queue> MakeNumaNodeQueues();
+  Queue& GetHomeQueue();
+  LocalCache* GetLocalCache();
+  std::size_t GetIdleCoroutinesApprox() const;
+
   const PoolConfig config_;
   const Executor executor_;
 
-  boost::coroutines2::protected_fixedsize_stack stack_allocator_;
-  moodycamel::ConcurrentQueue<Coroutine> coroutines_;
+  StackAllocator stack_allocator_;
+  Queue coroutines_;
+  // Coroutines released by the threads bound to a NUMA node. Their stacks are
+  // likely to reside on that node, so they are reused only by its threads.
+  utils::FixedArray<Queue> numa_node_coroutines_;
   std::atomic<std::size_t> idle_coroutines_num_;
   std::atomic<std::size_t> total_coroutines_num_;
+
+  mutable std::mutex local_caches_mutex_;
+  std::vector<const LocalCache*> local_caches_;
+  PoolStats stats_of_dead_local_caches_;
+};
+
+// A small per-thread stash of hot coroutines in front of the shared queues.
+// Only the owning thread modifies it, the counters are atomic just for
+// GetStats() to read them from other threads.
+template <typename Task>
+class Pool<Task>::LocalCache final {
+ public:
+  explicit LocalCache(Pool<Task>& pool) : pool_(pool) {
+    coroutines_.reserve(pool_.config_.local_cache_size);
+    const std::lock_guard lock(pool_.local_caches_mutex_);
+    pool_.local_caches_.push_back(this);
+  }
+
+  LocalCache(const LocalCache&) = delete;
+  LocalCache& operator=(const LocalCache&) = delete;
+
+  ~LocalCache() {
+    {
+      const std::lock_guard lock(pool_.local_caches_mutex_);
+      auto& caches = pool_.local_caches_;
+      caches.erase(std::remove(caches.begin(), caches.end(), this),
+                   caches.end());
+      pool_.stats_of_dead_local_caches_ += GetStats();
+    }
+
+    // The thread is exiting, give the coroutines to the other threads
+    for (auto& coroutine : coroutines_) {
+      if (pool_.coroutines_.enqueue(std::move(coroutine))) {
+        ++pool_.idle_coroutines_num_;
+      }
+    }
+  }
+
+  std::optional<CoroutineAndStack> TryPop() {
+    if (coroutines_.empty()) {
+      Increment(misses_);
+      return std::nullopt;
+    }
+
+    Increment(hits_);
+    std::optional<CoroutineAndStack> result{std::move(coroutines_.back())};
+    coroutines_.pop_back();
+    size_.store(coroutines_.size(), std::memory_order_relaxed);
+    return result;
+  }
+
+  bool TryPush(CoroutineAndStack& coroutine) {
+    if (coroutines_.size() >= pool_.config_.local_cache_size) return false;
+
+    coroutines_.push_back(std::move(coroutine));
+    size_.store(coroutines_.size(), std::memory_order_relaxed);
+    return true;
+  }
+
+  std::size_t GetSizeApprox() const noexcept {
+    return size_.load(std::memory_order_relaxed);
+  }
+
+  bool BelongsTo(const Pool<Task>& pool) const noexcept {
+    return &pool_ == &pool;
+  }
+
+  PoolStats GetStats() const noexcept {
+    PoolStats stats;
+    stats.local_cache_hits = hits_.load(std::memory_order_relaxed);
+    stats.local_cache_misses = misses_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+ private:
+  static void Increment(std::atomic<std::uint64_t>& counter) noexcept {
+    // Single writer, no need for an atomic RMW
+    counter.store(counter.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+  }
+
+  Pool<Task>& pool_;
+  std::vector<CoroutineAndStack> coroutines_;
+  std::atomic<std::size_t> size_{0};
+  std::atomic<std::uint64_t> hits_{0};
+  std::atomic<std::uint64_t> misses_{0};
 };
 
 template <typename Task>
 class Pool<Task>::CoroutinePtr final {
  public:
-  CoroutinePtr(Coroutine&& coro, Pool<Task>& pool) noexcept
+  CoroutinePtr(CoroutineAndStack&& coro, Pool<Task>& pool) noexcept
       : coro_(std::move(coro)), pool_(&pool) {}
 
   CoroutinePtr(CoroutinePtr&&) noexcept = default;
@@ -62,21 +177,30 @@ class Pool<Task>::CoroutinePtr final {
 
   ~CoroutinePtr() {
     UASSERT(pool_);
-    if (coro_) pool_->OnCoroutineDestruction();
+    if (coro_.coroutine) pool_->OnCoroutineDestruction();
   }
 
   Coroutine& Get() noexcept {
-    UASSERT(coro_);
-    return coro_;
+    UASSERT(coro_.coroutine);
+    return coro_.coroutine;
+  }
+
+  /// Returns the stack usage of the coroutine for one in
+  /// `stack_usage_sample_rate` calls, std::nullopt otherwise
+  std::optional<std::size_t> TrySampleStackUsage() const {
+    UASSERT(coro_.coroutine);
+    return pool_->TrySampleStackUsage(coro_.stack);
   }
 
   void ReturnToPool() && {
-    UASSERT(coro_);
+    UASSERT(coro_.coroutine);
     pool_->PutCoroutine(std::move(*this));
   }
 
  private:
-  Coroutine coro_;
+  friend class Pool<Task>;
+
+  CoroutineAndStack coro_;
   Pool<Task>* pool_;
 };
 
@@ -84,8 +208,9 @@ template <typename Task>
 Pool<Task>::Pool(PoolConfig config, Executor executor)
     : config_(std::move(config)),
       executor_(executor),
-      stack_allocator_(config.stack_size),
+      stack_allocator_(config_.stack_size, config_.lazy_stacks),
       coroutines_(config_.max_size),
+      numa_node_coroutines_(MakeNumaNodeQueues()),
       idle_coroutines_num_(config_.initial_size),
       total_coroutines_num_(0) {
   moodycamel::ProducerToken token(coroutines_);
@@ -101,18 +226,26 @@ Pool<Task>::~Pool() = default;
 template <typename Task>
 typename Pool<Task>::CoroutinePtr Pool<Task>::GetCoroutine() {
   struct CoroutineMover {
-    std::optional<Coroutine>& result;
+    std::optional<CoroutineAndStack>& result;
 
-    CoroutineMover& operator=(Coroutine&& coro) {
+    CoroutineMover& operator=(CoroutineAndStack&& coro) {
       result.emplace(std::move(coro));
       return *this;
     }
   };
 
-  std::optional<Coroutine> coroutine;
+  auto* const local_cache = GetLocalCache();
+  if (local_cache) {
+    auto cached = local_cache->TryPop();
+    if (cached) return CoroutinePtr(std::move(*cached), *this);
+  }
+
+  std::optional<CoroutineAndStack> coroutine;
   CoroutineMover mover{coroutine};
+  auto& home_queue = GetHomeQueue();
   auto& token = GetToken<moodycamel::ConsumerToken>();
-  if (coroutines_.try_dequeue(token, mover)) {
+  if (home_queue.try_dequeue(token, mover) ||
+      (&home_queue != &coroutines_ && coroutines_.try_dequeue(mover))) {
     --idle_coroutines_num_;
   } else {
     coroutine.emplace(CreateCoroutine());
@@ -122,9 +255,20 @@ typename Pool<Task>::CoroutinePtr Pool<Task>::GetCoroutine() {
 
 template <typename Task>
 void Pool<Task>::PutCoroutine(CoroutinePtr&& coroutine_ptr) {
+  auto* const local_cache = GetLocalCache();
+  auto& coro = coroutine_ptr.coro_;
+  if (local_cache && local_cache->TryPush(coro)) return;
+
   if (idle_coroutines_num_.load() >= config_.max_size) return;
+
+  // Coroutines in the shared queues may stay idle for a long time, unlike the
+  // ones in the local cache
+  if (config_.lazy_stacks) {
+    StackAllocator::ReleaseUnusedPages(coro.stack, kKeptStackTopBytes);
+  }
+
   auto& token = GetToken<moodycamel::ProducerToken>();
-  const bool ok = coroutines_.enqueue(token, std::move(coroutine_ptr.Get()));
+  const bool ok = GetHomeQueue().enqueue(token, std::move(coro));
   if (ok) ++idle_coroutines_num_;
 }
 
@@ -132,29 +276,38 @@ template <typename Task>
 PoolStats Pool<Task>::GetStats() const {
   PoolStats stats;
   stats.active_coroutines =
-      total_coroutines_num_.load() - coroutines_.size_approx();
+      total_coroutines_num_.load() - GetIdleCoroutinesApprox();
   stats.total_coroutines =
       std::max(total_coroutines_num_.load(), stats.active_coroutines);
+
+  const std::lock_guard lock(local_caches_mutex_);
+  stats += stats_of_dead_local_caches_;
+  for (const auto* local_cache : local_caches_) {
+    stats.local_cached_coroutines += local_cache->GetSizeApprox();
+    stats += local_cache->GetStats();
+  }
   return stats;
 }
 
 template <typename Task>
-typename Pool<Task>::Coroutine Pool<Task>::CreateCoroutine(bool quiet) {
+typename Pool<Task>::CoroutineAndStack Pool<Task>::CreateCoroutine(
+    bool quiet) {
   try {
-    Coroutine coroutine(stack_allocator_, executor_);
+    Stack stack;
+    Coroutine coroutine(stack_allocator_.WithAllocatedStackOutput(stack),
+                        executor_);
     const auto new_total = ++total_coroutines_num_;
     if (!quiet) {
       LOG_DEBUG() << "Created a coroutine #" << new_total << '/'
                   << config_.max_size;
     }
-    return coroutine;
+    return {std::move(coroutine), stack};
   } catch (const std::bad_alloc&) {
     if (errno == ENOMEM) {
       // It should be ok to allocate here (which LOG_ERROR might do),
       // because ENOMEM is most likely coming from mmap
       // hitting vm.max_map_count limit, not from the actual memory limit.
-      // See `stack_context::allocate` in
-      // uboost_coro/context/posix/protected_fixedsize_stack.hpp
+      // See `StackAllocator::allocate`.
       LOG_ERROR() << "Failed to allocate a coroutine (ENOMEM), current "
                      "coroutines count: "
                   << total_coroutines_num_.load()
@@ -170,6 +323,16 @@ void Pool<Task>::OnCoroutineDestruction() noexcept {
   --total_coroutines_num_;
 }
 
+template <typename Task>
+std::optional<std::size_t> Pool<Task>::TrySampleStackUsage(
+    const Stack& stack) const {
+  if (config_.stack_usage_sample_rate == 0) return std::nullopt;
+
+  thread_local std::size_t calls_count = 0;
+  if (++calls_count % config_.stack_usage_sample_rate != 0) return std::nullopt;
+  return StackAllocator::MeasureUsage(stack);
+}
+
 template <typename Task>
 std::size_t Pool<Task>::GetStackSize() const {
   return config_.stack_size;
@@ -178,10 +341,52 @@ std::size_t Pool<Task>::GetStackSize() const {
 template <typename Task>
 template <typename Token>
 Token& Pool<Task>::GetToken() {
-  thread_local Token token(coroutines_);
+  // The home queue of a thread never changes, see GetHomeQueue()
+  thread_local Token token(GetHomeQueue());
   return token;
 }
 
+template <typename Task>
+utils::FixedArray<typename Pool<Task>::Queue> Pool<Task>::MakeNumaNodeQueues() {
+  const auto numa_nodes_count = utils::GetNumaNodesCount();
+  if (numa_nodes_count <= 1) return {};
+  return utils::FixedArray<Queue>(numa_nodes_count);
+}
+
+template <typename Task>
+typename Pool<Task>::Queue& Pool<Task>::GetHomeQueue() {
+  // Threads are bound to NUMA nodes before they start running tasks
+  const auto node = utils::GetCurrentThreadNumaNode();
+  if (node && *node < numa_node_coroutines_.size()) {
+    return numa_node_coroutines_[*node];
+  }
+  return coroutines_;
+}
+
+template <typename Task>
+typename Pool<Task>::LocalCache* Pool<Task>::GetLocalCache() {
+  if (config_.local_cache_size == 0) return nullptr;
+
+  // Current thread uses only a single Pool, see GetToken()
+  thread_local LocalCache local_cache(*this);
+  UASSERT(local_cache.BelongsTo(*this));
+  return &local_cache;
+}
+
+template <typename Task>
+std::size_t Pool<Task>::GetIdleCoroutinesApprox() const {
+  std::size_t result = coroutines_.size_approx();
+  for (const auto& queue : numa_node_coroutines_) {
+    result += queue.size_approx();
+  }
+
+  const std::lock_guard lock(local_caches_mutex_);
+  for (const auto* local_cache : local_caches_) {
+    result += local_cache->GetSizeApprox();
+  }
+  return result;
+}
+
 }  // namespace engine::coro
 
 USERVER_NAMESPACE_END
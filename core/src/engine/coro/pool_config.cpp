@@ -10,6 +10,11 @@ PoolConfig Parse(const yaml_config::YamlConfig& value,
   config.initial_size = value["initial_size"].As<size_t>();
   config.max_size = value["max_size"].As<size_t>();
   config.stack_size = value["stack_size"].As<size_t>(config.stack_size);
+  config.local_cache_size =
+      value["local_cache_size"].As<size_t>(config.local_cache_size);
+  config.lazy_stacks = value["lazy_stacks"].As<bool>(config.lazy_stacks);
+  config.stack_usage_sample_rate = value["stack_usage_sample_rate"].As<size_t>(
+      config.stack_usage_sample_rate);
   return config;
 }
 
@@ -13,6 +13,9 @@ struct PoolConfig {
   size_t initial_size = 1000;
   size_t max_size = 10000;
   size_t stack_size = 256 * 1024ULL;
+  size_t local_cache_size = 32;
+  bool lazy_stacks = false;
+  size_t stack_usage_sample_rate = 1000;
 };
 
 PoolConfig Parse(const yaml_config::YamlConfig& value,
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 
 USERVER_NAMESPACE_BEGIN
@@ -10,11 +11,17 @@ namespace engine::coro {
 struct PoolStats {
   size_t active_coroutines = 0;
   size_t total_coroutines = 0;
+  size_t local_cached_coroutines = 0;
+  std::uint64_t local_cache_hits = 0;
+  std::uint64_t local_cache_misses = 0;
 };
 
 inline PoolStats& operator+=(PoolStats& lhs, const PoolStats& rhs) {
   lhs.active_coroutines += rhs.active_coroutines;
   lhs.total_coroutines += rhs.total_coroutines;
+  lhs.local_cached_coroutines += rhs.local_cached_coroutines;
+  lhs.local_cache_hits += rhs.local_cache_hits;
+  lhs.local_cache_misses += rhs.local_cache_misses;
   return lhs;
 }
 
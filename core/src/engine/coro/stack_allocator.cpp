@@ -0,0 +1,107 @@
+#include "stack_allocator.hpp"
+
+#include <sys/mman.h>
+
+#include <cerrno>
+#include <new>
+#include <vector>
+
+#include <uboost_coro/context/stack_traits.hpp>
+
+#if defined(BOOST_USE_VALGRIND)
+#include <valgrind/valgrind.h>
+#endif
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::coro {
+
+namespace {
+
+std::size_t PageSize() noexcept {
+  return boost::context::stack_traits::page_size();
+}
+
+std::size_t RoundUpToPages(std::size_t size) noexcept {
+  const auto page_size = PageSize();
+  return (size + page_size - 1) / page_size * page_size;
+}
+
+// The lowest page of a stack is the guard page
+char* GetUsableBottom(const StackAllocator::Stack& stack) noexcept {
+  return static_cast<char*>(stack.sp) - stack.size + PageSize();
+}
+
+}  // namespace
+
+StackAllocator::StackAllocator(std::size_t stack_size, bool lazy)
+    : size_(RoundUpToPages(stack_size) + PageSize()), lazy_(lazy) {}
+
+StackAllocator StackAllocator::WithAllocatedStackOutput(
+    Stack& allocated_stack) const {
+  auto result = *this;
+  result.allocated_stack_ = &allocated_stack;
+  return result;
+}
+
+StackAllocator::Stack StackAllocator::allocate() {
+  const int flags =
+      MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK | (lazy_ ? MAP_NORESERVE : 0);
+  void* const vp = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, flags, -1, 0);
+  // ENOMEM is most likely caused by the vm.max_map_count limit, see the
+  // handling of std::bad_alloc in Pool::CreateCoroutine()
+  if (vp == MAP_FAILED) throw std::bad_alloc();
+
+  [[maybe_unused]] const int result = ::mprotect(vp, PageSize(), PROT_NONE);
+  UASSERT(result == 0);
+
+  Stack stack;
+  stack.size = size_;
+  stack.sp = static_cast<char*>(vp) + size_;
+#if defined(BOOST_USE_VALGRIND)
+  stack.valgrind_stack_id = VALGRIND_STACK_REGISTER(stack.sp, vp);
+#endif
+  if (allocated_stack_) *allocated_stack_ = stack;
+  return stack;
+}
+
+void StackAllocator::deallocate(Stack& stack) noexcept {
+  UASSERT(stack.sp);
+#if defined(BOOST_USE_VALGRIND)
+  VALGRIND_STACK_DEREGISTER(stack.valgrind_stack_id);
+#endif
+  void* const vp = static_cast<char*>(stack.sp) - stack.size;
+  ::munmap(vp, stack.size);
+}
+
+void StackAllocator::ReleaseUnusedPages(const Stack& stack,
+                                        std::size_t keep_top_bytes) noexcept {
+  char* const bottom = GetUsableBottom(stack);
+  char* const top = static_cast<char*>(stack.sp);
+  const auto keep = RoundUpToPages(keep_top_bytes);
+  if (static_cast<std::size_t>(top - bottom) <= keep) return;
+
+  // The pages are zero-filled on the next access, the mapping is kept
+  ::madvise(bottom, top - keep - bottom, MADV_DONTNEED);
+}
+
+std::size_t StackAllocator::MeasureUsage(const Stack& stack) {
+  char* const bottom = GetUsableBottom(stack);
+  char* const top = static_cast<char*>(stack.sp);
+  const auto page_size = PageSize();
+
+  thread_local std::vector<unsigned char> residency;
+  residency.resize((top - bottom) / page_size);
+  if (::mincore(bottom, top - bottom, residency.data()) != 0) return 0;
+
+  for (std::size_t i = 0; i < residency.size(); ++i) {
+    if (residency[i] & 1) return top - (bottom + i * page_size);
+  }
+  return 0;
+}
+
+}  // namespace engine::coro
+
+USERVER_NAMESPACE_END
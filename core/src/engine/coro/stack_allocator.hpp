@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+
+#include <uboost_coro/context/stack_context.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::coro {
+
+/// mmap-based coroutine stack allocator with a guard page, a replacement
+/// for boost::coroutines2::protected_fixedsize_stack.
+///
+/// In the lazy mode the stacks are mapped with MAP_NORESERVE, and the pages
+/// of idle stacks may be returned to the OS with ReleaseUnusedPages().
+class StackAllocator final {
+ public:
+  using Stack = boost::context::stack_context;
+
+  StackAllocator(std::size_t stack_size, bool lazy);
+
+  /// Returns a copy of the allocator that additionally stores every
+  /// allocated stack into `allocated_stack`
+  StackAllocator WithAllocatedStackOutput(Stack& allocated_stack) const;
+
+  // Boost.Context StackAllocator concept
+  Stack allocate();
+  void deallocate(Stack& stack) noexcept;
+
+  /// Hints the OS that the pages of an idle stack are not needed anymore,
+  /// except for `keep_top_bytes` at the top of the stack
+  static void ReleaseUnusedPages(const Stack& stack,
+                                 std::size_t keep_top_bytes) noexcept;
+
+  /// Returns the distance from the top of the stack to its lowest resident
+  /// page, which is an upper bound of the stack usage
+  static std::size_t MeasureUsage(const Stack& stack);
+
+ private:
+  std::size_t size_;
+  bool lazy_;
+  Stack* allocated_stack_{nullptr};
+};
+
+}  // namespace engine::coro
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,63 @@
+#include "stack_allocator.hpp"
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kStackSize = 256 * 1024;
+constexpr std::size_t kTouchedBytes = 100 * 1024;
+
+void TouchTop(const engine::coro::StackAllocator::Stack& stack,
+              std::size_t bytes) {
+  std::memset(static_cast<char*>(stack.sp) - bytes, 1, bytes);
+}
+
+}  // namespace
+
+TEST(StackAllocator, AllocatedStackOutput) {
+  engine::coro::StackAllocator::Stack output;
+  auto allocator = engine::coro::StackAllocator(kStackSize, /*lazy=*/false)
+                       .WithAllocatedStackOutput(output);
+
+  auto stack = allocator.allocate();
+  EXPECT_EQ(output.sp, stack.sp);
+  EXPECT_EQ(output.size, stack.size);
+  EXPECT_GT(stack.size, kStackSize);
+  allocator.deallocate(stack);
+}
+
+TEST(StackAllocator, MeasureUsage) {
+  engine::coro::StackAllocator allocator(kStackSize, /*lazy=*/true);
+  auto stack = allocator.allocate();
+
+  EXPECT_LT(engine::coro::StackAllocator::MeasureUsage(stack), kTouchedBytes);
+
+  TouchTop(stack, kTouchedBytes);
+  const auto usage = engine::coro::StackAllocator::MeasureUsage(stack);
+  EXPECT_GE(usage, kTouchedBytes);
+  EXPECT_LE(usage, kStackSize);
+
+  allocator.deallocate(stack);
+}
+
+TEST(StackAllocator, ReleaseUnusedPages) {
+  constexpr std::size_t kKeptBytes = 16 * 1024;
+  engine::coro::StackAllocator allocator(kStackSize, /*lazy=*/true);
+  auto stack = allocator.allocate();
+
+  TouchTop(stack, kTouchedBytes);
+  engine::coro::StackAllocator::ReleaseUnusedPages(stack, kKeptBytes);
+  EXPECT_LE(engine::coro::StackAllocator::MeasureUsage(stack), kKeptBytes);
+
+  // The released pages are still usable
+  TouchTop(stack, kTouchedBytes);
+  EXPECT_GE(engine::coro::StackAllocator::MeasureUsage(stack), kTouchedBytes);
+
+  allocator.deallocate(stack);
+}
+
+USERVER_NAMESPACE_END
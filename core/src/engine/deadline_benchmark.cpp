@@ -1,7 +1,11 @@
 #include <benchmark/benchmark.h>
 
 #include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
 
+#include <engine/ev/timer_wheel.hpp>
 #include <userver/engine/deadline.hpp>
 
 #include <utils/gbench_auxilary.hpp>
@@ -47,6 +51,43 @@ void deadline_100s_interval_reached(benchmark::State& state) {
   deadline_is_reached(state, std::chrono::seconds{100});
 }
 
+void deadline_timer_wheel(benchmark::State& state) {
+  using engine::ev::TimerWheel;
+  struct Timer final {
+    Timer() : entry([](TimerWheel::Entry&) noexcept {}, nullptr) {}
+
+    TimerWheel::Entry entry;
+  };
+
+  const auto timers_count = state.range(0);
+  std::vector<Timer> timers(timers_count);
+
+  std::minstd_rand rng;
+  std::uniform_int_distribution<std::int64_t> deadline_ms(1, 10'000);
+  std::vector<std::chrono::milliseconds> deadlines(timers_count);
+  for (auto& deadline : deadlines) {
+    deadline = std::chrono::milliseconds{deadline_ms(rng)};
+  }
+
+  auto now = TimerWheel::Clock::now();
+  TimerWheel wheel(std::chrono::milliseconds{1}, now);
+
+  for (auto _ : state) {
+    for (std::int64_t i = 0; i < timers_count; ++i) {
+      wheel.Schedule(timers[i].entry, now + deadlines[i]);
+    }
+    // Most of the requests finish before their deadlines
+    for (std::int64_t i = 0; i < timers_count; ++i) {
+      if (i % 4 != 0) wheel.Cancel(timers[i].entry);
+    }
+    while (!wheel.IsEmpty()) {
+      now += std::chrono::milliseconds{1};
+      wheel.Advance(now);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * timers_count);
+}
+
 }  // namespace
 
 BENCHMARK(deadline_1us_interval_construction);
@@ -56,4 +97,9 @@ BENCHMARK(deadline_1us_interval_reached);
 BENCHMARK(deadline_20ms_interval_reached);
 BENCHMARK(deadline_100s_interval_reached);
 
+BENCHMARK(deadline_timer_wheel)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 1'000'000)
+    ->Unit(benchmark::kMillisecond);
+
 USERVER_NAMESPACE_END
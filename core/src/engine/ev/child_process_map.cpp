@@ -15,8 +15,17 @@ ChildProcessMap& GetChildProcessMap() {
   return child_process_map;
 }
 
+std::mutex& GetChildProcessMapMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
 }  // namespace
 
+std::unique_lock<std::mutex> ChildProcessMapLock() {
+  return std::unique_lock{GetChildProcessMapMutex()};
+}
+
 ChildProcessMapValue* ChildProcessMapGetOptional(int pid) {
   auto& child_process_map = GetChildProcessMap();
   auto it = child_process_map.find(pid);
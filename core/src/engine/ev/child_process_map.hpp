@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <mutex>
 
 #include <userver/engine/future.hpp>
 #include <userver/engine/subprocess/child_process_status.hpp>
@@ -19,8 +20,11 @@ struct ChildProcessMapValue {
   engine::Promise<subprocess::ChildProcessStatus> status_promise;
 };
 
-// All ChildProcessMap* methods should be called from ev_default_loop's thread
-// only.
+// All ChildProcessMap* methods should be called under the lock. The child
+// processes are started from any thread, while their statuses are handled in
+// the ev_default_loop's thread, possibly right after the start.
+std::unique_lock<std::mutex> ChildProcessMapLock();
+
 ChildProcessMapValue* ChildProcessMapGetOptional(int pid);
 
 void ChildProcessMapErase(int pid);
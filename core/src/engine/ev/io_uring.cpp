@@ -0,0 +1,378 @@
+#include "io_uring.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <userver/engine/single_use_event.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <engine/impl/wait_list_light.hpp>
+#include <engine/task/task_context.hpp>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define USERVER_IMPL_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+#ifdef USERVER_IMPL_HAS_IO_URING
+
+namespace {
+
+unsigned LoadAcquire(const unsigned* ptr) noexcept {
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+void StoreRelease(unsigned* ptr, unsigned value) noexcept {
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+bool IsRetriableEnterError(int error) noexcept {
+  return error == EINTR || error == EAGAIN || error == EBUSY;
+}
+
+}  // namespace
+
+struct IoUring::SubmissionEntry final {
+  SubmissionEntry(std::uint8_t opcode, int fd) noexcept {
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = opcode;
+    sqe.fd = fd;
+  }
+
+  io_uring_sqe sqe;
+};
+
+// The kernel-shared memory of the ring
+struct IoUring::Ring final {
+  Ring() = default;
+  Ring(Ring&&) = delete;
+  Ring& operator=(Ring&&) = delete;
+
+  ~Ring() {
+    if (sqes) ::munmap(sqes, sqes_size);
+    if (ring_ptr) ::munmap(ring_ptr, ring_size);
+    if (fd != -1) ::close(fd);
+  }
+
+  int fd{-1};
+
+  void* ring_ptr{nullptr};
+  std::size_t ring_size{0};
+  io_uring_sqe* sqes{nullptr};
+  std::size_t sqes_size{0};
+
+  unsigned* sq_head{nullptr};
+  unsigned* sq_tail{nullptr};
+  unsigned sq_mask{0};
+  unsigned sq_entries{0};
+  unsigned* sq_array{nullptr};
+
+  unsigned* cq_head{nullptr};
+  unsigned* cq_tail{nullptr};
+  unsigned cq_mask{0};
+  io_uring_cqe* cqes{nullptr};
+};
+
+// Lives on the stack of the waiting coroutine until the ev thread reaps its
+// completion
+struct IoUring::Operation final {
+  engine::impl::WaitListLight waiters;
+  engine::SingleUseEvent reaped;
+  std::atomic<bool> completed{false};
+  int result{0};
+};
+
+class IoUring::OperationWaitStrategy final
+    : public engine::impl::WaitStrategy {
+ public:
+  OperationWaitStrategy(Operation& operation,
+                        engine::impl::TaskContext& current, Deadline deadline)
+      : WaitStrategy(deadline), operation_(operation), current_(current) {}
+
+  void SetupWakeups() override {
+    operation_.waiters.Append(&current_);
+    if (operation_.completed.load()) operation_.waiters.WakeupOne();
+  }
+
+  void DisableWakeups() override { operation_.waiters.Remove(current_); }
+
+ private:
+  Operation& operation_;
+  engine::impl::TaskContext& current_;
+};
+
+std::unique_ptr<IoUring> IoUring::TryCreate(std::size_t entries) {
+  auto ring = std::make_unique<Ring>();
+
+  io_uring_params params{};
+  params.flags = IORING_SETUP_CLAMP;
+  ring->fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+  if (ring->fd < 0) {
+    LOG_WARNING() << "io_uring is not available: " << std::strerror(errno);
+    return nullptr;
+  }
+
+  // NODROP and FAST_POLL (Linux 5.7+) are required not to lose completions
+  // and not to occupy the kernel worker threads by polls
+  constexpr auto kRequiredFeatures =
+      IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_FAST_POLL;
+  if ((params.features & kRequiredFeatures) != kRequiredFeatures) {
+    LOG_WARNING() << "io_uring is not used, the kernel is too old";
+    return nullptr;
+  }
+
+  ring->ring_size =
+      std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+               params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+  void* const ring_ptr =
+      ::mmap(nullptr, ring->ring_size, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+  if (ring_ptr == MAP_FAILED) {
+    LOG_WARNING() << "io_uring is not available, failed to map the ring: "
+                  << std::strerror(errno);
+    return nullptr;
+  }
+  ring->ring_ptr = ring_ptr;
+
+  ring->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+  void* const sqes =
+      ::mmap(nullptr, ring->sqes_size, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    LOG_WARNING() << "io_uring is not available, failed to map the SQEs: "
+                  << std::strerror(errno);
+    return nullptr;
+  }
+  ring->sqes = static_cast<io_uring_sqe*>(sqes);
+
+  auto* const base = static_cast<char*>(ring->ring_ptr);
+  ring->sq_head = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+  ring->sq_tail = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+  ring->sq_mask = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+  ring->sq_entries = params.sq_entries;
+  ring->sq_array = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+  ring->cq_head = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+  ring->cq_tail = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+  ring->cq_mask = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+  ring->cqes = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+
+  return std::unique_ptr<IoUring>(new IoUring(std::move(ring)));
+}
+
+IoUring::IoUring(std::unique_ptr<Ring> ring) : ring_(std::move(ring)) {
+  event_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  UINVARIANT(event_fd_ != -1, "Failed to create an eventfd for io_uring");
+
+  const auto result = ::syscall(__NR_io_uring_register, ring_->fd,
+                                IORING_REGISTER_EVENTFD, &event_fd_, 1);
+  UINVARIANT(result == 0, "Failed to register an eventfd for io_uring");
+}
+
+IoUring::~IoUring() {
+  UASSERT_MSG(LoadAcquire(ring_->cq_head) == LoadAcquire(ring_->cq_tail),
+              "io_uring is destroyed with unreaped completions");
+  ::close(event_fd_);
+}
+
+void IoUring::ReapCompletions() noexcept {
+  std::uint64_t counter = 0;
+  [[maybe_unused]] const auto read_result =
+      ::read(event_fd_, &counter, sizeof(counter));
+
+  auto head = *ring_->cq_head;
+  const auto tail = LoadAcquire(ring_->cq_tail);
+  for (; head != tail; ++head) {
+    const auto& cqe = ring_->cqes[head & ring_->cq_mask];
+    // Cancellation requests have no Operation
+    if (cqe.user_data == 0) continue;
+
+    // NOLINTNEXTLINE(performance-no-int-to-ptr)
+    auto& operation = *reinterpret_cast<Operation*>(cqe.user_data);
+    operation.result = cqe.res;
+    operation.completed.store(true);
+    operation.waiters.WakeupOne();
+    // The waiter may destroy the operation after that
+    operation.reaped.Send();
+  }
+  StoreRelease(ring_->cq_head, head);
+}
+
+IoUring::Result IoUring::Poll(int fd, short events, Deadline deadline) {
+  SubmissionEntry entry(IORING_OP_POLL_ADD, fd);
+  entry.sqe.poll32_events = static_cast<unsigned>(events);
+  return Perform(entry, deadline);
+}
+
+IoUring::Result IoUring::OpenAt(int dir_fd, const char* path, int flags,
+                                mode_t mode, Deadline deadline) {
+  SubmissionEntry entry(IORING_OP_OPENAT, dir_fd);
+  entry.sqe.addr = reinterpret_cast<std::uintptr_t>(path);
+  entry.sqe.len = mode;
+  entry.sqe.open_flags = static_cast<std::uint32_t>(flags);
+  return Perform(entry, deadline);
+}
+
+IoUring::Result IoUring::Read(int fd, void* buf, std::size_t len,
+                              std::uint64_t offset, Deadline deadline) {
+  SubmissionEntry entry(IORING_OP_READ, fd);
+  entry.sqe.addr = reinterpret_cast<std::uintptr_t>(buf);
+  entry.sqe.len = static_cast<std::uint32_t>(len);
+  entry.sqe.off = offset;
+  return Perform(entry, deadline);
+}
+
+IoUring::Result IoUring::Write(int fd, const void* buf, std::size_t len,
+                               std::uint64_t offset, Deadline deadline) {
+  SubmissionEntry entry(IORING_OP_WRITE, fd);
+  entry.sqe.addr = reinterpret_cast<std::uintptr_t>(buf);
+  entry.sqe.len = static_cast<std::uint32_t>(len);
+  entry.sqe.off = offset;
+  return Perform(entry, deadline);
+}
+
+IoUring::Result IoUring::FSync(int fd, Deadline deadline) {
+  SubmissionEntry entry(IORING_OP_FSYNC, fd);
+  return Perform(entry, deadline);
+}
+
+IoUring::Result IoUring::Close(int fd) {
+  SubmissionEntry entry(IORING_OP_CLOSE, fd);
+  Operation operation;
+  entry.sqe.user_data = reinterpret_cast<std::uintptr_t>(&operation);
+  Submit(entry);
+  operation.reaped.WaitNonCancellable();
+  return {operation.result, false};
+}
+
+void IoUring::CancelFd([[maybe_unused]] int fd) noexcept {
+#ifdef IORING_ASYNC_CANCEL_FD
+  SubmissionEntry entry(IORING_OP_ASYNC_CANCEL, fd);
+  entry.sqe.cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+  Submit(entry);
+#endif
+}
+
+IoUring::Result IoUring::Perform(SubmissionEntry& entry, Deadline deadline) {
+  auto& current = current_task::GetCurrentTaskContext();
+
+  Operation operation;
+  entry.sqe.user_data = reinterpret_cast<std::uintptr_t>(&operation);
+  Submit(entry);
+
+  bool interrupted = false;
+  OperationWaitStrategy wait_strategy(operation, current, deadline);
+  while (!operation.completed.load()) {
+    if (current.Sleep(wait_strategy) !=
+        engine::impl::TaskContext::WakeupSource::kWaitList) {
+      interrupted = true;
+      break;
+    }
+  }
+
+  if (!operation.completed.load()) {
+    SubmissionEntry cancel_entry(IORING_OP_ASYNC_CANCEL, -1);
+    cancel_entry.sqe.addr = reinterpret_cast<std::uintptr_t>(&operation);
+    Submit(cancel_entry);
+  }
+
+  // The kernel may still write to the buffers of the operation
+  operation.reaped.WaitNonCancellable();
+  return {operation.result, interrupted && operation.result == -ECANCELED};
+}
+
+void IoUring::Submit(const SubmissionEntry& entry) noexcept {
+  for (;;) {
+    {
+      const std::lock_guard lock(submission_mutex_);
+      const auto tail = *ring_->sq_tail;
+      if (tail - LoadAcquire(ring_->sq_head) < ring_->sq_entries) {
+        const auto index = tail & ring_->sq_mask;
+        ring_->sqes[index] = entry.sqe;
+        ring_->sq_array[index] = index;
+        StoreRelease(ring_->sq_tail, tail + 1);
+        break;
+      }
+    }
+    // The queue is full of the entries that the concurrent submitters have
+    // not entered yet
+    Enter();
+  }
+  Enter();
+}
+
+void IoUring::Enter() noexcept {
+  // Each submitter enters a single entry after adding its own one, so the
+  // entry might be submitted by the call of another submitter, and this call
+  // submits the next entry or nothing
+  for (;;) {
+    const auto submitted =
+        ::syscall(__NR_io_uring_enter, ring_->fd, 1, 0, 0, nullptr, 0);
+    if (submitted >= 0) return;
+
+    const auto error = errno;
+    // The completion queue is overflown, the ev thread is reaping it
+    UINVARIANT(IsRetriableEnterError(error),
+               std::string{"io_uring_enter failed: "} + std::strerror(error));
+    std::this_thread::yield();
+  }
+}
+
+#else  // USERVER_IMPL_HAS_IO_URING
+
+struct IoUring::Ring final {};
+
+std::unique_ptr<IoUring> IoUring::TryCreate(std::size_t) {
+  LOG_WARNING() << "io_uring is not supported on this platform";
+  return nullptr;
+}
+
+IoUring::~IoUring() = default;
+
+void IoUring::ReapCompletions() noexcept {}
+
+IoUring::Result IoUring::Poll(int, short, Deadline) {
+  UINVARIANT(false, "io_uring is not supported on this platform");
+}
+
+IoUring::Result IoUring::OpenAt(int, const char*, int, mode_t, Deadline) {
+  UINVARIANT(false, "io_uring is not supported on this platform");
+}
+
+IoUring::Result IoUring::Read(int, void*, std::size_t, std::uint64_t,
+                              Deadline) {
+  UINVARIANT(false, "io_uring is not supported on this platform");
+}
+
+IoUring::Result IoUring::Write(int, const void*, std::size_t, std::uint64_t,
+                               Deadline) {
+  UINVARIANT(false, "io_uring is not supported on this platform");
+}
+
+IoUring::Result IoUring::FSync(int, Deadline) {
+  UINVARIANT(false, "io_uring is not supported on this platform");
+}
+
+IoUring::Result IoUring::Close(int) {
+  UINVARIANT(false, "io_uring is not supported on this platform");
+}
+
+void IoUring::CancelFd(int) noexcept {}
+
+#endif  // USERVER_IMPL_HAS_IO_URING
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+/// An io_uring instance of an ev thread.
+///
+/// Operations are submitted directly from the waiting coroutine with a single
+/// io_uring_enter call, their completions are reaped by the ev thread that
+/// is notified via an eventfd.
+///
+/// All the methods except ReapCompletions() must be called from coroutines
+/// and are thread-safe.
+class IoUring final {
+ public:
+  struct Result {
+    /// Result of the operation, e.g. the amount of bytes transferred,
+    /// or a negative errno
+    int value{0};
+
+    /// Whether the waiting was interrupted by the deadline or the task
+    /// cancellation, and the operation was cancelled before its completion
+    bool interrupted{false};
+  };
+
+  /// Returns nullptr if io_uring is not supported by the kernel or is
+  /// disabled, e.g. by a seccomp policy
+  static std::unique_ptr<IoUring> TryCreate(std::size_t entries);
+
+  IoUring(IoUring&&) = delete;
+  IoUring& operator=(IoUring&&) = delete;
+  ~IoUring();
+
+  /// The descriptor becomes readable on new completions
+  int GetEventFd() const noexcept { return event_fd_; }
+
+  /// Must be called from the ev thread only
+  void ReapCompletions() noexcept;
+
+  /// Waits for poll(2) `events` on `fd`, returns the ready events
+  Result Poll(int fd, short events, Deadline deadline);
+
+  Result OpenAt(int dir_fd, const char* path, int flags, mode_t mode,
+                Deadline deadline);
+  Result Read(int fd, void* buf, std::size_t len, std::uint64_t offset,
+              Deadline deadline);
+  Result Write(int fd, const void* buf, std::size_t len, std::uint64_t offset,
+               Deadline deadline);
+  Result FSync(int fd, Deadline deadline);
+
+  /// Not cancellable
+  Result Close(int fd);
+
+  /// Asynchronously cancels all the operations on `fd`, they complete with
+  /// -ECANCELED. Must be called before closing the `fd`.
+  void CancelFd(int fd) noexcept;
+
+ private:
+  struct Ring;
+  struct Operation;
+  class OperationWaitStrategy;
+  struct SubmissionEntry;
+
+  explicit IoUring(std::unique_ptr<Ring> ring);
+
+  Result Perform(SubmissionEntry& entry, Deadline deadline);
+  void Submit(const SubmissionEntry& entry) noexcept;
+  void Enter() noexcept;
+
+  std::unique_ptr<Ring> ring_;
+  int event_fd_{-1};
+  // Guards the writes to the submission queue only, io_uring_enter is called
+  // without it
+  std::mutex submission_mutex_;
+};
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
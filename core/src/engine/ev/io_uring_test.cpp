@@ -0,0 +1,109 @@
+#include <engine/ev/io_uring.hpp>
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <engine/ev/thread_control.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/fs/read.hpp>
+#include <userver/fs/write.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using namespace std::chrono_literals;
+
+namespace {
+
+engine::TaskProcessorPoolsConfig MakeIoUringConfig() {
+  engine::TaskProcessorPoolsConfig config;
+  config.ev_use_io_uring = true;
+  return config;
+}
+
+class Pipe final {
+ public:
+  Pipe() { EXPECT_EQ(::pipe(fds_.data()), 0); }
+  ~Pipe() {
+    ::close(fds_[0]);
+    ::close(fds_[1]);
+  }
+
+  int In() const { return fds_[0]; }
+  int Out() const { return fds_[1]; }
+
+ private:
+  std::array<int, 2> fds_{};
+};
+
+}  // namespace
+
+TEST(IoUring, Poll) {
+  engine::RunStandalone(2, MakeIoUringConfig(), [] {
+    auto* ring = engine::current_task::GetEventThread().GetIoUring();
+    if (!ring) GTEST_SKIP() << "io_uring is not available";
+
+    Pipe pipe;
+    auto timed_out = ring->Poll(pipe.In(), POLLIN,
+                                engine::Deadline::FromDuration(10ms));
+    EXPECT_TRUE(timed_out.interrupted);
+
+    auto task = engine::AsyncNoSpan([&] {
+      return ring->Poll(pipe.In(), POLLIN, engine::Deadline{});
+    });
+    engine::SleepFor(10ms);
+    EXPECT_FALSE(task.IsFinished());
+    ASSERT_EQ(::write(pipe.Out(), "x", 1), 1);
+
+    const auto ready = task.Get();
+    EXPECT_FALSE(ready.interrupted);
+    EXPECT_TRUE(ready.value & POLLIN);
+  });
+}
+
+TEST(IoUring, PollCancel) {
+  engine::RunStandalone(2, MakeIoUringConfig(), [] {
+    auto* ring = engine::current_task::GetEventThread().GetIoUring();
+    if (!ring) GTEST_SKIP() << "io_uring is not available";
+
+    Pipe pipe;
+    auto task = engine::AsyncNoSpan([&] {
+      return ring->Poll(pipe.In(), POLLIN, engine::Deadline{});
+    });
+    engine::SleepFor(10ms);
+    task.RequestCancel();
+    EXPECT_TRUE(task.Get().interrupted);
+  });
+}
+
+TEST(IoUring, Files) {
+  engine::RunStandalone(2, MakeIoUringConfig(), [] {
+    if (!engine::current_task::GetEventThread().GetIoUring()) {
+      GTEST_SKIP() << "io_uring is not available";
+    }
+
+    const auto file = fs::blocking::TempFile::Create();
+    auto& tp = engine::current_task::GetTaskProcessor();
+    const std::string contents(200 * 1024, 'a');
+
+    fs::RewriteFileContents(tp, file.GetPath(), contents);
+    EXPECT_EQ(fs::ReadFileContents(tp, file.GetPath()), contents);
+
+    fs::RewriteFileContents(tp, file.GetPath(), "short");
+    EXPECT_EQ(fs::ReadFileContents(tp, file.GetPath()), "short");
+
+    EXPECT_THROW(fs::ReadFileContents(tp, file.GetPath() + ".missing"),
+                 std::runtime_error);
+  });
+}
+
+USERVER_NAMESPACE_END
@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <stdexcept>
+#include <utility>
 
 #include <sys/param.h>
 #include <sys/types.h>
@@ -12,6 +13,7 @@
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/datetime/steady_coarse_clock.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
 #include <userver/utils/thread_name.hpp>
 
 #include <utils/check_syscall.hpp>
@@ -58,20 +60,26 @@ void ReleaseEvDefaultLoop() {
 }
 
 constexpr std::chrono::milliseconds kCpuStatsCollectInterval{1000};
+constexpr std::size_t kIoUringEntries{1024};
 constexpr std::size_t kCpuStatsThrottle{16};
 
 }  // namespace
 
 Thread::Thread(const std::string& thread_name,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, false, register_event_mode) {}
+               RegisterEventMode register_event_mode,
+               std::chrono::microseconds timer_wheel_slack, bool use_io_uring)
+    : Thread(thread_name, false, register_event_mode, timer_wheel_slack,
+             use_io_uring) {}
 
 Thread::Thread(const std::string& thread_name, UseDefaultEvLoop,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, true, register_event_mode) {}
+               RegisterEventMode register_event_mode,
+               std::chrono::microseconds timer_wheel_slack, bool use_io_uring)
+    : Thread(thread_name, true, register_event_mode, timer_wheel_slack,
+             use_io_uring) {}
 
 Thread::Thread(const std::string& thread_name, bool use_ev_default_loop,
-               RegisterEventMode register_event_mode)
+               RegisterEventMode register_event_mode,
+               std::chrono::microseconds timer_wheel_slack, bool use_io_uring)
     : use_ev_default_loop_(use_ev_default_loop),
       register_event_mode_(register_event_mode),
       loop_(nullptr),
@@ -79,6 +87,10 @@ Thread::Thread(const std::string& thread_name, bool use_ev_default_loop,
       name_{thread_name},
       cpu_stats_storage_{kCpuStatsCollectInterval, kCpuStatsThrottle},
       is_running_(false) {
+  if (timer_wheel_slack.count() > 0) {
+    timer_wheel_.emplace(timer_wheel_slack, TimerWheel::Clock::now());
+  }
+  if (use_io_uring) io_uring_ = IoUring::TryCreate(kIoUringEntries);
   if (use_ev_default_loop_) AcquireEvDefaultLoop(name_);
   Start();
 }
@@ -93,8 +105,19 @@ void Thread::RunInEvLoopAsync(AsyncPayloadBase& payload) noexcept {
   RegisterInEvLoop(payload);
 
   if (!IsInEvThread()) {
-    ev_async_send(loop_, &watch_update_);
+    Wakeup();
+  }
+}
+
+void Thread::Wakeup() noexcept {
+  // If the loop is awake, it will see kAwakeWithWork before the next poll.
+  // The exchange also makes the pushed payload visible to that check.
+  if (loop_state_.exchange(LoopState::kAwakeWithWork) !=
+      LoopState::kSleeping) {
+    return;
   }
+  wakeups_.fetch_add(1, std::memory_order_relaxed);
+  ev_async_send(loop_, &watch_update_);
 }
 
 void Thread::RunInEvLoopDeferred(AsyncPayloadBase& payload,
@@ -129,12 +152,42 @@ bool Thread::IsInEvThread() const {
   return (std::this_thread::get_id() == thread_.get_id());
 }
 
+void Thread::StartTimer(TimerWheel::Entry& entry, Deadline deadline) noexcept {
+  UASSERT(IsInEvThread());
+  UASSERT(timer_wheel_);
+  UASSERT(deadline.IsReachable());
+  timer_wheel_->Schedule(entry, TimerWheel::Clock::now() + deadline.TimeLeft());
+  // The driver is stopped while the wheel is empty not to wake up an idle loop
+  if (!ev_is_active(&timer_wheel_driver_)) {
+    ev_now_update(loop_);
+    ev_timer_again(loop_, &timer_wheel_driver_);
+  }
+}
+
+void Thread::StopTimer(TimerWheel::Entry& entry) noexcept {
+  UASSERT(IsInEvThread());
+  UASSERT(timer_wheel_);
+  timer_wheel_->Cancel(entry);
+}
+
 std::uint8_t Thread::GetCurrentLoadPercent() const {
   return cpu_stats_storage_.GetCurrentLoadPercent();
 }
 
 const std::string& Thread::GetName() const { return name_; }
 
+ThreadStatistics Thread::GetStatistics() const noexcept {
+  ThreadStatistics stats;
+  stats.wakeups = wakeups_.load(std::memory_order_relaxed);
+  stats.self_wakeups = self_wakeups_.load(std::memory_order_relaxed);
+  stats.payloads = payloads_.load(std::memory_order_relaxed);
+  stats.payload_batches = payload_batches_.load(std::memory_order_relaxed);
+  stats.iterations = iterations_.load(std::memory_order_relaxed);
+  stats.iterations_time = std::chrono::microseconds{
+      iterations_time_us_.load(std::memory_order_relaxed)};
+  return stats;
+}
+
 void Thread::Start() {
   loop_ = use_ev_default_loop_ ? ev_default_loop(EVFLAG_AUTO)
                                : ev_loop_new(EVFLAG_AUTO);
@@ -174,6 +227,21 @@ void Thread::Start() {
     ev_timer_start(loop_, &stats_timer_);
   }
 
+  if (timer_wheel_) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+    ev_init(&timer_wheel_driver_, TimerWheelDriver);
+    timer_wheel_driver_.repeat =
+        std::chrono::duration_cast<LibEvDuration>(timer_wheel_->GetSlack())
+            .count();
+  }
+
+  if (io_uring_) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+    ev_io_init(&watch_io_uring_, IoUringWatcher, io_uring_->GetEventFd(),
+               EV_READ);
+    ev_io_start(loop_, &watch_io_uring_);
+  }
+
   if (use_ev_default_loop_) {
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
     ev_child_init(&watch_child_, ChildWatcher, 0, 0);
@@ -215,6 +283,8 @@ void Thread::RunEvLoop() {
   } else {
     ev_timer_stop(loop_, &stats_timer_);
   }
+  if (timer_wheel_) ev_timer_stop(loop_, &timer_wheel_driver_);
+  if (io_uring_) ev_io_stop(loop_, &watch_io_uring_);
   if (use_ev_default_loop_) ev_child_stop(loop_, &watch_child_);
 }
 
@@ -231,8 +301,34 @@ void Thread::UpdateTimersWatcher(struct ev_loop* loop, ev_timer*,
   ev_thread->UpdateLoopWatcherImpl();
 }
 
+void Thread::TimerWheelDriver(struct ev_loop* loop, ev_timer* w,
+                              int) noexcept {
+  auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
+  UASSERT(ev_thread != nullptr);
+  UASSERT(ev_thread->timer_wheel_);
+  auto& timer_wheel = *ev_thread->timer_wheel_;
+
+  timer_wheel.Advance(TimerWheel::Clock::now());
+  if (timer_wheel.IsEmpty()) ev_timer_stop(loop, w);
+}
+
+void Thread::IoUringWatcher(struct ev_loop* loop, ev_io*, int) noexcept {
+  auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
+  UASSERT(ev_thread != nullptr);
+  UASSERT(ev_thread->io_uring_);
+  ev_thread->io_uring_->ReapCompletions();
+}
+
 void Thread::UpdateLoopWatcherImpl() {
+  std::uint64_t batch_size = 0;
+  const utils::FastScopeGuard account_batch([&]() noexcept {
+    if (batch_size == 0) return;
+    payloads_.fetch_add(batch_size, std::memory_order_relaxed);
+    payload_batches_.fetch_add(1, std::memory_order_relaxed);
+  });
+
   while (AsyncPayloadBase* payload = func_queue_.TryPop()) {
+    ++batch_size;
     LOG_TRACE() << "Thread::UpdateLoopWatcherImpl(), "
                 << compiler::GetTypeName(typeid(*payload));
     try {
@@ -264,6 +360,8 @@ void Thread::ChildWatcher(struct ev_loop*, ev_child* w, int) noexcept {
 }
 
 void Thread::ChildWatcherImpl(ev_child* w) {
+  // Waits for the process to be registered by its starter
+  const auto lock = ChildProcessMapLock();
   auto* child_process_info = ChildProcessMapGetOptional(w->rpid);
   UASSERT(child_process_info);
   if (!child_process_info) {
@@ -302,21 +400,50 @@ void Thread::ChildWatcherImpl(ev_child* w) {
   }
 }
 
+// libev calls Release right before the poll and Acquire right after it
 void Thread::Acquire(struct ev_loop* loop) noexcept {
   auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
   UASSERT(ev_thread != nullptr);
   ev_thread->AcquireImpl();
+  ev_thread->OnPollFinished();
 }
 
 void Thread::Release(struct ev_loop* loop) noexcept {
   auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
   UASSERT(ev_thread != nullptr);
+  ev_thread->OnPollStarting();
   ev_thread->ReleaseImpl();
 }
 
 void Thread::AcquireImpl() noexcept { lock_.lock(); }
 void Thread::ReleaseImpl() noexcept { lock_.unlock(); }
 
+void Thread::OnPollFinished() noexcept {
+  loop_state_.store(LoopState::kAwake);
+  iteration_start_ = std::chrono::steady_clock::now();
+}
+
+void Thread::OnPollStarting() noexcept {
+  if (iteration_start_) {
+    const auto iteration_time = std::chrono::steady_clock::now() -
+                                std::exchange(iteration_start_, std::nullopt)
+                                    .value();
+    iterations_.fetch_add(1, std::memory_order_relaxed);
+    iterations_time_us_.fetch_add(
+        std::chrono::duration_cast<std::chrono::microseconds>(iteration_time)
+            .count(),
+        std::memory_order_relaxed);
+  }
+
+  // Payloads pushed while the loop was awake may have missed the drain of
+  // this iteration. The poll is interrupted right away to process them.
+  if (loop_state_.exchange(LoopState::kSleeping) ==
+      LoopState::kAwakeWithWork) {
+    self_wakeups_.fetch_add(1, std::memory_order_relaxed);
+    ev_async_send(loop_, &watch_update_);
+  }
+}
+
 }  // namespace engine::ev
 
 USERVER_NAMESPACE_END
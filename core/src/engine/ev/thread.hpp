@@ -1,8 +1,10 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 
@@ -12,6 +14,9 @@
 
 #include <concurrent/impl/intrusive_mpsc_queue.hpp>
 #include <engine/ev/async_payload_base.hpp>
+#include <engine/ev/io_uring.hpp>
+#include <engine/ev/thread_statistics.hpp>
+#include <engine/ev/timer_wheel.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -34,8 +39,13 @@ class Thread final {
     kDeferred
   };
 
-  Thread(const std::string& thread_name, RegisterEventMode);
-  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode);
+  // Zero `timer_wheel_slack` disables the timer wheel
+  Thread(const std::string& thread_name, RegisterEventMode,
+         std::chrono::microseconds timer_wheel_slack = {},
+         bool use_io_uring = false);
+  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode,
+         std::chrono::microseconds timer_wheel_slack = {},
+         bool use_io_uring = false);
   ~Thread();
 
   struct ev_loop* GetEvLoop() const { return loop_; }
@@ -52,14 +62,33 @@ class Thread final {
 
   bool IsInEvThread() const;
 
+  bool HasTimerWheel() const noexcept { return timer_wheel_.has_value(); }
+
+  // Must be called on the ev thread, requires HasTimerWheel().
+  void StartTimer(TimerWheel::Entry& entry, Deadline deadline) noexcept;
+
+  // Must be called on the ev thread, requires HasTimerWheel().
+  void StopTimer(TimerWheel::Entry& entry) noexcept;
+
+  // Returns nullptr if the thread does not use io_uring
+  IoUring* GetIoUring() const noexcept { return io_uring_.get(); }
+
   std::uint8_t GetCurrentLoadPercent() const;
   const std::string& GetName() const;
 
+  ThreadStatistics GetStatistics() const noexcept;
+
  private:
+  // Producers only wake up a sleeping loop, the loop rechecks the state
+  // before going to sleep
+  enum class LoopState : std::uint8_t { kSleeping, kAwake, kAwakeWithWork };
+
   Thread(const std::string& thread_name, bool use_ev_default_loop,
-         RegisterEventMode register_event_mode);
+         RegisterEventMode register_event_mode,
+         std::chrono::microseconds timer_wheel_slack, bool use_io_uring);
 
   void RegisterInEvLoop(AsyncPayloadBase& payload);
+  void Wakeup() noexcept;
 
   void Start();
 
@@ -68,6 +97,8 @@ class Thread final {
 
   static void UpdateLoopWatcher(struct ev_loop*, ev_async* w, int) noexcept;
   static void UpdateTimersWatcher(struct ev_loop*, ev_timer* w, int) noexcept;
+  static void TimerWheelDriver(struct ev_loop*, ev_timer* w, int) noexcept;
+  static void IoUringWatcher(struct ev_loop*, ev_io* w, int) noexcept;
   void UpdateLoopWatcherImpl();
   static void BreakLoopWatcher(struct ev_loop*, ev_async* w, int) noexcept;
   void BreakLoopWatcherImpl();
@@ -78,8 +109,11 @@ class Thread final {
   static void Release(struct ev_loop* loop) noexcept;
   void AcquireImpl() noexcept;
   void ReleaseImpl() noexcept;
+  void OnPollFinished() noexcept;
+  void OnPollStarting() noexcept;
 
   concurrent::impl::IntrusiveMpscQueue<AsyncPayloadBase> func_queue_;
+  std::atomic<LoopState> loop_state_{LoopState::kAwake};
 
   bool use_ev_default_loop_;
   RegisterEventMode register_event_mode_;
@@ -91,14 +125,28 @@ class Thread final {
 
   ev_timer timers_driver_{};
   ev_timer stats_timer_{};
+  ev_timer timer_wheel_driver_{};
   ev_async watch_update_{};
   ev_async watch_break_{};
   ev_child watch_child_{};
+  ev_io watch_io_uring_{};
 
   const std::string name_;
   utils::statistics::ThreadCpuStatsStorage cpu_stats_storage_;
+  std::optional<TimerWheel> timer_wheel_;
+  std::unique_ptr<IoUring> io_uring_;
 
   bool is_running_;
+
+  std::atomic<std::uint64_t> wakeups_{0};
+
+  // Written by the ev thread only
+  std::optional<std::chrono::steady_clock::time_point> iteration_start_;
+  std::atomic<std::uint64_t> self_wakeups_{0};
+  std::atomic<std::uint64_t> payloads_{0};
+  std::atomic<std::uint64_t> payload_batches_{0};
+  std::atomic<std::uint64_t> iterations_{0};
+  std::atomic<std::int64_t> iterations_time_us_{0};
 };
 
 }  // namespace engine::ev
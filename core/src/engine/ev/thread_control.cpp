@@ -48,6 +48,25 @@ void ThreadControl::Again(ev_timer& w) noexcept {
   ev_timer_again(GetEvLoop(), &w);
 }
 
+bool ThreadControl::HasTimerWheel() const noexcept {
+  return thread_.HasTimerWheel();
+}
+
+// NOLINTNEXTLINE(readability-make-member-function-const)
+void ThreadControl::Start(TimerWheel::Entry& entry,
+                          Deadline deadline) noexcept {
+  thread_.StartTimer(entry, deadline);
+}
+
+// NOLINTNEXTLINE(readability-make-member-function-const)
+void ThreadControl::Stop(TimerWheel::Entry& entry) noexcept {
+  thread_.StopTimer(entry);
+}
+
+IoUring* ThreadControl::GetIoUring() const noexcept {
+  return thread_.GetIoUring();
+}
+
 // NOLINTNEXTLINE(readability-make-member-function-const)
 void ThreadControl::Start(ev_io& w) noexcept {
   UASSERT(IsInEvThread());
@@ -80,6 +99,10 @@ std::uint8_t ThreadControl::GetCurrentLoadPercent() const {
 
 const std::string& ThreadControl::GetName() const { return thread_.GetName(); }
 
+ThreadStatistics ThreadControl::GetStatistics() const noexcept {
+  return thread_.GetStatistics();
+}
+
 }  // namespace engine::ev
 
 USERVER_NAMESPACE_END
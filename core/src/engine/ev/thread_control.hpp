@@ -9,6 +9,9 @@
 #include <ev.h>
 
 #include <engine/ev/async_payload_base.hpp>
+#include <engine/ev/io_uring.hpp>
+#include <engine/ev/thread_statistics.hpp>
+#include <engine/ev/timer_wheel.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/single_use_event.hpp>
 #include <userver/utils/fast_scope_guard.hpp>
@@ -113,6 +116,16 @@ class ThreadControl final {
   void Stop(ev_timer& w) noexcept;
   void Again(ev_timer& w) noexcept;
 
+  /// Coarse timers of the ev thread timer wheel, see
+  /// ThreadPoolConfig::timer_wheel_slack
+  bool HasTimerWheel() const noexcept;
+  void Start(TimerWheel::Entry& entry, Deadline deadline) noexcept;
+  void Stop(TimerWheel::Entry& entry) noexcept;
+
+  /// Returns nullptr if the ev thread does not use io_uring, see
+  /// ThreadPoolConfig::io_backend
+  IoUring* GetIoUring() const noexcept;
+
   void Start(ev_io& w) noexcept;
   void Stop(ev_io& w) noexcept;
 
@@ -145,6 +158,8 @@ class ThreadControl final {
   std::uint8_t GetCurrentLoadPercent() const;
   const std::string& GetName() const;
 
+  ThreadStatistics GetStatistics() const noexcept;
+
  private:
   Thread& thread_;
 };
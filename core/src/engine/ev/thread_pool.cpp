@@ -1,5 +1,7 @@
 #include "thread_pool.hpp"
 
+#include <exception>
+
 #include <fmt/format.h>
 
 #include <userver/utils/assert.hpp>
@@ -31,17 +33,35 @@ ThreadPool::ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop)
   const auto register_timer_event_mode =
       GetRegisterEventMode(config.defer_events);
 
+  const bool use_io_uring = config.io_backend == IoBackend::kIoUring;
+
   threads_ = utils::GenerateFixedArray(config.threads, [&](std::size_t index) {
     const auto thread_name = fmt::format("{}_{}", config.thread_name, index);
     return (use_ev_default_loop && index == 0)
                ? Thread(thread_name, Thread::kUseDefaultEvLoop,
-                        register_timer_event_mode)
-               : Thread(thread_name, register_timer_event_mode);
+                        register_timer_event_mode, config.timer_wheel_slack,
+                        use_io_uring)
+               : Thread(thread_name, register_timer_event_mode,
+                        config.timer_wheel_slack, use_io_uring);
   });
 
   thread_controls_ = utils::GenerateFixedArray(
       threads_.size(),
       [&](std::size_t index) { return ThreadControl(threads_[index]); });
+
+  if (!config.affinity.IsEmpty()) {
+    for (auto& thread_control : thread_controls_) {
+      std::exception_ptr error;
+      thread_control.RunInEvLoopBlocking([&affinity = config.affinity, &error] {
+        try {
+          affinity.ApplyToCurrentThread();
+        } catch (const std::exception&) {
+          error = std::current_exception();
+        }
+      });
+      if (error) std::rethrow_exception(error);
+    }
+  }
 }
 
 ThreadPool::~ThreadPool() = default;
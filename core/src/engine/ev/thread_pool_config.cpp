@@ -1,15 +1,51 @@
 #include "thread_pool_config.hpp"
 
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <userver/utils/assert.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
 
+IoBackend Parse(const yaml_config::YamlConfig& value,
+                formats::parse::To<IoBackend>) {
+  const auto str = value.As<std::string>();
+  if (str == "libev") {
+    return IoBackend::kLibev;
+  } else if (str == "io_uring") {
+    return IoBackend::kIoUring;
+  }
+
+  throw std::logic_error(fmt::format(
+      "Invalid IoBackend value '{}' at path '{}'", str, value.GetPath()));
+}
+
+std::string_view ToString(IoBackend backend) {
+  switch (backend) {
+    case IoBackend::kLibev:
+      return "libev";
+    case IoBackend::kIoUring:
+      return "io_uring";
+  }
+
+  UINVARIANT(false, "Unexpected value of IoBackend");
+}
+
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ThreadPoolConfig>) {
   ThreadPoolConfig config;
   config.threads = value["threads"].As<size_t>(config.threads);
   config.thread_name = value["thread_name"].As<std::string>(config.thread_name);
   config.defer_events = value["defer_events"].As<bool>(config.defer_events);
+  config.timer_wheel_slack =
+      value["timer_wheel_slack"].As<std::chrono::milliseconds>(
+          config.timer_wheel_slack);
+  config.io_backend = value["io_backend"].As<IoBackend>(config.io_backend);
+  config.affinity =
+      value["affinity"].As<ThreadAffinityConfig>(config.affinity);
   return config;
 }
 
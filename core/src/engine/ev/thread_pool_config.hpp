@@ -1,7 +1,10 @@
 #pragma once
 
+#include <chrono>
 #include <string>
+#include <string_view>
 
+#include <engine/thread_affinity_config.hpp>
 #include <userver/formats/yaml.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
@@ -9,11 +12,24 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
 
+enum class IoBackend {
+  kLibev,
+  kIoUring,
+};
+
+IoBackend Parse(const yaml_config::YamlConfig& value,
+                formats::parse::To<IoBackend>);
+
+std::string_view ToString(IoBackend backend);
+
 struct ThreadPoolConfig {
   size_t threads = 2;
   std::string thread_name = "event-worker";
   bool ev_default_loop_disabled = false;
   bool defer_events = false;
+  std::chrono::milliseconds timer_wheel_slack{0};
+  IoBackend io_backend{IoBackend::kLibev};
+  ThreadAffinityConfig affinity;
 };
 
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
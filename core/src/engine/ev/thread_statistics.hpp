@@ -0,0 +1,25 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+struct ThreadStatistics final {
+  // ev_async_send calls to wake up a sleeping loop
+  std::uint64_t wakeups{0};
+  // Wakeups for the payloads pushed while the loop was about to sleep
+  std::uint64_t self_wakeups{0};
+  // Payloads and the non-empty batches of them processed by the loop
+  std::uint64_t payloads{0};
+  std::uint64_t payload_batches{0};
+  // Loop iterations and the time spent in them between the polls
+  std::uint64_t iterations{0};
+  std::chrono::microseconds iterations_time{0};
+};
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
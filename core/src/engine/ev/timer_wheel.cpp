@@ -0,0 +1,157 @@
+#include "timer_wheel.hpp"
+
+#include <algorithm>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+TimerWheel::Entry::Entry(Callback callback, void* data) noexcept
+    : callback_(callback), data_(data) {}
+
+TimerWheel::Entry::~Entry() { UASSERT(!IsScheduled()); }
+
+TimerWheel::Slot::Slot() noexcept : head(nullptr, nullptr) {
+  head.prev_ = &head;
+  head.next_ = &head;
+}
+
+TimerWheel::Slot::~Slot() {
+  UASSERT(head.next_ == &head);
+  // The sentinel is not a scheduled entry
+  head.prev_ = nullptr;
+  head.next_ = nullptr;
+}
+
+TimerWheel::TimerWheel(std::chrono::microseconds slack, Clock::time_point now)
+    : slack_(slack), start_(now) {
+  UINVARIANT(slack_.count() > 0, "Timer wheel slack must be positive");
+}
+
+TimerWheel::~TimerWheel() {
+  UASSERT_MSG(IsEmpty(), "Timer wheel is destroyed with scheduled timers");
+}
+
+void TimerWheel::Schedule(Entry& entry, Clock::time_point expiry) noexcept {
+  if (entry.IsScheduled()) {
+    Unlink(entry);
+  } else {
+    ++size_;
+  }
+  entry.expiry_tick_ = ToTick(expiry);
+  Insert(entry, current_tick_ + 1);
+}
+
+void TimerWheel::Cancel(Entry& entry) noexcept {
+  if (!entry.IsScheduled()) return;
+  Unlink(entry);
+  --size_;
+}
+
+std::size_t TimerWheel::Advance(Clock::time_point now) noexcept {
+  const auto target_tick = now < start_ ? 0 : (now - start_) / slack_;
+  std::size_t fired = 0;
+
+  while (current_tick_ < static_cast<std::uint64_t>(target_tick)) {
+    if (IsEmpty()) {
+      current_tick_ = target_tick;
+      break;
+    }
+
+    ++current_tick_;
+    for (std::size_t level = 1; level < kLevelsCount; ++level) {
+      if ((current_tick_ >> (kSlotBits * level - kSlotBits)) % kSlotsCount !=
+          0) {
+        break;
+      }
+      Cascade(level);
+    }
+    fired += FireSlot(levels_[0][current_tick_ % kSlotsCount]);
+  }
+  return fired;
+}
+
+std::uint64_t TimerWheel::ToTick(Clock::time_point time_point) const noexcept {
+  if (time_point <= start_) return 0;
+  // Round up, timers must not fire early
+  return (time_point - start_ + slack_ - Clock::duration{1}) / slack_;
+}
+
+void TimerWheel::Insert(Entry& entry, std::uint64_t min_tick) noexcept {
+  UASSERT(min_tick >= current_tick_);
+  const auto expiry_tick = std::max(entry.expiry_tick_, min_tick);
+  const auto delta = expiry_tick - current_tick_;
+
+  std::size_t level = 0;
+  while (level + 1 < kLevelsCount &&
+         delta >= (std::uint64_t{1} << (kSlotBits * (level + 1)))) {
+    ++level;
+  }
+
+  // Timers beyond the wheel range are reinserted after a full revolution
+  const auto max_delta = (std::uint64_t{1} << (kSlotBits * kLevelsCount)) - 1;
+  const auto placement_tick =
+      delta > max_delta ? current_tick_ + max_delta : expiry_tick;
+
+  auto& head = levels_[level][(placement_tick >> (kSlotBits * level)) %
+                             kSlotsCount]
+                   .head;
+  entry.prev_ = head.prev_;
+  entry.next_ = &head;
+  head.prev_->next_ = &entry;
+  head.prev_ = &entry;
+}
+
+void TimerWheel::Unlink(Entry& entry) noexcept {
+  entry.prev_->next_ = entry.next_;
+  entry.next_->prev_ = entry.prev_;
+  entry.prev_ = nullptr;
+  entry.next_ = nullptr;
+}
+
+void TimerWheel::Cascade(std::size_t level) noexcept {
+  auto& head =
+      levels_[level][(current_tick_ >> (kSlotBits * level)) % kSlotsCount]
+          .head;
+  while (head.next_ != &head) {
+    auto& entry = *head.next_;
+    Unlink(entry);
+    // The current tick slot of the lowest level is not fired yet
+    Insert(entry, current_tick_);
+  }
+}
+
+std::size_t TimerWheel::FireSlot(Slot& slot) noexcept {
+  // Detach the expired entries first, callbacks may reschedule them
+  // into the same slot
+  Slot expired;
+  auto& head = slot.head;
+  while (head.next_ != &head) {
+    auto& entry = *head.next_;
+    Unlink(entry);
+    if (entry.expiry_tick_ > current_tick_) {
+      Insert(entry, current_tick_ + 1);
+      continue;
+    }
+    entry.prev_ = expired.head.prev_;
+    entry.next_ = &expired.head;
+    expired.head.prev_->next_ = &entry;
+    expired.head.prev_ = &entry;
+  }
+
+  std::size_t fired = 0;
+  while (expired.head.next_ != &expired.head) {
+    auto& entry = *expired.head.next_;
+    Unlink(entry);
+    --size_;
+    ++fired;
+    entry.callback_(entry);
+  }
+  return fired;
+}
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
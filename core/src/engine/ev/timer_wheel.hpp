@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+/// Hierarchical timer wheel that coalesces timers with the `slack` precision.
+///
+/// Scheduling and cancellation are O(1), unlike the libev timer heap. Timers
+/// never fire early and fire at most `slack` late (plus the ev loop latency).
+///
+/// Not thread-safe, all the methods must be called from the owning ev thread.
+class TimerWheel final {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  class Entry final {
+   public:
+    using Callback = void (*)(Entry&) noexcept;
+
+    Entry(Callback callback, void* data) noexcept;
+    ~Entry();
+
+    Entry(Entry&&) = delete;
+    Entry& operator=(Entry&&) = delete;
+
+    bool IsScheduled() const noexcept { return prev_ != nullptr; }
+    void* GetData() const noexcept { return data_; }
+
+   private:
+    friend class TimerWheel;
+
+    Entry* prev_{nullptr};
+    Entry* next_{nullptr};
+    std::uint64_t expiry_tick_{0};
+    const Callback callback_;
+    void* const data_;
+  };
+
+  TimerWheel(std::chrono::microseconds slack, Clock::time_point now);
+  ~TimerWheel();
+
+  TimerWheel(TimerWheel&&) = delete;
+  TimerWheel& operator=(TimerWheel&&) = delete;
+
+  /// Schedules or reschedules the entry to fire after `expiry`
+  void Schedule(Entry& entry, Clock::time_point expiry) noexcept;
+
+  /// Does nothing for a not scheduled entry
+  void Cancel(Entry& entry) noexcept;
+
+  /// Fires the callbacks of the expired entries, returns their count.
+  /// The callbacks may schedule and cancel entries.
+  std::size_t Advance(Clock::time_point now) noexcept;
+
+  bool IsEmpty() const noexcept { return size_ == 0; }
+  std::size_t GetSize() const noexcept { return size_; }
+  std::chrono::microseconds GetSlack() const noexcept { return slack_; }
+
+ private:
+  static constexpr std::size_t kSlotBits = 6;
+  static constexpr std::size_t kSlotsCount = 1 << kSlotBits;
+  static constexpr std::size_t kLevelsCount = 4;
+
+  // Every slot is a circular list with a sentinel head, which makes
+  // the unlinking branchless
+  struct Slot final {
+    Slot() noexcept;
+    ~Slot();
+
+    Entry head;
+  };
+
+  using Level = std::array<Slot, kSlotsCount>;
+
+  std::uint64_t ToTick(Clock::time_point time_point) const noexcept;
+  // Already expired entries are placed into the `min_tick` slot
+  void Insert(Entry& entry, std::uint64_t min_tick) noexcept;
+  static void Unlink(Entry& entry) noexcept;
+  void Cascade(std::size_t level) noexcept;
+  std::size_t FireSlot(Slot& slot) noexcept;
+
+  const std::chrono::microseconds slack_;
+  const Clock::time_point start_;
+  std::uint64_t current_tick_{0};
+  std::size_t size_{0};
+  std::array<Level, kLevelsCount> levels_;
+};
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
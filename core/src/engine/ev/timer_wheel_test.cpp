@@ -0,0 +1,152 @@
+#include <engine/ev/timer_wheel.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/sleep.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using engine::ev::TimerWheel;
+using namespace std::chrono_literals;
+
+constexpr auto kSlack = 1ms;
+
+struct Timer final {
+  Timer() : entry(&OnTimer, this) {}
+
+  static void OnTimer(TimerWheel::Entry& entry) noexcept {
+    ++static_cast<Timer*>(entry.GetData())->fired;
+  }
+
+  TimerWheel::Entry entry;
+  int fired{0};
+};
+
+}  // namespace
+
+TEST(TimerWheel, FiresNotEarly) {
+  const auto start = TimerWheel::Clock::now();
+  TimerWheel wheel(kSlack, start);
+  Timer timer;
+
+  wheel.Schedule(timer.entry, start + 10ms + 100us);
+  EXPECT_TRUE(timer.entry.IsScheduled());
+  EXPECT_EQ(wheel.GetSize(), 1);
+
+  EXPECT_EQ(wheel.Advance(start + 10ms), 0);
+  EXPECT_EQ(timer.fired, 0);
+
+  EXPECT_EQ(wheel.Advance(start + 11ms), 1);
+  EXPECT_EQ(timer.fired, 1);
+  EXPECT_FALSE(timer.entry.IsScheduled());
+  EXPECT_TRUE(wheel.IsEmpty());
+}
+
+TEST(TimerWheel, ExpiredFireOnNextTick) {
+  const auto start = TimerWheel::Clock::now();
+  TimerWheel wheel(kSlack, start);
+  Timer timer;
+
+  wheel.Advance(start + 5ms);
+  wheel.Schedule(timer.entry, start + 1ms);
+  EXPECT_EQ(wheel.Advance(start + 6ms), 1);
+  EXPECT_EQ(timer.fired, 1);
+}
+
+TEST(TimerWheel, CancelAndReschedule) {
+  const auto start = TimerWheel::Clock::now();
+  TimerWheel wheel(kSlack, start);
+  Timer cancelled;
+  Timer rescheduled;
+
+  wheel.Schedule(cancelled.entry, start + 5ms);
+  wheel.Schedule(rescheduled.entry, start + 5ms);
+  wheel.Cancel(cancelled.entry);
+  wheel.Cancel(cancelled.entry);
+  wheel.Schedule(rescheduled.entry, start + 500ms);
+  EXPECT_EQ(wheel.GetSize(), 1);
+
+  EXPECT_EQ(wheel.Advance(start + 499ms), 0);
+  EXPECT_EQ(wheel.Advance(start + 500ms), 1);
+  EXPECT_EQ(cancelled.fired, 0);
+  EXPECT_EQ(rescheduled.fired, 1);
+}
+
+TEST(TimerWheel, AllLevels) {
+  const auto start = TimerWheel::Clock::now();
+  TimerWheel wheel(kSlack, start);
+
+  // Covers every level of the wheel and the timers beyond its range
+  const std::vector<std::chrono::milliseconds> delays{
+      1ms, 63ms, 64ms, 65ms, 4095ms, 4096ms, 4097ms, 300s, 20000s, 40000s};
+  std::vector<Timer> timers(delays.size());
+  for (std::size_t i = 0; i < delays.size(); ++i) {
+    wheel.Schedule(timers[i].entry, start + delays[i]);
+  }
+
+  for (std::size_t i = 0; i < delays.size(); ++i) {
+    wheel.Advance(start + delays[i] - 1ms);
+    EXPECT_EQ(timers[i].fired, 0) << delays[i].count();
+    wheel.Advance(start + delays[i]);
+    EXPECT_EQ(timers[i].fired, 1) << delays[i].count();
+  }
+  EXPECT_TRUE(wheel.IsEmpty());
+}
+
+TEST(TimerWheel, RescheduleFromCallback) {
+  struct PeriodicTimer final {
+    PeriodicTimer(TimerWheel& wheel, TimerWheel::Clock::time_point start)
+        : wheel(wheel), next(start), entry(&OnTimer, this) {}
+
+    static void OnTimer(TimerWheel::Entry& entry) noexcept {
+      auto& self = *static_cast<PeriodicTimer*>(entry.GetData());
+      if (++self.fired == 3) return;
+      self.next += 10ms;
+      self.wheel.Schedule(self.entry, self.next);
+    }
+
+    TimerWheel& wheel;
+    TimerWheel::Clock::time_point next;
+    TimerWheel::Entry entry;
+    int fired{0};
+  };
+
+  const auto start = TimerWheel::Clock::now();
+  TimerWheel wheel(kSlack, start);
+  PeriodicTimer timer(wheel, start);
+  wheel.Schedule(timer.entry, start + 10ms);
+
+  wheel.Advance(start + 1s);
+  EXPECT_EQ(timer.fired, 3);
+  EXPECT_TRUE(wheel.IsEmpty());
+}
+
+TEST(TimerWheel, EngineTimers) {
+  engine::TaskProcessorPoolsConfig config;
+  config.ev_timer_wheel_slack = 1ms;
+  engine::RunStandalone(2, config, [] {
+    const auto start = std::chrono::steady_clock::now();
+    engine::SleepFor(10ms);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 10ms);
+
+    auto task =
+        engine::AsyncNoSpan([] { engine::InterruptibleSleepFor(100s); });
+    task.WaitFor(10ms);
+    EXPECT_FALSE(task.IsFinished());
+    task.SyncCancel();
+
+    auto timed_out_task =
+        engine::AsyncNoSpan(engine::Deadline::FromDuration(10ms),
+                            [] { engine::InterruptibleSleepFor(100s); });
+    timed_out_task.WaitFor(1s);
+    EXPECT_TRUE(timed_out_task.IsFinished());
+  });
+}
+
+USERVER_NAMESPACE_END
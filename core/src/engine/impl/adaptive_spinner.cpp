@@ -0,0 +1,68 @@
+#include <engine/impl/adaptive_spinner.hpp>
+
+#include <utility>
+
+#include <userver/utils/statistics/labels.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace {
+
+struct LockCounters final {
+  const LockContentionStatistics& stats;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const LockCounters& counters) {
+  const auto& stats = counters.stats;
+  writer["fast-path"] = stats.fast_path;
+  writer["spin-acquired"] = stats.spin_acquired;
+  writer["slept"] = stats.slept;
+  writer["spin-iterations"] = stats.spin_iterations;
+  writer["spin-budget"] = stats.spin_budget;
+}
+
+}  // namespace
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const LockContentionStatistics& stats) {
+  writer.ValueWithLabels(LockCounters{stats},
+                         utils::statistics::LabelView{"lock", stats.name});
+}
+
+namespace impl {
+
+AdaptiveSpinner::AdaptiveSpinner(AdaptiveSpinning settings)
+    : settings_(std::move(settings)) {}
+
+LockContentionStatistics AdaptiveSpinner::GetStatistics() const {
+  LockContentionStatistics stats;
+  stats.name = settings_.name;
+  stats.fast_path = fast_path_.load(std::memory_order_relaxed);
+  stats.spin_acquired = spin_acquired_.load(std::memory_order_relaxed);
+  stats.slept = slept_.load(std::memory_order_relaxed);
+  stats.spin_iterations = spin_iterations_.load(std::memory_order_relaxed);
+  stats.spin_budget = budget_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void AdaptiveSpinner::UpdateBudget(std::uint32_t iterations,
+                                   bool acquired) noexcept {
+  // Racy by design, losing an update only slows down the adaptation
+  const auto budget = budget_.load(std::memory_order_relaxed);
+  const auto target = acquired ? iterations : 0;
+  const auto new_budget =
+      static_cast<std::uint32_t>(budget + (static_cast<std::int64_t>(target) -
+                                           static_cast<std::int64_t>(budget)) /
+                                              8);
+  budget_.store(new_budget, std::memory_order_relaxed);
+}
+
+}  // namespace impl
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include <compiler/relax_cpu.hpp>
+#include <userver/engine/adaptive_spinning.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+/// Spins a lock acquisition for a learned amount of iterations before the
+/// caller goes to sleep and gathers the contention statistics.
+///
+/// The budget follows the glibc PTHREAD_MUTEX_ADAPTIVE_NP approach: spin up to
+/// twice the average successful spin length, move the average towards the
+/// last successful spin and decay it on failures, so long critical sections
+/// stop being spun for. Every kProbePeriod-th spin uses the maximum limit to
+/// learn the hold times again after the budget has decayed.
+class AdaptiveSpinner final {
+ public:
+  static constexpr std::uint32_t kMaxSpinIterations = 1000;
+  static constexpr std::uint32_t kInitialBudget = 100;
+  static constexpr std::uint32_t kProbePeriod = 64;
+
+  explicit AdaptiveSpinner(AdaptiveSpinning settings);
+
+  const std::string& GetName() const noexcept { return settings_.name; }
+
+  /// Calls `try_lock()` until it succeeds, `should_spin()` returns false or the
+  /// budget is exhausted. Returns whether the lock was acquired.
+  template <typename TryLock, typename ShouldSpin>
+  bool Spin(TryLock&& try_lock, ShouldSpin&& should_spin);
+
+  void AccountFastPath() noexcept { Increment(fast_path_); }
+  void AccountSleep() noexcept { Increment(slept_); }
+
+  LockContentionStatistics GetStatistics() const;
+
+ private:
+  static void Increment(std::atomic<std::uint64_t>& counter,
+                        std::uint64_t value = 1) noexcept {
+    counter.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  void UpdateBudget(std::uint32_t iterations, bool acquired) noexcept;
+
+  const AdaptiveSpinning settings_;
+  std::atomic<std::uint32_t> budget_{kInitialBudget};
+  std::atomic<std::uint32_t> spins_{0};
+  std::atomic<std::uint64_t> fast_path_{0};
+  std::atomic<std::uint64_t> spin_acquired_{0};
+  std::atomic<std::uint64_t> slept_{0};
+  std::atomic<std::uint64_t> spin_iterations_{0};
+};
+
+template <typename TryLock, typename ShouldSpin>
+bool AdaptiveSpinner::Spin(TryLock&& try_lock, ShouldSpin&& should_spin) {
+  const auto budget = budget_.load(std::memory_order_relaxed);
+  const bool probe =
+      spins_.fetch_add(1, std::memory_order_relaxed) % kProbePeriod == 0;
+  const auto limit = probe ? kMaxSpinIterations
+                           : std::min(kMaxSpinIterations, budget * 2 + 10);
+
+  compiler::RelaxCpu relax;
+  std::uint32_t iterations = 0;
+  bool acquired = false;
+  while (iterations < limit && should_spin()) {
+    relax();
+    ++iterations;
+    if (try_lock()) {
+      acquired = true;
+      break;
+    }
+  }
+
+  if (iterations == 0) return false;
+  Increment(spin_iterations_, iterations);
+  if (acquired) Increment(spin_acquired_);
+  UpdateBudget(iterations, acquired);
+  return acquired;
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
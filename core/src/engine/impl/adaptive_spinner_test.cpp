@@ -0,0 +1,56 @@
+#include <engine/impl/adaptive_spinner.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+bool SpinUntilIteration(engine::impl::AdaptiveSpinner& spinner,
+                        std::uint32_t success_iteration) {
+  std::uint32_t iteration = 0;
+  return spinner.Spin([&] { return ++iteration == success_iteration; },
+                      [] { return true; });
+}
+
+}  // namespace
+
+TEST(AdaptiveSpinner, LearnsShortHolds) {
+  engine::impl::AdaptiveSpinner spinner{{"test"}};
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(SpinUntilIteration(spinner, 20));
+  }
+
+  const auto stats = spinner.GetStatistics();
+  EXPECT_EQ(stats.name, "test");
+  EXPECT_EQ(stats.spin_acquired, 100);
+  EXPECT_GE(stats.spin_budget, 15);
+  EXPECT_LE(stats.spin_budget, 30);
+}
+
+TEST(AdaptiveSpinner, BacksOffOnLongHolds) {
+  engine::impl::AdaptiveSpinner spinner{{"test"}};
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(SpinUntilIteration(spinner, 100));
+  }
+  const auto learned_budget = spinner.GetStatistics().spin_budget;
+  EXPECT_GT(learned_budget, 50);
+
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_FALSE(SpinUntilIteration(spinner,
+                                    engine::impl::AdaptiveSpinner::
+                                        kMaxSpinIterations + 1));
+  }
+  EXPECT_LT(spinner.GetStatistics().spin_budget, 10);
+}
+
+TEST(AdaptiveSpinner, NoSpinning) {
+  engine::impl::AdaptiveSpinner spinner{{"test"}};
+  EXPECT_FALSE(spinner.Spin([] { return true; }, [] { return false; }));
+
+  const auto stats = spinner.GetStatistics();
+  EXPECT_EQ(stats.spin_acquired, 0);
+  EXPECT_EQ(stats.spin_iterations, 0);
+}
+
+USERVER_NAMESPACE_END
@@ -6,6 +6,8 @@
 #include <userver/utils/assert.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
 
+#include <userver/concurrent/sharded_variable.hpp>
+
 #include <concurrent/intrusive_walkable_pool.hpp>
 #include <engine/task/task_context.hpp>
 
@@ -13,10 +15,15 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::impl {
 
+namespace {
+struct TokenShard;
+}  // namespace
+
 struct DetachedTasksSyncBlock::Token final {
-  explicit Token(DetachedTasksSyncBlock& owner) : owner(owner) {}
+  explicit Token(TokenShard& shard) : shard(shard) {}
 
-  DetachedTasksSyncBlock& owner;
+  // The shard is not necessarily the local one at the time of Dispose
+  TokenShard& shard;
 
   concurrent::impl::IntrusiveWalkablePoolHook<Token> pool_hook{};
 
@@ -27,11 +34,22 @@ struct DetachedTasksSyncBlock::Token final {
   utils::impl::WaitTokenStorage::Token wait_token{};
 };
 
+namespace {
+
+// Per-worker pools, so that concurrent Add calls do not contend on a single
+// free list
+struct TokenShard final {
+  concurrent::impl::IntrusiveWalkablePool<
+      DetachedTasksSyncBlock::Token,
+      concurrent::impl::MemberHook<&DetachedTasksSyncBlock::Token::pool_hook>>
+      pool{};
+};
+
+}  // namespace
+
 struct DetachedTasksSyncBlock::Impl final {
   std::optional<utils::impl::WaitTokenStorage> wait_tokens{};
-  concurrent::impl::IntrusiveWalkablePool<
-      Token, concurrent::impl::MemberHook<&Token::pool_hook>>
-      cancel_tokens{};
+  concurrent::ShardedVariable<TokenShard> cancel_tokens{};
   std::atomic<TaskCancellationReason> cancel_new_tasks{
       TaskCancellationReason::kNone};
 };
@@ -45,7 +63,8 @@ DetachedTasksSyncBlock::DetachedTasksSyncBlock(StopMode stop_mode) {
 DetachedTasksSyncBlock::~DetachedTasksSyncBlock() = default;
 
 void DetachedTasksSyncBlock::Add(TaskContext& context) {
-  auto& token = impl_->cancel_tokens.Acquire([this] { return Token(*this); });
+  auto& shard = impl_->cancel_tokens.GetLocal();
+  auto& token = shard.pool.Acquire([&shard] { return Token(shard); });
   UASSERT(token.task == nullptr);
 
   boost::intrusive_ptr<TaskContext> context_copy(&context);
@@ -75,21 +94,23 @@ void DetachedTasksSyncBlock::Dispose(Token& token) noexcept {
                                                     /*add_ref=*/false);
   }
   [[maybe_unused]] const auto wait_token = std::move(token.wait_token);
-  token.owner.impl_->cancel_tokens.Release(token);
+  token.shard.pool.Release(token);
 }
 
 void DetachedTasksSyncBlock::RequestCancellation(
     TaskCancellationReason reason) noexcept {
   impl_->cancel_new_tasks.store(reason);
 
-  impl_->cancel_tokens.Walk([&](Token& token) {
-    auto* const context_ptr = token.task.exchange(nullptr);
+  impl_->cancel_tokens.VisitAll([&](TokenShard& shard) {
+    shard.pool.Walk([&](Token& token) {
+      auto* const context_ptr = token.task.exchange(nullptr);
 
-    if (context_ptr != nullptr) {
-      boost::intrusive_ptr<TaskContext> context(context_ptr,
-                                                /*add_ref=*/false);
-      context->RequestCancel(reason);
-    }
+      if (context_ptr != nullptr) {
+        boost::intrusive_ptr<TaskContext> context(context_ptr,
+                                                  /*add_ref=*/false);
+        context->RequestCancel(reason);
+      }
+    });
   });
 
   if (impl_->wait_tokens) {
@@ -1,14 +1,17 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 
 #include <userver/engine/deadline.hpp>
 
 #include <userver/utils/assert.hpp>
 
+#include <engine/impl/adaptive_spinner.hpp>
 #include <engine/impl/wait_list.hpp>
 #include <engine/impl/wait_list_light.hpp>
 #include <engine/task/task_context.hpp>
+#include <engine/task/task_processor.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -18,6 +21,7 @@ template <class Waiters>
 class MutexImpl {
  public:
   MutexImpl();
+  explicit MutexImpl(AdaptiveSpinning settings);
   ~MutexImpl();
 
   MutexImpl(const MutexImpl&) = delete;
@@ -33,13 +37,19 @@ class MutexImpl {
 
   bool try_lock_until(Deadline deadline);
 
+  /// nullptr if the mutex does not spin
+  const AdaptiveSpinner* GetSpinner() const noexcept { return spinner_.get(); }
+
  private:
   class MutexWaitStrategy;
 
   bool LockFastPath(TaskContext&);
+  bool LockSpinning(TaskContext&);
   bool LockSlowPath(TaskContext&, Deadline);
 
   std::atomic<TaskContext*> owner_;
+  // Fills the padding before the over-aligned WaitListLight
+  const std::unique_ptr<AdaptiveSpinner> spinner_;
   Waiters lock_waiters_;
 };
 
@@ -93,6 +103,11 @@ class MutexImpl<WaitListLight>::MutexWaitStrategy final : public WaitStrategy {
 template <class Waiters>
 MutexImpl<Waiters>::MutexImpl() : owner_(nullptr) {}
 
+template <class Waiters>
+MutexImpl<Waiters>::MutexImpl(AdaptiveSpinning settings)
+    : owner_(nullptr),
+      spinner_(std::make_unique<AdaptiveSpinner>(std::move(settings))) {}
+
 template <class Waiters>
 MutexImpl<Waiters>::~MutexImpl() {
   UASSERT(!owner_);
@@ -105,8 +120,26 @@ bool MutexImpl<Waiters>::LockFastPath(TaskContext& current) {
                                         std::memory_order_acquire);
 }
 
+template <class Waiters>
+bool MutexImpl<Waiters>::LockSpinning(TaskContext& current) {
+  UASSERT(spinner_);
+  // Nobody may release the lock while we spin on a single worker. The state
+  // of the owner is not checked: it may be destroyed right after the unlock.
+  if (current.GetTaskProcessor().GetWorkerCount() < 2) return false;
+
+  return spinner_->Spin(
+      [&] { return !owner_.load(std::memory_order_relaxed) &&
+                   LockFastPath(current); },
+      [&] { return owner_.load(std::memory_order_relaxed) != &current; });
+}
+
 template <class Waiters>
 bool MutexImpl<Waiters>::LockSlowPath(TaskContext& current, Deadline deadline) {
+  if (spinner_ && !deadline.IsReached()) {
+    if (LockSpinning(current)) return true;
+    spinner_->AccountSleep();
+  }
+
   TaskContext* expected = nullptr;
 
   const engine::TaskCancellationBlocker block_cancels;
@@ -156,7 +189,11 @@ bool MutexImpl<Waiters>::try_lock() {
 template <class Waiters>
 bool MutexImpl<Waiters>::try_lock_until(Deadline deadline) {
   auto& current = current_task::GetCurrentTaskContext();
-  return LockFastPath(current) || LockSlowPath(current, deadline);
+  if (LockFastPath(current)) {
+    if (spinner_) spinner_->AccountFastPath();
+    return true;
+  }
+  return LockSlowPath(current, deadline);
 }
 
 }  // namespace engine::impl
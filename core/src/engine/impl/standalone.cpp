@@ -25,6 +25,10 @@ std::shared_ptr<TaskProcessorPools> MakeTaskProcessorPools(
   ev_config.thread_name = pools_config.ev_thread_name;
   ev_config.ev_default_loop_disabled = pools_config.ev_default_loop_disabled;
   ev_config.defer_events = pools_config.defer_events;
+  ev_config.timer_wheel_slack = pools_config.ev_timer_wheel_slack;
+  ev_config.io_backend = pools_config.ev_use_io_uring
+                             ? ev::IoBackend::kIoUring
+                             : ev::IoBackend::kLibev;
 
   return std::make_shared<TaskProcessorPools>(std::move(coro_config),
                                               std::move(ev_config));
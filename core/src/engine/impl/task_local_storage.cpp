@@ -1,10 +1,11 @@
 #include <userver/engine/impl/task_local_storage.hpp>
 
+#include <utility>
+
 #include <fmt/format.h>
-#include <boost/intrusive/list.hpp>
 #include <boost/intrusive/list_hook.hpp>
 #include <boost/intrusive/slist.hpp>
-#include <boost/range/adaptor/reversed.hpp>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
 
 #include <engine/task/task_context.hpp>
 #include <userver/compiler/demangle.hpp>
@@ -47,10 +48,54 @@ using NormalDataList = boost::intrusive::slist<
     boost::intrusive::constant_time_size<false>, boost::intrusive::linear<true>,
     boost::intrusive::cache_last<false>>;
 
-using InheritedDataList = boost::intrusive::list<
-    DataPtr,
-    boost::intrusive::member_hook<DataPtr, ListHook, &DataPtr::list_hook>,
-    boost::intrusive::constant_time_size<false>>;
+// Inherited variables are immutable once the parent task has shared them
+// with a child, so the whole set is shared by a single pointer. A shared set
+// is copied on the first modification, the copy only bumps the refcounts.
+class InheritedVariables final {
+ public:
+  InheritedVariables()
+      : nodes_(std::make_unique<InheritedDataBase*[]>(variable_count)) {}
+
+  InheritedVariables(const InheritedVariables& other) : InheritedVariables() {
+    for (Key key = 0; key < variable_count; ++key) {
+      auto* const node = other.nodes_[key];
+      if (!node) continue;
+      node->AddRef();
+      nodes_[key] = node;
+    }
+  }
+
+  InheritedVariables& operator=(const InheritedVariables&) = delete;
+
+  ~InheritedVariables() {
+    for (Key key = 0; key < variable_count; ++key) {
+      if (nodes_[key]) nodes_[key]->DeleteSelf();
+    }
+  }
+
+  InheritedDataBase*& operator[](Key key) noexcept {
+    UASSERT(key < variable_count);
+    return nodes_[key];
+  }
+
+  bool IsShared() const noexcept {
+    return ref_counter_.load(std::memory_order_acquire) != 1;
+  }
+
+  friend void intrusive_ptr_add_ref(InheritedVariables* ptr) noexcept {
+    ptr->ref_counter_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  friend void intrusive_ptr_release(InheritedVariables* ptr) noexcept {
+    if (ptr->ref_counter_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete ptr;
+    }
+  }
+
+ private:
+  std::atomic<std::size_t> ref_counter_{0};
+  const std::unique_ptr<InheritedDataBase*[]> nodes_;
+};
 
 }  // namespace
 
@@ -71,11 +116,20 @@ void ReportVariableNotSet(const std::type_info& type) {
 struct Storage::Impl final {
   std::unique_ptr<DataPtr[]> data;
   NormalDataList normal_data_storage;
-  InheritedDataList inherited_data_storage;
+  boost::intrusive_ptr<InheritedVariables> inherited_data;
 
-  void DoSetGeneric(Key key, DataBase& node);
+  InheritedVariables& GetMutableInherited();
 };
 
+InheritedVariables& Storage::Impl::GetMutableInherited() {
+  if (!inherited_data) {
+    inherited_data = new InheritedVariables();
+  } else if (inherited_data->IsShared()) {
+    inherited_data = new InheritedVariables(*inherited_data);
+  }
+  return *inherited_data;
+}
+
 Storage::Storage() { utils::impl::AssertStaticRegistrationFinished(); }
 
 Storage::~Storage() {
@@ -86,84 +140,59 @@ Storage::~Storage() {
 
   // By default, boost::intrusive containers don't own their elements (nodes),
   // so we need to destroy them explicitly. The variables are destroyed
-  // front-to-back, in reverse-initialization order.
+  // front-to-back, in reverse-initialization order. The inherited variables
+  // are released after them, together with impl_.
   while (!impl_->normal_data_storage.empty()) {
     impl_->normal_data_storage.pop_front_and_dispose(disposer);
   }
-
-  while (!impl_->inherited_data_storage.empty()) {
-    impl_->inherited_data_storage.pop_front_and_dispose(disposer);
-  }
 }
 
 void Storage::InheritFrom(Storage& other) {
   UASSERT(impl_->normal_data_storage.empty());
-  UASSERT(impl_->inherited_data_storage.empty());
-
-  if (!other.impl_->inherited_data_storage.empty() && !impl_->data) {
-    impl_->data = std::make_unique<DataPtr[]>(variable_count);
-  }
-
-  for (DataPtr& their_ptr :
-       other.impl_->inherited_data_storage | boost::adaptors::reversed) {
-    UASSERT(their_ptr.ptr);
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
-    auto& node = static_cast<InheritedDataBase&>(*their_ptr.ptr);
-    UASSERT(node.GetKey() < variable_count);
-
-    auto& our_ptr = impl_->data[node.GetKey()];
-    UASSERT(!our_ptr.ptr);
-    our_ptr.ptr = &node;
-    impl_->inherited_data_storage.push_front(our_ptr);
-    node.AddRef();
-  }
+  UASSERT(!impl_->inherited_data);
+  impl_->inherited_data = other.impl_->inherited_data;
 }
 
 void Storage::InitializeFrom(Storage&& other) noexcept {
   UASSERT(impl_->normal_data_storage.empty());
-  UASSERT(impl_->inherited_data_storage.empty());
+  UASSERT(!impl_->inherited_data);
   impl_ = std::move(other.impl_);
 }
 
-DataBase* Storage::GetGeneric(Key key) noexcept {
+DataBase* Storage::GetNormalGeneric(Key key) noexcept {
   UASSERT(key < variable_count);
   if (!impl_->data) return nullptr;
   return impl_->data[key].ptr;
 }
 
-void Storage::Impl::DoSetGeneric(Key key, DataBase& node) {
+DataBase* Storage::GetInheritedGeneric(Key key) noexcept {
   UASSERT(key < variable_count);
-  if (!data) data = std::make_unique<DataPtr[]>(variable_count);
-  data[key].ptr = &node;
+  if (!impl_->inherited_data) return nullptr;
+  return (*impl_->inherited_data)[key];
 }
 
 void Storage::SetGeneric(Key key, NormalDataBase& node,
                          bool has_existing_variable) {
-  impl_->DoSetGeneric(key, node);
+  UASSERT(key < variable_count);
+  auto& data = impl_->data;
+  if (!data) data = std::make_unique<DataPtr[]>(variable_count);
+  data[key].ptr = &node;
   if (!has_existing_variable) {
-    impl_->normal_data_storage.push_front(impl_->data[key]);
+    impl_->normal_data_storage.push_front(data[key]);
   }
 }
 
 void Storage::SetGeneric(Key key, InheritedDataBase& node,
-                         bool has_existing_variable) {
-  impl_->DoSetGeneric(key, node);
-  if (!has_existing_variable) {
-    impl_->inherited_data_storage.push_front(impl_->data[key]);
-  }
+                         bool /*has_existing_variable*/) {
+  // The old node, if any, is released by the caller
+  impl_->GetMutableInherited()[key] = &node;
 }
 
-void Storage::EraseInherited(Key key) noexcept {
-  UASSERT(key < variable_count);
-  if (!impl_->data) return;
-
-  auto& data_ptr = impl_->data[key];
-  auto* const data = data_ptr.ptr;
-  if (!data) return;
+void Storage::EraseInherited(Key key) {
+  if (!GetInheritedGeneric(key)) return;
 
-  data_ptr.ptr = nullptr;
-  impl_->inherited_data_storage.erase(
-      InheritedDataList::s_iterator_to(data_ptr));
+  auto& node = impl_->GetMutableInherited()[key];
+  auto* const data = std::exchange(node, nullptr);
   data->DeleteSelf();
 }
 
@@ -0,0 +1,198 @@
+#include <engine/io/batch_poller.hpp>
+
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <system_error>
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <utils/check_syscall.hpp>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io {
+
+#ifdef __linux__
+
+namespace {
+
+// epoll_event::data keeps the fd and the awaited events, the latter are
+// needed to report HUP as readiness
+std::uint64_t PackData(int fd, utils::Flags<Poller::Event::Type> events) {
+  return static_cast<std::uint32_t>(fd) |
+         (static_cast<std::uint64_t>(events.GetValue()) << 32);
+}
+
+int UnpackFd(std::uint64_t data) {
+  return static_cast<int>(static_cast<std::uint32_t>(data));
+}
+
+utils::Flags<Poller::Event::Type> UnpackEvents(std::uint64_t data) {
+  return utils::Flags<Poller::Event::Type>{
+      static_cast<Poller::Event::Type>(data >> 32)};
+}
+
+std::uint32_t ToEpollEvents(utils::Flags<Poller::Event::Type> events) {
+  std::uint32_t epoll_events = 0;
+  if (events & Poller::Event::kRead) epoll_events |= EPOLLIN;
+  if (events & Poller::Event::kWrite) epoll_events |= EPOLLOUT;
+  return epoll_events;
+}
+
+utils::Flags<Poller::Event::Type> FromEpollEvents(
+    std::uint32_t epoll_events, utils::Flags<Poller::Event::Type> awaited) {
+  if (epoll_events & EPOLLERR) return Poller::Event::kError;
+  if (epoll_events & EPOLLHUP) return awaited;
+
+  utils::Flags<Poller::Event::Type> events;
+  if (epoll_events & EPOLLIN) events |= Poller::Event::kRead;
+  if (epoll_events & EPOLLOUT) events |= Poller::Event::kWrite;
+  return events & awaited;
+}
+
+}  // namespace
+
+struct BatchPoller::EventsBuffer {
+  std::vector<epoll_event> events;
+};
+
+BatchPoller::BatchPoller(std::size_t max_batch_size)
+    : buffer_(std::make_unique<EventsBuffer>()) {
+  UASSERT(max_batch_size != 0);
+  buffer_->events.resize(max_batch_size);
+
+  epoll_fd_ = utils::CheckSyscall(::epoll_create1(EPOLL_CLOEXEC),
+                                  "creating epoll instance");
+  try {
+    interrupt_fd_ =
+        utils::CheckSyscall(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC),
+                            "creating eventfd for poller interrupts");
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = PackData(kInvalidFd, {});
+    utils::CheckSyscall(
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, interrupt_fd_, &event),
+        "adding eventfd to epoll");
+  } catch (const std::exception&) {
+    if (interrupt_fd_ != -1) ::close(interrupt_fd_);
+    ::close(epoll_fd_);
+    throw;
+  }
+  epoll_poller_.Reset(epoll_fd_, FdPoller::Kind::kRead);
+}
+
+BatchPoller::~BatchPoller() {
+  epoll_poller_.Invalidate();
+  ::close(interrupt_fd_);
+  ::close(epoll_fd_);
+}
+
+void BatchPoller::Add(int fd, utils::Flags<Event::Type> events) {
+  epoll_event event{};
+  event.events = ToEpollEvents(events);
+  event.data.u64 = PackData(fd, events);
+  if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) == -1) {
+    if (errno != EEXIST) {
+      throw std::system_error(errno, std::generic_category(),
+                              "Error while adding fd to epoll");
+    }
+    utils::CheckSyscall(::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &event),
+                        "modifying fd {} in epoll", fd);
+  }
+}
+
+void BatchPoller::Remove(int fd) {
+  if (::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr) == -1) {
+    UASSERT_MSG(false, "Request for removal of an unknown fd from poller");
+    LOG_LIMITED_WARNING() << "Failed to remove fd " << fd
+                          << " from epoll, errno " << errno;
+  }
+}
+
+BatchPoller::Status BatchPoller::NextEvents(std::vector<Event>& events,
+                                            Deadline deadline) {
+  while (true) {
+    const auto status = CollectEvents(events);
+    if (status != Status::kNoEvents) return status;
+    if (!epoll_poller_.Wait(deadline)) return Status::kNoEvents;
+  }
+}
+
+BatchPoller::Status BatchPoller::NextEventsNoblock(std::vector<Event>& events) {
+  return CollectEvents(events);
+}
+
+void BatchPoller::Interrupt() {
+  const std::uint64_t value = 1;
+  [[maybe_unused]] const auto written =
+      ::write(interrupt_fd_, &value, sizeof(value));
+  UASSERT(written == sizeof(value));
+}
+
+BatchPoller::Status BatchPoller::CollectEvents(std::vector<Event>& events) {
+  events.clear();
+  auto& buffer = buffer_->events;
+  const auto count =
+      ::epoll_wait(epoll_fd_, buffer.data(), buffer.size(), /*timeout=*/0);
+  if (count == -1) {
+    UASSERT_MSG(errno == EINTR, "epoll_wait failed");
+    return Status::kNoEvents;
+  }
+
+  bool is_interrupted = false;
+  events.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    const auto data = buffer[i].data.u64;
+    const auto fd = UnpackFd(data);
+    if (fd == kInvalidFd) {
+      std::uint64_t value = 0;
+      [[maybe_unused]] const auto read =
+          ::read(interrupt_fd_, &value, sizeof(value));
+      is_interrupted = true;
+      continue;
+    }
+
+    const auto type = FromEpollEvents(buffer[i].events, UnpackEvents(data));
+    if (type) events.push_back(Event{fd, type, 0});
+  }
+
+  if (is_interrupted) return Status::kInterrupt;
+  return events.empty() ? Status::kNoEvents : Status::kSuccess;
+}
+
+#else
+
+struct BatchPoller::EventsBuffer {};
+
+BatchPoller::BatchPoller(std::size_t) {
+  throw std::runtime_error("BatchPoller is supported on Linux only");
+}
+
+BatchPoller::~BatchPoller() = default;
+
+void BatchPoller::Add(int, utils::Flags<Event::Type>) {}
+
+void BatchPoller::Remove(int) {}
+
+BatchPoller::Status BatchPoller::NextEvents(std::vector<Event>&, Deadline) {
+  return Status::kNoEvents;
+}
+
+BatchPoller::Status BatchPoller::NextEventsNoblock(std::vector<Event>&) {
+  return Status::kNoEvents;
+}
+
+void BatchPoller::Interrupt() {}
+
+#endif
+
+}  // namespace engine::io
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <engine/io/poller.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/io/fd_poller.hpp>
+#include <userver/utils/flags.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io {
+
+/// @brief Level-triggered I/O event monitor for many file descriptors.
+///
+/// Unlike Poller, the descriptors are registered in a dedicated epoll
+/// instance directly from the coroutine, and the ev thread watches only the
+/// epoll descriptor itself. The events are retrieved in batches and are
+/// reported again and again until the descriptor is drained or removed, so
+/// the thousands of mostly idle sockets cost nothing between the events and
+/// an event costs no watcher restart.
+///
+/// Linux only, the constructor throws elsewhere.
+/// @warning Not thread-safe, must be used from a single task at a time.
+/// @note Reports HUP as readiness.
+class BatchPoller final {
+ public:
+  using Event = Poller::Event;
+  using Status = Poller::Status;
+
+  /// @param max_batch_size the maximum count of events returned at once
+  explicit BatchPoller(std::size_t max_batch_size = 256);
+  ~BatchPoller();
+
+  BatchPoller(const BatchPoller&) = delete;
+  BatchPoller(BatchPoller&&) = delete;
+
+  /// Sets the events to be monitored for the file descriptor.
+  /// @note Event::Type::kError is always monitored.
+  void Add(int fd, utils::Flags<Event::Type> events);
+
+  /// Disables event monitoring on the file descriptor, must be called before
+  /// closing it.
+  void Remove(int fd);
+
+  /// Waits for the events and replaces the contents of `events` with them.
+  Status NextEvents(std::vector<Event>& events, Deadline deadline);
+
+  /// Replaces the contents of `events` with the immediately available events.
+  Status NextEventsNoblock(std::vector<Event>& events);
+
+  /// Makes the current or the next NextEvents() call return kInterrupt.
+  /// Unlike the other methods may be called from any thread.
+  void Interrupt();
+
+ private:
+  struct EventsBuffer;
+
+  Status CollectEvents(std::vector<Event>& events);
+
+  int epoll_fd_{-1};
+  int interrupt_fd_{-1};
+  FdPoller epoll_poller_;
+  std::unique_ptr<EventsBuffer> buffer_;
+};
+
+}  // namespace engine::io
+
+USERVER_NAMESPACE_END
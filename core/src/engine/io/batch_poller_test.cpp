@@ -0,0 +1,185 @@
+#include "batch_poller.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+#ifdef __linux__
+
+namespace {
+
+class Pipe final {
+ public:
+  Pipe() { utils::CheckSyscall(::pipe(fd_), "creating pipe"); }
+  ~Pipe() {
+    ::close(fd_[0]);
+    ::close(fd_[1]);
+  }
+
+  int In() { return fd_[0]; }
+  int Out() { return fd_[1]; }
+
+ private:
+  int fd_[2]{};
+};
+
+void WriteOne(int fd) {
+  std::array<char, 1> buf{'1'};
+  ASSERT_EQ(buf.size(), ::write(fd, buf.data(), buf.size()));
+}
+
+void ReadOne(int fd) {
+  std::array<char, 1> buf{};
+  ASSERT_EQ(buf.size(), ::read(fd, buf.data(), buf.size()));
+  ASSERT_EQ(buf[0], '1');
+}
+
+using BatchPoller = engine::io::BatchPoller;
+using Events = std::vector<BatchPoller::Event>;
+
+constexpr auto kReadTimeout = utest::kMaxTestWaitTime;
+constexpr auto kFailTimeout = std::chrono::milliseconds{100};
+
+}  // namespace
+
+UTEST(BatchPoller, ReadEvent) {
+  Pipe pipe;
+  BatchPoller poller;
+  poller.Add(pipe.In(), BatchPoller::Event::kRead);
+
+  Events events;
+  EXPECT_EQ(poller.NextEventsNoblock(events), BatchPoller::Status::kNoEvents);
+  EXPECT_TRUE(events.empty());
+
+  WriteOne(pipe.Out());
+  ASSERT_EQ(
+      poller.NextEvents(events, engine::Deadline::FromDuration(kReadTimeout)),
+      BatchPoller::Status::kSuccess);
+  ASSERT_EQ(events.size(), 1);
+  EXPECT_EQ(events[0].fd, pipe.In());
+  EXPECT_EQ(events[0].type, BatchPoller::Event::kRead);
+  ReadOne(pipe.In());
+}
+
+UTEST(BatchPoller, EventsAreLevelTriggered) {
+  Pipe pipe;
+  BatchPoller poller;
+  poller.Add(pipe.In(), BatchPoller::Event::kRead);
+
+  Events events;
+  WriteOne(pipe.Out());
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(poller.NextEventsNoblock(events), BatchPoller::Status::kSuccess);
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(events[0].fd, pipe.In());
+  }
+
+  ReadOne(pipe.In());
+  EXPECT_EQ(
+      poller.NextEvents(events, engine::Deadline::FromDuration(kFailTimeout)),
+      BatchPoller::Status::kNoEvents);
+}
+
+UTEST(BatchPoller, Batch) {
+  constexpr std::size_t kPipesCount = 20;
+  std::array<Pipe, kPipesCount> pipes;
+  BatchPoller poller;
+  for (auto& pipe : pipes) poller.Add(pipe.In(), BatchPoller::Event::kRead);
+
+  auto task = engine::AsyncNoSpan([&] {
+    Events events;
+    std::vector<int> ready;
+    while (ready.size() < kPipesCount) {
+      ASSERT_EQ(poller.NextEvents(
+                    events, engine::Deadline::FromDuration(kReadTimeout)),
+                BatchPoller::Status::kSuccess);
+      for (const auto& event : events) {
+        EXPECT_EQ(event.type, BatchPoller::Event::kRead);
+        ReadOne(event.fd);
+        ready.push_back(event.fd);
+      }
+    }
+
+    std::sort(ready.begin(), ready.end());
+    EXPECT_EQ(std::unique(ready.begin(), ready.end()), ready.end());
+  });
+
+  engine::Yield();
+  for (auto& pipe : pipes) WriteOne(pipe.Out());
+  task.Get();
+}
+
+UTEST(BatchPoller, MaxBatchSize) {
+  constexpr std::size_t kPipesCount = 5;
+  std::array<Pipe, kPipesCount> pipes;
+  BatchPoller poller{2};
+  for (auto& pipe : pipes) {
+    poller.Add(pipe.In(), BatchPoller::Event::kRead);
+    WriteOne(pipe.Out());
+  }
+
+  Events events;
+  ASSERT_EQ(poller.NextEventsNoblock(events), BatchPoller::Status::kSuccess);
+  EXPECT_EQ(events.size(), 2);
+  for (auto& pipe : pipes) ReadOne(pipe.In());
+}
+
+UTEST(BatchPoller, AwaitedEventsChange) {
+  Pipe pipe;
+  BatchPoller poller;
+  Events events;
+
+  poller.Add(pipe.Out(), BatchPoller::Event::kWrite);
+  ASSERT_EQ(poller.NextEventsNoblock(events), BatchPoller::Status::kSuccess);
+  ASSERT_EQ(events.size(), 1);
+  EXPECT_EQ(events[0].type, BatchPoller::Event::kWrite);
+
+  poller.Add(pipe.Out(), BatchPoller::Event::kNone);
+  EXPECT_EQ(poller.NextEventsNoblock(events), BatchPoller::Status::kNoEvents);
+}
+
+UTEST(BatchPoller, Interrupt) {
+  Pipe pipe;
+  BatchPoller poller;
+  poller.Add(pipe.In(), BatchPoller::Event::kRead);
+
+  auto task = engine::AsyncNoSpan([&] {
+    Events events;
+    ASSERT_EQ(
+        poller.NextEvents(events, engine::Deadline::FromDuration(kReadTimeout)),
+        BatchPoller::Status::kInterrupt);
+    ASSERT_EQ(poller.NextEventsNoblock(events),
+              BatchPoller::Status::kNoEvents);
+  });
+
+  engine::Yield();
+  poller.Interrupt();
+  task.Get();
+}
+
+UTEST(BatchPoller, Remove) {
+  Pipe pipe;
+  BatchPoller poller;
+  Events events;
+
+  poller.Add(pipe.In(), BatchPoller::Event::kRead);
+  WriteOne(pipe.Out());
+  poller.Remove(pipe.In());
+  EXPECT_EQ(
+      poller.NextEvents(events, engine::Deadline::FromDuration(kFailTimeout)),
+      BatchPoller::Status::kNoEvents);
+  ReadOne(pipe.In());
+}
+
+#endif
+
+USERVER_NAMESPACE_END
@@ -1,14 +1,34 @@
 #include <userver/engine/io/buffered.hpp>
 
-#include <boost/algorithm/string/trim.hpp>
+#include <algorithm>
+#include <cstring>
 
 #include <engine/io/impl/buffer.hpp>
 #include <userver/engine/io/exception.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::io {
 
+namespace {
+
+bool IsLineTerminator(char c) { return c == '\n' || c == '\r'; }
+
+// Two memchr calls are much faster than a per-byte predicate
+const char* FindLineTerminator(const char* begin, const char* end) {
+  if (begin == end) return nullptr;
+  const auto* lf =
+      static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+  if (lf) end = lf;
+  if (begin == end) return lf;
+  const auto* cr =
+      static_cast<const char*>(std::memchr(begin, '\r', end - begin));
+  return cr ? cr : lf;
+}
+
+}  // namespace
+
 TerminatorNotFoundException::TerminatorNotFoundException()
     : IoException("EOF encountered before terminator could be found") {}
 
@@ -26,41 +46,29 @@ BufferedReader& BufferedReader::operator=(BufferedReader&&) noexcept = default;
 bool BufferedReader::IsValid() const { return source_->IsValid(); }
 
 std::string BufferedReader::ReadSome(size_t max_bytes, Deadline deadline) {
-  if (!buffer_->AvailableReadBytes()) {
-    buffer_->Reserve(1);
-    FillBuffer(deadline);
-  }
-  std::string result(buffer_->ReadPtr(),
-                     std::min(max_bytes, buffer_->AvailableReadBytes()));
+  std::string result{PeekSome(max_bytes, deadline)};
   buffer_->ReportRead(result.size());
   return result;
 }
 
 std::string BufferedReader::ReadAll(size_t num_bytes, Deadline deadline) {
-  if (buffer_->AvailableReadBytes() < num_bytes) {
-    buffer_->Reserve(num_bytes - buffer_->AvailableReadBytes());
-    while (buffer_->AvailableReadBytes() < num_bytes) {
-      if (!FillBuffer(deadline)) break;
-    }
-  }
-  std::string result(buffer_->ReadPtr(),
-                     std::min(num_bytes, buffer_->AvailableReadBytes()));
+  std::string result{PeekAll(num_bytes, deadline)};
   buffer_->ReportRead(result.size());
   return result;
 }
 
 std::string BufferedReader::ReadLine(Deadline deadline) {
-  static const auto kPred = [](int c) {
-    return c == '\n' || c == '\r' || c == EOF;
-  };
-  while (kPred(Peek(deadline))) Getc(deadline);
-  auto result = ReadUntil(kPred, deadline);
-  boost::algorithm::trim_right_if(result, kPred);
+  std::string result{PeekLine(deadline)};
+  // consume the terminator as well, if any
+  buffer_->ReportRead(
+      std::min(result.size() + 1, buffer_->AvailableReadBytes()));
   return result;
 }
 
 std::string BufferedReader::ReadUntil(char terminator, Deadline deadline) {
-  return ReadUntil([terminator](int c) { return c == terminator; }, deadline);
+  std::string result{PeekUntil(terminator, deadline)};
+  buffer_->ReportRead(result.size());
+  return result;
 }
 
 std::string BufferedReader::ReadUntil(const std::function<bool(int)>& pred,
@@ -120,6 +128,81 @@ void BufferedReader::Discard(size_t num_bytes, Deadline deadline) {
   }
 }
 
+std::string_view BufferedReader::PeekSome(size_t max_bytes,
+                                          Deadline deadline) {
+  if (!buffer_->AvailableReadBytes()) {
+    buffer_->Reserve(1);
+    FillBuffer(deadline);
+  }
+  return {buffer_->ReadPtr(),
+          std::min(max_bytes, buffer_->AvailableReadBytes())};
+}
+
+std::string_view BufferedReader::PeekAll(size_t num_bytes, Deadline deadline) {
+  if (buffer_->AvailableReadBytes() < num_bytes) {
+    buffer_->Reserve(num_bytes - buffer_->AvailableReadBytes());
+    while (buffer_->AvailableReadBytes() < num_bytes) {
+      if (!FillBuffer(deadline)) break;
+    }
+  }
+  return {buffer_->ReadPtr(),
+          std::min(num_bytes, buffer_->AvailableReadBytes())};
+}
+
+std::string_view BufferedReader::PeekUntil(char terminator,
+                                           Deadline deadline) {
+  // already searched bytes are not rescanned after a read
+  size_t search_pos = 0;
+  while (true) {
+    const auto* read_ptr = buffer_->ReadPtr();
+    const auto available = buffer_->AvailableReadBytes();
+    if (search_pos < available) {
+      const auto* found = static_cast<const char*>(std::memchr(
+          read_ptr + search_pos, terminator, available - search_pos));
+      if (found) return {read_ptr, static_cast<size_t>(found - read_ptr) + 1};
+    }
+    search_pos = available;
+
+    buffer_->Reserve(1);
+    if (!FillBuffer(deadline)) throw TerminatorNotFoundException();
+  }
+}
+
+std::string_view BufferedReader::PeekLine(Deadline deadline) {
+  while (true) {
+    const auto* read_ptr = buffer_->ReadPtr();
+    const auto available = buffer_->AvailableReadBytes();
+    size_t skip = 0;
+    while (skip < available && IsLineTerminator(read_ptr[skip])) ++skip;
+    buffer_->ReportRead(skip);
+    if (skip < available) break;
+
+    buffer_->Reserve(1);
+    if (!FillBuffer(deadline)) return {};
+  }
+
+  size_t search_pos = 0;
+  while (true) {
+    const auto* read_ptr = buffer_->ReadPtr();
+    const auto available = buffer_->AvailableReadBytes();
+    const auto* found =
+        FindLineTerminator(read_ptr + search_pos, read_ptr + available);
+    if (found) return {read_ptr, static_cast<size_t>(found - read_ptr)};
+    search_pos = available;
+
+    buffer_->Reserve(1);
+    if (!FillBuffer(deadline)) {
+      return {buffer_->ReadPtr(), buffer_->AvailableReadBytes()};
+    }
+  }
+}
+
+void BufferedReader::Consume(size_t num_bytes) {
+  UINVARIANT(num_bytes <= buffer_->AvailableReadBytes(),
+             "Attempt to consume more bytes than were buffered");
+  buffer_->ReportRead(num_bytes);
+}
+
 size_t BufferedReader::FillBuffer(Deadline deadline) {
   try {
     auto read_bytes = source_->ReadSome(
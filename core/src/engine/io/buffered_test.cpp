@@ -104,4 +104,54 @@ TEST(BufferedReader, GetPeek) {
   EXPECT_EQ(EOF, reader.Peek());
 }
 
+TEST(BufferedReader, PeekConsume) {
+  auto mock_ptr = std::make_shared<ReadableMock>();
+  BufferedReader reader(mock_ptr);
+
+  mock_ptr->Feed("key=value;tail");
+  const auto key = reader.PeekUntil('=');
+  EXPECT_EQ("key=", key);
+  EXPECT_EQ("key=", reader.PeekUntil('='));
+  reader.Consume(key.size());
+
+  EXPECT_EQ("value;", reader.PeekUntil(';'));
+  reader.Consume(6);
+  UEXPECT_THROW(reader.PeekUntil(';'),
+                engine::io::TerminatorNotFoundException);
+
+  EXPECT_EQ("ta", reader.PeekAll(2));
+  EXPECT_EQ("tail", reader.PeekAll(10));
+  EXPECT_EQ("t", reader.PeekSome(1));
+  EXPECT_UINVARIANT_FAILURE(reader.Consume(5));
+  reader.Consume(4);
+  EXPECT_TRUE(reader.PeekSome(10).empty());
+}
+
+TEST(BufferedReader, PeekLine) {
+  auto mock_ptr = std::make_shared<ReadableMock>();
+  BufferedReader reader(mock_ptr);
+
+  mock_ptr->Feed("\r\nGET / HTTP/1.0\r\n\r\nblah\n\nlast");
+  auto line = reader.PeekLine();
+  EXPECT_EQ("GET / HTTP/1.0", line);
+  reader.Consume(line.size());
+
+  line = reader.PeekLine();
+  EXPECT_EQ("blah", line);
+  reader.Consume(line.size());
+
+  EXPECT_EQ("last", reader.ReadLine());
+  EXPECT_TRUE(reader.PeekLine().empty());
+}
+
+TEST(BufferedReader, LongLine) {
+  auto mock_ptr = std::make_shared<ReadableMock>();
+  BufferedReader reader(mock_ptr, 16);
+
+  const std::string long_line(100000, 'x');
+  mock_ptr->Feed(long_line + "\nshort\n");
+  EXPECT_EQ(long_line, reader.ReadLine());
+  EXPECT_EQ("short", reader.PeekLine());
+}
+
 USERVER_NAMESPACE_END
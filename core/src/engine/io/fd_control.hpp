@@ -1,5 +1,6 @@
 #pragma once
 
+#include <sys/types.h>
 #include <sys/uio.h>
 #include <atomic>
 #include <cerrno>
@@ -86,6 +87,12 @@ class Direction final {
                     TransferMode mode, Deadline deadline,
                     const Context&... context);
 
+  // (IoFunc*)(int, off_t*, size_t), e.g. sendfile with the bound in_fd
+  template <typename IoFunc, typename... Context>
+  size_t PerformIoAt(SingleUserGuard& guard, IoFunc&& io_func, off_t offset,
+                     size_t len, TransferMode mode, Deadline deadline,
+                     const Context&... context);
+
  private:
   friend class FdControl;
   explicit Direction(Kind kind);
@@ -246,6 +253,30 @@ size_t Direction::PerformIo(SingleUserGuard&, IoFunc&& io_func, void* buf,
   return pos - begin;
 }
 
+template <typename IoFunc, typename... Context>
+size_t Direction::PerformIoAt(SingleUserGuard&, IoFunc&& io_func, off_t offset,
+                              size_t len, TransferMode mode, Deadline deadline,
+                              const Context&... context) {
+  size_t processed_bytes = 0;
+
+  while (processed_bytes < len) {
+    // io_func advances the offset by itself
+    auto chunk_size = io_func(Fd(), &offset, len - processed_bytes);
+
+    if (chunk_size > 0) {
+      processed_bytes += chunk_size;
+      if (mode == TransferMode::kOnce) {
+        break;
+      }
+    } else if (!chunk_size ||
+               TryHandleError(errno, processed_bytes, mode, deadline,
+                              context...) == ErrorMode::kFatal) {
+      break;
+    }
+  }
+  return processed_bytes;
+}
+
 }  // namespace engine::io::impl
 
 USERVER_NAMESPACE_END
@@ -1,5 +1,8 @@
 #include <userver/engine/io/fd_poller.hpp>
 
+#include <poll.h>
+
+#include <engine/ev/io_uring.hpp>
 #include <engine/ev/watcher.hpp>
 #include <engine/impl/wait_list_light.hpp>
 #include <engine/task/task_context.hpp>
@@ -48,6 +51,21 @@ int GetEvMode(FdPoller::Kind kind) {
   }
 }
 
+short GetPollEvents(FdPoller::Kind kind) {
+  switch (kind) {
+    case FdPoller::Kind::kRead:
+      return POLLIN;
+    case FdPoller::Kind::kWrite:
+      return POLLOUT;
+    case FdPoller::Kind::kReadWrite:
+      return POLLIN | POLLOUT;
+
+    default:
+      UINVARIANT(false,
+                 "Invalid kind: " + std::to_string(static_cast<int>(kind)));
+  }
+}
+
 }  // namespace
 
 namespace impl {
@@ -87,6 +105,8 @@ struct FdPoller::Impl {
   ~Impl();
 
   engine::impl::TaskContext::WakeupSource DoWait(Deadline deadline);
+  engine::impl::TaskContext::WakeupSource DoWaitIoUring(
+      engine::impl::TaskContext& current, Deadline deadline);
 
   bool IsValid() const noexcept;
 
@@ -99,14 +119,18 @@ struct FdPoller::Impl {
   void WakeupWaiters();
 
   int fd_{-1};
+  short poll_events_{0};
   std::atomic<FdPoller::State> state_{FdPoller::State::kInvalid};
   engine::impl::FastPimplWaitListLight waiters_;
   ev::Watcher<ev_io> watcher_;
+  ev::IoUring* const io_uring_;
 };
 
 void FdPoller::Impl::WakeupWaiters() { waiters_->WakeupOne(); }
 
-FdPoller::Impl::Impl() : watcher_(current_task::GetEventThread(), this) {
+FdPoller::Impl::Impl()
+    : watcher_(current_task::GetEventThread(), this),
+      io_uring_(current_task::GetEventThread().GetIoUring()) {
   watcher_.Init(&IoWatcherCb);
 }
 
@@ -122,6 +146,8 @@ engine::impl::TaskContext::WakeupSource FdPoller::Impl::DoWait(
     return engine::impl::TaskContext::WakeupSource::kCancelRequest;
   }
 
+  if (io_uring_) return DoWaitIoUring(current, deadline);
+
   impl::DirectionWaitStrategy wait_manager(deadline, *waiters_, watcher_,
                                            current);
   auto ret = current.Sleep(wait_manager);
@@ -134,8 +160,24 @@ engine::impl::TaskContext::WakeupSource FdPoller::Impl::DoWait(
   return ret;
 }
 
+engine::impl::TaskContext::WakeupSource FdPoller::Impl::DoWaitIoUring(
+    engine::impl::TaskContext& current, Deadline deadline) {
+  // The poll request is submitted right from the coroutine, no ev thread
+  // round trip is required to arm a watcher. Errors and -ECANCELED are
+  // reported as a wakeup, the following syscall on the fd reports the error.
+  const auto result = io_uring_->Poll(fd_, poll_events_, deadline);
+  if (!result.interrupted) {
+    return engine::impl::TaskContext::WakeupSource::kWaitList;
+  }
+  return current.ShouldCancel()
+             ? engine::impl::TaskContext::WakeupSource::kCancelRequest
+             : engine::impl::TaskContext::WakeupSource::kDeadlineTimer;
+}
+
 void FdPoller::Impl::Invalidate() {
   StopWatcher();
+  // io_uring holds a reference to the file while the poll is pending
+  if (io_uring_) io_uring_->CancelFd(fd_);
 
   auto old_state = State::kReadyToUse;
   const auto res = state_.compare_exchange_strong(old_state, State::kInvalid);
@@ -219,6 +261,7 @@ void FdPoller::Impl::Reset(int fd, Kind kind) {
   UASSERT(fd_ == fd || fd_ == -1);
   fd_ = fd;
   watcher_.Set(fd_, GetEvMode(kind));
+  poll_events_ = GetPollEvents(kind);
   state_ = State::kReadyToUse;
 }
 
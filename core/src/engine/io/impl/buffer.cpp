@@ -76,7 +76,8 @@ void Buffer::ReportWritten(size_t num_bytes) {
 void Buffer::Reallocate(size_t size_request) {
   UASSERT(size_request > data_.size());
 
-  std::vector<char> tmp(RoundedSize(size_request));
+  // geometric growth keeps reading of long lines and frames linear
+  std::vector<char> tmp(RoundedSize(std::max(size_request, data_.size() * 2)));
   tmp.swap(data_);  // does not invalidate ptrs
   Rebase();
 }
@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <vector>
+
+#include <engine/io/batch_poller.hpp>
+#include <engine/io/poller.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+#ifdef __linux__
+
+namespace {
+
+// Every 100th descriptor becomes ready on each iteration, the rest stay idle
+constexpr std::size_t kReadyEvery = 100;
+
+namespace io = engine::io;
+
+class EventFds final {
+ public:
+  explicit EventFds(std::size_t count) {
+    fds_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      fds_.push_back(utils::CheckSyscall(::eventfd(0, EFD_NONBLOCK),
+                                         "creating eventfd"));
+    }
+  }
+
+  ~EventFds() {
+    for (const auto fd : fds_) ::close(fd);
+  }
+
+  const std::vector<int>& Get() const { return fds_; }
+
+  void Signal(int fd) {
+    const std::uint64_t value = 1;
+    [[maybe_unused]] const auto res = ::write(fd, &value, sizeof(value));
+  }
+
+  void Drain(int fd) {
+    std::uint64_t value = 0;
+    [[maybe_unused]] const auto res = ::read(fd, &value, sizeof(value));
+  }
+
+ private:
+  std::vector<int> fds_;
+};
+
+}  // namespace
+
+void poller_many_idle_fds(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    EventFds fds(state.range(0));
+    io::Poller poller;
+    for (const auto fd : fds.Get()) poller.Add(fd, io::Poller::Event::kRead);
+
+    std::size_t events_count = 0;
+    for (auto _ : state) {
+      std::size_t expected = 0;
+      for (std::size_t i = 0; i < fds.Get().size(); i += kReadyEvery) {
+        fds.Signal(fds.Get()[i]);
+        ++expected;
+      }
+
+      io::Poller::Event event;
+      for (std::size_t i = 0; i < expected; ++i) {
+        if (poller.NextEvent(event, {}) != io::Poller::Status::kSuccess) {
+          state.SkipWithError("Poller failed");
+          return;
+        }
+        fds.Drain(event.fd);
+        // The events are one-shot, rearm
+        poller.Add(event.fd, io::Poller::Event::kRead);
+      }
+      events_count += expected;
+    }
+    state.SetItemsProcessed(events_count);
+  });
+}
+BENCHMARK(poller_many_idle_fds)->Arg(1'000)->Arg(10'000);
+
+void batch_poller_many_idle_fds(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    EventFds fds(state.range(0));
+    io::BatchPoller poller;
+    for (const auto fd : fds.Get()) {
+      poller.Add(fd, io::BatchPoller::Event::kRead);
+    }
+
+    std::vector<io::BatchPoller::Event> events;
+    std::size_t events_count = 0;
+    for (auto _ : state) {
+      std::size_t expected = 0;
+      for (std::size_t i = 0; i < fds.Get().size(); i += kReadyEvery) {
+        fds.Signal(fds.Get()[i]);
+        ++expected;
+      }
+
+      for (std::size_t received = 0; received < expected;) {
+        if (poller.NextEvents(events, {}) != io::Poller::Status::kSuccess) {
+          state.SkipWithError("BatchPoller failed");
+          return;
+        }
+        // The events are level-triggered, draining is enough
+        for (const auto& event : events) fds.Drain(event.fd);
+        received += events.size();
+      }
+      events_count += expected;
+    }
+    state.SetItemsProcessed(events_count);
+  });
+}
+BENCHMARK(batch_poller_many_idle_fds)->Arg(1'000)->Arg(10'000);
+
+#endif
+
+USERVER_NAMESPACE_END
@@ -4,7 +4,12 @@
 #include <sys/socket.h>
 #include <sys/uio.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
 
+#include <algorithm>
+#include <array>
 #include <cerrno>
 #include <string>
 #include <vector>
@@ -106,6 +111,29 @@ class SendToWrapper {
   const Sockaddr& dest_addr_;
 };
 
+class SendFileWrapper {
+ public:
+  explicit SendFileWrapper(int file_fd) : file_fd_(file_fd) {}
+
+  [[nodiscard]] ssize_t operator()(int fd, off_t* offset, size_t len) {
+#ifdef __linux__
+    return ::sendfile(fd, file_fd_, offset, len);
+#else
+    // MAC_COMPAT: sendfile has a different signature, no zero-copy here
+    std::array<char, 64 * 1024> buffer;
+    const auto read =
+        ::pread(file_fd_, buffer.data(), std::min(len, buffer.size()), *offset);
+    if (read <= 0) return read;
+    const auto sent = SendWrapper(fd, buffer.data(), read);
+    if (sent > 0) *offset += sent;
+    return sent;
+#endif
+  }
+
+ private:
+  const int file_fd_;
+};
+
 void FillIoSendData(const IoData* data, struct iovec* dst, std::size_t count) {
   UASSERT(data);
   UASSERT(count > 0);
@@ -278,6 +306,19 @@ size_t Socket::SendAll(const void* buf, size_t len, Deadline deadline) {
                        peername_);
 }
 
+size_t Socket::SendAllFile(int file_fd, std::size_t offset, std::size_t len,
+                           Deadline deadline) {
+  if (!IsValid()) {
+    throw IoException("Attempt to SendAllFile to closed socket");
+  }
+  auto& dir = fd_control_->Write();
+  impl::Direction::SingleUserGuard guard(dir);
+  return dir.PerformIoAt(guard, SendFileWrapper{file_fd},
+                         static_cast<off_t>(offset), len,
+                         impl::TransferMode::kWhole, deadline,
+                         "SendAllFile to ", peername_);
+}
+
 Socket::RecvFromResult Socket::RecvSomeFrom(void* buf, size_t len,
                                             Deadline deadline) {
   if (!IsValid()) {
@@ -17,6 +17,9 @@
 #include <userver/engine/mutex.hpp>
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/fs/blocking/write.hpp>
 #include <userver/internal/net/net_listener.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -213,6 +216,39 @@ UTEST(Socket, SendAllVectorHeap) {
   EXPECT_EQ(bytes_sent, bytes_read);
 }
 
+UTEST(Socket, SendAllFile) {
+  const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  constexpr std::size_t kOffset = 3;
+
+  std::string contents(1024 * 1024, '\0');
+  for (std::size_t i = 0; i < contents.size(); ++i) {
+    contents[i] = 'a' + i % 26;
+  }
+  const auto file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(file.GetPath(), contents);
+  const auto fd = fs::blocking::FileDescriptor::Open(
+      file.GetPath(), fs::blocking::OpenFlag::kRead);
+
+  TcpListener listener;
+  auto sockets = listener.MakeSocketPair(deadline);
+  std::string received(contents.size() - kOffset, '\0');
+  auto listen_task = engine::AsyncNoSpan([&sockets, &deadline, &received] {
+    EXPECT_EQ(sockets.first.RecvAll(received.data(), received.size(), deadline),
+              received.size());
+  });
+
+  const auto bytes_sent = sockets.second.SendAllFile(
+      fd.GetNative(), kOffset, contents.size() - kOffset, deadline);
+  listen_task.Get();
+  EXPECT_EQ(bytes_sent, contents.size() - kOffset);
+  EXPECT_EQ(received, contents.substr(kOffset));
+
+  // Stops at the end of the file
+  EXPECT_EQ(sockets.second.SendAllFile(fd.GetNative(), contents.size() - 1,
+                                       100, deadline),
+            1);
+}
+
 UTEST(Socket, Cancel) {
   const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
 
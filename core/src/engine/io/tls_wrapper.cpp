@@ -1,16 +1,22 @@
 #include <userver/engine/io/tls_wrapper.hpp>
 
+#include <array>
 #include <exception>
 #include <memory>
+#include <string_view>
+#include <unordered_map>
 
 #include <fmt/format.h>
 #include <openssl/bio.h>
+#include <openssl/rand.h>
 #include <openssl/ssl.h>
 
 #include <crypto/helpers.hpp>
 #include <crypto/openssl.hpp>
 #include <engine/io/fd_control.hpp>
+#include <userver/concurrent/variable.hpp>
 #include <userver/engine/io/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
@@ -34,6 +40,13 @@ struct BioDeleter {
 };
 using Bio = std::unique_ptr<BIO, BioDeleter>;
 
+struct SslSessionDeleter {
+  void operator()(SSL_SESSION* session) const noexcept {
+    SSL_SESSION_free(session);
+  }
+};
+using SslSession = std::unique_ptr<SSL_SESSION, SslSessionDeleter>;
+
 #if OPENSSL_VERSION_NUMBER >= 0x010100000L
 struct BioMethodDeleter {
   void operator()(BIO_METHOD* biom) { BIO_meth_free(biom); }
@@ -230,29 +243,144 @@ enum InterruptAction {
   kFail,
 };
 
+#if OPENSSL_VERSION_NUMBER >= 0x010100000L
+// Key name, HMAC secret and AES-256 key
+constexpr size_t kTicketKeysSize = 80;
+#else
+// Key name, HMAC secret and AES-128 key
+constexpr size_t kTicketKeysSize = 48;
+#endif
+
+// The sessions are only resumed by the servers with the same context
+constexpr std::string_view kSessionIdContext = "userver-tls-wrapper";
+
+class SessionStorage {
+ public:
+  SessionStorage() {
+    crypto::impl::Openssl::Init();
+    if (1 != RAND_bytes(ticket_keys_.data(), ticket_keys_.size())) {
+      throw TlsException(crypto::FormatSslError(
+          "Failed to create a TLS session cache: RAND_bytes"));
+    }
+  }
+
+  void SetUpServer(SSL_CTX* ssl_ctx) {
+    // cast in openssl macro expansion
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+    if (1 != SSL_CTX_set_tlsext_ticket_keys(ssl_ctx, ticket_keys_.data(),
+                                            ticket_keys_.size())) {
+      throw TlsException(crypto::FormatSslError(
+          "Failed to set up server TLS wrapper: "
+          "SSL_CTX_set_tlsext_ticket_keys"));
+    }
+    if (1 != SSL_CTX_set_session_id_context(
+                 ssl_ctx,
+                 reinterpret_cast<const unsigned char*>(
+                     kSessionIdContext.data()),
+                 kSessionIdContext.size())) {
+      throw TlsException(crypto::FormatSslError(
+          "Failed to set up server TLS wrapper: "
+          "SSL_CTX_set_session_id_context"));
+    }
+  }
+
+  void Resume(SSL* ssl, const std::string& server_name) {
+    auto sessions = client_sessions_.UniqueLock();
+    const auto it = sessions->find(server_name);
+    if (it == sessions->end()) return;
+    if (1 != SSL_set_session(ssl, it->second.get())) {
+      throw TlsException(crypto::FormatSslError(
+          "Failed to set up client TLS wrapper: SSL_set_session"));
+    }
+  }
+
+  // Takes the ownership of the session if did not throw
+  void Store(const std::string& server_name, SSL_SESSION* session) {
+    auto sessions = client_sessions_.UniqueLock();
+    (*sessions)[server_name].reset(session);
+  }
+
+ private:
+  std::array<unsigned char, kTicketKeysSize> ticket_keys_{};
+  concurrent::Variable<std::unordered_map<std::string, SslSession>>
+      client_sessions_;
+};
+
+struct ClientSessionContext {
+  // keeps the storage alive
+  std::shared_ptr<TlsSessionCache> cache;
+  SessionStorage& storage;
+  std::string server_name;
+};
+
+int OnNewClientSession(SSL* ssl, SSL_SESSION* session) noexcept {
+  auto* context = static_cast<ClientSessionContext*>(SSL_get_app_data(ssl));
+  if (!context) return 0;
+
+  try {
+    context->storage.Store(context->server_name, session);
+  } catch (const std::exception& ex) {
+    LOG_LIMITED_WARNING() << "Failed to store the TLS session: " << ex;
+    return 0;
+  }
+  return 1;  // the reference is kept in the storage
+}
+
+void WaitSocketOrThrow(Socket& socket, int ssl_error, Deadline deadline,
+                       size_t bytes_transferred) {
+  const bool is_ready = ssl_error == SSL_ERROR_WANT_READ
+                            ? socket.WaitReadable(deadline)
+                            : socket.WaitWriteable(deadline);
+  if (is_ready) return;
+  if (current_task::ShouldCancel()) throw IoCancelled(bytes_transferred);
+  throw IoTimeout(bytes_transferred);
+}
+
 }  // namespace
 
+class TlsSessionCache::Impl final : public SessionStorage {};
+
+TlsSessionCache::TlsSessionCache() : impl_(std::make_unique<Impl>()) {}
+
+TlsSessionCache::~TlsSessionCache() = default;
+
 class TlsWrapper::Impl {
  public:
   explicit Impl(Socket&& socket) : bio_data(std::move(socket)) {}
 
   Impl(Impl&& other) noexcept
       : bio_data(std::move(other.bio_data)),
+        session_context(std::move(other.session_context)),
         ssl(std::move(other.ssl)),
-        is_in_shutdown(other.is_in_shutdown) {
+        is_in_shutdown(other.is_in_shutdown),
+        is_native_bio(other.is_native_bio) {
     UASSERT(SSL_get_rbio(ssl.get()) == SSL_get_wbio(ssl.get()));
-    SyncBioData(SSL_get_rbio(ssl.get()), &other.bio_data);
+    if (!is_native_bio) SyncBioData(SSL_get_rbio(ssl.get()), &other.bio_data);
   }
 
-  void SetUp(SslCtx&& ssl_ctx) {
-    Bio socket_bio{BIO_new(GetSocketBioMethod())};
+  void SetUp(SslCtx&& ssl_ctx, const TlsOptions& options) {
+    Bio socket_bio;
+#if defined(SSL_OP_ENABLE_KTLS)
+    if (options.kernel_tls) {
+      // OpenSSL only passes the keys to the kernel from its own socket BIO,
+      // which does not wait for the socket, see WaitSocket()
+      SSL_CTX_set_options(ssl_ctx.get(), SSL_OP_ENABLE_KTLS);
+      socket_bio.reset(BIO_new_socket(bio_data.socket.Fd(), BIO_NOCLOSE));
+      is_native_bio = true;
+    }
+#else
+    static_cast<void>(options);
+#endif
+    if (!is_native_bio) socket_bio.reset(BIO_new(GetSocketBioMethod()));
     if (!socket_bio) {
       throw TlsException(
           crypto::FormatSslError("Failed to set up TLS wrapper: BIO_new"));
     }
-    BIO_set_shutdown(socket_bio.get(), 0);
-    SyncBioData(socket_bio.get(), nullptr);
-    BIO_set_init(socket_bio.get(), 1);
+    if (!is_native_bio) {
+      BIO_set_shutdown(socket_bio.get(), 0);
+      SyncBioData(socket_bio.get(), nullptr);
+      BIO_set_init(socket_bio.get(), 1);
+    }
 
     ssl.reset(SSL_new(ssl_ctx.get()));
     if (!ssl) {
@@ -266,6 +394,41 @@ class TlsWrapper::Impl {
     [[maybe_unused]] const auto* disowned_bio = socket_bio.release();
   }
 
+  void Handshake(int (*handshake_func)(SSL*), Deadline deadline,
+                 const char* side) {
+    bio_data.current_deadline = deadline;
+    for (;;) {
+      const auto ret = handshake_func(ssl.get());
+      if (1 == ret) return;
+      if (bio_data.last_exception) {
+        std::rethrow_exception(bio_data.last_exception);
+      }
+
+      const int ssl_error = SSL_get_error(ssl.get(), ret);
+      if (is_native_bio && (ssl_error == SSL_ERROR_WANT_READ ||
+                            ssl_error == SSL_ERROR_WANT_WRITE)) {
+        WaitSocketOrThrow(bio_data.socket, ssl_error, deadline, 0);
+        continue;
+      }
+      throw TlsException(crypto::FormatSslError(fmt::format(
+          "Failed to set up {} TLS wrapper ({})", side, ssl_error)));
+    }
+  }
+
+  // The native socket BIO only reports that the socket is not ready
+  void WaitSocket(int ssl_error, Deadline deadline, size_t bytes_transferred,
+                  InterruptAction interrupt_action) {
+    if (!is_native_bio) return;
+    try {
+      WaitSocketOrThrow(bio_data.socket, ssl_error, deadline,
+                        bytes_transferred);
+    } catch (const IoInterrupted&) {
+      // see the comment on the interrupted writes in PerformSslIo
+      if (interrupt_action == InterruptAction::kFail) ssl.reset();
+      throw;
+    }
+  }
+
   template <typename SslIoFunc>
   size_t PerformSslIo(SslIoFunc&& io_func, void* buf, size_t len,
                       impl::TransferMode mode, InterruptAction interrupt_action,
@@ -294,6 +457,8 @@ class TlsWrapper::Impl {
           // timeout, cancel, EOF, or just a spurious wakeup
           case SSL_ERROR_WANT_READ:
           case SSL_ERROR_WANT_WRITE:
+            WaitSocket(ssl_error, deadline, pos - begin, interrupt_action);
+            break;
           case SSL_ERROR_ZERO_RETURN:
             break;
 
@@ -334,8 +499,11 @@ class TlsWrapper::Impl {
   }
 
   SocketBioData bio_data;
+  // referenced by the SSL, must outlive it
+  std::unique_ptr<ClientSessionContext> session_context;
   Ssl ssl;
   bool is_in_shutdown{false};
+  bool is_native_bio{false};
 
  private:
   void SyncBioData(BIO* bio,
@@ -350,6 +518,13 @@ TlsWrapper::TlsWrapper(Socket&& socket) : impl_(std::move(socket)) {}
 TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
                                       const std::string& server_name,
                                       Deadline deadline) {
+  return StartTlsClient(std::move(socket), server_name, deadline, {});
+}
+
+TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
+                                      const std::string& server_name,
+                                      Deadline deadline,
+                                      const TlsOptions& options) {
   auto ssl_ctx = MakeSslCtx();
 
   if (!server_name.empty()) {
@@ -366,8 +541,17 @@ TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
     SSL_CTX_set_verify(ssl_ctx.get(), SSL_VERIFY_PEER, nullptr);
   }
 
+  if (options.session_cache) {
+    // TLS 1.3 tickets arrive after the handshake, so the sessions are stored
+    // by the callback
+    SSL_CTX_set_session_cache_mode(
+        ssl_ctx.get(),
+        SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ssl_ctx.get(), &OnNewClientSession);
+  }
+
   TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
+  wrapper.impl_->SetUp(std::move(ssl_ctx), options);
   if (!server_name.empty()) {
     // cast in openssl1.0 macro expansion
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
@@ -378,18 +562,16 @@ TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
     }
   }
 
-  wrapper.impl_->bio_data.current_deadline = deadline;
-
-  auto ret = SSL_connect(wrapper.impl_->ssl.get());
-  if (1 != ret) {
-    if (wrapper.impl_->bio_data.last_exception) {
-      std::rethrow_exception(wrapper.impl_->bio_data.last_exception);
-    }
-
-    throw TlsException(crypto::FormatSslError(
-        fmt::format("Failed to set up client TLS wrapper ({})",
-                    SSL_get_error(wrapper.impl_->ssl.get(), ret))));
+  if (options.session_cache) {
+    auto& storage = *options.session_cache->impl_;
+    wrapper.impl_->session_context.reset(new ClientSessionContext{
+        options.session_cache, storage, server_name});
+    SSL_set_app_data(wrapper.impl_->ssl.get(),
+                     wrapper.impl_->session_context.get());
+    storage.Resume(wrapper.impl_->ssl.get(), server_name);
   }
+
+  wrapper.impl_->Handshake(&SSL_connect, deadline, "client");
   return wrapper;
 }
 
@@ -397,6 +579,15 @@ TlsWrapper TlsWrapper::StartTlsServer(
     Socket&& socket, const crypto::Certificate& cert,
     const crypto::PrivateKey& key, Deadline deadline,
     const std::vector<crypto::Certificate>& cert_authorities) {
+  return StartTlsServer(std::move(socket), cert, key, deadline,
+                        cert_authorities, {});
+}
+
+TlsWrapper TlsWrapper::StartTlsServer(
+    Socket&& socket, const crypto::Certificate& cert,
+    const crypto::PrivateKey& key, Deadline deadline,
+    const std::vector<crypto::Certificate>& cert_authorities,
+    const TlsOptions& options) {
   auto ssl_ctx = MakeSslCtx();
 
   if (!cert_authorities.empty()) {
@@ -419,21 +610,13 @@ TlsWrapper TlsWrapper::StartTlsServer(
         "Failed to set up server TLS wrapper: SSL_CTX_use_PrivateKey"));
   }
 
-  TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
-  wrapper.impl_->bio_data.current_deadline = deadline;
-
-  auto ret = SSL_accept(wrapper.impl_->ssl.get());
-  if (1 != ret) {
-    if (wrapper.impl_->bio_data.last_exception) {
-      std::rethrow_exception(wrapper.impl_->bio_data.last_exception);
-    }
-
-    throw TlsException(crypto::FormatSslError(
-        fmt::format("Failed to set up server TLS wrapper ({})",
-                    SSL_get_error(wrapper.impl_->ssl.get(), ret))));
+  if (options.session_cache) {
+    options.session_cache->impl_->SetUpServer(ssl_ctx.get());
   }
 
+  TlsWrapper wrapper{std::move(socket)};
+  wrapper.impl_->SetUp(std::move(ssl_ctx), options);
+  wrapper.impl_->Handshake(&SSL_accept, deadline, "server");
   return wrapper;
 }
 
@@ -450,6 +633,18 @@ bool TlsWrapper::IsValid() const {
   return impl_->ssl && !impl_->is_in_shutdown;
 }
 
+bool TlsWrapper::IsSessionReused() const {
+  return impl_->ssl && SSL_session_reused(impl_->ssl.get());
+}
+
+bool TlsWrapper::IsKernelTlsEnabled() const {
+#if defined(SSL_OP_ENABLE_KTLS)
+  return impl_->ssl && BIO_get_ktls_send(SSL_get_wbio(impl_->ssl.get()));
+#else
+  return false;
+#endif
+}
+
 bool TlsWrapper::WaitReadable(Deadline deadline) {
   impl_->CheckAlive();
   char buf = 0;
@@ -495,6 +690,7 @@ Socket TlsWrapper::StopTls(Deadline deadline) {
           // this is fine
           case SSL_ERROR_WANT_READ:
           case SSL_ERROR_WANT_WRITE:
+            impl_->WaitSocket(ssl_error, deadline, 0, InterruptAction::kPass);
             break;
 
           // connection breaking errors
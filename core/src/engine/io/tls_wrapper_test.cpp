@@ -4,6 +4,7 @@
 #include <sys/socket.h>
 
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -572,4 +573,99 @@ UTEST(TlsWrapper, PeerDisconnect) {
   server_task.Get();
 }
 
+UTEST_MT(TlsWrapper, KernelTls, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  // large enough to overflow the socket buffers
+  const std::string data(4 * 1024 * 1024, 'k');
+
+  TcpListener tcp_listener;
+  auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+  io::TlsOptions options;
+  options.kernel_tls = true;
+
+  auto server_task = engine::AsyncNoSpan(
+      [test_deadline, &data, &options](auto&& server) {
+        try {
+          auto tls_server = io::TlsWrapper::StartTlsServer(
+              std::forward<decltype(server)>(server),
+              crypto::Certificate::LoadFromString(cert),
+              crypto::PrivateKey::LoadFromString(key), test_deadline, {},
+              options);
+          LOG_INFO() << "Kernel TLS enabled: "
+                     << tls_server.IsKernelTlsEnabled();
+          EXPECT_EQ(data.size(), tls_server.SendAll(data.data(), data.size(),
+                                                    test_deadline));
+          char c = 0;
+          EXPECT_EQ(1, tls_server.RecvAll(&c, 1, test_deadline));
+          EXPECT_EQ('2', c);
+
+          auto raw_server = tls_server.StopTls(test_deadline);
+          EXPECT_EQ(1, raw_server.SendAll("3", 1, test_deadline));
+        } catch (const std::exception& e) {
+          LOG_ERROR() << e;
+          FAIL() << e.what();
+        }
+      },
+      std::move(server));
+
+  auto tls_client = io::TlsWrapper::StartTlsClient(std::move(client), {},
+                                                   test_deadline, options);
+  std::string received(data.size(), '\0');
+  EXPECT_EQ(data.size(), tls_client.RecvAll(received.data(), received.size(),
+                                            test_deadline));
+  EXPECT_EQ(data, received);
+  EXPECT_EQ(1, tls_client.SendAll("2", 1, test_deadline));
+  char c = 0;
+  UEXPECT_THROW([[maybe_unused]] const auto ret = tls_client.RecvAll(
+                    &c, 1, Deadline::FromDuration(kShortTimeout)),
+                io::IoTimeout);
+  auto raw_client = tls_client.StopTls(test_deadline);
+  EXPECT_EQ(1, raw_client.RecvAll(&c, 1, test_deadline));
+  EXPECT_EQ('3', c);
+
+  server_task.Get();
+}
+
+UTEST_MT(TlsWrapper, SessionResumption, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  io::TlsOptions server_options;
+  server_options.session_cache = std::make_shared<io::TlsSessionCache>();
+  io::TlsOptions client_options;
+  client_options.session_cache = std::make_shared<io::TlsSessionCache>();
+
+  TcpListener tcp_listener;
+  for (const bool is_resumed : {false, true}) {
+    auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+
+    auto server_task = engine::AsyncNoSpan(
+        [test_deadline, &server_options, is_resumed](auto&& server) {
+          try {
+            auto tls_server = io::TlsWrapper::StartTlsServer(
+                std::forward<decltype(server)>(server),
+                crypto::Certificate::LoadFromString(cert),
+                crypto::PrivateKey::LoadFromString(key), test_deadline, {},
+                server_options);
+            EXPECT_EQ(is_resumed, tls_server.IsSessionReused());
+            EXPECT_EQ(1, tls_server.SendAll("1", 1, test_deadline));
+            char c = 0;
+            EXPECT_EQ(1, tls_server.RecvAll(&c, 1, test_deadline));
+          } catch (const std::exception& e) {
+            LOG_ERROR() << e;
+            FAIL() << e.what();
+          }
+        },
+        std::move(server));
+
+    auto tls_client = io::TlsWrapper::StartTlsClient(
+        std::move(client), {}, test_deadline, client_options);
+    EXPECT_EQ(is_resumed, tls_client.IsSessionReused());
+    // TLS 1.3 session tickets are received along with the data
+    char c = 0;
+    EXPECT_EQ(1, tls_client.RecvAll(&c, 1, test_deadline));
+    EXPECT_EQ(1, tls_client.SendAll("2", 1, test_deadline));
+
+    server_task.Get();
+  }
+}
+
 USERVER_NAMESPACE_END
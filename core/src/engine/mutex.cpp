@@ -1,15 +1,22 @@
 #include <userver/engine/mutex.hpp>
 
+#include <utility>
+
 #include <engine/impl/mutex_impl.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace engine {
 
-class Mutex::Impl final : public impl::MutexImpl<impl::WaitList> {};
+class Mutex::Impl final : public impl::MutexImpl<impl::WaitList> {
+ public:
+  using MutexImpl::MutexImpl;
+};
 
 Mutex::Mutex() = default;
 
+Mutex::Mutex(AdaptiveSpinning settings) : impl_(std::move(settings)) {}
+
 Mutex::~Mutex() = default;
 
 void Mutex::lock() { impl_->lock(); }
@@ -22,6 +29,11 @@ bool Mutex::try_lock_until(Deadline deadline) {
   return impl_->try_lock_until(deadline);
 }
 
+LockContentionStatistics Mutex::GetContentionStatistics() const {
+  const auto* spinner = impl_->GetSpinner();
+  return spinner ? spinner->GetStatistics() : LockContentionStatistics{};
+}
+
 }  // namespace engine
 
 USERVER_NAMESPACE_END
@@ -6,7 +6,7 @@
 #include <thread>
 #include <vector>
 
-#include <concurrent/impl/interference_shield.hpp>
+#include <userver/concurrent/impl/interference_shield.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/engine/run_standalone.hpp>
@@ -55,6 +55,15 @@ class AsyncCoroPool {
   std::vector<engine::TaskWithResult<void>> tasks;
 };
 
+class AdaptiveMutex final {
+ public:
+  void lock() { mutex_.lock(); }
+  void unlock() { mutex_.unlock(); }
+
+ private:
+  engine::Mutex mutex_{engine::AdaptiveSpinning{"benchmark"}};
+};
+
 template <typename T>
 struct PoolForImpl;
 
@@ -68,6 +77,11 @@ struct PoolForImpl<engine::Mutex> {
   using Pool = AsyncCoroPool;
 };
 
+template <>
+struct PoolForImpl<AdaptiveMutex> {
+  using Pool = AsyncCoroPool;
+};
+
 template <>
 struct PoolForImpl<engine::SingleWaitingTaskMutex> {
   using Pool = AsyncCoroPool;
@@ -249,6 +263,11 @@ void mutex_coro_contention(benchmark::State& state) {
                         [&] { generic_contention<engine::Mutex>(state); });
 }
 
+void mutex_coro_adaptive_contention(benchmark::State& state) {
+  engine::RunStandalone(state.range(0),
+                        [&] { generic_contention<AdaptiveMutex>(state); });
+}
+
 void mutex_std_contention(benchmark::State& state) {
   generic_contention<std::mutex>(state);
 }
@@ -265,6 +284,12 @@ void mutex_coro_contention_with_payload(benchmark::State& state) {
   });
 }
 
+void mutex_coro_adaptive_contention_with_payload(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    generic_contention_with_payload<AdaptiveMutex>(state);
+  });
+}
+
 void mutex_std_contention_with_payload(benchmark::State& state) {
   generic_contention_with_payload<std::mutex>(state);
 }
@@ -287,10 +312,14 @@ BENCHMARK(mutex_std_unlock);
 BENCHMARK(single_waiting_task_mutex_unlock);
 
 BENCHMARK(mutex_coro_contention)->RangeMultiplier(2)->Range(1, 32);
+BENCHMARK(mutex_coro_adaptive_contention)->RangeMultiplier(2)->Range(1, 32);
 BENCHMARK(mutex_std_contention)->RangeMultiplier(2)->Range(1, 32);
 BENCHMARK(single_waiting_task_mutex_contention)->Range(1, 2);
 
 BENCHMARK(mutex_coro_contention_with_payload)->RangeMultiplier(2)->Range(1, 32);
+BENCHMARK(mutex_coro_adaptive_contention_with_payload)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
 BENCHMARK(mutex_std_contention_with_payload)->RangeMultiplier(2)->Range(1, 32);
 BENCHMARK(single_waiting_task_mutex_contention_with_payload)->Range(1, 2);
 
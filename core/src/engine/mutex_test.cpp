@@ -13,6 +13,38 @@ using namespace std::chrono_literals;
 
 USERVER_NAMESPACE_BEGIN
 
+namespace {
+
+template <typename BaseMutex>
+class Adaptive final {
+ public:
+  void lock() { mutex_.lock(); }
+  void unlock() { mutex_.unlock(); }
+  bool try_lock() { return mutex_.try_lock(); }
+
+  template <typename Duration>
+  bool try_lock_for(Duration duration) {
+    return mutex_.try_lock_for(duration);
+  }
+
+  template <typename TimePoint>
+  bool try_lock_until(TimePoint until) {
+    return mutex_.try_lock_until(until);
+  }
+
+  engine::LockContentionStatistics GetContentionStatistics() const {
+    return mutex_.GetContentionStatistics();
+  }
+
+ private:
+  BaseMutex mutex_{engine::AdaptiveSpinning{"test"}};
+};
+
+using AdaptiveMutex = Adaptive<engine::Mutex>;
+using AdaptiveSharedMutex = Adaptive<engine::SharedMutex>;
+
+}  // namespace
+
 template <class T>
 struct Mutex : public ::testing::Test {};
 TYPED_UTEST_SUITE_P(Mutex);
@@ -165,6 +197,33 @@ UTEST(Mutex, SampleMutex) {
   /// [Sample engine::Mutex usage]
 }
 
+UTEST_MT(Mutex, AdaptiveSpinningStatistics, 4) {
+  constexpr std::size_t kTasks = 4;
+  constexpr std::size_t kIterations = 10000;
+  AdaptiveMutex mutex;
+  std::size_t counter = 0;
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < kTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      for (std::size_t j = 0; j < kIterations; ++j) {
+        const std::lock_guard lock(mutex);
+        ++counter;
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_EQ(counter, kTasks * kIterations);
+  const auto stats = mutex.GetContentionStatistics();
+  EXPECT_EQ(stats.name, "test");
+  EXPECT_EQ(stats.fast_path + stats.spin_acquired + stats.slept,
+            kTasks * kIterations);
+  EXPECT_LE(stats.spin_budget, 1000);
+
+  EXPECT_EQ(engine::Mutex{}.GetContentionStatistics().fast_path, 0);
+}
+
 REGISTER_TYPED_UTEST_SUITE_P(Mutex,
 
                              LockUnlock, LockUnlockDouble, WaitAndCancel,
@@ -172,6 +231,9 @@ REGISTER_TYPED_UTEST_SUITE_P(Mutex,
 
 INSTANTIATE_TYPED_UTEST_SUITE_P(EngineMutex, Mutex, engine::Mutex);
 INSTANTIATE_TYPED_UTEST_SUITE_P(EngineSharedMutex, Mutex, engine::SharedMutex);
+INSTANTIATE_TYPED_UTEST_SUITE_P(EngineAdaptiveMutex, Mutex, AdaptiveMutex);
+INSTANTIATE_TYPED_UTEST_SUITE_P(EngineAdaptiveSharedMutex, Mutex,
+                                AdaptiveSharedMutex);
 INSTANTIATE_TYPED_UTEST_SUITE_P(EngineSingleWaitingTaskMutex, Mutex,
                                 engine::SingleWaitingTaskMutex);
 
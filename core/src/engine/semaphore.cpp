@@ -1,12 +1,16 @@
 #include <userver/engine/semaphore.hpp>
 
+#include <utility>
+
 #include <fmt/format.h>
 
 #include <userver/engine/task/cancel.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <engine/impl/adaptive_spinner.hpp>
 #include <engine/impl/wait_list.hpp>
 #include <engine/task/task_context.hpp>
+#include <engine/task/task_processor.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -46,6 +50,11 @@ class SemaphoreWaitStrategy final : public impl::WaitStrategy {
 Semaphore::Semaphore(Counter capacity)
     : acquired_locks_(0), capacity_(capacity) {}
 
+Semaphore::Semaphore(Counter capacity, AdaptiveSpinning settings)
+    : acquired_locks_(0),
+      capacity_(capacity),
+      spinner_(std::make_unique<impl::AdaptiveSpinner>(std::move(settings))) {}
+
 Semaphore::~Semaphore() {
   UASSERT_MSG(
       acquired_locks_.load() == 0,
@@ -123,11 +132,18 @@ bool Semaphore::try_lock_shared_until_count(Deadline deadline,
                                             const Counter count) {
   LOG_TRACE() << "try_lock_shared_until_count()";
   const auto status = LockFastPath(count);
-  if (status == TryLockStatus::kSuccess) return true;
+  if (status == TryLockStatus::kSuccess) {
+    if (spinner_) spinner_->AccountFastPath();
+    return true;
+  }
   if (status == TryLockStatus::kPermanentFailure) return false;
   return LockSlowPath(deadline, count);
 }
 
+LockContentionStatistics Semaphore::GetContentionStatistics() const {
+  return spinner_ ? spinner_->GetStatistics() : LockContentionStatistics{};
+}
+
 Semaphore::TryLockStatus Semaphore::DoTryLock(const Counter count) {
   auto capacity = capacity_.load(std::memory_order_acquire);
   if (count > capacity) return TryLockStatus::kPermanentFailure;
@@ -155,15 +171,33 @@ Semaphore::TryLockStatus Semaphore::LockFastPath(const Counter count) {
   return status;
 }
 
+bool Semaphore::LockSpinning(const Counter count, TryLockStatus& status) {
+  UASSERT(spinner_);
+  // Nobody may release the locks while we spin on a single worker
+  auto& current = current_task::GetCurrentTaskContext();
+  if (current.GetTaskProcessor().GetWorkerCount() < 2) return false;
+
+  status = TryLockStatus::kTransientFailure;
+  return spinner_->Spin(
+      [&] { return (status = DoTryLock(count)) == TryLockStatus::kSuccess; },
+      [&] { return status == TryLockStatus::kTransientFailure; });
+}
+
 bool Semaphore::LockSlowPath(Deadline deadline, const Counter count) {
   UASSERT(count > 0);
   LOG_TRACE() << "trying slow path";
 
+  TryLockStatus status{};
+  if (spinner_ && !deadline.IsReached()) {
+    if (LockSpinning(count, status)) return true;
+    if (status == TryLockStatus::kPermanentFailure) return false;
+    spinner_->AccountSleep();
+  }
+
   engine::TaskCancellationBlocker block_cancels;
   auto& current = current_task::GetCurrentTaskContext();
   SemaphoreWaitStrategy wait_manager(*lock_waiters_, current, deadline);
 
-  TryLockStatus status{};
   while ((status = DoTryLock(count)) == TryLockStatus::kTransientFailure) {
     LOG_TRACE() << "iteration()";
 
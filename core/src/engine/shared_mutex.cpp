@@ -1,5 +1,7 @@
 #include <userver/engine/shared_mutex.hpp>
 
+#include <utility>
+
 #include <userver/engine/task/cancel.hpp>
 #include <userver/utils/scope_guard.hpp>
 
@@ -14,6 +16,13 @@ constexpr auto kWriterLock = std::numeric_limits<Semaphore::Counter>::max();
 SharedMutex::SharedMutex()
     : semaphore_(kWriterLock), waiting_writers_count_(0) {}
 
+SharedMutex::SharedMutex(AdaptiveSpinning settings)
+    : semaphore_(kWriterLock, std::move(settings)), waiting_writers_count_(0) {}
+
+LockContentionStatistics SharedMutex::GetContentionStatistics() const {
+  return semaphore_.GetContentionStatistics();
+}
+
 void SharedMutex::lock() { try_lock_until(Deadline{}); }
 
 void SharedMutex::unlock() {
@@ -1,5 +1,9 @@
 #include <benchmark/benchmark.h>
 
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
 #include <engine/ev/thread_control.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
@@ -67,4 +71,45 @@ BENCHMARK_CAPTURE(unreached_task_deadline_benchmark, no_task_deadline, false);
 BENCHMARK_CAPTURE(unreached_task_deadline_benchmark, unreached_task_deadline,
                   true);
 
+void sleep_concurrent_timers(benchmark::State& state, bool use_timer_wheel) {
+  const auto timers_count = state.range(0);
+
+  engine::TaskProcessorPoolsConfig config;
+  config.initial_coro_pool_size = timers_count;
+  config.max_coro_pool_size = timers_count;
+  config.coro_stack_size = 32 * 1024;
+  config.ev_timer_wheel_slack = use_timer_wheel ? 1ms : 0ms;
+
+  engine::RunStandalone(4, config, [&] {
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(timers_count);
+
+    for (auto _ : state) {
+      std::atomic<std::int64_t> sleeping{0};
+      for (std::int64_t i = 0; i < timers_count; ++i) {
+        tasks.push_back(engine::AsyncNoSpan([&sleeping] {
+          ++sleeping;
+          engine::InterruptibleSleepFor(100s);
+        }));
+      }
+      while (sleeping < timers_count) engine::Yield();
+
+      // Most of the deadlines are never reached
+      for (auto& task : tasks) task.SyncCancel();
+      tasks.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * timers_count);
+  });
+}
+// Every coroutine stack takes 2 memory mappings, the 1M case requires
+// raising vm.max_map_count
+BENCHMARK_CAPTURE(sleep_concurrent_timers, libev_timers, false)
+    ->RangeMultiplier(16)
+    ->Range(1024, 1024 * 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(sleep_concurrent_timers, timer_wheel, true)
+    ->RangeMultiplier(16)
+    ->Range(1024, 1024 * 1024)
+    ->Unit(benchmark::kMillisecond);
+
 USERVER_NAMESPACE_END
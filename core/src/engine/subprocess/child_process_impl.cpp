@@ -3,6 +3,7 @@
 #include <sys/types.h>
 
 #include <csignal>
+#include <stdexcept>
 
 #include <userver/engine/task/cancel.hpp>
 #include <utils/check_syscall.hpp>
@@ -11,9 +12,29 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::subprocess {
 
+namespace {
+
+template <typename Pipe>
+Pipe& GetPipe(std::optional<Pipe>& pipe, const char* option_name) {
+  if (!pipe) {
+    throw std::logic_error(std::string{"ExecOptions::"} + option_name +
+                           " was not set for the child process");
+  }
+  return *pipe;
+}
+
+}  // namespace
+
 ChildProcessImpl::ChildProcessImpl(int pid,
-                                   Future<ChildProcessStatus>&& status_future)
-    : pid_(pid), status_future_(std::move(status_future)) {}
+                                   Future<ChildProcessStatus>&& status_future,
+                                   std::optional<io::PipeWriter> stdin_pipe,
+                                   std::optional<io::PipeReader> stdout_pipe,
+                                   std::optional<io::PipeReader> stderr_pipe)
+    : pid_(pid),
+      status_future_(std::move(status_future)),
+      stdin_(std::move(stdin_pipe)),
+      stdout_(std::move(stdout_pipe)),
+      stderr_(std::move(stderr_pipe)) {}
 
 void ChildProcessImpl::WaitNonCancellable() {
   TaskCancellationBlocker cancel_blocker;
@@ -35,6 +56,18 @@ void ChildProcessImpl::SendSignal(int signum) {
   utils::CheckSyscall(kill(pid_, signum), "kill, pid={}", pid_);
 }
 
+io::PipeWriter& ChildProcessImpl::GetStdin() {
+  return GetPipe(stdin_, "pipe_stdin");
+}
+
+io::PipeReader& ChildProcessImpl::GetStdout() {
+  return GetPipe(stdout_, "pipe_stdout");
+}
+
+io::PipeReader& ChildProcessImpl::GetStderr() {
+  return GetPipe(stderr_, "pipe_stderr");
+}
+
 }  // namespace engine::subprocess
 
 USERVER_NAMESPACE_END
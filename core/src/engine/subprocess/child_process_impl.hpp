@@ -1,9 +1,11 @@
 #pragma once
 
 #include <chrono>
+#include <optional>
 
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/future.hpp>
+#include <userver/engine/io/pipe.hpp>
 #include <userver/engine/subprocess/child_process_status.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -12,7 +14,10 @@ namespace engine::subprocess {
 
 class ChildProcessImpl {
  public:
-  ChildProcessImpl(int pid, Future<ChildProcessStatus>&& status_future);
+  ChildProcessImpl(int pid, Future<ChildProcessStatus>&& status_future,
+                   std::optional<io::PipeWriter> stdin_pipe = {},
+                   std::optional<io::PipeReader> stdout_pipe = {},
+                   std::optional<io::PipeReader> stderr_pipe = {});
 
   int GetPid() const { return pid_; }
 
@@ -24,9 +29,16 @@ class ChildProcessImpl {
 
   void SendSignal(int signum);
 
+  io::PipeWriter& GetStdin();
+  io::PipeReader& GetStdout();
+  io::PipeReader& GetStderr();
+
  private:
   int pid_;
   Future<ChildProcessStatus> status_future_;
+  std::optional<io::PipeWriter> stdin_;
+  std::optional<io::PipeReader> stdout_;
+  std::optional<io::PipeReader> stderr_;
 };
 
 }  // namespace engine::subprocess
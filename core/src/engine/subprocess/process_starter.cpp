@@ -1,29 +1,25 @@
 #include <userver/engine/subprocess/process_starter.hpp>
 
+#include <fcntl.h>
+#include <spawn.h>
 #include <sys/types.h>
-#include <sys/wait.h>
 #include <unistd.h>
 
 #include <csignal>
-#include <cstdio>
-#include <cstring>
-#include <iostream>
+#include <stdexcept>
 
 #include <fmt/format.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 
+#include <userver/engine/future.hpp>
+#include <userver/engine/io/pipe.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
 #include <utils/check_syscall.hpp>
 
 #include <engine/ev/child_process_map.hpp>
-#include <engine/ev/thread_control.hpp>
-#include <engine/ev/thread_pool.hpp>
-#include <engine/task/task_processor.hpp>
-#include <userver/engine/future.hpp>
-#include <userver/engine/task/cancel.hpp>
-
 #include <engine/subprocess/child_process_impl.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -31,20 +27,103 @@ USERVER_NAMESPACE_BEGIN
 namespace engine::subprocess {
 namespace {
 
-void DoExecve(const std::string& command, const std::vector<std::string>& args,
-              const EnvironmentVariables& env,
-              const std::optional<std::string>& stdout_file,
-              const std::optional<std::string>& stderr_file) {
-  if (stdout_file) {
-    if (!std::freopen(stdout_file->c_str(), "a", stdout)) {
-      utils::CheckSyscall(-1, "freopen stdout to {}", *stdout_file);
-    }
+constexpr int kOutputFileFlags = O_WRONLY | O_CREAT | O_APPEND;
+constexpr mode_t kOutputFileMode = 0666;
+
+void CheckSpawnCall(int error_code, std::string_view action) {
+  if (error_code != 0) {
+    errno = error_code;
+    utils::CheckSyscall(-1, "{}", action);
   }
-  if (stderr_file) {
-    if (!std::freopen(stderr_file->c_str(), "a", stderr)) {
-      utils::CheckSyscall(-1, "freopen stderr to {}", *stdout_file);
-    }
+}
+
+class SpawnFileActions final {
+ public:
+  SpawnFileActions() {
+    CheckSpawnCall(::posix_spawn_file_actions_init(&actions_),
+                   "posix_spawn_file_actions_init");
+  }
+
+  ~SpawnFileActions() { ::posix_spawn_file_actions_destroy(&actions_); }
+
+  SpawnFileActions(const SpawnFileActions&) = delete;
+  SpawnFileActions& operator=(const SpawnFileActions&) = delete;
+
+  void AddOpen(int fd, const std::string& path) {
+    CheckSpawnCall(::posix_spawn_file_actions_addopen(
+                       &actions_, fd, path.c_str(), kOutputFileFlags,
+                       kOutputFileMode),
+                   "posix_spawn_file_actions_addopen");
   }
+
+  // Also clears the FD_CLOEXEC of the `fd`
+  void AddDup2(int from_fd, int fd) {
+    CheckSpawnCall(::posix_spawn_file_actions_adddup2(&actions_, from_fd, fd),
+                   "posix_spawn_file_actions_adddup2");
+  }
+
+  const posix_spawn_file_actions_t* Get() const { return &actions_; }
+
+ private:
+  posix_spawn_file_actions_t actions_{};
+};
+
+// The end of a pipe passed to the child, closed in the parent after the start
+class ChildPipeEnd final {
+ public:
+  explicit ChildPipeEnd(int fd) : fd_(fd) {
+    // The child may not expect non-blocking standard streams
+    const int flags =
+        utils::CheckSyscall(::fcntl(fd_, F_GETFL), "fcntl(F_GETFL)");
+    utils::CheckSyscall(::fcntl(fd_, F_SETFL, flags & ~O_NONBLOCK),
+                        "fcntl(F_SETFL)");
+  }
+
+  ~ChildPipeEnd() {
+    if (fd_ != -1) ::close(fd_);
+  }
+
+  ChildPipeEnd(const ChildPipeEnd&) = delete;
+  ChildPipeEnd& operator=(const ChildPipeEnd&) = delete;
+
+  int Fd() const { return fd_; }
+
+ private:
+  int fd_;
+};
+
+std::string ToString(const std::vector<std::string>& args) {
+  return args.empty() ? "" : '\'' + boost::join(args, "' '") + '\'';
+}
+
+std::string ToString(const EnvironmentVariables& env) {
+  return boost::join(
+      env | boost::adaptors::transformed([](const auto& key_value) {
+        return key_value.first + '=' + key_value.second;
+      }),
+      ", ");
+}
+
+}  // namespace
+
+ProcessStarter::ProcessStarter(TaskProcessor&) {}
+
+ChildProcess ProcessStarter::Exec(const std::string& command,
+                                  const std::vector<std::string>& args,
+                                  const EnvironmentVariables& env,
+                                  const ExecOptions& options) {
+  if (options.pipe_stdout && options.stdout_file) {
+    throw std::logic_error("Both pipe_stdout and stdout_file are set");
+  }
+  if (options.pipe_stderr && options.stderr_file) {
+    throw std::logic_error("Both pipe_stderr and stderr_file are set");
+  }
+
+  tracing::Span span("ProcessStarter::Exec");
+  span.AddTag("command", command);
+  LOG_DEBUG() << "do posix_spawn(), command=" << command << ", args=["
+              << ToString(args) << "], env=[" << ToString(env) << ']';
+
   std::vector<char*> argv_ptrs;
   std::vector<std::string> envp_buf;
   std::vector<char*> envp_ptrs;
@@ -67,74 +146,83 @@ void DoExecve(const std::string& command, const std::vector<std::string>& args,
   }
   envp_ptrs.push_back(nullptr);
 
-  utils::CheckSyscall(
-      execve(command.c_str(), argv_ptrs.data(), envp_ptrs.data()), "execve");
-}
+  SpawnFileActions actions;
+  std::optional<io::PipeWriter> stdin_pipe;
+  std::optional<io::PipeReader> stdout_pipe;
+  std::optional<io::PipeReader> stderr_pipe;
+  std::optional<ChildPipeEnd> child_stdin;
+  std::optional<ChildPipeEnd> child_stdout;
+  std::optional<ChildPipeEnd> child_stderr;
+
+  if (options.pipe_stdin) {
+    io::Pipe pipe;
+    child_stdin.emplace(pipe.reader.Release());
+    stdin_pipe.emplace(std::move(pipe.writer));
+    actions.AddDup2(child_stdin->Fd(), STDIN_FILENO);
+  }
+  if (options.pipe_stdout) {
+    io::Pipe pipe;
+    child_stdout.emplace(pipe.writer.Release());
+    stdout_pipe.emplace(std::move(pipe.reader));
+    actions.AddDup2(child_stdout->Fd(), STDOUT_FILENO);
+  } else if (options.stdout_file) {
+    actions.AddOpen(STDOUT_FILENO, *options.stdout_file);
+  }
+  if (options.pipe_stderr) {
+    io::Pipe pipe;
+    child_stderr.emplace(pipe.writer.Release());
+    stderr_pipe.emplace(std::move(pipe.reader));
+    actions.AddDup2(child_stderr->Fd(), STDERR_FILENO);
+  } else if (options.stderr_file) {
+    actions.AddOpen(STDERR_FILENO, *options.stderr_file);
+  }
 
-}  // namespace
+  Promise<ChildProcessStatus> status_promise;
+  auto status_future = status_promise.get_future();
+  pid_t pid = -1;
+  {
+    // The process must be registered before its exit status gets handled
+    const auto lock = ev::ChildProcessMapLock();
+
+    // Unlike fork(), does not copy the page tables of the service and
+    // returns once the child has called execve()
+    CheckSpawnCall(::posix_spawn(&pid, command.c_str(), actions.Get(),
+                                 nullptr, argv_ptrs.data(), envp_ptrs.data()),
+                   fmt::format("posix_spawn {}", command));
+
+    const auto res = ev::ChildProcessMapSet(
+        pid, ev::ChildProcessMapValue(std::move(status_promise)));
+    if (!res.second) {
+      std::string msg = "process with pid=" + std::to_string(pid) +
+                        " already exists in child_process_map";
+      LOG_ERROR() << msg << ", send SIGKILL";
+      ChildProcessImpl(pid, Future<ChildProcessStatus>{}).SendSignal(SIGKILL);
+      throw std::runtime_error(msg);
+    }
+  }
+
+  span.AddTag("child-process-pid", pid);
+  LOG_DEBUG() << "Started child process with pid=" << pid;
+  return ChildProcess{ChildProcessImpl{
+      pid, std::move(status_future), std::move(stdin_pipe),
+      std::move(stdout_pipe), std::move(stderr_pipe)}};
+}
 
-ProcessStarter::ProcessStarter(TaskProcessor& task_processor)
-    : thread_control_(
-          task_processor.EventThreadPool().GetEvDefaultLoopThread()) {}
+ChildProcess ProcessStarter::Exec(const std::string& command,
+                                  const std::vector<std::string>& args,
+                                  const ExecOptions& options) {
+  return Exec(command, args, GetCurrentEnvironmentVariables(), options);
+}
 
 ChildProcess ProcessStarter::Exec(
     const std::string& command, const std::vector<std::string>& args,
     const EnvironmentVariables& env,
     const std::optional<std::string>& stdout_file,
     const std::optional<std::string>& stderr_file) {
-  tracing::Span span("ProcessStarter::Exec");
-  span.AddTag("command", command);
-  Promise<ChildProcess> promise;
-  auto future = promise.get_future();
-  thread_control_.RunInEvLoopAsync([&, promise = std::move(promise)]() mutable {
-    LOG_DEBUG() << "do fork() + execve(), command=" << command << ", args=["
-                << (args.empty() ? "" : '\'' + boost::join(args, "' '") + '\'')
-                << "], env=["
-                << (env.empty()
-                        ? ""
-                        : boost::join(env | boost::adaptors::transformed(
-                                                [](const auto& key_value) {
-                                                  return key_value.first + '=' +
-                                                         key_value.second;
-                                                }),
-                                      ", "))
-                << ']';
-    auto pid = utils::CheckSyscall(fork(), "fork");
-    if (pid) {
-      // in parent thread
-      span.AddTag("child-process-pid", pid);
-      LOG_DEBUG() << "Started child process with pid=" << pid;
-      Promise<ChildProcessStatus> exec_result_promise;
-      auto res = ChildProcessMapSet(
-          pid, ev::ChildProcessMapValue(std::move(exec_result_promise)));
-      if (res.second) {
-        promise.set_value(ChildProcess{
-            ChildProcessImpl{pid, res.first->status_promise.get_future()}});
-      } else {
-        std::string msg = "process with pid=" + std::to_string(pid) +
-                          " already exists in child_process_map";
-        LOG_ERROR() << msg << ", send SIGKILL";
-        ChildProcessImpl(pid, Future<ChildProcessStatus>{}).SendSignal(SIGKILL);
-        promise.set_exception(std::make_exception_ptr(std::runtime_error(msg)));
-      }
-    } else {
-      // in child thread
-      try {
-        try {
-          DoExecve(command, args, env, stdout_file, stderr_file);
-        } catch (const std::exception& ex) {
-          std::cerr << "Cannot execute child: " << ex.what();
-        }
-      } catch (...) {
-        // must not do anything in a child
-      }
-      // on success execve does not return
-      std::abort();
-    }
-  });
-
-  engine::TaskCancellationBlocker cancel_blocker;
-  return future.get();
+  ExecOptions options;
+  options.stdout_file = stdout_file;
+  options.stderr_file = stderr_file;
+  return Exec(command, args, env, options);
 }
 
 ChildProcess ProcessStarter::Exec(
@@ -19,6 +19,8 @@
 
 #include <engine/ev/thread_control.hpp>
 #include <engine/ev/thread_pool.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/pipe.hpp>
 #include <userver/engine/subprocess/child_process.hpp>
 #include <userver/engine/subprocess/process_starter.hpp>
 #include <userver/engine/task/task.hpp>
@@ -63,6 +65,63 @@ UTEST(Subprocess, False) {
   EXPECT_NE(0, status.GetExitCode());
 }
 
+UTEST(Subprocess, Pipes) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  engine::subprocess::ProcessStarter starter(
+      engine::current_task::GetTaskProcessor());
+
+  engine::subprocess::ExecOptions options;
+  options.pipe_stdin = true;
+  options.pipe_stdout = true;
+  options.pipe_stderr = true;
+  auto child = starter.Exec(
+      "/bin/sh", {"-c", "cat; echo -n error >&2"}, options);
+
+  const std::string input = "hello, child";
+  ASSERT_EQ(child.GetStdin().WriteAll(input.data(), input.size(), deadline),
+            input.size());
+  child.GetStdin().Close();
+
+  std::string output(input.size() + 1, '\0');
+  output.resize(
+      child.GetStdout().ReadAll(output.data(), output.size(), deadline));
+  EXPECT_EQ(output, input);
+
+  std::string error(16, '\0');
+  error.resize(child.GetStderr().ReadAll(error.data(), error.size(), deadline));
+  EXPECT_EQ(error, "error");
+
+  const auto status = child.Get();
+  ASSERT_TRUE(status.IsExited());
+  EXPECT_EQ(0, status.GetExitCode());
+}
+
+UTEST(Subprocess, NoPipes) {
+  engine::subprocess::ProcessStarter starter(
+      engine::current_task::GetTaskProcessor());
+
+  auto child = starter.Exec(kTestProgram, {"-n", "1"},
+                            engine::subprocess::ExecOptions{});
+  UEXPECT_THROW(child.GetStdout(), std::logic_error);
+  EXPECT_TRUE(child.Get().IsExited());
+}
+
+UTEST_MT(Subprocess, ManyChildren, 4) {
+  constexpr std::size_t kChildrenCount = 64;
+  engine::subprocess::ProcessStarter starter(
+      engine::current_task::GetTaskProcessor());
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < kChildrenCount; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&starter] {
+      const auto status = starter.Exec(kTestProgram, {"-n", "1"}).Get();
+      ASSERT_TRUE(status.IsExited());
+      EXPECT_EQ(0, status.GetExitCode());
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+}
+
 UTEST(Subprocess, CheckSpdlogClosesFds) {
   auto file = fs::blocking::TempFile::Create("/tmp", kSpdlogFilePart);
   auto logger = logging::MakeFileLogger("to_file", file.GetPath(),
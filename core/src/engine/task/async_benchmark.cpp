@@ -35,6 +35,18 @@ void async_comparisons_coro(benchmark::State& state) {
 }
 BENCHMARK(async_comparisons_coro)->RangeMultiplier(2)->Range(1, 32);
 
+void async_comparisons_coro_inline(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    std::uint64_t constructed_joined_count = 0;
+    for (auto _ : state) {
+      engine::InlineAsyncNoSpan([] {}).Wait();
+      ++constructed_joined_count;
+    }
+    benchmark::DoNotOptimize(constructed_joined_count);
+  });
+}
+BENCHMARK(async_comparisons_coro_inline)->RangeMultiplier(2)->Range(1, 32);
+
 void wrap_call_single(benchmark::State& state) {
   engine::RunStandalone([&] {
     for (auto _ : state) {
@@ -1,6 +1,8 @@
 #include <userver/utest/utest.hpp>
 
 #include <atomic>
+#include <functional>
+#include <stdexcept>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/sleep.hpp>
@@ -285,4 +287,49 @@ UTEST(Async, FromNonWorkerThread) {
   task.Wait();
 }
 
+UTEST(Async, InlineRunsOnCaller) {
+  auto& caller = engine::current_task::GetCurrentTaskContext();
+
+  auto task = engine::InlineAsyncNoSpan(
+      [&](int x) {
+        EXPECT_TRUE(caller.IsCurrent());
+        return x * 2;
+      },
+      21);
+
+  EXPECT_TRUE(task.IsFinished());
+  EXPECT_EQ(task.Get(), 42);
+}
+
+UTEST(Async, InlineException) {
+  auto task = engine::InlineAsyncNoSpan(
+      [] { throw std::runtime_error("inline failure"); });
+
+  EXPECT_TRUE(task.IsFinished());
+  UEXPECT_THROW(task.Get(), std::runtime_error);
+}
+
+UTEST(Async, InlineFallbackOnCancel) {
+  auto& caller = engine::current_task::GetCurrentTaskContext();
+  engine::current_task::GetCancellationToken().RequestCancel();
+
+  auto task = engine::InlineAsyncNoSpan([&] { return caller.IsCurrent(); });
+
+  engine::TaskCancellationBlocker blocker;
+  EXPECT_FALSE(task.Get());
+}
+
+UTEST(Async, InlineDepthLimit) {
+  auto& caller = engine::current_task::GetCurrentTaskContext();
+
+  std::function<std::size_t(std::size_t)> recurse = [&](std::size_t depth) {
+    if (!caller.IsCurrent()) return depth;
+    return engine::InlineAsyncNoSpan(recurse, depth + 1).Get();
+  };
+
+  const auto depth = recurse(0);
+  EXPECT_GT(depth, 1);
+  EXPECT_LT(depth, 100);
+}
+
 USERVER_NAMESPACE_END
@@ -36,6 +36,7 @@ class ContextTimer::Impl final : public ev::MultiShotAsyncPayload<Impl> {
   void DoFinalize();
 
   static void OnTimer(struct ev_loop*, ev_timer* w, int) noexcept;
+  static void OnWheelTimer(ev::TimerWheel::Entry& entry) noexcept;
   void DoOnTimer();
 
   class Finalizer final : public ev::SingleShotAsyncPayload<Finalizer> {
@@ -56,11 +57,14 @@ class ContextTimer::Impl final : public ev::MultiShotAsyncPayload<Impl> {
   std::optional<ev::ThreadControl> thread_control_;
   Params params_;
   ev_timer timer_{};
+  // Used instead of `timer_` if the ev thread has a timer wheel
+  ev::TimerWheel::Entry wheel_entry_;
   ev::DataPipeToEv<Params> params_pipe_to_ev_;
   Finalizer finalizer_;
 };
 
-ContextTimer::Impl::Impl() : finalizer_(*this) {
+ContextTimer::Impl::Impl()
+    : wheel_entry_(&OnWheelTimer, this), finalizer_(*this) {
   timer_.data = this;
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
   ev_init(&timer_, OnTimer);
@@ -129,11 +133,20 @@ void ContextTimer::Impl::ArmTimerInEvThread() {
     return;
   }
 
+  if (thread_control_->HasTimerWheel()) {
+    thread_control_->Start(wheel_entry_, params_.deadline);
+    return;
+  }
+
   timer_.repeat = time_left;
   thread_control_->Again(timer_);
 }
 
 void ContextTimer::Impl::StopTimerInEvThread() noexcept {
+  if (thread_control_->HasTimerWheel()) {
+    thread_control_->Stop(wheel_entry_);
+    return;
+  }
   thread_control_->Stop(timer_);
 }
 
@@ -154,6 +167,12 @@ void ContextTimer::Impl::OnTimer(struct ev_loop*, ev_timer* w, int) noexcept {
   ev_timer->DoOnTimer();
 }
 
+void ContextTimer::Impl::OnWheelTimer(ev::TimerWheel::Entry& entry) noexcept {
+  auto* ev_timer = static_cast<Impl*>(entry.GetData());
+  UASSERT(ev_timer != nullptr);
+  ev_timer->DoOnTimer();
+}
+
 void ContextTimer::Impl::DoOnTimer() {
   try {
     // do not keep the function object around for much longer
@@ -10,7 +10,9 @@ namespace engine::impl {
 
 CountedCoroutinePtr::CountedCoroutinePtr(CoroPool::CoroutinePtr coro,
                                          TaskProcessor& task_processor)
-    : coro_(std::move(coro)), token_(task_processor.GetTaskCounter()) {}
+    : coro_(std::move(coro)),
+      token_(task_processor.GetTaskCounter()),
+      counter_(&task_processor.GetTaskCounter()) {}
 
 CountedCoroutinePtr::CoroPool::Coroutine& CountedCoroutinePtr::operator*() {
   UASSERT(coro_);
@@ -18,7 +20,11 @@ CountedCoroutinePtr::CoroPool::Coroutine& CountedCoroutinePtr::operator*() {
 }
 
 void CountedCoroutinePtr::ReturnToPool() && {
-  if (coro_) std::move(*coro_).ReturnToPool();
+  if (coro_) {
+    const auto stack_usage = coro_->TrySampleStackUsage();
+    if (stack_usage) counter_->AccountStackUsage(*stack_usage);
+    std::move(*coro_).ReturnToPool();
+  }
   token_ = std::nullopt;
 }
 
@@ -33,6 +33,7 @@ class CountedCoroutinePtr final {
  private:
   std::optional<CoroPool::CoroutinePtr> coro_;
   std::optional<TaskCounter::CoroToken> token_;
+  TaskCounter* counter_{nullptr};
 };
 
 }  // namespace engine::impl
@@ -18,6 +18,7 @@ engine::TaskInheritedVariable<std::string> kStringVariable2;
 engine::TaskInheritedVariable<std::string> kStringVariable3;
 
 engine::TaskInheritedVariable<std::unique_ptr<int>> kPtrVariable;
+engine::TaskInheritedVariable<std::shared_ptr<int>> kSharedPtrVariable;
 
 engine::TaskInheritedVariable<std::pair<std::string, int>> kPairVariable;
 
@@ -151,6 +152,48 @@ UTEST(TaskInheritedVariable, SameObjectIsInherited) {
   }).Get();
 }
 
+UTEST(TaskInheritedVariable, IndependenceOfSiblings) {
+  kStringVariable.Set("parent");
+  kStringVariable2.Set("parent2");
+
+  utils::Async("first", [] {
+    kStringVariable.Set("first");
+    kStringVariable2.Erase();
+    EXPECT_EQ(kStringVariable.Get(), "first");
+    EXPECT_FALSE(kStringVariable2.GetOptional());
+  }).Get();
+
+  utils::Async("second", [] {
+    EXPECT_EQ(kStringVariable.Get(), "parent");
+    EXPECT_EQ(kStringVariable2.Get(), "parent2");
+  }).Get();
+
+  EXPECT_EQ(kStringVariable.Get(), "parent");
+  EXPECT_EQ(kStringVariable2.Get(), "parent2");
+}
+
+UTEST(TaskInheritedVariable, ReleasedWithLastOwner) {
+  auto value = std::make_shared<int>(42);
+  const std::weak_ptr<int> weak_value = value;
+  kSharedPtrVariable.Set(std::move(value));
+
+  engine::SingleConsumerEvent child_started;
+  engine::SingleConsumerEvent parent_erased;
+  auto child = utils::Async("child", [&] {
+    child_started.Send();
+    ASSERT_TRUE(parent_erased.WaitForEvent());
+    EXPECT_EQ(*kSharedPtrVariable.Get(), 42);
+  });
+
+  ASSERT_TRUE(child_started.WaitForEvent());
+  kSharedPtrVariable.Erase();
+  EXPECT_FALSE(weak_value.expired());
+
+  parent_erased.Send();
+  child.Get();
+  EXPECT_TRUE(weak_value.expired());
+}
+
 UTEST_MT(TaskInheritedVariable, VariablesAfterParentTaskDeath, 4) {
   using Event = engine::SingleConsumerEvent;
   Event assigned_a{Event::NoAutoReset{}};
@@ -60,4 +60,13 @@ UTEST_MT(SingleThreadedTaskprocessor, ConstructionWithoutComponentSystem, 2) {
   }
 }
 
+UTEST(SingleThreadedTaskprocessor, InvalidAffinity) {
+  engine::TaskProcessorConfig config;
+  config.name = "test";
+  config.worker_threads = 2;
+  config.affinity.cpus = {100000};
+
+  UEXPECT_THROW(Pool{config}, std::runtime_error);
+}
+
 USERVER_NAMESPACE_END
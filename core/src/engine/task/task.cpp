@@ -28,6 +28,18 @@ Task::Task(engine::TaskProcessor& task_processor, Task::Importance importance,
                    impl::SleepState::Epoch{0});
 }
 
+Task::Task(engine::TaskProcessor& task_processor, Task::Importance importance,
+           Task::WaitMode wait_mode, engine::Deadline deadline,
+           impl::TaskPayload&& payload, impl::TryRunInlineTag)
+    : context_(utils::make_intrusive_ptr<impl::TaskContext>(
+          task_processor, importance, wait_mode, deadline,
+          std::move(payload))) {
+  if (!context_->TryRunInline()) {
+    context_->Wakeup(impl::TaskContext::WakeupSource::kBootstrap,
+                     impl::SleepState::Epoch{0});
+  }
+}
+
 Task::Task(Task&&) noexcept = default;
 
 Task& Task::operator=(Task&& rhs) noexcept {
@@ -196,6 +208,18 @@ size_t GetStackSize() {
       .GetStackSize();
 }
 
+TaskPriority GetPriority() noexcept {
+  return GetCurrentTaskContext().GetPriority();
+}
+
+void SetPriority(TaskPriority priority) noexcept {
+  GetCurrentTaskContext().SetPriority(priority);
+}
+
+TaskExecutionStatistics GetExecutionStatistics() noexcept {
+  return GetCurrentTaskContext().GetExecutionStatistics();
+}
+
 }  // namespace current_task
 }  // namespace engine
 
@@ -1,15 +1,24 @@
 #include <benchmark/benchmark.h>
 
+#include <array>
 #include <thread>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/inherited_variable.hpp>
 #include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/async.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
+namespace {
+
+std::array<engine::TaskInheritedVariable<int>, 16> kInheritedVariables;
+
+}  // namespace
+
 void engine_task_create(benchmark::State& state) {
   engine::RunStandalone([&] {
     for (auto _ : state) engine::AsyncNoSpan([]() {}).Detach();
@@ -17,6 +26,17 @@ void engine_task_create(benchmark::State& state) {
 }
 BENCHMARK(engine_task_create);
 
+void engine_task_create_inherited(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    for (int i = 0; i < state.range(0); ++i) kInheritedVariables[i].Set(i);
+    for (auto _ : state) utils::Async("", []() {}).Detach();
+  });
+}
+BENCHMARK(engine_task_create_inherited)
+    ->Arg(0)
+    ->RangeMultiplier(4)
+    ->Range(1, kInheritedVariables.size());
+
 void engine_task_yield(benchmark::State& state) {
   engine::RunStandalone([&] {
     std::vector<engine::TaskWithResult<void>> tasks;
@@ -89,6 +89,13 @@ class CurrentTaskScope final {
   EhGlobals& eh_store_;
 };
 
+constexpr std::uint8_t kMaxInlineDepth = 8;
+
+TaskPriority GetInheritedPriority() noexcept {
+  auto* const current = current_task::GetCurrentTaskContextUnchecked();
+  return current ? current->GetPriority() : TaskPriority::kNormal;
+}
+
 constexpr SleepState MakeNextEpochSleepState(SleepState::Epoch current) {
   using Epoch = SleepState::Epoch;
   return {SleepFlags::kNone, Epoch{utils::UnderlyingValue(current) + 1}};
@@ -106,6 +113,7 @@ TaskContext::TaskContext(TaskProcessor& task_processor,
       task_processor_(task_processor),
       task_counter_token_(task_processor_.GetTaskCounter()),
       is_critical_(importance == Task::Importance::kCritical),
+      priority_(GetInheritedPriority()),
       payload_(std::move(payload)),
       state_(Task::State::kNew),
       detached_token_(nullptr),
@@ -214,6 +222,30 @@ void TaskContext::WaitUntil(Deadline deadline) const {
   }
 }
 
+bool TaskContext::TryRunInline() {
+  UASSERT(state_ == Task::State::kNew);
+
+  auto* const current = current_task::GetCurrentTaskContextUnchecked();
+  if (!current || &current->task_processor_ != &task_processor_) return false;
+
+  // Cancellations of the task and of the caller are separate, the regular path
+  // deals with them
+  if (cancel_deadline_.IsReached() || current->ShouldCancel()) return false;
+
+  // Avoid stack overflows on recursive inline launches
+  if (current->inline_depth_ >= kMaxInlineDepth) return false;
+
+  ++current->inline_depth_;
+  const utils::FastScopeGuard depth_guard{
+      [current]() noexcept { --current->inline_depth_; }};
+
+  payload_->Perform();
+  SetState(Task::State::kCompleted);
+  TraceStateTransition(Task::State::kCompleted);
+  task_processor_.GetTaskCounter().AccountTaskInline();
+  return true;
+}
+
 void TaskContext::DoStep() {
   if (IsFinished()) return;
 
@@ -326,6 +358,7 @@ TaskContext::WakeupSource TaskContext::Sleep(WaitStrategy& wait_strategy) {
   UASSERT(task_pipe_);
   TraceStateTransition(Task::State::kSuspended);
   ProfilerStopExecution();
+  ++context_switches_;
   [[maybe_unused]] TaskContext* context = (*task_pipe_)().get();
   ProfilerStartExecution();
   TraceStateTransition(Task::State::kRunning);
@@ -649,26 +682,33 @@ void TaskContext::Schedule() {
   // NOTE: may be executed at this point
 }
 
+void TaskContext::SetPriority(TaskPriority priority) noexcept {
+  UASSERT(IsCurrent());
+  priority_ = priority;
+}
+
+TaskExecutionStatistics TaskContext::GetExecutionStatistics() const noexcept {
+  UASSERT(IsCurrent());
+  const auto running_for = std::chrono::steady_clock::now() - execute_started_;
+  return {
+      std::chrono::duration_cast<std::chrono::nanoseconds>(cpu_time_ +
+                                                           running_for),
+      context_switches_,
+  };
+}
+
 void TaskContext::ProfilerStartExecution() {
-  auto threshold_us = task_processor_.GetProfilerThreshold();
-  if (threshold_us.count() > 0) {
-    execute_started_ = std::chrono::steady_clock::now();
-  } else {
-    execute_started_ = {};
-  }
+  execute_started_ = std::chrono::steady_clock::now();
 }
 
 void TaskContext::ProfilerStopExecution() {
+  auto now = std::chrono::steady_clock::now();
+  auto duration = now - execute_started_;
+  cpu_time_ += duration;
+
   auto threshold_us = task_processor_.GetProfilerThreshold();
   if (threshold_us.count() <= 0) return;
 
-  if (execute_started_ == std::chrono::steady_clock::time_point{}) {
-    // the task was started w/o profiling, skip it
-    return;
-  }
-
-  auto now = std::chrono::steady_clock::now();
-  auto duration = now - execute_started_;
   auto duration_us =
       std::chrono::duration_cast<std::chrono::microseconds>(duration);
 
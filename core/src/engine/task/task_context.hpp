@@ -3,6 +3,7 @@
 #include <atomic>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <ev.h>
@@ -121,6 +122,11 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
   TaskProcessor& GetTaskProcessor() { return task_processor_; }
   void DoStep();
 
+  // Performs the payload of a new task on the calling coroutine and completes
+  // the task. Returns false if that is not possible, the task should be
+  // scheduled as usual then.
+  bool TryRunInline();
+
   // normally non-blocking, causes wakeup
   void RequestCancel(TaskCancellationReason);
 
@@ -162,6 +168,16 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
 
   TaskId GetTaskId() const { return reinterpret_cast<TaskId>(this); }
 
+  // is inherited from the task that created this one
+  TaskPriority GetPriority() const noexcept { return priority_; }
+
+  // takes effect from the next Schedule(), must only be called from this
+  // context
+  void SetPriority(TaskPriority priority) noexcept;
+
+  // on-CPU time and suspensions so far, must only be called from this context
+  TaskExecutionStatistics GetExecutionStatistics() const noexcept;
+
   std::chrono::steady_clock::time_point GetQueueWaitTimepoint() const {
     return task_queue_wait_timepoint_;
   }
@@ -172,6 +188,21 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
 
   void SetCancelDeadline(Deadline deadline);
 
+  // the name of the innermost span of this task for the SIGPROF handler of
+  // the CPU profiler, must only be set from this context
+  void SetProfilerSpanName(const std::string* name) noexcept {
+    // the handler runs on the same thread, only the compiler must not reorder
+    // the store with the construction or the destruction of the name
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    profiler_span_name_.store(name, std::memory_order_relaxed);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+  }
+
+  // async-signal-safe
+  const std::string* GetProfilerSpanName() const noexcept {
+    return profiler_span_name_.load(std::memory_order_relaxed);
+  }
+
   bool HasLocalStorage() const noexcept;
   task_local::Storage& GetLocalStorage() noexcept;
 
@@ -209,14 +240,18 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
   TaskProcessor& task_processor_;
   TaskCounter::Token task_counter_token_;
   const bool is_critical_;
+  TaskPriority priority_;
   bool is_cancellable_{true};
   bool within_sleep_{false};
+  // nesting of the tasks run inline by this task
+  std::uint8_t inline_depth_{0};
   EhGlobals eh_globals_;
   TaskPayload payload_;
 
   std::atomic<Task::State> state_;
   std::atomic<DetachedTasksSyncBlock::Token*> detached_token_;
   std::atomic<TaskCancellationReason> cancellation_reason_;
+  std::atomic<const std::string*> profiler_span_name_{nullptr};
   mutable FastPimplGenericWaitList finish_waiters_;
 
   ContextTimer deadline_timer_;
@@ -226,6 +261,8 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
   std::chrono::steady_clock::time_point task_queue_wait_timepoint_;
   std::chrono::steady_clock::time_point execute_started_;
   std::chrono::steady_clock::time_point last_state_change_timepoint_;
+  std::chrono::steady_clock::duration cpu_time_{};
+  std::uint64_t context_switches_{0};
 
   size_t trace_csw_left_;
 
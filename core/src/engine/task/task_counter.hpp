@@ -88,6 +88,8 @@ class TaskCounter final {
 
   size_t GetSpuriousWakeups() const { return spurious_wakeups_; }
 
+  size_t GetInlineTasks() const { return tasks_inline_; }
+
   void AccountTaskCancel() noexcept { tasks_cancelled_++; }
 
   void AccountTaskCancelOverload() noexcept { tasks_cancelled_overload_++; }
@@ -104,6 +106,17 @@ class TaskCounter final {
 
   void AccountSpuriousWakeup() { spurious_wakeups_++; }
 
+  void AccountTaskInline() noexcept { tasks_inline_++; }
+
+  void AccountStackUsage(size_t bytes) noexcept {
+    auto current = max_stack_usage_.load(std::memory_order_relaxed);
+    while (current < bytes && !max_stack_usage_.compare_exchange_weak(
+                                  current, bytes, std::memory_order_relaxed)) {
+    }
+  }
+
+  size_t GetMaxStackUsage() const { return max_stack_usage_; }
+
   void AccountTaskExecution(std::chrono::microseconds us) {
     task_processor_profiler_timings_.Add(us.count(), 1);
   }
@@ -120,12 +133,15 @@ class TaskCounter final {
   std::atomic<size_t> tasks_switch_fast_{0};
   std::atomic<size_t> tasks_switch_slow_{0};
   std::atomic<size_t> spurious_wakeups_{0};
+  std::atomic<size_t> tasks_inline_{0};
   std::atomic<size_t> tasks_cancelled_overload_{0};
   std::atomic<size_t> tasks_overload_{0};
 
   std::atomic<size_t> tasks_overload_sensor_{0};
   std::atomic<size_t> tasks_no_overload_sensor_{0};
 
+  std::atomic<size_t> max_stack_usage_{0};
+
   utils::statistics::AggregatedValues<25> task_processor_profiler_timings_;
 };
 
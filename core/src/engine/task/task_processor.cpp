@@ -10,6 +10,7 @@
 #include <userver/utils/rand.hpp>
 #include <userver/utils/thread_name.hpp>
 #include <utils/impl/static_registration.hpp>
+#include <utils/jemalloc.hpp>
 #include <utils/threads.hpp>
 
 #include <engine/task/task_context.hpp>
@@ -20,6 +21,9 @@ USERVER_NAMESPACE_BEGIN
 namespace engine {
 namespace {
 
+std::atomic<std::size_t> next_worker_index{0};
+thread_local std::size_t current_worker_index = impl::kInvalidWorkerIndex;
+
 void SetTaskQueueWaitTimepoint(impl::TaskContext* context) {
   static constexpr size_t kTaskTimestampInterval = 4;
   thread_local size_t task_count = 0;
@@ -35,6 +39,20 @@ void SetTaskQueueWaitTimepoint(impl::TaskContext* context) {
   }
 }
 
+std::variant<impl::TaskQueue, impl::WorkStealingTaskQueue> MakeTaskQueue(
+    const TaskProcessorConfig& config) {
+  using Variant = std::variant<impl::TaskQueue, impl::WorkStealingTaskQueue>;
+  switch (config.task_processor_queue) {
+    case TaskQueueType::kGlobalTaskQueue:
+      return Variant{std::in_place_type<impl::TaskQueue>};
+    case TaskQueueType::kWorkStealingTaskQueue:
+      return Variant{std::in_place_type<impl::WorkStealingTaskQueue>,
+                     config.worker_threads};
+  }
+
+  UINVARIANT(false, "Unexpected value of TaskQueueType");
+}
+
 // Hooks are modified only before task processors created and only in main
 // thread, so it doesnt' need any synchronization.
 std::vector<std::function<void()>>& ThreadStartedHooks() {
@@ -42,6 +60,34 @@ std::vector<std::function<void()>>& ThreadStartedHooks() {
   return thread_started_hooks;
 }
 
+std::optional<unsigned> CreateJemallocArena(const TaskProcessorConfig& config) {
+  const auto& jemalloc_config = config.jemalloc;
+  if (!jemalloc_config.dedicated_arena) return std::nullopt;
+
+  unsigned arena = 0;
+  if (const auto ec = utils::jemalloc::CreateArena(arena)) {
+    LOG_WARNING() << "Failed to create a jemalloc arena for task processor "
+                  << config.name << ": " << ec.message();
+    return std::nullopt;
+  }
+
+  if (jemalloc_config.dirty_decay) {
+    if (const auto ec = utils::jemalloc::SetArenaDirtyDecay(
+            arena, *jemalloc_config.dirty_decay)) {
+      LOG_WARNING() << "Failed to set jemalloc dirty decay for task processor "
+                    << config.name << ": " << ec.message();
+    }
+  }
+  if (jemalloc_config.muzzy_decay) {
+    if (const auto ec = utils::jemalloc::SetArenaMuzzyDecay(
+            arena, *jemalloc_config.muzzy_decay)) {
+      LOG_WARNING() << "Failed to set jemalloc muzzy decay for task processor "
+                    << config.name << ": " << ec.message();
+    }
+  }
+  return arena;
+}
+
 void EmitMagicNanosleep() {
   // If we're ptrace'd (e.g. by strace), the magic syscall tells a tracer
   // that all startup stuff of the current thread is done.
@@ -65,11 +111,13 @@ void TaskProcessorThreadStartedHook() {
 TaskProcessor::TaskProcessor(TaskProcessorConfig config,
                              std::shared_ptr<impl::TaskProcessorPools> pools)
     : config_(std::move(config)),
+      jemalloc_arena_(CreateJemallocArena(config_)),
       task_profiler_threshold_{std::chrono::microseconds(0)},
       profiler_force_stacktrace_{false},
       pools_(std::move(pools)),
       is_shutting_down_(false),
       detached_contexts_(impl::DetachedTasksSyncBlock::StopMode::kCancel),
+      task_queue_(MakeTaskQueue(config_)),
       max_task_queue_wait_time_(std::chrono::microseconds(0)),
       max_task_queue_wait_length_(0),
       task_trace_logger_{nullptr} {
@@ -77,7 +125,11 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config,
   try {
     LOG_INFO() << "creating task_processor " << Name() << " "
                << "worker_threads=" << config_.worker_threads
-               << " thread_name=" << config_.thread_name;
+               << " thread_name=" << config_.thread_name
+               << " task_processor_queue="
+               << ToString(config_.task_processor_queue);
+    // Reported here, as a failure in a worker thread would terminate
+    config_.affinity.Validate();
     workers_.reserve(config_.worker_threads);
     for (size_t i = 0; i < config_.worker_threads; ++i) {
       workers_.emplace_back([this, i] {
@@ -92,6 +144,25 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config,
             break;
         }
 
+        try {
+          config_.affinity.ApplyToCurrentThread();
+        } catch (const std::exception& ex) {
+          // The affinity is validated above, the CPU set might have changed
+          LOG_ERROR() << "Failed to set the affinity of a worker thread of "
+                      << Name() << ": " << ex;
+        }
+
+        // Not fatal: arena creation errors are logged above, and without
+        // jemalloc the calls are no-ops
+        if (jemalloc_arena_) {
+          [[maybe_unused]] const auto ec =
+              utils::jemalloc::SetThreadArena(*jemalloc_arena_);
+        }
+        if (!config_.jemalloc.tcache) {
+          [[maybe_unused]] const auto ec =
+              utils::jemalloc::SetThreadTcacheEnabled(false);
+        }
+
         utils::SetCurrentThreadName(
             fmt::format("{}_{}", config_.thread_name, i));
         ProcessTasks();
@@ -111,7 +182,7 @@ void TaskProcessor::Cleanup() noexcept {
   // Some tasks may be bound but not scheduled yet
   task_counter_.WaitForExhaustion(std::chrono::milliseconds(10));
 
-  task_queue_.enqueue(nullptr);
+  std::visit([](auto& queue) { queue.StopProcessing(); }, task_queue_);
 
   for (auto& w : workers_) {
     w.join();
@@ -146,7 +217,7 @@ void TaskProcessor::Schedule(impl::TaskContext* context) {
   // but oh well
   intrusive_ptr_add_ref(context);
 
-  task_queue_.enqueue(context);
+  std::visit([context](auto& queue) { queue.Push(context); }, task_queue_);
   // NOTE: task may be executed at this point
 }
 
@@ -158,6 +229,12 @@ ev::ThreadPool& TaskProcessor::EventThreadPool() {
   return pools_->EventThreadPool();
 }
 
+size_t TaskProcessor::GetTaskQueueSize() const {
+  return std::visit(
+      [](const auto& queue) { return queue.GetSizeApproximate(); },
+      task_queue_);
+}
+
 impl::CountedCoroutinePtr TaskProcessor::GetCoroutine() {
   return {pools_->GetCoroPool().GetCoroutine(), *this};
 }
@@ -228,23 +305,17 @@ logging::LoggerPtr TaskProcessor::GetTaskTraceLogger() const {
 }
 
 impl::TaskContext* TaskProcessor::DequeueTask() {
-  impl::TaskContext* buf = nullptr;
-
-  /* Current thread handles only a single TaskProcessor, so it's safe to store
-   * a token for the task processor in a thread-local variable.
-   */
-  thread_local moodycamel::ConsumerToken token(task_queue_);
-
-  task_queue_.wait_dequeue(token, buf);
+  auto* const context =
+      std::visit([](auto& queue) { return queue.PopBlocking(); }, task_queue_);
   GetTaskCounter().AccountTaskSwitchSlow();
+  return context;
+}
 
-  if (!buf) {
-    // return "stop" token back
-    task_queue_.enqueue(nullptr);
-  }
+namespace impl {
 
-  return buf;
-}
+std::size_t GetCurrentWorkerIndex() noexcept { return current_worker_index; }
+
+}  // namespace impl
 
 void RegisterThreadStartedHook(std::function<void()> func) {
   utils::impl::AssertStaticRegistrationAllowed(
@@ -253,6 +324,7 @@ void RegisterThreadStartedHook(std::function<void()> func) {
 }
 
 void TaskProcessor::ProcessTasks() noexcept {
+  current_worker_index = next_worker_index.fetch_add(1);
   TaskProcessorThreadStartedHook();
 
   while (true) {
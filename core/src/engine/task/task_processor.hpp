@@ -5,16 +5,19 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <thread>
 #include <unordered_set>
+#include <variant>
 #include <vector>
 
-#include <moodycamel/blockingconcurrentqueue.h>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
 #include <engine/task/counted_coroutine_ptr.hpp>
 #include <engine/task/task_counter.hpp>
 #include <engine/task/task_processor_config.hpp>
+#include <engine/task/task_queue.hpp>
+#include <engine/task/work_stealing_task_queue.hpp>
 #include <userver/engine/impl/detached_tasks_sync_block.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -55,10 +58,13 @@ class TaskProcessor final {
 
   const impl::TaskCounter& GetTaskCounter() const { return task_counter_; }
 
-  size_t GetTaskQueueSize() const { return task_queue_.size_approx(); }
+  size_t GetTaskQueueSize() const;
 
   size_t GetWorkerCount() const { return workers_.size(); }
 
+  /// The dedicated jemalloc arena of the worker threads, if any
+  std::optional<unsigned> GetJemallocArena() const { return jemalloc_arena_; }
+
   void SetSettings(const TaskProcessorSettings& settings);
 
   std::chrono::microseconds GetProfilerThreshold() const;
@@ -85,6 +91,7 @@ class TaskProcessor final {
   void HandleOverload(impl::TaskContext& context);
 
   const TaskProcessorConfig config_;
+  const std::optional<unsigned> jemalloc_arena_;
   std::atomic<std::chrono::microseconds> task_profiler_threshold_;
   std::atomic<bool> profiler_force_stacktrace_{false};
 
@@ -93,7 +100,7 @@ class TaskProcessor final {
   std::atomic<bool> is_shutting_down_;
   impl::DetachedTasksSyncBlock detached_contexts_;
 
-  moodycamel::BlockingConcurrentQueue<impl::TaskContext*> task_queue_;
+  std::variant<impl::TaskQueue, impl::WorkStealingTaskQueue> task_queue_;
 
   std::atomic<std::chrono::microseconds> sensor_task_queue_wait_time_{};
   std::atomic<std::chrono::microseconds> max_task_queue_wait_time_{};
@@ -115,6 +122,17 @@ class TaskProcessor final {
 /// @note It is a low-level function. You might not want to use it.
 void RegisterThreadStartedHook(std::function<void()>);
 
+namespace impl {
+
+inline constexpr std::size_t kInvalidWorkerIndex = -1;
+
+/// Returns the index of the current task processor worker thread, the indices
+/// are dense and unique across all the task processors. Returns
+/// kInvalidWorkerIndex outside of the worker threads.
+std::size_t GetCurrentWorkerIndex() noexcept;
+
+}  // namespace impl
+
 }  // namespace engine
 
 USERVER_NAMESPACE_END
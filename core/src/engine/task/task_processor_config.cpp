@@ -1,6 +1,7 @@
 #include <engine/task/task_processor_config.hpp>
 
 #include <cstdint>
+#include <stdexcept>
 
 #include <fmt/format.h>
 
@@ -28,6 +29,49 @@ OsScheduling Parse(const yaml_config::YamlConfig& value,
       "Invalid OsScheduling value '{}' at path '{}'", str, value.GetPath()));
 }
 
+TaskQueueType Parse(const yaml_config::YamlConfig& value,
+                    formats::parse::To<TaskQueueType>) {
+  const auto str = value.As<std::string>();
+  if (str == "global-task-queue") {
+    return TaskQueueType::kGlobalTaskQueue;
+  } else if (str == "work-stealing-task-queue") {
+    return TaskQueueType::kWorkStealingTaskQueue;
+  }
+
+  throw std::logic_error(fmt::format(
+      "Invalid TaskQueueType value '{}' at path '{}'", str, value.GetPath()));
+}
+
+std::string_view ToString(TaskQueueType type) {
+  switch (type) {
+    case TaskQueueType::kGlobalTaskQueue:
+      return "global-task-queue";
+    case TaskQueueType::kWorkStealingTaskQueue:
+      return "work-stealing-task-queue";
+  }
+
+  UINVARIANT(false, "Unexpected value of TaskQueueType");
+}
+
+JemallocConfig Parse(const yaml_config::YamlConfig& value,
+                     formats::parse::To<JemallocConfig>) {
+  JemallocConfig config;
+  config.dedicated_arena =
+      value["dedicated-arena"].As<bool>(config.dedicated_arena);
+  config.tcache = value["tcache"].As<bool>(config.tcache);
+  config.dirty_decay =
+      value["dirty-decay"].As<std::optional<std::chrono::milliseconds>>();
+  config.muzzy_decay =
+      value["muzzy-decay"].As<std::optional<std::chrono::milliseconds>>();
+
+  if ((config.dirty_decay || config.muzzy_decay) && !config.dedicated_arena) {
+    throw std::runtime_error(
+        "jemalloc decay may be set only for a dedicated arena at " +
+        value.GetPath());
+  }
+  return config;
+}
+
 TaskProcessorConfig Parse(const yaml_config::YamlConfig& value,
                           formats::parse::To<TaskProcessorConfig>) {
   TaskProcessorConfig config;
@@ -37,6 +81,12 @@ TaskProcessorConfig Parse(const yaml_config::YamlConfig& value,
   config.thread_name = value["thread_name"].As<std::string>();
   config.os_scheduling =
       value["os-scheduling"].As<OsScheduling>(config.os_scheduling);
+  config.task_processor_queue =
+      value["task-processor-queue"].As<TaskQueueType>(
+          config.task_processor_queue);
+  config.affinity =
+      value["affinity"].As<ThreadAffinityConfig>(config.affinity);
+  config.jemalloc = value["jemalloc"].As<JemallocConfig>(config.jemalloc);
 
   const auto task_trace = value["task-trace"];
   if (!task_trace.IsMissing()) {
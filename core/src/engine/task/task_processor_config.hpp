@@ -2,8 +2,11 @@
 
 #include <chrono>
 #include <cstddef>
+#include <optional>
 #include <string>
+#include <string_view>
 
+#include <engine/thread_affinity_config.hpp>
 #include <userver/formats/json_fwd.hpp>
 #include <userver/yaml_config/fwd.hpp>
 
@@ -20,6 +23,29 @@ enum class OsScheduling {
 OsScheduling Parse(const yaml_config::YamlConfig& value,
                    formats::parse::To<OsScheduling>);
 
+enum class TaskQueueType {
+  kGlobalTaskQueue,
+  kWorkStealingTaskQueue,
+};
+
+TaskQueueType Parse(const yaml_config::YamlConfig& value,
+                    formats::parse::To<TaskQueueType>);
+
+std::string_view ToString(TaskQueueType type);
+
+/// jemalloc settings of the worker threads
+struct JemallocConfig {
+  /// Allocate from an arena that is not shared with other threads
+  bool dedicated_arena{false};
+  bool tcache{true};
+  /// Decay times of the dedicated arena, jemalloc defaults if not set
+  std::optional<std::chrono::milliseconds> dirty_decay;
+  std::optional<std::chrono::milliseconds> muzzy_decay;
+};
+
+JemallocConfig Parse(const yaml_config::YamlConfig& value,
+                     formats::parse::To<JemallocConfig>);
+
 struct TaskProcessorConfig {
   std::string name;
 
@@ -27,6 +53,9 @@ struct TaskProcessorConfig {
   std::size_t worker_threads{6};
   std::string thread_name;
   OsScheduling os_scheduling{OsScheduling::kNormal};
+  TaskQueueType task_processor_queue{TaskQueueType::kGlobalTaskQueue};
+  ThreadAffinityConfig affinity;
+  JemallocConfig jemalloc;
 
   std::size_t task_trace_every{1000};
   std::size_t task_trace_max_csw{0};
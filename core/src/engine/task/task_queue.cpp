@@ -0,0 +1,89 @@
+#include <engine/task/task_queue.hpp>
+
+#include <engine/task/task_context.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/underlying_value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+namespace {
+
+// Round-robin slots of kLatencyCritical, kNormal and kBackground: 8, 4 and 1
+constexpr std::size_t kRoundRobinSlots = 13;
+
+constexpr std::size_t GetPreferredIndex(std::size_t slot) noexcept {
+  if (slot < 8) return 0;
+  if (slot < 12) return 1;
+  return 2;
+}
+
+}  // namespace
+
+void TaskQueue::Push(TaskContext* context) {
+  UASSERT(context);
+  const auto index =
+      static_cast<std::size_t>(utils::UnderlyingValue(context->GetPriority()));
+  UASSERT(index < kPrioritiesCount);
+  DoPush(index, context);
+}
+
+TaskContext* TaskQueue::PopBlocking() {
+  struct Consumer final {
+    explicit Consumer(std::array<Queue, kPrioritiesCount>& queues)
+        : tokens{moodycamel::ConsumerToken(queues[0]),
+                 moodycamel::ConsumerToken(queues[1]),
+                 moodycamel::ConsumerToken(queues[2])} {}
+
+    std::array<moodycamel::ConsumerToken, kPrioritiesCount> tokens;
+    std::size_t slot{0};
+  };
+
+  /* Current thread handles only a single TaskProcessor, so it's safe to store
+   * tokens for the task processor in a thread-local variable.
+   */
+  thread_local Consumer consumer(queues_);
+
+  tasks_available_.wait();
+
+  const auto preferred = GetPreferredIndex(consumer.slot);
+  consumer.slot = (consumer.slot + 1) % kRoundRobinSlots;
+
+  TaskContext* buf = nullptr;
+  // The semaphore has reserved an item for us, it becomes visible soon
+  while (true) {
+    if (queues_[preferred].try_dequeue(consumer.tokens[preferred], buf)) break;
+
+    bool found = false;
+    for (std::size_t i = 0; i < kPrioritiesCount && !found; ++i) {
+      if (i == preferred) continue;
+      found = queues_[i].try_dequeue(consumer.tokens[i], buf);
+    }
+    if (found) break;
+  }
+
+  if (!buf) {
+    // return "stop" token back
+    DoPush(0, nullptr);
+  }
+
+  return buf;
+}
+
+void TaskQueue::StopProcessing() { DoPush(0, nullptr); }
+
+std::size_t TaskQueue::GetSizeApproximate() const noexcept {
+  std::size_t size = 0;
+  for (const auto& queue : queues_) size += queue.size_approx();
+  return size;
+}
+
+void TaskQueue::DoPush(std::size_t priority_index, TaskContext* context) {
+  queues_[priority_index].enqueue(context);
+  tasks_available_.signal();
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
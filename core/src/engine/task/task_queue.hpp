@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <moodycamel/concurrentqueue.h>
+#include <moodycamel/lightweightsemaphore.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+class TaskContext;
+
+/// @brief MPMC queues shared by all the workers of a TaskProcessor, one per
+/// TaskPriority.
+///
+/// Workers pick the classes in a weighted round-robin: a worker prefers the
+/// class of its current round-robin slot and falls back to the other classes
+/// in the priority order, so no class is starved and no worker idles while
+/// there is work of any class.
+class TaskQueue final {
+ public:
+  TaskQueue() = default;
+
+  TaskQueue(const TaskQueue&) = delete;
+  TaskQueue& operator=(const TaskQueue&) = delete;
+
+  void Push(TaskContext* context);
+
+  /// Blocks until a task is available, returns nullptr on shutdown
+  TaskContext* PopBlocking();
+
+  void StopProcessing();
+
+  std::size_t GetSizeApproximate() const noexcept;
+
+ private:
+  static constexpr std::size_t kPrioritiesCount = 3;
+
+  using Queue = moodycamel::ConcurrentQueue<TaskContext*>;
+
+  void DoPush(std::size_t priority_index, TaskContext* context);
+
+  moodycamel::LightweightSemaphore tasks_available_;
+  std::array<Queue, kPrioritiesCount> queues_;
+};
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
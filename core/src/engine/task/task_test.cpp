@@ -3,6 +3,7 @@
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <vector>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/condition_variable.hpp>
@@ -189,6 +190,64 @@ UTEST(Task, GetStackSize) {
   EXPECT_GE(engine::current_task::GetStackSize(), kMinimalStackSize);
 }
 
+UTEST(Task, ExecutionStatistics) {
+  const auto before = engine::current_task::GetExecutionStatistics();
+
+  const auto busy_until = std::chrono::steady_clock::now() + 5ms;
+  while (std::chrono::steady_clock::now() < busy_until) {
+  }
+  engine::SleepFor(100ms);
+
+  const auto after = engine::current_task::GetExecutionStatistics();
+  EXPECT_EQ(after.context_switches - before.context_switches, 1);
+  EXPECT_GE(after.cpu_time - before.cpu_time, 5ms);
+  // The time spent sleeping is not accounted
+  EXPECT_LT(after.cpu_time - before.cpu_time, 100ms);
+}
+
+UTEST(Task, PriorityInheritance) {
+  EXPECT_EQ(engine::current_task::GetPriority(), engine::TaskPriority::kNormal);
+
+  engine::current_task::SetPriority(engine::TaskPriority::kBackground);
+  auto child = engine::AsyncNoSpan([] {
+    const auto inherited = engine::current_task::GetPriority();
+    engine::current_task::SetPriority(engine::TaskPriority::kLatencyCritical);
+    engine::Yield();
+    return inherited;
+  });
+  EXPECT_EQ(child.Get(), engine::TaskPriority::kBackground);
+
+  engine::current_task::SetPriority(engine::TaskPriority::kNormal);
+  engine::Yield();
+  EXPECT_EQ(engine::current_task::GetPriority(), engine::TaskPriority::kNormal);
+}
+
+UTEST_MT(Task, PrioritiesAreNotStarved, 2) {
+  std::atomic<bool> stop{false};
+  std::atomic<std::size_t> iterations[3]{};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (const auto priority :
+       {engine::TaskPriority::kLatencyCritical, engine::TaskPriority::kNormal,
+        engine::TaskPriority::kBackground}) {
+    for (int i = 0; i < 4; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&, priority] {
+        engine::current_task::SetPriority(priority);
+        while (!stop) {
+          ++iterations[static_cast<std::size_t>(priority)];
+          engine::Yield();
+        }
+      }));
+    }
+  }
+
+  engine::SleepFor(50ms);
+  stop = true;
+  for (auto& task : tasks) task.Get();
+
+  for (const auto& count : iterations) EXPECT_GT(count.load(), 0);
+}
+
 UTEST_MT(Task, MultiWait, 4) {
   constexpr size_t kWaitingTasksCount = 4;
   const auto test_deadline =
@@ -0,0 +1,199 @@
+#include <engine/task/work_stealing_task_queue.hpp>
+
+#include <thread>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+namespace {
+
+// Check the global queue first once in a while, otherwise tasks scheduled
+// from outside of the workers could starve while workers feed each other.
+constexpr std::size_t kGlobalQueueCheckInterval = 61;
+
+// Limits the number of tasks taken from the LIFO slot in a row, so that a pair
+// of tasks that wake each other can't starve the worker-local queue.
+constexpr std::size_t kMaxLifoPopsInRow = 3;
+
+constexpr std::size_t kMaxStealBatchSize = 16;
+
+// Current thread handles only a single TaskProcessor, so it's safe to store
+// the worker state in thread-local variables.
+thread_local const void* current_queue = nullptr;
+thread_local void* current_consumer = nullptr;
+
+// A fake context that signals shutdown, it is never dereferenced
+TaskContext* StopToken() noexcept {
+  static char token;
+  return reinterpret_cast<TaskContext*>(&token);
+}
+
+}  // namespace
+
+WorkStealingTaskQueue::Consumer::Consumer(Queue& global_queue)
+    : local_producer_token(local_queue),
+      local_consumer_token(local_queue),
+      global_consumer_token(global_queue) {}
+
+WorkStealingTaskQueue::WorkStealingTaskQueue(std::size_t consumers_count)
+    : consumers_(consumers_count, global_queue_) {
+  UINVARIANT(consumers_count > 0, "Need at least one consumer");
+  for (std::size_t i = 0; i < consumers_.size(); ++i) {
+    consumers_[i]->index = i;
+    consumers_[i]->steal_cursor = i + 1;
+  }
+}
+
+void WorkStealingTaskQueue::Push(TaskContext* context) {
+  UASSERT(context);
+  auto* const consumer = GetCurrentConsumer();
+  if (consumer) {
+    auto* const evicted =
+        consumer->lifo_slot.exchange(context, std::memory_order_acq_rel);
+    if (evicted) {
+      consumer->local_queue.enqueue(consumer->local_producer_token, evicted);
+    }
+  } else {
+    global_queue_.enqueue(context);
+  }
+  tasks_available_.signal();
+}
+
+TaskContext* WorkStealingTaskQueue::PopBlocking() {
+  auto& consumer = GetOrRegisterCurrentConsumer();
+
+  tasks_available_.wait();
+
+  // The semaphore guarantees that there is an unclaimed task somewhere. It
+  // may be in flight between queues, so keep looking until we catch it.
+  TaskContext* context = TryPop(consumer);
+  while (!context) {
+    std::this_thread::yield();
+    context = TryPop(consumer);
+  }
+
+  if (context == StopToken()) {
+    // return "stop" token back
+    StopProcessing();
+    return nullptr;
+  }
+
+  ++consumer.pops_count;
+  return context;
+}
+
+void WorkStealingTaskQueue::StopProcessing() {
+  global_queue_.enqueue(StopToken());
+  tasks_available_.signal();
+}
+
+std::size_t WorkStealingTaskQueue::GetSizeApproximate() const noexcept {
+  return tasks_available_.availableApprox();
+}
+
+WorkStealingTaskQueue::Consumer*
+WorkStealingTaskQueue::GetCurrentConsumer() noexcept {
+  if (current_queue != this) return nullptr;
+  return static_cast<Consumer*>(current_consumer);
+}
+
+WorkStealingTaskQueue::Consumer&
+WorkStealingTaskQueue::GetOrRegisterCurrentConsumer() {
+  if (auto* consumer = GetCurrentConsumer()) return *consumer;
+
+  const auto index = registered_consumers_.fetch_add(1);
+  UINVARIANT(index < consumers_.size(),
+             "Too many threads consume from WorkStealingTaskQueue");
+  auto& consumer = *consumers_[index];
+  current_queue = this;
+  current_consumer = &consumer;
+  return consumer;
+}
+
+TaskContext* WorkStealingTaskQueue::TryPop(Consumer& consumer) {
+  TaskContext* context = nullptr;
+
+  if (consumer.pops_count % kGlobalQueueCheckInterval == 0) {
+    context = TryPopGlobal(consumer);
+    if (context) return context;
+  }
+
+  if (consumer.lifo_pops_in_row < kMaxLifoPopsInRow) {
+    context = TryPopLifo(consumer);
+    if (context) {
+      ++consumer.lifo_pops_in_row;
+      return context;
+    }
+  }
+  consumer.lifo_pops_in_row = 0;
+
+  context = TryPopLocal(consumer);
+  if (context) return context;
+
+  context = TryPopLifo(consumer);
+  if (context) return context;
+
+  context = TryPopGlobal(consumer);
+  if (context) return context;
+
+  return TrySteal(consumer);
+}
+
+TaskContext* WorkStealingTaskQueue::TryPopLifo(Consumer& consumer) {
+  // Cheap check to avoid dirtying the cacheline when the slot is empty
+  if (!consumer.lifo_slot.load(std::memory_order_relaxed)) return nullptr;
+  return consumer.lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+TaskContext* WorkStealingTaskQueue::TryPopLocal(Consumer& consumer) {
+  TaskContext* context = nullptr;
+  consumer.local_queue.try_dequeue(consumer.local_consumer_token, context);
+  return context;
+}
+
+TaskContext* WorkStealingTaskQueue::TryPopGlobal(Consumer& consumer) {
+  TaskContext* context = nullptr;
+  global_queue_.try_dequeue(consumer.global_consumer_token, context);
+  return context;
+}
+
+TaskContext* WorkStealingTaskQueue::TrySteal(Consumer& consumer) {
+  const auto consumers_count = consumers_.size();
+
+  // Take a batch from some worker-local queue, the rest of the batch is moved
+  // into our local queue to balance the load.
+  for (std::size_t i = 0; i < consumers_count; ++i) {
+    auto& victim = *consumers_[(consumer.steal_cursor + i) % consumers_count];
+    if (&victim == &consumer) continue;
+
+    TaskContext* stolen[kMaxStealBatchSize];
+    const auto count =
+        victim.local_queue.try_dequeue_bulk(stolen, kMaxStealBatchSize);
+    if (count == 0) continue;
+
+    consumer.steal_cursor = victim.index;
+    if (count > 1) {
+      consumer.local_queue.enqueue_bulk(consumer.local_producer_token,
+                                        stolen + 1, count - 1);
+    }
+    return stolen[0];
+  }
+
+  // LIFO slots are the last resort, they are hot in cache of their owners
+  for (std::size_t i = 0; i < consumers_count; ++i) {
+    auto& victim = *consumers_[(consumer.steal_cursor + i) % consumers_count];
+    if (&victim == &consumer) continue;
+
+    auto* const context = TryPopLifo(victim);
+    if (context) return context;
+  }
+
+  return nullptr;
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include <moodycamel/concurrentqueue.h>
+#include <moodycamel/lightweightsemaphore.h>
+
+#include <userver/concurrent/impl/interference_shield.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+class TaskContext;
+
+/// @brief A task queue with a local queue and a LIFO slot per worker.
+///
+/// Tasks scheduled from a worker thread go to the LIFO slot of that worker,
+/// evicting the previous occupant into the worker-local queue. Tasks scheduled
+/// from other threads go to the shared global queue. A worker that runs out of
+/// local tasks checks the global queue and then steals from other workers.
+///
+/// A single semaphore counts unclaimed tasks, so a worker never sleeps while
+/// there is work to do anywhere in the queue.
+///
+/// TaskPriority is not taken into account.
+class WorkStealingTaskQueue final {
+ public:
+  explicit WorkStealingTaskQueue(std::size_t consumers_count);
+
+  WorkStealingTaskQueue(const WorkStealingTaskQueue&) = delete;
+  WorkStealingTaskQueue& operator=(const WorkStealingTaskQueue&) = delete;
+
+  void Push(TaskContext* context);
+
+  /// Blocks until a task is available, returns nullptr on shutdown.
+  /// Must be called by at most `consumers_count` distinct threads.
+  TaskContext* PopBlocking();
+
+  void StopProcessing();
+
+  std::size_t GetSizeApproximate() const noexcept;
+
+ private:
+  using Queue = moodycamel::ConcurrentQueue<TaskContext*>;
+
+  struct Consumer final {
+    explicit Consumer(Queue& global_queue);
+
+    std::atomic<TaskContext*> lifo_slot{nullptr};
+    Queue local_queue;
+    moodycamel::ProducerToken local_producer_token;
+    moodycamel::ConsumerToken local_consumer_token;
+    moodycamel::ConsumerToken global_consumer_token;
+
+    // Accessed only by the owning thread
+    std::size_t index{0};
+    std::size_t pops_count{0};
+    std::size_t lifo_pops_in_row{0};
+    std::size_t steal_cursor{0};
+  };
+
+  Consumer* GetCurrentConsumer() noexcept;
+  Consumer& GetOrRegisterCurrentConsumer();
+
+  TaskContext* TryPop(Consumer& consumer);
+  TaskContext* TryPopLifo(Consumer& consumer);
+  TaskContext* TryPopLocal(Consumer& consumer);
+  TaskContext* TryPopGlobal(Consumer& consumer);
+  TaskContext* TrySteal(Consumer& consumer);
+
+  moodycamel::LightweightSemaphore tasks_available_;
+  Queue global_queue_;
+  utils::FixedArray<concurrent::impl::InterferenceShield<Consumer>> consumers_;
+  std::atomic<std::size_t> registered_consumers_{0};
+};
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,106 @@
+#include <engine/task/work_stealing_task_queue.hpp>
+
+#include <atomic>
+#include <vector>
+
+#include <engine/task/task_processor.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kWorkerThreads = 4;
+
+class WorkStealingTaskProcessor final {
+ public:
+  WorkStealingTaskProcessor()
+      : task_processor_(MakeConfig(), engine::current_task::GetTaskProcessor()
+                                          .GetTaskProcessorPools()) {}
+
+  engine::TaskProcessor& operator*() { return task_processor_; }
+
+ private:
+  static engine::TaskProcessorConfig MakeConfig() {
+    engine::TaskProcessorConfig config;
+    config.name = "work-stealing";
+    config.thread_name = "ws-worker";
+    config.worker_threads = kWorkerThreads;
+    config.task_processor_queue = engine::TaskQueueType::kWorkStealingTaskQueue;
+    return config;
+  }
+
+  engine::TaskProcessor task_processor_;
+};
+
+}  // namespace
+
+UTEST(WorkStealingTaskQueue, ManyTasks) {
+  WorkStealingTaskProcessor task_processor;
+
+  constexpr std::size_t kTasksCount = 1000;
+  std::atomic<std::size_t> counter{0};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(kTasksCount);
+  for (std::size_t i = 0; i < kTasksCount; ++i) {
+    tasks.push_back(engine::AsyncNoSpan(*task_processor, [&counter] {
+      engine::Yield();
+      ++counter;
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_EQ(counter.load(), kTasksCount);
+  EXPECT_EQ((*task_processor).GetTaskQueueSize(), 0);
+}
+
+UTEST(WorkStealingTaskQueue, PingPong) {
+  WorkStealingTaskProcessor task_processor;
+
+  constexpr std::size_t kIterations = 10000;
+  engine::SingleConsumerEvent ping;
+  engine::SingleConsumerEvent pong;
+
+  auto pinger = engine::AsyncNoSpan(*task_processor, [&] {
+    for (std::size_t i = 0; i < kIterations; ++i) {
+      ping.Send();
+      ASSERT_TRUE(pong.WaitForEvent());
+    }
+  });
+  auto ponger = engine::AsyncNoSpan(*task_processor, [&] {
+    for (std::size_t i = 0; i < kIterations; ++i) {
+      ASSERT_TRUE(ping.WaitForEvent());
+      pong.Send();
+    }
+  });
+
+  UEXPECT_NO_THROW(pinger.Get());
+  UEXPECT_NO_THROW(ponger.Get());
+}
+
+UTEST(WorkStealingTaskQueue, BusyWorkersDoNotStarveOthers) {
+  WorkStealingTaskProcessor task_processor;
+
+  std::atomic<bool> stop{false};
+  std::vector<engine::TaskWithResult<void>> yielders;
+  for (std::size_t i = 0; i < kWorkerThreads * 2; ++i) {
+    yielders.push_back(engine::AsyncNoSpan(*task_processor, [&stop] {
+      while (!stop) engine::Yield();
+    }));
+  }
+
+  auto task = engine::AsyncNoSpan(*task_processor, [] { return 42; });
+  EXPECT_EQ(task.Get(), 42);
+
+  stop = true;
+  for (auto& yielder : yielders) yielder.Get();
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,129 @@
+#include <userver/engine/task_group.hpp>
+
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace impl {
+
+class TaskGroupState final {
+ public:
+  explicit TaskGroupState(TaskGroup::ErrorPolicy policy) : policy_(policy) {}
+
+  void Reserve(std::size_t count) {
+    const std::lock_guard lock(mutex_);
+    children_.reserve(count);
+  }
+
+  void Register(Task& task) {
+    TaskCancellationToken token(task);
+    {
+      const std::lock_guard lock(mutex_);
+      children_.push_back(token);
+    }
+    started_.fetch_add(1, std::memory_order_relaxed);
+    if (cancelled_.load()) token.RequestCancel();
+  }
+
+  void OnChildFinished(bool failed) noexcept {
+    if (failed) {
+      failed_.fetch_add(1);
+      if (policy_ == TaskGroup::ErrorPolicy::kCancelOnFirstError) CancelAll();
+    }
+
+    // Pairs with the waiter that stores the target before checking `finished_`
+    const auto finished = finished_.fetch_add(1) + 1;
+    if (finished >= wait_target_.load()) finished_event_.Send();
+  }
+
+  bool WaitForCount(std::size_t count, Deadline deadline) {
+    wait_target_.store(count);
+    while (finished_.load() < count) {
+      if (!finished_event_.WaitForEventUntil(deadline)) {
+        return finished_.load() >= count;
+      }
+    }
+    return true;
+  }
+
+  void CancelAll() noexcept {
+    if (cancelled_.exchange(true)) return;
+
+    const std::lock_guard lock(mutex_);
+    for (auto& child : children_) child.RequestCancel();
+  }
+
+  std::size_t GetStarted() const noexcept {
+    return started_.load(std::memory_order_relaxed);
+  }
+
+  std::size_t GetFinished() const noexcept { return finished_.load(); }
+
+  std::size_t GetFailed() const noexcept { return failed_.load(); }
+
+ private:
+  const TaskGroup::ErrorPolicy policy_;
+
+  std::atomic<std::size_t> started_{0};
+  std::atomic<std::size_t> finished_{0};
+  std::atomic<std::size_t> failed_{0};
+  // Children do not wake up the owner until it waits
+  std::atomic<std::size_t> wait_target_{
+      std::numeric_limits<std::size_t>::max()};
+  std::atomic<bool> cancelled_{false};
+  SingleConsumerEvent finished_event_;
+
+  // Children of a failed group are cancelled from the failed child's task
+  std::mutex mutex_;
+  std::vector<TaskCancellationToken> children_;
+};
+
+void OnTaskGroupChildFinished(TaskGroupState& state, bool failed) noexcept {
+  state.OnChildFinished(failed);
+}
+
+}  // namespace impl
+
+TaskGroup::TaskGroup(ErrorPolicy policy)
+    : state_(std::make_shared<impl::TaskGroupState>(policy)) {}
+
+TaskGroup::~TaskGroup() = default;
+
+void TaskGroup::Reserve(std::size_t count) { state_->Reserve(count); }
+
+std::size_t TaskGroup::GetSize() const noexcept { return state_->GetStarted(); }
+
+std::size_t TaskGroup::GetFinishedCount() const noexcept {
+  return state_->GetFinished();
+}
+
+std::size_t TaskGroup::GetFailedCount() const noexcept {
+  return state_->GetFailed();
+}
+
+bool TaskGroup::WaitForCount(std::size_t count, Deadline deadline) {
+  UASSERT_MSG(count <= GetSize(),
+              "Waiting for more children than the group has");
+  return state_->WaitForCount(count, deadline);
+}
+
+bool TaskGroup::WaitAll(Deadline deadline) {
+  return state_->WaitForCount(GetSize(), deadline);
+}
+
+void TaskGroup::CancelAll() { state_->CancelAll(); }
+
+void TaskGroup::Register(Task& task) { state_->Register(task); }
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
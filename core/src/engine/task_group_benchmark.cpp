@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task_group.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+void task_group_fan_out_wait_all_checked(benchmark::State& state) {
+  engine::RunStandalone(4, [&] {
+    const auto fan_out = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+      std::vector<engine::TaskWithResult<void>> tasks;
+      tasks.reserve(fan_out);
+      for (std::size_t i = 0; i < fan_out; ++i) {
+        tasks.push_back(engine::AsyncNoSpan([] {}));
+      }
+      engine::WaitAllChecked(tasks);
+    }
+  });
+}
+BENCHMARK(task_group_fan_out_wait_all_checked)->Arg(20)->Arg(100);
+
+void task_group_fan_out(benchmark::State& state) {
+  engine::RunStandalone(4, [&] {
+    const auto fan_out = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+      engine::TaskGroup group;
+      group.Reserve(fan_out);
+      std::vector<engine::TaskWithResult<void>> tasks;
+      tasks.reserve(fan_out);
+      for (std::size_t i = 0; i < fan_out; ++i) {
+        tasks.push_back(group.AsyncNoSpan([] {}));
+      }
+      benchmark::DoNotOptimize(group.WaitAll());
+    }
+  });
+}
+BENCHMARK(task_group_fan_out)->Arg(20)->Arg(100);
+
+void task_group_first_of_many(benchmark::State& state) {
+  engine::RunStandalone(4, [&] {
+    const auto fan_out = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+      engine::TaskGroup group;
+      group.Reserve(fan_out);
+      std::vector<engine::TaskWithResult<void>> tasks;
+      tasks.reserve(fan_out);
+      for (std::size_t i = 0; i < fan_out; ++i) {
+        tasks.push_back(group.AsyncNoSpan([] {}));
+      }
+      benchmark::DoNotOptimize(group.WaitForCount(1));
+      group.CancelAll();
+    }
+  });
+}
+BENCHMARK(task_group_first_of_many)->Arg(20)->Arg(100);
+
+USERVER_NAMESPACE_END
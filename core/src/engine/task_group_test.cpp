@@ -0,0 +1,100 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task_group.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using namespace std::chrono_literals;
+
+UTEST(TaskGroup, Sample) {
+  /// [Sample engine::TaskGroup usage]
+  constexpr std::size_t kSubrequests = 20;
+
+  engine::TaskGroup group;
+  group.Reserve(kSubrequests);
+
+  std::vector<engine::TaskWithResult<std::size_t>> tasks;
+  tasks.reserve(kSubrequests);
+  for (std::size_t i = 0; i < kSubrequests; ++i) {
+    tasks.push_back(group.AsyncNoSpan([i] { return i * i; }));
+  }
+
+  ASSERT_TRUE(group.WaitAll());
+
+  std::size_t sum = 0;
+  for (auto& task : tasks) sum += task.Get();
+  /// [Sample engine::TaskGroup usage]
+
+  EXPECT_EQ(sum, 2470);
+  EXPECT_EQ(group.GetSize(), kSubrequests);
+  EXPECT_EQ(group.GetFinishedCount(), kSubrequests);
+  EXPECT_EQ(group.GetFailedCount(), 0);
+}
+
+UTEST_MT(TaskGroup, WaitForCount, 4) {
+  constexpr std::size_t kFast = 3;
+  constexpr std::size_t kSlow = 7;
+
+  engine::TaskGroup group;
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < kFast; ++i) {
+    tasks.push_back(group.AsyncNoSpan([] {}));
+  }
+  for (std::size_t i = 0; i < kSlow; ++i) {
+    tasks.push_back(
+        group.AsyncNoSpan([] { engine::InterruptibleSleepFor(100s); }));
+  }
+
+  EXPECT_TRUE(group.WaitForCount(kFast));
+  EXPECT_FALSE(
+      group.WaitForCount(kFast + 1, engine::Deadline::FromDuration(10ms)));
+
+  group.CancelAll();
+  EXPECT_TRUE(group.WaitAll(engine::Deadline::FromDuration(
+      utest::kMaxTestWaitTime)));
+  EXPECT_EQ(group.GetFinishedCount(), kFast + kSlow);
+}
+
+UTEST_MT(TaskGroup, CancelOnFirstError, 4) {
+  engine::TaskGroup group(engine::TaskGroup::ErrorPolicy::kCancelOnFirstError);
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int i = 0; i < 5; ++i) {
+    tasks.push_back(
+        group.AsyncNoSpan([] { engine::InterruptibleSleepFor(100s); }));
+  }
+  tasks.push_back(
+      group.AsyncNoSpan([] { throw std::runtime_error("subrequest failed"); }));
+
+  EXPECT_TRUE(group.WaitAll(engine::Deadline::FromDuration(
+      utest::kMaxTestWaitTime)));
+  EXPECT_EQ(group.GetFailedCount(), 1);
+  UEXPECT_THROW(tasks.back().Get(), std::runtime_error);
+
+  // The children started after the failure are cancelled right away
+  auto late_task =
+      group.AsyncNoSpan([] { engine::InterruptibleSleepFor(100s); });
+  EXPECT_TRUE(group.WaitAll(engine::Deadline::FromDuration(
+      utest::kMaxTestWaitTime)));
+}
+
+UTEST(TaskGroup, CancelledBeforeStart) {
+  engine::TaskGroup group;
+  std::atomic<bool> started{false};
+
+  auto task = group.AsyncNoSpan([&] { started = true; });
+  task.RequestCancel();
+  EXPECT_TRUE(group.WaitAll());
+  EXPECT_FALSE(started);
+  EXPECT_EQ(group.GetFinishedCount(), 1);
+  EXPECT_EQ(group.GetFailedCount(), 0);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,57 @@
+#include <engine/thread_affinity_config.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <userver/yaml_config/yaml_config.hpp>
+#include <utils/threads.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+void ThreadAffinityConfig::Validate() const {
+  if (numa_node && *numa_node >= utils::GetNumaNodesCount()) {
+    throw std::runtime_error(
+        fmt::format("NUMA node {} does not exist", *numa_node));
+  }
+
+  if (cpus.empty()) return;
+#ifdef __linux__
+  const auto online_cpus = utils::GetOnlineCpus();
+  if (online_cpus.empty()) return;
+  for (const auto cpu : cpus) {
+    if (!std::binary_search(online_cpus.begin(), online_cpus.end(), cpu)) {
+      throw std::runtime_error(fmt::format("CPU {} is not online", cpu));
+    }
+  }
+#else
+  throw std::runtime_error("CPU affinity is not supported on this platform");
+#endif
+}
+
+void ThreadAffinityConfig::ApplyToCurrentThread() const {
+  if (!cpus.empty()) utils::SetCurrentThreadCpuAffinity(cpus);
+  if (numa_node) utils::SetCurrentThreadNumaNode(*numa_node);
+}
+
+ThreadAffinityConfig Parse(const yaml_config::YamlConfig& value,
+                           formats::parse::To<ThreadAffinityConfig>) {
+  ThreadAffinityConfig config;
+  config.numa_node = value["numa-node"].As<std::optional<std::size_t>>();
+
+  const auto cpus = value["cpus"].As<std::optional<std::string>>();
+  if (cpus) {
+    config.cpus = utils::ParseCpuList(*cpus);
+  } else if (config.numa_node) {
+    config.cpus = utils::GetNumaNodeCpus(*config.numa_node);
+  }
+
+  return config;
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
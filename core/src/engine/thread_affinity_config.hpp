@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <userver/formats/parse/to.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+/// CPU and NUMA node placement of engine threads
+struct ThreadAffinityConfig {
+  /// CPUs to bind the threads to, no binding if empty
+  std::vector<std::size_t> cpus;
+  /// NUMA node to allocate the thread memory on
+  std::optional<std::size_t> numa_node;
+
+  bool IsEmpty() const noexcept { return cpus.empty() && !numa_node; }
+
+  /// Throws if the CPUs are not online or the NUMA node does not exist, so
+  /// that the errors are reported before the threads are started
+  void Validate() const;
+
+  void ApplyToCurrentThread() const;
+};
+
+/// If `numa-node` is set and `cpus` is not, binds to all the CPUs of the node
+ThreadAffinityConfig Parse(const yaml_config::YamlConfig& value,
+                           formats::parse::To<ThreadAffinityConfig>);
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,127 @@
+#include <fs/io_uring_file.hpp>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <userver/engine/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/logging/log.hpp>
+
+#include <engine/ev/io_uring.hpp>
+#include <engine/ev/thread_control.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fs::impl {
+
+namespace {
+
+constexpr std::size_t kReadChunkSize = 64 * 1024;
+constexpr mode_t kCreatedFileMode = S_IRUSR | S_IWUSR;
+
+int CheckResult(engine::ev::IoUring::Result result, std::string_view action,
+                const std::string& path) {
+  if (result.interrupted) {
+    throw engine::WaitInterruptedException(
+        engine::current_task::CancellationReason());
+  }
+  if (result.value < 0) {
+    throw std::system_error(-result.value, std::generic_category(),
+                            fmt::format("Error while {} '{}'", action, path));
+  }
+  return result.value;
+}
+
+class RingFile final {
+ public:
+  RingFile(engine::ev::IoUring& ring, int fd) : ring_(ring), fd_(fd) {}
+
+  RingFile(RingFile&&) = delete;
+  RingFile& operator=(RingFile&&) = delete;
+
+  ~RingFile() {
+    if (fd_ == -1) return;
+    const auto result = ring_.Close(fd_);
+    if (result.value < 0) {
+      LOG_ERROR() << "Cannot close fd " << fd_ << ": "
+                  << std::error_code(-result.value, std::generic_category())
+                         .message();
+    }
+  }
+
+  int Get() const noexcept { return fd_; }
+
+  int Release() && noexcept { return std::exchange(fd_, -1); }
+
+ private:
+  engine::ev::IoUring& ring_;
+  int fd_;
+};
+
+engine::ev::IoUring* GetCurrentIoUring() {
+  return engine::current_task::GetEventThread().GetIoUring();
+}
+
+}  // namespace
+
+std::optional<std::string> TryReadFileContentsIoUring(const std::string& path) {
+  auto* ring = GetCurrentIoUring();
+  if (!ring) return std::nullopt;
+
+  const auto open_result =
+      ring->OpenAt(AT_FDCWD, path.c_str(), O_RDONLY | O_CLOEXEC, 0, {});
+  if (open_result.interrupted) CheckResult(open_result, "opening", path);
+  if (open_result.value < 0) {
+    throw std::runtime_error("Error opening '" + path + '\'');
+  }
+  RingFile file{*ring, open_result.value};
+
+  std::string result;
+  std::size_t offset = 0;
+  while (true) {
+    result.resize(offset + kReadChunkSize);
+    const auto read = CheckResult(
+        ring->Read(file.Get(), result.data() + offset, kReadChunkSize, offset,
+                   {}),
+        "reading", path);
+    offset += read;
+    if (read == 0) break;
+  }
+  result.resize(offset);
+  return result;
+}
+
+bool TryRewriteFileContentsIoUring(const std::string& path,
+                                   std::string_view contents) {
+  auto* ring = GetCurrentIoUring();
+  if (!ring) return false;
+
+  RingFile file{
+      *ring,
+      CheckResult(ring->OpenAt(AT_FDCWD, path.c_str(),
+                               O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                               kCreatedFileMode, {}),
+                  "opening", path)};
+
+  std::size_t offset = 0;
+  while (offset < contents.size()) {
+    offset += CheckResult(
+        ring->Write(file.Get(), contents.data() + offset,
+                    contents.size() - offset, offset, {}),
+        "writing", path);
+  }
+  CheckResult(ring->FSync(file.Get(), {}), "syncing", path);
+  CheckResult(ring->Close(std::move(file).Release()), "closing", path);
+  return true;
+}
+
+}  // namespace fs::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fs::impl {
+
+/// Reads the file via io_uring of the current ev thread. Returns std::nullopt
+/// if the ev thread does not use io_uring.
+std::optional<std::string> TryReadFileContentsIoUring(const std::string& path);
+
+/// Rewrites and fsyncs the file via io_uring of the current ev thread.
+/// Returns false if the ev thread does not use io_uring.
+bool TryRewriteFileContentsIoUring(const std::string& path,
+                                   std::string_view contents);
+
+}  // namespace fs::impl
+
+USERVER_NAMESPACE_END
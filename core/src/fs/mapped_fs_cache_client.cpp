@@ -0,0 +1,234 @@
+#include <userver/fs/mapped_fs_cache_client.hpp>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <system_error>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/fd_poller.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fs {
+
+namespace {
+
+#ifdef __linux__
+// Unlinking and renaming over the file changes the link count, which is
+// reported as IN_ATTRIB
+constexpr std::uint32_t kWatchMask =
+    IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF;
+#endif
+
+// Rejects the hidden files and directories, including '..'
+bool IsServedPath(std::string_view path) {
+  if (path.empty() || path.front() != '/') return false;
+
+  std::size_t pos = 0;
+  while (pos < path.size()) {
+    const auto next = std::min(path.find('/', pos + 1), path.size());
+    const auto name = path.substr(pos + 1, next - pos - 1);
+    if (name.empty() || name.front() == '.') return false;
+    pos = next;
+  }
+  return true;
+}
+
+std::string GetExtension(std::string_view path) {
+  const auto name = path.substr(path.rfind('/') + 1);
+  const auto pos = name.rfind('.');
+  if (pos == std::string_view::npos || pos == 0) return {};
+  return std::string{name.substr(pos)};
+}
+
+bool IsNotFound(const std::system_error& ex) {
+  const auto error = ex.code().value();
+  return error == ENOENT || error == ENOTDIR;
+}
+
+// nullptr if there's no such regular file
+MappedFileConstPtr MapFile(const std::string& path) {
+  try {
+    auto fd = blocking::FileDescriptor::Open(path, blocking::OpenFlag::kRead);
+
+    struct stat info {};
+    utils::CheckSyscall(::fstat(fd.GetNative(), &info), "stat '{}'", path);
+    if (!S_ISREG(info.st_mode)) return nullptr;
+
+    return std::make_shared<const MappedFile>(
+        std::move(fd), static_cast<std::size_t>(info.st_size),
+        GetExtension(path));
+  } catch (const std::system_error& ex) {
+    if (IsNotFound(ex)) return nullptr;
+    throw;
+  }
+}
+
+}  // namespace
+
+MappedFile::MappedFile(blocking::FileDescriptor fd, std::size_t size,
+                       std::string extension)
+    : fd_(std::move(fd)), size_(size), extension_(std::move(extension)) {
+  // mmap(2) does not accept empty mappings
+  if (size_ == 0) return;
+
+  data_ = utils::CheckSyscallNotEquals(
+      ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_.GetNative(), 0),
+      MAP_FAILED, "mapping the file");
+}
+
+MappedFile::~MappedFile() {
+  if (data_) ::munmap(data_, size_);
+}
+
+std::string_view MappedFile::GetData() const {
+  if (!data_) return {};
+  return {static_cast<const char*>(data_), size_};
+}
+
+MappedFsCacheClient::MappedFsCacheClient(std::string_view dir,
+                                         std::size_t max_files,
+                                         engine::TaskProcessor& tp)
+    : dir_(dir), max_files_(max_files), tp_(tp), files_(max_files) {
+  UINVARIANT(max_files_ > 0, "max_files should be positive");
+#ifdef __linux__
+  inotify_fd_ = utils::CheckSyscall(::inotify_init1(IN_NONBLOCK | IN_CLOEXEC),
+                                    "initializing inotify");
+  watcher_task_ =
+      engine::CriticalAsyncNoSpan(tp_, [this] { WatchChanges(); });
+#endif
+  // MAC_COMPAT: no inotify, the cached files are never invalidated
+}
+
+MappedFsCacheClient::~MappedFsCacheClient() {
+  if (watcher_task_.IsValid()) watcher_task_.SyncCancel();
+  if (inotify_fd_ != -1) ::close(inotify_fd_);
+}
+
+MappedFileConstPtr MappedFsCacheClient::TryGetFile(
+    std::string_view path) const {
+  LOG_DEBUG() << "Find file " << path;
+  if (!IsServedPath(path)) return nullptr;
+  const std::string key{path};
+
+  std::lock_guard lock(mutex_);
+  if (const auto* entry = files_.Get(key)) return entry->file;
+
+  // The filesystem operations are done under the lock, so that the changes
+  // that happen after the watch is added are not missed
+  return LoadFile(key);
+}
+
+MappedFileConstPtr MappedFsCacheClient::LoadFile(
+    const std::string& path) const {
+  const auto full_path = dir_ + path;
+
+  int watch_descriptor = -1;
+#ifdef __linux__
+  int error = 0;
+  watch_descriptor =
+      engine::AsyncNoSpan(tp_, [this, &full_path, &error] {
+        const auto wd =
+            ::inotify_add_watch(inotify_fd_, full_path.c_str(), kWatchMask);
+        error = errno;
+        return wd;
+      }).Get();
+  if (watch_descriptor == -1) {
+    if (error == ENOENT || error == ENOTDIR) return nullptr;
+    LOG_LIMITED_WARNING() << "Can not watch '" << full_path
+                          << "' for changes, it is not cached: "
+                          << std::error_code{error, std::system_category()};
+  }
+#endif
+
+  const auto file =
+      engine::AsyncNoSpan(tp_, &MapFile, std::cref(full_path)).Get();
+  if (watch_descriptor == -1) return file;
+
+  watched_paths_.emplace(watch_descriptor, path);
+  if (!file) {
+    Forget(path, watch_descriptor);
+    return nullptr;
+  }
+
+  if (files_.GetSize() >= max_files_) {
+    const auto least_used = *files_.GetLeastUsed();
+    files_.Erase(least_used.path);
+    Forget(least_used.path, least_used.watch_descriptor);
+  }
+  files_.Put(path, Entry{file, path, watch_descriptor});
+  return file;
+}
+
+void MappedFsCacheClient::Forget(const std::string& path,
+                                 int watch_descriptor) const {
+  auto [begin, end] = watched_paths_.equal_range(watch_descriptor);
+  const auto it = std::find_if(
+      begin, end, [&path](const auto& item) { return item.second == path; });
+  if (it == end) return;
+
+  const bool is_last_path = std::next(begin) == end;
+  watched_paths_.erase(it);
+#ifdef __linux__
+  if (is_last_path) ::inotify_rm_watch(inotify_fd_, watch_descriptor);
+#endif
+}
+
+void MappedFsCacheClient::Invalidate(int watch_descriptor) {
+  std::lock_guard lock(mutex_);
+  auto [begin, end] = watched_paths_.equal_range(watch_descriptor);
+  if (begin == end) return;
+
+  for (auto it = begin; it != end; ++it) {
+    LOG_DEBUG() << "File " << it->second << " has changed";
+    files_.Erase(it->second);
+  }
+  watched_paths_.erase(begin, end);
+#ifdef __linux__
+  // The kernel drops the watch by itself if the file is gone
+  ::inotify_rm_watch(inotify_fd_, watch_descriptor);
+#endif
+}
+
+void MappedFsCacheClient::WatchChanges() {
+#ifdef __linux__
+  engine::io::FdPoller poller;
+  poller.Reset(inotify_fd_, engine::io::FdPoller::Kind::kRead);
+
+  alignas(inotify_event) std::array<char, 4096> buffer{};
+  while (!engine::current_task::ShouldCancel()) {
+    if (!poller.Wait({})) continue;
+
+    while (true) {
+      const auto size = ::read(inotify_fd_, buffer.data(), buffer.size());
+      if (size <= 0) break;
+
+      for (ssize_t pos = 0; pos < size;) {
+        const auto* event =
+            reinterpret_cast<const inotify_event*>(buffer.data() + pos);
+        Invalidate(event->wd);
+        pos += sizeof(inotify_event) + event->len;
+      }
+    }
+  }
+  poller.Invalidate();
+#endif
+}
+
+}  // namespace fs
+
+USERVER_NAMESPACE_END
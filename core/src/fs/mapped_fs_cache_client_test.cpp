@@ -0,0 +1,125 @@
+#include <userver/utest/utest.hpp>
+
+#include <chrono>
+#include <string>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/fs/mapped_fs_cache_client.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class MappedFsCacheClientTest : public ::testing::Test {
+ protected:
+  MappedFsCacheClientTest() {
+    fs::blocking::CreateDirectories(dir_.GetPath() + "/sub");
+    Write("/index.html", "<html></html>");
+    Write("/sub/data.json", "{}");
+    Write("/empty", "");
+    Write("/.hidden", "secret");
+  }
+
+  void Write(const std::string& path, std::string_view contents) {
+    fs::blocking::RewriteFileContents(dir_.GetPath() + path, contents);
+  }
+
+  // Replaces the file the way the deployment tools should do it
+  void Replace(const std::string& path, std::string_view contents) {
+    Write(path + ".tmp", contents);
+    fs::blocking::Rename(dir_.GetPath() + path + ".tmp",
+                         dir_.GetPath() + path);
+  }
+
+  fs::MappedFsCacheClient MakeClient(std::size_t max_files) const {
+    return {dir_.GetPath(), max_files,
+            engine::current_task::GetTaskProcessor()};
+  }
+
+ private:
+  const fs::blocking::TempDirectory dir_ =
+      fs::blocking::TempDirectory::Create();
+};
+
+}  // namespace
+
+UTEST_F(MappedFsCacheClientTest, Basic) {
+  const auto client = MakeClient(10);
+
+  const auto index = client.TryGetFile("/index.html");
+  ASSERT_TRUE(index);
+  EXPECT_EQ(index->GetData(), "<html></html>");
+  EXPECT_EQ(index->GetSize(), 13);
+  EXPECT_EQ(index->GetExtension(), ".html");
+  EXPECT_TRUE(index->GetFileDescriptor().IsOpen());
+
+  const auto data = client.TryGetFile("/sub/data.json");
+  ASSERT_TRUE(data);
+  EXPECT_EQ(data->GetData(), "{}");
+  EXPECT_EQ(data->GetExtension(), ".json");
+
+  const auto empty = client.TryGetFile("/empty");
+  ASSERT_TRUE(empty);
+  EXPECT_EQ(empty->GetData(), "");
+  EXPECT_EQ(empty->GetExtension(), "");
+
+  EXPECT_EQ(client.TryGetFile("/index.html"), index);
+}
+
+UTEST_F(MappedFsCacheClientTest, NotServed) {
+  const auto client = MakeClient(10);
+
+  for (const auto path : {"/missing", "/index.html/x", "/sub", "/sub/",
+                          "/.hidden", "/sub/../index.html", "index.html",
+                          "//index.html", ""}) {
+    EXPECT_FALSE(client.TryGetFile(path)) << path;
+  }
+}
+
+UTEST_F(MappedFsCacheClientTest, LeastRecentlyUsed) {
+  const auto client = MakeClient(2);
+
+  const auto index = client.TryGetFile("/index.html");
+  const auto data = client.TryGetFile("/sub/data.json");
+  EXPECT_EQ(client.TryGetFile("/index.html"), index);
+
+  // evicts the "/sub/data.json"
+  EXPECT_TRUE(client.TryGetFile("/empty"));
+  EXPECT_EQ(client.TryGetFile("/index.html"), index);
+  const auto new_data = client.TryGetFile("/sub/data.json");
+  ASSERT_TRUE(new_data);
+  EXPECT_NE(new_data, data);
+  EXPECT_EQ(new_data->GetData(), "{}");
+  // evicted file is still usable
+  EXPECT_EQ(data->GetData(), "{}");
+}
+
+#ifdef __linux__
+UTEST_F(MappedFsCacheClientTest, Invalidation) {
+  const auto client = MakeClient(10);
+  const auto old_index = client.TryGetFile("/index.html");
+  ASSERT_TRUE(old_index);
+
+  Replace("/index.html", "<html>new</html>");
+
+  auto index = client.TryGetFile("/index.html");
+  while (index == old_index) {
+    engine::SleepFor(std::chrono::milliseconds{10});
+    index = client.TryGetFile("/index.html");
+  }
+  ASSERT_TRUE(index);
+  EXPECT_EQ(index->GetData(), "<html>new</html>");
+  EXPECT_EQ(old_index->GetData(), "<html></html>");
+
+  Replace("/index.html", "<html>newer</html>");
+  while (index->GetData() != "<html>newer</html>") {
+    engine::SleepFor(std::chrono::milliseconds{10});
+    index = client.TryGetFile("/index.html");
+  }
+}
+#endif
+
+USERVER_NAMESPACE_END
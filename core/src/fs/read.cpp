@@ -3,6 +3,8 @@
 #include <userver/engine/async.hpp>
 #include <userver/fs/blocking/read.hpp>
 
+#include <fs/io_uring_file.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace fs {
@@ -25,6 +27,9 @@ std::string GetRelative(std::string_view path, std::string_view dir) {
 
 std::string ReadFileContents(engine::TaskProcessor& async_tp,
                              const std::string& path) {
+  if (auto contents = impl::TryReadFileContentsIoUring(path)) {
+    return std::move(*contents);
+  }
   return engine::AsyncNoSpan(async_tp, &fs::blocking::ReadFileContents, path)
       .Get();
 }
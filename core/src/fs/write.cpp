@@ -6,6 +6,8 @@
 #include <userver/fs/blocking/write.hpp>
 #include <userver/utils/boost_uuid4.hpp>
 
+#include <fs/io_uring_file.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace fs {
@@ -25,6 +27,7 @@ void CreateDirectories(engine::TaskProcessor& async_tp, std::string_view path) {
 
 void RewriteFileContents(engine::TaskProcessor& async_tp,
                          const std::string& path, std::string_view contents) {
+  if (impl::TryRewriteFileContentsIoUring(path, contents)) return;
   engine::AsyncNoSpan(async_tp, &fs::blocking::RewriteFileContents, path,
                       contents)
       .Get();
@@ -0,0 +1,165 @@
+#include <logging/binary_format.hpp>
+
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/datetime/timestring.hpp>
+#include <userver/utils/encoding/tskv.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl::binary {
+
+namespace {
+
+// level and timestamp
+constexpr std::size_t kHeaderSize =
+    sizeof(std::uint8_t) + sizeof(std::int64_t);
+
+constexpr std::string_view kTextKey = "text";
+
+class Parser final {
+ public:
+  explicit Parser(std::string_view data) : data_(data) {}
+
+  bool IsEmpty() const { return data_.empty(); }
+
+  template <typename T>
+  T Read() {
+    const auto bytes = ReadBytes(sizeof(T));
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+      const auto byte = static_cast<unsigned char>(bytes[i]);
+      value |= static_cast<std::uint64_t>(byte) << (i * 8);
+    }
+    return static_cast<T>(value);
+  }
+
+  std::string_view ReadBytes(std::size_t size) {
+    if (data_.size() < size) {
+      throw std::runtime_error("Malformed binary log record");
+    }
+    const auto result = data_.substr(0, size);
+    data_.remove_prefix(size);
+    return result;
+  }
+
+ private:
+  std::string_view data_;
+};
+
+void AppendEncoded(std::string& out, std::string_view value,
+                   utils::encoding::EncodeTskvMode mode) {
+  utils::encoding::EncodeTskv(out, value.begin(), value.end(), mode);
+}
+
+void RenderText(const Record& record, Format format, std::string& out) {
+  const char key_value_separator = format == Format::kLtsv ? ':' : '=';
+
+  if (format != Format::kRaw) {
+    char timestamp[utils::datetime::kMaxTimestringSize];
+    const auto timestamp_size = utils::datetime::TimestringInto(
+        timestamp, record.timestamp,
+        utils::datetime::TimestringFormat::kTskvLocal);
+    const auto level = spdlog::level::to_string_view(
+        static_cast<spdlog::level::level_enum>(record.level));
+
+    if (format == Format::kTskv) out.append("tskv\t");
+    out.append("timestamp");
+    out.push_back(key_value_separator);
+    out.append(timestamp, timestamp_size);
+    out.push_back('\t');
+    fmt::format_to(std::back_inserter(out), "level{}{}\t", key_value_separator,
+                   std::string_view{level.data(), level.size()});
+  }
+
+  bool is_first = true;
+  for (const auto& field : record.fields) {
+    if (!is_first) out.push_back(utils::encoding::kTskvPairsSeparator);
+    is_first = false;
+
+    AppendEncoded(out, field.key,
+                  utils::encoding::EncodeTskvMode::kKeyReplacePeriod);
+    out.push_back(key_value_separator);
+    AppendEncoded(out, field.value, utils::encoding::EncodeTskvMode::kValue);
+  }
+}
+
+}  // namespace
+
+void Formatter::format(const spdlog::details::log_msg& msg,
+                       spdlog::memory_buf_t& dest) {
+  const auto size = kHeaderSize + msg.payload.size();
+  UINVARIANT(size <= std::numeric_limits<std::uint32_t>::max(),
+             "Log record is too big");
+
+  AppendLittleEndian(dest, static_cast<std::uint32_t>(size));
+  AppendLittleEndian(dest, static_cast<std::uint8_t>(msg.level));
+  AppendLittleEndian(
+      dest, static_cast<std::int64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    msg.time.time_since_epoch())
+                    .count()));
+  dest.append(msg.payload.begin(), msg.payload.end());
+}
+
+std::unique_ptr<spdlog::formatter> Formatter::clone() const {
+  return std::make_unique<Formatter>();
+}
+
+bool ReadRecord(std::istream& in, std::string& buffer) {
+  char size_bytes[sizeof(std::uint32_t)];
+  in.read(size_bytes, sizeof(size_bytes));
+  if (in.gcount() == 0) return false;
+  if (in.gcount() != sizeof(size_bytes)) {
+    throw std::runtime_error("Truncated binary log record size");
+  }
+
+  const auto size =
+      Parser({size_bytes, sizeof(size_bytes)}).Read<std::uint32_t>();
+  buffer.resize(size);
+  in.read(buffer.data(), size);
+  if (static_cast<std::size_t>(in.gcount()) != size) {
+    throw std::runtime_error("Truncated binary log record");
+  }
+  return true;
+}
+
+Record ParseRecord(std::string_view buffer) {
+  Parser parser(buffer);
+
+  Record record;
+  record.level = static_cast<Level>(parser.Read<std::uint8_t>());
+  record.timestamp = std::chrono::system_clock::time_point{
+      std::chrono::microseconds{parser.Read<std::int64_t>()}};
+
+  if (parser.IsEmpty() ||
+      parser.ReadBytes(1).front() != kStructuredPayloadMarker) {
+    record.fields.push_back({kTextKey, buffer.substr(kHeaderSize)});
+    return record;
+  }
+
+  while (!parser.IsEmpty()) {
+    Field field;
+    field.key = parser.ReadBytes(parser.Read<std::uint16_t>());
+    field.value = parser.ReadBytes(parser.Read<std::uint32_t>());
+    record.fields.push_back(field);
+  }
+  return record;
+}
+
+void RenderRecord(const Record& record, Format format, std::string& out) {
+  UINVARIANT(format != Format::kBinary,
+             "Binary records can only be rendered in a text format");
+  RenderText(record, format, out);
+  out.push_back('\n');
+}
+
+}  // namespace logging::impl::binary
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// this header must be included before any spdlog headers
+// to override spdlog's level names
+#include <logging/spdlog.hpp>
+
+#include <spdlog/formatter.h>
+
+#include <userver/logging/format.hpp>
+#include <userver/logging/level.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+/// Binary log records, see logging::Format::kBinary
+///
+/// Each record is written as:
+/// - u32 size of the rest of the record;
+/// - u8 level;
+/// - i64 timestamp, microseconds since epoch;
+/// - the payload of the log message.
+///
+/// The payload of the records written by LogHelper starts with
+/// kStructuredPayloadMarker followed by the fields:
+/// - u16 key size, key;
+/// - u32 value size, value.
+///
+/// Any other payload (e.g. of the access logs that are formatted by the
+/// caller) is read back as a single `text` field. All the integers are little
+/// endian. Keys and values are stored as is, escaping happens on rendering.
+namespace logging::impl::binary {
+
+inline constexpr char kStructuredPayloadMarker = '\0';
+
+struct Field {
+  std::string_view key;
+  std::string_view value;
+};
+
+struct Record {
+  Level level{Level::kNone};
+  std::chrono::system_clock::time_point timestamp;
+  std::vector<Field> fields;
+};
+
+template <typename T, typename Buffer>
+void AppendLittleEndian(Buffer& to, T value) {
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    to.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+  }
+}
+
+template <typename T>
+void StoreLittleEndian(char* to, T value) {
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    to[i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+  }
+}
+
+/// spdlog formatter that writes binary records
+class Formatter final : public spdlog::formatter {
+ public:
+  void format(const spdlog::details::log_msg& msg,
+              spdlog::memory_buf_t& dest) override;
+
+  std::unique_ptr<spdlog::formatter> clone() const override;
+};
+
+/// Reads the next record into `buffer`, returns false at the end of input.
+/// @throws std::runtime_error if the input is truncated
+bool ReadRecord(std::istream& in, std::string& buffer);
+
+/// Parses the record read by ReadRecord, the fields refer to `buffer`.
+/// @throws std::runtime_error if the record is malformed
+Record ParseRecord(std::string_view buffer);
+
+/// Appends the record as a line in the text `format`, the same way the
+/// text loggers would have written it
+void RenderRecord(const Record& record, Format format, std::string& out);
+
+}  // namespace logging::impl::binary
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,184 @@
+#include <logging/buffered_file_sink.hpp>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <spdlog/common.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging {
+
+namespace {
+
+// Suitable for O_DIRECT on both 512-byte and 4K sector devices
+constexpr std::size_t kDirectIoAlignment = 4096;
+
+std::size_t RoundUp(std::size_t value, std::size_t alignment) noexcept {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+std::size_t RoundDown(std::size_t value, std::size_t alignment) noexcept {
+  return value / alignment * alignment;
+}
+
+[[noreturn]] void ThrowSystemError(const std::string& what,
+                                   const std::string& filename) {
+  spdlog::throw_spdlog_ex(what + " failed for log file " + filename, errno);
+}
+
+}  // namespace
+
+BufferedFileSink::BufferedFileSink(std::string filename,
+                                   BufferedFileSinkSettings settings)
+    : filename_(std::move(filename)),
+      settings_(std::move(settings)),
+      alignment_(settings_.direct_io ? kDirectIoAlignment : 1),
+      capacity_(RoundUp(std::max<std::size_t>(settings_.buffer_size, 1),
+                        kDirectIoAlignment)),
+      buffer_(static_cast<char*>(
+          std::aligned_alloc(kDirectIoAlignment, capacity_))) {
+  if (!buffer_) throw std::bad_alloc{};
+#ifndef O_DIRECT
+  if (settings_.direct_io) {
+    spdlog::throw_spdlog_ex("direct_io is not supported on this platform");
+  }
+#endif
+
+  Open(/*truncate=*/false);
+}
+
+BufferedFileSink::~BufferedFileSink() {
+  try {
+    WriteBuffer();
+  } catch (const std::exception&) {
+    // nowhere to report
+  }
+  Close();
+}
+
+void BufferedFileSink::Reopen(bool truncate) {
+  std::lock_guard lock(mutex_);
+  if (fd_ != -1) {
+    WriteBuffer();
+    if (settings_.fsync_period && has_unsynced_data_) ::fdatasync(fd_);
+    Close();
+  }
+  Open(truncate);
+}
+
+void BufferedFileSink::sink_it_(const spdlog::details::log_msg& msg) {
+  spdlog::memory_buf_t formatted;
+  formatter_->format(msg, formatted);
+  Append(formatted.data(), formatted.size());
+}
+
+void BufferedFileSink::flush_() {
+  WriteBuffer();
+  SyncIfNeeded();
+}
+
+void BufferedFileSink::Open(bool truncate) {
+  // O_RDWR to read back the partially filled last block with O_DIRECT
+  int flags = O_RDWR | O_CREAT | O_CLOEXEC;
+  if (truncate) flags |= O_TRUNC;
+#ifdef O_DIRECT
+  if (settings_.direct_io) flags |= O_DIRECT;
+#endif
+
+  fd_ = ::open(filename_.c_str(), flags, 0644);
+  if (fd_ == -1) ThrowSystemError("open", filename_);
+
+  struct stat file_stat {};
+  if (::fstat(fd_, &file_stat) == -1) {
+    Close();
+    ThrowSystemError("fstat", filename_);
+  }
+  const auto file_size = static_cast<std::uint64_t>(file_stat.st_size);
+
+  file_offset_ = RoundDown(file_size, alignment_);
+  size_ = file_size - file_offset_;
+  written_size_ = size_;
+  if (size_ > 0 &&
+      ::pread(fd_, buffer_.get(), alignment_, file_offset_) !=
+          static_cast<ssize_t>(size_)) {
+    Close();
+    ThrowSystemError("pread", filename_);
+  }
+
+  // Same as ReopeningFileSink, separates the records of different runs
+  if (file_size > 0) Append("\n", 1);
+}
+
+void BufferedFileSink::Close() noexcept {
+  if (fd_ != -1) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+void BufferedFileSink::Append(const char* data, std::size_t size) {
+  while (size > 0) {
+    if (size_ == capacity_) WriteBuffer();
+
+    const auto chunk = std::min(size, capacity_ - size_);
+    std::memcpy(buffer_.get() + size_, data, chunk);
+    size_ += chunk;
+    data += chunk;
+    size -= chunk;
+  }
+}
+
+void BufferedFileSink::WriteBuffer() {
+  if (size_ == written_size_) return;
+
+  const auto write_size = RoundUp(size_, alignment_);
+  std::memset(buffer_.get() + size_, 0, write_size - size_);
+
+  std::size_t written = 0;
+  while (written < write_size) {
+    const auto result = ::pwrite(fd_, buffer_.get() + written,
+                                 write_size - written, file_offset_ + written);
+    if (result == -1) {
+      if (errno == EINTR) continue;
+      ThrowSystemError("pwrite", filename_);
+    }
+    written += result;
+  }
+  if (write_size != size_ && ::ftruncate(fd_, file_offset_ + size_) == -1) {
+    ThrowSystemError("ftruncate", filename_);
+  }
+  has_unsynced_data_ = true;
+
+  // Keep the partially filled last block to rewrite it with the new data
+  const auto full_blocks_size = RoundDown(size_, alignment_);
+  std::memmove(buffer_.get(), buffer_.get() + full_blocks_size,
+               size_ - full_blocks_size);
+  file_offset_ += full_blocks_size;
+  size_ -= full_blocks_size;
+  written_size_ = size_;
+}
+
+void BufferedFileSink::SyncIfNeeded() {
+  if (!settings_.fsync_period || !has_unsynced_data_) return;
+
+  const auto now = std::chrono::steady_clock::now();
+  if (now - last_sync_time_ < *settings_.fsync_period) return;
+
+  if (::fdatasync(fd_) == -1) ThrowSystemError("fdatasync", filename_);
+  last_sync_time_ = now;
+  has_unsynced_data_ = false;
+
+  if (settings_.drop_page_cache) {
+    ::posix_fadvise(fd_, 0, 0, POSIX_FADV_DONTNEED);
+  }
+}
+
+}  // namespace logging
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+// this header must be included before any spdlog headers
+// to override spdlog's level names
+#include <logging/spdlog.hpp>
+
+#include <spdlog/sinks/base_sink.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging {
+
+struct BufferedFileSinkSettings {
+  std::size_t buffer_size{1 << 20};
+  // fdatasync the written data at most once per period, never if not set
+  std::optional<std::chrono::milliseconds> fsync_period;
+  // Bypass the page cache with O_DIRECT
+  bool direct_io{false};
+  // Evict the synced data from the page cache with posix_fadvise
+  bool drop_page_cache{false};
+};
+
+/// File sink that formats the messages into a large aligned buffer and writes
+/// the buffer with a single syscall once it is full or on flush.
+///
+/// With `direct_io` the writes are done in whole blocks, the partially filled
+/// last block is padded and then cut off with ftruncate. It is written once
+/// more when the rest of the block is filled.
+class BufferedFileSink final : public spdlog::sinks::base_sink<std::mutex> {
+ public:
+  BufferedFileSink(std::string filename, BufferedFileSinkSettings settings);
+
+  ~BufferedFileSink() override;
+
+  void Reopen(bool truncate);
+
+ protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override;
+
+  void flush_() override;
+
+ private:
+  struct FreeDeleter {
+    void operator()(char* memory) const noexcept { std::free(memory); }
+  };
+
+  void Open(bool truncate);
+  void Close() noexcept;
+  void Append(const char* data, std::size_t size);
+  void WriteBuffer();
+  void SyncIfNeeded();
+
+  const std::string filename_;
+  const BufferedFileSinkSettings settings_;
+  const std::size_t alignment_;
+  const std::size_t capacity_;
+  std::unique_ptr<char, FreeDeleter> buffer_;
+
+  int fd_{-1};
+  // File offset of the buffer start, a multiple of alignment_
+  std::uint64_t file_offset_{0};
+  std::size_t size_{0};
+  // Bytes at the buffer start that are already in the file
+  std::size_t written_size_{0};
+
+  bool has_unsynced_data_{false};
+  std::chrono::steady_clock::time_point last_sync_time_{};
+};
+
+}  // namespace logging
+
+USERVER_NAMESPACE_END
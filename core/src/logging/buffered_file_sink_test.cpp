@@ -0,0 +1,127 @@
+#include <logging/buffered_file_sink.hpp>
+
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+#include <spdlog/logger.h>
+
+#include <userver/fs/blocking/temp_directory.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string ReadFile(const std::string& path) {
+  std::ifstream file(path);
+  std::ostringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+std::shared_ptr<spdlog::logger> MakeLogger(
+    std::shared_ptr<logging::BufferedFileSink> sink) {
+  auto logger = std::make_shared<spdlog::logger>("test", std::move(sink));
+  logger->set_pattern("%v");
+  return logger;
+}
+
+}  // namespace
+
+TEST(BufferedFileSink, WritesOnFlush) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/log.txt";
+
+  auto sink = std::make_shared<logging::BufferedFileSink>(
+      path, logging::BufferedFileSinkSettings{});
+  auto logger = MakeLogger(sink);
+
+  logger->info("first");
+  logger->info("second");
+  EXPECT_EQ(ReadFile(path), "");
+
+  logger->flush();
+  EXPECT_EQ(ReadFile(path), "first\nsecond\n");
+}
+
+TEST(BufferedFileSink, WritesFullBuffer) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/log.txt";
+
+  logging::BufferedFileSinkSettings settings;
+  settings.buffer_size = 4096;
+  auto sink = std::make_shared<logging::BufferedFileSink>(path, settings);
+  auto logger = MakeLogger(sink);
+
+  const std::string message(5000, 'x');
+  logger->info(message);
+  logger->info("tail");
+  EXPECT_EQ(ReadFile(path).size(), 4096);
+
+  logger->flush();
+  EXPECT_EQ(ReadFile(path), message + "\ntail\n");
+}
+
+TEST(BufferedFileSink, Reopen) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/log.txt";
+
+  auto sink = std::make_shared<logging::BufferedFileSink>(
+      path, logging::BufferedFileSinkSettings{});
+  auto logger = MakeLogger(sink);
+
+  logger->info("before");
+  sink->Reopen(/*truncate=*/false);
+  EXPECT_EQ(ReadFile(path), "before\n");
+
+  logger->info("after");
+  logger->flush();
+  EXPECT_EQ(ReadFile(path), "before\n\nafter\n");
+
+  sink->Reopen(/*truncate=*/true);
+  logger->info("truncated");
+  logger->flush();
+  EXPECT_EQ(ReadFile(path), "truncated\n");
+}
+
+TEST(BufferedFileSink, DirectIo) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/log.txt";
+
+  logging::BufferedFileSinkSettings settings;
+  settings.buffer_size = 8192;
+  settings.direct_io = true;
+  settings.fsync_period = std::chrono::milliseconds{0};
+
+  std::shared_ptr<logging::BufferedFileSink> sink;
+  try {
+    sink = std::make_shared<logging::BufferedFileSink>(path, settings);
+  } catch (const spdlog::spdlog_ex& ex) {
+    GTEST_SKIP() << "O_DIRECT is not supported by the file system: "
+                 << ex.what();
+  }
+  auto logger = MakeLogger(sink);
+
+  std::string expected;
+  for (int i = 0; i < 1000; ++i) {
+    const auto message = "message " + std::to_string(i);
+    logger->info(message);
+    expected += message + '\n';
+    if (i % 100 == 0) {
+      logger->flush();
+      EXPECT_EQ(ReadFile(path), expected);
+    }
+  }
+  logger->flush();
+  EXPECT_EQ(ReadFile(path), expected);
+
+  sink.reset();
+  logger.reset();
+  sink = std::make_shared<logging::BufferedFileSink>(path, settings);
+  logger = MakeLogger(sink);
+  logger->info("reopened");
+  logger->flush();
+  EXPECT_EQ(ReadFile(path), expected + "\nreopened\n");
+}
+
+USERVER_NAMESPACE_END
@@ -12,12 +12,13 @@
 
 #include <fmt/format.h>
 
-#include <spdlog/async.h>
 #include <spdlog/sinks/stdout_sinks.h>
 
+#include <logging/buffered_file_sink.hpp>
 #include <logging/logger_with_info.hpp>
 #include <logging/reopening_file_sink.hpp>
 #include <logging/spdlog_helpers.hpp>
+#include <logging/thread_buffered_logger.hpp>
 #include <logging/unix_socket_sink.hpp>
 #include <userver/components/component.hpp>
 #include <userver/engine/async.hpp>
@@ -27,7 +28,7 @@
 #include <userver/logging/logger.hpp>
 #include <userver/os_signals/component.hpp>
 #include <userver/utils/algo.hpp>
-#include <userver/utils/thread_name.hpp>
+#include <userver/utils/statistics/writer.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 #include "config.hpp"
@@ -67,14 +68,15 @@ std::optional<TestsuiteCaptureConfig> GetTestsuiteCaptureConfig(
 
 void ReopenAll(std::vector<spdlog::sink_ptr>& sinks) {
   for (const auto& s : sinks) {
-    auto reop = std::dynamic_pointer_cast<logging::ReopeningFileSinkMT>(s);
-    if (!reop) {
-      continue;
-    }
-
     try {
       bool should_truncate = false;
-      reop->Reopen(should_truncate);
+      if (auto reop =
+              std::dynamic_pointer_cast<logging::ReopeningFileSinkMT>(s)) {
+        reop->Reopen(should_truncate);
+      } else if (auto buffered =
+                     std::dynamic_pointer_cast<logging::BufferedFileSink>(s)) {
+        buffered->Reopen(should_truncate);
+      }
     } catch (const std::exception& e) {
       LOG_ERROR() << "Exception on log reopen: " << e;
     }
@@ -94,11 +96,21 @@ void CreateLogDirectory(const std::string& logger_name,
   }
 }
 
-spdlog::sink_ptr GetSinkFromFilename(const spdlog::filename_t& file_path) {
+spdlog::sink_ptr GetSinkFromFilename(
+    const logging::LoggerConfig& logger_config) {
+  const auto& file_path = logger_config.file_path;
   if (boost::starts_with(file_path, unix_socket_prefix)) {
     // Use Unix-socket sink
     return std::make_shared<logging::SocketSinkMT>(
         file_path.substr(unix_socket_prefix.size()));
+  } else if (logger_config.file_buffer_size > 0) {
+    // Use buffered File sink
+    logging::BufferedFileSinkSettings settings;
+    settings.buffer_size = logger_config.file_buffer_size;
+    settings.fsync_period = logger_config.fsync_period;
+    settings.direct_io = logger_config.direct_io;
+    settings.drop_page_cache = logger_config.drop_page_cache;
+    return std::make_shared<logging::BufferedFileSink>(file_path, settings);
   } else {
     // Use File sink
     return std::make_shared<logging::ReopeningFileSinkMT>(file_path);
@@ -117,25 +129,14 @@ std::shared_ptr<logging::impl::LoggerWithInfo> CreateAsyncLogger(
     return logging::MakeStdoutLogger(logger_name, logger_config.format,
                                      logger_config.level);
 
-  auto overflow_policy = spdlog::async_overflow_policy::overrun_oldest;
-  if (logger_config.queue_overflow_behavior ==
-      logging::LoggerConfig::QueueOveflowBehavior::kBlock) {
-    overflow_policy = spdlog::async_overflow_policy::block;
-  }
-
   CreateLogDirectory(logger_name, logger_config.file_path);
-  spdlog::sink_ptr sink = GetSinkFromFilename(logger_config.file_path);
-
-  auto tp = std::make_shared<spdlog::details::thread_pool>(
-      logger_config.message_queue_size, logger_config.thread_pool_size,
-      [thread_name = "log/" + logger_name] {
-        utils::SetCurrentThreadName(thread_name);
-      });
+  spdlog::sink_ptr sink = GetSinkFromFilename(logger_config);
 
   return std::make_shared<logging::impl::LoggerWithInfo>(
-      logger_config.format, tp,
-      utils::MakeSharedRef<spdlog::async_logger>(logger_name, std::move(sink),
-                                                 tp, overflow_policy));
+      logger_config.format, std::shared_ptr<spdlog::details::thread_pool>{},
+      utils::MakeSharedRef<logging::impl::ThreadBufferedLogger>(
+          logger_name, std::move(sink), logger_config.message_queue_size,
+          logger_config.queue_overflow_behavior));
 }
 
 }  // namespace
@@ -212,10 +213,16 @@ Logging::Logging(const ComponentConfig& config, const ComponentContext& context)
 
     const auto logger_config = logger_yaml.As<logging::LoggerConfig>();
     auto logger = CreateAsyncLogger(logger_name, logger_config);
+    if (auto buffered_logger =
+            std::dynamic_pointer_cast<logging::impl::ThreadBufferedLogger>(
+                logger->ptr.GetBase())) {
+      buffered_loggers_.emplace_back(logger_name, std::move(buffered_logger));
+    }
 
     logger->ptr->set_level(
         static_cast<spdlog::level::level_enum>(logger_config.level));
-    logger->ptr->set_pattern(logger_config.pattern);
+    logging::SetSpdlogFormat(*logger->ptr, logger_config.format,
+                             logger_config.pattern);
     logger->ptr->flush_on(
         static_cast<spdlog::level::level_enum>(logger_config.flush_level));
 
@@ -323,6 +330,12 @@ void Logging::FlushLogs() {
   }
 }
 
+void Logging::WriteStatistics(utils::statistics::Writer& writer) const {
+  for (const auto& [name, logger] : buffered_loggers_) {
+    writer.ValueWithLabels(logger->GetQueueStatistics(), {"logger", name});
+  }
+}
+
 yaml_config::Schema Logging::GetStaticConfigSchema() {
   return yaml_config::MergeSchemas<impl::ComponentBase>(R"(
 type: object
@@ -356,14 +369,15 @@ properties:
                       - tskv
                       - ltsv
                       - raw
+                      - binary
                 flush_level:
                     type: string
                     description: messages of this and higher levels get flushed to the file immediately
                     defaultDescription: warning
                 message_queue_size:
                     type: integer
-                    description: the size of internal message queue, must be a power of 2
-                    defaultDescription: 65536
+                    description: the size of the message queue of each thread that writes to the logger, must be a power of 2
+                    defaultDescription: 4096
                 overflow_behavior:
                     type: string
                     description: "message handling policy while the queue is full: `discard` drops messages, `block` waits until message gets into the queue"
@@ -371,6 +385,22 @@ properties:
                     enum:
                       - discard
                       - block
+                file_buffer_size:
+                    type: integer
+                    description: size of the buffer to accumulate the file writes in, 0 writes each message separately
+                    defaultDescription: 0
+                    minimum: 0
+                fsync_period:
+                    type: string
+                    description: how often the written data is fdatasync'ed, never if not set; requires file_buffer_size
+                direct_io:
+                    type: boolean
+                    description: write the file with O_DIRECT bypassing the page cache; requires file_buffer_size
+                    defaultDescription: false
+                drop_page_cache:
+                    type: boolean
+                    description: evict the synced data from the page cache; requires fsync_period
+                    defaultDescription: false
                 testsuite-capture:
                     type: object
                     description: if exists, setups additional TCP log sink for testing purposes
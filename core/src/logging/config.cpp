@@ -44,7 +44,8 @@ LoggerConfig Parse(const yaml_config::YamlConfig& value,
 
   config.message_queue_size = value["message_queue_size"].As<size_t>(
       LoggerConfig::kDefaultMessageQueueSize);
-  if (config.message_queue_size & (config.message_queue_size - 1)) {
+  if (config.message_queue_size == 0 ||
+      (config.message_queue_size & (config.message_queue_size - 1))) {
     throw std::runtime_error("log message queue size must be a power of 2");
   }
 
@@ -52,8 +53,21 @@ LoggerConfig Parse(const yaml_config::YamlConfig& value,
       value["overflow_behavior"].As<LoggerConfig::QueueOveflowBehavior>(
           LoggerConfig::QueueOveflowBehavior::kDiscard);
 
-  config.thread_pool_size = value["thread_pool_size"].As<size_t>(
-      LoggerConfig::kDefaultThreadPoolSize);
+  config.file_buffer_size = value["file_buffer_size"].As<size_t>(0);
+  config.fsync_period =
+      value["fsync_period"].As<std::optional<std::chrono::milliseconds>>();
+  config.direct_io = value["direct_io"].As<bool>(false);
+  config.drop_page_cache = value["drop_page_cache"].As<bool>(false);
+  if (config.file_buffer_size == 0 &&
+      (config.fsync_period || config.direct_io || config.drop_page_cache)) {
+    throw std::runtime_error(
+        "fsync_period, direct_io and drop_page_cache require file_buffer_size");
+  }
+  if (config.drop_page_cache && !config.fsync_period) {
+    throw std::runtime_error(
+        "drop_page_cache requires fsync_period, only the synced data may be "
+        "dropped from the page cache");
+  }
 
   return config;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -13,8 +15,7 @@ USERVER_NAMESPACE_BEGIN
 namespace logging {
 
 struct LoggerConfig {
-  static constexpr size_t kDefaultMessageQueueSize = 1 << 16;
-  static constexpr size_t kDefaultThreadPoolSize = 1;
+  static constexpr size_t kDefaultMessageQueueSize = 1 << 12;
 
   enum class QueueOveflowBehavior { kDiscard, kBlock };
 
@@ -24,11 +25,15 @@ struct LoggerConfig {
   std::string pattern;  // deprecated
   Level flush_level = Level::kWarning;
 
-  // must be a power of 2
+  // per writing thread, must be a power of 2
   size_t message_queue_size = kDefaultMessageQueueSize;
   QueueOveflowBehavior queue_overflow_behavior = QueueOveflowBehavior::kDiscard;
 
-  size_t thread_pool_size = kDefaultThreadPoolSize;
+  // 0 writes each message to the file separately
+  size_t file_buffer_size = 0;
+  std::optional<std::chrono::milliseconds> fsync_period;
+  bool direct_io = false;
+  bool drop_page_cache = false;
 };
 
 LoggerConfig Parse(const yaml_config::YamlConfig& value,
@@ -1,6 +1,7 @@
 #include "dynamic_debug.hpp"
 
 #include <cstring>
+#include <mutex>
 
 #include <fmt/format.h>
 
@@ -18,6 +19,11 @@ LogEntryContentSet& GetAllLocations() noexcept {
   return locations;
 }
 
+std::atomic<bool>& RateLimitEnabled() noexcept {
+  static std::atomic<bool> enabled{false};
+  return enabled;
+}
+
 [[noreturn]] void ThrowUnknownDynamicLogLocation(std::string_view location,
                                                  int line) {
   if (line != kAnyLine) {
@@ -45,8 +51,16 @@ StaticLogEntry::StaticLogEntry(const char* path, int line) noexcept {
   GetAllLocations().insert(*item);
 }
 
-bool StaticLogEntry::ShouldLog() const noexcept {
-  return reinterpret_cast<const LogEntryContent&>(content).should_log.load();
+bool StaticLogEntry::ShouldLog(Level level) noexcept {
+  auto& entry = reinterpret_cast<LogEntryContent&>(content);
+  if (!logging::ShouldLog(level)) return entry.should_log.load();
+
+  if (!RateLimitEnabled().load(std::memory_order_relaxed) ||
+      entry.rate_limit.Obtain()) {
+    return true;
+  }
+  entry.dropped.fetch_add(1, std::memory_order_relaxed);
+  return false;
 }
 
 }  // namespace impl
@@ -107,6 +121,50 @@ const LogEntryContentSet& GetDynamicDebugLocations() {
   return GetAllLocations();
 }
 
+void SetLogRateLimit(const LogRateLimit& rate_limit) {
+  utils::impl::AssertStaticRegistrationFinished();
+  UINVARIANT(!rate_limit.enabled || rate_limit.max_messages_per_second > 0,
+             "max-messages-per-second must be positive");
+
+  static std::mutex mutex;
+  static LogRateLimit current;
+  std::lock_guard lock(mutex);
+  if (rate_limit.enabled == current.enabled &&
+      rate_limit.max_messages_per_second == current.max_messages_per_second &&
+      rate_limit.max_burst == current.max_burst) {
+    return;
+  }
+  current = rate_limit;
+
+  if (!rate_limit.enabled) {
+    RateLimitEnabled() = false;
+    return;
+  }
+
+  const utils::TokenBucket::RefillPolicy policy{
+      1, std::chrono::duration_cast<utils::TokenBucket::Duration>(
+             std::chrono::seconds{1}) /
+             rate_limit.max_messages_per_second};
+  for (auto& location : GetAllLocations()) {
+    location.rate_limit = utils::TokenBucket{rate_limit.max_burst, policy};
+  }
+  RateLimitEnabled() = true;
+}
+
+void LogSuppressedMessages() {
+  utils::impl::AssertStaticRegistrationFinished();
+
+  for (auto& location : GetAllLocations()) {
+    const auto dropped = location.dropped.exchange(0);
+    if (dropped == 0) continue;
+
+    // LOG_TO is not rate limited
+    LOG_TO(DefaultLogger(), Level::kWarning)
+        << "suppressed " << dropped << " messages from " << location.path
+        << ':' << location.line;
+  }
+}
+
 }  // namespace logging
 
 USERVER_NAMESPACE_END
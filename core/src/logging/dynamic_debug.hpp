@@ -1,12 +1,15 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string_view>
 
 #include <boost/intrusive/set.hpp>
 #include <boost/intrusive/set_hook.hpp>
 
 #include <userver/logging/log.hpp>
+#include <userver/utils/token_bucket.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -27,6 +30,8 @@ struct LogEntryContent {
   const int line;
   const char* const path;
   LogEntryContentHook hook;
+  utils::TokenBucket rate_limit;
+  std::atomic<std::uint64_t> dropped{0};
 };
 
 bool operator<(const LogEntryContent& x, const LogEntryContent& y) noexcept;
@@ -48,6 +53,21 @@ void RemoveDynamicDebugLog(const std::string& location_relative, int line);
 
 const LogEntryContentSet& GetDynamicDebugLocations();
 
+struct LogRateLimit {
+  bool enabled{false};
+  std::size_t max_messages_per_second{100};
+  std::size_t max_burst{1000};
+};
+
+/// Sets the per-location token bucket for the LOG_* macros, the logs that
+/// do not fit into the bucket are dropped and counted. The buckets are
+/// refilled only if the settings change.
+void SetLogRateLimit(const LogRateLimit& rate_limit);
+
+/// Writes "suppressed N messages from file:line" for each location with the
+/// logs dropped by the rate limit since the previous call
+void LogSuppressedMessages();
+
 }  // namespace logging
 
 USERVER_NAMESPACE_END
@@ -83,4 +83,28 @@ TEST_F(LoggingTest, DynamicDebugAnyLineRemove) {
   logging::SetDefaultLoggerLevel(logging::Level::kInfo);
 }
 
+TEST_F(LoggingTest, RateLimit) {
+  logging::LogRateLimit rate_limit;
+  rate_limit.enabled = true;
+  rate_limit.max_messages_per_second = 1;
+  rate_limit.max_burst = 2;
+  logging::SetLogRateLimit(rate_limit);
+
+  for (int i = 0; i < 5; ++i) {
+#line 30001
+    LOG_INFO() << "limited " << i;
+  }
+  logging::LogSuppressedMessages();
+  logging::SetLogRateLimit({});
+  LOG_INFO() << "after";
+
+  EXPECT_TRUE(LoggedTextContains("limited 0"));
+  EXPECT_TRUE(LoggedTextContains("limited 1"));
+  EXPECT_FALSE(LoggedTextContains("limited 2"));
+  EXPECT_TRUE(LoggedTextContains(
+      "suppressed 3 messages from " + std::string{USERVER_FILEPATH} +
+      ":30001"));
+  EXPECT_TRUE(LoggedTextContains("after"));
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <logging/binary_format.hpp>
+#include <logging/logging_test.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/logging/log_extra.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace binary = logging::impl::binary;
+
+class LoggingBinaryTest : public DefaultLoggerFixture {
+ protected:
+  LoggingBinaryTest() {
+    SetDefaultLogger(MakeNamedStreamLogger(
+        "test-binary-logger", sstream_, logging::Format::kBinary));
+  }
+
+  std::vector<std::string> ReadRecords() {
+    logging::LogFlush();
+    std::istringstream in(sstream_.str());
+
+    std::vector<std::string> records;
+    std::string buffer;
+    while (binary::ReadRecord(in, buffer)) records.push_back(buffer);
+    return records;
+  }
+
+ private:
+  std::ostringstream sstream_;
+};
+
+}  // namespace
+
+TEST_F(LoggingBinaryTest, Fields) {
+  LOG_WARNING() << "text\twith\nspecial=chars"
+                << logging::LogExtra{{"some.key", 42}};
+
+  const auto records = ReadRecords();
+  ASSERT_EQ(records.size(), 1);
+
+  const auto record = binary::ParseRecord(records.front());
+  EXPECT_EQ(record.level, logging::Level::kWarning);
+
+  std::vector<std::string_view> keys;
+  for (const auto& field : record.fields) keys.push_back(field.key);
+  const std::vector<std::string_view> expected_keys{
+      "module", "task_id", "thread_id", "text", "some.key"};
+  EXPECT_EQ(keys, expected_keys);
+
+  EXPECT_EQ(record.fields[3].value, "text\twith\nspecial=chars");
+  EXPECT_EQ(record.fields[4].value, "42");
+}
+
+TEST_F(LoggingBinaryTest, RenderTskv) {
+  LOG_ERROR() << "text\twith\nspecial=chars"
+              << logging::LogExtra{{"some.key", "value"}};
+
+  const auto records = ReadRecords();
+  ASSERT_EQ(records.size(), 1);
+
+  std::string line;
+  binary::RenderRecord(binary::ParseRecord(records.front()),
+                       logging::Format::kTskv, line);
+
+  EXPECT_EQ(line.rfind("tskv\ttimestamp=", 0), 0) << line;
+  EXPECT_NE(line.find("\tlevel=ERROR\tmodule="), std::string::npos) << line;
+  EXPECT_NE(line.find("\ttext=text\\twith\\nspecial=chars\t"),
+            std::string::npos)
+      << line;
+  EXPECT_NE(line.find("\tsome_key=value\n"), std::string::npos) << line;
+  EXPECT_EQ(line.find('\n'), line.size() - 1) << line;
+}
+
+TEST(LoggingBinary, UnstructuredPayload) {
+  std::ostringstream out;
+  auto logger =
+      MakeNamedStreamLogger("test-binary-raw", out, logging::Format::kBinary);
+  logger->ptr->info("access\tlog line");
+  logger->ptr->flush();
+
+  std::istringstream in(out.str());
+  std::string buffer;
+  ASSERT_TRUE(binary::ReadRecord(in, buffer));
+
+  const auto record = binary::ParseRecord(buffer);
+  ASSERT_EQ(record.fields.size(), 1);
+  EXPECT_EQ(record.fields[0].key, "text");
+  EXPECT_EQ(record.fields[0].value, "access\tlog line");
+
+  std::string line;
+  binary::RenderRecord(record, logging::Format::kRaw, line);
+  EXPECT_EQ(line, "text=access\\tlog line\n");
+
+  EXPECT_FALSE(binary::ReadRecord(in, buffer));
+}
+
+USERVER_NAMESPACE_END
@@ -71,7 +71,7 @@ LogExtra::LogExtra(std::initializer_list<Pair> initial,
 }
 
 void LogExtra::Extend(std::string key, Value value, ExtendType extend_type) {
-  Extend(std::move(key),
+  Extend(StoredKey{std::move(key)},
          ProtectedValue(std::move(value), extend_type == ExtendType::kFrozen),
          extend_type);
 }
@@ -80,6 +80,12 @@ void LogExtra::Extend(Pair extra, ExtendType extend_type) {
   Extend(std::move(extra.first), std::move(extra.second), extend_type);
 }
 
+void LogExtra::Extend(StaticKey key, Value value, ExtendType extend_type) {
+  Extend(StoredKey{key},
+         ProtectedValue(std::move(value), extend_type == ExtendType::kFrozen),
+         extend_type);
+}
+
 void LogExtra::Extend(std::initializer_list<Pair> extra,
                       ExtendType extend_type) {
   ExtendRange(extra.begin(), extra.end(), extend_type);
@@ -117,17 +123,15 @@ LogExtra LogExtra::Stacktrace(const logging::LoggerPtr& logger) noexcept {
   return GetStacktrace(logger, {});
 }
 
-const std::pair<LogExtra::Key, LogExtra::ProtectedValue>* LogExtra::Find(
-    std::string_view key) const {
+const LogExtra::MapItem* LogExtra::Find(std::string_view key) const {
   for (const auto& it : *extra_)
-    if (it.first == key) return &it;
+    if (it.first.GetView() == key) return &it;
   return nullptr;
 }
 
-std::pair<LogExtra::Key, LogExtra::ProtectedValue>* LogExtra::Find(
-    std::string_view key) {
+LogExtra::MapItem* LogExtra::Find(std::string_view key) {
   for (auto& it : *extra_)
-    if (it.first == key) return &it;
+    if (it.first.GetView() == key) return &it;
   return nullptr;
 }
 
@@ -145,14 +149,14 @@ const LogExtra::Value& LogExtra::GetValue(std::string_view key) const {
   return it->second.GetValue();
 }
 
-void LogExtra::Extend(std::string key, ProtectedValue protected_value,
+void LogExtra::Extend(StoredKey key, ProtectedValue protected_value,
                       ExtendType extend_type) {
   UINVARIANT(
-      !kTechnicalKeys.Contains(key),
+      !kTechnicalKeys.Contains(key.GetView()),
       fmt::format("'{}' is one of the [{}] technical keys. Overwrite would "
                   "produce incorrect logs",
-                  key, kTechnicalKeys.Describe()));
-  auto* it = Find(key);
+                  key.GetView(), kTechnicalKeys.Describe()));
+  auto* it = Find(key.GetView());
   if (!it) {
     extra_->emplace_back(
         std::move(key),
@@ -1,7 +1,11 @@
 #include "log_helper_impl.hpp"
 
+#include <cstdint>
+#include <limits>
+
 #include <logging/spdlog.hpp>
 
+#include <logging/binary_format.hpp>
 #include <logging/logger_with_info.hpp>
 
 #include <userver/utils/assert.hpp>
@@ -19,6 +23,12 @@ class PutCharFmtBuffer final {
   void operator()(fmt::basic_memory_buffer<char, Size>& to, char ch) const {
     to.push_back(ch);
   }
+
+  template <size_t Size>
+  void operator()(fmt::basic_memory_buffer<char, Size>& to, const char* first,
+                  const char* last) const {
+    to.append(first, last);
+  }
 };
 
 char GetSeparatorFromLogger(const LoggerPtr& logger_ptr) {
@@ -31,6 +41,7 @@ char GetSeparatorFromLogger(const LoggerPtr& logger_ptr) {
   switch (logger.format) {
     case Format::kTskv:
     case Format::kRaw:
+    case Format::kBinary:
       return '=';
     case Format::kLtsv:
       return ':';
@@ -39,6 +50,10 @@ char GetSeparatorFromLogger(const LoggerPtr& logger_ptr) {
   UINVARIANT(false, "Invalid logging::Format enum value");
 }
 
+bool IsBinaryLogger(const LoggerPtr& logger_ptr) {
+  return logger_ptr && logger_ptr->format == Format::kBinary;
+}
+
 }  // namespace
 
 LogHelper::Impl::int_type LogHelper::Impl::BufferStd::overflow(int_type c) {
@@ -56,37 +71,35 @@ std::streamsize LogHelper::Impl::BufferStd::xsputn(const char_type* s,
 LogHelper::Impl::Impl(LoggerPtr logger, Level level) noexcept
     : logger_(std::move(logger)),
       level_(level),
-      key_value_separator_(GetSeparatorFromLogger(logger_)) {
+      key_value_separator_(GetSeparatorFromLogger(logger_)),
+      is_binary_(IsBinaryLogger(logger_)) {
   static_assert(sizeof(LogHelper::Impl) < 4096,
                 "Structures with size more than 4096 would consume at least "
                 "8KB memory in allocator.");
+  if (is_binary_) msg_.push_back(impl::binary::kStructuredPayloadMarker);
 }
 
 std::streamsize LogHelper::Impl::xsputn(const char_type* s, std::streamsize n) {
+  if (is_binary_) {
+    // escaping is deferred to the rendering of the binary records
+    msg_.append(s, s + n);
+    return n;
+  }
+
   switch (encode_mode_) {
     case Encode::kNone:
       msg_.append(s, s + n);
       break;
     case Encode::kValue:
-      if (!utils::encoding::ShouldValueBeEscaped({s, static_cast<size_t>(n)})) {
-        msg_.append(s, s + n);
-      } else {
-        msg_.reserve(msg_.size() + n);
-
-        utils::encoding::EncodeTskv(msg_, s, s + n,
-                                    utils::encoding::EncodeTskvMode::kValue,
-                                    PutCharFmtBuffer{});
-      }
+      // clean runs are appended at once
+      utils::encoding::EncodeTskv(msg_, s, s + n,
+                                  utils::encoding::EncodeTskvMode::kValue,
+                                  PutCharFmtBuffer{});
       break;
     case Encode::kKeyReplacePeriod:
-      if (!utils::encoding::ShouldKeyBeEscaped({s, static_cast<size_t>(n)})) {
-        msg_.append(s, s + n);
-      } else {
-        msg_.reserve(msg_.size() + n);
-        utils::encoding::EncodeTskv(
-            msg_, s, s + n, utils::encoding::EncodeTskvMode::kKeyReplacePeriod,
-            PutCharFmtBuffer{});
-      }
+      utils::encoding::EncodeTskv(
+          msg_, s, s + n, utils::encoding::EncodeTskvMode::kKeyReplacePeriod,
+          PutCharFmtBuffer{});
       break;
   }
 
@@ -96,6 +109,11 @@ std::streamsize LogHelper::Impl::xsputn(const char_type* s, std::streamsize n) {
 LogHelper::Impl::int_type LogHelper::Impl::overflow(int_type c) {
   if (c == std::streambuf::traits_type::eof()) return c;
 
+  if (is_binary_) {
+    msg_.push_back(c);
+    return c;
+  }
+
   switch (encode_mode_) {
     case Encode::kNone:
       msg_.push_back(c);
@@ -124,11 +142,44 @@ LogHelper::Impl::LazyInitedStream& LogHelper::Impl::GetLazyInitedStream() {
   return *lazy_stream_;
 }
 
-void LogHelper::Impl::LogTheMessage() const {
+void LogHelper::Impl::PutKey(std::string_view key) {
+  UASSERT(encode_mode_ == Encode::kNone);
+
+  if (is_binary_) {
+    FinishBinaryValue();
+    key = key.substr(0, std::numeric_limits<std::uint16_t>::max());
+    impl::binary::AppendLittleEndian(msg_,
+                                     static_cast<std::uint16_t>(key.size()));
+    msg_.append(key.data(), key.data() + key.size());
+    binary_value_size_offset_ = msg_.size();
+    impl::binary::AppendLittleEndian(msg_, std::uint32_t{0});
+    return;
+  }
+
+  if (msg_.size() != 0) msg_.push_back(utils::encoding::kTskvPairsSeparator);
+  encode_mode_ = Encode::kKeyReplacePeriod;
+  xsputn(key.data(), key.size());
+  encode_mode_ = Encode::kNone;
+  msg_.push_back(key_value_separator_);
+}
+
+void LogHelper::Impl::FinishBinaryValue() {
+  if (binary_value_size_offset_ == 0) return;
+
+  const auto value_begin = binary_value_size_offset_ + sizeof(std::uint32_t);
+  impl::binary::StoreLittleEndian(
+      msg_.data() + binary_value_size_offset_,
+      static_cast<std::uint32_t>(msg_.size() - value_begin));
+  binary_value_size_offset_ = 0;
+}
+
+void LogHelper::Impl::LogTheMessage() {
   if (IsBroken()) {
     return;
   }
 
+  FinishBinaryValue();
+
   UASSERT(logger_);
   std::string_view message(msg_.data(), msg_.size());
   logger_->ptr->log(static_cast<spdlog::level::level_enum>(level_), message);
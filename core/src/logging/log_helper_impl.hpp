@@ -2,6 +2,7 @@
 
 #include <optional>
 #include <ostream>
+#include <string_view>
 
 #include <fmt/format.h>
 
@@ -37,9 +38,10 @@ class LogHelper::Impl final {
   std::streamsize xsputn(const char_type* s, std::streamsize n);
   int_type overflow(int_type c);
 
-  void PutKeyValueSeparator() { xsputn(&key_value_separator_, 1); }
+  /// Starts a new key-value pair, the value is written by the following calls
+  void PutKey(std::string_view key);
 
-  void LogTheMessage() const;
+  void LogTheMessage();
 
   void MarkTextBegin();
   size_t TextSize() const { return msg_.size() - initial_length_; }
@@ -69,16 +71,21 @@ class LogHelper::Impl final {
 
   LazyInitedStream& GetLazyInitedStream();
 
+  // Writes the size of the last value for Format::kBinary
+  void FinishBinaryValue();
+
   static constexpr size_t kOptimalBufferSize = 1500;
 
   LoggerPtr logger_;
   const Level level_;
   const char key_value_separator_;
+  const bool is_binary_;
   Encode encode_mode_{Encode::kNone};
   fmt::basic_memory_buffer<char, kOptimalBufferSize> msg_;
   std::optional<LazyInitedStream> lazy_stream_;
   LogExtra extra_;
   size_t initial_length_{0};
+  size_t binary_value_size_offset_{0};
 };
 
 }  // namespace logging
@@ -4,6 +4,8 @@
 #include <userver/logging/logger.hpp>
 
 #include <ostream>
+#include <string>
+#include <string_view>
 
 #include <utils/gbench_auxilary.hpp>
 
@@ -73,6 +75,40 @@ BENCHMARK_REGISTER_F(LogHelperBenchmark, LogCheck)
     ->Range(8, 8 << 10)
     ->Complexity();
 
+// Tags of a typical span, the keys do not fit into the SSO buffer
+constexpr std::string_view kLogExtraKeys[] = {
+    "http_status_code", "stopwatch_name_tag", "db_statement_name",
+    "peer_address_tag", "request_method_tag", "handler_path_tag",
+};
+
+template <typename MakeKey>
+logging::LogExtra MakeLogExtra(MakeKey make_key) {
+  logging::LogExtra extra;
+  for (const auto key : kLogExtraKeys) extra.Extend(make_key(key), 42);
+  return extra;
+}
+
+// Logs the tags of a span that also has child spans, so they are copied
+BENCHMARK_DEFINE_F(LogHelperBenchmark, LogExtraStringKeys)
+(benchmark::State& state) {
+  const auto extra =
+      MakeLogExtra([](std::string_view key) { return std::string{key}; });
+  for (auto _ : state) {
+    LOG_INFO() << extra;
+  }
+}
+BENCHMARK_REGISTER_F(LogHelperBenchmark, LogExtraStringKeys);
+
+BENCHMARK_DEFINE_F(LogHelperBenchmark, LogExtraStaticKeys)
+(benchmark::State& state) {
+  const auto extra = MakeLogExtra(
+      [](std::string_view key) { return logging::LogExtra::StaticKey{key}; });
+  for (auto _ : state) {
+    LOG_INFO() << extra;
+  }
+}
+BENCHMARK_REGISTER_F(LogHelperBenchmark, LogExtraStaticKeys);
+
 struct StreamedStruct {
   int64_t intVal;
   std::string stringVal;
@@ -79,6 +79,21 @@ TEST_F(LoggingTest, TskvEncodeKeyWithDot) {
               testing::HasSubstr("line 1\\nline 2\thttp_port_ipv4=4040"));
 }
 
+TEST_F(LoggingTest, LogExtraStaticKey) {
+  static constexpr logging::LogExtra::StaticKey kKey{"static_key_out_of_sso"};
+
+  logging::LogExtra le;
+  le.Extend(kKey, 1);
+  le.Extend("static_key_out_of_sso", 2);
+  le.Extend(kKey, 3, logging::LogExtra::ExtendType::kFrozen);
+  le.Extend("static_key_out_of_sso", 4);
+
+  const auto copy = le;
+  LOG_CRITICAL() << copy;
+  EXPECT_THAT(GetStreamString(),
+              testing::HasSubstr("\tstatic_key_out_of_sso=3\n"));
+}
+
 TEST_F(LoggingTest, FloatingPoint) {
   constexpr float f = 3.1415F;
   EXPECT_EQ(ToStringViaLogging(f), ToStringViaStreams(f));
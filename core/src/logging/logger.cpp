@@ -30,7 +30,7 @@ LoggerPtr MakeSimpleLogger(const std::string& name, spdlog::sink_ptr sink,
       format, std::shared_ptr<spdlog::details::thread_pool>{},
       std::move(spdlog_logger));
 
-  logger->ptr->set_pattern(GetSpdlogPattern(format));
+  SetSpdlogFormat(*logger->ptr, format, GetSpdlogPattern(format));
   logger->ptr->set_level(level);
   logger->ptr->flush_on(level);
   return logger;
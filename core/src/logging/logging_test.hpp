@@ -19,7 +19,8 @@ inline logging::LoggerPtr MakeLoggerFromSink(
   auto logger = std::make_shared<logging::impl::LoggerWithInfo>(
       format, std::shared_ptr<spdlog::details::thread_pool>{},
       utils::MakeSharedRef<spdlog::logger>(logger_name, sink_ptr));
-  logger->ptr->set_pattern(logging::GetSpdlogPattern(format));
+  logging::SetSpdlogFormat(*logger->ptr, format,
+                           logging::GetSpdlogPattern(format));
   logger->ptr->set_level(spdlog::level::level_enum::info);
   return logger;
 }
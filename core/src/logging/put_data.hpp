@@ -3,7 +3,6 @@
 #include <logging/log_helper_impl.hpp>
 #include <userver/logging/log_helper.hpp>
 #include <userver/utils/encoding/hex.hpp>
-#include <userver/utils/encoding/tskv.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -11,13 +10,7 @@ namespace logging {
 
 template <typename T>
 void PutData(LogHelper& lh, std::string_view key, const T& value) {
-  lh.Put(utils::encoding::kTskvPairsSeparator);
-  {
-    logging::LogHelper::EncodingGuard guard{
-        lh, logging::LogHelper::Encode::kKeyReplacePeriod};
-    lh.Put(key);
-  }
-  lh.pimpl_->PutKeyValueSeparator();
+  lh.pimpl_->PutKey(key);
   lh << value;
 }
 
@@ -1,5 +1,8 @@
 #include <logging/spdlog_helpers.hpp>
 
+#include <spdlog/logger.h>
+
+#include <logging/binary_format.hpp>
 #include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -19,12 +22,22 @@ const std::string& GetSpdlogPattern(Format format) {
     case Format::kLtsv:
       return kSpdlogLtsvPattern;
     case Format::kRaw:
+    case Format::kBinary:
       return kSpdlogRawPattern;
   }
 
   UINVARIANT(false, "Invalid logging::Format enum value");
 }
 
+void SetSpdlogFormat(spdlog::logger& logger, Format format,
+                     const std::string& pattern) {
+  if (format == Format::kBinary) {
+    logger.set_formatter(std::make_unique<impl::binary::Formatter>());
+  } else {
+    logger.set_pattern(pattern);
+  }
+}
+
 }  // namespace logging
 
 USERVER_NAMESPACE_END
@@ -2,6 +2,10 @@
 
 #include <string>
 
+// this header must be included before any spdlog headers
+// to override spdlog's level names
+#include <logging/spdlog.hpp>
+
 #include <userver/logging/format.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -10,6 +14,11 @@ namespace logging {
 
 const std::string& GetSpdlogPattern(Format format);
 
+/// Sets the `pattern` for the text formats and the binary formatter for
+/// Format::kBinary
+void SetSpdlogFormat(spdlog::logger& logger, Format format,
+                     const std::string& pattern);
+
 }  // namespace logging
 
 USERVER_NAMESPACE_END
@@ -83,6 +83,14 @@ std::string to_string(const boost::stacktrace::stacktrace& st) {
   return res;
 }
 
+std::string frame_to_string(const void* address) {
+  if (!stacktrace_enabled.load()) {
+    return "<unknown>";
+  }
+
+  return ToStringCachedFiltered(boost::stacktrace::frame{address});
+}
+
 bool GlobalEnableStacktrace(bool enable) {
   return stacktrace_enabled.exchange(enable);
 }
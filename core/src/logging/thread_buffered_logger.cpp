@@ -0,0 +1,309 @@
+#include <logging/thread_buffered_logger.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+#include <compiler/tls.hpp>
+#include <userver/concurrent/impl/interference_shield.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/thread_name.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+namespace {
+
+// Bounds the latency of flushes while the queues are never empty
+constexpr std::size_t kMaxBatchSize = 1024;
+
+// The writer is woken up by the producers, the timeout is a safety net
+constexpr std::chrono::milliseconds kMaxSleepTime{100};
+
+std::atomic<std::uint64_t> next_logger_id{0};
+
+struct Record {
+  std::uint64_t sequence{0};
+  spdlog::details::log_msg msg;
+  std::string payload;
+};
+
+}  // namespace
+
+// Single producer single consumer ring of records. The records keep the memory
+// of their payloads, so no allocations happen once the queue is warmed up.
+class ThreadLogQueue final {
+ public:
+  explicit ThreadLogQueue(std::size_t size) : records_(size), mask_(size - 1) {
+    UASSERT_MSG(size != 0 && (size & mask_) == 0,
+                "log queue size must be a power of 2");
+  }
+
+  // Producer side
+
+  bool HasSpace() const {
+    return write_->load(std::memory_order_relaxed) -
+               read_->load(std::memory_order_acquire) <
+           records_.size();
+  }
+
+  void Push(const spdlog::details::log_msg& msg, std::uint64_t sequence) {
+    const auto write = write_->load(std::memory_order_relaxed);
+    auto& record = records_[write & mask_];
+    record.sequence = sequence;
+    record.payload.assign(msg.payload.data(), msg.payload.size());
+    record.msg = msg;
+    record.msg.payload = {record.payload.data(), record.payload.size()};
+    write_->store(write + 1, std::memory_order_release);
+  }
+
+  void CountDropped() {
+    dropped_.store(dropped_.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_relaxed);
+  }
+
+  void MarkAbandoned() { is_abandoned_ = true; }
+
+  // Consumer side
+
+  const Record* Front() const {
+    const auto read = read_->load(std::memory_order_relaxed);
+    if (read == write_->load(std::memory_order_acquire)) return nullptr;
+    return &records_[read & mask_];
+  }
+
+  void Pop() {
+    read_->store(read_->load(std::memory_order_relaxed) + 1,
+                 std::memory_order_release);
+  }
+
+  bool IsAbandoned() const { return is_abandoned_; }
+
+  // Any thread
+
+  std::uint64_t GetSize() const {
+    const auto read = read_->load(std::memory_order_relaxed);
+    const auto write = write_->load(std::memory_order_relaxed);
+    return write > read ? write - read : 0;
+  }
+
+  std::uint64_t GetDropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::vector<Record> records_;
+  const std::size_t mask_;
+  concurrent::impl::InterferenceShield<std::atomic<std::uint64_t>> write_{0};
+  concurrent::impl::InterferenceShield<std::atomic<std::uint64_t>> read_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<bool> is_abandoned_{false};
+};
+
+namespace {
+
+struct ThreadQueueRef {
+  std::uint64_t logger_id;
+  ThreadLogQueue* queue;
+  std::weak_ptr<ThreadLogQueue> owner;
+};
+
+// The queues of the current thread, marked as abandoned on thread exit so
+// that the loggers could remove them once they are drained
+struct ThreadQueueRefs final {
+  ~ThreadQueueRefs() {
+    for (const auto& ref : refs) {
+      if (auto queue = ref.owner.lock()) queue->MarkAbandoned();
+    }
+  }
+
+  std::vector<ThreadQueueRef> refs;
+};
+
+thread_local ThreadQueueRefs thread_queue_refs;
+
+}  // namespace
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const LogQueueStatistics& stats) {
+  writer["dropped"] = stats.dropped;
+  writer["queued"] = stats.queued;
+}
+
+ThreadBufferedLogger::ThreadBufferedLogger(std::string name,
+                                           spdlog::sink_ptr sink,
+                                           std::size_t queue_size,
+                                           OverflowBehavior overflow_behavior)
+    : spdlog::logger(std::move(name), std::move(sink)),
+      id_(next_logger_id++),
+      queue_size_(queue_size),
+      overflow_behavior_(overflow_behavior),
+      writer_([this] { Run(); }) {}
+
+ThreadBufferedLogger::~ThreadBufferedLogger() {
+  {
+    std::lock_guard lock(mutex_);
+    is_stopping_ = true;
+  }
+  wake_up_.notify_one();
+  writer_.join();
+}
+
+LogQueueStatistics ThreadBufferedLogger::GetQueueStatistics() const {
+  std::lock_guard lock(mutex_);
+  LogQueueStatistics stats;
+  stats.dropped = dropped_by_removed_queues_;
+  for (const auto& queue : queues_) {
+    stats.dropped += queue->GetDropped();
+    stats.queued += queue->GetSize();
+  }
+  return stats;
+}
+
+void ThreadBufferedLogger::sink_it_(const spdlog::details::log_msg& msg) {
+  auto& queue = GetThreadQueue();
+  if (!queue.HasSpace()) {
+    if (overflow_behavior_ == OverflowBehavior::kDiscard) {
+      queue.CountDropped();
+      return;
+    }
+    while (!queue.HasSpace()) std::this_thread::yield();
+  }
+
+  // Only this thread pushes to the queue, so there is still space for the
+  // message. The sequence is taken right before the push, the writer waits
+  // for the messages that have taken it but are not pushed yet.
+  queue.Push(msg, next_sequence_.fetch_add(1, std::memory_order_relaxed));
+  WakeUpWriter();
+}
+
+void ThreadBufferedLogger::flush_() {
+  is_flush_requested_ = true;
+  WakeUpWriter();
+}
+
+USERVER_PREVENT_TLS_CACHING ThreadLogQueue&
+ThreadBufferedLogger::GetThreadQueue() {
+  auto& refs = thread_queue_refs.refs;
+  for (const auto& ref : refs) {
+    if (ref.logger_id == id_) return *ref.queue;
+  }
+
+  // The first message of this thread, forget the loggers that are gone
+  refs.erase(std::remove_if(refs.begin(), refs.end(),
+                            [](const auto& ref) { return ref.owner.expired(); }),
+             refs.end());
+
+  auto queue = std::make_shared<ThreadLogQueue>(queue_size_);
+  refs.push_back({id_, queue.get(), queue});
+  {
+    std::lock_guard lock(mutex_);
+    queues_.push_back(queue);
+    ++queues_version_;
+  }
+  return *queue;
+}
+
+void ThreadBufferedLogger::WakeUpWriter() {
+  // Pairs with the fence in Sleep(), either the writer sees the new state
+  // or we see that it is going to sleep
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (is_writer_sleeping_.load(std::memory_order_relaxed)) {
+    std::lock_guard lock(mutex_);
+    wake_up_.notify_one();
+  }
+}
+
+void ThreadBufferedLogger::Run() {
+  utils::SetCurrentThreadName("log/" + name());
+
+  Queues queues;
+  std::uint64_t version = 0;
+
+  while (true) {
+    if (version != queues_version_.load()) {
+      std::lock_guard lock(mutex_);
+      queues = queues_;
+      version = queues_version_;
+    }
+
+    const auto written = WriteRecords(queues);
+    if (is_flush_requested_.exchange(false)) spdlog::logger::flush_();
+    if (written != 0) continue;
+
+    if (next_written_sequence_ != next_sequence_.load()) {
+      // A message has taken its sequence but is not pushed yet
+      std::this_thread::yield();
+      continue;
+    }
+
+    if (is_stopping_) break;
+
+    RemoveAbandonedQueues();
+    Sleep();
+  }
+
+  spdlog::logger::flush_();
+}
+
+std::size_t ThreadBufferedLogger::WriteRecords(const Queues& queues) {
+  std::size_t written = 0;
+  std::size_t current = 0;
+
+  while (written < kMaxBatchSize) {
+    // The messages of one thread usually go in a row
+    const Record* record =
+        current < queues.size() ? queues[current]->Front() : nullptr;
+
+    if (!record || record->sequence != next_written_sequence_) {
+      record = nullptr;
+      for (std::size_t i = 0; i < queues.size(); ++i) {
+        const auto* front = queues[i]->Front();
+        if (front && front->sequence == next_written_sequence_) {
+          record = front;
+          current = i;
+          break;
+        }
+      }
+      if (!record) break;
+    }
+
+    // Writes to the sinks, flush_on level requests a flush via flush_()
+    spdlog::logger::sink_it_(record->msg);
+    queues[current]->Pop();
+    ++next_written_sequence_;
+    ++written;
+  }
+
+  return written;
+}
+
+void ThreadBufferedLogger::Sleep() {
+  std::unique_lock lock(mutex_);
+  is_writer_sleeping_.store(true, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  const bool has_work = is_stopping_ || is_flush_requested_ ||
+                        next_written_sequence_ != next_sequence_.load();
+  if (!has_work) wake_up_.wait_for(lock, kMaxSleepTime);
+
+  is_writer_sleeping_.store(false, std::memory_order_relaxed);
+}
+
+void ThreadBufferedLogger::RemoveAbandonedQueues() {
+  std::lock_guard lock(mutex_);
+  const auto it = std::remove_if(
+      queues_.begin(), queues_.end(), [this](const auto& queue) {
+        if (!queue->IsAbandoned() || queue->Front()) return false;
+        dropped_by_removed_queues_ += queue->GetDropped();
+        return true;
+      });
+  if (it == queues_.end()) return;
+
+  queues_.erase(it, queues_.end());
+  ++queues_version_;
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// this header must be included before any spdlog headers
+// to override spdlog's level names
+#include <logging/spdlog.hpp>
+
+#include <spdlog/logger.h>
+
+#include <logging/config.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+class ThreadLogQueue;
+
+struct LogQueueStatistics {
+  std::uint64_t dropped{0};
+  std::uint64_t queued{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const LogQueueStatistics& stats);
+
+/// @brief Asynchronous logger with a queue for each thread that writes to it.
+///
+/// The threads do not contend on a shared queue. The dedicated thread takes
+/// the messages from all the queues in the order they were logged and writes
+/// them to the sinks in batches, flushing the sinks once per batch.
+class ThreadBufferedLogger final : public spdlog::logger {
+ public:
+  using OverflowBehavior = LoggerConfig::QueueOveflowBehavior;
+
+  /// @param queue_size the size of the queue of each thread, a power of 2
+  ThreadBufferedLogger(std::string name, spdlog::sink_ptr sink,
+                       std::size_t queue_size,
+                       OverflowBehavior overflow_behavior);
+
+  /// Writes all the queued messages and flushes the sinks
+  ~ThreadBufferedLogger() override;
+
+  LogQueueStatistics GetQueueStatistics() const;
+
+ protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override;
+
+  /// Requests a flush of the sinks from the writing thread
+  void flush_() override;
+
+ private:
+  using Queues = std::vector<std::shared_ptr<ThreadLogQueue>>;
+
+  ThreadLogQueue& GetThreadQueue();
+  void WakeUpWriter();
+
+  void Run();
+  std::size_t WriteRecords(const Queues& queues);
+  void Sleep();
+  void RemoveAbandonedQueues();
+
+  const std::uint64_t id_;
+  const std::size_t queue_size_;
+  const OverflowBehavior overflow_behavior_;
+
+  std::atomic<std::uint64_t> next_sequence_{0};
+  std::uint64_t next_written_sequence_{0};
+
+  mutable std::mutex mutex_;
+  std::condition_variable wake_up_;
+  Queues queues_;
+  std::uint64_t dropped_by_removed_queues_{0};
+  std::atomic<std::uint64_t> queues_version_{0};
+
+  std::atomic<bool> is_writer_sleeping_{false};
+  std::atomic<bool> is_flush_requested_{false};
+  std::atomic<bool> is_stopping_{false};
+
+  std::thread writer_;
+};
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
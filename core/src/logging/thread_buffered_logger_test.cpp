@@ -0,0 +1,133 @@
+#include <logging/thread_buffered_logger.hpp>
+
+#include <cstdio>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <spdlog/sinks/base_sink.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using logging::impl::ThreadBufferedLogger;
+using OverflowBehavior = ThreadBufferedLogger::OverflowBehavior;
+
+class RecordingSink final : public spdlog::sinks::base_sink<std::mutex> {
+ public:
+  explicit RecordingSink(std::shared_future<void> unblocked = {})
+      : unblocked_(std::move(unblocked)) {}
+
+  std::vector<std::string> GetMessages() {
+    std::lock_guard lock(mutex_);
+    return messages_;
+  }
+
+  std::size_t GetFlushes() {
+    std::lock_guard lock(mutex_);
+    return flushes_;
+  }
+
+ protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override {
+    if (unblocked_.valid()) unblocked_.wait();
+    messages_.emplace_back(msg.payload.data(), msg.payload.size());
+  }
+
+  void flush_() override { ++flushes_; }
+
+ private:
+  std::shared_future<void> unblocked_;
+  std::vector<std::string> messages_;
+  std::size_t flushes_{0};
+};
+
+}  // namespace
+
+TEST(ThreadBufferedLogger, KeepsOrder) {
+  constexpr int kThreads = 4;
+  constexpr int kMessages = 10000;
+
+  auto sink = std::make_shared<RecordingSink>();
+  {
+    ThreadBufferedLogger logger("test", sink, 16, OverflowBehavior::kBlock);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+      threads.emplace_back([&logger, i] {
+        for (int j = 0; j < kMessages; ++j) {
+          logger.info("{} {}", i, j);
+        }
+      });
+    }
+    for (auto& thread : threads) thread.join();
+
+    // the messages of a thread are written after the messages of another
+    // thread that it waited for
+    logger.info("last");
+  }
+
+  const auto messages = sink->GetMessages();
+  ASSERT_EQ(messages.size(), kThreads * kMessages + 1);
+  EXPECT_EQ(messages.back(), "last");
+
+  std::vector<int> next(kThreads, 0);
+  for (std::size_t i = 0; i + 1 < messages.size(); ++i) {
+    int thread = 0;
+    int message = 0;
+    ASSERT_EQ(std::sscanf(messages[i].c_str(), "%d %d", &thread, &message), 2);
+    ASSERT_EQ(message, next[thread]) << "thread " << thread;
+    ++next[thread];
+  }
+}
+
+TEST(ThreadBufferedLogger, DiscardsOnOverflow) {
+  std::promise<void> unblock;
+  auto sink = std::make_shared<RecordingSink>(unblock.get_future().share());
+  {
+    ThreadBufferedLogger logger("test", sink, 4, OverflowBehavior::kDiscard);
+    for (int i = 0; i < 10; ++i) logger.info("{}", i);
+
+    const auto stats = logger.GetQueueStatistics();
+    EXPECT_EQ(stats.dropped, 6);
+    EXPECT_EQ(stats.queued, 4);
+
+    unblock.set_value();
+  }
+
+  const std::vector<std::string> expected{"0", "1", "2", "3"};
+  EXPECT_EQ(sink->GetMessages(), expected);
+}
+
+TEST(ThreadBufferedLogger, Flush) {
+  auto sink = std::make_shared<RecordingSink>();
+  ThreadBufferedLogger logger("test", sink, 16, OverflowBehavior::kDiscard);
+  logger.flush_on(spdlog::level::warn);
+
+  logger.warn("flushed");
+  while (sink->GetFlushes() == 0) std::this_thread::yield();
+  EXPECT_EQ(sink->GetMessages(), std::vector<std::string>{"flushed"});
+
+  logger.info("written on flush");
+  logger.flush();
+  while (sink->GetFlushes() < 2) std::this_thread::yield();
+  EXPECT_EQ(sink->GetMessages().size(), 2);
+}
+
+TEST(ThreadBufferedLogger, ExitedThreads) {
+  auto sink = std::make_shared<RecordingSink>();
+  {
+    ThreadBufferedLogger logger("test", sink, 4, OverflowBehavior::kBlock);
+    for (int i = 0; i < 100; ++i) {
+      std::thread([&logger, i] { logger.info("{}", i); }).join();
+    }
+    EXPECT_EQ(logger.GetQueueStatistics().dropped, 0);
+  }
+  EXPECT_EQ(sink->GetMessages().size(), 100);
+}
+
+USERVER_NAMESPACE_END
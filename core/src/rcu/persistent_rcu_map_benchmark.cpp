@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/rcu/persistent_rcu_map.hpp>
+#include <userver/rcu/rcu_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+template <typename Map>
+void rcu_map_insert_erase(benchmark::State& state) {
+  const auto size = static_cast<std::int64_t>(state.range(0));
+
+  engine::RunStandalone([&] {
+    Map map;
+    for (std::int64_t i = 0; i < size; ++i) *map[i] = i;
+
+    std::int64_t i = 0;
+    for (auto _ : state) {
+      // Replaces the oldest key, so that the size stays the same
+      map.Erase(i);
+      *map[i + size] = i;
+      ++i;
+    }
+  });
+}
+BENCHMARK_TEMPLATE(rcu_map_insert_erase,
+                   rcu::RcuMap<std::int64_t, std::int64_t>)
+    ->RangeMultiplier(8)
+    ->Range(8, 32768);
+BENCHMARK_TEMPLATE(rcu_map_insert_erase,
+                   rcu::PersistentRcuMap<std::int64_t, std::int64_t>)
+    ->RangeMultiplier(8)
+    ->Range(8, 32768);
+
+template <typename Map>
+void rcu_map_get(benchmark::State& state) {
+  const auto size = static_cast<std::int64_t>(state.range(0));
+
+  engine::RunStandalone([&] {
+    Map map;
+    for (std::int64_t i = 0; i < size; ++i) *map[i] = i;
+
+    std::int64_t i = 0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(map.Get(i++ % size));
+    }
+  });
+}
+BENCHMARK_TEMPLATE(rcu_map_get, rcu::RcuMap<std::int64_t, std::int64_t>)
+    ->RangeMultiplier(8)
+    ->Range(8, 32768);
+BENCHMARK_TEMPLATE(rcu_map_get,
+                   rcu::PersistentRcuMap<std::int64_t, std::int64_t>)
+    ->RangeMultiplier(8)
+    ->Range(8, 32768);
+
+USERVER_NAMESPACE_END
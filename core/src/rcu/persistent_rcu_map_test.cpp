@@ -0,0 +1,250 @@
+#include <userver/utest/utest.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/rcu/persistent_rcu_map.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Puts every key into one of a few buckets to get full hash collisions
+struct CollidingHash final {
+  std::size_t operator()(int key) const noexcept {
+    return static_cast<std::size_t>(key % 7) * 0x9E3779B97F4A7C15ULL;
+  }
+};
+
+template <typename Map>
+std::map<int, int> ToStdMap(const Map& map) {
+  std::map<int, int> result;
+  for (const auto& [key, value] : map) {
+    EXPECT_TRUE(result.emplace(key, *value).second) << "duplicate " << key;
+  }
+  return result;
+}
+
+}  // namespace
+
+UTEST(PersistentRcuMap, Empty) {
+  rcu::PersistentRcuMap<std::string, int> map;
+  const auto& cmap = map;
+
+  EXPECT_EQ(0, map.SizeApprox());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(cmap.begin(), cmap.end());
+  auto snap = map.GetSnapshot();
+  map.Clear();
+  EXPECT_EQ(snap, map.GetSnapshot());
+}
+
+UTEST(PersistentRcuMap, Modify) {
+  rcu::PersistentRcuMap<std::string, int> map;
+  const auto& cmap = map;
+
+  UEXPECT_THROW(cmap["any"], rcu::MissingKeyException);
+  EXPECT_FALSE(map.Get("any"));
+  EXPECT_FALSE(cmap.Get("any"));
+  EXPECT_FALSE(map.Erase("any"));
+  EXPECT_FALSE(map.Pop("any"));
+
+  UEXPECT_NO_THROW(*map["any"] = 1);
+
+  EXPECT_EQ(1, *cmap["any"]);
+  EXPECT_EQ(1, *map.Get("any"));
+  EXPECT_EQ(1, *cmap.Get("any"));
+  EXPECT_TRUE(map.Erase("any"));
+  EXPECT_FALSE(map.Erase("any"));
+  EXPECT_FALSE(map.Pop("any"));
+
+  UEXPECT_NO_THROW(*map["any"] = 2);
+  EXPECT_EQ(2, *map.Pop("any"));
+  EXPECT_FALSE(map.Pop("any"));
+
+  EXPECT_TRUE(map.Insert("any", std::make_shared<int>(3)).inserted);
+  EXPECT_FALSE(map.Insert("any", std::make_shared<int>(0)).inserted);
+  EXPECT_EQ(*map.Insert("any", std::make_shared<int>(0)).value, 3);
+  EXPECT_EQ(*cmap["any"], 3);
+  EXPECT_EQ(*map.Pop("any"), 3);
+
+  EXPECT_TRUE(map.Emplace("any", 4).inserted);
+  EXPECT_FALSE(map.Emplace("any", 0).inserted);
+  EXPECT_EQ(*map.Emplace("any", 0).value, 4);
+  EXPECT_EQ(*cmap["any"], 4);
+  EXPECT_EQ(*map.Pop("any"), 4);
+  EXPECT_EQ(0, map.SizeApprox());
+}
+
+UTEST(PersistentRcuMap, InsertOrAssign) {
+  rcu::PersistentRcuMap<std::string, int> map;
+
+  map.InsertOrAssign("foo", std::make_shared<int>(10));
+  EXPECT_EQ(*map["foo"], 10);
+
+  map.InsertOrAssign("foo", std::make_shared<int>(20));
+  EXPECT_EQ(*map["foo"], 20);
+  EXPECT_EQ(1, map.SizeApprox());
+}
+
+UTEST(PersistentRcuMap, Snapshot) {
+  rcu::PersistentRcuMap<std::string, int> map;
+
+  const auto empty_snap = map.GetSnapshot();
+  EXPECT_TRUE(empty_snap.empty());
+
+  *map["a"] = 1;
+
+  const auto first_snap = map.GetSnapshot();
+  EXPECT_TRUE(empty_snap.empty());
+  ASSERT_TRUE(first_snap.count("a"));
+  EXPECT_EQ(1, *first_snap.at("a"));
+
+  *map["a"] = *map["b"] = 2;
+
+  const auto second_snap = map.GetSnapshot();
+  EXPECT_EQ(1, first_snap.size());
+  EXPECT_EQ(2, *first_snap.at("a"));
+  ASSERT_EQ(2, second_snap.size());
+  EXPECT_EQ(2, *second_snap.at("a"));
+  EXPECT_EQ(2, *second_snap.at("b"));
+}
+
+UTEST(PersistentRcuMap, ManyKeys) {
+  constexpr int kKeys = 10'000;
+  rcu::PersistentRcuMap<int, int> map;
+  std::map<int, int> expected;
+
+  for (int i = 0; i < kKeys; ++i) {
+    EXPECT_TRUE(map.Emplace(i, i).inserted);
+    expected.emplace(i, i);
+  }
+  EXPECT_EQ(kKeys, map.SizeApprox());
+  EXPECT_EQ(expected, ToStdMap(map));
+
+  for (int i = 0; i < kKeys; i += 2) {
+    ASSERT_TRUE(map.Erase(i));
+    expected.erase(i);
+  }
+  EXPECT_EQ(kKeys / 2, map.SizeApprox());
+  EXPECT_EQ(expected, ToStdMap(map));
+
+  for (int i = 0; i < kKeys; ++i) {
+    const auto value = map.Get(i);
+    ASSERT_EQ(i % 2 == 1, static_cast<bool>(value)) << i;
+    if (value) {
+      EXPECT_EQ(i, *value);
+    }
+  }
+
+  for (int i = 1; i < kKeys; i += 2) ASSERT_TRUE(map.Erase(i));
+  EXPECT_EQ(0, map.SizeApprox());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+UTEST(PersistentRcuMap, HashCollisions) {
+  constexpr int kKeys = 100;
+  rcu::PersistentRcuMap<int, int, CollidingHash> map;
+  std::map<int, int> expected;
+
+  for (int i = 0; i < kKeys; ++i) {
+    *map[i] = i;
+    expected.emplace(i, i);
+  }
+  EXPECT_EQ(expected, ToStdMap(map));
+
+  map.InsertOrAssign(42, std::make_shared<int>(-42));
+  expected[42] = -42;
+  EXPECT_EQ(-42, *map.Get(42));
+
+  // Empties some of the collision buckets completely
+  for (int i = 0; i < kKeys; ++i) {
+    if (i % 7 < 3 || i % 3 == 0) {
+      ASSERT_TRUE(map.Erase(i));
+      expected.erase(i);
+    }
+  }
+  EXPECT_EQ(expected.size(), map.SizeApprox());
+  EXPECT_EQ(expected, ToStdMap(map));
+
+  for (int i = 0; i < kKeys; ++i) {
+    EXPECT_EQ(expected.count(i) == 1, static_cast<bool>(map.Get(i))) << i;
+  }
+}
+
+UTEST(PersistentRcuMap, SnapshotIsPersistent) {
+  rcu::PersistentRcuMap<int, int> map;
+  for (int i = 0; i < 1000; ++i) *map[i] = i;
+
+  // The iterator holds on to the version of the keyset it started with
+  auto it = map.begin();
+  map.Clear();
+  EXPECT_EQ(map.begin(), map.end());
+
+  std::size_t count = 0;
+  for (; it != map.end(); ++it) ++count;
+  EXPECT_EQ(1000, count);
+}
+
+UTEST_MT(PersistentRcuMap, ConcurrentUpdates, 4) {
+  rcu::PersistentRcuMap<int, std::atomic<uint32_t>> map;
+  std::array<engine::TaskWithResult<void>, 4> workers;
+  std::atomic<bool> stop_flag{false};
+
+  for (size_t i = 0; i < workers.size(); ++i) {
+    workers[i] = utils::Async("writer", [i, &map, &stop_flag] {
+      const uint32_t mask = 0xFFu << (i * 8);
+      while (!stop_flag) {
+        *map[i << 8] = -1;
+        for (uint8_t v = 1; v != 0; ++v) {
+          ASSERT_TRUE(map.Get((i << 8) + v - 1));
+
+          const auto prev_shr = map[-1]->fetch_and(~mask);
+          ASSERT_EQ(v - 1, (prev_shr & mask) >> (i * 8));
+
+          ASSERT_TRUE(map.Erase((i << 8) + v - 1));
+
+          const auto cleared_shr = map[-1]->fetch_or(uint32_t{v} << (i * 8));
+          ASSERT_EQ(0, cleared_shr & mask);
+
+          *map[(i << 8) + v] = -1;
+        }
+        ASSERT_EQ(mask, map[-1]->fetch_and(~mask) & mask);
+        ASSERT_TRUE(map.Erase((i << 8) + 0xFF));
+      }
+    });
+  }
+
+  engine::SleepFor(std::chrono::milliseconds(100));
+  stop_flag = true;
+  for (auto& w : workers) w.Get();
+
+  EXPECT_TRUE(map.Erase(-1));
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+UTEST(PersistentRcuMap, SamplePersistentRcuMapVariable) {
+  /// [Sample rcu::PersistentRcuMap usage]
+  struct Data {
+    // Access to PersistentRcuMap content must be synchronized via std::atomic
+    // or other synchronization primitives
+    std::atomic<int> x{0};
+  };
+  rcu::PersistentRcuMap<std::string, Data> map;
+
+  // Insertion copies only a few trie nodes, even for a big map
+  map["123"]->x++;
+  map["other_data"]->x = 42;
+  ASSERT_EQ(map["123"]->x.load(), 1);
+  ASSERT_EQ(map["other_data"]->x.load(), 42);
+  ASSERT_TRUE(map.Erase("123"));
+  ASSERT_FALSE(map.Get("123"));
+  /// [Sample rcu::PersistentRcuMap usage]
+}
+
+USERVER_NAMESPACE_END
@@ -53,6 +53,34 @@ BENCHMARK_TEMPLATE(rcu_write, 1);
 BENCHMARK_TEMPLATE(rcu_write, 2);
 BENCHMARK_TEMPLATE(rcu_write, 4);
 
+template <rcu::Reclamation Reclamation>
+void rcu_write_while_reading(benchmark::State& state) {
+  const std::size_t kept_readable_pointers_count = state.range(0);
+
+  engine::RunStandalone([&] {
+    rcu::Variable<std::uint64_t, Reclamation> var{
+        rcu::DestructionType::kSync, 0};
+
+    std::queue<rcu::ReadablePtr<std::uint64_t, Reclamation>> pointers;
+    for (std::size_t i = 0; i < kept_readable_pointers_count; i++) {
+      pointers.push(var.Read());
+    }
+
+    std::uint64_t i = 0;
+    for (auto _ : state) {
+      pointers.pop();
+      pointers.push(var.Read());
+      var.Assign(++i);
+    }
+  });
+}
+BENCHMARK_TEMPLATE(rcu_write_while_reading, rcu::Reclamation::kHazardPointers)
+    ->RangeMultiplier(4)
+    ->Range(1, 1024);
+BENCHMARK_TEMPLATE(rcu_write_while_reading, rcu::Reclamation::kEpochs)
+    ->RangeMultiplier(4)
+    ->Range(1, 1024);
+
 void rcu_contention(benchmark::State& state) {
   const std::size_t readers_count = state.range(0);
   const std::size_t writers_count = state.range(1);
@@ -448,6 +448,86 @@ UTEST_MT(Rcu, TortureTest, kTotalTasks) {
   keep_running = false;
 }
 
+UTEST(Rcu, EpochsLifetime) {
+  using Counted = Counted<struct EpochsLifetimeTag>;
+  rcu::Variable<Counted, rcu::Reclamation::kEpochs> ptr(
+      rcu::DestructionType::kSync);
+  EXPECT_EQ(1, Counted::counter);
+
+  {
+    auto reader = ptr.Read();
+    ptr.Emplace();
+    EXPECT_EQ(2, Counted::counter);
+
+    // the value retired after the reader started is kept as well
+    ptr.Emplace();
+    EXPECT_EQ(3, Counted::counter);
+    EXPECT_EQ(1, reader->value);
+  }
+  EXPECT_EQ(3, Counted::counter);
+
+  ptr.Cleanup();
+  EXPECT_EQ(1, Counted::counter);
+
+  {
+    auto old_reader = ptr.Read();
+    ptr.Emplace();
+    auto new_reader = ptr.Read();
+    ptr.Emplace();
+    EXPECT_EQ(3, Counted::counter);
+
+    old_reader = ptr.Read();
+    ptr.Emplace();
+    // only the value retired before new_reader started is freed
+    EXPECT_EQ(3, Counted::counter);
+  }
+
+  ptr.Emplace();
+  EXPECT_EQ(1, Counted::counter);
+}
+
+UTEST_MT(Rcu, EpochsTortureTest, kTotalTasks) {
+  rcu::Variable<CleaningUpInt, rcu::Reclamation::kEpochs> data{1};
+  std::atomic<bool> keep_running{true};
+
+  engine::Mutex ping_pong_mutex;
+  auto ptr = data.Read();
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+
+  for (std::size_t i = 0; i < kReadablePtrPingPongTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        std::lock_guard lock(ping_pong_mutex);
+        // copy a ptr created by another thread
+        ptr = rcu::ReadablePtr{ptr};
+        ASSERT_GT(ptr->value, 0);
+      }
+    }));
+  }
+
+  for (std::size_t i = 0; i < kReadingTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        const auto local_ptr = data.Read();
+        ASSERT_GT(local_ptr->value, 0);
+      }
+    }));
+  }
+
+  for (std::size_t i = 0; i < kWritingTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        const auto old = data.Read();
+        data.Assign(CleaningUpInt{old->value + 1});
+      }
+    }));
+  }
+
+  engine::SleepFor(std::chrono::milliseconds{100});
+  keep_running = false;
+}
+
 UTEST(Rcu, WritablePtrUnlocksInCommit) {
   rcu::Variable<int> var{1};
 
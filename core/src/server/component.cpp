@@ -24,11 +24,16 @@ Server::Server(const components::ComponentConfig& component_config,
       "http.handler.total", [this](utils::statistics::Writer& writer) {
         return server_->WriteTotalHandlerStatistics(writer);
       });
+  listener_statistics_holder_ = statistics_storage.RegisterWriter(
+      "server.listener", [this](utils::statistics::Writer& writer) {
+        return server_->WriteListenerStatistics(writer);
+      });
 }
 
 Server::~Server() {
   server_statistics_holder_.Unregister();
   handler_statistics_holder_.Unregister();
+  listener_statistics_holder_.Unregister();
 }
 
 void Server::OnAllComponentsLoaded() { server_->Start(); }
@@ -137,9 +142,40 @@ properties:
                         type: integer
                         description: timeout in seconds to drop connection if there's not data received from it
                         defaultDescription: 600
+                    request_parser:
+                        type: string
+                        description: |
+                            HTTP/1.x request parser implementation.
+                            `simd` scans the request head with SSE4.2 if the
+                            CPU supports it.
+                        defaultDescription: http-parser
+                        enum:
+                          - http-parser
+                          - simd
+                    http2_enabled:
+                        type: boolean
+                        description: serve HTTP/2 without TLS (h2c) to the clients that start the connection with the HTTP/2 preface
+                        defaultDescription: false
+                    http2_max_concurrent_streams:
+                        type: integer
+                        description: max count of concurrent HTTP/2 streams per connection
+                        defaultDescription: 100
+                    http2_header_table_size:
+                        type: integer
+                        description: size in bytes of the HPACK dynamic tables for HTTP/2 headers
+                        defaultDescription: 4096
+                    http2_initial_window_size:
+                        type: integer
+                        description: initial size in bytes of the HTTP/2 stream flow control window
+                        defaultDescription: 65535
             shards:
                 type: integer
-                description: how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing
+                description: how many listening SO_REUSEPORT sockets to open, each one with its own accepting coroutine; do not set if not sure what it is doing
+                defaultDescription: count of the event threads
+            cpu_steering:
+                type: boolean
+                description: "Linux only: pass each new connection to the socket number `CPU % shards`, where `CPU` is the one that received the SYN"
+                defaultDescription: false
     listener-monitor:
         type: object
         description: describes the special monitoring socket, used for getting statistics and processing utility requests that should succeed even is the main socket is under heavy pressure
@@ -181,6 +217,16 @@ properties:
                         type: integer
                         description: timeout in seconds to drop connection if there's not data received from it
                         defaultDescription: 600
+                    request_parser:
+                        type: string
+                        description: |
+                            HTTP/1.x request parser implementation.
+                            `simd` scans the request head with SSE4.2 if the
+                            CPU supports it.
+                        defaultDescription: http-parser
+                        enum:
+                          - http-parser
+                          - simd
             handler-defaults:
                 type: object
                 description: handler defaults options
@@ -200,11 +246,20 @@ properties:
                         description: optional field to parse request according to x-www-form-urlencoded rules and make parameters accessible as query parameters
             shards:
                 type: integer
-                description: how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing
+                description: how many listening SO_REUSEPORT sockets to open, each one with its own accepting coroutine; do not set if not sure what it is doing
+                defaultDescription: count of the event threads
+            cpu_steering:
+                type: boolean
+                description: "Linux only: pass each new connection to the socket number `CPU % shards`, where `CPU` is the one that received the SYN"
+                defaultDescription: false
     set-response-server-hostname:
         type: boolean
         description: set to true to add the `X-YaTaxi-Server-Hostname` header with instance name, set to false to not add the header
         defaultDescription: false
+    handoff-socket:
+        type: string
+        description: path of a unix socket to pass the listening sockets over to the next instance of the service on restart; do not set to disable the handoff
+        defaultDescription: ''
 )");
 }
 
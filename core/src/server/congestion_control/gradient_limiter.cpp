@@ -0,0 +1,166 @@
+#include <server/congestion_control/gradient_limiter.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::congestion_control {
+
+namespace {
+
+constexpr std::int64_t kMicrosecondsPerSample = 10;
+
+// Fewer samples give a too noisy percentile, the window is extended then
+constexpr std::uint32_t kMinWindowSamples = 10;
+
+// The baseline is an exponential average over about this count of windows
+constexpr double kBaselineWindows = 30;
+
+// Share of the new estimation in the limit, damps the oscillations
+constexpr double kSmoothing = 0.2;
+
+constexpr double kMinGradient = 0.5;
+
+}  // namespace
+
+GradientLimiter::GradientLimiter(
+    const handlers::AdaptiveConcurrencyConfig& config, Clock::time_point now)
+    : config_(config),
+      limit_(config.initial_limit),
+      next_update_((now + config.window).time_since_epoch().count()),
+      estimated_limit_(config.initial_limit) {}
+
+bool GradientLimiter::TryAcquire(handlers::RequestPriority priority) noexcept {
+  std::size_t current = in_flight_.load(std::memory_order_relaxed);
+  if (priority == handlers::RequestPriority::kCritical) {
+    current = in_flight_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    auto limit = limit_.load(std::memory_order_relaxed);
+    auto* rejected = &rejected_normal_;
+    if (priority == handlers::RequestPriority::kLow) {
+      limit = limit * config_.low_priority_percent / 100;
+      rejected = &rejected_low_;
+    }
+
+    do {
+      if (current >= limit) {
+        ++*rejected;
+        return false;
+      }
+    } while (!in_flight_.compare_exchange_weak(current, current + 1,
+                                               std::memory_order_relaxed));
+  }
+
+  auto max_in_flight = max_in_flight_.load(std::memory_order_relaxed);
+  while (max_in_flight <= current &&
+         !max_in_flight_.compare_exchange_weak(max_in_flight, current + 1,
+                                               std::memory_order_relaxed)) {
+  }
+  return true;
+}
+
+void GradientLimiter::Release(std::chrono::microseconds latency,
+                              Clock::time_point now) noexcept {
+  in_flight_.fetch_sub(1, std::memory_order_relaxed);
+  samples_.Account(std::max<std::int64_t>(latency.count(), 0) /
+                   kMicrosecondsPerSample);
+
+  if (now.time_since_epoch().count() <
+      next_update_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  // Only one of the concurrent requests recalculates the limit
+  if (is_updating_.exchange(true, std::memory_order_acquire)) return;
+  Update(now);
+  is_updating_.store(false, std::memory_order_release);
+}
+
+void GradientLimiter::ReleaseWithoutSample() noexcept {
+  in_flight_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void GradientLimiter::Update(Clock::time_point now) noexcept {
+  if (samples_.Count() < kMinWindowSamples) return;
+  next_update_.store((now + config_.window).time_since_epoch().count(),
+                     std::memory_order_relaxed);
+
+  // The samples that are accounted during the reset may be lost, that is fine
+  const auto latency =
+      std::max(1.0, static_cast<double>(
+                        samples_.GetPercentile(config_.percentile)));
+  samples_.Reset();
+
+  if (baseline_latency_ == 0) {
+    baseline_latency_ = latency;
+  } else {
+    baseline_latency_ += (latency - baseline_latency_) / kBaselineWindows;
+  }
+  // The latency dropped and stays low, e.g. a slow dependency recovered
+  if (baseline_latency_ > latency * 2) baseline_latency_ *= 0.95;
+
+  const auto max_in_flight = max_in_flight_.exchange(
+      in_flight_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  const auto gradient = std::clamp(
+      config_.tolerance * baseline_latency_ / latency, kMinGradient, 1.0);
+
+  // Do not grow the limit that is not reached by the load, otherwise the
+  // limit is far above the sustainable concurrency when the load comes
+  const bool is_load_limited =
+      static_cast<double>(max_in_flight) * 2 < estimated_limit_;
+  if (gradient < 1.0 || !is_load_limited) {
+    const auto new_limit =
+        estimated_limit_ * gradient + std::sqrt(estimated_limit_);
+    estimated_limit_ = std::clamp(
+        estimated_limit_ * (1 - kSmoothing) + new_limit * kSmoothing,
+        static_cast<double>(config_.min_limit),
+        static_cast<double>(config_.max_limit));
+  }
+
+  limit_.store(std::lround(estimated_limit_), std::memory_order_relaxed);
+  latency_us_.store(std::llround(latency * kMicrosecondsPerSample),
+                    std::memory_order_relaxed);
+  baseline_latency_us_.store(
+      std::llround(baseline_latency_ * kMicrosecondsPerSample),
+      std::memory_order_relaxed);
+}
+
+std::uint64_t GradientLimiter::GetRejected(
+    handlers::RequestPriority priority) const noexcept {
+  switch (priority) {
+    case handlers::RequestPriority::kLow:
+      return rejected_low_.load();
+    case handlers::RequestPriority::kNormal:
+      return rejected_normal_.load();
+    case handlers::RequestPriority::kCritical:
+      return 0;
+  }
+  return 0;
+}
+
+std::chrono::microseconds GradientLimiter::GetLatency() const noexcept {
+  return std::chrono::microseconds{latency_us_.load()};
+}
+
+std::chrono::microseconds GradientLimiter::GetBaselineLatency()
+    const noexcept {
+  return std::chrono::microseconds{baseline_latency_us_.load()};
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const GradientLimiter& limiter) {
+  writer["limit"] = limiter.GetLimit();
+  writer["in-flight"] = limiter.GetInFlight();
+  writer["latency-us"] = limiter.GetLatency().count();
+  writer["baseline-latency-us"] = limiter.GetBaselineLatency().count();
+  writer["rejected"].ValueWithLabels(
+      limiter.GetRejected(handlers::RequestPriority::kLow),
+      {"priority", "low"});
+  writer["rejected"].ValueWithLabels(
+      limiter.GetRejected(handlers::RequestPriority::kNormal),
+      {"priority", "normal"});
+}
+
+}  // namespace server::congestion_control
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <userver/server/handlers/handler_config.hpp>
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::congestion_control {
+
+/// @brief Concurrency limiter of a handler that follows its latency
+///
+/// Every window the percentile of the latency is compared with its long term
+/// baseline. While the latency stays in the tolerance the limit grows by the
+/// square root of itself (the allowed queue), otherwise it is multiplied by
+/// the gradient baseline / latency, so the limit converges to the concurrency
+/// the handler sustains without queueing.
+class GradientLimiter final {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit GradientLimiter(const handlers::AdaptiveConcurrencyConfig& config,
+                           Clock::time_point now = Clock::now());
+
+  /// @returns true if the request is admitted, it should be released then
+  bool TryAcquire(handlers::RequestPriority priority) noexcept;
+
+  /// Releases the admitted request and accounts its latency
+  void Release(std::chrono::microseconds latency,
+               Clock::time_point now = Clock::now()) noexcept;
+
+  /// Releases the admitted request that should not affect the limit, e.g.
+  /// a failed one
+  void ReleaseWithoutSample() noexcept;
+
+  std::size_t GetLimit() const noexcept { return limit_.load(); }
+
+  std::size_t GetInFlight() const noexcept { return in_flight_.load(); }
+
+  std::uint64_t GetRejected(handlers::RequestPriority priority) const noexcept;
+
+  std::chrono::microseconds GetLatency() const noexcept;
+
+  std::chrono::microseconds GetBaselineLatency() const noexcept;
+
+ private:
+  // in units of 10us: precise up to 10ms, then up to ~1s by 1ms
+  using Percentile = utils::statistics::Percentile<1000, std::uint32_t, 1000,
+                                                   100>;
+
+  void Update(Clock::time_point now) noexcept;
+
+  const handlers::AdaptiveConcurrencyConfig config_;
+
+  std::atomic<std::size_t> limit_;
+  std::atomic<std::size_t> in_flight_{0};
+  std::atomic<std::size_t> max_in_flight_{0};
+  std::atomic<std::uint64_t> rejected_low_{0};
+  std::atomic<std::uint64_t> rejected_normal_{0};
+
+  Percentile samples_;
+  std::atomic<Clock::rep> next_update_;
+  std::atomic<bool> is_updating_{false};
+
+  // guarded by is_updating_
+  double estimated_limit_;
+  double baseline_latency_{0};
+
+  std::atomic<std::int64_t> latency_us_{0};
+  std::atomic<std::int64_t> baseline_latency_us_{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const GradientLimiter& limiter);
+
+}  // namespace server::congestion_control
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,115 @@
+#include <server/congestion_control/gradient_limiter.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::congestion_control::GradientLimiter;
+using server::handlers::RequestPriority;
+
+constexpr std::chrono::milliseconds kWindow{100};
+
+server::handlers::AdaptiveConcurrencyConfig MakeConfig() {
+  server::handlers::AdaptiveConcurrencyConfig config;
+  config.min_limit = 5;
+  config.max_limit = 200;
+  config.initial_limit = 20;
+  config.window = kWindow;
+  return config;
+}
+
+// Runs a window where `concurrency` requests of `latency` are in flight
+void RunWindow(GradientLimiter& limiter,
+               GradientLimiter::Clock::time_point& now, std::size_t concurrency,
+               std::chrono::microseconds latency) {
+  now += kWindow;
+  std::size_t admitted = 0;
+  for (std::size_t i = 0; i < concurrency; ++i) {
+    if (limiter.TryAcquire(RequestPriority::kNormal)) ++admitted;
+  }
+  for (std::size_t i = 0; i < admitted; ++i) limiter.Release(latency, now);
+}
+
+}  // namespace
+
+TEST(GradientLimiter, Admission) {
+  const auto config = MakeConfig();
+  GradientLimiter limiter{config};
+  EXPECT_EQ(limiter.GetLimit(), 20);
+
+  for (int i = 0; i < 16; ++i) {
+    EXPECT_TRUE(limiter.TryAcquire(RequestPriority::kLow));
+  }
+  // 80% of the limit is for the low priority requests
+  EXPECT_FALSE(limiter.TryAcquire(RequestPriority::kLow));
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(limiter.TryAcquire(RequestPriority::kNormal));
+  }
+  EXPECT_FALSE(limiter.TryAcquire(RequestPriority::kNormal));
+  EXPECT_TRUE(limiter.TryAcquire(RequestPriority::kCritical));
+
+  EXPECT_EQ(limiter.GetInFlight(), 21);
+  EXPECT_EQ(limiter.GetRejected(RequestPriority::kLow), 1);
+  EXPECT_EQ(limiter.GetRejected(RequestPriority::kNormal), 1);
+
+  limiter.ReleaseWithoutSample();
+  EXPECT_EQ(limiter.GetInFlight(), 20);
+}
+
+TEST(GradientLimiter, GrowsUnderSteadyLatency) {
+  auto now = GradientLimiter::Clock::now();
+  GradientLimiter limiter{MakeConfig(), now};
+
+  for (int i = 0; i < 100; ++i) {
+    RunWindow(limiter, now, 1000, std::chrono::milliseconds{5});
+  }
+  EXPECT_EQ(limiter.GetLimit(), 200);
+  EXPECT_EQ(limiter.GetLatency(), std::chrono::milliseconds{5});
+  EXPECT_EQ(limiter.GetBaselineLatency(), std::chrono::milliseconds{5});
+}
+
+TEST(GradientLimiter, DoesNotGrowWithoutLoad) {
+  auto now = GradientLimiter::Clock::now();
+  GradientLimiter limiter{MakeConfig(), now};
+
+  // The load never reaches the half of the limit
+  for (int i = 0; i < 100; ++i) {
+    RunWindow(limiter, now, 9, std::chrono::milliseconds{5});
+    limiter.TryAcquire(RequestPriority::kNormal);
+    limiter.Release(std::chrono::milliseconds{5}, now);
+  }
+  EXPECT_EQ(limiter.GetLimit(), 20);
+}
+
+TEST(GradientLimiter, ShrinksOnLatencyGrowth) {
+  auto now = GradientLimiter::Clock::now();
+  GradientLimiter limiter{MakeConfig(), now};
+
+  for (int i = 0; i < 100; ++i) {
+    RunWindow(limiter, now, 1000, std::chrono::milliseconds{5});
+  }
+  ASSERT_EQ(limiter.GetLimit(), 200);
+
+  for (int i = 0; i < 10; ++i) {
+    RunWindow(limiter, now, 1000, std::chrono::milliseconds{50});
+  }
+  EXPECT_LT(limiter.GetLimit(), 100);
+  EXPECT_EQ(limiter.GetLatency(), std::chrono::milliseconds{50});
+}
+
+TEST(GradientLimiter, RespectsMinLimit) {
+  auto config = MakeConfig();
+  config.min_limit = 15;
+  auto now = GradientLimiter::Clock::now();
+  GradientLimiter limiter{config, now};
+
+  RunWindow(limiter, now, 1000, std::chrono::milliseconds{1});
+  for (int i = 0; i < 10; ++i) {
+    RunWindow(limiter, now, 1000, std::chrono::milliseconds{900});
+  }
+  EXPECT_EQ(limiter.GetLimit(), 15);
+}
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,6 @@
 #include "auth_checker_apikey.hpp"
 
-#include <userver/crypto/algorithm.hpp>
+#include <userver/crypto/hash.hpp>
 #include <userver/formats/parse/common_containers.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/logging/log.hpp>
@@ -32,13 +32,8 @@ const ApiKeysSet& GetApiKeysByType(const AuthCheckerSettings& settings,
   return it->second;
 }
 
-bool IsApiKeyAllowed(const std::string& api_key,
-                     const ApiKeysSet& allowed_keys) {
-  for (const auto& allowed_key : allowed_keys) {
-    if (crypto::algorithm::AreStringsEqualConstTime(api_key, allowed_key))
-      return true;
-  }
-  return false;
+std::string MakeApiKeyDigest(std::string_view api_key) {
+  return crypto::hash::Sha256(api_key, crypto::hash::OutputEncoding::kBinary);
 }
 
 }  // namespace
@@ -49,7 +44,7 @@ AuthCheckerApiKey::AuthCheckerApiKey(const HandlerAuthConfig& auth_config,
   const auto apikey_type =
       auth_config[kApiKeyType].As<std::optional<std::string>>();
   if (apikey_type) {
-    const auto& keys_set = GetApiKeysByType(settings, *apikey_type);
+    const auto& keys_set = GetApiKeyDigestsByType(settings, *apikey_type);
     for (auto method : http::kHandlerMethods)
       keys_by_method_[static_cast<int>(method)] = &keys_set;
   }
@@ -61,7 +56,8 @@ AuthCheckerApiKey::AuthCheckerApiKey(const HandlerAuthConfig& auth_config,
       auto method_idx = static_cast<int>(method);
       auto apikey_type_opt = apikey_type_by_method->apikey_type[method_idx];
       if (apikey_type_opt) {
-        const auto& keys_set = GetApiKeysByType(settings, *apikey_type_opt);
+        const auto& keys_set =
+            GetApiKeyDigestsByType(settings, *apikey_type_opt);
         keys_by_method_[method_idx] = &keys_set;
       }
     }
@@ -87,7 +83,7 @@ AuthCheckerApiKey::AuthCheckerApiKey(const HandlerAuthConfig& auth_config,
             std::string(USERVER_NAMESPACE::http::headers::kApiKey) + " header"};
   }
 
-  if (IsApiKeyAllowed(request_apikey, *allowed_keys)) {
+  if (allowed_keys->count(MakeApiKeyDigest(request_apikey))) {
     return AuthCheckResult{AuthCheckResult::Status::kOk,
                            std::string{"IsApiKeyAllowed: OK"}};
   }
@@ -100,7 +96,20 @@ AuthCheckerApiKey::AuthCheckerApiKey(const HandlerAuthConfig& auth_config,
           std::string(USERVER_NAMESPACE::http::headers::kApiKey) + " header"};
 }
 
-const ApiKeysSet* AuthCheckerApiKey::GetApiKeysForRequest(
+const AuthCheckerApiKey::ApiKeyDigestsSet&
+AuthCheckerApiKey::GetApiKeyDigestsByType(const AuthCheckerSettings& settings,
+                                          const std::string& apikey_type) {
+  auto [it, inserted] = digests_by_type_.try_emplace(apikey_type);
+  if (inserted) {
+    for (const auto& api_key : GetApiKeysByType(settings, apikey_type)) {
+      it->second.insert(MakeApiKeyDigest(api_key));
+    }
+  }
+  return it->second;
+}
+
+const AuthCheckerApiKey::ApiKeyDigestsSet*
+AuthCheckerApiKey::GetApiKeysForRequest(
     const http::HttpRequest& request) const {
   auto method_idx = static_cast<size_t>(request.GetMethod());
   if (method_idx >= keys_by_method_.size())
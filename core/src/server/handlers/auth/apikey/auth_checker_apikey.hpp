@@ -2,6 +2,9 @@
 
 #include <array>
 #include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <userver/yaml_config/yaml_config.hpp>
 
@@ -38,10 +41,20 @@ class AuthCheckerApiKey : public AuthCheckerBase {
       const yaml_config::YamlConfig& value,
       formats::parse::To<ApiKeyTypeByMethodSettings>);
 
-  const ApiKeysSet* GetApiKeysForRequest(
+  // SHA-256 digests of the allowed keys, the lookup of the digest of a
+  // request key takes a single hash table probe and does not reveal the
+  // allowed keys through the comparison timings
+  using ApiKeyDigestsSet = std::unordered_set<std::string>;
+
+  const ApiKeyDigestsSet& GetApiKeyDigestsByType(
+      const AuthCheckerSettings& settings, const std::string& apikey_type);
+
+  const ApiKeyDigestsSet* GetApiKeysForRequest(
       const http::HttpRequest& request) const;
 
-  std::array<const ApiKeysSet*, http::kHandlerMethodsMax + 1> keys_by_method_{};
+  std::unordered_map<std::string, ApiKeyDigestsSet> digests_by_type_;
+  std::array<const ApiKeyDigestsSet*, http::kHandlerMethodsMax + 1>
+      keys_by_method_{};
 };
 
 }  // namespace server::handlers::auth::apikey
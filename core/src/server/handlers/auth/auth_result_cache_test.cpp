@@ -0,0 +1,104 @@
+#include <userver/server/handlers/auth/auth_result_cache.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/server/handlers/auth/auth_checker_base.hpp>
+#include <userver/utils/mock_now.hpp>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::handlers::auth::AuthCheckResult;
+using server::handlers::auth::AuthResultCache;
+using server::handlers::auth::AuthResultCacheSettings;
+
+constexpr std::chrono::seconds kLifetime{10};
+
+AuthResultCacheSettings MakeSettings(std::chrono::milliseconds stale) {
+  AuthResultCacheSettings settings;
+  settings.ways = 1;
+  settings.way_size = 10;
+  settings.lifetime = kLifetime;
+  settings.stale_lifetime = stale;
+  return settings;
+}
+
+}  // namespace
+
+UTEST(AuthResultCache, Sample) {
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+  std::atomic<int> remote_calls{0};
+
+  /// [Sample AuthResultCache]
+  AuthResultCache<AuthCheckResult> cache{MakeSettings({})};
+  auto introspect = [&remote_calls](const std::string& token) {
+    // A call to the token introspection service goes here
+    ++remote_calls;
+    return token == "valid" ? AuthCheckResult{}
+                            : AuthCheckResult{
+                                  AuthCheckResult::Status::kForbidden};
+  };
+
+  const auto result = cache.Get("valid", introspect);
+  /// [Sample AuthResultCache]
+
+  EXPECT_EQ(result.status, AuthCheckResult::Status::kOk);
+  EXPECT_EQ(cache.Get("valid", introspect).status,
+            AuthCheckResult::Status::kOk);
+  EXPECT_EQ(cache.Get("invalid", introspect).status,
+            AuthCheckResult::Status::kForbidden);
+  EXPECT_EQ(remote_calls, 2);
+}
+
+UTEST(AuthResultCache, Expires) {
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+  AuthResultCache<int> cache{MakeSettings({})};
+
+  EXPECT_EQ(cache.Get("token", [](const std::string&) { return 1; }), 1);
+  EXPECT_EQ(cache.Get("token", [](const std::string&) { return 2; }), 1);
+
+  utils::datetime::MockSleep(kLifetime + std::chrono::seconds{1});
+  EXPECT_EQ(cache.Get("token", [](const std::string&) { return 3; }), 3);
+}
+
+UTEST(AuthResultCache, ServesStaleWhileRechecking) {
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+  AuthResultCache<int> cache{MakeSettings(kLifetime)};
+
+  EXPECT_EQ(cache.Get("token", [](const std::string&) { return 1; }), 1);
+  utils::datetime::MockSleep(kLifetime + std::chrono::seconds{1});
+
+  auto credential = std::make_shared<std::string>();
+  auto recheck = [credential](const std::string& token) {
+    *credential = token;
+    return 2;
+  };
+  EXPECT_EQ(cache.Get("token", recheck), 1);
+
+  // The stale result is returned until the background recheck completes
+  int value = 1;
+  for (int i = 0; i < 100 && value == 1; ++i) {
+    engine::Yield();
+    value = cache.Get("token", recheck);
+  }
+  EXPECT_EQ(value, 2);
+  // The recheck gets the credential itself, not its digest
+  EXPECT_EQ(*credential, "token");
+}
+
+UTEST(AuthResultCache, Invalidate) {
+  AuthResultCache<int> cache{MakeSettings({})};
+
+  EXPECT_EQ(cache.Get("token", [](const std::string&) { return 1; }), 1);
+  cache.Invalidate("token");
+  EXPECT_EQ(cache.Get("token", [](const std::string&) { return 2; }), 2);
+  EXPECT_EQ(cache.GetSizeApproximate(), 1);
+}
+
+USERVER_NAMESPACE_END
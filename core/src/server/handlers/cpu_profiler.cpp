@@ -0,0 +1,96 @@
+#include <userver/server/handlers/cpu_profiler.hpp>
+
+#include <fmt/format.h>
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/text.hpp>
+#include <userver/yaml_config/schema.hpp>
+#include <utils/cpu_profiler.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+namespace {
+
+std::string HandleStart(const http::HttpRequest& request) {
+  utils::cpu_profiler::Settings settings;
+  try {
+    if (request.HasArg("frequency")) {
+      settings.frequency =
+          utils::FromString<std::size_t>(request.GetArg("frequency"));
+    }
+    if (request.HasArg("max_samples")) {
+      settings.max_samples =
+          utils::FromString<std::size_t>(request.GetArg("max_samples"));
+    }
+  } catch (const std::exception& ex) {
+    request.SetResponseStatus(server::http::HttpStatus::kBadRequest);
+    return std::string{"invalid argument value: "} + ex.what();
+  }
+  if (request.HasArg("task_processor")) {
+    settings.task_processors =
+        utils::text::Split(request.GetArg("task_processor"), ",");
+  }
+
+  try {
+    utils::cpu_profiler::Start(settings);
+  } catch (const std::exception& ex) {
+    request.SetResponseStatus(server::http::HttpStatus::kConflict);
+    return ex.what();
+  }
+  LOG_WARNING() << "CPU profiler is started with frequency "
+                << settings.frequency;
+  return "OK\n";
+}
+
+std::string HandleStop(const http::HttpRequest& request) {
+  try {
+    auto profile = utils::cpu_profiler::Stop();
+    LOG_WARNING() << "CPU profiler is stopped, collected " << profile.samples
+                  << " samples, dropped " << profile.dropped_samples;
+    return std::move(profile.folded);
+  } catch (const std::exception& ex) {
+    request.SetResponseStatus(server::http::HttpStatus::kConflict);
+    return ex.what();
+  }
+}
+
+std::string HandleStatus() {
+  const auto status = utils::cpu_profiler::GetStatus();
+  if (!status.running) return "stopped\n";
+  return fmt::format("running, samples: {}, dropped samples: {}\n",
+                     status.samples, status.dropped_samples);
+}
+
+}  // namespace
+
+CpuProfiler::CpuProfiler(const components::ComponentConfig& config,
+                         const components::ComponentContext& component_context)
+    : HttpHandlerBase(config, component_context, /*is_monitor = */ true) {}
+
+std::string CpuProfiler::HandleRequestThrow(const http::HttpRequest& request,
+                                            request::RequestContext&) const {
+  const auto command = request.GetPathArg("command");
+  if (command == "start") {
+    return HandleStart(request);
+  } else if (command == "stop") {
+    return HandleStop(request);
+  } else if (command == "status") {
+    return HandleStatus();
+  } else {
+    request.SetResponseStatus(server::http::HttpStatus::kBadRequest);
+    return "Unsupported command";
+  }
+}
+
+yaml_config::Schema CpuProfiler::GetStaticConfigSchema() {
+  auto schema = HttpHandlerBase::GetStaticConfigSchema();
+  schema.UpdateDescription("handler-cpu-profiler config");
+  return schema;
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
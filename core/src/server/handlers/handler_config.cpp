@@ -1,10 +1,14 @@
 #include <userver/server/handlers/handler_config.hpp>
 
+#include <algorithm>
+#include <cstdint>
+
 #include <fmt/format.h>
 
 #include <server/server_config.hpp>
 
 #include <userver/formats/parse/common_containers.hpp>
+#include <userver/utils/keyed_rate_limiter.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -29,6 +33,110 @@ FallbackHandler Parse(const yaml_config::YamlConfig& yaml,
   return FallbackHandlerFromString(value);
 }
 
+ResponseCompressionConfig Parse(const yaml_config::YamlConfig& yaml,
+                                formats::parse::To<ResponseCompressionConfig>) {
+  ResponseCompressionConfig config;
+  config.min_size = yaml["min_size"].As<size_t>(config.min_size);
+  config.level = yaml["level"].As<int>(config.level);
+  if (config.level < 0 || config.level > 9) {
+    throw std::runtime_error(
+        fmt::format("compress_response.level should be from 0 to 9 at {}, "
+                    "current value is {}",
+                    yaml.GetPath(), config.level));
+  }
+  return config;
+}
+
+AdaptiveConcurrencyConfig Parse(const yaml_config::YamlConfig& yaml,
+                                formats::parse::To<AdaptiveConcurrencyConfig>) {
+  AdaptiveConcurrencyConfig config;
+  config.min_limit = yaml["min_limit"].As<size_t>(config.min_limit);
+  config.max_limit = yaml["max_limit"].As<size_t>(config.max_limit);
+  config.initial_limit =
+      yaml["initial_limit"].As<size_t>(std::max(config.min_limit,
+                                                config.initial_limit));
+  config.percentile = yaml["percentile"].As<double>(config.percentile);
+  config.window = std::chrono::milliseconds{
+      yaml["window_ms"].As<std::int64_t>(config.window.count())};
+  config.tolerance = yaml["tolerance"].As<double>(config.tolerance);
+  config.low_priority_percent =
+      yaml["low_priority_percent"].As<size_t>(config.low_priority_percent);
+
+  if (config.min_limit == 0 || config.min_limit > config.initial_limit ||
+      config.initial_limit > config.max_limit) {
+    throw std::runtime_error(fmt::format(
+        "adaptive_concurrency limits should satisfy 0 < min_limit <= "
+        "initial_limit <= max_limit at {}, current values are {}, {}, {}",
+        yaml.GetPath(), config.min_limit, config.initial_limit,
+        config.max_limit));
+  }
+  if (config.percentile <= 0 || config.percentile > 100) {
+    throw std::runtime_error(
+        fmt::format("adaptive_concurrency.percentile should be in (0, 100] at "
+                    "{}, current value is {}",
+                    yaml.GetPath(), config.percentile));
+  }
+  if (config.window.count() <= 0 || config.tolerance < 1 ||
+      config.low_priority_percent > 100) {
+    throw std::runtime_error(fmt::format(
+        "adaptive_concurrency should have positive window_ms, tolerance >= 1 "
+        "and low_priority_percent <= 100 at {}",
+        yaml.GetPath()));
+  }
+  return config;
+}
+
+StatsLabel Parse(const yaml_config::YamlConfig& yaml,
+                 formats::parse::To<StatsLabel>) {
+  const auto& value = yaml.As<std::string>();
+  if (value == "path") return StatsLabel::kPath;
+  if (value == "client") return StatsLabel::kClient;
+  if (value == "response-size") return StatsLabel::kResponseSize;
+  throw std::runtime_error(
+      fmt::format("can't parse StatsLabel from '{}' at {}, expected one of "
+                  "'path', 'client', 'response-size'",
+                  value, yaml.GetPath()));
+}
+
+LabeledStatsConfig Parse(const yaml_config::YamlConfig& yaml,
+                         formats::parse::To<LabeledStatsConfig>) {
+  LabeledStatsConfig config;
+  config.labels = yaml["labels"].As<std::vector<StatsLabel>>();
+  config.max_label_sets =
+      yaml["max_label_sets"].As<size_t>(config.max_label_sets);
+  config.client_header =
+      yaml["client_header"].As<std::string>(config.client_header);
+
+  if (config.labels.empty() || config.max_label_sets == 0) {
+    throw std::runtime_error(fmt::format(
+        "labeled_stats should have non-empty labels and positive "
+        "max_label_sets at {}",
+        yaml.GetPath()));
+  }
+  return config;
+}
+
+ClientRateLimitConfig Parse(const yaml_config::YamlConfig& yaml,
+                            formats::parse::To<ClientRateLimitConfig>) {
+  ClientRateLimitConfig config;
+  config.client_header =
+      yaml["client_header"].As<std::string>(config.client_header);
+  config.requests = yaml["requests"].As<size_t>();
+  config.window = std::chrono::milliseconds{
+      yaml["window_ms"].As<std::int64_t>(config.window.count())};
+  config.max_clients = yaml["max_clients"].As<size_t>(config.max_clients);
+
+  if (config.client_header.empty() || config.requests == 0 ||
+      config.requests > utils::KeyedRateLimiter::kMaxLimit ||
+      config.window.count() <= 0 || config.max_clients == 0) {
+    throw std::runtime_error(fmt::format(
+        "client_rate_limit should have non-empty client_header, requests in "
+        "[1, {}], positive window_ms and max_clients at {}",
+        utils::KeyedRateLimiter::kMaxLimit, yaml.GetPath()));
+  }
+  return config;
+}
+
 HandlerConfig ParseHandlerConfigsWithDefaults(
     const yaml_config::YamlConfig& value,
     const server::ServerConfig& server_config, bool is_monitor) {
@@ -81,11 +189,17 @@ HandlerConfig ParseHandlerConfigsWithDefaults(
   config.max_requests_per_second =
       value["max_requests_per_second"].As<std::optional<size_t>>();
   config.decompress_request = value["decompress_request"].As<bool>(false);
+  config.compress_response =
+      value["compress_response"].As<std::optional<ResponseCompressionConfig>>();
+  config.adaptive_concurrency =
+      value["adaptive_concurrency"]
+          .As<std::optional<AdaptiveConcurrencyConfig>>();
   config.throttling_enabled = value["throttling_enabled"].As<bool>(true);
   config.set_response_server_hostname =
       value["set-response-server-hostname"].As<std::optional<bool>>();
 
   config.response_body_stream = value["response-body-stream"].As<bool>(false);
+  config.request_body_stream = value["request-body-stream"].As<bool>(false);
 
   if (config.max_requests_per_second &&
       config.max_requests_per_second.value() <= 0) {
@@ -96,6 +210,11 @@ HandlerConfig ParseHandlerConfigsWithDefaults(
 
   config.set_tracing_headers = value["set_tracing_headers"].As<bool>(
       handler_defaults.set_tracing_headers);
+  config.scope_time_stats = value["scope_time_stats"].As<bool>(false);
+  config.labeled_stats =
+      value["labeled_stats"].As<std::optional<LabeledStatsConfig>>();
+  config.client_rate_limit =
+      value["client_rate_limit"].As<std::optional<ClientRateLimitConfig>>();
 
   return config;
 }
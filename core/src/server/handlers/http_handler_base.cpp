@@ -5,8 +5,10 @@
 #include <boost/algorithm/string/split.hpp>
 
 #include <compression/gzip.hpp>
+#include <server/congestion_control/gradient_limiter.hpp>
 #include <server/handlers/http_handler_base_statistics.hpp>
 #include <server/handlers/http_server_settings.hpp>
+#include <server/http/accept_encoding.hpp>
 #include <server/http/http_request_impl.hpp>
 #include <server/server_config.hpp>
 #include <userver/components/component.hpp>
@@ -33,6 +35,7 @@
 #include <userver/utils/fast_scope_guard.hpp>
 #include <userver/utils/from_string.hpp>
 #include <userver/utils/graphite.hpp>
+#include <userver/utils/keyed_rate_limiter.hpp>
 #include <userver/utils/log.hpp>
 #include <userver/utils/overloaded.hpp>
 #include <userver/utils/scope_guard.hpp>
@@ -339,6 +342,15 @@ HttpHandlerBase::HttpHandlerBase(const components::ComponentConfig& config,
       handler_name_(config.Name()),
       handler_statistics_(std::make_unique<HttpHandlerStatistics>()),
       request_statistics_(std::make_unique<HttpRequestStatistics>()),
+      compression_statistics_(
+          std::make_unique<ResponseCompressionStatistics>()),
+      scope_time_statistics_(GetConfig().scope_time_stats
+                                 ? std::make_unique<ScopeTimeStatistics>()
+                                 : nullptr),
+      labeled_statistics_(GetConfig().labeled_stats
+                              ? std::make_unique<LabeledStatistics>(
+                                    *GetConfig().labeled_stats)
+                              : nullptr),
       auth_checkers_(auth::CreateAuthCheckers(
           context, GetConfig(),
           context.FindComponent<components::AuthCheckerSettings>().Get())),
@@ -359,6 +371,20 @@ HttpHandlerBase::HttpHandlerBase(const components::ComponentConfig& config,
         {1, utils::TokenBucket::Duration{std::chrono::seconds(1)} / max_rps});
   }
 
+  if (GetConfig().adaptive_concurrency) {
+    concurrency_limiter_ =
+        std::make_unique<congestion_control::GradientLimiter>(
+            *GetConfig().adaptive_concurrency);
+  }
+
+  if (GetConfig().client_rate_limit) {
+    const auto& limit_config = *GetConfig().client_rate_limit;
+    client_rate_limit_ = std::make_unique<utils::KeyedRateLimiter>(
+        utils::KeyedRateLimiter::Settings{limit_config.requests,
+                                          limit_config.window,
+                                          limit_config.max_clients});
+  }
+
   auto& server_component = context.FindComponent<components::Server>();
 
   engine::TaskProcessor& task_processor =
@@ -394,6 +420,18 @@ HttpHandlerBase::HttpHandlerBase(const components::ComponentConfig& config,
         if constexpr (kIncludeServerHttpMetrics) {
           FormatStatistics(result["request"], *request_statistics_);
         }
+        if (GetConfig().compress_response) {
+          result["compression"] = *compression_statistics_;
+        }
+        if (concurrency_limiter_) {
+          result["congestion-control"] = *concurrency_limiter_;
+        }
+        if (scope_time_statistics_) {
+          result["handler"]["scope-time"] = *scope_time_statistics_;
+        }
+        if (labeled_statistics_) {
+          result["handler"]["labeled"] = *labeled_statistics_;
+        }
       },
       std::move(labels));
 
@@ -414,14 +452,43 @@ void HttpHandlerBase::HandleRequestStream(
   auto& http_response = http_request.GetHttpResponse();
   server::http::ResponseBodyStream response_body_stream{
       response.GetBodyProducer(), http_response};
+  if (IsResponseCompressionAccepted(http_request)) {
+    response_body_stream.EnableCompression(
+        GetConfig().compress_response->level);
+  }
+  utils::FastScopeGuard compression_guard([&]() noexcept {
+    try {
+      response_body_stream.FinishCompression();
+    } catch (const std::exception& e) {
+      LOG_ERROR() << "failed to finish the response compression: " << e;
+      return;
+    }
+    const auto& compressor = response_body_stream.compressor_;
+    if (!compressor) return;
+    compression_statistics_->Account(
+        compressor->GetInputSize(), compressor->GetOutputSize(),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            response_body_stream.compression_time_));
+  });
 
   // Just in case HandleStreamRequest() throws an exception.
   // Though it can be changed in HandleStreamRequest().
   response_body_stream.SetStatusCode(500);
 
+  // The status and a part of the body may be already sent, the response can
+  // not be replaced with an error then and is left incomplete
+  const auto log_failure_after_headers = [this](const std::exception& e) {
+    LOG_ERROR() << "exception in '" << HandlerName()
+                << "' handler after the response headers were sent: " << e;
+  };
+
   try {
     HandleStreamRequest(http_request, context, response_body_stream);
   } catch (const CustomHandlerException& e) {
+    if (response_body_stream.headers_ended_) {
+      log_failure_after_headers(e);
+      return;
+    }
     response_body_stream.SetStatusCode(http::GetHttpStatus(e.GetCode()));
 
     for (const auto& [name, value] : e.GetExtraHeaders()) {
@@ -436,6 +503,10 @@ void HttpHandlerBase::HandleRequestStream(
                                 std::move(formatted_error));
     }
   } catch (const std::exception& e) {
+    if (response_body_stream.headers_ended_) {
+      log_failure_after_headers(e);
+      return;
+    }
     if (engine::current_task::ShouldCancel()) {
       LOG_WARNING() << "request task cancelled, exception in '" << HandlerName()
                     << "' handler in handle_request: " << e;
@@ -463,8 +534,8 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
   auto& response = http_request.GetHttpResponse();
 
   try {
-    HttpHandlerStatisticsScope stats_scope(*handler_statistics_,
-                                           http_request.GetMethod(), response);
+    HttpHandlerStatisticsScope stats_scope(
+        *handler_statistics_, labeled_statistics_.get(), http_request);
 
     const auto server_settings = config_source_.GetCopy(kHttpServerSettings);
 
@@ -482,6 +553,8 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
         http_request.GetHeader(USERVER_NAMESPACE::http::headers::kXYaTraceId);
     const auto& parent_span_id =
         http_request.GetHeader(USERVER_NAMESPACE::http::headers::kXYaSpanId);
+    const auto& sampled =
+        http_request.GetHeader(USERVER_NAMESPACE::http::headers::kXYaSampled);
 
     const auto& yandex_request_id =
         http_request.GetHeader(USERVER_NAMESPACE::http::headers::kXRequestId);
@@ -503,6 +576,7 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
 
     auto span = tracing::Span::MakeSpan(fmt::format("http/{}", HandlerName()),
                                         trace_id, parent_span_id);
+    if (!sampled.empty()) span.SetSampled(sampled != "0");
 
     span.SetLocalLogLevel(log_level_);
 
@@ -520,6 +594,7 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
 
     static const std::string kParseRequestDataStep = "parse_request_data";
     static const std::string kCheckAuthStep = "check_auth";
+    static const std::string kCheckDeadlineStep = "check_deadline";
     static const std::string kCheckRatelimitStep = "check_ratelimit";
     static const std::string kHandleRequestStep = "handle_request";
     static const std::string kDecompressRequestBody = "decompress_request_body";
@@ -529,9 +604,35 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
         server_settings.need_log_request,
         server_settings.need_log_request_headers);
 
+    if (server_settings.need_cancel_handle_request_by_deadline) {
+      request_processor.ProcessRequestStep(
+          kCheckDeadlineStep, [this, &http_request, &inherited_data] {
+            CheckDeadline(http_request, inherited_data.deadline);
+          });
+    }
+
+    std::optional<std::chrono::steady_clock::time_point> concurrency_start;
+    utils::FastScopeGuard concurrency_guard([&]() noexcept {
+      if (!concurrency_start) return;
+      // The fast failures would make the handler look faster than it is
+      const auto status = static_cast<int>(response.GetStatus());
+      if (status >= 500 ||
+          response.GetStatus() == http::HttpStatus::kTooManyRequests) {
+        concurrency_limiter_->ReleaseWithoutSample();
+        return;
+      }
+      concurrency_limiter_->Release(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - *concurrency_start));
+    });
+
     request_processor.ProcessRequestStep(
-        kCheckRatelimitStep,
-        [this, &http_request] { return CheckRatelimit(http_request); });
+        kCheckRatelimitStep, [this, &http_request, &concurrency_start] {
+          CheckRatelimit(http_request);
+          if (CheckConcurrencyLimit(http_request)) {
+            concurrency_start = std::chrono::steady_clock::now();
+          }
+        });
 
     request_processor.ProcessRequestStep(
         kCheckAuthStep,
@@ -574,10 +675,16 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
       response.SetHeader(USERVER_NAMESPACE::http::headers::kXYaSpanId,
                          span.GetSpanId());
     }
+
+    if (scope_time_statistics_) {
+      scope_time_statistics_->Account(span.GetTimeStorage());
+    }
   } catch (const std::exception& ex) {
     LOG_ERROR() << "unable to handle request: " << ex;
   }
 
+  // After the request processor has logged the response data
+  if (!response.IsBodyStreamed()) CompressResponse(http_request, response);
   SetResponseAcceptEncoding(response);
   SetResponseServerHostname(response);
   response.SetHeadersEnd();
@@ -670,6 +777,21 @@ void HttpHandlerBase::CheckAuth(const http::HttpRequest& http_request,
   auth::CheckAuth(auth_checkers_, http_request, context);
 }
 
+void HttpHandlerBase::CheckDeadline(const http::HttpRequest& http_request,
+                                    engine::Deadline deadline) const {
+  if (!deadline.IsReached()) return;
+
+  handler_statistics_->ForMethodAndTotal(
+      http_request.GetMethod(), [](HttpHandlerMethodStatistics& stats) {
+        stats.IncrementRejectedByDeadline();
+      });
+
+  // The client does not wait for the response anymore, do not waste the
+  // resources on it
+  throw ExceptionWithCode<HandlerErrorCode::kGatewayTimeout>(InternalMessage{
+      "the deadline of the request has expired before it was handled"});
+}
+
 void HttpHandlerBase::CheckRatelimit(
     const http::HttpRequest& http_request) const {
   auto& statistics = handler_statistics_->GetByMethod(http_request.GetMethod());
@@ -692,6 +814,24 @@ void HttpHandlerBase::CheckRatelimit(
     throw ExceptionWithCode<HandlerErrorCode::kTooManyRequests>();
   }
 
+  if (client_rate_limit_) {
+    const auto& client = http_request.GetHeader(
+        GetConfig().client_rate_limit->client_header);
+    if (!client.empty() && !client_rate_limit_->TryAcquire(client)) {
+      auto& http_response = http_request.GetHttpResponse();
+      auto log_reason =
+          fmt::format("reached client_rate_limit requests={} of client '{}'",
+                      GetConfig().client_rate_limit->requests, client);
+      SetThrottleReason(
+          http_response, std::move(log_reason),
+          USERVER_NAMESPACE::http::headers::ratelimit_reason::kClient);
+      statistics.IncrementRateLimitReached();
+      total_statistics.IncrementRateLimitReached();
+
+      throw ExceptionWithCode<HandlerErrorCode::kTooManyRequests>();
+    }
+  }
+
   auto max_requests_in_flight = GetConfig().max_requests_in_flight;
   auto requests_in_flight = statistics.GetInFlight();
   if (max_requests_in_flight &&
@@ -710,9 +850,36 @@ void HttpHandlerBase::CheckRatelimit(
   }
 }
 
+bool HttpHandlerBase::CheckConcurrencyLimit(
+    const http::HttpRequest& http_request) const {
+  if (!concurrency_limiter_) return false;
+  if (concurrency_limiter_->TryAcquire(GetRequestPriority(http_request))) {
+    return true;
+  }
+
+  auto& http_response = http_request.GetHttpResponse();
+  auto log_reason = fmt::format("reached adaptive_concurrency limit={}",
+                                concurrency_limiter_->GetLimit());
+  SetThrottleReason(
+      http_response, std::move(log_reason),
+      USERVER_NAMESPACE::http::headers::ratelimit_reason::kAdaptiveConcurrency);
+
+  handler_statistics_->ForMethodAndTotal(
+      http_request.GetMethod(), [](HttpHandlerMethodStatistics& stats) {
+        stats.IncrementTooManyRequestsInFlight();
+      });
+
+  throw ExceptionWithCode<HandlerErrorCode::kTooManyRequests>();
+}
+
 void HttpHandlerBase::DecompressRequestBody(
     http::HttpRequest& http_request) const {
-  if (!http_request.IsBodyCompressed()) return;
+  // The streamed body is passed to the handler as is, gzip and deflate are
+  // decompressed as the body is received
+  if (!http_request.IsBodyCompressed() || http_request.IsBodyStreamed() ||
+      http_request.IsBodyDecompressed()) {
+    return;
+  }
 
   const auto& content_encoding = http_request.GetHeader("Content-Encoding");
 
@@ -739,6 +906,47 @@ void HttpHandlerBase::DecompressRequestBody(
   throw ClientError(HandlerErrorCode::kUnsupportedMediaType);
 }
 
+bool HttpHandlerBase::IsResponseCompressionAccepted(
+    const http::HttpRequest& http_request) const {
+  return GetConfig().compress_response &&
+         http::impl::IsEncodingAccepted(
+             http_request.GetHeader(
+                 USERVER_NAMESPACE::http::headers::kAcceptEncoding),
+             "gzip");
+}
+
+void HttpHandlerBase::CompressResponse(const http::HttpRequest& http_request,
+                                       http::HttpResponse& response) const {
+  if (!IsResponseCompressionAccepted(http_request)) return;
+
+  const auto& data = response.GetData();
+  const auto status = response.GetStatus();
+  if (data.empty() || data.size() < GetConfig().compress_response->min_size ||
+      status == http::HttpStatus::kNoContent ||
+      status == http::HttpStatus::kNotModified ||
+      response.HasHeader(USERVER_NAMESPACE::http::headers::kContentEncoding)) {
+    return;
+  }
+
+  // The encoder does not yield, so the wall time is the CPU time
+  const auto start = std::chrono::steady_clock::now();
+  std::string compressed;
+  try {
+    compressed =
+        compression::gzip::Compress(data, GetConfig().compress_response->level);
+  } catch (const std::exception& e) {
+    LOG_LIMITED_ERROR() << "failed to compress the response, it is sent as is: "
+                        << e;
+    return;
+  }
+  const auto cpu_time = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  compression_statistics_->Account(data.size(), compressed.size(), cpu_time);
+
+  response.SetData(std::move(compressed));
+  http::impl::SetResponseEncoding(response, "gzip");
+}
+
 std::string HttpHandlerBase::GetRequestBodyForLogging(
     const http::HttpRequest&, request::RequestContext&,
     const std::string& request_body) const {
@@ -810,7 +1018,7 @@ void HttpHandlerBase::SetResponseAcceptEncoding(
 
   if (!response.HasHeader(USERVER_NAMESPACE::http::headers::kAcceptEncoding)) {
     response.SetHeader(USERVER_NAMESPACE::http::headers::kAcceptEncoding,
-                       "gzip, identity");
+                       "gzip, deflate, identity");
   }
 }
 
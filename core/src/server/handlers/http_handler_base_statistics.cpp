@@ -1,6 +1,10 @@
 #include <server/handlers/http_handler_base_statistics.hpp>
 
+#include <limits>
+#include <utility>
+
 #include <userver/server/request/task_inherited_data.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/statistics/metadata.hpp>
 #include <userver/utils/statistics/percentile_format_json.hpp>
 
@@ -13,6 +17,8 @@ void HttpHandlerMethodStatistics::Account(
   reply_codes_.Account(
       static_cast<utils::statistics::HttpCodes::Code>(stats.code));
   timings_.GetCurrentCounter().Account(stats.timing.count());
+  cpu_times_.GetCurrentCounter().Account(stats.cpu_time.count());
+  context_switches_.GetCurrentCounter().Account(stats.context_switches);
   if (stats.deadline.IsReachable()) ++deadline_received_;
   if (stats.cancellation == engine::TaskCancellationReason::kDeadline) {
     ++cancelled_by_deadline_;
@@ -27,22 +33,28 @@ void DumpMetric(utils::statistics::Writer& writer,
 HttpHandlerStatisticsSnapshot::HttpHandlerStatisticsSnapshot(
     const HttpHandlerMethodStatistics& stats)
     : timings(stats.GetTimings()),
+      cpu_times(stats.GetCpuTimes()),
+      context_switches(stats.GetContextSwitches()),
       reply_codes(stats.GetReplyCodes()),
       in_flight(stats.GetInFlight()),
       too_many_requests_in_flight(stats.GetTooManyRequestsInFlight()),
       rate_limit_reached(stats.GetRateLimitReached()),
       deadline_received(stats.GetDeadlineReceived()),
-      cancelled_by_deadline(stats.GetCancelledByDeadline()) {}
+      cancelled_by_deadline(stats.GetCancelledByDeadline()),
+      rejected_by_deadline(stats.GetRejectedByDeadline()) {}
 
 void HttpHandlerStatisticsSnapshot::Add(
     const HttpHandlerStatisticsSnapshot& other) {
   timings.Add(other.timings);
+  cpu_times.Add(other.cpu_times);
+  context_switches.Add(other.context_switches);
   reply_codes += other.reply_codes;
   in_flight += other.in_flight;
   too_many_requests_in_flight += other.too_many_requests_in_flight;
   rate_limit_reached += other.rate_limit_reached;
   deadline_received += other.deadline_received;
   cancelled_by_deadline += other.cancelled_by_deadline;
+  rejected_by_deadline += other.rejected_by_deadline;
 }
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -53,7 +65,10 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["rate-limit-reached"] = stats.rate_limit_reached;
   writer["deadline-received"] = stats.deadline_received;
   writer["cancelled-by-deadline"] = stats.cancelled_by_deadline;
+  writer["rejected-by-deadline"] = stats.rejected_by_deadline;
   writer["timings"] = stats.timings;
+  writer["cpu-time-us"] = stats.cpu_times;
+  writer["context-switches"] = stats.context_switches;
 }
 
 void HttpRequestMethodStatistics::Account(
@@ -84,30 +99,251 @@ std::size_t HttpMethodToIndex(http::HttpMethod method) noexcept {
   return static_cast<std::size_t>(method);
 }
 
+void ResponseCompressionStatistics::Account(
+    std::uint64_t input_size, std::uint64_t output_size,
+    std::chrono::microseconds cpu_time) noexcept {
+  ++responses_;
+  input_bytes_ += input_size;
+  output_bytes_ += output_size;
+  cpu_time_us_ += cpu_time.count();
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ResponseCompressionStatistics& stats) {
+  const auto input_bytes = stats.GetInputBytes();
+  const auto output_bytes = stats.GetOutputBytes();
+  writer["responses"] = stats.GetResponses();
+  writer["input-bytes"] = input_bytes;
+  writer["output-bytes"] = output_bytes;
+  // percents of the original size, 100 for no data
+  writer["ratio-percent"] =
+      input_bytes ? output_bytes * 100 / input_bytes : std::uint64_t{100};
+  writer["cpu-time-us"] = stats.GetCpuTimeUs();
+}
+
+void ScopeTimeStatistics::Account(
+    const tracing::impl::TimeStorage& time_storage) {
+  for (const auto& [scope, duration] : time_storage.GetAll()) {
+    auto timings = scopes_.Get(scope);
+    if (!timings) {
+      if (scopes_.SizeApprox() >= kMaxScopes) continue;
+      timings = scopes_.Emplace(scope).value;
+    }
+    timings->GetCurrentCounter().Account(
+        std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+            .count());
+  }
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ScopeTimeStatistics& stats) {
+  stats.ForEachScope(
+      [&writer](const std::string& scope,
+                const ScopeTimeStatistics::Percentile& timings) {
+        writer["timings"].ValueWithLabels(timings, {"scope", scope});
+      });
+}
+
+namespace {
+
+constexpr std::string_view kOtherLabelValue = "__other__";
+
+// Upper bounds of the response body size buckets, the last one is unbounded
+constexpr std::array<std::pair<std::size_t, std::string_view>, 4>
+    kResponseSizeBuckets{{
+        {1 << 10, "1KiB"},
+        {16 << 10, "16KiB"},
+        {256 << 10, "256KiB"},
+        {std::numeric_limits<std::size_t>::max(), "inf"},
+    }};
+
+std::string_view GetResponseSizeBucket(std::size_t size) noexcept {
+  for (const auto& [bound, name] : kResponseSizeBuckets) {
+    if (size <= bound) return name;
+  }
+  return kResponseSizeBuckets.back().second;
+}
+
+std::string_view GetLabelName(StatsLabel label) noexcept {
+  switch (label) {
+    case StatsLabel::kPath:
+      return "http_request_path";
+    case StatsLabel::kClient:
+      return "http_client";
+    case StatsLabel::kResponseSize:
+      return "http_response_size";
+  }
+  UINVARIANT(false, "Unexpected StatsLabel");
+}
+
+}  // namespace
+
+LabeledStatistics::LabeledStatistics(LabeledStatsConfig config)
+    : config_(std::move(config)),
+      overflow_(std::vector<std::string>(config_.labels.size(),
+                                         std::string{kOtherLabelValue})) {}
+
+void LabeledStatistics::Account(const Request& request) {
+  auto values = GetLabelValues(request);
+
+  std::string key;
+  for (const auto& value : values) {
+    key += value;
+    key += '\0';
+  }
+
+  auto label_set = label_sets_.Get(key);
+  if (!label_set) {
+    if (label_sets_.SizeApprox() >= config_.max_label_sets) {
+      overflow_.Account(request);
+      return;
+    }
+    label_set = label_sets_.Emplace(key, std::move(values)).value;
+  }
+  label_set->Account(request);
+}
+
+std::vector<std::string> LabeledStatistics::GetLabelValues(
+    const Request& request) const {
+  std::vector<std::string> values;
+  values.reserve(config_.labels.size());
+  for (const auto label : config_.labels) {
+    switch (label) {
+      case StatsLabel::kPath:
+        values.emplace_back(request.path);
+        break;
+      case StatsLabel::kClient:
+        values.emplace_back(request.client);
+        break;
+      case StatsLabel::kResponseSize:
+        values.emplace_back(GetResponseSizeBucket(request.response_size));
+        break;
+    }
+  }
+  return values;
+}
+
+LabeledStatistics::LabelSet::LabelSet(std::vector<std::string> values)
+    : values(std::move(values)) {}
+
+void LabeledStatistics::LabelSet::Account(const Request& request) noexcept {
+  auto& local = counters.GetLocal();
+  ++local.requests;
+
+  const auto code_class = static_cast<std::size_t>(request.code) / 100;
+  if (code_class >= 1 && code_class <= kReplyCodeClasses) {
+    ++local.reply_code_classes[code_class - 1];
+  }
+
+  const auto timing_ms = request.timing.count();
+  local.timings_sum_ms += timing_ms;
+  const auto bucket = std::lower_bound(kTimingBoundsMs.begin(),
+                                       kTimingBoundsMs.end(), timing_ms) -
+                      kTimingBoundsMs.begin();
+  ++local.timings[bucket];
+}
+
+LabeledStatistics::Snapshot LabeledStatistics::LabelSet::GetSnapshot() const {
+  Snapshot result;
+  counters.VisitAll([&result](const Counters& shard) {
+    result.requests += shard.requests.Load();
+    for (std::size_t i = 0; i < kReplyCodeClasses; ++i) {
+      result.reply_code_classes[i] += shard.reply_code_classes[i].Load();
+    }
+    result.timings_sum_ms += shard.timings_sum_ms.Load();
+    for (std::size_t i = 0; i < result.timings.size(); ++i) {
+      result.timings[i] += shard.timings[i].Load();
+    }
+  });
+  return result;
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const LabeledStatistics& stats) {
+  const auto& labels = stats.GetConfig().labels;
+  std::vector<utils::statistics::LabelView> label_views;
+
+  stats.ForEachLabelSet([&](const std::vector<std::string>& values,
+                            const LabeledStatistics::Snapshot& snapshot) {
+    if (snapshot.requests == 0) return;
+
+    label_views.clear();
+    for (std::size_t i = 0; i < labels.size(); ++i) {
+      label_views.emplace_back(GetLabelName(labels[i]), values[i]);
+    }
+    const utils::statistics::LabelsSpan labels_span{label_views};
+    writer["requests"].ValueWithLabels(snapshot.requests, labels_span);
+    writer["timings-sum-ms"].ValueWithLabels(snapshot.timings_sum_ms,
+                                             labels_span);
+
+    for (std::size_t i = 0; i < snapshot.reply_code_classes.size(); ++i) {
+      const auto code_class = std::to_string(i + 1) + "xx";
+      label_views.emplace_back("http_code_class", code_class);
+      writer["reply-codes"].ValueWithLabels(
+          snapshot.reply_code_classes[i],
+          utils::statistics::LabelsSpan{label_views});
+      label_views.pop_back();
+    }
+
+    // cumulative, as the 'le' label suggests
+    std::uint64_t timings_le = 0;
+    for (std::size_t i = 0; i < snapshot.timings.size(); ++i) {
+      timings_le += snapshot.timings[i];
+      const auto bound =
+          i < LabeledStatistics::kTimingBoundsMs.size()
+              ? std::to_string(LabeledStatistics::kTimingBoundsMs[i])
+              : std::string{"inf"};
+      label_views.emplace_back("le", bound);
+      writer["timings"].ValueWithLabels(
+          timings_le, utils::statistics::LabelsSpan{label_views});
+      label_views.pop_back();
+    }
+  });
+}
+
 HttpHandlerStatisticsScope::HttpHandlerStatisticsScope(
-    HttpHandlerStatistics& stats, http::HttpMethod method,
-    server::http::HttpResponse& response)
+    HttpHandlerStatistics& stats, LabeledStatistics* labeled_stats,
+    const server::http::HttpRequest& request)
     : stats_(stats),
-      method_(method),
+      labeled_stats_(labeled_stats),
+      request_(request),
+      method_(request.GetMethod()),
       start_time_(std::chrono::steady_clock::now()),
-      response_(response) {
-  stats_.ForMethodAndTotal(method, [&](HttpHandlerMethodStatistics& stats) {
+      start_execution_(engine::current_task::GetExecutionStatistics()),
+      response_(request.GetHttpResponse()) {
+  stats_.ForMethodAndTotal(method_, [&](HttpHandlerMethodStatistics& stats) {
     stats.IncrementInFlight();
   });
 }
 
 HttpHandlerStatisticsScope::~HttpHandlerStatisticsScope() {
   const auto finish_time = std::chrono::steady_clock::now();
+  const auto finish_execution = engine::current_task::GetExecutionStatistics();
   const auto* const data = request::kTaskInheritedData.GetOptional();
 
   HttpHandlerStatisticsEntry stats;
   stats.code = response_.GetStatus();
   stats.timing = std::chrono::duration_cast<std::chrono::milliseconds>(
       finish_time - start_time_);
+  stats.cpu_time = std::chrono::duration_cast<std::chrono::microseconds>(
+      finish_execution.cpu_time - start_execution_.cpu_time);
+  stats.context_switches =
+      finish_execution.context_switches - start_execution_.context_switches;
   stats.deadline = data ? data->deadline : engine::Deadline{};
   stats.cancellation = engine::current_task::CancellationReason();
   stats_.Account(method_, stats);
 
+  if (labeled_stats_) {
+    LabeledStatistics::Request labeled_request;
+    labeled_request.path = request_.GetRequestPath();
+    labeled_request.client =
+        request_.GetHeader(labeled_stats_->GetConfig().client_header);
+    labeled_request.response_size = response_.GetData().size();
+    labeled_request.code = stats.code;
+    labeled_request.timing = stats.timing;
+    labeled_stats_->Account(labeled_request);
+  }
+
   stats_.ForMethodAndTotal(method_, [&](HttpHandlerMethodStatistics& stats) {
     stats.DecrementInFlight();
   });
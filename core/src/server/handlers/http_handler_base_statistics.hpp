@@ -1,18 +1,29 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <string>
+#include <string_view>
 #include <type_traits>
+#include <vector>
 
 #include <server/http/handler_methods.hpp>
+#include <tracing/time_storage.hpp>
+#include <userver/concurrent/sharded_variable.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task.hpp>
 #include <userver/formats/json_fwd.hpp>
+#include <userver/rcu/rcu_map.hpp>
+#include <userver/server/handlers/handler_config.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/server/http/http_status.hpp>
 #include <userver/utils/statistics/aggregated_values.hpp>
+#include <userver/utils/statistics/hdr_histogram.hpp>
 #include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/relaxed_counter.hpp>
 #include <utils/statistics/http_codes.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -23,11 +34,21 @@ namespace server::handlers {
 struct HttpHandlerStatisticsEntry final {
   http::HttpStatus code{http::HttpStatus::kInternalServerError};
   std::chrono::milliseconds timing{};
+  // on-CPU time and suspensions of the handler task
+  std::chrono::microseconds cpu_time{};
+  std::uint64_t context_switches{0};
   engine::Deadline deadline{};
   engine::TaskCancellationReason cancellation{
       engine::TaskCancellationReason::kNone};
 };
 
+#ifdef USERVER_FEATURE_HDR_HISTOGRAM_TIMINGS
+using TimingsPercentile = utils::statistics::HdrHistogram<>;
+#else
+using TimingsPercentile =
+    utils::statistics::Percentile<2048, unsigned int, 120>;
+#endif
+
 class HttpHandlerMethodStatistics final {
  public:
   void Account(const HttpHandlerStatisticsEntry& stats) noexcept;
@@ -36,10 +57,20 @@ class HttpHandlerMethodStatistics final {
     return reply_codes_;
   }
 
-  using Percentile = utils::statistics::Percentile<2048, unsigned int, 120>;
+  using Percentile = TimingsPercentile;
 
   Percentile GetTimings() const { return timings_.GetStatsForPeriod(); }
 
+  // in microseconds
+  Percentile GetCpuTimes() const { return cpu_times_.GetStatsForPeriod(); }
+
+  using ContextSwitchesPercentile =
+      utils::statistics::Percentile<100, unsigned int, 20, 50>;
+
+  ContextSwitchesPercentile GetContextSwitches() const {
+    return context_switches_.GetStatsForPeriod();
+  }
+
   size_t GetInFlight() const noexcept { return in_flight_; }
 
   void IncrementInFlight() noexcept { in_flight_++; }
@@ -66,18 +97,30 @@ class HttpHandlerMethodStatistics final {
     return cancelled_by_deadline_.load();
   }
 
+  void IncrementRejectedByDeadline() noexcept { rejected_by_deadline_++; }
+
+  std::uint64_t GetRejectedByDeadline() const noexcept {
+    return rejected_by_deadline_.load();
+  }
+
  private:
   using RecentPeriod =
       utils::statistics::RecentPeriod<Percentile, Percentile,
                                       utils::datetime::SteadyClock>;
 
   RecentPeriod timings_;
+  RecentPeriod cpu_times_;
+  utils::statistics::RecentPeriod<ContextSwitchesPercentile,
+                                  ContextSwitchesPercentile,
+                                  utils::datetime::SteadyClock>
+      context_switches_;
   utils::statistics::HttpCodes reply_codes_;
   std::atomic<std::size_t> in_flight_{0};
   std::atomic<std::uint64_t> too_many_requests_in_flight_{0};
   std::atomic<std::uint64_t> rate_limit_reached_{0};
   std::atomic<std::uint64_t> deadline_received_{0};
   std::atomic<std::uint64_t> cancelled_by_deadline_{0};
+  std::atomic<std::uint64_t> rejected_by_deadline_{0};
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -92,12 +135,15 @@ struct HttpHandlerStatisticsSnapshot final {
   void Add(const HttpHandlerStatisticsSnapshot& other);
 
   HttpHandlerMethodStatistics::Percentile timings;
+  HttpHandlerMethodStatistics::Percentile cpu_times;
+  HttpHandlerMethodStatistics::ContextSwitchesPercentile context_switches;
   utils::statistics::HttpCodes::Snapshot reply_codes;
   std::size_t in_flight{0};
   std::uint64_t too_many_requests_in_flight{0};
   std::uint64_t rate_limit_reached{0};
   std::uint64_t deadline_received{0};
   std::uint64_t cancelled_by_deadline{0};
+  std::uint64_t rejected_by_deadline{0};
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -113,7 +159,7 @@ class HttpRequestMethodStatistics final {
  public:
   void Account(const HttpRequestStatisticsEntry& stats) noexcept;
 
-  using Percentile = utils::statistics::Percentile<2048, unsigned int, 120>;
+  using Percentile = TimingsPercentile;
 
   Percentile GetTimings() const { return timings_.GetStatsForPeriod(); }
 
@@ -168,18 +214,154 @@ class HttpHandlerStatistics final
 class HttpRequestStatistics final
     : public ByMethodStatistics<HttpRequestMethodStatistics> {};
 
+// Statistics of the response compression of the handler
+class ResponseCompressionStatistics final {
+ public:
+  void Account(std::uint64_t input_size, std::uint64_t output_size,
+               std::chrono::microseconds cpu_time) noexcept;
+
+  std::uint64_t GetResponses() const noexcept { return responses_.load(); }
+
+  std::uint64_t GetInputBytes() const noexcept { return input_bytes_.load(); }
+
+  std::uint64_t GetOutputBytes() const noexcept {
+    return output_bytes_.load();
+  }
+
+  std::uint64_t GetCpuTimeUs() const noexcept { return cpu_time_us_.load(); }
+
+ private:
+  std::atomic<std::uint64_t> responses_{0};
+  std::atomic<std::uint64_t> input_bytes_{0};
+  std::atomic<std::uint64_t> output_bytes_{0};
+  std::atomic<std::uint64_t> cpu_time_us_{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ResponseCompressionStatistics& stats);
+
+// Per-request time of the tracing::ScopeTime scopes of the handler span,
+// gives the latency breakdown by stages
+class ScopeTimeStatistics final {
+ public:
+  using Percentile = HttpHandlerMethodStatistics::Percentile;
+
+  // Scopes beyond this count are not accounted to limit the metrics count
+  static constexpr std::size_t kMaxScopes = 100;
+
+  void Account(const tracing::impl::TimeStorage& time_storage);
+
+  template <typename Func>
+  void ForEachScope(const Func& func) const {
+    for (const auto& [scope, timings] : scopes_) {
+      func(scope, timings->GetStatsForPeriod());
+    }
+  }
+
+ private:
+  using RecentPeriod =
+      utils::statistics::RecentPeriod<Percentile, Percentile,
+                                      utils::datetime::SteadyClock>;
+
+  rcu::RcuMap<std::string, RecentPeriod> scopes_;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ScopeTimeStatistics& stats);
+
+// Request counts, reply code classes and timings of the handler broken down
+// by the request properties from LabeledStatsConfig. The counters of each
+// label set are sharded by the engine worker and are summed up only when the
+// metrics are written, so the recording takes no locks and does not bounce
+// the cache lines between the cores.
+class LabeledStatistics final {
+ public:
+  // Properties of a finished request
+  struct Request final {
+    std::string_view path;
+    std::string_view client;
+    std::size_t response_size{0};
+    http::HttpStatus code{http::HttpStatus::kInternalServerError};
+    std::chrono::milliseconds timing{};
+  };
+
+  // Upper bounds of the timing histogram buckets, the last bucket is unbounded
+  static constexpr std::array<std::int64_t, 10> kTimingBoundsMs{
+      5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000};
+
+  // 1xx..5xx, the codes out of range are not accounted by class
+  static constexpr std::size_t kReplyCodeClasses = 5;
+
+  struct Snapshot final {
+    std::uint64_t requests{0};
+    std::array<std::uint64_t, kReplyCodeClasses> reply_code_classes{};
+    std::uint64_t timings_sum_ms{0};
+    std::array<std::uint64_t, kTimingBoundsMs.size() + 1> timings{};
+  };
+
+  explicit LabeledStatistics(LabeledStatsConfig config);
+
+  const LabeledStatsConfig& GetConfig() const noexcept { return config_; }
+
+  void Account(const Request& request);
+
+  // Calls `func(const std::vector<std::string>& label_values,
+  // const Snapshot&)` for every label set, the values go in the order of
+  // GetConfig().labels
+  template <typename Func>
+  void ForEachLabelSet(const Func& func) const {
+    for (const auto& [key, label_set] : label_sets_) {
+      func(label_set->values, label_set->GetSnapshot());
+    }
+    func(overflow_.values, overflow_.GetSnapshot());
+  }
+
+ private:
+  using Counter = utils::statistics::RelaxedCounter<std::uint64_t>;
+
+  struct Counters final {
+    Counter requests;
+    std::array<Counter, kReplyCodeClasses> reply_code_classes;
+    Counter timings_sum_ms;
+    std::array<Counter, kTimingBoundsMs.size() + 1> timings;
+  };
+
+  struct LabelSet final {
+    explicit LabelSet(std::vector<std::string> values);
+
+    void Account(const Request& request) noexcept;
+
+    Snapshot GetSnapshot() const;
+
+    const std::vector<std::string> values;
+    concurrent::ShardedVariable<Counters> counters;
+  };
+
+  std::vector<std::string> GetLabelValues(const Request& request) const;
+
+  const LabeledStatsConfig config_;
+  rcu::RcuMap<std::string, LabelSet> label_sets_;
+  LabelSet overflow_;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const LabeledStatistics& stats);
+
 class HttpHandlerStatisticsScope final {
  public:
   HttpHandlerStatisticsScope(HttpHandlerStatistics& stats,
-                             http::HttpMethod method,
-                             server::http::HttpResponse& response);
+                             LabeledStatistics* labeled_stats,
+                             const server::http::HttpRequest& request);
 
   ~HttpHandlerStatisticsScope();
 
  private:
   HttpHandlerStatistics& stats_;
+  LabeledStatistics* const labeled_stats_;
+  const server::http::HttpRequest& request_;
   const http::HttpMethod method_;
   const std::chrono::steady_clock::time_point start_time_;
+  const engine::TaskExecutionStatistics start_execution_;
   server::http::HttpResponse& response_;
 };
 
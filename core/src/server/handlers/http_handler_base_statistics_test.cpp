@@ -0,0 +1,163 @@
+#include <server/handlers/http_handler_base_statistics.hpp>
+
+#include <map>
+
+#include <userver/utest/utest.hpp>
+#include <userver/utils/mock_now.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::map<std::string, std::size_t> CountsByScope(
+    const server::handlers::ScopeTimeStatistics& stats) {
+  // complete the current epoch of the recent period
+  utils::datetime::MockSleep(std::chrono::seconds{10});
+
+  std::map<std::string, std::size_t> result;
+  stats.ForEachScope([&result](const std::string& scope, const auto& timings) {
+    result[scope] = timings.Count();
+  });
+  return result;
+}
+
+}  // namespace
+
+UTEST(ScopeTimeStatistics, Account) {
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+  server::handlers::ScopeTimeStatistics stats;
+
+  for (int i = 0; i < 3; ++i) {
+    tracing::impl::TimeStorage time_storage;
+    time_storage.PushLap("pg_query", std::chrono::milliseconds{10});
+    time_storage.PushLap("pg_query", std::chrono::milliseconds{5});
+    if (i == 0) {
+      time_storage.PushLap("serialize", std::chrono::milliseconds{1});
+    }
+    stats.Account(time_storage);
+  }
+
+  // the laps of a single request are summed up into a single value
+  const std::map<std::string, std::size_t> expected{{"pg_query", 3},
+                                                    {"serialize", 1}};
+  EXPECT_EQ(CountsByScope(stats), expected);
+  utils::datetime::MockNowUnset();
+}
+
+UTEST(ScopeTimeStatistics, MaxScopes) {
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+  server::handlers::ScopeTimeStatistics stats;
+
+  tracing::impl::TimeStorage time_storage;
+  for (std::size_t i = 0; i < 2 * stats.kMaxScopes; ++i) {
+    time_storage.PushLap("scope" + std::to_string(i),
+                         std::chrono::milliseconds{1});
+  }
+  stats.Account(time_storage);
+
+  EXPECT_EQ(CountsByScope(stats).size(), stats.kMaxScopes);
+  utils::datetime::MockNowUnset();
+}
+
+namespace {
+
+using server::handlers::LabeledStatistics;
+
+LabeledStatistics::Request MakeRequest(std::string_view path,
+                                       std::string_view client,
+                                       server::http::HttpStatus code,
+                                       std::chrono::milliseconds timing) {
+  LabeledStatistics::Request request;
+  request.path = path;
+  request.client = client;
+  request.response_size = 100;
+  request.code = code;
+  request.timing = timing;
+  return request;
+}
+
+}  // namespace
+
+UTEST(LabeledStatistics, Account) {
+  server::handlers::LabeledStatsConfig config;
+  config.labels = {server::handlers::StatsLabel::kPath,
+                   server::handlers::StatsLabel::kClient,
+                   server::handlers::StatsLabel::kResponseSize};
+  LabeledStatistics stats{config};
+
+  using server::http::HttpStatus;
+  using std::chrono::milliseconds;
+  stats.Account(MakeRequest("/v1/a", "svc", HttpStatus::kOk, milliseconds{3}));
+  stats.Account(MakeRequest("/v1/a", "svc", HttpStatus::kNotFound,
+                            milliseconds{30}));
+  stats.Account(MakeRequest("/v1/b", "svc", HttpStatus::kOk, milliseconds{7}));
+
+  utils::statistics::Storage storage;
+  auto holder = storage.RegisterWriter(
+      "labeled", [&stats](utils::statistics::Writer& writer) {
+        writer = stats;
+      });
+  const utils::statistics::Snapshot snapshot{storage, "labeled"};
+
+  const std::vector<utils::statistics::Label> labels_a{
+      {"http_request_path", "/v1/a"},
+      {"http_client", "svc"},
+      {"http_response_size", "1KiB"}};
+  EXPECT_EQ(snapshot.SingleMetric("requests", labels_a).AsInt(), 2);
+  EXPECT_EQ(snapshot.SingleMetric("timings-sum-ms", labels_a).AsInt(), 33);
+
+  auto with_label = [](std::vector<utils::statistics::Label> labels,
+                       std::string name, std::string value) {
+    labels.emplace_back(std::move(name), std::move(value));
+    return labels;
+  };
+  EXPECT_EQ(snapshot
+                .SingleMetric("reply-codes",
+                              with_label(labels_a, "http_code_class", "4xx"))
+                .AsInt(),
+            1);
+  EXPECT_EQ(
+      snapshot.SingleMetric("timings", with_label(labels_a, "le", "5")).AsInt(),
+      1);
+  EXPECT_EQ(snapshot.SingleMetric("timings", with_label(labels_a, "le", "25"))
+                .AsInt(),
+            1);
+  EXPECT_EQ(snapshot.SingleMetric("timings", with_label(labels_a, "le", "inf"))
+                .AsInt(),
+            2);
+
+  EXPECT_EQ(
+      snapshot.SingleMetric("requests", {{"http_request_path", "/v1/b"}})
+          .AsInt(),
+      1);
+}
+
+UTEST(LabeledStatistics, MaxLabelSets) {
+  server::handlers::LabeledStatsConfig config;
+  config.labels = {server::handlers::StatsLabel::kPath};
+  config.max_label_sets = 2;
+  LabeledStatistics stats{config};
+
+  for (int i = 0; i < 5; ++i) {
+    stats.Account(MakeRequest("/v1/" + std::to_string(i), "",
+                              server::http::HttpStatus::kOk,
+                              std::chrono::milliseconds{1}));
+  }
+
+  std::size_t label_sets = 0;
+  std::uint64_t other_requests = 0;
+  stats.ForEachLabelSet([&](const std::vector<std::string>& values,
+                            const LabeledStatistics::Snapshot& snapshot) {
+    if (values.front() == "__other__") {
+      other_requests = snapshot.requests;
+    } else {
+      ++label_sets;
+    }
+  });
+  EXPECT_EQ(label_sets, 2);
+  EXPECT_EQ(other_requests, 3);
+}
+
+USERVER_NAMESPACE_END
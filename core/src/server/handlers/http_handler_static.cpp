@@ -1,11 +1,20 @@
 #include <userver/server/handlers/http_handler_static.hpp>
 
+#include <optional>
+#include <utility>
+
+#include <fmt/format.h>
+
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
+#include <userver/components/mapped_fs_cache.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/dynamic_config/value.hpp>
+#include <userver/http/common_headers.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
+#include <server/http/byte_range.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server::handlers {
@@ -18,28 +27,97 @@ auto ParseContentTypeMap(const dynamic_config::DocsMap& docs_map) {
 }
 constexpr dynamic_config::Key<ParseContentTypeMap> kContentTypeMap{};
 
+struct FilePart {
+  std::size_t offset;
+  std::size_t size;
+};
+
+// Sets the status and the headers for the requested range of the file,
+// returns std::nullopt if nothing should be sent
+std::optional<FilePart> SelectFilePart(const http::HttpRequest& request,
+                                       std::size_t file_size) {
+  using Kind = http::impl::ByteRange::Kind;
+  namespace headers = USERVER_NAMESPACE::http::headers;
+
+  auto& response = request.GetHttpResponse();
+  response.SetHeader(std::string{headers::kAcceptRanges}, "bytes");
+
+  const auto& range_header = request.GetHeader(headers::kRange);
+  // The validators are not sent, so the If-Range never matches
+  if (range_header.empty() || !request.GetHeader(headers::kIfRange).empty()) {
+    return FilePart{0, file_size};
+  }
+
+  const auto range = http::impl::ParseByteRange(range_header, file_size);
+  switch (range.kind) {
+    case Kind::kIgnored:
+      return FilePart{0, file_size};
+    case Kind::kSatisfiable:
+      response.SetStatus(http::HttpStatus::kPartialContent);
+      response.SetHeader(std::string{headers::kContentRange},
+                         fmt::format("bytes {}-{}/{}", range.offset,
+                                     range.offset + range.size - 1,
+                                     file_size));
+      return FilePart{range.offset, range.size};
+    case Kind::kUnsatisfiable:
+      response.SetStatus(http::HttpStatus::kRangeNotSatisfiable);
+      response.SetHeader(std::string{headers::kContentRange},
+                         fmt::format("bytes */{}", file_size));
+      return std::nullopt;
+  }
+  return FilePart{0, file_size};
+}
+
 }  // namespace
 
 HttpHandlerStatic::HttpHandlerStatic(
     const components::ComponentConfig& config,
     const components::ComponentContext& context)
     : HttpHandlerBase(config, context),
-      config_(context.FindComponent<components::DynamicConfig>().GetSource()),
-      storage_(context
-                   .FindComponent<components::FsCache>(
-                       config["fs-cache-component"].As<std::string>(
-                           "fs-cache-component"))
-                   .GetClient()) {}
+      config_(context.FindComponent<components::DynamicConfig>().GetSource()) {
+  if (config.HasMember("mapped-fs-cache-component")) {
+    mapped_storage_ =
+        &context
+             .FindComponent<components::MappedFsCache>(
+                 config["mapped-fs-cache-component"].As<std::string>())
+             .GetClient();
+  } else {
+    storage_ = &context
+                    .FindComponent<components::FsCache>(
+                        config["fs-cache-component"].As<std::string>(
+                            "fs-cache-component"))
+                    .GetClient();
+  }
+}
 
 std::string HttpHandlerStatic::HandleRequestThrow(
     const http::HttpRequest& request, request::RequestContext&) const {
   LOG_DEBUG() << "Handler: " << request.GetRequestPath();
-  const auto file = storage_.TryGetFile(request.GetRequestPath());
-  if (file) {
-    const auto config = config_.GetSnapshot();
-    request.GetHttpResponse().SetContentType(
-        config[kContentTypeMap][file->extension]);
-    return file->data;
+  const auto config = config_.GetSnapshot();
+  auto& response = request.GetHttpResponse();
+
+  if (mapped_storage_) {
+    const auto file = mapped_storage_->TryGetFile(request.GetRequestPath());
+    if (file) {
+      response.SetContentType(config[kContentTypeMap][file->GetExtension()]);
+      const auto part = SelectFilePart(request, file->GetSize());
+      if (!part) return {};
+      // The descriptor keeps the whole mapped file alive
+      response.SetFileBody(
+          std::shared_ptr<const fs::blocking::FileDescriptor>(
+              file, &file->GetFileDescriptor()),
+          part->offset, part->size);
+      return {};
+    }
+  } else {
+    const auto file = storage_->TryGetFile(request.GetRequestPath());
+    if (file) {
+      response.SetContentType(config[kContentTypeMap][file->extension]);
+      const auto part = SelectFilePart(request, file->data.size());
+      if (!part) return {};
+      if (part->size == file->data.size()) return file->data;
+      return file->data.substr(part->offset, part->size);
+    }
   }
   request.GetResponse().SetStatusNotFound();
   return "File not found";
@@ -57,6 +135,11 @@ properties:
         type: string
         description: Name of the FsCache component
         defaultDescription: fs-cache-component
+    mapped-fs-cache-component:
+        type: string
+        description: |
+            Name of the MappedFsCache component to serve the files with
+            sendfile(2) instead of the FsCache component
 )");
 }
 
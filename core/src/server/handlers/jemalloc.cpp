@@ -51,6 +51,10 @@ std::string Jemalloc::HandleRequestThrow(const http::HttpRequest& request,
     return HandleRc(utils::jemalloc::EnableBgThreads());
   } else if (command == "bg_threads_disable") {
     return HandleRc(utils::jemalloc::StopBgThreads());
+  } else if (command == "decay") {
+    return HandleRc(utils::jemalloc::DecayArena(utils::jemalloc::kAllArenas));
+  } else if (command == "purge") {
+    return HandleRc(utils::jemalloc::PurgeArena(utils::jemalloc::kAllArenas));
   } else {
     return "Unsupported command";
   }
@@ -1,9 +1,16 @@
 #include <userver/server/handlers/server_monitor.hpp>
 
+#include <optional>
+
+#include <fmt/format.h>
+
 #include <userver/components/component.hpp>
 #include <userver/components/statistics_storage.hpp>
+#include <userver/concurrent/single_flight.hpp>
 #include <userver/formats/json/serialize.hpp>
+#include <userver/rcu/rcu_map.hpp>
 #include <userver/server/handlers/exceptions.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/statistics/graphite.hpp>
 #include <userver/utils/statistics/json.hpp>
 #include <userver/utils/statistics/prometheus.hpp>
@@ -48,8 +55,63 @@ StatsFormat ParseFormat(std::string_view format) {
       handlers::ExternalBody{"Unknown value of 'format' URL parameter"});
 }
 
+// Bounds the memory for the distinct requests, the rest are not cached
+constexpr std::size_t kMaxCachedResponses = 64;
+
+std::string Serialize(StatsFormat format,
+                      const utils::statistics::Storage& storage,
+                      const std::unordered_map<std::string, std::string>&
+                          common_labels,
+                      const utils::statistics::Request& statistics_request) {
+  switch (format) {
+    case StatsFormat::kGraphite:
+      return utils::statistics::ToGraphiteFormat(storage, statistics_request);
+
+    case StatsFormat::kPrometheus:
+      return utils::statistics::ToPrometheusFormat(storage,
+                                                   statistics_request);
+
+    case StatsFormat::kPrometheusUntyped:
+      return utils::statistics::ToPrometheusFormatUntyped(storage,
+                                                          statistics_request);
+
+    case StatsFormat::kJson:
+      return utils::statistics::ToJsonFormat(storage, statistics_request);
+
+    case StatsFormat::kSolomon:
+      return utils::statistics::ToSolomonFormat(storage, common_labels,
+                                                statistics_request);
+
+    case StatsFormat::kInternal:
+      const auto json = storage.GetAsJson();
+      UASSERT(utils::statistics::AreAllMetricsNumbers(json));
+      return formats::json::ToString(json);
+  }
+
+  UINVARIANT(false, "Unexpected 'format' value");
+}
+
+engine::TaskProcessor* GetStatisticsTaskProcessor(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context) {
+  const auto name =
+      config["statistics-task-processor"].As<std::optional<std::string>>();
+  return name ? &context.GetTaskProcessor(*name) : nullptr;
+}
+
 }  // namespace
 
+struct ServerMonitor::ResponseCache final {
+  struct Response final {
+    std::chrono::steady_clock::time_point created;
+    std::string data;
+  };
+  using ResponsePtr = std::shared_ptr<const Response>;
+
+  rcu::RcuMap<std::string, const Response> responses;
+  concurrent::SingleFlight<std::string, ResponsePtr> single_flight;
+};
+
 ServerMonitor::ServerMonitor(
     const components::ComponentConfig& config,
     const components::ComponentContext& component_context)
@@ -57,7 +119,13 @@ ServerMonitor::ServerMonitor(
       statistics_storage_(
           component_context.FindComponent<components::StatisticsStorage>()
               .GetStorage()),
-      common_labels_{config["common-labels"].As<CommonLabels>({})} {}
+      common_labels_{config["common-labels"].As<CommonLabels>({})},
+      cache_period_(config["cache-period"].As<std::chrono::milliseconds>(0)),
+      response_cache_(std::make_unique<ResponseCache>()),
+      statistics_task_processor_(
+          GetStatisticsTaskProcessor(config, component_context)) {}
+
+ServerMonitor::~ServerMonitor() = default;
 
 std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
                                               request::RequestContext&) const {
@@ -88,34 +156,42 @@ std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
                     : Request::MakeWithPath(path, std::move(common_labels),
                                             std::move(labels)));
 
-  switch (format) {
-    case StatsFormat::kGraphite:
-      return utils::statistics::ToGraphiteFormat(statistics_storage_,
-                                                 statistics_request);
-
-    case StatsFormat::kPrometheus:
-      return utils::statistics::ToPrometheusFormat(statistics_storage_,
-                                                   statistics_request);
-
-    case StatsFormat::kPrometheusUntyped:
-      return utils::statistics::ToPrometheusFormatUntyped(statistics_storage_,
-                                                          statistics_request);
-
-    case StatsFormat::kJson:
-      return utils::statistics::ToJsonFormat(statistics_storage_,
-                                             statistics_request);
-
-    case StatsFormat::kSolomon:
-      return utils::statistics::ToSolomonFormat(
-          statistics_storage_, common_labels_, statistics_request);
-
-    case StatsFormat::kInternal:
-      const auto json = statistics_storage_.GetAsJson();
-      UASSERT(utils::statistics::AreAllMetricsNumbers(json));
-      return formats::json::ToString(json);
+  const auto serialize = [&] {
+    if (!statistics_task_processor_) {
+      return Serialize(format, statistics_storage_, common_labels_,
+                       statistics_request);
+    }
+    return utils::Async(*statistics_task_processor_, "serialize-statistics",
+                        [&] {
+                          return Serialize(format, statistics_storage_,
+                                           common_labels_, statistics_request);
+                        })
+        .Get();
+  };
+
+  if (cache_period_.count() == 0) return serialize();
+
+  const auto key = fmt::format("{}\n{}\n{}\n{}", request.GetArg("format"), prefix,
+                         path, labels_json);
+  const auto cached = response_cache_->responses.Get(key);
+  if (cached &&
+      std::chrono::steady_clock::now() - cached->created < cache_period_) {
+    return cached->data;
   }
 
-  UINVARIANT(false, "Unexpected 'format' value");
+  const auto response = response_cache_->single_flight.Do(key, [&] {
+    auto fresh = std::make_shared<const ResponseCache::Response>(
+        ResponseCache::Response{
+            std::chrono::steady_clock::now(),
+            serialize(),
+        });
+    if (cached ||
+        response_cache_->responses.SizeApprox() < kMaxCachedResponses) {
+      response_cache_->responses.InsertOrAssign(key, fresh);
+    }
+    return fresh;
+  });
+  return response->data;
 }
 
 std::string ServerMonitor::GetResponseDataForLogging(const http::HttpRequest&,
@@ -138,6 +214,20 @@ properties:
             added to each metric.
         additionalProperties: true
         properties: {}
+    cache-period:
+        type: string
+        description: |
+            reuse the serialized response for the same request arguments
+            during this period, e.g. '5s'; 0 to serialize the metrics on
+            each request
+        defaultDescription: 0
+    statistics-task-processor:
+        type: string
+        description: |
+            task processor to collect and serialize the metrics on, so that
+            the heavy metrics writers do not stall the task processor of the
+            handler
+        defaultDescription: task processor of the handler
   )");
 }
 
@@ -93,8 +93,67 @@ properties:
         defaultDescription: <no limit>
     decompress_request:
         type: boolean
-        description: allow decompression of the requests
+        description: |
+            decompress the gzip and deflate request bodies as they are
+            received, max_request_size limits the decompressed size
         defaultDescription: false
+    compress_response:
+        type: object
+        description: gzip the responses for the clients that send 'Accept-Encoding gzip'
+        defaultDescription: <no compression>
+        additionalProperties: false
+        properties:
+            min_size:
+                type: integer
+                description: do not compress the smaller responses, the streamed responses are always compressed
+                defaultDescription: 1024
+                minimum: 0
+            level:
+                type: integer
+                description: gzip compression level, from 0 (no compression) to 9 (best compression)
+                defaultDescription: 6
+                minimum: 0
+                maximum: 9
+    adaptive_concurrency:
+        type: object
+        description: limit the requests in flight of the handler by a limit that follows its latency, the requests over the limit get 429
+        defaultDescription: <no limit>
+        additionalProperties: false
+        properties:
+            min_limit:
+                type: integer
+                description: the limit never goes below this value
+                defaultDescription: 10
+                minimum: 1
+            max_limit:
+                type: integer
+                description: the limit never goes above this value
+                defaultDescription: 1000
+                minimum: 1
+            initial_limit:
+                type: integer
+                description: the limit at the start
+                defaultDescription: 20
+                minimum: 1
+            percentile:
+                type: number
+                description: percentile of the latency over a window that is compared with its long term baseline
+                defaultDescription: 90
+            window_ms:
+                type: integer
+                description: how often the limit is recalculated
+                defaultDescription: 1000
+                minimum: 1
+            tolerance:
+                type: number
+                description: how many times the latency may exceed the baseline before the limit goes down
+                defaultDescription: 1.5
+            low_priority_percent:
+                type: integer
+                description: share of the limit for the low priority requests
+                defaultDescription: 80
+                minimum: 0
+                maximum: 100
     throttling_enabled:
         type: boolean
         description: allow throttling of the requests by components::Server , for more info see its `max_response_size_in_flight` and `requests_queue_size_threshold` options
@@ -107,6 +166,10 @@ properties:
         type: boolean
         description: TODO
         defaultDescription: false
+    request-body-stream:
+        type: boolean
+        description: pass the HTTP/1.x requests to the handler right after their headers, the handler reads the body with server::http::HttpRequest::GetBodyStream() as it arrives
+        defaultDescription: false
     monitor-handler:
         type: boolean
         description: overrides the in-code `is_monitor` flag that makes the handler run either on 'server.listener' or on 'server.listener-monitor'
@@ -115,6 +178,59 @@ properties:
         type: boolean
         description: whether to set http tracing headers (X-YaTraceId, X-YaSpanId, X-RequestId)
         defaultDescription: true
+    scope_time_stats:
+        type: boolean
+        description: export percentiles of the tracing::ScopeTime scopes of the request span as `http.handler.scope-time.timings` labeled by `scope`
+        defaultDescription: false
+    labeled_stats:
+        type: object
+        description: export the request counts, reply code classes and timing histogram as `http.handler.labeled.*` broken down by the request properties
+        defaultDescription: <no breakdown>
+        additionalProperties: false
+        properties:
+            labels:
+                type: array
+                description: request properties to label the metrics with
+                items:
+                    type: string
+                    description: one of 'path' (request path), 'client' (value of the client_header), 'response-size' (bucket of the response body size)
+                    enum:
+                      - path
+                      - client
+                      - response-size
+            max_label_sets:
+                type: integer
+                description: requests with the new label values beyond this count of label sets are accounted with all the labels set to `__other__`
+                defaultDescription: 100
+                minimum: 1
+            client_header:
+                type: string
+                description: request header that identifies the client service
+                defaultDescription: User-Agent
+    client_rate_limit:
+        type: object
+        description: limit the requests of each client over a sliding window, the requests over the limit get 429
+        defaultDescription: <no limit>
+        additionalProperties: false
+        properties:
+            client_header:
+                type: string
+                description: request header that identifies the client, the requests without it are not limited
+                defaultDescription: X-Client-Id
+            requests:
+                type: integer
+                description: max requests of a client over a window
+                minimum: 1
+            window_ms:
+                type: integer
+                description: duration of the sliding window
+                defaultDescription: 1000
+                minimum: 1
+            max_clients:
+                type: integer
+                description: requests of the new clients beyond this count share a single limit
+                defaultDescription: 10000
+                minimum: 1
 )");
 }
 
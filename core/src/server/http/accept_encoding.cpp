@@ -0,0 +1,83 @@
+#include <server/http/accept_encoding.hpp>
+
+#include <fmt/format.h>
+
+#include <userver/http/common_headers.hpp>
+#include <userver/utils/str_icase.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+namespace {
+
+constexpr std::string_view kWhitespace = " \t";
+
+std::string_view Trim(std::string_view value) {
+  const auto begin = value.find_first_not_of(kWhitespace);
+  if (begin == std::string_view::npos) return {};
+  const auto end = value.find_last_not_of(kWhitespace);
+  return value.substr(begin, end - begin + 1);
+}
+
+// The weight is "0", "0.", "0.0" ... or something non-zero up to "1.000"
+bool IsZeroWeight(std::string_view params) {
+  while (!params.empty()) {
+    const auto next = params.find(';');
+    auto param = Trim(params.substr(0, next));
+    params = next == std::string_view::npos ? std::string_view{}
+                                            : params.substr(next + 1);
+
+    if (param.size() < 2 || (param[0] != 'q' && param[0] != 'Q')) continue;
+    param = Trim(param.substr(1));
+    if (param.empty() || param.front() != '=') continue;
+    param = Trim(param.substr(1));
+    return param.find_first_not_of("0.") == std::string_view::npos;
+  }
+  return false;
+}
+
+}  // namespace
+
+bool IsEncodingAccepted(std::string_view accept_encoding,
+                        std::string_view coding) {
+  const utils::StrIcaseEqual equal;
+  bool is_wildcard_accepted = false;
+
+  while (!accept_encoding.empty()) {
+    const auto next = accept_encoding.find(',');
+    const auto item = accept_encoding.substr(0, next);
+    accept_encoding = next == std::string_view::npos
+                          ? std::string_view{}
+                          : accept_encoding.substr(next + 1);
+
+    const auto params_pos = item.find(';');
+    const auto name = Trim(item.substr(0, params_pos));
+    const bool is_accepted =
+        params_pos == std::string_view::npos ||
+        !IsZeroWeight(item.substr(params_pos + 1));
+
+    if (equal(name, coding)) return is_accepted;
+    if (name == "*") is_wildcard_accepted = is_accepted;
+  }
+  return is_wildcard_accepted;
+}
+
+void SetResponseEncoding(HttpResponse& response, std::string coding) {
+  response.SetContentEncoding(std::move(coding));
+
+  const std::string vary_name{USERVER_NAMESPACE::http::headers::kVary};
+  static constexpr std::string_view kAcceptEncoding =
+      USERVER_NAMESPACE::http::headers::kAcceptEncoding;
+  if (!response.HasHeader(vary_name)) {
+    response.SetHeader(vary_name, std::string{kAcceptEncoding});
+    return;
+  }
+  const auto& vary = response.GetHeader(vary_name);
+  if (vary == "*") return;
+  response.SetHeader(vary_name, fmt::format("{}, {}", vary, kAcceptEncoding));
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
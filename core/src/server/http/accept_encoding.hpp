@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string_view>
+
+#include <userver/server/http/http_response.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+/// @brief Checks the value of the `Accept-Encoding` header (RFC 7231, 5.3.4)
+/// for the content coding, e.g. "gzip"
+///
+/// The coding is acceptable if it is listed with a non-zero weight, or if it
+/// is not listed and "*" is listed with a non-zero weight.
+bool IsEncodingAccepted(std::string_view accept_encoding,
+                        std::string_view coding);
+
+/// @brief Sets the `Content-Encoding` of the compressed response and adds
+/// `Accept-Encoding` to its `Vary` header for the caches
+void SetResponseEncoding(HttpResponse& response, std::string coding);
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
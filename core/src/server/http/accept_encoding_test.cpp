@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include <server/http/accept_encoding.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using server::http::impl::IsEncodingAccepted;
+
+TEST(AcceptEncoding, Accepted) {
+  EXPECT_TRUE(IsEncodingAccepted("gzip", "gzip"));
+  EXPECT_TRUE(IsEncodingAccepted("GZip", "gzip"));
+  EXPECT_TRUE(IsEncodingAccepted("gzip, deflate, br", "gzip"));
+  EXPECT_TRUE(IsEncodingAccepted("br,gzip", "gzip"));
+  EXPECT_TRUE(IsEncodingAccepted(" br ; q=1.0 ,  gzip ; q=0.5 ", "gzip"));
+  EXPECT_TRUE(IsEncodingAccepted("gzip;Q=0.001", "gzip"));
+  EXPECT_TRUE(IsEncodingAccepted("*", "gzip"));
+  EXPECT_TRUE(IsEncodingAccepted("br, *;q=0.1", "gzip"));
+}
+
+TEST(AcceptEncoding, NotAccepted) {
+  EXPECT_FALSE(IsEncodingAccepted("", "gzip"));
+  EXPECT_FALSE(IsEncodingAccepted("identity", "gzip"));
+  EXPECT_FALSE(IsEncodingAccepted("br, deflate", "gzip"));
+  EXPECT_FALSE(IsEncodingAccepted("x-gzip", "gzip"));
+  EXPECT_FALSE(IsEncodingAccepted("gzip;q=0", "gzip"));
+  EXPECT_FALSE(IsEncodingAccepted("gzip; q=0.000", "gzip"));
+  EXPECT_FALSE(IsEncodingAccepted("*;q=0", "gzip"));
+  EXPECT_FALSE(IsEncodingAccepted("*, gzip;q=0", "gzip"));
+  EXPECT_FALSE(IsEncodingAccepted("gzip;q=0, *", "gzip"));
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,63 @@
+#include <server/http/byte_range.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <optional>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+namespace {
+
+constexpr std::string_view kBytesUnit = "bytes=";
+
+std::optional<std::size_t> ParsePosition(std::string_view value) {
+  std::size_t result = 0;
+  const auto* const end = value.data() + value.size();
+  const auto [ptr, ec] = std::from_chars(value.data(), end, result);
+  if (value.empty() || ec != std::errc{} || ptr != end) return std::nullopt;
+  return result;
+}
+
+}  // namespace
+
+ByteRange ParseByteRange(std::string_view header, std::size_t total_size) {
+  using Kind = ByteRange::Kind;
+
+  if (header.substr(0, kBytesUnit.size()) != kBytesUnit) return {};
+  header.remove_prefix(kBytesUnit.size());
+  if (header.find(',') != std::string_view::npos) return {};
+
+  const auto dash = header.find('-');
+  if (dash == std::string_view::npos) return {};
+  const auto first = header.substr(0, dash);
+  const auto last = header.substr(dash + 1);
+
+  if (first.empty()) {
+    // suffix-byte-range-spec: the last N bytes
+    const auto suffix = ParsePosition(last);
+    if (!suffix) return {};
+    if (*suffix == 0 || total_size == 0) return {Kind::kUnsatisfiable};
+    const auto size = std::min(*suffix, total_size);
+    return {Kind::kSatisfiable, total_size - size, size};
+  }
+
+  const auto first_pos = ParsePosition(first);
+  if (!first_pos) return {};
+  std::size_t last_pos = total_size;
+  if (!last.empty()) {
+    const auto parsed = ParsePosition(last);
+    if (!parsed || *parsed < *first_pos) return {};
+    last_pos = std::min(*parsed, total_size - 1);
+  } else if (total_size) {
+    last_pos = total_size - 1;
+  }
+
+  if (*first_pos >= total_size) return {Kind::kUnsatisfiable};
+  return {Kind::kSatisfiable, *first_pos, last_pos - *first_pos + 1};
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
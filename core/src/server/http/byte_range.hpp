@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+struct ByteRange final {
+  enum class Kind {
+    /// No range or an unsupported one, the whole representation is sent
+    kIgnored,
+    /// 206 Partial Content with the `offset` and `size`
+    kSatisfiable,
+    /// 416 Range Not Satisfiable
+    kUnsatisfiable,
+  };
+
+  Kind kind{Kind::kIgnored};
+  std::size_t offset{0};
+  std::size_t size{0};
+};
+
+/// @brief Parses the value of the `Range` header (RFC 7233) for a
+/// representation of `total_size` bytes
+///
+/// Only a single range of bytes is supported, the invalid values and the
+/// multiple ranges are ignored, as permitted by the RFC.
+ByteRange ParseByteRange(std::string_view header, std::size_t total_size);
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
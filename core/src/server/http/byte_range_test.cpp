@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include <server/http/byte_range.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::impl::ByteRange;
+using server::http::impl::ParseByteRange;
+using Kind = ByteRange::Kind;
+
+void ExpectRange(std::string_view header, std::size_t offset,
+                 std::size_t size) {
+  const auto range = ParseByteRange(header, 100);
+  EXPECT_EQ(range.kind, Kind::kSatisfiable) << header;
+  EXPECT_EQ(range.offset, offset) << header;
+  EXPECT_EQ(range.size, size) << header;
+}
+
+}  // namespace
+
+TEST(ByteRange, Satisfiable) {
+  ExpectRange("bytes=0-0", 0, 1);
+  ExpectRange("bytes=0-99", 0, 100);
+  ExpectRange("bytes=10-19", 10, 10);
+  ExpectRange("bytes=10-1000", 10, 90);
+  ExpectRange("bytes=10-", 10, 90);
+  ExpectRange("bytes=-10", 90, 10);
+  ExpectRange("bytes=-1000", 0, 100);
+}
+
+TEST(ByteRange, Unsatisfiable) {
+  for (const auto header : {"bytes=100-", "bytes=100-200", "bytes=-0"}) {
+    EXPECT_EQ(ParseByteRange(header, 100).kind, Kind::kUnsatisfiable)
+        << header;
+  }
+  EXPECT_EQ(ParseByteRange("bytes=0-", 0).kind, Kind::kUnsatisfiable);
+  EXPECT_EQ(ParseByteRange("bytes=-5", 0).kind, Kind::kUnsatisfiable);
+}
+
+TEST(ByteRange, Ignored) {
+  for (const auto header :
+       {"", "bytes=", "bytes=-", "items=0-1", "bytes=1-0", "bytes=a-1",
+        "bytes=0-1,5-6", "bytes= 0-1", "bytes=0-1x", "bytes=--1"}) {
+    EXPECT_EQ(ParseByteRange(header, 100).kind, Kind::kIgnored) << header;
+  }
+}
+
+USERVER_NAMESPACE_END
@@ -14,22 +14,25 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server {
 
-inline server::http::HttpRequestParser CreateTestParser(
-    server::http::HttpRequestParser::OnNewRequestCb&& cb) {
+inline constexpr server::request::HttpRequestConfig kTestRequestConfig{
+    /*.max_url_size = */ 8192,
+    /*.max_request_size = */ 1024 * 1024,
+    /*.max_headers_size = */ 65536,
+    /*.parse_args_from_body = */ false,
+    /*.testing_mode = */ true,  // non default value
+    /*.decompress_request = */ false,
+};
+
+template <typename Parser = server::http::HttpRequestParser>
+Parser CreateTestParser(
+    typename Parser::OnNewRequestCb&& cb,
+    const server::request::HttpRequestConfig& request_config =
+        kTestRequestConfig) {
   static const server::http::HandlerInfoIndex kTestHandlerInfoIndex;
-  static constexpr server::request::HttpRequestConfig kTestRequestConfig{
-      /*.max_url_size = */ 8192,
-      /*.max_request_size = */ 1024 * 1024,
-      /*.max_headers_size = */ 65536,
-      /*.parse_args_from_body = */ false,
-      /*.testing_mode = */ true,  // non default value
-      /*.decompress_request = */ false,
-  };
   static server::net::ParserStats test_stats;
   static server::request::ResponseDataAccounter test_accounter;
-  return server::http::HttpRequestParser(kTestHandlerInfoIndex,
-                                         kTestRequestConfig, std::move(cb),
-                                         test_stats, test_accounter);
+  return Parser(kTestHandlerInfoIndex, request_config, std::move(cb),
+                test_stats, test_accounter);
 }
 
 }  // namespace server
@@ -1,6 +1,8 @@
 #include <server/http/fixed_path_index.hpp>
 
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -32,14 +34,22 @@ void FixedPathIndex::AddHandler(std::string path,
                                 engine::TaskProcessor& task_processor) {
   handler_method_index_map_[std::move(path)].AddHandler(handler, task_processor,
                                                         {});
+
+  std::vector<std::pair<std::string, const HandlerMethodIndex*>> items;
+  items.reserve(handler_method_index_map_.size());
+  for (const auto& [key, handler_method_index] : handler_method_index_map_) {
+    items.emplace_back(key, &handler_method_index);
+  }
+  index_ = PerfectHashIndex<const HandlerMethodIndex*>{std::move(items)};
 }
 
 bool FixedPathIndex::MatchRequest(HttpMethod method, const std::string& path,
                                   MatchRequestResult& match_result) const {
-  auto it = handler_method_index_map_.find(path);
-  if (it == handler_method_index_map_.end()) return false;
+  const auto* handler_method_index = index_.Find(path);
+  if (!handler_method_index) return false;
 
-  const auto* handler_info_data = it->second.GetHandlerInfoData(method);
+  const auto* handler_info_data =
+      (*handler_method_index)->GetHandlerInfoData(method);
   if (!handler_info_data) {
     match_result.status = MatchRequestResult::Status::kMethodNotAllowed;
     return false;
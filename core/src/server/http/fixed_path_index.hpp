@@ -7,6 +7,7 @@
 
 #include <server/http/handler_info_index.hpp>
 #include <server/http/handler_method_index.hpp>
+#include <server/http/perfect_hash_index.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/server/http/http_method.hpp>
 
@@ -26,6 +27,8 @@ class FixedPathIndex final {
                   engine::TaskProcessor& task_processor);
 
   std::unordered_map<std::string, HandlerMethodIndex> handler_method_index_map_;
+  // Rebuilt on each AddHandler(), as the handlers are added only at startup
+  PerfectHashIndex<const HandlerMethodIndex*> index_;
 };
 
 }  // namespace server::http::impl
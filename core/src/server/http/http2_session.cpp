@@ -0,0 +1,594 @@
+#include "http2_session.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/server/http/http_method.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/server/request/request_base.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/scope_guard.hpp>
+
+#include "http_cached_date.hpp"
+#include "http_request_constructor.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+// The client preface is "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n", nghttp2 checks the
+// rest of it. HTTP/1.x requests never start this way.
+constexpr std::string_view kPrefaceStart = "PRI * HTTP/2.0";
+
+constexpr std::string_view kAuthorityHeader = ":authority";
+constexpr std::string_view kMethodHeader = ":method";
+constexpr std::string_view kPathHeader = ":path";
+constexpr std::string_view kCookieHeader = "cookie";
+
+const std::string kDefaultContentType = "text/html; charset=utf-8";
+
+// RFC 7540, section 8.1.2.2
+constexpr std::array<std::string_view, 6> kConnectionSpecificHeaders{
+    "connection",        "keep-alive", "proxy-connection",
+    "transfer-encoding", "upgrade",    "content-length",
+};
+
+bool IsConnectionSpecificHeader(std::string_view lowercase_name) {
+  return std::find(kConnectionSpecificHeaders.begin(),
+                   kConnectionSpecificHeaders.end(),
+                   lowercase_name) != kConnectionSpecificHeaders.end();
+}
+
+bool IsBodyForbiddenForStatus(HttpStatus status) {
+  return status == HttpStatus::kNoContent ||
+         status == HttpStatus::kNotModified ||
+         (static_cast<int>(status) >= 100 && static_cast<int>(status) < 200);
+}
+
+std::string ToLowerAscii(std::string_view name) {
+  std::string result{name};
+  for (auto& c : result) {
+    if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+  }
+  return result;
+}
+
+nghttp2_nv MakeNv(std::string_view name, std::string_view value) {
+  // nghttp2 copies the header fields on submit
+  return {reinterpret_cast<uint8_t*>(const_cast<char*>(name.data())),
+          reinterpret_cast<uint8_t*>(const_cast<char*>(value.data())),
+          name.size(), value.size(), NGHTTP2_NV_FLAG_NONE};
+}
+
+void CheckNghttp2(int rv, std::string_view what) {
+  if (rv < 0) {
+    throw std::runtime_error(fmt::format("{} failed: {}", what,
+                                         nghttp2_strerror(rv)));
+  }
+}
+
+}  // namespace
+
+struct Http2Session::Stream final {
+  explicit Stream(int32_t id) : id(id) {}
+
+  const int32_t id;
+
+  // Set until the request is received completely
+  std::optional<HttpRequestConstructor> request_constructor;
+  bool url_complete{false};
+  bool is_malformed{false};
+  std::string cookies;
+
+  // Keeps the response and its data alive until the stream is closed
+  std::shared_ptr<request::RequestBase> request;
+  std::string owned_body;
+  std::string_view body;
+  bool is_body_complete{false};
+  bool is_closed{false};
+};
+
+Http2Session::Http2Session(const net::ConnectionConfig& config,
+                           const HandlerInfoIndex& handler_info_index,
+                           const request::HttpRequestConfig& request_config,
+                           OnNewRequestCb&& on_new_request_cb,
+                           net::ParserStats& stats,
+                           request::ResponseDataAccounter& data_accounter,
+                           engine::io::Socket& socket)
+    : handler_info_index_(handler_info_index),
+      request_config_(request_config),
+      max_pending_body_size_(config.in_buffer_size),
+      on_new_request_cb_(std::move(on_new_request_cb)),
+      stats_(stats),
+      data_accounter_(data_accounter),
+      socket_(socket) {
+  nghttp2_session_callbacks* callbacks = nullptr;
+  CheckNghttp2(nghttp2_session_callbacks_new(&callbacks),
+               "nghttp2_session_callbacks_new");
+  utils::ScopeGuard callbacks_guard(
+      [callbacks] { nghttp2_session_callbacks_del(callbacks); });
+
+  nghttp2_session_callbacks_set_on_begin_headers_callback(callbacks,
+                                                          &OnBeginHeaders);
+  nghttp2_session_callbacks_set_on_header_callback(callbacks, &OnHeader);
+  nghttp2_session_callbacks_set_on_data_chunk_recv_callback(callbacks,
+                                                            &OnDataChunkRecv);
+  nghttp2_session_callbacks_set_on_frame_recv_callback(callbacks,
+                                                       &OnFrameRecv);
+  nghttp2_session_callbacks_set_on_stream_close_callback(callbacks,
+                                                         &OnStreamClose);
+
+  nghttp2_option* option = nullptr;
+  CheckNghttp2(nghttp2_option_new(&option), "nghttp2_option_new");
+  utils::ScopeGuard option_guard([option] { nghttp2_option_del(option); });
+  // Our HPACK encoder uses no more than the decoder of the peer allows
+  nghttp2_option_set_max_deflate_dynamic_table_size(
+      option, config.http2_header_table_size);
+
+  CheckNghttp2(
+      nghttp2_session_server_new2(&session_, callbacks, this, option),
+      "nghttp2_session_server_new2");
+
+  const std::array<nghttp2_settings_entry, 3> settings{{
+      {NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS,
+       static_cast<uint32_t>(config.http2_max_concurrent_streams)},
+      {NGHTTP2_SETTINGS_HEADER_TABLE_SIZE,
+       static_cast<uint32_t>(config.http2_header_table_size)},
+      {NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE,
+       static_cast<uint32_t>(config.http2_initial_window_size)},
+  }};
+  // Sent along with the first reply of the session
+  CheckNghttp2(nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE,
+                                       settings.data(), settings.size()),
+               "nghttp2_submit_settings");
+}
+
+Http2Session::~Http2Session() {
+  for (const auto& [id, stream] : streams_) {
+    if (stream->request_constructor) --stats_.parsing_request_count;
+  }
+  nghttp2_session_del(session_);
+}
+
+bool Http2Session::IsPreface(std::string_view data) {
+  return data.size() >= kPrefaceStart.size() &&
+         data.substr(0, kPrefaceStart.size()) == kPrefaceStart;
+}
+
+bool Http2Session::Parse(const char* data, size_t size) {
+  std::unique_lock lock(mutex_);
+  const auto parsed = nghttp2_session_mem_recv(
+      session_, reinterpret_cast<const uint8_t*>(data), size);
+  if (parsed < 0) {
+    LOG_WARNING() << "HTTP/2 session error: " << nghttp2_strerror(parsed);
+    // Tries to send GOAWAY
+    nghttp2_session_terminate_session(session_, NGHTTP2_PROTOCOL_ERROR);
+  }
+  Flush();
+  const bool is_alive = parsed >= 0 && (nghttp2_session_want_read(session_) ||
+                                        nghttp2_session_want_write(session_));
+  auto requests = std::move(parsed_requests_);
+  parsed_requests_.clear();
+  lock.unlock();
+
+  // WINDOW_UPDATE may have let the streamed bodies through
+  window_cv_.NotifyAll();
+  for (auto& request : requests) on_new_request_cb_(std::move(request));
+  return is_alive;
+}
+
+void Http2Session::SendResponse(
+    const std::shared_ptr<request::RequestBase>& request) {
+  auto& response = static_cast<HttpResponse&>(request->GetResponse());
+
+  // HTTP/2 frames the data itself, no sendfile(2) here
+  std::string file_body;
+  if (response.GetFileBody() && !IsBodyForbiddenForStatus(response.status_) &&
+      response.request_.GetOrigMethod() != HttpMethod::kHead) {
+    file_body = response.ReadFileBody();
+  }
+
+  std::unique_lock lock(mutex_);
+  const auto it = responding_.find(request.get());
+  UASSERT(it != responding_.end());
+  const auto stream = std::move(it->second);
+  responding_.erase(it);
+
+  if (stream->is_closed) {
+    lock.unlock();
+    LOG_DEBUG() << "HTTP/2 stream " << stream->id
+                << " was closed before the response";
+    response.SetSendFailed(std::chrono::steady_clock::now());
+    return;
+  }
+
+  auto bytes_sent = SubmitResponse(*stream, response, std::move(file_body));
+  lock.unlock();
+
+  if (response.IsBodyStreamed() && response.GetData().empty()) {
+    bytes_sent += SendStreamedBody(stream, response);
+  }
+
+  response.SetSentTime(std::chrono::steady_clock::now());
+  response.SetSent(bytes_sent);
+}
+
+size_t Http2Session::SubmitResponse(Stream& stream, HttpResponse& response,
+                                    std::string&& file_body) {
+  const auto status_str =
+      fmt::format(FMT_COMPILE("{}"), static_cast<int>(response.status_));
+
+  static const PreparedHeaders::Data kNoPreparedHeaders;
+  const auto& prepared = response.prepared_headers_.data_
+                             ? *response.prepared_headers_.data_
+                             : kNoPreparedHeaders;
+
+  std::vector<std::string> names;
+  names.reserve(response.headers_.size());
+  std::vector<nghttp2_nv> nva;
+  nva.reserve(response.headers_.size() + prepared.headers.size() +
+              response.cookies_.size() + 4);
+  nva.push_back(MakeNv(":status", status_str));
+
+  const auto& headers = response.headers_;
+  std::string date;
+  if (!prepared.has_date &&
+      headers.find(USERVER_NAMESPACE::http::headers::kDate) == headers.end()) {
+    AppendCachedDate(date);
+    nva.push_back(MakeNv("date", date));
+  }
+  if (!prepared.has_content_type &&
+      headers.find(USERVER_NAMESPACE::http::headers::kContentType) ==
+          headers.end()) {
+    nva.push_back(MakeNv("content-type", kDefaultContentType));
+  }
+  for (const auto& [name, value] : headers) {
+    auto& lowercase_name = names.emplace_back(ToLowerAscii(name));
+    if (IsConnectionSpecificHeader(lowercase_name)) continue;
+    nva.push_back(MakeNv(lowercase_name, value));
+  }
+  // The names are already lowercase
+  for (const auto& [name, value] : prepared.headers) {
+    if (IsConnectionSpecificHeader(name)) continue;
+    nva.push_back(MakeNv(name, value));
+  }
+
+  std::vector<std::string> cookies;
+  cookies.reserve(response.cookies_.size());
+  for (const auto& [name, cookie] : response.cookies_) {
+    auto& value = cookies.emplace_back();
+    cookie.AppendToString(value);
+    nva.push_back(MakeNv("set-cookie", value));
+  }
+
+  const bool is_body_forbidden = IsBodyForbiddenForStatus(response.status_);
+  const bool is_head_request =
+      response.request_.GetOrigMethod() == HttpMethod::kHead;
+  const bool is_streamed =
+      response.IsBodyStreamed() && response.GetData().empty();
+  const auto& data = response.GetData();
+  const auto* file_body_info = response.GetFileBody();
+  const auto body_size = file_body_info ? file_body_info->size : data.size();
+
+  std::string content_length;
+  if (!is_body_forbidden && !is_streamed) {
+    content_length = fmt::format(FMT_COMPILE("{}"), body_size);
+    nva.push_back(MakeNv("content-length", content_length));
+  }
+  if (is_body_forbidden && body_size != 0) {
+    LOG_LIMITED_WARNING()
+        << "Non-empty body provided for response with HTTP code "
+        << static_cast<int>(response.status_)
+        << " which does not allow one, it will be dropped";
+  }
+
+  size_t bytes_sent = 0;
+  for (const auto& nv : nva) bytes_sent += nv.namelen + nv.valuelen;
+
+  nghttp2_data_provider provider{};
+  provider.source.ptr = &stream;
+  provider.read_callback = &OnReadBody;
+  const bool has_body = !is_body_forbidden && !is_head_request;
+  if (has_body && !is_streamed) {
+    if (file_body_info) {
+      stream.owned_body = std::move(file_body);
+      stream.body = stream.owned_body;
+    } else {
+      stream.body = data;
+    }
+    stream.is_body_complete = true;
+    bytes_sent += stream.body.size();
+  }
+
+  CheckNghttp2(nghttp2_submit_response(session_, stream.id, nva.data(),
+                                       nva.size(),
+                                       has_body ? &provider : nullptr),
+               "nghttp2_submit_response");
+  Flush();
+  return bytes_sent;
+}
+
+size_t Http2Session::SendStreamedBody(const StreamPtr& stream,
+                                      HttpResponse& response) {
+  const bool is_body_allowed =
+      !IsBodyForbiddenForStatus(response.status_) &&
+      response.request_.GetOrigMethod() != HttpMethod::kHead;
+
+  size_t bytes_sent = 0;
+  std::string body_part;
+  while (response.body_stream_->Pop(body_part)) {
+    if (body_part.empty() || !is_body_allowed) continue;
+
+    std::unique_lock lock(mutex_);
+    // Waits for the peer to read the data, just like a blocking socket does
+    [[maybe_unused]] const bool ok = window_cv_.Wait(lock, [&stream, this] {
+      return stream->is_closed || stream->body.size() < max_pending_body_size_;
+    });
+    if (stream->is_closed) break;
+
+    auto& owned_body = stream->owned_body;
+    owned_body.erase(0, owned_body.size() - stream->body.size());
+    owned_body.append(body_part);
+    stream->body = owned_body;
+    bytes_sent += body_part.size();
+    nghttp2_session_resume_data(session_, stream->id);
+    Flush();
+  }
+
+  response.body_stream_producer_.reset();
+  response.body_stream_.reset();
+
+  std::unique_lock lock(mutex_);
+  if (!stream->is_closed) {
+    stream->is_body_complete = true;
+    nghttp2_session_resume_data(session_, stream->id);
+    Flush();
+  }
+  return bytes_sent;
+}
+
+void Http2Session::Flush() {
+  while (true) {
+    const uint8_t* data = nullptr;
+    const auto size = nghttp2_session_mem_send(session_, &data);
+    CheckNghttp2(size, "nghttp2_session_mem_send");
+    if (size == 0) break;
+    if (socket_.SendAll(data, size, {}) != static_cast<size_t>(size)) {
+      throw std::runtime_error("peer has closed the HTTP/2 connection");
+    }
+  }
+}
+
+Http2Session::Stream* Http2Session::FindStream(int32_t stream_id) const {
+  const auto it = streams_.find(stream_id);
+  return it == streams_.end() ? nullptr : it->second.get();
+}
+
+bool Http2Session::CheckUrlComplete(Stream& stream) {
+  if (stream.url_complete) return true;
+  stream.url_complete = true;
+  stream.request_constructor->SetHttpMajor(2);
+  stream.request_constructor->SetHttpMinor(0);
+  try {
+    stream.request_constructor->ParseUrl();
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't parse url: " << ex;
+    return false;
+  }
+  return true;
+}
+
+void Http2Session::FinalizeRequest(Stream& stream) {
+  UASSERT(stream.request_constructor);
+  --stats_.parsing_request_count;
+
+  // The malformed requests get the error responses from Finalize(), just like
+  // the ones that failed the HTTP/1.x parsing
+  auto request = stream.request_constructor->Finalize();
+  stream.request_constructor.reset();
+  if (!request) {
+    LOG_ERROR() << "request is null after Finalize()";
+    nghttp2_submit_rst_stream(session_, NGHTTP2_FLAG_NONE, stream.id,
+                              NGHTTP2_INTERNAL_ERROR);
+    return;
+  }
+
+  stream.request = request;
+  responding_.emplace(request.get(), streams_.at(stream.id));
+  parsed_requests_.push_back(std::move(request));
+}
+
+int Http2Session::OnBeginHeaders(nghttp2_session*, const nghttp2_frame* frame,
+                                 void* user_data) {
+  auto* http2_session = static_cast<Http2Session*>(user_data);
+  UASSERT(http2_session != nullptr);
+  return http2_session->OnBeginHeadersImpl(*frame);
+}
+
+int Http2Session::OnHeader(nghttp2_session*, const nghttp2_frame* frame,
+                           const uint8_t* name, size_t namelen,
+                           const uint8_t* value, size_t valuelen, uint8_t,
+                           void* user_data) {
+  auto* http2_session = static_cast<Http2Session*>(user_data);
+  UASSERT(http2_session != nullptr);
+  return http2_session->OnHeaderImpl(
+      *frame, {reinterpret_cast<const char*>(name), namelen},
+      {reinterpret_cast<const char*>(value), valuelen});
+}
+
+int Http2Session::OnDataChunkRecv(nghttp2_session*, uint8_t, int32_t stream_id,
+                                  const uint8_t* data, size_t len,
+                                  void* user_data) {
+  auto* http2_session = static_cast<Http2Session*>(user_data);
+  UASSERT(http2_session != nullptr);
+  return http2_session->OnDataChunkRecvImpl(
+      stream_id, {reinterpret_cast<const char*>(data), len});
+}
+
+int Http2Session::OnFrameRecv(nghttp2_session*, const nghttp2_frame* frame,
+                              void* user_data) {
+  auto* http2_session = static_cast<Http2Session*>(user_data);
+  UASSERT(http2_session != nullptr);
+  return http2_session->OnFrameRecvImpl(*frame);
+}
+
+int Http2Session::OnStreamClose(nghttp2_session*, int32_t stream_id, uint32_t,
+                                void* user_data) {
+  auto* http2_session = static_cast<Http2Session*>(user_data);
+  UASSERT(http2_session != nullptr);
+  return http2_session->OnStreamCloseImpl(stream_id);
+}
+
+ssize_t Http2Session::OnReadBody(nghttp2_session*, int32_t, uint8_t* buf,
+                                 size_t length, uint32_t* data_flags,
+                                 nghttp2_data_source* source, void*) {
+  auto& stream = *static_cast<Stream*>(source->ptr);
+  const auto size = std::min(length, stream.body.size());
+  std::memcpy(buf, stream.body.data(), size);
+  stream.body.remove_prefix(size);
+
+  if (stream.body.empty()) {
+    if (stream.is_body_complete) {
+      *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+    } else if (size == 0) {
+      // Resumed once the next chunk of the streamed body is ready
+      return NGHTTP2_ERR_DEFERRED;
+    }
+  }
+  return static_cast<ssize_t>(size);
+}
+
+int Http2Session::OnBeginHeadersImpl(const nghttp2_frame& frame) {
+  if (frame.hd.type != NGHTTP2_HEADERS ||
+      frame.headers.cat != NGHTTP2_HCAT_REQUEST) {
+    return 0;
+  }
+
+  LOG_TRACE() << "HTTP/2 stream " << frame.hd.stream_id << " begin";
+  auto stream = std::make_shared<Stream>(frame.hd.stream_id);
+  stream->request_constructor.emplace(request_config_, handler_info_index_,
+                                      data_accounter_);
+  ++stats_.parsing_request_count;
+  streams_.emplace(frame.hd.stream_id, std::move(stream));
+  return 0;
+}
+
+int Http2Session::OnHeaderImpl(const nghttp2_frame& frame,
+                               std::string_view name, std::string_view value) {
+  // Trailers are of no use for handlers, just like in HTTP/1.1
+  if (frame.headers.cat != NGHTTP2_HCAT_REQUEST) return 0;
+  auto* stream = FindStream(frame.hd.stream_id);
+  if (!stream || !stream->request_constructor || stream->is_malformed) {
+    return 0;
+  }
+  LOG_TRACE() << "header: '" << name << "': '" << value << '\'';
+
+  auto& constructor = *stream->request_constructor;
+  try {
+    if (name == kMethodHeader) {
+      constructor.SetMethod(HttpMethodFromString(value));
+    } else if (name == kPathHeader) {
+      constructor.AppendUrl(value.data(), value.size());
+    } else if (name == kAuthorityHeader) {
+      const std::string_view host = USERVER_NAMESPACE::http::headers::kHost;
+      constructor.AppendHeaderField(host.data(), host.size());
+      constructor.AppendHeaderValue(value.data(), value.size());
+    } else if (!name.empty() && name[0] == ':') {
+      // :scheme and the rest of pseudo-headers are of no use for handlers
+    } else if (name == kCookieHeader) {
+      // RFC 7540, section 8.1.2.5
+      if (!stream->cookies.empty()) stream->cookies.append("; ");
+      stream->cookies.append(value);
+    } else {
+      if (!CheckUrlComplete(*stream)) {
+        stream->is_malformed = true;
+        return 0;
+      }
+      constructor.AppendHeaderField(name.data(), name.size());
+      constructor.AppendHeaderValue(value.data(), value.size());
+    }
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append header: " << ex;
+    stream->is_malformed = true;
+  }
+  return 0;
+}
+
+int Http2Session::OnDataChunkRecvImpl(int32_t stream_id,
+                                      std::string_view data) {
+  auto* stream = FindStream(stream_id);
+  if (!stream || !stream->request_constructor || stream->is_malformed) {
+    return 0;
+  }
+  LOG_TRACE() << "body: '" << data << "'";
+
+  try {
+    stream->request_constructor->AppendBody(data.data(), data.size());
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append body: " << ex;
+    stream->is_malformed = true;
+  }
+  return 0;
+}
+
+int Http2Session::OnFrameRecvImpl(const nghttp2_frame& frame) {
+  if (frame.hd.type != NGHTTP2_HEADERS && frame.hd.type != NGHTTP2_DATA) {
+    return 0;
+  }
+  auto* stream = FindStream(frame.hd.stream_id);
+  if (!stream || !stream->request_constructor) return 0;
+
+  if (frame.hd.type == NGHTTP2_HEADERS &&
+      frame.headers.cat == NGHTTP2_HCAT_REQUEST && !stream->is_malformed) {
+    auto& constructor = *stream->request_constructor;
+    try {
+      if (!CheckUrlComplete(*stream)) {
+        stream->is_malformed = true;
+      } else {
+        if (!stream->cookies.empty()) {
+          constructor.AppendHeaderField(kCookieHeader.data(),
+                                        kCookieHeader.size());
+          constructor.AppendHeaderValue(stream->cookies.data(),
+                                        stream->cookies.size());
+          std::string().swap(stream->cookies);
+        }
+        constructor.AppendHeaderField("", 0);
+      }
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "can't append header: " << ex;
+      stream->is_malformed = true;
+    }
+  }
+
+  if (frame.hd.flags & NGHTTP2_FLAG_END_STREAM) {
+    LOG_TRACE() << "HTTP/2 stream " << stream->id << " request complete";
+    FinalizeRequest(*stream);
+  }
+  return 0;
+}
+
+int Http2Session::OnStreamCloseImpl(int32_t stream_id) {
+  const auto it = streams_.find(stream_id);
+  if (it == streams_.end()) return 0;
+
+  LOG_TRACE() << "HTTP/2 stream " << stream_id << " closed";
+  auto& stream = *it->second;
+  if (stream.request_constructor) --stats_.parsing_request_count;
+  stream.is_closed = true;
+  streams_.erase(it);
+  return 0;
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <nghttp2/nghttp2.h>
+
+#include <server/net/connection_config.hpp>
+#include <server/net/stats.hpp>
+#include <server/request/request_parser.hpp>
+
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/server/request/request_config.hpp>
+
+#include "handler_info_index.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+class HttpResponse;
+
+/// @brief Server side of an HTTP/2 connection (h2c with prior knowledge)
+///
+/// Parses the frames received from the peer into the requests and frames the
+/// responses. nghttp2 takes care of the per-stream flow control and of the
+/// HPACK dynamic tables. The reading and the sending tasks of the connection
+/// both write to the socket, so they serialize on the session mutex.
+class Http2Session final : public request::RequestParser {
+ public:
+  using OnNewRequestCb =
+      std::function<void(std::shared_ptr<request::RequestBase>&&)>;
+
+  Http2Session(const net::ConnectionConfig& config,
+               const HandlerInfoIndex& handler_info_index,
+               const request::HttpRequestConfig& request_config,
+               OnNewRequestCb&& on_new_request_cb, net::ParserStats& stats,
+               request::ResponseDataAccounter& data_accounter,
+               engine::io::Socket& socket);
+
+  Http2Session(Http2Session&&) = delete;
+  Http2Session& operator=(Http2Session&&) = delete;
+  ~Http2Session() override;
+
+  /// @returns whether the connection starts with the HTTP/2 client preface
+  static bool IsPreface(std::string_view data);
+
+  using request::RequestParser::Parse;
+
+  /// Feeds the received data into the session and sends out the frames the
+  /// session replies with, e.g. SETTINGS ACK or WINDOW_UPDATE.
+  /// @returns false on a connection error or if the peer has gone away
+  bool Parse(const char* data, size_t size) override;
+
+  /// Submits the response for the request that was parsed by this session.
+  /// Does not wait for the whole body to be sent, only the streamed body
+  /// chunks wait for the peer to open the flow control window.
+  void SendResponse(const std::shared_ptr<request::RequestBase>& request);
+
+ private:
+  struct Stream;
+  using StreamPtr = std::shared_ptr<Stream>;
+
+  static int OnBeginHeaders(nghttp2_session* session,
+                            const nghttp2_frame* frame, void* user_data);
+  static int OnHeader(nghttp2_session* session, const nghttp2_frame* frame,
+                      const uint8_t* name, size_t namelen,
+                      const uint8_t* value, size_t valuelen, uint8_t flags,
+                      void* user_data);
+  static int OnDataChunkRecv(nghttp2_session* session, uint8_t flags,
+                             int32_t stream_id, const uint8_t* data,
+                             size_t len, void* user_data);
+  static int OnFrameRecv(nghttp2_session* session, const nghttp2_frame* frame,
+                         void* user_data);
+  static int OnStreamClose(nghttp2_session* session, int32_t stream_id,
+                           uint32_t error_code, void* user_data);
+  static ssize_t OnReadBody(nghttp2_session* session, int32_t stream_id,
+                            uint8_t* buf, size_t length, uint32_t* data_flags,
+                            nghttp2_data_source* source, void* user_data);
+
+  int OnBeginHeadersImpl(const nghttp2_frame& frame);
+  int OnHeaderImpl(const nghttp2_frame& frame, std::string_view name,
+                   std::string_view value);
+  int OnDataChunkRecvImpl(int32_t stream_id, std::string_view data);
+  int OnFrameRecvImpl(const nghttp2_frame& frame);
+  int OnStreamCloseImpl(int32_t stream_id);
+
+  Stream* FindStream(int32_t stream_id) const;
+  bool CheckUrlComplete(Stream& stream);
+  void FinalizeRequest(Stream& stream);
+
+  // Must be called with the mutex locked
+  void Flush();
+
+  // Both return the amount of the submitted data
+  size_t SubmitResponse(Stream& stream, HttpResponse& response,
+                        std::string&& file_body);
+  size_t SendStreamedBody(const StreamPtr& stream, HttpResponse& response);
+
+  const HandlerInfoIndex& handler_info_index_;
+  const request::HttpRequestConfig request_config_;
+  const size_t max_pending_body_size_;
+  OnNewRequestCb on_new_request_cb_;
+  net::ParserStats& stats_;
+  request::ResponseDataAccounter& data_accounter_;
+  engine::io::Socket& socket_;
+
+  engine::Mutex mutex_;
+  engine::ConditionVariable window_cv_;
+  nghttp2_session* session_{nullptr};
+  std::unordered_map<int32_t, StreamPtr> streams_;
+  std::unordered_map<const request::RequestBase*, StreamPtr> responding_;
+  // Requests parsed by the current Parse() call, they are dispatched with
+  // the mutex unlocked as the dispatch may wait for the queue of responses
+  std::vector<std::shared_ptr<request::RequestBase>> parsed_requests_;
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
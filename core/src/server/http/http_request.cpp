@@ -106,14 +106,24 @@ bool HttpRequest::HasPathArg(size_t index) const {
 size_t HttpRequest::PathArgCount() const { return impl_.PathArgCount(); }
 
 const std::string& HttpRequest::GetHeader(
-    const std::string& header_name) const {
+    std::string_view header_name) const {
   return impl_.GetHeader(header_name);
 }
 
-bool HttpRequest::HasHeader(const std::string& header_name) const {
+const std::string& HttpRequest::GetHeader(
+    USERVER_NAMESPACE::http::headers::PredefinedHeader header) const {
+  return impl_.GetHeader(header);
+}
+
+bool HttpRequest::HasHeader(std::string_view header_name) const {
   return impl_.HasHeader(header_name);
 }
 
+bool HttpRequest::HasHeader(
+    USERVER_NAMESPACE::http::headers::PredefinedHeader header) const {
+  return impl_.HasHeader(header);
+}
+
 size_t HttpRequest::HeaderCount() const { return impl_.HeaderCount(); }
 
 HttpRequest::HeadersMapKeys HttpRequest::GetHeaderNames() const {
@@ -139,6 +149,16 @@ const std::string& HttpRequest::RequestBody() const {
   return impl_.RequestBody();
 }
 
+std::vector<std::string_view> HttpRequest::RequestBodyChunks() const {
+  return impl_.RequestBodyChunks();
+}
+
+bool HttpRequest::IsBodyStreamed() const { return impl_.IsBodyStreamed(); }
+
+RequestBodyStream& HttpRequest::GetBodyStream() const {
+  return impl_.GetBodyStream();
+}
+
 void HttpRequest::SetRequestBody(std::string body) {
   impl_.SetRequestBody(std::move(body));
 }  // namespace server::http
@@ -151,6 +171,10 @@ void HttpRequest::SetResponseStatus(HttpStatus status) const {
 
 bool HttpRequest::IsBodyCompressed() const { return impl_.IsBodyCompressed(); }
 
+bool HttpRequest::IsBodyDecompressed() const {
+  return impl_.IsBodyDecompressed();
+}
+
 }  // namespace server::http
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,44 @@
+#include <userver/server/http/http_request_body_stream.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+RequestBodyStream::RequestBodyStream(Queue::Consumer&& consumer)
+    : consumer_(std::move(consumer)) {}
+
+RequestBodyStream::RequestBodyStream(const std::string& body) : body_(body) {}
+
+bool RequestBodyStream::ReadChunk(std::string& chunk,
+                                  engine::Deadline deadline) {
+  if (is_finished_) return false;
+
+  if (!consumer_) {
+    is_finished_ = true;
+    if (body_.empty()) return false;
+    chunk = std::move(body_);
+    return true;
+  }
+
+  std::string part;
+  if (!consumer_->Pop(part, deadline)) {
+    if (deadline.IsReached()) {
+      throw RequestBodyStreamError(
+          "deadline expired while waiting for the request body");
+    }
+    is_finished_ = true;
+    throw RequestBodyStreamError("the request body was not received in full");
+  }
+
+  // The parts are never empty, an empty one marks the end of the body
+  if (part.empty()) {
+    is_finished_ = true;
+    return false;
+  }
+  chunk = std::move(part);
+  return true;
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,106 @@
+#include <userver/utest/utest.hpp>
+
+#include <string>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/server/http/http_request_body_stream.hpp>
+
+#include <server/http/http_request_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::RequestBodyStreamError;
+
+std::vector<std::string> ReadAll(server::http::RequestBodyStream& stream) {
+  std::vector<std::string> result;
+  std::string chunk;
+  while (stream.ReadChunk(chunk)) result.push_back(chunk);
+  return result;
+}
+
+}  // namespace
+
+UTEST(RequestBodyStream, NotStreamed) {
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  request.SetRequestBody("body");
+
+  EXPECT_FALSE(request.IsBodyStreamed());
+  EXPECT_EQ(ReadAll(request.GetBodyStream()),
+            std::vector<std::string>{"body"});
+  std::string chunk;
+  EXPECT_FALSE(request.GetBodyStream().ReadChunk(chunk));
+}
+
+UTEST(RequestBodyStream, Streamed) {
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  auto producer = request.StartBodyStream();
+  EXPECT_TRUE(request.IsBodyStreamed());
+
+  auto task = engine::AsyncNoSpan([&producer] {
+    for (const auto* chunk : {"a", "bc", "def", ""}) {
+      EXPECT_TRUE(producer.Push(chunk));
+      engine::Yield();
+    }
+  });
+
+  EXPECT_EQ(ReadAll(request.GetBodyStream()),
+            (std::vector<std::string>{"a", "bc", "def"}));
+  task.Get();
+  std::string chunk;
+  EXPECT_FALSE(request.GetBodyStream().ReadChunk(chunk));
+}
+
+UTEST(RequestBodyStream, CutShort) {
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  {
+    auto producer = request.StartBodyStream();
+    EXPECT_TRUE(producer.Push("part"));
+  }
+
+  auto& stream = request.GetBodyStream();
+  std::string chunk;
+  EXPECT_TRUE(stream.ReadChunk(chunk));
+  EXPECT_EQ(chunk, "part");
+  EXPECT_THROW(stream.ReadChunk(chunk), RequestBodyStreamError);
+}
+
+UTEST(RequestBodyStream, Deadline) {
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  auto producer = request.StartBodyStream();
+
+  auto& stream = request.GetBodyStream();
+  std::string chunk;
+  EXPECT_THROW(stream.ReadChunk(chunk, engine::Deadline::Passed()),
+               RequestBodyStreamError);
+
+  // The body is still read after the timeout
+  EXPECT_TRUE(producer.Push("part"));
+  EXPECT_TRUE(stream.ReadChunk(chunk));
+  EXPECT_EQ(chunk, "part");
+}
+
+UTEST(RequestBodyStream, Backpressure) {
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  auto producer = request.StartBodyStream();
+
+  // The connection waits when the handler is behind
+  std::size_t pushed = 0;
+  while (producer.PushNoblock("part")) ++pushed;
+  EXPECT_GT(pushed, 0);
+  EXPECT_LT(pushed, 100);
+
+  std::string chunk;
+  EXPECT_TRUE(request.GetBodyStream().ReadChunk(chunk));
+  EXPECT_TRUE(producer.PushNoblock("part"));
+}
+
+USERVER_NAMESPACE_END
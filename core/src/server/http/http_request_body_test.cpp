@@ -0,0 +1,213 @@
+#include <userver/utest/utest.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/server/http/http_request.hpp>
+
+#include <compression/gzip.hpp>
+#include <server/http/http_request_impl.hpp>
+#include <server/http/http_request_parser.hpp>
+#include <server/net/recv_buffer.hpp>
+
+#include "create_parser_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kBufferSize = 32 * 1024;
+
+using RequestPtr = std::shared_ptr<server::request::RequestBase>;
+
+// Feeds the data to the parser the way server::net::Connection does
+std::vector<std::shared_ptr<server::net::RecvBuffer>> Feed(
+    server::http::HttpRequestParser& parser, const std::string& data) {
+  std::vector<std::shared_ptr<server::net::RecvBuffer>> buffers;
+  for (std::size_t pos = 0; pos < data.size(); pos += kBufferSize) {
+    const auto size = std::min(kBufferSize, data.size() - pos);
+    auto buffer = std::make_shared<server::net::RecvBuffer>(kBufferSize);
+    std::copy_n(data.data() + pos, size, buffer->data());
+    EXPECT_TRUE(parser.Parse(buffer, size));
+    buffers.push_back(std::move(buffer));
+  }
+  return buffers;
+}
+
+std::string MakeRequest(const std::string& body) {
+  return fmt::format("POST / HTTP/1.1\r\nContent-Length: {}\r\n\r\n{}",
+                     body.size(), body);
+}
+
+std::string MakeCompressedRequest(const std::string& compressed_body) {
+  return fmt::format(
+      "POST / HTTP/1.1\r\nContent-Encoding: gzip\r\nContent-Length: "
+      "{}\r\n\r\n{}",
+      compressed_body.size(), compressed_body);
+}
+
+server::request::HttpRequestConfig MakeDecompressConfig(
+    std::size_t max_request_size) {
+  auto config = server::kTestRequestConfig;
+  config.max_request_size = max_request_size;
+  config.decompress_request = true;
+  return config;
+}
+
+std::string Join(const std::vector<std::string_view>& chunks) {
+  std::string result;
+  for (const auto chunk : chunks) result.append(chunk);
+  return result;
+}
+
+}  // namespace
+
+UTEST(HttpRequestBody, SmallBodyIsCopied) {
+  const std::string body = "small body";
+  RequestPtr request;
+  auto parser = server::CreateTestParser(
+      [&request](RequestPtr&& parsed) { request = std::move(parsed); });
+
+  const auto buffers = Feed(parser, MakeRequest(body));
+  ASSERT_TRUE(request);
+  ASSERT_EQ(buffers.size(), 1);
+  EXPECT_EQ(buffers[0].use_count(), 1);
+
+  auto& http_request_impl =
+      dynamic_cast<server::http::HttpRequestImpl&>(*request);
+  const server::http::HttpRequest http_request(http_request_impl);
+  EXPECT_EQ(http_request.RequestBodyChunks(),
+            std::vector<std::string_view>{body});
+  EXPECT_EQ(http_request.RequestBody(), body);
+}
+
+UTEST(HttpRequestBody, BigBodyIsNotCopied) {
+  std::string body(200 * 1024, '\0');
+  for (std::size_t i = 0; i < body.size(); ++i) body[i] = 'a' + i % 26;
+
+  RequestPtr request;
+  auto parser = server::CreateTestParser(
+      [&request](RequestPtr&& parsed) { request = std::move(parsed); });
+
+  const auto data = MakeRequest(body);
+  const auto buffers = Feed(parser, data);
+  ASSERT_TRUE(request);
+  ASSERT_GT(buffers.size(), 1);
+  for (const auto& buffer : buffers) EXPECT_EQ(buffer.use_count(), 2);
+
+  auto& http_request_impl =
+      dynamic_cast<server::http::HttpRequestImpl&>(*request);
+  const server::http::HttpRequest http_request(http_request_impl);
+
+  const auto chunks = http_request.RequestBodyChunks();
+  EXPECT_EQ(chunks.size(), buffers.size());
+  // Points right into the receive buffer
+  const auto last_size = data.size() - (buffers.size() - 1) * kBufferSize;
+  EXPECT_EQ(chunks.back().data() + chunks.back().size(),
+            buffers.back()->data() + last_size);
+  EXPECT_EQ(Join(chunks), body);
+
+  // Flattening releases the buffers
+  EXPECT_EQ(http_request.RequestBody(), body);
+  for (const auto& buffer : buffers) EXPECT_EQ(buffer.use_count(), 1);
+  EXPECT_EQ(http_request.RequestBodyChunks(),
+            std::vector<std::string_view>{body});
+}
+
+UTEST(HttpRequestBody, ChunkedBodyIsCopied) {
+  const std::string body(100 * 1024, 'x');
+  const auto data = fmt::format(
+      "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n{:x}\r\n{}\r\n0"
+      "\r\n\r\n",
+      body.size(), body);
+
+  RequestPtr request;
+  auto parser = server::CreateTestParser(
+      [&request](RequestPtr&& parsed) { request = std::move(parsed); });
+
+  const auto buffers = Feed(parser, data);
+  ASSERT_TRUE(request);
+  for (const auto& buffer : buffers) EXPECT_EQ(buffer.use_count(), 1);
+
+  auto& http_request_impl =
+      dynamic_cast<server::http::HttpRequestImpl&>(*request);
+  EXPECT_EQ(http_request_impl.RequestBody(), body);
+}
+
+UTEST(HttpRequestBody, CompressedBodyIsDecompressed) {
+  std::string body(500 * 1024, '\0');
+  for (std::size_t i = 0; i < body.size(); ++i) body[i] = 'a' + i % 26;
+
+  RequestPtr request;
+  auto parser = server::CreateTestParser(
+      [&request](RequestPtr&& parsed) { request = std::move(parsed); },
+      MakeDecompressConfig(body.size()));
+
+  const auto buffers =
+      Feed(parser, MakeCompressedRequest(compression::gzip::Compress(body)));
+  ASSERT_TRUE(request);
+  for (const auto& buffer : buffers) EXPECT_EQ(buffer.use_count(), 1);
+
+  auto& http_request_impl =
+      dynamic_cast<server::http::HttpRequestImpl&>(*request);
+  EXPECT_TRUE(http_request_impl.IsBodyCompressed());
+  EXPECT_TRUE(http_request_impl.IsBodyDecompressed());
+  EXPECT_EQ(http_request_impl.RequestBody(), body);
+}
+
+UTEST(HttpRequestBody, CompressedBodyIsTooLarge) {
+  const std::string body(500 * 1024, 'x');
+
+  RequestPtr request;
+  auto parser = server::CreateTestParser(
+      [&request](RequestPtr&& parsed) { request = std::move(parsed); },
+      MakeDecompressConfig(body.size() - 1));
+
+  const auto data = MakeCompressedRequest(compression::gzip::Compress(body));
+  EXPECT_FALSE(parser.Parse(data.data(), data.size()));
+  ASSERT_TRUE(request);
+  auto& http_request_impl =
+      dynamic_cast<server::http::HttpRequestImpl&>(*request);
+  EXPECT_EQ(http_request_impl.GetHttpResponse().GetStatus(),
+            server::http::HttpStatus::kPayloadTooLarge);
+}
+
+UTEST(HttpRequestBody, CompressedBodyIsMalformed) {
+  RequestPtr request;
+  auto parser = server::CreateTestParser(
+      [&request](RequestPtr&& parsed) { request = std::move(parsed); },
+      MakeDecompressConfig(1024));
+
+  const auto compressed = compression::gzip::Compress("body");
+  const auto data =
+      MakeCompressedRequest(compressed.substr(0, compressed.size() - 1));
+  EXPECT_TRUE(parser.Parse(data.data(), data.size()));
+  ASSERT_TRUE(request);
+  auto& http_request_impl =
+      dynamic_cast<server::http::HttpRequestImpl&>(*request);
+  EXPECT_EQ(http_request_impl.GetHttpResponse().GetStatus(),
+            server::http::HttpStatus::kBadRequest);
+}
+
+UTEST(HttpRequestBody, SetRequestBody) {
+  const std::string body(100 * 1024, 'x');
+  RequestPtr request;
+  auto parser = server::CreateTestParser(
+      [&request](RequestPtr&& parsed) { request = std::move(parsed); });
+
+  const auto buffers = Feed(parser, MakeRequest(body));
+  ASSERT_TRUE(request);
+
+  auto& http_request_impl =
+      dynamic_cast<server::http::HttpRequestImpl&>(*request);
+  http_request_impl.SetRequestBody("other");
+  for (const auto& buffer : buffers) EXPECT_EQ(buffer.use_count(), 1);
+  EXPECT_EQ(http_request_impl.RequestBody(), "other");
+}
+
+USERVER_NAMESPACE_END
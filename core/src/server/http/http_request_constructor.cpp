@@ -19,6 +19,10 @@ namespace {
 
 const std::string kCookieHeader = "Cookie";
 
+// Smaller bodies are copied into a single string, so that they do not keep
+// the whole receive buffers alive
+constexpr std::uint64_t kMinZeroCopyBodySize = 64 * 1024;
+
 inline void Strip(const char*& begin, const char*& end) {
   while (begin < end && isspace(*begin)) ++begin;
   while (begin < end && isspace(end[-1])) --end;
@@ -115,6 +119,7 @@ void HttpRequestConstructor::ParseUrl() {
     config_.parse_args_from_body =
         handler_config.request_config.parse_args_from_body;
     if (handler_config.decompress_request) config_.decompress_request = true;
+    is_body_stream_requested_ = handler_config.request_body_stream;
 
     request_->SetTaskProcessor(handler_info->task_processor);
     request_->SetHttpHandler(handler_info->handler);
@@ -159,15 +164,109 @@ void HttpRequestConstructor::AppendHeaderValue(const char* data, size_t size) {
   header_value_.append(data, size);
 }
 
+void HttpRequestConstructor::StartBody() {
+  // The streamed body is passed to the handler as is
+  if (!config_.decompress_request || ShouldStreamBody()) return;
+  if (status_ != Status::kOk &&
+      (!config_.testing_mode || status_ != Status::kHandlerNotFound)) {
+    return;
+  }
+
+  const auto& content_encoding = request_->GetHeader(
+      USERVER_NAMESPACE::http::headers::kContentEncoding);
+  if (content_encoding == "gzip") {
+    decompressor_.emplace(compression::gzip::Format::kGzip,
+                          config_.max_request_size);
+  } else if (content_encoding == "deflate") {
+    decompressor_.emplace(compression::gzip::Format::kZlib,
+                          config_.max_request_size);
+  }
+}
+
+void HttpRequestConstructor::SetContentLength(std::uint64_t content_length) {
+  // The streamed body is not kept in the request, the size of the
+  // decompressed body is not known
+  if (ShouldStreamBody() || decompressor_) return;
+  is_body_zero_copy_ = content_length >= kMinZeroCopyBodySize;
+  if (!is_body_zero_copy_) request_->request_body_.reserve(content_length);
+}
+
 void HttpRequestConstructor::AppendBody(const char* data, size_t size) {
+  if (body_producer_) {
+    if (size) PushBodyChunk(std::string{data, size});
+    return;
+  }
+  if (decompressor_) return DecompressBody(data, size);
   AccountRequestSize(size);
   request_->request_body_.append(data, size);
 }
 
+void HttpRequestConstructor::AppendBody(const net::RecvBufferPtr& buffer,
+                                        const char* data, size_t size) {
+  if (!is_body_zero_copy_ || body_producer_ || decompressor_) {
+    return AppendBody(data, size);
+  }
+
+  UASSERT(buffer->data() <= data &&
+          data + size <= buffer->data() + buffer->size());
+  AccountRequestSize(size);
+  request_->request_body_chunks_.push_back({buffer, {data, size}});
+}
+
 void HttpRequestConstructor::SetIsFinal(bool is_final) {
   request_->is_final_ = is_final;
 }
 
+bool HttpRequestConstructor::ShouldStreamBody() const {
+  return is_body_stream_requested_ && url_parsed_ && status_ == Status::kOk;
+}
+
+void HttpRequestConstructor::StreamBody() {
+  UASSERT(ShouldStreamBody() && !body_producer_ && request_);
+  body_producer_.emplace(request_->StartBodyStream());
+}
+
+void HttpRequestConstructor::FinishBody() {
+  UASSERT(body_producer_);
+  // The empty part marks the end of the body
+  PushBodyChunk({});
+  body_producer_.reset();
+}
+
+void HttpRequestConstructor::PushBodyChunk(std::string chunk) {
+  // Waits while the handler is behind, so the connection does not read the
+  // socket. The push fails if the handler is done and the body is not needed.
+  [[maybe_unused]] const bool is_pushed =
+      body_producer_->Push(std::move(chunk));
+}
+
+void HttpRequestConstructor::DecompressBody(const char* data, size_t size) {
+  // The compressed size is limited as well as the decompressed one
+  AccountRequestSize(size);
+  try {
+    decompressor_->Decompress({data, size}, request_->request_body_);
+  } catch (const compression::TooBigError&) {
+    SetStatus(Status::kRequestTooLarge);
+    utils::LogErrorAndThrow(
+        "decompressed request body is too large, >" +
+        std::to_string(config_.max_request_size) +
+        " (enforced by 'max_request_size' handler limit in config.yaml)");
+  } catch (const compression::DecompressionError&) {
+    SetStatus(Status::kBadRequest);
+    throw;
+  }
+}
+
+void HttpRequestConstructor::FinishDecompression() {
+  try {
+    decompressor_->Finish();
+  } catch (const compression::DecompressionError&) {
+    SetStatus(Status::kBadRequest);
+    throw;
+  }
+  request_->is_body_decompressed_ = true;
+}
+
 std::shared_ptr<request::RequestBase> HttpRequestConstructor::Finalize() {
   LOG_TRACE() << "method=" << request_->GetMethodStr()
               << " orig_method=" << request_->GetOrigMethodStr();
@@ -190,12 +289,24 @@ void HttpRequestConstructor::FinalizeImpl() {
     return;
   }
 
+  if (decompressor_) {
+    try {
+      FinishDecompression();
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "can't decompress body: " << ex;
+      return;
+    }
+  }
+
   try {
     ParseArgs(parsed_url_);
-    if (config_.parse_args_from_body) {
-      if (!config_.decompress_request || !request_->IsBodyCompressed())
-        ParseArgs(request_->request_body_.data(),
-                  request_->request_body_.size());
+    // The streamed body is not received yet
+    if (config_.parse_args_from_body && !body_producer_) {
+      if (!config_.decompress_request || !request_->IsBodyCompressed() ||
+          request_->IsBodyDecompressed()) {
+        const auto& body = request_->RequestBody();
+        ParseArgs(body.data(), body.size());
+      }
     }
   } catch (const std::exception& ex) {
     LOG_WARNING() << "can't parse args: " << ex;
@@ -222,7 +333,7 @@ void HttpRequestConstructor::FinalizeImpl() {
 
   const auto& content_type =
       request_->GetHeader(USERVER_NAMESPACE::http::headers::kContentType);
-  if (IsMultipartFormDataContentType(content_type)) {
+  if (!body_producer_ && IsMultipartFormDataContentType(content_type)) {
     if (!ParseMultipartFormData(content_type, request_->RequestBody(),
                                 request_->form_data_args_)) {
       SetStatus(Status::kParseMultipartFormDataError);
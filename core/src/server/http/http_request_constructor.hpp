@@ -1,13 +1,17 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 
 #include <http_parser.h>
 
+#include <compression/gzip.hpp>
 #include <userver/http/parser/http_request_parse_args.hpp>
 #include <userver/server/http/http_method.hpp>
 #include <userver/server/request/request_config.hpp>
 
+#include <server/net/recv_buffer.hpp>
 #include <server/request/request_constructor.hpp>
 
 #include "handler_info_index.hpp"
@@ -50,10 +54,28 @@ class HttpRequestConstructor final : public request::RequestConstructor {
   void ParseUrl();
   void AppendHeaderField(const char* data, size_t size);
   void AppendHeaderValue(const char* data, size_t size);
+  // Called when the headers are complete, before the body
+  void StartBody();
+  void SetContentLength(std::uint64_t content_length);
   void AppendBody(const char* data, size_t size);
+  // `data` points into the `buffer`
+  void AppendBody(const net::RecvBufferPtr& buffer, const char* data,
+                  size_t size);
 
   void SetIsFinal(bool is_final);
 
+  // The handler reads the body with the RequestBodyStream, known after the
+  // ParseUrl()
+  bool ShouldStreamBody() const;
+  // Called before the Finalize() that passes the request on before its body,
+  // the following AppendBody() calls push the body to the handler
+  void StreamBody();
+  // Marks the end of the streamed body
+  void FinishBody();
+
+  // The request is passed on, only the streamed body may be appended
+  bool IsFinalized() const { return !request_; }
+
   std::shared_ptr<request::RequestBase> Finalize() override;
 
  private:
@@ -68,6 +90,9 @@ class HttpRequestConstructor final : public request::RequestConstructor {
   void AccountRequestSize(size_t size);
   void AccountUrlSize(size_t size);
   void AccountHeadersSize(size_t size);
+  void PushBodyChunk(std::string chunk);
+  void DecompressBody(const char* data, size_t size);
+  void FinishDecompression();
 
   void CheckStatus() const;
 
@@ -84,9 +109,14 @@ class HttpRequestConstructor final : public request::RequestConstructor {
   size_t url_size_ = 0;
   size_t headers_size_ = 0;
   bool url_parsed_ = false;
+  bool is_body_zero_copy_ = false;
+  bool is_body_stream_requested_ = false;
   Status status_ = Status::kOk;
 
   std::shared_ptr<HttpRequestImpl> request_;
+  std::optional<HttpRequestImpl::BodyQueue::Producer> body_producer_;
+  // The compressed body is decompressed as it arrives
+  std::optional<compression::gzip::Decompressor> decompressor_;
 };
 
 }  // namespace server::http
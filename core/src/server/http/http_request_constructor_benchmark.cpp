@@ -1,6 +1,12 @@
 #include <benchmark/benchmark.h>
 
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <server/http/http_request_constructor.hpp>
+#include <userver/server/request/request_context.hpp>
 #include <utils/gbench_auxilary.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -21,4 +27,43 @@ BENCHMARK(http_request_constructor_url_decode)
     ->RangeMultiplier(2)
     ->Range(1, 1024);
 
+namespace {
+
+constexpr std::string_view kScratchValue = "some-value-that-does-not-fit-sso";
+
+// Typical scratch data of a handler: a few containers with strings
+template <typename Allocator>
+void FillScratch(const Allocator& allocator, std::size_t count) {
+  using String =
+      std::basic_string<char, std::char_traits<char>,
+                        typename std::allocator_traits<
+                            Allocator>::template rebind_alloc<char>>;
+  std::vector<String, typename std::allocator_traits<
+                          Allocator>::template rebind_alloc<String>>
+      values{allocator};
+  for (std::size_t i = 0; i < count; ++i) {
+    values.emplace_back(kScratchValue, allocator);
+  }
+  benchmark::DoNotOptimize(values.data());
+}
+
+void http_request_scratch_heap(benchmark::State& state) {
+  for (auto _ : state) {
+    server::request::RequestContext context;
+    FillScratch(std::allocator<char>{}, state.range(0));
+  }
+}
+
+void http_request_scratch_arena(benchmark::State& state) {
+  for (auto _ : state) {
+    server::request::RequestContext context;
+    FillScratch(server::request::ArenaAllocator<char>{context.GetArena()},
+                state.range(0));
+  }
+}
+
+}  // namespace
+BENCHMARK(http_request_scratch_heap)->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK(http_request_scratch_arena)->RangeMultiplier(4)->Range(1, 64);
+
 USERVER_NAMESPACE_END
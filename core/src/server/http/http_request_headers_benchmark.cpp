@@ -1,6 +1,9 @@
 #include <benchmark/benchmark.h>
 
+#include <unordered_map>
+
 #include <server/http/http_request_constructor.hpp>
+#include <userver/http/common_headers.hpp>
 
 #include <utils/gbench_auxilary.hpp>
 
@@ -19,6 +22,27 @@ const char* kHeadersArray[kHeadersCount] = {
     "TestHeader28", "TestHeader29", "TestHeader30", "TestHeader31",
 };
 
+// Headers of a typical request from another service
+constexpr std::size_t kRequestHeadersCount = 10;
+const char* kRequestHeadersArray[kRequestHeadersCount] = {
+    http::headers::kHost,          http::headers::kUserAgent,
+    http::headers::kAccept,        http::headers::kAcceptEncoding,
+    http::headers::kContentType,   http::headers::kContentLength,
+    http::headers::kXYaRequestId,  http::headers::kXYaTraceId,
+    http::headers::kXYaSpanId,     "X-Custom-Header",
+};
+
+using UnorderedHeadersMap =
+    std::unordered_map<std::string, std::string, utils::StrIcaseHash,
+                       utils::StrIcaseEqual>;
+
+template <typename Map>
+Map MakeRequestHeaders() {
+  Map map;
+  for (const auto* name : kRequestHeadersArray) map[name] = "1";
+  return map;
+}
+
 void http_request_headers_insert(benchmark::State& state) {
   for (auto _ : state) {
     server::http::HttpRequest::HeadersMap map;
@@ -40,6 +64,36 @@ void http_request_headers_get(benchmark::State& state) {
   }
 }
 
+template <typename Map>
+void http_request_headers_insert_request(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(MakeRequestHeaders<Map>());
+  }
+}
+
+template <typename Map>
+void http_request_headers_get_request(benchmark::State& state) {
+  const auto map = MakeRequestHeaders<Map>();
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    if (++i == kRequestHeadersCount) i = 0;
+    benchmark::DoNotOptimize(map.find(kRequestHeadersArray[i]));
+  }
+}
+
+void http_request_headers_get_predefined(benchmark::State& state) {
+  const auto map =
+      MakeRequestHeaders<server::http::HttpRequest::HeadersMap>();
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    if (++i == http::headers::kPredefinedHeadersCount) i = 0;
+    benchmark::DoNotOptimize(
+        map.find(static_cast<http::headers::PredefinedHeader>(i)));
+  }
+}
+
 }  // namespace
 BENCHMARK(http_request_headers_insert)
     ->RangeMultiplier(2)
@@ -47,4 +101,12 @@ BENCHMARK(http_request_headers_insert)
 
 BENCHMARK(http_request_headers_get);
 
+BENCHMARK_TEMPLATE(http_request_headers_insert_request,
+                   server::http::HttpRequest::HeadersMap);
+BENCHMARK_TEMPLATE(http_request_headers_insert_request, UnorderedHeadersMap);
+BENCHMARK_TEMPLATE(http_request_headers_get_request,
+                   server::http::HttpRequest::HeadersMap);
+BENCHMARK_TEMPLATE(http_request_headers_get_request, UnorderedHeadersMap);
+BENCHMARK(http_request_headers_get_predefined);
+
 USERVER_NAMESPACE_END
@@ -5,7 +5,7 @@
 #include <logging/logger_with_info.hpp>
 #include <server/handlers/http_handler_base_statistics.hpp>
 #include <userver/engine/task/task.hpp>
-#include <userver/http/common_headers.hpp>
+#include <userver/http/header_map.hpp>
 #include <userver/http/parser/http_request_parse_args.hpp>
 #include <userver/logging/logger.hpp>
 #include <userver/utils/datetime.hpp>
@@ -19,6 +19,10 @@ constexpr size_t kBucketCount = 32;
 
 constexpr size_t kZeroAllocationBucketCount = 0;
 
+// The connection stops reading the socket when this many parts of the
+// streamed body are not read by the handler
+constexpr size_t kBodyStreamQueueSize = 16;
+
 std::string EscapeLogString(const std::string& str,
                             const std::vector<uint8_t>& need_escape_map) {
   size_t esc_cnt = 0;
@@ -68,6 +72,8 @@ std::string EscapeForAccessTskvLog(const std::string& str) {
 const std::string kEmptyString{};
 const std::vector<std::string> kEmptyVector{};
 
+using PredefinedHeader = USERVER_NAMESPACE::http::headers::PredefinedHeader;
+
 }  // namespace
 
 namespace server::http {
@@ -96,7 +102,7 @@ std::chrono::duration<double> HttpRequestImpl::GetResponseTime() const {
 }
 
 const std::string& HttpRequestImpl::GetHost() const {
-  return GetHeader(USERVER_NAMESPACE::http::headers::kHost);
+  return GetHeader(PredefinedHeader::kHost);
 }
 
 const std::string& HttpRequestImpl::GetArg(const std::string& arg_name) const {
@@ -184,17 +190,30 @@ bool HttpRequestImpl::HasPathArg(size_t index) const {
 size_t HttpRequestImpl::PathArgCount() const { return path_args_.size(); }
 
 const std::string& HttpRequestImpl::GetHeader(
-    const std::string& header_name) const {
+    std::string_view header_name) const {
   auto it = headers_.find(header_name);
   if (it == headers_.end()) return kEmptyString;
   return it->second;
 }
 
-bool HttpRequestImpl::HasHeader(const std::string& header_name) const {
+const std::string& HttpRequestImpl::GetHeader(
+    USERVER_NAMESPACE::http::headers::PredefinedHeader header) const {
+  auto it = headers_.find(header);
+  if (it == headers_.end()) return kEmptyString;
+  return it->second;
+}
+
+bool HttpRequestImpl::HasHeader(std::string_view header_name) const {
   auto it = headers_.find(header_name);
   return (it != headers_.end());
 }
 
+bool HttpRequestImpl::HasHeader(
+    USERVER_NAMESPACE::http::headers::PredefinedHeader header) const {
+  auto it = headers_.find(header);
+  return (it != headers_.end());
+}
+
 size_t HttpRequestImpl::HeaderCount() const { return headers_.size(); }
 
 HttpRequest::HeadersMapKeys HttpRequestImpl::GetHeaderNames() const {
@@ -218,19 +237,66 @@ HttpRequest::CookiesMapKeys HttpRequestImpl::GetCookieNames() const {
   return HttpRequest::CookiesMapKeys{cookies_};
 }
 
+const std::string& HttpRequestImpl::RequestBody() const {
+  if (!request_body_chunks_.empty()) {
+    UASSERT(request_body_.empty());
+    std::size_t size = 0;
+    for (const auto& chunk : request_body_chunks_) size += chunk.data.size();
+
+    request_body_.reserve(size);
+    for (const auto& chunk : request_body_chunks_) {
+      request_body_.append(chunk.data);
+    }
+    // Releases the receive buffers
+    request_body_chunks_.clear();
+  }
+  return request_body_;
+}
+
+std::vector<std::string_view> HttpRequestImpl::RequestBodyChunks() const {
+  std::vector<std::string_view> result;
+  if (request_body_chunks_.empty()) {
+    if (!request_body_.empty()) result.emplace_back(request_body_);
+    return result;
+  }
+
+  result.reserve(request_body_chunks_.size());
+  for (const auto& chunk : request_body_chunks_) {
+    result.push_back(chunk.data);
+  }
+  return result;
+}
+
 void HttpRequestImpl::SetRequestBody(std::string body) {
   request_body_ = std::move(body);
+  request_body_chunks_.clear();
 }
 
 void HttpRequestImpl::ParseArgsFromBody() {
-  USERVER_NAMESPACE::http::parser::ParseArgs(request_body_, request_args_);
+  USERVER_NAMESPACE::http::parser::ParseArgs(RequestBody(), request_args_);
 }
 
 bool HttpRequestImpl::IsBodyCompressed() const {
-  auto encoding = GetHeader(USERVER_NAMESPACE::http::headers::kContentEncoding);
+  const auto& encoding = GetHeader(PredefinedHeader::kContentEncoding);
   return !encoding.empty() && encoding != "identity";
 }
 
+HttpRequestImpl::BodyQueue::Producer HttpRequestImpl::StartBodyStream() {
+  UASSERT(!is_body_streamed_);
+  auto queue = BodyQueue::Create(kBodyStreamQueueSize);
+  is_body_streamed_ = true;
+  // The constructor is accessible only to the friends
+  body_stream_.reset(new RequestBodyStream(queue->GetConsumer()));
+  return queue->GetProducer();
+}
+
+bool HttpRequestImpl::IsBodyStreamed() const { return is_body_streamed_; }
+
+RequestBodyStream& HttpRequestImpl::GetBodyStream() const {
+  if (!body_stream_) body_stream_.reset(new RequestBodyStream(RequestBody()));
+  return *body_stream_;
+}
+
 void HttpRequestImpl::SetPathArgs(
     std::vector<std::pair<std::string, std::string>> args) {
   path_args_.clear();
@@ -307,9 +373,10 @@ void HttpRequestImpl::WriteAccessLog(
       EscapeForAccessLog(GetHost()), EscapeForAccessLog(remote_address),
       EscapeForAccessLog(GetOrigMethodStr()), EscapeForAccessLog(GetUrl()),
       GetHttpMajor(), GetHttpMinor(), static_cast<int>(response_.GetStatus()),
-      EscapeForAccessLog(GetHeader("Referer")),
-      EscapeForAccessLog(GetHeader("User-Agent")),
-      EscapeForAccessLog(GetHeader("Cookie")), GetRequestTime().count(),
+      EscapeForAccessLog(GetHeader(PredefinedHeader::kReferer)),
+      EscapeForAccessLog(GetHeader(PredefinedHeader::kUserAgent)),
+      EscapeForAccessLog(GetHeader(PredefinedHeader::kCookie)),
+      GetRequestTime().count(),
       GetResponse().BytesSent(), GetResponseTime().count());
 }
 
@@ -344,13 +411,13 @@ void HttpRequestImpl::WriteAccessTskvLog(
       static_cast<int>(response_.GetStatus()), GetHttpMajor(), GetHttpMinor(),
       EscapeForAccessTskvLog(GetOrigMethodStr()),
       EscapeForAccessTskvLog(GetUrl()),
-      EscapeForAccessTskvLog(GetHeader("Referer")),
-      EscapeForAccessTskvLog(GetHeader("Cookie")),
-      EscapeForAccessTskvLog(GetHeader("User-Agent")),
+      EscapeForAccessTskvLog(GetHeader(PredefinedHeader::kReferer)),
+      EscapeForAccessTskvLog(GetHeader(PredefinedHeader::kCookie)),
+      EscapeForAccessTskvLog(GetHeader(PredefinedHeader::kUserAgent)),
       EscapeForAccessTskvLog(GetHost()), EscapeForAccessTskvLog(remote_address),
-      EscapeForAccessTskvLog(GetHeader("X-Forwarded-For")),
-      EscapeForAccessTskvLog(GetHeader("X-Real-IP")),
-      EscapeForAccessTskvLog(GetHeader("X-YaRequestId")),
+      EscapeForAccessTskvLog(GetHeader(PredefinedHeader::kXForwardedFor)),
+      EscapeForAccessTskvLog(GetHeader(PredefinedHeader::kXRealIp)),
+      EscapeForAccessTskvLog(GetHeader(PredefinedHeader::kXYaRequestId)),
       EscapeForAccessTskvLog(GetHost()), EscapeForAccessTskvLog(remote_address),
       GetRequestTime().count(), GetResponseTime().count(),
       EscapeForAccessTskvLog(RequestBody()));
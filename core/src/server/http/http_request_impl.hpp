@@ -3,6 +3,7 @@
 #include <chrono>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -10,11 +11,14 @@
 
 #include <userver/server/http/http_method.hpp>
 #include <userver/server/http/http_request.hpp>
+#include <userver/server/http/http_request_body_stream.hpp>
 #include <userver/server/http/http_response.hpp>
 #include <userver/server/request/request_base.hpp>
 #include <userver/utils/datetime/wall_coarse_clock.hpp>
 #include <userver/utils/str_icase.hpp>
 
+#include <server/net/recv_buffer.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server {
@@ -64,8 +68,12 @@ class HttpRequestImpl final : public request::RequestBase {
   bool HasPathArg(size_t index) const;
   size_t PathArgCount() const;
 
-  const std::string& GetHeader(const std::string& header_name) const;
-  bool HasHeader(const std::string& header_name) const;
+  const std::string& GetHeader(std::string_view header_name) const;
+  const std::string& GetHeader(
+      USERVER_NAMESPACE::http::headers::PredefinedHeader header) const;
+  bool HasHeader(std::string_view header_name) const;
+  bool HasHeader(
+      USERVER_NAMESPACE::http::headers::PredefinedHeader header) const;
   size_t HeaderCount() const;
   HttpRequest::HeadersMapKeys GetHeaderNames() const;
 
@@ -74,7 +82,8 @@ class HttpRequestImpl final : public request::RequestBase {
   size_t CookieCount() const;
   HttpRequest::CookiesMapKeys GetCookieNames() const;
 
-  const std::string& RequestBody() const { return request_body_; }
+  const std::string& RequestBody() const;
+  std::vector<std::string_view> RequestBodyChunks() const;
   void SetRequestBody(std::string body);
   void ParseArgsFromBody();
   void SetResponseStatus(HttpStatus status) const {
@@ -82,6 +91,15 @@ class HttpRequestImpl final : public request::RequestBase {
   }
 
   bool IsBodyCompressed() const;
+  bool IsBodyDecompressed() const { return is_body_decompressed_; }
+
+  using BodyQueue = concurrent::SpscQueue<std::string>;
+
+  // The parts of the body received after the request is passed on are pushed
+  // to the producer, an empty part marks the end of the body
+  BodyQueue::Producer StartBodyStream();
+  bool IsBodyStreamed() const;
+  RequestBodyStream& GetBodyStream() const;
 
   bool IsFinal() const override { return is_final_; }
 
@@ -126,7 +144,13 @@ class HttpRequestImpl final : public request::RequestBase {
   unsigned short http_minor_{1};
   std::string url_;
   std::string request_path_;
-  std::string request_body_;
+  // Big bodies are kept in the receive buffers until someone asks for the
+  // contiguous body
+  mutable std::string request_body_;
+  mutable std::vector<net::RecvBufferSlice> request_body_chunks_;
+  bool is_body_streamed_{false};
+  bool is_body_decompressed_{false};
+  mutable std::unique_ptr<RequestBodyStream> body_stream_;
   std::string path_suffix_;
   std::unordered_map<std::string, std::vector<std::string>, utils::StrCaseHash>
       request_args_;
@@ -1,9 +1,12 @@
 #include "http_request_parser.hpp"
 
+#include <limits>
+
 #include <userver/logging/log.hpp>
 #include <userver/server/http/http_method.hpp>
 #include <userver/server/request/request_base.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/scope_guard.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -79,6 +82,13 @@ bool HttpRequestParser::Parse(const char* data, size_t size) {
   return true;
 }
 
+bool HttpRequestParser::Parse(const net::RecvBufferPtr& buffer, size_t size) {
+  UASSERT(buffer && size <= buffer->size());
+  current_buffer_ = &buffer;
+  utils::ScopeGuard reset_buffer([this] { current_buffer_ = nullptr; });
+  return Parse(buffer->data(), size);
+}
+
 int HttpRequestParser::OnMessageBegin(http_parser* p) {
   auto* http_request_parser = static_cast<HttpRequestParser*>(p->data);
   UASSERT(http_request_parser != nullptr);
@@ -177,11 +187,25 @@ int HttpRequestParser::OnHeadersCompleteImpl(http_parser* p) {
   if (!CheckUrlComplete(p)) return -1;
   try {
     request_constructor_->AppendHeaderField("", 0);
+    request_constructor_->StartBody();
   } catch (const std::exception& ex) {
     LOG_WARNING() << "can't append header value: " << ex;
     return -1;
   }
+  // http_parser sets all ones if there is no Content-Length
+  if (p->content_length !=
+      std::numeric_limits<decltype(p->content_length)>::max()) {
+    request_constructor_->SetContentLength(p->content_length);
+  }
   LOG_TRACE() << "headers complete";
+
+  if (request_constructor_->ShouldStreamBody()) {
+    // The handler gets the request right away and reads the body as it
+    // arrives
+    request_constructor_->StreamBody();
+    request_constructor_->SetIsFinal(!http_should_keep_alive(p));
+    if (!FinalizeRequestImpl()) return -1;
+  }
   return 0;
 }
 
@@ -191,7 +215,11 @@ int HttpRequestParser::OnBodyImpl(http_parser* p, const char* data,
   if (!CheckUrlComplete(p)) return -1;
   LOG_TRACE() << "body: '" << std::string_view(data, size) << "'";
   try {
-    request_constructor_->AppendBody(data, size);
+    if (current_buffer_) {
+      request_constructor_->AppendBody(*current_buffer_, data, size);
+    } else {
+      request_constructor_->AppendBody(data, size);
+    }
   } catch (const std::exception& ex) {
     LOG_WARNING() << "can't append body: " << ex;
     return -1;
@@ -205,7 +233,11 @@ int HttpRequestParser::OnMessageCompleteImpl(http_parser* p) {
     LOG_WARNING() << "upgrade detected";
     return -1;  // error
   }
-  request_constructor_->SetIsFinal(!http_should_keep_alive(p));
+  if (request_constructor_->IsFinalized()) {
+    request_constructor_->FinishBody();
+  } else {
+    request_constructor_->SetIsFinal(!http_should_keep_alive(p));
+  }
   if (!CheckUrlComplete(p)) return -1;
   LOG_TRACE() << "message complete";
   if (!FinalizeRequest()) return -1;
@@ -244,6 +276,9 @@ bool HttpRequestParser::FinalizeRequest() {
 
 bool HttpRequestParser::FinalizeRequestImpl() {
   if (!request_constructor_) CreateRequestConstructor();
+  // The request with the streamed body is already passed on, the body that is
+  // cut short is reported by the RequestBodyStream
+  if (request_constructor_->IsFinalized()) return true;
 
   if (auto request = request_constructor_->Finalize())
     on_new_request_cb_(std::move(request));
@@ -7,6 +7,7 @@
 
 #include <http_parser.h>
 
+#include <server/net/recv_buffer.hpp>
 #include <server/net/stats.hpp>
 #include <server/request/request_parser.hpp>
 
@@ -33,6 +34,10 @@ class HttpRequestParser final : public request::RequestParser {
 
   bool Parse(const char* data, size_t size) override;
 
+  /// Big request bodies parsed from the buffer share its ownership instead of
+  /// copying the data
+  bool Parse(const net::RecvBufferPtr& buffer, size_t size) override;
+
  private:
   static int OnMessageBegin(http_parser* p);
   static int OnUrl(http_parser* p, const char* data, size_t size);
@@ -67,6 +72,9 @@ class HttpRequestParser final : public request::RequestParser {
   http_parser parser_{};
   std::optional<HttpRequestConstructor> request_constructor_;
 
+  // Set for the duration of Parse(RecvBufferPtr)
+  const net::RecvBufferPtr* current_buffer_{nullptr};
+
   static const http_parser_settings parser_settings;
   net::ParserStats& stats_;
   request::ResponseDataAccounter& data_accounter_;
@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+
+#include <string_view>
+
+#include <userver/engine/run_standalone.hpp>
+
+#include <server/http/http_request_parser.hpp>
+#include <server/http/simd_http_request_parser.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::string_view kBrowserRequest =
+    "GET /static/js/main.8f3c2a1e.js?v=20230412 HTTP/1.1\r\n"
+    "Host: www.example.com\r\n"
+    "Connection: keep-alive\r\n"
+    "sec-ch-ua: \"Chromium\";v=\"112\", \"Google Chrome\";v=\"112\"\r\n"
+    "sec-ch-ua-mobile: ?0\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, "
+    "like Gecko) Chrome/112.0.0.0 Safari/537.36\r\n"
+    "sec-ch-ua-platform: \"Linux\"\r\n"
+    "Accept: */*\r\n"
+    "Sec-Fetch-Site: same-origin\r\n"
+    "Sec-Fetch-Mode: no-cors\r\n"
+    "Sec-Fetch-Dest: script\r\n"
+    "Referer: https://www.example.com/catalog/phones?sort=price&page=2\r\n"
+    "Accept-Encoding: gzip, deflate, br\r\n"
+    "Accept-Language: en-US,en;q=0.9,ru;q=0.8\r\n"
+    "Cookie: session_id=3f2c9d7e1b8a4c6f9e0d5a2b7c4e1f8a; theme=dark; "
+    "_ga=GA1.2.1234567890.1681234567; _gid=GA1.2.9876543210.1681234567\r\n"
+    "\r\n";
+
+constexpr std::string_view kApiRequest =
+    "POST /v1/orders/create?lang=en HTTP/1.1\r\n"
+    "Host: orders.internal.example.net:8080\r\n"
+    "Content-Type: application/json; charset=utf-8\r\n"
+    "Accept: application/json\r\n"
+    "Accept-Encoding: gzip\r\n"
+    "User-Agent: userver/1.0 (20230412114501; rv:a1b2c3d4)\r\n"
+    "X-YaRequestId: 6a1b3c5d7e9f4a2b8c0d1e3f5a7b9c2d\r\n"
+    "X-YaTraceId: 0f1e2d3c4b5a69788796a5b4c3d2e1f0\r\n"
+    "X-YaSpanId: 1a2b3c4d5e6f7a8b\r\n"
+    "X-Request-Application: mobile-app\r\n"
+    "X-Request-Language: en\r\n"
+    "X-Idempotency-Token: 4c8e1a3f-9b2d-4e6a-8f0c-2d4b6e8a0c1e\r\n"
+    "Content-Length: 64\r\n"
+    "\r\n"
+    R"({"items":[{"id":"a1b2c3","count":2}],"payment":"card","tip":100})";
+
+static_assert(kApiRequest.substr(kApiRequest.find("\r\n\r\n") + 4).size() ==
+              64);
+
+template <typename Parser>
+void ParseRequests(benchmark::State& state, std::string_view request) {
+  static const server::http::HandlerInfoIndex kHandlerInfoIndex;
+  static constexpr server::request::HttpRequestConfig kRequestConfig{};
+  static server::net::ParserStats stats;
+  static server::request::ResponseDataAccounter accounter;
+
+  engine::RunStandalone([&] {
+    std::size_t requests_count = 0;
+    Parser parser(
+        kHandlerInfoIndex, kRequestConfig,
+        [&requests_count](std::shared_ptr<server::request::RequestBase>&&) {
+          ++requests_count;
+        },
+        stats, accounter);
+
+    for (auto _ : state) {
+      const bool ok = parser.Parse(request.data(), request.size());
+      benchmark::DoNotOptimize(ok);
+    }
+
+    if (requests_count != static_cast<std::size_t>(state.iterations())) {
+      state.SkipWithError("not all the requests were parsed");
+    }
+  });
+}
+
+void http_request_parser_browser(benchmark::State& state) {
+  ParseRequests<server::http::HttpRequestParser>(state, kBrowserRequest);
+}
+
+void simd_http_request_parser_browser(benchmark::State& state) {
+  ParseRequests<server::http::SimdHttpRequestParser>(state, kBrowserRequest);
+}
+
+void http_request_parser_api(benchmark::State& state) {
+  ParseRequests<server::http::HttpRequestParser>(state, kApiRequest);
+}
+
+void simd_http_request_parser_api(benchmark::State& state) {
+  ParseRequests<server::http::SimdHttpRequestParser>(state, kApiRequest);
+}
+
+}  // namespace
+
+BENCHMARK(http_request_parser_browser);
+BENCHMARK(simd_http_request_parser_browser);
+BENCHMARK(http_request_parser_api);
+BENCHMARK(simd_http_request_parser_api);
+
+USERVER_NAMESPACE_END
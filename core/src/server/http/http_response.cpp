@@ -1,12 +1,20 @@
 #include <userver/server/http/http_response.hpp>
 
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
 #include <array>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include <cctz/time_zone.h>
 #include <fmt/compile.h>
 
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/io/socket.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
 #include <userver/hostinfo/blocking/get_hostname.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/http/content_type.hpp>
@@ -17,6 +25,7 @@
 #include <userver/utils/datetime/wall_coarse_clock.hpp>
 
 #include <server/http/http_cached_date.hpp>
+#include <utils/check_syscall.hpp>
 
 #include "http_request_impl.hpp"
 
@@ -27,6 +36,9 @@ namespace {
 constexpr std::string_view kCrlf = "\r\n";
 constexpr std::string_view kKeyValueHeaderSeparator = ": ";
 
+// The header, the prepared headers and the end of the header
+constexpr std::size_t kMaxHeaderIoData = 3;
+
 const auto kDefaultContentTypeString =
     http::ContentType{"text/html; charset=utf-8"}.ToString();
 
@@ -66,6 +78,58 @@ void CheckHeaderValue(std::string_view value) {
   }
 }
 
+bool IEquals(std::string_view lhs, std::string_view rhs) {
+  return lhs.size() == rhs.size() &&
+         std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](char l, char r) {
+           return std::tolower(static_cast<unsigned char>(l)) ==
+                  std::tolower(static_cast<unsigned char>(r));
+         });
+}
+
+std::string ToLowerAscii(std::string_view value) {
+  std::string result{value};
+  for (auto& c : result) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  return result;
+}
+
+constexpr int kMinStatus = 100;
+constexpr int kMaxStatus = 599;
+
+using StatusLines = std::array<std::string, kMaxStatus - kMinStatus + 1>;
+
+StatusLines MakeStatusLines(int http_minor) {
+  StatusLines result;
+  for (int code = kMinStatus; code <= kMaxStatus; ++code) {
+    const auto status = static_cast<server::http::HttpStatus>(code);
+    result[code - kMinStatus] =
+        fmt::format(FMT_COMPILE("HTTP/1.{} {} {}\r\n"), http_minor, code,
+                    HttpStatusString(status));
+  }
+  return result;
+}
+
+// The status lines of HTTP/1.0 and HTTP/1.1 are formatted once
+void AppendStatusLine(std::string& header, int http_major, int http_minor,
+                      server::http::HttpStatus status) {
+  static const std::array<StatusLines, 2> kStatusLines{MakeStatusLines(0),
+                                                       MakeStatusLines(1)};
+
+  const auto code = static_cast<int>(status);
+  if (http_major == 1 && (http_minor == 0 || http_minor == 1) &&
+      code >= kMinStatus && code <= kMaxStatus) {
+    header.append(kStatusLines[http_minor][code - kMinStatus]);
+    return;
+  }
+
+  header.append("HTTP/");
+  fmt::format_to(std::back_inserter(header), FMT_COMPILE("{}.{} {} "),
+                 http_major, http_minor, code);
+  header.append(HttpStatusString(status));
+  header.append(kCrlf);
+}
+
 bool IsBodyForbiddenForStatus(server::http::HttpStatus status) {
   return status == server::http::HttpStatus::kNoContent ||
          status == server::http::HttpStatus::kNotModified ||
@@ -98,6 +162,29 @@ void OutputHeader(std::string& header, std::string_view key,
 
 }  // namespace impl
 
+PreparedHeaders::PreparedHeaders(const std::vector<Header>& headers) {
+  auto data = std::make_shared<Data>();
+  data->headers.reserve(headers.size());
+  for (const auto& [name, value] : headers) {
+    CheckHeaderName(name);
+    CheckHeaderValue(value);
+    impl::OutputHeader(data->serialized, name, value);
+    data->headers.emplace_back(ToLowerAscii(name), value);
+
+    using USERVER_NAMESPACE::http::headers::kConnection;
+    using USERVER_NAMESPACE::http::headers::kContentType;
+    using USERVER_NAMESPACE::http::headers::kDate;
+    data->has_date |= IEquals(name, kDate);
+    data->has_content_type |= IEquals(name, kContentType);
+    data->has_connection |= IEquals(name, kConnection);
+  }
+  if (!data->headers.empty()) data_ = std::move(data);
+}
+
+std::string_view PreparedHeaders::GetSerialized() const noexcept {
+  return data_ ? std::string_view{data_->serialized} : std::string_view{};
+}
+
 HttpResponse::HttpResponse(const HttpRequestImpl& request,
                            request::ResponseDataAccounter& data_accounter)
     : ResponseBase(data_accounter),
@@ -130,6 +217,16 @@ bool HttpResponse::SetHeader(std::string name, std::string value) {
   return true;
 }
 
+bool HttpResponse::SetPreparedHeaders(PreparedHeaders headers) {
+  if (headers_end_.IsReady()) {
+    // Attempt to set headers for Stream'ed response after it is already set
+    return false;
+  }
+
+  prepared_headers_ = std::move(headers);
+  return true;
+}
+
 void HttpResponse::SetContentType(
     const USERVER_NAMESPACE::http::ContentType& type) {
   SetHeader(USERVER_NAMESPACE::http::headers::kContentType, type.ToString());
@@ -157,6 +254,7 @@ bool HttpResponse::ClearHeaders() {
   }
 
   headers_.clear();
+  prepared_headers_ = {};
   return true;
 }
 
@@ -201,6 +299,83 @@ void HttpResponse::SetHeadersEnd() { headers_end_.Send(); }
 bool HttpResponse::WaitForHeadersEnd() { return headers_end_.WaitForEvent(); }
 
 void HttpResponse::SendResponse(engine::io::Socket& socket) {
+  auto header = MakeHeader();
+  if (IsBodyStreamed() && GetData().empty()) {
+    SetBodyStreamed(socket, header);
+  } else {
+    // e.g. a CustomHandlerException
+    SetBodyNotstreamed(socket, header);
+  }
+}
+
+void HttpResponse::SendResponses(engine::io::Socket& socket,
+                                 const std::vector<HttpResponse*>& responses) {
+  std::vector<std::string> headers;
+  std::vector<std::string_view> bodies;
+  std::vector<const FileBody*> file_bodies;
+  headers.reserve(responses.size());
+  bodies.reserve(responses.size());
+  file_bodies.reserve(responses.size());
+  for (auto* response : responses) {
+    UASSERT(!response->IsBodyStreamed() || !response->GetData().empty());
+    headers.push_back(response->MakeHeader());
+    file_bodies.push_back(nullptr);
+    bodies.push_back(response->CompleteHeaderNotstreamed(headers.back(),
+                                                         file_bodies.back()));
+  }
+
+  std::vector<engine::io::IoData> io_data;
+  io_data.reserve(responses.size() * 4);
+  std::size_t sent_bytes = 0;
+  std::size_t queued_bytes = 0;
+  // Returns false if the peer has closed the connection
+  const auto flush = [&] {
+    if (io_data.empty()) return true;
+    const auto sent =
+        socket.SendAll(io_data.data(), io_data.size(), engine::Deadline{});
+    io_data.clear();
+    sent_bytes += sent;
+    return std::exchange(queued_bytes, 0) == sent;
+  };
+
+  // File bodies are sent with sendfile(2) in between the writev calls
+  for (std::size_t i = 0; i < responses.size(); ++i) {
+    const auto header_io_data_count = io_data.size();
+    io_data.resize(header_io_data_count + kMaxHeaderIoData);
+    io_data.resize(header_io_data_count +
+                   responses[i]->AddHeaderIoData(
+                       headers[i], io_data.data() + header_io_data_count));
+    queued_bytes += responses[i]->GetHeaderSize(headers[i]);
+    if (!bodies[i].empty()) {
+      io_data.push_back({bodies[i].data(), bodies[i].size()});
+      queued_bytes += bodies[i].size();
+    }
+
+    if (const auto* file_body = file_bodies[i]) {
+      if (!flush()) break;
+      const auto sent =
+          socket.SendAllFile(file_body->file->GetNative(), file_body->offset,
+                             file_body->size, engine::Deadline{});
+      sent_bytes += sent;
+      if (sent != file_body->size) break;
+    }
+  }
+  flush();
+
+  // The bytes sent are attributed to the responses in order
+  const auto now = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < responses.size(); ++i) {
+    const auto size =
+        std::min(sent_bytes, responses[i]->GetHeaderSize(headers[i]) +
+                                 bodies[i].size() +
+                                 (file_bodies[i] ? file_bodies[i]->size : 0));
+    sent_bytes -= size;
+    responses[i]->SetSentTime(now);
+    responses[i]->SetSent(size);
+  }
+}
+
+std::string HttpResponse::MakeHeader() {
   // According to https://www.chromium.org/spdy/spdy-whitepaper/
   // "typical header sizes of 700-800 bytes is common"
   // Adjusting it to 1KiB to fit jemalloc size class
@@ -209,29 +384,32 @@ void HttpResponse::SendResponse(engine::io::Socket& socket) {
   std::string header;
   header.reserve(kTypicalHeadersSize);
 
-  header.append("HTTP/");
-  fmt::format_to(std::back_inserter(header), FMT_COMPILE("{}.{} {} "),
-                 request_.GetHttpMajor(), request_.GetHttpMinor(),
-                 static_cast<int>(status_));
-  header.append(HttpStatusString(status_));
-  header.append(kCrlf);
+  AppendStatusLine(header, request_.GetHttpMajor(), request_.GetHttpMinor(),
+                   status_);
+
+  static const PreparedHeaders::Data kNoPreparedHeaders;
+  const auto& prepared =
+      prepared_headers_.data_ ? *prepared_headers_.data_ : kNoPreparedHeaders;
 
   headers_.erase(USERVER_NAMESPACE::http::headers::kContentLength);
   const auto end = headers_.cend();
-  if (headers_.find(USERVER_NAMESPACE::http::headers::kDate) == end) {
+  if (!prepared.has_date &&
+      headers_.find(USERVER_NAMESPACE::http::headers::kDate) == end) {
     header.append(USERVER_NAMESPACE::http::headers::kDate);
     header.append(kKeyValueHeaderSeparator);
     AppendCachedDate(header);
     header.append(kCrlf);
   }
-  if (headers_.find(USERVER_NAMESPACE::http::headers::kContentType) == end) {
+  if (!prepared.has_content_type &&
+      headers_.find(USERVER_NAMESPACE::http::headers::kContentType) == end) {
     impl::OutputHeader(header, USERVER_NAMESPACE::http::headers::kContentType,
                        kDefaultContentTypeString);
   }
   for (const auto& item : headers_) {
     impl::OutputHeader(header, item.first, item.second);
   }
-  if (headers_.find(USERVER_NAMESPACE::http::headers::kConnection) == end) {
+  if (!prepared.has_connection &&
+      headers_.find(USERVER_NAMESPACE::http::headers::kConnection) == end) {
     impl::OutputHeader(header, USERVER_NAMESPACE::http::headers::kConnection,
                        (request_.IsFinal() ? kClose : kKeepAlive));
   }
@@ -241,42 +419,69 @@ void HttpResponse::SendResponse(engine::io::Socket& socket) {
     cookie.second.AppendToString(header);
     header.append(kCrlf);
   }
-
-  if (IsBodyStreamed() && GetData().empty()) {
-    SetBodyStreamed(socket, header);
-  } else {
-    // e.g. a CustomHandlerException
-    SetBodyNotstreamed(socket, header);
-  }
+  return header;
 }
 
-void HttpResponse::SetBodyNotstreamed(engine::io::Socket& socket,
-                                      std::string& header) {
+std::string_view HttpResponse::CompleteHeaderNotstreamed(
+    std::string& header, const FileBody*& file_body) {
   const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
   const bool is_head_request = request_.GetOrigMethod() == HttpMethod::kHead;
   const auto& data = GetData();
+  file_body = GetFileBody();
+  const auto body_size = file_body ? file_body->size : data.size();
 
   if (!is_body_forbidden) {
     impl::OutputHeader(header, USERVER_NAMESPACE::http::headers::kContentLength,
-                       fmt::format(FMT_COMPILE("{}"), data.size()));
+                       fmt::format(FMT_COMPILE("{}"), body_size));
   }
-  header.append(kCrlf);
+  // Otherwise the header ends after the prepared headers
+  if (prepared_headers_.IsEmpty()) header.append(kCrlf);
 
-  if (is_body_forbidden && !data.empty()) {
+  if (is_body_forbidden && body_size != 0) {
     LOG_LIMITED_WARNING()
         << "Non-empty body provided for response with HTTP code "
         << static_cast<int>(status_)
         << " which does not allow one, it will be dropped";
   }
 
-  ssize_t sent_bytes = 0;
-  if (!is_head_request && !is_body_forbidden) {
-    sent_bytes = socket.SendAll(
-        {{header.data(), header.size()}, {data.data(), data.size()}},
-        engine::Deadline{});
-  } else {
-    sent_bytes =
-        socket.SendAll(header.data(), header.size(), engine::Deadline{});
+  if (is_head_request || is_body_forbidden) {
+    file_body = nullptr;
+    return {};
+  }
+  return data;
+}
+
+std::size_t HttpResponse::AddHeaderIoData(const std::string& header,
+                                         engine::io::IoData* io_data) const {
+  io_data[0] = {header.data(), header.size()};
+  if (prepared_headers_.IsEmpty()) return 1;
+
+  const auto prepared = prepared_headers_.GetSerialized();
+  io_data[1] = {prepared.data(), prepared.size()};
+  io_data[2] = {kCrlf.data(), kCrlf.size()};
+  return kMaxHeaderIoData;
+}
+
+std::size_t HttpResponse::GetHeaderSize(const std::string& header) const {
+  if (prepared_headers_.IsEmpty()) return header.size();
+  return header.size() + prepared_headers_.GetSerialized().size() +
+         kCrlf.size();
+}
+
+void HttpResponse::SetBodyNotstreamed(engine::io::Socket& socket,
+                                      std::string& header) {
+  const FileBody* file_body = nullptr;
+  const auto body = CompleteHeaderNotstreamed(header, file_body);
+
+  std::array<engine::io::IoData, kMaxHeaderIoData + 1> io_data{};
+  auto io_data_count = AddHeaderIoData(header, io_data.data());
+  if (!body.empty()) io_data[io_data_count++] = {body.data(), body.size()};
+  size_t sent_bytes =
+      socket.SendAll(io_data.data(), io_data_count, engine::Deadline{});
+  if (file_body && sent_bytes == GetHeaderSize(header)) {
+    sent_bytes +=
+        socket.SendAllFile(file_body->file->GetNative(), file_body->offset,
+                           file_body->size, engine::Deadline{});
   }
 
   SetSentTime(std::chrono::steady_clock::now());
@@ -285,30 +490,58 @@ void HttpResponse::SetBodyNotstreamed(engine::io::Socket& socket,
 
 void HttpResponse::SetBodyStreamed(engine::io::Socket& socket,
                                    std::string& header) {
+  // Body parts that are already produced are sent along with the header and
+  // with each other
+  static constexpr std::size_t kMaxPartsPerSend = 64;
+
   impl::OutputHeader(
       header, USERVER_NAMESPACE::http::headers::kTransferEncoding, "chunked");
-
-  // send HTTP headers
-  size_t sent_bytes = socket.SendAll(header.data(), header.size(), {});
-  std::string().swap(header);  // free memory before time consuming operation
+  // A single copy per streamed response is cheap compared to its body
+  header.append(prepared_headers_.GetSerialized());
+
+  // Chunk framing and payloads, each chunk starts with the CRLF that ends
+  // the previous one or the header
+  std::vector<std::string> parts;
+  parts.reserve(kMaxPartsPerSend);
+  parts.push_back(std::move(header));
+  std::vector<engine::io::IoData> io_data;
+  io_data.reserve(kMaxPartsPerSend);
+
+  size_t sent_bytes = 0;
+  const auto flush = [&] {
+    io_data.clear();
+    for (const auto& part : parts) {
+      io_data.push_back({part.data(), part.size()});
+    }
+    sent_bytes +=
+        socket.SendAll(io_data.data(), io_data.size(), engine::Deadline{});
+    parts.clear();
+  };
+  const auto append_chunk = [&parts](std::string&& body_part) {
+    if (body_part.empty()) {
+      LOG_DEBUG() << "Zero size body_part in http_response.cpp";
+      return;
+    }
+    parts.push_back(fmt::format(FMT_COMPILE("\r\n{:x}\r\n"), body_part.size()));
+    parts.push_back(std::move(body_part));
+  };
 
   // Transmit HTTP response body
   std::string body_part;
-  while (body_stream_->Pop(body_part)) {
-    if (body_part.empty()) {
-      LOG_DEBUG() << "Zero size body_part in http_response.cpp";
-      continue;
+  while (true) {
+    while (parts.size() + 2 <= kMaxPartsPerSend &&
+           body_stream_->PopNoblock(body_part)) {
+      append_chunk(std::move(body_part));
     }
+    if (!parts.empty()) flush();
 
-    auto size = fmt::format("\r\n{:x}\r\n", body_part.size());
-    sent_bytes += socket.SendAll(
-        {{size.data(), size.size()}, {body_part.data(), body_part.size()}},
-        engine::Deadline{});
+    if (!body_stream_->Pop(body_part)) break;
+    append_chunk(std::move(body_part));
   }
 
   const constexpr std::string_view terminating_chunk{"\r\n0\r\n\r\n"};
-  sent_bytes +=
-      socket.SendAll(terminating_chunk.data(), terminating_chunk.size(), {});
+  parts.emplace_back(terminating_chunk);
+  flush();
 
   // TODO: exceptions?
   body_stream_producer_.reset();
@@ -318,6 +551,37 @@ void HttpResponse::SetBodyStreamed(engine::io::Socket& socket,
   SetSent(sent_bytes);
 }
 
+void HttpResponse::SetFileBody(
+    std::shared_ptr<const fs::blocking::FileDescriptor> file,
+    std::size_t offset, std::size_t size) {
+  UASSERT(file && file->IsOpen());
+  file_body_ = FileBody{std::move(file), offset, size};
+}
+
+const HttpResponse::FileBody* HttpResponse::GetFileBody() const {
+  if (!file_body_ || !GetData().empty()) return nullptr;
+  return &*file_body_;
+}
+
+std::string HttpResponse::ReadFileBody() const {
+  const auto* file_body = GetFileBody();
+  UASSERT(file_body);
+
+  std::string result(file_body->size, '\0');
+  std::size_t read_bytes = 0;
+  while (read_bytes < result.size()) {
+    const auto read = utils::CheckSyscall(
+        ::pread(file_body->file->GetNative(), result.data() + read_bytes,
+                result.size() - read_bytes, file_body->offset + read_bytes),
+        "reading the file body");
+    if (read == 0) {
+      throw std::runtime_error("The file body is shorter than expected");
+    }
+    read_bytes += read;
+  }
+  return result;
+}
+
 void SetThrottleReason(http::HttpResponse& http_response,
                        std::string log_reason, std::string http_header_reason) {
   http_response.SetHeader(
@@ -334,7 +598,7 @@ void SetThrottleReason(http::HttpResponse& http_response,
 void HttpResponse::SetStreamBody() {
   UASSERT(!body_stream_);
 
-  const auto body_queue = Queue::Create();
+  const auto body_queue = Queue::Create(kMaxQueuedBodyChunks);
   body_stream_.emplace(body_queue->GetConsumer());
   body_stream_producer_.emplace(body_queue->GetProducer());
 }
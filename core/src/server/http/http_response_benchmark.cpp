@@ -1,10 +1,13 @@
 #include <benchmark/benchmark.h>
 
 #include <fmt/compile.h>
+#include <array>
 #include <sstream>
+#include <vector>
 
 #include <userver/http/common_headers.hpp>
 #include <userver/server/http/http_response.hpp>
+#include <userver/server/http/http_response_prepared_headers.hpp>
 #include <userver/server/http/http_status.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -65,9 +68,32 @@ void http_headers_serialization_ostreams(benchmark::State& state) {
   }
 }
 
+// The status line is preformatted and the headers are referenced in the iovec
+void http_headers_serialization_prepared(benchmark::State& state) {
+  const server::http::PreparedHeaders prepared{
+      std::vector<server::http::PreparedHeaders::Header>(kHeaders.begin(),
+                                                         kHeaders.end())};
+  constexpr std::string_view kStatusLine = "HTTP/1.1 200 OK\r\n";
+
+  for (auto _ : state) {
+    std::string os;
+    os.reserve(1024);
+
+    os.append(kStatusLine);
+    server::http::impl::OutputHeader(
+        os, USERVER_NAMESPACE::http::headers::kContentLength,
+        fmt::format(FMT_COMPILE("{}"), 1024));
+
+    const std::array<std::string_view, 2> io_data{os,
+                                                  prepared.GetSerialized()};
+    benchmark::DoNotOptimize(io_data);
+  }
+}
+
 }  // namespace
 
 BENCHMARK(http_headers_serialization_no_ostreams);
 BENCHMARK(http_headers_serialization_ostreams);
+BENCHMARK(http_headers_serialization_prepared);
 
 USERVER_NAMESPACE_END
@@ -1,5 +1,10 @@
 #include <userver/server/http/http_response_body_stream.hpp>
 
+#include <compression/gzip.hpp>
+#include <server/http/accept_encoding.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/utils/assert.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
@@ -10,27 +15,79 @@ ResponseBodyStream::ResponseBodyStream(
     : queue_producer_(std::move(queue_producer)),
       http_response_(http_response) {}
 
+ResponseBodyStream::ResponseBodyStream(ResponseBodyStream&&) noexcept =
+    default;
+
+ResponseBodyStream::~ResponseBodyStream() = default;
+
 void ResponseBodyStream::PushBodyChunk(std::string&& chunk) {
   UASSERT_MSG(headers_ended_,
               "SetEndOfHeaders() was not called before PushBodyChunk()");
+  if (compressor_) {
+    // Each chunk is flushed, so the client gets it without a delay
+    const auto start = std::chrono::steady_clock::now();
+    chunk = compressor_->Compress(chunk, compression::gzip::Flush::kSync);
+    compression_time_ += std::chrono::steady_clock::now() - start;
+  }
   queue_producer_.Push(std::move(chunk));
 }
 
 void ResponseBodyStream::SetHeader(const std::string& name,
                                    const std::string& value) {
+  UASSERT_MSG(!headers_ended_, "a header is set after SetEndOfHeaders()");
   http_response_.SetHeader(name, value);
 }
 
-void ResponseBodyStream::SetEndOfHeaders() { headers_ended_ = true; }
+void ResponseBodyStream::SetEndOfHeaders() {
+  if (headers_ended_) return;
+  headers_ended_ = true;
+
+  const auto status = http_response_.GetStatus();
+  if (compression_level_ && status != HttpStatus::kNoContent &&
+      status != HttpStatus::kNotModified &&
+      !http_response_.HasHeader(
+          USERVER_NAMESPACE::http::headers::kContentEncoding)) {
+    compressor_ =
+        std::make_unique<compression::gzip::Compressor>(*compression_level_);
+    impl::SetResponseEncoding(http_response_, "gzip");
+  }
+
+  // The connection sends the headers and the chunks from now on, while the
+  // handler produces the rest of the body
+  http_response_.SetHeadersEnd();
+}
 
 void ResponseBodyStream::SetStatusCode(int status_code) {
-  http_response_.SetStatus(static_cast<server::http::HttpStatus>(status_code));
+  SetStatusCode(static_cast<server::http::HttpStatus>(status_code));
 }
 
 void ResponseBodyStream::SetStatusCode(HttpStatus status) {
+  UASSERT_MSG(!headers_ended_, "the status is set after SetEndOfHeaders()");
   http_response_.SetStatus(status);
 }
 
+void ResponseBodyStream::EnableCompression(int level) {
+  UASSERT_MSG(!headers_ended_, "compression is enabled too late");
+  compression_level_ = level;
+}
+
+void ResponseBodyStream::FinishCompression() {
+  if (!compressor_) return;
+  const auto start = std::chrono::steady_clock::now();
+  if (http_response_.GetData().empty()) {
+    queue_producer_.Push(
+        compressor_->Compress({}, compression::gzip::Flush::kFinish));
+  } else {
+    // The error body replaces the streamed one and is sent at once, see
+    // HttpResponse::SendResponse(), so it is compressed on its own
+    compressor_ =
+        std::make_unique<compression::gzip::Compressor>(*compression_level_);
+    http_response_.SetData(compressor_->Compress(
+        http_response_.GetData(), compression::gzip::Flush::kFinish));
+  }
+  compression_time_ += std::chrono::steady_clock::now() - start;
+}
+
 }  // namespace server::http
 
 USERVER_NAMESPACE_END
@@ -5,6 +5,9 @@
 
 #include <server/http/http_request_impl.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/fs/blocking/write.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/internal/net/net_listener.hpp>
 #include <userver/server/http/http_response.hpp>
@@ -45,6 +48,236 @@ UTEST(HttpResponse, Smoke) {
             fmt::format("\r\n\r\n{}", kBody));
 }
 
+UTEST(HttpResponse, SendResponses) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl first_request{accounter};
+  server::http::HttpResponse first_response{first_request, accounter};
+  first_response.SetData("first");
+  server::http::HttpRequestImpl second_request{accounter};
+  server::http::HttpResponse second_response{second_request, accounter};
+  second_response.SetData("second");
+  second_response.SetStatus(server::http::HttpStatus::kNoContent);
+
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  auto send_task = engine::AsyncNoSpan(
+      [&](auto&& socket) {
+        server::http::HttpResponse::SendResponses(
+            socket, {&first_response, &second_response});
+        socket.Close();
+      },
+      std::move(server));
+
+  std::vector<char> buffer(4096, '\0');
+  const auto reply_size =
+      client.RecvAll(buffer.data(), buffer.size(), test_deadline);
+  send_task.Get();
+
+  const std::string_view reply{buffer.data(), reply_size};
+  const auto second_pos = reply.find("HTTP/1.1 204 ");
+  ASSERT_NE(second_pos, std::string_view::npos);
+  EXPECT_EQ(reply.substr(0, second_pos).substr(second_pos - 9),
+            "\r\n\r\nfirst");
+  EXPECT_EQ(reply.substr(reply.size() - 4), "\r\n\r\n");
+
+  EXPECT_TRUE(first_response.IsSent());
+  EXPECT_TRUE(second_response.IsSent());
+  EXPECT_EQ(first_response.BytesSent(), second_pos);
+  EXPECT_EQ(second_response.BytesSent(), reply_size - second_pos);
+}
+
+UTEST(HttpResponse, FileBody) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  const auto file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(file.GetPath(), "0123456789");
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl first_request{accounter};
+  server::http::HttpResponse first_response{first_request, accounter};
+  first_response.SetFileBody(
+      std::make_shared<const fs::blocking::FileDescriptor>(
+          fs::blocking::FileDescriptor::Open(file.GetPath(),
+                                             fs::blocking::OpenFlag::kRead)),
+      2, 5);
+  server::http::HttpRequestImpl second_request{accounter};
+  server::http::HttpResponse second_response{second_request, accounter};
+  second_response.SetData("second");
+
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  auto send_task = engine::AsyncNoSpan(
+      [&](auto&& socket) {
+        server::http::HttpResponse::SendResponses(
+            socket, {&first_response, &second_response});
+        socket.Close();
+      },
+      std::move(server));
+
+  std::vector<char> buffer(4096, '\0');
+  const auto reply_size =
+      client.RecvAll(buffer.data(), buffer.size(), test_deadline);
+  send_task.Get();
+
+  const std::string_view reply{buffer.data(), reply_size};
+  EXPECT_NE(reply.find("Content-Length: 5\r\n"), std::string_view::npos);
+  const auto second_pos = reply.find("HTTP/1.1 200 ", 1);
+  ASSERT_NE(second_pos, std::string_view::npos);
+  EXPECT_EQ(reply.substr(0, second_pos).substr(second_pos - 9),
+            "\r\n\r\n23456");
+  EXPECT_EQ(reply.substr(reply.size() - 6), "second");
+  EXPECT_EQ(first_response.BytesSent(), second_pos);
+}
+
+UTEST(HttpResponse, StreamedBody) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+  response.SetStreamBody();
+  {
+    // The parts that are ready are sent along with the header
+    auto producer = response.GetBodyProducer();
+    ASSERT_TRUE(producer.Push("first"));
+    ASSERT_TRUE(producer.Push(""));
+    ASSERT_TRUE(producer.Push("second part"));
+  }
+
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  auto send_task = engine::AsyncNoSpan(
+      [](auto&& response, auto&& socket) {
+        response.SendResponse(socket);
+        socket.Close();
+      },
+      std::ref(response), std::move(server));
+
+  std::vector<char> buffer(4096, '\0');
+  const auto reply_size =
+      client.RecvAll(buffer.data(), buffer.size(), test_deadline);
+  send_task.Get();
+
+  const std::string_view reply{buffer.data(), reply_size};
+  const auto expected_transfer_encoding = fmt::format(
+      "\r\n{}: chunked\r\n", http::headers::kTransferEncoding);
+  EXPECT_NE(reply.find(expected_transfer_encoding), std::string_view::npos);
+  constexpr std::string_view kExpectedBody =
+      "\r\n\r\n5\r\nfirst\r\nb\r\nsecond part\r\n0\r\n\r\n";
+  ASSERT_GE(reply.size(), kExpectedBody.size());
+  EXPECT_EQ(reply.substr(reply.size() - kExpectedBody.size()), kExpectedBody);
+  EXPECT_EQ(response.BytesSent(), reply_size);
+}
+
+UTEST(HttpResponse, StreamedBodyBackpressure) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  constexpr auto kMaxChunks = server::http::HttpResponse::kMaxQueuedBodyChunks;
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+  response.SetStreamBody();
+
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  engine::TaskWithResult<void> send_task;
+  {
+    auto producer = response.GetBodyProducer();
+    for (std::size_t i = 0; i < kMaxChunks; ++i) {
+      ASSERT_TRUE(producer.PushNoblock("x"));
+    }
+    // The producer has to wait for the data to be sent
+    EXPECT_FALSE(producer.PushNoblock("y"));
+
+    send_task = engine::AsyncNoSpan(
+        [](auto&& response, auto&& socket) {
+          response.SendResponse(socket);
+          socket.Close();
+        },
+        std::ref(response), std::move(server));
+    ASSERT_TRUE(producer.Push("y", test_deadline));
+  }
+
+  std::vector<char> buffer(4096, '\0');
+  const auto reply_size =
+      client.RecvAll(buffer.data(), buffer.size(), test_deadline);
+  send_task.Get();
+
+  std::string expected_body = "\r\n";
+  for (std::size_t i = 0; i < kMaxChunks; ++i) expected_body += "\r\n1\r\nx";
+  expected_body += "\r\n1\r\ny\r\n0\r\n\r\n";
+  const std::string_view reply{buffer.data(), reply_size};
+  ASSERT_GE(reply.size(), expected_body.size());
+  EXPECT_EQ(reply.substr(reply.size() - expected_body.size()), expected_body);
+}
+
+UTEST(HttpResponse, PreparedHeaders) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  const server::http::PreparedHeaders headers{{
+      {"Content-Type", "application/json"},
+      {"X-Prepared", "value"},
+  }};
+  EXPECT_EQ(headers.GetSerialized(),
+            "Content-Type: application/json\r\nX-Prepared: value\r\n");
+  const std::vector<server::http::PreparedHeaders::Header> bad_headers{
+      {"X-Bad", "new\nline"}};
+  EXPECT_THROW(server::http::PreparedHeaders{bad_headers}, std::runtime_error);
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl first_request{accounter};
+  server::http::HttpResponse first_response{first_request, accounter};
+  first_response.SetPreparedHeaders(headers);
+  first_response.SetData("first");
+  server::http::HttpRequestImpl second_request{accounter};
+  server::http::HttpResponse second_response{second_request, accounter};
+  second_response.SetPreparedHeaders(headers);
+  second_response.SetHeader(std::string{"X-Dynamic"}, "dynamic");
+  second_response.SetData("second");
+
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  auto send_task = engine::AsyncNoSpan(
+      [&](auto&& socket) {
+        server::http::HttpResponse::SendResponses(
+            socket, {&first_response, &second_response});
+        socket.Close();
+      },
+      std::move(server));
+
+  std::vector<char> buffer(4096, '\0');
+  const auto reply_size =
+      client.RecvAll(buffer.data(), buffer.size(), test_deadline);
+  send_task.Get();
+
+  const std::string_view reply{buffer.data(), reply_size};
+  const auto second_pos = reply.find("HTTP/1.1 200 OK\r\n", 1);
+  ASSERT_NE(second_pos, std::string_view::npos);
+  const auto first_reply = reply.substr(0, second_pos);
+  const auto second_reply = reply.substr(second_pos);
+
+  for (const auto part : {first_reply, second_reply}) {
+    EXPECT_NE(part.find("\r\nX-Prepared: value\r\n"), std::string_view::npos);
+    // The default Content-Type is not added
+    EXPECT_EQ(part.find("text/html"), std::string_view::npos);
+  }
+  EXPECT_EQ(first_reply.substr(first_reply.size() - 9), "\r\n\r\nfirst");
+  EXPECT_NE(second_reply.find("\r\nX-Dynamic: dynamic\r\n"),
+            std::string_view::npos);
+  EXPECT_EQ(second_reply.substr(second_reply.size() - 10),
+            "\r\n\r\nsecond");
+
+  EXPECT_EQ(first_response.BytesSent(), first_reply.size());
+  EXPECT_EQ(second_response.BytesSent(), second_reply.size());
+}
+
 class HttpResponseBody : public testing::TestWithParam<int> {};
 
 UTEST_P(HttpResponseBody, ForbiddenBody) {
@@ -0,0 +1,37 @@
+#include <userver/server/http/json_array_stream.hpp>
+
+#include <userver/http/common_headers.hpp>
+#include <userver/http/content_type.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+JsonArrayStream::JsonArrayStream(ResponseBodyStream& stream,
+                                 std::size_t chunk_size)
+    : stream_(stream), chunk_size_(chunk_size) {
+  stream_.SetHeader(
+      USERVER_NAMESPACE::http::headers::kContentType,
+      USERVER_NAMESPACE::http::content_type::kApplicationJson.ToString());
+  stream_.SetEndOfHeaders();
+  array_.emplace(builder_);
+}
+
+JsonArrayStream::~JsonArrayStream() = default;
+
+void JsonArrayStream::Flush() {
+  UASSERT_MSG(array_, "Flush() is called after Finish()");
+  auto chunk = builder_.ExtractString();
+  if (!chunk.empty()) stream_.PushBodyChunk(std::move(chunk));
+}
+
+void JsonArrayStream::Finish() {
+  UASSERT_MSG(array_, "Finish() is called twice");
+  array_.reset();
+  stream_.PushBodyChunk(builder_.ExtractString());
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
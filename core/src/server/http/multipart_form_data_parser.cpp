@@ -262,40 +262,18 @@ bool ParseMultipartFormDataHeaders(std::string_view& body,
   return SkipCrLf(body, crlf);
 }
 
-size_t FindBoundaryEnd(std::string_view body, std::string_view boundary,
-                       std::string_view crlf) {
-  size_t pos = 0;
-  while (pos < body.size()) {
-    if (body[pos] == crlf.front()) {
-      if (pos + crlf.size() < body.size() &&
-          body.substr(pos, crlf.size()) == crlf) {
-        pos += crlf.size();
-        if (pos < body.size() && body[pos] == '-') {
-          ++pos;
-          if (pos < body.size() && body[pos] == '-') {
-            ++pos;
-            size_t idx = 0;
-            while (idx < boundary.size() && pos + idx < body.size() &&
-                   body[pos + idx] == boundary[idx])
-              ++idx;
-            pos += idx;
-            if (idx == boundary.size()) return pos;
-          }
-        }
-      } else
-        ++pos;
-    } else
-      ++pos;
-  }
-  return std::string_view::npos;
+size_t FindBoundaryEnd(std::string_view body,
+                       const MultipartDelimiterSearcher& delimiter) {
+  const auto pos = delimiter.Find(body);
+  if (pos == std::string_view::npos) return pos;
+  return pos + delimiter.GetSize();
 }
 
 bool ParseMultipartFormDataValue(std::string_view& body,
-                                 std::string_view boundary,
+                                 const MultipartDelimiterSearcher& delimiter,
                                  FormDataArgInfo&& arg_info,
                                  std::optional<std::string>& charset,
-                                 FormDataArgs& form_data_args,
-                                 std::string_view crlf) {
+                                 FormDataArgs& form_data_args) {
   static const std::string kCharset = "_charset_";
 
   if (arg_info.arg.content_disposition.empty()) {
@@ -303,12 +281,12 @@ bool ParseMultipartFormDataValue(std::string_view& body,
     return false;
   }
 
-  size_t pos = FindBoundaryEnd(body, boundary, crlf);
+  size_t pos = FindBoundaryEnd(body, delimiter);
   if (pos == std::string_view::npos) {
     LOG_WARNING() << "Unexpected end of form-data part value";
     return false;
   }
-  arg_info.arg.value = body.substr(0, pos - boundary.size() - 2 - crlf.size());
+  arg_info.arg.value = body.substr(0, pos - delimiter.GetSize());
   if (arg_info.name == kCharset) {
     charset = arg_info.arg.value;
   } else {
@@ -328,15 +306,20 @@ bool ParseMultipartFormDataBody(std::string_view body,
                                 bool strict_cr_lf) {
   LOG_TRACE() << "body=" << body << ", body.size()=" << body.size();
   std::string_view crlf = "\r\n";
-  if (boundary.size() + 2 <= body.size() && body[0] == '-' && body[1] == '-' &&
-      body.substr(2, boundary.size()) == boundary) {
+  const bool starts_with_boundary =
+      boundary.size() + 2 <= body.size() && body[0] == '-' && body[1] == '-' &&
+      body.substr(2, boundary.size()) == boundary;
+  if (starts_with_boundary) {
     body.remove_prefix(2 + boundary.size());
-    if (!strict_cr_lf) crlf = AutoDetectCrLf(body, crlf);
   } else {
     while (!body.empty() && body.front() != kCr && body.front() != kLf)
       body.remove_prefix(1);
-    if (!strict_cr_lf) crlf = AutoDetectCrLf(body, crlf);
-    size_t pos = FindBoundaryEnd(body, boundary, crlf);
+  }
+  if (!strict_cr_lf) crlf = AutoDetectCrLf(body, crlf);
+
+  const MultipartDelimiterSearcher delimiter{boundary, crlf};
+  if (!starts_with_boundary) {
+    size_t pos = FindBoundaryEnd(body, delimiter);
     if (pos == std::string_view::npos) {
       LOG_WARNING() << "Unexpected request body end";
       return false;
@@ -381,8 +364,8 @@ bool ParseMultipartFormDataBody(std::string_view body,
     if (!ParseMultipartFormDataHeaders(body, arg_info, crlf)) return false;
     LOG_TRACE() << "ParseMultipartFormDataHeaders finished, body=" << body
                 << ", body.size()=" << body.size();
-    if (!ParseMultipartFormDataValue(body, boundary, std::move(arg_info),
-                                     charset, form_data_args, crlf)) {
+    if (!ParseMultipartFormDataValue(body, delimiter, std::move(arg_info),
+                                     charset, form_data_args)) {
       return false;
     }
   }
@@ -406,9 +389,21 @@ bool IsMultipartFormDataContentType(std::string_view content_type) {
   return false;
 }
 
-bool ParseMultipartFormData(const std::string& content_type,
-                            std::string_view body, FormDataArgs& form_data_args,
-                            bool strict_cr_lf) {
+MultipartDelimiterSearcher::MultipartDelimiterSearcher(
+    std::string_view boundary, std::string_view crlf)
+    : delimiter_(std::string{crlf} + "--" + std::string{boundary}),
+      searcher_(delimiter_.data(), delimiter_.data() + delimiter_.size()) {}
+
+size_t MultipartDelimiterSearcher::Find(std::string_view data) const {
+  const auto* const end = data.data() + data.size();
+  const auto* const found = searcher_(data.data(), end).first;
+  return found == end ? std::string_view::npos
+                      : static_cast<size_t>(found - data.data());
+}
+
+bool ParseMultipartFormDataContentType(std::string_view content_type,
+                                       std::string& boundary,
+                                       std::string& charset) {
   static const std::string kBoundary = "boundary";
   static const std::string kCharset = "charset";
   static const std::string kBoundaryNotFound =
@@ -422,8 +417,8 @@ bool ParseMultipartFormData(const std::string& content_type,
   unparsed.remove_prefix(kMultipartFormData.size());
   SkipOptionalSpaces(unparsed);
 
-  std::string boundary;
-  std::string charset;
+  boundary.clear();
+  charset.clear();
   while (!unparsed.empty()) {
     if (!SkipSymbol(unparsed, ';')) return false;
     SkipOptionalSpaces(unparsed);
@@ -455,6 +450,30 @@ bool ParseMultipartFormData(const std::string& content_type,
     LOG_WARNING() << kBoundaryNotFound;
     return false;
   }
+  return true;
+}
+
+bool ParseMultipartFormDataPartHeaders(std::string_view headers,
+                                       std::string& name, FormDataArg& arg) {
+  FormDataArgInfo arg_info;
+  if (!ParseMultipartFormDataHeaders(headers, arg_info, "\r\n")) return false;
+  if (arg_info.arg.content_disposition.empty()) {
+    LOG_WARNING() << "Missing Content-Disposition header";
+    return false;
+  }
+  name = std::move(arg_info.name);
+  arg = std::move(arg_info.arg);
+  return true;
+}
+
+bool ParseMultipartFormData(const std::string& content_type,
+                            std::string_view body, FormDataArgs& form_data_args,
+                            bool strict_cr_lf) {
+  std::string boundary;
+  std::string charset;
+  if (!ParseMultipartFormDataContentType(content_type, boundary, charset)) {
+    return false;
+  }
 
   return ParseMultipartFormDataBody(body, boundary, std::move(charset),
                                     form_data_args, strict_cr_lf);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -15,7 +16,39 @@ namespace server::http {
 using FormDataArgs = std::unordered_map<std::string, std::vector<FormDataArg>,
                                         utils::StrCaseHash>;
 
+/// Finds the delimiter of the multipart body parts by the Boyer-Moore-Horspool
+/// algorithm, that skips most of the bytes of the large values
+class MultipartDelimiterSearcher final {
+ public:
+  MultipartDelimiterSearcher(std::string_view boundary, std::string_view crlf);
+
+  MultipartDelimiterSearcher(const MultipartDelimiterSearcher&) = delete;
+  MultipartDelimiterSearcher& operator=(const MultipartDelimiterSearcher&) =
+      delete;
+
+  /// @returns position of the delimiter or std::string_view::npos
+  size_t Find(std::string_view data) const;
+
+  /// @returns size of the `crlf--boundary` delimiter
+  size_t GetSize() const noexcept { return delimiter_.size(); }
+
+ private:
+  const std::string delimiter_;
+  // refers to delimiter_
+  const std::boyer_moore_horspool_searcher<const char*> searcher_;
+};
+
 bool IsMultipartFormDataContentType(std::string_view content_type);
+
+bool ParseMultipartFormDataContentType(std::string_view content_type,
+                                       std::string& boundary,
+                                       std::string& charset);
+
+/// Parses the headers of a part up to and including the empty line after
+/// them, the string views of `arg` refer to `headers`
+bool ParseMultipartFormDataPartHeaders(std::string_view headers,
+                                       std::string& name, FormDataArg& arg);
+
 bool ParseMultipartFormData(const std::string& content_type,
                             std::string_view body, FormDataArgs& form_data_args,
                             bool strict_cr_lf = false);
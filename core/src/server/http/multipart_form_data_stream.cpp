@@ -0,0 +1,216 @@
+#include <userver/server/http/multipart_form_data_stream.hpp>
+
+#include <server/http/multipart_form_data_parser.hpp>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+constexpr std::string_view kCrLf = "\r\n";
+constexpr std::string_view kHeadersEnd = "\r\n\r\n";
+constexpr std::string_view kCloseDelimiterSuffix = "--";
+
+// The headers are buffered, the values are not
+constexpr std::size_t kMaxHeadersSize = 64 * 1024;
+
+std::string ParseBoundary(std::string_view content_type) {
+  std::string boundary;
+  std::string charset;
+  if (!ParseMultipartFormDataContentType(content_type, boundary, charset)) {
+    throw MultipartFormDataStreamError(
+        "Content-Type is not multipart/form-data with a boundary");
+  }
+  return boundary;
+}
+
+bool IsTransportPadding(char c) { return c == ' ' || c == '\t'; }
+
+}  // namespace
+
+struct MultipartFormDataStream::Impl {
+  enum class State {
+    kPreamble,
+    kValue,
+    kDelimiter,
+    kFinished,
+  };
+
+  Impl(RequestBodyStream& body, std::string_view content_type)
+      : body(body), delimiter(ParseBoundary(content_type), kCrLf) {}
+
+  bool ReadMore(engine::Deadline deadline);
+  void Require(std::size_t size, engine::Deadline deadline);
+  bool ReadValue(std::string& chunk, engine::Deadline deadline);
+  bool ReadDelimiterSuffix(engine::Deadline deadline);
+  void ReadHeaders(engine::Deadline deadline);
+
+  RequestBodyStream& body;
+  const MultipartDelimiterSearcher delimiter;
+
+  // The delimiter includes the leading line break, the first one is prepended
+  // to match the boundary at the start of the body
+  std::string buffer{kCrLf};
+  State state{State::kPreamble};
+  FormDataPart part;
+};
+
+bool MultipartFormDataStream::Impl::ReadMore(engine::Deadline deadline) {
+  std::string chunk;
+  if (!body.ReadChunk(chunk, deadline)) return false;
+  if (buffer.empty()) {
+    buffer = std::move(chunk);
+  } else {
+    buffer += chunk;
+  }
+  return true;
+}
+
+void MultipartFormDataStream::Impl::Require(std::size_t size,
+                                            engine::Deadline deadline) {
+  while (buffer.size() < size) {
+    if (!ReadMore(deadline)) {
+      throw MultipartFormDataStreamError(
+          "Unexpected end of the multipart/form-data body");
+    }
+  }
+}
+
+bool MultipartFormDataStream::Impl::ReadValue(std::string& chunk,
+                                              engine::Deadline deadline) {
+  UASSERT(state == State::kPreamble || state == State::kValue);
+  for (;;) {
+    const auto pos = delimiter.Find(buffer);
+    if (pos == 0) {
+      buffer.erase(0, delimiter.GetSize());
+      state = State::kDelimiter;
+      return false;
+    }
+    if (pos != std::string_view::npos) {
+      chunk.assign(buffer, 0, pos);
+      buffer.erase(0, pos);
+      return true;
+    }
+
+    // The tail may be the beginning of the delimiter
+    if (buffer.size() >= delimiter.GetSize()) {
+      const auto size = buffer.size() - delimiter.GetSize() + 1;
+      chunk.assign(buffer, 0, size);
+      buffer.erase(0, size);
+      return true;
+    }
+    if (!ReadMore(deadline)) {
+      throw MultipartFormDataStreamError(
+          "Unexpected end of the multipart/form-data body");
+    }
+  }
+}
+
+bool MultipartFormDataStream::Impl::ReadDelimiterSuffix(
+    engine::Deadline deadline) {
+  UASSERT(state == State::kDelimiter);
+  Require(kCloseDelimiterSuffix.size(), deadline);
+  if (std::string_view{buffer}.substr(0, kCloseDelimiterSuffix.size()) ==
+      kCloseDelimiterSuffix) {
+    // The epilogue is ignored and discarded with the rest of the body
+    state = State::kFinished;
+    return false;
+  }
+
+  // https://datatracker.ietf.org/doc/html/rfc2046#section-5.1.1
+  std::size_t padding = 0;
+  for (;;) {
+    Require(padding + kCrLf.size(), deadline);
+    if (!IsTransportPadding(buffer[padding])) break;
+    ++padding;
+  }
+  if (std::string_view{buffer}.substr(padding, kCrLf.size()) != kCrLf) {
+    throw MultipartFormDataStreamError(
+        "Line break expected after the multipart/form-data boundary");
+  }
+  buffer.erase(0, padding + kCrLf.size());
+  return true;
+}
+
+void MultipartFormDataStream::Impl::ReadHeaders(engine::Deadline deadline) {
+  Require(kCrLf.size(), deadline);
+  std::size_t headers_size = kCrLf.size();
+  if (std::string_view{buffer}.substr(0, kCrLf.size()) != kCrLf) {
+    std::size_t searched = 0;
+    for (;;) {
+      const auto pos = buffer.find(kHeadersEnd, searched);
+      if (pos != std::string::npos) {
+        headers_size = pos + kHeadersEnd.size();
+        break;
+      }
+      if (buffer.size() > kMaxHeadersSize) {
+        throw MultipartFormDataStreamError(
+            "Too large headers of a multipart/form-data part");
+      }
+      if (buffer.size() >= kHeadersEnd.size()) {
+        searched = buffer.size() - kHeadersEnd.size() + 1;
+      }
+      Require(buffer.size() + 1, deadline);
+    }
+  }
+
+  std::string name;
+  FormDataArg arg;
+  if (!ParseMultipartFormDataPartHeaders(
+          std::string_view{buffer}.substr(0, headers_size), name, arg)) {
+    throw MultipartFormDataStreamError(
+        "Malformed headers of a multipart/form-data part");
+  }
+  part.name = std::move(name);
+  part.filename = std::move(arg.filename);
+  part.content_type.reset();
+  if (arg.content_type) part.content_type.emplace(*arg.content_type);
+
+  buffer.erase(0, headers_size);
+  state = State::kValue;
+}
+
+MultipartFormDataStream::MultipartFormDataStream(RequestBodyStream& body,
+                                                 std::string_view content_type)
+    : impl_(std::make_unique<Impl>(body, content_type)) {}
+
+MultipartFormDataStream::MultipartFormDataStream(
+    MultipartFormDataStream&&) noexcept = default;
+
+MultipartFormDataStream& MultipartFormDataStream::operator=(
+    MultipartFormDataStream&&) noexcept = default;
+
+MultipartFormDataStream::~MultipartFormDataStream() = default;
+
+bool MultipartFormDataStream::NextPart(engine::Deadline deadline) {
+  auto& impl = *impl_;
+  if (impl.state == Impl::State::kFinished) return false;
+
+  std::string skipped;
+  while (impl.state != Impl::State::kDelimiter) {
+    impl.ReadValue(skipped, deadline);
+  }
+  if (!impl.ReadDelimiterSuffix(deadline)) return false;
+  impl.ReadHeaders(deadline);
+  return true;
+}
+
+const FormDataPart& MultipartFormDataStream::GetPart() const {
+  UASSERT_MSG(impl_->state == Impl::State::kValue ||
+                  impl_->state == Impl::State::kDelimiter,
+              "NextPart() should return true before GetPart()");
+  return impl_->part;
+}
+
+bool MultipartFormDataStream::ReadChunk(std::string& chunk,
+                                        engine::Deadline deadline) {
+  if (impl_->state != Impl::State::kValue) return false;
+  return impl_->ReadValue(chunk, deadline);
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
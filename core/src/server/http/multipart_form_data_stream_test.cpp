@@ -0,0 +1,150 @@
+#include <userver/utest/utest.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/server/http/multipart_form_data_stream.hpp>
+
+#include <server/http/http_request_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::MultipartFormDataStream;
+using server::http::MultipartFormDataStreamError;
+
+constexpr std::string_view kContentType =
+    "multipart/form-data; boundary=---------------------------9051914041544843"
+    "365972754266";
+
+constexpr std::string_view kBody =
+    "preamble\r\n"
+    "-----------------------------9051914041544843365972754266\r\n"
+    "Content-Disposition: form-data; name=\"text\"\r\n"
+    "\r\n"
+    "text default\r\n"
+    "-----------------------------9051914041544843365972754266\r\n"
+    "Content-Disposition: form-data; name=\"file1\"; filename=\"a.txt\"\r\n"
+    "Content-Type: text/plain\r\n"
+    "\r\n"
+    "line\r\n-----not a boundary\r\n"
+    "-----------------------------9051914041544843365972754266  \r\n"
+    "Content-Disposition: form-data; name=\"empty\"\r\n"
+    "\r\n"
+    "\r\n"
+    "-----------------------------9051914041544843365972754266--\r\n"
+    "epilogue";
+
+using Parts = std::vector<std::pair<std::string, std::string>>;
+
+Parts ReadParts(MultipartFormDataStream& stream) {
+  Parts result;
+  std::string chunk;
+  while (stream.NextPart()) {
+    result.emplace_back(stream.GetPart().name, std::string{});
+    while (stream.ReadChunk(chunk)) {
+      EXPECT_FALSE(chunk.empty());
+      result.back().second += chunk;
+    }
+  }
+  return result;
+}
+
+// Sends the body in the chunks of `chunk_size`
+Parts ParseStreamed(std::string_view body, std::size_t chunk_size) {
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  auto producer = request.StartBodyStream();
+
+  auto task = engine::AsyncNoSpan([&producer, body, chunk_size] {
+    for (std::size_t pos = 0; pos < body.size(); pos += chunk_size) {
+      EXPECT_TRUE(producer.Push(std::string{body.substr(pos, chunk_size)}));
+    }
+    EXPECT_TRUE(producer.Push({}));
+  });
+
+  MultipartFormDataStream stream{request.GetBodyStream(), kContentType};
+  auto result = ReadParts(stream);
+  task.Get();
+  return result;
+}
+
+const Parts kExpected{
+    {"text", "text default"},
+    {"file1", "line\r\n-----not a boundary"},
+    {"empty", ""},
+};
+
+}  // namespace
+
+UTEST(MultipartFormDataStream, Buffered) {
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  request.SetRequestBody(std::string{kBody});
+
+  MultipartFormDataStream stream{request.GetBodyStream(), kContentType};
+  ASSERT_TRUE(stream.NextPart());
+  EXPECT_EQ(stream.GetPart().name, "text");
+  EXPECT_EQ(stream.GetPart().filename, std::nullopt);
+
+  // The rest of the part is skipped
+  ASSERT_TRUE(stream.NextPart());
+  EXPECT_EQ(stream.GetPart().name, "file1");
+  EXPECT_EQ(stream.GetPart().filename, "a.txt");
+  EXPECT_EQ(stream.GetPart().content_type, "text/plain");
+
+  ASSERT_TRUE(stream.NextPart());
+  EXPECT_EQ(stream.GetPart().name, "empty");
+  ASSERT_FALSE(stream.NextPart());
+  std::string chunk;
+  EXPECT_FALSE(stream.ReadChunk(chunk));
+  EXPECT_FALSE(stream.NextPart());
+}
+
+UTEST(MultipartFormDataStream, Chunked) {
+  for (std::size_t chunk_size = 1; chunk_size <= kBody.size(); ++chunk_size) {
+    EXPECT_EQ(ParseStreamed(kBody, chunk_size), kExpected)
+        << "chunk_size=" << chunk_size;
+  }
+}
+
+UTEST(MultipartFormDataStream, LargeValue) {
+  const std::string value(1024 * 1024, 'x');
+  const std::string body =
+      "--b\r\nContent-Disposition: form-data; name=\"f\"\r\n\r\n" + value +
+      "\r\n--b--";
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  request.SetRequestBody(body);
+
+  MultipartFormDataStream stream{request.GetBodyStream(),
+                                 "multipart/form-data; boundary=b"};
+  EXPECT_EQ(ReadParts(stream), (Parts{{"f", value}}));
+}
+
+UTEST(MultipartFormDataStream, Malformed) {
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  EXPECT_THROW(MultipartFormDataStream(request.GetBodyStream(), "text/plain"),
+               MultipartFormDataStreamError);
+  EXPECT_THROW(
+      MultipartFormDataStream(request.GetBodyStream(), "multipart/form-data"),
+      MultipartFormDataStreamError);
+
+  for (const std::string_view body : {
+           "--b\r\nContent-Disposition: form-data; name=\"f\"\r\n\r\nvalue",
+           "--b\r\nContent-Type: text/plain\r\n\r\nvalue\r\n--b--",
+           "--bx\r\n",
+       }) {
+    server::http::HttpRequestImpl malformed_request{accounter};
+    malformed_request.SetRequestBody(std::string{body});
+    MultipartFormDataStream stream{malformed_request.GetBodyStream(),
+                                   "multipart/form-data; boundary=b"};
+    EXPECT_THROW(ReadParts(stream), MultipartFormDataStreamError) << body;
+  }
+}
+
+USERVER_NAMESPACE_END
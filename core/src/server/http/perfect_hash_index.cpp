@@ -0,0 +1,113 @@
+#include <server/http/perfect_hash_index.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_set>
+
+#include <fmt/format.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+namespace {
+
+constexpr std::size_t kMaxSeedAttempts = 64;
+
+// Returns false if the displacements were not found for some bucket
+bool TryBuild(const std::vector<std::uint64_t>& hashes,
+              PerfectHashLayout& layout) {
+  const auto size = static_cast<std::uint32_t>(hashes.size());
+  // A key per bucket on average keeps the search fast
+  const auto buckets_count = size;
+  const std::uint64_t max_attempts = 64 * std::uint64_t{size} + 64;
+
+  std::vector<std::vector<std::uint32_t>> buckets(buckets_count);
+  for (std::uint32_t i = 0; i < size; ++i) {
+    buckets[PerfectHashBucket(hashes[i], buckets_count)].push_back(i);
+  }
+
+  // The largest buckets are placed first while there are many free slots
+  std::vector<std::uint32_t> order(buckets_count);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](auto lhs, auto rhs) {
+    return buckets[lhs].size() > buckets[rhs].size();
+  });
+
+  layout.displacements.assign(buckets_count, 0);
+  layout.slots.assign(size, 0);
+  std::vector<bool> is_taken(size, false);
+  std::vector<std::uint32_t> bucket_slots;
+
+  for (const auto bucket_index : order) {
+    const auto& bucket = buckets[bucket_index];
+    if (bucket.empty()) break;
+
+    bool is_placed = false;
+    for (std::uint64_t attempt = 0; !is_placed && attempt < max_attempts;
+         ++attempt) {
+      const auto displacement =
+          PerfectHashDisplacement(static_cast<std::uint32_t>(attempt));
+      bucket_slots.clear();
+      for (const auto key_index : bucket) {
+        const auto slot =
+            PerfectHashSlot(hashes[key_index], displacement, size);
+        const bool is_duplicate =
+            std::find(bucket_slots.begin(), bucket_slots.end(), slot) !=
+            bucket_slots.end();
+        if (is_taken[slot] || is_duplicate) break;
+        bucket_slots.push_back(slot);
+      }
+      if (bucket_slots.size() != bucket.size()) continue;
+
+      for (std::size_t i = 0; i < bucket.size(); ++i) {
+        is_taken[bucket_slots[i]] = true;
+        layout.slots[bucket[i]] = bucket_slots[i];
+      }
+      layout.displacements[bucket_index] = displacement;
+      is_placed = true;
+    }
+    if (!is_placed) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+PerfectHashLayout BuildPerfectHash(const std::vector<std::string_view>& keys) {
+  if (keys.size() > std::numeric_limits<std::uint32_t>::max()) {
+    throw std::logic_error("Too many keys for a perfect hash");
+  }
+  if (std::unordered_set<std::string_view>(keys.begin(), keys.end()).size() !=
+      keys.size()) {
+    throw std::logic_error("Duplicate keys for a perfect hash");
+  }
+
+  PerfectHashLayout layout;
+  if (keys.empty()) return layout;
+
+  std::vector<std::uint64_t> hashes(keys.size());
+  for (std::size_t attempt = 0; attempt < kMaxSeedAttempts; ++attempt) {
+    layout.seed = PerfectHashMix(attempt + 1);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      hashes[i] = PerfectHashKey(keys[i], layout.seed);
+    }
+    // The keys with the same hash can not be told apart by any displacement,
+    // the rarer collisions of the bucket and the lower bits are handled by
+    // TryBuild() failures
+    if (std::unordered_set<std::uint64_t>(hashes.begin(), hashes.end())
+            .size() != hashes.size()) {
+      continue;
+    }
+    if (TryBuild(hashes, layout)) return layout;
+  }
+
+  throw std::logic_error(fmt::format(
+      "Failed to build a perfect hash for {} keys", keys.size()));
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
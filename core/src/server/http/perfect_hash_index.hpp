@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+/// Parameters of a minimal perfect hash function for a fixed set of keys
+struct PerfectHashLayout final {
+  std::uint64_t seed{0};
+  std::vector<std::uint32_t> displacements;
+  // slots[i] is the position of the i-th key
+  std::vector<std::uint32_t> slots;
+};
+
+/// @brief Finds the minimal perfect hash function for the keys by the
+/// "hash, displace and compress" scheme
+/// @throws std::logic_error on duplicate keys
+PerfectHashLayout BuildPerfectHash(const std::vector<std::string_view>& keys);
+
+inline std::uint64_t PerfectHashMix(std::uint64_t value) noexcept {
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31;
+  return value;
+}
+
+template <typename Integer>
+Integer PerfectHashLoad(const char* data) noexcept {
+  Integer result{};
+  std::memcpy(&result, data, sizeof(result));
+  return result;
+}
+
+inline std::uint64_t PerfectHashKey(std::string_view key,
+                                    std::uint64_t seed) noexcept {
+  constexpr std::uint64_t kMultiplier = 0x9e3779b97f4a7c15ULL;
+  const char* data = key.data();
+  std::size_t size = key.size();
+  std::uint64_t result = seed ^ (size * kMultiplier);
+
+  // Only the fixed size loads, the overlapping ones for the tail
+  std::uint64_t tail = 0;
+  if (size > sizeof(std::uint64_t)) {
+    for (; size > sizeof(std::uint64_t); size -= sizeof(std::uint64_t)) {
+      result = (result ^ PerfectHashLoad<std::uint64_t>(data)) * kMultiplier;
+      result ^= result >> 32;
+      data += sizeof(std::uint64_t);
+    }
+    tail = PerfectHashLoad<std::uint64_t>(data + size - sizeof(std::uint64_t));
+  } else if (size >= sizeof(std::uint32_t)) {
+    tail = (std::uint64_t{PerfectHashLoad<std::uint32_t>(data)} << 32) |
+           PerfectHashLoad<std::uint32_t>(data + size -
+                                          sizeof(std::uint32_t));
+  } else if (size > 0) {
+    tail = (std::uint64_t{static_cast<unsigned char>(data[0])} << 16) |
+           (std::uint64_t{static_cast<unsigned char>(data[size / 2])} << 8) |
+           static_cast<unsigned char>(data[size - 1]);
+  }
+  return PerfectHashMix(result ^ tail);
+}
+
+// Maps the value to [0, size) without a division
+inline std::uint32_t PerfectHashReduce(std::uint32_t value,
+                                       std::uint32_t size) noexcept {
+  return static_cast<std::uint32_t>(
+      (static_cast<std::uint64_t>(value) * size) >> 32);
+}
+
+inline std::uint32_t PerfectHashBucket(std::uint64_t hash,
+                                       std::uint32_t buckets_count) noexcept {
+  return PerfectHashReduce(static_cast<std::uint32_t>(hash >> 32),
+                           buckets_count);
+}
+
+// The displacements are stored mixed, so the lookup does not mix again
+inline std::uint32_t PerfectHashDisplacement(std::uint32_t attempt) noexcept {
+  return static_cast<std::uint32_t>(PerfectHashMix(attempt));
+}
+
+inline std::uint32_t PerfectHashSlot(std::uint64_t hash,
+                                     std::uint32_t displacement,
+                                     std::uint32_t slots_count) noexcept {
+  return PerfectHashReduce(static_cast<std::uint32_t>(hash) ^ displacement,
+                           slots_count);
+}
+
+/// @brief Immutable map from strings: the lookup is a single pass over the
+/// key, two table reads and a comparison of the key
+template <typename T>
+class PerfectHashIndex final {
+ public:
+  PerfectHashIndex() = default;
+
+  /// @throws std::logic_error on duplicate keys
+  explicit PerfectHashIndex(std::vector<std::pair<std::string, T>> items);
+
+  const T* Find(std::string_view key) const noexcept;
+
+  std::size_t GetSize() const noexcept { return items_.size(); }
+
+ private:
+  std::uint64_t seed_{0};
+  std::vector<std::uint32_t> displacements_;
+  // ordered by slot
+  std::vector<std::pair<std::string, T>> items_;
+};
+
+template <typename T>
+PerfectHashIndex<T>::PerfectHashIndex(
+    std::vector<std::pair<std::string, T>> items) {
+  std::vector<std::string_view> keys;
+  keys.reserve(items.size());
+  for (const auto& item : items) keys.push_back(item.first);
+
+  auto layout = BuildPerfectHash(keys);
+  seed_ = layout.seed;
+  displacements_ = std::move(layout.displacements);
+
+  std::vector<std::pair<std::string, T>*> by_slot(items.size());
+  for (std::size_t i = 0; i < items.size(); ++i) {
+    by_slot[layout.slots[i]] = &items[i];
+  }
+  items_.reserve(items.size());
+  for (auto* item : by_slot) items_.push_back(std::move(*item));
+}
+
+template <typename T>
+const T* PerfectHashIndex<T>::Find(std::string_view key) const noexcept {
+  if (items_.empty()) return nullptr;
+
+  const auto hash = PerfectHashKey(key, seed_);
+  const auto buckets_count = static_cast<std::uint32_t>(displacements_.size());
+  const auto displacement =
+      displacements_[PerfectHashBucket(hash, buckets_count)];
+  const auto& item = items_[PerfectHashSlot(
+      hash, displacement, static_cast<std::uint32_t>(items_.size()))];
+  return item.first == key ? &item.second : nullptr;
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <server/http/perfect_hash_index.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// 400 paths in the style of a big service
+std::vector<std::string> MakeHandlerPaths() {
+  const std::vector<std::string> prefixes = {"/v1", "/v2", "/4.0/service",
+                                             "/internal/service", "/admin"};
+  const std::vector<std::string> resources = {
+      "orders",    "users",         "drivers",   "payments",
+      "vehicles",  "tariffs",       "zones",     "promocodes",
+      "feedback",  "notifications", "sessions",  "subscriptions",
+      "documents", "invoices",      "referrals", "experiments"};
+  const std::vector<std::string> actions = {"list", "create", "retrieve",
+                                            "update", "delete"};
+
+  std::vector<std::string> paths;
+  for (const auto& prefix : prefixes) {
+    for (const auto& resource : resources) {
+      for (const auto& action : actions) {
+        paths.push_back(fmt::format("{}/{}/{}", prefix, resource, action));
+      }
+    }
+  }
+  return paths;
+}
+
+// Every fourth request is for an unknown path
+std::vector<std::string> MakeRequestPaths(
+    const std::vector<std::string>& handler_paths) {
+  std::vector<std::string> paths;
+  for (std::size_t i = 0; i < handler_paths.size(); ++i) {
+    paths.push_back(i % 4 ? handler_paths[(i * 7) % handler_paths.size()]
+                          : handler_paths[i] + "/unknown");
+  }
+  return paths;
+}
+
+void fixed_path_unordered_map(benchmark::State& state) {
+  const auto handler_paths = MakeHandlerPaths();
+  const auto request_paths = MakeRequestPaths(handler_paths);
+  std::unordered_map<std::string, std::size_t> index;
+  for (std::size_t i = 0; i < handler_paths.size(); ++i) {
+    index.emplace(handler_paths[i], i);
+  }
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    const auto it = index.find(request_paths[i++ % request_paths.size()]);
+    benchmark::DoNotOptimize(it == index.end() ? 0 : it->second);
+  }
+}
+
+void fixed_path_perfect_hash(benchmark::State& state) {
+  const auto handler_paths = MakeHandlerPaths();
+  const auto request_paths = MakeRequestPaths(handler_paths);
+  std::vector<std::pair<std::string, std::size_t>> items;
+  for (std::size_t i = 0; i < handler_paths.size(); ++i) {
+    items.emplace_back(handler_paths[i], i);
+  }
+  const server::http::impl::PerfectHashIndex<std::size_t> index{
+      std::move(items)};
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    const auto* value = index.Find(request_paths[i++ % request_paths.size()]);
+    benchmark::DoNotOptimize(value ? *value : 0);
+  }
+}
+
+void fixed_path_perfect_hash_build(benchmark::State& state) {
+  const auto handler_paths = MakeHandlerPaths();
+  for (auto _ : state) {
+    std::vector<std::pair<std::string, std::size_t>> items;
+    for (std::size_t i = 0; i < handler_paths.size(); ++i) {
+      items.emplace_back(handler_paths[i], i);
+    }
+    const server::http::impl::PerfectHashIndex<std::size_t> index{
+        std::move(items)};
+    benchmark::DoNotOptimize(index.GetSize());
+  }
+}
+
+}  // namespace
+
+BENCHMARK(fixed_path_unordered_map);
+BENCHMARK(fixed_path_perfect_hash);
+BENCHMARK(fixed_path_perfect_hash_build);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,67 @@
+#include <server/http/perfect_hash_index.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::impl::PerfectHashIndex;
+
+std::vector<std::pair<std::string, int>> MakeItems(int count) {
+  std::vector<std::pair<std::string, int>> items;
+  for (int i = 0; i < count; ++i) {
+    items.emplace_back(fmt::format("/v{}/resource/{}/action", i % 7, i), i);
+  }
+  return items;
+}
+
+}  // namespace
+
+TEST(PerfectHashIndex, Empty) {
+  const PerfectHashIndex<int> index;
+  EXPECT_EQ(index.GetSize(), 0);
+  EXPECT_EQ(index.Find(""), nullptr);
+  EXPECT_EQ(index.Find("/ping"), nullptr);
+
+  const PerfectHashIndex<int> built{{}};
+  EXPECT_EQ(built.Find("/ping"), nullptr);
+}
+
+TEST(PerfectHashIndex, Small) {
+  const PerfectHashIndex<int> index{{{"/ping", 1}, {"", 2}}};
+  EXPECT_EQ(index.GetSize(), 2);
+  ASSERT_NE(index.Find("/ping"), nullptr);
+  EXPECT_EQ(*index.Find("/ping"), 1);
+  ASSERT_NE(index.Find(""), nullptr);
+  EXPECT_EQ(*index.Find(""), 2);
+  EXPECT_EQ(index.Find("/ping/"), nullptr);
+  EXPECT_EQ(index.Find("/pin"), nullptr);
+}
+
+TEST(PerfectHashIndex, Many) {
+  for (const int count : {3, 10, 100, 1000, 10000}) {
+    const PerfectHashIndex<int> index{MakeItems(count)};
+    ASSERT_EQ(index.GetSize(), count);
+
+    for (const auto& [key, value] : MakeItems(count)) {
+      const auto* found = index.Find(key);
+      ASSERT_NE(found, nullptr) << key;
+      EXPECT_EQ(*found, value) << key;
+      EXPECT_EQ(index.Find(key + '/'), nullptr) << key;
+      EXPECT_EQ(index.Find(key.substr(1)), nullptr) << key;
+    }
+  }
+}
+
+TEST(PerfectHashIndex, Duplicates) {
+  EXPECT_THROW((PerfectHashIndex<int>{{{"/ping", 1}, {"/ping", 2}}}),
+               std::logic_error);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,200 @@
+#include "request_head_parser.hpp"
+
+#include <array>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define USERVER_IMPL_HTTP_SSE42 1
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+namespace {
+
+// Byte ranges terminating the scan, in the format of _mm_cmpestri
+// (pairs of inclusive bounds). The same ones picohttpparser uses.
+struct ScanRanges final {
+  alignas(16) char bounds[16];
+  int size;
+};
+
+// Control characters and space end the URL
+constexpr ScanRanges kUrlRanges{"\000\040\177\177", 4};
+// Control characters except for the horizontal tab end the header value
+constexpr ScanRanges kHeaderValueRanges{"\000\010\012\037\177\177", 6};
+
+constexpr bool IsInRanges(const ScanRanges& ranges, unsigned char c) {
+  for (int i = 0; i < ranges.size; i += 2) {
+    if (static_cast<unsigned char>(ranges.bounds[i]) <= c &&
+        c <= static_cast<unsigned char>(ranges.bounds[i + 1])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+using CharTable = std::array<bool, 256>;
+
+constexpr CharTable MakeTable(const ScanRanges& ranges) {
+  CharTable table{};
+  for (int c = 0; c < 256; ++c) {
+    table[c] = IsInRanges(ranges, static_cast<unsigned char>(c));
+  }
+  return table;
+}
+
+constexpr CharTable kUrlStopTable = MakeTable(kUrlRanges);
+constexpr CharTable kHeaderValueStopTable = MakeTable(kHeaderValueRanges);
+
+// RFC 7230, section 3.2.6
+constexpr CharTable MakeTokenTable() {
+  CharTable table{};
+  for (int c = '0'; c <= '9'; ++c) table[c] = true;
+  for (int c = 'a'; c <= 'z'; ++c) table[c] = true;
+  for (int c = 'A'; c <= 'Z'; ++c) table[c] = true;
+  for (const char c : std::string_view{"!#$%&'*+-.^_`|~"}) {
+    table[static_cast<unsigned char>(c)] = true;
+  }
+  return table;
+}
+
+constexpr CharTable kTokenTable = MakeTokenTable();
+
+#ifdef USERVER_IMPL_HTTP_SSE42
+__attribute__((target("sse4.2"))) const char* FindInRangesSse42(
+    const char* begin, const char* end, const ScanRanges& ranges) {
+  const __m128i bounds =
+      _mm_load_si128(reinterpret_cast<const __m128i*>(ranges.bounds));
+  while (end - begin >= 16) {
+    const __m128i data =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    const int pos =
+        _mm_cmpestri(bounds, ranges.size, data, 16,
+                     _SIDD_LEAST_SIGNIFICANT | _SIDD_CMP_RANGES |
+                         _SIDD_UBYTE_OPS);
+    if (pos != 16) return begin + pos;
+    begin += 16;
+  }
+  return begin;
+}
+
+const bool kHasSse42 = [] {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("sse4.2") != 0;
+}();
+#endif
+
+// Returns the first char in ranges or `end`
+const char* FindInRanges(const char* begin, const char* end,
+                         const ScanRanges& ranges, const CharTable& table) {
+#ifdef USERVER_IMPL_HTTP_SSE42
+  if (kHasSse42) begin = FindInRangesSse42(begin, end, ranges);
+#endif
+  while (begin != end && !table[static_cast<unsigned char>(*begin)]) ++begin;
+  return begin;
+}
+
+const char* FindTokenEnd(const char* begin, const char* end) {
+  while (begin != end && kTokenTable[static_cast<unsigned char>(*begin)]) {
+    ++begin;
+  }
+  return begin;
+}
+
+bool IsSpace(char c) { return c == ' ' || c == '\t'; }
+
+// Returns the position after CRLF or LF, nullptr if it is incomplete or if it
+// is not a line end, which sets the `error`
+const char* SkipLineEnd(const char* pos, const char* end, bool& error) {
+  if (pos == end) return nullptr;
+  if (*pos == '\n') return pos + 1;
+  if (*pos != '\r') {
+    error = true;
+    return nullptr;
+  }
+  if (++pos == end) return nullptr;
+  if (*pos != '\n') {
+    error = true;
+    return nullptr;
+  }
+  return pos + 1;
+}
+
+}  // namespace
+
+std::ptrdiff_t ParseRequestHead(std::string_view data, RequestHead& head) {
+  const char* const begin = data.data();
+  const char* const end = begin + data.size();
+  const char* pos = begin;
+  bool error = false;
+
+  head.headers.clear();
+
+  // RFC 7230, section 3.5
+  while (pos != end && (*pos == '\r' || *pos == '\n')) ++pos;
+
+  // method SP request-target SP HTTP-version CRLF
+  const char* const method_end = FindTokenEnd(pos, end);
+  if (method_end == end) return kRequestHeadIncomplete;
+  if (method_end == pos || *method_end != ' ') return kRequestHeadError;
+  head.method = {pos, static_cast<std::size_t>(method_end - pos)};
+
+  pos = method_end + 1;
+  const char* const url_end =
+      FindInRanges(pos, end, kUrlRanges, kUrlStopTable);
+  if (url_end == end) return kRequestHeadIncomplete;
+  if (url_end == pos || *url_end != ' ') return kRequestHeadError;
+  head.url = {pos, static_cast<std::size_t>(url_end - pos)};
+
+  pos = url_end + 1;
+  constexpr std::string_view kVersionPrefix = "HTTP/1.";
+  const auto version_size = kVersionPrefix.size() + 1;
+  if (static_cast<std::size_t>(end - pos) < version_size) {
+    const std::string_view rest{pos, static_cast<std::size_t>(end - pos)};
+    return kVersionPrefix.substr(0, rest.size()) == rest
+               ? kRequestHeadIncomplete
+               : kRequestHeadError;
+  }
+  if (std::string_view{pos, kVersionPrefix.size()} != kVersionPrefix ||
+      pos[kVersionPrefix.size()] < '0' || pos[kVersionPrefix.size()] > '9') {
+    return kRequestHeadError;
+  }
+  head.http_minor = pos[kVersionPrefix.size()] - '0';
+  pos = SkipLineEnd(pos + version_size, end, error);
+  if (!pos) return error ? kRequestHeadError : kRequestHeadIncomplete;
+
+  // *( field-name ":" OWS field-value OWS CRLF ) CRLF
+  while (true) {
+    if (pos == end) return kRequestHeadIncomplete;
+    if (*pos == '\r' || *pos == '\n') {
+      pos = SkipLineEnd(pos, end, error);
+      if (!pos) return error ? kRequestHeadError : kRequestHeadIncomplete;
+      return pos - begin;
+    }
+
+    // Obsolete line folding is rejected as well, RFC 7230, section 3.2.4
+    const char* const name_end = FindTokenEnd(pos, end);
+    if (name_end == end) return kRequestHeadIncomplete;
+    if (name_end == pos || *name_end != ':') return kRequestHeadError;
+    const std::string_view name{pos,
+                                static_cast<std::size_t>(name_end - pos)};
+
+    pos = name_end + 1;
+    while (pos != end && IsSpace(*pos)) ++pos;
+    const char* value_end =
+        FindInRanges(pos, end, kHeaderValueRanges, kHeaderValueStopTable);
+    const char* const line_end = SkipLineEnd(value_end, end, error);
+    if (!line_end) return error ? kRequestHeadError : kRequestHeadIncomplete;
+    while (value_end != pos && IsSpace(value_end[-1])) --value_end;
+
+    head.headers.emplace_back(
+        name, std::string_view{pos, static_cast<std::size_t>(value_end - pos)});
+    pos = line_end;
+  }
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
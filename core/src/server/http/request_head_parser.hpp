@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+/// The request line and the header fields of an HTTP/1.x request, refer to
+/// the parsed data
+struct RequestHead final {
+  std::string_view method;
+  std::string_view url;
+  unsigned short http_minor{0};
+  std::vector<std::pair<std::string_view, std::string_view>> headers;
+};
+
+inline constexpr std::ptrdiff_t kRequestHeadIncomplete = -2;
+inline constexpr std::ptrdiff_t kRequestHeadError = -1;
+
+/// @brief Parses the request line and the header fields up to the empty line
+///
+/// Scans for the delimiters 16 bytes at a time with SSE4.2 if the CPU
+/// supports it. The empty lines before the request line are skipped.
+/// @returns the size of the head including the empty line,
+/// kRequestHeadIncomplete if more data is required or kRequestHeadError
+std::ptrdiff_t ParseRequestHead(std::string_view data, RequestHead& head);
+
+/// @brief Decodes the `Transfer-Encoding: chunked` body, the chunk extensions
+/// and trailers are skipped
+class ChunkedBodyDecoder final {
+ public:
+  enum class Result { kNeedMore, kDone, kError };
+
+  /// Consumes the data from the front of `data` and calls
+  /// `on_data(std::string_view)` for each piece of the decoded body.
+  /// The unconsumed data is left in `data` only on kDone.
+  template <typename OnData>
+  Result Decode(std::string_view& data, OnData&& on_data);
+
+ private:
+  enum class State {
+    kSize,
+    kExtension,
+    kSizeLf,
+    kData,
+    kDataCr,
+    kDataLf,
+    kTrailerLineStart,
+    kTrailerLine,
+    kTrailerEndLf,
+  };
+
+  static int HexDigit(char c);
+
+  State state_{State::kSize};
+  bool has_size_digits_{false};
+  std::uint64_t size_{0};
+};
+
+template <typename OnData>
+ChunkedBodyDecoder::Result ChunkedBodyDecoder::Decode(std::string_view& data,
+                                                      OnData&& on_data) {
+  while (!data.empty()) {
+    if (state_ == State::kData) {
+      const auto size = static_cast<std::size_t>(
+          std::min<std::uint64_t>(size_, data.size()));
+      on_data(data.substr(0, size));
+      data.remove_prefix(size);
+      size_ -= size;
+      if (size_ == 0) state_ = State::kDataCr;
+      continue;
+    }
+
+    const char c = data.front();
+    data.remove_prefix(1);
+    switch (state_) {
+      case State::kSize:
+        if (const int digit = HexDigit(c); digit >= 0) {
+          if (size_ >> 60) return Result::kError;  // overflow
+          size_ = size_ * 16 + digit;
+          has_size_digits_ = true;
+          break;
+        }
+        if (!has_size_digits_) return Result::kError;
+        if (c == ';' || c == ' ' || c == '\t') {
+          state_ = State::kExtension;
+        } else if (c == '\r') {
+          state_ = State::kSizeLf;
+        } else if (c != '\n') {
+          return Result::kError;
+        } else {
+          state_ = size_ ? State::kData : State::kTrailerLineStart;
+        }
+        break;
+      case State::kExtension:
+        if (c == '\n') state_ = size_ ? State::kData : State::kTrailerLineStart;
+        break;
+      case State::kSizeLf:
+        if (c != '\n') return Result::kError;
+        state_ = size_ ? State::kData : State::kTrailerLineStart;
+        break;
+      case State::kDataCr:
+        if (c == '\r') {
+          state_ = State::kDataLf;
+          break;
+        }
+        [[fallthrough]];
+      case State::kDataLf:
+        if (c != '\n') return Result::kError;
+        state_ = State::kSize;
+        has_size_digits_ = false;
+        break;
+      case State::kTrailerLineStart:
+        if (c == '\r') {
+          state_ = State::kTrailerEndLf;
+        } else if (c == '\n') {
+          return Result::kDone;
+        } else {
+          state_ = State::kTrailerLine;
+        }
+        break;
+      case State::kTrailerLine:
+        if (c == '\n') state_ = State::kTrailerLineStart;
+        break;
+      case State::kTrailerEndLf:
+        if (c != '\n') return Result::kError;
+        return Result::kDone;
+      case State::kData:
+        break;  // handled above
+    }
+  }
+  return Result::kNeedMore;
+}
+
+inline int ChunkedBodyDecoder::HexDigit(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+#include <server/http/request_head_parser.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::impl::ChunkedBodyDecoder;
+using server::http::impl::kRequestHeadError;
+using server::http::impl::kRequestHeadIncomplete;
+using server::http::impl::ParseRequestHead;
+using server::http::impl::RequestHead;
+
+using Headers = std::vector<std::pair<std::string_view, std::string_view>>;
+
+constexpr std::string_view kRequest =
+    "GET /path?arg=value HTTP/1.1\r\n"
+    "Host: localhost:8080\r\n"
+    "User-Agent: curl/7.81.0\r\n"
+    "Accept: */*\r\n"
+    "\r\n";
+
+// Returns the decoded body or "<error>"
+std::string Decode(std::string_view data, std::size_t piece_size,
+                   std::string_view* rest = nullptr) {
+  ChunkedBodyDecoder decoder;
+  std::string body;
+  while (!data.empty()) {
+    auto piece = data.substr(0, piece_size);
+    data.remove_prefix(piece.size());
+    const auto result = decoder.Decode(
+        piece, [&body](std::string_view chunk) { body.append(chunk); });
+    if (result == ChunkedBodyDecoder::Result::kError) return "<error>";
+    if (result == ChunkedBodyDecoder::Result::kDone) {
+      if (rest) *rest = {piece.data(), piece.size() + data.size()};
+      return body;
+    }
+    EXPECT_TRUE(piece.empty());
+  }
+  return "<incomplete>";
+}
+
+}  // namespace
+
+TEST(RequestHeadParser, Simple) {
+  RequestHead head;
+  ASSERT_EQ(ParseRequestHead(kRequest, head),
+            static_cast<std::ptrdiff_t>(kRequest.size()));
+  EXPECT_EQ(head.method, "GET");
+  EXPECT_EQ(head.url, "/path?arg=value");
+  EXPECT_EQ(head.http_minor, 1);
+  EXPECT_EQ(head.headers, (Headers{{"Host", "localhost:8080"},
+                                   {"User-Agent", "curl/7.81.0"},
+                                   {"Accept", "*/*"}}));
+}
+
+TEST(RequestHeadParser, Pipelined) {
+  const std::string data = std::string{kRequest} + "POST / HTTP/1.0\r\n";
+  RequestHead head;
+  EXPECT_EQ(ParseRequestHead(data, head),
+            static_cast<std::ptrdiff_t>(kRequest.size()));
+}
+
+TEST(RequestHeadParser, Incomplete) {
+  RequestHead head;
+  for (std::size_t size = 0; size < kRequest.size(); ++size) {
+    EXPECT_EQ(ParseRequestHead(kRequest.substr(0, size), head),
+              kRequestHeadIncomplete)
+        << "size=" << size;
+  }
+}
+
+TEST(RequestHeadParser, LineEndsAndSpaces) {
+  constexpr std::string_view kData =
+      "\r\n\nPUT / HTTP/1.0\n"
+      "Empty:\n"
+      "Spaces: \t value with  spaces \t \r\n"
+      "\n";
+  RequestHead head;
+  ASSERT_EQ(ParseRequestHead(kData, head),
+            static_cast<std::ptrdiff_t>(kData.size()));
+  EXPECT_EQ(head.method, "PUT");
+  EXPECT_EQ(head.http_minor, 0);
+  EXPECT_EQ(head.headers, (Headers{{"Empty", ""},
+                                   {"Spaces", "value with  spaces"}}));
+}
+
+TEST(RequestHeadParser, LongTokens) {
+  // The 16 byte SIMD blocks end at all the possible offsets
+  for (std::size_t size = 1; size < 70; ++size) {
+    const std::string url = "/" + std::string(size, 'u');
+    const std::string value(size, 'v');
+    const std::string data =
+        "GET " + url + " HTTP/1.1\r\nName: " + value + "\r\n\r\n";
+
+    RequestHead head;
+    ASSERT_EQ(ParseRequestHead(data, head),
+              static_cast<std::ptrdiff_t>(data.size()));
+    EXPECT_EQ(head.url, url);
+    ASSERT_EQ(head.headers.size(), 1);
+    EXPECT_EQ(head.headers[0].second, value);
+
+    auto bad_data = data;
+    bad_data[bad_data.size() - 5] = '\0';  // in value
+    EXPECT_EQ(ParseRequestHead(bad_data, head), kRequestHeadError);
+  }
+}
+
+TEST(RequestHeadParser, Errors) {
+  for (const std::string_view data : {
+           "GET  / HTTP/1.1\r\n\r\n",
+           "G(T / HTTP/1.1\r\n\r\n",
+           "GET /\x01 HTTP/1.1\r\n\r\n",
+           "GET / HTTP/2.0\r\n\r\n",
+           "GET / HTTQ",
+           "GET / HTTP/1.1\r\r\n\r\n",
+           "GET / HTTP/1.1 \r\n\r\n",
+           "GET / HTTP/1.1\r\nName : value\r\n\r\n",
+           "GET / HTTP/1.1\r\nName\r\n\r\n",
+           "GET / HTTP/1.1\r\n: value\r\n\r\n",
+           "GET / HTTP/1.1\r\nName: value\r\n folded\r\n\r\n",
+           "GET / HTTP/1.1\r\nName: val\rue\r\n\r\n",
+           "GET / HTTP/1.1\r\n\rX",
+       }) {
+    RequestHead head;
+    EXPECT_EQ(ParseRequestHead(data, head), kRequestHeadError) << data;
+  }
+}
+
+TEST(ChunkedBodyDecoder, Simple) {
+  constexpr std::string_view kData =
+      "5\r\nHello\r\n"
+      "7;ext=value\r\n, world\r\n"
+      "1A\r\nabcdefghijklmnopqrstuvwxyz\r\n"
+      "0\r\n"
+      "Trailer: value\r\n"
+      "\r\n"
+      "GET / HTTP/1.1\r\n";
+  constexpr std::string_view kBody = "Hello, worldabcdefghijklmnopqrstuvwxyz";
+
+  for (std::size_t piece_size = 1; piece_size <= kData.size(); ++piece_size) {
+    std::string_view rest;
+    EXPECT_EQ(Decode(kData, piece_size, &rest), kBody);
+    EXPECT_EQ(rest, "GET / HTTP/1.1\r\n");
+  }
+}
+
+TEST(ChunkedBodyDecoder, Errors) {
+  EXPECT_EQ(Decode("\r\n", 1), "<error>");
+  EXPECT_EQ(Decode("x\r\n", 1), "<error>");
+  EXPECT_EQ(Decode("3\r\nabcd\r\n", 100), "<error>");
+  EXPECT_EQ(Decode("0\r\n\rx", 100), "<error>");
+  EXPECT_EQ(Decode("10000000000000000\r\n", 100), "<error>");
+  EXPECT_EQ(Decode("3\r\nabc", 100), "<incomplete>");
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,334 @@
+#include "simd_http_request_parser.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/server/http/http_method.hpp>
+#include <userver/server/request/request_base.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/str_icase.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+constexpr std::string_view kChunked = "chunked";
+constexpr std::string_view kClose = "close";
+constexpr std::string_view kKeepAlive = "keep-alive";
+constexpr std::string_view kUpgrade = "upgrade";
+constexpr std::string_view kUpgradeHeader = "Upgrade";
+
+HttpMethod ConvertHttpMethod(std::string_view method) {
+  try {
+    return HttpMethodFromString(method);
+  } catch (const std::exception&) {
+    return HttpMethod::kUnknown;
+  }
+}
+
+bool IEquals(std::string_view lhs, std::string_view rhs) {
+  return utils::StrIcaseEqual{}(lhs, rhs);
+}
+
+std::string_view Strip(std::string_view value) {
+  while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+    value.remove_prefix(1);
+  }
+  while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+    value.remove_suffix(1);
+  }
+  return value;
+}
+
+// Calls `func` for each element of a comma separated list
+template <typename Func>
+void ForEachListElement(std::string_view list, Func&& func) {
+  while (!list.empty()) {
+    const auto pos = std::min(list.find(','), list.size());
+    if (const auto element = Strip(list.substr(0, pos)); !element.empty()) {
+      func(element);
+    }
+    list.remove_prefix(std::min(pos + 1, list.size()));
+  }
+}
+
+// The same framing rules as in the http_parser
+struct Framing final {
+  std::optional<std::uint64_t> content_length;
+  bool is_chunked{false};
+  bool has_transfer_encoding{false};
+  bool has_connection_close{false};
+  bool has_connection_keep_alive{false};
+  bool has_connection_upgrade{false};
+  bool has_upgrade{false};
+
+  // Returns false for the conflicting or invalid framing
+  bool Account(std::string_view name, std::string_view value) {
+    using USERVER_NAMESPACE::http::headers::kConnection;
+    using USERVER_NAMESPACE::http::headers::kContentLength;
+    using USERVER_NAMESPACE::http::headers::kTransferEncoding;
+
+    if (IEquals(name, kContentLength)) {
+      std::uint64_t length = 0;
+      const auto* const end = value.data() + value.size();
+      const auto [ptr, ec] = std::from_chars(value.data(), end, length);
+      if (value.empty() || ec != std::errc{} || ptr != end) return false;
+      if (content_length && *content_length != length) return false;
+      content_length = length;
+    } else if (IEquals(name, kTransferEncoding)) {
+      has_transfer_encoding = true;
+      // Only the last one of the codings matters
+      is_chunked = false;
+      ForEachListElement(value, [this](std::string_view coding) {
+        is_chunked = IEquals(coding, kChunked);
+      });
+    } else if (IEquals(name, kConnection)) {
+      ForEachListElement(value, [this](std::string_view option) {
+        if (IEquals(option, kClose)) {
+          has_connection_close = true;
+        } else if (IEquals(option, kKeepAlive)) {
+          has_connection_keep_alive = true;
+        } else if (IEquals(option, kUpgrade)) {
+          has_connection_upgrade = true;
+        }
+      });
+    } else if (IEquals(name, kUpgradeHeader)) {
+      has_upgrade = true;
+    }
+    return true;
+  }
+
+  bool IsValid() const {
+    // RFC 7230, section 3.3.3
+    return !has_transfer_encoding || (is_chunked && !content_length);
+  }
+
+  bool ShouldKeepAlive(unsigned short http_minor) const {
+    return http_minor > 0 ? !has_connection_close : has_connection_keep_alive;
+  }
+};
+
+}  // namespace
+
+SimdHttpRequestParser::SimdHttpRequestParser(
+    const HandlerInfoIndex& handler_info_index,
+    const request::HttpRequestConfig& request_config,
+    OnNewRequestCb&& on_new_request_cb, net::ParserStats& stats,
+    request::ResponseDataAccounter& data_accounter)
+    : handler_info_index_(handler_info_index),
+      request_constructor_config_{request_config},
+      on_new_request_cb_(std::move(on_new_request_cb)),
+      stats_(stats),
+      data_accounter_(data_accounter) {}
+
+SimdHttpRequestParser::~SimdHttpRequestParser() {
+  if (request_constructor_) --stats_.parsing_request_count;
+}
+
+bool SimdHttpRequestParser::Parse(const char* data, size_t size) {
+  return ParseImpl({data, size}, nullptr);
+}
+
+bool SimdHttpRequestParser::Parse(const net::RecvBufferPtr& buffer,
+                                  size_t size) {
+  UASSERT(buffer && size <= buffer->size());
+  return ParseImpl({buffer->data(), size}, &buffer);
+}
+
+bool SimdHttpRequestParser::ParseImpl(std::string_view data,
+                                      const net::RecvBufferPtr* buffer) {
+  while (!data.empty()) {
+    bool ok = true;
+    switch (state_) {
+      case State::kHead:
+        ok = ParseHead(data);
+        break;
+      case State::kBody: {
+        const auto size = static_cast<std::size_t>(
+            std::min<std::uint64_t>(body_left_, data.size()));
+        ok = AppendBody(data.substr(0, size), buffer);
+        data.remove_prefix(size);
+        body_left_ -= size;
+        if (ok && body_left_ == 0) ok = CompleteRequest();
+        break;
+      }
+      case State::kChunkedBody: {
+        using Result = impl::ChunkedBodyDecoder::Result;
+        const auto result = chunked_body_decoder_.Decode(
+            data, [this, &ok](std::string_view chunk) {
+              // Chunks are copied, just like in the HttpRequestParser
+              if (ok) ok = AppendBody(chunk, nullptr);
+            });
+        if (result == Result::kError) {
+          LOG_WARNING() << "invalid chunked body";
+          ok = false;
+        } else if (ok && result == Result::kDone) {
+          ok = CompleteRequest();
+        }
+        break;
+      }
+    }
+
+    if (!ok) {
+      // Responds to the malformed request with an error
+      FinalizeRequest();
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SimdHttpRequestParser::ParseHead(std::string_view& data) {
+  const auto pending_size = pending_head_.size();
+  std::string_view head_data = data;
+  if (pending_size) {
+    pending_head_.append(data);
+    head_data = pending_head_;
+  }
+
+  const auto head_size = impl::ParseRequestHead(head_data, head_);
+  if (head_size == impl::kRequestHeadIncomplete) {
+    if (!pending_size) pending_head_.assign(data);
+    data = {};
+    // The head limits of the handler are not known yet
+    if (pending_head_.size() > request_constructor_config_.max_request_size) {
+      LOG_WARNING() << "request head is too large";
+      return false;
+    }
+    return true;
+  }
+  if (head_size == impl::kRequestHeadError) {
+    LOG_WARNING() << "malformed request head";
+    return false;
+  }
+
+  const bool ok = OnHead();
+  data.remove_prefix(head_size - pending_size);
+  pending_head_.clear();
+  return ok;
+}
+
+bool SimdHttpRequestParser::OnHead() {
+  CreateRequestConstructor();
+  auto& constructor = *request_constructor_;
+  LOG_TRACE() << "url: '" << head_.url << '\'';
+
+  const auto method = ConvertHttpMethod(head_.method);
+  Framing framing;
+  try {
+    constructor.SetMethod(method);
+    constructor.AppendUrl(head_.url.data(), head_.url.size());
+    constructor.SetHttpMajor(1);
+    constructor.SetHttpMinor(head_.http_minor);
+    constructor.ParseUrl();
+
+    for (const auto& [name, value] : head_.headers) {
+      LOG_TRACE() << "header: '" << name << "': '" << value << '\'';
+      if (!framing.Account(name, value)) {
+        LOG_WARNING() << "invalid '" << name << "' header";
+        return false;
+      }
+      constructor.AppendHeaderField(name.data(), name.size());
+      constructor.AppendHeaderValue(value.data(), value.size());
+    }
+    constructor.AppendHeaderField("", 0);
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't parse request head: " << ex;
+    return false;
+  }
+
+  if (!framing.IsValid()) {
+    LOG_WARNING() << "invalid request body framing";
+    return false;
+  }
+  if ((framing.has_upgrade && framing.has_connection_upgrade) ||
+      method == HttpMethod::kConnect) {
+    LOG_WARNING() << "upgrade detected";
+    return false;
+  }
+  constructor.SetIsFinal(!framing.ShouldKeepAlive(head_.http_minor));
+
+  if (constructor.ShouldStreamBody()) {
+    // The handler gets the request right away and reads the body as it
+    // arrives
+    constructor.StreamBody();
+    if (!FinalizeRequestImpl()) return false;
+  }
+
+  if (framing.is_chunked) {
+    chunked_body_decoder_ = {};
+    state_ = State::kChunkedBody;
+    return true;
+  }
+  if (framing.content_length) {
+    constructor.SetContentLength(*framing.content_length);
+    if (*framing.content_length) {
+      body_left_ = *framing.content_length;
+      state_ = State::kBody;
+      return true;
+    }
+  }
+  return CompleteRequest();
+}
+
+bool SimdHttpRequestParser::AppendBody(std::string_view data,
+                                       const net::RecvBufferPtr* buffer) {
+  UASSERT(request_constructor_);
+  LOG_TRACE() << "body: '" << data << "'";
+  try {
+    if (buffer) {
+      request_constructor_->AppendBody(*buffer, data.data(), data.size());
+    } else {
+      request_constructor_->AppendBody(data.data(), data.size());
+    }
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append body: " << ex;
+    return false;
+  }
+  return true;
+}
+
+void SimdHttpRequestParser::CreateRequestConstructor() {
+  UASSERT(!request_constructor_);
+  ++stats_.parsing_request_count;
+  request_constructor_.emplace(request_constructor_config_, handler_info_index_,
+                               data_accounter_);
+}
+
+bool SimdHttpRequestParser::FinalizeRequest() {
+  if (!request_constructor_) CreateRequestConstructor();
+  const bool res = FinalizeRequestImpl();
+  --stats_.parsing_request_count;
+  request_constructor_.reset();
+  state_ = State::kHead;
+  return res;
+}
+
+bool SimdHttpRequestParser::CompleteRequest() {
+  if (request_constructor_ && request_constructor_->IsFinalized()) {
+    request_constructor_->FinishBody();
+  }
+  return FinalizeRequest();
+}
+
+bool SimdHttpRequestParser::FinalizeRequestImpl() {
+  // The request with the streamed body is already passed on, the body that is
+  // cut short is reported by the RequestBodyStream
+  if (request_constructor_->IsFinalized()) return true;
+  if (auto request = request_constructor_->Finalize()) {
+    on_new_request_cb_(std::move(request));
+  } else {
+    LOG_ERROR() << "request is null after Finalize()";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
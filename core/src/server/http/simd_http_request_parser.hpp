@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <server/net/recv_buffer.hpp>
+#include <server/net/stats.hpp>
+#include <server/request/request_parser.hpp>
+
+#include <userver/server/request/request_config.hpp>
+
+#include "http_request_constructor.hpp"
+#include "request_head_parser.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// @brief HTTP/1.x request parser that scans the whole request head at once
+///
+/// Unlike HttpRequestParser, it does not go through the http_parser callbacks
+/// byte by byte: the delimiters of the head are found with SSE4.2 if the CPU
+/// supports it (see impl::ParseRequestHead), the header fields are passed to
+/// HttpRequestConstructor whole. The head that is split across receives is
+/// buffered until it is complete.
+class SimdHttpRequestParser final : public request::RequestParser {
+ public:
+  using OnNewRequestCb =
+      std::function<void(std::shared_ptr<request::RequestBase>&&)>;
+
+  SimdHttpRequestParser(const HandlerInfoIndex& handler_info_index,
+                        const request::HttpRequestConfig& request_config,
+                        OnNewRequestCb&& on_new_request_cb,
+                        net::ParserStats& stats,
+                        request::ResponseDataAccounter& data_accounter);
+
+  SimdHttpRequestParser(SimdHttpRequestParser&&) = delete;
+  SimdHttpRequestParser& operator=(SimdHttpRequestParser&&) = delete;
+  ~SimdHttpRequestParser() override;
+
+  bool Parse(const char* data, size_t size) override;
+  bool Parse(const net::RecvBufferPtr& buffer, size_t size) override;
+
+ private:
+  enum class State { kHead, kBody, kChunkedBody };
+
+  bool ParseImpl(std::string_view data, const net::RecvBufferPtr* buffer);
+  bool ParseHead(std::string_view& data);
+  bool OnHead();
+  bool AppendBody(std::string_view data, const net::RecvBufferPtr* buffer);
+
+  void CreateRequestConstructor();
+  // Finishes the request that is received in full
+  bool CompleteRequest();
+  bool FinalizeRequest();
+  bool FinalizeRequestImpl();
+
+  const HandlerInfoIndex& handler_info_index_;
+  const HttpRequestConstructor::Config request_constructor_config_;
+
+  OnNewRequestCb on_new_request_cb_;
+
+  State state_{State::kHead};
+  // The beginning of the head that did not fit into the previous receives
+  std::string pending_head_;
+  impl::RequestHead head_;
+  std::uint64_t body_left_{0};
+  impl::ChunkedBodyDecoder chunked_body_decoder_;
+  std::optional<HttpRequestConstructor> request_constructor_;
+
+  net::ParserStats& stats_;
+  request::ResponseDataAccounter& data_accounter_;
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,139 @@
+#include <userver/utest/utest.hpp>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/server/http/http_request.hpp>
+
+#include <server/http/http_request_impl.hpp>
+#include <server/http/simd_http_request_parser.hpp>
+
+#include "create_parser_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using RequestPtr = std::shared_ptr<server::request::RequestBase>;
+
+const std::vector<std::string> kRequests = {
+    "GET / HTTP/1.1\r\n\r\n",
+    "GET /path?arg=value&other=%20x HTTP/1.1\r\n"
+    "Host: localhost:8080\r\n"
+    "User-Agent: curl/7.81.0\r\n"
+    "Accept: */*\r\n"
+    "Cookie: a=b; c=d\r\n"
+    "\r\n",
+    "\r\nPOST /body HTTP/1.0\r\n"
+    "Connection: keep-alive\r\n"
+    "X-Header:  value with spaces \t\r\n"
+    "Content-Length: 11\r\n"
+    "\r\n"
+    "hello world",
+    "PUT /chunked HTTP/1.1\r\n"
+    "Transfer-Encoding: chunked\r\n"
+    "Connection: close\r\n"
+    "\r\n"
+    "5\r\nhello\r\n"
+    "6;ext=1\r\n world\r\n"
+    "0\r\n"
+    "\r\n",
+    "DELETE /x HTTP/1.1\n"
+    "Empty:\n"
+    "\n",
+};
+
+// Describes everything the handlers get from the request
+std::string Describe(const RequestPtr& request) {
+  auto& http_request_impl =
+      dynamic_cast<server::http::HttpRequestImpl&>(*request);
+  const server::http::HttpRequest http_request(http_request_impl);
+
+  std::vector<std::string> headers;
+  for (const auto& name : http_request.GetHeaderNames()) {
+    headers.push_back(
+        fmt::format("{}: {}", name, http_request.GetHeader(name)));
+  }
+  std::sort(headers.begin(), headers.end());
+
+  return fmt::format(
+      "{} {} HTTP/{}.{} final={} {} status={}\n{}\n\n{}",
+      http_request.GetMethodStr(), http_request.GetUrl(),
+      http_request.GetHttpMajor(), http_request.GetHttpMinor(),
+      request->IsFinal(), http_request.GetArg("arg"),
+      static_cast<int>(http_request.GetHttpResponse().GetStatus()),
+      fmt::join(headers, "\n"), http_request.RequestBody());
+}
+
+struct ParseResult {
+  std::vector<std::string> requests;
+  bool ok{true};
+};
+
+// Splits the data into two receives at `split`
+template <typename Parser>
+ParseResult Parse(const std::string& data, std::size_t split) {
+  ParseResult result;
+  auto parser = server::CreateTestParser<Parser>(
+      [&result](RequestPtr&& request) {
+        result.requests.push_back(Describe(request));
+      });
+
+  const std::string_view view{data};
+  for (const auto piece : {view.substr(0, split), view.substr(split)}) {
+    if (!piece.empty() && result.ok) {
+      result.ok = parser.Parse(piece.data(), piece.size());
+    }
+  }
+  return result;
+}
+
+void ExpectSameAsHttpParser(const std::string& data) {
+  for (std::size_t split = 0; split <= data.size(); ++split) {
+    const auto expected = Parse<server::http::HttpRequestParser>(data, split);
+    const auto result =
+        Parse<server::http::SimdHttpRequestParser>(data, split);
+    ASSERT_EQ(result.ok, expected.ok) << data << "split=" << split;
+    ASSERT_EQ(result.requests, expected.requests)
+        << data << "split=" << split;
+  }
+}
+
+}  // namespace
+
+UTEST(SimdHttpRequestParser, SameAsHttpParser) {
+  for (const auto& request : kRequests) ExpectSameAsHttpParser(request);
+}
+
+UTEST(SimdHttpRequestParser, Pipelined) {
+  std::string data;
+  for (const auto& request : kRequests) {
+    if (request.find("close") == std::string::npos) data += request;
+  }
+
+  ExpectSameAsHttpParser(data);
+  EXPECT_EQ(
+      Parse<server::http::SimdHttpRequestParser>(data, 0).requests.size(),
+      kRequests.size() - 1);
+}
+
+UTEST(SimdHttpRequestParser, Malformed) {
+  for (const std::string data : {
+           "GET / HTTP/1.1\r\nName : value\r\n\r\n",
+           "GET / HTTP/1.1\r\nContent-Length: x\r\n\r\n",
+           "GET / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 2\r\n\r\n",
+           "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\nxyz\r\n",
+           "GET / HTTP/1.1\r\nConnection: upgrade\r\nUpgrade: h2c\r\n\r\n",
+       }) {
+    const auto result =
+        Parse<server::http::SimdHttpRequestParser>(data, data.size());
+    EXPECT_FALSE(result.ok) << data;
+    EXPECT_EQ(result.requests.size(), 1) << data;
+  }
+}
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #include <server/http/wildcard_path_index.hpp>
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <boost/algorithm/string/split.hpp>
@@ -9,7 +10,7 @@ USERVER_NAMESPACE_BEGIN
 namespace server::http::impl {
 namespace {
 
-const std::string kAnySuffixMark{"*"};
+constexpr std::string_view kAnySuffixMark{"*"};
 
 constexpr char kWildcardStart = '{';
 constexpr char kWildcardFinish = '}';
@@ -20,6 +21,19 @@ std::vector<std::string> SplitBySlash(const std::string& path) {
   return path_vec;
 }
 
+// The same as SplitBySlash() without copying the segments, for the requests
+std::vector<std::string_view> SplitViewBySlash(std::string_view path) {
+  std::vector<std::string_view> path_vec;
+  path_vec.reserve(std::count(path.begin(), path.end(), '/') + 1);
+  while (true) {
+    const auto pos = path.find('/');
+    path_vec.push_back(path.substr(0, pos));
+    if (pos == std::string_view::npos) break;
+    path.remove_prefix(pos + 1);
+  }
+  return path_vec;
+}
+
 std::string ExtractWildcardName(const std::string& str) {
   if (str.empty() || str.front() != kWildcardStart ||
       str.back() != kWildcardFinish) {
@@ -31,7 +45,7 @@ std::string ExtractWildcardName(const std::string& str) {
 
 bool GetFromHandlerMethodIndex(const WildcardPathIndex::Node& node,
                                HttpMethod method,
-                               const std::vector<std::string>& path,
+                               const std::vector<std::string_view>& path,
                                MatchRequestResult& match_result,
                                bool limit_path_length) {
   const auto& index_map = node.handler_method_index_map;
@@ -60,7 +74,8 @@ bool GetFromHandlerMethodIndex(const WildcardPathIndex::Node& node,
           "matched path from handler has length greater than path from "
           "request");
     match_result.args_from_path.emplace_back(
-        arg.name, arg.index == path.size() ? std::string{} : path[arg.index]);
+        arg.name, arg.index == path.size() ? std::string_view{}
+                                           : path[arg.index]);
   }
   match_result.status = MatchRequestResult::Status::kOk;
   return true;
@@ -108,7 +123,7 @@ void WildcardPathIndex::AddHandler(const handlers::HttpHandlerBase& handler,
 
 bool WildcardPathIndex::MatchRequest(HttpMethod method, const std::string& path,
                                      MatchRequestResult& match_result) const {
-  return MatchRequest(root_, method, SplitBySlash(path), path.size(),
+  return MatchRequest(root_, method, SplitViewBySlash(path), path.size(),
                       match_result);
 }
 
@@ -151,7 +166,7 @@ void WildcardPathIndex::AddPath(const handlers::HttpHandlerBase& handler,
 }
 
 bool WildcardPathIndex::MatchRequest(const Node& node, HttpMethod method,
-                                     const std::vector<std::string>& path,
+                                     const std::vector<std::string_view>& path,
                                      size_t path_string_length,
                                      MatchRequestResult& match_result) const {
   for (const auto& next_item : node.next) {
@@ -184,7 +199,8 @@ bool WildcardPathIndex::MatchRequest(const Node& node, HttpMethod method,
           match_result.matched_path_length += path[i].size();
         }
         for (size_t i = asterisk_pos; i < path.size(); i++) {
-          match_result.args_from_path.emplace_back(std::string{}, path[i]);
+          match_result.args_from_path.emplace_back(std::string{},
+                                                   std::string{path[i]});
         }
         return true;
       }
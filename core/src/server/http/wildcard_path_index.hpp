@@ -2,6 +2,7 @@
 
 #include <map>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 
@@ -22,7 +23,7 @@ class WildcardPathIndex final {
  public:
   struct Node {
     // ordered by position in path
-    std::map<size_t, std::map<std::string, Node>> next;
+    std::map<size_t, std::map<std::string, Node, std::less<>>> next;
 
     // by path length
     std::map<size_t, HandlerMethodIndex> handler_method_index_map;
@@ -45,7 +46,7 @@ class WildcardPathIndex final {
                std::vector<PathItem> wildcards);
 
   bool MatchRequest(const Node& node, HttpMethod method,
-                    const std::vector<std::string>& path,
+                    const std::vector<std::string_view>& path,
                     size_t path_string_length,
                     MatchRequestResult& match_result) const;
 
@@ -2,12 +2,15 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <stdexcept>
 #include <system_error>
 #include <vector>
 
 #include <server/http/http_request_parser.hpp>
 #include <server/http/request_handler_base.hpp>
+#include <server/http/simd_http_request_parser.hpp>
+#include <server/net/recv_buffer.hpp>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/exception.hpp>
@@ -15,6 +18,7 @@
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/server/http/http_response.hpp>
 #include <userver/server/request/request_config.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/scope_guard.hpp>
@@ -23,16 +27,44 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+namespace {
+
+constexpr std::size_t kMaxCoalescedResponses = 64;
+
+// Returns false if the response should be marked as failed
+template <typename Func>
+bool TrySend(Func&& func) {
+  try {
+    func();
+  } catch (const engine::io::IoSystemError& ex) {
+    // working with raw values because std::errc compares error_category
+    // default_error_category() fixed only in GCC 9.1 (PR libstdc++/60555)
+    auto log_level =
+        ex.Code().value() == static_cast<int>(std::errc::broken_pipe)
+            ? logging::Level::kWarning
+            : logging::Level::kError;
+    LOG(log_level) << "I/O error while sending data: " << ex;
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Error while sending data: " << ex;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
 std::shared_ptr<Connection> Connection::Create(
     engine::TaskProcessor& task_processor, const ConnectionConfig& config,
     const request::HttpRequestConfig& handler_defaults_config,
     engine::io::Socket peer_socket,
     const http::RequestHandlerBase& request_handler,
     std::shared_ptr<Stats> stats,
+    std::shared_ptr<ConnectionHistograms> histograms,
     request::ResponseDataAccounter& data_accounter) {
   return std::make_shared<Connection>(
       task_processor, config, handler_defaults_config, std::move(peer_socket),
-      request_handler, std::move(stats), data_accounter, EmplaceEnabler{});
+      request_handler, std::move(stats), std::move(histograms), data_accounter,
+      EmplaceEnabler{});
 }
 
 Connection::Connection(
@@ -41,6 +73,7 @@ Connection::Connection(
     engine::io::Socket peer_socket,
     const http::RequestHandlerBase& request_handler,
     std::shared_ptr<Stats> stats,
+    std::shared_ptr<ConnectionHistograms> histograms,
     request::ResponseDataAccounter& data_accounter, EmplaceEnabler)
     : task_processor_(task_processor),
       config_(config),
@@ -48,6 +81,7 @@ Connection::Connection(
       peer_socket_(std::move(peer_socket)),
       request_handler_(request_handler),
       stats_(std::move(stats)),
+      histograms_(std::move(histograms)),
       data_accounter_(data_accounter),
       remote_address_(peer_socket_.Getpeername().PrimaryAddressString()),
       request_tasks_(Queue::Create()) {
@@ -114,6 +148,8 @@ void Connection::Shutdown() noexcept {
 
   --stats_->active_connections;
   ++stats_->connections_closed;
+  histograms_->requests_per_connection.GetCurrentCounter().Account(
+      requests_count_);
 
   if (close_cb_) close_cb_();  // should not throw
 
@@ -128,6 +164,23 @@ bool Connection::IsRequestTasksEmpty() const noexcept {
   return request_tasks_->GetSizeApproximate() == 0;
 }
 
+std::unique_ptr<request::RequestParser> Connection::CreateRequestParser(
+    std::function<void(std::shared_ptr<request::RequestBase>&&)>&&
+        on_new_request) {
+  switch (config_.request_parser) {
+    case RequestParserType::kHttpParser:
+      return std::make_unique<http::HttpRequestParser>(
+          request_handler_.GetHandlerInfoIndex(), handler_defaults_config_,
+          std::move(on_new_request), stats_->parser_stats, data_accounter_);
+    case RequestParserType::kSimd:
+      return std::make_unique<http::SimdHttpRequestParser>(
+          request_handler_.GetHandlerInfoIndex(), handler_defaults_config_,
+          std::move(on_new_request), stats_->parser_stats, data_accounter_);
+  }
+
+  UINVARIANT(false, "Unexpected request parser type");
+}
+
 void Connection::ListenForRequests(Queue::Producer producer) noexcept {
   using RequestBasePtr = std::shared_ptr<request::RequestBase>;
 
@@ -142,20 +195,30 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
   try {
     request_tasks_->SetSoftMaxSize(config_.requests_queue_size_threshold);
 
-    http::HttpRequestParser request_parser(
-        request_handler_.GetHandlerInfoIndex(), handler_defaults_config_,
+    const auto on_new_request =
         [this, &producer](RequestBasePtr&& request_ptr) {
           if (!NewRequest(std::move(request_ptr), producer)) {
             is_accepting_requests_ = false;
           }
-        },
-        stats_->parser_stats, data_accounter_);
+        };
+    const auto request_parser = CreateRequestParser(on_new_request);
 
-    std::vector<char> buf(config_.in_buffer_size);
+    auto buf = std::make_shared<RecvBuffer>(config_.in_buffer_size);
     std::size_t last_bytes_read = 0;
+    // HTTP/2 is detected by the client preface, no upgrade from HTTP/1.1
+    bool is_protocol_detected = !config_.http2_enabled;
     while (is_accepting_requests_) {
       auto deadline = engine::Deadline::FromDuration(config_.keepalive_timeout);
 
+      // Requests with big bodies refer to the buffer instead of copying it,
+      // we may reuse it only when they are done with it
+      if (buf.use_count() != 1) {
+        buf = std::make_shared<RecvBuffer>(config_.in_buffer_size);
+      } else {
+        // Pairs with the release of the shared_ptr by the request
+        std::atomic_thread_fence(std::memory_order_acquire);
+      }
+
       bool is_readable = true;
       // If we didn't fill the buffer in the previous loop iteration we almost
       // certainly will hit EWOULDBLOCK on the subsequent recv syscall from
@@ -167,13 +230,19 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
       // 3. recv (return some data)
       //
       // So instead we just do 2. and 3., shaving off a whole recv syscall
-      if (last_bytes_read != buf.size()) {
+      if (last_bytes_read != buf->size()) {
+        const auto wait_start = std::chrono::steady_clock::now();
         is_readable = peer_socket_.WaitReadable(deadline);
+        histograms_->wait_readable_ms.GetCurrentCounter().Account(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - wait_start)
+                .count());
       }
 
       last_bytes_read =
-          is_readable ? peer_socket_.RecvSome(buf.data(), buf.size(), deadline)
-                      : 0;
+          is_readable
+              ? peer_socket_.RecvSome(buf->data(), buf->size(), deadline)
+              : 0;
       if (!last_bytes_read) {
         LOG_TRACE() << "Peer " << peer_socket_.Getpeername() << " on fd "
                     << Fd() << " closed connection or the connection timed out";
@@ -187,10 +256,26 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
         // processing and pending requests.
         return;
       }
+      histograms_->bytes_per_read.GetCurrentCounter().Account(last_bytes_read);
       LOG_TRACE() << "Received " << last_bytes_read << " byte(s) from "
                   << peer_socket_.Getpeername() << " on fd " << Fd();
 
-      if (!request_parser.Parse(buf.data(), last_bytes_read)) {
+      if (!is_protocol_detected) {
+        is_protocol_detected = true;
+        if (http::Http2Session::IsPreface({buf->data(), last_bytes_read})) {
+          LOG_TRACE() << "HTTP/2 connection preface on fd " << Fd();
+          http2_session_ = std::make_unique<http::Http2Session>(
+              config_, request_handler_.GetHandlerInfoIndex(),
+              handler_defaults_config_, on_new_request, stats_->parser_stats,
+              data_accounter_, peer_socket_);
+        }
+      }
+
+      const bool is_parsed =
+          http2_session_
+              ? http2_session_->Parse(buf->data(), last_bytes_read)
+              : request_parser->Parse(buf, last_bytes_read);
+      if (!is_parsed) {
         LOG_DEBUG() << "Malformed request from " << peer_socket_.Getpeername()
                     << " on fd " << Fd();
 
@@ -238,6 +323,9 @@ bool Connection::NewRequest(std::shared_ptr<request::RequestBase>&& request_ptr,
   }
 
   ++stats_->active_request_count;
+  ++requests_count_;
+  histograms_->pipelining_depth.GetCurrentCounter().Account(
+      request_tasks_->GetSizeApproximate() + 1);
   return producer.Push(
       {request_ptr, request_handler_.StartRequestTask(request_ptr)});
 }
@@ -245,24 +333,54 @@ bool Connection::NewRequest(std::shared_ptr<request::RequestBase>&& request_ptr,
 void Connection::ProcessResponses(Queue::Consumer& consumer) noexcept {
   try {
     QueueItem item;
-    while (consumer.Pop(item)) {
+    bool has_item = consumer.Pop(item);
+    while (has_item) {
       HandleQueueItem(item);
+      has_item = false;
+
+      {
+        // now we must complete processing
+        engine::TaskCancellationBlocker block_cancel;
+
+        // Responses to the pipelined requests that are already handled are
+        // sent with a single writev
+        std::vector<QueueItem> items;
+        items.push_back(std::move(item));
+        while (items.size() < kMaxCoalescedResponses &&
+               CanCoalesceResponse(items.back()) &&
+               consumer.PopNoblock(item)) {
+          if (!CanCoalesceResponse(item) ||
+              engine::current_task::IsCancelRequested()) {
+            has_item = true;
+            break;
+          }
+          HandleQueueItem(item);
+          items.push_back(std::move(item));
+        }
+
+        /* In stream case we don't want a user task to exit
+         * until SendResponse() as the task produces body chunks.
+         */
+        SendResponses(items);
+      }
 
-      // now we must complete processing
-      engine::TaskCancellationBlocker block_cancel;
-
-      /* In stream case we don't want a user task to exit
-       * until SendResponse() as the task produces body chunks.
-       */
-      SendResponse(*item.first);
-      item.first.reset();
-      item.second = {};
+      if (!has_item) has_item = consumer.Pop(item);
     }
   } catch (const std::exception& e) {
     LOG_ERROR() << "Exception for fd " << Fd() << ": " << e;
   }
 }
 
+bool Connection::CanCoalesceResponse(const QueueItem& item) const {
+  if (http2_session_ || !is_response_chain_valid_) return false;
+
+  // The response is not touched until the handler task is finished. The task
+  // is left in the handled item only for the streamed response.
+  if (item.second.IsValid() && !item.second.IsFinished()) return false;
+  const auto& response = item.first->GetResponse();
+  return !response.IsBodyStreamed() || !response.GetData().empty();
+}
+
 void Connection::HandleQueueItem(QueueItem& item) {
   auto& request = *item.first;
 
@@ -300,29 +418,69 @@ void Connection::HandleQueueItem(QueueItem& item) {
   }
 }
 
-void Connection::SendResponse(request::RequestBase& request) {
+void Connection::SendResponses(std::vector<QueueItem>& items) {
+  if (items.size() == 1) {
+    SendResponse(items.front().first);
+    items.clear();
+    return;
+  }
+
+  std::vector<http::HttpResponse*> responses;
+  responses.reserve(items.size());
+  for (auto& [request_ptr, task] : items) {
+    auto& response = request_ptr->GetResponse();
+    UASSERT(!response.IsSent());
+    UASSERT(dynamic_cast<http::HttpResponse*>(&response));
+    request_ptr->SetStartSendResponseTime();
+    responses.push_back(static_cast<http::HttpResponse*>(&response));
+  }
+
+  if (peer_socket_) {
+    const auto start = std::chrono::steady_clock::now();
+    const bool is_sent = TrySend([&] {
+      http::HttpResponse::SendResponses(peer_socket_, responses);
+    });
+    AccountSendResponse(start, responses.size());
+    if (!is_sent) {
+      for (auto* response : responses) {
+        response->SetSendFailed(std::chrono::steady_clock::now());
+      }
+    }
+  } else {
+    for (auto* response : responses) {
+      response->SetSendFailed(std::chrono::steady_clock::now());
+    }
+  }
+
+  for (auto& item : items) FinishSendResponse(*item.first);
+  items.clear();
+}
+
+void Connection::SendResponse(
+    const std::shared_ptr<request::RequestBase>& request_ptr) {
+  auto& request = *request_ptr;
   auto& response = request.GetResponse();
   UASSERT(!response.IsSent());
   request.SetStartSendResponseTime();
   if (is_response_chain_valid_ && peer_socket_) {
-    try {
+    const auto start = std::chrono::steady_clock::now();
+    const bool is_sent = TrySend([&] {
       // Might be a stream reading or a fully constructed response
-      response.SendResponse(peer_socket_);
-    } catch (const engine::io::IoSystemError& ex) {
-      // working with raw values because std::errc compares error_category
-      // default_error_category() fixed only in GCC 9.1 (PR libstdc++/60555)
-      auto log_level =
-          ex.Code().value() == static_cast<int>(std::errc::broken_pipe)
-              ? logging::Level::kWarning
-              : logging::Level::kError;
-      LOG(log_level) << "I/O error while sending data: " << ex;
-    } catch (const std::exception& ex) {
-      LOG_ERROR() << "Error while sending data: " << ex;
-      response.SetSendFailed(std::chrono::steady_clock::now());
-    }
+      if (http2_session_) {
+        http2_session_->SendResponse(request_ptr);
+      } else {
+        response.SendResponse(peer_socket_);
+      }
+    });
+    AccountSendResponse(start, 1);
+    if (!is_sent) response.SetSendFailed(std::chrono::steady_clock::now());
   } else {
     response.SetSendFailed(std::chrono::steady_clock::now());
   }
+  FinishSendResponse(request);
+}
+
+void Connection::FinishSendResponse(request::RequestBase& request) {
   request.SetFinishSendResponseTime();
   --stats_->active_request_count;
   ++stats_->requests_processed_count;
@@ -331,6 +489,16 @@ void Connection::SendResponse(request::RequestBase& request) {
                           request_handler_.LoggerAccessTskv(), remote_address_);
 }
 
+void Connection::AccountSendResponse(
+    std::chrono::steady_clock::time_point start, std::size_t responses_count) {
+  const auto send_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+  // The coalesced responses are sent together, each of them waits for all
+  auto& counter = histograms_->send_response_us.GetCurrentCounter();
+  for (std::size_t i = 0; i < responses_count; ++i) counter.Account(send_us);
+}
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
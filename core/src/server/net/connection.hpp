@@ -1,9 +1,12 @@
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include <server/http/http2_session.hpp>
 #include <server/http/request_handler_base.hpp>
 #include <server/net/connection_config.hpp>
 #include <server/net/stats.hpp>
@@ -36,6 +39,7 @@ class Connection final : public std::enable_shared_from_this<Connection> {
       engine::io::Socket peer_socket,
       const http::RequestHandlerBase& request_handler,
       std::shared_ptr<Stats> stats,
+      std::shared_ptr<ConnectionHistograms> histograms,
       request::ResponseDataAccounter& data_accounter);
 
   // Use Create instead of this constructor
@@ -45,6 +49,7 @@ class Connection final : public std::enable_shared_from_this<Connection> {
              engine::io::Socket peer_socket,
              const http::RequestHandlerBase& request_handler,
              std::shared_ptr<Stats> stats,
+             std::shared_ptr<ConnectionHistograms> histograms,
              request::ResponseDataAccounter& data_accounter, EmplaceEnabler);
 
   void SetCloseCb(CloseCb close_cb);
@@ -64,13 +69,21 @@ class Connection final : public std::enable_shared_from_this<Connection> {
 
   bool IsRequestTasksEmpty() const noexcept;
 
+  std::unique_ptr<request::RequestParser> CreateRequestParser(
+      std::function<void(std::shared_ptr<request::RequestBase>&&)>&&
+          on_new_request);
   void ListenForRequests(Queue::Producer) noexcept;
   bool NewRequest(std::shared_ptr<request::RequestBase>&& request_ptr,
                   Queue::Producer&);
 
   void ProcessResponses(Queue::Consumer&) noexcept;
+  bool CanCoalesceResponse(const QueueItem& item) const;
   void HandleQueueItem(QueueItem& item);
-  void SendResponse(request::RequestBase& request);
+  void SendResponses(std::vector<QueueItem>& items);
+  void SendResponse(const std::shared_ptr<request::RequestBase>& request_ptr);
+  void FinishSendResponse(request::RequestBase& request);
+  void AccountSendResponse(std::chrono::steady_clock::time_point start,
+                           std::size_t responses_count);
 
   engine::TaskProcessor& task_processor_;
   const ConnectionConfig& config_;
@@ -78,6 +91,7 @@ class Connection final : public std::enable_shared_from_this<Connection> {
   engine::io::Socket peer_socket_;
   const http::RequestHandlerBase& request_handler_;
   const std::shared_ptr<Stats> stats_;
+  const std::shared_ptr<ConnectionHistograms> histograms_;
   request::ResponseDataAccounter& data_accounter_;
   const std::string remote_address_;
 
@@ -86,6 +100,11 @@ class Connection final : public std::enable_shared_from_this<Connection> {
   engine::SingleConsumerEvent response_sender_assigned_event_;
   engine::Task response_sender_task_;
 
+  // Set by ListenForRequests() before the first request of an HTTP/2
+  // connection, is used by both tasks
+  std::unique_ptr<http::Http2Session> http2_session_;
+
+  std::size_t requests_count_{0};
   bool is_accepting_requests_{true};
   bool is_response_chain_valid_{true};
   CloseCb close_cb_;
@@ -1,11 +1,29 @@
 #include <server/net/connection_config.hpp>
 
+#include <stdexcept>
+
+#include <fmt/format.h>
+
 #include <userver/yaml_config/yaml_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+RequestParserType Parse(const yaml_config::YamlConfig& value,
+                        formats::parse::To<RequestParserType>) {
+  const auto str = value.As<std::string>();
+  if (str == "http-parser") {
+    return RequestParserType::kHttpParser;
+  } else if (str == "simd") {
+    return RequestParserType::kSimd;
+  }
+
+  throw std::logic_error(fmt::format(
+      "Invalid RequestParserType value '{}' at path '{}'", str,
+      value.GetPath()));
+}
+
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ConnectionConfig>) {
   ConnectionConfig config;
@@ -18,6 +36,19 @@ ConnectionConfig Parse(const yaml_config::YamlConfig& value,
   config.keepalive_timeout =
       value["keepalive_timeout"].As<std::chrono::seconds>(
           config.keepalive_timeout);
+  config.request_parser =
+      value["request_parser"].As<RequestParserType>(config.request_parser);
+  config.http2_enabled =
+      value["http2_enabled"].As<bool>(config.http2_enabled);
+  config.http2_max_concurrent_streams =
+      value["http2_max_concurrent_streams"].As<size_t>(
+          config.http2_max_concurrent_streams);
+  config.http2_header_table_size =
+      value["http2_header_table_size"].As<size_t>(
+          config.http2_header_table_size);
+  config.http2_initial_window_size =
+      value["http2_initial_window_size"].As<size_t>(
+          config.http2_initial_window_size);
 
   return config;
 }
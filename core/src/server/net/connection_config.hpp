@@ -9,12 +9,26 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+enum class RequestParserType {
+  kHttpParser,  ///< http::HttpRequestParser
+  kSimd,        ///< http::SimdHttpRequestParser
+};
+
 struct ConnectionConfig {
   size_t in_buffer_size = 32 * 1024;
   size_t requests_queue_size_threshold = 100;
   std::chrono::seconds keepalive_timeout{10 * 60};
+  RequestParserType request_parser = RequestParserType::kHttpParser;
+
+  bool http2_enabled = false;
+  size_t http2_max_concurrent_streams = 100;
+  size_t http2_header_table_size = 4096;
+  size_t http2_initial_window_size = 64 * 1024 - 1;
 };
 
+RequestParserType Parse(const yaml_config::YamlConfig& value,
+                        formats::parse::To<RequestParserType>);
+
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ConnectionConfig>);
 
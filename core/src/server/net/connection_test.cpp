@@ -1,5 +1,7 @@
 #include <server/net/connection.hpp>
 
+#include <vector>
+
 #include <fmt/format.h>
 
 #include <server/handlers/http_handler_base_statistics.hpp>
@@ -9,6 +11,7 @@
 #include <userver/clients/http/client.hpp>
 #include <userver/engine/io/sockaddr.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/internal/net/net_listener.hpp>
 
 #include <userver/utest/http_client.hpp>
 #include <userver/utest/utest.hpp>
@@ -111,12 +114,14 @@ UTEST(ServerNetConnection, EarlyCancel) {
   auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
   ASSERT_TRUE(peer.IsValid());
   auto stats = std::make_shared<net::Stats>();
+  auto histograms = std::make_shared<net::ConnectionHistograms>();
   server::request::ResponseDataAccounter data_accounter;
   TestHttprequestHandler handler;
 
   auto connection_ptr = net::Connection::Create(
       engine::current_task::GetTaskProcessor(), config.connection_config,
-      config.handler_defaults, std::move(peer), handler, stats, data_accounter);
+      config.handler_defaults, std::move(peer), handler, stats, histograms,
+      data_accounter);
 
   connection_ptr->Start();
   // Immediately canceling the `socket_listener_` task without giving it
@@ -149,6 +154,7 @@ UTEST(ServerNetConnection, EarlyTimeout) {
       request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
   ASSERT_TRUE(peer.IsValid());
   auto stats = std::make_shared<net::Stats>();
+  auto histograms = std::make_shared<net::ConnectionHistograms>();
   server::request::ResponseDataAccounter data_accounter;
   TestHttprequestHandler handler;
 
@@ -156,7 +162,8 @@ UTEST(ServerNetConnection, EarlyTimeout) {
 
   auto connection_ptr = net::Connection::Create(
       engine::current_task::GetTaskProcessor(), config.connection_config,
-      config.handler_defaults, std::move(peer), handler, stats, data_accounter);
+      config.handler_defaults, std::move(peer), handler, stats, histograms,
+      data_accounter);
 
   connection_ptr->Start();
   std::weak_ptr<net::Connection> weak = connection_ptr;
@@ -182,12 +189,14 @@ UTEST(ServerNetConnection, TimeoutWithTaskCancellation) {
       request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
   ASSERT_TRUE(peer.IsValid());
   auto stats = std::make_shared<net::Stats>();
+  auto histograms = std::make_shared<net::ConnectionHistograms>();
   server::request::ResponseDataAccounter data_accounter;
   TestHttprequestHandler handler{TestHttprequestHandler::Behaviors::kHang};
 
   auto connection_ptr = net::Connection::Create(
       engine::current_task::GetTaskProcessor(), config.connection_config,
-      config.handler_defaults, std::move(peer), handler, stats, data_accounter);
+      config.handler_defaults, std::move(peer), handler, stats, histograms,
+      data_accounter);
 
   connection_ptr->Start();
   std::weak_ptr<net::Connection> weak = connection_ptr;
@@ -232,12 +241,14 @@ UTEST(ServerNetConnection, RemoteClosed) {
   auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
   ASSERT_TRUE(peer.IsValid());
   auto stats = std::make_shared<net::Stats>();
+  auto histograms = std::make_shared<net::ConnectionHistograms>();
   server::request::ResponseDataAccounter data_accounter;
   TestHttprequestHandler handler;
 
   auto connection_ptr = net::Connection::Create(
       engine::current_task::GetTaskProcessor(), config.connection_config,
-      config.handler_defaults, std::move(peer), handler, stats, data_accounter);
+      config.handler_defaults, std::move(peer), handler, stats, histograms,
+      data_accounter);
 
   connection_ptr->Start();
   std::weak_ptr<net::Connection> weak = connection_ptr;
@@ -265,12 +276,14 @@ UTEST(ServerNetConnection, KeepAlive) {
   auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
   ASSERT_TRUE(peer.IsValid());
   auto stats = std::make_shared<net::Stats>();
+  auto histograms = std::make_shared<net::ConnectionHistograms>();
   server::request::ResponseDataAccounter data_accounter;
   TestHttprequestHandler handler;
 
   auto connection_ptr = net::Connection::Create(
       engine::current_task::GetTaskProcessor(), config.connection_config,
-      config.handler_defaults, std::move(peer), handler, stats, data_accounter);
+      config.handler_defaults, std::move(peer), handler, stats, histograms,
+      data_accounter);
 
   connection_ptr->Start();
   EXPECT_EQ(request.Get()->status_code(), 404);
@@ -297,13 +310,14 @@ UTEST(ServerNetConnection, CancelMultipleInFlight) {
     auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
     ASSERT_TRUE(peer.IsValid());
     auto stats = std::make_shared<net::Stats>();
+    auto histograms = std::make_shared<net::ConnectionHistograms>();
     server::request::ResponseDataAccounter data_accounter;
     TestHttprequestHandler handler;
 
     auto connection_ptr = net::Connection::Create(
         engine::current_task::GetTaskProcessor(), config.connection_config,
         config.handler_defaults, std::move(peer), handler, stats,
-        data_accounter);
+        histograms, data_accounter);
 
     connection_ptr->Start();
     res.Wait();
@@ -339,4 +353,90 @@ UTEST(ServerNetConnection, CancelMultipleInFlight) {
   FAIL() << "Failed to simulate cancellation of multiple requests";
 }
 
+UTEST(ServerNetConnection, Pipelining) {
+  constexpr std::size_t kRequests = 10;
+  const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  net::ListenerConfig config = CreateConfig();
+
+  auto [peer, client] = internal::net::TcpListener{}.MakeSocketPair(deadline);
+  auto stats = std::make_shared<net::Stats>();
+  auto histograms = std::make_shared<net::ConnectionHistograms>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler;
+
+  auto connection_ptr = net::Connection::Create(
+      engine::current_task::GetTaskProcessor(), config.connection_config,
+      config.handler_defaults, std::move(peer), handler, stats, histograms,
+      data_accounter);
+  connection_ptr->Start();
+
+  std::string requests;
+  for (std::size_t i = 1; i < kRequests; ++i) {
+    requests += "GET / HTTP/1.1\r\n\r\n";
+  }
+  requests += "GET / HTTP/1.1\r\nConnection: close\r\n\r\n";
+  ASSERT_EQ(client.SendAll(requests.data(), requests.size(), deadline),
+            requests.size());
+
+  // The responses may be coalesced, but each one is sent exactly once and in
+  // order
+  std::vector<char> buffer(64 * 1024);
+  const auto size = client.RecvAll(buffer.data(), buffer.size(), deadline);
+  const std::string_view replies{buffer.data(), size};
+
+  std::size_t replies_count = 0;
+  for (auto pos = replies.find("HTTP/1.1 404"); pos != std::string_view::npos;
+       pos = replies.find("HTTP/1.1 404", pos + 1)) {
+    ++replies_count;
+  }
+  EXPECT_EQ(replies_count, kRequests);
+  EXPECT_NE(replies.rfind("Connection: close"), std::string_view::npos);
+  EXPECT_EQ(handler.asyncs_finished, kRequests);
+
+  EXPECT_EQ(histograms->pipelining_depth.GetCurrentCounter().Count(),
+            kRequests);
+  EXPECT_GT(histograms->bytes_per_read.GetCurrentCounter().Count(), 0);
+}
+
+UTEST(ServerNetConnection, Http2PriorKnowledge) {
+  constexpr std::size_t kRequests = 3;
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.http2_enabled = true;
+  auto request_socket = net::CreateSocket(config);
+
+  auto http_client_ptr = utest::CreateHttpClient();
+  http_client_ptr->SetMaxHostConnections(1);
+
+  std::vector<clients::http::ResponseFuture> requests;
+  for (std::size_t i = 0; i < kRequests; ++i) {
+    requests.push_back(
+        http_client_ptr->CreateRequest()
+            ->get(HttpConnectionUriFromSocket(request_socket))
+            ->http_version(clients::http::HttpVersion::k2PriorKnowledge)
+            ->retry(1)
+            ->timeout(utest::kMaxTestWaitTime)
+            ->async_perform());
+  }
+
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  auto histograms = std::make_shared<net::ConnectionHistograms>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler;
+
+  auto connection_ptr = net::Connection::Create(
+      engine::current_task::GetTaskProcessor(), config.connection_config,
+      config.handler_defaults, std::move(peer), handler, stats, histograms,
+      data_accounter);
+  connection_ptr->Start();
+
+  // All the streams are multiplexed over the single connection
+  for (auto& request : requests) {
+    EXPECT_EQ(request.Get()->status_code(), 404);
+  }
+  EXPECT_EQ(handler.asyncs_finished, kRequests);
+  EXPECT_EQ(stats->connections_created, 1);
+}
+
 USERVER_NAMESPACE_END
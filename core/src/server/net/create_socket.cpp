@@ -1,12 +1,17 @@
 #include "create_socket.hpp"
 
 #include <arpa/inet.h>
+#ifdef __linux__
+#include <linux/filter.h>
+#endif
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <array>
+#include <cerrno>
 #include <cstdint>
 #include <cstring>
 #include <stdexcept>
@@ -21,6 +26,8 @@
 #include <userver/engine/sleep.hpp>
 #include <userver/fs/blocking/read.hpp>
 #include <userver/fs/blocking/write.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -82,6 +89,34 @@ engine::io::Socket CreateSocket(const ListenerConfig& config) {
     return CreateUnixSocket(config.unix_socket_path, config.backlog);
 }
 
+void SetupCpuSteering(engine::io::Socket& socket, std::size_t sockets_count) {
+  UASSERT(sockets_count > 0);
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+  // The program returns the index of the socket in the group, the kernel
+  // falls back to the hash of the connection if there is no such socket.
+  std::array<sock_filter, 3> code{{
+      {BPF_LD | BPF_W | BPF_ABS, 0, 0,
+       static_cast<std::uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+      {BPF_ALU | BPF_MOD | BPF_K, 0, 0,
+       static_cast<std::uint32_t>(sockets_count)},
+      {BPF_RET | BPF_A, 0, 0, 0},
+  }};
+  sock_fprog program{static_cast<unsigned short>(code.size()), code.data()};
+
+  if (::setsockopt(socket.Fd(), SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF,
+                   &program, sizeof(program)) == -1) {
+    const auto error = errno;
+    LOG_WARNING() << "Failed to attach the CPU steering program to "
+                  << socket.Getsockname() << ": "
+                  << std::error_code{error, std::system_category()};
+  }
+#else
+  // MAC_COMPAT: no SO_REUSEPORT steering programs
+  LOG_WARNING() << "CPU steering of the connections to "
+                << socket.Getsockname() << " is not supported";
+#endif
+}
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
@@ -9,6 +9,12 @@ namespace server::net {
 
 engine::io::Socket CreateSocket(const ListenerConfig& config);
 
+/// Makes the kernel pass the new connections of the SO_REUSEPORT group of
+/// `sockets_count` sockets to the socket number `cpu % sockets_count`, where
+/// `cpu` is the CPU that processed the SYN. Logs the failures, as the
+/// connections are still accepted without the steering.
+void SetupCpuSteering(engine::io::Socket& socket, std::size_t sockets_count);
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,75 @@
+#include <server/net/create_socket.hpp>
+
+#include <netinet/in.h>
+
+#include <atomic>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/exception.hpp>
+#include <userver/engine/io/sockaddr.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kSocketsCount = 2;
+constexpr std::size_t kConnectionsCount = 16;
+
+engine::io::Sockaddr MakeLoopbackAddr(int port) {
+  engine::io::Sockaddr addr;
+  auto* sa = addr.As<struct sockaddr_in6>();
+  sa->sin6_family = AF_INET6;
+  sa->sin6_port = htons(port);
+  sa->sin6_addr = in6addr_loopback;
+  return addr;
+}
+
+}  // namespace
+
+UTEST_MT(CreateSocket, CpuSteering, kSocketsCount + 1) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  server::net::ListenerConfig config;
+  std::vector<engine::io::Socket> listen_sockets;
+  for (std::size_t i = 0; i < kSocketsCount; ++i) {
+    listen_sockets.push_back(server::net::CreateSocket(config));
+    // The rest of the sockets join the group of the first one
+    config.port = listen_sockets.front().Getsockname().Port();
+    UEXPECT_NO_THROW(
+        server::net::SetupCpuSteering(listen_sockets.back(), kSocketsCount));
+  }
+
+  std::atomic<std::size_t> accepted{0};
+  std::vector<engine::TaskWithResult<void>> acceptors;
+  for (auto& listen_socket : listen_sockets) {
+    acceptors.push_back(engine::AsyncNoSpan([&] {
+      while (accepted < kConnectionsCount) {
+        try {
+          auto peer_socket = listen_socket.Accept(deadline);
+          ++accepted;
+        } catch (const engine::io::IoCancelled&) {
+          return;
+        }
+      }
+    }));
+  }
+
+  std::vector<engine::io::Socket> clients;
+  for (std::size_t i = 0; i < kConnectionsCount; ++i) {
+    clients.emplace_back(engine::io::AddrDomain::kInet6,
+                         engine::io::SocketType::kStream);
+    clients.back().Connect(MakeLoopbackAddr(config.port), deadline);
+  }
+
+  while (accepted < kConnectionsCount && !deadline.IsReached()) {
+    engine::Yield();
+  }
+  EXPECT_EQ(accepted, kConnectionsCount);
+
+  for (auto& acceptor : acceptors) acceptor.SyncCancel();
+}
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 
 #include <server/http/http_request_handler.hpp>
 #include <server/net/connection.hpp>
@@ -18,8 +19,13 @@ struct EndpointInfo {
   const ListenerConfig& listener_config;
   http::HttpRequestHandler& request_handler;
   Connection::Type connection_type{Connection::Type::kRequest};
+  // Count of the listening SO_REUSEPORT sockets, one per net::Listener
+  size_t listeners_count{1};
 
   std::atomic<size_t> connection_count{0};
+  // Shared by the connections of all the net::Listener of the endpoint
+  std::shared_ptr<ConnectionHistograms> histograms{
+      std::make_shared<ConnectionHistograms>()};
 };
 
 }  // namespace server::net
@@ -22,9 +22,10 @@ Listener::~Listener() {
   LOG_TRACE() << "Destroyed listener";
 }
 
-void Listener::Start() {
+void Listener::Start(std::optional<engine::io::Socket> inherited_socket) {
   impl_ = std::make_unique<ListenerImpl>(*task_processor_, endpoint_info_,
-                                         *data_accounter_);
+                                         *data_accounter_,
+                                         std::move(inherited_socket));
 }
 
 Stats Listener::GetStats() const {
@@ -32,6 +33,10 @@ Stats Listener::GetStats() const {
   return Stats{};
 }
 
+int Listener::GetListeningFd() const {
+  return impl_ ? impl_->GetListeningFd() : -1;
+}
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include <userver/engine/task/task_processor_fwd.hpp>
 
@@ -24,10 +25,14 @@ class Listener final {
   Listener& operator=(const Listener&) = delete;
   Listener& operator=(Listener&&) = default;
 
-  void Start();
+  /// Listens on `inherited_socket` if it is set, on a new socket otherwise
+  void Start(std::optional<engine::io::Socket> inherited_socket = {});
 
   Stats GetStats() const;
 
+  /// Returns -1 if the listener is not started
+  int GetListeningFd() const;
+
  private:
   engine::TaskProcessor* task_processor_;
   std::shared_ptr<EndpointInfo> endpoint_info_;
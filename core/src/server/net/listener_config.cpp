@@ -21,6 +21,8 @@ ListenerConfig Parse(const yaml_config::YamlConfig& value,
   config.max_connections =
       value["max_connections"].As<size_t>(config.max_connections);
   config.shards = value["shards"].As<std::optional<size_t>>(config.shards);
+  config.cpu_steering =
+      value["cpu_steering"].As<bool>(config.cpu_steering);
   config.task_processor = value["task_processor"].As<std::string>();
   config.backlog = value["backlog"].As<int>(config.backlog);
 
@@ -32,6 +34,12 @@ ListenerConfig Parse(const yaml_config::YamlConfig& value,
     throw std::runtime_error(
         "Either non-zero 'port' or non-empty 'unix-socket' fields must be set");
 
+  if (config.cpu_steering && !config.unix_socket_path.empty()) {
+    throw std::runtime_error(
+        "'cpu_steering' is not supported for the 'unix-socket' in " +
+        value.GetPath());
+  }
+
   if (config.backlog <= 0) {
     throw std::runtime_error("Invalid backlog value in " + value.GetPath());
   }
@@ -22,31 +22,49 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+namespace {
+
+engine::io::Socket CreateListenerSocket(const EndpointInfo& endpoint_info) {
+  auto socket = CreateSocket(endpoint_info.listener_config);
+  if (endpoint_info.listener_config.cpu_steering) {
+    SetupCpuSteering(socket, endpoint_info.listeners_count);
+  }
+  return socket;
+}
+
+}  // namespace
+
 ListenerImpl::ListenerImpl(engine::TaskProcessor& task_processor,
                            std::shared_ptr<EndpointInfo> endpoint_info,
-                           request::ResponseDataAccounter& data_accounter)
+                           request::ResponseDataAccounter& data_accounter,
+                           std::optional<engine::io::Socket> inherited_socket)
     : task_processor_(task_processor),
       endpoint_info_(std::move(endpoint_info)),
       stats_(std::make_shared<Stats>()),
-      data_accounter_(data_accounter),
-      socket_listener_task_(engine::CriticalAsyncNoSpan(
-          task_processor_,
-          [this](engine::io::Socket&& request_socket) {
-            while (!engine::current_task::ShouldCancel()) {
-              try {
-                AcceptConnection(request_socket);
-              } catch (const engine::io::IoCancelled&) {
-                break;
-              } catch (const std::exception& ex) {
-                LOG_ERROR() << "can't accept connection: " << ex;
-
-                // If we're out of files, allow other coroutines to close old
-                // connections
-                engine::Yield();
-              }
-            }
-          },
-          CreateSocket(endpoint_info_->listener_config))) {}
+      data_accounter_(data_accounter) {
+  auto socket = inherited_socket ? std::move(*inherited_socket)
+                                 : CreateListenerSocket(*endpoint_info_);
+  listening_fd_ = socket.Fd();
+
+  socket_listener_task_ = engine::CriticalAsyncNoSpan(
+      task_processor_,
+      [this](engine::io::Socket&& request_socket) {
+        while (!engine::current_task::ShouldCancel()) {
+          try {
+            AcceptConnection(request_socket);
+          } catch (const engine::io::IoCancelled&) {
+            break;
+          } catch (const std::exception& ex) {
+            LOG_ERROR() << "can't accept connection: " << ex;
+
+            // If we're out of files, allow other coroutines to close old
+            // connections
+            engine::Yield();
+          }
+        }
+      },
+      std::move(socket));
+}
 
 ListenerImpl::~ListenerImpl() {
   LOG_TRACE() << "Stopping socket listener task";
@@ -58,6 +76,8 @@ ListenerImpl::~ListenerImpl() {
 
 Stats ListenerImpl::GetStats() const { return *stats_; }
 
+int ListenerImpl::GetListeningFd() const { return listening_fd_; }
+
 engine::TaskProcessor& ListenerImpl::GetTaskProcessor() const {
   return task_processor_;
 }
@@ -93,7 +113,8 @@ void ListenerImpl::SetupConnection(engine::io::Socket peer_socket) {
   auto connection_ptr = Connection::Create(
       task_processor_, endpoint_info_->listener_config.connection_config,
       endpoint_info_->listener_config.handler_defaults, std::move(peer_socket),
-      endpoint_info_->request_handler, stats_, data_accounter_);
+      endpoint_info_->request_handler, stats_, endpoint_info_->histograms,
+      data_accounter_);
   connection_ptr->SetCloseCb([endpoint_info = endpoint_info_]() {
     --endpoint_info->connection_count;
   });
@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 
 #include <userver/engine/io/socket.hpp>
@@ -19,13 +20,17 @@ namespace server::net {
 
 class ListenerImpl final {
  public:
+  /// Listens on `inherited_socket` if it is set, on a new socket otherwise
   ListenerImpl(engine::TaskProcessor& task_processor,
                std::shared_ptr<EndpointInfo> endpoint_info,
-               request::ResponseDataAccounter& data_accounter);
+               request::ResponseDataAccounter& data_accounter,
+               std::optional<engine::io::Socket> inherited_socket);
   ~ListenerImpl();
 
   Stats GetStats() const;
 
+  int GetListeningFd() const;
+
   engine::TaskProcessor& GetTaskProcessor() const;
 
  private:
@@ -43,6 +48,7 @@ class ListenerImpl final {
   std::shared_ptr<Stats> stats_;
   request::ResponseDataAccounter& data_accounter_;
 
+  int listening_fd_{-1};
   engine::TaskWithResult<void> socket_listener_task_;
 
   // connections_ are added in socket_listener_task_ and removed
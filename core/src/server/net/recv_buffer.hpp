@@ -0,0 +1,24 @@
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::net {
+
+/// Block of memory a connection receives the data into. The requests parsed
+/// from it may share its ownership to refer to their bodies without copying.
+using RecvBuffer = std::vector<char>;
+using RecvBufferPtr = std::shared_ptr<const RecvBuffer>;
+
+/// Part of the received data that keeps its buffer alive
+struct RecvBufferSlice final {
+  RecvBufferPtr buffer;
+  std::string_view data;
+};
+
+}  // namespace server::net
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,257 @@
+#include "socket_handoff.hpp"
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/logging/log.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::net {
+
+namespace {
+
+// Connect and the sockets transfer, the new instance is ready by then
+constexpr std::chrono::seconds kHandoffTimeout{10};
+
+constexpr char kReadyMessage = 'R';
+
+engine::io::Sockaddr MakeUnixSockaddr(const std::string& path) {
+  engine::io::Sockaddr addr;
+  auto* sa = addr.As<struct sockaddr_un>();
+  sa->sun_family = AF_UNIX;
+  if (path.empty() || path.size() >= sizeof(sa->sun_path)) {
+    throw std::runtime_error("invalid handoff socket path '" + path + "'");
+  }
+  std::strncpy(sa->sun_path, path.c_str(), sizeof(sa->sun_path));
+  return addr;
+}
+
+void WaitOrThrow(bool is_ready) {
+  if (is_ready) return;
+  if (engine::current_task::ShouldCancel()) throw engine::io::IoCancelled();
+  throw engine::io::IoTimeout();
+}
+
+bool IsRetryable(int error) {
+  return error == EAGAIN || error == EWOULDBLOCK || error == EINTR;
+}
+
+// Passes the descriptor via SCM_RIGHTS along with a single dummy byte
+void SendFd(engine::io::Socket& peer, int fd, engine::Deadline deadline) {
+  char byte = 0;
+  iovec iov{&byte, sizeof(byte)};
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))]{};
+
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+
+  auto* header = CMSG_FIRSTHDR(&message);
+  header->cmsg_level = SOL_SOCKET;
+  header->cmsg_type = SCM_RIGHTS;
+  header->cmsg_len = CMSG_LEN(sizeof(int));
+  std::memcpy(CMSG_DATA(header), &fd, sizeof(int));
+
+  while (::sendmsg(peer.Fd(), &message, 0) == -1) {
+    const auto error = errno;
+    if (!IsRetryable(error)) {
+      throw engine::io::IoSystemError(error, "sending a listening socket");
+    }
+    WaitOrThrow(peer.WaitWriteable(deadline));
+  }
+}
+
+engine::io::Socket RecvFd(engine::io::Socket& peer, engine::Deadline deadline) {
+  char byte = 0;
+  iovec iov{&byte, sizeof(byte)};
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))]{};
+
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+
+  for (;;) {
+    const auto received = ::recvmsg(peer.Fd(), &message, 0);
+    if (received > 0) break;
+    if (received == 0) {
+      throw engine::io::IoException("handoff connection closed by peer");
+    }
+    const auto error = errno;
+    if (!IsRetryable(error)) {
+      throw engine::io::IoSystemError(error, "receiving a listening socket");
+    }
+    WaitOrThrow(peer.WaitReadable(deadline));
+  }
+
+  const auto* header = CMSG_FIRSTHDR(&message);
+  if (!header || header->cmsg_level != SOL_SOCKET ||
+      header->cmsg_type != SCM_RIGHTS ||
+      header->cmsg_len != CMSG_LEN(sizeof(int))) {
+    throw engine::io::IoException("no listening socket in handoff message");
+  }
+  int fd = -1;
+  std::memcpy(&fd, CMSG_DATA(header), sizeof(int));
+  return engine::io::Socket{fd};
+}
+
+bool IsListeningOn(engine::io::Socket& socket, const ListenerConfig& config) {
+  const auto& addr = socket.Getsockname();
+  if (!config.unix_socket_path.empty()) {
+    return addr.Domain() == engine::io::AddrDomain::kUnix &&
+           config.unix_socket_path == addr.As<struct sockaddr_un>()->sun_path;
+  }
+  return addr.HasPort() && addr.Port() == config.port;
+}
+
+}  // namespace
+
+SocketHandoffClient::SocketHandoffClient(
+    const std::string& handoff_socket_path) {
+  // Blocking API is fine here, it is only called once on startup
+  if (fs::blocking::GetFileType(handoff_socket_path) !=
+      boost::filesystem::file_type::socket_file) {
+    LOG_INFO() << "No previous instance to take the listening sockets from";
+    return;
+  }
+
+  const auto deadline = engine::Deadline::FromDuration(kHandoffTimeout);
+  try {
+    const auto addr = MakeUnixSockaddr(handoff_socket_path);
+    engine::io::Socket connection{addr.Domain(),
+                                  engine::io::SocketType::kStream};
+    connection.Connect(addr, deadline);
+
+    std::uint32_t count = 0;
+    if (connection.RecvAll(&count, sizeof(count), deadline) != sizeof(count)) {
+      throw engine::io::IoException("handoff connection closed by peer");
+    }
+    for (std::uint32_t i = 0; i < count; ++i) {
+      sockets_.push_back(RecvFd(connection, deadline));
+    }
+    connection_ = std::move(connection);
+  } catch (const std::exception& ex) {
+    // e.g. a stale socket file of an instance that has already stopped
+    LOG_WARNING() << "Failed to take the listening sockets from the previous "
+                     "instance, listening on new sockets: "
+                  << ex;
+    sockets_.clear();
+    return;
+  }
+  LOG_INFO() << "Took " << sockets_.size()
+             << " listening sockets from the previous instance";
+}
+
+SocketHandoffClient::~SocketHandoffClient() = default;
+
+std::optional<engine::io::Socket> SocketHandoffClient::TakeSocket(
+    const ListenerConfig& config) {
+  for (auto it = sockets_.begin(); it != sockets_.end(); ++it) {
+    if (IsListeningOn(*it, config)) {
+      auto socket = std::move(*it);
+      sockets_.erase(it);
+      return socket;
+    }
+  }
+  return std::nullopt;
+}
+
+void SocketHandoffClient::NotifyReady() {
+  sockets_.clear();
+  if (!connection_) return;
+
+  try {
+    const auto deadline = engine::Deadline::FromDuration(kHandoffTimeout);
+    [[maybe_unused]] const auto sent =
+        connection_.SendAll(&kReadyMessage, sizeof(kReadyMessage), deadline);
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to notify the previous instance: " << ex;
+  }
+  connection_.Close();
+}
+
+SocketHandoffServer::SocketHandoffServer(const std::string& handoff_socket_path,
+                                         std::vector<int> listening_fds,
+                                         std::function<void()> on_handed_off)
+    : listening_fds_(std::move(listening_fds)),
+      on_handed_off_(std::move(on_handed_off)) {
+  const auto addr = MakeUnixSockaddr(handoff_socket_path);
+
+  // The previous instance has stopped serving it
+  if (fs::blocking::GetFileType(handoff_socket_path) ==
+      boost::filesystem::file_type::socket_file) {
+    fs::blocking::RemoveSingleFile(handoff_socket_path);
+  }
+
+  engine::io::Socket socket{addr.Domain(), engine::io::SocketType::kStream};
+  socket.Bind(addr);
+  socket.Listen(1);
+  fs::blocking::Chmod(handoff_socket_path,
+                      boost::filesystem::perms::owner_read |
+                          boost::filesystem::perms::owner_write);
+
+  serve_task_ = engine::CriticalAsyncNoSpan(
+      [this](engine::io::Socket&& handoff_socket) {
+        while (!engine::current_task::ShouldCancel()) {
+          try {
+            auto peer = handoff_socket.Accept({});
+            if (HandOff(peer)) {
+              on_handed_off_();
+              return;
+            }
+          } catch (const engine::io::IoCancelled&) {
+            break;
+          } catch (const std::exception& ex) {
+            LOG_ERROR() << "Failed to hand off the listening sockets: " << ex;
+          }
+        }
+      },
+      std::move(socket));
+}
+
+SocketHandoffServer::~SocketHandoffServer() { serve_task_.SyncCancel(); }
+
+bool SocketHandoffServer::HandOff(engine::io::Socket& peer) const {
+  LOG_INFO() << "Passing " << listening_fds_.size()
+             << " listening sockets to the new instance";
+  const auto deadline = engine::Deadline::FromDuration(kHandoffTimeout);
+
+  const auto count = static_cast<std::uint32_t>(listening_fds_.size());
+  [[maybe_unused]] const auto sent =
+      peer.SendAll(&count, sizeof(count), deadline);
+  for (const int fd : listening_fds_) SendFd(peer, fd, deadline);
+
+  // The new instance connects once its components are loaded, but its
+  // listeners may take a while to start
+  char message = 0;
+  const auto received =
+      peer.RecvAll(&message, sizeof(message), engine::Deadline{});
+  if (received != sizeof(message) || message != kReadyMessage) {
+    LOG_WARNING() << "The new instance has failed to start, keep serving";
+    return false;
+  }
+  LOG_INFO() << "The new instance is ready";
+  return true;
+}
+
+}  // namespace server::net
+
+USERVER_NAMESPACE_END
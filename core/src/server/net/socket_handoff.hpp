@@ -0,0 +1,60 @@
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+#include <server/net/listener_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::net {
+
+/// @brief Receives the listening sockets of the previous instance of the
+/// service over its handoff unix socket.
+///
+/// The previous instance keeps accepting the connections on the same sockets
+/// until NotifyReady() is called, so no connection is lost during a restart.
+class SocketHandoffClient final {
+ public:
+  /// Does nothing if there is no previous instance listening on the path
+  explicit SocketHandoffClient(const std::string& handoff_socket_path);
+  ~SocketHandoffClient();
+
+  /// Returns a received socket that listens on the `config` address
+  std::optional<engine::io::Socket> TakeSocket(const ListenerConfig& config);
+
+  /// Makes the previous instance stop, closes the sockets nobody took
+  void NotifyReady();
+
+ private:
+  engine::io::Socket connection_;
+  std::vector<engine::io::Socket> sockets_;
+};
+
+/// @brief Serves the handoff unix socket, passing the listening sockets to
+/// the next instance of the service.
+///
+/// `on_handed_off` is called once the next instance is ready to serve.
+class SocketHandoffServer final {
+ public:
+  SocketHandoffServer(const std::string& handoff_socket_path,
+                      std::vector<int> listening_fds,
+                      std::function<void()> on_handed_off);
+  ~SocketHandoffServer();
+
+ private:
+  bool HandOff(engine::io::Socket& peer) const;
+
+  const std::vector<int> listening_fds_;
+  const std::function<void()> on_handed_off_;
+  engine::TaskWithResult<void> serve_task_;
+};
+
+}  // namespace server::net
+
+USERVER_NAMESPACE_END
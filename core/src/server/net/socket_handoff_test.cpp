@@ -0,0 +1,72 @@
+#include <server/net/socket_handoff.hpp>
+
+#include <netinet/in.h>
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/utest/utest.hpp>
+
+#include <server/net/create_socket.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+engine::io::Sockaddr MakeLoopbackAddr(int port) {
+  engine::io::Sockaddr addr;
+  auto* sa = addr.As<struct sockaddr_in6>();
+  sa->sin6_family = AF_INET6;
+  sa->sin6_port = htons(port);
+  sa->sin6_addr = in6addr_loopback;
+  return addr;
+}
+
+}  // namespace
+
+UTEST(SocketHandoff, PassesListeningSockets) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  const auto temp_root = fs::blocking::TempDirectory::Create();
+  const auto handoff_path = temp_root.GetPath() + "/handoff.sock";
+
+  server::net::ListenerConfig config;
+  auto listen_socket = server::net::CreateSocket(config);
+  config.port = listen_socket.Getsockname().Port();
+
+  engine::SingleConsumerEvent handed_off;
+  server::net::SocketHandoffServer handoff_server{
+      handoff_path, {listen_socket.Fd()}, [&] { handed_off.Send(); }};
+
+  server::net::SocketHandoffClient handoff_client{handoff_path};
+  server::net::ListenerConfig other_config;
+  other_config.port = config.port + 1;
+  EXPECT_FALSE(handoff_client.TakeSocket(other_config));
+
+  auto taken_socket = handoff_client.TakeSocket(config);
+  ASSERT_TRUE(taken_socket);
+  EXPECT_EQ(taken_socket->Getsockname().Port(), config.port);
+  EXPECT_FALSE(handoff_client.TakeSocket(config));
+
+  // The connections are accepted by the new owner of the socket
+  listen_socket.Close();
+  engine::io::Socket client{engine::io::AddrDomain::kInet6,
+                            engine::io::SocketType::kStream};
+  client.Connect(MakeLoopbackAddr(config.port), deadline);
+  EXPECT_TRUE(taken_socket->Accept(deadline));
+
+  EXPECT_FALSE(handed_off.WaitForEventFor(std::chrono::milliseconds{10}));
+  handoff_client.NotifyReady();
+  EXPECT_TRUE(handed_off.WaitForEventUntil(deadline));
+}
+
+UTEST(SocketHandoff, NoPreviousInstance) {
+  const auto temp_root = fs::blocking::TempDirectory::Create();
+
+  server::net::SocketHandoffClient handoff_client{temp_root.GetPath() +
+                                                  "/handoff.sock"};
+  server::net::ListenerConfig config;
+  config.port = 80;
+  EXPECT_FALSE(handoff_client.TakeSocket(config));
+  UEXPECT_NO_THROW(handoff_client.NotifyReady());
+}
+
+USERVER_NAMESPACE_END
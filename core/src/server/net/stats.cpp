@@ -0,0 +1,19 @@
+#include <server/net/stats.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::net {
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ConnectionHistograms& histograms) {
+  writer["requests-per-connection"] =
+      histograms.requests_per_connection.GetStatsForPeriod();
+  writer["pipelining-depth"] = histograms.pipelining_depth.GetStatsForPeriod();
+  writer["bytes-per-read"] = histograms.bytes_per_read.GetStatsForPeriod();
+  writer["wait-readable-ms"] = histograms.wait_readable_ms.GetStatsForPeriod();
+  writer["send-response-us"] = histograms.send_response_us.GetStatsForPeriod();
+}
+
+}  // namespace server::net
+
+USERVER_NAMESPACE_END
@@ -2,8 +2,13 @@
 
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
@@ -57,6 +62,36 @@ inline Stats& operator+=(Stats& lhs, const Stats& rhs) {
 
 inline Stats operator+(Stats&& lhs, const Stats& rhs) { return lhs += rhs; }
 
+// Distributions over the last minute for tuning the listener options, shared
+// by all the connections of the listener
+struct ConnectionHistograms {
+  template <typename Percentile>
+  using RecentPeriod =
+      utils::statistics::RecentPeriod<Percentile, Percentile>;
+
+  using RequestsPercentile =
+      utils::statistics::Percentile<1000, std::uint32_t, 100, 1000>;
+  using DepthPercentile = utils::statistics::Percentile<128>;
+  using BytesPercentile =
+      utils::statistics::Percentile<1024, std::uint32_t, 512, 1024>;
+  using TimingsPercentile =
+      utils::statistics::Percentile<2048, std::uint32_t, 120>;
+
+  // accounted when the connection is closed
+  RecentPeriod<RequestsPercentile> requests_per_connection;
+  // requests of the connection that wait for the response, including the new
+  // one, accounted for each request
+  RecentPeriod<DepthPercentile> pipelining_depth;
+  RecentPeriod<BytesPercentile> bytes_per_read;
+  // in milliseconds, includes the keepalive waits
+  RecentPeriod<TimingsPercentile> wait_readable_ms;
+  // in microseconds
+  RecentPeriod<TimingsPercentile> send_response_us;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ConnectionHistograms& histograms);
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,64 @@
+#include <userver/server/request/arena.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::request {
+
+namespace {
+
+constexpr std::size_t kInitialBlockSize = 1024;
+constexpr std::size_t kMaxBlockSize = 64 * 1024;
+
+}  // namespace
+
+struct alignas(std::max_align_t) Arena::Block {
+  Block* next;
+};
+
+Arena::~Arena() {
+  for (auto* destructor = destructors_; destructor;
+       destructor = destructor->next) {
+    destructor->destroy(destructor->object);
+  }
+
+  while (blocks_) {
+    auto* next = blocks_->next;
+    ::operator delete(blocks_);
+    blocks_ = next;
+  }
+}
+
+void* Arena::AllocateSlow(std::size_t size, std::size_t alignment) {
+  const auto block_size =
+      std::clamp(reserved_size_, kInitialBlockSize, kMaxBlockSize);
+  // The data after the header is aligned for all the usual alignments
+  const auto padding = alignment > alignof(Block) ? alignment : 0;
+  const auto data_size = std::max(block_size, size + padding);
+
+  auto* block = static_cast<Block*>(::operator new(sizeof(Block) + data_size));
+  block->next = blocks_;
+  blocks_ = block;
+  reserved_size_ += sizeof(Block) + data_size;
+
+  // NOLINTNEXTLINE(performance-no-int-to-ptr)
+  current_ = reinterpret_cast<std::uintptr_t>(block + 1);
+  end_ = current_ + data_size;
+
+  auto* result = Allocate(size, alignment);
+  UASSERT(result);
+  return result;
+}
+
+std::string_view Arena::Copy(std::string_view value) {
+  if (value.empty()) return {};
+  auto* data = static_cast<char*>(Allocate(value.size(), 1));
+  std::memcpy(data, value.data(), value.size());
+  return {data, value.size()};
+}
+
+}  // namespace server::request
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,114 @@
+#include <userver/server/request/arena.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <userver/server/request/request_context.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::request::Arena;
+using server::request::ArenaAllocator;
+
+bool IsAligned(const void* ptr, std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+/// [Sample Arena]
+using ArenaString =
+    std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+std::vector<ArenaString, ArenaAllocator<ArenaString>> SplitPath(
+    std::string_view path, server::request::RequestContext& context) {
+  ArenaAllocator<ArenaString> allocator{context.GetArena()};
+  std::vector<ArenaString, ArenaAllocator<ArenaString>> result{allocator};
+  while (!path.empty()) {
+    const auto pos = std::min(path.find('/'), path.size());
+    if (pos) result.emplace_back(path.substr(0, pos), allocator);
+    path.remove_prefix(std::min(pos + 1, path.size()));
+  }
+  return result;
+}
+/// [Sample Arena]
+
+}  // namespace
+
+TEST(Arena, Sample) {
+  server::request::RequestContext context;
+  const auto parts = SplitPath(
+      "/v1/some-pretty-long-path-segment/another-long-path-segment", context);
+  ASSERT_EQ(parts.size(), 3);
+  EXPECT_EQ(parts[1], "some-pretty-long-path-segment");
+  EXPECT_GT(context.GetArena().GetReservedSize(), 0);
+}
+
+TEST(Arena, Allocate) {
+  Arena arena;
+  EXPECT_EQ(arena.GetReservedSize(), 0);
+
+  for (const std::size_t alignment : {1, 2, 8, 16, 64, 4096}) {
+    for (const std::size_t size : {1, 3, 100, 5000}) {
+      auto* ptr = arena.Allocate(size, alignment);
+      EXPECT_TRUE(IsAligned(ptr, alignment)) << size << ' ' << alignment;
+      std::memset(ptr, 0, size);
+    }
+  }
+
+  const auto reserved = arena.GetReservedSize();
+  EXPECT_GT(reserved, 0);
+  arena.Allocate(1, 1);
+  EXPECT_EQ(arena.GetReservedSize(), reserved);
+}
+
+TEST(Arena, Create) {
+  std::vector<int> destroyed;
+  struct Tracker {
+    std::vector<int>& destroyed;
+    int id;
+    ~Tracker() { destroyed.push_back(id); }
+  };
+
+  {
+    Arena arena;
+    auto& first = arena.Create<Tracker>(Tracker{destroyed, 1});
+    auto& second = arena.Create<Tracker>(Tracker{destroyed, 2});
+    EXPECT_EQ(first.id, 1);
+    EXPECT_EQ(second.id, 2);
+    destroyed.clear();  // the temporaries
+
+    auto& value = arena.Create<std::uint64_t>(42);
+    EXPECT_EQ(value, 42);
+    EXPECT_TRUE(IsAligned(&value, alignof(std::uint64_t)));
+  }
+  EXPECT_EQ(destroyed, (std::vector<int>{2, 1}));
+}
+
+TEST(Arena, Copy) {
+  Arena arena;
+  std::string value = "some value";
+  const auto copy = arena.Copy(value);
+  value.assign("other value");
+  EXPECT_EQ(copy, "some value");
+  EXPECT_EQ(arena.Copy({}), "");
+}
+
+TEST(Arena, Containers) {
+  Arena arena;
+  std::vector<std::uint64_t, ArenaAllocator<std::uint64_t>> values{
+      ArenaAllocator<std::uint64_t>{arena}};
+  for (std::uint64_t i = 0; i < 10000; ++i) values.push_back(i);
+  EXPECT_EQ(values.back(), 9999);
+  EXPECT_GE(arena.GetReservedSize(), values.size() * sizeof(std::uint64_t));
+
+  Arena other_arena;
+  EXPECT_EQ(ArenaAllocator<int>{arena}, ArenaAllocator<char>{arena});
+  EXPECT_NE(ArenaAllocator<int>{arena}, ArenaAllocator<int>{other_arena});
+}
+
+USERVER_NAMESPACE_END
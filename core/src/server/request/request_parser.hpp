@@ -2,6 +2,8 @@
 
 #include <cstddef>
 
+#include <server/net/recv_buffer.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server::request {
@@ -15,6 +17,12 @@ class RequestParser {
   virtual ~RequestParser() noexcept = default;
 
   virtual bool Parse(const char* data, size_t size) = 0;
+
+  /// Lets the parsed requests refer to the data in the buffer instead of
+  /// copying it
+  virtual bool Parse(const net::RecvBufferPtr& buffer, size_t size) {
+    return Parse(buffer->data(), size);
+  }
 };
 
 }  // namespace server::request
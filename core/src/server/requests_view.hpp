@@ -1,46 +1,40 @@
 #pragma once
 
-#include <list>
 #include <memory>
+#include <mutex>
+#include <vector>
 
-#include <moodycamel/concurrentqueue.h>
-#include <userver/engine/mutex.hpp>
+#include <userver/concurrent/sharded_variable.hpp>
 #include <userver/server/request/request_base.hpp>
-#include <userver/utils/periodic_task.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server {
 
+/// Keeps track of the requests in flight for the inspect-requests handler.
+///
+/// Registering a request is a push to the shard of the current worker, the
+/// finished requests are only removed once a shard grows twice or the
+/// requests are inspected.
 class RequestsView final {
  public:
-  RequestsView();
-  ~RequestsView();
-
   using RequestWPtr = std::weak_ptr<request::RequestBase>;
-  using Queue = moodycamel::ConcurrentQueue<RequestWPtr>;
 
-  std::shared_ptr<Queue> GetQueue() { return queue_; }
+  void Register(const std::shared_ptr<request::RequestBase>& request);
 
   std::vector<std::shared_ptr<request::RequestBase>> GetAllRequests();
 
-  void StartBackgroudWorker();
-
-  void StopBackgroundWorker();
-
  private:
-  void DoJob();
-
-  void GarbageCollect();
-
-  void HandleQueue();
+  static constexpr std::size_t kMinCompactionSize = 64;
 
-  std::shared_ptr<Queue> queue_;
-  engine::TaskWithResult<void> job_task_;
-  std::vector<RequestWPtr> job_requests;
+  struct Shard {
+    std::mutex mutex;
+    std::vector<RequestWPtr> requests;
+    // The finished requests are removed once the size reaches it
+    std::size_t compaction_size{kMinCompactionSize};
+  };
 
-  engine::Mutex requests_in_flight_mutex_;
-  std::list<RequestWPtr> requests_in_flight_;
+  concurrent::ShardedVariable<Shard> shards_;
 };
 
 }  // namespace server
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include <server/requests_view.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// ~2ms handling time at 500k RPS
+constexpr std::size_t kRequestsInFlight = 1000;
+constexpr double kRps = 500'000;
+
+// RequestsView only looks at the lifetime of the requests
+std::shared_ptr<server::request::RequestBase> MakeRequest() {
+  return {std::make_shared<char>(), nullptr};
+}
+
+// Share of a CPU core spent at kRps
+benchmark::Counter MakeCpuShareCounter(const benchmark::State& state) {
+  return benchmark::Counter(static_cast<double>(state.iterations()) / kRps,
+                            benchmark::Counter::kIsRate |
+                                benchmark::Counter::kInvert);
+}
+
+void requests_view_make_request(benchmark::State& state) {
+  std::vector<std::shared_ptr<server::request::RequestBase>> in_flight(
+      kRequestsInFlight);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    // finishes the oldest request
+    in_flight[i++ % kRequestsInFlight] = MakeRequest();
+  }
+}
+BENCHMARK(requests_view_make_request);
+
+void requests_view_register(benchmark::State& state) {
+  server::RequestsView view;
+  std::vector<std::shared_ptr<server::request::RequestBase>> in_flight(
+      kRequestsInFlight);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto& request = in_flight[i++ % kRequestsInFlight];
+    request = MakeRequest();
+    view.Register(request);
+  }
+  state.counters["cpu-share-at-500k-rps"] = MakeCpuShareCounter(state);
+}
+BENCHMARK(requests_view_register);
+
+void requests_view_get_all(benchmark::State& state) {
+  server::RequestsView view;
+  std::vector<std::shared_ptr<server::request::RequestBase>> in_flight(
+      kRequestsInFlight);
+  for (auto& request : in_flight) {
+    request = MakeRequest();
+    view.Register(request);
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(view.GetAllRequests());
+  }
+}
+BENCHMARK(requests_view_get_all);
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,8 @@
 #include <userver/server/server.hpp>
 
+#include <signal.h>
+#include <unistd.h>
+
 #include <atomic>
 #include <stdexcept>
 
@@ -10,6 +13,7 @@
 #include <server/http/http_request_impl.hpp>
 #include <server/net/endpoint_info.hpp>
 #include <server/net/listener.hpp>
+#include <server/net/socket_handoff.hpp>
 #include <server/net/stats.hpp>
 #include <server/requests_view.hpp>
 #include <server/server_config.hpp>
@@ -39,7 +43,7 @@ class ServerImpl final {
     request::ResponseDataAccounter data_accounter_;
     std::vector<net::Listener> listeners_;
 
-    void Start();
+    void Start(net::SocketHandoffClient* handoff_client);
 
     void Stop();
   };
@@ -53,7 +57,10 @@ class ServerImpl final {
 
   void StartPortInfos();
 
+  void StartSocketHandoffServer();
+
   PortInfo main_port_info_, monitor_port_info_;
+  std::unique_ptr<net::SocketHandoffServer> handoff_server_;
   std::atomic<size_t> handlers_count_{0};
 
   mutable std::shared_timed_mutex stat_mutex_;
@@ -87,11 +94,16 @@ void ServerImpl::PortInfo::Stop() {
   LOG_TRACE() << "Stopped request handlers";
 }
 
-void ServerImpl::PortInfo::Start() {
+void ServerImpl::PortInfo::Start(net::SocketHandoffClient* handoff_client) {
   UASSERT(request_handler_);
   request_handler_->DisableAddHandler();
   for (auto& listener : listeners_) {
-    listener.Start();
+    if (handoff_client) {
+      listener.Start(
+          handoff_client->TakeSocket(endpoint_info_->listener_config));
+    } else {
+      listener.Start();
+    }
   }
 }
 
@@ -125,6 +137,7 @@ void ServerImpl::Stop() {
   }
 
   LOG_INFO() << "Stopping server";
+  handoff_server_.reset();
   main_port_info_.Stop();
   monitor_port_info_.Stop();
   LOG_INFO() << "Stopped server";
@@ -149,6 +162,7 @@ void ServerImpl::InitPortInfo(
   const auto& event_thread_pool = task_processor.EventThreadPool();
   size_t listener_shards = listener_config.shards ? *listener_config.shards
                                                   : event_thread_pool.GetSize();
+  info.endpoint_info_->listeners_count = listener_shards;
   while (listener_shards--) {
     info.listeners_.emplace_back(info.endpoint_info_, task_processor,
                                  info.data_accounter_);
@@ -159,10 +173,10 @@ void ServerImpl::StartPortInfos() {
   UASSERT(main_port_info_.request_handler_);
 
   if (has_requests_view_watchers_.load()) {
-    auto queue = requests_view_->GetQueue();
-    requests_view_->StartBackgroudWorker();
-    auto hook = [queue](std::shared_ptr<request::RequestBase> request) {
-      queue->enqueue(request);
+    // requests_view_ outlives the request handlers
+    auto hook = [&view = *requests_view_](
+                    std::shared_ptr<request::RequestBase> request) {
+      view.Register(request);
     };
     main_port_info_.request_handler_->SetNewRequestHook(hook);
     if (monitor_port_info_.request_handler_) {
@@ -170,16 +184,47 @@ void ServerImpl::StartPortInfos() {
     }
   }
 
-  main_port_info_.Start();
+  // The previous instance of the service keeps serving until all the
+  // components of this one are loaded, i.e. right until now
+  std::optional<net::SocketHandoffClient> handoff_client;
+  if (!config_.handoff_socket_path.empty()) {
+    handoff_client.emplace(config_.handoff_socket_path);
+  }
+  auto* handoff_client_ptr = handoff_client ? &*handoff_client : nullptr;
+
+  main_port_info_.Start(handoff_client_ptr);
   if (monitor_port_info_.request_handler_) {
-    monitor_port_info_.Start();
+    monitor_port_info_.Start(handoff_client_ptr);
   } else {
     LOG_WARNING() << "No 'listener-monitor' in 'server' component";
   }
 
+  if (handoff_client) {
+    handoff_client->NotifyReady();
+    StartSocketHandoffServer();
+  }
+
   started_.store(true);
 }
 
+void ServerImpl::StartSocketHandoffServer() {
+  std::vector<int> listening_fds;
+  for (const auto* info : {&main_port_info_, &monitor_port_info_}) {
+    for (const auto& listener : info->listeners_) {
+      listening_fds.push_back(listener.GetListeningFd());
+    }
+  }
+
+  handoff_server_ = std::make_unique<net::SocketHandoffServer>(
+      config_.handoff_socket_path, std::move(listening_fds), [] {
+        LOG_WARNING() << "The listening sockets are taken over by the new "
+                         "instance of the service, shutting down";
+        // Same as the deploy system would do, in-flight requests are finished
+        // by the usual graceful shutdown
+        ::kill(::getpid(), SIGTERM);
+      });
+}
+
 Server::Server(ServerConfig config,
                const components::ComponentContext& component_context)
     : pimpl(
@@ -234,6 +279,15 @@ void Server::WriteTotalHandlerStatistics(
   writer = total;
 }
 
+void Server::WriteListenerStatistics(utils::statistics::Writer& writer) const {
+  if (const auto& info = pimpl->main_port_info_.endpoint_info_) {
+    writer.ValueWithLabels(*info->histograms, {"server_listener", "main"});
+  }
+  if (const auto& info = pimpl->monitor_port_info_.endpoint_info_) {
+    writer.ValueWithLabels(*info->histograms, {"server_listener", "monitor"});
+  }
+}
+
 net::Stats Server::GetServerStats() const { return pimpl->GetServerStats(); }
 
 void Server::AddHandler(const handlers::HttpHandlerBase& handler,
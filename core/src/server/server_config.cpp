@@ -23,6 +23,8 @@ ServerConfig Parse(const yaml_config::YamlConfig& value,
       value["server-name"].As<std::string>(utils::GetUserverIdentifier());
   config.set_response_server_hostname =
       value["set-response-server-hostname"].As<bool>(false);
+  config.handoff_socket_path =
+      value["handoff-socket"].As<std::string>(config.handoff_socket_path);
 
   return config;
 }
@@ -1,11 +1,13 @@
 #include <userver/testsuite/testpoint.hpp>
 
+#include <atomic>
 #include <utility>
 #include <variant>
 
 #include <userver/engine/shared_mutex.hpp>
 #include <userver/rcu/rcu.hpp>
 #include <userver/testsuite/testpoint_control.hpp>
+#include <userver/tracing/span.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/async.hpp>
 #include <userver/utils/overloaded.hpp>
@@ -24,6 +26,8 @@ std::atomic<TestpointClientBase*> client_instance{nullptr};
 engine::SharedMutex client_instance_mutex;
 
 rcu::Variable<EnabledTestpoints> enabled_testpoints;
+// false if 'enabled_testpoints' is empty, to skip the RCU read and the lookup
+std::atomic<bool> any_testpoint_enabled{false};
 std::atomic<TestpointControl*> control_instance{nullptr};
 
 }  // namespace
@@ -37,7 +41,13 @@ struct TestpointScope::Impl final {
   TestpointClientBase* client{nullptr};
 };
 
-TestpointScope::TestpointScope() = default;
+TestpointScope::TestpointScope() {
+  if (!impl_->client) return;
+
+  // Tail sampling should not hide the traces checked by the tests
+  auto* span = tracing::Span::CurrentSpanUnchecked();
+  if (span) span->ForceSampled();
+}
 
 TestpointScope::~TestpointScope() = default;
 
@@ -50,6 +60,11 @@ const TestpointClientBase& TestpointScope::GetClient() const noexcept {
   return *impl_->client;
 }
 
+bool AreTestpointsAvailable() noexcept {
+  return any_testpoint_enabled.load(std::memory_order_relaxed) &&
+         client_instance.load(std::memory_order_relaxed) != nullptr;
+}
+
 bool IsTestpointEnabled(const std::string& name) {
   if (!client_instance) return false;
   const auto enabled_names = enabled_testpoints.Read();
@@ -92,21 +107,26 @@ TestpointControl::TestpointControl() {
                "Only 1 TestpointControl instance may exist at a time");
   }
   enabled_testpoints.Assign(EnableOnly{});
+  any_testpoint_enabled = false;
 }
 
 TestpointControl::~TestpointControl() {
+  any_testpoint_enabled = false;
   enabled_testpoints.Assign(EnableOnly{});
   control_instance = nullptr;
 }
 
 void TestpointControl::SetEnabledNames(std::unordered_set<std::string> names) {
   (void)this;  // silence clang-tidy
+  const bool any_enabled = !names.empty();
   enabled_testpoints.Assign(EnableOnly{std::move(names)});
+  any_testpoint_enabled = any_enabled;
 }
 
 void TestpointControl::SetAllEnabled() {
   (void)this;  // silence clang-tidy
   enabled_testpoints.Assign(EnableAll{});
+  any_testpoint_enabled = true;
 }
 
 void TestpointControl::SetClient(TestpointClientBase& client) {
@@ -43,6 +43,20 @@ UTEST(Testpoint, Smoke) {
   EXPECT_EQ(response, formats::json::MakeObject("name", "what", "body", "foo"));
 }
 
+UTEST(Testpoint, NoneEnabled) {
+  testsuite::TestpointControl testpoint_control;
+  EchoTestpointClient testpoint_client;
+  testpoint_control.SetClient(testpoint_client);
+
+  testpoint_control.SetEnabledNames({});
+  EXPECT_FALSE(testsuite::impl::AreTestpointsAvailable());
+  EXPECT_FALSE(TryExecuteTestpoint());
+
+  testpoint_control.SetEnabledNames({"name"});
+  EXPECT_TRUE(testsuite::impl::AreTestpointsAvailable());
+  EXPECT_TRUE(TryExecuteTestpoint());
+}
+
 namespace {}  // namespace
 
 UTEST(Testpoint, ReentrableInitialization) {
@@ -0,0 +1,73 @@
+#include <tracing/sampling.hpp>
+
+#include <tracing/span_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+TailSampling::TailSampling(std::chrono::milliseconds slow_threshold,
+                           std::size_t max_spans)
+    : slow_threshold_(slow_threshold), max_spans_(max_spans) {}
+
+TailSampling::~TailSampling() = default;
+
+void TailSampling::Keep() {
+  std::vector<Span::Impl> spans;
+  {
+    std::lock_guard lock(mutex_);
+    if (decision_ != Decision::kUndecided) return;
+    decision_ = Decision::kKeep;
+    spans.swap(spans_);
+  }
+  Flush(std::move(spans));
+}
+
+void TailSampling::OnSpanFinished(Span::Impl&& span, bool is_error) {
+  std::vector<Span::Impl> spans;
+  {
+    std::lock_guard lock(mutex_);
+    switch (decision_) {
+      case Decision::kDrop:
+        return;
+      case Decision::kUndecided:
+        if (!is_error) {
+          // Spans over the limit are lost even if the trace is kept later
+          if (spans_.size() < max_spans_) spans_.push_back(std::move(span));
+          return;
+        }
+        decision_ = Decision::kKeep;
+        spans.swap(spans_);
+        break;
+      case Decision::kKeep:
+        break;
+    }
+  }
+  Flush(std::move(spans));
+  span.LogFinished();
+}
+
+void TailSampling::OnRootFinished(
+    Span::Impl&& root, bool is_error,
+    std::chrono::steady_clock::duration duration) {
+  std::vector<Span::Impl> spans;
+  {
+    std::lock_guard lock(mutex_);
+    if (decision_ == Decision::kUndecided) {
+      decision_ = is_error || duration >= slow_threshold_ ? Decision::kKeep
+                                                          : Decision::kDrop;
+    }
+    spans.swap(spans_);
+    if (decision_ == Decision::kDrop) return;
+  }
+  Flush(std::move(spans));
+  root.LogFinished();
+}
+
+void TailSampling::Flush(std::vector<Span::Impl>&& spans) {
+  for (auto& span : spans) span.LogFinished();
+}
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
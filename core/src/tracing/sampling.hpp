@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <userver/tracing/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+/// Sampling settings of the root spans, see components::Tracer
+struct Sampling {
+  /// Probability of a new trace to be logged
+  double head_probability{1.0};
+
+  /// Buffer the spans of the traces that were not head sampled and log them
+  /// if the trace was slow or errored
+  bool tail_enabled{false};
+  std::chrono::milliseconds tail_slow_threshold{1000};
+  std::size_t tail_max_spans{1000};
+};
+
+namespace impl {
+
+/// Finished spans of a trace that was not head sampled, waiting for the
+/// sampling root span to finish. Shared between all the spans of the trace.
+class TailSampling final {
+ public:
+  TailSampling(std::chrono::milliseconds slow_threshold,
+               std::size_t max_spans);
+
+  TailSampling(const TailSampling&) = delete;
+  TailSampling& operator=(const TailSampling&) = delete;
+
+  ~TailSampling();
+
+  /// Logs the buffered spans and all the spans finishing later
+  void Keep();
+
+  /// Buffers or logs a finished span that is not the sampling root
+  void OnSpanFinished(Span::Impl&& span, bool is_error);
+
+  /// Decides on the whole trace and logs the root span if it is kept
+  void OnRootFinished(Span::Impl&& root, bool is_error,
+                      std::chrono::steady_clock::duration duration);
+
+ private:
+  enum class Decision { kUndecided, kKeep, kDrop };
+
+  void Flush(std::vector<Span::Impl>&& spans);
+
+  const std::chrono::milliseconds slow_threshold_;
+  const std::size_t max_spans_;
+
+  std::mutex mutex_;
+  Decision decision_{Decision::kUndecided};
+  std::vector<Span::Impl> spans_;
+};
+
+}  // namespace impl
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
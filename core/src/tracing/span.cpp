@@ -1,15 +1,20 @@
 #include <tracing/span_impl.hpp>
 
-#include <random>
+#include <iterator>
 #include <type_traits>
+#include <vector>
 
+#include <boost/container/small_vector.hpp>
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
 #include <engine/task/task_context.hpp>
 #include <logging/put_data.hpp>
+#include <tracing/sampling.hpp>
 #include <userver/engine/task/local_variable.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/span_exporter.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/rand.hpp>
@@ -70,18 +75,33 @@ engine::TaskLocalVariable<boost::intrusive::list<
     Span::Impl, boost::intrusive::constant_time_size<false>>>
     task_local_spans;
 
-std::string GenerateSpanId() {
-  std::uniform_int_distribution<std::uint64_t> dist;
-  auto random_value = dist(utils::DefaultRandom());
-  return fmt::format(FMT_COMPILE("{:016x}"), random_value);
-}
-
 logging::LogHelper& operator<<(logging::LogHelper& lh,
                                tracing::Span::Impl&& span_impl) {
   std::move(span_impl).LogTo(lh);
   return lh;
 }
 
+// The SIGPROF handler of the CPU profiler must not walk the span stack, so
+// the name of the innermost span is published into the task context. The
+// span that is being destroyed is skipped, as its name is destroyed before
+// it is unlinked.
+void PublishCurrentSpanName(const Span::Impl* destroyed = nullptr) noexcept {
+  auto* context = engine::current_task::GetCurrentTaskContextUnchecked();
+  if (!context || !context->HasLocalStorage()) return;
+
+  const auto* spans_ptr = task_local_spans.GetOptional();
+  const Span::Impl* current = nullptr;
+  if (spans_ptr && !spans_ptr->empty()) {
+    auto it = std::prev(spans_ptr->end());
+    if (&*it == destroyed) {
+      if (it != spans_ptr->begin()) current = &*std::prev(it);
+    } else {
+      current = &*it;
+    }
+  }
+  context->SetProfilerSpanName(current ? &current->GetName() : nullptr);
+}
+
 const Span::Impl* GetParentSpanImpl() {
   if (!engine::current_task::GetCurrentTaskContextUnchecked()) return nullptr;
 
@@ -104,30 +124,54 @@ Span::Impl::Impl(TracerPtr tracer, std::string name, const Span::Impl* parent,
       tracer_(std::move(tracer)),
       start_system_time_(std::chrono::system_clock::now()),
       start_steady_time_(std::chrono::steady_clock::now()),
-      trace_id_(parent ? parent->GetTraceId()
-                       : utils::generators::GenerateUuid()),
-      span_id_(GenerateSpanId()),
+      trace_id_(parent ? parent->trace_id_ : impl::TraceId::Generate()),
+      span_id_(impl::SpanId::Generate()),
       parent_id_(GetParentIdForLogging(parent)),
       reference_type_(reference_type) {
   if (parent) {
     log_extra_inheritable_ = parent->log_extra_inheritable_;
     local_log_level_ = parent->local_log_level_;
   }
+  InitSampling(parent);
 }
 
 Span::Impl::~Impl() {
+  if (is_linked()) PublishCurrentSpanName(this);
+
+  if (!is_sampled_ && !tail_sampling_) {
+    return;
+  }
+
   if (!ShouldLog()) {
     return;
   }
 
+  if (!tail_sampling_) {
+    LogFinished();
+    return;
+  }
+
+  // The span outlives *this in the tail sampling buffer, it must not be
+  // logged or buffered once more when destroyed
+  const auto tail_sampling = std::move(tail_sampling_);
+  span_ = nullptr;
+  finished_duration_ = std::chrono::steady_clock::now() - start_steady_time_;
+
+  if (is_sampling_root_) {
+    tail_sampling->OnRootFinished(std::move(*this), HasErrorTag(),
+                                  *finished_duration_);
+  } else {
+    tail_sampling->OnSpanFinished(std::move(*this), HasErrorTag());
+  }
+}
+
+void Span::Impl::LogFinished() {
   PutIntoLogger(DO_LOG_TO_NO_SPAN(logging::DefaultLogger(), log_level_));
 }
 
 void Span::Impl::PutIntoLogger(logging::LogHelper& lh) {
-  const auto steady_now = std::chrono::steady_clock::now();
-  const auto duration = steady_now - start_steady_time_;
   const auto total_time_ms =
-      std::chrono::duration_cast<RealMilliseconds>(duration).count();
+      std::chrono::duration_cast<RealMilliseconds>(GetDuration()).count();
 
   const auto& ref_type = GetReferenceType() == ReferenceType::kChild
                              ? kReferenceTypeChild
@@ -140,6 +184,7 @@ void Span::Impl::PutIntoLogger(logging::LogHelper& lh) {
   PutData(lh, kStartTimestampAttrName, StartTsToString(start_system_time_));
 
   LogOpenTracing();
+  ExportSpan();
 
   time_storage_.MergeInto(lh);
 
@@ -147,28 +192,76 @@ void Span::Impl::PutIntoLogger(logging::LogHelper& lh) {
   lh << std::move(*this);
 }
 
+std::chrono::steady_clock::duration Span::Impl::GetDuration() const {
+  return finished_duration_.value_or(std::chrono::steady_clock::now() -
+                                     start_steady_time_);
+}
+
+void Span::Impl::ExportSpan() const {
+  const auto exporter = GetSpanExporter();
+  if (!exporter) return;
+
+  FinishedSpan span;
+  if (tracer_) span.service_name = tracer_->GetServiceName();
+  span.name = name_;
+  span.trace_id = GetTraceId();
+  span.span_id = GetSpanId();
+  span.parent_id = GetParentId();
+  span.reference_type = reference_type_;
+  span.start_time = start_system_time_;
+  span.duration = GetDuration();
+
+  const auto add_tags = [&span](const logging::LogExtra& log_extra) {
+    for (const auto& [key, value] : *log_extra.extra_) {
+      span.tags.emplace_back(key.GetView(), value.GetValue());
+    }
+  };
+  add_tags(GetInheritableTags());
+  if (log_extra_local_) add_tags(*log_extra_local_);
+
+  exporter->Export(std::move(span));
+}
+
 void Span::Impl::LogTo(logging::LogHelper& log_helper) const& {
-  log_helper << log_extra_inheritable_;
+  log_helper << GetInheritableTags();
   tracer_->LogSpanContextTo(*this, log_helper);
 }
 
 void Span::Impl::LogTo(logging::LogHelper& log_helper) && {
-  log_helper << std::move(log_extra_inheritable_);
+  log_helper << GetInheritableTags();
   tracer_->LogSpanContextTo(std::move(*this), log_helper);
 }
 
-void Span::Impl::DetachFromCoroStack() { unlink(); }
+const logging::LogExtra& Span::Impl::GetInheritableTags() const noexcept {
+  static const logging::LogExtra kNoTags;
+  return log_extra_inheritable_ ? *log_extra_inheritable_ : kNoTags;
+}
+
+template <typename Func>
+void Span::Impl::UpdateInheritableTags(Func&& update) {
+  auto tags = log_extra_inheritable_
+                  ? std::make_shared<logging::LogExtra>(*log_extra_inheritable_)
+                  : std::make_shared<logging::LogExtra>();
+  std::forward<Func>(update)(*tags);
+  log_extra_inheritable_ = std::move(tags);
+}
+
+void Span::Impl::DetachFromCoroStack() {
+  unlink();
+  PublishCurrentSpanName();
+}
 
 void Span::Impl::AttachToCoroStack() {
   UASSERT(!is_linked());
   task_local_spans->push_back(*this);
+  PublishCurrentSpanName();
 }
 
-std::string Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
+impl::SpanId Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
   if (!parent) return {};
 
   if (!parent->is_linked()) {
-    return parent->GetSpanId();
+    return parent->span_id_;
   }
 
   const auto* spans_ptr = task_local_spans.GetOptional();
@@ -181,9 +274,9 @@ std::string Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
   // orphaned. It's still possible for chaining to break in case parent span
   // becomes non-loggable after child span is created, but that we can't control
   for (auto current = spans_ptr->iterator_to(*parent);; --current) {
-    if (current->GetParentId().empty() /* won't find better candidate */ ||
+    if (current->parent_id_.IsEmpty() /* won't find better candidate */ ||
         current->ShouldLog()) {
-      return current->GetSpanId();
+      return current->span_id_;
     }
     if (current == spans_ptr->begin()) break;
   };
@@ -191,6 +284,56 @@ std::string Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
   return {};
 }
 
+void Span::Impl::InitSampling(const Span::Impl* parent) {
+  if (parent) {
+    is_sampled_ = parent->is_sampled_;
+    tail_sampling_ = parent->tail_sampling_;
+    return;
+  }
+
+  const auto sampling = Tracer::GetSampling();
+  if (sampling.head_probability >= 1.0) return;
+
+  is_sampled_ = utils::RandRange(1.0) < sampling.head_probability;
+  if (!is_sampled_ && sampling.tail_enabled) {
+    tail_sampling_ = std::make_shared<impl::TailSampling>(
+        sampling.tail_slow_threshold, sampling.tail_max_spans);
+    is_sampling_root_ = true;
+  }
+}
+
+void Span::Impl::SetSampled(bool sampled) {
+  is_sampled_ = sampled;
+  tail_sampling_.reset();
+  is_sampling_root_ = false;
+  if (sampled) return;
+
+  const auto sampling = Tracer::GetSampling();
+  if (sampling.tail_enabled) {
+    tail_sampling_ = std::make_shared<impl::TailSampling>(
+        sampling.tail_slow_threshold, sampling.tail_max_spans);
+    is_sampling_root_ = true;
+  }
+}
+
+void Span::Impl::ForceSampled() {
+  if (tail_sampling_) {
+    tail_sampling_->Keep();
+  } else {
+    is_sampled_ = true;
+  }
+}
+
+bool Span::Impl::HasErrorTag() const {
+  const auto has_error = [](const logging::LogExtra& log_extra) {
+    // LogExtra has no bool alternative, `AddTag(kErrorFlag, true)` stores int
+    const auto* flag = std::get_if<int>(&log_extra.GetValue(kErrorFlag));
+    return flag && *flag != 0;
+  };
+  return has_error(GetInheritableTags()) ||
+         (log_extra_local_ && has_error(*log_extra_local_));
+}
+
 bool Span::Impl::ShouldLog() const {
   /* We must honour default log level, but use span's level from ourselves,
    * not the previous span's.
@@ -200,15 +343,58 @@ bool Span::Impl::ShouldLog() const {
 }
 
 namespace {
+
+// Spans are created and destroyed at a high rate, keeping the memory of the
+// destroyed Span::Impl for reuse saves a malloc/free pair per span. The memory
+// may be returned to the pool of another thread, the pool size is bounded.
+class ImplPool final {
+ public:
+  ImplPool() { free_.reserve(kMaxFree); }
+
+  ~ImplPool() {
+    for (void* memory : free_) ::operator delete(memory);
+  }
+
+  void* Allocate() {
+    if (free_.empty()) return ::operator new(sizeof(Span::Impl));
+    void* memory = free_.back();
+    free_.pop_back();
+    return memory;
+  }
+
+  void Deallocate(void* memory) noexcept {
+    if (free_.size() < kMaxFree) {
+      free_.push_back(memory);
+    } else {
+      ::operator delete(memory);
+    }
+  }
+
+ private:
+  static constexpr std::size_t kMaxFree = 256;
+
+  std::vector<void*> free_;
+};
+
+thread_local ImplPool impl_pool;
+
 template <typename... Args>
 Span::Impl* AllocateImpl(Args&&... args) {
-  return new Span::Impl(std::forward<Args>(args)...);
+  void* memory = impl_pool.Allocate();
+  try {
+    return new (memory) Span::Impl(std::forward<Args>(args)...);
+  } catch (...) {
+    impl_pool.Deallocate(memory);
+    throw;
+  }
 }
+
 }  // namespace
 
 void Span::OptionalDeleter::operator()(Span::Impl* impl) const noexcept {
   if (do_delete) {
-    std::default_delete<Impl>{}(impl);
+    impl->~Impl();
+    impl_pool.Deallocate(impl);
   }
 }
 
@@ -334,17 +520,20 @@ std::optional<logging::Level> Span::GetLocalLogLevel() const {
 }
 
 void Span::AddTag(std::string key, logging::LogExtra::Value value) {
-  pimpl_->log_extra_inheritable_.Extend(std::move(key), std::move(value));
+  pimpl_->UpdateInheritableTags([&](logging::LogExtra& tags) {
+    tags.Extend(std::move(key), std::move(value));
+  });
 }
 
 void Span::AddTags(const logging::LogExtra& log_extra, utils::InternalTag) {
-  pimpl_->log_extra_inheritable_.Extend(log_extra);
+  pimpl_->UpdateInheritableTags(
+      [&](logging::LogExtra& tags) { tags.Extend(log_extra); });
 }
 
 impl::TimeStorage& Span::GetTimeStorage() { return pimpl_->GetTimeStorage(); }
 
 std::string Span::GetTag(std::string_view tag) const {
-  const auto& value = pimpl_->log_extra_inheritable_.GetValue(tag);
+  const auto& value = pimpl_->GetInheritableTags().GetValue(tag);
   const auto* s = std::get_if<std::string>(&value);
   if (s)
     return *s;
@@ -353,8 +542,10 @@ std::string Span::GetTag(std::string_view tag) const {
 }
 
 void Span::AddTagFrozen(std::string key, logging::LogExtra::Value value) {
-  pimpl_->log_extra_inheritable_.Extend(std::move(key), std::move(value),
-                                        logging::LogExtra::ExtendType::kFrozen);
+  pimpl_->UpdateInheritableTags([&](logging::LogExtra& tags) {
+    tags.Extend(std::move(key), std::move(value),
+                logging::LogExtra::ExtendType::kFrozen);
+  });
 }
 
 void Span::SetLink(std::string link) {
@@ -375,12 +566,20 @@ void Span::LogTo(logging::LogHelper& log_helper) const& {
 
 bool Span::ShouldLogDefault() const noexcept { return pimpl_->ShouldLog(); }
 
+bool Span::IsSampled() const noexcept { return pimpl_->IsSampled(); }
+
+void Span::SetSampled(bool sampled) { pimpl_->SetSampled(sampled); }
+
+void Span::ForceSampled() { pimpl_->ForceSampled(); }
+
 void Span::DetachFromCoroStack() {
   if (pimpl_) pimpl_->DetachFromCoroStack();
 }
 
 void Span::AttachToCoroStack() { pimpl_->AttachToCoroStack(); }
 
+const std::string& Span::GetName() const { return pimpl_->GetName(); }
+
 const std::string& Span::GetTraceId() const { return pimpl_->GetTraceId(); }
 
 const std::string& Span::GetSpanId() const { return pimpl_->GetSpanId(); }
@@ -0,0 +1,30 @@
+#include <userver/tracing/span_exporter.hpp>
+
+#include <userver/rcu/rcu.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+namespace {
+
+auto& GlobalSpanExporter() {
+  static rcu::Variable<std::shared_ptr<SpanExporter>> exporter;
+  return exporter;
+}
+
+}  // namespace
+
+SpanExporter::~SpanExporter() = default;
+
+std::shared_ptr<SpanExporter> GetSpanExporter() {
+  return GlobalSpanExporter().ReadCopy();
+}
+
+void SetSpanExporter(std::shared_ptr<SpanExporter> exporter) {
+  GlobalSpanExporter().Assign(std::move(exporter));
+}
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
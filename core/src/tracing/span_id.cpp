@@ -0,0 +1,38 @@
+#include <tracing/span_id.hpp>
+
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+template <std::size_t Words>
+HexId<Words> HexId<Words>::Generate() {
+  auto& random = utils::DefaultFastRandom();
+
+  HexId result;
+  for (auto& word : result.binary_) word = random();
+  result.needs_encoding_ = true;
+  return result;
+}
+
+template <std::size_t Words>
+void HexId<Words>::Encode() const {
+  std::array<char, Words * 16> buffer{};
+  auto* out = buffer.data();
+  for (const auto word : binary_) {
+    out = fmt::format_to(out, FMT_COMPILE("{:016x}"), word);
+  }
+  hex_.assign(buffer.data(), buffer.size());
+  needs_encoding_ = false;
+}
+
+template class HexId<1>;
+template class HexId<2>;
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+/// @brief Trace or span id that is generated as a binary value of `Words`
+/// 64-bit words and is hex-encoded only on the first access.
+///
+/// Most of the spans are never logged, so their ids are never encoded. Ids
+/// that came from the outside (e.g. from the request headers) are kept as is.
+/// Not thread-safe, just like the Span itself.
+template <std::size_t Words>
+class HexId final {
+ public:
+  HexId() = default;
+
+  explicit HexId(std::string&& hex) noexcept : hex_(std::move(hex)) {}
+
+  static HexId Generate();
+
+  const std::string& Get() const& {
+    if (needs_encoding_) Encode();
+    return hex_;
+  }
+
+  std::string Get() && {
+    if (needs_encoding_) Encode();
+    return std::move(hex_);
+  }
+
+  bool IsEmpty() const noexcept { return !needs_encoding_ && hex_.empty(); }
+
+ private:
+  void Encode() const;
+
+  std::array<std::uint64_t, Words> binary_{};
+  mutable std::string hex_;
+  mutable bool needs_encoding_{false};
+};
+
+using SpanId = HexId<1>;
+using TraceId = HexId<2>;
+
+extern template class HexId<1>;
+extern template class HexId<2>;
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <list>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -17,6 +18,7 @@
 #include <userver/tracing/span.hpp>
 #include <userver/tracing/tracer.hpp>
 
+#include <tracing/span_id.hpp>
 #include <tracing/time_storage.hpp>
 
 // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
@@ -33,6 +35,10 @@ class ValueBuilder;
 
 namespace tracing {
 
+namespace impl {
+class TailSampling;
+}  // namespace impl
+
 class Span::Impl
     : public boost::intrusive::list_base_hook<
           boost::intrusive::link_mode<boost::intrusive::auto_unlink>> {
@@ -55,16 +61,25 @@ class Span::Impl
 
   void LogTo(logging::LogHelper& log_helper) &&;
 
-  const std::string& GetTraceId() const& noexcept { return trace_id_; }
-  const std::string& GetSpanId() const& noexcept { return span_id_; }
-  const std::string& GetParentId() const& noexcept { return parent_id_; }
+  const std::string& GetName() const noexcept { return name_; }
+
+  const std::string& GetTraceId() const& { return trace_id_.Get(); }
+  const std::string& GetSpanId() const& { return span_id_.Get(); }
+  const std::string& GetParentId() const& { return parent_id_.Get(); }
 
-  std::string GetTraceId() && noexcept { return std::move(trace_id_); }
-  std::string GetSpanId() && noexcept { return std::move(span_id_); }
-  std::string GetParentId() && noexcept { return std::move(parent_id_); }
+  std::string GetTraceId() && { return std::move(trace_id_).Get(); }
+  std::string GetSpanId() && { return std::move(span_id_).Get(); }
+  std::string GetParentId() && { return std::move(parent_id_).Get(); }
 
-  void SetTraceId(std::string&& id) noexcept { trace_id_ = std::move(id); }
-  void SetParentId(std::string&& id) noexcept { parent_id_ = std::move(id); }
+  void SetTraceId(std::string&& id) noexcept {
+    trace_id_ = impl::TraceId{std::move(id)};
+  }
+  void SetParentId(std::string&& id) noexcept {
+    parent_id_ = impl::SpanId{std::move(id)};
+  }
+
+  /// Tags that are inherited by the child spans
+  const logging::LogExtra& GetInheritableTags() const noexcept;
 
   ReferenceType GetReferenceType() const noexcept { return reference_type_; }
 
@@ -72,14 +87,28 @@ class Span::Impl
   void AttachToCoroStack();
   void PutIntoLogger(logging::LogHelper& lh);
 
+  /// Writes the finished span into the default logger
+  void LogFinished();
+
+  bool IsSampled() const noexcept { return is_sampled_; }
+  void SetSampled(bool sampled);
+  void ForceSampled();
+
  private:
+  std::chrono::steady_clock::duration GetDuration() const;
+  void ExportSpan() const;
   void LogOpenTracing() const;
   void DoLogOpenTracing(logging::LogHelper& lh) const;
   static void AddOpentracingTags(formats::json::StringBuilder& output,
                                  const logging::LogExtra& input);
 
-  static std::string GetParentIdForLogging(const Span::Impl* parent);
+  template <typename Func>
+  void UpdateInheritableTags(Func&& update);
+
+  static impl::SpanId GetParentIdForLogging(const Span::Impl* parent);
   bool ShouldLog() const;
+  bool HasErrorTag() const;
+  void InitSampling(const Span::Impl* parent);
 
   const std::string name_;
   const bool is_no_log_span_;
@@ -87,7 +116,9 @@ class Span::Impl
   std::optional<logging::Level> local_log_level_;
 
   std::shared_ptr<Tracer> tracer_;
-  logging::LogExtra log_extra_inheritable_;
+  // Shared with the parent and the children, never changed in place as they
+  // may read it from other threads. Adding a tag replaces it with a copy.
+  std::shared_ptr<const logging::LogExtra> log_extra_inheritable_;
 
   Span* span_{nullptr};
 
@@ -97,11 +128,17 @@ class Span::Impl
   const std::chrono::system_clock::time_point start_system_time_;
   const std::chrono::steady_clock::time_point start_steady_time_;
 
-  std::string trace_id_;
-  std::string span_id_;
-  std::string parent_id_;
+  impl::TraceId trace_id_;
+  impl::SpanId span_id_;
+  impl::SpanId parent_id_;
   const ReferenceType reference_type_;
 
+  bool is_sampled_{true};
+  // Set for the spans of not sampled traces if the tail sampling is enabled
+  std::shared_ptr<impl::TailSampling> tail_sampling_;
+  bool is_sampling_root_{false};
+  std::optional<std::chrono::steady_clock::duration> finished_duration_;
+
   friend class Span;
 };
 
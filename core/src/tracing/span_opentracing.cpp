@@ -19,22 +19,25 @@ struct OpentracingTag {
   std::string type;
 };
 
-const std::unordered_map<std::string, OpentracingTag>& GetOpentracingTags() {
-  static const std::unordered_map<std::string, OpentracingTag> opentracing_tags{
-      {kHttpStatusCode, {"http.status_code", "int64"}},
-      {kErrorFlag, {"error", "bool"}},
-      {kHttpMethod, {"http.method", "string"}},
-      {kHttpUrl, {"http.url", "string"}},
-
-      {kDatabaseType, {"db.type", "string"}},
-      {kDatabaseStatement, {"db.statement", "string"}},
-      {kDatabaseInstance, {"db.instance", "string"}},
-      {kDatabaseStatementName, {"db.statement_name", "string"}},
-      {kDatabaseCollection, {"db.collection", "string"}},
-      {kDatabaseStatementDescription, {"db.query_description", "string"}},
-
-      {kPeerAddress, {"peer.address", "string"}},
-  };
+// Keys refer to the global tag names
+const std::unordered_map<std::string_view, OpentracingTag>&
+GetOpentracingTags() {
+  static const std::unordered_map<std::string_view, OpentracingTag>
+      opentracing_tags{
+          {kHttpStatusCode, {"http.status_code", "int64"}},
+          {kErrorFlag, {"error", "bool"}},
+          {kHttpMethod, {"http.method", "string"}},
+          {kHttpUrl, {"http.url", "string"}},
+
+          {kDatabaseType, {"db.type", "string"}},
+          {kDatabaseStatement, {"db.statement", "string"}},
+          {kDatabaseInstance, {"db.instance", "string"}},
+          {kDatabaseStatementName, {"db.statement_name", "string"}},
+          {kDatabaseCollection, {"db.collection", "string"}},
+          {kDatabaseStatementDescription, {"db.query_description", "string"}},
+
+          {kPeerAddress, {"peer.address", "string"}},
+      };
 
   return opentracing_tags;
 }
@@ -85,10 +88,9 @@ void Span::Impl::LogOpenTracing() const {
 }
 
 void Span::Impl::DoLogOpenTracing(logging::LogHelper& lh) const {
-  const auto steady_now = std::chrono::steady_clock::now();
-  const auto duration = steady_now - start_steady_time_;
   const auto duration_microseconds =
-      std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+      std::chrono::duration_cast<std::chrono::microseconds>(GetDuration())
+          .count();
   auto start_time = std::chrono::duration_cast<std::chrono::microseconds>(
                         start_system_time_.time_since_epoch())
                         .count();
@@ -96,9 +98,9 @@ void Span::Impl::DoLogOpenTracing(logging::LogHelper& lh) const {
   if (tracer_) {
     PutData(lh, jaeger::kServiceName, tracer_->GetServiceName());
   }
-  PutData(lh, jaeger::kTraceId, trace_id_);
-  PutData(lh, jaeger::kParentId, parent_id_);
-  PutData(lh, jaeger::kSpanId, span_id_);
+  PutData(lh, jaeger::kTraceId, GetTraceId());
+  PutData(lh, jaeger::kParentId, GetParentId());
+  PutData(lh, jaeger::kSpanId, GetSpanId());
   PutData(lh, jaeger::kStartTime, start_time);
   PutData(lh, jaeger::kStartTimeMillis, start_time / 1000);
   PutData(lh, jaeger::kDuration, duration_microseconds);
@@ -107,7 +109,7 @@ void Span::Impl::DoLogOpenTracing(logging::LogHelper& lh) const {
   formats::json::StringBuilder tags;
   {
     formats::json::StringBuilder::ArrayGuard guard(tags);
-    AddOpentracingTags(tags, log_extra_inheritable_);
+    AddOpentracingTags(tags, GetInheritableTags());
     if (log_extra_local_) {
       AddOpentracingTags(tags, *log_extra_local_);
     }
@@ -119,7 +121,7 @@ void Span::Impl::AddOpentracingTags(formats::json::StringBuilder& output,
                                     const logging::LogExtra& input) {
   const auto& opentracing_tags = jaeger::GetOpentracingTags();
   for (const auto& [key, value] : *input.extra_) {
-    const auto tag_it = opentracing_tags.find(key);
+    const auto tag_it = opentracing_tags.find(key.GetView());
     if (tag_it != opentracing_tags.end()) {
       const auto& tag = tag_it->second;
       jaeger::GetTagObject(output, tag.opentracing_name, value.GetValue(),
@@ -3,11 +3,13 @@
 
 #include <logging/logging_test.hpp>
 #include <tracing/no_log_spans.hpp>
+#include <tracing/sampling.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/tracing/noop.hpp>
 #include <userver/tracing/opentracing.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utest/utest.hpp>
 
@@ -15,6 +17,34 @@ USERVER_NAMESPACE_BEGIN
 
 class Span : public LoggingTest {};
 
+class SpanSampling : public Span {
+ protected:
+  void TearDown() override {
+    tracing::Tracer::SetSampling(tracing::Sampling{});
+    Span::TearDown();
+  }
+
+  static void SetSampling(double head_probability, bool tail_enabled,
+                          std::chrono::milliseconds slow_threshold = {}) {
+    tracing::Sampling sampling;
+    sampling.head_probability = head_probability;
+    sampling.tail_enabled = tail_enabled;
+    sampling.tail_slow_threshold = slow_threshold;
+    tracing::Tracer::SetSampling(std::move(sampling));
+  }
+
+  static tracing::Span MakeRootSpan(std::string name) {
+    return tracing::Tracer::GetTracer()->CreateSpanWithoutParent(
+        std::move(name));
+  }
+
+  bool IsSpanLogged(std::string_view name) {
+    logging::LogFlush();
+    return GetStreamString().find(fmt::format("stopwatch_name={}\t", name)) !=
+           std::string::npos;
+  }
+};
+
 class OpentracingSpan : public Span {
  protected:
   void SetUp() override {
@@ -110,6 +140,36 @@ UTEST_F(Span, InheritTag) {
   EXPECT_NE(std::string::npos, GetStreamString().find("k=v"));
 }
 
+UTEST_F(Span, ChildTagDoesNotChangeParent) {
+  tracing::Span span("span_name");
+  span.AddTag("k", "v");
+  {
+    tracing::Span child("child");
+    child.AddTag("k", "child_v");
+    child.AddTag("child_k", "child_v");
+  }
+  logging::LogFlush();
+  EXPECT_NE(std::string::npos, GetStreamString().find("k=child_v"));
+  ClearLog();
+
+  tracing::Span child2("child2");
+  LOG_INFO() << "inside";
+  logging::LogFlush();
+  EXPECT_NE(std::string::npos, GetStreamString().find("k=v"));
+  EXPECT_EQ(std::string::npos, GetStreamString().find("child_v"));
+}
+
+UTEST_F(Span, Ids) {
+  tracing::Span span("span_name");
+  EXPECT_EQ(span.GetTraceId().size(), 32);
+  EXPECT_EQ(span.GetSpanId().size(), 16);
+
+  tracing::Span child("child");
+  EXPECT_EQ(child.GetTraceId(), span.GetTraceId());
+  EXPECT_EQ(child.GetParentId(), span.GetSpanId());
+  EXPECT_NE(child.GetSpanId(), span.GetSpanId());
+}
+
 UTEST_F(Span, NonInheritTag) {
   tracing::Span span("span_name");
 
@@ -651,4 +711,84 @@ UTEST_F(Span, MakeSpanWithParentIdTraceIdLinkWithExisting) {
   }
 }
 
+UTEST_F(SpanSampling, HeadSamplingDropsTrace) {
+  SetSampling(0.0, false);
+  {
+    auto root = MakeRootSpan("root_span");
+    EXPECT_FALSE(root.IsSampled());
+
+    auto child = root.CreateChild("child_span");
+    EXPECT_FALSE(child.IsSampled());
+  }
+
+  EXPECT_FALSE(IsSpanLogged("root_span"));
+  EXPECT_FALSE(IsSpanLogged("child_span"));
+}
+
+UTEST_F(SpanSampling, SetSampledOverridesHeadSampling) {
+  SetSampling(0.0, false);
+  {
+    auto root = MakeRootSpan("root_span");
+    root.SetSampled(true);
+    auto child = root.CreateChild("child_span");
+    EXPECT_TRUE(child.IsSampled());
+  }
+
+  EXPECT_TRUE(IsSpanLogged("root_span"));
+  EXPECT_TRUE(IsSpanLogged("child_span"));
+}
+
+UTEST_F(SpanSampling, TailSamplingDropsFastTrace) {
+  SetSampling(0.0, true, std::chrono::hours{1});
+  {
+    auto root = MakeRootSpan("root_span");
+    auto child = root.CreateChild("child_span");
+  }
+
+  EXPECT_FALSE(IsSpanLogged("root_span"));
+  EXPECT_FALSE(IsSpanLogged("child_span"));
+}
+
+UTEST_F(SpanSampling, TailSamplingKeepsSlowTrace) {
+  SetSampling(0.0, true, std::chrono::milliseconds{1});
+  {
+    auto root = MakeRootSpan("root_span");
+    { auto child = root.CreateChild("child_span"); }
+    EXPECT_FALSE(IsSpanLogged("child_span"));
+
+    engine::SleepFor(std::chrono::milliseconds{2});
+  }
+
+  EXPECT_TRUE(IsSpanLogged("root_span"));
+  EXPECT_TRUE(IsSpanLogged("child_span"));
+}
+
+UTEST_F(SpanSampling, TailSamplingKeepsErroredTrace) {
+  SetSampling(0.0, true, std::chrono::hours{1});
+  {
+    auto root = MakeRootSpan("root_span");
+    { auto child = root.CreateChild("child_span"); }
+    {
+      auto failed = root.CreateChild("failed_span");
+      failed.AddTag(tracing::kErrorFlag, true);
+    }
+    EXPECT_TRUE(IsSpanLogged("child_span"));
+    EXPECT_TRUE(IsSpanLogged("failed_span"));
+  }
+
+  EXPECT_TRUE(IsSpanLogged("root_span"));
+}
+
+UTEST_F(SpanSampling, ForceSampledKeepsTrace) {
+  SetSampling(0.0, true, std::chrono::hours{1});
+  {
+    auto root = MakeRootSpan("root_span");
+    { auto child = root.CreateChild("child_span"); }
+    root.ForceSampled();
+    EXPECT_TRUE(IsSpanLogged("child_span"));
+  }
+
+  EXPECT_TRUE(IsSpanLogged("root_span"));
+}
+
 USERVER_NAMESPACE_END
@@ -26,6 +26,11 @@ class TimeStorage {
   /// Accumulated time for a certain key. If the key is not there, returns 0
   Duration DurationTotal(const std::string& key) const;
 
+  /// Accumulated time of all the keys
+  const std::unordered_map<std::string, Duration>& GetAll() const {
+    return data_;
+  }
+
   void MergeInto(logging::LogHelper& lh);
 
  private:
@@ -3,6 +3,7 @@
 #include <atomic>
 
 #include <tracing/no_log_spans.hpp>
+#include <tracing/sampling.hpp>
 #include <userver/rcu/rcu.hpp>
 #include <userver/tracing/noop.hpp>
 #include <userver/utils/uuid4.hpp>
@@ -18,6 +19,11 @@ auto& GlobalNoLogSpans() {
   return spans;
 }
 
+auto& GlobalSampling() {
+  static rcu::Variable<Sampling> sampling{};
+  return sampling;
+}
+
 auto& GlobalTracer() {
   static const std::string kEmptyServiceName;
   static rcu::Variable<TracerPtr> tracer(
@@ -63,6 +69,12 @@ bool Tracer::IsNoLogSpan(const std::string& name) {
          spans->names.find(name) != spans->names.end();
 }
 
+void Tracer::SetSampling(Sampling&& sampling) {
+  GlobalSampling().Assign(std::move(sampling));
+}
+
+Sampling Tracer::GetSampling() { return GlobalSampling().ReadCopy(); }
+
 void Tracer::SetTracer(std::shared_ptr<Tracer> tracer) {
   GlobalTracer().Assign(tracer);
 }
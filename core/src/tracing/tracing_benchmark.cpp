@@ -33,6 +33,23 @@ void tracing_happy_log(benchmark::State& state) {
 }
 BENCHMARK(tracing_happy_log);
 
+void tracing_child_ctr(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    auto tracer = tracing::MakeNoopTracer("test_service");
+    auto parent = tracer->CreateSpanWithoutParent("parent");
+    parent.AddTag("meta_code", 200);
+    parent.AddTag("http.url", "http://example.com/example");
+    parent.SetLogLevel(logging::Level::kNone);
+
+    for (auto _ : state) {
+      auto span = parent.CreateChild("child");
+      span.SetLogLevel(logging::Level::kNone);
+      benchmark::DoNotOptimize(span);
+    }
+  });
+}
+BENCHMARK(tracing_child_ctr);
+
 tracing::Span GetSpanWithOpentracingHttpTags(tracing::TracerPtr tracer) {
   auto span = tracer->CreateSpanWithoutParent("name");
   span.AddTag("meta_code", 200);
@@ -0,0 +1,71 @@
+#include <ubench/allocations.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// Checked on every allocation, the counter is touched only during the
+// allocations counting runs to not affect the timings
+std::atomic<bool> is_counting{false};
+std::atomic<std::int64_t> allocations{0};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  if (is_counting.load(std::memory_order_relaxed)) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  if (size == 0) size = 1;
+  while (true) {
+    if (void* ptr = std::malloc(size)) return ptr;
+    const auto handler = std::get_new_handler();
+    if (!handler) throw std::bad_alloc{};
+    handler();
+  }
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ubench {
+
+namespace {
+
+// The methods are not marked `override` as google-benchmark has changed the
+// signature of Stop() between the versions
+class AllocationsCounter final : public benchmark::MemoryManager {
+ public:
+  void Start() {
+    allocations = 0;
+    is_counting = true;
+  }
+
+  void Stop(Result* result) { Stop(*result); }
+
+  void Stop(Result& result) {
+    is_counting = false;
+    result.num_allocs = allocations.load();
+  }
+};
+
+}  // namespace
+
+void RegisterAllocationsCounter() {
+  static AllocationsCounter counter;
+  benchmark::RegisterMemoryManager(&counter);
+}
+
+}  // namespace ubench
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,14 @@
+#pragma once
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ubench {
+
+/// Makes google-benchmark report `allocs_per_iter` for each benchmark,
+/// counted over all the threads of the process in an additional run of the
+/// benchmark.
+void RegisterAllocationsCounter();
+
+}  // namespace ubench
+
+USERVER_NAMESPACE_END
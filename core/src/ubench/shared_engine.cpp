@@ -0,0 +1,66 @@
+#include <ubench/shared_engine.hpp>
+
+#include <mutex>
+#include <optional>
+
+#include <engine/impl/standalone.hpp>
+#include <engine/task/task_processor.hpp>
+#include <userver/engine/benchmark_helpers.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct SharedEngine {
+  std::mutex mutex;
+  std::size_t worker_threads{0};
+  std::optional<engine::impl::TaskProcessorHolder> task_processor;
+};
+
+SharedEngine& GetSharedEngine() {
+  static SharedEngine engine;
+  return engine;
+}
+
+}  // namespace
+
+namespace engine {
+
+void RunInSharedEngine(std::size_t worker_threads,
+                       std::function<void()> payload) {
+  UINVARIANT(!engine::current_task::GetTaskProcessorOptional(),
+             "RunInSharedEngine must not be used from a running engine");
+  UINVARIANT(worker_threads != 0, "Unable to run anything using 0 threads");
+
+  auto& shared = GetSharedEngine();
+  std::lock_guard lock(shared.mutex);
+  if (shared.worker_threads != worker_threads) {
+    // Only a single engine instance may exist at a time
+    shared.task_processor.reset();
+    shared.worker_threads = 0;
+    shared.task_processor.emplace(engine::impl::TaskProcessorHolder::Make(
+        worker_threads, "coro-runner",
+        engine::impl::MakeTaskProcessorPools({})));
+    shared.worker_threads = worker_threads;
+  }
+
+  engine::impl::RunOnTaskProcessorSync(**shared.task_processor,
+                                       std::move(payload));
+}
+
+}  // namespace engine
+
+namespace ubench {
+
+void DestroySharedEngine() {
+  auto& shared = GetSharedEngine();
+  std::lock_guard lock(shared.mutex);
+  shared.task_processor.reset();
+  shared.worker_threads = 0;
+}
+
+}  // namespace ubench
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,13 @@
+#pragma once
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ubench {
+
+/// Stops the engine of engine::RunInSharedEngine, must be called before the
+/// exit from main()
+void DestroySharedEngine();
+
+}  // namespace ubench
+
+USERVER_NAMESPACE_END
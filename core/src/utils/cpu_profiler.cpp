@@ -0,0 +1,280 @@
+#include <utils/cpu_profiler.hpp>
+
+#include <signal.h>
+#include <sys/time.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#include <boost/stacktrace/safe_dump_to.hpp>
+
+#include <engine/task/task_context.hpp>
+#include <engine/task/task_processor.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/logging/stacktrace_cache.hpp>
+#include <utils/strerror.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::cpu_profiler {
+
+namespace {
+
+constexpr std::size_t kMaxFrames = 64;
+constexpr std::size_t kMaxSpanNameSize = 64;
+constexpr std::size_t kMaxFrequency = 10000;
+
+constexpr std::string_view kNoTaskProcessor = "[no task processor]";
+constexpr std::string_view kNoSpan = "[no span]";
+
+struct Sample {
+  // +1 for the terminating nullptr written by safe_dump_to
+  std::array<const void*, kMaxFrames + 1> frames;
+  std::size_t frames_count;
+  std::array<char, kMaxSpanNameSize> span_name;
+  std::size_t span_name_size;
+  // Task processors live until the service stops, nullptr for non-task threads
+  const std::string* task_processor;
+};
+
+// Written under control_mutex while the sampling is stopped, read-only for
+// the signal handler.
+struct SamplingState {
+  std::unique_ptr<Sample[]> samples;
+  std::size_t max_samples{0};
+  std::vector<std::string> task_processors;
+};
+
+std::mutex control_mutex;
+bool signal_handler_installed = false;
+SamplingState state;
+
+std::atomic<bool> is_running{false};
+std::atomic<std::size_t> handlers_in_flight{0};
+std::atomic<std::size_t> next_sample{0};
+std::atomic<std::size_t> dropped_samples{0};
+
+bool ShouldSample(const std::string* task_processor) noexcept {
+  if (state.task_processors.empty()) return true;
+  if (!task_processor) return false;
+  return std::find(state.task_processors.begin(), state.task_processors.end(),
+                   *task_processor) != state.task_processors.end();
+}
+
+// Does not allocate and does not take locks, reads only the thread-local
+// current task and the span name it publishes.
+void OnSigProf(int) {
+  const auto saved_errno = errno;
+  handlers_in_flight.fetch_add(1);
+
+  if (is_running.load()) {
+    const auto* task_processor_ptr =
+        engine::current_task::GetTaskProcessorOptional();
+    const auto* task_processor =
+        task_processor_ptr ? &task_processor_ptr->Name() : nullptr;
+
+    if (ShouldSample(task_processor)) {
+      const auto index = next_sample.fetch_add(1, std::memory_order_relaxed);
+      if (index < state.max_samples) {
+        auto& sample = state.samples[index];
+        // skips this handler and the signal trampoline
+        const auto dumped = boost::stacktrace::safe_dump_to(
+            2, sample.frames.data(), sizeof(sample.frames));
+        sample.frames_count = dumped ? dumped - 1 : 0;
+
+        sample.span_name_size = 0;
+        const auto* context =
+            engine::current_task::GetCurrentTaskContextUnchecked();
+        if (const auto* name =
+                context ? context->GetProfilerSpanName() : nullptr) {
+          sample.span_name_size = std::min(name->size(), kMaxSpanNameSize);
+          std::memcpy(sample.span_name.data(), name->data(),
+                      sample.span_name_size);
+        }
+        sample.task_processor = task_processor;
+      } else {
+        dropped_samples.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  handlers_in_flight.fetch_sub(1);
+  errno = saved_errno;
+}
+
+void InstallSignalHandler() {
+  if (signal_handler_installed) return;
+
+  struct sigaction action {};
+  action.sa_handler = &OnSigProf;
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+
+  struct sigaction old_action {};
+  if (sigaction(SIGPROF, &action, &old_action) == -1) {
+    throw std::runtime_error("sigaction() failed: " +
+                             utils::strerror(errno));
+  }
+  if (old_action.sa_handler != SIG_DFL && old_action.sa_handler != SIG_IGN) {
+    sigaction(SIGPROF, &old_action, nullptr);
+    throw std::runtime_error("SIGPROF handler is already installed");
+  }
+
+  // Never uninstalled, a SIGPROF that is delivered after the timer is
+  // disarmed would otherwise terminate the process.
+  signal_handler_installed = true;
+}
+
+void SetTimer(std::size_t frequency) {
+  struct itimerval timer {};
+  if (frequency) {
+    const auto period_us = std::max<std::size_t>(1000000 / frequency, 1);
+    timer.it_interval.tv_sec = period_us / 1000000;
+    timer.it_interval.tv_usec = period_us % 1000000;
+    timer.it_value = timer.it_interval;
+  }
+  if (setitimer(ITIMER_PROF, &timer, nullptr) == -1) {
+    throw std::runtime_error("setitimer() failed: " + utils::strerror(errno));
+  }
+}
+
+// Function name without the source location, with the separators of the
+// folded format replaced
+std::string FrameName(const void* address) {
+  auto name = logging::stacktrace_cache::frame_to_string(address);
+  for (const std::string_view location_sep : {" at ", " in "}) {
+    const auto pos = name.find(location_sep);
+    if (pos != std::string::npos) {
+      name.resize(pos);
+      break;
+    }
+  }
+  std::replace(name.begin(), name.end(), ';', ':');
+  return name;
+}
+
+std::string Fold(const Sample* samples, std::size_t samples_count) {
+  std::unordered_map<const void*, std::string> frame_names;
+  const auto get_frame_name = [&frame_names](const void* address) -> auto& {
+    auto [it, inserted] = frame_names.try_emplace(address);
+    if (inserted) it->second = FrameName(address);
+    return it->second;
+  };
+
+  std::map<std::string, std::size_t> stacks;
+  std::vector<const std::string*> frames;
+  std::string stack;
+  for (std::size_t i = 0; i < samples_count; ++i) {
+    const auto& sample = samples[i];
+
+    frames.clear();
+    for (std::size_t j = 0; j < sample.frames_count; ++j) {
+      const auto& name = get_frame_name(sample.frames[j]);
+      // the rest is the common coroutine start boilerplate
+      if (name.empty()) break;
+      frames.push_back(&name);
+    }
+
+    stack.clear();
+    stack += sample.task_processor ? std::string_view{*sample.task_processor}
+                                   : kNoTaskProcessor;
+    stack += ';';
+    if (sample.span_name_size) {
+      const auto span_begin = stack.size();
+      stack.append(sample.span_name.data(), sample.span_name_size);
+      std::replace(stack.begin() + span_begin, stack.end(), ';', ':');
+    } else {
+      stack += kNoSpan;
+    }
+    for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+      stack += ';';
+      stack += **it;
+    }
+
+    ++stacks[stack];
+  }
+
+  std::string result;
+  for (const auto& [folded_stack, count] : stacks) {
+    result += folded_stack;
+    result += ' ';
+    result += std::to_string(count);
+    result += '\n';
+  }
+  return result;
+}
+
+}  // namespace
+
+void Start(const Settings& settings) {
+  if (settings.frequency == 0 || settings.frequency > kMaxFrequency) {
+    throw std::runtime_error("CPU profiler frequency must be in [1, " +
+                             std::to_string(kMaxFrequency) + "]");
+  }
+
+  std::lock_guard lock(control_mutex);
+  if (is_running.load()) {
+    throw std::runtime_error("CPU profiler is already running");
+  }
+
+  InstallSignalHandler();
+
+  state.samples = std::make_unique<Sample[]>(settings.max_samples);
+  state.max_samples = settings.max_samples;
+  state.task_processors = settings.task_processors;
+  next_sample.store(0);
+  dropped_samples.store(0);
+
+  is_running.store(true);
+  try {
+    SetTimer(settings.frequency);
+  } catch (const std::exception&) {
+    is_running.store(false);
+    throw;
+  }
+}
+
+Profile Stop() {
+  std::lock_guard lock(control_mutex);
+  if (!is_running.load()) {
+    throw std::runtime_error("CPU profiler is not running");
+  }
+
+  SetTimer(0);
+  is_running.store(false);
+  // handlers that have seen is_running == true may still write the samples
+  while (handlers_in_flight.load() != 0) std::this_thread::yield();
+
+  Profile profile;
+  // next_sample also counts the dropped samples
+  profile.samples = std::min(next_sample.load(), state.max_samples);
+  profile.dropped_samples = dropped_samples.load();
+  profile.folded = Fold(state.samples.get(), profile.samples);
+
+  state = {};
+  return profile;
+}
+
+Status GetStatus() {
+  std::lock_guard lock(control_mutex);
+  Status status;
+  status.running = is_running.load();
+  if (status.running) {
+    status.samples = std::min(next_sample.load(), state.max_samples);
+    status.dropped_samples = dropped_samples.load();
+  }
+  return status;
+}
+
+}  // namespace utils::cpu_profiler
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+/// Sampling CPU profiler based on SIGPROF.
+///
+/// The samples are taken with the frequency that is counted in the CPU time
+/// of the whole process, i.e. a process that fully loads 4 cores gets about
+/// 4 * frequency samples per second. Each sample records the native stack of
+/// the interrupted thread, the name of the current span and the task
+/// processor of the current task.
+namespace utils::cpu_profiler {
+
+struct Settings {
+  // Samples per second of the process CPU time
+  std::size_t frequency{100};
+  // Task processors to sample, all threads are sampled if empty
+  std::vector<std::string> task_processors;
+  // Memory for the samples is preallocated, the rest of samples are dropped
+  std::size_t max_samples{20000};
+};
+
+struct Profile {
+  // Stacks in the "folded" format of FlameGraph:
+  // `task_processor;span;outer_frame;...;inner_frame count`
+  std::string folded;
+  std::size_t samples{0};
+  std::size_t dropped_samples{0};
+};
+
+struct Status {
+  bool running{false};
+  std::size_t samples{0};
+  std::size_t dropped_samples{0};
+};
+
+/// Starts the sampling, throws std::runtime_error if it is already running
+void Start(const Settings& settings);
+
+/// Stops the sampling and returns the collected samples, throws
+/// std::runtime_error if the sampling is not running
+Profile Stop();
+
+Status GetStatus();
+
+}  // namespace utils::cpu_profiler
+
+USERVER_NAMESPACE_END
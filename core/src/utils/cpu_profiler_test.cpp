@@ -0,0 +1,95 @@
+#include <utils/cpu_profiler.hpp>
+
+#include <chrono>
+
+#include <userver/engine/task/task.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+
+#include <engine/task/task_processor.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+volatile std::size_t sink = 0;
+
+void BurnCpu(std::chrono::milliseconds duration) {
+  const auto deadline = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < deadline) {
+    for (std::size_t i = 0; i < 10000; ++i) sink = sink + i;
+  }
+}
+
+}  // namespace
+
+UTEST(CpuProfiler, Folded) {
+  const auto& task_processor_name =
+      engine::current_task::GetTaskProcessor().Name();
+  tracing::Span span("cpu_profiler_test");
+
+  utils::cpu_profiler::Settings settings;
+  settings.frequency = 1000;
+  settings.task_processors = {task_processor_name};
+  utils::cpu_profiler::Start(settings);
+  EXPECT_TRUE(utils::cpu_profiler::GetStatus().running);
+  EXPECT_THROW(utils::cpu_profiler::Start(settings), std::runtime_error);
+
+  BurnCpu(std::chrono::milliseconds{300});
+
+  const auto profile = utils::cpu_profiler::Stop();
+  EXPECT_FALSE(utils::cpu_profiler::GetStatus().running);
+  EXPECT_THROW(utils::cpu_profiler::Stop(), std::runtime_error);
+
+  EXPECT_GT(profile.samples, 0);
+  EXPECT_EQ(profile.dropped_samples, 0);
+  const auto prefix = task_processor_name + ";cpu_profiler_test;";
+  EXPECT_EQ(profile.folded.rfind(prefix, 0), 0) << profile.folded;
+}
+
+UTEST(CpuProfiler, InnermostSpan) {
+  const auto& task_processor_name =
+      engine::current_task::GetTaskProcessor().Name();
+  tracing::Span outer("cpu_profiler_outer");
+  { tracing::Span inner("cpu_profiler_inner"); }
+
+  utils::cpu_profiler::Settings settings;
+  settings.frequency = 1000;
+  settings.task_processors = {task_processor_name};
+  utils::cpu_profiler::Start(settings);
+
+  BurnCpu(std::chrono::milliseconds{100});
+
+  const auto profile = utils::cpu_profiler::Stop();
+  EXPECT_GT(profile.samples, 0);
+  const auto prefix = task_processor_name + ";cpu_profiler_outer;";
+  EXPECT_EQ(profile.folded.rfind(prefix, 0), 0) << profile.folded;
+}
+
+UTEST(CpuProfiler, TaskProcessorFilter) {
+  utils::cpu_profiler::Settings settings;
+  settings.frequency = 1000;
+  settings.task_processors = {"missing-task-processor"};
+  utils::cpu_profiler::Start(settings);
+
+  BurnCpu(std::chrono::milliseconds{100});
+
+  const auto profile = utils::cpu_profiler::Stop();
+  EXPECT_EQ(profile.samples, 0);
+  EXPECT_EQ(profile.folded, "");
+}
+
+UTEST(CpuProfiler, MaxSamples) {
+  utils::cpu_profiler::Settings settings;
+  settings.frequency = 1000;
+  settings.max_samples = 1;
+  utils::cpu_profiler::Start(settings);
+
+  BurnCpu(std::chrono::milliseconds{100});
+
+  const auto profile = utils::cpu_profiler::Stop();
+  EXPECT_EQ(profile.samples, 1);
+  EXPECT_GT(profile.dropped_samples, 0);
+}
+
+USERVER_NAMESPACE_END
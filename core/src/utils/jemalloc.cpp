@@ -6,6 +6,12 @@
 #include <cerrno>
 #endif
 
+#include <sys/types.h>
+
+#include <cstdint>
+
+#include <fmt/format.h>
+
 #include <userver/utils/thread_name.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -36,6 +42,20 @@ std::error_code MallCtl(const char* name) {
   return MakeErrorCode(rc);
 }
 
+template <typename T>
+std::error_code MallCtlRead(const char* name, T& value) {
+  size_t size = sizeof(value);
+  int rc = mallctl(name, &value, &size, nullptr, 0);
+  return MakeErrorCode(rc);
+}
+
+std::error_code RefreshStats() {
+  std::uint64_t epoch = 1;
+  size_t size = sizeof(epoch);
+  int rc = mallctl("epoch", &epoch, &size, &epoch, size);
+  return MakeErrorCode(rc);
+}
+
 void MallocStatPrintCb(void* data, const char* msg) {
   auto* s = static_cast<std::string*>(data);
   *s += msg;
@@ -68,6 +88,68 @@ std::error_code StopBgThreads() {
   return MallCtl<bool>("background_thread", false);
 }
 
+#ifdef JEMALLOC_ENABLED
+static_assert(kAllArenas == MALLCTL_ARENAS_ALL);
+#endif
+
+std::error_code CreateArena(unsigned& arena) {
+  return MallCtlRead("arenas.create", arena);
+}
+
+std::error_code SetThreadArena(unsigned arena) {
+  return MallCtl<unsigned>("thread.arena", arena);
+}
+
+std::error_code SetThreadTcacheEnabled(bool enabled) {
+  return MallCtl<bool>("thread.tcache.enabled", enabled);
+}
+
+std::error_code SetArenaDirtyDecay(unsigned arena,
+                                   std::chrono::milliseconds decay) {
+  const auto name = fmt::format("arena.{}.dirty_decay_ms", arena);
+  return MallCtl<ssize_t>(name.c_str(), decay.count());
+}
+
+std::error_code SetArenaMuzzyDecay(unsigned arena,
+                                   std::chrono::milliseconds decay) {
+  const auto name = fmt::format("arena.{}.muzzy_decay_ms", arena);
+  return MallCtl<ssize_t>(name.c_str(), decay.count());
+}
+
+std::error_code DecayArena(unsigned arena) {
+  return MallCtl(fmt::format("arena.{}.decay", arena).c_str());
+}
+
+std::error_code PurgeArena(unsigned arena) {
+  return MallCtl(fmt::format("arena.{}.purge", arena).c_str());
+}
+
+std::error_code GetArenaStats(unsigned arena, ArenaStats& stats) {
+  if (auto ec = RefreshStats()) return ec;
+
+  const auto prefix = fmt::format("stats.arenas.{}.", arena);
+  const auto read = [&prefix](const char* name, size_t& value) {
+    return MallCtlRead((prefix + name).c_str(), value);
+  };
+
+  size_t small_allocated = 0;
+  size_t large_allocated = 0;
+  size_t active_pages = 0;
+  size_t page_size = 0;
+  for (auto ec : {read("small.allocated", small_allocated),
+                  read("large.allocated", large_allocated),
+                  read("pactive", active_pages),
+                  read("resident", stats.resident),
+                  read("mapped", stats.mapped),
+                  MallCtlRead("arenas.page", page_size)}) {
+    if (ec) return ec;
+  }
+
+  stats.allocated = small_allocated + large_allocated;
+  stats.active = active_pages * page_size;
+  return {};
+}
+
 }  // namespace utils::jemalloc
 
 USERVER_NAMESPACE_END
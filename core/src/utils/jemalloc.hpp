@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <string>
 #include <system_error>
 
@@ -22,6 +24,38 @@ std::error_code EnableBgThreads();
 // blocking
 std::error_code StopBgThreads();
 
+/// Index that refers to all the arenas at once, MALLCTL_ARENAS_ALL
+inline constexpr unsigned kAllArenas = 4096;
+
+/// Memory of an arena in bytes
+struct ArenaStats {
+  std::size_t allocated{0};
+  std::size_t active{0};
+  std::size_t resident{0};
+  std::size_t mapped{0};
+};
+
+std::error_code CreateArena(unsigned& arena);
+
+std::error_code SetThreadArena(unsigned arena);
+
+std::error_code SetThreadTcacheEnabled(bool enabled);
+
+/// Negative value disables the decay, the pages are never purged
+std::error_code SetArenaDirtyDecay(unsigned arena,
+                                   std::chrono::milliseconds decay);
+
+std::error_code SetArenaMuzzyDecay(unsigned arena,
+                                   std::chrono::milliseconds decay);
+
+/// Purges the unused pages that have decayed
+std::error_code DecayArena(unsigned arena);
+
+/// Purges all the unused pages
+std::error_code PurgeArena(unsigned arena);
+
+std::error_code GetArenaStats(unsigned arena, ArenaStats& stats);
+
 }  // namespace utils::jemalloc
 
 USERVER_NAMESPACE_END
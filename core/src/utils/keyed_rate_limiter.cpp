@@ -0,0 +1,170 @@
+#include <userver/utils/keyed_rate_limiter.hpp>
+
+#include <atomic>
+#include <functional>
+
+#include <userver/rcu/rcu_map.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+namespace {
+
+constexpr std::size_t kShardCount = 16;
+
+// The window state is a single word:
+// [window index: 24 bits][previous count: 20 bits][current count: 20 bits]
+// The index wraps around, that is harmless as the idle keys are removed
+// long before that.
+constexpr int kCountBits = 20;
+constexpr std::uint64_t kCountMask = (std::uint64_t{1} << kCountBits) - 1;
+constexpr std::uint64_t kIndexMask = (std::uint64_t{1} << 24) - 1;
+
+static_assert(KeyedRateLimiter::kMaxLimit == kCountMask);
+
+struct WindowState {
+  std::uint64_t index;
+  std::uint64_t prev;
+  std::uint64_t curr;
+};
+
+WindowState Unpack(std::uint64_t state) {
+  return {state >> (2 * kCountBits), (state >> kCountBits) & kCountMask,
+          state & kCountMask};
+}
+
+std::uint64_t Pack(const WindowState& state) {
+  return (state.index << (2 * kCountBits)) | (state.prev << kCountBits) |
+         state.curr;
+}
+
+// Count of the windows passed since `index`, modulo the index size
+std::uint64_t WindowsPassed(std::uint64_t index, std::uint64_t current) {
+  return (current - index) & kIndexMask;
+}
+
+}  // namespace
+
+struct KeyedRateLimiter::Window {
+  std::atomic<std::uint64_t> state{0};
+};
+
+struct KeyedRateLimiter::Shard {
+  rcu::RcuMap<std::string, Window> windows;
+  // Cleanups of a full shard are attempted at most once per window
+  std::atomic<std::uint64_t> last_cleanup_index{kIndexMask + 1};
+};
+
+KeyedRateLimiter::KeyedRateLimiter(Settings settings)
+    : settings_(settings),
+      window_(settings_.window),
+      max_keys_per_shard_((settings_.max_keys + kShardCount - 1) /
+                          kShardCount),
+      shards_(std::make_unique<Shard[]>(kShardCount)),
+      overflow_(std::make_unique<Window>()) {
+  UINVARIANT(settings_.limit > 0 && settings_.limit <= kMaxLimit,
+             "KeyedRateLimiter limit is out of range");
+  UINVARIANT(window_.count() > 0, "KeyedRateLimiter window must be positive");
+  UINVARIANT(settings_.max_keys > 0, "KeyedRateLimiter max_keys is zero");
+}
+
+KeyedRateLimiter::~KeyedRateLimiter() = default;
+
+bool KeyedRateLimiter::TryAcquire(const std::string& key,
+                                  Clock::time_point now) {
+  const auto since_epoch = now.time_since_epoch();
+  const auto window_index = static_cast<std::uint64_t>(since_epoch / window_);
+  const auto prev_weight =
+      1.0 - static_cast<double>((since_epoch % window_).count()) /
+                window_.count();
+
+  auto& shard = GetShard(key);
+  auto window = shard.windows.Get(key);
+  if (!window) {
+    if (shard.windows.SizeApprox() >= max_keys_per_shard_) {
+      RemoveIdle(shard, window_index);
+    }
+    if (shard.windows.SizeApprox() >= max_keys_per_shard_) {
+      return TryAcquire(*overflow_, window_index, prev_weight);
+    }
+    window = shard.windows.TryEmplace(key).value;
+  }
+  return TryAcquire(*window, window_index, prev_weight);
+}
+
+void KeyedRateLimiter::RemoveIdle(Clock::time_point now) {
+  const auto window_index =
+      static_cast<std::uint64_t>(now.time_since_epoch() / window_);
+  for (std::size_t i = 0; i < kShardCount; ++i) {
+    auto& shard = shards_[i];
+    shard.last_cleanup_index = kIndexMask + 1;
+    RemoveIdle(shard, window_index);
+  }
+}
+
+std::size_t KeyedRateLimiter::GetKeysCountApprox() const {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < kShardCount; ++i) {
+    count += shards_[i].windows.SizeApprox();
+  }
+  return count;
+}
+
+bool KeyedRateLimiter::TryAcquire(Window& window, std::uint64_t window_index,
+                                  double prev_weight) const {
+  const auto current_index = window_index & kIndexMask;
+  auto old_state = window.state.load(std::memory_order_relaxed);
+  while (true) {
+    auto state = Unpack(old_state);
+    if (state.index != current_index) {
+      const bool is_previous = WindowsPassed(state.index, current_index) == 1;
+      state = {current_index, is_previous ? state.curr : 0, 0};
+    }
+
+    const auto estimate = state.prev * prev_weight + state.curr;
+    if (estimate + 1 > settings_.limit) return false;
+
+    ++state.curr;
+    if (window.state.compare_exchange_weak(old_state, Pack(state),
+                                           std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+}
+
+void KeyedRateLimiter::RemoveIdle(Shard& shard, std::uint64_t window_index) {
+  const auto current_index = window_index & kIndexMask;
+  auto last_cleanup = shard.last_cleanup_index.load();
+  if (last_cleanup == current_index ||
+      !shard.last_cleanup_index.compare_exchange_strong(last_cleanup,
+                                                        current_index)) {
+    return;
+  }
+
+  auto txn = shard.windows.StartWrite();
+  const auto size_before = txn->size();
+  for (auto it = txn->begin(); it != txn->end();) {
+    const auto state = Unpack(it->second->state.load());
+    if (WindowsPassed(state.index, current_index) >= 2) {
+      it = txn->erase(it);
+    } else {
+      ++it;
+    }
+  }
+  if (txn->size() != size_before) txn.Commit();
+}
+
+KeyedRateLimiter::Shard& KeyedRateLimiter::GetShard(const std::string& key) {
+  // std::hash of the strings is the one used by the map itself, mix it to
+  // not correlate the shard with the map bucket
+  const auto hash =
+      static_cast<std::uint64_t>(std::hash<std::string>{}(key)) *
+      0x9E3779B97F4A7C15;
+  return shards_[(hash >> 32) % kShardCount];
+}
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
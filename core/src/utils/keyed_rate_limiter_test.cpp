@@ -0,0 +1,100 @@
+#include <userver/utils/keyed_rate_limiter.hpp>
+
+#include <atomic>
+#include <vector>
+
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/async.hpp>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Limiter = utils::KeyedRateLimiter;
+
+constexpr std::size_t kLimit = 10;
+constexpr std::chrono::milliseconds kWindow{1000};
+
+// Window aligned, as are the windows of the limiter
+const Limiter::Clock::time_point kStart{std::chrono::seconds{100}};
+
+std::size_t AcquireMany(Limiter& limiter, const std::string& key,
+                        std::size_t count, Limiter::Clock::time_point now) {
+  std::size_t acquired = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (limiter.TryAcquire(key, now)) ++acquired;
+  }
+  return acquired;
+}
+
+}  // namespace
+
+UTEST(KeyedRateLimiter, LimitsEachKey) {
+  Limiter limiter{{kLimit, kWindow, 100}};
+
+  EXPECT_EQ(AcquireMany(limiter, "a", kLimit * 2, kStart), kLimit);
+  EXPECT_EQ(AcquireMany(limiter, "b", kLimit * 2, kStart), kLimit);
+  EXPECT_FALSE(limiter.TryAcquire("a", kStart + kWindow / 2));
+  EXPECT_EQ(limiter.GetKeysCountApprox(), 2);
+}
+
+UTEST(KeyedRateLimiter, SlidingWindow) {
+  Limiter limiter{{kLimit, kWindow, 100}};
+  ASSERT_EQ(AcquireMany(limiter, "a", kLimit, kStart + kWindow * 3 / 4),
+            kLimit);
+
+  // A quarter of the next window passed, the previous window still counts
+  // with the weight of 3/4: 7.5 of 10 requests are taken
+  EXPECT_EQ(AcquireMany(limiter, "a", kLimit, kStart + kWindow * 5 / 4), 2);
+
+  // The previous window is out of the sliding window completely
+  EXPECT_EQ(AcquireMany(limiter, "a", kLimit * 2, kStart + kWindow * 3),
+            kLimit);
+}
+
+UTEST(KeyedRateLimiter, RemoveIdle) {
+  Limiter limiter{{kLimit, kWindow, 100}};
+  ASSERT_TRUE(limiter.TryAcquire("a", kStart));
+  ASSERT_TRUE(limiter.TryAcquire("b", kStart + kWindow));
+
+  limiter.RemoveIdle(kStart + kWindow * 2);
+  EXPECT_EQ(limiter.GetKeysCountApprox(), 1);
+
+  limiter.RemoveIdle(kStart + kWindow * 3);
+  EXPECT_EQ(limiter.GetKeysCountApprox(), 0);
+}
+
+UTEST(KeyedRateLimiter, OverflowKeysShareWindow) {
+  constexpr std::size_t kKeys = 1000;
+  Limiter limiter{{kLimit, kWindow, 1}};
+
+  std::size_t acquired = 0;
+  for (std::size_t i = 0; i < kKeys; ++i) {
+    acquired += AcquireMany(limiter, std::to_string(i), 1, kStart);
+  }
+  EXPECT_LT(limiter.GetKeysCountApprox(), kKeys);
+  EXPECT_LT(acquired, kKeys);
+
+  // The idle keys are replaced by the new ones
+  EXPECT_EQ(AcquireMany(limiter, "new", kLimit, kStart + kWindow * 2), kLimit);
+}
+
+UTEST_MT(KeyedRateLimiter, Concurrent, 4) {
+  constexpr std::size_t kTasks = 4;
+  Limiter limiter{{kLimit * 100, kWindow, 100}};
+
+  std::atomic<std::size_t> acquired{0};
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < kTasks; ++i) {
+    tasks.push_back(utils::Async("acquirer", [&] {
+      acquired += AcquireMany(limiter, "a", kLimit * 100, kStart);
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_EQ(acquired.load(), kLimit * 100);
+}
+
+USERVER_NAMESPACE_END
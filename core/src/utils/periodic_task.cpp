@@ -121,6 +121,7 @@ void PeriodicTask::Run() {
   }
 
   while (!engine::current_task::ShouldCancel()) {
+    engine::current_task::SetPriority(GetCurrentSettings().priority);
     const auto before = std::chrono::steady_clock::now();
     bool no_exception = Step();
     auto settings = settings_.Read();
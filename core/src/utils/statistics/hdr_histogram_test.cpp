@@ -0,0 +1,144 @@
+#include <userver/utils/statistics/hdr_histogram.hpp>
+
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Histogram = utils::statistics::HdrHistogram<>;
+
+class TestTimer {
+ public:
+  using duration = std::chrono::steady_clock::duration;
+
+  static std::chrono::steady_clock::time_point now() {
+    return std::chrono::steady_clock::time_point(timer_);
+  }
+
+  static void sleep(duration duration) { timer_ += duration; }
+
+ private:
+  static inline duration timer_{0};
+};
+
+}  // namespace
+
+static_assert(utils::statistics::kHasWriterSupport<Histogram>);
+
+TEST(HdrHistogram, Zero) {
+  Histogram h;
+
+  EXPECT_EQ(0U, h.Count());
+  EXPECT_EQ(0U, h.GetPercentile(0));
+  EXPECT_EQ(0U, h.GetPercentile(50));
+  EXPECT_EQ(0U, h.GetPercentile(100));
+}
+
+TEST(HdrHistogram, One) {
+  Histogram h;
+
+  h.Account(3);
+
+  EXPECT_EQ(1U, h.Count());
+  EXPECT_EQ(3U, h.GetPercentile(0));
+  EXPECT_EQ(3U, h.GetPercentile(50));
+  EXPECT_EQ(3U, h.GetPercentile(100));
+}
+
+TEST(HdrHistogram, SameAsPercentileForSmallValues) {
+  Histogram h;
+  utils::statistics::Percentile<Histogram::kSubBuckets> p;
+
+  for (std::size_t i = 0; i < Histogram::kSubBuckets; ++i) {
+    h.Account(i);
+    p.Account(i);
+  }
+
+  for (const double percent : {0.0, 10.0, 50.0, 90.0, 99.0, 100.0, 200.0}) {
+    EXPECT_EQ(p.GetPercentile(percent), h.GetPercentile(percent)) << percent;
+  }
+}
+
+TEST(HdrHistogram, BucketBounds) {
+  for (std::size_t i = 1; i < Histogram::kBucketsCount; ++i) {
+    EXPECT_LT(Histogram::BucketToValue(i - 1), Histogram::BucketToValue(i));
+    EXPECT_EQ(i, Histogram::BucketIndex(Histogram::BucketToValue(i)));
+    EXPECT_EQ(i, Histogram::BucketIndex(Histogram::BucketToValue(i - 1) + 1));
+  }
+  EXPECT_EQ(Histogram::kMaxValue,
+            Histogram::BucketToValue(Histogram::kBucketsCount - 1));
+}
+
+TEST(HdrHistogram, RelativeError) {
+  const double max_error = 1.0 / Histogram::kHalfSubBuckets;
+
+  for (std::uint64_t value = 1; value < Histogram::kMaxValue;
+       value = value * 3 / 2 + 1) {
+    Histogram h;
+    h.Account(value);
+
+    const auto result = h.GetPercentile(50);
+    EXPECT_GE(result, value);
+    EXPECT_LE(static_cast<double>(result - value) / value, max_error) << value;
+  }
+}
+
+TEST(HdrHistogram, Overflow) {
+  Histogram h;
+
+  h.Account(Histogram::kMaxValue + 1);
+  h.Account(std::numeric_limits<std::uint64_t>::max());
+
+  EXPECT_EQ(2U, h.Count());
+  EXPECT_EQ(Histogram::kMaxValue, h.GetPercentile(0));
+  EXPECT_EQ(Histogram::kMaxValue, h.GetPercentile(100));
+}
+
+TEST(HdrHistogram, Add) {
+  Histogram first;
+  Histogram second;
+
+  for (int i = 0; i < 50; i++) first.Account(i);
+  for (int i = 50; i < 100; i++) second.Account(i);
+
+  first.Add(second);
+
+  EXPECT_EQ(100U, first.Count());
+  EXPECT_EQ(0U, first.GetPercentile(0));
+  EXPECT_EQ(50U, first.GetPercentile(50));
+  EXPECT_EQ(99U, first.GetPercentile(100));
+
+  Histogram copy = first;
+  first.Reset();
+  EXPECT_EQ(0U, first.Count());
+  EXPECT_EQ(100U, copy.Count());
+  EXPECT_EQ(99U, copy.GetPercentile(100));
+}
+
+TEST(HdrHistogram, RecentPeriod) {
+  utils::statistics::RecentPeriod<Histogram, Histogram, TestTimer> stat(
+      std::chrono::seconds(10), std::chrono::seconds(60));
+
+  for (int i = 0; i < 5; i++) {
+    stat.GetCurrentCounter().Account(1000);
+    stat.GetCurrentCounter().Account(10);
+    TestTimer::sleep(std::chrono::seconds(10));
+  }
+
+  auto result = stat.GetStatsForPeriod();
+  EXPECT_EQ(10U, result.Count());
+  EXPECT_EQ(10U, result.GetPercentile(0));
+  EXPECT_EQ(1007U, result.GetPercentile(100));
+
+  TestTimer::sleep(std::chrono::seconds(60));
+  result = stat.GetStatsForPeriod();
+  EXPECT_EQ(0U, result.Count());
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,73 @@
+#include <userver/utils/statistics/sharded.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/datetime.hpp>
+#include <userver/utils/statistics/percentile.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Percentile = utils::statistics::Percentile<2048, unsigned int, 120>;
+
+using RecentPeriod =
+    utils::statistics::RecentPeriod<Percentile, Percentile,
+                                    utils::datetime::SteadyClock>;
+
+using ShardedRecentPeriod =
+    utils::statistics::ShardedRecentPeriod<Percentile, Percentile,
+                                           utils::datetime::SteadyClock>;
+
+// Values of a typical handler timing, that hit a few hot buckets
+constexpr std::size_t kValuesCount = 8;
+constexpr std::size_t kValues[kValuesCount] = {3, 4, 4, 5, 5, 5, 6, 12};
+
+template <typename Timings>
+void recent_period_account(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    Timings timings;
+
+    const std::size_t concurrent_jobs = state.range(0);
+    std::atomic<bool> keep_running{true};
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(concurrent_jobs);
+
+    for (std::size_t i = 1; i < concurrent_jobs; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&] {
+        std::size_t j = 0;
+        while (keep_running) {
+          timings.GetCurrentCounter().Account(kValues[j++ % kValuesCount]);
+        }
+      }));
+    }
+
+    std::size_t j = 0;
+    for (auto _ : state) {
+      timings.GetCurrentCounter().Account(kValues[j++ % kValuesCount]);
+    }
+
+    keep_running = false;
+    for (auto& task : tasks) {
+      task.Get();
+    }
+  });
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(recent_period_account, RecentPeriod)
+    ->RangeMultiplier(2)
+    ->Range(1, 16);
+BENCHMARK_TEMPLATE(recent_period_account, ShardedRecentPeriod)
+    ->RangeMultiplier(2)
+    ->Range(1, 16);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,120 @@
+#include <userver/utils/statistics/sharded.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/mock_now.hpp>
+#include <userver/utils/statistics/min_max_avg.hpp>
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/prometheus.hpp>
+#include <userver/utils/statistics/relaxed_counter.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kTasks = 4;
+constexpr std::size_t kIterations = 1000;
+
+using Percentile = utils::statistics::Percentile<100>;
+
+/// [ShardedMetric usage]
+struct HandlerMetrics {
+  utils::statistics::ShardedMetric<
+      utils::statistics::RelaxedCounter<std::uint64_t>>
+      requests;
+  utils::statistics::ShardedMetric<Percentile> timings;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const HandlerMetrics& metrics) {
+  // the shards are combined only here
+  writer["requests"] = metrics.requests;
+  writer["timings"] = metrics.timings;
+}
+
+void AccountRequest(HandlerMetrics& metrics, std::size_t timing) {
+  ++metrics.requests.GetLocal();
+  metrics.timings.Account(timing);
+}
+/// [ShardedMetric usage]
+
+template <typename Func>
+void RunConcurrently(const Func& func) {
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < kTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&func] {
+      for (std::size_t j = 0; j < kIterations; ++j) func(j);
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+}
+
+}  // namespace
+
+static_assert(utils::statistics::kHasWriterSupport<HandlerMetrics>);
+
+UTEST_MT(ShardedMetric, Combine, kTasks) {
+  HandlerMetrics metrics;
+  RunConcurrently([&](std::size_t i) { AccountRequest(metrics, i % 100); });
+
+  EXPECT_EQ(metrics.requests.Combine().Load(), kTasks * kIterations);
+
+  const auto timings = metrics.timings.Combine();
+  EXPECT_EQ(timings.Count(), kTasks * kIterations);
+  EXPECT_EQ(timings.GetPercentile(50), 50);
+  EXPECT_EQ(timings.GetPercentile(100), 99);
+
+  metrics.timings.Reset();
+  EXPECT_EQ(metrics.timings.Combine().Count(), 0);
+}
+
+UTEST(ShardedMetric, MinMaxAvgEmptyShards) {
+  utils::statistics::ShardedMetric<utils::statistics::MinMaxAvg<int>> mma(8);
+  mma.Account(10);
+  mma.Account(20);
+
+  const auto current = mma.Combine().GetCurrent();
+  EXPECT_EQ(current.minimum, 10);
+  EXPECT_EQ(current.maximum, 20);
+  EXPECT_EQ(current.average, 15);
+}
+
+UTEST(ShardedMetric, Dump) {
+  HandlerMetrics metrics;
+  AccountRequest(metrics, 42);
+
+  utils::statistics::Storage storage;
+  auto holder = storage.RegisterWriter(
+      "handler", [&](utils::statistics::Writer& writer) { writer = metrics; });
+
+  const auto result = utils::statistics::ToPrometheusFormatUntyped(
+      storage, utils::statistics::Request::MakeWithPath("handler.requests"));
+  EXPECT_EQ(result, "handler_requests{} 1\n");
+  holder.Unregister();
+}
+
+UTEST_MT(ShardedRecentPeriod, GetStatsForPeriod, kTasks) {
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+  utils::statistics::ShardedRecentPeriod<Percentile, Percentile,
+                                         utils::datetime::SteadyClock>
+      timings;
+
+  RunConcurrently(
+      [&](std::size_t i) { timings.GetCurrentCounter().Account(i % 100); });
+  EXPECT_EQ(timings.GetStatsForPeriod().Count(), 0);
+  EXPECT_EQ(timings.GetStatsForPeriod(std::chrono::seconds{60}, true).Count(),
+            kTasks * kIterations);
+
+  utils::datetime::MockSleep(std::chrono::seconds{10});
+  EXPECT_EQ(timings.GetStatsForPeriod().Count(), kTasks * kIterations);
+
+  utils::datetime::MockSleep(std::chrono::seconds{100});
+  EXPECT_EQ(timings.GetStatsForPeriod().Count(), 0);
+  utils::datetime::MockNowUnset();
+}
+
+USERVER_NAMESPACE_END
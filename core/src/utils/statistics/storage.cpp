@@ -1,9 +1,11 @@
 #include <userver/utils/statistics/storage.hpp>
 
+#include <map>
 #include <utility>
 
 #include <boost/container/small_vector.hpp>
 
+#include <userver/engine/sleep.hpp>
 #include <userver/formats/common/utils.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
@@ -23,6 +25,8 @@ namespace {
 const std::string kVersionField = "$version";
 constexpr int kVersion = 2;
 
+constexpr std::string_view kRootPrefix = "<root>";
+
 void RemoveAddedLabels(std::vector<Label>& labels,
                        const Request::AddLabels& add_labels) {
   labels.erase(std::remove_if(labels.begin(), labels.end(),
@@ -61,7 +65,10 @@ Request::Request(std::string prefix_in, PrefixMatch path_match_type_in,
 
 BaseFormatBuilder::~BaseFormatBuilder() = default;
 
-Storage::Storage() : may_register_extenders_(true) {}
+Storage::Storage() : Storage(VisitSettings{}) {}
+
+Storage::Storage(VisitSettings settings)
+    : settings_(settings), may_register_extenders_(true) {}
 
 formats::json::Value Storage::GetAsJson() const {
   formats::json::ValueBuilder result;
@@ -92,18 +99,33 @@ void Storage::VisitMetrics(BaseFormatBuilder& out,
 
     boost::container::small_vector<LabelView, 16> labels_vector;
 
+    std::chrono::steady_clock::duration writers_time{0};
+
     std::shared_lock lock(mutex_);
     for (const auto& entry : metrics_sources_) {
       if (!entry.writer) {
         continue;
       }
 
+      if (settings_.writers_time_budget.count() != 0 &&
+          writers_time >= settings_.writers_time_budget) {
+        ++budget_exceeded_;
+        LOG_LIMITED_WARNING()
+            << "Metrics writers time budget of "
+            << settings_.writers_time_budget.count()
+            << "us is exceeded, skipping the writers starting from prefix '"
+            << entry.prefix_path << "'";
+        break;
+      }
+
       labels_vector.clear();
       labels_vector.reserve(entry.writer_labels.size());
       for (const auto& l : entry.writer_labels) {
         labels_vector.emplace_back(l);
       }
 
+      const auto start = std::chrono::steady_clock::now();
+      bool is_written = false;
       try {
         auto writer =
             (entry.prefix_path.empty()
@@ -111,6 +133,7 @@ void Storage::VisitMetrics(BaseFormatBuilder& out,
                  : Writer{state, LabelsSpan{labels_vector}}[entry.prefix_path]);
         if (writer) {
           LOG_DEBUG() << "Getting statistics for prefix=" << entry.prefix_path;
+          is_written = true;
           entry.writer(writer);
         }
       } catch (const std::exception& e) {
@@ -120,12 +143,45 @@ void Storage::VisitMetrics(BaseFormatBuilder& out,
         LOG_ERROR() << "Failed to write metrics for prefix '"
                     << entry.prefix_path << "': " << e;
       }
+
+      // Writers filtered out by the request keep the duration of the last run
+      if (is_written) {
+        const auto duration = std::chrono::steady_clock::now() - start;
+        writers_time += duration;
+        entry.last_duration_us =
+            std::chrono::duration_cast<std::chrono::microseconds>(duration)
+                .count();
+
+        if (settings_.yield_between_writers) engine::Yield();
+      }
     }
+
+    if (settings_.report_writers_durations) WriteWritersDurations(state);
   }
 
   statistics::VisitMetrics(out, GetAsJson(), request);
 }
 
+void Storage::WriteWritersDurations(impl::WriterState& state) const {
+  auto writer = Writer{state, LabelsSpan{}}["statistics"]["writers"];
+  if (!writer) return;
+
+  // Several writers may share the same prefix
+  std::map<std::string_view, std::int64_t> durations;
+  for (const auto& entry : metrics_sources_) {
+    if (!entry.writer) continue;
+    const std::string_view prefix =
+        entry.prefix_path.empty() ? kRootPrefix : entry.prefix_path;
+    durations[prefix] += entry.last_duration_us.Load();
+  }
+
+  for (const auto& [prefix, duration_us] : durations) {
+    writer["duration-us"].ValueWithLabels(duration_us,
+                                          {"statistics_prefix", prefix});
+  }
+  writer["budget-exceeded"] = budget_exceeded_.Load();
+}
+
 void Storage::StopRegisteringExtenders() { may_register_extenders_ = false; }
 
 Entry Storage::RegisterWriter(std::string prefix, WriterFunc func,
@@ -1,6 +1,8 @@
 #include <userver/utils/statistics/storage.hpp>
 
+#include <userver/engine/sleep.hpp>
 #include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/testing.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -14,4 +16,54 @@ UTEST(StatisticsStorage, RegisterExtender) {
   EXPECT_EQ(json["foo"]["bar"]["baz"].As<int>(), 42);
 }
 
+UTEST(StatisticsStorage, WritersTimeBudget) {
+  utils::statistics::VisitSettings settings;
+  settings.writers_time_budget = std::chrono::milliseconds{1};
+  settings.report_writers_durations = true;
+  utils::statistics::Storage statistics_storage{settings};
+
+  auto slow_holder = statistics_storage.RegisterWriter(
+      "slow", [](utils::statistics::Writer& writer) {
+        engine::SleepFor(std::chrono::milliseconds{5});
+        writer = 1;
+      });
+  bool is_fast_written = false;
+  auto fast_holder = statistics_storage.RegisterWriter(
+      "fast", [&is_fast_written](utils::statistics::Writer& writer) {
+        is_fast_written = true;
+        writer = 2;
+      });
+
+  const utils::statistics::Snapshot snapshot{statistics_storage};
+  EXPECT_EQ(snapshot.SingleMetric("slow").AsInt(), 1);
+  EXPECT_FALSE(is_fast_written);
+  EXPECT_EQ(snapshot.SingleMetric("statistics.writers.budget-exceeded").AsInt(),
+            1);
+  EXPECT_GE(snapshot
+                .SingleMetric("statistics.writers.duration-us",
+                              {{"statistics_prefix", "slow"}})
+                .AsInt(),
+            5000);
+  EXPECT_EQ(snapshot
+                .SingleMetric("statistics.writers.duration-us",
+                              {{"statistics_prefix", "fast"}})
+                .AsInt(),
+            0);
+}
+
+UTEST(StatisticsStorage, YieldBetweenWriters) {
+  utils::statistics::VisitSettings settings;
+  settings.yield_between_writers = true;
+  utils::statistics::Storage statistics_storage{settings};
+
+  auto first_holder = statistics_storage.RegisterWriter(
+      "first", [](utils::statistics::Writer& writer) { writer = 1; });
+  auto second_holder = statistics_storage.RegisterWriter(
+      "second", [](utils::statistics::Writer& writer) { writer = 2; });
+
+  const utils::statistics::Snapshot snapshot{statistics_storage};
+  EXPECT_EQ(snapshot.SingleMetric("first").AsInt(), 1);
+  EXPECT_EQ(snapshot.SingleMetric("second").AsInt(), 2);
+}
+
 USERVER_NAMESPACE_END
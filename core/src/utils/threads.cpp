@@ -18,9 +18,13 @@
 #endif
 
 #include <algorithm>
+#include <charconv>
+#include <stdexcept>
 
+#include <boost/algorithm/string/trim.hpp>
 #include <fmt/format.h>
 
+#include <userver/fs/blocking/read.hpp>
 #include <utils/check_syscall.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -59,6 +63,31 @@ LowPriorityParams QueryLowPriorityParams() {
   return result;
 }
 
+// Not using libnuma to avoid the dependency
+#ifdef __linux__
+constexpr int kMpolPreferred = 1;  // MPOL_PREFERRED from <linux/mempolicy.h>
+#endif
+
+thread_local std::optional<std::size_t> current_thread_numa_node;
+
+std::size_t ParseCpuNumber(std::string_view str, std::string_view cpu_list) {
+  std::size_t result = 0;
+  const auto [ptr, ec] =
+      std::from_chars(str.data(), str.data() + str.size(), result);
+  if (ec != std::errc{} || ptr != str.data() + str.size()) {
+    throw std::runtime_error(
+        fmt::format("Invalid CPU list '{}': '{}' is not a number", cpu_list,
+                    str));
+  }
+  return result;
+}
+
+std::string ReadSysfsValue(const std::string& path) {
+  auto value = fs::blocking::ReadFileContents(path);
+  boost::algorithm::trim(value);
+  return value;
+}
+
 }  // namespace
 
 bool IsMainThread() {
@@ -98,6 +127,115 @@ void SetCurrentThreadLowPriorityScheduling() {
       "setting thread scheduling parameters");
 }
 
+std::vector<std::size_t> ParseCpuList(std::string_view cpu_list) {
+  std::vector<std::size_t> result;
+
+  std::string_view rest = cpu_list;
+  while (!rest.empty()) {
+    const auto comma_pos = rest.find(',');
+    const auto range = rest.substr(0, comma_pos);
+    rest = (comma_pos == std::string_view::npos) ? std::string_view{}
+                                                 : rest.substr(comma_pos + 1);
+    if (range.empty()) continue;
+
+    const auto dash_pos = range.find('-');
+    const auto first = ParseCpuNumber(range.substr(0, dash_pos), cpu_list);
+    const auto last =
+        (dash_pos == std::string_view::npos)
+            ? first
+            : ParseCpuNumber(range.substr(dash_pos + 1), cpu_list);
+    if (last < first) {
+      throw std::runtime_error(fmt::format(
+          "Invalid CPU list '{}': range '{}' is reversed", cpu_list, range));
+    }
+
+    for (auto cpu = first; cpu <= last; ++cpu) result.push_back(cpu);
+  }
+
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+std::size_t GetNumaNodesCount() {
+#ifdef __linux__
+  static constexpr std::string_view kPossibleNodesPath =
+      "/sys/devices/system/node/possible";
+  if (!fs::blocking::FileExists(std::string{kPossibleNodesPath})) return 1;
+
+  const auto nodes =
+      ParseCpuList(ReadSysfsValue(std::string{kPossibleNodesPath}));
+  return nodes.empty() ? 1 : nodes.back() + 1;
+#else
+  return 1;
+#endif
+}
+
+std::vector<std::size_t> GetOnlineCpus() {
+#ifdef __linux__
+  static const std::string kOnlineCpusPath = "/sys/devices/system/cpu/online";
+  if (!fs::blocking::FileExists(kOnlineCpusPath)) return {};
+  return ParseCpuList(ReadSysfsValue(kOnlineCpusPath));
+#else
+  return {};
+#endif
+}
+
+std::vector<std::size_t> GetNumaNodeCpus(std::size_t node) {
+  const auto path =
+      fmt::format("/sys/devices/system/node/node{}/cpulist", node);
+  if (!fs::blocking::FileExists(path)) {
+    throw std::runtime_error(
+        fmt::format("NUMA node {} does not exist: missing '{}'", node, path));
+  }
+
+  auto cpus = ParseCpuList(ReadSysfsValue(path));
+  if (cpus.empty()) {
+    throw std::runtime_error(fmt::format("NUMA node {} has no CPUs", node));
+  }
+  return cpus;
+}
+
+void SetCurrentThreadCpuAffinity(const std::vector<std::size_t>& cpus) {
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const auto cpu : cpus) {
+    if (cpu >= CPU_SETSIZE) {
+      throw std::runtime_error(
+          fmt::format("CPU {} is out of the supported range", cpu));
+    }
+    CPU_SET(cpu, &cpu_set);
+  }
+
+  static constexpr ::pid_t kThisThreadPid = 0;
+  utils::CheckSyscall(
+      ::sched_setaffinity(kThisThreadPid, sizeof(cpu_set), &cpu_set),
+      "setting thread CPU affinity");
+#else
+  (void)cpus;
+  throw std::runtime_error("CPU affinity is not supported on this platform");
+#endif
+}
+
+void SetCurrentThreadNumaNode(std::size_t node) {
+#ifdef __linux__
+  static constexpr std::size_t kBitsInLong = sizeof(unsigned long) * 8;
+  std::vector<unsigned long> node_mask(node / kBitsInLong + 1, 0);
+  node_mask[node / kBitsInLong] |= 1UL << (node % kBitsInLong);
+
+  utils::CheckSyscall(::syscall(SYS_set_mempolicy, kMpolPreferred,
+                                node_mask.data(),
+                                node_mask.size() * kBitsInLong + 1),
+                      "setting memory policy for NUMA node {}", node);
+#endif
+  current_thread_numa_node = node;
+}
+
+std::optional<std::size_t> GetCurrentThreadNumaNode() noexcept {
+  return current_thread_numa_node;
+}
+
 }  // namespace utils
 
 USERVER_NAMESPACE_END
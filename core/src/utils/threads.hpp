@@ -1,5 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace utils {
@@ -10,6 +15,29 @@ void SetCurrentThreadIdleScheduling();
 
 void SetCurrentThreadLowPriorityScheduling();
 
+/// Parses the Linux cpulist format, e.g. "0-3,8,10-11"
+std::vector<std::size_t> ParseCpuList(std::string_view cpu_list);
+
+/// Returns the count of possible NUMA nodes, 1 if NUMA is not supported
+std::size_t GetNumaNodesCount();
+
+/// Returns the online CPUs, empty if they are unknown on this platform
+std::vector<std::size_t> GetOnlineCpus();
+
+/// Returns CPUs of the NUMA node, throws if there's no such node
+std::vector<std::size_t> GetNumaNodeCpus(std::size_t node);
+
+/// Binds the current thread to the CPUs
+void SetCurrentThreadCpuAffinity(const std::vector<std::size_t>& cpus);
+
+/// Makes the memory allocations of the current thread prefer the NUMA node
+/// and remembers the node for GetCurrentThreadNumaNode()
+void SetCurrentThreadNumaNode(std::size_t node);
+
+/// Returns the NUMA node set by SetCurrentThreadNumaNode() for the current
+/// thread, if any
+std::optional<std::size_t> GetCurrentThreadNumaNode() noexcept;
+
 }  // namespace utils
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,28 @@
+#include <utils/threads.hpp>
+
+#include <gtest/gtest.h>
+
+#include <userver/utest/assert_macros.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using Cpus = std::vector<std::size_t>;
+
+TEST(ParseCpuList, Basic) {
+  EXPECT_EQ(utils::ParseCpuList(""), Cpus{});
+  EXPECT_EQ(utils::ParseCpuList("0"), Cpus{0});
+  EXPECT_EQ(utils::ParseCpuList("0-3"), (Cpus{0, 1, 2, 3}));
+  EXPECT_EQ(utils::ParseCpuList("0-1,8,10-11"), (Cpus{0, 1, 8, 10, 11}));
+  EXPECT_EQ(utils::ParseCpuList("3,1-2,2"), (Cpus{1, 2, 3}));
+}
+
+TEST(ParseCpuList, Invalid) {
+  UEXPECT_THROW(utils::ParseCpuList("a"), std::runtime_error);
+  UEXPECT_THROW(utils::ParseCpuList("1-"), std::runtime_error);
+  UEXPECT_THROW(utils::ParseCpuList("3-1"), std::runtime_error);
+  UEXPECT_THROW(utils::ParseCpuList("1 ,2"), std::runtime_error);
+}
+
+TEST(NumaNodes, Count) { EXPECT_GE(utils::GetNumaNodesCount(), 1); }
+
+USERVER_NAMESPACE_END
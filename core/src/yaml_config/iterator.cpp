@@ -50,7 +50,8 @@ void Iterator<iter_traits>::UpdateValue() const {
     current_ = (*container_)[it_.GetIndex()];
   } else {
     UASSERT(it_.GetIteratorType() == formats::common::Type::kObject);
-    current_ = (*container_)[it_.GetName()];
+    // avoids the linear lookup of the member by name
+    current_ = container_->MakeMember(*it_, it_.GetName());
   }
 }
 
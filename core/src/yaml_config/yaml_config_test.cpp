@@ -1,5 +1,7 @@
 #include <userver/yaml_config/yaml_config.hpp>
 
+#include <map>
+
 #include <gtest/gtest.h>
 
 #include <formats/common/value_test.hpp>
@@ -470,4 +472,32 @@ TEST(YamlConfig, IteratorArray) {
   EXPECT_NE(cit, it);
 }
 
+TEST(YamlConfig, IteratorObjectFallback) {
+  auto vmap = formats::yaml::FromString(R"(
+    present: 1
+  )");
+
+  auto node = formats::yaml::FromString(R"(
+    a: $present
+    a#fallback: 2
+    b: $missing
+    b#fallback: 3
+    c: $missing
+    d: 4
+  )");
+  yaml_config::YamlConfig conf(std::move(node), std::move(vmap));
+
+  std::map<std::string, std::optional<int>> values;
+  for (const auto& [name, value] : Items(conf)) {
+    values.emplace(name, value.As<std::optional<int>>());
+    EXPECT_EQ(values[name], conf[name].As<std::optional<int>>());
+  }
+
+  const std::map<std::string, std::optional<int>> expected{
+      {"a", 1}, {"a#fallback", 2}, {"b", 3},
+      {"b#fallback", 3}, {"c", std::nullopt}, {"d", 4},
+  };
+  EXPECT_EQ(values, expected);
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,80 @@
+#pragma once
+
+/// @file userver/otlp/exporter_component.hpp
+/// @brief @copybrief otlp::ExporterComponent
+
+#include <memory>
+
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/utils/statistics/entry.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+/// OpenTelemetry support
+namespace otlp {
+
+namespace impl {
+class Exporter;
+}  // namespace impl
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief Sends the spans and the metrics to an OpenTelemetry collector over
+/// OTLP/gRPC.
+///
+/// The finished spans are put into a bounded in-memory queue and are sent
+/// in batches from a background task, spans that do not fit into the queue
+/// are dropped. Only the spans that are logged are exported, see
+/// tracing::Span::IsSampled. The metrics of components::StatisticsStorage
+/// are sent as gauges.
+///
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// endpoint | address of the OpenTelemetry collector | -
+/// service-name | value of the `service.name` resource attribute | -
+/// client-factory | name of the ugrpc::client::ClientFactoryComponent to create the clients | grpc-client-factory
+/// max-queue-size | limit on the spans waiting for the export | 65536
+/// max-batch-size | limit on the spans in a single export request | 512
+/// export-period | how often the queued spans are sent | 1s
+/// metrics-export-period | how often the metrics are sent, the metrics are not exported if not set | -
+/// max-retries | how many times a failed export request is retried | 3
+/// retry-backoff | delay before the first retry, doubles with each retry | 100ms
+/// export-timeout | timeout of a single export request | 5s
+///
+/// ## Statistics:
+/// `otlp.exporter.spans` and `otlp.exporter.metrics` contain the counters of
+/// the `exported`, `dropped` and retried (`retries`) items, the count of
+/// `failed-batches` and the `batch-age-ms` of the oldest span of each batch.
+
+// clang-format on
+class ExporterComponent final : public components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName = "otlp-exporter";
+
+  ExporterComponent(const components::ComponentConfig& config,
+                    const components::ComponentContext& context);
+
+  ~ExporterComponent() override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  void WriteStatistics(utils::statistics::Writer& writer) const;
+
+  std::shared_ptr<impl::Exporter> exporter_;
+  utils::PeriodicTask spans_task_;
+  utils::PeriodicTask metrics_task_;
+  utils::statistics::Entry statistics_holder_;
+};
+
+}  // namespace otlp
+
+template <>
+inline constexpr bool components::kHasValidate<otlp::ExporterComponent> = true;
+
+USERVER_NAMESPACE_END
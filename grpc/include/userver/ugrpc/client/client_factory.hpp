@@ -15,6 +15,7 @@
 #include <userver/yaml_config/fwd.hpp>
 
 #include <userver/ugrpc/client/impl/channel_cache.hpp>
+#include <userver/ugrpc/impl/completion_queues.hpp>
 #include <userver/ugrpc/impl/statistics_storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -38,6 +39,15 @@ struct ClientFactoryConfig {
   /// Number of underlying channels that will be created for every client
   /// in this factory.
   std::size_t channel_count{1};
+
+  /// Up to this number of channels are used for an endpoint if all the
+  /// channels in use have `max_concurrent_streams` RPCs in flight. Values
+  /// below `channel_count` disable the growth.
+  std::size_t max_channel_count{0};
+
+  /// In-flight RPCs per channel, after which one more channel is used. Should
+  /// match the HTTP/2 MAX_CONCURRENT_STREAMS setting of the servers.
+  std::size_t max_concurrent_streams{100};
 };
 
 ClientFactoryConfig Parse(const yaml_config::YamlConfig& value,
@@ -53,6 +63,12 @@ class ClientFactory final {
                 grpc::CompletionQueue& queue,
                 utils::statistics::Storage& statistics_storage);
 
+  /// @brief Creates the clients whose RPCs are distributed across `queues`
+  ClientFactory(ClientFactoryConfig&& config,
+                engine::TaskProcessor& channel_task_processor,
+                const ugrpc::impl::CompletionQueues& queues,
+                utils::statistics::Storage& statistics_storage);
+
   template <typename Client>
   Client MakeClient(const std::string& endpoint);
 
@@ -60,7 +76,7 @@ class ClientFactory final {
   impl::ChannelCache::Token GetChannel(const std::string& endpoint);
 
   engine::TaskProcessor& channel_task_processor_;
-  grpc::CompletionQueue& queue_;
+  const ugrpc::impl::CompletionQueues queues_;
   impl::ChannelCache channel_cache_;
   ugrpc::impl::StatisticsStorage client_statistics_storage_;
 };
@@ -69,7 +85,7 @@ template <typename Client>
 Client ClientFactory::MakeClient(const std::string& endpoint) {
   auto& statistics =
       client_statistics_storage_.GetServiceStatistics(Client::GetMetadata());
-  return Client(GetChannel(endpoint), queue_, statistics);
+  return Client(GetChannel(endpoint), queues_, statistics);
 }
 
 }  // namespace ugrpc::client
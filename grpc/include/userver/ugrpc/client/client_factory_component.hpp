@@ -4,6 +4,7 @@
 /// @brief @copybrief ugrpc::client::ClientFactoryComponent
 
 #include <userver/components/loggable_component_base.hpp>
+#include <userver/utils/statistics/entry.hpp>
 
 #include <userver/ugrpc/client/client_factory.hpp>
 #include <userver/ugrpc/client/queue_holder.hpp>
@@ -45,6 +46,20 @@ namespace ugrpc::client {
 /// auth-type | authentication method, see above | -
 /// default-service-config | default service config, see above | -
 /// channel-count | Number of underlying grpc::Channel objects | 1
+/// max-channel-count | Max number of grpc::Channel objects, see below | 0
+/// max-concurrent-streams | In-flight RPCs per channel, see below | 100
+/// completion-queue-count | Number of completion queues, see below | 1
+///
+/// ## Channel selection
+/// Each RPC goes to the channel of the endpoint with the least RPCs in flight.
+/// If all the channels in use have `max-concurrent-streams` RPCs in flight,
+/// one more channel is used, up to `max-channel-count`.
+///
+/// ## Completion queues
+/// If a ugrpc::server::ServerComponent is present, the clients share the
+/// completion queues of the server and `completion-queue-count` is ignored.
+/// Otherwise the component creates its own queues. Each queue is drained by
+/// a separate thread, RPCs are distributed across the queues.
 ///
 /// @see https://grpc.github.io/grpc/core/group__grpc__arg__keys.html
 class ClientFactoryComponent final : public components::LoggableComponentBase {
@@ -54,6 +69,8 @@ class ClientFactoryComponent final : public components::LoggableComponentBase {
   ClientFactoryComponent(const components::ComponentConfig& config,
                          const components::ComponentContext& context);
 
+  ~ClientFactoryComponent() override;
+
   ClientFactory& GetFactory();
 
   static yaml_config::Schema GetStaticConfigSchema();
@@ -61,6 +78,7 @@ class ClientFactoryComponent final : public components::LoggableComponentBase {
  private:
   std::optional<QueueHolder> queue_;
   std::optional<ClientFactory> factory_;
+  utils::statistics::Entry queue_statistics_holder_;
 };
 
 }  // namespace ugrpc::client
@@ -14,6 +14,7 @@
 #include <userver/tracing/in_place_span.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/ugrpc/client/exceptions.hpp>
+#include <userver/ugrpc/client/impl/channel_cache.hpp>
 #include <userver/ugrpc/impl/async_method_invocation.hpp>
 #include <userver/ugrpc/impl/statistics_scope.hpp>
 
@@ -63,13 +64,21 @@ using RawReaderWriterPreparer = RawReaderWriter<Request, Response> (Stub::*)(
 
 using ugrpc::impl::AsyncMethodInvocation;
 
+/// A stub for a new RPC, accounted as in flight on its channel
+template <typename Stub>
+struct StubHandle final {
+  Stub& stub;
+  ChannelRpcGuard guard;
+};
+
 enum class State { kOpen, kWritesDone, kFinished };
 
 class RpcData final {
  public:
   RpcData(std::unique_ptr<grpc::ClientContext>&& context,
           std::string_view call_name,
-          ugrpc::impl::MethodStatistics& statistics);
+          ugrpc::impl::MethodStatistics& statistics,
+          ChannelRpcGuard&& channel_guard);
 
   RpcData(RpcData&&) noexcept = delete;
   RpcData& operator=(RpcData&&) noexcept = delete;
@@ -97,6 +106,9 @@ class RpcData final {
 
   grpc::Status& GetStatus() noexcept;
 
+  // The RPC no longer occupies a stream of its channel
+  void ReleaseChannel() noexcept;
+
   class AsyncMethodInvocationGuard {
    public:
     AsyncMethodInvocationGuard(RpcData& data) noexcept;
@@ -116,6 +128,7 @@ class RpcData final {
 
   std::optional<AsyncMethodInvocation> invocation_;
   grpc::Status status_;
+  ChannelRpcGuard channel_guard_;
 };
 
 class FutureImpl final {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -12,16 +13,38 @@
 
 #include <userver/concurrent/variable.hpp>
 #include <userver/utils/fixed_array.hpp>
+#include <userver/utils/statistics/fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::client::impl {
 
+/// Accounts an RPC as in flight on a channel until destroyed or released
+class ChannelRpcGuard final {
+ public:
+  ChannelRpcGuard() noexcept = default;
+  explicit ChannelRpcGuard(std::atomic<std::uint64_t>& in_flight) noexcept;
+
+  ChannelRpcGuard(ChannelRpcGuard&&) noexcept;
+  ChannelRpcGuard& operator=(ChannelRpcGuard&&) noexcept;
+  ~ChannelRpcGuard();
+
+  void Release() noexcept;
+
+ private:
+  std::atomic<std::uint64_t>* in_flight_{nullptr};
+};
+
 class ChannelCache final {
  public:
+  /// All `max_channel_count` channels of an endpoint are created at once,
+  /// which is cheap, because gRPC channels connect lazily. RPCs only use the
+  /// first `channel_count` of them until all of those have
+  /// `max_concurrent_streams` RPCs in flight.
   ChannelCache(std::shared_ptr<grpc::ChannelCredentials>&& credentials,
                const grpc::ChannelArguments& channel_args,
-               std::size_t channel_count);
+               std::size_t channel_count, std::size_t max_channel_count,
+               std::size_t max_concurrent_streams);
 
   ~ChannelCache();
 
@@ -31,14 +54,19 @@ class ChannelCache final {
   // alive.
   Token Get(const std::string& endpoint);
 
+  friend void DumpMetric(utils::statistics::Writer& writer,
+                         const ChannelCache& cache);
+
  private:
   struct CountedChannel final {
     CountedChannel(const std::string& endpoint,
                    const std::shared_ptr<grpc::ChannelCredentials>& credentials,
                    const grpc::ChannelArguments& channel_args,
-                   std::size_t count);
+                   std::size_t count, std::size_t max_count);
 
     utils::FixedArray<std::shared_ptr<grpc::Channel>> channels;
+    utils::FixedArray<std::atomic<std::uint64_t>> in_flight;
+    std::atomic<std::size_t> active_count;
     std::uint64_t counter{0};
   };
 
@@ -47,6 +75,8 @@ class ChannelCache final {
   const std::shared_ptr<grpc::ChannelCredentials> credentials_;
   const grpc::ChannelArguments channel_args_;
   const std::size_t channel_count_;
+  const std::size_t max_channel_count_;
+  const std::size_t max_concurrent_streams_;
   concurrent::Variable<Map> channels_;
 };
 
@@ -62,11 +92,23 @@ class ChannelCache::Token final {
   Token& operator=(Token&&) noexcept;
   ~Token();
 
+  /// @returns the count of all the channels, including the inactive ones
   std::size_t GetChannelCount() const noexcept;
 
+  /// @returns the count of the channels the RPCs are distributed across
+  std::size_t GetActiveChannelCount() const noexcept;
+
   const std::shared_ptr<grpc::Channel>& GetChannel(std::size_t index) const
       noexcept;
 
+  /// @brief Picks the active channel with the least RPCs in flight. Activates
+  /// one more channel if all the active ones are saturated.
+  /// @returns the channel index
+  std::size_t PickChannel() const noexcept;
+
+  /// Accounts a new RPC on the channel
+  ChannelRpcGuard StartRpc(std::size_t index) const noexcept;
+
  private:
   ChannelCache* cache_{nullptr};
   const std::string* endpoint_{nullptr};
@@ -7,10 +7,11 @@
 #include <grpcpp/channel.h>
 #include <grpcpp/completion_queue.h>
 
+#include <userver/ugrpc/client/impl/async_methods.hpp>
 #include <userver/ugrpc/client/impl/channel_cache.hpp>
+#include <userver/ugrpc/impl/completion_queues.hpp>
 #include <userver/ugrpc/impl/statistics.hpp>
 #include <userver/utils/fixed_array.hpp>
-#include <userver/utils/rand.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -26,11 +27,11 @@ class ClientData final {
 
   template <typename Service>
   ClientData(impl::ChannelCache::Token channel_token,
-             grpc::CompletionQueue& queue,
+             const ugrpc::impl::CompletionQueues& queues,
              ugrpc::impl::ServiceStatistics& statistics,
              std::in_place_type_t<Service>)
       : channel_token_(std::move(channel_token)),
-        queue_(&queue),
+        queues_(&queues),
         statistics_(&statistics) {
     const std::size_t channel_count = channel_token_.GetChannelCount();
     stubs_ = utils::GenerateFixedArray(channel_count, [&](std::size_t index) {
@@ -46,13 +47,15 @@ class ClientData final {
   ClientData(const ClientData&) = delete;
   ClientData& operator=(const ClientData&) = delete;
 
+  /// @returns the stub of the channel with the least RPCs in flight
   template <typename Service>
-  Stub<Service>& NextStub() const {
-    return *static_cast<Stub<Service>*>(
-        stubs_[utils::RandRange(stubs_.size())].get());
+  StubHandle<Stub<Service>> NextStub() const {
+    const auto index = channel_token_.PickChannel();
+    return {*static_cast<Stub<Service>*>(stubs_[index].get()),
+            channel_token_.StartRpc(index)};
   }
 
-  grpc::CompletionQueue& GetQueue() const { return *queue_; }
+  grpc::CompletionQueue& GetQueue() const { return queues_->NextQueue(); }
 
   ugrpc::impl::MethodStatistics& GetStatistics(std::size_t method_id) const {
     return statistics_->GetMethodStatistics(method_id);
@@ -71,7 +74,7 @@ class ClientData final {
 
   impl::ChannelCache::Token channel_token_;
   utils::FixedArray<StubPtr> stubs_;
-  grpc::CompletionQueue* queue_;
+  const ugrpc::impl::CompletionQueues* queues_;
   ugrpc::impl::ServiceStatistics* statistics_;
 };
 
@@ -3,28 +3,45 @@
 /// @file userver/ugrpc/client/queue_holder.hpp
 /// @brief @copybrief ugrpc::client::QueueHolder
 
+#include <cstddef>
+
 #include <grpcpp/completion_queue.h>
 
 #include <userver/utils/fast_pimpl.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+
+#include <userver/ugrpc/impl/completion_queues.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::client {
 
-/// @brief Manages a gRPC completion queue, usable only in clients
+/// @brief Manages gRPC completion queues, usable only in clients
+///
+/// Each of the queues is drained by a separate thread, RPCs of the clients
+/// created with GetQueues are distributed across all the queues.
 class QueueHolder final {
  public:
-  QueueHolder();
+  explicit QueueHolder(std::size_t queue_count = 1);
 
   QueueHolder(QueueHolder&&) = delete;
   QueueHolder& operator=(QueueHolder&&) = delete;
   ~QueueHolder();
 
+  /// @returns the first of the queues
   grpc::CompletionQueue& GetQueue();
 
+  /// @returns all the queues
+  const ugrpc::impl::CompletionQueues& GetQueues() const;
+
+  /// @cond
+  friend void DumpMetric(utils::statistics::Writer& writer,
+                         const QueueHolder& holder);
+  /// @endcond
+
  private:
   struct Impl;
-  utils::FastPimpl<Impl, 136, 8> impl_;
+  utils::FastPimpl<Impl, 40, 8> impl_;
 };
 
 }  // namespace ugrpc::client
@@ -7,6 +7,7 @@
 #include <string_view>
 #include <utility>
 
+#include <google/protobuf/arena.h>
 #include <grpcpp/impl/codegen/proto_utils.h>
 
 #include <userver/utils/assert.hpp>
@@ -15,6 +16,7 @@
 #include <userver/ugrpc/client/exceptions.hpp>
 #include <userver/ugrpc/client/impl/async_methods.hpp>
 #include <userver/ugrpc/impl/deadline_timepoint.hpp>
+#include <userver/ugrpc/impl/statistics.hpp>
 #include <userver/ugrpc/impl/statistics_scope.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -86,6 +88,34 @@ class StreamReadFuture {
   typename RPC::RawStream* stream_;
 };
 
+/// @brief A response allocated on its own protobuf arena, the whole message
+/// is freed in one shot on destruction
+template <typename Response>
+class ArenaResponse final {
+ public:
+  /// @cond
+  ArenaResponse(std::unique_ptr<google::protobuf::Arena>&& arena,
+                Response& response) noexcept
+      : arena_(std::move(arena)), response_(&response) {}
+  /// @endcond
+
+  ArenaResponse(ArenaResponse&&) noexcept = default;
+  ArenaResponse& operator=(ArenaResponse&&) noexcept = default;
+
+  Response& operator*() noexcept { return *response_; }
+  const Response& operator*() const noexcept { return *response_; }
+
+  Response* operator->() noexcept { return response_; }
+  const Response* operator->() const noexcept { return response_; }
+
+  /// @returns the arena, e.g. to allocate related messages on it
+  google::protobuf::Arena& GetArena() noexcept { return *arena_; }
+
+ private:
+  std::unique_ptr<google::protobuf::Arena> arena_;
+  Response* response_;
+};
+
 /// @brief Controls a single request -> single response RPC
 ///
 /// This class is not thread-safe except for `GetContext`.
@@ -106,6 +136,15 @@ class USERVER_NODISCARD UnaryCall final {
   /// @throws ugrpc::client::RpcError on an RPC error
   Response Finish();
 
+  /// @brief Await and read the response into a protobuf arena
+  ///
+  /// The arena is sized from the recent responses of the method. Same as
+  /// `Finish` otherwise.
+  ///
+  /// @returns the response allocated on its own arena
+  /// @throws ugrpc::client::RpcError on an RPC error
+  ArenaResponse<Response> FinishOnArena();
+
   /// @brief Asynchronously finish the call
   ///
   /// `FinishAsync` should not be called multiple times for the same RPC.
@@ -122,7 +161,7 @@ class USERVER_NODISCARD UnaryCall final {
   // For internal use only
   template <typename Stub, typename Request>
   UnaryCall(
-      Stub& stub, grpc::CompletionQueue& queue,
+      impl::StubHandle<Stub>&& stub, grpc::CompletionQueue& queue,
       impl::RawResponseReaderPreparer<Stub, Request, Response> prepare_func,
       std::string_view call_name, std::unique_ptr<grpc::ClientContext> context,
       ugrpc::impl::MethodStatistics& statistics, const Request& req);
@@ -169,7 +208,7 @@ class USERVER_NODISCARD InputStream final {
   using RawStream = grpc::ClientAsyncReader<Response>;
 
   template <typename Stub, typename Request>
-  InputStream(Stub& stub, grpc::CompletionQueue& queue,
+  InputStream(impl::StubHandle<Stub>&& stub, grpc::CompletionQueue& queue,
               impl::RawReaderPreparer<Stub, Request, Response> prepare_func,
               std::string_view call_name,
               std::unique_ptr<grpc::ClientContext> context,
@@ -228,7 +267,7 @@ class USERVER_NODISCARD OutputStream final {
   using RawStream = grpc::ClientAsyncWriter<Request>;
 
   template <typename Stub>
-  OutputStream(Stub& stub, grpc::CompletionQueue& queue,
+  OutputStream(impl::StubHandle<Stub>&& stub, grpc::CompletionQueue& queue,
                impl::RawWriterPreparer<Stub, Request, Response> prepare_func,
                std::string_view call_name,
                std::unique_ptr<grpc::ClientContext> context,
@@ -301,7 +340,7 @@ class USERVER_NODISCARD BidirectionalStream final {
 
   template <typename Stub>
   BidirectionalStream(
-      Stub& stub, grpc::CompletionQueue& queue,
+      impl::StubHandle<Stub>&& stub, grpc::CompletionQueue& queue,
       impl::RawReaderWriterPreparer<Stub, Request, Response> prepare_func,
       std::string_view call_name, std::unique_ptr<grpc::ClientContext> context,
       ugrpc::impl::MethodStatistics& statistics);
@@ -366,13 +405,13 @@ bool StreamReadFuture<RPC>::IsReady() const noexcept {
 template <typename Response>
 template <typename Stub, typename Request>
 UnaryCall<Response>::UnaryCall(
-    Stub& stub, grpc::CompletionQueue& queue,
+    impl::StubHandle<Stub>&& stub, grpc::CompletionQueue& queue,
     impl::RawResponseReaderPreparer<Stub, Request, Response> prepare_func,
     std::string_view call_name, std::unique_ptr<grpc::ClientContext> context,
     ugrpc::impl::MethodStatistics& statistics, const Request& req)
     : data_(std::make_unique<impl::RpcData>(std::move(context), call_name,
-                                            statistics)),
-      reader_((stub.*prepare_func)(&data_->GetContext(), req, &queue)) {
+                                            statistics, std::move(stub.guard))),
+      reader_((stub.stub.*prepare_func)(&data_->GetContext(), req, &queue)) {
   reader_->StartCall();
   data_->SetState(impl::State::kWritesDone);
 }
@@ -390,6 +429,19 @@ Response UnaryCall<Response>::Finish() {
   return response;
 }
 
+template <typename Response>
+ArenaResponse<Response> UnaryCall<Response>::FinishOnArena() {
+  auto& estimate =
+      data_->GetStatsScope().GetStatistics().GetArenaSizeEstimate();
+  auto arena =
+      std::make_unique<google::protobuf::Arena>(estimate.MakeArenaOptions());
+  auto& response = *google::protobuf::Arena::Create<Response>(arena.get());
+  UnaryFuture future = FinishAsync(response);
+  future.Get();
+  estimate.Account(arena->SpaceUsed());
+  return {std::move(arena), response};
+}
+
 template <typename Response>
 UnaryFuture UnaryCall<Response>::FinishAsync(Response& response) {
   PrepareFinish(*data_);
@@ -403,13 +455,13 @@ UnaryFuture UnaryCall<Response>::FinishAsync(Response& response) {
 template <typename Response>
 template <typename Stub, typename Request>
 InputStream<Response>::InputStream(
-    Stub& stub, grpc::CompletionQueue& queue,
+    impl::StubHandle<Stub>&& stub, grpc::CompletionQueue& queue,
     impl::RawReaderPreparer<Stub, Request, Response> prepare_func,
     std::string_view call_name, std::unique_ptr<grpc::ClientContext> context,
     ugrpc::impl::MethodStatistics& statistics, const Request& req)
     : data_(std::make_unique<impl::RpcData>(std::move(context), call_name,
-                                            statistics)),
-      stream_((stub.*prepare_func)(&data_->GetContext(), req, &queue)) {
+                                            statistics, std::move(stub.guard))),
+      stream_((stub.stub.*prepare_func)(&data_->GetContext(), req, &queue)) {
   impl::StartCall(*stream_, *data_);
   data_->SetState(impl::State::kWritesDone);
 }
@@ -434,16 +486,16 @@ bool InputStream<Response>::Read(Response& response) {
 template <typename Request, typename Response>
 template <typename Stub>
 OutputStream<Request, Response>::OutputStream(
-    Stub& stub, grpc::CompletionQueue& queue,
+    impl::StubHandle<Stub>&& stub, grpc::CompletionQueue& queue,
     impl::RawWriterPreparer<Stub, Request, Response> prepare_func,
     std::string_view call_name, std::unique_ptr<grpc::ClientContext> context,
     ugrpc::impl::MethodStatistics& statistics)
     : data_(std::make_unique<impl::RpcData>(std::move(context), call_name,
-                                            statistics)),
+                                            statistics, std::move(stub.guard))),
       final_response_(std::make_unique<Response>()),
       // 'final_response_' will be filled upon successful 'Finish' async call
-      stream_((stub.*prepare_func)(&data_->GetContext(), final_response_.get(),
-                                   &queue)) {
+      stream_((stub.stub.*prepare_func)(&data_->GetContext(),
+                                        final_response_.get(), &queue)) {
   impl::StartCall(*stream_, *data_);
 }
 
@@ -475,13 +527,13 @@ Response OutputStream<Request, Response>::Finish() {
 template <typename Request, typename Response>
 template <typename Stub>
 BidirectionalStream<Request, Response>::BidirectionalStream(
-    Stub& stub, grpc::CompletionQueue& queue,
+    impl::StubHandle<Stub>&& stub, grpc::CompletionQueue& queue,
     impl::RawReaderWriterPreparer<Stub, Request, Response> prepare_func,
     std::string_view call_name, std::unique_ptr<grpc::ClientContext> context,
     ugrpc::impl::MethodStatistics& statistics)
     : data_(std::make_unique<impl::RpcData>(std::move(context), call_name,
-                                            statistics)),
-      stream_((stub.*prepare_func)(&data_->GetContext(), &queue)) {
+                                            statistics, std::move(stub.guard))),
+      stream_((stub.stub.*prepare_func)(&data_->GetContext(), &queue)) {
   impl::StartCall(*stream_, *data_);
 }
 
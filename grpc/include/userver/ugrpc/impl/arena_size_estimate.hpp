@@ -0,0 +1,28 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include <google/protobuf/arena.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::impl {
+
+/// @brief Running estimate of the arena memory used by the recent RPCs of a
+/// method, so that a typical RPC fits into the first arena block
+class ArenaSizeEstimate final {
+ public:
+  /// @returns options for the arena of a new RPC
+  google::protobuf::ArenaOptions MakeArenaOptions() const noexcept;
+
+  /// Account the arena memory used by a finished RPC
+  void Account(std::size_t space_used) noexcept;
+
+ private:
+  std::atomic<std::size_t> estimate_{0};
+};
+
+}  // namespace ugrpc::impl
+
+USERVER_NAMESPACE_END
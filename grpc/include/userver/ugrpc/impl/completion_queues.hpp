@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <grpcpp/completion_queue.h>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::impl {
+
+/// @brief Non-owning list of the completion queues new RPCs are distributed
+/// across. Each of the queues is drained by its own QueueRunner thread.
+class CompletionQueues final {
+ public:
+  explicit CompletionQueues(grpc::CompletionQueue& queue) : queues_{&queue} {}
+
+  explicit CompletionQueues(std::vector<grpc::CompletionQueue*>&& queues)
+      : queues_(std::move(queues)) {
+    UASSERT(!queues_.empty());
+  }
+
+  std::size_t GetSize() const noexcept { return queues_.size(); }
+
+  grpc::CompletionQueue& GetQueue(std::size_t index) const {
+    UASSERT(index < queues_.size());
+    return *queues_[index];
+  }
+
+  /// @returns the queue for a new RPC
+  grpc::CompletionQueue& NextQueue() const {
+    if (queues_.size() == 1) return *queues_.front();
+    return *queues_[utils::RandRange(queues_.size())];
+  }
+
+ private:
+  std::vector<grpc::CompletionQueue*> queues_;
+};
+
+}  // namespace ugrpc::impl
+
+USERVER_NAMESPACE_END
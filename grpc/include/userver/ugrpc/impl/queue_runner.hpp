@@ -1,8 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+
 #include <grpcpp/completion_queue.h>
 
 #include <userver/engine/single_use_event.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -13,8 +19,19 @@ class QueueRunner final {
   explicit QueueRunner(grpc::CompletionQueue& queue);
   ~QueueRunner();
 
+  friend void DumpMetric(utils::statistics::Writer& writer,
+                         const QueueRunner& runner);
+
  private:
+  using DepthPercentile =
+      utils::statistics::Percentile<100, std::uint32_t, 20, 50>;
+
+  void ProcessQueue() noexcept;
+
   grpc::CompletionQueue& queue_;
+  std::atomic<std::uint64_t> events_{0};
+  // Events that were ready by the time the runner got to them
+  utils::statistics::RecentPeriod<DepthPercentile, DepthPercentile> depth_;
   engine::SingleUseEvent completion_;
 };
 
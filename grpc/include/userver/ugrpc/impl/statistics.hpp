@@ -5,6 +5,7 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <string_view>
 
 #include <grpcpp/support/status.h>
 
@@ -13,15 +14,20 @@
 #include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
 
+#include <userver/ugrpc/impl/arena_size_estimate.hpp>
 #include <userver/ugrpc/impl/static_metadata.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::impl {
 
+enum class StatisticsDomain { kClient, kServer };
+
+std::string_view ToString(StatisticsDomain);
+
 class MethodStatistics final {
  public:
-  MethodStatistics();
+  explicit MethodStatistics(StatisticsDomain domain);
 
   void AccountStarted() noexcept;
 
@@ -29,6 +35,10 @@ class MethodStatistics final {
 
   void AccountTiming(std::chrono::milliseconds timing) noexcept;
 
+  // On-CPU time and suspensions of the task that handled the RPC, server only
+  void AccountExecution(std::chrono::microseconds cpu_time,
+                        std::uint64_t context_switches) noexcept;
+
   // All errors without gRPC status codes are categorized as "network errors".
   // See server::RpcInterruptedError.
   void AccountNetworkError() noexcept;
@@ -38,12 +48,17 @@ class MethodStatistics final {
   // UNKNOWN status code is automatically returned in this case.
   void AccountInternalError() noexcept;
 
+  // Sizes the arenas of the RPCs that opted into arena allocation
+  ArenaSizeEstimate& GetArenaSizeEstimate() noexcept;
+
   friend void DumpMetric(utils::statistics::Writer& writer,
                          const MethodStatistics& stats);
 
  private:
   using Percentile =
       utils::statistics::Percentile<2000, std::uint32_t, 256, 100>;
+  using ContextSwitchesPercentile =
+      utils::statistics::Percentile<100, std::uint32_t, 20, 50>;
   using Counter = std::atomic<std::uint64_t>;
 
   // StatusCode enum cases have consecutive underlying values, starting from 0.
@@ -51,16 +66,24 @@ class MethodStatistics final {
   static constexpr std::size_t kCodesCount =
       static_cast<std::size_t>(grpc::StatusCode::UNAUTHENTICATED) + 1;
 
+  const StatisticsDomain domain_;
   Counter started_{0};
   std::array<Counter, kCodesCount> status_codes_{};
   utils::statistics::RecentPeriod<Percentile, Percentile> timings_;
+  // in microseconds
+  utils::statistics::RecentPeriod<Percentile, Percentile> cpu_times_;
+  utils::statistics::RecentPeriod<ContextSwitchesPercentile,
+                                  ContextSwitchesPercentile>
+      context_switches_;
   Counter network_errors_{0};
   Counter internal_errors_{0};
+  ArenaSizeEstimate arena_size_estimate_;
 };
 
 class ServiceStatistics final {
  public:
-  explicit ServiceStatistics(const StaticServiceMetadata& metadata);
+  ServiceStatistics(const StaticServiceMetadata& metadata,
+                    StatisticsDomain domain);
 
   ~ServiceStatistics();
 
@@ -5,6 +5,8 @@
 
 #include <grpcpp/support/status.h>
 
+#include <userver/engine/task/task.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::impl {
@@ -21,6 +23,8 @@ class RpcStatisticsScope final {
 
   void OnNetworkError();
 
+  MethodStatistics& GetStatistics() noexcept { return statistics_; }
+
  private:
   // Represents how the RPC was finished. Kinds with higher numeric values
   // override those with lower ones.
@@ -41,6 +45,7 @@ class RpcStatisticsScope final {
 
   MethodStatistics& statistics_;
   std::optional<std::chrono::steady_clock::time_point> start_time_;
+  const engine::TaskExecutionStatistics start_execution_;
   FinishKind finish_kind_{FinishKind::kAutomatic};
   grpc::StatusCode finish_code_{};
 };
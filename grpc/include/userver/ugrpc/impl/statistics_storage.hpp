@@ -1,6 +1,6 @@
 #pragma once
 
-#include <string_view>
+#include <functional>
 #include <unordered_map>
 
 #include <userver/engine/shared_mutex.hpp>
@@ -16,8 +16,12 @@ namespace ugrpc::impl {
 /// for storing their statistics.
 class StatisticsStorage final {
  public:
+  // Writes additional metrics of the domain, e.g. of the client channels
+  using ExtraWriter = std::function<void(utils::statistics::Writer&)>;
+
   explicit StatisticsStorage(utils::statistics::Storage& statistics_storage,
-                             std::string_view domain);
+                             StatisticsDomain domain,
+                             ExtraWriter extra_writer = {});
 
   StatisticsStorage(const StatisticsStorage&) = delete;
   StatisticsStorage& operator=(const StatisticsStorage&) = delete;
@@ -33,6 +37,9 @@ class StatisticsStorage final {
 
   void ExtendStatistics(utils::statistics::Writer& writer);
 
+  const StatisticsDomain domain_;
+  const ExtraWriter extra_writer_;
+
   std::unordered_map<ServiceId, ugrpc::impl::ServiceStatistics>
       service_statistics_;
   engine::SharedMutex mutex_;
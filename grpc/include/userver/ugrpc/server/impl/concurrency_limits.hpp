@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <mutex>
+
+#include <userver/concurrent/variable.hpp>
+#include <userver/congestion_control/limiter.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/semaphore.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server::impl {
+
+/// @brief Max concurrency of a service or a method
+///
+/// The configured limit is scaled down while the congestion control limits
+/// the server load.
+class ConcurrencyLimit final {
+ public:
+  ConcurrencyLimit(std::size_t max_concurrency, double load_ratio);
+
+  /// @returns a lock that does not own a slot on timeout
+  engine::SemaphoreLock Acquire(engine::Deadline deadline);
+
+  void SetLoadRatio(double load_ratio);
+
+  std::size_t GetCapacity() const noexcept;
+
+ private:
+  const std::size_t max_concurrency_;
+  engine::Semaphore semaphore_;
+};
+
+/// @brief All the concurrency limits of a server, adjusted by the congestion
+/// control
+class ConcurrencyLimits final : public congestion_control::Limiter {
+ public:
+  ConcurrencyLimits() = default;
+
+  /// @note The limit is alive as long as `ConcurrencyLimits`
+  ConcurrencyLimit& Add(std::size_t max_concurrency);
+
+  void SetLimit(const congestion_control::Limit& new_limit) override;
+
+ private:
+  concurrent::Variable<std::list<ConcurrencyLimit>, std::mutex> limits_;
+  std::atomic<double> load_ratio_{1.0};
+};
+
+}  // namespace ugrpc::server::impl
+
+USERVER_NAMESPACE_END
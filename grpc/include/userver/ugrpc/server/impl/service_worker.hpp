@@ -1,8 +1,12 @@
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 #include <memory>
+#include <optional>
+#include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include <grpcpp/completion_queue.h>
@@ -13,6 +17,7 @@
 
 #include <userver/ugrpc/impl/static_metadata.hpp>
 #include <userver/ugrpc/impl/statistics_storage.hpp>
+#include <userver/ugrpc/server/impl/concurrency_limits.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -20,9 +25,19 @@ namespace ugrpc::server::impl {
 
 /// Config for a `ServiceWorker`, provided by `ugrpc::server::Server`
 struct ServiceSettings final {
-  grpc::ServerCompletionQueue& queue;
+  // Each method is listened to on each of the queues
+  std::vector<grpc::ServerCompletionQueue*> queues;
   engine::TaskProcessor& task_processor;
   ugrpc::impl::StatisticsStorage& statistics_storage;
+  // Allocate initial requests on per-RPC protobuf arenas
+  bool use_arena{false};
+  // Only log sampled or failed call spans, don't echo the tracing ids
+  bool lean_tracing{false};
+  // Limits of the RPCs handled concurrently, see ServiceOptions
+  ConcurrencyLimits& concurrency_limits;
+  std::optional<std::size_t> max_concurrent_rpcs;
+  std::unordered_map<std::string, std::size_t> method_max_concurrent_rpcs;
+  std::chrono::milliseconds queue_timeout{0};
 };
 
 /// @brief Listens to requests for a gRPC service, forwarding them to a
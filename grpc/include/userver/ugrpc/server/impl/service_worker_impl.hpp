@@ -1,17 +1,23 @@
 #pragma once
 
+#include <chrono>
 #include <exception>
 #include <functional>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
+#include <google/protobuf/arena.h>
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/impl/service_type.h>
 #include <grpcpp/server_context.h>
 
 #include <userver/engine/async.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/semaphore.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/tracing/in_place_span.hpp>
@@ -27,6 +33,7 @@
 #include <userver/ugrpc/server/impl/async_method_invocation.hpp>
 #include <userver/ugrpc/server/impl/async_service.hpp>
 #include <userver/ugrpc/server/impl/call_traits.hpp>
+#include <userver/ugrpc/server/impl/concurrency_limits.hpp>
 #include <userver/ugrpc/server/impl/service_worker.hpp>
 #include <userver/ugrpc/server/rpc.hpp>
 #include <userver/ugrpc/server/service_base.hpp>
@@ -44,7 +51,23 @@ void ReportNetworkError(const RpcInterruptedError& ex,
                         tracing::Span& span) noexcept;
 
 void SetupSpan(std::optional<tracing::InPlaceSpan>& span_holder,
-               grpc::ServerContext& context, std::string_view call_name);
+               grpc::ServerContext& context, std::string_view span_name,
+               bool lean_tracing);
+
+std::vector<std::string> MakeSpanNames(
+    const ugrpc::impl::StaticServiceMetadata& metadata);
+
+ConcurrencyLimit* MakeServiceLimit(const ServiceSettings& settings);
+
+std::vector<ConcurrencyLimit*> MakeMethodLimits(
+    const ServiceSettings& settings,
+    const ugrpc::impl::StaticServiceMetadata& metadata);
+
+engine::Deadline GetQueueDeadline(const ServiceSettings& settings,
+                                  const grpc::ServerContext& context);
+
+extern const grpc::Status kDeadlineExpiredStatus;
+extern const grpc::Status kConcurrencyLimitStatus;
 
 /// Per-gRPC-service data
 template <typename GrpcppService>
@@ -53,8 +76,11 @@ struct ServiceData final {
               const ugrpc::impl::StaticServiceMetadata& metadata)
       : settings(settings),
         metadata(metadata),
-        statistics(settings.statistics_storage.GetServiceStatistics(metadata)) {
-  }
+        statistics(
+            settings.statistics_storage.GetServiceStatistics(metadata)),
+        span_names(MakeSpanNames(metadata)),
+        service_limit(MakeServiceLimit(settings)),
+        method_limits(MakeMethodLimits(settings, metadata)) {}
 
   ~ServiceData() = default;
 
@@ -63,6 +89,11 @@ struct ServiceData final {
   AsyncService<GrpcppService> async_service{metadata.method_full_names.size()};
   utils::impl::WaitTokenStorage wait_tokens;
   ugrpc::impl::ServiceStatistics& statistics;
+  // Built once, so that RPCs do not concatenate the span names
+  const std::vector<std::string> span_names;
+  // Null if unlimited
+  ConcurrencyLimit* const service_limit;
+  const std::vector<ConcurrencyLimit*> method_limits;
 };
 
 /// Per-gRPC-method data
@@ -72,11 +103,14 @@ struct MethodData final {
   const std::size_t method_id{};
   typename CallTraits::ServiceBase& service;
   const typename CallTraits::ServiceMethod service_method;
+  grpc::ServerCompletionQueue& queue;
 
   std::string_view call_name{
       service_data.metadata.method_full_names[method_id]};
   ugrpc::impl::MethodStatistics& statistics{
       service_data.statistics.GetMethodStatistics(method_id)};
+  std::string_view span_name{service_data.span_names[method_id]};
+  ConcurrencyLimit* concurrency_limit{service_data.method_limits[method_id]};
 };
 
 template <typename GrpcppService, typename CallTraits>
@@ -87,6 +121,14 @@ class CallData final {
         method_data_(method_data) {
     UASSERT(method_data.method_id <
             method_data.service_data.metadata.method_full_names.size());
+    if constexpr (!std::is_same_v<InitialRequest, NoInitialRequest>) {
+      if (method_data.service_data.settings.use_arena) {
+        auto& estimate = method_data.statistics.GetArenaSizeEstimate();
+        arena_.emplace(estimate.MakeArenaOptions());
+        initial_request_ =
+            google::protobuf::Arena::Create<InitialRequest>(&*arena_);
+      }
+    }
   }
 
   void operator()() && {
@@ -101,9 +143,9 @@ class CallData final {
     context_.AsyncNotifyWhenDone(notify_when_done.GetTag());
 
     // the request for an incoming RPC must be performed synchronously
-    auto& queue = method_data_.service_data.settings.queue;
+    auto& queue = method_data_.queue;
     method_data_.service_data.async_service.template Prepare<CallTraits>(
-        method_data_.method_id, context_, initial_request_, raw_responder_,
+        method_data_.method_id, context_, *initial_request_, raw_responder_,
         queue, queue, prepare_.GetTag());
 
     if (!prepare_.Wait()) {
@@ -118,7 +160,12 @@ class CallData final {
     // start a concurrent listener immediately, as advised by gRPC docs
     ListenAsync(method_data_);
 
-    HandleRpc();
+    AdmitAndHandleRpc();
+
+    if (arena_) {
+      method_data_.statistics.GetArenaSizeEstimate().Account(
+          arena_->SpaceUsed());
+    }
 
     // Even if we finished before receiving notification that call is done, we
     // should wait on this async operation. CompletionQueue has a pointer to
@@ -139,12 +186,60 @@ class CallData final {
   using RawCall = typename CallTraits::RawCall;
   using Call = typename CallTraits::Call;
 
+  void AdmitAndHandleRpc() {
+    const auto& settings = method_data_.service_data.settings;
+
+    // Expired RPCs are dropped without running the handler
+    if (context_.deadline() <= std::chrono::system_clock::now()) {
+      RejectRpc(kDeadlineExpiredStatus);
+      return;
+    }
+
+    const auto deadline = GetQueueDeadline(settings, context_);
+    engine::SemaphoreLock method_lock;
+    if (auto* limit = method_data_.concurrency_limit) {
+      method_lock = limit->Acquire(deadline);
+      if (!method_lock) {
+        RejectRpc(kConcurrencyLimitStatus);
+        return;
+      }
+    }
+    engine::SemaphoreLock service_lock;
+    if (auto* limit = method_data_.service_data.service_limit) {
+      service_lock = limit->Acquire(deadline);
+      if (!service_lock) {
+        RejectRpc(kConcurrencyLimitStatus);
+        return;
+      }
+    }
+
+    HandleRpc();
+  }
+
+  void RejectRpc(const grpc::Status& status) {
+    ugrpc::impl::RpcStatisticsScope statistics_scope(method_data_.statistics);
+    statistics_scope.OnExplicitFinish(status.error_code());
+    try {
+      constexpr auto kCallCategory = CallTraits::kCallCategory;
+      if constexpr (kCallCategory == CallCategory::kUnary ||
+                    kCallCategory == CallCategory::kInputStream) {
+        impl::FinishWithError(raw_responder_, status, method_data_.call_name);
+      } else {
+        impl::Finish(raw_responder_, status, method_data_.call_name);
+      }
+    } catch (const RpcInterruptedError& /*ex*/) {
+      // The client is gone
+      statistics_scope.OnNetworkError();
+    }
+  }
+
   void HandleRpc() {
     const auto call_name = method_data_.call_name;
     auto& service = method_data_.service;
     const auto service_method = method_data_.service_method;
 
-    SetupSpan(span_, context_, call_name);
+    SetupSpan(span_, context_, method_data_.span_name,
+              method_data_.service_data.settings.lean_tracing);
     utils::FastScopeGuard destroy_span([&]() noexcept { span_.reset(); });
 
     ugrpc::impl::RpcStatisticsScope statistics_scope(method_data_.statistics);
@@ -155,7 +250,7 @@ class CallData final {
       if constexpr (std::is_same_v<InitialRequest, NoInitialRequest>) {
         (service.*service_method)(responder);
       } else {
-        (service.*service_method)(responder, std::move(initial_request_));
+        (service.*service_method)(responder, std::move(*initial_request_));
       }
     } catch (const RpcInterruptedError& ex) {
       ReportNetworkError(ex, call_name, span_->Get());
@@ -172,7 +267,10 @@ class CallData final {
   MethodData<GrpcppService, CallTraits> method_data_;
 
   grpc::ServerContext context_{};
-  InitialRequest initial_request_{};
+  // Frees the request and the messages the handler allocated on it at once
+  std::optional<google::protobuf::Arena> arena_{};
+  InitialRequest default_initial_request_{};
+  InitialRequest* initial_request_{&default_initial_request_};
   RawCall raw_responder_{&context_};
   ugrpc::impl::AsyncMethodInvocation prepare_{};
   std::optional<tracing::InPlaceSpan> span_{};
@@ -187,10 +285,13 @@ class ServiceWorkerImpl final : public ServiceWorker {
                     Service& service, ServiceMethods... service_methods)
       : service_data_(settings, metadata),
         start_{[this, &service, service_methods...] {
-          std::size_t method_id = 0;
-          (CallData<GrpcppService, CallTraits<ServiceMethods>>::ListenAsync(
-               {service_data_, method_id++, service, service_methods}),
-           ...);
+          for (auto* queue : service_data_.settings.queues) {
+            std::size_t method_id = 0;
+            (CallData<GrpcppService, CallTraits<ServiceMethods>>::ListenAsync(
+                 {service_data_, method_id++, service, service_methods,
+                  *queue}),
+             ...);
+          }
         }} {}
 
   ~ServiceWorkerImpl() override {
@@ -13,6 +13,7 @@
 #include <userver/ugrpc/impl/statistics_scope.hpp>
 #include <userver/ugrpc/server/exceptions.hpp>
 #include <userver/ugrpc/server/impl/async_methods.hpp>
+#include <userver/ugrpc/server/impl/buffered_writer.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -138,6 +139,26 @@ class OutputStream final {
   /// @throws ugrpc::server::RpcError on an RPC error
   void Write(const Response& response);
 
+  /// @brief Coalesce the subsequent writes
+  ///
+  /// By default, each `Write` waits until gRPC is done with the message.
+  /// With write buffering, `Write` only waits for the previous message
+  /// to be let through by the flow control, and the messages are sent in
+  /// batches: once the limits of `settings` are reached, on `Flush` and on
+  /// `Finish`. The last written message is kept until then.
+  ///
+  /// @param settings when to flush the buffered messages
+  void EnableWriteBuffering(const WriteBuffering& settings = {});
+
+  /// @brief Send the buffered messages
+  ///
+  /// Must be called if the producer has no new messages for a while and write
+  /// buffering is enabled, otherwise the last messages may never be sent.
+  /// Does nothing without write buffering.
+  ///
+  /// @throws ugrpc::server::RpcError on an RPC error
+  void Flush();
+
   /// @brief Complete the RPC successfully
   ///
   /// `Finish` must not be called multiple times.
@@ -185,6 +206,7 @@ class OutputStream final {
   const std::string_view call_name_;
   impl::RawWriter<Response>& stream_;
   State state_{State::kNew};
+  impl::BufferedWriter<Response> writer_;
   ugrpc::impl::RpcStatisticsScope& statistics_;
   tracing::Span& call_span_;
 };
@@ -211,6 +233,26 @@ class BidirectionalStream {
   /// @throws ugrpc::server::RpcError on an RPC error
   void Write(const Response& response);
 
+  /// @brief Coalesce the subsequent writes
+  ///
+  /// By default, each `Write` waits until gRPC is done with the message.
+  /// With write buffering, `Write` only waits for the previous message
+  /// to be let through by the flow control, and the messages are sent in
+  /// batches: once the limits of `settings` are reached, on `Flush` and on
+  /// `Finish`. The last written message is kept until then.
+  ///
+  /// @param settings when to flush the buffered messages
+  void EnableWriteBuffering(const WriteBuffering& settings = {});
+
+  /// @brief Send the buffered messages
+  ///
+  /// Must be called if the producer has no new messages for a while and write
+  /// buffering is enabled, otherwise the last messages may never be sent.
+  /// Does nothing without write buffering.
+  ///
+  /// @throws ugrpc::server::RpcError on an RPC error
+  void Flush();
+
   /// @brief Complete the RPC successfully
   ///
   /// `Finish` must not be called multiple times.
@@ -258,6 +300,7 @@ class BidirectionalStream {
   const std::string_view call_name_;
   impl::RawReaderWriter<Request, Response>& stream_;
   State state_{State::kOpen};
+  impl::BufferedWriter<Response> writer_;
   ugrpc::impl::RpcStatisticsScope& statistics_;
   tracing::Span& call_span_;
 };
@@ -372,7 +415,10 @@ OutputStream<Response>::OutputStream(
 
 template <typename Response>
 OutputStream<Response>::~OutputStream() {
-  if (state_ != State::kFinished) impl::Cancel(stream_, call_name_);
+  if (state_ != State::kFinished) {
+    writer_.WaitPendingWriteNoexcept();
+    impl::Cancel(stream_, call_name_);
+  }
 }
 
 template <typename Response>
@@ -388,6 +434,11 @@ void OutputStream<Response>::Write(const Response& response) {
   // streams
   impl::SendInitialMetadataIfNew(stream_, call_name_, state_);
 
+  if (writer_.IsEnabled()) {
+    writer_.Write(stream_, response, call_name_);
+    return;
+  }
+
   // Don't buffer writes, otherwise in an event subscription scenario, events
   // may never actually be delivered
   grpc::WriteOptions write_options{};
@@ -395,12 +446,30 @@ void OutputStream<Response>::Write(const Response& response) {
   impl::Write(stream_, response, write_options, call_name_);
 }
 
+template <typename Response>
+void OutputStream<Response>::EnableWriteBuffering(
+    const WriteBuffering& settings) {
+  UINVARIANT(state_ != State::kFinished,
+             "'EnableWriteBuffering' called on a finished stream");
+  writer_.Enable(settings);
+}
+
+template <typename Response>
+void OutputStream<Response>::Flush() {
+  UINVARIANT(state_ != State::kFinished, "'Flush' called on a finished stream");
+  if (writer_.IsEnabled()) writer_.Flush(stream_, call_name_);
+}
+
 template <typename Response>
 void OutputStream<Response>::Finish() {
   UINVARIANT(state_ != State::kFinished,
              "'Finish' called on a finished stream");
   state_ = State::kFinished;
-  impl::Finish(stream_, grpc::Status::OK, call_name_);
+  if (writer_.IsEnabled()) {
+    writer_.Finish(stream_, grpc::Status::OK, call_name_);
+  } else {
+    impl::Finish(stream_, grpc::Status::OK, call_name_);
+  }
   statistics_.OnExplicitFinish(grpc::StatusCode::OK);
   ugrpc::impl::UpdateSpanWithStatus(call_span_, grpc::Status::OK);
 }
@@ -411,7 +480,11 @@ void OutputStream<Response>::FinishWithError(const grpc::Status& status) {
   UINVARIANT(state_ != State::kFinished,
              "'Finish' called on a finished stream");
   state_ = State::kFinished;
-  impl::Finish(stream_, status, call_name_);
+  if (writer_.IsEnabled()) {
+    writer_.Finish(stream_, status, call_name_);
+  } else {
+    impl::Finish(stream_, status, call_name_);
+  }
   statistics_.OnExplicitFinish(status.error_code());
   ugrpc::impl::UpdateSpanWithStatus(call_span_, status);
 }
@@ -422,6 +495,11 @@ void OutputStream<Response>::WriteAndFinish(const Response& response) {
              "'WriteAndFinish' called on a finished stream");
   state_ = State::kFinished;
 
+  if (writer_.IsEnabled()) {
+    writer_.WriteAndFinish(stream_, response, call_name_);
+    return;
+  }
+
   // Don't buffer writes, otherwise in an event subscription scenario, events
   // may never actually be delivered
   grpc::WriteOptions write_options{};
@@ -443,7 +521,10 @@ BidirectionalStream<Request, Response>::BidirectionalStream(
 
 template <typename Request, typename Response>
 BidirectionalStream<Request, Response>::~BidirectionalStream() {
-  if (state_ != State::kFinished) impl::Cancel(stream_, call_name_);
+  if (state_ != State::kFinished) {
+    writer_.WaitPendingWriteNoexcept();
+    impl::Cancel(stream_, call_name_);
+  }
 }
 
 template <typename Request, typename Response>
@@ -467,18 +548,41 @@ template <typename Request, typename Response>
 void BidirectionalStream<Request, Response>::Write(const Response& response) {
   UINVARIANT(state_ == State::kOpen, "'Write' called on a finished stream");
 
+  if (writer_.IsEnabled()) {
+    writer_.Write(stream_, response, call_name_);
+    return;
+  }
+
   // Don't buffer writes, optimize for ping-pong-style interaction
   grpc::WriteOptions write_options{};
 
   impl::Write(stream_, response, write_options, call_name_);
 }
 
+template <typename Request, typename Response>
+void BidirectionalStream<Request, Response>::EnableWriteBuffering(
+    const WriteBuffering& settings) {
+  UINVARIANT(state_ != State::kFinished,
+             "'EnableWriteBuffering' called on a finished stream");
+  writer_.Enable(settings);
+}
+
+template <typename Request, typename Response>
+void BidirectionalStream<Request, Response>::Flush() {
+  UINVARIANT(state_ != State::kFinished, "'Flush' called on a finished stream");
+  if (writer_.IsEnabled()) writer_.Flush(stream_, call_name_);
+}
+
 template <typename Request, typename Response>
 void BidirectionalStream<Request, Response>::Finish() {
   UINVARIANT(state_ != State::kFinished,
              "'Finish' called on a finished stream");
   state_ = State::kFinished;
-  impl::Finish(stream_, grpc::Status::OK, call_name_);
+  if (writer_.IsEnabled()) {
+    writer_.Finish(stream_, grpc::Status::OK, call_name_);
+  } else {
+    impl::Finish(stream_, grpc::Status::OK, call_name_);
+  }
   statistics_.OnExplicitFinish(grpc::StatusCode::OK);
   ugrpc::impl::UpdateSpanWithStatus(call_span_, grpc::Status::OK);
 }
@@ -490,7 +594,11 @@ void BidirectionalStream<Request, Response>::FinishWithError(
   UINVARIANT(state_ != State::kFinished,
              "'FinishWithError' called on a finished stream");
   state_ = State::kFinished;
-  impl::Finish(stream_, status, call_name_);
+  if (writer_.IsEnabled()) {
+    writer_.Finish(stream_, status, call_name_);
+  } else {
+    impl::Finish(stream_, status, call_name_);
+  }
   statistics_.OnExplicitFinish(status.error_code());
   ugrpc::impl::UpdateSpanWithStatus(call_span_, status);
 }
@@ -502,6 +610,11 @@ void BidirectionalStream<Request, Response>::WriteAndFinish(
              "'WriteAndFinish' called on a finished stream");
   state_ = State::kFinished;
 
+  if (writer_.IsEnabled()) {
+    writer_.WriteAndFinish(stream_, response, call_name_);
+    return;
+  }
+
   // Don't buffer writes, optimize for ping-pong-style interaction
   grpc::WriteOptions write_options{};
 
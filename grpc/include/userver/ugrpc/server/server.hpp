@@ -3,18 +3,24 @@
 /// @file userver/ugrpc/server/server.hpp
 /// @brief @copybrief ugrpc::server::Server
 
+#include <chrono>
+#include <cstddef>
 #include <functional>
 #include <memory>
+#include <optional>
+#include <string>
 #include <unordered_map>
 
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/server_builder.h>
 
+#include <userver/congestion_control/limiter.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/logging/level.hpp>
 #include <userver/utils/statistics/fwd.hpp>
 #include <userver/yaml_config/fwd.hpp>
 
+#include <userver/ugrpc/impl/completion_queues.hpp>
 #include <userver/ugrpc/impl/statistics.hpp>
 #include <userver/ugrpc/server/service_base.hpp>
 
@@ -39,11 +45,43 @@ struct ServerConfig final {
 
   /// Serve a web page with runtime info about gRPC connections
   bool enable_channelz{false};
+
+  /// Number of completion queues, each one is drained by a separate thread.
+  /// Incoming RPCs and RPCs of the clients using GetCompletionQueues are
+  /// distributed across the queues.
+  std::size_t completion_queue_count{1};
 };
 
 ServerConfig Parse(const yaml_config::YamlConfig& value,
                    formats::parse::To<ServerConfig> to);
 
+/// Settings relating to a single service
+struct ServiceOptions final {
+  /// Allocate the request of each unary and server-streaming RPC on a
+  /// protobuf arena. The arena is sized from the recent RPCs of the method and
+  /// is freed in one shot when the RPC completes. The handler may allocate
+  /// its messages on the same arena using `request.GetArena()`.
+  bool use_arena{false};
+
+  /// Keep the per-RPC tracing overhead minimal, for high-rate tiny RPCs. The
+  /// call span is only logged if it is sampled or the RPC fails, and the
+  /// tracing ids are not sent back to the client in the initial metadata.
+  bool lean_tracing{false};
+
+  /// Max number of concurrently handled RPCs of the service, unlimited if
+  /// unset. The excess RPCs wait for `queue_timeout` and are then rejected
+  /// with `RESOURCE_EXHAUSTED`.
+  std::optional<std::size_t> max_concurrent_rpcs{};
+
+  /// Max number of concurrently handled RPCs per method name, e.g.
+  /// `SayHello`. Applies in addition to `max_concurrent_rpcs`.
+  std::unordered_map<std::string, std::size_t> method_max_concurrent_rpcs{};
+
+  /// How long an RPC may wait for the concurrency limits, capped by the RPC
+  /// deadline
+  std::chrono::milliseconds queue_timeout{0};
+};
+
 /// @brief Manages the gRPC server
 ///
 /// All methods are thread-safe.
@@ -63,7 +101,8 @@ class Server final {
   /// @brief Register a service implementation in the server. The user or the
   /// component is responsible for keeping `service` alive at least until `Stop`
   /// is called.
-  void AddService(ServiceBase& service, engine::TaskProcessor& task_processor);
+  void AddService(ServiceBase& service, engine::TaskProcessor& task_processor,
+                  const ServiceOptions& options = {});
 
   /// @brief Get names of all registered services
   std::vector<std::string_view> GetServiceNames() const;
@@ -78,6 +117,16 @@ class Server final {
   /// usually no more than one instance per program.
   grpc::CompletionQueue& GetCompletionQueue() noexcept;
 
+  /// @returns all the completion queues of the server, for clients that
+  /// distribute their RPCs across the queues
+  /// @note The same lifetime restrictions as for GetCompletionQueue apply
+  const ugrpc::impl::CompletionQueues& GetCompletionQueues() noexcept;
+
+  /// @returns the limiter that scales the concurrency limits of all the
+  /// services, see ServiceOptions::max_concurrent_rpcs
+  /// @note Usually fed by congestion_control::Component
+  congestion_control::Limiter& GetConcurrencyLimiter() noexcept;
+
   /// @brief Start accepting requests
   /// @note Must be called at most once after all the services are registered
   void Start();
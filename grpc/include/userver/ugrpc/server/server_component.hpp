@@ -26,6 +26,7 @@ namespace ugrpc::server {
 /// channel-args | a map of channel arguments, see gRPC Core docs | {}
 /// native-log-level | min log level for the native gRPC library | 'error'
 /// enable-channelz | initialize service with runtime info about gRPC connections | false
+/// completion-queue-count | number of completion queues, each one is drained by a separate thread | 1
 ///
 /// @see https://grpc.github.io/grpc/core/group__grpc__arg__keys.html
 
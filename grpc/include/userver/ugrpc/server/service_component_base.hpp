@@ -8,14 +8,13 @@
 #include <userver/components/loggable_component_base.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 
+#include <userver/ugrpc/server/server.hpp>
 #include <userver/ugrpc/server/service_base.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::server {
 
-class Server;
-
 /// @ingroup userver_components userver_base_classes
 ///
 /// @brief Base class for all the gRPC service components.
@@ -24,6 +23,13 @@ class Server;
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
 /// task-processor | the task processor to use for responses | -
+/// use-arena | allocate requests on per-RPC protobuf arenas | false
+/// lean-tracing | only log sampled or failed call spans | false
+/// max-concurrent-rpcs | max concurrently handled RPCs | unlimited
+/// method-max-concurrent-rpcs | the same, per method name | {}
+/// queue-timeout | how long an RPC may wait for the limits | 0
+///
+/// @see ugrpc::server::ServiceOptions
 class ServiceComponentBase : public components::LoggableComponentBase {
  public:
   ServiceComponentBase(const components::ComponentConfig& config,
@@ -39,6 +45,7 @@ class ServiceComponentBase : public components::LoggableComponentBase {
  private:
   Server& server_;
   engine::TaskProcessor& service_task_processor_;
+  const ServiceOptions service_options_;
   std::atomic<bool> registered_{false};
 };
 
@@ -0,0 +1,283 @@
+#include <otlp/exporter.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/tracing/tags.hpp>
+#include <userver/ugrpc/client/exceptions.hpp>
+#include <userver/utils/encoding/hex.hpp>
+#include <userver/utils/overloaded.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp::impl {
+
+namespace {
+
+namespace common = opentelemetry::proto::common::v1;
+namespace metrics = opentelemetry::proto::metrics::v1;
+namespace resource = opentelemetry::proto::resource::v1;
+namespace trace = opentelemetry::proto::trace::v1;
+
+constexpr std::string_view kScopeName = "userver";
+constexpr std::size_t kTraceIdSize = 16;
+constexpr std::size_t kSpanIdSize = 8;
+
+std::uint64_t ToUnixNano(std::chrono::system_clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             time.time_since_epoch())
+      .count();
+}
+
+// OTLP ids are raw bytes of a fixed size, while the incoming userver ids may
+// be arbitrary strings
+std::string ToOtlpId(std::string_view id, std::size_t size) {
+  if (id.empty()) return {};
+  if (id.size() == size * 2 && utils::encoding::IsHexData(id)) {
+    return utils::encoding::FromHex(id);
+  }
+
+  const auto hash = std::hash<std::string_view>{}(id);
+  std::string result(size, '\0');
+  for (std::size_t i = 0; i < size; ++i) {
+    result[i] = static_cast<char>(hash >> (i % sizeof(hash) * 8));
+  }
+  return result;
+}
+
+void SetAttribute(common::KeyValue& attribute, std::string_view key,
+                  std::string_view value) {
+  attribute.set_key(std::string{key});
+  attribute.mutable_value()->set_string_value(std::string{value});
+}
+
+void FillResource(resource::Resource& resource,
+                  const std::string& service_name) {
+  SetAttribute(*resource.add_attributes(), "service.name", service_name);
+}
+
+void FillSpan(trace::Span& out, tracing::FinishedSpan&& span) {
+  out.set_trace_id(ToOtlpId(span.trace_id, kTraceIdSize));
+  out.set_span_id(ToOtlpId(span.span_id, kSpanIdSize));
+  out.set_parent_span_id(ToOtlpId(span.parent_id, kSpanIdSize));
+  out.set_name(std::move(span.name));
+  out.set_start_time_unix_nano(ToUnixNano(span.start_time));
+  out.set_end_time_unix_nano(ToUnixNano(
+      span.start_time +
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          span.duration)));
+
+  for (auto& [key, value] : span.tags) {
+    if (key == tracing::kErrorFlag) {
+      const auto* flag = std::get_if<int>(&value);
+      if (flag && *flag) {
+        out.mutable_status()->set_code(trace::Status::STATUS_CODE_ERROR);
+      }
+      continue;
+    }
+    if (key == tracing::kErrorMessage) {
+      if (auto* message = std::get_if<std::string>(&value)) {
+        out.mutable_status()->set_message(std::move(*message));
+      }
+      continue;
+    }
+
+    auto& attribute = *out.add_attributes();
+    attribute.set_key(std::move(key));
+    auto& attribute_value = *attribute.mutable_value();
+    std::visit(
+        utils::Overloaded{
+            [&](std::string& string) {
+              attribute_value.set_string_value(std::move(string));
+            },
+            [&](float number) { attribute_value.set_double_value(number); },
+            [&](double number) { attribute_value.set_double_value(number); },
+            [&](auto integer) {
+              attribute_value.set_int_value(static_cast<std::int64_t>(integer));
+            },
+        },
+        value);
+  }
+}
+
+class MetricsBuilder final : public utils::statistics::BaseFormatBuilder {
+ public:
+  explicit MetricsBuilder(metrics::ScopeMetrics& scope_metrics)
+      : scope_metrics_(scope_metrics),
+        time_unix_nano_(ToUnixNano(std::chrono::system_clock::now())) {}
+
+  void HandleMetric(std::string_view path, utils::statistics::LabelsSpan labels,
+                    const utils::statistics::MetricValue& value) override {
+    auto& gauge = GetGauge(path);
+    auto& point = *gauge.add_data_points();
+    point.set_time_unix_nano(time_unix_nano_);
+    for (const auto& label : labels) {
+      SetAttribute(*point.add_attributes(), label.Name(), label.Value());
+    }
+    value.Visit(utils::Overloaded{
+        [&](std::int64_t integer) { point.set_as_int(integer); },
+        [&](double number) { point.set_as_double(number); },
+    });
+    ++values_count_;
+  }
+
+  std::size_t GetValuesCount() const noexcept { return values_count_; }
+
+ private:
+  metrics::Gauge& GetGauge(std::string_view path) {
+    auto it = gauges_.find(path);
+    if (it != gauges_.end()) return *it->second;
+
+    auto& metric = *scope_metrics_.add_metrics();
+    metric.set_name(std::string{path});
+    auto* gauge = metric.mutable_gauge();
+    gauges_.emplace(metric.name(), gauge);
+    return *gauge;
+  }
+
+  metrics::ScopeMetrics& scope_metrics_;
+  const std::uint64_t time_unix_nano_;
+  // Keys point to the names stored in scope_metrics_
+  std::unordered_map<std::string_view, metrics::Gauge*> gauges_;
+  std::size_t values_count_{0};
+};
+
+}  // namespace
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ExportStatistics& stats) {
+  writer["exported"] = stats.exported;
+  writer["dropped"] = stats.dropped;
+  writer["retries"] = stats.retries;
+  writer["failed-batches"] = stats.failed_batches;
+  writer["batch-age-ms"] = stats.batch_age_ms;
+}
+
+Exporter::Exporter(ExporterConfig&& config, TraceClient&& trace_client,
+                   MetricsClient&& metrics_client)
+    : config_(std::move(config)),
+      trace_client_(std::move(trace_client)),
+      metrics_client_(std::move(metrics_client)) {}
+
+Exporter::~Exporter() = default;
+
+template <typename Call>
+bool Exporter::SendWithRetries(Call call, ExportStatistics& stats) {
+  auto backoff = config_.retry_backoff;
+  for (std::size_t attempt = 0;; ++attempt) {
+    try {
+      auto context = std::make_unique<grpc::ClientContext>();
+      context->set_deadline(std::chrono::system_clock::now() +
+                            config_.export_timeout);
+      call(std::move(context));
+      return true;
+    } catch (const ugrpc::client::RpcError& ex) {
+      if (attempt >= config_.max_retries ||
+          engine::current_task::ShouldCancel()) {
+        LOG_LIMITED_WARNING() << "Failed to export to the OpenTelemetry "
+                                 "collector: "
+                              << ex;
+        ++stats.failed_batches;
+        return false;
+      }
+    }
+
+    ++stats.retries;
+    engine::InterruptibleSleepFor(backoff);
+    backoff *= 2;
+  }
+}
+
+void Exporter::Export(tracing::FinishedSpan&& span) noexcept {
+  // The spans of the export requests must not be exported themselves
+  if (span.name.rfind("grpc/opentelemetry.proto.collector.", 0) == 0) return;
+
+  std::lock_guard lock(queue_mutex_);
+  if (queue_.size() >= config_.max_queue_size) {
+    ++span_statistics_.dropped;
+    return;
+  }
+  queue_.push_back({std::move(span), std::chrono::steady_clock::now()});
+}
+
+void Exporter::ExportSpans() {
+  std::vector<QueuedSpan> spans;
+  {
+    std::lock_guard lock(queue_mutex_);
+    spans.swap(queue_);
+  }
+
+  for (std::size_t begin = 0; begin < spans.size();
+       begin += config_.max_batch_size) {
+    const auto end = std::min(spans.size(), begin + config_.max_batch_size);
+
+    // The spans are queued in the order of their finish
+    span_statistics_.batch_age_ms.Account(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - spans[begin].enqueue_time)
+            .count());
+
+    opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest
+        request;
+    auto& resource_spans = *request.add_resource_spans();
+    FillResource(*resource_spans.mutable_resource(), config_.service_name);
+    auto& scope_spans = *resource_spans.add_scope_spans();
+    scope_spans.mutable_scope()->set_name(std::string{kScopeName});
+    for (auto i = begin; i < end; ++i) {
+      FillSpan(*scope_spans.add_spans(), std::move(spans[i].span));
+    }
+
+    const auto sent = SendWithRetries(
+        [&](auto&& context) {
+          trace_client_.Export(request, std::move(context)).Finish();
+        },
+        span_statistics_);
+    if (sent) {
+      span_statistics_.exported += end - begin;
+    } else {
+      span_statistics_.dropped += end - begin;
+    }
+  }
+}
+
+void Exporter::ExportMetrics(const utils::statistics::Storage& storage) {
+  opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceRequest
+      request;
+  auto& resource_metrics = *request.add_resource_metrics();
+  FillResource(*resource_metrics.mutable_resource(), config_.service_name);
+  auto& scope_metrics = *resource_metrics.add_scope_metrics();
+  scope_metrics.mutable_scope()->set_name(std::string{kScopeName});
+
+  MetricsBuilder builder{scope_metrics};
+  storage.VisitMetrics(builder);
+  if (builder.GetValuesCount() == 0) return;
+
+  const auto sent = SendWithRetries(
+      [&](auto&& context) {
+        metrics_client_.Export(request, std::move(context)).Finish();
+      },
+      metric_statistics_);
+  if (sent) {
+    metric_statistics_.exported += builder.GetValuesCount();
+  } else {
+    metric_statistics_.dropped += builder.GetValuesCount();
+  }
+}
+
+const ExportStatistics& Exporter::GetSpanStatistics() const noexcept {
+  return span_statistics_;
+}
+
+const ExportStatistics& Exporter::GetMetricStatistics() const noexcept {
+  return metric_statistics_;
+}
+
+}  // namespace otlp::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <opentelemetry/proto/collector/metrics/v1/metrics_service_client.usrv.pb.hpp>
+#include <opentelemetry/proto/collector/trace/v1/trace_service_client.usrv.pb.hpp>
+
+#include <userver/tracing/span_exporter.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/min_max_avg.hpp>
+#include <userver/utils/statistics/relaxed_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp::impl {
+
+struct ExporterConfig {
+  std::string service_name;
+  std::size_t max_queue_size{65536};
+  std::size_t max_batch_size{512};
+  std::size_t max_retries{3};
+  std::chrono::milliseconds retry_backoff{100};
+  std::chrono::milliseconds export_timeout{5000};
+};
+
+struct ExportStatistics {
+  // Spans or metric values accepted by the collector
+  utils::statistics::RelaxedCounter<std::uint64_t> exported{0};
+  // Spans that did not fit into the queue and items of the failed batches
+  utils::statistics::RelaxedCounter<std::uint64_t> dropped{0};
+  utils::statistics::RelaxedCounter<std::uint64_t> retries{0};
+  utils::statistics::RelaxedCounter<std::uint64_t> failed_batches{0};
+  // Time the oldest item of a batch spent in the queue
+  utils::statistics::MinMaxAvg<std::int64_t> batch_age_ms;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ExportStatistics& stats);
+
+/// Queues the finished spans and sends them to an OpenTelemetry collector in
+/// batches. Also sends the metrics of a utils::statistics::Storage.
+class Exporter final : public tracing::SpanExporter {
+ public:
+  using TraceClient =
+      opentelemetry::proto::collector::trace::v1::TraceServiceClient;
+  using MetricsClient =
+      opentelemetry::proto::collector::metrics::v1::MetricsServiceClient;
+
+  Exporter(ExporterConfig&& config, TraceClient&& trace_client,
+           MetricsClient&& metrics_client);
+
+  ~Exporter() override;
+
+  void Export(tracing::FinishedSpan&& span) noexcept override;
+
+  /// Sends all the queued spans, must be called periodically
+  void ExportSpans();
+
+  /// Sends the current values of all the metrics from the storage
+  void ExportMetrics(const utils::statistics::Storage& storage);
+
+  const ExportStatistics& GetSpanStatistics() const noexcept;
+  const ExportStatistics& GetMetricStatistics() const noexcept;
+
+ private:
+  struct QueuedSpan {
+    tracing::FinishedSpan span;
+    std::chrono::steady_clock::time_point enqueue_time;
+  };
+
+  template <typename Call>
+  bool SendWithRetries(Call call, ExportStatistics& stats);
+
+  const ExporterConfig config_;
+  TraceClient trace_client_;
+  MetricsClient metrics_client_;
+
+  std::mutex queue_mutex_;
+  std::vector<QueuedSpan> queue_;
+
+  ExportStatistics span_statistics_;
+  ExportStatistics metric_statistics_;
+};
+
+}  // namespace otlp::impl
+
+USERVER_NAMESPACE_END
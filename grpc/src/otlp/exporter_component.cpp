@@ -0,0 +1,155 @@
+#include <userver/otlp/exporter_component.hpp>
+
+#include <optional>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/tracing/span_exporter.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <userver/ugrpc/client/client_factory_component.hpp>
+
+#include <otlp/exporter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp {
+
+namespace {
+
+impl::ExporterConfig ParseExporterConfig(
+    const components::ComponentConfig& config) {
+  impl::ExporterConfig result;
+  result.service_name = config["service-name"].As<std::string>();
+  result.max_queue_size =
+      config["max-queue-size"].As<std::size_t>(result.max_queue_size);
+  result.max_batch_size =
+      config["max-batch-size"].As<std::size_t>(result.max_batch_size);
+  result.max_retries =
+      config["max-retries"].As<std::size_t>(result.max_retries);
+  result.retry_backoff = config["retry-backoff"].As<std::chrono::milliseconds>(
+      result.retry_backoff);
+  result.export_timeout =
+      config["export-timeout"].As<std::chrono::milliseconds>(
+          result.export_timeout);
+  return result;
+}
+
+}  // namespace
+
+ExporterComponent::ExporterComponent(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context)
+    : LoggableComponentBase(config, context) {
+  auto& client_factory =
+      context
+          .FindComponent<ugrpc::client::ClientFactoryComponent>(
+              config["client-factory"].As<std::string>(std::string{
+                  ugrpc::client::ClientFactoryComponent::kName}))
+          .GetFactory();
+  const auto endpoint = config["endpoint"].As<std::string>();
+
+  exporter_ = std::make_shared<impl::Exporter>(
+      ParseExporterConfig(config),
+      client_factory.MakeClient<impl::Exporter::TraceClient>(endpoint),
+      client_factory.MakeClient<impl::Exporter::MetricsClient>(endpoint));
+
+  spans_task_.Start(
+      "otlp-export-spans",
+      {config["export-period"].As<std::chrono::milliseconds>(
+           std::chrono::seconds{1}),
+       {utils::PeriodicTask::Flags::kStrong},
+       logging::Level::kDebug},
+      [this] { exporter_->ExportSpans(); });
+
+  auto& storage =
+      context.FindComponent<components::StatisticsStorage>().GetStorage();
+
+  const auto metrics_export_period =
+      config["metrics-export-period"]
+          .As<std::optional<std::chrono::milliseconds>>();
+  if (metrics_export_period) {
+    metrics_task_.Start("otlp-export-metrics",
+                        {*metrics_export_period,
+                         {utils::PeriodicTask::Flags::kStrong},
+                         logging::Level::kDebug},
+                        [this, &storage] { exporter_->ExportMetrics(storage); });
+  }
+
+  statistics_holder_ = storage.RegisterWriter(
+      "otlp.exporter",
+      [this](utils::statistics::Writer& writer) { WriteStatistics(writer); });
+
+  tracing::SetSpanExporter(exporter_);
+}
+
+ExporterComponent::~ExporterComponent() {
+  tracing::SetSpanExporter(nullptr);
+  statistics_holder_.Unregister();
+  metrics_task_.Stop();
+  spans_task_.Stop();
+
+  // Send the spans finished before the shutdown
+  exporter_->ExportSpans();
+}
+
+void ExporterComponent::WriteStatistics(
+    utils::statistics::Writer& writer) const {
+  writer["spans"] = exporter_->GetSpanStatistics();
+  writer["metrics"] = exporter_->GetMetricStatistics();
+}
+
+yaml_config::Schema ExporterComponent::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<components::LoggableComponentBase>(R"(
+type: object
+description: Sends the spans and the metrics to an OpenTelemetry collector
+additionalProperties: false
+properties:
+    endpoint:
+        type: string
+        description: address of the OpenTelemetry collector
+    service-name:
+        type: string
+        description: value of the service.name resource attribute
+    client-factory:
+        type: string
+        description: name of the ugrpc::client::ClientFactoryComponent to create the clients
+        defaultDescription: grpc-client-factory
+    max-queue-size:
+        type: integer
+        description: limit on the spans waiting for the export
+        defaultDescription: 65536
+        minimum: 1
+    max-batch-size:
+        type: integer
+        description: limit on the spans in a single export request
+        defaultDescription: 512
+        minimum: 1
+    export-period:
+        type: string
+        description: how often the queued spans are sent
+        defaultDescription: 1s
+    metrics-export-period:
+        type: string
+        description: how often the metrics are sent, the metrics are not exported if not set
+    max-retries:
+        type: integer
+        description: how many times a failed export request is retried
+        defaultDescription: 3
+        minimum: 0
+    retry-backoff:
+        type: string
+        description: delay before the first retry, doubles with each retry
+        defaultDescription: 100ms
+    export-timeout:
+        type: string
+        description: timeout of a single export request
+        defaultDescription: 5s
+)");
+}
+
+}  // namespace otlp
+
+USERVER_NAMESPACE_END
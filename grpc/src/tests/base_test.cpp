@@ -332,4 +332,121 @@ UTEST_F(GrpcWriteAndFinish, BidirectionalStreamAsyncRead) {
   EXPECT_FALSE(result);
 }
 
+namespace {
+
+class ArenaService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    auto* const arena = request.GetArena();
+    EXPECT_NE(arena, nullptr);
+    auto& response =
+        *google::protobuf::Arena::Create<sample::ugrpc::GreetingResponse>(
+            arena);
+    response.set_name("Hello " + request.name());
+    call.Finish(response);
+  }
+};
+
+class GrpcArena : public GrpcServiceFixture {
+ protected:
+  GrpcArena() {
+    ugrpc::server::ServiceOptions options;
+    options.use_arena = true;
+    RegisterService(service_, options);
+    StartServer();
+  }
+
+  ~GrpcArena() override { StopServer(); }
+
+ private:
+  ArenaService service_;
+};
+
+}  // namespace
+
+UTEST_F(GrpcArena, UnaryRPC) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  sample::ugrpc::GreetingRequest out;
+  out.set_name("userver");
+
+  // Later calls use the arena size estimate of the earlier ones
+  for (int i = 0; i < 3; ++i) {
+    auto in = client.SayHello(out).FinishOnArena();
+    EXPECT_EQ(in->name(), "Hello userver");
+    EXPECT_EQ(in->GetArena(), &in.GetArena());
+  }
+}
+
+namespace {
+
+class BufferedWritesService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void ReadMany(ReadManyCall& call,
+                sample::ugrpc::StreamGreetingRequest&& request) override {
+    ugrpc::server::WriteBuffering settings;
+    settings.max_messages = 4;
+    call.EnableWriteBuffering(settings);
+
+    sample::ugrpc::StreamGreetingResponse response;
+    response.set_name("Hello again " + request.name());
+    for (int i = 0; i < request.number(); ++i) {
+      response.set_number(i);
+      call.Write(response);
+    }
+    call.Finish();
+  }
+
+  void Chat(ChatCall& call) override {
+    call.EnableWriteBuffering();
+
+    sample::ugrpc::StreamGreetingRequest request;
+    sample::ugrpc::StreamGreetingResponse response;
+    int count = 0;
+    while (call.Read(request)) {
+      ++count;
+      response.set_number(count);
+      call.Write(response);
+      // The client awaits the response before sending the next request
+      call.Flush();
+    }
+    call.Finish();
+  }
+};
+
+}  // namespace
+
+using GrpcBufferedWrites =
+    GrpcServiceFixtureSimple<USERVER_NAMESPACE::BufferedWritesService>;
+
+UTEST_F(GrpcBufferedWrites, OutputStream) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  sample::ugrpc::StreamGreetingRequest out;
+  out.set_name("userver");
+  out.set_number(kNumber);
+  auto is = client.ReadMany(out);
+
+  sample::ugrpc::StreamGreetingResponse in;
+  for (int i = 0; i < kNumber; ++i) {
+    ASSERT_TRUE(is.Read(in));
+    EXPECT_EQ(in.number(), i);
+  }
+  EXPECT_FALSE(is.Read(in));
+}
+
+UTEST_F(GrpcBufferedWrites, BidirectionalStream) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  auto bs = client.Chat();
+
+  sample::ugrpc::StreamGreetingRequest out;
+  sample::ugrpc::StreamGreetingResponse in;
+  for (int i = 0; i < kNumber; ++i) {
+    UEXPECT_NO_THROW(bs.Write(out));
+    ASSERT_TRUE(bs.Read(in));
+    EXPECT_EQ(in.number(), i + 1);
+  }
+  UEXPECT_NO_THROW(bs.WritesDone());
+  EXPECT_FALSE(bs.Read(in));
+}
+
 USERVER_NAMESPACE_END
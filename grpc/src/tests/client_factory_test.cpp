@@ -1,5 +1,8 @@
 #include <userver/ugrpc/client/client_factory.hpp>
 
+#include <set>
+#include <vector>
+
 #include <userver/engine/task/task.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/formats/yaml/value.hpp>
@@ -41,4 +44,68 @@ UTEST(GrpcClient, ChannelsCount) {
   ASSERT_EQ(kChannelsCount, data.GetChannelToken().GetChannelCount());
 }
 
+UTEST(GrpcClient, ChannelsGrowth) {
+  ugrpc::client::ClientFactoryConfig config;
+  config.channel_count = 1;
+  config.max_channel_count = 3;
+  config.max_concurrent_streams = 1;
+  ugrpc::client::QueueHolder client_queue;
+  utils::statistics::Storage statistics_storage;
+
+  ugrpc::client::ClientFactory client_factory(
+      std::move(config), engine::current_task::GetTaskProcessor(),
+      client_queue.GetQueue(), statistics_storage);
+
+  auto client = client_factory.MakeClient<sample::ugrpc::UnitTestServiceClient>(
+      "[::]:50051");
+  auto& token = ugrpc::client::impl::GetClientData(client).GetChannelToken();
+  EXPECT_EQ(token.GetChannelCount(), 3);
+  EXPECT_EQ(token.GetActiveChannelCount(), 1);
+
+  std::vector<ugrpc::client::impl::ChannelRpcGuard> rpcs;
+  for (std::size_t i = 0; i < 3; ++i) {
+    // Each of the active channels is saturated, another one is activated
+    const auto index = token.PickChannel();
+    EXPECT_EQ(index, i);
+    rpcs.push_back(token.StartRpc(index));
+    EXPECT_EQ(token.GetActiveChannelCount(), i + 1);
+  }
+
+  // The limit is reached
+  EXPECT_LT(token.PickChannel(), 3);
+  EXPECT_EQ(token.GetActiveChannelCount(), 3);
+
+  // The least loaded channel is picked
+  rpcs[1].Release();
+  EXPECT_EQ(token.PickChannel(), 1);
+}
+
+UTEST(GrpcClient, MultipleQueues) {
+  constexpr std::size_t kQueueCount = 3;
+  ugrpc::client::QueueHolder client_queue(kQueueCount);
+  utils::statistics::Storage statistics_storage;
+
+  const auto& queues = client_queue.GetQueues();
+  ASSERT_EQ(queues.GetSize(), kQueueCount);
+  EXPECT_EQ(&queues.GetQueue(0), &client_queue.GetQueue());
+
+  ugrpc::client::ClientFactory client_factory(
+      {}, engine::current_task::GetTaskProcessor(), queues,
+      statistics_storage);
+
+  auto client = client_factory.MakeClient<sample::ugrpc::UnitTestServiceClient>(
+      "[::]:50051");
+  auto& data = ugrpc::client::impl::GetClientData(client);
+
+  std::set<const grpc::CompletionQueue*> used_queues;
+  for (int i = 0; i < 100; ++i) {
+    used_queues.insert(&data.GetQueue());
+  }
+  EXPECT_GT(used_queues.size(), 1U);
+  for (std::size_t i = 0; i < kQueueCount; ++i) {
+    used_queues.erase(&queues.GetQueue(i));
+  }
+  EXPECT_TRUE(used_queues.empty());
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,133 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/engine/single_consumer_event.hpp>
+
+#include <userver/ugrpc/client/exceptions.hpp>
+#include <userver/ugrpc/server/impl/concurrency_limits.hpp>
+#include <userver/ugrpc/server/server.hpp>
+
+#include <tests/service_fixture_test.hpp>
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class BlockingService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    if (request.name() == "block") {
+      started_.Send();
+      EXPECT_TRUE(release_.WaitForEventFor(utest::kMaxTestWaitTime));
+    }
+    sample::ugrpc::GreetingResponse response;
+    response.set_name("Hello " + request.name());
+    call.Finish(response);
+  }
+
+  void WaitStarted() {
+    ASSERT_TRUE(started_.WaitForEventFor(utest::kMaxTestWaitTime));
+  }
+
+  void Release() { release_.Send(); }
+
+ private:
+  engine::SingleConsumerEvent started_;
+  engine::SingleConsumerEvent release_;
+};
+
+class GrpcConcurrencyLimit : public GrpcServiceFixture {
+ protected:
+  explicit GrpcConcurrencyLimit(ugrpc::server::ServiceOptions options) {
+    RegisterService(service_, options);
+    StartServer();
+  }
+
+  ~GrpcConcurrencyLimit() override { StopServer(); }
+
+  BlockingService& GetService() { return service_; }
+
+ private:
+  BlockingService service_;
+};
+
+ugrpc::server::ServiceOptions MakeServiceLimit() {
+  ugrpc::server::ServiceOptions options;
+  options.max_concurrent_rpcs = 1;
+  return options;
+}
+
+ugrpc::server::ServiceOptions MakeMethodLimit() {
+  ugrpc::server::ServiceOptions options;
+  options.method_max_concurrent_rpcs = {{"SayHello", 1}};
+  return options;
+}
+
+class GrpcServiceLimit : public GrpcConcurrencyLimit {
+ protected:
+  GrpcServiceLimit() : GrpcConcurrencyLimit(MakeServiceLimit()) {}
+};
+
+class GrpcMethodLimit : public GrpcConcurrencyLimit {
+ protected:
+  GrpcMethodLimit() : GrpcConcurrencyLimit(MakeMethodLimit()) {}
+};
+
+sample::ugrpc::GreetingRequest MakeRequest(std::string name) {
+  sample::ugrpc::GreetingRequest request;
+  request.set_name(std::move(name));
+  return request;
+}
+
+}  // namespace
+
+UTEST_F(GrpcServiceLimit, Shedding) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+
+  auto blocked = client.SayHello(MakeRequest("block"));
+  GetService().WaitStarted();
+
+  auto shed = client.SayHello(MakeRequest("userver"));
+  UEXPECT_THROW(shed.Finish(), ugrpc::client::ResourceExhaustedError);
+
+  GetService().Release();
+  EXPECT_EQ(blocked.Finish().name(), "Hello block");
+
+  // The slot is free again
+  EXPECT_EQ(client.SayHello(MakeRequest("userver")).Finish().name(),
+            "Hello userver");
+}
+
+UTEST_F(GrpcMethodLimit, Shedding) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+
+  auto blocked = client.SayHello(MakeRequest("block"));
+  GetService().WaitStarted();
+
+  auto shed = client.SayHello(MakeRequest("userver"));
+  UEXPECT_THROW(shed.Finish(), ugrpc::client::ResourceExhaustedError);
+
+  GetService().Release();
+  EXPECT_EQ(blocked.Finish().name(), "Hello block");
+}
+
+UTEST(GrpcConcurrencyLimits, CongestionControl) {
+  ugrpc::server::impl::ConcurrencyLimits limits;
+  auto& limit = limits.Add(10);
+  EXPECT_EQ(limit.GetCapacity(), 10);
+
+  // Half of the load is allowed by the controller
+  limits.SetLimit({50, 100});
+  EXPECT_EQ(limit.GetCapacity(), 5);
+  EXPECT_EQ(limits.Add(4).GetCapacity(), 2);
+
+  limits.SetLimit({1, 100});
+  EXPECT_EQ(limit.GetCapacity(), 1);
+
+  limits.SetLimit({std::nullopt, 100});
+  EXPECT_EQ(limit.GetCapacity(), 10);
+}
+
+USERVER_NAMESPACE_END
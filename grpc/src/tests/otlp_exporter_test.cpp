@@ -0,0 +1,137 @@
+#include <userver/utest/utest.hpp>
+
+#include <vector>
+
+#include <userver/tracing/tags.hpp>
+
+#include <opentelemetry/proto/collector/trace/v1/trace_service_service.usrv.pb.hpp>
+
+#include <otlp/exporter.hpp>
+#include <tests/service_fixture_test.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace collector = opentelemetry::proto::collector::trace::v1;
+
+class TraceServiceMock final : public collector::TraceServiceBase {
+ public:
+  void Export(ExportCall& call,
+              collector::ExportTraceServiceRequest&& request) override {
+    if (failures_left_ > 0) {
+      --failures_left_;
+      call.FinishWithError({grpc::StatusCode::UNAVAILABLE, "try later"});
+      return;
+    }
+    requests_.push_back(std::move(request));
+    call.Finish({});
+  }
+
+  void SetFailures(int count) { failures_left_ = count; }
+
+  const std::vector<collector::ExportTraceServiceRequest>& GetRequests() {
+    return requests_;
+  }
+
+ private:
+  int failures_left_{0};
+  std::vector<collector::ExportTraceServiceRequest> requests_;
+};
+
+class OtlpExporter : public GrpcServiceFixtureSimple<TraceServiceMock> {
+ protected:
+  otlp::impl::Exporter MakeExporter(std::size_t max_queue_size = 16,
+                                    std::size_t max_retries = 0) {
+    otlp::impl::ExporterConfig config;
+    config.service_name = "test-service";
+    config.max_queue_size = max_queue_size;
+    config.max_batch_size = 2;
+    config.max_retries = max_retries;
+    config.retry_backoff = std::chrono::milliseconds{1};
+    return otlp::impl::Exporter{
+        std::move(config),
+        MakeClient<otlp::impl::Exporter::TraceClient>(),
+        MakeClient<otlp::impl::Exporter::MetricsClient>()};
+  }
+
+  static tracing::FinishedSpan MakeSpan(std::string name) {
+    tracing::FinishedSpan span;
+    span.name = std::move(name);
+    span.trace_id = "0123456789abcdef0123456789abcdef";
+    span.span_id = "0123456789abcdef";
+    span.start_time = std::chrono::system_clock::now();
+    span.duration = std::chrono::milliseconds{5};
+    return span;
+  }
+};
+
+}  // namespace
+
+UTEST_F(OtlpExporter, Batches) {
+  auto exporter = MakeExporter();
+  for (const auto* name : {"first", "second", "third"}) {
+    exporter.Export(MakeSpan(name));
+  }
+  auto failed = MakeSpan("failed");
+  failed.tags.emplace_back(tracing::kErrorFlag, true);
+  failed.tags.emplace_back("key", "value");
+  exporter.Export(std::move(failed));
+
+  exporter.ExportSpans();
+
+  const auto& requests = GetService().GetRequests();
+  ASSERT_EQ(requests.size(), 2);
+  const auto& spans = requests[1].resource_spans(0).scope_spans(0).spans();
+  ASSERT_EQ(spans.size(), 2);
+  EXPECT_EQ(spans[0].name(), "third");
+  EXPECT_EQ(spans[0].trace_id().size(), 16);
+  EXPECT_EQ(spans[0].span_id().size(), 8);
+  EXPECT_EQ(spans[0].end_time_unix_nano() - spans[0].start_time_unix_nano(),
+            5'000'000);
+
+  EXPECT_EQ(spans[1].name(), "failed");
+  EXPECT_EQ(spans[1].status().code(),
+            opentelemetry::proto::trace::v1::Status::STATUS_CODE_ERROR);
+  ASSERT_EQ(spans[1].attributes_size(), 1);
+  EXPECT_EQ(spans[1].attributes(0).key(), "key");
+  EXPECT_EQ(spans[1].attributes(0).value().string_value(), "value");
+
+  EXPECT_EQ(exporter.GetSpanStatistics().exported.Load(), 4);
+  EXPECT_EQ(exporter.GetSpanStatistics().dropped.Load(), 0);
+}
+
+UTEST_F(OtlpExporter, QueueOverflow) {
+  auto exporter = MakeExporter(/*max_queue_size=*/1);
+  exporter.Export(MakeSpan("first"));
+  exporter.Export(MakeSpan("second"));
+
+  exporter.ExportSpans();
+
+  ASSERT_EQ(GetService().GetRequests().size(), 1);
+  EXPECT_EQ(exporter.GetSpanStatistics().exported.Load(), 1);
+  EXPECT_EQ(exporter.GetSpanStatistics().dropped.Load(), 1);
+}
+
+UTEST_F(OtlpExporter, Retries) {
+  auto exporter = MakeExporter(/*max_queue_size=*/16, /*max_retries=*/2);
+  GetService().SetFailures(2);
+  exporter.Export(MakeSpan("first"));
+
+  exporter.ExportSpans();
+
+  ASSERT_EQ(GetService().GetRequests().size(), 1);
+  EXPECT_EQ(exporter.GetSpanStatistics().retries.Load(), 2);
+  EXPECT_EQ(exporter.GetSpanStatistics().exported.Load(), 1);
+
+  GetService().SetFailures(3);
+  exporter.Export(MakeSpan("second"));
+
+  exporter.ExportSpans();
+
+  EXPECT_EQ(GetService().GetRequests().size(), 1);
+  EXPECT_EQ(exporter.GetSpanStatistics().failed_batches.Load(), 1);
+  EXPECT_EQ(exporter.GetSpanStatistics().dropped.Load(), 1);
+}
+
+USERVER_NAMESPACE_END
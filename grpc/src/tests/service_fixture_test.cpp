@@ -21,8 +21,11 @@ GrpcServiceFixture::GrpcServiceFixture()
 
 GrpcServiceFixture::~GrpcServiceFixture() = default;
 
-void GrpcServiceFixture::RegisterService(ugrpc::server::ServiceBase& service) {
-  server_.AddService(service, engine::current_task::GetTaskProcessor());
+void GrpcServiceFixture::RegisterService(
+    ugrpc::server::ServiceBase& service,
+    const ugrpc::server::ServiceOptions& options) {
+  server_.AddService(service, engine::current_task::GetTaskProcessor(),
+                     options);
 }
 
 void GrpcServiceFixture::StartServer(
@@ -31,7 +34,7 @@ void GrpcServiceFixture::StartServer(
   endpoint_ = fmt::format("[::1]:{}", server_.GetPort());
   client_factory_.emplace(std::move(client_factory_config),
                           engine::current_task::GetTaskProcessor(),
-                          server_.GetCompletionQueue(), statistics_storage_);
+                          server_.GetCompletionQueues(), statistics_storage_);
 }
 
 void GrpcServiceFixture::StopServer() noexcept {
@@ -21,7 +21,8 @@ class GrpcServiceFixture : public ::testing::Test {
   GrpcServiceFixture();
   ~GrpcServiceFixture() override;
 
-  void RegisterService(ugrpc::server::ServiceBase& service);
+  void RegisterService(ugrpc::server::ServiceBase& service,
+                       const ugrpc::server::ServiceOptions& options = {});
 
   // Must be called after the services are registered
   void StartServer(ugrpc::client::ClientFactoryConfig&& config = {});
@@ -55,6 +55,43 @@ UTEST_F(GrpcStatistics, LongRequest) {
   }
 }
 
+UTEST_F(GrpcStatistics, ExecutionOnServerOnly) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  sample::ugrpc::GreetingRequest out;
+  out.set_name("userver");
+  UEXPECT_THROW(client.SayHello(out).Finish(),
+                ugrpc::client::InvalidArgumentError);
+  GetServer().StopDebug();
+
+  const std::vector<utils::statistics::Label> labels{
+      {"grpc_destination", "sample.ugrpc.UnitTestService/SayHello"},
+      {"percentile", "p100"}};
+
+  const auto server_stats = GetStatistics("grpc.server.by-destination");
+  EXPECT_GE(server_stats.SingleMetric("cpu-time-us", labels).AsInt(), 0);
+  EXPECT_GE(server_stats.SingleMetric("context-switches", labels).AsInt(), 0);
+
+  const auto client_stats = GetStatistics("grpc.client.by-destination");
+  UEXPECT_THROW(client_stats.SingleMetric("cpu-time-us", labels),
+                utils::statistics::MetricQueryError);
+}
+
+UTEST_F(GrpcStatistics, QueueEvents) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  sample::ugrpc::GreetingRequest out;
+  out.set_name("userver");
+  UEXPECT_THROW(client.SayHello(out).Finish(),
+                ugrpc::client::InvalidArgumentError);
+
+  const auto stats = GetStatistics("grpc.server.queues");
+  EXPECT_GT(stats.SingleMetric("events", {{"grpc_queue", "0"}}).AsInt(), 0);
+  EXPECT_GE(stats
+                .SingleMetric("depth",
+                              {{"grpc_queue", "0"}, {"percentile", "p100"}})
+                .AsInt(),
+            1);
+}
+
 UTEST_F_MT(GrpcStatistics, Multithreaded, 2) {
   constexpr int kIterations = 10;
 
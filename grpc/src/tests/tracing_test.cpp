@@ -171,4 +171,37 @@ UTEST_F(GrpcTracing, SpansInDifferentRPCs) {
             GetMetadata(metadata2, kServerParentLink));
 }
 
+namespace {
+
+class GrpcLeanTracing : public GrpcServiceFixture {
+ protected:
+  GrpcLeanTracing() {
+    ugrpc::server::ServiceOptions options;
+    options.lean_tracing = true;
+    RegisterService(service_, options);
+    StartServer();
+  }
+
+  ~GrpcLeanTracing() override { StopServer(); }
+
+ private:
+  UnitTestServiceWithTracingChecks service_;
+};
+
+}  // namespace
+
+UTEST_F(GrpcLeanTracing, UnaryRPC) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  sample::ugrpc::GreetingRequest out;
+  out.set_name("userver");
+  auto call = client.SayHello(out);
+  UEXPECT_NO_THROW(call.Finish());
+  CheckMetadata(call.GetContext());
+
+  // The tracing ids are not echoed by the server itself
+  const auto& metadata = call.GetContext().GetServerInitialMetadata();
+  EXPECT_EQ(metadata.count(ugrpc::impl::kXYaTraceId), 0);
+  EXPECT_EQ(metadata.count(ugrpc::impl::kXYaSpanId), 0);
+}
+
 USERVER_NAMESPACE_END
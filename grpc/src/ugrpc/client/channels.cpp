@@ -48,7 +48,8 @@ namespace {
 [[nodiscard]] bool TryWaitForConnected(
     impl::ChannelCache::Token& token, grpc::CompletionQueue& queue,
     engine::Deadline deadline, engine::TaskProcessor& blocking_task_processor) {
-  auto range = boost::irange(std::size_t{0}, token.GetChannelCount());
+  // Inactive channels stay idle until the load requires them
+  auto range = boost::irange(std::size_t{0}, token.GetActiveChannelCount());
   return std::all_of(range.begin(), range.end(), [&](std::size_t index) {
     return TryWaitForConnected(*token.GetChannel(index), queue, deadline,
                                blocking_task_processor);
@@ -7,6 +7,7 @@
 
 #include <userver/engine/async.hpp>
 #include <userver/logging/level_serialization.hpp>
+#include <userver/utils/statistics/writer.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
 #include <ugrpc/impl/logging.hpp>
@@ -80,6 +81,11 @@ ClientFactoryConfig Parse(const yaml_config::YamlConfig& value,
       value["native-log-level"].As<logging::Level>(config.native_log_level);
   config.channel_count =
       value["channel-count"].As<std::size_t>(config.channel_count);
+  config.max_channel_count =
+      value["max-channel-count"].As<std::size_t>(config.max_channel_count);
+  config.max_concurrent_streams =
+      value["max-concurrent-streams"].As<std::size_t>(
+          config.max_concurrent_streams);
 
   return config;
 }
@@ -88,11 +94,23 @@ ClientFactory::ClientFactory(ClientFactoryConfig&& config,
                              engine::TaskProcessor& channel_task_processor,
                              grpc::CompletionQueue& queue,
                              utils::statistics::Storage& statistics_storage)
+    : ClientFactory(std::move(config), channel_task_processor,
+                    ugrpc::impl::CompletionQueues(queue), statistics_storage) {}
+
+ClientFactory::ClientFactory(ClientFactoryConfig&& config,
+                             engine::TaskProcessor& channel_task_processor,
+                             const ugrpc::impl::CompletionQueues& queues,
+                             utils::statistics::Storage& statistics_storage)
     : channel_task_processor_(channel_task_processor),
-      queue_(queue),
+      queues_(queues),
       channel_cache_(std::move(config.credentials), config.channel_args,
-                     config.channel_count),
-      client_statistics_storage_(statistics_storage, "client") {
+                     config.channel_count, config.max_channel_count,
+                     config.max_concurrent_streams),
+      client_statistics_storage_(
+          statistics_storage, ugrpc::impl::StatisticsDomain::kClient,
+          [this](utils::statistics::Writer& writer) {
+            writer["channels"] = channel_cache_;
+          }) {
   ugrpc::impl::SetupNativeLogging();
   ugrpc::impl::UpdateNativeLogLevel(config.native_log_level);
 }
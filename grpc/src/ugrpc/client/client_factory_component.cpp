@@ -3,6 +3,8 @@
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
 #include <userver/components/statistics_storage.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/writer.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 #include <userver/ugrpc/server/server_component.hpp>
@@ -18,22 +20,31 @@ ClientFactoryComponent::ClientFactoryComponent(
   auto& task_processor =
       context.GetTaskProcessor(config["task-processor"].As<std::string>());
 
-  grpc::CompletionQueue* queue = nullptr;
+  auto& statistics_storage =
+      context.FindComponent<components::StatisticsStorage>().GetStorage();
+
+  const ugrpc::impl::CompletionQueues* queues = nullptr;
   if (auto* const server =
           context.FindComponentOptional<ugrpc::server::ServerComponent>()) {
-    queue = &server->GetServer().GetCompletionQueue();
+    queues = &server->GetServer().GetCompletionQueues();
   } else {
-    queue_.emplace();
-    queue = &queue_->GetQueue();
-  }
+    queue_.emplace(config["completion-queue-count"].As<std::size_t>(1));
+    queues = &queue_->GetQueues();
 
-  auto& statistics_storage =
-      context.FindComponent<components::StatisticsStorage>().GetStorage();
+    queue_statistics_holder_ = statistics_storage.RegisterWriter(
+        "grpc.client.queues",
+        [this](utils::statistics::Writer& writer) { writer = *queue_; },
+        {{"grpc_client_factory", config.Name()}});
+  }
 
-  factory_.emplace(config.As<ClientFactoryConfig>(), task_processor, *queue,
+  factory_.emplace(config.As<ClientFactoryConfig>(), task_processor, *queues,
                    statistics_storage);
 }
 
+ClientFactoryComponent::~ClientFactoryComponent() {
+  queue_statistics_holder_.Unregister();
+}
+
 ClientFactory& ClientFactoryComponent::GetFactory() { return *factory_; }
 
 yaml_config::Schema ClientFactoryComponent::GetStaticConfigSchema() {
@@ -81,6 +92,26 @@ properties:
         description: |
             Number of channels created for each endpoint.
         defaultDescription: 1
+    max-channel-count:
+        type: integer
+        description: |
+            Max number of channels used for each endpoint when the channels
+            in use are saturated with RPCs. Values below channel-count
+            disable the growth.
+        defaultDescription: 0
+    max-concurrent-streams:
+        type: integer
+        description: |
+            In-flight RPCs per channel, after which one more channel is used
+        defaultDescription: 100
+        minimum: 1
+    completion-queue-count:
+        type: integer
+        description: |
+            Number of completion queues, each one is drained by a separate
+            thread. Ignored if the clients use the queues of grpc-server.
+        defaultDescription: 1
+        minimum: 1
 )");
 }
 
@@ -31,6 +31,7 @@ void SetupSpan(std::optional<tracing::InPlaceSpan>& span_holder,
                       ugrpc::impl::ToGrpcString(span.GetSpanId()));
   context.AddMetadata(ugrpc::impl::kXYaRequestId,
                       ugrpc::impl::ToGrpcString(span.GetLink()));
+  context.AddMetadata(ugrpc::impl::kXYaSampled, span.IsSampled() ? "1" : "0");
 }
 
 void SetStatusDetailsForSpan(RpcData& data, grpc::Status& status,
@@ -77,10 +78,12 @@ void FutureImpl::ClearData() noexcept { data_ = nullptr; }
 
 RpcData::RpcData(std::unique_ptr<grpc::ClientContext>&& context,
                  std::string_view call_name,
-                 ugrpc::impl::MethodStatistics& statistics)
+                 ugrpc::impl::MethodStatistics& statistics,
+                 ChannelRpcGuard&& channel_guard)
     : context_(std::move(context)),
       call_name_(call_name),
-      stats_scope_(statistics) {
+      stats_scope_(statistics),
+      channel_guard_(std::move(channel_guard)) {
   UASSERT(context_);
   SetupSpan(span_, *context_, call_name_);
 }
@@ -136,6 +139,8 @@ void RpcData::SetState(State new_state) noexcept {
   state_ = new_state;
 }
 
+void RpcData::ReleaseChannel() noexcept { channel_guard_.Release(); }
+
 void RpcData::EmplaceAsyncMethodInvocation() {
   UINVARIANT(!invocation_.has_value(),
              "Another method is already running for this RPC concurrently");
@@ -162,6 +167,7 @@ RpcData::AsyncMethodInvocationGuard::~AsyncMethodInvocationGuard() noexcept {
 void CheckOk(RpcData& data, bool ok, std::string_view stage) {
   if (!ok) {
     data.SetState(State::kFinished);
+    data.ReleaseChannel();
     data.GetStatsScope().OnNetworkError();
     SetErrorForSpan(data, fmt::format("Network error at '{}'", stage));
     throw RpcInterruptedError(data.GetCallName(), stage);
@@ -179,6 +185,7 @@ void ProcessFinishResult(RpcData& data, bool ok, grpc::Status& status,
   UASSERT_MSG(ok,
               "ok=false in async Finish method invocation is prohibited "
               "by gRPC docs, see grpc::CompletionQueue::Next");
+  data.ReleaseChannel();
   data.GetStatsScope().OnExplicitFinish(status.error_code());
 
   if (!status.ok()) {
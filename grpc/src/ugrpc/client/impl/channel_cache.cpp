@@ -1,12 +1,15 @@
 #include <userver/ugrpc/client/impl/channel_cache.hpp>
 
 #include <algorithm>
+#include <string>
 #include <utility>
 
 #include <grpcpp/create_channel.h>
 #include <grpcpp/security/credentials.h>
 
 #include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+#include <userver/utils/statistics/writer.hpp>
 
 #include <ugrpc/impl/to_string.hpp>
 
@@ -14,6 +17,28 @@ USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::client::impl {
 
+ChannelRpcGuard::ChannelRpcGuard(std::atomic<std::uint64_t>& in_flight) noexcept
+    : in_flight_(&in_flight) {
+  in_flight_->fetch_add(1, std::memory_order_relaxed);
+}
+
+ChannelRpcGuard::ChannelRpcGuard(ChannelRpcGuard&& other) noexcept
+    : in_flight_(std::exchange(other.in_flight_, nullptr)) {}
+
+ChannelRpcGuard& ChannelRpcGuard::operator=(ChannelRpcGuard&& other) noexcept {
+  std::swap(in_flight_, other.in_flight_);
+  return *this;
+}
+
+ChannelRpcGuard::~ChannelRpcGuard() { Release(); }
+
+void ChannelRpcGuard::Release() noexcept {
+  if (in_flight_) {
+    in_flight_->fetch_sub(1, std::memory_order_relaxed);
+    in_flight_ = nullptr;
+  }
+}
+
 ChannelCache::Token::Token(ChannelCache& cache, const std::string& endpoint,
                            CountedChannel& counted_channel) noexcept
     : cache_(&cache), endpoint_(&endpoint), counted_channel_(&counted_channel) {
@@ -55,36 +80,107 @@ std::size_t ChannelCache::Token::GetChannelCount() const noexcept {
   return counted_channel_->channels.size();
 }
 
+std::size_t ChannelCache::Token::GetActiveChannelCount() const noexcept {
+  UASSERT(counted_channel_);
+  return counted_channel_->active_count.load(std::memory_order_relaxed);
+}
+
+std::size_t ChannelCache::Token::PickChannel() const noexcept {
+  UASSERT(cache_);
+  UASSERT(counted_channel_);
+  auto& counted_channel = *counted_channel_;
+
+  const auto active_count =
+      counted_channel.active_count.load(std::memory_order_relaxed);
+  if (active_count == 1 && counted_channel.channels.size() == 1) return 0;
+
+  // Start from a random channel, so that idle channels share the load evenly
+  const auto start = utils::RandRange(active_count);
+  std::size_t best_index = start;
+  auto best_in_flight =
+      counted_channel.in_flight[start].load(std::memory_order_relaxed);
+  for (std::size_t i = 1; i < active_count && best_in_flight != 0; ++i) {
+    const auto index = (start + i) % active_count;
+    const auto in_flight =
+        counted_channel.in_flight[index].load(std::memory_order_relaxed);
+    if (in_flight < best_in_flight) {
+      best_index = index;
+      best_in_flight = in_flight;
+    }
+  }
+
+  if (best_in_flight >= cache_->max_concurrent_streams_ &&
+      active_count < counted_channel.channels.size()) {
+    auto expected = active_count;
+    if (counted_channel.active_count.compare_exchange_strong(
+            expected, active_count + 1, std::memory_order_relaxed)) {
+      return active_count;
+    }
+  }
+  return best_index;
+}
+
+ChannelRpcGuard ChannelCache::Token::StartRpc(std::size_t index) const
+    noexcept {
+  UASSERT(counted_channel_);
+  UASSERT(index < counted_channel_->in_flight.size());
+  return ChannelRpcGuard{counted_channel_->in_flight[index]};
+}
+
 ChannelCache::CountedChannel::CountedChannel(
     const std::string& endpoint,
     const std::shared_ptr<grpc::ChannelCredentials>& credentials,
-    const grpc::ChannelArguments& channel_args, std::size_t count) {
+    const grpc::ChannelArguments& channel_args, std::size_t count,
+    std::size_t max_count)
+    : in_flight(max_count, 0), active_count(count) {
+  UASSERT(count > 0);
+  UASSERT(count <= max_count);
   const auto endpoint_string = ugrpc::impl::ToGrpcString(endpoint);
-  channels = utils::GenerateFixedArray(count, [&](std::size_t) {
+  channels = utils::GenerateFixedArray(max_count, [&](std::size_t) {
     return grpc::CreateCustomChannel(endpoint_string, credentials,
                                      channel_args);
   });
-  UASSERT(count > 0);
 }
 
 ChannelCache::ChannelCache(
     std::shared_ptr<grpc::ChannelCredentials>&& credentials,
-    const grpc::ChannelArguments& channel_args, std::size_t channel_count)
+    const grpc::ChannelArguments& channel_args, std::size_t channel_count,
+    std::size_t max_channel_count, std::size_t max_concurrent_streams)
     : credentials_(std::move(credentials)),
       channel_args_(channel_args),
-      channel_count_(channel_count) {
+      channel_count_(channel_count),
+      max_channel_count_(std::max(channel_count, max_channel_count)),
+      max_concurrent_streams_(max_concurrent_streams) {
   UINVARIANT(channel_count > 0, "Channels count must be greater than zero");
+  UINVARIANT(max_concurrent_streams > 0,
+             "Max concurrent streams must be greater than zero");
 }
 
 ChannelCache::~ChannelCache() = default;
 
 ChannelCache::Token ChannelCache::Get(const std::string& endpoint) {
   auto channels = channels_.Lock();
-  const auto [it, _] = channels->try_emplace(endpoint, endpoint, credentials_,
-                                             channel_args_, channel_count_);
+  const auto [it, _] =
+      channels->try_emplace(endpoint, endpoint, credentials_, channel_args_,
+                            channel_count_, max_channel_count_);
   return {*this, it->first, it->second};
 }
 
+void DumpMetric(utils::statistics::Writer& writer, const ChannelCache& cache) {
+  const auto channels = cache.channels_.Lock();
+  for (const auto& [endpoint, counted_channel] : *channels) {
+    const auto active_count =
+        counted_channel.active_count.load(std::memory_order_relaxed);
+    writer["active-channels"].ValueWithLabels(active_count,
+                                              {"grpc_endpoint", endpoint});
+    for (std::size_t i = 0; i < active_count; ++i) {
+      writer["in-flight"].ValueWithLabels(
+          counted_channel.in_flight[i].load(std::memory_order_relaxed),
+          {{"grpc_endpoint", endpoint}, {"grpc_channel", std::to_string(i)}});
+    }
+  }
+}
+
 }  // namespace ugrpc::client::impl
 
 USERVER_NAMESPACE_END
@@ -1,21 +1,68 @@
 #include <userver/ugrpc/client/queue_holder.hpp>
 
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
 #include <userver/ugrpc/impl/queue_runner.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::client {
 
-struct QueueHolder::Impl final {
+namespace {
+
+struct QueueWithRunner final {
   grpc::CompletionQueue queue;
   ugrpc::impl::QueueRunner queue_runner{queue};
 };
 
-QueueHolder::QueueHolder() = default;
+std::size_t CheckQueueCount(std::size_t queue_count) {
+  UINVARIANT(queue_count > 0, "At least one completion queue is required");
+  return queue_count;
+}
+
+std::vector<grpc::CompletionQueue*> GetQueuePointers(
+    utils::FixedArray<QueueWithRunner>& queues) {
+  std::vector<grpc::CompletionQueue*> result;
+  result.reserve(queues.size());
+  for (auto& queue : queues) result.push_back(&queue.queue);
+  return result;
+}
+
+}  // namespace
+
+struct QueueHolder::Impl final {
+  explicit Impl(std::size_t queue_count)
+      : queues(CheckQueueCount(queue_count)),
+        queue_pointers(GetQueuePointers(queues)) {}
+
+  utils::FixedArray<QueueWithRunner> queues;
+  ugrpc::impl::CompletionQueues queue_pointers;
+};
+
+QueueHolder::QueueHolder(std::size_t queue_count) : impl_(queue_count) {}
 
 QueueHolder::~QueueHolder() = default;
 
-grpc::CompletionQueue& QueueHolder::GetQueue() { return impl_->queue; }
+grpc::CompletionQueue& QueueHolder::GetQueue() {
+  return impl_->queues[0].queue;
+}
+
+const ugrpc::impl::CompletionQueues& QueueHolder::GetQueues() const {
+  return impl_->queue_pointers;
+}
+
+void DumpMetric(utils::statistics::Writer& writer, const QueueHolder& holder) {
+  for (std::size_t i = 0; i < holder.impl_->queues.size(); ++i) {
+    writer.ValueWithLabels(holder.impl_->queues[i].queue_runner,
+                           {"grpc_queue", std::to_string(i)});
+  }
+}
 
 }  // namespace ugrpc::client
 
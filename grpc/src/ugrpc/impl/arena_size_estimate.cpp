@@ -0,0 +1,42 @@
+#include <userver/ugrpc/impl/arena_size_estimate.hpp>
+
+#include <algorithm>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::impl {
+
+namespace {
+
+constexpr std::size_t kMinBlockSize = 256;
+constexpr std::size_t kMaxBlockSize = 1024 * 1024;
+
+// Recent RPCs have the weight of 1 / 2^kDecayShift in the estimate
+constexpr int kDecayShift = 3;
+
+}  // namespace
+
+google::protobuf::ArenaOptions ArenaSizeEstimate::MakeArenaOptions()
+    const noexcept {
+  const auto estimate = estimate_.load(std::memory_order_relaxed);
+  google::protobuf::ArenaOptions options;
+  // Some headroom for the RPCs that are slightly larger than the average
+  options.start_block_size =
+      std::clamp(estimate + estimate / 4, kMinBlockSize, kMaxBlockSize);
+  options.max_block_size = std::max(options.max_block_size, kMaxBlockSize);
+  return options;
+}
+
+void ArenaSizeEstimate::Account(std::size_t space_used) noexcept {
+  // Concurrent updates may be lost, which is fine for an estimate
+  const auto old_estimate = estimate_.load(std::memory_order_relaxed);
+  const auto new_estimate =
+      old_estimate == 0 ? space_used
+                        : old_estimate - (old_estimate >> kDecayShift) +
+                              (space_used >> kDecayShift);
+  estimate_.store(new_estimate, std::memory_order_relaxed);
+}
+
+}  // namespace ugrpc::impl
+
+USERVER_NAMESPACE_END
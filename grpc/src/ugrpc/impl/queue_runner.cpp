@@ -2,7 +2,10 @@
 
 #include <thread>
 
+#include <grpc/support/time.h>
+
 #include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/writer.hpp>
 #include <userver/utils/thread_name.hpp>
 
 #include <userver/ugrpc/impl/async_method_invocation.hpp>
@@ -13,26 +16,16 @@ namespace ugrpc::impl {
 
 namespace {
 
-void ProcessQueue(grpc::CompletionQueue& queue,
-                  engine::SingleUseEvent& completion) noexcept {
-  utils::SetCurrentThreadName("grpc-queue");
-
-  void* tag = nullptr;
-  bool ok = false;
-
-  while (queue.Next(&tag, &ok)) {
-    auto* call = static_cast<EventBase*>(tag);
-    UASSERT(call != nullptr);
-    call->Notify(ok);
-  }
-
-  completion.Send();
+void Notify(void* tag, bool ok) noexcept {
+  auto* call = static_cast<EventBase*>(tag);
+  UASSERT(call != nullptr);
+  call->Notify(ok);
 }
 
 }  // namespace
 
 QueueRunner::QueueRunner(grpc::CompletionQueue& queue) : queue_(queue) {
-  std::thread([this] { ProcessQueue(queue_, completion_); }).detach();
+  std::thread([this] { ProcessQueue(); }).detach();
 }
 
 QueueRunner::~QueueRunner() {
@@ -40,6 +33,35 @@ QueueRunner::~QueueRunner() {
   completion_.WaitNonCancellable();
 }
 
+void QueueRunner::ProcessQueue() noexcept {
+  utils::SetCurrentThreadName("grpc-queue");
+
+  void* tag = nullptr;
+  bool ok = false;
+
+  while (queue_.Next(&tag, &ok)) {
+    // Events that are already completed are drained without blocking. Their
+    // count approximates the queue depth: it only grows above 1 when events
+    // complete faster than the runner handles them.
+    std::uint32_t depth = 0;
+    do {
+      Notify(tag, ok);
+      ++depth;
+    } while (queue_.AsyncNext(&tag, &ok, gpr_inf_past(GPR_CLOCK_MONOTONIC)) ==
+             grpc::CompletionQueue::GOT_EVENT);
+
+    events_.fetch_add(depth, std::memory_order_relaxed);
+    depth_.GetCurrentCounter().Account(depth);
+  }
+
+  completion_.Send();
+}
+
+void DumpMetric(utils::statistics::Writer& writer, const QueueRunner& runner) {
+  writer["events"] = runner.events_.load(std::memory_order_relaxed);
+  writer["depth"] = runner.depth_.GetStatsForPeriod();
+}
+
 }  // namespace ugrpc::impl
 
 USERVER_NAMESPACE_END
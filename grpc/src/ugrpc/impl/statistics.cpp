@@ -1,6 +1,7 @@
 #include <userver/ugrpc/impl/statistics.hpp>
 
 #include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/enumerate.hpp>
 #include <userver/utils/statistics/writer.hpp>
 #include <userver/utils/underlying_value.hpp>
@@ -11,7 +12,18 @@ USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::impl {
 
-MethodStatistics::MethodStatistics() {
+std::string_view ToString(StatisticsDomain domain) {
+  switch (domain) {
+    case StatisticsDomain::kClient:
+      return "client";
+    case StatisticsDomain::kServer:
+      return "server";
+  }
+
+  UINVARIANT(false, "Invalid StatisticsDomain");
+}
+
+MethodStatistics::MethodStatistics(StatisticsDomain domain) : domain_(domain) {
   for (auto& counter : status_codes_) {
     // TODO remove after atomic value-initialization in C++20
     counter.store(0);
@@ -33,13 +45,28 @@ void MethodStatistics::AccountTiming(
   timings_.GetCurrentCounter().Account(timing.count());
 }
 
+void MethodStatistics::AccountExecution(
+    std::chrono::microseconds cpu_time,
+    std::uint64_t context_switches) noexcept {
+  cpu_times_.GetCurrentCounter().Account(cpu_time.count());
+  context_switches_.GetCurrentCounter().Account(context_switches);
+}
+
 void MethodStatistics::AccountNetworkError() noexcept { ++network_errors_; }
 
 void MethodStatistics::AccountInternalError() noexcept { ++internal_errors_; }
 
+ArenaSizeEstimate& MethodStatistics::GetArenaSizeEstimate() noexcept {
+  return arena_size_estimate_;
+}
+
 void DumpMetric(utils::statistics::Writer& writer,
                 const MethodStatistics& stats) {
   writer["timings"] = stats.timings_.GetStatsForPeriod();
+  if (stats.domain_ == StatisticsDomain::kServer) {
+    writer["cpu-time-us"] = stats.cpu_times_.GetStatsForPeriod();
+    writer["context-switches"] = stats.context_switches_.GetStatsForPeriod();
+  }
 
   std::uint64_t total_requests = 0;
   std::uint64_t error_requests = 0;
@@ -75,9 +102,10 @@ void DumpMetric(utils::statistics::Writer& writer,
 
 ServiceStatistics::~ServiceStatistics() = default;
 
-ServiceStatistics::ServiceStatistics(const StaticServiceMetadata& metadata)
+ServiceStatistics::ServiceStatistics(const StaticServiceMetadata& metadata,
+                                     StatisticsDomain domain)
     : metadata_(metadata),
-      method_statistics_(metadata.method_full_names.size()) {}
+      method_statistics_(metadata.method_full_names.size(), domain) {}
 
 MethodStatistics& ServiceStatistics::GetMethodStatistics(
     std::size_t method_id) {
@@ -9,7 +9,9 @@ USERVER_NAMESPACE_BEGIN
 namespace ugrpc::impl {
 
 RpcStatisticsScope::RpcStatisticsScope(MethodStatistics& statistics)
-    : statistics_(statistics), start_time_(std::chrono::steady_clock::now()) {
+    : statistics_(statistics),
+      start_time_(std::chrono::steady_clock::now()),
+      start_execution_(engine::current_task::GetExecutionStatistics()) {
   statistics_.AccountStarted();
 }
 
@@ -54,6 +56,12 @@ void RpcStatisticsScope::AccountTiming() {
   statistics_.AccountTiming(
       std::chrono::duration_cast<std::chrono::milliseconds>(
           std::chrono::steady_clock::now() - *start_time_));
+
+  const auto finish_execution = engine::current_task::GetExecutionStatistics();
+  statistics_.AccountExecution(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          finish_execution.cpu_time - start_execution_.cpu_time),
+      finish_execution.context_switches - start_execution_.context_switches);
   start_time_.reset();
 }
 
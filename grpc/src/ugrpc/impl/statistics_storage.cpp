@@ -1,5 +1,7 @@
 #include <userver/ugrpc/impl/statistics_storage.hpp>
 
+#include <utility>
+
 #include <fmt/format.h>
 
 #include <userver/utils/algo.hpp>
@@ -11,9 +13,11 @@ USERVER_NAMESPACE_BEGIN
 namespace ugrpc::impl {
 
 StatisticsStorage::StatisticsStorage(
-    utils::statistics::Storage& statistics_storage, std::string_view domain) {
+    utils::statistics::Storage& statistics_storage, StatisticsDomain domain,
+    ExtraWriter extra_writer)
+    : domain_(domain), extra_writer_(std::move(extra_writer)) {
   statistics_holder_ = statistics_storage.RegisterWriter(
-      fmt::format("grpc.{}", domain),
+      fmt::format("grpc.{}", ToString(domain)),
       [this](utils::statistics::Writer& writer) { ExtendStatistics(writer); });
 }
 
@@ -38,7 +42,7 @@ ugrpc::impl::ServiceStatistics& StatisticsStorage::GetServiceStatistics(
   std::lock_guard lock(mutex_);
 
   const auto [iter, is_new] =
-      service_statistics_.try_emplace(service_id, metadata);
+      service_statistics_.try_emplace(service_id, metadata, domain_);
   return iter->second;
 }
 
@@ -50,6 +54,7 @@ void StatisticsStorage::ExtendStatistics(utils::statistics::Writer& writer) {
       by_destination = service_stats;
     }
   }
+  if (extra_writer_) extra_writer_(writer);
 }
 
 }  // namespace ugrpc::impl
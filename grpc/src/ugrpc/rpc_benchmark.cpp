@@ -0,0 +1,303 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+#include <userver/ugrpc/client/client_factory.hpp>
+#include <userver/ugrpc/server/server.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kEngineThreads = 4;
+constexpr int kStreamMessages = 100;
+
+using Duration = std::chrono::steady_clock::duration;
+
+class EchoService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  explicit EchoService(bool buffered_writes)
+      : buffered_writes_(buffered_writes) {}
+
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    sample::ugrpc::GreetingResponse response;
+    response.set_name(std::move(*request.mutable_name()));
+    call.Finish(response);
+  }
+
+  void ReadMany(ReadManyCall& call,
+                sample::ugrpc::StreamGreetingRequest&& request) override {
+    if (buffered_writes_) call.EnableWriteBuffering();
+    sample::ugrpc::StreamGreetingResponse response;
+    response.set_name(std::move(*request.mutable_name()));
+    for (int i = 0; i < request.number(); ++i) {
+      response.set_number(i);
+      call.Write(response);
+    }
+    call.Finish();
+  }
+
+  void Chat(ChatCall& call) override {
+    sample::ugrpc::StreamGreetingRequest request;
+    sample::ugrpc::StreamGreetingResponse response;
+    while (call.Read(request)) {
+      response.set_number(request.number());
+      response.set_name(std::move(*request.mutable_name()));
+      call.Write(response);
+    }
+    call.Finish();
+  }
+
+ private:
+  const bool buffered_writes_;
+};
+
+struct Setup final {
+  std::size_t queue_count{1};
+  bool use_arena{false};
+  bool buffered_writes{false};
+};
+
+// An in-process server and a client talking to it over loopback
+class Loopback final {
+ public:
+  explicit Loopback(const Setup& setup)
+      : service_(setup.buffered_writes),
+        server_(MakeServerConfig(setup), statistics_storage_) {
+    ugrpc::server::ServiceOptions options;
+    options.use_arena = setup.use_arena;
+    server_.AddService(service_, engine::current_task::GetTaskProcessor(),
+                       options);
+    server_.Start();
+
+    client_factory_.emplace(ugrpc::client::ClientFactoryConfig{},
+                            engine::current_task::GetTaskProcessor(),
+                            server_.GetCompletionQueues(),
+                            statistics_storage_);
+    client_.emplace(
+        client_factory_->MakeClient<sample::ugrpc::UnitTestServiceClient>(
+            fmt::format("[::1]:{}", server_.GetPort())));
+  }
+
+  ~Loopback() {
+    client_.reset();
+    client_factory_.reset();
+    server_.Stop();
+  }
+
+  sample::ugrpc::UnitTestServiceClient& GetClient() { return *client_; }
+
+ private:
+  static ugrpc::server::ServerConfig MakeServerConfig(const Setup& setup) {
+    ugrpc::server::ServerConfig config;
+    config.port = 0;
+    config.completion_queue_count = setup.queue_count;
+    return config;
+  }
+
+  utils::statistics::Storage statistics_storage_;
+  EchoService service_;
+  ugrpc::server::Server server_;
+  std::optional<ugrpc::client::ClientFactory> client_factory_;
+  std::optional<sample::ugrpc::UnitTestServiceClient> client_;
+};
+
+Duration PerformUnary(sample::ugrpc::UnitTestServiceClient& client,
+                      const sample::ugrpc::GreetingRequest& request,
+                      bool use_arena) {
+  const auto start = std::chrono::steady_clock::now();
+  auto call = client.SayHello(request);
+  const bool ok = use_arena ? call.FinishOnArena()->name() == request.name()
+                            : call.Finish().name() == request.name();
+  if (!ok) throw std::runtime_error("Unexpected response");
+  return std::chrono::steady_clock::now() - start;
+}
+
+Duration PerformServerStream(
+    sample::ugrpc::UnitTestServiceClient& client,
+    const sample::ugrpc::StreamGreetingRequest& request) {
+  const auto start = std::chrono::steady_clock::now();
+  auto call = client.ReadMany(request);
+  sample::ugrpc::StreamGreetingResponse response;
+  int count = 0;
+  while (call.Read(response)) ++count;
+  if (count != request.number()) throw std::runtime_error("Lost messages");
+  return std::chrono::steady_clock::now() - start;
+}
+
+Duration PerformChat(sample::ugrpc::UnitTestServiceClient& client,
+                     sample::ugrpc::StreamGreetingRequest request) {
+  const auto start = std::chrono::steady_clock::now();
+  auto call = client.Chat();
+  sample::ugrpc::StreamGreetingResponse response;
+  for (int i = 0; i < kStreamMessages; ++i) {
+    request.set_number(i);
+    call.Write(request);
+    if (!call.Read(response) || response.number() != i) {
+      throw std::runtime_error("Unexpected response");
+    }
+  }
+  call.WritesDone();
+  if (call.Read(response)) throw std::runtime_error("Unexpected response");
+  return std::chrono::steady_clock::now() - start;
+}
+
+double PercentileMicroseconds(std::vector<Duration>& latencies,
+                              double percentile) {
+  if (latencies.empty()) return 0;
+  const auto pos = latencies.begin() + static_cast<std::ptrdiff_t>(
+                                           (latencies.size() - 1) * percentile);
+  std::nth_element(latencies.begin(), pos, latencies.end());
+  return std::chrono::duration<double, std::micro>(*pos).count();
+}
+
+// Runs `concurrency` RPCs at once per iteration and reports their latencies
+template <typename Perform>
+void RunConcurrently(benchmark::State& state, std::size_t concurrency,
+                     std::size_t messages_per_rpc, std::size_t message_size,
+                     Perform perform) {
+  // warm up the connections
+  for (std::size_t i = 0; i < concurrency; ++i) perform();
+
+  std::vector<Duration> latencies;
+  std::vector<engine::TaskWithResult<Duration>> tasks;
+  tasks.reserve(concurrency);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < concurrency; ++i) {
+      tasks.push_back(engine::AsyncNoSpan(perform));
+    }
+    for (auto& task : tasks) latencies.push_back(task.Get());
+    tasks.clear();
+  }
+
+  const auto messages = static_cast<std::int64_t>(
+      state.iterations() * concurrency * messages_per_rpc);
+  state.SetItemsProcessed(messages);
+  state.SetBytesProcessed(messages * message_size * 2);
+  state.counters["rpcs"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * concurrency),
+      benchmark::Counter::kIsRate);
+  state.counters["p50-us"] = PercentileMicroseconds(latencies, 0.5);
+  state.counters["p99-us"] = PercentileMicroseconds(latencies, 0.99);
+  state.counters["p999-us"] = PercentileMicroseconds(latencies, 0.999);
+}
+
+// range(0) is the message size, range(1) is the count of the concurrent RPCs,
+// range(2) is the count of the completion queues, range(3) enables arenas
+void ugrpc_unary(benchmark::State& state) {
+  engine::RunStandalone(kEngineThreads, [&] {
+    Setup setup;
+    setup.queue_count = state.range(2);
+    setup.use_arena = state.range(3) != 0;
+    Loopback loopback{setup};
+
+    sample::ugrpc::GreetingRequest request;
+    request.set_name(std::string(state.range(0), 'x'));
+
+    RunConcurrently(state, state.range(1), 1, state.range(0), [&] {
+      return PerformUnary(loopback.GetClient(), request, setup.use_arena);
+    });
+  });
+}
+
+// range(0) is the message size, range(1) is the count of the concurrent RPCs,
+// range(2) is the count of the completion queues, range(3) enables the write
+// buffering of the server
+void ugrpc_server_stream(benchmark::State& state) {
+  engine::RunStandalone(kEngineThreads, [&] {
+    Setup setup;
+    setup.queue_count = state.range(2);
+    setup.buffered_writes = state.range(3) != 0;
+    Loopback loopback{setup};
+
+    sample::ugrpc::StreamGreetingRequest request;
+    request.set_name(std::string(state.range(0), 'x'));
+    request.set_number(kStreamMessages);
+
+    const auto perform = [&] {
+      return PerformServerStream(loopback.GetClient(), request);
+    };
+    RunConcurrently(state, state.range(1), kStreamMessages, state.range(0),
+                    perform);
+  });
+}
+
+// range(0) is the message size, range(1) is the count of the concurrent RPCs,
+// range(2) is the count of the completion queues
+void ugrpc_bidirectional_stream(benchmark::State& state) {
+  engine::RunStandalone(kEngineThreads, [&] {
+    Setup setup;
+    setup.queue_count = state.range(2);
+    Loopback loopback{setup};
+
+    sample::ugrpc::StreamGreetingRequest request;
+    request.set_name(std::string(state.range(0), 'x'));
+
+    RunConcurrently(state, state.range(1), kStreamMessages, state.range(0),
+                    [&] { return PerformChat(loopback.GetClient(), request); });
+  });
+}
+
+void UnaryArgs(benchmark::internal::Benchmark* b) {
+  for (const int message_size : {16, 1024, 64 * 1024}) {
+    for (const int concurrency : {1, 16, 64}) {
+      for (const int queue_count : {1, 4}) {
+        for (const int use_arena : {0, 1}) {
+          b->Args({message_size, concurrency, queue_count, use_arena});
+        }
+      }
+    }
+  }
+  b->UseRealTime();
+}
+
+void StreamArgs(benchmark::internal::Benchmark* b) {
+  for (const int message_size : {16, 1024, 64 * 1024}) {
+    for (const int concurrency : {1, 16}) {
+      for (const int queue_count : {1, 4}) {
+        b->Args({message_size, concurrency, queue_count});
+      }
+    }
+  }
+  b->UseRealTime();
+}
+
+void ServerStreamArgs(benchmark::internal::Benchmark* b) {
+  for (const int message_size : {16, 1024, 64 * 1024}) {
+    for (const int concurrency : {1, 16}) {
+      for (const int queue_count : {1, 4}) {
+        for (const int buffered_writes : {0, 1}) {
+          b->Args({message_size, concurrency, queue_count, buffered_writes});
+        }
+      }
+    }
+  }
+  b->UseRealTime();
+}
+
+}  // namespace
+
+BENCHMARK(ugrpc_unary)->Apply(UnaryArgs);
+BENCHMARK(ugrpc_server_stream)->Apply(ServerStreamArgs);
+BENCHMARK(ugrpc_bidirectional_stream)->Apply(StreamArgs);
+
+USERVER_NAMESPACE_END
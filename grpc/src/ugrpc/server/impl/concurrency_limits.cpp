@@ -0,0 +1,62 @@
+#include <userver/ugrpc/server/impl/concurrency_limits.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server::impl {
+
+namespace {
+
+std::size_t ScaleCapacity(std::size_t max_concurrency, double load_ratio) {
+  // A zero capacity would make the RPCs wait for nothing
+  return std::max<std::size_t>(
+      1, static_cast<std::size_t>(std::ceil(max_concurrency * load_ratio)));
+}
+
+}  // namespace
+
+ConcurrencyLimit::ConcurrencyLimit(std::size_t max_concurrency,
+                                   double load_ratio)
+    : max_concurrency_(max_concurrency),
+      semaphore_(ScaleCapacity(max_concurrency, load_ratio)) {
+  UINVARIANT(max_concurrency > 0, "Max concurrency of RPCs must be positive");
+}
+
+engine::SemaphoreLock ConcurrencyLimit::Acquire(engine::Deadline deadline) {
+  return engine::SemaphoreLock{semaphore_, deadline};
+}
+
+void ConcurrencyLimit::SetLoadRatio(double load_ratio) {
+  semaphore_.SetCapacity(ScaleCapacity(max_concurrency_, load_ratio));
+}
+
+std::size_t ConcurrencyLimit::GetCapacity() const noexcept {
+  return semaphore_.GetCapacity();
+}
+
+ConcurrencyLimit& ConcurrencyLimits::Add(std::size_t max_concurrency) {
+  auto limits = limits_.Lock();
+  return limits->emplace_back(max_concurrency, load_ratio_.load());
+}
+
+void ConcurrencyLimits::SetLimit(const congestion_control::Limit& new_limit) {
+  // The controller limits the RPS of the HTTP server, the same share of
+  // the load is kept for RPCs
+  double load_ratio = 1.0;
+  if (new_limit.load_limit && new_limit.current_load > 0) {
+    load_ratio = std::min(1.0, static_cast<double>(*new_limit.load_limit) /
+                                   new_limit.current_load);
+  }
+
+  auto limits = limits_.Lock();
+  load_ratio_ = load_ratio;
+  for (auto& limit : *limits) limit.SetLoadRatio(load_ratio);
+}
+
+}  // namespace ugrpc::server::impl
+
+USERVER_NAMESPACE_END
@@ -1,30 +1,77 @@
 #include <ugrpc/server/impl/queue_holder.hpp>
 
+#include <string>
 #include <utility>
+#include <vector>
 
 #include <userver/ugrpc/impl/queue_runner.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/statistics/writer.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::server::impl {
 
-struct QueueHolder::Impl final {
-  explicit Impl(std::unique_ptr<grpc::ServerCompletionQueue>&& queue)
-      : queue(std::move(queue)) {
-    UASSERT(this->queue);
+namespace {
+
+struct QueueWithRunner final {
+  explicit QueueWithRunner(grpc::ServerBuilder& builder)
+      : queue(builder.AddCompletionQueue()) {
+    UASSERT(queue);
   }
 
   std::unique_ptr<grpc::ServerCompletionQueue> queue;
   ugrpc::impl::QueueRunner queue_runner{*queue};
 };
 
-QueueHolder::QueueHolder(std::unique_ptr<grpc::ServerCompletionQueue>&& queue)
-    : impl_(std::move(queue)) {}
+std::size_t CheckQueueCount(std::size_t queue_count) {
+  UINVARIANT(queue_count > 0, "At least one completion queue is required");
+  return queue_count;
+}
+
+std::vector<grpc::CompletionQueue*> GetQueuePointers(
+    utils::FixedArray<QueueWithRunner>& queues) {
+  std::vector<grpc::CompletionQueue*> result;
+  result.reserve(queues.size());
+  for (auto& queue : queues) result.push_back(queue.queue.get());
+  return result;
+}
+
+}  // namespace
+
+struct QueueHolder::Impl final {
+  Impl(grpc::ServerBuilder& builder, std::size_t queue_count)
+      : queues(CheckQueueCount(queue_count), builder),
+        queue_pointers(GetQueuePointers(queues)) {}
+
+  utils::FixedArray<QueueWithRunner> queues;
+  ugrpc::impl::CompletionQueues queue_pointers;
+};
+
+QueueHolder::QueueHolder(grpc::ServerBuilder& builder, std::size_t queue_count)
+    : impl_(builder, queue_count) {}
 
 QueueHolder::~QueueHolder() = default;
 
-grpc::ServerCompletionQueue& QueueHolder::GetQueue() { return *impl_->queue; }
+std::size_t QueueHolder::GetQueueCount() const noexcept {
+  return impl_->queues.size();
+}
+
+grpc::ServerCompletionQueue& QueueHolder::GetQueue(std::size_t index) {
+  return *impl_->queues[index].queue;
+}
+
+const ugrpc::impl::CompletionQueues& QueueHolder::GetQueues() const noexcept {
+  return impl_->queue_pointers;
+}
+
+void DumpMetric(utils::statistics::Writer& writer, const QueueHolder& holder) {
+  for (std::size_t i = 0; i < holder.impl_->queues.size(); ++i) {
+    writer.ValueWithLabels(holder.impl_->queues[i].queue_runner,
+                           {"grpc_queue", std::to_string(i)});
+  }
+}
 
 }  // namespace ugrpc::server::impl
 
@@ -1,32 +1,45 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
 #include <grpcpp/completion_queue.h>
+#include <grpcpp/server_builder.h>
 
 #include <userver/utils/fast_pimpl.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+
+#include <userver/ugrpc/impl/completion_queues.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::server::impl {
 
-/// @brief Manages a gRPC completion queue, usable in services and clients.
+/// @brief Manages gRPC completion queues, usable in services and clients.
+/// Each of the queues is drained by a separate thread.
 /// @note During shutdown, `QueueHolder`s must be destroyed after
 /// `grpc::Server::Shutdown` is called, but before ugrpc::server::Reactor
 /// instances are destroyed.
 class QueueHolder final {
  public:
-  explicit QueueHolder(std::unique_ptr<grpc::ServerCompletionQueue>&& queue);
+  QueueHolder(grpc::ServerBuilder& builder, std::size_t queue_count);
 
   QueueHolder(QueueHolder&&) = delete;
   QueueHolder& operator=(QueueHolder&&) = delete;
   ~QueueHolder();
 
-  grpc::ServerCompletionQueue& GetQueue();
+  std::size_t GetQueueCount() const noexcept;
+
+  grpc::ServerCompletionQueue& GetQueue(std::size_t index);
+
+  const ugrpc::impl::CompletionQueues& GetQueues() const noexcept;
+
+  friend void DumpMetric(utils::statistics::Writer& writer,
+                         const QueueHolder& holder);
 
  private:
   struct Impl;
-  utils::FastPimpl<Impl, 32, 8> impl_;
+  utils::FastPimpl<Impl, 40, 8> impl_;
 };
 
 }  // namespace ugrpc::server::impl
@@ -1,5 +1,10 @@
 #include <userver/ugrpc/server/impl/service_worker_impl.hpp>
 
+#include <algorithm>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
 #include <userver/logging/log.hpp>
 #include <userver/tracing/tags.hpp>
 #include <userver/utils/algo.hpp>
@@ -11,6 +16,14 @@ USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::server::impl {
 
+const grpc::Status kDeadlineExpiredStatus{
+    grpc::StatusCode::DEADLINE_EXCEEDED,
+    "The deadline expired before the RPC was handled"};
+
+const grpc::Status kConcurrencyLimitStatus{
+    grpc::StatusCode::RESOURCE_EXHAUSTED,
+    "Too many concurrent RPCs, the limit is reached"};
+
 void ReportHandlerError(const std::exception& ex, std::string_view call_name,
                         tracing::Span& span) noexcept {
   LOG_ERROR() << "Uncaught exception in '" << call_name << "': " << ex;
@@ -27,8 +40,8 @@ void ReportNetworkError(const RpcInterruptedError& ex,
 }
 
 void SetupSpan(std::optional<tracing::InPlaceSpan>& span_holder,
-               grpc::ServerContext& context, std::string_view call_name) {
-  auto span_name = utils::StrCat("grpc/", call_name);
+               grpc::ServerContext& context, std::string_view span_name,
+               bool lean_tracing) {
   const auto& client_metadata = context.client_metadata();
 
   const auto* const trace_id =
@@ -36,20 +49,31 @@ void SetupSpan(std::optional<tracing::InPlaceSpan>& span_holder,
   const auto* const parent_span_id =
       utils::FindOrNullptr(client_metadata, ugrpc::impl::kXYaSpanId);
   if (trace_id && parent_span_id) {
-    span_holder.emplace(std::move(span_name), ugrpc::impl::ToString(*trace_id),
+    span_holder.emplace(std::string{span_name},
+                        ugrpc::impl::ToString(*trace_id),
                         ugrpc::impl::ToString(*parent_span_id));
   } else {
-    span_holder.emplace(std::move(span_name));
+    span_holder.emplace(std::string{span_name});
   }
 
   auto& span = span_holder->Get();
 
+  const auto* const sampled =
+      utils::FindOrNullptr(client_metadata, ugrpc::impl::kXYaSampled);
+  if (sampled) span.SetSampled(ugrpc::impl::ToString(*sampled) != "0");
+
   const auto* const parent_link =
       utils::FindOrNullptr(client_metadata, ugrpc::impl::kXYaRequestId);
   if (parent_link) {
     span.SetParentLink(ugrpc::impl::ToString(*parent_link));
   }
 
+  if (lean_tracing) {
+    // Raised by UpdateSpanWithStatus if the RPC fails
+    if (!span.IsSampled()) span.SetLogLevel(logging::Level::kNone);
+    return;
+  }
+
   context.AddInitialMetadata(ugrpc::impl::kXYaTraceId,
                              ugrpc::impl::ToGrpcString(span.GetTraceId()));
   context.AddInitialMetadata(ugrpc::impl::kXYaSpanId,
@@ -58,6 +82,56 @@ void SetupSpan(std::optional<tracing::InPlaceSpan>& span_holder,
                              ugrpc::impl::ToGrpcString(span.GetLink()));
 }
 
+std::vector<std::string> MakeSpanNames(
+    const ugrpc::impl::StaticServiceMetadata& metadata) {
+  std::vector<std::string> span_names;
+  span_names.reserve(metadata.method_full_names.size());
+  for (const auto call_name : metadata.method_full_names) {
+    span_names.push_back(utils::StrCat("grpc/", call_name));
+  }
+  return span_names;
+}
+
+ConcurrencyLimit* MakeServiceLimit(const ServiceSettings& settings) {
+  if (!settings.max_concurrent_rpcs) return nullptr;
+  return &settings.concurrency_limits.Add(*settings.max_concurrent_rpcs);
+}
+
+std::vector<ConcurrencyLimit*> MakeMethodLimits(
+    const ServiceSettings& settings,
+    const ugrpc::impl::StaticServiceMetadata& metadata) {
+  std::vector<ConcurrencyLimit*> limits;
+  limits.reserve(metadata.method_full_names.size());
+  std::size_t found_count = 0;
+  for (const auto call_name : metadata.method_full_names) {
+    const auto method_name = call_name.substr(call_name.rfind('/') + 1);
+    const auto* max_concurrency = utils::FindOrNullptr(
+        settings.method_max_concurrent_rpcs, std::string{method_name});
+    if (max_concurrency) {
+      limits.push_back(&settings.concurrency_limits.Add(*max_concurrency));
+      ++found_count;
+    } else {
+      limits.push_back(nullptr);
+    }
+  }
+
+  if (found_count != settings.method_max_concurrent_rpcs.size()) {
+    throw std::runtime_error(fmt::format(
+        "Unknown methods in the concurrency limits of service '{}'",
+        metadata.service_full_name));
+  }
+  return limits;
+}
+
+engine::Deadline GetQueueDeadline(const ServiceSettings& settings,
+                                  const grpc::ServerContext& context) {
+  const auto rpc_time_left =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          context.deadline() - std::chrono::system_clock::now());
+  return engine::Deadline::FromDuration(
+      std::min(settings.queue_timeout, rpc_time_left));
+}
+
 }  // namespace ugrpc::server::impl
 
 USERVER_NAMESPACE_END
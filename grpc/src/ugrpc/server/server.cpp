@@ -16,13 +16,16 @@
 #include <userver/logging/level_serialization.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
-#include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/entry.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/writer.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
 #include <ugrpc/impl/logging.hpp>
 #include <ugrpc/impl/to_string.hpp>
 #include <ugrpc/server/impl/queue_holder.hpp>
 #include <userver/ugrpc/impl/statistics_storage.hpp>
+#include <userver/ugrpc/server/impl/concurrency_limits.hpp>
 #include <userver/ugrpc/server/impl/service_worker.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -77,6 +80,9 @@ ServerConfig Parse(const yaml_config::YamlConfig& value,
   config.native_log_level =
       value["native-log-level"].As<logging::Level>(logging::Level::kError);
   config.enable_channelz = value["enable-channelz"].As<bool>(false);
+  config.completion_queue_count =
+      value["completion-queue-count"].As<std::size_t>(
+          config.completion_queue_count);
   return config;
 }
 
@@ -86,7 +92,8 @@ class Server::Impl final {
                 utils::statistics::Storage& statistics_storage);
   ~Impl();
 
-  void AddService(ServiceBase& service, engine::TaskProcessor& task_processor);
+  void AddService(ServiceBase& service, engine::TaskProcessor& task_processor,
+                  const ServiceOptions& options);
 
   std::vector<std::string_view> GetServiceNames() const;
 
@@ -94,6 +101,10 @@ class Server::Impl final {
 
   grpc::CompletionQueue& GetCompletionQueue() noexcept;
 
+  const ugrpc::impl::CompletionQueues& GetCompletionQueues() noexcept;
+
+  congestion_control::Limiter& GetConcurrencyLimiter() noexcept;
+
   void Start();
 
   int GetPort() const noexcept;
@@ -116,17 +127,21 @@ class Server::Impl final {
   State state_{State::kConfiguration};
   std::optional<grpc::ServerBuilder> server_builder_;
   std::optional<int> port_;
+  // Must outlive the service workers
+  impl::ConcurrencyLimits concurrency_limits_;
   std::vector<std::unique_ptr<impl::ServiceWorker>> service_workers_;
   std::optional<impl::QueueHolder> queue_;
   std::unique_ptr<grpc::Server> server_;
   mutable engine::Mutex configuration_mutex_;
 
   ugrpc::impl::StatisticsStorage statistics_storage_;
+  utils::statistics::Entry queue_statistics_holder_;
 };
 
 Server::Impl::Impl(ServerConfig&& config,
                    utils::statistics::Storage& statistics_storage)
-    : statistics_storage_(statistics_storage, "server") {
+    : statistics_storage_(statistics_storage,
+                          ugrpc::impl::StatisticsDomain::kServer) {
   LOG_INFO() << "Configuring the gRPC server";
   ugrpc::impl::SetupNativeLogging();
   ugrpc::impl::UpdateNativeLogLevel(config.native_log_level);
@@ -139,11 +154,17 @@ Server::Impl::Impl(ServerConfig&& config,
   }
   server_builder_.emplace();
   ApplyChannelArgs(*server_builder_, config);
-  queue_.emplace(server_builder_->AddCompletionQueue());
+  queue_.emplace(*server_builder_, config.completion_queue_count);
   if (config.port) AddListeningPort(*config.port);
+
+  queue_statistics_holder_ = statistics_storage.RegisterWriter(
+      "grpc.server.queues", [this](utils::statistics::Writer& writer) {
+        writer = *queue_;
+      });
 }
 
 Server::Impl::~Impl() {
+  queue_statistics_holder_.Unregister();
   if (state_ == State::kActive) {
     LOG_DEBUG() << "Stopping the gRPC server automatically. When using Server "
                    "outside of ServerComponent, call Stop() explicitly to "
@@ -167,12 +188,22 @@ void Server::Impl::AddListeningPort(int port) {
 }
 
 void Server::Impl::AddService(ServiceBase& service,
-                              engine::TaskProcessor& task_processor) {
+                              engine::TaskProcessor& task_processor,
+                              const ServiceOptions& options) {
   std::lock_guard lock(configuration_mutex_);
   UASSERT(state_ == State::kConfiguration);
 
+  std::vector<grpc::ServerCompletionQueue*> queues;
+  queues.reserve(queue_->GetQueueCount());
+  for (std::size_t i = 0; i < queue_->GetQueueCount(); ++i) {
+    queues.push_back(&queue_->GetQueue(i));
+  }
+
   service_workers_.push_back(service.MakeWorker(impl::ServiceSettings{
-      queue_->GetQueue(), task_processor, statistics_storage_}));
+      std::move(queues), task_processor, statistics_storage_,
+      options.use_arena, options.lean_tracing, concurrency_limits_,
+      options.max_concurrent_rpcs, options.method_max_concurrent_rpcs,
+      options.queue_timeout}));
 }
 
 std::vector<std::string_view> Server::Impl::GetServiceNames() const {
@@ -196,7 +227,17 @@ void Server::Impl::WithServerBuilder(SetupHook&& setup) {
 
 grpc::CompletionQueue& Server::Impl::GetCompletionQueue() noexcept {
   UASSERT(state_ == State::kConfiguration || state_ == State::kActive);
-  return queue_->GetQueue();
+  return queue_->GetQueue(0);
+}
+
+const ugrpc::impl::CompletionQueues&
+Server::Impl::GetCompletionQueues() noexcept {
+  UASSERT(state_ == State::kConfiguration || state_ == State::kActive);
+  return queue_->GetQueues();
+}
+
+congestion_control::Limiter& Server::Impl::GetConcurrencyLimiter() noexcept {
+  return concurrency_limits_;
 }
 
 void Server::Impl::Start() {
@@ -231,6 +272,7 @@ void Server::Impl::Stop() noexcept {
     server_->Shutdown();
   }
   service_workers_.clear();
+  queue_statistics_holder_.Unregister();
   queue_.reset();
   server_.reset();
 
@@ -274,8 +316,9 @@ Server::Server(ServerConfig&& config,
 Server::~Server() = default;
 
 void Server::AddService(ServiceBase& service,
-                        engine::TaskProcessor& task_processor) {
-  impl_->AddService(service, task_processor);
+                        engine::TaskProcessor& task_processor,
+                        const ServiceOptions& options) {
+  impl_->AddService(service, task_processor, options);
 }
 
 std::vector<std::string_view> Server::GetServiceNames() const {
@@ -290,6 +333,14 @@ grpc::CompletionQueue& Server::GetCompletionQueue() noexcept {
   return impl_->GetCompletionQueue();
 }
 
+const ugrpc::impl::CompletionQueues& Server::GetCompletionQueues() noexcept {
+  return impl_->GetCompletionQueues();
+}
+
+congestion_control::Limiter& Server::GetConcurrencyLimiter() noexcept {
+  return impl_->GetConcurrencyLimiter();
+}
+
 void Server::Start() { return impl_->Start(); }
 
 int Server::GetPort() const noexcept { return impl_->GetPort(); }
@@ -2,6 +2,7 @@
 
 #include <userver/components/component.hpp>
 #include <userver/components/statistics_storage.hpp>
+#include <userver/congestion_control/component.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -14,6 +15,11 @@ ServerComponent::ServerComponent(const components::ComponentConfig& config,
       server_(
           config.As<ServerConfig>(),
           context.FindComponent<components::StatisticsStorage>().GetStorage()) {
+  // The concurrency limits of the services follow the server congestion
+  if (auto* congestion_control =
+          context.FindComponentOptional<congestion_control::Component>()) {
+    congestion_control->RegisterLimiter(server_.GetConcurrencyLimiter());
+  }
 }
 
 Server& ServerComponent::GetServer() noexcept { return server_; }
@@ -54,6 +60,13 @@ properties:
     enable-channelz:
         type: boolean
         description: enable channelz
+    completion-queue-count:
+        type: integer
+        description: |
+            number of completion queues, each one is drained by a separate
+            thread
+        defaultDescription: 1
+        minimum: 1
 )");
 }
 
@@ -1,5 +1,10 @@
 #include <userver/ugrpc/server/service_component_base.hpp>
 
+#include <chrono>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
 #include <userver/utils/assert.hpp>
@@ -11,17 +16,36 @@ USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::server {
 
+namespace {
+
+ServiceOptions MakeServiceOptions(const components::ComponentConfig& config) {
+  ServiceOptions options;
+  options.use_arena = config["use-arena"].As<bool>(false);
+  options.lean_tracing = config["lean-tracing"].As<bool>(false);
+  options.max_concurrent_rpcs =
+      config["max-concurrent-rpcs"].As<std::optional<std::size_t>>();
+  options.method_max_concurrent_rpcs =
+      config["method-max-concurrent-rpcs"]
+          .As<std::unordered_map<std::string, std::size_t>>({});
+  options.queue_timeout =
+      config["queue-timeout"].As<std::chrono::milliseconds>(0);
+  return options;
+}
+
+}  // namespace
+
 ServiceComponentBase::ServiceComponentBase(
     const components::ComponentConfig& config,
     const components::ComponentContext& context)
     : LoggableComponentBase(config, context),
       server_(context.FindComponent<ServerComponent>().GetServer()),
       service_task_processor_(context.GetTaskProcessor(
-          config["task-processor"].As<std::string>())) {}
+          config["task-processor"].As<std::string>())),
+      service_options_(MakeServiceOptions(config)) {}
 
 void ServiceComponentBase::RegisterService(ServiceBase& service) {
   UASSERT_MSG(!registered_.exchange(true), "Register must only be called once");
-  server_.AddService(service, service_task_processor_);
+  server_.AddService(service, service_task_processor_, service_options_);
 }
 
 yaml_config::Schema ServiceComponentBase::GetStaticConfigSchema() {
@@ -33,6 +57,34 @@ properties:
     task-processor:
         type: string
         description: the task processor to use for responses
+    use-arena:
+        type: boolean
+        description: allocate requests on per-RPC protobuf arenas
+        defaultDescription: false
+    lean-tracing:
+        type: boolean
+        description: only log sampled or failed call spans
+        defaultDescription: false
+    max-concurrent-rpcs:
+        type: integer
+        description: max number of concurrently handled RPCs of the service
+        defaultDescription: unlimited
+        minimum: 1
+    method-max-concurrent-rpcs:
+        type: object
+        description: max number of concurrently handled RPCs per method name
+        defaultDescription: '{}'
+        additionalProperties:
+            type: integer
+            description: max number of concurrently handled RPCs of the method
+            minimum: 1
+        properties: {}
+    queue-timeout:
+        type: string
+        description: |
+            how long an RPC may wait for the concurrency limits before it is
+            rejected with RESOURCE_EXHAUSTED, e.g. '10ms'
+        defaultDescription: 0
 )");
 }
 
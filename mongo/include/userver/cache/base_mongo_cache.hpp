@@ -4,6 +4,9 @@
 /// @brief @copybrief components::MongoCache
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -11,6 +14,7 @@
 #include <userver/cache/caching_component_base.hpp>
 #include <userver/cache/mongo_cache_type_traits.hpp>
 #include <userver/components/component_context.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/formats/bson/document.hpp>
 #include <userver/formats/bson/inline.hpp>
 #include <userver/formats/bson/value_builder.hpp>
@@ -18,6 +22,7 @@
 #include <userver/storages/mongo/operations.hpp>
 #include <userver/storages/mongo/options.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/cpu_relax.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
@@ -30,6 +35,9 @@ inline const std::string kFetchAndParseStage = "fetch_and_parse";
 inline constexpr std::chrono::milliseconds kCpuRelaxThreshold{10};
 inline constexpr std::chrono::milliseconds kCpuRelaxInterval{2};
 
+/// Number of the sampled `_id`s per range of a full update by ranges
+inline constexpr std::size_t kFullUpdateSamplesPerRange = 100;
+
 namespace impl {
 
 std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
@@ -74,7 +82,10 @@ std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 ///   static constexpr auto kKeyField = &CachedObject::name;
 ///   // Type of kKeyField
 ///   using KeyType = std::string;
-///   // Type of cache map, e.g. unordered_map, map, bimap
+///   // Type of cache map, e.g. unordered_map, map, bimap. Consider
+///   // cache::ChunkedCowMap for large caches with incremental updates, its
+///   // copies share the unchanged data, or utils::FlatHashMap for a faster
+///   // lookup.
 ///   using DataType = std::unordered_map<KeyType, ObjectType>;
 ///
 ///   // Whether the cache prefers to read from replica (if true, you might get stale data)
@@ -108,6 +119,12 @@ std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 ///   // Whether update part of the cache even if failed to parse some documents
 ///   static constexpr bool kAreInvalidDocumentsSkipped = false;
 ///
+///   // Number of the `_id` ranges read and parsed concurrently on a full
+///   // update, each on its own connection (optional, 1 by default). The range
+///   // bounds are taken from a random sample of the collection `_id`s.
+///   // Requires the default find operation.
+///   static constexpr std::size_t kFullUpdateRangesCount = 8;
+///
 ///   // Component to get the collections
 ///   using MongoCollectionsComponent = components::MongoCollections;
 /// };
@@ -148,8 +165,25 @@ class MongoCache
   std::unique_ptr<typename MongoCacheTraits::DataType> GetData(
       cache::UpdateType type);
 
+  struct RangeData {
+    std::vector<typename MongoCacheTraits::ObjectType> objects;
+    std::size_t documents_count{0};
+    std::size_t parse_failures{0};
+  };
+
+  void UpdateByRanges(cache::UpdateStatisticsScope& stats_scope);
+
+  std::vector<formats::bson::Document> GetRangeFilters(
+      std::size_t ranges_count);
+
+  RangeData ReadRange(formats::bson::Document filter) const;
+
+  void Insert(typename MongoCacheTraits::DataType& cache,
+              typename MongoCacheTraits::ObjectType&& object,
+              cache::UpdateType type) const;
+
   const std::shared_ptr<CollectionsType> mongo_collections_;
-  const storages::mongo::Collection* const mongo_collection_;
+  storages::mongo::Collection* const mongo_collection_;
   const std::chrono::system_clock::duration correction_;
   std::size_t cpu_relax_iterations_{0};
 };
@@ -206,6 +240,14 @@ void MongoCache<MongoCacheTraits>::Update(
     cache::UpdateStatisticsScope& stats_scope) {
   namespace sm = storages::mongo;
 
+  if constexpr (mongo_cache::impl::GetFullUpdateRangesCount<
+                    MongoCacheTraits>() > 1) {
+    if (type == cache::UpdateType::kFull) {
+      UpdateByRanges(stats_scope);
+      return;
+    }
+  }
+
   const auto* collection = mongo_collection_;
   auto find_op = GetFindOperation(type, last_update, now, correction_);
   auto cursor = collection->Execute(find_op);
@@ -217,15 +259,19 @@ void MongoCache<MongoCacheTraits>::Update(
   }
 
   auto scope = tracing::Span::CurrentSpan().CreateScopeTime("copy_data");
+  stats_scope.SetStage(cache::UpdateStage::kBuild);
   auto new_cache = GetData(type);
 
   // No good way to identify whether cursor accesses DB or reads buffed data
   scope.Reset(kFetchAndParseStage);
+  stats_scope.SetStage(cache::UpdateStage::kFetch);
 
   utils::CpuRelax relax{cpu_relax_iterations_, &scope};
   std::size_t doc_count = 0;
 
   for (const auto& doc : cursor) {
+    // the time in the cursor iteration is accounted to the fetch
+    stats_scope.SetStage(cache::UpdateStage::kParse);
     ++doc_count;
 
     relax.Relax();
@@ -233,16 +279,7 @@ void MongoCache<MongoCacheTraits>::Update(
     stats_scope.IncreaseDocumentsReadCount(1);
 
     try {
-      auto object = DeserializeObject(doc);
-      auto key = (object.*MongoCacheTraits::kKeyField);
-
-      if (type == cache::UpdateType::kIncremental ||
-          new_cache->count(key) == 0) {
-        (*new_cache)[key] = std::move(object);
-      } else {
-        LOG_LIMITED_ERROR() << "Found duplicate key for 2 items in cache "
-                            << MongoCacheTraits::kName << ", key=" << key;
-      }
+      Insert(*new_cache, DeserializeObject(doc), type);
     } catch (const std::exception& e) {
       LOG_LIMITED_ERROR() << "Failed to deserialize cache item of cache "
                           << MongoCacheTraits::kName << ", _id="
@@ -252,6 +289,7 @@ void MongoCache<MongoCacheTraits>::Update(
 
       if (!MongoCacheTraits::kAreInvalidDocumentsSkipped) throw;
     }
+    stats_scope.SetStage(cache::UpdateStage::kFetch);
   }
 
   const auto elapsed_time = scope.ElapsedTotal(kFetchAndParseStage);
@@ -266,11 +304,162 @@ void MongoCache<MongoCacheTraits>::Update(
 
   scope.Reset();
 
+  stats_scope.SetStage(cache::UpdateStage::kPublish);
+  const auto size = new_cache->size();
+  this->Set(std::move(new_cache));
+  stats_scope.Finish(size);
+}
+
+template <class MongoCacheTraits>
+void MongoCache<MongoCacheTraits>::UpdateByRanges(
+    cache::UpdateStatisticsScope& stats_scope) {
+  constexpr auto kRangesCount =
+      mongo_cache::impl::GetFullUpdateRangesCount<MongoCacheTraits>();
+
+  auto scope =
+      tracing::Span::CurrentSpan().CreateScopeTime(kFetchAndParseStage);
+  stats_scope.SetStage(cache::UpdateStage::kFetch);
+
+  std::vector<engine::TaskWithResult<RangeData>> tasks;
+  for (auto& filter : GetRangeFilters(kRangesCount)) {
+    tasks.push_back(utils::Async(
+        "mongo-cache-update-range",
+        [this, filter = std::move(filter)]() mutable {
+          return ReadRange(std::move(filter));
+        }));
+  }
+
+  std::vector<RangeData> ranges;
+  ranges.reserve(tasks.size());
+  for (auto& task : tasks) ranges.push_back(task.Get());
+
+  std::size_t doc_count = 0;
+  for (const auto& range : ranges) {
+    doc_count += range.documents_count;
+    stats_scope.IncreaseDocumentsReadCount(range.documents_count);
+    stats_scope.IncreaseDocumentsParseFailures(range.parse_failures);
+  }
+
+  const auto elapsed_time = scope.ElapsedTotal(kFetchAndParseStage);
+  if (elapsed_time > kCpuRelaxThreshold) {
+    // Every range task relaxes independently, so the total rate is an upper
+    // bound of the rate of a single task
+    cpu_relax_iterations_ = static_cast<std::size_t>(
+        static_cast<double>(doc_count) / (elapsed_time / kCpuRelaxInterval));
+  }
+
+  scope.Reset("merge_ranges");
+  stats_scope.SetStage(cache::UpdateStage::kBuild);
+  auto new_cache = GetData(cache::UpdateType::kFull);
+  utils::CpuRelax relax{cpu_relax_iterations_, &scope};
+  for (auto& range : ranges) {
+    for (auto& object : range.objects) {
+      relax.Relax();
+      Insert(*new_cache, std::move(object), cache::UpdateType::kFull);
+    }
+  }
+  scope.Reset();
+
+  stats_scope.SetStage(cache::UpdateStage::kPublish);
   const auto size = new_cache->size();
   this->Set(std::move(new_cache));
   stats_scope.Finish(size);
 }
 
+template <class MongoCacheTraits>
+std::vector<formats::bson::Document>
+MongoCache<MongoCacheTraits>::GetRangeFilters(std::size_t ranges_count) {
+  namespace bson = formats::bson;
+  namespace sm = storages::mongo;
+
+  const auto read_preference =
+      MongoCacheTraits::kIsSecondaryPreferred
+          ? sm::options::ReadPreference::kSecondaryPreferred
+          : sm::options::ReadPreference::kPrimary;
+  const auto sample_size =
+      static_cast<std::int64_t>(ranges_count * kFullUpdateSamplesPerRange);
+  auto cursor = mongo_collection_->Aggregate(
+      bson::MakeArray(
+          bson::MakeDoc("$sample", bson::MakeDoc("size", sample_size)),
+          bson::MakeDoc("$project", bson::MakeDoc("_id", 1)),
+          bson::MakeDoc("$sort", bson::MakeDoc("_id", 1))),
+      read_preference);
+  std::vector<bson::Value> sample;
+  for (const auto& doc : cursor) sample.push_back(doc["_id"]);
+
+  std::vector<bson::Value> bounds;
+  for (std::size_t i = 1; i < ranges_count && !sample.empty(); ++i) {
+    auto bound = sample[i * sample.size() / ranges_count];
+    if (bounds.empty() || bounds.back() != bound) {
+      bounds.push_back(std::move(bound));
+    }
+  }
+  if (bounds.empty()) return {bson::MakeDoc()};
+
+  // The range comparisons match only the `_id`s of the bound type, so the
+  // first range takes everything that is not in the other ranges
+  std::vector<bson::Document> filters;
+  filters.reserve(bounds.size() + 1);
+  filters.push_back(bson::MakeDoc(
+      "_id", bson::MakeDoc("$not", bson::MakeDoc("$gte", bounds.front()))));
+  for (std::size_t i = 0; i < bounds.size(); ++i) {
+    if (i + 1 < bounds.size()) {
+      filters.push_back(bson::MakeDoc(
+          "_id", bson::MakeDoc("$gte", bounds[i], "$lt", bounds[i + 1])));
+    } else {
+      filters.push_back(
+          bson::MakeDoc("_id", bson::MakeDoc("$gte", bounds[i])));
+    }
+  }
+  return filters;
+}
+
+template <class MongoCacheTraits>
+typename MongoCache<MongoCacheTraits>::RangeData
+MongoCache<MongoCacheTraits>::ReadRange(
+    formats::bson::Document filter) const {
+  namespace sm = storages::mongo;
+
+  sm::operations::Find find_op(std::move(filter));
+  if (MongoCacheTraits::kIsSecondaryPreferred) {
+    find_op.SetOption(sm::options::ReadPreference::kSecondaryPreferred);
+  }
+
+  RangeData result;
+  utils::CpuRelax relax{cpu_relax_iterations_, nullptr};
+  for (const auto& doc : mongo_collection_->Execute(find_op)) {
+    relax.Relax();
+    ++result.documents_count;
+    try {
+      result.objects.push_back(DeserializeObject(doc));
+    } catch (const std::exception& e) {
+      LOG_LIMITED_ERROR() << "Failed to deserialize cache item of cache "
+                          << MongoCacheTraits::kName << ", _id="
+                          << doc["_id"].template ConvertTo<std::string>()
+                          << ", what(): " << e;
+      ++result.parse_failures;
+
+      if (!MongoCacheTraits::kAreInvalidDocumentsSkipped) throw;
+    }
+  }
+  return result;
+}
+
+template <class MongoCacheTraits>
+void MongoCache<MongoCacheTraits>::Insert(
+    typename MongoCacheTraits::DataType& cache,
+    typename MongoCacheTraits::ObjectType&& object,
+    cache::UpdateType type) const {
+  auto key = (object.*MongoCacheTraits::kKeyField);
+
+  if (type == cache::UpdateType::kIncremental || cache.count(key) == 0) {
+    cache[key] = std::move(object);
+  } else {
+    LOG_LIMITED_ERROR() << "Found duplicate key for 2 items in cache "
+                        << MongoCacheTraits::kName << ", key=" << key;
+  }
+}
+
 template <class MongoCacheTraits>
 typename MongoCacheTraits::ObjectType
 MongoCache<MongoCacheTraits>::DeserializeObject(
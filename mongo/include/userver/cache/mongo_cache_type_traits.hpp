@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <type_traits>
 
 #include <userver/cache/update_type.hpp>
@@ -99,6 +100,21 @@ template <typename T>
 inline constexpr bool kHasInvalidDocumentsSkipped =
     meta::kIsDetected<HasInvalidDocumentsSkipped, T>;
 
+template <typename T>
+using HasFullUpdateRangesCount = decltype(T::kFullUpdateRangesCount);
+template <typename T>
+inline constexpr bool kHasFullUpdateRangesCount =
+    meta::kIsDetected<HasFullUpdateRangesCount, T>;
+
+template <typename T>
+constexpr std::size_t GetFullUpdateRangesCount() {
+  if constexpr (kHasFullUpdateRangesCount<T>) {
+    return T::kFullUpdateRangesCount;
+  } else {
+    return 1;
+  }
+}
+
 template <typename>
 struct ClassByMemberPointer {};
 template <typename T, typename C>
@@ -129,6 +145,19 @@ struct CheckTraits {
               bool>,
           "Mongo cache traits must specify kUseDefaultFindOperation as bool");
     }
+    if constexpr (kHasFullUpdateRangesCount<MongoCacheTraits>) {
+      static_assert(
+          std::is_convertible_v<
+              decltype(MongoCacheTraits::kFullUpdateRangesCount), std::size_t>,
+          "Mongo cache traits must specify kFullUpdateRangesCount as an "
+          "integer");
+      static_assert(MongoCacheTraits::kFullUpdateRangesCount > 0,
+                    "Mongo cache traits must specify a positive "
+                    "kFullUpdateRangesCount");
+      static_assert(!kHasFindOperation<MongoCacheTraits>,
+                    "Mongo cache traits with kFullUpdateRangesCount must use "
+                    "the default find operation");
+    }
   }
 
   static_assert(kHasCollectionsField<MongoCacheTraits>,
@@ -0,0 +1,243 @@
+#pragma once
+
+/// @file userver/formats/bson/aggregate.hpp
+/// @brief Fast BSON serialization and parsing of aggregates with a
+/// compile-time field layout
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/pfr/core.hpp>
+#include <boost/pfr/tuple_size.hpp>
+
+#include <userver/formats/bson/document.hpp>
+#include <userver/formats/bson/types.hpp>
+#include <userver/formats/bson/value.hpp>
+#include <userver/formats/bson/value_builder.hpp>
+#include <userver/formats/parse/to.hpp>
+#include <userver/formats/serialize/to.hpp>
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::bson {
+
+/// @brief BSON field names of an aggregate, in the order of its members
+///
+/// Specialize in the global namespace to enable the fast path serialization
+/// and parsing of an aggregate:
+///
+/// @code
+/// struct MyStruct {
+///   int id;
+///   std::string name;
+///   std::optional<double> score;
+/// };
+///
+/// template <>
+/// struct formats::bson::AggregateLayout<MyStruct> {
+///   static constexpr std::string_view kFieldNames[] = {"_id", "name",
+///                                                      "score"};
+/// };
+/// @endcode
+///
+/// The document is written into a single buffer preallocated for the size
+/// precomputed from the field layout. Members of the aggregates with
+/// a layout, bool, int, int64_t, double, std::string, Oid and
+/// std::chrono::system_clock::time_point are appended directly, other
+/// members go through their regular Serialize. Parsing matches the document
+/// fields against the layout in order, the documents written in the layout
+/// order are matched without any lookups. Members are parsed as with
+/// `value[name].As<T>()`, missing std::optional members are std::nullopt.
+template <typename T>
+struct AggregateLayout {};
+
+namespace impl {
+
+template <typename T>
+using HasAggregateLayout = decltype(AggregateLayout<T>::kFieldNames);
+
+template <typename T>
+inline constexpr bool kHasAggregateLayout =
+    meta::kIsDetected<HasAggregateLayout, T>;
+
+template <typename T>
+constexpr bool IsLayoutAggregate() {
+  if constexpr (kHasAggregateLayout<T>) {
+    static_assert(std::is_aggregate_v<T>,
+                  "formats::bson::AggregateLayout is specialized for a type "
+                  "that is not an aggregate");
+    static_assert(
+        std::size(AggregateLayout<T>::kFieldNames) ==
+            boost::pfr::tuple_size_v<T>,
+        "formats::bson::AggregateLayout field names count does not match "
+        "the members count of the aggregate");
+    return true;
+  } else {
+    return false;
+  }
+}
+
+class AggregateWriter final {
+ public:
+  explicit AggregateWriter(std::size_t reserved_size);
+  ~AggregateWriter();
+
+  AggregateWriter(const AggregateWriter&) = delete;
+  AggregateWriter& operator=(const AggregateWriter&) = delete;
+
+  void Append(std::string_view key, std::nullptr_t);
+  void Append(std::string_view key, bool);
+  void Append(std::string_view key, int32_t);
+  void Append(std::string_view key, int64_t);
+  void Append(std::string_view key, double);
+  void Append(std::string_view key, std::string_view);
+  void Append(std::string_view key, std::chrono::system_clock::time_point);
+  void Append(std::string_view key, const Oid&);
+  void Append(std::string_view key, const Value&);
+
+  void BeginDocument(std::string_view key);
+  void EndDocument();
+
+  Document Extract();
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+class AggregateReader final {
+ public:
+  AggregateReader(const Value& value, const std::string_view* keys,
+                  std::size_t count);
+
+  Value Get(std::size_t index) const { return Value(members_[index]); }
+
+ private:
+  std::vector<ValueImplPtr> members_;
+};
+
+// BSON element overhead: type byte and key terminator
+inline constexpr std::size_t kElementOverhead = 2;
+// Document overhead: size and terminator
+inline constexpr std::size_t kDocumentOverhead = 5;
+
+template <typename T>
+std::size_t EstimateAggregateSize(const T& value);
+
+template <typename T>
+std::size_t EstimateFieldSize(const T& field) {
+  if constexpr (IsLayoutAggregate<T>()) {
+    return EstimateAggregateSize(field);
+  } else if constexpr (meta::kIsOptional<T>) {
+    return field ? EstimateFieldSize(*field) : 0;
+  } else if constexpr (std::is_same_v<T, bool>) {
+    return 1;
+  } else if constexpr (std::is_same_v<T, int32_t>) {
+    return 4;
+  } else if constexpr (std::is_same_v<T, int64_t> ||
+                       std::is_same_v<T, double> ||
+                       std::is_same_v<T,
+                                      std::chrono::system_clock::time_point>) {
+    return 8;
+  } else if constexpr (std::is_same_v<T, std::string>) {
+    return 4 + field.size() + 1;
+  } else if constexpr (std::is_same_v<T, Oid>) {
+    return 12;
+  } else {
+    // Unknown, the buffer grows if needed
+    return 0;
+  }
+}
+
+template <typename T>
+std::size_t EstimateAggregateSize(const T& value) {
+  std::size_t size = kDocumentOverhead;
+  std::size_t index = 0;
+  boost::pfr::for_each_field(value, [&size, &index](const auto& field) {
+    const auto key = AggregateLayout<T>::kFieldNames[index++];
+    size += kElementOverhead + key.size() + EstimateFieldSize(field);
+  });
+  return size;
+}
+
+template <typename T>
+void WriteAggregate(AggregateWriter& writer, const T& value);
+
+template <typename T>
+void WriteField(AggregateWriter& writer, std::string_view key,
+                const T& field) {
+  if constexpr (IsLayoutAggregate<T>()) {
+    writer.BeginDocument(key);
+    WriteAggregate(writer, field);
+    writer.EndDocument();
+  } else if constexpr (meta::kIsOptional<T>) {
+    if (field) {
+      WriteField(writer, key, *field);
+    } else {
+      writer.Append(key, nullptr);
+    }
+  } else if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, int32_t> ||
+                       std::is_same_v<T, int64_t> ||
+                       std::is_same_v<T, double> ||
+                       std::is_same_v<T,
+                                      std::chrono::system_clock::time_point> ||
+                       std::is_same_v<T, Oid> || std::is_same_v<T, Value> ||
+                       std::is_same_v<T, Document>) {
+    writer.Append(key, field);
+  } else if constexpr (std::is_same_v<T, std::string>) {
+    writer.Append(key, std::string_view{field});
+  } else {
+    writer.Append(key, ValueBuilder(field).ExtractValue());
+  }
+}
+
+template <typename T>
+void WriteAggregate(AggregateWriter& writer, const T& value) {
+  std::size_t index = 0;
+  boost::pfr::for_each_field(value, [&writer, &index](const auto& field) {
+    WriteField(writer, AggregateLayout<T>::kFieldNames[index++], field);
+  });
+}
+
+template <typename T, std::size_t... Indices>
+T ReadAggregate(const AggregateReader& reader,
+                std::index_sequence<Indices...>) {
+  return T{reader.Get(Indices)
+               .template As<boost::pfr::tuple_element_t<Indices, T>>()...};
+}
+
+}  // namespace impl
+
+/// Aggregates with formats::bson::AggregateLayout serialization support
+template <typename T>
+std::enable_if_t<impl::IsLayoutAggregate<T>(), Value> Serialize(
+    const T& value, formats::serialize::To<Value>) {
+  impl::AggregateWriter writer(impl::EstimateAggregateSize(value));
+  impl::WriteAggregate(writer, value);
+  return writer.Extract();
+}
+
+/// Aggregates with formats::bson::AggregateLayout parsing support
+template <typename T>
+std::enable_if_t<impl::IsLayoutAggregate<T>(), T> Parse(
+    const Value& value, formats::parse::To<T>) {
+  constexpr const auto& kNames = AggregateLayout<T>::kFieldNames;
+  const impl::AggregateReader reader(value, std::data(kNames),
+                                     std::size(kNames));
+  return impl::ReadAggregate<T>(
+      reader, std::make_index_sequence<std::size(kNames)>{});
+}
+
+}  // namespace formats::bson
+
+USERVER_NAMESPACE_END
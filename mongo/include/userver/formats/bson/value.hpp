@@ -20,6 +20,8 @@ USERVER_NAMESPACE_BEGIN
 
 namespace formats::bson {
 namespace impl {
+class AggregateReader;
+class AggregateWriter;
 class BsonBuilder;
 class ValueImpl;
 }  // namespace impl
@@ -257,6 +259,8 @@ class Value {
 
  private:
   friend class ValueBuilder;
+  friend class impl::AggregateReader;
+  friend class impl::AggregateWriter;
   friend class impl::BsonBuilder;
 
   impl::ValueImplPtr impl_;
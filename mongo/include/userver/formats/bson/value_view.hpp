@@ -0,0 +1,42 @@
+#pragma once
+
+/// @file userver/formats/bson/value_view.hpp
+/// @brief @copybrief formats::bson::ValueView
+
+#include <userver/formats/bson/document.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::bson {
+
+/// @brief Non-owning view of a BSON document
+///
+/// Refers to the document data owned by someone else, e.g. by a cursor batch,
+/// and must not be used after the owner invalidates it. This also applies to
+/// the values obtained from the viewed document. Use Copy() to keep the
+/// document for longer.
+class ValueView {
+ public:
+  /// @cond
+  /// Borrows a native document, internal use only
+  explicit ValueView(const bson_t*);
+
+  /// Refers to an owned document, internal use only
+  explicit ValueView(Document);
+  /// @endcond
+
+  /// Accesses the viewed document
+  const Document& operator*() const { return doc_; }
+  const Document* operator->() const { return &doc_; }
+
+  /// Returns a copy of the document that does not depend on the owner
+  Document Copy() const;
+
+ private:
+  Document doc_;
+  bool is_borrowed_;
+};
+
+}  // namespace formats::bson
+
+USERVER_NAMESPACE_END
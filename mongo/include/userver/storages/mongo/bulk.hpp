@@ -15,11 +15,24 @@ class CDriverCollectionImpl;
 
 namespace storages::mongo::operations {
 
-/// Efficiently executes a number of operations over a single collection
+/// @brief Efficiently executes a number of operations over a single collection
+///
+/// Unordered bulks are split into chunks of at most kMaxChunkOpsCount
+/// operations and kMaxChunkSizeBytes of documents, and up to
+/// kMaxParallelChunks of them are executed concurrently over separate
+/// connections. The results of the chunks are merged, operation indices
+/// in the merged result refer to the whole bulk.
 class Bulk {
  public:
   enum class Mode { kOrdered, kUnordered };
 
+  /// Max operations count in a chunk of an unordered bulk
+  static constexpr size_t kMaxChunkOpsCount = 10'000;
+  /// Max total size of documents in a chunk of an unordered bulk
+  static constexpr size_t kMaxChunkSizeBytes = 16 * 1024 * 1024;
+  /// Max number of chunks of an unordered bulk executed concurrently
+  static constexpr size_t kMaxParallelChunks = 4;
+
   explicit Bulk(Mode);
   ~Bulk();
 
@@ -76,7 +89,7 @@ class Bulk {
   friend class storages::mongo::impl::cdriver::CDriverCollectionImpl;
 
   class Impl;
-  static constexpr size_t kSize = 48;
+  static constexpr size_t kSize = 72;
   static constexpr size_t kAlignment = 8;
   // MAC_COMPAT: std::string size differs
   utils::FastPimpl<Impl, kSize, kAlignment, false> impl_;
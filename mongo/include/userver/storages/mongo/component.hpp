@@ -60,6 +60,7 @@ namespace components {
 /// local_threshold | latency window for instance selection | mongodb default
 /// max_replication_lag | replication lag limit for usable secondaries, min. 90s | -
 /// maintenance_period | pool maintenance period (idle connections pruning etc.) | 15s
+/// detailed_stats_limit | limit for per host metrics series number, 0 disables them | 0
 /// stats_verbosity | changes the granularity of reported metrics | 'terse'
 /// dns_resolver | server hostname resolver type (getaddrinfo or async) | 'getaddrinfo'
 ///
@@ -67,7 +68,7 @@ namespace components {
 /// Value | Description
 /// ----- | -----------
 /// terse | Default value, report only cumulative stats and read/write totals
-/// full | Separate metrics for each operation, divided by read preference or write concern
+/// full | Separate metrics for each operation, divided by read preference or write concern, and by host if `detailed_stats_limit` is set
 
 // clang-format on
 
@@ -133,6 +134,7 @@ inline constexpr bool kHasValidate<Mongo> = true;
 /// connecting_limit | limit for establishing connections number (per database) | 8
 /// local_threshold | latency window for instance selection | mongodb default
 /// max_replication_lag | replication lag limit for usable secondaries, min. 90s | -
+/// detailed_stats_limit | limit for per host metrics series number (per database), 0 disables them | 0
 /// stats_verbosity | changes the granularity of reported metrics | 'terse'
 /// dns_resolver | server hostname resolver type (getaddrinfo or async) | 'getaddrinfo'
 ///
@@ -140,7 +142,7 @@ inline constexpr bool kHasValidate<Mongo> = true;
 /// Value | Description
 /// ----- | -----------
 /// terse | Default value, report only cumulative stats and read/write totals
-/// full | Separate metrics for each operation, divided by read preference or write concern
+/// full | Separate metrics for each operation, divided by read preference or write concern, and by host if `detailed_stats_limit` is set
 
 // clang-format on
 
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include <userver/formats/bson/document.hpp>
+#include <userver/formats/bson/value_view.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -48,6 +49,11 @@ class Cursor {
     reference operator*() const;
     pointer operator->() const;
 
+    /// @brief Returns the current document without copying it out of the
+    /// cursor batch
+    /// @warning The view is invalidated by advancing the iterator
+    formats::bson::ValueView View() const;
+
     bool operator==(const Iterator&) const;
     bool operator!=(const Iterator&) const;
 
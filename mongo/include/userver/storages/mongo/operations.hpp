@@ -95,6 +95,7 @@ class Find {
   void SetOption(options::Tailable);
   void SetOption(const options::Comment&);
   void SetOption(const options::MaxServerTime&);
+  void SetOption(options::Prefetch);
 
  private:
   friend class storages::mongo::impl::cdriver::CDriverCollectionImpl;
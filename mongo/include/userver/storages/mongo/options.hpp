@@ -259,6 +259,12 @@ class SuppressServerExceptions {};
 /// @see https://docs.mongodb.com/manual/core/tailable-cursors/
 class Tailable {};
 
+/// @brief Fetches the next batch of the cursor in background while the current
+/// one is being iterated over
+/// @note The prefetched documents are copied from the batch buffer, so
+/// Cursor::Iterator::View() saves no copies with this option.
+class Prefetch {};
+
 /// Sets a comment for the operation, which would be visible in profile data
 class Comment {
  public:
@@ -67,6 +67,8 @@ class PoolConfig {
   std::optional<std::chrono::milliseconds> local_threshold;
   /// Pool maintenance period
   std::chrono::milliseconds maintenance_period;
+  /// Per host statistics series limit, 0 disables the per host statistics
+  size_t detailed_stats_limit;
 
   /// Application name (sent to server)
   std::string app_name;
@@ -71,6 +71,18 @@ TEST(CheckTraits, FindOperation) {
                IncorrectSignatureOfFindOperation>);
 }
 
+struct RangesCountTraits {
+  static constexpr std::size_t kFullUpdateRangesCount = 4;
+};
+
+TEST(CheckTraits, FullUpdateRangesCount) {
+  EXPECT_EQ(
+      mongo_cache::impl::GetFullUpdateRangesCount<CorrectMongoCacheTraits>(),
+      std::size_t{1});
+  EXPECT_EQ(mongo_cache::impl::GetFullUpdateRangesCount<RangesCountTraits>(),
+            std::size_t{4});
+}
+
 TEST(CheckTraits, CorrectTraits) {
   mongo_cache::impl::CheckTraits<CorrectMongoCacheTraits>{};
 }
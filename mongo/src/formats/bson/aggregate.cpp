@@ -0,0 +1,131 @@
+#include <userver/formats/bson/aggregate.hpp>
+
+#include <deque>
+
+#include <bson/bson.h>
+
+#include <formats/bson/value_impl.hpp>
+#include <formats/bson/wrappers.hpp>
+#include <userver/formats/bson/exception.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/text.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::bson::impl {
+
+class AggregateWriter::Impl {
+ public:
+  explicit Impl(std::size_t reserved_size)
+      : bson_(MutableBson::AdoptNative(bson_sized_new(reserved_size))) {}
+
+  ~Impl() {
+    // Unfinished subdocuments are left on exceptions
+    while (!subdocuments_.empty()) {
+      bson_destroy(&subdocuments_.back());
+      subdocuments_.pop_back();
+    }
+  }
+
+  bson_t* Current() {
+    return subdocuments_.empty() ? bson_.Get() : &subdocuments_.back();
+  }
+
+  void BeginDocument(std::string_view key) {
+    auto* parent = Current();
+    // bson_t of a subdocument is referenced by its children until finished,
+    // std::deque keeps the addresses stable
+    auto& subdocument = subdocuments_.emplace_back();
+    bson_append_document_begin(parent, key.data(), key.size(), &subdocument);
+  }
+
+  void EndDocument() {
+    UASSERT(!subdocuments_.empty());
+    auto* parent = subdocuments_.size() > 1
+                       ? &subdocuments_[subdocuments_.size() - 2]
+                       : bson_.Get();
+    bson_append_document_end(parent, &subdocuments_.back());
+    bson_destroy(&subdocuments_.back());
+    subdocuments_.pop_back();
+  }
+
+  BsonHolder Extract() {
+    UASSERT(subdocuments_.empty());
+    return bson_.Extract();
+  }
+
+ private:
+  MutableBson bson_;
+  std::deque<bson_t> subdocuments_;
+};
+
+AggregateWriter::AggregateWriter(std::size_t reserved_size)
+    : impl_(std::make_unique<Impl>(reserved_size)) {}
+
+AggregateWriter::~AggregateWriter() = default;
+
+void AggregateWriter::Append(std::string_view key, std::nullptr_t) {
+  bson_append_null(impl_->Current(), key.data(), key.size());
+}
+
+void AggregateWriter::Append(std::string_view key, bool value) {
+  bson_append_bool(impl_->Current(), key.data(), key.size(), value);
+}
+
+void AggregateWriter::Append(std::string_view key, int32_t value) {
+  bson_append_int32(impl_->Current(), key.data(), key.size(), value);
+}
+
+void AggregateWriter::Append(std::string_view key, int64_t value) {
+  bson_append_int64(impl_->Current(), key.data(), key.size(), value);
+}
+
+void AggregateWriter::Append(std::string_view key, double value) {
+  bson_append_double(impl_->Current(), key.data(), key.size(), value);
+}
+
+void AggregateWriter::Append(std::string_view key, std::string_view value) {
+  if (!utils::text::utf8::IsValid(
+          reinterpret_cast<const unsigned char*>(value.data()), value.size())) {
+    throw BsonException("BSON strings must be valid UTF-8");
+  }
+  bson_append_utf8(impl_->Current(), key.data(), key.size(), value.data(),
+                   value.size());
+}
+
+void AggregateWriter::Append(std::string_view key,
+                             std::chrono::system_clock::time_point value) {
+  const int64_t ms_since_epoch =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          value.time_since_epoch())
+          .count();
+  bson_append_date_time(impl_->Current(), key.data(), key.size(),
+                        ms_since_epoch);
+}
+
+void AggregateWriter::Append(std::string_view key, const Oid& value) {
+  bson_append_oid(impl_->Current(), key.data(), key.size(), value.GetNative());
+}
+
+void AggregateWriter::Append(std::string_view key, const Value& value) {
+  value.impl_->CheckNotMissing();
+  bson_append_value(impl_->Current(), key.data(), key.size(),
+                    value.impl_->GetNative());
+}
+
+void AggregateWriter::BeginDocument(std::string_view key) {
+  impl_->BeginDocument(key);
+}
+
+void AggregateWriter::EndDocument() { impl_->EndDocument(); }
+
+Document AggregateWriter::Extract() { return Document(impl_->Extract()); }
+
+AggregateReader::AggregateReader(const Value& value,
+                                 const std::string_view* keys,
+                                 std::size_t count)
+    : members_(value.impl_->GetMembers(keys, count)) {}
+
+}  // namespace formats::bson::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,133 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include <userver/formats/bson.hpp>
+#include <userver/formats/bson/aggregate.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+#include <userver/formats/serialize/common_containers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using formats::parse::To;
+
+struct Car {
+  std::string number;
+  std::string model;
+  int32_t age;
+  double price;
+};
+
+struct Profile {
+  std::string id;
+  std::string uuid;
+  std::string license;
+  int64_t updated_ts;
+  bool free;
+  std::optional<std::string> status;
+  Car car;
+};
+
+// The same structure with the regular customization points
+struct ManualProfile : Profile {};
+
+formats::bson::Value Serialize(const ManualProfile& profile,
+                               formats::serialize::To<formats::bson::Value>) {
+  formats::bson::ValueBuilder builder;
+  builder["_id"] = profile.id;
+  builder["uuid"] = profile.uuid;
+  builder["driver_license"] = profile.license;
+  builder["updated_ts"] = profile.updated_ts;
+  builder["free"] = profile.free;
+  builder["status"] = profile.status;
+  builder["car"]["number"] = profile.car.number;
+  builder["car"]["model"] = profile.car.model;
+  builder["car"]["age"] = profile.car.age;
+  builder["car"]["price"] = profile.car.price;
+  return builder.ExtractValue();
+}
+
+ManualProfile Parse(const formats::bson::Value& value, To<ManualProfile>) {
+  ManualProfile profile;
+  profile.id = value["_id"].As<std::string>();
+  profile.uuid = value["uuid"].As<std::string>();
+  profile.license = value["driver_license"].As<std::string>();
+  profile.updated_ts = value["updated_ts"].As<int64_t>();
+  profile.free = value["free"].As<bool>();
+  profile.status = value["status"].As<std::optional<std::string>>();
+  const auto car = value["car"];
+  profile.car.number = car["number"].As<std::string>();
+  profile.car.model = car["model"].As<std::string>();
+  profile.car.age = car["age"].As<int32_t>();
+  profile.car.price = car["price"].As<double>();
+  return profile;
+}
+
+Profile MakeProfile() {
+  return {"999002_00611f99bab343948edbfb9a0ec7eb39",
+          "00611f99bab343948edbfb9a0ec7eb39",
+          "*********",
+          1553506333,
+          true,
+          "free",
+          {"*********", "Volkswagen Caddy", 2014, 922183.3333333334}};
+}
+
+}  // namespace
+
+template <>
+struct formats::bson::AggregateLayout<Car> {
+  static constexpr std::string_view kFieldNames[] = {"number", "model", "age",
+                                                     "price"};
+};
+
+template <>
+struct formats::bson::AggregateLayout<Profile> {
+  static constexpr std::string_view kFieldNames[] = {
+      "_id", "uuid", "driver_license", "updated_ts", "free", "status", "car"};
+};
+
+void bson_aggregate_serialize(benchmark::State& state) {
+  const auto profile = MakeProfile();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        formats::bson::ValueBuilder(profile).ExtractValue());
+  }
+}
+BENCHMARK(bson_aggregate_serialize);
+
+void bson_aggregate_serialize_manual(benchmark::State& state) {
+  const ManualProfile profile{MakeProfile()};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        formats::bson::ValueBuilder(profile).ExtractValue());
+  }
+}
+BENCHMARK(bson_aggregate_serialize_manual);
+
+void bson_aggregate_parse(benchmark::State& state) {
+  const formats::bson::Document doc =
+      formats::bson::ValueBuilder(MakeProfile()).ExtractValue();
+  for (auto _ : state) {
+    // Copy of the document is not parsed yet
+    const formats::bson::Document copy(doc.GetBson());
+    benchmark::DoNotOptimize(copy.As<Profile>());
+  }
+}
+BENCHMARK(bson_aggregate_parse);
+
+void bson_aggregate_parse_manual(benchmark::State& state) {
+  const formats::bson::Document doc =
+      formats::bson::ValueBuilder(MakeProfile()).ExtractValue();
+  for (auto _ : state) {
+    const formats::bson::Document copy(doc.GetBson());
+    benchmark::DoNotOptimize(copy.As<ManualProfile>());
+  }
+}
+BENCHMARK(bson_aggregate_parse_manual);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/formats/bson.hpp>
+#include <userver/formats/bson/aggregate.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+#include <userver/formats/serialize/common_containers.hpp>
+#include <userver/utest/assert_macros.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fb = formats::bson;
+
+namespace {
+
+struct Inner {
+  int32_t number;
+  std::string text;
+};
+
+struct Outer {
+  fb::Oid id;
+  int64_t counter;
+  double ratio;
+  bool flag;
+  std::chrono::system_clock::time_point updated;
+  std::optional<std::string> comment;
+  Inner inner;
+  std::vector<int> numbers;
+};
+
+}  // namespace
+
+template <>
+struct formats::bson::AggregateLayout<Inner> {
+  static constexpr std::string_view kFieldNames[] = {"number", "text"};
+};
+
+template <>
+struct formats::bson::AggregateLayout<Outer> {
+  static constexpr std::string_view kFieldNames[] = {
+      "_id", "counter", "ratio", "flag", "updated", "comment", "inner", "nums"};
+};
+
+namespace {
+
+Outer MakeOuter() {
+  return {fb::Oid{},
+          42,
+          0.5,
+          true,
+          std::chrono::system_clock::time_point{std::chrono::seconds{100}},
+          std::nullopt,
+          {7, "text"},
+          {1, 2, 3}};
+}
+
+}  // namespace
+
+TEST(BsonAggregate, Serialize) {
+  const auto outer = MakeOuter();
+  const fb::Document doc = fb::ValueBuilder(outer).ExtractValue();
+
+  std::vector<std::string> keys;
+  for (auto it = doc.begin(); it != doc.end(); ++it) {
+    keys.push_back(it.GetName());
+  }
+  const std::vector<std::string> expected_keys{
+      "_id", "counter", "ratio", "flag", "updated", "comment", "inner", "nums"};
+  EXPECT_EQ(keys, expected_keys);
+
+  EXPECT_EQ(doc["_id"].As<fb::Oid>(), outer.id);
+  EXPECT_TRUE(doc["counter"].IsInt64());
+  EXPECT_EQ(doc["counter"].As<int64_t>(), 42);
+  EXPECT_DOUBLE_EQ(doc["ratio"].As<double>(), 0.5);
+  EXPECT_TRUE(doc["flag"].As<bool>());
+  EXPECT_EQ(doc["updated"].As<std::chrono::system_clock::time_point>(),
+            outer.updated);
+  EXPECT_TRUE(doc["comment"].IsNull());
+  EXPECT_TRUE(doc["inner"]["number"].IsInt32());
+  EXPECT_EQ(doc["inner"]["number"].As<int32_t>(), 7);
+  EXPECT_EQ(doc["inner"]["text"].As<std::string>(), "text");
+  EXPECT_EQ(doc["nums"].As<std::vector<int>>(), outer.numbers);
+}
+
+TEST(BsonAggregate, Roundtrip) {
+  auto outer = MakeOuter();
+  outer.comment = "comment";
+
+  const auto parsed = fb::ValueBuilder(outer).ExtractValue().As<Outer>();
+  EXPECT_EQ(parsed.id, outer.id);
+  EXPECT_EQ(parsed.counter, outer.counter);
+  EXPECT_DOUBLE_EQ(parsed.ratio, outer.ratio);
+  EXPECT_EQ(parsed.flag, outer.flag);
+  EXPECT_EQ(parsed.updated, outer.updated);
+  EXPECT_EQ(parsed.comment, outer.comment);
+  EXPECT_EQ(parsed.inner.number, outer.inner.number);
+  EXPECT_EQ(parsed.inner.text, outer.inner.text);
+  EXPECT_EQ(parsed.numbers, outer.numbers);
+}
+
+TEST(BsonAggregate, ParseUnordered) {
+  const auto doc = fb::MakeDoc("extra", 1, "text", "value", "number", 5);
+  const auto inner = doc.As<Inner>();
+  EXPECT_EQ(inner.number, 5);
+  EXPECT_EQ(inner.text, "value");
+
+  // Already parsed by the member access
+  const auto parsed_doc = fb::MakeDoc("number", 5, "text", "value");
+  EXPECT_TRUE(parsed_doc.HasMember("number"));
+  EXPECT_EQ(parsed_doc.As<Inner>().number, 5);
+}
+
+TEST(BsonAggregate, ParseErrors) {
+  UEXPECT_THROW(fb::MakeDoc("number", 1).As<Inner>(),
+                fb::MemberMissingException);
+  UEXPECT_THROW(fb::MakeDoc("number", "1", "text", "").As<Inner>(),
+                fb::TypeMismatchException);
+  UEXPECT_THROW(fb::MakeDoc("number", 1, "text", "", "number", 2).As<Inner>(),
+                fb::ParseException);
+  UEXPECT_THROW(fb::MakeArray(1, "").As<Inner>(), fb::TypeMismatchException);
+}
+
+USERVER_NAMESPACE_END
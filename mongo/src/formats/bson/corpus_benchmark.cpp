@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <formats/common/benchmark_corpus.hpp>
+#include <userver/formats/bson.hpp>
+#include <userver/formats/bson/serialize.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using formats::corpus::Document;
+using formats::corpus::RegisterBenchmarks;
+
+template <typename Function>
+void RunIterations(benchmark::State& state, std::size_t bytes,
+                   Function function) {
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(function());
+  }
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+void RegisterBsonBenchmarks() {
+  RegisterBenchmarks(
+      "bson", "parse", [](benchmark::State& state, const Document& document) {
+        const auto binary = formats::bson::ToBinaryString(
+            formats::bson::FromJsonString(document.json));
+        const auto view = binary.GetView();
+        RunIterations(state, view.size(), [view] {
+          return formats::bson::FromBinaryString(view);
+        });
+      });
+  RegisterBenchmarks(
+      "bson", "serialize",
+      [](benchmark::State& state, const Document& document) {
+        const auto value = formats::bson::FromJsonString(document.json);
+        const auto size = formats::bson::ToBinaryString(value).Size();
+        RunIterations(state, size, [&value] {
+          return formats::bson::ToBinaryString(value).Size();
+        });
+      });
+  RegisterBenchmarks(
+      "bson", "value_builder_roundtrip",
+      [](benchmark::State& state, const Document& document) {
+        const auto value = formats::bson::FromJsonString(document.json);
+        const auto size = formats::bson::ToBinaryString(value).Size();
+        RunIterations(state, size, [&value] {
+          formats::bson::ValueBuilder builder{value};
+          return formats::bson::Document{builder.ExtractValue()};
+        });
+      });
+  RegisterBenchmarks(
+      "bson", "parse_to_struct",
+      [](benchmark::State& state, const Document& document) {
+        const auto value = formats::bson::FromJsonString(document.json);
+        const auto size = formats::bson::ToBinaryString(value).Size();
+        RunIterations(state, size, [&value, &document] {
+          return formats::corpus::ParseToStructs(document.kind, value);
+        });
+      });
+}
+
+[[maybe_unused]] const bool kRegistered = [] {
+  RegisterBsonBenchmarks();
+  return true;
+}();
+
+}  // namespace
+
+USERVER_NAMESPACE_END
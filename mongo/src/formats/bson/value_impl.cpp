@@ -1,5 +1,6 @@
 #include <formats/bson/value_impl.hpp>
 
+#include <algorithm>
 #include <cstring>
 
 #include <formats/bson/wrappers.hpp>
@@ -393,6 +394,65 @@ bool ValueImpl::HasMember(const std::string& name) {
   return std::get<ParsedDocument>(*parsed_value_.load()).count(name);
 }
 
+std::vector<ValueImplPtr> ValueImpl::GetMembers(const std::string_view* keys,
+                                                std::size_t count) {
+  std::vector<ValueImplPtr> members(count);
+  if (!IsMissing() && !IsNull()) {
+    CheckIsDocument();
+    if (const auto* parsed_ptr = parsed_value_.load()) {
+      const auto& parsed_doc = std::get<ParsedDocument>(*parsed_ptr);
+      for (std::size_t i = 0; i < count; ++i) {
+        auto it = parsed_doc.find(std::string(keys[i]));
+        if (it != parsed_doc.end()) members[i] = it->second;
+      }
+    } else {
+      // Fields are usually stored in the order of the keys, so the next key
+      // is checked before the search
+      std::size_t next_index = 0;
+      ForEachValue(
+          bson_value_.value.v_doc.data, bson_value_.value.v_doc.data_len, path_,
+          [this, keys, count, &members, &next_index](bson_iter_t* it) {
+            std::string_view key(bson_iter_key(it), bson_iter_key_len(it));
+            auto index = next_index;
+            if (index >= count || keys[index] != key) {
+              index = std::find(keys, keys + count, key) - keys;
+              if (index == count) return;
+            }
+            next_index = index + 1;
+
+            const bson_value_t* iter_value = bson_iter_value(it);
+            if (!iter_value) {
+              throw ParseException(
+                  fmt::format("malformed BSON element at {}.{}",
+                              path_.ToStringView(), key));
+            }
+            if (members[index]) {
+              switch (duplicate_fields_policy_) {
+                case Value::DuplicateFieldsPolicy::kForbid:
+                  throw ParseException(fmt::format("duplicate key '{}' at {}",
+                                                   key, path_.ToStringView()));
+                case Value::DuplicateFieldsPolicy::kUseFirst:
+                  return;
+                case Value::DuplicateFieldsPolicy::kUseLast:
+                  break;
+              }
+            }
+            members[index] = std::make_shared<ValueImpl>(
+                EmplaceEnabler{}, storage_, path_, *iter_value,
+                duplicate_fields_policy_, std::string(key));
+          });
+    }
+  }
+
+  for (std::size_t i = 0; i < count; ++i) {
+    if (members[i]) continue;
+    members[i] = std::make_shared<ValueImpl>(
+        EmplaceEnabler{}, nullptr, path_, kDefaultBsonValue,
+        duplicate_fields_policy_, std::string(keys[i]));
+  }
+  return members;
+}
+
 ValueImplPtr ValueImpl::GetOrInsert(const std::string& key) {
   if (IsMissing() || IsNull()) {
     RelaxedSetParsedValue(parsed_value_, ParsedDocument());
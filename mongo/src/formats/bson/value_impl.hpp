@@ -3,7 +3,9 @@
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <string_view>
 #include <variant>
+#include <vector>
 
 #include <bson/bson.h>
 
@@ -60,6 +62,10 @@ class ValueImpl {
 
   bool HasMember(const std::string& name);
 
+  // Members in the order of the keys, missing ones for the absent keys
+  std::vector<ValueImplPtr> GetMembers(const std::string_view* keys,
+                                       std::size_t count);
+
   ValueImplPtr GetOrInsert(const std::string& key);
   void Resize(uint32_t size);
   void PushBack(ValueImplPtr);
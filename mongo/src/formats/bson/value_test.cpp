@@ -25,6 +25,21 @@ static_assert(!std::is_assignable_v<
                   decltype(*std::declval<fb::Value>().begin()), fb::Value>,
               "Value iterators are not assignable");
 
+TEST(BsonValue, View) {
+  const fb::ValueView owning_view{kDoc};
+  EXPECT_EQ(kDoc, *owning_view);
+  EXPECT_EQ(kDoc, owning_view.Copy());
+
+  const fb::ValueView view{kDoc.GetBson().get()};
+  EXPECT_FALSE(view->IsMissing());
+  EXPECT_TRUE((*view)["doc"]["b"].As<bool>());
+  EXPECT_EQ(kDoc, *view);
+
+  const auto copy = view.Copy();
+  EXPECT_EQ(kDoc, copy);
+  EXPECT_NE(kDoc.GetBson().get(), copy.GetBson().get());
+}
+
 TEST(BsonValue, SubvalAccess) {
   EXPECT_TRUE(kDoc["missing"].IsMissing());
   EXPECT_TRUE(kDoc["arr"].IsArray());
@@ -0,0 +1,23 @@
+#include <userver/formats/bson/value_view.hpp>
+
+#include <formats/bson/wrappers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::bson {
+
+ValueView::ValueView(const bson_t* bson)
+    : doc_(impl::BsonHolder(bson, [](const bson_t*) {})), is_borrowed_(true) {}
+
+ValueView::ValueView(Document doc)
+    : doc_(std::move(doc)), is_borrowed_(false) {}
+
+Document ValueView::Copy() const {
+  if (!is_borrowed_) return doc_;
+  return Document(
+      impl::MutableBson::CopyNative(doc_.GetBson().get()).Extract());
+}
+
+}  // namespace formats::bson
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,7 @@
 #include <mongoc/mongoc.h>
 
 #include <userver/storages/mongo/mongo_error.hpp>
+#include <userver/utils/assert.hpp>
 
 #include <storages/mongo/bulk_ops_impl.hpp>
 #include <storages/mongo/operations_common.hpp>
@@ -13,34 +14,60 @@ USERVER_NAMESPACE_BEGIN
 namespace storages::mongo::operations {
 namespace {
 
-auto EnsureBulk(impl::cdriver::BulkOperationPtr& bulk_ptr, Bulk::Mode mode) {
-  if (!bulk_ptr) {
-    const bool is_ordered = (mode == Bulk::Mode::kOrdered);
-    bulk_ptr.reset(mongoc_bulk_operation_new(is_ordered));
-  }
-  return bulk_ptr.get();
+size_t GetSize(const formats::bson::Document& doc) {
+  return doc.GetBson()->len;
 }
 
 }  // namespace
 
+mongoc_bulk_operation_t* Bulk::Impl::GetChunk(size_t op_size_bytes) {
+  const bool is_ordered = (mode == Mode::kOrdered);
+  // an empty chunk can only be the last one
+  if (chunks.empty() ||
+      (!is_ordered && chunks.back().ops_count &&
+       (chunks.back().ops_count >= kMaxChunkOpsCount ||
+        chunks.back().size_bytes + op_size_bytes > kMaxChunkSizeBytes))) {
+    auto& chunk = chunks.emplace_back();
+    chunk.bulk.reset(mongoc_bulk_operation_new(is_ordered));
+    if (write_concern) {
+      mongoc_bulk_operation_set_write_concern(chunk.bulk.get(),
+                                              write_concern.get());
+    }
+  }
+  return chunks.back().bulk.get();
+}
+
+void Bulk::Impl::AccountAppended(size_t op_size_bytes) {
+  UASSERT(!chunks.empty());
+  auto& chunk = chunks.back();
+  ++chunk.ops_count;
+  chunk.size_bytes += op_size_bytes;
+}
+
 Bulk::Bulk(Mode mode) : impl_(mode) {}
 Bulk::~Bulk() = default;
 
 Bulk::Bulk(Bulk&&) noexcept = default;
 Bulk& Bulk::operator=(Bulk&&) noexcept = default;
 
-bool Bulk::IsEmpty() const { return !impl_->bulk; }
+bool Bulk::IsEmpty() const {
+  return impl_->chunks.empty() || !impl_->chunks.front().ops_count;
+}
 
 void Bulk::SetOption(options::WriteConcern::Level level) {
-  mongoc_bulk_operation_set_write_concern(
-      EnsureBulk(impl_->bulk, impl_->mode),
-      impl::MakeCDriverWriteConcern(level).get());
+  impl_->write_concern = impl::MakeCDriverWriteConcern(level);
+  for (const auto& chunk : impl_->chunks) {
+    mongoc_bulk_operation_set_write_concern(chunk.bulk.get(),
+                                            impl_->write_concern.get());
+  }
 }
 
 void Bulk::SetOption(const options::WriteConcern& write_concern) {
-  mongoc_bulk_operation_set_write_concern(
-      EnsureBulk(impl_->bulk, impl_->mode),
-      impl::MakeCDriverWriteConcern(write_concern).get());
+  impl_->write_concern = impl::MakeCDriverWriteConcern(write_concern);
+  for (const auto& chunk : impl_->chunks) {
+    mongoc_bulk_operation_set_write_concern(chunk.bulk.get(),
+                                            impl_->write_concern.get());
+  }
 }
 
 void Bulk::SetOption(options::SuppressServerExceptions) {
@@ -49,30 +76,38 @@ void Bulk::SetOption(options::SuppressServerExceptions) {
 
 void Bulk::Append(const bulk_ops::InsertOne& insert_subop) {
   MongoError error;
-  const bson_t* native_bson_ptr = insert_subop.impl_->document.GetBson().get();
-  if (!mongoc_bulk_operation_insert_with_opts(
-          EnsureBulk(impl_->bulk, impl_->mode), native_bson_ptr, nullptr,
-          error.GetNative())) {
+  const auto& document = insert_subop.impl_->document;
+  const auto op_size = GetSize(document);
+  const bson_t* native_bson_ptr = document.GetBson().get();
+  if (!mongoc_bulk_operation_insert_with_opts(impl_->GetChunk(op_size),
+                                              native_bson_ptr, nullptr,
+                                              error.GetNative())) {
     error.Throw("Error appending insert to bulk");
   }
+  impl_->AccountAppended(op_size);
 }
 
 void Bulk::Append(const bulk_ops::ReplaceOne& replace_subop) {
   MongoError error;
+  const auto op_size = GetSize(replace_subop.impl_->selector) +
+                       GetSize(replace_subop.impl_->replacement);
   const bson_t* native_selector_bson_ptr =
       replace_subop.impl_->selector.GetBson().get();
   const bson_t* native_replacement_bson_ptr =
       replace_subop.impl_->replacement.GetBson().get();
   if (!mongoc_bulk_operation_replace_one_with_opts(
-          EnsureBulk(impl_->bulk, impl_->mode), native_selector_bson_ptr,
+          impl_->GetChunk(op_size), native_selector_bson_ptr,
           native_replacement_bson_ptr,
           impl::GetNative(replace_subop.impl_->options), error.GetNative())) {
     error.Throw("Error appending replace to bulk");
   }
+  impl_->AccountAppended(op_size);
 }
 
 void Bulk::Append(const bulk_ops::Update& update_subop) {
   MongoError error;
+  const auto op_size = GetSize(update_subop.impl_->selector) +
+                       GetSize(update_subop.impl_->update);
   const bson_t* native_selector_bson_ptr =
       update_subop.impl_->selector.GetBson().get();
   const bson_t* native_update_bson_ptr =
@@ -81,40 +116,43 @@ void Bulk::Append(const bulk_ops::Update& update_subop) {
   switch (update_subop.impl_->mode) {
     case bulk_ops::Update::Mode::kSingle:
       has_succeeded = mongoc_bulk_operation_update_one_with_opts(
-          EnsureBulk(impl_->bulk, impl_->mode), native_selector_bson_ptr,
+          impl_->GetChunk(op_size), native_selector_bson_ptr,
           native_update_bson_ptr, impl::GetNative(update_subop.impl_->options),
           error.GetNative());
       break;
 
     case bulk_ops::Update::Mode::kMulti:
       has_succeeded = mongoc_bulk_operation_update_many_with_opts(
-          EnsureBulk(impl_->bulk, impl_->mode), native_selector_bson_ptr,
+          impl_->GetChunk(op_size), native_selector_bson_ptr,
           native_update_bson_ptr, impl::GetNative(update_subop.impl_->options),
           error.GetNative());
       break;
   }
   if (!has_succeeded) error.Throw("Error appending update to bulk");
+  impl_->AccountAppended(op_size);
 }
 
 void Bulk::Append(const bulk_ops::Delete& delete_subop) {
   MongoError error;
+  const auto op_size = GetSize(delete_subop.impl_->selector);
   const bson_t* native_selector_bson_ptr =
       delete_subop.impl_->selector.GetBson().get();
   bool has_succeeded = false;
   switch (delete_subop.impl_->mode) {
     case bulk_ops::Delete::Mode::kSingle:
       has_succeeded = mongoc_bulk_operation_remove_one_with_opts(
-          EnsureBulk(impl_->bulk, impl_->mode), native_selector_bson_ptr,
-          nullptr, error.GetNative());
+          impl_->GetChunk(op_size), native_selector_bson_ptr, nullptr,
+          error.GetNative());
       break;
 
     case bulk_ops::Delete::Mode::kMulti:
       has_succeeded = mongoc_bulk_operation_remove_many_with_opts(
-          EnsureBulk(impl_->bulk, impl_->mode), native_selector_bson_ptr,
-          nullptr, error.GetNative());
+          impl_->GetChunk(op_size), native_selector_bson_ptr, nullptr,
+          error.GetNative());
       break;
   }
   if (!has_succeeded) error.Throw("Error appending delete to bulk");
+  impl_->AccountAppended(op_size);
 }
 
 }  // namespace storages::mongo::operations
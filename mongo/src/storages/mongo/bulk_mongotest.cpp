@@ -277,4 +277,34 @@ UTEST_F(Bulk, Mixed) {
   EXPECT_TRUE(upserted_ids[5].IsOid());
 }
 
+UTEST_F(Bulk, UnorderedChunks) {
+  auto coll = GetDefaultPool().GetCollection("unordered_chunks");
+  coll.InsertOne(bson::MakeDoc("_id", 1));
+
+  constexpr int kOpsCount = 3 * mongo::operations::Bulk::kMaxChunkOpsCount;
+  constexpr int kDuplicateIndex = kOpsCount - 2;
+  auto bulk =
+      coll.MakeUnorderedBulk(mongo::options::SuppressServerExceptions{});
+  for (int i = 0; i < kOpsCount; ++i) {
+    bulk.InsertOne(bson::MakeDoc("_id", i == kDuplicateIndex ? 1 : i + 2));
+  }
+  bulk.UpdateOne(bson::MakeDoc("_id", -1),
+                 bson::MakeDoc("$set", bson::MakeDoc("x", 1)),
+                 mongo::options::Upsert{});
+  auto result = coll.Execute(std::move(bulk));
+
+  EXPECT_EQ(kOpsCount - 1, result.InsertedCount());
+  EXPECT_EQ(1, result.UpsertedCount());
+  EXPECT_EQ(kOpsCount + 1, coll.Count({}));
+
+  auto errors = result.ServerErrors();
+  ASSERT_EQ(1, errors.size());
+  EXPECT_EQ(1, errors.count(kDuplicateIndex));
+  EXPECT_EQ(11000, errors[kDuplicateIndex].Code());
+
+  auto upserted_ids = result.UpsertedIds();
+  ASSERT_EQ(1, upserted_ids.size());
+  EXPECT_EQ(-1, upserted_ids[kOpsCount].As<int>());
+}
+
 USERVER_NAMESPACE_END
@@ -6,6 +6,7 @@
 #include <poll.h>
 #include <sys/socket.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cerrno>
@@ -41,6 +42,9 @@ namespace {
 // chosen empirically as the best performance for size (16K-32K)
 constexpr size_t kBufferSize = 32 * 1024;
 
+// buffers are sent with a single syscall up to this count
+constexpr size_t kMaxSendIoDataCount = 64;
+
 constexpr int kCompatibleMajorVersion = 1;
 constexpr int kMaxCompatibleMinorVersion = 21;  // Tested on Fedora, works
 
@@ -75,10 +79,9 @@ class AsyncStream : public mongoc_stream_t {
  private:
   AsyncStream(engine::io::Socket) noexcept;
 
-  // mongoc_stream_buffered does not provide write buffering
-  // NOTE: returns number of bytes sent, not buffered!
-  size_t BufferedSend(const void* data, size_t size, engine::Deadline deadline);
-  size_t FlushSendBuffer(engine::Deadline);
+  // writes are not buffered, the buffers are sent with a vectored write
+  size_t SendVectored(const mongoc_iovec_t* iov, size_t iovcnt,
+                      engine::Deadline deadline);
 
   // mongoc_stream_buffered resizes itself indiscriminately
   // NOTE: returns number of bytes stored to data, not buffered!
@@ -107,18 +110,16 @@ class AsyncStream : public mongoc_stream_t {
   AsyncStreamPoller::WatcherPtr write_watcher_;
   bool is_timed_out_{false};
 
-  size_t send_buffer_bytes_used_{0};
   size_t recv_buffer_bytes_used_{0};
   size_t recv_buffer_pos_{0};
 
-  // buffer sizes are adjusted for better heap utilization and aligned for copy
+  // buffer size is adjusted for better heap utilization and aligned for copy
   static constexpr size_t kAlignment = 256;
   static_assert(kBufferSize % kAlignment == 0);
-  alignas(kAlignment) std::array<char, kBufferSize - kAlignment> send_buffer_;
   alignas(kAlignment) std::array<char, kBufferSize - kAlignment> recv_buffer_;
 };
-static_assert(sizeof(AsyncStream) <= 2 * kBufferSize &&
-                  sizeof(AsyncStream) >= (kBufferSize + 3 * kBufferSize / 4),
+static_assert(sizeof(AsyncStream) <= kBufferSize &&
+                  sizeof(AsyncStream) >= 3 * kBufferSize / 4,
               "AsyncStream has suboptimal size");
 
 engine::Deadline DeadlineFromTimeoutMs(int32_t timeout_ms) {
@@ -369,37 +370,19 @@ AsyncStream::AsyncStream(engine::io::Socket socket) noexcept
   should_retry = &ShouldRetry;
 }
 
-size_t AsyncStream::BufferedSend(const void* data, size_t size,
+size_t AsyncStream::SendVectored(const mongoc_iovec_t* iov, size_t iovcnt,
                                  engine::Deadline deadline) {
   size_t bytes_sent = 0;
-
-  size_t bytes_left = size;
-  const char* pos = static_cast<const char*>(data);
+  std::array<engine::io::IoData, kMaxSendIoDataCount> io_data{};
   try {
-    while (bytes_left) {
-      size_t batch_size = 0;
-      if (!send_buffer_bytes_used_ && bytes_left >= send_buffer_.size()) {
-        // no pending data and will overflow the buffer, stream directly
-        batch_size = bytes_left - bytes_left % send_buffer_.size();
-        bytes_sent += socket_.SendAll(pos, batch_size, deadline);
-      } else {
-        // data pending or can be buffered
-        UASSERT(send_buffer_bytes_used_ <= send_buffer_.size());
-        batch_size = std::min<size_t>(
-            bytes_left, send_buffer_.size() - send_buffer_bytes_used_);
-
-        std::memcpy(send_buffer_.data() + send_buffer_bytes_used_, pos,
-                    batch_size);
-        send_buffer_bytes_used_ += batch_size;
-      }
-      UASSERT(batch_size);
-      bytes_left -= batch_size;
-      pos += batch_size;
-
-      UASSERT(send_buffer_bytes_used_ <= send_buffer_.size());
-      if (send_buffer_bytes_used_ == send_buffer_.size()) {
-        bytes_sent += FlushSendBuffer(deadline);
+    while (iovcnt) {
+      const auto batch_size = std::min(iovcnt, io_data.size());
+      for (size_t i = 0; i < batch_size; ++i) {
+        io_data[i] = {iov[i].iov_base, iov[i].iov_len};
       }
+      bytes_sent += socket_.SendAll(io_data.data(), batch_size, deadline);
+      iov += batch_size;
+      iovcnt -= batch_size;
     }
   } catch (const engine::io::IoTimeout& timeout_ex) {
     // adjust the counter
@@ -408,12 +391,6 @@ size_t AsyncStream::BufferedSend(const void* data, size_t size,
   return bytes_sent;
 }
 
-size_t AsyncStream::FlushSendBuffer(engine::Deadline deadline) {
-  const size_t bytes_to_send = std::exchange(send_buffer_bytes_used_, 0);
-  if (!bytes_to_send) return 0;
-  return socket_.SendAll(send_buffer_.data(), bytes_to_send, deadline);
-}
-
 size_t AsyncStream::BufferedRecv(void* data, size_t size, size_t min_bytes,
                                  engine::Deadline deadline) {
   size_t bytes_stored = 0;
@@ -517,11 +494,7 @@ ssize_t AsyncStream::Writev(mongoc_stream_t* stream, mongoc_iovec_t* iov,
   ssize_t bytes_sent = 0;
   try {
     engine::TaskCancellationBlocker block_cancel;
-    for (size_t i = 0; i < iovcnt; ++i) {
-      bytes_sent +=
-          self->BufferedSend(iov[i].iov_base, iov[i].iov_len, deadline);
-    }
-    bytes_sent += self->FlushSendBuffer(deadline);
+    bytes_sent = self->SendVectored(iov, iovcnt, deadline);
   } catch (const engine::io::IoCancelled&) {
     UASSERT_MSG(false,
                 "Cancellation is not supported in cdriver implementation");
@@ -1,14 +1,21 @@
 #include <storages/mongo/cdriver/collection_impl.hpp>
 
+#include <exception>
+#include <vector>
+
 #include <bson/bson.h>
 #include <mongoc/mongoc.h>
 
 #include <userver/formats/bson/document.hpp>
 #include <userver/formats/bson/inline.hpp>
+#include <userver/formats/bson/value_builder.hpp>
+#include <userver/engine/semaphore.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/storages/mongo/exception.hpp>
 #include <userver/storages/mongo/mongo_error.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/text.hpp>
 
 #include <formats/bson/wrappers.hpp>
@@ -35,6 +42,52 @@ class WriteResultHelper {
   formats::bson::impl::UninitializedBson bson_;
 };
 
+// Merges the replies of the bulk chunks, each starting at the corresponding
+// operation offset in the whole bulk
+formats::bson::Document MergeBulkReplies(
+    const std::vector<formats::bson::Document>& replies,
+    const std::vector<size_t>& ops_offsets) {
+  static const std::string kCounters[] = {
+      "nInserted", "nMatched", "nModified", "nRemoved", "nUpserted"};
+  static const std::string kIndexedArrays[] = {"writeErrors", "upserted"};
+  static const std::string kWriteConcernErrors = "writeConcernErrors";
+  static const std::string kIndex = "index";
+  using Type = formats::bson::ValueBuilder::Type;
+  UASSERT(replies.size() == ops_offsets.size());
+
+  formats::bson::ValueBuilder builder(Type::kObject);
+  for (const auto& counter : kCounters) {
+    int64_t total = 0;
+    for (const auto& reply : replies) total += reply[counter].As<int64_t>(0);
+    builder[counter] = total;
+  }
+
+  for (const auto& array_name : kIndexedArrays) {
+    formats::bson::ValueBuilder merged(Type::kArray);
+    for (size_t i = 0; i < replies.size(); ++i) {
+      const auto array = replies[i][array_name];
+      if (array.IsMissing()) continue;
+      for (const auto& item : array) {
+        formats::bson::ValueBuilder item_builder(item);
+        item_builder[kIndex] =
+            item[kIndex].As<int64_t>() + static_cast<int64_t>(ops_offsets[i]);
+        merged.PushBack(std::move(item_builder));
+      }
+    }
+    builder[array_name] = std::move(merged);
+  }
+
+  formats::bson::ValueBuilder write_concern_errors(Type::kArray);
+  for (const auto& reply : replies) {
+    const auto errors = reply[kWriteConcernErrors];
+    if (errors.IsMissing()) continue;
+    for (const auto& error : errors) write_concern_errors.PushBack(error);
+  }
+  builder[kWriteConcernErrors] = std::move(write_concern_errors);
+
+  return builder.ExtractValue();
+}
+
 std::optional<std::string> GetCurrentSpanLink() {
   auto* span = tracing::Span::CurrentSpanUnchecked();
   if (span) return span->GetLink();
@@ -189,7 +242,8 @@ Cursor CDriverCollectionImpl::Execute(const operations::Find& find_op) const {
       collection.get(), native_filter_bson_ptr, impl::GetNative(options),
       find_op.impl_->read_prefs.Get()));
   return Cursor(std::make_unique<impl::cdriver::CDriverCursorImpl>(
-      std::move(client), std::move(cdriver_cursor), std::move(stats_ptr)));
+      std::move(client), std::move(cdriver_cursor), std::move(stats_ptr),
+      find_op.impl_->is_prefetched));
 }
 
 WriteResult CDriverCollectionImpl::Execute(
@@ -440,32 +494,74 @@ WriteResult CDriverCollectionImpl::Execute(operations::Bulk&& bulk_op) {
   auto span = MakeSpan("mongo_bulk");
   if (bulk_op.IsEmpty()) return {};
 
-  UASSERT(bulk_op.impl_->bulk);
-  mongoc_bulk_operation_set_database(bulk_op.impl_->bulk.get(),
-                                     GetDatabaseName().c_str());
-  mongoc_bulk_operation_set_collection(bulk_op.impl_->bulk.get(),
-                                       GetCollectionName().c_str());
+  auto& chunks = bulk_op.impl_->chunks;
+  // the last chunk may be left empty by a failed append
+  if (!chunks.back().ops_count) chunks.pop_back();
+  const bool should_throw = bulk_op.impl_->should_throw;
+  auto stats_ptr = statistics_->write[bulk_op.impl_->write_concern_desc];
 
-  auto client = GetCDriverClient();
-  mongoc_bulk_operation_set_client(bulk_op.impl_->bulk.get(), client.get());
+  if (chunks.size() == 1) {
+    return WriteResult(ExecuteBulkChunk(chunks.front().bulk.get(),
+                                        should_throw, stats_ptr));
+  }
 
-  auto stats_ptr = statistics_->write[bulk_op.impl_->write_concern_desc];
+  engine::Semaphore parallel_chunks(operations::Bulk::kMaxParallelChunks);
+  std::vector<engine::TaskWithResult<formats::bson::Document>> tasks;
+  tasks.reserve(chunks.size());
+  for (auto& chunk : chunks) {
+    tasks.push_back(utils::Async(
+        "mongo_bulk_chunk",
+        [this, &parallel_chunks, &stats_ptr, should_throw,
+         bulk = chunk.bulk.get()] {
+          engine::SemaphoreLock lock(parallel_chunks);
+          return ExecuteBulkChunk(bulk, should_throw, stats_ptr);
+        }));
+  }
+
+  std::vector<formats::bson::Document> replies;
+  replies.reserve(tasks.size());
+  std::exception_ptr first_error;
+  for (auto& task : tasks) {
+    try {
+      replies.push_back(task.Get());
+    } catch (const std::exception&) {
+      if (!first_error) first_error = std::current_exception();
+    }
+  }
+  if (first_error) std::rethrow_exception(first_error);
+
+  std::vector<size_t> ops_offsets;
+  ops_offsets.reserve(chunks.size());
+  size_t ops_count = 0;
+  for (const auto& chunk : chunks) {
+    ops_offsets.push_back(ops_count);
+    ops_count += chunk.ops_count;
+  }
+  return WriteResult(MergeBulkReplies(replies, ops_offsets));
+}
+
+formats::bson::Document CDriverCollectionImpl::ExecuteBulkChunk(
+    mongoc_bulk_operation_t* bulk, bool should_throw,
+    const std::shared_ptr<stats::WriteOperationStatistics>& stats_ptr) {
+  mongoc_bulk_operation_set_database(bulk, GetDatabaseName().c_str());
+  mongoc_bulk_operation_set_collection(bulk, GetCollectionName().c_str());
+
+  auto client = GetCDriverClient();
+  mongoc_bulk_operation_set_client(bulk, client.get());
 
   MongoError error;
-  WriteResultHelper write_result;
+  formats::bson::impl::UninitializedBson reply;
   stats::OperationStopwatch bulk_sw(stats_ptr,
                                     stats::WriteOperationStatistics::kBulk);
-  if (mongoc_bulk_operation_execute(bulk_op.impl_->bulk.get(),
-                                    write_result.GetNative(),
-                                    error.GetNative())) {
+  if (mongoc_bulk_operation_execute(bulk, reply.Get(), error.GetNative())) {
     bulk_sw.AccountSuccess();
   } else {
     bulk_sw.AccountError(error.GetKind());
-    if (bulk_op.impl_->should_throw || !error.IsServerError()) {
+    if (should_throw || !error.IsServerError()) {
       error.Throw("Error running bulk operation");
     }
   }
-  return write_result.Extract();
+  return formats::bson::Document(reply.Extract());
 }
 
 Cursor CDriverCollectionImpl::Execute(
@@ -492,7 +588,8 @@ Cursor CDriverCollectionImpl::Execute(
       collection.get(), MONGOC_QUERY_NONE, native_pipeline_bson_ptr,
       impl::GetNative(options), aggregate_op.impl_->read_prefs.Get()));
   return Cursor(std::make_unique<impl::cdriver::CDriverCursorImpl>(
-      std::move(client), std::move(cdriver_cursor), std::move(stats_ptr)));
+      std::move(client), std::move(cdriver_cursor), std::move(stats_ptr),
+      /*is_prefetched=*/false));
 }
 
 void CDriverCollectionImpl::Execute(const operations::Drop& drop_op) {
@@ -6,6 +6,7 @@
 #include <storages/mongo/cdriver/pool_impl.hpp>
 #include <storages/mongo/collection_impl.hpp>
 #include <storages/mongo/stats.hpp>
+#include <userver/formats/bson/document.hpp>
 #include <userver/tracing/span.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -40,6 +41,9 @@ class CDriverCollectionImpl : public CollectionImpl {
                                bool& has_max_server_time_option) const;
   void SetDefaultMaxServerTime(mongoc_find_and_modify_opts_t* options,
                                bool& has_max_server_time_option) const;
+  formats::bson::Document ExecuteBulkChunk(
+      mongoc_bulk_operation_t*, bool should_throw,
+      const std::shared_ptr<stats::WriteOperationStatistics>&);
 
   PoolImplPtr pool_impl_;
   std::shared_ptr<stats::CollectionStatistics> statistics_;
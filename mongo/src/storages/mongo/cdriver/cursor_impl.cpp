@@ -7,6 +7,7 @@
 
 #include <userver/storages/mongo/mongo_error.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
 
 #include <formats/bson/wrappers.hpp>
 
@@ -21,40 +22,90 @@ int mongoc_cursor_get_batch_num(const T*...) noexcept {
   return -1;
 }
 
+// Limits the prefetched documents count when the batch boundaries are unknown
+constexpr size_t kMaxPrefetchedDocuments = 1000;
+
 }  // namespace
 
 namespace storages::mongo::impl::cdriver {
 
 CDriverCursorImpl::CDriverCursorImpl(
     cdriver::CDriverPoolImpl::BoundClientPtr client, cdriver::CursorPtr cursor,
-    std::shared_ptr<stats::ReadOperationStatistics> stats_ptr)
-    : client_(std::move(client)),
+    std::shared_ptr<stats::ReadOperationStatistics> stats_ptr,
+    bool is_prefetched)
+    : is_prefetched_(is_prefetched),
+      client_(std::move(client)),
       cursor_(std::move(cursor)),
       stats_ptr_(std::move(stats_ptr)) {
-  Next();  // prime the cursor
+  // prime the cursor
+  if (is_prefetched_) {
+    batch_ = FetchBatch();
+    StartPrefetch();
+  } else {
+    current_bson_ = FetchNext();
+  }
 }
 
-bool CDriverCursorImpl::IsValid() const { return cursor_ || current_; }
+bool CDriverCursorImpl::IsValid() const {
+  if (is_prefetched_) return batch_pos_ < batch_.size();
+  return current_bson_ != nullptr;
+}
 
 bool CDriverCursorImpl::HasMore() const {
+  if (is_prefetched_) return prefetch_task_.has_value();
   return cursor_ && mongoc_cursor_more(cursor_.get());
 }
 
 const formats::bson::Document& CDriverCursorImpl::Current() const {
   if (!IsValid()) throw std::logic_error("Reading from invalid cursor");
+  if (is_prefetched_) return batch_[batch_pos_];
+
+  if (!current_) {
+    current_ = formats::bson::Document(
+        formats::bson::impl::MutableBson::CopyNative(current_bson_).Extract());
+  }
   return *current_;
 }
 
+formats::bson::ValueView CDriverCursorImpl::CurrentView() const {
+  if (!IsValid()) throw std::logic_error("Reading from invalid cursor");
+  if (is_prefetched_) return formats::bson::ValueView(batch_[batch_pos_]);
+  if (current_) return formats::bson::ValueView(*current_);
+  return formats::bson::ValueView(current_bson_);
+}
+
 void CDriverCursorImpl::Next() {
   if (!IsValid()) throw std::logic_error("Advancing cursor past the end");
 
-  current_ = std::nullopt;
-  if (!HasMore()) {
-    UASSERT(!cursor_ && !client_);
+  if (!is_prefetched_) {
+    current_ = std::nullopt;
+    current_bson_ = nullptr;
+    current_bson_ = FetchNext();
     return;
   }
 
-  UASSERT(client_ && cursor_);
+  if (++batch_pos_ < batch_.size()) return;
+  batch_.clear();
+  batch_pos_ = 0;
+  if (!prefetch_task_) return;
+
+  auto task = std::move(*prefetch_task_);
+  prefetch_task_.reset();
+  batch_ = task.Get();
+  StartPrefetch();
+}
+
+const bson_t* CDriverCursorImpl::FetchNext() {
+  if (!cursor_) return nullptr;
+
+  // The previously returned document is not used anymore
+  if (!mongoc_cursor_more(cursor_.get())) {
+    cursor_.reset();
+    client_.reset();
+    return nullptr;
+  }
+
+  UASSERT(client_);
   const auto batch_num_before = mongoc_cursor_get_batch_num(cursor_.get());
   stats::OperationStopwatch<stats::ReadOperationStatistics> cursor_next_sw(
       stats_ptr_, batch_num_before == -1
@@ -63,12 +114,9 @@ void CDriverCursorImpl::Next() {
 
   const bson_t* current_bson = nullptr;
   MongoError error;
-  while (!mongoc_cursor_error(cursor_.get(), error.GetNative()) && HasMore()) {
-    if (mongoc_cursor_next(cursor_.get(), &current_bson)) {
-      current_ = formats::bson::Document(
-          formats::bson::impl::MutableBson::CopyNative(current_bson).Extract());
-      break;
-    }
+  while (!mongoc_cursor_error(cursor_.get(), error.GetNative()) &&
+         mongoc_cursor_more(cursor_.get())) {
+    if (mongoc_cursor_next(cursor_.get(), &current_bson)) break;
   }
   if (batch_num_before == mongoc_cursor_get_batch_num(cursor_.get())) {
     cursor_next_sw.Discard();
@@ -77,13 +125,41 @@ void CDriverCursorImpl::Next() {
   } else {
     cursor_next_sw.AccountError(error.GetKind());
   }
-  if (!HasMore()) {
+  if (!current_bson && !mongoc_cursor_more(cursor_.get())) {
     cursor_.reset();
     client_.reset();
   }
   if (error) {
     error.Throw("Error iterating over query results");
   }
+  return current_bson;
+}
+
+CDriverCursorImpl::Batch CDriverCursorImpl::FetchBatch() {
+  Batch batch;
+  int batch_num = -1;
+  while (batch.size() < kMaxPrefetchedDocuments) {
+    const auto* current_bson = FetchNext();
+    if (!current_bson) break;
+    batch.emplace_back(
+        formats::bson::impl::MutableBson::CopyNative(current_bson).Extract());
+
+    // The document that required a getMore ends the batch
+    const auto current_batch_num = mongoc_cursor_get_batch_num(cursor_.get());
+    if (batch.size() == 1) {
+      batch_num = current_batch_num;
+    } else if (current_batch_num != batch_num) {
+      break;
+    }
+  }
+  return batch;
+}
+
+void CDriverCursorImpl::StartPrefetch() {
+  UASSERT(!prefetch_task_);
+  if (!cursor_) return;
+  prefetch_task_.emplace(
+      utils::Async("mongo-cursor-prefetch", [this] { return FetchBatch(); }));
 }
 
 }  // namespace storages::mongo::impl::cdriver
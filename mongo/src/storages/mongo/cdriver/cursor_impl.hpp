@@ -2,8 +2,11 @@
 
 #include <memory>
 #include <optional>
+#include <vector>
 
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/formats/bson/document.hpp>
+#include <userver/formats/bson/value_view.hpp>
 
 #include <storages/mongo/cdriver/pool_impl.hpp>
 #include <storages/mongo/cdriver/wrappers.hpp>
@@ -19,19 +22,43 @@ class CDriverCursorImpl final : public CursorImpl {
  public:
   CDriverCursorImpl(cdriver::CDriverPoolImpl::BoundClientPtr,
                     cdriver::CursorPtr,
-                    std::shared_ptr<stats::ReadOperationStatistics>);
+                    std::shared_ptr<stats::ReadOperationStatistics>,
+                    bool is_prefetched);
 
   bool IsValid() const override;
   bool HasMore() const override;
 
   const formats::bson::Document& Current() const override;
+  formats::bson::ValueView CurrentView() const override;
   void Next() override;
 
  private:
-  std::optional<formats::bson::Document> current_;
+  using Batch = std::vector<formats::bson::Document>;
+
+  // Returns the document borrowed from the cdriver cursor buffer, which is
+  // valid until the next call, or nullptr if the cursor is exhausted
+  const bson_t* FetchNext();
+
+  // Reads documents until a batch boundary is crossed, so that the next
+  // getMore is issued by the prefetching task
+  Batch FetchBatch();
+  void StartPrefetch();
+
+  const bool is_prefetched_;
+
+  // Current document of the non-prefetched cursor, copied on demand
+  const bson_t* current_bson_{nullptr};
+  mutable std::optional<formats::bson::Document> current_;
+
+  Batch batch_;
+  size_t batch_pos_{0};
+
   cdriver::CDriverPoolImpl::BoundClientPtr client_;
   cdriver::CursorPtr cursor_;
   std::shared_ptr<stats::ReadOperationStatistics> stats_ptr_;
+
+  // Must be destroyed before the cursor it uses
+  std::optional<engine::TaskWithResult<Batch>> prefetch_task_;
 };
 
 }  // namespace storages::mongo::impl::cdriver
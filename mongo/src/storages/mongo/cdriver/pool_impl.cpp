@@ -1,13 +1,16 @@
 #include <storages/mongo/cdriver/pool_impl.hpp>
 
 #include <limits>
+#include <vector>
 
 #include <bson/bson.h>
 
 #include <userver/clients/dns/resolver.hpp>
 #include <userver/formats/bson.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/traceful_exception.hpp>
 
 #include <storages/mongo/cdriver/async_stream.hpp>
@@ -21,6 +24,7 @@ namespace storages::mongo::impl::cdriver {
 namespace {
 
 const std::string kMaintenanceTaskName = "mongo_maintenance";
+const std::string kWarmupTaskName = "mongo_warmup";
 constexpr size_t kIdleConnectionDropRate = 1;
 
 int32_t CheckedDurationMs(const std::chrono::milliseconds& timeout,
@@ -43,6 +47,37 @@ int32_t CheckedDurationSeconds(const std::chrono::seconds& timeout,
   return timeout_sec;
 }
 
+void OnCommandStarted(const mongoc_apm_command_started_t* event) {
+  auto* limiter = static_cast<stats::DetailedStatisticsLimiter*>(
+      mongoc_apm_command_started_get_context(event));
+  stats::AccountCommandStarted(
+      *limiter, mongoc_apm_command_started_get_command(event)->len);
+}
+
+void OnCommandSucceeded(const mongoc_apm_command_succeeded_t* event) {
+  stats::AccountCommandFinished(
+      mongoc_apm_command_succeeded_get_host(event)->host_and_port,
+      std::chrono::microseconds{
+          mongoc_apm_command_succeeded_get_duration(event)},
+      mongoc_apm_command_succeeded_get_reply(event)->len);
+}
+
+void OnCommandFailed(const mongoc_apm_command_failed_t* event) {
+  stats::AccountCommandFinished(
+      mongoc_apm_command_failed_get_host(event)->host_and_port,
+      std::chrono::microseconds{mongoc_apm_command_failed_get_duration(event)},
+      mongoc_apm_command_failed_get_reply(event)->len);
+}
+
+// Command events feed the per host statistics of the current operation
+ApmCallbacksPtr MakeDetailedStatsCallbacks() {
+  ApmCallbacksPtr callbacks(mongoc_apm_callbacks_new());
+  mongoc_apm_set_command_started_cb(callbacks.get(), &OnCommandStarted);
+  mongoc_apm_set_command_succeeded_cb(callbacks.get(), &OnCommandSucceeded);
+  mongoc_apm_set_command_failed_cb(callbacks.get(), &OnCommandFailed);
+  return callbacks;
+}
+
 bool HasOption(const UriPtr& uri, const char* opt) {
   const bson_t* options = mongoc_uri_get_options(uri.get());
   bson_iter_t it;
@@ -148,15 +183,17 @@ CDriverPoolImpl::CDriverPoolImpl(std::string id, const std::string& uri_string,
 
   init_data_.ssl_opt = MakeSslOpt(uri_.get());
 
-  try {
-    LOG_INFO() << "Creating " << config.initial_size << " mongo connections";
-    for (size_t i = 0; i < config.initial_size; ++i) {
-      engine::SemaphoreLock lock(in_use_semaphore_);
-      Push(Create());
-      lock.Release();
-    }
-  } catch (const std::exception& ex) {
-    LOG_ERROR() << "Mongo pool was not fully prepopulated: " << ex;
+  if (config.detailed_stats_limit) {
+    GetStatistics().pool->detailed_limiter =
+        std::make_shared<stats::DetailedStatisticsLimiter>(
+            config.detailed_stats_limit);
+  }
+
+  LOG_INFO() << "Creating " << config.initial_size << " mongo connections";
+  const auto failed_count = Warmup(config.initial_size);
+  if (failed_count) {
+    LOG_ERROR() << "Mongo pool was not fully prepopulated, failed to create "
+                << failed_count << " connections";
   }
 
   maintenance_task_.Start(kMaintenanceTaskName,
@@ -168,6 +205,7 @@ CDriverPoolImpl::CDriverPoolImpl(std::string id, const std::string& uri_string,
 
 CDriverPoolImpl::~CDriverPoolImpl() {
   maintenance_task_.Stop();
+  warmup_tasks_.CancelAndWait();
 
   const ClientDeleter deleter;
   mongoc_client_t* client = nullptr;
@@ -218,6 +256,8 @@ mongoc_client_t* CDriverPoolImpl::Pop() {
             << Id() << "' has too many establishing connections";
       }
       client = Create();
+      // the pool grows, get ready for more
+      StartWarmup();
     }
   }
 
@@ -263,6 +303,12 @@ mongoc_client_t* CDriverPoolImpl::Create() {
     mongoc_client_set_appname(client.get(), app_name_.c_str());
   }
 
+  if (const auto& limiter = GetStatistics().pool->detailed_limiter) {
+    static const auto kDetailedStatsCallbacks = MakeDetailedStatsCallbacks();
+    mongoc_client_set_apm_callbacks(client.get(), kDetailedStatsCallbacks.get(),
+                                    limiter.get());
+  }
+
   // force topology refresh
   // XXX: Periodic task forcing topology refresh?
   MongoError error;
@@ -282,6 +328,50 @@ mongoc_client_t* CDriverPoolImpl::Create() {
   return client.release();
 }
 
+size_t CDriverPoolImpl::Warmup(size_t target_size) {
+  const auto size = size_.load();
+  if (size >= target_size) return 0;
+
+  // connections are established concurrently up to connecting_limit
+  std::vector<engine::TaskWithResult<bool>> tasks;
+  tasks.reserve(target_size - size);
+  for (auto i = size; i < target_size; ++i) {
+    tasks.push_back(utils::Async("mongo_warmup_connect",
+                                 [this] { return TryCreateIdle(); }));
+  }
+
+  size_t failed_count = 0;
+  for (auto& task : tasks) {
+    if (!task.Get()) ++failed_count;
+  }
+  return failed_count;
+}
+
+bool CDriverPoolImpl::TryCreateIdle() {
+  try {
+    engine::SemaphoreLock in_use_lock(in_use_semaphore_, std::try_to_lock);
+    if (!in_use_lock) return false;
+    engine::SemaphoreLock connecting_lock(connecting_semaphore_);
+
+    Push(Create());
+    in_use_lock.Release();
+    return true;
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Failed to create a connection in mongo pool '" << Id()
+                  << "': " << ex;
+    return false;
+  }
+}
+
+void CDriverPoolImpl::StartWarmup() {
+  if (size_.load() >= idle_limit_ || is_warming_up_.exchange(true)) return;
+
+  warmup_tasks_.AsyncDetach(kWarmupTaskName, [this] {
+    Warmup(idle_limit_);
+    is_warming_up_ = false;
+  });
+}
+
 void CDriverPoolImpl::DoMaintenance() {
   LOG_DEBUG() << "Starting mongo pool '" << Id() << "' maintenance";
   for (auto idle_drop_left = kIdleConnectionDropRate;
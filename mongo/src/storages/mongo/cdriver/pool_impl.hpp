@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 
 #include <mongoc/mongoc.h>
@@ -10,6 +11,7 @@
 #include <storages/mongo/dynamic_config.hpp>
 #include <storages/mongo/pool_impl.hpp>
 #include <userver/clients/dns/resolver_fwd.hpp>
+#include <userver/concurrent/background_task_storage.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/semaphore.hpp>
 #include <userver/storages/mongo/pool_config.hpp>
@@ -58,6 +60,12 @@ class CDriverPoolImpl final : public PoolImpl {
   mongoc_client_t* TryGetIdle();
   mongoc_client_t* Create();
 
+  // Creates idle connections in parallel until the pool has target_size ones,
+  // returns the number of the failed attempts
+  size_t Warmup(size_t target_size);
+  bool TryCreateIdle();
+  void StartWarmup();
+
   void DoMaintenance();
 
   const std::string app_name_;
@@ -72,6 +80,8 @@ class CDriverPoolImpl final : public PoolImpl {
   engine::Semaphore in_use_semaphore_;
   engine::Semaphore connecting_semaphore_;
   boost::lockfree::queue<mongoc_client_t*> queue_;
+  std::atomic<bool> is_warming_up_{false};
+  concurrent::BackgroundTaskStorage warmup_tasks_;
   utils::PeriodicTask maintenance_task_;
 };
 
@@ -18,6 +18,14 @@ class GlobalInitializer {
   static void LogInitWarningsOnce();
 };
 
+struct ApmCallbacksDeleter {
+  void operator()(mongoc_apm_callbacks_t* callbacks) const noexcept {
+    mongoc_apm_callbacks_destroy(callbacks);
+  }
+};
+using ApmCallbacksPtr =
+    std::unique_ptr<mongoc_apm_callbacks_t, ApmCallbacksDeleter>;
+
 struct BulkOperationDeleter {
   void operator()(mongoc_bulk_operation_t* bulk) const noexcept {
     mongoc_bulk_operation_destroy(bulk);
@@ -101,6 +101,18 @@ UTEST_F(Collection, Read) {
     }
   }
 
+  {
+    std::vector<bson::Document> copies;
+    auto cursor = coll.Find(kFilter);
+    for (auto it = cursor.begin(); it != cursor.end(); ++it) {
+      const auto view = it.View();
+      EXPECT_EQ(1, (*view)["x"].As<int>());
+      copies.push_back(view.Copy());
+    }
+    ASSERT_EQ(2U, copies.size());
+    EXPECT_NE(copies[0]["_id"], copies[1]["_id"]);
+  }
+
   EXPECT_EQ(4, coll.CountApprox());
   EXPECT_EQ(0, other_coll.CountApprox());
 }
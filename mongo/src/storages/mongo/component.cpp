@@ -128,6 +128,10 @@ properties:
         type: string
         description: pool maintenance period (idle connections pruning etc.)
         defaultDescription: 15s
+    detailed_stats_limit:
+        type: integer
+        description: limit for per host metrics series number, 0 disables them
+        defaultDescription: 0
     stats_verbosity:
         type: string
         description: changes the granularity of reported metrics
@@ -223,6 +227,10 @@ properties:
     max_replication_lag:
         type: string
         description: replication lag limit for usable secondaries, min. 90s
+    detailed_stats_limit:
+        type: integer
+        description: limit for per host metrics series number (per database), 0 disables them
+        defaultDescription: 0
     stats_verbosity:
         type: string
         description: changes the granularity of reported metrics
@@ -45,6 +45,10 @@ const formats::bson::Document* Cursor::Iterator::operator->() const {
   return &cursor_->impl_->Current();
 }
 
+formats::bson::ValueView Cursor::Iterator::View() const {
+  return cursor_->impl_->CurrentView();
+}
+
 bool Cursor::Iterator::operator==(const Iterator& rhs) const {
   return cursor_ == rhs.cursor_;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <userver/formats/bson/document.hpp>
+#include <userver/formats/bson/value_view.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -14,6 +15,7 @@ class CursorImpl {
   virtual bool HasMore() const = 0;
 
   virtual const formats::bson::Document& Current() const = 0;
+  virtual formats::bson::ValueView CurrentView() const = 0;
   virtual void Next() = 0;
 };
 
@@ -362,6 +362,8 @@ void Find::SetOption(const options::MaxServerTime& max_server_time) {
                       impl_->has_max_server_time_option, max_server_time);
 }
 
+void Find::SetOption(options::Prefetch) { impl_->is_prefetched = true; }
+
 InsertOne::InsertOne(formats::bson::Document document)
     : impl_(std::move(document)) {}
 
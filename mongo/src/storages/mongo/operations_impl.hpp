@@ -48,6 +48,7 @@ class Find::Impl {
   std::optional<formats::bson::impl::BsonBuilder> options;
   bool has_comment_option{false};
   bool has_max_server_time_option{false};
+  bool is_prefetched{false};
 };
 
 class InsertOne::Impl {
@@ -139,9 +140,23 @@ class FindAndRemove::Impl {
 
 class Bulk::Impl {
  public:
+  struct Chunk {
+    impl::cdriver::BulkOperationPtr bulk;
+    size_t ops_count{0};
+    size_t size_bytes{0};
+  };
+
   explicit Impl(Mode mode_) : mode(mode_) {}
 
-  impl::cdriver::BulkOperationPtr bulk;
+  // Returns the chunk to append an operation of the specified size to
+  mongoc_bulk_operation_t* GetChunk(size_t op_size_bytes);
+  // Must be called after the operation is appended to the chunk
+  void AccountAppended(size_t op_size_bytes);
+
+  // Unordered bulks are split into chunks executed concurrently,
+  // ordered ones always consist of a single chunk
+  std::vector<Chunk> chunks;
+  impl::cdriver::WriteConcernPtr write_concern;
   std::string write_concern_desc{kDefaultWriteConcernDesc};
   Mode mode;
   bool should_throw{true};
@@ -578,6 +578,25 @@ UTEST_F(Options, Tailable) {
   UEXPECT_NO_THROW(coll.FindOne({}, mongo::options::Tailable{}));
 }
 
+UTEST_F(Options, Prefetch) {
+  auto coll = GetDefaultPool().GetCollection("prefetch");
+
+  constexpr int kDocumentsCount = 1000;
+  for (int i = 0; i < kDocumentsCount; ++i) {
+    coll.InsertOne(bson::MakeDoc("x", i));
+  }
+
+  const mongo::options::Sort sort{{"x", mongo::options::Sort::kAscending}};
+  int count = 0;
+  for (const auto& doc : coll.Find({}, sort, mongo::options::Prefetch{})) {
+    EXPECT_EQ(count++, doc["x"].As<int>());
+  }
+  EXPECT_EQ(kDocumentsCount, count);
+
+  auto cursor = coll.Find(bson::MakeDoc("x", -1), mongo::options::Prefetch{});
+  EXPECT_FALSE(cursor);
+}
+
 UTEST_F(Options, Comment) {
   auto coll = GetDefaultPool().GetCollection("comment");
 
@@ -71,6 +71,8 @@ PoolConfig::PoolConfig(const components::ComponentConfig& component_config)
       maintenance_period(
           component_config["maintenance_period"].As<std::chrono::milliseconds>(
               kDefaultMaintenancePeriod)),
+      detailed_stats_limit(
+          component_config["detailed_stats_limit"].As<size_t>(0)),
       app_name(component_config["appname"].As<std::string>(kDefaultAppName)),
       max_replication_lag(component_config["max_replication_lag"]
                               .As<std::optional<std::chrono::seconds>>()),
@@ -98,6 +100,7 @@ PoolConfig::PoolConfig()
       idle_limit(kTestIdleLimit),
       connecting_limit(kTestConnectingLimit),
       maintenance_period(kTestMaintenancePeriod),
+      detailed_stats_limit(0),
       app_name(kDefaultAppName),
       driver_impl(DriverImpl::kMongoCDriver) {
   if (!IsValidAppName(app_name)) {
@@ -96,4 +96,30 @@ UTEST_F(Pool, Limits) {
   UEXPECT_THROW(second_find.Get(), mongo::MongoException);
 }
 
+UTEST_F(Pool, DetailedStatistics) {
+  mongo::PoolConfig detailed_config{};
+  detailed_config.detailed_stats_limit = 1;
+  auto detailed_pool = MakePool({}, detailed_config);
+
+  auto collection = detailed_pool.GetCollection("detailed");
+  collection.InsertOne(formats::bson::MakeDoc("_id", 1));
+  // limit is reached by the insert
+  EXPECT_EQ(collection.Count({}), 1U);
+
+  const auto stats = detailed_pool.GetVerboseStatistics();
+  size_t hosts_count = 0;
+  for (const auto& wc_stats :
+       stats["by-collection"]["detailed"]["by-write-concern"]) {
+    for (const auto& host_stats :
+         wc_stats["by-operation"]["insert-one"]["by-host"]) {
+      EXPECT_TRUE(host_stats.HasMember("server-timings"));
+      EXPECT_TRUE(host_stats.HasMember("conn-wait-timings"));
+      EXPECT_TRUE(host_stats.HasMember("written-sizes"));
+      ++hosts_count;
+    }
+  }
+  EXPECT_EQ(hosts_count, 1);
+  EXPECT_EQ(stats["pool"]["detailed-stats-overflows"].As<int>(), 1);
+}
+
 USERVER_NAMESPACE_END
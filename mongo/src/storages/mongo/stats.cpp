@@ -1,7 +1,10 @@
 #include <storages/mongo/stats.hpp>
 
 #include <exception>
+#include <optional>
+#include <type_traits>
 
+#include <userver/engine/task/local_variable.hpp>
 #include <userver/tracing/span.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -42,6 +45,31 @@ auto GetMilliseconds(const std::chrono::duration<Rep, Period>& duration) {
       .count();
 }
 
+struct OperationDetails {
+  // set by the first command of the operation
+  DetailedStatisticsLimiter* limiter{nullptr};
+  std::optional<std::chrono::milliseconds> conn_wait;
+  std::string host;
+  std::chrono::microseconds server_time{0};
+  size_t read_size{0};
+  size_t written_size{0};
+
+  void ResetCommands() {
+    limiter = nullptr;
+    host.clear();
+    server_time = {};
+    read_size = 0;
+    written_size = 0;
+  }
+};
+
+// Only initialized in the tasks working with the detailed statistics pools
+engine::TaskLocalVariable<OperationDetails> current_operation_details;
+
+bool HasOperationDetails() {
+  return current_operation_details.GetOptional() != nullptr;
+}
+
 }  // namespace
 
 OperationStatisticsItem::OperationStatisticsItem(
@@ -136,6 +164,19 @@ std::string ToString(WriteOperationStatistics::OpType type) {
   UINVARIANT(false, "Unexpected type");
 }
 
+bool DetailedStatisticsLimiter::TryAcquire() {
+  auto used = used_.load(std::memory_order_relaxed);
+  do {
+    if (used >= limit_) return false;
+  } while (!used_.compare_exchange_weak(used, used + 1,
+                                        std::memory_order_relaxed));
+  return true;
+}
+
+void DetailedStatisticsLimiter::Release() {
+  used_.fetch_sub(1, std::memory_order_relaxed);
+}
+
 PoolConnectStatistics::PoolConnectStatistics() {
   for (auto& item : items) {
     item = std::make_shared<Aggregator<OperationStatisticsItem>>();
@@ -175,8 +216,11 @@ template <typename OpStats>
 void OperationStopwatch<OpStats>::Reset(
     const std::shared_ptr<OpStats>& stats_ptr,
     typename OpStats::OpType op_type) {
+  stats_ptr_ = stats_ptr;
+  op_type_ = op_type;
   stats_item_agg_ = stats_ptr ? stats_ptr->items[op_type] : nullptr;
   scope_time_.Reset(ToString(op_type));
+  if (HasOperationDetails()) current_operation_details->ResetCommands();
 }
 
 template <typename OpStats>
@@ -191,6 +235,7 @@ void OperationStopwatch<OpStats>::AccountError(MongoError::Kind kind) {
 
 template <typename OpStats>
 void OperationStopwatch<OpStats>::Discard() {
+  stats_ptr_.reset();
   stats_item_agg_.reset();
   scope_time_.Discard();
 }
@@ -205,11 +250,53 @@ void OperationStopwatch<OpStats>::Account(
     auto& stats_item = stats_item_agg->GetCurrentCounter();
     ++stats_item.counters[error_type];
     stats_item.timings.Account(GetMilliseconds(scope_time_.Reset()));
+    AccountHost();
   } catch (const std::exception&) {
     // ignore
   }
 }
 
+template <typename OpStats>
+void OperationStopwatch<OpStats>::AccountHost() noexcept {
+  if constexpr (!std::is_same_v<OpStats, PoolConnectStatistics>) {
+    const auto stats_ptr = std::exchange(stats_ptr_, nullptr);
+    if (!stats_ptr || !HasOperationDetails()) return;
+
+    try {
+      auto& details = *current_operation_details;
+      if (!details.limiter || details.host.empty()) return;
+
+      auto hosts_stats = stats_ptr->by_host[op_type_];
+      auto host_stats = hosts_stats->Get(details.host);
+      if (!host_stats) {
+        if (!details.limiter->TryAcquire()) {
+          ++details.limiter->overflows;
+          return;
+        }
+        auto [value, inserted] = hosts_stats->TryEmplace(details.host);
+        if (!inserted) details.limiter->Release();
+        host_stats = std::move(value);
+      }
+
+      host_stats->server_timings.GetCurrentCounter().Account(
+          GetMilliseconds(details.server_time));
+      if (details.conn_wait) {
+        host_stats->conn_wait_timings.GetCurrentCounter().Account(
+            details.conn_wait->count());
+      }
+      host_stats->read_sizes.GetCurrentCounter().Account(details.read_size);
+      host_stats->written_sizes.GetCurrentCounter().Account(
+          details.written_size);
+
+      // connection wait is accounted once per connection acquisition
+      details.conn_wait.reset();
+      details.ResetCommands();
+    } catch (const std::exception&) {
+      // ignore
+    }
+  }
+}
+
 // explicit instantiations
 template class OperationStopwatch<ReadOperationStatistics>;
 template class OperationStopwatch<WriteOperationStatistics>;
@@ -223,8 +310,42 @@ ConnectionWaitStopwatch::ConnectionWaitStopwatch(
 ConnectionWaitStopwatch::~ConnectionWaitStopwatch() {
   try {
     ++stats_ptr_->requested;
+    const auto wait_time =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            scope_time_.Reset());
     stats_ptr_->request_timings_agg.GetCurrentCounter().Account(
-        GetMilliseconds(scope_time_.Reset()));
+        wait_time.count());
+    if (stats_ptr_->detailed_limiter) {
+      current_operation_details->conn_wait = wait_time;
+    }
+  } catch (const std::exception&) {
+    // ignore
+  }
+}
+
+void AccountCommandStarted(DetailedStatisticsLimiter& limiter,
+                           size_t command_size) noexcept {
+  try {
+    auto& details = *current_operation_details;
+    details.limiter = &limiter;
+    details.written_size += command_size;
+  } catch (const std::exception&) {
+    // ignore
+  }
+}
+
+void AccountCommandFinished(std::string_view host,
+                            std::chrono::microseconds duration,
+                            size_t reply_size) noexcept {
+  if (!HasOperationDetails()) return;
+
+  try {
+    auto& details = *current_operation_details;
+    if (!details.limiter) return;
+    // operations are not split between the hosts, the last one is reported
+    details.host = host;
+    details.server_time += duration;
+    details.read_size += reply_size;
   } catch (const std::exception&) {
     // ignore
   }
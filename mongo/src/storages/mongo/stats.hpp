@@ -1,11 +1,14 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <ratio>
 #include <string>
+#include <string_view>
 
 #include <userver/rcu/rcu_map.hpp>
 #include <userver/storages/mongo/mongo_error.hpp>
@@ -24,6 +27,12 @@ using TimingsPercentile =
                                   /*extra_buckets=*/780,
                                   /*extra_bucket_size=*/50>;
 
+// in bytes, exact up to 1KiB, then up to 16MiB with 16KiB precision
+using SizesPercentile =
+    utils::statistics::Percentile</*buckets =*/1024, uint32_t,
+                                  /*extra_buckets=*/1023,
+                                  /*extra_bucket_size=*/16 * 1024>;
+
 template <typename T>
 using Aggregator = utils::statistics::RecentPeriod<T, T>;
 
@@ -60,6 +69,35 @@ struct OperationStatisticsItem {
 
 std::string ToString(OperationStatisticsItem::ErrorType type);
 
+/// Operation statistics for a single server, collected only when
+/// the detailed statistics are enabled for the pool
+struct HostOperationStatistics {
+  // server commands time, including the network
+  Aggregator<TimingsPercentile> server_timings;
+  Aggregator<TimingsPercentile> conn_wait_timings;
+  Aggregator<SizesPercentile> read_sizes;
+  Aggregator<SizesPercentile> written_sizes;
+};
+
+// host -> stats
+using HostsStatistics = rcu::RcuMap<std::string, HostOperationStatistics>;
+
+/// Limits the total number of the per host statistics series of a pool
+class DetailedStatisticsLimiter {
+ public:
+  explicit DetailedStatisticsLimiter(size_t limit) : limit_(limit) {}
+
+  bool TryAcquire();
+  void Release();
+
+  // series not created because of the limit
+  Counter overflows;
+
+ private:
+  const size_t limit_;
+  std::atomic<size_t> used_{0};
+};
+
 struct ReadOperationStatistics {
   enum OpType {
     kCount,
@@ -69,6 +107,7 @@ struct ReadOperationStatistics {
   };
 
   rcu::RcuMap<OpType, Aggregator<OperationStatisticsItem>> items;
+  rcu::RcuMap<OpType, HostsStatistics> by_host;
 };
 
 std::string ToString(ReadOperationStatistics::OpType type);
@@ -89,6 +128,7 @@ struct WriteOperationStatistics {
   };
 
   rcu::RcuMap<OpType, Aggregator<OperationStatisticsItem>> items;
+  rcu::RcuMap<OpType, HostsStatistics> by_host;
 };
 
 std::string ToString(WriteOperationStatistics::OpType type);
@@ -122,6 +162,9 @@ struct PoolConnectStatistics {
 
   Aggregator<TimingsPercentile> request_timings_agg;
   Aggregator<TimingsPercentile> queue_wait_timings_agg;
+
+  // set when the detailed statistics are enabled
+  std::shared_ptr<DetailedStatisticsLimiter> detailed_limiter;
 };
 
 std::string ToString(PoolConnectStatistics::OpType type);
@@ -153,11 +196,22 @@ class OperationStopwatch {
 
  private:
   void Account(OperationStatisticsItem::ErrorType) noexcept;
+  void AccountHost() noexcept;
 
+  std::shared_ptr<OperationStatistics> stats_ptr_;
+  typename OperationStatistics::OpType op_type_{};
   std::shared_ptr<Aggregator<OperationStatisticsItem>> stats_item_agg_;
   tracing::ScopeTime scope_time_;
 };
 
+// Details of the current task operation for the detailed statistics,
+// accounted by the OperationStopwatch. Called from the driver command events.
+void AccountCommandStarted(DetailedStatisticsLimiter&,
+                           size_t command_size) noexcept;
+void AccountCommandFinished(std::string_view host,
+                            std::chrono::microseconds duration,
+                            size_t reply_size) noexcept;
+
 class ConnectionWaitStopwatch {
  public:
   explicit ConnectionWaitStopwatch(std::shared_ptr<PoolConnectStatistics>);
@@ -17,6 +17,9 @@ namespace {
 constexpr std::initializer_list<double> kOperationsStatisticsPercentiles = {
     95, 98, 99, 100};
 
+constexpr std::initializer_list<double> kHostStatisticsPercentiles = {
+    50, 90, 95, 98, 99, 99.9, 100};
+
 void Dump(const OperationStatisticsItem& item,
           formats::json::ValueBuilder& builder) {
   Counter::ValueType total_errors = 0;
@@ -42,6 +45,26 @@ void Dump(const OperationStatisticsItem& item,
   Dump(item, builder);
 }
 
+void Dump(const HostsStatistics& hosts_stats,
+          formats::json::ValueBuilder&& builder) {
+  for (const auto& [host, host_stats] : hosts_stats) {
+    auto host_builder = builder[host];
+    host_builder["server-timings"] = utils::statistics::PercentileToJson(
+        host_stats->server_timings.GetStatsForPeriod(),
+        kHostStatisticsPercentiles);
+    host_builder["conn-wait-timings"] = utils::statistics::PercentileToJson(
+        host_stats->conn_wait_timings.GetStatsForPeriod(),
+        kHostStatisticsPercentiles);
+    host_builder["read-sizes"] = utils::statistics::PercentileToJson(
+        host_stats->read_sizes.GetStatsForPeriod(),
+        kHostStatisticsPercentiles);
+    host_builder["written-sizes"] = utils::statistics::PercentileToJson(
+        host_stats->written_sizes.GetStatsForPeriod(),
+        kHostStatisticsPercentiles);
+  }
+  utils::statistics::SolomonChildrenAreLabelValues(builder, "mongo_host");
+}
+
 template <typename OperationStatistics>
 OperationStatisticsItem DumpAndCombineOperation(
     const OperationStatistics& op_stats,
@@ -53,6 +76,9 @@ OperationStatisticsItem DumpAndCombineOperation(
     Dump(item, op_builder[ToString(type)]);
     overall.Add(item);
   }
+  for (const auto& [type, hosts_stats] : op_stats.by_host) {
+    Dump(*hosts_stats, op_builder[ToString(type)]["by-host"]);
+  }
   utils::statistics::SolomonChildrenAreLabelValues(op_builder,
                                                    "mongo_operation");
   utils::statistics::SolomonSkip(op_builder);
@@ -141,6 +167,11 @@ void Dump(const PoolConnectStatistics& conn_stats,
       conn_stats.request_timings_agg.GetStatsForPeriod());
   builder["queue-wait-timings"] = utils::statistics::PercentileToJson(
       conn_stats.queue_wait_timings_agg.GetStatsForPeriod());
+
+  if (conn_stats.detailed_limiter) {
+    builder["detailed-stats-overflows"] =
+        conn_stats.detailed_limiter->overflows.Load();
+  }
 }
 
 }  // namespace
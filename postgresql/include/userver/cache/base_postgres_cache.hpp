@@ -9,6 +9,7 @@
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -19,13 +20,19 @@
 
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
 #include <userver/storages/postgres/io/chrono.hpp>
 
 #include <userver/compiler/demangle.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/cpu_relax.hpp>
+#include <userver/utils/flat_hash_map.hpp>
 #include <userver/utils/meta.hpp>
 #include <userver/utils/void_t.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
@@ -62,6 +69,8 @@ namespace components {
 /// incremental-update-op-timeout | timeout for an incremental update | 1s
 /// update-correction | incremental update window adjustment | - (0 for caches with defined GetLastKnownUpdated)
 /// chunk-size | number of rows to request from PostgreSQL, 0 to fetch all rows in one request | 1000
+/// full-update-partitions | number of parallel queries of a full update, requires kFullUpdatePartitionKey in the policy | 1
+/// notify-debounce | delay of an update after a notification of kListenChannel, the notifications of the delay are coalesced | 100ms
 ///
 /// @section pg_cc_cache_policy Cache policy
 ///
@@ -93,6 +102,24 @@ namespace components {
 ///
 /// @snippet cache/postgres_cache_test.cpp Pg Cache Policy Custom Container With Write Notification Example
 ///
+/// Incremental updates copy the cache data before applying the changes. For
+/// the large caches use cache::ChunkedCowMap as the CacheContainer: its copies
+/// share the unchanged data, so an update copies only the chunks of the
+/// changed rows. For the large caches with full updates utils::FlatHashMap
+/// is a faster and more compact replacement of std::unordered_map.
+///
+/// @section pg_cc_notifications Updates on notifications
+///
+/// If the policy defines `kListenChannel`, the cache subscribes to the
+/// notifications of that channel on the master host of each shard (see
+/// storages::postgres::Cluster::Listen) and runs an incremental update when
+/// a notification arrives, e.g. from a trigger
+/// `PERFORM pg_notify('my_structures_changed', '')`. The notifications that
+/// arrive within `notify-debounce` of the first one are coalesced into a
+/// single update. The periodic updates are a safety net for the notifications
+/// lost while a subscription is reestablished, so their interval may be
+/// much longer.
+///
 /// @section pg_cc_forward_declaration Forward Declaration
 ///
 /// To forward declare a cache you can forward declare a trait and
@@ -157,6 +184,19 @@ using HasWhere = decltype(T::kWhere);
 template <typename T>
 inline constexpr bool kHasWhere = meta::kIsDetected<HasWhere, T>;
 
+// Component kFullUpdatePartitionKey in policy
+template <typename T>
+using HasFullUpdatePartitionKey = decltype(T::kFullUpdatePartitionKey);
+template <typename T>
+inline constexpr bool kHasFullUpdatePartitionKey =
+    meta::kIsDetected<HasFullUpdatePartitionKey, T>;
+
+// Component kListenChannel in policy
+template <typename T>
+using HasListenChannel = decltype(T::kListenChannel);
+template <typename T>
+inline constexpr bool kHasListenChannel = meta::kIsDetected<HasListenChannel, T>;
+
 // Update field
 template <typename T>
 using HasUpdatedField = decltype(T::kUpdatedField);
@@ -202,7 +242,8 @@ using DataCacheContainerType = typename DataCacheContainer<T>::type;
 template <typename T>
 inline constexpr bool kIsContainerCopiedByElement =
     meta::kIsInstantiationOf<std::unordered_map, T> ||
-    meta::kIsInstantiationOf<std::map, T>;
+    meta::kIsInstantiationOf<std::map, T> ||
+    meta::kIsInstantiationOf<USERVER_NAMESPACE::utils::FlatHashMap, T>;
 
 template <typename T>
 std::unique_ptr<T> CopyContainer(
@@ -358,12 +399,23 @@ inline constexpr std::chrono::seconds kDefaultIncrementalUpdateTimeout{1};
 inline constexpr std::chrono::milliseconds kStatementTimeoutOff{0};
 inline constexpr std::chrono::milliseconds kCpuRelaxThreshold{10};
 inline constexpr std::chrono::milliseconds kCpuRelaxInterval{2};
+inline constexpr std::chrono::milliseconds kDefaultNotifyDebounce{100};
+inline constexpr std::chrono::seconds kListenWaitTimeout{10};
+inline constexpr std::chrono::seconds kListenRetryInterval{1};
 
 inline constexpr std::string_view kCopyStage = "copy_data";
 inline constexpr std::string_view kFetchStage = "fetch";
 inline constexpr std::string_view kParseStage = "parse";
 
 inline constexpr std::size_t kDefaultChunkSize = 1000;
+
+// Rows of a full update partition, parsed in a separate task
+template <typename ValueType>
+struct PartitionData {
+  std::vector<ValueType> values;
+  std::size_t read_count{0};
+  std::size_t parse_failures{0};
+};
 }  // namespace pg_cache::detail
 
 /// @ingroup userver_components
@@ -416,8 +468,21 @@ class PostgreCache final
                     cache::UpdateStatisticsScope& stats_scope,
                     tracing::ScopeTime& scope);
 
+  std::size_t UpdateByPartitions(UpdatedFieldType last_updated,
+                                 CachedData& data_cache,
+                                 cache::UpdateStatisticsScope& stats_scope,
+                                 tracing::ScopeTime& scope);
+  pg_cache::detail::PartitionData<ValueType> FetchPartition(
+      storages::postgres::Cluster& cluster,
+      const storages::postgres::Query& query,
+      UpdatedFieldType last_updated) const;
+
+  void ListenForUpdates(storages::postgres::Cluster& cluster);
+  void UpdateOnNotification();
+
   static storages::postgres::Query GetAllQuery();
   static storages::postgres::Query GetDeltaQuery();
+  storages::postgres::Query GetPartitionQuery(std::size_t partition) const;
 
   std::chrono::milliseconds ParseCorrection(const ComponentConfig& config);
 
@@ -427,8 +492,11 @@ class PostgreCache final
   const std::chrono::milliseconds full_update_timeout_;
   const std::chrono::milliseconds incremental_update_timeout_;
   const std::size_t chunk_size_;
+  const std::size_t full_update_partitions_;
+  const std::chrono::milliseconds notify_debounce_;
   std::size_t cpu_relax_iterations_parse_{0};
   std::size_t cpu_relax_iterations_copy_{0};
+  std::vector<engine::TaskWithResult<void>> listen_tasks_;
 };
 
 template <typename PostgreCachePolicy>
@@ -446,7 +514,11 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config,
           config["incremental-update-op-timeout"].As<std::chrono::milliseconds>(
               pg_cache::detail::kDefaultIncrementalUpdateTimeout)},
       chunk_size_{config["chunk-size"].As<size_t>(
-          pg_cache::detail::kDefaultChunkSize)} {
+          pg_cache::detail::kDefaultChunkSize)},
+      full_update_partitions_{
+          config["full-update-partitions"].As<size_t>(1)},
+      notify_debounce_{config["notify-debounce"].As<std::chrono::milliseconds>(
+          pg_cache::detail::kDefaultNotifyDebounce)} {
   if (this->GetAllowedUpdateTypes() ==
           cache::AllowedUpdateTypes::kFullAndIncremental &&
       !kIncrementalUpdates) {
@@ -455,6 +527,15 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config,
         "name is specified in traits of '" +
         config.Name() + "' cache");
   }
+  if (full_update_partitions_ == 0 ||
+      (full_update_partitions_ > 1 &&
+       !pg_cache::detail::kHasFullUpdatePartitionKey<PostgreCachePolicy>)) {
+    throw std::logic_error(
+        "Invalid full-update-partitions requested in config for '" +
+        config.Name() +
+        "' cache, it must be positive and values greater than 1 require "
+        "kFullUpdatePartitionKey in the cache policy");
+  }
   if (correction_.count() < 0) {
     throw std::logic_error(
         "Refusing to set forward (negative) update correction requested in "
@@ -479,13 +560,77 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config,
              << GetDeltaQuery().Statement() << "`";
 
   this->StartPeriodicUpdates();
+
+  if constexpr (pg_cache::detail::kHasListenChannel<PostgreCachePolicy>) {
+    for (const auto& cluster : clusters_) {
+      listen_tasks_.push_back(utils::CriticalAsync(
+          "pg-cache-listen", [this, cluster] { ListenForUpdates(*cluster); }));
+    }
+  }
 }
 
 template <typename PostgreCachePolicy>
 PostgreCache<PostgreCachePolicy>::~PostgreCache() {
+  for (auto& task : listen_tasks_) {
+    task.SyncCancel();
+  }
   this->StopPeriodicUpdates();
 }
 
+template <typename PostgreCachePolicy>
+void PostgreCache<PostgreCachePolicy>::ListenForUpdates(
+    storages::postgres::Cluster& cluster) {
+  const std::string_view channel{PostgreCachePolicy::kListenChannel};
+  bool is_resubscribed = false;
+
+  while (!engine::current_task::ShouldCancel()) {
+    try {
+      auto scope = cluster.Listen(channel);
+      // The notifications sent without a subscription are lost
+      if (is_resubscribed) UpdateOnNotification();
+      is_resubscribed = true;
+
+      while (!engine::current_task::ShouldCancel()) {
+        try {
+          scope.WaitNotify(engine::Deadline::FromDuration(
+              pg_cache::detail::kListenWaitTimeout));
+        } catch (const storages::postgres::ConnectionTimeoutError&) {
+          continue;
+        }
+
+        const auto debounce_deadline =
+            engine::Deadline::FromDuration(notify_debounce_);
+        try {
+          while (true) scope.WaitNotify(debounce_deadline);
+        } catch (const storages::postgres::ConnectionTimeoutError&) {
+          // All the notifications of the interval are consumed
+        }
+        UpdateOnNotification();
+      }
+    } catch (const std::exception& e) {
+      if (engine::current_task::ShouldCancel()) break;
+      LOG_WARNING() << "Subscription of cache " << kName << " to channel '"
+                    << channel << "' failed: " << e;
+      engine::InterruptibleSleepFor(pg_cache::detail::kListenRetryInterval);
+    }
+  }
+}
+
+template <typename PostgreCachePolicy>
+void PostgreCache<PostgreCachePolicy>::UpdateOnNotification() {
+  const auto type = (kIncrementalUpdates &&
+                     this->GetAllowedUpdateTypes() !=
+                         cache::AllowedUpdateTypes::kOnlyFull)
+                        ? cache::UpdateType::kIncremental
+                        : cache::UpdateType::kFull;
+  try {
+    cache::CacheUpdateTrait::Update(type);
+  } catch (const std::exception& e) {
+    LOG_WARNING() << "Update of cache " << kName
+                  << " on a notification failed: " << e;
+  }
+}
+
 template <typename PostgreCachePolicy>
 storages::postgres::Query PostgreCache<PostgreCachePolicy>::GetAllQuery() {
   storages::postgres::Query query = PolicyCheckerType::GetQuery();
@@ -518,6 +663,31 @@ storages::postgres::Query PostgreCache<PostgreCachePolicy>::GetDeltaQuery() {
   }
 }
 
+template <typename PostgreCachePolicy>
+storages::postgres::Query PostgreCache<PostgreCachePolicy>::GetPartitionQuery(
+    [[maybe_unused]] std::size_t partition) const {
+  if constexpr (pg_cache::detail::kHasFullUpdatePartitionKey<
+                    PostgreCachePolicy>) {
+    storages::postgres::Query query = PolicyCheckerType::GetQuery();
+    // abs() keeps the negative keys in [0, partitions)
+    const auto condition =
+        fmt::format("abs(({}) % {}) = {}",
+                    PostgreCachePolicy::kFullUpdatePartitionKey,
+                    full_update_partitions_, partition);
+
+    if constexpr (pg_cache::detail::kHasWhere<PostgreCachePolicy>) {
+      return {fmt::format("{} where ({}) and {}", query.Statement(),
+                          PostgreCachePolicy::kWhere, condition),
+              query.GetName()};
+    } else {
+      return {fmt::format("{} where {}", query.Statement(), condition),
+              query.GetName()};
+    }
+  } else {
+    UINVARIANT(false, "Partitioned full update requires a partition key");
+  }
+}
+
 template <typename PostgreCachePolicy>
 std::chrono::milliseconds PostgreCache<PostgreCachePolicy>::ParseCorrection(
     const ComponentConfig& config) {
@@ -561,48 +731,54 @@ void PostgreCache<PostgreCachePolicy>::Update(
   // COPY current cached data
   auto scope = tracing::Span::CurrentSpan().CreateScopeTime(
       std::string{pg_cache::detail::kCopyStage});
+  stats_scope.SetStage(cache::UpdateStage::kBuild);
   auto data_cache = GetDataSnapshot(type, scope);
   [[maybe_unused]] const auto old_size = data_cache->size();
 
   scope.Reset(std::string{pg_cache::detail::kFetchStage});
+  stats_scope.SetStage(cache::UpdateStage::kFetch);
 
   size_t changes = 0;
-  // Iterate clusters
-  for (auto& cluster : clusters_) {
-    if (chunk_size_ > 0) {
-      auto trx = cluster->Begin(
-          kClusterHostTypeFlags, pg::Transaction::RO,
-          pg::CommandControl{timeout, pg_cache::detail::kStatementTimeoutOff});
-      auto portal =
-          trx.MakePortal(query, GetLastUpdated(last_update, *data_cache));
-      while (portal) {
-        scope.Reset(std::string{pg_cache::detail::kFetchStage});
-        auto res = portal.Fetch(chunk_size_);
+  if (type == cache::UpdateType::kFull && full_update_partitions_ > 1) {
+    changes = UpdateByPartitions(GetLastUpdated(last_update, *data_cache),
+                                 data_cache, stats_scope, scope);
+  } else {
+    // Iterate clusters
+    const pg::CommandControl command_control{
+        timeout, pg_cache::detail::kStatementTimeoutOff};
+    for (auto& cluster : clusters_) {
+      if (chunk_size_ > 0) {
+        auto trx = cluster->Begin(kClusterHostTypeFlags, pg::Transaction::RO,
+                                  command_control);
+        auto portal =
+            trx.MakePortal(query, GetLastUpdated(last_update, *data_cache));
+        while (portal) {
+          scope.Reset(std::string{pg_cache::detail::kFetchStage});
+          stats_scope.SetStage(cache::UpdateStage::kFetch);
+          auto res = portal.Fetch(chunk_size_);
+          stats_scope.IncreaseDocumentsReadCount(res.Size());
+
+          scope.Reset(std::string{pg_cache::detail::kParseStage});
+          stats_scope.SetStage(cache::UpdateStage::kParse);
+          CacheResults(res, data_cache, stats_scope, scope);
+          changes += res.Size();
+        }
+        trx.Commit();
+      } else {
+        bool has_parameter = query.Statement().find('$') != std::string::npos;
+        auto res = has_parameter
+                       ? cluster->Execute(
+                             kClusterHostTypeFlags, command_control, query,
+                             GetLastUpdated(last_update, *data_cache))
+                       : cluster->Execute(kClusterHostTypeFlags,
+                                          command_control, query);
         stats_scope.IncreaseDocumentsReadCount(res.Size());
 
         scope.Reset(std::string{pg_cache::detail::kParseStage});
+        stats_scope.SetStage(cache::UpdateStage::kParse);
         CacheResults(res, data_cache, stats_scope, scope);
         changes += res.Size();
       }
-      trx.Commit();
-    } else {
-      bool has_parameter = query.Statement().find('$') != std::string::npos;
-      auto res = has_parameter
-                     ? cluster->Execute(
-                           kClusterHostTypeFlags,
-                           pg::CommandControl{
-                               timeout, pg_cache::detail::kStatementTimeoutOff},
-                           query, GetLastUpdated(last_update, *data_cache))
-                     : cluster->Execute(
-                           kClusterHostTypeFlags,
-                           pg::CommandControl{
-                               timeout, pg_cache::detail::kStatementTimeoutOff},
-                           query);
-      stats_scope.IncreaseDocumentsReadCount(res.Size());
-
-      scope.Reset(std::string{pg_cache::detail::kParseStage});
-      CacheResults(res, data_cache, stats_scope, scope);
-      changes += res.Size();
     }
   }
 
@@ -639,9 +815,11 @@ void PostgreCache<PostgreCachePolicy>::Update(
   }
   if (changes > 0 || type == cache::UpdateType::kFull) {
     // Set current cache
-    stats_scope.Finish(data_cache->size());
+    stats_scope.SetStage(cache::UpdateStage::kPublish);
+    const auto size = data_cache->size();
     pg_cache::detail::OnWritesDone(*data_cache);
     this->Set(std::move(data_cache));
+    stats_scope.Finish(size);
   } else {
     stats_scope.FinishNoChanges();
   }
@@ -673,6 +851,91 @@ void PostgreCache<PostgreCachePolicy>::CacheResults(
   }
 }
 
+// The partitions are fetched and parsed in parallel, the main task inserts
+// them into the container as they are ready.
+template <typename PostgreCachePolicy>
+std::size_t PostgreCache<PostgreCachePolicy>::UpdateByPartitions(
+    UpdatedFieldType last_updated, CachedData& data_cache,
+    cache::UpdateStatisticsScope& stats_scope, tracing::ScopeTime& scope) {
+  using PartitionData = pg_cache::detail::PartitionData<ValueType>;
+  std::vector<engine::TaskWithResult<PartitionData>> tasks;
+  tasks.reserve(clusters_.size() * full_update_partitions_);
+  for (const auto& cluster : clusters_) {
+    for (std::size_t i = 0; i < full_update_partitions_; ++i) {
+      tasks.push_back(utils::Async(
+          "pg-cache-fetch-partition",
+          [this, cluster, query = GetPartitionQuery(i), last_updated] {
+            return FetchPartition(*cluster, query, last_updated);
+          }));
+    }
+  }
+
+  std::size_t changes = 0;
+  for (auto& task : tasks) {
+    scope.Reset(std::string{pg_cache::detail::kFetchStage});
+    stats_scope.SetStage(cache::UpdateStage::kFetch);
+    auto partition = task.Get();
+    stats_scope.IncreaseDocumentsReadCount(partition.read_count);
+    stats_scope.IncreaseDocumentsParseFailures(partition.parse_failures);
+    changes += partition.read_count;
+
+    scope.Reset(std::string{pg_cache::detail::kParseStage});
+    stats_scope.SetStage(cache::UpdateStage::kBuild);
+    utils::CpuRelax relax{cpu_relax_iterations_parse_, &scope};
+    for (auto& value : partition.values) {
+      relax.Relax();
+      using pg_cache::detail::CacheInsertOrAssign;
+      CacheInsertOrAssign(*data_cache, std::move(value),
+                          PostgreCachePolicy::kKeyMember);
+    }
+  }
+  return changes;
+}
+
+template <typename PostgreCachePolicy>
+pg_cache::detail::PartitionData<
+    typename PostgreCache<PostgreCachePolicy>::ValueType>
+PostgreCache<PostgreCachePolicy>::FetchPartition(
+    storages::postgres::Cluster& cluster,
+    const storages::postgres::Query& query,
+    UpdatedFieldType last_updated) const {
+  namespace pg = storages::postgres;
+  pg_cache::detail::PartitionData<ValueType> partition;
+  utils::CpuRelax relax{cpu_relax_iterations_parse_, nullptr};
+  const auto parse = [&](pg::ResultSet res) {
+    partition.read_count += res.Size();
+    partition.values.reserve(partition.values.size() + res.Size());
+    auto values = res.AsSetOf<RawValueType>(pg::kRowTag);
+    for (auto p = values.begin(); p != values.end(); ++p) {
+      relax.Relax();
+      try {
+        partition.values.push_back(
+            pg_cache::detail::ExtractValue<PostgreCachePolicy>(*p));
+      } catch (const std::exception& e) {
+        ++partition.parse_failures;
+        LOG_ERROR() << "Error parsing data row in cache '" << kName << "' to '"
+                    << compiler::GetTypeName<ValueType>() << "': " << e.what();
+      }
+    }
+  };
+
+  const pg::CommandControl command_control{
+      full_update_timeout_, pg_cache::detail::kStatementTimeoutOff};
+  if (chunk_size_ > 0) {
+    auto trx = cluster.Begin(kClusterHostTypeFlags, pg::Transaction::RO,
+                             command_control);
+    auto portal = trx.MakePortal(query, last_updated);
+    while (portal) parse(portal.Fetch(chunk_size_));
+    trx.Commit();
+  } else if (query.Statement().find('$') != std::string::npos) {
+    parse(cluster.Execute(kClusterHostTypeFlags, command_control, query,
+                          last_updated));
+  } else {
+    parse(cluster.Execute(kClusterHostTypeFlags, command_control, query));
+  }
+  return partition;
+}
+
 template <typename PostgreCachePolicy>
 typename PostgreCache<PostgreCachePolicy>::CachedData
 PostgreCache<PostgreCachePolicy>::GetDataSnapshot(cache::UpdateType type,
@@ -14,6 +14,7 @@
 #include <userver/storages/postgres/cluster_types.hpp>
 #include <userver/storages/postgres/database.hpp>
 #include <userver/storages/postgres/detail/non_transaction.hpp>
+#include <userver/storages/postgres/notify.hpp>
 #include <userver/storages/postgres/options.hpp>
 #include <userver/storages/postgres/query.hpp>
 #include <userver/storages/postgres/statistics.hpp>
@@ -172,6 +173,10 @@ class Cluster {
   /// control settings.
   /// @note You must specify at least one role from ClusterHostType here
   ///
+  /// The result of a named statement of the result cache settings is served
+  /// from the client-side cache if all the arguments are of built-in types,
+  /// see SetStatementResultCacheSettings.
+  ///
   /// @warning Do NOT create a query string manually by embedding arguments!
   /// It leads to vulnerabilities and bad performance. Either pass arguments
   /// separately, or use storages::postgres::ParameterScope.
@@ -181,6 +186,11 @@ class Cluster {
 
   /// @brief Execute a statement with stored arguments and specified host
   /// selection rules.
+  ///
+  /// If `batching_connections` of the pool settings is not zero and the
+  /// pipeline mode is enabled, the statement may be sent over a connection
+  /// that is shared with the statements of other coroutines without waiting
+  /// for their results.
   ResultSet Execute(ClusterHostTypeFlags flags, const Query& query,
                     const ParameterStore& store);
 
@@ -191,6 +201,13 @@ class Cluster {
                     const Query& query, const ParameterStore& store);
   /// @}
 
+  /// @brief Subscribes to the notifications of a channel.
+  ///
+  /// The subscription holds a dedicated connection to the master host, see
+  /// NotifyScope. The channel name is an identifier, it is quoted.
+  /// @throws ClusterUnavailable if the master host is not available
+  NotifyScope Listen(std::string_view channel, OptionalCommandControl = {});
+
   /// Replaces globally updated command control with a static user-provided one
   void SetDefaultCommandControl(CommandControl);
 
@@ -217,10 +234,20 @@ class Cluster {
 
   void SetStatementMetricsSettings(const StatementMetricsSettings& settings);
 
+  /// Replaces the set of the statements whose results are cached on the
+  /// client side, see StatementResultCacheSettings.
+  ///
+  /// Only the results of the named statements that are executed by
+  /// Cluster::Execute are cached, use it for the read-only queries that
+  /// tolerate stale results within the TTL.
+  void SetStatementResultCacheSettings(
+      const StatementResultCacheSettings& settings);
+
  private:
   detail::NonTransaction Start(ClusterHostTypeFlags, OptionalCommandControl);
 
   OptionalCommandControl GetQueryCmdCtl(const std::string& query_name) const;
+  bool IsResultCached(const Query& query) const;
   OptionalCommandControl GetHandlersCmdCtl(
       OptionalCommandControl cmd_ctl) const;
 
@@ -237,6 +264,13 @@ template <typename... Args>
 ResultSet Cluster::Execute(ClusterHostTypeFlags flags,
                            OptionalCommandControl statement_cmd_ctl,
                            const Query& query, const Args&... args) {
+  if constexpr ((io::traits::kIsMappedToSystemType<Args> && ...)) {
+    if (IsResultCached(query)) {
+      ParameterStore store;
+      (store.PushBack(args), ...);
+      return Execute(flags, statement_cmd_ctl, query, store);
+    }
+  }
   if (!statement_cmd_ctl && query.GetName()) {
     statement_cmd_ctl = GetQueryCmdCtl(query.GetName()->GetUnderlying());
   }
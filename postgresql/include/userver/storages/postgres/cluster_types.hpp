@@ -44,6 +44,13 @@ enum class ClusterHostType {
 
   /// Chooses a host with the lowest RTT
   kNearest = 0x10,
+
+  /// Chooses a host with the least expected load: the number of connections
+  /// in use weighted by the recent query latency as observed by the client.
+  /// The latency includes the network RTT, so the hosts of the local
+  /// datacenter are preferred until they are loaded noticeably more than the
+  /// remote ones.
+  kLeastLoaded = 0x20,
   /// @}
 };
 
@@ -54,7 +61,8 @@ constexpr ClusterHostTypeFlags kClusterHostRolesMask{
     ClusterHostType::kSlave};
 
 constexpr ClusterHostTypeFlags kClusterHostStrategyMask{
-    ClusterHostType::kRoundRobin, ClusterHostType::kNearest};
+    ClusterHostType::kRoundRobin, ClusterHostType::kNearest,
+    ClusterHostType::kLeastLoaded};
 
 std::string ToString(ClusterHostType);
 std::string ToString(ClusterHostTypeFlags);
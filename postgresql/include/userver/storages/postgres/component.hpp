@@ -125,10 +125,14 @@ namespace components {
 /// monitoring-dbalias      | name of the database for monitorings                      | calculated from dbalias or dbconnection options
 /// max_prepared_cache_size | prepared statements cache size limit                      | 5000
 /// max_statement_metrics   | limit of exported metrics for named statements            | 0
+/// statement_result_cache  | TTLs of the client-side cached results by the query names, see storages::postgres::StatementResultCacheSettings | {}
+/// statement_result_cache_size | limit of the number of the cached statement results per host | 1000
 /// min_pool_size           | number of connections created initially                   | 4
 /// max_pool_size           | maximum number of created connections                     | 15
 /// max_queue_size          | maximum number of clients waiting for a connection        | 200
 /// connecting_limit        | limit for concurrent establishing connections number per pool (0 - unlimited) | 0
+/// batching_connections    | number of connections shared by the concurrent non-transactional queries in the pipeline mode (0 - no sharing) | 0
+/// batching_max_depth      | maximum number of queries in flight on a shared connection | 64
 
 // clang-format on
 
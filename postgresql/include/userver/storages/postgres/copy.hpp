@@ -0,0 +1,169 @@
+#pragma once
+
+/// @file userver/storages/postgres/copy.hpp
+/// @brief COPY FROM STDIN / TO STDOUT streaming in the binary format
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/storages/postgres/io/field_buffer.hpp>
+#include <userver/storages/postgres/io/supported_types.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+#include <userver/storages/postgres/query.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace detail {
+class Connection;
+}  // namespace detail
+
+/// @brief Writer of the rows of a `COPY ... FROM STDIN (FORMAT binary)`
+/// statement, see Transaction::CopyIn.
+///
+/// The columns are formatted with the same formatters as the query
+/// parameters. The rows are sent in chunks of about kChunkSize bytes, WriteRow
+/// suspends the coroutine while the server does not accept more data.
+///
+/// The COPY is aborted if the writer is destroyed before Finish() is called,
+/// the transaction fails in that case.
+///
+/// @code
+/// auto copy = trx.CopyIn("COPY users (id, name) FROM STDIN (FORMAT binary)");
+/// for (const auto& user : users) {
+///   copy.WriteRow(user.id, user.name);
+/// }
+/// const auto copied_rows = copy.Finish();
+/// @endcode
+class CopyInWriter {
+ public:
+  static constexpr std::size_t kChunkSize = 64 * 1024;
+
+  CopyInWriter(detail::Connection* conn, const Query& query,
+               OptionalCommandControl cmd_ctl);
+
+  CopyInWriter(CopyInWriter&&) noexcept;
+  CopyInWriter& operator=(CopyInWriter&&) noexcept;
+
+  CopyInWriter(const CopyInWriter&) = delete;
+  CopyInWriter& operator=(const CopyInWriter&) = delete;
+
+  ~CopyInWriter();
+
+  /// Writes a row, the number and the types of the columns must match the
+  /// column list of the COPY statement
+  template <typename... Columns>
+  void WriteRow(const Columns&... columns);
+
+  /// Sends the rest of the rows and finishes the COPY
+  /// @returns the number of the copied rows
+  std::size_t Finish();
+
+ private:
+  const UserTypes& GetUserTypes() const;
+  void CheckActive() const;
+  void SendBuffer();
+  void Abort() noexcept;
+
+  detail::Connection* conn_{nullptr};
+  Query query_;
+  OptionalCommandControl cmd_ctl_;
+  std::vector<char> buffer_;
+};
+
+/// @brief Reader of the rows of a `COPY ... TO STDOUT (FORMAT binary)`
+/// statement, see Transaction::CopyOut.
+///
+/// The columns are parsed with the same parsers as the result set fields.
+/// The format carries no type information, so only the types that do not need
+/// the server type descriptions are supported, e.g. not the composite types.
+/// The data is received on demand, a slow reader slows down the server.
+///
+/// The COPY is aborted if the reader is destroyed before the last row is read,
+/// the transaction fails in that case.
+///
+/// @code
+/// auto copy = trx.CopyOut("COPY users (id, name) TO STDOUT (FORMAT binary)");
+/// int id = 0;
+/// std::string name;
+/// while (copy.ReadRow(id, name)) {
+///   ...
+/// }
+/// @endcode
+class CopyOutReader {
+ public:
+  CopyOutReader(detail::Connection* conn, const Query& query,
+                OptionalCommandControl cmd_ctl);
+
+  CopyOutReader(CopyOutReader&&) noexcept;
+  CopyOutReader& operator=(CopyOutReader&&) noexcept;
+
+  CopyOutReader(const CopyOutReader&) = delete;
+  CopyOutReader& operator=(const CopyOutReader&) = delete;
+
+  ~CopyOutReader();
+
+  /// Reads the next row into the columns
+  /// @returns false if there are no more rows
+  /// @throws FieldTupleMismatch if the number of columns does not match
+  template <typename... Columns>
+  bool ReadRow(Columns&... columns);
+
+  /// Number of the rows read so far
+  std::size_t RowsRead() const { return rows_read_; }
+
+ private:
+  /// Returns the fields of the next row, std::nullopt after the last row
+  std::optional<io::FieldBuffer> NextRow(std::size_t columns_count);
+  void EnsureData(std::size_t size);
+  /// Appends the next message of data, returns false if there is no more data
+  bool ReceiveData(std::string& buffer);
+  io::FieldBuffer Data(std::size_t offset = 0) const;
+  void Finish();
+  void Abort() noexcept;
+
+  detail::Connection* conn_{nullptr};
+  Query query_;
+  OptionalCommandControl cmd_ctl_;
+  std::string buffer_;
+  std::size_t pos_{0};
+  std::size_t rows_read_{0};
+  bool header_read_{false};
+  bool is_data_received_{false};
+};
+
+template <typename... Columns>
+void CopyInWriter::WriteRow(const Columns&... columns) {
+  static_assert(sizeof...(Columns) > 0, "A row must have columns");
+  CheckActive();
+  const auto& types = GetUserTypes();
+  io::WriteBuffer(types, buffer_, static_cast<Smallint>(sizeof...(Columns)));
+  (io::WriteRawBinary(types, buffer_, columns), ...);
+  if (buffer_.size() >= kChunkSize) SendBuffer();
+}
+
+template <typename... Columns>
+bool CopyOutReader::ReadRow(Columns&... columns) {
+  static_assert(sizeof...(Columns) > 0, "A row must have columns");
+  static_assert(
+      (!io::detail::kParserRequiresTypeCategories<Columns> && ...),
+      "The types that need the server type descriptions are not supported");
+
+  auto row = NextRow(sizeof...(Columns));
+  if (!row) return false;
+
+  static const io::TypeBufferCategory kNoCategories;
+  (row->ReadRaw(columns, kNoCategories,
+                io::traits::kTypeBufferCategory<Columns>),
+   ...);
+  ++rows_read_;
+  return true;
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
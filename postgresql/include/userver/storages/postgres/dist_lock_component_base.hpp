@@ -52,6 +52,8 @@ namespace storages::postgres {
 /// autostart      | if true, start automatically after component load | true
 /// task-processor | the name of the TaskProcessor for running DoWork | main-task-processor
 /// testsuite-support | Enable testsuite support | false
+/// fencing-tokens | keep the fencing tokens in the `fencing_token` column, see dist_lock::DistLockedWorker::GetFencingToken | false
+/// release-channel | NOTIFY channel to take over the released lock without waiting for the next attempt | --
 ///
 /// ## Migration example
 ///
@@ -66,6 +68,13 @@ namespace storages::postgres {
 ///     expiration_time TIMESTAMPTZ
 /// );
 /// ```
+///
+/// The `fencing-tokens` option requires one more column:
+///
+/// ```SQL
+/// ALTER TABLE service.distlocks ADD COLUMN fencing_token BIGINT NOT NULL
+///     DEFAULT 0;
+/// ```
 
 // clang-format on
 
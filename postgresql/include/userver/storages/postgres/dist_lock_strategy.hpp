@@ -3,28 +3,54 @@
 /// @file userver/storages/postgres/dist_lock_strategy.hpp
 /// @brief @copybrief storages::postgres::DistLockStrategy
 
+#include <optional>
+#include <string>
+
 #include <userver/dist_lock/dist_lock_settings.hpp>
 #include <userver/dist_lock/dist_lock_strategy.hpp>
 #include <userver/engine/deadline.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/rcu/rcu.hpp>
+#include <userver/storages/postgres/notify.hpp>
 #include <userver/storages/postgres/options.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace storages::postgres {
 
+/// Optional features of the postgres distributed lock
+struct DistLockOptions {
+  /// Keep the fencing token of the lock in the `fencing_token BIGINT` column
+  /// of the table. The released locks stay in the table to keep their tokens.
+  /// @see dist_lock::DistLockStrategyBase::AcquireWithFencingToken
+  bool fencing_tokens{false};
+
+  /// Notify the channel on release and listen to it while waiting for the
+  /// lock, so the lock is taken over right after it is released. The lock
+  /// that is not released by its holder is still taken over after its TTL.
+  /// Waiting holds a dedicated connection to the master host.
+  std::optional<std::string> release_channel;
+};
+
 /// Postgres distributed locking strategy
 class DistLockStrategy final : public dist_lock::DistLockStrategyBase {
  public:
   DistLockStrategy(ClusterPtr cluster, const std::string& table,
                    const std::string& lock_name,
-                   const dist_lock::DistLockSettings& settings);
+                   const dist_lock::DistLockSettings& settings,
+                   DistLockOptions options = {});
 
   void Acquire(std::chrono::milliseconds lock_ttl,
                const std::string& locker_id) override;
 
+  std::optional<std::int64_t> AcquireWithFencingToken(
+      std::chrono::milliseconds lock_ttl,
+      const std::string& locker_id) override;
+
   void Release(const std::string& locker_id) override;
 
+  void WaitForRelease(engine::Deadline deadline) override;
+
   void UpdateCommandControl(CommandControl cc);
 
  private:
@@ -34,6 +60,10 @@ class DistLockStrategy final : public dist_lock::DistLockStrategyBase {
   const std::string release_query_;
   const std::string lock_name_;
   const std::string owner_prefix_;
+  const DistLockOptions options_;
+
+  engine::Mutex listen_mutex_;
+  std::optional<NotifyScope> listen_scope_;
 };
 
 }  // namespace storages::postgres
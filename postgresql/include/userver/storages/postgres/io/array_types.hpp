@@ -6,19 +6,25 @@
 /// @ingroup userver_postgres_parse_and_format
 
 #include <array>
+#include <cstring>
 #include <iterator>
 #include <set>
 #include <unordered_set>
 #include <vector>
 
+#include <boost/endian/conversion.hpp>
+
 #include <userver/storages/postgres/exceptions.hpp>
 #include <userver/storages/postgres/io/buffer_io_base.hpp>
 #include <userver/storages/postgres/io/field_buffer.hpp>
+#include <userver/storages/postgres/io/floating_point_types.hpp>
+#include <userver/storages/postgres/io/integral_types.hpp>
 #include <userver/storages/postgres/io/row_types.hpp>
 #include <userver/storages/postgres/io/traits.hpp>
 #include <userver/storages/postgres/io/type_mapping.hpp>
 #include <userver/storages/postgres/io/type_traits.hpp>
 #include <userver/storages/postgres/io/user_types.hpp>
+#include <userver/utils/meta.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -43,6 +49,21 @@ namespace storages::postgres::io {
 /// - std::set
 /// - std::unordered_set
 /// - std::vector
+/// - storages::postgres::io::ArrayView (formatting only)
+///
+/// @par Bulk parameters
+/// A column of a bulk insert or update is passed as an array parameter and
+/// expanded with `UNNEST`. io::ArrayView passes a column stored in contiguous
+/// memory without copying it into a container. The arrays of the fixed width
+/// integral and floating point types are written with a single buffer
+/// allocation and without calling the element formatters.
+///
+/// @code
+/// std::vector<int> ids = ...;
+/// std::vector<double> values = ...;
+/// trx.Execute("insert into t (id, value) select * from unnest($1, $2)",
+///             io::ArrayView<int>{ids}, io::ArrayView<double>{values});
+/// @endcode
 ///
 /// ----------
 ///
@@ -50,6 +71,45 @@ namespace storages::postgres::io {
 /// ⇦ @ref pg_range_types | @ref pg_bytea ⇨
 /// @htmlonly </div> @endhtmlonly
 
+/// @brief Non-owning view of contiguous values that is formatted as a one
+/// dimensional array, see @ref pg_arrays
+///
+/// The viewed values must outlive the query execution.
+template <typename T>
+class ArrayView {
+ public:
+  using value_type = T;
+  using const_iterator = const T*;
+
+  constexpr ArrayView() noexcept = default;
+  constexpr ArrayView(const T* data, std::size_t size) noexcept
+      : data_{data}, size_{size} {}
+
+  template <typename Container,
+            typename = std::enable_if_t<std::is_convertible_v<
+                decltype(std::data(std::declval<const Container&>())),
+                const T*>>>
+  constexpr ArrayView(const Container& container) noexcept
+      : data_{std::data(container)}, size_{std::size(container)} {}
+
+  constexpr std::size_t size() const noexcept { return size_; }
+  constexpr bool empty() const noexcept { return size_ == 0; }
+
+  constexpr const_iterator begin() const noexcept { return data_; }
+  constexpr const_iterator cbegin() const noexcept { return data_; }
+
+  constexpr const_iterator end() const noexcept { return data_ + size_; }
+  constexpr const_iterator cend() const noexcept { return data_ + size_; }
+
+ private:
+  const T* data_{nullptr};
+  std::size_t size_{0};
+};
+
+template <typename Container>
+ArrayView(const Container&) -> ArrayView<std::remove_const_t<
+    std::remove_pointer_t<decltype(std::data(std::declval<Container&>()))>>>;
+
 namespace traits {
 
 template <typename Container>
@@ -141,6 +201,22 @@ inline bool ForceInitElementMapping() {
   }
 }
 
+template <typename T>
+constexpr bool IsFixedWidthBinaryParsed() {
+  if constexpr (!std::is_arithmetic_v<T> || !traits::kHasParser<T>) {
+    return false;
+  } else {
+    using Parser = typename traits::IO<T>::ParserType;
+    return std::is_base_of_v<IntegralBinaryParser<T>, Parser> ||
+           std::is_base_of_v<FloatingPointBinaryParser<T>, Parser>;
+  }
+}
+
+/// Values of the type are read from their native representation in
+/// the network byte order
+template <typename T>
+inline constexpr bool kIsFixedWidthBinaryParsed = IsFixedWidthBinaryParsed<T>();
+
 template <typename Container>
 struct ArrayBinaryParser : BufferParserBase<Container> {
   using BaseType = BufferParserBase<Container>;
@@ -244,7 +320,10 @@ struct ArrayBinaryParser : BufferParserBase<Container> {
   void ReadDimension(FieldBuffer& buffer, DimensionConstIterator dim,
                      BufferCategory elem_category,
                      const TypeBufferCategory& categories, Element& elem) {
-    if constexpr (traits::kIsCompatibleContainer<Element>) {
+    if constexpr (meta::kIsVector<Element> &&
+                  kIsFixedWidthBinaryParsed<typename Element::value_type>) {
+      ReadFixedWidthDimension(buffer, *dim, elem_category, categories, elem);
+    } else if constexpr (traits::kIsCompatibleContainer<Element>) {
       if constexpr (traits::kCanClear<Element>) {
         elem.clear();
       }
@@ -265,6 +344,36 @@ struct ArrayBinaryParser : BufferParserBase<Container> {
     }
   }
 
+  // The vector is resized once, the elements of the expected size are byte
+  // swapped right out of the buffer. The rest of the elements (NULLs, values
+  // of a narrower database type) are left to the element parser.
+  template <typename T>
+  void ReadFixedWidthDimension(FieldBuffer& buffer, std::size_t size,
+                               BufferCategory elem_category,
+                               const TypeBufferCategory& categories,
+                               std::vector<T>& elem) {
+    constexpr std::size_t kValueSize = sizeof(T);
+    constexpr std::size_t kElementSize = sizeof(Integer) + kValueSize;
+    using BySizeType = typename IntegralType<kValueSize>::type;
+    const auto size_be =
+        boost::endian::native_to_big(static_cast<Integer>(kValueSize));
+
+    elem.resize(size);
+    std::size_t i = 0;
+    for (; i < size && buffer.length >= kElementSize; ++i) {
+      if (std::memcmp(buffer.buffer, &size_be, sizeof(Integer)) != 0) break;
+      BySizeType tmp;
+      std::memcpy(&tmp, buffer.buffer + sizeof(Integer), kValueSize);
+      boost::endian::big_to_native_inplace(tmp);
+      std::memcpy(&elem[i], &tmp, kValueSize);
+      buffer.buffer += kElementSize;
+      buffer.length -= kElementSize;
+    }
+    for (; i < size; ++i) {
+      buffer.ReadRaw(elem[i], categories, elem_category);
+    }
+  }
+
   void ReadDimension(FieldBuffer& buffer, DimensionConstIterator dim,
                      BufferCategory elem_category,
                      const TypeBufferCategory& categories,
@@ -280,6 +389,22 @@ struct ArrayBinaryParser : BufferParserBase<Container> {
   }
 };
 
+template <typename T>
+constexpr bool IsFixedWidthBinary() {
+  if constexpr (!std::is_arithmetic_v<T> || !traits::kHasFormatter<T>) {
+    return false;
+  } else {
+    using Formatter = typename traits::IO<T>::FormatterType;
+    return std::is_base_of_v<IntegralBinaryFormatter<T>, Formatter> ||
+           std::is_base_of_v<FloatingPointBinaryFormatter<T>, Formatter>;
+  }
+}
+
+/// Values of the type are written with their native representation in
+/// the network byte order
+template <typename T>
+inline constexpr bool kIsFixedWidthBinary = IsFixedWidthBinary<T>();
+
 template <typename Container>
 struct ArrayBinaryFormatter : BufferFormatterBase<Container> {
   using BaseType = BufferFormatterBase<Container>;
@@ -366,6 +491,9 @@ struct ArrayBinaryFormatter : BufferFormatterBase<Container> {
       for (const auto& sub : element) {
         WriteData(types, dim + 1, buffer, sub);
       }
+    } else if constexpr (kIsFixedWidthBinary<
+                             typename Element::value_type>) {
+      WriteFixedWidthData(buffer, element);
     } else {
       // this is the final dimension
       for (const auto& sub : element) {
@@ -374,6 +502,30 @@ struct ArrayBinaryFormatter : BufferFormatterBase<Container> {
     }
   }
 
+  // The buffer is resized once for all the elements, the elements are
+  // byte swapped directly into it
+  template <typename Buffer, typename Element>
+  void WriteFixedWidthData(Buffer& buffer, const Element& element) const {
+    using ValueType = typename Element::value_type;
+    constexpr std::size_t kValueSize = sizeof(ValueType);
+    using BySizeType = typename IntegralType<kValueSize>::type;
+    const auto size_be = boost::endian::native_to_big(
+        static_cast<Integer>(kValueSize));
+
+    auto pos = buffer.size();
+    buffer.resize(pos + element.size() * (sizeof(Integer) + kValueSize));
+    auto* data = reinterpret_cast<char*>(buffer.data());
+    for (const auto& sub : element) {
+      BySizeType tmp;
+      std::memcpy(&tmp, &sub, kValueSize);
+      boost::endian::native_to_big_inplace(tmp);
+      std::memcpy(data + pos, &size_be, sizeof(Integer));
+      pos += sizeof(Integer);
+      std::memcpy(data + pos, &tmp, kValueSize);
+      pos += kValueSize;
+    }
+  }
+
   template <typename Buffer>
   void WriteData(const UserTypes& types, DimensionConstIterator dim,
                  Buffer& buffer, const std::vector<bool>& element) const {
@@ -418,9 +570,16 @@ constexpr bool IsElementMappedToSystem() {
   }
 }
 
+template <typename T>
+struct IsArrayView : std::false_type {};
+
+template <typename T>
+struct IsArrayView<ArrayView<T>> : std::true_type {};
+
 template <typename Container>
 constexpr bool EnableArrayParser() {
-  if constexpr (!traits::kIsCompatibleContainer<Container>) {
+  if constexpr (!traits::kIsCompatibleContainer<Container> ||
+                IsArrayView<Container>::value) {
     return false;
   } else {
     using ElementType = typename traits::ContainerFinalElement<Container>::type;
@@ -482,6 +641,10 @@ struct IsCompatibleContainer<std::set<T...>> : std::true_type {};
 template <typename... T>
 struct IsCompatibleContainer<std::unordered_set<T...>> : std::true_type {};
 
+// io::ArrayView
+template <typename T>
+struct IsCompatibleContainer<io::ArrayView<T>> : std::true_type {};
+
 // TODO Add more containers
 
 }  // namespace traits
@@ -93,12 +93,19 @@ struct CompositeBinaryParser : BufferParserBase<T> {
                  U& val) const {
     Integer field_type = 0;
     buffer.Read(field_type, BufferCategory::kPlainBuffer);
-    auto elem_category = GetTypeBufferCategory(categories, field_type);
-    if (elem_category == BufferCategory::kNoParser) {
-      throw LogicError{"Buffer category for oid " + std::to_string(field_type) +
-                       " is unknown"};
+    if constexpr (traits::kTypeBufferCategory<U> ==
+                  BufferCategory::kPlainBuffer) {
+      // The layout of the field is known at compile time, the parser doesn't
+      // look at the buffer category, so the lookup by oid is skipped
+      buffer.ReadRaw(val, categories, BufferCategory::kPlainBuffer);
+    } else {
+      auto elem_category = GetTypeBufferCategory(categories, field_type);
+      if (elem_category == BufferCategory::kNoParser) {
+        throw LogicError{"Buffer category for oid " +
+                         std::to_string(field_type) + " is unknown"};
+      }
+      buffer.ReadRaw(val, categories, elem_category);
     }
-    buffer.ReadRaw(val, categories, elem_category);
   }
   template <typename Tuple, std::size_t... Indexes>
   void ReadTuple(FieldBuffer& buffer, const TypeBufferCategory& categories,
@@ -0,0 +1,74 @@
+#pragma once
+
+/// @file userver/storages/postgres/notify.hpp
+/// @brief LISTEN/NOTIFY subscriptions
+
+#include <string>
+#include <string_view>
+
+#include <userver/engine/deadline.hpp>
+
+#include <userver/storages/postgres/detail/connection_ptr.hpp>
+#include <userver/storages/postgres/options.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+/// @brief A notification sent with `NOTIFY channel, 'payload'` or
+/// `pg_notify('channel', 'payload')`
+struct Notification {
+  std::string channel;
+  /// Empty if the notification was sent without a payload
+  std::string payload;
+};
+
+/// @brief Subscription to the notifications of a channel, see Cluster::Listen.
+///
+/// The subscription holds a dedicated connection to the master host. The
+/// notifications sent while nobody waits for them are queued and are
+/// returned by the following WaitNotify calls. The channel is unsubscribed
+/// and the connection is returned to the pool when the scope is destroyed.
+///
+/// The notifications sent while the connection was being reestablished are
+/// lost, so the subscribers should resynchronize after a new subscription.
+///
+/// @code
+/// auto scope = cluster->Listen("cache_updates");
+/// while (!engine::current_task::ShouldCancel()) {
+///   const auto notification =
+///       scope.WaitNotify(engine::Deadline::FromDuration(kWaitTimeout));
+///   ...
+/// }
+/// @endcode
+class NotifyScope {
+ public:
+  NotifyScope(detail::ConnectionPtr&& conn, std::string_view channel,
+              OptionalCommandControl cmd_ctl);
+
+  NotifyScope(NotifyScope&&) noexcept;
+  NotifyScope& operator=(NotifyScope&&) noexcept;
+
+  NotifyScope(const NotifyScope&) = delete;
+  NotifyScope& operator=(const NotifyScope&) = delete;
+
+  ~NotifyScope();
+
+  /// Waits for a notification of the channel
+  /// @throws ConnectionTimeoutError if there is no notification until the
+  /// deadline, the subscription is still valid in that case
+  /// @throws ConnectionError if the connection is lost, a new subscription is
+  /// required
+  Notification WaitNotify(engine::Deadline deadline);
+
+ private:
+  void Unlisten() noexcept;
+
+  detail::ConnectionPtr conn_;
+  std::string channel_;
+  OptionalCommandControl cmd_ctl_;
+};
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
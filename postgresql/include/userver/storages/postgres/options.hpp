@@ -165,6 +165,10 @@ static constexpr size_t kDefaultPoolMaxQueueSize = 200;
 /// Default limit for concurrent establishing connections number
 static constexpr size_t kDefaultConnectingLimit = 0;
 
+/// Default limit of queries in flight on a connection shared by the
+/// auto-batching of non-transactional queries
+static constexpr size_t kDefaultBatchingMaxDepth = 64;
+
 /// @brief PostgreSQL connection pool options
 ///
 /// Dynamic option @ref POSTGRES_CONNECTION_POOL_SETTINGS
@@ -181,10 +185,21 @@ struct PoolSettings {
   /// Limits number of concurrent establishing connections (0 - unlimited)
   size_t connecting_limit{kDefaultConnectingLimit};
 
+  /// Number of pool connections that are shared by the concurrent
+  /// non-transactional Cluster::Execute calls in the pipeline mode
+  /// (0 - every call takes a connection of its own)
+  size_t batching_connections{0};
+
+  /// Maximum number of queries in flight on a shared connection, the calls
+  /// beyond it take a connection of their own
+  size_t batching_max_depth{kDefaultBatchingMaxDepth};
+
   bool operator==(const PoolSettings& rhs) const {
     return min_size == rhs.min_size && max_size == rhs.max_size &&
            max_queue_size == rhs.max_queue_size &&
-           connecting_limit == rhs.connecting_limit;
+           connecting_limit == rhs.connecting_limit &&
+           batching_connections == rhs.batching_connections &&
+           batching_max_depth == rhs.batching_max_depth;
   }
 };
 
@@ -261,6 +276,27 @@ struct StatementMetricsSettings final {
   }
 };
 
+/// Default limit of the number of cached statement results of a host
+static constexpr size_t kDefaultResultCacheMaxSize = 1000;
+
+/// @brief Client-side cache of the results of the named read-only statements
+///
+/// The results are cached by the query name and the parameters values. The
+/// concurrent executions of the same statement with the same parameters wait
+/// for the result of the first one.
+struct StatementResultCacheSettings final {
+  /// Time to live of the cached results by the query names, the results of
+  /// the other statements are not cached
+  std::unordered_map<std::string, std::chrono::milliseconds> ttl_by_query;
+
+  /// Maximum number of the cached results of a host
+  size_t max_size{kDefaultResultCacheMaxSize};
+
+  bool operator==(const StatementResultCacheSettings& other) const {
+    return ttl_by_query == other.ttl_by_query && max_size == other.max_size;
+  }
+};
+
 /// Initialization modes
 enum class InitMode {
   kSync = 0,
@@ -286,6 +322,9 @@ struct ClusterSettings {
 
   /// database name
   std::string db_name;
+
+  /// settings for the client-side cache of statement results
+  StatementResultCacheSettings result_cache_settings;
 };
 
 }  // namespace storages::postgres
@@ -168,6 +168,21 @@ namespace storages::postgres {
 /// A result set can be represented as a set of user row types or extracted to
 /// a container. For more information see @ref pg_user_row_types
 ///
+/// The `std::string_view` fields and data members borrow the data of the
+/// result set instead of copying it. To keep the data alive, extract such rows
+/// with ResultSet::AsBorrowedContainer.
+///
+/// @code
+/// struct User {
+///   int id;
+///   std::string_view name;
+/// };
+/// auto users = res.AsBorrowedContainer<std::vector<User>>(kRowTag);
+/// for (const auto& user : users) {
+///   // Process user data
+/// }
+/// @endcode
+///
 /// @todo Interface for copying a ResultSet to an output interator.
 ///
 /// @par Non-select query results
@@ -220,6 +235,8 @@ class Row;
 class ResultSet;
 template <typename T, typename ExtractionTag>
 class TypedResultSet;
+template <typename Container>
+class BorrowedContainer;
 
 /// @brief Accessor to a single field in a result set's row
 class Field {
@@ -632,6 +649,15 @@ class ResultSet {
   template <typename Container>
   Container AsContainer(RowTag) const;
 
+  /// @brief Extract data into a container that keeps the result set alive,
+  /// so that the extracted values may borrow its data, e.g. be or contain
+  /// `std::string_view`.
+  /// For more information see @ref psql_typed_results
+  template <typename Container>
+  BorrowedContainer<Container> AsBorrowedContainer() const;
+  template <typename Container>
+  BorrowedContainer<Container> AsBorrowedContainer(RowTag) const;
+
   /// @brief Extract first row into user type.
   /// A single row result set is expected, will throw an exception when result
   /// set size != 1
@@ -654,6 +680,35 @@ class ResultSet {
   std::shared_ptr<detail::ResultWrapper> pimpl_;
 };
 
+/// @brief A container extracted from a ResultSet together with the result
+/// set data it borrows, see ResultSet::AsBorrowedContainer
+template <typename Container>
+class BorrowedContainer {
+ public:
+  using value_type = typename Container::value_type;
+  using const_iterator = typename Container::const_iterator;
+
+  const Container& Get() const& { return container_; }
+  const Container& operator*() const& { return container_; }
+  const Container* operator->() const& { return &container_; }
+
+  std::size_t size() const { return container_.size(); }
+  bool empty() const { return container_.empty(); }
+
+  const_iterator begin() const { return container_.begin(); }
+  const_iterator end() const { return container_.end(); }
+
+ private:
+  friend class ResultSet;
+
+  BorrowedContainer(ResultSet owner, Container&& container)
+      : owner_{std::move(owner)}, container_{std::move(container)} {}
+
+  // Destroyed after the container
+  ResultSet owner_;
+  Container container_;
+};
+
 namespace detail {
 
 //@{
@@ -867,6 +922,16 @@ Container ResultSet::AsContainer(RowTag) const {
   return c;
 }
 
+template <typename Container>
+BorrowedContainer<Container> ResultSet::AsBorrowedContainer() const {
+  return {*this, AsContainer<Container>()};
+}
+
+template <typename Container>
+BorrowedContainer<Container> ResultSet::AsBorrowedContainer(RowTag) const {
+  return {*this, AsContainer<Container>(kRowTag)};
+}
+
 template <typename T>
 auto ResultSet::AsSingleRow() const {
   return AsSingleRow<T>(kFieldTag);
@@ -3,11 +3,15 @@
 /// @file userver/storages/postgres/statistics.hpp
 /// @brief Statistics helpers
 
+#include <chrono>
+#include <cstdint>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 #include <userver/storages/postgres/detail/time_types.hpp>
 
+#include <userver/utils/statistics/hdr_histogram.hpp>
 #include <userver/utils/statistics/min_max_avg.hpp>
 #include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
@@ -31,6 +35,8 @@ struct TransactionStatistics {
   Counter out_of_trx_total = 0;
   /// Number of parsed queries
   Counter parse_total = 0;
+  /// Number of queries prepared on new connections before their first use
+  Counter warmup_parse_total = 0;
   /// Number of query executions
   Counter execute_total = 0;
   /// Total number of replies
@@ -113,13 +119,35 @@ struct InstanceStatisticsTemplate {
   Counter pool_exhaust_errors = 0;
   /// Error caused by queue size overflow
   Counter queue_size_errors = 0;
+  /// Error caused by a deadline too short to wait for a connection and to
+  /// execute a query of the recent duration
+  Counter queue_deadline_errors = 0;
+  /// Number of times the host was chosen by the kLeastLoaded strategy
+  Counter least_loaded_selected = 0;
+  /// Recent average query duration in microseconds, as observed by the client
+  Counter recent_query_latency_us = 0;
   /// Connect time percentile
   PercentileAccumulator connection_percentile;
   /// Acquire connection percentile
   PercentileAccumulator acquire_percentile;
+  /// Wait in the queue of an exhausted pool percentile
+  PercentileAccumulator queue_wait_percentile;
 };
 
+/// @brief Client-side result cache statistics of a statement
+struct StatementResultCacheStatistics {
+  /// Number of the executions served by a cached result or by the result of
+  /// a concurrent execution
+  std::uint64_t hits = 0;
+  /// Number of the executions that ran the query
+  std::uint64_t misses = 0;
+};
+
+#ifdef USERVER_FEATURE_HDR_HISTOGRAM_TIMINGS
+using Percentile = USERVER_NAMESPACE::utils::statistics::HdrHistogram<>;
+#else
 using Percentile = USERVER_NAMESPACE::utils::statistics::Percentile<2048>;
+#endif
 using MinMaxAvg = USERVER_NAMESPACE::utils::statistics::MinMaxAvg<uint32_t>;
 using InstanceStatistics = InstanceStatisticsTemplate<
     USERVER_NAMESPACE::utils::statistics::RelaxedCounter<uint32_t>,
@@ -162,6 +190,7 @@ struct InstanceStatisticsNonatomic : InstanceStatisticsNonatomicBase {
     transaction.rollback_total = stats.transaction.rollback_total;
     transaction.out_of_trx_total = stats.transaction.out_of_trx_total;
     transaction.parse_total = stats.transaction.parse_total;
+    transaction.warmup_parse_total = stats.transaction.warmup_parse_total;
     transaction.execute_total = stats.transaction.execute_total;
     transaction.reply_total = stats.transaction.reply_total;
     transaction.portal_bind_total = stats.transaction.portal_bind_total;
@@ -186,8 +215,12 @@ struct InstanceStatisticsNonatomic : InstanceStatisticsNonatomicBase {
 
     pool_exhaust_errors = stats.pool_exhaust_errors;
     queue_size_errors = stats.queue_size_errors;
+    queue_deadline_errors = stats.queue_deadline_errors;
+    least_loaded_selected = stats.least_loaded_selected;
+    recent_query_latency_us = stats.recent_query_latency_us;
     connection_percentile = stats.connection_percentile.GetStatsForPeriod();
     acquire_percentile = stats.acquire_percentile.GetStatsForPeriod();
+    queue_wait_percentile = stats.queue_wait_percentile.GetStatsForPeriod();
 
     return *this;
   }
@@ -203,7 +236,21 @@ struct InstanceStatisticsNonatomic : InstanceStatisticsNonatomicBase {
     return *this;
   }
 
+  InstanceStatisticsNonatomic& Add(
+      const std::unordered_map<std::string, StatementResultCacheStatistics>&
+          result_cache) {
+    for (const auto& [name, cache_stats] : result_cache) {
+      auto& total = statement_result_cache[name];
+      total.hits += cache_stats.hits;
+      total.misses += cache_stats.misses;
+    }
+
+    return *this;
+  }
+
   std::unordered_map<std::string, Percentile> statement_timings;
+  std::unordered_map<std::string, StatementResultCacheStatistics>
+      statement_result_cache;
 };
 
 /// @brief Instance statistics with description
@@ -214,6 +261,19 @@ struct InstanceStatsDescriptor {
   InstanceStatisticsNonatomic stats;
 };
 
+/// @brief Cluster topology discovery statistics
+struct ClusterTopologyStatistics {
+  /// Number of out-of-schedule topology checks caused by the errors typical
+  /// for a failover
+  uint64_t triggered_checks = 0;
+  /// Number of detected master host changes
+  uint64_t master_changes = 0;
+  /// Time from the first failover error to the detection of the new master
+  /// during the latest master change, 0 if it was detected by the scheduled
+  /// discovery without any errors
+  std::chrono::milliseconds last_master_change_detection_time{0};
+};
+
 /// @brief Cluster statistics storage
 struct ClusterStatistics {
   /// Master instance statistics
@@ -224,8 +284,18 @@ struct ClusterStatistics {
   std::vector<InstanceStatsDescriptor> slaves;
   /// Unknown/unreachable instances statistics
   std::vector<InstanceStatsDescriptor> unknown;
+  /// Topology discovery statistics
+  ClusterTopologyStatistics topology;
 };
 
+// StatementResultCacheStatistics values support for utils::statistics::Writer
+void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
+                const StatementResultCacheStatistics& stats);
+
+// ClusterTopologyStatistics values support for utils::statistics::Writer
+void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
+                const ClusterTopologyStatistics& stats);
+
 // InstanceStatisticsNonatomic values support for utils::statistics::Writer
 void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
                 const InstanceStatisticsNonatomic& stats);
@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 
+#include <userver/storages/postgres/copy.hpp>
 #include <userver/storages/postgres/detail/connection_ptr.hpp>
 #include <userver/storages/postgres/detail/query_parameters.hpp>
 #include <userver/storages/postgres/detail/time_types.hpp>
@@ -257,6 +258,22 @@ class Transaction {
   Portal MakePortal(OptionalCommandControl statement_cmd_ctl,
                     const Query& query, const ParameterStore& store);
 
+  /// Start a `COPY ... FROM STDIN (FORMAT binary)` statement, the rows are
+  /// written with the returned CopyInWriter. The transaction cannot execute
+  /// other statements until the COPY is finished.
+  ///
+  /// @note COPY is not supported on connections in the pipeline mode
+  CopyInWriter CopyIn(const Query& query,
+                      OptionalCommandControl statement_cmd_ctl = {});
+
+  /// Start a `COPY ... TO STDOUT (FORMAT binary)` statement, the rows are
+  /// read with the returned CopyOutReader. The transaction cannot execute
+  /// other statements until all the rows are read.
+  ///
+  /// @note COPY is not supported on connections in the pipeline mode
+  CopyOutReader CopyOut(const Query& query,
+                        OptionalCommandControl statement_cmd_ctl = {});
+
   /// Set a connection parameter
   /// https://www.postgresql.org/docs/current/sql-set.html
   /// The parameter is set for this transaction only
@@ -28,6 +28,14 @@ properties:
         type: integer
         description: number of rows to request from PostgreSQL, 0 to fetch all rows in one request
         defaultDescription: 1000
+    full-update-partitions:
+        type: integer
+        description: number of parallel queries of a full update, requires kFullUpdatePartitionKey in the policy
+        defaultDescription: 1
+    notify-debounce:
+        type: string
+        description: delay of an update after a notification of kListenChannel, the notifications of the delay are coalesced
+        defaultDescription: 100ms
     pgcomponent:
         type: string
         description: PostgreSQL component name
@@ -4,7 +4,9 @@
 
 #include <boost/functional/hash.hpp>
 
+#include <userver/cache/chunked_cow_map.hpp>
 #include <userver/components/minimal_server_component_list.hpp>
+#include <userver/utils/flat_hash_map.hpp>
 #include <userver/utils/projected_set.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -72,6 +74,22 @@ struct PostgresExamplePolicy {
   // Required: no
   static constexpr const char* kWhere = "id > 10";
 
+  // Integer SQL expression that splits the full update into the
+  // `full-update-partitions` parallel queries by its value modulo the
+  // partitions count.
+  //
+  // Required: no
+  static constexpr const char* kFullUpdatePartitionKey = "id";
+
+  // LISTEN channel of the notifications about the changes of the data. A
+  // notification triggers an update of the cache after the `notify-debounce`
+  // interval, the notifications of the interval are coalesced. The periodic
+  // updates are still needed, as the notifications are lost while the
+  // subscription is being reestablished.
+  //
+  // Required: no
+  static constexpr std::string_view kListenChannel = "my_structures_changed";
+
   // Cache container type.
   //
   // It can be of any map type. The default is `unordered_map`, it is not
@@ -295,6 +313,30 @@ struct PostgresExamplePolicy7 {
   using CacheContainer = utils::ProjectedUnorderedSet<ValueType, kKeyMember>;
 };
 
+// Tests ChunkedCowMap as container, incremental updates do not copy the data
+struct PostgresExamplePolicy8 {
+  static constexpr std::string_view kName = "my-pg-cache";
+  using ValueType = MyStructure;
+  static constexpr auto kKeyMember = &MyStructure::id;
+  static constexpr const char* kQuery =
+      "select id, bar, updated from test.my_data";
+  static constexpr const char* kUpdatedField = "updated";
+  using UpdatedFieldType = storages::postgres::TimePointTz;
+  using CacheContainer = cache::ChunkedCowMap<int, MyStructure>;
+};
+
+// Tests FlatHashMap as container
+struct PostgresExamplePolicy9 {
+  static constexpr std::string_view kName = "my-pg-cache";
+  using ValueType = MyStructure;
+  static constexpr auto kKeyMember = &MyStructure::id;
+  static constexpr const char* kQuery =
+      "select id, bar, updated from test.my_data";
+  static constexpr const char* kUpdatedField = "updated";
+  using UpdatedFieldType = storages::postgres::TimePointTz;
+  using CacheContainer = utils::FlatHashMap<int, MyStructure>;
+};
+
 // Instantiation test
 using MyCache1 = PostgreCache<PostgresExamplePolicy>;
 using MyCache2 = PostgreCache<PostgresExamplePolicy2>;
@@ -304,6 +346,8 @@ using MyTrivialCache = PostgreCache<PostgresTrivialPolicy>;
 using MyCache5 = PostgreCache<PostgresExamplePolicy5>;
 using MyCache6 = PostgreCache<PostgresExamplePolicy6>;
 using MyCache7 = PostgreCache<PostgresExamplePolicy7>;
+using MyCache8 = PostgreCache<PostgresExamplePolicy8>;
+using MyCache9 = PostgreCache<PostgresExamplePolicy9>;
 
 // NB: field access required for actual instantiation
 static_assert(MyCache1::kIncrementalUpdates);
@@ -313,6 +357,8 @@ static_assert(MyCache4::kIncrementalUpdates);
 static_assert(MyCache5::kIncrementalUpdates);
 static_assert(MyCache6::kIncrementalUpdates);
 static_assert(MyCache7::kIncrementalUpdates);
+static_assert(MyCache8::kIncrementalUpdates);
+static_assert(MyCache9::kIncrementalUpdates);
 
 namespace pg = storages::postgres;
 static_assert(MyCache1::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
@@ -322,6 +368,8 @@ static_assert(MyCache4::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache5::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache6::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache7::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
+static_assert(MyCache8::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
+static_assert(MyCache9::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 
 // Update() instantiation test
 [[maybe_unused]] void VerifyUpdateCompiles(
@@ -335,6 +383,8 @@ static_assert(MyCache7::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
   MyCache5 cache5{config, context};
   MyCache6 cache6{config, context};
   MyCache7 cache7{config, context};
+  MyCache8 cache8{config, context};
+  MyCache9 cache9{config, context};
 }
 
 inline auto SampleOfComponentRegistration() {
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <storages/postgres/tests/test_buffers.hpp>
+#include <userver/storages/postgres/io/array_types.hpp>
+#include <userver/storages/postgres/io/composite_types.hpp>
+#include <userver/storages/postgres/io/string_types.hpp>
+#include <userver/storages/postgres/io/user_types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+namespace io = pg::io;
+
+const pg::UserTypes types;
+const io::TypeBufferCategory categories;
+
+struct Composite {
+  pg::Integer id{0};
+  pg::Bigint counter{0};
+  double weight{0};
+  std::string name;
+};
+
+template <typename T>
+std::vector<T> MakeArray(std::size_t size) {
+  std::vector<T> result(size);
+  std::iota(result.begin(), result.end(), T{1});
+  return result;
+}
+
+template <typename T>
+void PgArrayBinaryFormat(benchmark::State& state) {
+  const auto value = MakeArray<T>(state.range(0));
+  pg::test::Buffer buffer;
+  for (auto _ : state) {
+    io::WriteBuffer(types, buffer, value);
+    buffer.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+void PgArrayBinaryParse(benchmark::State& state) {
+  auto value = MakeArray<T>(state.range(0));
+  pg::test::Buffer buffer;
+  io::WriteBuffer(types, buffer, value);
+  const auto fb =
+      pg::test::MakeFieldBuffer(buffer, io::BufferCategory::kArrayBuffer);
+  for (auto _ : state) {
+    io::ReadBuffer(fb, value, categories);
+    benchmark::DoNotOptimize(value);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+void WriteField(pg::test::Buffer& buffer, const T& value) {
+  io::WriteBuffer(types, buffer,
+                  static_cast<pg::Integer>(io::CppToPg<T>::GetOid(types)));
+  io::WriteRawBinary(types, buffer, value);
+}
+
+void PgCompositeBinaryParse(benchmark::State& state) {
+  pg::test::Buffer buffer;
+  io::WriteBuffer(types, buffer, pg::Integer{4});
+  WriteField(buffer, pg::Integer{42});
+  WriteField(buffer, pg::Bigint{1} << 40);
+  WriteField(buffer, 0.5);
+  WriteField(buffer, std::string{"composite"});
+  const auto fb =
+      pg::test::MakeFieldBuffer(buffer, io::BufferCategory::kCompositeBuffer);
+
+  Composite value;
+  for (auto _ : state) {
+    io::ReadBuffer(fb, value, categories);
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+BENCHMARK_TEMPLATE(PgArrayBinaryFormat, pg::Integer)->Range(8, 8 << 10);
+BENCHMARK_TEMPLATE(PgArrayBinaryFormat, double)->Range(8, 8 << 10);
+BENCHMARK_TEMPLATE(PgArrayBinaryParse, pg::Integer)->Range(8, 8 << 10);
+BENCHMARK_TEMPLATE(PgArrayBinaryParse, pg::Bigint)->Range(8, 8 << 10);
+BENCHMARK_TEMPLATE(PgArrayBinaryParse, double)->Range(8, 8 << 10);
+BENCHMARK(PgCompositeBinaryParse);
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -82,6 +82,16 @@ void Cluster::SetStatementMetricsSettings(
   pimpl_->SetStatementMetricsSettings(settings);
 }
 
+void Cluster::SetStatementResultCacheSettings(
+    const StatementResultCacheSettings& settings) {
+  pimpl_->SetStatementResultCacheSettings(settings);
+}
+
+NotifyScope Cluster::Listen(std::string_view channel,
+                            OptionalCommandControl cmd_ctl) {
+  return pimpl_->Listen(channel, GetHandlersCmdCtl(cmd_ctl));
+}
+
 detail::NonTransaction Cluster::Start(ClusterHostTypeFlags flags,
                                       OptionalCommandControl cmd_ctl) {
   return pimpl_->Start(flags, cmd_ctl);
@@ -92,9 +102,15 @@ OptionalCommandControl Cluster::GetQueryCmdCtl(
   return pimpl_->GetQueryCmdCtl(query_name);
 }
 
+bool Cluster::IsResultCached(const Query& query) const {
+  return query.GetName() &&
+         pimpl_->IsResultCached(query.GetName()->GetUnderlying());
+}
+
 OptionalCommandControl Cluster::GetHandlersCmdCtl(
     OptionalCommandControl cmd_ctl) const {
-  return cmd_ctl ? cmd_ctl : pimpl_->GetTaskDataHandlersCommandControl();
+  return pimpl_->ApplyTaskDataDeadline(
+      cmd_ctl ? cmd_ctl : pimpl_->GetTaskDataHandlersCommandControl());
 }
 
 ResultSet Cluster::Execute(ClusterHostTypeFlags flags, const Query& query,
@@ -109,8 +125,7 @@ ResultSet Cluster::Execute(ClusterHostTypeFlags flags,
     statement_cmd_ctl = GetQueryCmdCtl(query.GetName()->GetUnderlying());
   }
   statement_cmd_ctl = GetHandlersCmdCtl(statement_cmd_ctl);
-  auto ntrx = Start(flags, statement_cmd_ctl);
-  return ntrx.Execute(statement_cmd_ctl, query.Statement(), store);
+  return pimpl_->Execute(flags, statement_cmd_ctl, query, store);
 }
 
 }  // namespace storages::postgres
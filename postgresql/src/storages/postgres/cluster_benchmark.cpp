@@ -0,0 +1,139 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+#include <storages/postgres/util_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+using namespace pg::bench;
+
+using WideRow = std::tuple<pg::Bigint, pg::Integer, pg::Smallint, double, bool,
+                           std::string, std::string, pg::Bigint, double,
+                           std::string>;
+
+const std::string kWideRowsQuery =
+    "select i::bigint, i::integer, (i % 1000)::smallint, i * 0.5, i % 2 = 0, "
+    "'name_' || i, md5(i::text), i * 1000::bigint, i / 3.0, repeat('x', 32) "
+    "from generate_series(1, $1) as i";
+
+constexpr std::size_t kContentionThreads = 4;
+constexpr std::size_t kContentionPoolSize = 2;
+constexpr int kPortalRows = 10'000;
+
+pg::PipelineMode GetPipelineMode(const benchmark::State& state) {
+  return state.range(0) ? pg::PipelineMode::kEnabled
+                        : pg::PipelineMode::kDisabled;
+}
+
+BENCHMARK_DEFINE_F(PgCluster, ClusterSelectOne)(benchmark::State& state) {
+  RunStandalone(
+      state, 1, MakeClusterSettings(1, GetPipelineMode(state)), [this, &state] {
+        for (auto _ : state) {
+          auto res =
+              GetCluster().Execute(pg::ClusterHostType::kMaster, "select 1");
+          benchmark::DoNotOptimize(res.AsSingleRow<int>());
+        }
+        state.SetItemsProcessed(state.iterations());
+      });
+}
+BENCHMARK_REGISTER_F(PgCluster, ClusterSelectOne)
+    ->ArgName("pipeline")
+    ->Arg(0)
+    ->Arg(1);
+
+BENCHMARK_DEFINE_F(PgCluster, ClusterWideRowsDecode)
+(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto rows = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+      auto res = GetCluster().Execute(pg::ClusterHostType::kMaster,
+                                      kWideRowsQuery, rows);
+      auto decoded = res.AsContainer<std::vector<WideRow>>(pg::kRowTag);
+      benchmark::DoNotOptimize(decoded);
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+  });
+}
+BENCHMARK_REGISTER_F(PgCluster, ClusterWideRowsDecode)
+    ->RangeMultiplier(10)
+    ->Range(1, 10'000);
+
+BENCHMARK_DEFINE_F(PgCluster, ClusterTransaction)(benchmark::State& state) {
+  RunStandalone(
+      state, 1, MakeClusterSettings(1, GetPipelineMode(state)), [this, &state] {
+        for (auto _ : state) {
+          auto trx = GetCluster().Begin(pg::ClusterHostType::kMaster, {});
+          auto res = trx.Execute("select 1");
+          benchmark::DoNotOptimize(res.AsSingleRow<int>());
+          trx.Commit();
+        }
+        state.SetItemsProcessed(state.iterations());
+      });
+}
+BENCHMARK_REGISTER_F(PgCluster, ClusterTransaction)
+    ->ArgName("pipeline")
+    ->Arg(0)
+    ->Arg(1);
+
+// Every iteration runs the concurrent queries on a pool that is smaller than
+// the number of the queries, the waiting for a connection is measured as well
+BENCHMARK_DEFINE_F(PgCluster, ClusterPoolContention)
+(benchmark::State& state) {
+  RunStandalone(
+      state, kContentionThreads,
+      MakeClusterSettings(kContentionPoolSize, pg::PipelineMode::kDisabled),
+      [this, &state] {
+        const auto concurrency = static_cast<std::size_t>(state.range(0));
+        auto& task_processor = engine::current_task::GetTaskProcessor();
+        std::vector<engine::TaskWithResult<void>> tasks;
+        tasks.reserve(concurrency);
+        for (auto _ : state) {
+          for (std::size_t i = 0; i < concurrency; ++i) {
+            tasks.push_back(engine::AsyncNoSpan(task_processor, [this] {
+              auto res = GetCluster().Execute(pg::ClusterHostType::kMaster,
+                                              "select 1");
+              benchmark::DoNotOptimize(res.AsSingleRow<int>());
+            }));
+          }
+          for (auto& task : tasks) task.Get();
+          tasks.clear();
+        }
+        state.SetItemsProcessed(state.iterations() * concurrency);
+      });
+}
+BENCHMARK_REGISTER_F(PgCluster, ClusterPoolContention)
+    ->RangeMultiplier(4)
+    ->Range(kContentionPoolSize, 64);
+
+BENCHMARK_DEFINE_F(PgCluster, ClusterPortalFetch)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto chunk_size = static_cast<std::uint32_t>(state.range(0));
+    for (auto _ : state) {
+      auto trx = GetCluster().Begin(pg::ClusterHostType::kMaster, {});
+      auto portal = trx.MakePortal(kWideRowsQuery, kPortalRows);
+      while (portal) {
+        auto res = portal.Fetch(chunk_size);
+        auto decoded = res.AsContainer<std::vector<WideRow>>(pg::kRowTag);
+        benchmark::DoNotOptimize(decoded);
+      }
+      trx.Commit();
+    }
+    state.SetItemsProcessed(state.iterations() * kPortalRows);
+  });
+}
+BENCHMARK_REGISTER_F(PgCluster, ClusterPortalFetch)
+    ->RangeMultiplier(10)
+    ->Range(100, 10'000);
+
+}  // namespace
+
+USERVER_NAMESPACE_END
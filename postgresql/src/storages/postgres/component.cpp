@@ -78,6 +78,9 @@ Postgres::Postgres(const ComponentConfig& config,
   initial_settings_.statement_metrics_settings =
       config.As<storages::postgres::StatementMetricsSettings>();
 
+  initial_settings_.result_cache_settings =
+      config.As<storages::postgres::StatementResultCacheSettings>();
+
   initial_settings_.pool_settings =
       config.As<storages::postgres::PoolSettings>();
   initial_settings_.init_mode = config["sync-start"].As<bool>(true)
@@ -246,6 +249,18 @@ properties:
         type: integer
         description: limit of exported metrics for named statements
         defaultDescription: 0
+    statement_result_cache:
+        type: object
+        description: TTLs of the client-side cached results by the query names
+        defaultDescription: '{}'
+        additionalProperties:
+            type: string
+            description: time to live of the cached results of the query
+        properties: {}
+    statement_result_cache_size:
+        type: integer
+        description: limit of the number of the cached statement results per host
+        defaultDescription: 1000
     error-injection:
         type: object
         description: error-injection options
@@ -283,6 +298,14 @@ properties:
         type: integer
         description: limit for concurrent establishing connections number per pool (0 - unlimited)
         defaultDescription: 0
+    batching_connections:
+        type: integer
+        description: number of connections shared by the concurrent non-transactional queries in the pipeline mode (0 - no sharing)
+        defaultDescription: 0
+    batching_max_depth:
+        type: integer
+        description: maximum number of queries in flight on a shared connection
+        defaultDescription: 64
 )");
 }
 
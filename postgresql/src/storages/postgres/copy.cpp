@@ -0,0 +1,236 @@
+#include <userver/storages/postgres/copy.hpp>
+
+#include <algorithm>
+#include <string_view>
+#include <utility>
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace {
+
+// https://www.postgresql.org/docs/current/sql-copy.html#id-1.9.3.55.9.4
+constexpr std::string_view kSignature{"PGCOPY\n\377\r\n\0", 11};
+constexpr std::size_t kHeaderSize =
+    kSignature.size() + sizeof(Integer) + sizeof(Integer);
+constexpr Smallint kTrailer = -1;
+
+}  // namespace
+
+CopyInWriter::CopyInWriter(detail::Connection* conn, const Query& query,
+                           OptionalCommandControl cmd_ctl)
+    : conn_{conn}, query_{query}, cmd_ctl_{std::move(cmd_ctl)} {
+  UASSERT(conn_);
+  conn_->CopyStart(query_, /*is_copy_in=*/true, cmd_ctl_);
+
+  buffer_.reserve(kChunkSize);
+  buffer_.insert(buffer_.end(), kSignature.begin(), kSignature.end());
+  const auto& types = GetUserTypes();
+  // flags
+  io::WriteBuffer(types, buffer_, Integer{0});
+  // header extension length
+  io::WriteBuffer(types, buffer_, Integer{0});
+}
+
+CopyInWriter::CopyInWriter(CopyInWriter&& other) noexcept
+    : conn_{std::exchange(other.conn_, nullptr)},
+      query_{std::move(other.query_)},
+      cmd_ctl_{std::move(other.cmd_ctl_)},
+      buffer_{std::move(other.buffer_)} {}
+
+CopyInWriter& CopyInWriter::operator=(CopyInWriter&& other) noexcept {
+  if (this == &other) return *this;
+  Abort();
+  conn_ = std::exchange(other.conn_, nullptr);
+  query_ = std::move(other.query_);
+  cmd_ctl_ = std::move(other.cmd_ctl_);
+  buffer_ = std::move(other.buffer_);
+  return *this;
+}
+
+CopyInWriter::~CopyInWriter() { Abort(); }
+
+std::size_t CopyInWriter::Finish() {
+  CheckActive();
+  io::WriteBuffer(GetUserTypes(), buffer_, kTrailer);
+  SendBuffer();
+  auto* conn = std::exchange(conn_, nullptr);
+  return conn->CopyFinish(query_, /*is_copy_in=*/true, cmd_ctl_);
+}
+
+const UserTypes& CopyInWriter::GetUserTypes() const {
+  return conn_->GetUserTypes();
+}
+
+void CopyInWriter::CheckActive() const {
+  if (!conn_) throw LogicError{"COPY is already finished"};
+}
+
+void CopyInWriter::SendBuffer() {
+  try {
+    conn_->CopyPutData({buffer_.data(), buffer_.size()}, cmd_ctl_);
+  } catch (const std::exception&) {
+    Abort();
+    throw;
+  }
+  buffer_.clear();
+}
+
+void CopyInWriter::Abort() noexcept {
+  if (!conn_) return;
+  std::exchange(conn_, nullptr)->CopyAbort(/*is_copy_in=*/true);
+}
+
+CopyOutReader::CopyOutReader(detail::Connection* conn, const Query& query,
+                             OptionalCommandControl cmd_ctl)
+    : conn_{conn}, query_{query}, cmd_ctl_{std::move(cmd_ctl)} {
+  UASSERT(conn_);
+  conn_->CopyStart(query_, /*is_copy_in=*/false, cmd_ctl_);
+}
+
+CopyOutReader::CopyOutReader(CopyOutReader&& other) noexcept
+    : conn_{std::exchange(other.conn_, nullptr)},
+      query_{std::move(other.query_)},
+      cmd_ctl_{std::move(other.cmd_ctl_)},
+      buffer_{std::move(other.buffer_)},
+      pos_{other.pos_},
+      rows_read_{other.rows_read_},
+      header_read_{other.header_read_},
+      is_data_received_{other.is_data_received_} {}
+
+CopyOutReader& CopyOutReader::operator=(CopyOutReader&& other) noexcept {
+  if (this == &other) return *this;
+  Abort();
+  conn_ = std::exchange(other.conn_, nullptr);
+  query_ = std::move(other.query_);
+  cmd_ctl_ = std::move(other.cmd_ctl_);
+  buffer_ = std::move(other.buffer_);
+  pos_ = other.pos_;
+  rows_read_ = other.rows_read_;
+  header_read_ = other.header_read_;
+  is_data_received_ = other.is_data_received_;
+  return *this;
+}
+
+CopyOutReader::~CopyOutReader() { Abort(); }
+
+std::optional<io::FieldBuffer> CopyOutReader::NextRow(
+    std::size_t columns_count) {
+  if (!conn_) return std::nullopt;
+
+  if (!header_read_) {
+    EnsureData(kHeaderSize);
+    if (std::string_view{buffer_}.substr(pos_, kSignature.size()) !=
+        kSignature) {
+      throw InvalidBinaryBuffer{"Invalid COPY binary signature"};
+    }
+    Integer extension_size = 0;
+    Data(kSignature.size() + sizeof(Integer)).Read(extension_size);
+    if (extension_size < 0) {
+      throw InvalidBinaryBuffer{"Invalid COPY header extension size"};
+    }
+    EnsureData(kHeaderSize + extension_size);
+    pos_ += kHeaderSize + extension_size;
+    header_read_ = true;
+  }
+
+  EnsureData(sizeof(Smallint));
+  Smallint fields_count = 0;
+  Data().Read(fields_count);
+  if (fields_count == kTrailer) {
+    pos_ += sizeof(Smallint);
+    Finish();
+    return std::nullopt;
+  }
+  if (fields_count < 0 ||
+      static_cast<std::size_t>(fields_count) != columns_count) {
+    throw FieldTupleMismatch(fields_count, columns_count);
+  }
+
+  // The row is checked to be complete before parsing the fields
+  std::size_t row_size = sizeof(Smallint);
+  for (Smallint i = 0; i < fields_count; ++i) {
+    EnsureData(row_size + sizeof(Integer));
+    Integer field_size = 0;
+    Data(row_size).Read(field_size);
+    row_size += sizeof(Integer);
+    if (field_size > 0) row_size += field_size;
+  }
+  EnsureData(row_size);
+
+  auto row = Data(sizeof(Smallint));
+  row.length = row_size - sizeof(Smallint);
+  pos_ += row_size;
+  return row;
+}
+
+void CopyOutReader::EnsureData(std::size_t size) {
+  if (buffer_.size() - pos_ >= size) return;
+
+  buffer_.erase(0, pos_);
+  pos_ = 0;
+  while (buffer_.size() < size) {
+    if (!ReceiveData(buffer_)) {
+      // Throws the error of the COPY, if any
+      Finish();
+      throw InvalidInputBufferSize{buffer_.size(),
+                                   "unexpected end of COPY data"};
+    }
+  }
+}
+
+bool CopyOutReader::ReceiveData(std::string& buffer) {
+  if (is_data_received_) return false;
+  try {
+    is_data_received_ = !conn_->CopyGetData(buffer, cmd_ctl_);
+  } catch (const std::exception&) {
+    Abort();
+    throw;
+  }
+  return !is_data_received_;
+}
+
+io::FieldBuffer CopyOutReader::Data(std::size_t offset) const {
+  UASSERT(pos_ + offset <= buffer_.size());
+  return {false, io::BufferCategory::kPlainBuffer,
+          buffer_.size() - pos_ - offset,
+          reinterpret_cast<const std::uint8_t*>(buffer_.data()) + pos_ +
+              offset};
+}
+
+void CopyOutReader::Finish() {
+  std::string rest;
+  while (ReceiveData(rest)) {
+    rest.clear();
+  }
+  // The connection is out of the COPY mode, the result is left
+  std::exchange(conn_, nullptr)
+      ->CopyFinish(query_, /*is_copy_in=*/false, cmd_ctl_);
+}
+
+void CopyOutReader::Abort() noexcept {
+  if (!conn_) return;
+  auto* conn = std::exchange(conn_, nullptr);
+  if (!is_data_received_) {
+    conn->CopyAbort(/*is_copy_in=*/false);
+    return;
+  }
+
+  // Only the result is left
+  try {
+    conn->CopyFinish(query_, /*is_copy_in=*/false, cmd_ctl_);
+  } catch (const std::exception& e) {
+    LOG_LIMITED_WARNING() << "Error of an abandoned COPY: " << e;
+  }
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
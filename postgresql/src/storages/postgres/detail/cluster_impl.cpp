@@ -1,5 +1,8 @@
 #include <storages/postgres/detail/cluster_impl.hpp>
 
+#include <algorithm>
+#include <chrono>
+
 #include <fmt/format.h>
 
 #include <userver/engine/async.hpp>
@@ -28,15 +31,38 @@ ClusterHostType Fallback(ClusterHostType ht) {
     case ClusterHostType::kNone:
     case ClusterHostType::kRoundRobin:
     case ClusterHostType::kNearest:
+    case ClusterHostType::kLeastLoaded:
       throw ClusterError("Invalid ClusterHostType value for fallback " +
                          ToString(ht));
   }
   UINVARIANT(false, "Unexpected cluster host type");
 }
 
-size_t SelectDsnIndex(const topology::TopologyBase::DsnIndices& indices,
-                      ClusterHostTypeFlags flags,
-                      std::atomic<uint32_t>& rr_host_idx) {
+size_t SelectLeastLoadedDsnIndex(
+    const topology::TopologyBase::DsnIndices& indices,
+    const std::vector<std::shared_ptr<ConnectionPool>>& host_pools,
+    std::atomic<uint32_t>& rr_host_idx) {
+  // Rotating the start spreads the load between the equally loaded hosts
+  const auto start = rr_host_idx.fetch_add(1, std::memory_order_relaxed);
+  size_t best_index = indices[start % indices.size()];
+  auto best_load = host_pools[best_index]->GetLoad();
+  for (size_t i = 1; i < indices.size(); ++i) {
+    const auto index = indices[(start + i) % indices.size()];
+    const auto load = host_pools[index]->GetLoad();
+    if (load < best_load) {
+      best_index = index;
+      best_load = load;
+    }
+  }
+  host_pools[best_index]->AccountLeastLoadedSelection();
+  return best_index;
+}
+
+size_t SelectDsnIndex(
+    const topology::TopologyBase::DsnIndices& indices,
+    ClusterHostTypeFlags flags,
+    const std::vector<std::shared_ptr<ConnectionPool>>& host_pools,
+    std::atomic<uint32_t>& rr_host_idx) {
   UASSERT(!indices.empty());
   if (indices.empty()) {
     throw ClusterError("Cannot select host from an empty list");
@@ -51,6 +77,10 @@ size_t SelectDsnIndex(const topology::TopologyBase::DsnIndices& indices,
       idx_pos =
           rr_host_idx.fetch_add(1, std::memory_order_relaxed) % indices.size();
     }
+  } else if (strategy_flags == ClusterHostType::kLeastLoaded) {
+    if (indices.size() != 1) {
+      return SelectLeastLoadedDsnIndex(indices, host_pools, rr_host_idx);
+    }
   } else if (strategy_flags != ClusterHostType::kNearest) {
     throw LogicError(
         fmt::format("Invalid strategy requested: {}, ensure only one is used",
@@ -69,7 +99,8 @@ ClusterImpl::ClusterImpl(DsnList dsns, clients::dns::Resolver* resolver,
                          const error_injection::Settings& ei_settings)
     : default_cmd_ctls_(default_cmd_ctls),
       bg_task_processor_(bg_task_processor),
-      rr_host_idx_(0) {
+      rr_host_idx_(0),
+      result_cache_settings_(cluster_settings.result_cache_settings) {
   if (dsns.empty()) {
     throw ClusterError("Cannot create a cluster from an empty DSN list");
   } else if (dsns.size() == 1) {
@@ -91,6 +122,7 @@ ClusterImpl::ClusterImpl(DsnList dsns, clients::dns::Resolver* resolver,
   UASSERT(!dsn_list.empty());
 
   LOG_DEBUG() << "Starting pools initialization";
+  const auto rediscovery_trigger = topology_->GetRediscoveryTrigger();
   host_pools_.reserve(dsn_list.size());
   for (const auto& dsn : dsn_list) {
     host_pools_.push_back(ConnectionPool::Create(
@@ -99,6 +131,11 @@ ClusterImpl::ClusterImpl(DsnList dsns, clients::dns::Resolver* resolver,
         cluster_settings.conn_settings,
         cluster_settings.statement_metrics_settings, default_cmd_ctls_,
         testsuite_pg_ctl, ei_settings));
+    host_pools_.back()->SetStatementResultCacheSettings(
+        cluster_settings.result_cache_settings);
+    if (rediscovery_trigger) {
+      host_pools_.back()->SetFailoverCallback(rediscovery_trigger);
+    }
   }
   LOG_DEBUG() << "Pools initialized";
 }
@@ -129,6 +166,8 @@ ClusterStatisticsPtr ClusterImpl::GetStatistics() const {
     cluster_stats->master.stats.Add(host_pools_[dsn_index]
                                         ->GetStatementTimingsStorage()
                                         .GetTimingsPercentiles());
+    cluster_stats->master.stats.Add(
+        host_pools_[dsn_index]->GetStatementResultCache().GetStatistics());
     is_host_pool_seen[dsn_index] = 1;
   }
 
@@ -146,6 +185,8 @@ ClusterStatisticsPtr ClusterImpl::GetStatistics() const {
     cluster_stats->sync_slave.stats.Add(host_pools_[dsn_index]
                                             ->GetStatementTimingsStorage()
                                             .GetTimingsPercentiles());
+    cluster_stats->sync_slave.stats.Add(
+        host_pools_[dsn_index]->GetStatementResultCache().GetStatistics());
     is_host_pool_seen[dsn_index] = 1;
   }
 
@@ -167,6 +208,8 @@ ClusterStatisticsPtr ClusterImpl::GetStatistics() const {
       slave_desc.stats.Add(host_pools_[dsn_index]
                                ->GetStatementTimingsStorage()
                                .GetTimingsPercentiles());
+      slave_desc.stats.Add(
+          host_pools_[dsn_index]->GetStatementResultCache().GetStatistics());
       is_host_pool_seen[dsn_index] = 1;
     }
   }
@@ -181,9 +224,11 @@ ClusterStatisticsPtr ClusterImpl::GetStatistics() const {
     desc.stats.Add(host_pools_[i]->GetStatistics(), dsn_stats[i]);
     desc.stats.Add(
         host_pools_[i]->GetStatementTimingsStorage().GetTimingsPercentiles());
+    desc.stats.Add(host_pools_[i]->GetStatementResultCache().GetStatistics());
 
     cluster_stats->unknown.push_back(std::move(desc));
   }
+  cluster_stats->topology = topology_->GetTopologyStatistics();
 
   return cluster_stats;
 }
@@ -207,7 +252,8 @@ ClusterImpl::ConnectionPoolPtr ClusterImpl::FindPool(
     if (alive_dsn_indices->empty()) {
       throw ClusterUnavailable("None of cluster hosts are available");
     }
-    dsn_index = SelectDsnIndex(*alive_dsn_indices, flags, rr_host_idx_);
+    dsn_index = SelectDsnIndex(*alive_dsn_indices, flags, host_pools_,
+                               rr_host_idx_);
   } else {
     auto host_role = static_cast<ClusterHostType>(role_flags.GetValue());
     auto dsn_indices_by_type = topology_->GetDsnIndicesByType();
@@ -229,7 +275,8 @@ ClusterImpl::ConnectionPoolPtr ClusterImpl::FindPool(
                       ToString(host_role), ToString(role_flags)));
     }
     LOG_TRACE() << "Starting transaction on " << host_role;
-    dsn_index = SelectDsnIndex(dsn_indices_it->second, flags, rr_host_idx_);
+    dsn_index = SelectDsnIndex(dsn_indices_it->second, flags, host_pools_,
+                               rr_host_idx_);
   }
 
   UASSERT(dsn_index < host_pools_.size());
@@ -264,6 +311,25 @@ NonTransaction ClusterImpl::Start(ClusterHostTypeFlags flags,
   return FindPool(flags)->Start(cmd_ctl);
 }
 
+NotifyScope ClusterImpl::Listen(std::string_view channel,
+                                OptionalCommandControl cmd_ctl) {
+  LOG_TRACE() << "Requested subscription to channel " << channel;
+  // The notifications are delivered only to the sessions of the master
+  return FindPool(ClusterHostType::kMaster)->Listen(channel, cmd_ctl);
+}
+
+ResultSet ClusterImpl::Execute(ClusterHostTypeFlags flags,
+                               OptionalCommandControl cmd_ctl,
+                               const Query& query,
+                               const ParameterStore& store) {
+  if (!(flags & kClusterHostRolesMask)) {
+    throw LogicError(
+        "Host role must be specified for execution of a single statement");
+  }
+  LOG_TRACE() << "Requested single statement on " << flags;
+  return FindPool(flags)->Execute(cmd_ctl, query, store);
+}
+
 void ClusterImpl::SetDefaultCommandControl(CommandControl cmd_ctl,
                                            DefaultCommandControlSource source) {
   default_cmd_ctls_.UpdateDefaultCmdCtl(cmd_ctl, source);
@@ -302,6 +368,19 @@ void ClusterImpl::SetStatementMetricsSettings(
   }
 }
 
+void ClusterImpl::SetStatementResultCacheSettings(
+    const StatementResultCacheSettings& settings) {
+  for (const auto& pool : host_pools_) {
+    pool->SetStatementResultCacheSettings(settings);
+  }
+  result_cache_settings_.Assign(settings);
+}
+
+bool ClusterImpl::IsResultCached(const std::string& query_name) const {
+  const auto settings = result_cache_settings_.Read();
+  return settings->ttl_by_query.count(query_name) != 0;
+}
+
 OptionalCommandControl ClusterImpl::GetQueryCmdCtl(
     const std::string& query_name) const {
   return default_cmd_ctls_.GetQueryCmdCtl(query_name);
@@ -316,6 +395,24 @@ OptionalCommandControl ClusterImpl::GetTaskDataHandlersCommandControl() const {
   return std::nullopt;
 }
 
+OptionalCommandControl ClusterImpl::ApplyTaskDataDeadline(
+    OptionalCommandControl cmd_ctl) const {
+  const auto* task_data = server::request::kTaskInheritedData.GetOptional();
+  if (!task_data || !task_data->deadline.IsReachable()) return cmd_ctl;
+
+  // Zero statement timeout disables it, so at least a millisecond is left
+  const auto time_left = std::max(
+      std::chrono::duration_cast<TimeoutDuration>(
+          task_data->deadline.TimeLeft()),
+      TimeoutDuration{1});
+  const auto limit = [time_left](TimeoutDuration timeout) {
+    return timeout.count() > 0 ? std::min(timeout, time_left) : time_left;
+  };
+
+  const auto result = cmd_ctl.value_or(GetDefaultCommandControl());
+  return CommandControl{limit(result.execute), limit(result.statement)};
+}
+
 }  // namespace storages::postgres::detail
 
 USERVER_NAMESPACE_END
@@ -7,6 +7,7 @@
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/error_injection/settings.hpp>
+#include <userver/rcu/rcu.hpp>
 #include <userver/testsuite/postgres_control.hpp>
 
 #include <storages/postgres/detail/pg_impl_types.hpp>
@@ -40,6 +41,11 @@ class ClusterImpl {
 
   NonTransaction Start(ClusterHostTypeFlags, OptionalCommandControl);
 
+  NotifyScope Listen(std::string_view channel, OptionalCommandControl);
+
+  ResultSet Execute(ClusterHostTypeFlags, OptionalCommandControl,
+                    const Query& query, const ParameterStore& store);
+
   void SetDefaultCommandControl(CommandControl, DefaultCommandControlSource);
   CommandControl GetDefaultCommandControl() const;
 
@@ -55,10 +61,19 @@ class ClusterImpl {
 
   void SetStatementMetricsSettings(const StatementMetricsSettings& settings);
 
+  void SetStatementResultCacheSettings(
+      const StatementResultCacheSettings& settings);
+
+  bool IsResultCached(const std::string& query_name) const;
+
   OptionalCommandControl GetQueryCmdCtl(const std::string& query_name) const;
 
   OptionalCommandControl GetTaskDataHandlersCommandControl() const;
 
+  /// Limits the timeouts by the deadline of the handled request
+  OptionalCommandControl ApplyTaskDataDeadline(
+      OptionalCommandControl cmd_ctl) const;
+
  private:
   using ConnectionPoolPtr = std::shared_ptr<ConnectionPool>;
 
@@ -69,6 +84,7 @@ class ClusterImpl {
   engine::TaskProcessor& bg_task_processor_;
   std::vector<ConnectionPoolPtr> host_pools_;
   std::atomic<uint32_t> rr_host_idx_;
+  rcu::Variable<StatementResultCacheSettings> result_cache_settings_;
 };
 
 }  // namespace storages::postgres::detail
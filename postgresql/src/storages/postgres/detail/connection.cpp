@@ -65,6 +65,10 @@ bool Connection::IsConnected() const { return pimpl_->IsConnected(); }
 
 bool Connection::IsIdle() const { return pimpl_->IsIdle(); }
 
+bool Connection::TakeFailoverSignal() { return pimpl_->TakeFailoverSignal(); }
+
+bool Connection::IsPipelineActive() const { return pimpl_->IsPipelineActive(); }
+
 int Connection::GetServerVersion() const { return pimpl_->GetServerVersion(); }
 
 bool Connection::IsInTransaction() const { return pimpl_->IsInTransaction(); }
@@ -129,6 +133,72 @@ ResultSet Connection::PortalExecute(StatementId statement_id,
                                std::move(statement_cmd_ctl));
 }
 
+std::vector<Connection::PreparedStatementDescription>
+Connection::TakeNewPreparedStatements() {
+  return pimpl_->TakeNewPreparedStatements();
+}
+
+std::size_t Connection::PrepareStatements(
+    const std::vector<PreparedStatementDescription>& statements) {
+  return pimpl_->PrepareStatements(statements);
+}
+
+void Connection::CopyStart(const Query& query, bool is_copy_in,
+                           OptionalCommandControl statement_cmd_ctl) {
+  pimpl_->CopyStart(query, is_copy_in, std::move(statement_cmd_ctl));
+}
+
+void Connection::CopyPutData(std::string_view data,
+                             OptionalCommandControl statement_cmd_ctl) {
+  pimpl_->CopyPutData(data, std::move(statement_cmd_ctl));
+}
+
+bool Connection::CopyGetData(std::string& buffer,
+                             OptionalCommandControl statement_cmd_ctl) {
+  return pimpl_->CopyGetData(buffer, std::move(statement_cmd_ctl));
+}
+
+std::size_t Connection::CopyFinish(const Query& query, bool is_copy_in,
+                                   OptionalCommandControl statement_cmd_ctl) {
+  return pimpl_->CopyFinish(query, is_copy_in, std::move(statement_cmd_ctl));
+}
+
+void Connection::CopyAbort(bool is_copy_in) { pimpl_->CopyAbort(is_copy_in); }
+
+void Connection::Listen(std::string_view channel,
+                        OptionalCommandControl cmd_ctl) {
+  pimpl_->Listen(channel, std::move(cmd_ctl));
+}
+
+void Connection::Unlisten(std::string_view channel,
+                          OptionalCommandControl cmd_ctl) {
+  pimpl_->Unlisten(channel, std::move(cmd_ctl));
+}
+
+Notification Connection::WaitNotify(engine::Deadline deadline) {
+  return pimpl_->WaitNotify(deadline);
+}
+
+void Connection::SendPipelined(const Query& query,
+                               const detail::QueryParameters& params,
+                               engine::Deadline deadline, tracing::Span& span) {
+  pimpl_->SendPipelined(query, params, deadline, span);
+}
+
+bool Connection::TryFlushPipeline() { return pimpl_->TryFlushPipeline(); }
+
+std::optional<ResultSet> Connection::TryGetPipelinedResult() {
+  return pimpl_->TryGetPipelinedResult();
+}
+
+bool Connection::WaitReadable(engine::Deadline deadline) {
+  return pimpl_->WaitReadable(deadline);
+}
+
+bool Connection::WaitWriteable(engine::Deadline deadline) {
+  return pimpl_->WaitWriteable(deadline);
+}
+
 void Connection::CancelAndCleanup(TimeoutDuration timeout) {
   pimpl_->CancelAndCleanup(timeout);
 }
@@ -2,9 +2,13 @@
 
 #include <atomic>
 #include <chrono>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
+#include <userver/engine/deadline.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/error_injection/settings.hpp>
 #include <userver/testsuite/postgres_control.hpp>
@@ -15,6 +19,7 @@
 #include <userver/storages/postgres/detail/query_parameters.hpp>
 #include <userver/storages/postgres/detail/time_types.hpp>
 #include <userver/storages/postgres/dsn.hpp>
+#include <userver/storages/postgres/notify.hpp>
 #include <userver/storages/postgres/options.hpp>
 #include <userver/storages/postgres/parameter_store.hpp>
 #include <userver/storages/postgres/result_set.hpp>
@@ -107,6 +112,14 @@ class Connection {
     SteadyClock::duration sum_query_duration{0};
   };
 
+  /// Text and parameter types of a prepared statement, enough to prepare it
+  /// on another connection
+  struct PreparedStatementDescription {
+    StatementId id{};
+    std::string statement;
+    std::vector<Oid> param_types;
+  };
+
   using SizeGuard =
       USERVER_NAMESPACE::utils::SizeGuard<std::shared_ptr<std::atomic<size_t>>>;
 
@@ -155,6 +168,11 @@ class Connection {
   /// Check if the connection is currently idle (IsConnected &&
   /// !IsInTransaction)
   bool IsIdle() const;
+  /// Check if the libpq pipeline mode is on
+  bool IsPipelineActive() const;
+  /// Returns true once after the server reported an error typical for a
+  /// failover: the host became read-only or is shutting down
+  bool TakeFailoverSignal();
 
   /// The result is formed by multiplying the server's major version number by
   /// 10000 and adding the minor version number. -- docs
@@ -225,6 +243,62 @@ class Connection {
   ResultSet PortalExecute(StatementId, const std::string& portal_name,
                           std::uint32_t n_rows, OptionalCommandControl);
 
+  /// @name Sharing of the prepared statements between connections of a pool
+  //@{
+  /// Returns the statements prepared since the previous call
+  std::vector<PreparedStatementDescription> TakeNewPreparedStatements();
+  /// Prepares the statements that are not prepared yet. The statements that
+  /// fail to prepare are skipped, throws on connection errors.
+  /// @returns the number of the prepared statements
+  std::size_t PrepareStatements(
+      const std::vector<PreparedStatementDescription>& statements);
+  //@}
+
+  /// @name COPY FROM STDIN / TO STDOUT in the binary format
+  //@{
+  /// Sends the COPY statement and waits for the server to switch to the
+  /// COPY mode
+  void CopyStart(const Query& query, bool is_copy_in,
+                 OptionalCommandControl statement_cmd_ctl);
+  /// Sends a chunk of data, waits while the server does not accept it
+  void CopyPutData(std::string_view data,
+                   OptionalCommandControl statement_cmd_ctl);
+  /// Appends the next message of data to the buffer, returns false if there
+  /// is no more data
+  bool CopyGetData(std::string& buffer,
+                   OptionalCommandControl statement_cmd_ctl);
+  /// Finishes the COPY, returns the number of copied rows
+  std::size_t CopyFinish(const Query& query, bool is_copy_in,
+                         OptionalCommandControl statement_cmd_ctl);
+  /// Aborts an unfinished COPY, the transaction fails. Does not throw, the
+  /// connection is closed if it cannot leave the COPY mode.
+  void CopyAbort(bool is_copy_in);
+  //@}
+
+  /// @name LISTEN/NOTIFY, see NotifyScope
+  //@{
+  void Listen(std::string_view channel, OptionalCommandControl cmd_ctl);
+  /// Also discards the received notifications
+  void Unlisten(std::string_view channel, OptionalCommandControl cmd_ctl);
+  Notification WaitNotify(engine::Deadline deadline);
+  //@}
+
+  /// @name Pipelining of queries from different coroutines
+  /// The caller is responsible for the order of the results and for waiting
+  /// on the socket, see detail::PipelineExecutor
+  //@{
+  /// Sends the query with a sync point after it, does not wait
+  void SendPipelined(const Query& query, const detail::QueryParameters& params,
+                     engine::Deadline deadline, tracing::Span& span);
+  /// @returns false if there is still data to send
+  bool TryFlushPipeline();
+  /// Returns the result of the earliest query in flight, std::nullopt if it
+  /// is not fully received yet. Throws the error of that query.
+  std::optional<ResultSet> TryGetPipelinedResult();
+  [[nodiscard]] bool WaitReadable(engine::Deadline deadline);
+  [[nodiscard]] bool WaitWriteable(engine::Deadline deadline);
+  //@}
+
   /// Send cancel to the database backend
   /// Try to return connection to idle state discarding all results.
   /// If there is a transaction in progress - roll it back.
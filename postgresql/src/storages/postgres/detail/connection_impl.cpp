@@ -1,5 +1,7 @@
 #include <storages/postgres/detail/connection_impl.hpp>
 
+#include <utility>
+
 #include <boost/functional/hash.hpp>
 
 #include <userver/error_injection/hook.hpp>
@@ -25,6 +27,21 @@ const char* const kStatementTimeoutParameter = "statement_timeout";
 const std::string kBadCachedPlanErrorMessage =
     "cached plan must not change result type";
 
+// Errors of a host that stopped being the writable master or is going down,
+// the cluster topology should be checked again without waiting for the
+// scheduled discovery
+bool IsFailoverError(SqlState state) {
+  switch (state) {
+    case SqlState::kReadOnlySqlTransaction:
+    case SqlState::kAdminShutdown:
+    case SqlState::kCrashShutdown:
+    case SqlState::kCannotConnectNow:
+      return true;
+    default:
+      return false;
+  }
+}
+
 std::size_t QueryHash(const std::string& statement,
                       const QueryParameters& params) {
   auto res = params.TypeHash();
@@ -131,6 +148,21 @@ ORDER BY c.reltype, a.attnum)~";
 
 const std::string kPingStatement = "SELECT 1 AS ping";
 
+// Parameters of a statement that is prepared without being executed
+class ParamTypesOnly {
+ public:
+  explicit ParamTypesOnly(const std::vector<Oid>& types) : types_{types} {}
+
+  std::size_t Size() const { return types_.size(); }
+  static const char* const* ParamBuffers() { return nullptr; }
+  const Oid* ParamTypesBuffer() const { return types_.data(); }
+  static const int* ParamLengthsBuffer() { return nullptr; }
+  static const int* ParamFormatsBuffer() { return nullptr; }
+
+ private:
+  const std::vector<Oid>& types_;
+};
+
 void CheckQueryParameters(const std::string& statement,
                           const QueryParameters& params) {
   for (std::size_t i = 1; i <= params.Size(); ++i) {
@@ -296,6 +328,10 @@ bool ConnectionImpl::IsPipelineActive() const {
   return conn_wrapper_.IsPipelineActive();
 }
 
+bool ConnectionImpl::TakeFailoverSignal() {
+  return std::exchange(is_failover_suspected_, false);
+}
+
 ConnectionSettings const& ConnectionImpl::GetSettings() const {
   return settings_;
 }
@@ -477,6 +513,195 @@ ResultSet ConnectionImpl::PortalExecute(
                     count_execute, span, scope, &prepared_info->description);
 }
 
+std::vector<Connection::PreparedStatementDescription>
+ConnectionImpl::TakeNewPreparedStatements() {
+  return std::exchange(new_prepared_, {});
+}
+
+std::size_t ConnectionImpl::PrepareStatements(
+    const std::vector<Connection::PreparedStatementDescription>& statements) {
+  if (settings_.prepared_statements ==
+      ConnectionSettings::kNoPreparedStatements) {
+    return 0;
+  }
+  CheckBusy();
+  DiscardOldPreparedStatements(MakeCurrentDeadline());
+
+  std::size_t prepared_count = 0;
+  for (const auto& description : statements) {
+    // Do not evict the statements that are already prepared
+    if (prepared_.GetSize() >= settings_.max_prepared_cache_size) break;
+
+    ParamTypesOnly holder{description.param_types};
+    const QueryParameters params{holder};
+    if (prepared_.Get(
+            Connection::StatementId{QueryHash(description.statement, params)})) {
+      continue;
+    }
+
+    tracing::Span span{scopes::kPrepare};
+    conn_wrapper_.FillSpanTags(span);
+    span.AddTag(tracing::kDatabaseStatement, description.statement);
+    const auto deadline = MakeCurrentDeadline();
+    CheckDeadlineReached(deadline);
+    auto scope = span.CreateScopeTime();
+    try {
+      PrepareStatement(description.statement, params, deadline, span, scope);
+      ++prepared_count;
+    } catch (const ConnectionError&) {
+      throw;
+    } catch (const std::exception& e) {
+      // E.g. the table of the statement was dropped
+      LOG_LIMITED_WARNING() << "Failed to prepare statement `"
+                            << description.statement << "`: " << e;
+    }
+  }
+  return prepared_count;
+}
+
+void ConnectionImpl::CopyStart(const Query& query, bool is_copy_in,
+                               OptionalCommandControl statement_cmd_ctl) {
+  if (IsPipelineActive()) {
+    throw LogicError{"COPY is not supported in the pipeline mode"};
+  }
+  CheckBusy();
+  auto deadline = MakeCommandDeadline(statement_cmd_ctl);
+  SetStatementTimeout(std::move(statement_cmd_ctl));
+
+  CheckDeadlineReached(deadline);
+  auto span = MakeQuerySpan(query);
+  auto scope = span.CreateScopeTime(scopes::kExec);
+  ++stats_.execute_total;
+  try {
+    conn_wrapper_.SendQuery(query.Statement(), scope);
+    conn_wrapper_.WaitCopyStart(is_copy_in, deadline, scope);
+  } catch (const std::exception&) {
+    ++stats_.error_execute_total;
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  }
+}
+
+void ConnectionImpl::CopyPutData(std::string_view data,
+                                 OptionalCommandControl statement_cmd_ctl) {
+  conn_wrapper_.PutCopyData(data, MakeCommandDeadline(statement_cmd_ctl));
+}
+
+bool ConnectionImpl::CopyGetData(std::string& buffer,
+                                 OptionalCommandControl statement_cmd_ctl) {
+  return conn_wrapper_.GetCopyData(buffer,
+                                   MakeCommandDeadline(statement_cmd_ctl));
+}
+
+std::size_t ConnectionImpl::CopyFinish(
+    const Query& query, bool is_copy_in,
+    OptionalCommandControl statement_cmd_ctl) {
+  const auto deadline = MakeCommandDeadline(statement_cmd_ctl);
+  auto span = MakeQuerySpan(query);
+  auto scope = span.CreateScopeTime(scopes::kExec);
+  try {
+    if (is_copy_in) conn_wrapper_.PutCopyEnd(nullptr, deadline);
+    auto res = conn_wrapper_.WaitResult(deadline, scope);
+    stats_.last_execute_finish = SteadyClock::now();
+    return res.RowsAffected();
+  } catch (const std::exception&) {
+    ++stats_.error_execute_total;
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  }
+}
+
+void ConnectionImpl::CopyAbort(bool is_copy_in) {
+  ++stats_.error_execute_total;
+  const auto deadline = MakeCurrentDeadline();
+  try {
+    if (is_copy_in) {
+      conn_wrapper_.PutCopyEnd("COPY is aborted by the client", deadline);
+    } else {
+      // The server stops sending the data only after the cancellation
+      Cancel();
+      std::string buffer;
+      while (conn_wrapper_.GetCopyData(buffer, deadline)) buffer.clear();
+    }
+    // The error of the aborted COPY leaves the transaction failed
+    conn_wrapper_.DiscardInput(deadline);
+  } catch (const std::exception& e) {
+    // libpq does not leave the COPY mode by itself, the connection cannot be
+    // cleaned up
+    LOG_LIMITED_WARNING() << "Failed to abort COPY, closing the connection: "
+                          << e;
+    MarkAsBroken();
+    Close();
+  }
+}
+
+void ConnectionImpl::Listen(std::string_view channel,
+                            OptionalCommandControl cmd_ctl) {
+  CheckBusy();
+  ExecuteCommandNoPrepare("LISTEN " + conn_wrapper_.EscapeIdentifier(channel),
+                          MakeCommandDeadline(cmd_ctl));
+}
+
+void ConnectionImpl::Unlisten(std::string_view channel,
+                              OptionalCommandControl cmd_ctl) {
+  CheckBusy();
+  ExecuteCommandNoPrepare(
+      "UNLISTEN " + conn_wrapper_.EscapeIdentifier(channel),
+      MakeCommandDeadline(cmd_ctl));
+  // No more notifications of the channel after UNLISTEN
+  conn_wrapper_.DiscardNotifications();
+}
+
+Notification ConnectionImpl::WaitNotify(engine::Deadline deadline) {
+  CheckBusy();
+  return conn_wrapper_.WaitNotify(deadline);
+}
+
+void ConnectionImpl::SendPipelined(const Query& query,
+                                   const QueryParameters& params,
+                                   engine::Deadline deadline,
+                                   tracing::Span& span) {
+  UASSERT(IsPipelineActive());
+  if (settings_.ignore_unused_query_params ==
+      ConnectionSettings::kCheckUnused) {
+    CheckQueryParameters(query.Statement(), params);
+  }
+  CheckDeadlineReached(deadline);
+  conn_wrapper_.FillSpanTags(span);
+  auto scope = span.CreateScopeTime(scopes::kExec);
+  ++stats_.execute_total;
+  // Unnamed statement is parsed in the same round trip
+  conn_wrapper_.SendQuery(query.Statement(), params, scope);
+  conn_wrapper_.PipelineSync();
+}
+
+bool ConnectionImpl::TryFlushPipeline() { return conn_wrapper_.TryFlush(); }
+
+std::optional<ResultSet> ConnectionImpl::TryGetPipelinedResult() {
+  try {
+    auto res = conn_wrapper_.TryGetPipelineResult();
+    if (res) {
+      stats_.last_execute_finish = SteadyClock::now();
+      // User types are not reloaded here, the connection is shared with
+      // other queries that are in flight
+      if (!res->IsEmpty()) res->FillBufferCategories(db_types_);
+      if (res->FieldCount()) ++stats_.reply_total;
+    }
+    return res;
+  } catch (const std::exception&) {
+    ++stats_.error_execute_total;
+    throw;
+  }
+}
+
+bool ConnectionImpl::WaitReadable(engine::Deadline deadline) {
+  return conn_wrapper_.WaitReadable(deadline);
+}
+
+bool ConnectionImpl::WaitWriteable(engine::Deadline deadline) {
+  return conn_wrapper_.WaitWriteable(deadline);
+}
+
 void ConnectionImpl::CancelAndCleanup(TimeoutDuration timeout) {
   auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(timeout);
 
@@ -579,6 +804,12 @@ engine::Deadline ConnectionImpl::MakeCurrentDeadline() const {
   return testsuite_pg_ctl_.MakeExecuteDeadline(CurrentExecuteTimeout());
 }
 
+engine::Deadline ConnectionImpl::MakeCommandDeadline(
+    const OptionalCommandControl& statement_cmd_ctl) const {
+  return testsuite_pg_ctl_.MakeExecuteDeadline(
+      statement_cmd_ctl ? statement_cmd_ctl->execute : CurrentExecuteTimeout());
+}
+
 void ConnectionImpl::SetTransactionCommandControl(CommandControl cmd_ctl) {
   if (!IsInTransaction()) {
     throw NotInTransaction{
@@ -687,6 +918,11 @@ const ConnectionImpl::PreparedStatementInfo& ConnectionImpl::PrepareStatement(
     // Ensure we've got binary format established
     res.GetRowDescription().CheckBinaryFormat(db_types_);
     ++stats_.parse_total;
+    if (new_prepared_.size() < settings_.max_prepared_cache_size) {
+      const auto* types = params.ParamTypesBuffer();
+      new_prepared_.push_back(
+          {query_id, statement, {types, types + params.Size()}});
+    }
     return *statement_info;
   }
 }
@@ -890,6 +1126,12 @@ ResultSet ConnectionImpl::WaitResult(const std::string& statement,
     }
     span.AddTag(tracing::kErrorFlag, true);
     throw;
+  } catch (const ServerRuntimeError& e) {
+    if (IsFailoverError(e.GetServerMessage().GetSqlState())) {
+      is_failover_suspected_ = true;
+    }
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
   } catch (const std::exception&) {
     span.AddTag(tracing::kErrorFlag, true);
     throw;
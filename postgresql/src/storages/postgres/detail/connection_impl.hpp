@@ -5,6 +5,7 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <userver/cache/lru_map.hpp>
 #include <userver/engine/deadline.hpp>
@@ -48,6 +49,7 @@ class ConnectionImpl {
   bool IsIdle() const;
   bool IsInTransaction() const;
   bool IsPipelineActive() const;
+  bool TakeFailoverSignal();
   ConnectionSettings const& GetSettings() const;
 
   CommandControl GetDefaultCommandControl() const;
@@ -81,6 +83,32 @@ class ConnectionImpl {
                           const std::string& portal_name, std::uint32_t n_rows,
                           OptionalCommandControl statement_cmd_ctl);
 
+  std::vector<Connection::PreparedStatementDescription>
+  TakeNewPreparedStatements();
+  std::size_t PrepareStatements(
+      const std::vector<Connection::PreparedStatementDescription>& statements);
+
+  void CopyStart(const Query& query, bool is_copy_in,
+                 OptionalCommandControl statement_cmd_ctl);
+  void CopyPutData(std::string_view data,
+                   OptionalCommandControl statement_cmd_ctl);
+  bool CopyGetData(std::string& buffer,
+                   OptionalCommandControl statement_cmd_ctl);
+  std::size_t CopyFinish(const Query& query, bool is_copy_in,
+                         OptionalCommandControl statement_cmd_ctl);
+  void CopyAbort(bool is_copy_in);
+
+  void Listen(std::string_view channel, OptionalCommandControl cmd_ctl);
+  void Unlisten(std::string_view channel, OptionalCommandControl cmd_ctl);
+  Notification WaitNotify(engine::Deadline deadline);
+
+  void SendPipelined(const Query& query, const detail::QueryParameters& params,
+                     engine::Deadline deadline, tracing::Span& span);
+  bool TryFlushPipeline();
+  std::optional<ResultSet> TryGetPipelinedResult();
+  [[nodiscard]] bool WaitReadable(engine::Deadline deadline);
+  [[nodiscard]] bool WaitWriteable(engine::Deadline deadline);
+
   void CancelAndCleanup(TimeoutDuration timeout);
   bool Cleanup(TimeoutDuration timeout);
 
@@ -113,6 +141,8 @@ class ConnectionImpl {
   void CheckDeadlineReached(const engine::Deadline& deadline);
   tracing::Span MakeQuerySpan(const Query& query) const;
   engine::Deadline MakeCurrentDeadline() const;
+  engine::Deadline MakeCommandDeadline(
+      const OptionalCommandControl& statement_cmd_ctl) const;
 
   void SetTransactionCommandControl(CommandControl cmd_ctl);
 
@@ -170,10 +200,13 @@ class ConnectionImpl {
   Connection::Statistics stats_;
   PGConnectionWrapper conn_wrapper_;
   PreparedStatements prepared_;
+  // Prepared since the last TakeNewPreparedStatements call
+  std::vector<Connection::PreparedStatementDescription> new_prepared_;
   UserTypes db_types_;
   bool is_in_recovery_ = true;
   bool is_read_only_ = true;
   bool is_discard_prepared_pending_ = false;
+  bool is_failover_suspected_ = false;
   ConnectionSettings settings_;
 
   CommandControl default_cmd_ctl_{{}, {}};
@@ -512,6 +512,199 @@ ResultSet PGConnectionWrapper::WaitResult(Deadline deadline,
   return MakeResult(std::move(handle));
 }
 
+void PGConnectionWrapper::WaitCopyStart(bool is_copy_in, Deadline deadline,
+                                        tracing::ScopeTime& scope) {
+  scope.Reset(scopes::kLibpqWaitResult);
+  Flush(deadline);
+  ConsumeInput(deadline);
+  auto handle = MakeResultHandle(PQXgetResult(conn_));
+  const auto status =
+      handle ? PQresultStatus(handle.get()) : PGRES_EMPTY_QUERY;
+  switch (status) {
+    case PGRES_COPY_IN:
+    case PGRES_COPY_OUT:
+      if ((status == PGRES_COPY_IN) != is_copy_in) {
+        CloseWithError(LogicError{"Unexpected direction of COPY"});
+      }
+      if (!PQbinaryTuples(handle.get())) {
+        CloseWithError(
+            LogicError{"Only the binary format of COPY is supported"});
+      }
+      return;
+    case PGRES_COPY_BOTH:
+      CloseWithError(LogicError{"COPY BOTH is not supported"});
+    default:
+      // Error or not a COPY, the connection is not in the COPY mode
+      ConsumeInput(deadline);
+      while (auto* pg_res = PQXgetResult(conn_)) {
+        PQclear(pg_res);
+        ConsumeInput(deadline);
+      }
+      MakeResult(std::move(handle));
+      throw LogicError{"Statement is not a COPY FROM STDIN / TO STDOUT"};
+  }
+}
+
+void PGConnectionWrapper::PutCopyData(std::string_view data,
+                                      Deadline deadline) {
+  while (true) {
+    const int put_res = PQputCopyData(conn_, data.data(), data.size());
+    if (put_res < 0) {
+      HandleSocketPostClose();
+      throw CommandError(PQerrorMessage(conn_));
+    }
+    // Sending synchronously keeps at most one chunk of data in libpq buffers
+    Flush(deadline);
+    if (put_res > 0) break;
+  }
+}
+
+void PGConnectionWrapper::PutCopyEnd(const char* error_message,
+                                     Deadline deadline) {
+  while (true) {
+    const int put_res = PQputCopyEnd(conn_, error_message);
+    if (put_res < 0) {
+      HandleSocketPostClose();
+      throw CommandError(PQerrorMessage(conn_));
+    }
+    Flush(deadline);
+    if (put_res > 0) break;
+  }
+}
+
+bool PGConnectionWrapper::GetCopyData(std::string& buffer, Deadline deadline) {
+  while (true) {
+    char* data = nullptr;
+    const int get_res = PQgetCopyData(conn_, &data, /*async=*/1);
+    if (get_res > 0) {
+      buffer.append(data, get_res);
+      PQfreemem(data);
+      return true;
+    }
+    if (get_res == -1) return false;
+    if (get_res < -1) {
+      HandleSocketPostClose();
+      throw CommandError(PQerrorMessage(conn_));
+    }
+
+    // No complete CopyData message yet
+    HandleSocketPostClose();
+    if (!WaitSocketReadable(deadline)) {
+      if (engine::current_task::ShouldCancel()) {
+        throw ConnectionInterrupted("Task cancelled while receiving COPY data");
+      }
+      PGCW_LOG_LIMITED_WARNING()
+          << "Timeout while receiving COPY data from PostgreSQL";
+      throw ConnectionTimeoutError("Timed out while receiving COPY data");
+    }
+    CheckError<CommandError>("PQconsumeInput", PQconsumeInput(conn_));
+    UpdateLastUse();
+  }
+}
+
+std::string PGConnectionWrapper::EscapeIdentifier(
+    std::string_view identifier) {
+  std::unique_ptr<char, decltype(&PQfreemem)> escaped{
+      PQescapeIdentifier(conn_, identifier.data(), identifier.size()),
+      &PQfreemem};
+  if (!escaped) {
+    throw LogicError{"Failed to escape identifier '" +
+                     std::string{identifier} +
+                     "': " + PQerrorMessage(conn_)};
+  }
+  return escaped.get();
+}
+
+Notification PGConnectionWrapper::WaitNotify(Deadline deadline) {
+  while (true) {
+    const std::unique_ptr<PGnotify, decltype(&PQfreemem)> notify{
+        PQnotifies(conn_), &PQfreemem};
+    if (notify) {
+      return {notify->relname, notify->extra ? notify->extra : ""};
+    }
+
+    HandleSocketPostClose();
+    if (!WaitSocketReadable(deadline)) {
+      if (engine::current_task::ShouldCancel()) {
+        throw ConnectionInterrupted(
+            "Task cancelled while waiting for a notification");
+      }
+      throw ConnectionTimeoutError("Timed out waiting for a notification");
+    }
+    CheckError<CommandError>("PQconsumeInput", PQconsumeInput(conn_));
+    UpdateLastUse();
+  }
+}
+
+void PGConnectionWrapper::DiscardNotifications() {
+  while (auto* notify = PQnotifies(conn_)) {
+    PQfreemem(notify);
+  }
+}
+
+void PGConnectionWrapper::PipelineSync() {
+#if LIBPQ_HAS_PIPELINING
+  CheckError<CommandError>("PQpipelineSync", PQpipelineSync(conn_));
+#else
+  UINVARIANT(false, "Pipeline mode is not supported");
+#endif
+}
+
+bool PGConnectionWrapper::TryFlush() {
+  const int flush_res = PQflush(conn_);
+  if (flush_res < 0) {
+    HandleSocketPostClose();
+    throw CommandError(PQerrorMessage(conn_));
+  }
+  UpdateLastUse();
+  return flush_res == 0;
+}
+
+std::optional<ResultSet> PGConnectionWrapper::TryGetPipelineResult() {
+#if LIBPQ_HAS_PIPELINING
+  CheckError<CommandError>("PQconsumeInput", PQconsumeInput(conn_));
+  UpdateLastUse();
+
+  bool is_query_end = false;
+  while (!PQXisBusy(conn_)) {
+    auto handle = MakeResultHandle(PQXgetResult(conn_));
+    if (!handle) {
+      if (PQstatus(conn_) == CONNECTION_BAD) {
+        CloseWithError(ConnectionError{"Connection lost in a pipeline"});
+      }
+      // Two NULLs in a row mean that there are no queries in flight
+      if (is_query_end) break;
+      // The end of the results of a query, the sync point follows
+      is_query_end = true;
+      continue;
+    }
+    is_query_end = false;
+
+    switch (PQresultStatus(handle.get())) {
+      case PGRES_PIPELINE_SYNC:
+        // The whole response is consumed, so MakeResult may throw the error
+        // of the query without breaking the pipeline
+        return MakeResult(std::exchange(pipeline_result_, nullptr));
+      case PGRES_PIPELINE_ABORTED:
+        continue;
+      default:
+        pipeline_result_ = std::move(handle);
+    }
+  }
+  return std::nullopt;
+#else
+  UINVARIANT(false, "Pipeline mode is not supported");
+#endif
+}
+
+bool PGConnectionWrapper::WaitReadable(Deadline deadline) {
+  return WaitSocketReadable(deadline);
+}
+
+bool PGConnectionWrapper::WaitWriteable(Deadline deadline) {
+  return WaitSocketWriteable(deadline);
+}
+
 void PGConnectionWrapper::DiscardInput(Deadline deadline) {
   Flush(deadline);
   auto handle = MakeResultHandle(nullptr);
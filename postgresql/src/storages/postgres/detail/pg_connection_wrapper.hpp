@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <optional>
 #include <string_view>
 
 #include <libpq-fe.h>
@@ -103,6 +104,56 @@ class PGConnectionWrapper {
   /// Will return result or throw an exception
   ResultSet WaitResult(Deadline deadline, tracing::ScopeTime&);
 
+  /// @brief Waits for the server to switch to the COPY mode after the COPY
+  /// command is sent
+  /// @param is_copy_in true for COPY FROM STDIN, false for COPY TO STDOUT
+  /// @throws the error of the command, LogicError if the command is not
+  /// a COPY in the binary format in the requested direction
+  void WaitCopyStart(bool is_copy_in, Deadline deadline, tracing::ScopeTime&);
+
+  /// @brief Wrapper for PQputCopyData, waits until the data is sent
+  void PutCopyData(std::string_view data, Deadline deadline);
+
+  /// @brief Wrapper for PQputCopyEnd, aborts the COPY if the error message
+  /// is not null. The result is received with WaitResult.
+  void PutCopyEnd(const char* error_message, Deadline deadline);
+
+  /// @brief Wrapper for PQgetCopyData, appends a received CopyData message
+  /// to the buffer
+  /// @returns false if the COPY is finished, the result is received with
+  /// WaitResult
+  bool GetCopyData(std::string& buffer, Deadline deadline);
+
+  /// @brief Wrapper for PQescapeIdentifier
+  std::string EscapeIdentifier(std::string_view identifier);
+
+  /// @brief Wrapper for PQnotifies, waits for a notification of a channel the
+  /// connection listens to
+  Notification WaitNotify(Deadline deadline);
+
+  /// @brief Discards the received notifications
+  void DiscardNotifications();
+
+  /// @brief Pipeline mode only: ends the last sent query with a sync point, so
+  /// that its failure does not abort the queries sent after it.
+  void PipelineSync();
+
+  /// @brief Sends the buffered commands without waiting.
+  /// @returns false if the socket is not ready to accept the rest of the data
+  bool TryFlush();
+
+  /// @brief Pipeline mode only: consumes the available input without waiting
+  /// and returns the result of the earliest query up to its sync point.
+  /// @returns std::nullopt if the result is not fully received yet
+  /// @throws the error of the query, the connection stays usable
+  std::optional<ResultSet> TryGetPipelineResult();
+
+  /// @return true if wait was successful, false if was awakened by the deadline
+  [[nodiscard]] bool WaitReadable(Deadline deadline);
+
+  /// @return true if wait was successful, false if was awakened by the deadline
+  [[nodiscard]] bool WaitWriteable(Deadline deadline);
+
   /// Consume input from connection
   void ConsumeInput(Deadline deadline);
   /// Consume all input discarding all result sets
@@ -162,6 +213,8 @@ class PGConnectionWrapper {
   std::chrono::steady_clock::time_point last_use_;
   bool is_broken_{false};
   bool is_syncing_pipeline_{false};
+  // Last result of the query that is being received by TryGetPipelineResult
+  ResultHandle pipeline_result_{MakeResultHandle(nullptr)};
 };
 
 }  // namespace storages::postgres::detail
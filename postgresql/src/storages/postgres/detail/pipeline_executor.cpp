@@ -0,0 +1,298 @@
+#include <storages/postgres/detail/pipeline_executor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <mutex>
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/scope_guard.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <storages/postgres/detail/pool.hpp>
+#include <storages/postgres/detail/tracing_tags.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+namespace {
+
+// The reader retries sending of the buffered queries at least this often
+constexpr std::chrono::milliseconds kFlushRetryInterval{1};
+
+}  // namespace
+
+struct PipelineExecutor::Slot {
+  std::optional<ResultSet> result;
+  std::exception_ptr error;
+  engine::SingleConsumerEvent event;
+
+  // Guarded by SharedConnection::mutex
+  bool done{false};
+  bool is_reader{false};
+  bool abandoned{false};
+};
+
+struct PipelineExecutor::SharedConnection {
+  explicit SharedConnection(ConnectionPtr&& conn) : conn(std::move(conn)) {}
+
+  // Waits for the result of the slot, reading the results of the other
+  // queries while the slot has the reader role
+  void Wait(std::unique_lock<engine::Mutex>& lock, Slot& slot,
+            engine::Deadline deadline);
+
+  void Read(std::unique_lock<engine::Mutex>& lock, Slot& slot,
+            engine::Deadline deadline);
+  [[noreturn]] void Abandon(Slot& slot, engine::Deadline deadline);
+  void PassReading();
+
+  void CompleteFront(std::optional<ResultSet>&& result,
+                     std::exception_ptr error);
+  void FailAll(std::exception_ptr error);
+
+  ConnectionPtr conn;
+  engine::Mutex mutex;
+
+  // Guarded by mutex
+  std::deque<std::shared_ptr<Slot>> pending;
+  bool has_reader{false};
+
+  std::atomic<bool> broken{false};
+
+  // Guarded by PipelineExecutor::mutex_
+  std::size_t users{0};
+};
+
+void PipelineExecutor::SharedConnection::Wait(
+    std::unique_lock<engine::Mutex>& lock, Slot& slot,
+    engine::Deadline deadline) {
+  while (!slot.done) {
+    if (slot.is_reader) {
+      Read(lock, slot, deadline);
+      continue;
+    }
+
+    lock.unlock();
+    const bool is_signaled = slot.event.WaitForEventUntil(deadline);
+    lock.lock();
+    if (!is_signaled && !slot.done) Abandon(slot, deadline);
+  }
+}
+
+void PipelineExecutor::SharedConnection::Read(
+    std::unique_lock<engine::Mutex>& lock, Slot& slot,
+    engine::Deadline deadline) {
+  UASSERT(slot.is_reader);
+  bool is_flushed = false;
+  try {
+    is_flushed = conn->TryFlushPipeline();
+    while (!pending.empty()) {
+      std::optional<ResultSet> result;
+      try {
+        result = conn->TryGetPipelinedResult();
+      } catch (const ConnectionError&) {
+        throw;
+      } catch (const std::exception&) {
+        // Error of the earliest query, the rest of the pipeline is intact
+        CompleteFront({}, std::current_exception());
+        continue;
+      }
+      if (!result) break;
+      CompleteFront(std::move(result), {});
+    }
+  } catch (const std::exception&) {
+    FailAll(std::current_exception());
+    return;
+  }
+
+  if (slot.done) {
+    PassReading();
+    return;
+  }
+  if (deadline.IsReached() || engine::current_task::ShouldCancel()) {
+    Abandon(slot, deadline);
+  }
+
+  lock.unlock();
+  // The senders only flush what the socket accepts at once
+  if (is_flushed) {
+    [[maybe_unused]] const auto is_readable = conn->WaitReadable(deadline);
+  } else {
+    [[maybe_unused]] const auto is_writeable =
+        conn->WaitWriteable(std::min(
+            deadline, engine::Deadline::FromDuration(kFlushRetryInterval)));
+  }
+  lock.lock();
+}
+
+void PipelineExecutor::SharedConnection::Abandon(Slot& slot,
+                                                 engine::Deadline deadline) {
+  // The result is skipped by the reader when it arrives
+  slot.abandoned = true;
+  if (slot.is_reader) PassReading();
+
+  if (deadline.IsReached()) {
+    throw ConnectionTimeoutError{"Timed out waiting for a pipelined result"};
+  }
+  throw ConnectionInterrupted{"Task cancelled while waiting for a result"};
+}
+
+void PipelineExecutor::SharedConnection::PassReading() {
+  has_reader = false;
+  for (auto& slot : pending) {
+    slot->is_reader = false;
+  }
+  for (auto& slot : pending) {
+    if (slot->abandoned) continue;
+    slot->is_reader = true;
+    has_reader = true;
+    slot->event.Send();
+    return;
+  }
+  // Results of the abandoned queries are read by the next query or are
+  // discarded with the connection
+}
+
+void PipelineExecutor::SharedConnection::CompleteFront(
+    std::optional<ResultSet>&& result, std::exception_ptr error) {
+  UASSERT(!pending.empty());
+  auto slot = std::move(pending.front());
+  pending.pop_front();
+
+  slot->result = std::move(result);
+  slot->error = std::move(error);
+  slot->done = true;
+  if (!slot->abandoned) slot->event.Send();
+}
+
+void PipelineExecutor::SharedConnection::FailAll(std::exception_ptr error) {
+  broken = true;
+  for (auto& slot : pending) {
+    slot->error = error;
+    slot->done = true;
+    if (!slot->abandoned) slot->event.Send();
+  }
+  pending.clear();
+  has_reader = false;
+}
+
+PipelineExecutor::PipelineExecutor(ConnectionPool& pool) : pool_{pool} {}
+
+PipelineExecutor::~PipelineExecutor() = default;
+
+std::optional<ResultSet> PipelineExecutor::TryExecute(
+    const Query& query, const QueryParameters& params,
+    engine::Deadline deadline, std::size_t max_connections,
+    std::size_t max_depth) {
+  auto shared = Join(deadline, max_connections, max_depth);
+  if (!shared) return std::nullopt;
+  const USERVER_NAMESPACE::utils::ScopeGuard leave_guard(
+      [this, &shared] { Leave(std::move(shared)); });
+
+  std::unique_lock lock{shared->mutex};
+  if (shared->broken) return std::nullopt;
+
+  tracing::Span span{scopes::kQuery};
+  query.FillSpanTags(span);
+  const auto slot = std::make_shared<Slot>();
+
+  try {
+    shared->conn->SendPipelined(query, params, deadline, span);
+  } catch (const ConnectionTimeoutError&) {
+    // Deadline is checked before sending
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  } catch (const std::exception&) {
+    shared->FailAll(std::current_exception());
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  }
+  shared->pending.push_back(slot);
+  try {
+    // The rest is sent by the reader
+    [[maybe_unused]] const auto is_flushed = shared->conn->TryFlushPipeline();
+  } catch (const std::exception&) {
+    shared->FailAll(std::current_exception());
+  }
+  if (!slot->done && !shared->has_reader) {
+    shared->has_reader = true;
+    slot->is_reader = true;
+  }
+
+  try {
+    shared->Wait(lock, *slot, deadline);
+  } catch (const std::exception&) {
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  }
+  if (slot->error) {
+    span.AddTag(tracing::kErrorFlag, true);
+    std::rethrow_exception(slot->error);
+  }
+  return std::move(slot->result);
+}
+
+PipelineExecutor::SharedConnectionPtr PipelineExecutor::Join(
+    engine::Deadline deadline, std::size_t max_connections,
+    std::size_t max_depth) {
+  {
+    std::lock_guard lock{mutex_};
+    SharedConnectionPtr* best = nullptr;
+    for (auto& shared : connections_) {
+      if (shared->broken || shared->users >= max_depth) continue;
+      if (!best || shared->users < (*best)->users) best = &shared;
+    }
+    if (best) {
+      ++(*best)->users;
+      return *best;
+    }
+    if (connections_.size() + acquiring_ >= max_connections) return {};
+    ++acquiring_;
+  }
+
+  const USERVER_NAMESPACE::utils::ScopeGuard acquiring_guard([this] {
+    std::lock_guard lock{mutex_};
+    --acquiring_;
+  });
+  auto conn = pool_.Acquire(deadline);
+  // Pipeline mode is off for the servers that do not support it
+  if (!conn->IsPipelineActive()) return {};
+
+  conn->Start(SteadyClock::now());
+  auto shared = std::make_shared<SharedConnection>(std::move(conn));
+  shared->users = 1;
+
+  std::lock_guard lock{mutex_};
+  connections_.push_back(shared);
+  return shared;
+}
+
+void PipelineExecutor::Leave(SharedConnectionPtr&& shared) {
+  {
+    std::lock_guard lock{mutex_};
+    if (--shared->users != 0) return;
+    connections_.erase(
+        std::find(connections_.begin(), connections_.end(), shared));
+  }
+
+  // Nobody else uses the connection now
+  auto& conn = shared->conn;
+  conn->Finish();
+  if (shared->broken || !shared->pending.empty()) {
+    // The results of the abandoned queries are still in flight
+    conn->MarkAsBroken();
+    conn->Close();
+  }
+  shared.reset();
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/mutex.hpp>
+
+#include <userver/storages/postgres/detail/connection_ptr.hpp>
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+#include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+class ConnectionPool;
+
+/// @brief Executes independent single statements of different coroutines on
+/// a few shared connections in the libpq pipeline mode.
+///
+/// Each query is sent with its own sync point, so an error of a query does
+/// not affect the other queries of the pipeline. The coroutine that sent the
+/// earliest query in flight reads the results of all the queries and wakes up
+/// their owners, then passes the reading to the next waiting owner.
+class PipelineExecutor final {
+ public:
+  explicit PipelineExecutor(ConnectionPool& pool);
+  ~PipelineExecutor();
+
+  /// @returns std::nullopt if the query should be executed on a dedicated
+  /// connection: all the shared connections are full or they are not in the
+  /// pipeline mode.
+  std::optional<ResultSet> TryExecute(const Query& query,
+                                      const QueryParameters& params,
+                                      engine::Deadline deadline,
+                                      std::size_t max_connections,
+                                      std::size_t max_depth);
+
+ private:
+  struct Slot;
+  struct SharedConnection;
+  using SharedConnectionPtr = std::shared_ptr<SharedConnection>;
+
+  SharedConnectionPtr Join(engine::Deadline deadline,
+                           std::size_t max_connections, std::size_t max_depth);
+  void Leave(SharedConnectionPtr&& shared);
+
+  ConnectionPool& pool_;
+  engine::Mutex mutex_;
+  std::vector<SharedConnectionPtr> connections_;
+  std::size_t acquiring_{0};
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,10 @@
 #include <storages/postgres/detail/pool.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+
 #include <storages/postgres/detail/statement_timings_storage.hpp>
 
 #include <userver/engine/async.hpp>
@@ -32,6 +37,14 @@ constexpr std::chrono::seconds kConnectingTimeout{2};
 // Max idle connections that can be dropped in one run of maintenance task
 constexpr auto kIdleDropLimit = 1;
 
+// Weight of the previous value in the recent query latency average
+constexpr std::int64_t kRecentLatencySmoothing = 8;
+
+// Max statements remembered to be prepared on the new connections
+constexpr std::size_t kPreparedRegistrySize = 1000;
+// Max statements prepared on a new connection before it is used
+constexpr std::size_t kMaxWarmUpStatements = 100;
+
 // Practically unlimited number on concurrect establishing connections
 constexpr auto kUnlimitedConnecting = std::numeric_limits<std::size_t>::max();
 
@@ -83,7 +96,10 @@ ConnectionPool::ConnectionPool(
       ei_settings_(std::move(ei_settings)),
       cancel_limit_{std::max(std::size_t{1}, settings.max_size / kCancelRatio),
                     {1, kCancelPeriod}},
-      sts_{statement_metrics_settings} {}
+      sts_{statement_metrics_settings},
+      pipeline_executor_{*this},
+      prepared_registry_{kPreparedRegistrySize},
+      result_cache_{{}} {}
 
 ConnectionPool::~ConnectionPool() {
   StopMaintainTask();
@@ -175,9 +191,37 @@ ConnectionPtr ConnectionPool::Acquire(engine::Deadline deadline) {
   return connection;
 }
 
+std::uint64_t ConnectionPool::GetLoad() const {
+  // Hosts without the latency data yet are tried first
+  const std::uint64_t latency =
+      std::max<std::uint32_t>(stats_.recent_query_latency_us.Load(), 1);
+  return (stats_.connection.used.Load() + 1) * latency;
+}
+
+void ConnectionPool::AccountLeastLoadedSelection() {
+  ++stats_.least_loaded_selected;
+}
+
 void ConnectionPool::AccountConnectionStats(Connection::Statistics conn_stats) {
   auto now = SteadyClock::now();
 
+  if (conn_stats.execute_total > 0) {
+    const std::int64_t query_latency =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            conn_stats.sum_query_duration)
+            .count() /
+        static_cast<std::int64_t>(conn_stats.execute_total);
+    // Exponential moving average, the concurrent updates may be lost
+    const std::int64_t prev_latency = stats_.recent_query_latency_us.Load();
+    const std::int64_t latency =
+        prev_latency ? prev_latency + (query_latency - prev_latency) /
+                                          kRecentLatencySmoothing
+                     : query_latency;
+    stats_.recent_query_latency_us =
+        std::clamp<std::int64_t>(latency, 1,
+                                 std::numeric_limits<std::uint32_t>::max());
+  }
+
   stats_.connection.prepared_statements.GetCurrentCounter().Account(
       conn_stats.prepared_statements_current);
 
@@ -216,17 +260,46 @@ void ConnectionPool::AccountConnectionStats(Connection::Statistics conn_stats) {
           .count());
 }
 
+void ConnectionPool::WarmUpPreparedStatements(Connection& connection) {
+  const auto& conn_settings = connection.GetSettings();
+  if (conn_settings.prepared_statements ==
+      ConnectionSettings::kNoPreparedStatements) {
+    return;
+  }
+  const auto statements = prepared_registry_.GetHottest(
+      std::min(kMaxWarmUpStatements, conn_settings.max_prepared_cache_size));
+  if (statements.empty()) return;
+
+  try {
+    stats_.transaction.warmup_parse_total +=
+        connection.PrepareStatements(statements);
+  } catch (const std::exception& e) {
+    LOG_LIMITED_WARNING() << "Failed to prepare statements on a new "
+                             "connection: "
+                          << e;
+  }
+  // The statements are already accounted by the connections they were
+  // prepared on
+  [[maybe_unused]] const auto prepared = connection.TakeNewPreparedStatements();
+}
+
 void ConnectionPool::Release(Connection* connection) {
   UASSERT(connection);
   using DecGuard = USERVER_NAMESPACE::utils::SizeGuard<
       USERVER_NAMESPACE::utils::statistics::RelaxedCounter<uint32_t>>;
   DecGuard dg{stats_.connection.used, DecGuard::DontIncrement{}};
 
+  prepared_registry_.Account(connection->TakeNewPreparedStatements());
+
   // Grab stats only if connection is not in transaction
   if (!connection->IsInTransaction()) {
     AccountConnectionStats(connection->GetStatsAndReset());
   }
 
+  if (connection->TakeFailoverSignal() || !connection->IsConnected()) {
+    NotifyFailover();
+  }
+
   if (connection->IsIdle()) {
     Push(connection);
     return;
@@ -318,6 +391,49 @@ NonTransaction ConnectionPool::Start(OptionalCommandControl cmd_ctl) {
   return NonTransaction{std::move(conn), start_time};
 }
 
+NotifyScope ConnectionPool::Listen(std::string_view channel,
+                                   OptionalCommandControl cmd_ctl) {
+  const auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(GetExecuteTimeout(cmd_ctl));
+  auto conn = Acquire(deadline);
+  UASSERT(conn);
+  return NotifyScope{std::move(conn), channel, std::move(cmd_ctl)};
+}
+
+ResultSet ConnectionPool::Execute(OptionalCommandControl cmd_ctl,
+                                  const Query& query,
+                                  const ParameterStore& store) {
+  const auto& name = query.GetName();
+  const auto ttl = name ? result_cache_.GetTtl(name->GetUnderlying())
+                        : std::nullopt;
+  if (!ttl) return ExecuteUncached(cmd_ctl, query, store);
+
+  const auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(GetExecuteTimeout(cmd_ctl));
+  return result_cache_.GetOrFetch(
+      name->GetUnderlying(), *ttl, QueryParameters{store.GetInternalData()},
+      deadline, [&] { return ExecuteUncached(cmd_ctl, query, store); });
+}
+
+ResultSet ConnectionPool::ExecuteUncached(OptionalCommandControl cmd_ctl,
+                                          const Query& query,
+                                          const ParameterStore& store) {
+  const auto settings = settings_.Read();
+  const auto conn_settings = conn_settings_.Read();
+  if (settings->batching_connections &&
+      conn_settings->pipeline_mode == PipelineMode::kEnabled) {
+    const auto deadline =
+        testsuite_pg_ctl_.MakeExecuteDeadline(GetExecuteTimeout(cmd_ctl));
+    auto res = pipeline_executor_.TryExecute(
+        query, QueryParameters{store.GetInternalData()}, deadline,
+        settings->batching_connections, settings->batching_max_depth);
+    if (res) return std::move(*res);
+  }
+
+  auto ntrx = Start(cmd_ctl);
+  return ntrx.Execute(cmd_ctl, query.Statement(), store);
+}
+
 TimeoutDuration ConnectionPool::GetExecuteTimeout(
     OptionalCommandControl cmd_ctl) const {
   if (cmd_ctl) return cmd_ctl->execute;
@@ -354,6 +470,15 @@ void ConnectionPool::SetStatementMetricsSettings(
   sts_.SetSettings(settings);
 }
 
+void ConnectionPool::SetStatementResultCacheSettings(
+    const StatementResultCacheSettings& settings) {
+  result_cache_.SetSettings(settings);
+}
+
+void ConnectionPool::SetFailoverCallback(std::function<void()> callback) {
+  failover_callback_.Assign(std::move(callback));
+}
+
 engine::TaskWithResult<bool> ConnectionPool::Connect(
     SharedSizeGuard&& size_guard) {
   return engine::AsyncNoSpan([shared_this = shared_from_this(),
@@ -397,6 +522,13 @@ engine::TaskWithResult<bool> ConnectionPool::Connect(
     }
     LOG_TRACE() << "PostgreSQL connection created";
 
+    shared_this->WarmUpPreparedStatements(*connection);
+    if (!connection->IsIdle()) {
+      ++shared_this->stats_.connection.error_total;
+      shared_this->DeleteConnection(connection.release());
+      return false;
+    }
+
     // Clean up the statistics and not account it
     [[maybe_unused]] const auto& stats = connection->GetStatsAndReset();
 
@@ -438,7 +570,13 @@ void ConnectionPool::Push(Connection* connection) {
   if (connection->GetSettings().version < conn_settings->version) {
     DropOutdatedConnection(connection);
   } else if (queue_.push(connection)) {
-    conn_available_.NotifyOne();
+    // Pairs with the fence in Pop, either the waiter sees the connection or
+    // the connection is handed to the waiter here
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_count_.load(std::memory_order_relaxed) > 0) {
+      std::lock_guard lock{wait_mutex_};
+      ServeWaiters();
+    }
   } else {
     // TODO Reflect this as a statistics error
     LOG_LIMITED_WARNING()
@@ -459,7 +597,9 @@ Connection* ConnectionPool::Pop(engine::Deadline deadline) {
   Stopwatch st{stats_.acquire_percentile};
   Connection* connection = nullptr;
   auto conn_settings = conn_settings_.Read();
-  while (queue_.pop(connection)) {
+  // The waiters are served first
+  while (waiters_count_.load(std::memory_order_relaxed) == 0 &&
+         queue_.pop(connection)) {
     if (connection->GetSettings().version < conn_settings->version) {
       DropOutdatedConnection(connection);
       continue;
@@ -480,13 +620,42 @@ Connection* ConnectionPool::Pop(engine::Deadline deadline) {
               << "ms";
   TryCreateConnectionAsync();
 
+  const auto wait_start = SteadyClock::now();
+  Waiter waiter{deadline};
   {
-    std::unique_lock<engine::Mutex> lock{wait_mutex_};
-    // Wait for a connection
-    if (conn_available_.WaitUntil(lock, deadline,
-                                  [&] { return queue_.pop(connection); })) {
-      return connection;
+    std::lock_guard lock{wait_mutex_};
+    waiter.seq = ++waiter_seq_;
+    waiters_.insert(&waiter);
+    waiters_count_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    ServeWaiters();
+  }
+  [[maybe_unused]] const auto is_signaled =
+      waiter.event.WaitForEventUntil(deadline);
+  {
+    std::lock_guard lock{wait_mutex_};
+    if (!waiter.done) {
+      waiters_.erase(&waiter);
+      waiters_count_.fetch_sub(1, std::memory_order_relaxed);
     }
+    connection = waiter.connection;
+  }
+
+  if (connection) {
+    const auto wait_time = SteadyClock::now() - wait_start;
+    stats_.queue_wait_percentile.GetCurrentCounter().Account(
+        std::chrono::duration_cast<std::chrono::milliseconds>(wait_time)
+            .count());
+    // Waiting longer than a query takes means the pool is too small
+    if (wait_time > std::chrono::microseconds{
+                        stats_.recent_query_latency_us.Load()}) {
+      TryCreateConnectionAsync();
+    }
+    return connection;
+  }
+  if (waiter.done) {
+    ++stats_.queue_deadline_errors;
+    throw PoolError("Not enough time left to wait for a connection", db_name_);
   }
 
   if (engine::current_task::ShouldCancel()) {
@@ -497,6 +666,25 @@ Connection* ConnectionPool::Pop(engine::Deadline deadline) {
   throw PoolError("No available connections found", db_name_);
 }
 
+void ConnectionPool::ServeWaiters() {
+  // The waiters that would most likely time out in the middle of a query
+  const std::chrono::microseconds min_time_left{
+      stats_.recent_query_latency_us.Load()};
+
+  while (!waiters_.empty()) {
+    auto* waiter = *waiters_.begin();
+    if (waiter->deadline.TimeLeft() >= min_time_left) {
+      Connection* connection = nullptr;
+      if (!queue_.pop(connection)) return;
+      waiter->connection = connection;
+    }
+    waiters_.erase(waiters_.begin());
+    waiters_count_.fetch_sub(1, std::memory_order_relaxed);
+    waiter->done = true;
+    waiter->event.Send();
+  }
+}
+
 void ConnectionPool::Clear() {
   Connection* connection = nullptr;
   while (queue_.pop(connection)) {
@@ -515,6 +703,11 @@ void ConnectionPool::DeleteBrokenConnection(Connection* connection) {
   DeleteConnection(connection);
 }
 
+void ConnectionPool::NotifyFailover() {
+  const auto callback = failover_callback_.Read();
+  if (*callback) (*callback)();
+}
+
 void ConnectionPool::DropOutdatedConnection(Connection* connection) {
   LOG_LIMITED_WARNING() << "Dropping connection with outdated settings";
   DeleteConnection(connection);
@@ -1,14 +1,17 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <set>
 #include <vector>
 
 #include <boost/lockfree/queue.hpp>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
-#include <userver/engine/condition_variable.hpp>
 #include <userver/engine/semaphore.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/engine/task/task_with_result.hpp>
 #include <userver/error_injection/settings.hpp>
@@ -21,12 +24,16 @@
 #include <storages/postgres/default_command_controls.hpp>
 #include <userver/storages/postgres/detail/connection_ptr.hpp>
 #include <userver/storages/postgres/detail/non_transaction.hpp>
+#include <userver/storages/postgres/notify.hpp>
 #include <userver/storages/postgres/options.hpp>
 #include <userver/storages/postgres/statistics.hpp>
 #include <userver/storages/postgres/transaction.hpp>
 
 #include <storages/postgres/detail/connection.hpp>
 #include <storages/postgres/detail/pg_impl_types.hpp>
+#include <storages/postgres/detail/pipeline_executor.hpp>
+#include <storages/postgres/detail/prepared_statements_registry.hpp>
+#include <storages/postgres/detail/statement_result_cache.hpp>
 #include <storages/postgres/detail/statement_timings_storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -62,11 +69,27 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   void Release(Connection* connection);
 
   const InstanceStatistics& GetStatistics() const;
+
+  /// Expected load of the host for the kLeastLoaded host selection: the
+  /// number of connections in use weighted by the recent query latency
+  std::uint64_t GetLoad() const;
+  void AccountLeastLoadedSelection();
+
   [[nodiscard]] Transaction Begin(const TransactionOptions& options,
                                   OptionalCommandControl trx_cmd_ctl = {});
 
   [[nodiscard]] NonTransaction Start(OptionalCommandControl cmd_ctl = {});
 
+  /// Subscribes to the notifications of the channel on a dedicated connection
+  [[nodiscard]] NotifyScope Listen(std::string_view channel,
+                                   OptionalCommandControl cmd_ctl = {});
+
+  /// Executes a single statement, on a connection that is shared with the
+  /// statements of other coroutines if the batching is enabled. The results
+  /// of the statements of the result cache settings are cached.
+  ResultSet Execute(OptionalCommandControl cmd_ctl, const Query& query,
+                    const ParameterStore& store);
+
   CommandControl GetDefaultCommandControl() const;
 
   void SetSettings(const PoolSettings& settings);
@@ -75,19 +98,56 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
 
   void SetStatementMetricsSettings(const StatementMetricsSettings& settings);
 
+  void SetStatementResultCacheSettings(
+      const StatementResultCacheSettings& settings);
+
+  /// Sets the function called when a released connection is lost or got an
+  /// error typical for a failover, the function must be cheap and may be
+  /// called concurrently
+  void SetFailoverCallback(std::function<void()> callback);
+
   const detail::StatementTimingsStorage& GetStatementTimingsStorage() const {
     return sts_;
   }
 
+  const StatementResultCache& GetStatementResultCache() const {
+    return result_cache_;
+  }
+
  private:
   using SizeGuard = USERVER_NAMESPACE::utils::SizeGuard<std::atomic<size_t>>;
   using SharedCounter = std::shared_ptr<std::atomic<size_t>>;
   using SharedSizeGuard = USERVER_NAMESPACE::utils::SizeGuard<SharedCounter>;
 
+  /// A coroutine waiting for a connection
+  struct Waiter {
+    explicit Waiter(engine::Deadline deadline) : deadline(deadline) {}
+
+    engine::Deadline deadline;
+    std::uint64_t seq{0};
+    engine::SingleConsumerEvent event;
+
+    // Guarded by wait_mutex_
+    Connection* connection{nullptr};
+    bool done{false};
+  };
+
+  /// The earliest deadline first, in the order of arrival for equal deadlines
+  struct WaiterLess {
+    bool operator()(const Waiter* lhs, const Waiter* rhs) const {
+      if (lhs->deadline < rhs->deadline) return true;
+      if (rhs->deadline < lhs->deadline) return false;
+      return lhs->seq < rhs->seq;
+    }
+  };
+
   void Init(InitMode mode);
 
   TimeoutDuration GetExecuteTimeout(OptionalCommandControl) const;
 
+  ResultSet ExecuteUncached(OptionalCommandControl cmd_ctl, const Query& query,
+                            const ParameterStore& store);
+
   [[nodiscard]] engine::TaskWithResult<bool> Connect(SharedSizeGuard&&);
 
   void TryCreateConnectionAsync();
@@ -95,14 +155,19 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
 
   void Push(Connection* connection);
   Connection* Pop(engine::Deadline);
+  /// Hands the idle connections to the waiters and rejects the waiters that
+  /// have no time left for a query, requires wait_mutex_ to be locked
+  void ServeWaiters();
 
   void Clear();
 
   void DeleteConnection(Connection* connection);
   void DeleteBrokenConnection(Connection* connection);
   void DropOutdatedConnection(Connection* connection);
+  void NotifyFailover();
 
   void AccountConnectionStats(Connection::Statistics stats);
+  void WarmUpPreparedStatements(Connection& connection);
 
   Connection* AcquireImmediate();
   void MaintainConnections();
@@ -121,7 +186,10 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   engine::TaskProcessor& bg_task_processor_;
   USERVER_NAMESPACE::utils::PeriodicTask ping_task_;
   engine::Mutex wait_mutex_;
-  engine::ConditionVariable conn_available_;
+  // Guarded by wait_mutex_
+  std::set<Waiter*, WaiterLess> waiters_;
+  std::uint64_t waiter_seq_{0};
+  std::atomic<std::size_t> waiters_count_{0};
   boost::lockfree::queue<Connection*> queue_;
   SharedCounter size_;
   engine::Semaphore connecting_semaphore_;
@@ -132,6 +200,10 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   RecentCounter recent_conn_errors_;
   USERVER_NAMESPACE::utils::TokenBucket cancel_limit_;
   detail::StatementTimingsStorage sts_;
+  PipelineExecutor pipeline_executor_;
+  PreparedStatementsRegistry prepared_registry_;
+  StatementResultCache result_cache_;
+  rcu::Variable<std::function<void()>> failover_callback_;
 };
 
 }  // namespace storages::postgres::detail
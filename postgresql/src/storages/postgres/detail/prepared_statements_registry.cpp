@@ -0,0 +1,54 @@
+#include <storages/postgres/detail/prepared_statements_registry.hpp>
+
+#include <algorithm>
+#include <utility>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+PreparedStatementsRegistry::PreparedStatementsRegistry(std::size_t max_size)
+    : storage_{max_size} {}
+
+void PreparedStatementsRegistry::Account(
+    std::vector<StatementDescription>&& statements) {
+  if (statements.empty()) return;
+
+  auto storage = storage_.Lock();
+  for (auto& description : statements) {
+    const auto id = description.id.GetUnderlying();
+    auto* entry = storage->Get(id);
+    if (!entry) {
+      storage->Put(id, {std::move(description), 0});
+      entry = storage->Get(id);
+    }
+    ++entry->prepare_count;
+  }
+}
+
+std::vector<PreparedStatementsRegistry::StatementDescription>
+PreparedStatementsRegistry::GetHottest(std::size_t count) const {
+  std::vector<const Entry*> entries;
+  std::vector<StatementDescription> result;
+
+  auto storage = storage_.Lock();
+  entries.reserve(storage->GetSize());
+  storage->VisitAll([&entries](const std::size_t&, const Entry& entry) {
+    entries.push_back(&entry);
+  });
+  count = std::min(count, entries.size());
+  std::partial_sort(entries.begin(), entries.begin() + count, entries.end(),
+                    [](const Entry* lhs, const Entry* rhs) {
+                      return lhs->prepare_count > rhs->prepare_count;
+                    });
+
+  result.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    result.push_back(entries[i]->description);
+  }
+  return result;
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
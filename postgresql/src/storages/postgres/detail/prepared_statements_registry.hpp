@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/concurrent/variable.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// @brief Statements prepared on the connections of a pool.
+///
+/// The statements prepared on the most connections are prepared on the new
+/// connections before they are used, so that the first queries on a new
+/// connection do not pay for the parse roundtrip.
+class PreparedStatementsRegistry final {
+ public:
+  using StatementDescription = Connection::PreparedStatementDescription;
+
+  explicit PreparedStatementsRegistry(std::size_t max_size);
+
+  /// Counts the statements prepared on a connection
+  void Account(std::vector<StatementDescription>&& statements);
+
+  /// @returns at most `count` statements, the most often prepared first
+  std::vector<StatementDescription> GetHottest(std::size_t count) const;
+
+ private:
+  struct Entry {
+    StatementDescription description;
+    std::size_t prepare_count{0};
+  };
+
+  using Storage = USERVER_NAMESPACE::cache::LruMap<std::size_t, Entry>;
+
+  USERVER_NAMESPACE::concurrent::Variable<Storage> storage_;
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
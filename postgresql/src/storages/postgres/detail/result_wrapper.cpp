@@ -104,6 +104,24 @@ void ResultWrapper::FillBufferCategories(const UserTypes& types) {
 
     AddTypeBufferCategories(data_type, types, buffer_categories_, context);
   }
+  FillColumnDescriptions();
+}
+
+void ResultWrapper::SetTypeBufferCategories(
+    const io::TypeBufferCategory& cats) {
+  buffer_categories_ = cats;
+  FillColumnDescriptions();
+}
+
+void ResultWrapper::FillColumnDescriptions() {
+  const auto n_fields = FieldCount();
+  columns_.clear();
+  columns_.reserve(n_fields);
+  for (std::size_t f_no = 0; f_no < n_fields; ++f_no) {
+    columns_.push_back(
+        {GetFieldBufferCategory(f_no),
+         PQfformat(handle_.get(), f_no) == io::kPgBinaryDataFormat});
+  }
 }
 
 ExecStatusType ResultWrapper::GetStatus() const {
@@ -188,6 +206,13 @@ std::size_t ResultWrapper::GetFieldLength(std::size_t row,
 
 io::FieldBuffer ResultWrapper::GetFieldBuffer(std::size_t row,
                                               std::size_t col) const {
+  if (col < columns_.size() && columns_[col].is_binary) {
+    return io::FieldBuffer{IsFieldNull(row, col), columns_[col].category,
+                           GetFieldLength(row, col),
+                           reinterpret_cast<const std::uint8_t*>(
+                               PQgetvalue(handle_.get(), row, col))};
+  }
+
   if (PQfformat(handle_.get(), col) != io::kPgBinaryDataFormat) {
     throw ResultSetError{
         fmt::format("Column with index {} has text format\n", col) +
@@ -3,6 +3,7 @@
 #include <libpq-fe.h>
 #include <memory>
 #include <string_view>
+#include <vector>
 
 #include <userver/storages/postgres/postgres_fwd.hpp>
 
@@ -33,9 +34,7 @@ class ResultWrapper {
   const io::TypeBufferCategory& GetTypeBufferCategories() const {
     return buffer_categories_;
   }
-  void SetTypeBufferCategories(const io::TypeBufferCategory& cats) {
-    buffer_categories_ = cats;
-  }
+  void SetTypeBufferCategories(const io::TypeBufferCategory& cats);
   std::string CommandStatus() const;
   std::size_t RowsAffected() const;
 
@@ -74,6 +73,17 @@ class ResultWrapper {
 
   ResultHandle handle_;
   io::TypeBufferCategory buffer_categories_;
+
+ private:
+  struct ColumnDescription {
+    io::BufferCategory category;
+    bool is_binary;
+  };
+
+  void FillColumnDescriptions();
+
+  // Per column data of the field buffers, computed once per result
+  std::vector<ColumnDescription> columns_;
 };
 
 inline ResultWrapper::ResultHandle MakeResultHandle(PGresult* pg_res) {
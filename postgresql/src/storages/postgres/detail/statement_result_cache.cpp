@@ -0,0 +1,126 @@
+#include <storages/postgres/detail/statement_result_cache.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+
+#include <userver/storages/postgres/exceptions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+namespace {
+
+std::size_t GetMaxSize(const StatementResultCacheSettings& settings) {
+  return std::max(settings.max_size, std::size_t{1});
+}
+
+template <typename T>
+void AppendValue(std::string& key, const T& value) {
+  key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+}  // namespace
+
+StatementResultCache::StatementResultCache(
+    const StatementResultCacheSettings& settings)
+    : settings_{settings}, entries_{GetMaxSize(settings)} {}
+
+std::optional<std::chrono::milliseconds> StatementResultCache::GetTtl(
+    const std::string& statement_name) const {
+  const auto settings = settings_.Read();
+  const auto it = settings->ttl_by_query.find(statement_name);
+  if (it == settings->ttl_by_query.end()) return std::nullopt;
+  return it->second;
+}
+
+ResultSet StatementResultCache::GetOrFetch(const std::string& statement_name,
+                                           std::chrono::milliseconds ttl,
+                                           const QueryParameters& params,
+                                           engine::Deadline deadline,
+                                           const Fetcher& fetch) {
+  const auto key = MakeKey(statement_name, params);
+
+  std::unique_lock lock{mutex_};
+  while (true) {
+    auto* entry = entries_.Get(key);
+    if (!entry) break;
+    if (entry->result && entry->expires_at > SteadyClock::now()) {
+      ++stats_[statement_name].hits;
+      return *entry->result;
+    }
+    if (!entry->in_flight) break;
+
+    if (fetched_cv_.WaitUntil(lock, deadline) == engine::CvStatus::kTimeout) {
+      throw ConnectionTimeoutError{
+          "Timed out waiting for the result of a concurrent execution"};
+    }
+  }
+
+  ++stats_[statement_name].misses;
+  entries_.Put(key, Entry{std::nullopt, {}, true});
+  lock.unlock();
+
+  std::optional<ResultSet> result;
+  try {
+    result.emplace(fetch());
+  } catch (const std::exception&) {
+    lock.lock();
+    // The waiters run the query themselves
+    entries_.Erase(key);
+    fetched_cv_.NotifyAll();
+    throw;
+  }
+
+  lock.lock();
+  entries_.Put(key, Entry{result, SteadyClock::now() + ttl, false});
+  fetched_cv_.NotifyAll();
+  return std::move(*result);
+}
+
+std::unordered_map<std::string, StatementResultCacheStatistics>
+StatementResultCache::GetStatistics() const {
+  std::lock_guard lock{mutex_};
+  return stats_;
+}
+
+void StatementResultCache::SetSettings(
+    const StatementResultCacheSettings& settings) {
+  const auto settings_ptr = settings_.Read();
+  if (*settings_ptr == settings) return;
+
+  {
+    std::lock_guard lock{mutex_};
+    entries_.SetMaxSize(GetMaxSize(settings));
+    // The results of the statements that are not cached any more are evicted
+    // on their own, the statistics of such statements are dropped
+    for (auto it = stats_.begin(); it != stats_.end();) {
+      if (settings.ttl_by_query.count(it->first)) {
+        ++it;
+      } else {
+        it = stats_.erase(it);
+      }
+    }
+  }
+  settings_.Assign(settings);
+}
+
+std::string StatementResultCache::MakeKey(const std::string& statement_name,
+                                          const QueryParameters& params) {
+  std::string key = statement_name;
+  key.push_back('\0');
+  for (std::size_t i = 0; i < params.Size(); ++i) {
+    AppendValue(key, params.ParamTypesBuffer()[i]);
+    const auto length = params.ParamLengthsBuffer()[i];
+    AppendValue(key, length);
+    if (params.ParamBuffers()[i] && length > 0) {
+      key.append(params.ParamBuffers()[i], length);
+    }
+  }
+  return key;
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
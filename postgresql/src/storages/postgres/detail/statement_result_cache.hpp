@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/rcu/rcu.hpp>
+
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+#include <userver/storages/postgres/detail/time_types.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+#include <userver/storages/postgres/statistics.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// @brief Client-side cache of the results of the named statements of a host.
+///
+/// The results are shared handles of the immutable result sets. Only the
+/// first of the concurrent executions of a statement with the same parameters
+/// runs the query, the rest wait for its result.
+class StatementResultCache final {
+ public:
+  using Fetcher = std::function<ResultSet()>;
+
+  explicit StatementResultCache(const StatementResultCacheSettings& settings);
+
+  /// @returns the time to live of the results of the statement, std::nullopt
+  /// if the results of the statement are not cached
+  std::optional<std::chrono::milliseconds> GetTtl(
+      const std::string& statement_name) const;
+
+  /// Returns the cached result or the result of `fetch`, waits for the
+  /// result of a concurrent execution of the statement if there is one
+  /// @throws ConnectionTimeoutError if the deadline is reached while waiting
+  ResultSet GetOrFetch(const std::string& statement_name,
+                       std::chrono::milliseconds ttl,
+                       const QueryParameters& params, engine::Deadline deadline,
+                       const Fetcher& fetch);
+
+  std::unordered_map<std::string, StatementResultCacheStatistics>
+  GetStatistics() const;
+
+  void SetSettings(const StatementResultCacheSettings& settings);
+
+ private:
+  struct Entry {
+    std::optional<ResultSet> result;
+    SteadyClock::time_point expires_at;
+    bool in_flight{false};
+  };
+
+  static std::string MakeKey(const std::string& statement_name,
+                             const QueryParameters& params);
+
+  rcu::Variable<StatementResultCacheSettings> settings_;
+
+  mutable engine::Mutex mutex_;
+  engine::ConditionVariable fetched_cv_;
+  // Guarded by mutex_
+  USERVER_NAMESPACE::cache::LruMap<std::string, Entry> entries_;
+  std::unordered_map<std::string, StatementResultCacheStatistics> stats_;
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
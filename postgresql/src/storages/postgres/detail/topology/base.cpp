@@ -39,6 +39,14 @@ const testsuite::PostgresControl& TopologyBase::GetTestsuiteControl() const {
   return testsuite_pg_ctl_;
 }
 
+std::function<void()> TopologyBase::GetRediscoveryTrigger() const {
+  return {};
+}
+
+ClusterTopologyStatistics TopologyBase::GetTopologyStatistics() const {
+  return {};
+}
+
 std::unique_ptr<Connection> TopologyBase::MakeTopologyConnection(DsnIndex idx) {
   UASSERT(idx < dsns_.size());
   return Connection::Connect(dsns_[idx], resolver_, bg_task_processor_,
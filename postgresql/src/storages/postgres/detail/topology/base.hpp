@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -50,6 +51,15 @@ class TopologyBase {
   virtual const std::vector<decltype(InstanceStatistics::topology)>&
   GetDsnStatistics() const = 0;
 
+  /// Returns a function requesting an out-of-schedule topology check, e.g.
+  /// after an error typical for a failover. The function may be called
+  /// concurrently and may outlive the topology. Empty if the topology has
+  /// nothing to rediscover.
+  virtual std::function<void()> GetRediscoveryTrigger() const;
+
+  /// Returns statistics of the topology discovery
+  virtual ClusterTopologyStatistics GetTopologyStatistics() const;
+
  protected:
   std::unique_ptr<Connection> MakeTopologyConnection(DsnIndex);
 
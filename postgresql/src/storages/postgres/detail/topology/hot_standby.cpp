@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -15,6 +17,8 @@
 #include <storages/postgres/internal_pg_types.hpp>
 #include <storages/postgres/io/pg_type_parsers.hpp>
 #include <userver/engine/deadline.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/engine/task/task_with_result.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
@@ -32,6 +36,13 @@ namespace {
 constexpr auto kCheckTimeout = std::chrono::seconds{1};
 constexpr auto kDiscoveryInterval = std::chrono::seconds{1};
 
+// Out-of-schedule checks after failover errors: the hosts that do not reply
+// quickly are skipped until the next check, the checks repeat with a short
+// interval until a writable master shows up
+constexpr std::chrono::milliseconds kTriggeredCheckTimeout{300};
+constexpr std::chrono::milliseconds kTriggeredCheckInterval{100};
+constexpr std::size_t kMaxTriggeredChecks = 20;
+
 using Rtt = std::chrono::microseconds;
 constexpr Rtt kUnknownRtt{-1};
 
@@ -39,6 +50,10 @@ using ReplicationLag = std::chrono::milliseconds;
 
 constexpr const char* kDiscoveryTaskName = "pg_topology";
 
+std::int64_t NowTicks() {
+  return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
 const std::string kShowSyncStandbyNames = "SHOW synchronous_standby_names";
 
 struct WalInfoStatements {
@@ -130,6 +145,18 @@ struct HotStandby::HostState {
   std::vector<std::string> detected_sync_slaves;
 };
 
+struct HotStandby::RediscoveryRequest {
+  void Send() {
+    std::int64_t expected = 0;
+    first_error_ticks.compare_exchange_strong(expected, NowTicks());
+    event.Send();
+  }
+
+  engine::SingleConsumerEvent event;
+  // Time of the first failover error since the latest found master, 0 if none
+  std::atomic<std::int64_t> first_error_ticks{0};
+};
+
 HotStandby::HotStandby(engine::TaskProcessor& bg_task_processor, DsnList dsns,
                        clients::dns::Resolver* resolver,
                        const TopologySettings& topology_settings,
@@ -141,18 +168,24 @@ HotStandby::HotStandby(engine::TaskProcessor& bg_task_processor, DsnList dsns,
                    topology_settings, conn_settings, default_cmd_ctls,
                    testsuite_pg_ctl, std::move(ei_settings)),
       host_states_{GetDsnList().begin(), GetDsnList().end()},
-      dsn_stats_(GetDsnList().size()) {
+      dsn_stats_(GetDsnList().size()),
+      rediscovery_request_(std::make_shared<RediscoveryRequest>()) {
   crypto::impl::Openssl::Init();
-  RunDiscovery();
+  RunDiscovery(kCheckTimeout);
 
   discovery_task_.Start(
       kDiscoveryTaskName,
       {kDiscoveryInterval,
        {USERVER_NAMESPACE::utils::PeriodicTask::Flags::kStrong}},
-      [this] { RunDiscovery(); });
+      [this] { RunDiscovery(kCheckTimeout); });
+  rediscovery_task_ =
+      engine::CriticalAsyncNoSpan([this] { RunTriggeredDiscovery(); });
 }
 
-HotStandby::~HotStandby() { discovery_task_.Stop(); }
+HotStandby::~HotStandby() {
+  rediscovery_task_.SyncCancel();
+  discovery_task_.Stop();
+}
 
 rcu::ReadablePtr<TopologyBase::DsnIndicesByType>
 HotStandby::GetDsnIndicesByType() const {
@@ -169,11 +202,68 @@ HotStandby::GetDsnStatistics() const {
   return dsn_stats_;
 }
 
-void HotStandby::RunDiscovery() {
+std::function<void()> HotStandby::GetRediscoveryTrigger() const {
+  return [weak_request = std::weak_ptr{rediscovery_request_}] {
+    if (const auto request = weak_request.lock()) request->Send();
+  };
+}
+
+ClusterTopologyStatistics HotStandby::GetTopologyStatistics() const {
+  ClusterTopologyStatistics stats;
+  stats.triggered_checks = triggered_checks_.Load();
+  stats.master_changes = master_changes_.Load();
+  stats.last_master_change_detection_time =
+      std::chrono::milliseconds{last_detection_time_ms_.load()};
+  return stats;
+}
+
+void HotStandby::RunTriggeredDiscovery() {
+  while (rediscovery_request_->event.WaitForEvent()) {
+    try {
+      for (std::size_t i = 0; i < kMaxTriggeredChecks; ++i) {
+        ++triggered_checks_;
+        if (RunDiscovery(kTriggeredCheckTimeout)) break;
+        engine::InterruptibleSleepFor(kTriggeredCheckInterval);
+      }
+    } catch (const std::exception& e) {
+      LOG_WARNING() << "Triggered topology discovery failed: " << e;
+    }
+    // Errors of the requests that were in flight during the check should not
+    // start another one right away
+    engine::InterruptibleSleepFor(kTriggeredCheckInterval);
+  }
+}
+
+void HotStandby::AccountMaster(std::optional<DsnIndex> master_idx) {
+  if (!master_idx) return;
+
+  const auto first_error_ticks =
+      rediscovery_request_->first_error_ticks.exchange(0);
+  if (last_master_idx_ && *last_master_idx_ != *master_idx) {
+    ++master_changes_;
+    const auto detection_time =
+        first_error_ticks
+            ? std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::duration{NowTicks() -
+                                                      first_error_ticks})
+            : std::chrono::milliseconds::zero();
+    last_detection_time_ms_ = detection_time.count();
+    LOG_WARNING() << "Master changed from "
+                  << host_states_[*last_master_idx_].app_name << " to "
+                  << host_states_[*master_idx].app_name << ", detected in "
+                  << detection_time.count() << " ms after the first error";
+  }
+  last_master_idx_ = master_idx;
+}
+
+bool HotStandby::RunDiscovery(std::chrono::milliseconds check_timeout) {
+  std::lock_guard lock{discovery_mutex_};
+
   std::vector<engine::TaskWithResult<void>> tasks;
   tasks.reserve(GetDsnList().size());
   for (DsnIndex i = 0; i < GetDsnList().size(); ++i) {
-    tasks.emplace_back(engine::AsyncNoSpan([this, i] { RunCheck(i); }));
+    tasks.emplace_back(engine::AsyncNoSpan(
+        [this, i, check_timeout] { RunCheck(i, check_timeout); }));
   }
   for (auto& task : tasks) task.Get();
 
@@ -255,7 +345,10 @@ void HotStandby::RunDiscovery() {
                        "insufficient disk space";
     }
     master->role = ClusterHostType::kSlave;
+    master = nullptr;
   }
+  std::optional<DsnIndex> master_idx;
+  if (master) master_idx = master - host_states_.data();
 
   DsnIndices alive_dsn_indices;
   for (DsnIndex i = 0; i < GetDsnList().size(); ++i) {
@@ -282,9 +375,13 @@ void HotStandby::RunDiscovery() {
   }
   dsn_indices_by_type_.Assign(std::move(dsn_indices_by_type));
   alive_dsn_indices_.Assign(std::move(alive_dsn_indices));
+
+  AccountMaster(master_idx);
+  return master_idx.has_value();
 }
 
-void HotStandby::RunCheck(DsnIndex idx) {
+void HotStandby::RunCheck(DsnIndex idx,
+                          std::chrono::milliseconds check_timeout) {
   UASSERT(idx < GetDsnList().size());
   const auto& dsn = GetDsnList()[idx];
   auto& state = host_states_[idx];
@@ -301,7 +398,7 @@ void HotStandby::RunCheck(DsnIndex idx) {
       return;
     }
   }
-  auto deadline = GetTestsuiteControl().MakeExecuteDeadline(kCheckTimeout);
+  auto deadline = GetTestsuiteControl().MakeExecuteDeadline(check_timeout);
   auto start = std::chrono::steady_clock::now();
   try {
     state.connection->RefreshReplicaState(deadline);
@@ -1,13 +1,20 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include <storages/postgres/detail/topology/base.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/rcu/rcu.hpp>
 #include <userver/storages/postgres/statistics.hpp>
 #include <userver/utils/periodic_task.hpp>
+#include <userver/utils/statistics/relaxed_counter.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -31,17 +38,38 @@ class HotStandby final : public TopologyBase {
   const std::vector<decltype(InstanceStatistics::topology)>& GetDsnStatistics()
       const override;
 
+  std::function<void()> GetRediscoveryTrigger() const override;
+  ClusterTopologyStatistics GetTopologyStatistics() const override;
+
  private:
   struct HostState;
+  struct RediscoveryRequest;
 
-  void RunDiscovery();
-  void RunCheck(DsnIndex);
+  /// Returns true if a writable master was found
+  bool RunDiscovery(std::chrono::milliseconds check_timeout);
+  void RunCheck(DsnIndex, std::chrono::milliseconds check_timeout);
+  void RunTriggeredDiscovery();
+  void AccountMaster(std::optional<DsnIndex> master_idx);
 
   std::vector<HostState> host_states_;
   rcu::Variable<DsnIndicesByType> dsn_indices_by_type_;
   rcu::Variable<DsnIndices> alive_dsn_indices_;
   std::vector<decltype(InstanceStatistics::topology)> dsn_stats_;
+
+  // Scheduled and triggered discoveries share the host states
+  engine::Mutex discovery_mutex_;
+  // Guarded by discovery_mutex_, the latest found writable master
+  std::optional<DsnIndex> last_master_idx_;
+
+  std::shared_ptr<RediscoveryRequest> rediscovery_request_;
+  USERVER_NAMESPACE::utils::statistics::RelaxedCounter<uint64_t>
+      triggered_checks_;
+  USERVER_NAMESPACE::utils::statistics::RelaxedCounter<uint64_t>
+      master_changes_;
+  std::atomic<std::chrono::milliseconds::rep> last_detection_time_ms_{0};
+
   USERVER_NAMESPACE::utils::PeriodicTask discovery_task_;
+  engine::TaskWithResult<void> rediscovery_task_;
 };
 
 /// Returns sync slave names (disregarding availability)
@@ -37,8 +37,13 @@ DistLockComponentBase::DistLockComponentBase(
       component_config["restart-delay"].As<std::chrono::milliseconds>(
           settings.worker_func_restart_delay);
 
-  auto strategy = std::make_shared<DistLockStrategy>(std::move(cluster), table,
-                                                     lock_name, settings);
+  DistLockOptions options;
+  options.fencing_tokens = component_config["fencing-tokens"].As<bool>(false);
+  options.release_channel =
+      component_config["release-channel"].As<std::optional<std::string>>();
+
+  auto strategy = std::make_shared<DistLockStrategy>(
+      std::move(cluster), table, lock_name, settings, std::move(options));
 
   auto task_processor_name =
       component_config["task-processor"].As<std::optional<std::string>>();
@@ -130,6 +135,13 @@ properties:
         type: boolean
         description: Enable testsuite support
         defaultDescription: false
+    fencing-tokens:
+        type: boolean
+        description: keep the fencing tokens in the fencing_token column
+        defaultDescription: false
+    release-channel:
+        type: string
+        description: NOTIFY channel to take over the released lock without waiting for the next attempt
 )");
 }
 
@@ -5,6 +5,7 @@
 
 #include <userver/hostinfo/blocking/get_hostname.hpp>
 #include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -15,7 +16,8 @@ namespace {
 // key - $1
 // owner - $2
 // timeout in seconds - $3
-std::string MakeAcquireQuery(const std::string& table) {
+std::string MakeAcquireQuery(const std::string& table,
+                             const DistLockOptions& options) {
   static constexpr auto kAcquireQueryFmt = R"(
     INSERT INTO {} AS t (key, owner, expiration_time) VALUES
     ($1, $2, current_timestamp + make_interval(secs => $3))
@@ -24,19 +26,52 @@ std::string MakeAcquireQuery(const std::string& table) {
     WHERE (t.owner = $2) OR
     (t.expiration_time <= current_timestamp) RETURNING 1;
 )";
+  // The token changes only when the lock changes hands
+  static constexpr auto kAcquireWithFencingTokenQueryFmt = R"(
+    INSERT INTO {} AS t (key, owner, expiration_time, fencing_token) VALUES
+    ($1, $2, current_timestamp + make_interval(secs => $3), 1)
+    ON CONFLICT (key) DO UPDATE
+    SET owner = $2, expiration_time = current_timestamp + make_interval(secs => $3),
+    fencing_token = t.fencing_token + (CASE WHEN t.owner = $2 THEN 0 ELSE 1 END)
+    WHERE (t.owner = $2) OR
+    (t.expiration_time <= current_timestamp) RETURNING t.fencing_token;
+)";
+  if (options.fencing_tokens) {
+    return fmt::format(FMT_COMPILE(kAcquireWithFencingTokenQueryFmt), table);
+  }
   return fmt::format(FMT_COMPILE(kAcquireQueryFmt), table);
 }
 
 // key - $1
 // owner - $2
-std::string MakeReleaseQuery(const std::string& table) {
+// release channel - $3
+std::string MakeReleaseQuery(const std::string& table,
+                             const DistLockOptions& options) {
   static constexpr auto kReleaseQueryFmt = R"(
     DELETE FROM {}
     WHERE key = $1
     AND owner = $2
-    RETURNING 1;
+    RETURNING key
+)";
+  // The row keeps the fencing token for the next holder
+  static constexpr auto kReleaseKeepingFencingTokenQueryFmt = R"(
+    UPDATE {} SET owner = '', expiration_time = current_timestamp
+    WHERE key = $1
+    AND owner = $2
+    RETURNING key
 )";
-  return fmt::format(FMT_COMPILE(kReleaseQueryFmt), table);
+  auto query =
+      options.fencing_tokens
+          ? fmt::format(FMT_COMPILE(kReleaseKeepingFencingTokenQueryFmt), table)
+          : fmt::format(FMT_COMPILE(kReleaseQueryFmt), table);
+  if (options.release_channel) {
+    query = fmt::format(FMT_COMPILE(R"(
+    WITH released AS ({})
+    SELECT pg_notify($3, key) FROM released;
+)"),
+                        query);
+  }
+  return query;
 }
 
 std::string MakeOwnerId(const std::string& prefix, const std::string& locker) {
@@ -47,13 +82,15 @@ std::string MakeOwnerId(const std::string& prefix, const std::string& locker) {
 
 DistLockStrategy::DistLockStrategy(ClusterPtr cluster, const std::string& table,
                                    const std::string& lock_name,
-                                   const dist_lock::DistLockSettings& settings)
+                                   const dist_lock::DistLockSettings& settings,
+                                   DistLockOptions options)
     : cluster_(std::move(cluster)),
       cc_(settings.forced_stop_margin, settings.forced_stop_margin),
-      acquire_query_(MakeAcquireQuery(table)),
-      release_query_(MakeReleaseQuery(table)),
+      acquire_query_(MakeAcquireQuery(table, options)),
+      release_query_(MakeReleaseQuery(table, options)),
       lock_name_(lock_name),
-      owner_prefix_(hostinfo::blocking::GetRealHostName()) {}
+      owner_prefix_(hostinfo::blocking::GetRealHostName()),
+      options_(std::move(options)) {}
 
 void DistLockStrategy::UpdateCommandControl(CommandControl cc) {
   auto cc_ptr = cc_.StartWrite();
@@ -63,6 +100,11 @@ void DistLockStrategy::UpdateCommandControl(CommandControl cc) {
 
 void DistLockStrategy::Acquire(std::chrono::milliseconds lock_ttl,
                                const std::string& locker_id) {
+  AcquireWithFencingToken(lock_ttl, locker_id);
+}
+
+std::optional<std::int64_t> DistLockStrategy::AcquireWithFencingToken(
+    std::chrono::milliseconds lock_ttl, const std::string& locker_id) {
   double timeout_seconds = lock_ttl.count() / 1000.0;
   auto cc_ptr = cc_.Read();
   auto result = cluster_->Execute(
@@ -70,12 +112,55 @@ void DistLockStrategy::Acquire(std::chrono::milliseconds lock_ttl,
       MakeOwnerId(owner_prefix_, locker_id), timeout_seconds);
 
   if (result.IsEmpty()) throw dist_lock::LockIsAcquiredByAnotherHostException();
+
+  if (options_.release_channel) {
+    // The holder does not need the subscription
+    std::unique_lock<engine::Mutex> lock(listen_mutex_, std::try_to_lock);
+    if (lock) listen_scope_.reset();
+  }
+
+  if (!options_.fencing_tokens) return std::nullopt;
+  return result.AsSingleRow<std::int64_t>();
 }
 
 void DistLockStrategy::Release(const std::string& locker_id) {
   auto cc_ptr = cc_.Read();
-  cluster_->Execute(ClusterHostType::kMaster, *cc_ptr, release_query_,
-                    lock_name_, MakeOwnerId(owner_prefix_, locker_id));
+  if (options_.release_channel) {
+    cluster_->Execute(ClusterHostType::kMaster, *cc_ptr, release_query_,
+                      lock_name_, MakeOwnerId(owner_prefix_, locker_id),
+                      *options_.release_channel);
+  } else {
+    cluster_->Execute(ClusterHostType::kMaster, *cc_ptr, release_query_,
+                      lock_name_, MakeOwnerId(owner_prefix_, locker_id));
+  }
+}
+
+void DistLockStrategy::WaitForRelease(engine::Deadline deadline) {
+  if (!options_.release_channel) {
+    return DistLockStrategyBase::WaitForRelease(deadline);
+  }
+
+  // Another locker of the same strategy is already listening
+  std::unique_lock<engine::Mutex> lock(listen_mutex_, std::try_to_lock);
+  if (!lock) return DistLockStrategyBase::WaitForRelease(deadline);
+
+  // A release before the subscription is missed, the lock is acquired on the
+  // next attempt after the deadline
+  if (!listen_scope_) {
+    listen_scope_.emplace(cluster_->Listen(*options_.release_channel));
+  }
+
+  try {
+    // The channel may be shared by several locks
+    while (listen_scope_->WaitNotify(deadline).payload != lock_name_) {
+      // Released another lock
+    }
+  } catch (const ConnectionTimeoutError&) {
+    // Not released until the deadline
+  } catch (const std::exception&) {
+    listen_scope_.reset();
+    throw;
+  }
 }
 
 }  // namespace storages::postgres
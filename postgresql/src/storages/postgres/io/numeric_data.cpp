@@ -5,6 +5,7 @@
 #include <string_view>
 
 #include <boost/algorithm/string/trim.hpp>
+#include <boost/container/small_vector.hpp>
 
 #include <storages/postgres/io/pg_type_parsers.hpp>
 #include <userver/storages/postgres/exceptions.hpp>
@@ -54,6 +55,9 @@ const std::uint16_t kDscaleMask = 0x3fff;
 // Number of decimal digits in
 const int kDigitWidth = 4;
 
+// The inline capacity is enough for the numerics within int64, e.g. decimal64
+using BinaryDigits = boost::container::small_vector<std::int16_t, 8>;
+
 void WriteDigit(std::string& res, std::uint16_t bin_dgt,
                 bool truncate_leading_zeros) {
   std::array<char, 8> buffer{'0', '0', '0', '0', '0', '0', '0', '0'};
@@ -97,7 +101,7 @@ std::int16_t GetPaddedDigit(std::string_view str, int idx) {
 }
 
 void ConvertDecimalToBinary(std::string_view dec_digits, int left_padding,
-                            std::vector<std::int16_t>& target) {
+                            BinaryDigits& target) {
   for (auto dec_pos = left_padding;
        dec_pos < static_cast<std::int32_t>(dec_digits.size());
        dec_pos += kDigitWidth) {
@@ -116,7 +120,7 @@ int Log10(std::int64_t number) {
 }
 
 void IntegralToBinary(std::int64_t integral_part, Smallint digits,
-                      std::vector<std::int16_t>& target) {
+                      BinaryDigits& target) {
   // Left pad
   if (digits % kDigitWidth) {
     digits += kDigitWidth - digits % kDigitWidth;
@@ -163,7 +167,7 @@ void IntegralToBinary(std::int64_t integral_part, Smallint digits,
 ///            decimal positions
 struct NumericData {
   using Digit = std::int16_t;
-  using Digits = std::vector<Digit>;
+  using Digits = BinaryDigits;
 
   std::uint16_t ndigits = 0;
   Smallint weight = 0;
@@ -0,0 +1,59 @@
+#include <userver/storages/postgres/notify.hpp>
+
+#include <utility>
+
+#include <userver/logging/log.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+NotifyScope::NotifyScope(detail::ConnectionPtr&& conn, std::string_view channel,
+                         OptionalCommandControl cmd_ctl)
+    : conn_{std::move(conn)}, channel_{channel}, cmd_ctl_{std::move(cmd_ctl)} {
+  conn_->Start(detail::SteadyClock::now());
+  try {
+    conn_->Listen(channel_, cmd_ctl_);
+  } catch (const std::exception&) {
+    conn_->Finish();
+    throw;
+  }
+}
+
+NotifyScope::NotifyScope(NotifyScope&&) noexcept = default;
+
+NotifyScope& NotifyScope::operator=(NotifyScope&& other) noexcept {
+  if (this == &other) return *this;
+  Unlisten();
+  conn_ = std::move(other.conn_);
+  channel_ = std::move(other.channel_);
+  cmd_ctl_ = std::move(other.cmd_ctl_);
+  return *this;
+}
+
+NotifyScope::~NotifyScope() { Unlisten(); }
+
+Notification NotifyScope::WaitNotify(engine::Deadline deadline) {
+  if (!conn_) throw LogicError{"The subscription is moved out"};
+  return conn_->WaitNotify(deadline);
+}
+
+void NotifyScope::Unlisten() noexcept {
+  if (!conn_) return;
+  try {
+    conn_->Unlisten(channel_, cmd_ctl_);
+  } catch (const std::exception& e) {
+    LOG_LIMITED_WARNING() << "Failed to unsubscribe from channel '" << channel_
+                          << "': " << e;
+    conn_->MarkAsBroken();
+  }
+  conn_->Finish();
+  conn_ = detail::ConnectionPtr{nullptr};
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
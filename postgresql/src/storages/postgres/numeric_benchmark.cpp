@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+
+#include <userver/decimal64/decimal64.hpp>
+
+#include <storages/postgres/tests/test_buffers.hpp>
+#include <userver/storages/postgres/io/decimal64.hpp>
+#include <userver/storages/postgres/io/user_types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+namespace io = pg::io;
+
+using Decimal = decimal64::Decimal<4>;
+
+const pg::UserTypes types;
+
+void PgDecimalBinaryFormat(benchmark::State& state) {
+  const Decimal value{"-123456.789"};
+  pg::test::Buffer buffer;
+  for (auto _ : state) {
+    io::WriteBuffer(types, buffer, value);
+    buffer.clear();
+  }
+}
+
+void PgDecimalBinaryParse(benchmark::State& state) {
+  Decimal value{"-123456.789"};
+  pg::test::Buffer buffer;
+  io::WriteBuffer(types, buffer, value);
+  auto fb = pg::test::MakeFieldBuffer(buffer);
+  for (auto _ : state) {
+    io::ReadBuffer(fb, value);
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+BENCHMARK(PgDecimalBinaryFormat);
+BENCHMARK(PgDecimalBinaryParse);
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -91,11 +91,21 @@ PoolSettings ParsePoolSettings(const ConfigType& config) {
       config["max_queue_size"].template As<size_t>(result.max_queue_size);
   result.connecting_limit =
       config["connecting_limit"].template As<size_t>(result.connecting_limit);
+  result.batching_connections =
+      config["batching_connections"].template As<size_t>(
+          result.batching_connections);
+  result.batching_max_depth = config["batching_max_depth"].template As<size_t>(
+      result.batching_max_depth);
 
   if (result.max_size == 0)
     throw InvalidConfig{"max_pool_size must be greater than 0"};
   if (result.max_size < result.min_size)
     throw InvalidConfig{"max_pool_size cannot be less than min_pool_size"};
+  if (result.batching_connections > result.max_size)
+    throw InvalidConfig{
+        "batching_connections cannot be greater than max_pool_size"};
+  if (result.batching_max_depth == 0)
+    throw InvalidConfig{"batching_max_depth must be greater than 0"};
 
   return result;
 }
@@ -136,6 +146,18 @@ StatementMetricsSettings Parse(const yaml_config::YamlConfig& config,
   return ParseStatementMetricsSettings(config);
 }
 
+StatementResultCacheSettings Parse(
+    const yaml_config::YamlConfig& config,
+    formats::parse::To<StatementResultCacheSettings>) {
+  StatementResultCacheSettings result{};
+  result.ttl_by_query =
+      config["statement_result_cache"]
+          .As<std::unordered_map<std::string, std::chrono::milliseconds>>({});
+  result.max_size =
+      config["statement_result_cache_size"].As<size_t>(result.max_size);
+  return result;
+}
+
 PipelineMode ParsePipelineMode(const dynamic_config::DocsMap& docs_map) {
   return docs_map.Get("POSTGRES_CONNECTION_PIPELINE_ENABLED").As<bool>(false)
              ? PipelineMode::kEnabled
@@ -31,6 +31,10 @@ StatementMetricsSettings Parse(const formats::json::Value& config,
 StatementMetricsSettings Parse(const yaml_config::YamlConfig& config,
                                formats::parse::To<StatementMetricsSettings>);
 
+StatementResultCacheSettings Parse(
+    const yaml_config::YamlConfig& config,
+    formats::parse::To<StatementResultCacheSettings>);
+
 class Config {
  public:
   dynamic_config::Value<CommandControl> default_command_control;
@@ -4,6 +4,20 @@ USERVER_NAMESPACE_BEGIN
 
 namespace storages::postgres {
 
+void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
+                const StatementResultCacheStatistics& stats) {
+  writer["hits"] = stats.hits;
+  writer["misses"] = stats.misses;
+}
+
+void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
+                const ClusterTopologyStatistics& stats) {
+  writer["triggered-checks"] = stats.triggered_checks;
+  writer["master-changes"] = stats.master_changes;
+  writer["last-master-change-detection-ms"] =
+      stats.last_master_change_detection_time.count();
+}
+
 void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
                 const InstanceStatisticsNonatomic& stats) {
   if (auto conn = writer["connections"]) {
@@ -29,9 +43,11 @@ void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
     timing["return-to-pool"] = stats.transaction.return_to_pool_percentile;
     timing["connect"] = stats.connection_percentile;
     timing["acquire-connection"] = stats.acquire_percentile;
+    timing["queue-wait"] = stats.queue_wait_percentile;
   }
   if (auto query = writer["queries"]) {
     query["parsed"] = stats.transaction.parse_total;
+    query["parsed-warmup"] = stats.transaction.warmup_parse_total;
     query["portals-bound"] = stats.transaction.portal_bind_total;
     query["executed"] = stats.transaction.execute_total;
     query["replies"] = stats.transaction.reply_total;
@@ -51,9 +67,15 @@ void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
                            {kPostgresqlError, "pool"});
     errors.ValueWithLabels(stats.queue_size_errors,
                            {kPostgresqlError, "queue"});
+    errors.ValueWithLabels(stats.queue_deadline_errors,
+                           {kPostgresqlError, "queue-deadline"});
     errors.ValueWithLabels(stats.connection.error_timeout,
                            {kPostgresqlError, "connection-timeout"});
   }
+  if (auto selection = writer["host-selection"]) {
+    selection["least-loaded-selected"] = stats.least_loaded_selected;
+    selection["recent-query-latency-us"] = stats.recent_query_latency_us;
+  }
   writer["prepared-per-connection"] = stats.connection.prepared_statements;
   writer["roundtrip-time"] = stats.topology.roundtrip_time;
   writer["replication-lag"] = stats.topology.replication_lag;
@@ -63,6 +85,12 @@ void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
       timings.ValueWithLabels(percentile, {"postgresql_query", name});
     }
   }
+  if (!stats.statement_result_cache.empty()) {
+    auto result_cache = writer["statement_result_cache"];
+    for (const auto& [name, cache_stats] : stats.statement_result_cache) {
+      result_cache.ValueWithLabels(cache_stats, {"postgresql_query", name});
+    }
+  }
 }
 
 void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
@@ -86,6 +114,7 @@ void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
   for (const auto& item : value.unknown) {
     writer.ValueWithLabels(item, {kPostgresqlClusterHostType, "unknown"});
   }
+  writer["topology"] = value.topology;
 }
 
 }  // namespace storages::postgres
@@ -1,6 +1,7 @@
 #include <storages/postgres/tests/test_buffers.hpp>
 #include <storages/postgres/tests/util_pgtest.hpp>
 #include <userver/storages/postgres/io/array_types.hpp>
+#include <userver/storages/postgres/io/optional.hpp>
 #include <userver/storages/postgres/io/user_types.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -878,6 +879,92 @@ TEST(PostgreIO, SplitContainer) {
   CheckSplit(io::SplitContainer(data, 10));
 }
 
+TEST(PostgreIO, ArrayView) {
+  const pg::io::TypeBufferCategory categories = GetTestTypeCategories();
+  {
+    const std::vector<pg::Bigint> src{1, -2, 3, 1LL << 40};
+    pg::test::Buffer buffer;
+    UEXPECT_NO_THROW(io::WriteBuffer(types, buffer, io::ArrayView{src}));
+    pg::test::Buffer vector_buffer;
+    UEXPECT_NO_THROW(io::WriteBuffer(types, vector_buffer, src));
+    EXPECT_EQ(vector_buffer, buffer);
+
+    auto fb =
+        pg::test::MakeFieldBuffer(buffer, io::BufferCategory::kArrayBuffer);
+    std::vector<pg::Bigint> tgt;
+    UEXPECT_NO_THROW(io::ReadBuffer(fb, tgt, categories));
+    EXPECT_EQ(src, tgt);
+  }
+  {
+    const double src[] = {0.5, -1.25, 1e100};
+    pg::test::Buffer buffer;
+    UEXPECT_NO_THROW(
+        io::WriteBuffer(types, buffer, io::ArrayView<double>{src, 3}));
+    auto fb =
+        pg::test::MakeFieldBuffer(buffer, io::BufferCategory::kArrayBuffer);
+    std::vector<double> tgt;
+    UEXPECT_NO_THROW(io::ReadBuffer(fb, tgt, categories));
+    EXPECT_EQ((std::vector<double>{0.5, -1.25, 1e100}), tgt);
+  }
+  {
+    pg::test::Buffer buffer;
+    UEXPECT_NO_THROW(io::WriteBuffer(types, buffer, io::ArrayView<int>{}));
+    auto fb =
+        pg::test::MakeFieldBuffer(buffer, io::BufferCategory::kArrayBuffer);
+    std::vector<int> tgt{1};
+    UEXPECT_NO_THROW(io::ReadBuffer(fb, tgt, categories));
+    EXPECT_TRUE(tgt.empty());
+  }
+}
+
+TEST(PostgreIO, ArrayFixedWidthParse) {
+  const pg::io::TypeBufferCategory categories = GetTestTypeCategories();
+  {
+    // Elements of a narrower type are left to the element parser
+    const std::vector<pg::Integer> src{1, -2, 3};
+    pg::test::Buffer buffer;
+    UEXPECT_NO_THROW(io::WriteBuffer(types, buffer, src));
+    auto fb =
+        pg::test::MakeFieldBuffer(buffer, io::BufferCategory::kArrayBuffer);
+    std::vector<pg::Bigint> tgt{42};
+    UEXPECT_NO_THROW(io::ReadBuffer(fb, tgt, categories));
+    EXPECT_EQ((std::vector<pg::Bigint>{1, -2, 3}), tgt);
+  }
+  {
+    const std::vector<std::optional<pg::Bigint>> src{1, std::nullopt};
+    pg::test::Buffer buffer;
+    UEXPECT_NO_THROW(io::WriteBuffer(types, buffer, src));
+    auto fb =
+        pg::test::MakeFieldBuffer(buffer, io::BufferCategory::kArrayBuffer);
+    std::vector<pg::Bigint> tgt;
+    UEXPECT_THROW(io::ReadBuffer(fb, tgt, categories),
+                  pg::TypeCannotBeNull);
+  }
+}
+
+UTEST_P(PostgreConnection, ArrayViewUnnest) {
+  CheckConnection(GetConn());
+
+  GetConn()->Execute(
+      "create temporary table array_view_test(id integer, value float8)");
+  std::vector<int> ids(1000);
+  std::vector<double> values(ids.size());
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    ids[i] = i;
+    values[i] = i * 0.5;
+  }
+  UEXPECT_NO_THROW(GetConn()->Execute(
+      "insert into array_view_test select * from unnest($1, $2)",
+      io::ArrayView<int>{ids}, io::ArrayView<double>{values}));
+
+  auto res = GetConn()->Execute(
+      "select count(*), sum(id), sum(value) from array_view_test where "
+      "value = id * 0.5");
+  EXPECT_EQ(ids.size(), res.Front()[0].As<pg::Bigint>());
+  EXPECT_EQ(499500, res.Front()[1].As<pg::Bigint>());
+  EXPECT_EQ(249750, res.Front()[2].As<double>());
+}
+
 UTEST_P(PostgreConnection, ChunkedContainer) {
   CheckConnection(GetConn());
 
@@ -1,8 +1,11 @@
 #include <storages/postgres/tests/util_pgtest.hpp>
 
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
 
 #include <storages/postgres/detail/connection.hpp>
 #include <userver/storages/postgres/cluster.hpp>
@@ -160,12 +163,20 @@ UTEST_F(PostgreCluster, ClusterSlaveRO) {
   CheckRoTransaction(cluster.Begin(
       {pg::ClusterHostType::kSlave, pg::ClusterHostType::kNearest},
       pg::Transaction::RO));
+  CheckRoTransaction(cluster.Begin(
+      {pg::ClusterHostType::kSlave, pg::ClusterHostType::kLeastLoaded},
+      pg::Transaction::RO));
 
   UEXPECT_THROW(cluster.Begin({pg::ClusterHostType::kSlave,
                                pg::ClusterHostType::kRoundRobin,
                                pg::ClusterHostType::kNearest},
                               pg::Transaction::RO),
                 pg::LogicError);
+  UEXPECT_THROW(cluster.Begin({pg::ClusterHostType::kSlave,
+                               pg::ClusterHostType::kNearest,
+                               pg::ClusterHostType::kLeastLoaded},
+                              pg::Transaction::RO),
+                pg::LogicError);
 }
 
 UTEST_F(PostgreCluster, ClusterSyncSlaveRO) {
@@ -196,6 +207,10 @@ UTEST_F(PostgreCluster, ClusterAnyRO) {
       cluster.Begin({pg::ClusterHostType::kSlave, pg::ClusterHostType::kMaster,
                      pg::ClusterHostType::kNearest},
                     pg::Transaction::RO));
+  CheckRoTransaction(
+      cluster.Begin({pg::ClusterHostType::kSlave, pg::ClusterHostType::kMaster,
+                     pg::ClusterHostType::kLeastLoaded},
+                    pg::Transaction::RO));
 
   UEXPECT_THROW(
       cluster.Begin(
@@ -332,4 +347,77 @@ UTEST_F(PostgreCluster, NonTransactionExecuteWithParameterStore) {
   }
 }
 
+UTEST_F(PostgreCluster, ListenNotify) {
+  auto cluster = CreateCluster(GetDsnFromEnv(), GetTaskProcessor(), 2);
+  const std::string channel = "test \"channel\"";
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  auto scope = cluster.Listen(channel);
+  UEXPECT_THROW(scope.WaitNotify(engine::Deadline::FromDuration(
+                    std::chrono::milliseconds{10})),
+                pg::ConnectionTimeoutError);
+
+  cluster.Execute(pg::ClusterHostType::kMaster, "select pg_notify($1, $2)",
+                  channel, std::string{"payload"});
+  cluster.Execute(pg::ClusterHostType::kMaster, "select pg_notify($1, '')",
+                  channel);
+
+  auto notification = scope.WaitNotify(deadline);
+  EXPECT_EQ(channel, notification.channel);
+  EXPECT_EQ("payload", notification.payload);
+  notification = scope.WaitNotify(deadline);
+  EXPECT_EQ(channel, notification.channel);
+  EXPECT_EQ("", notification.payload);
+}
+
+UTEST_F(PostgreCluster, StatementResultCache) {
+  auto cluster = CreateCluster(GetDsnFromEnv(), GetTaskProcessor(), 4);
+  const std::string statement_name = "cached_select";
+  const pg::Query cached_query{"select $1::integer, random()",
+                               pg::Query::Name{statement_name}};
+  const pg::Query slow_query{"select $1::integer, random(), pg_sleep(0.1)",
+                             pg::Query::Name{statement_name}};
+  const pg::Query uncached_query{"select $1::integer, random()",
+                                 pg::Query::Name{"uncached_select"}};
+  const auto get_random = [&](const pg::Query& query, int arg) {
+    return cluster.Execute(pg::ClusterHostType::kMaster, query, arg)
+        .Front()[1]
+        .As<double>();
+  };
+
+  EXPECT_NE(get_random(cached_query, 1), get_random(cached_query, 1));
+
+  pg::StatementResultCacheSettings settings;
+  settings.ttl_by_query[statement_name] = std::chrono::minutes{1};
+  cluster.SetStatementResultCacheSettings(settings);
+
+  const auto cached = get_random(cached_query, 1);
+  EXPECT_EQ(cached, get_random(cached_query, 1));
+  EXPECT_EQ(cached, cluster
+                        .Execute(pg::ClusterHostType::kMaster, cached_query,
+                                 pg::ParameterStore{}.PushBack(1))
+                        .Front()[1]
+                        .As<double>());
+  EXPECT_NE(cached, get_random(cached_query, 2));
+  EXPECT_NE(get_random(uncached_query, 1), get_random(uncached_query, 1));
+
+  // The concurrent executions wait for the result of the first one
+  std::vector<engine::TaskWithResult<double>> tasks;
+  for (int i = 0; i < 3; ++i) {
+    tasks.push_back(utils::Async("cached_select",
+                                 [&] { return get_random(slow_query, 3); }));
+  }
+  const auto deduplicated = tasks.front().Get();
+  for (auto& task : tasks) {
+    EXPECT_EQ(deduplicated, task.Get());
+  }
+
+  const auto stats = cluster.GetStatistics();
+  const auto& result_cache = stats->master.stats.statement_result_cache;
+  ASSERT_EQ(1, result_cache.count(statement_name));
+  EXPECT_EQ(3, result_cache.at(statement_name).misses);
+  EXPECT_EQ(4, result_cache.at(statement_name).hits);
+  EXPECT_EQ(0, result_cache.count("uncached_select"));
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,125 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <optional>
+#include <string>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/copy.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+const std::string kCreateTable =
+    "create temp table copytest(id integer, name text, value bigint)";
+const std::string kCopyIn =
+    "copy copytest (id, name, value) from stdin (format binary)";
+const std::string kCopyOut =
+    "copy (select id, name, value from copytest order by id) to stdout "
+    "(format binary)";
+
+UTEST_P(PostgreConnection, CopyInOut) {
+  constexpr int kRowsCount = 100'000;
+
+  CheckConnection(GetConn());
+  pg::Transaction trx{std::move(GetConn())};
+  trx.Execute(kCreateTable);
+
+  {
+    auto copy = trx.CopyIn(kCopyIn);
+    for (int i = 0; i < kRowsCount; ++i) {
+      std::optional<pg::Bigint> value;
+      if (i % 2) value = i * 10;
+      copy.WriteRow(i, std::to_string(i), value);
+    }
+    EXPECT_EQ(kRowsCount, copy.Finish());
+    EXPECT_ANY_THROW(copy.WriteRow(0, std::string{}, pg::Bigint{0}));
+  }
+
+  auto res = trx.Execute("select count(*), sum(value) from copytest");
+  EXPECT_EQ(kRowsCount, res.Front()[0].As<pg::Bigint>());
+
+  auto copy = trx.CopyOut(kCopyOut);
+  int id = 0;
+  std::string name;
+  std::optional<pg::Bigint> value;
+  int expected_id = 0;
+  while (copy.ReadRow(id, name, value)) {
+    EXPECT_EQ(expected_id, id);
+    EXPECT_EQ(std::to_string(expected_id), name);
+    if (expected_id % 2) {
+      EXPECT_EQ(expected_id * 10, value);
+    } else {
+      EXPECT_FALSE(value);
+    }
+    ++expected_id;
+  }
+  EXPECT_EQ(kRowsCount, expected_id);
+  EXPECT_EQ(kRowsCount, copy.RowsRead());
+  EXPECT_FALSE(copy.ReadRow(id, name, value));
+
+  UEXPECT_NO_THROW(trx.Commit());
+}
+
+UTEST_P(PostgreConnection, CopyOutColumnsMismatch) {
+  CheckConnection(GetConn());
+  pg::Transaction trx{std::move(GetConn())};
+  trx.Execute(kCreateTable);
+  trx.Execute("insert into copytest values (1, 'one', 1)");
+
+  auto copy = trx.CopyOut(kCopyOut);
+  int id = 0;
+  std::string name;
+  UEXPECT_THROW(copy.ReadRow(id, name), pg::FieldTupleMismatch);
+}
+
+UTEST_P(PostgreConnection, CopyNotBinary) {
+  CheckConnection(GetConn());
+  pg::Transaction trx{std::move(GetConn())};
+  trx.Execute(kCreateTable);
+
+  UEXPECT_THROW(trx.CopyIn("copy copytest from stdin"), pg::LogicError);
+}
+
+UTEST_P(PostgreConnection, CopyNotCopy) {
+  CheckConnection(GetConn());
+  pg::Transaction trx{std::move(GetConn())};
+
+  UEXPECT_THROW(trx.CopyIn("select 1"), pg::LogicError);
+  UEXPECT_NO_THROW(trx.Execute("select 1"));
+  UEXPECT_NO_THROW(trx.Commit());
+}
+
+UTEST_P(PostgreConnection, CopyInAbandoned) {
+  CheckConnection(GetConn());
+  pg::Transaction trx{std::move(GetConn())};
+  trx.Execute(kCreateTable);
+
+  {
+    auto copy = trx.CopyIn(kCopyIn);
+    copy.WriteRow(1, std::string{"one"}, pg::Bigint{1});
+  }
+  // The transaction is failed by the aborted COPY
+  UEXPECT_THROW(trx.Execute("select 1"), pg::InvalidTransactionState);
+}
+
+UTEST_P(PostgreConnection, CopyOutAbandoned) {
+  CheckConnection(GetConn());
+  pg::Transaction trx{std::move(GetConn())};
+
+  {
+    auto copy = trx.CopyOut(
+        "copy (select generate_series(1, 1000000)) to stdout (format binary)");
+    int value = 0;
+    EXPECT_TRUE(copy.ReadRow(value));
+    EXPECT_EQ(1, value);
+  }
+  UEXPECT_THROW(trx.Execute("select 1"), pg::InvalidTransactionState);
+}
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,192 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+#include <storages/postgres/detail/pool.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/parameter_store.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+constexpr std::size_t kConcurrency = 8;
+
+// Time for the first statement to become the reader of the shared connection
+constexpr std::chrono::milliseconds kReaderStartDelay{50};
+
+constexpr pg::CommandControl kShortCmdCtl{std::chrono::milliseconds{100},
+                                          std::chrono::milliseconds{100}};
+
+const pg::Query kSlowQuery{"select pg_backend_pid(), pg_sleep(0.3)"};
+const pg::Query kPidQuery{"select pg_backend_pid(), $1::integer"};
+
+std::int32_t GetBackendPid(const pg::ResultSet& res) {
+  return res.Front()[0].As<std::int32_t>();
+}
+
+}  // namespace
+
+class PostgrePipelineExecutor : public PostgreSQLBase {
+ protected:
+  static std::shared_ptr<pg::detail::ConnectionPool> MakePool(
+      const pg::ConnectionSettings& conn_settings) {
+    pg::PoolSettings settings;
+    settings.min_size = 1;
+    settings.max_size = kConcurrency;
+    settings.batching_connections = 1;
+    settings.batching_max_depth = kConcurrency;
+    return pg::detail::ConnectionPool::Create(
+        GetDsnFromEnv(), nullptr, GetTaskProcessor(), "", pg::InitMode::kAsync,
+        settings, conn_settings, {}, GetTestCmdCtls(), {}, {});
+  }
+};
+
+UTEST_F(PostgrePipelineExecutor, ConcurrentStatementsShareConnection) {
+  auto pool = MakePool(kPipelineEnabled);
+
+  auto reader = engine::AsyncNoSpan(
+      [&] { return GetBackendPid(pool->Execute({}, kSlowQuery, {})); });
+  engine::SleepFor(kReaderStartDelay);
+
+  std::vector<engine::TaskWithResult<pg::ResultSet>> tasks;
+  for (std::size_t i = 0; i < kConcurrency - 1; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&, i] {
+      return pool->Execute(
+          {}, kPidQuery,
+          pg::ParameterStore{}.PushBack(static_cast<std::int32_t>(i)));
+    }));
+  }
+
+  const auto reader_pid = reader.Get();
+  for (std::size_t i = 0; i < tasks.size(); ++i) {
+    const auto res = tasks[i].Get();
+    EXPECT_EQ(GetBackendPid(res), reader_pid);
+    EXPECT_EQ(res.Front()[1].As<std::int32_t>(),
+              static_cast<std::int32_t>(i));
+  }
+}
+
+UTEST_F(PostgrePipelineExecutor, FailingStatementDoesNotAffectOthers) {
+  auto pool = MakePool(kPipelineEnabled);
+
+  auto reader =
+      engine::AsyncNoSpan([&] { return pool->Execute({}, kSlowQuery, {}); });
+  engine::SleepFor(kReaderStartDelay);
+
+  auto before = engine::AsyncNoSpan([&] {
+    return pool->Execute({}, kPidQuery, pg::ParameterStore{}.PushBack(1));
+  });
+  auto failing = engine::AsyncNoSpan([&] {
+    return pool->Execute({}, pg::Query{"select 1 / $1::integer"},
+                         pg::ParameterStore{}.PushBack(0));
+  });
+  auto after = engine::AsyncNoSpan([&] {
+    return pool->Execute({}, kPidQuery, pg::ParameterStore{}.PushBack(2));
+  });
+
+  UEXPECT_NO_THROW(reader.Get());
+  UEXPECT_THROW(failing.Get(), pg::DataException);
+  EXPECT_EQ(before.Get().Front()[1].As<std::int32_t>(), 1);
+  EXPECT_EQ(after.Get().Front()[1].As<std::int32_t>(), 2);
+
+  // The shared connection is still usable
+  EXPECT_EQ(pool->Execute({}, kPidQuery, pg::ParameterStore{}.PushBack(3))
+                .Front()[1]
+                .As<std::int32_t>(),
+            3);
+}
+
+UTEST_F(PostgrePipelineExecutor, ReaderTimeout) {
+  auto pool = MakePool(kPipelineEnabled);
+
+  auto reader = engine::AsyncNoSpan(
+      [&] { return pool->Execute(kShortCmdCtl, kSlowQuery, {}); });
+  engine::SleepFor(kReaderStartDelay);
+  auto other = engine::AsyncNoSpan([&] {
+    return pool->Execute({}, kPidQuery, pg::ParameterStore{}.PushBack(1));
+  });
+
+  UEXPECT_THROW(reader.Get(), pg::ConnectionTimeoutError);
+  // The reading is passed to the next statement
+  EXPECT_EQ(other.Get().Front()[1].As<std::int32_t>(), 1);
+}
+
+UTEST_F(PostgrePipelineExecutor, NonReaderTimeout) {
+  auto pool = MakePool(kPipelineEnabled);
+
+  auto reader =
+      engine::AsyncNoSpan([&] { return pool->Execute({}, kSlowQuery, {}); });
+  engine::SleepFor(kReaderStartDelay);
+  auto other = engine::AsyncNoSpan([&] {
+    return pool->Execute(kShortCmdCtl, kPidQuery,
+                         pg::ParameterStore{}.PushBack(1));
+  });
+
+  UEXPECT_THROW(other.Get(), pg::ConnectionTimeoutError);
+  UEXPECT_NO_THROW(reader.Get());
+}
+
+UTEST_F(PostgrePipelineExecutor, ReaderCancellation) {
+  auto pool = MakePool(kPipelineEnabled);
+
+  auto reader =
+      engine::AsyncNoSpan([&] { return pool->Execute({}, kSlowQuery, {}); });
+  engine::SleepFor(kReaderStartDelay);
+  auto other = engine::AsyncNoSpan([&] {
+    return pool->Execute({}, kPidQuery, pg::ParameterStore{}.PushBack(1));
+  });
+  engine::SleepFor(kReaderStartDelay);
+
+  reader.RequestCancel();
+  UEXPECT_THROW(reader.Get(), pg::ConnectionInterrupted);
+  EXPECT_EQ(other.Get().Front()[1].As<std::int32_t>(), 1);
+}
+
+UTEST_F(PostgrePipelineExecutor, NonReaderCancellation) {
+  auto pool = MakePool(kPipelineEnabled);
+
+  auto reader =
+      engine::AsyncNoSpan([&] { return pool->Execute({}, kSlowQuery, {}); });
+  engine::SleepFor(kReaderStartDelay);
+  auto cancelled = engine::AsyncNoSpan([&] {
+    return pool->Execute({}, kPidQuery, pg::ParameterStore{}.PushBack(1));
+  });
+  auto other = engine::AsyncNoSpan([&] {
+    return pool->Execute({}, kPidQuery, pg::ParameterStore{}.PushBack(2));
+  });
+  engine::SleepFor(kReaderStartDelay);
+
+  cancelled.RequestCancel();
+  UEXPECT_THROW(cancelled.Get(), pg::ConnectionInterrupted);
+  UEXPECT_NO_THROW(reader.Get());
+  // The result of the cancelled statement is skipped
+  EXPECT_EQ(other.Get().Front()[1].As<std::int32_t>(), 2);
+}
+
+UTEST_F(PostgrePipelineExecutor, PipelineModeDisabled) {
+  auto pool = MakePool(kCachePreparedStatements);
+
+  std::vector<engine::TaskWithResult<pg::ResultSet>> tasks;
+  for (std::size_t i = 0; i < kConcurrency; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&, i] {
+      return pool->Execute(
+          {}, kPidQuery,
+          pg::ParameterStore{}.PushBack(static_cast<std::int32_t>(i)));
+    }));
+  }
+
+  for (std::size_t i = 0; i < tasks.size(); ++i) {
+    EXPECT_EQ(tasks[i].Get().Front()[1].As<std::int32_t>(),
+              static_cast<std::int32_t>(i));
+  }
+}
+
+USERVER_NAMESPACE_END
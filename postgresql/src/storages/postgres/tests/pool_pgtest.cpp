@@ -299,4 +299,58 @@ UTEST_F(PostgrePool, DefaultCmdCtl) {
   EXPECT_EQ(kTestCmdCtl, pool->GetDefaultCommandControl());
 }
 
+UTEST_F(PostgrePool, PreparedStatementsWarmUp) {
+  auto pool = pg::detail::ConnectionPool::Create(
+      GetDsnFromEnv(), nullptr, GetTaskProcessor(), "",
+      storages::postgres::InitMode::kSync, {1, 2, 10},
+      kCachePreparedStatements, {}, GetTestCmdCtls(),
+      testsuite::PostgresControl{}, error_injection::Settings{});
+
+  UEXPECT_NO_THROW(pool->Begin({}).Execute("select $1::integer", 1));
+  const auto& stats = pool->GetStatistics();
+  EXPECT_EQ(0, stats.transaction.warmup_parse_total);
+
+  // The first connection is busy, the second one is created for the
+  // transaction and gets the statement prepared
+  auto first = pool->Begin({});
+  auto second = pool->Begin({});
+  EXPECT_EQ(2, pool->GetStatistics().connection.open_total);
+  EXPECT_EQ(1, pool->GetStatistics().transaction.warmup_parse_total);
+
+  const auto parsed = pool->GetStatistics().transaction.parse_total;
+  UEXPECT_NO_THROW(second.Execute("select $1::integer", 2));
+  UEXPECT_NO_THROW(second.Commit());
+  UEXPECT_NO_THROW(first.Commit());
+  EXPECT_EQ(parsed, pool->GetStatistics().transaction.parse_total);
+}
+
+UTEST_F(PostgrePool, WaitersEarliestDeadlineFirst) {
+  auto pool = pg::detail::ConnectionPool::Create(
+      GetDsnFromEnv(), nullptr, GetTaskProcessor(), "",
+      storages::postgres::InitMode::kSync, {1, 1, 10},
+      kCachePreparedStatements, {}, GetTestCmdCtls(),
+      testsuite::PostgresControl{}, error_injection::Settings{});
+
+  auto trx = pool->Begin({});
+  std::vector<int> order;
+  auto late = engine::AsyncNoSpan([&pool, &order] {
+    auto conn =
+        pool->Acquire(engine::Deadline::FromDuration(utest::kMaxTestWaitTime));
+    order.push_back(2);
+  });
+  engine::SleepFor(std::chrono::milliseconds{10});
+  auto early = engine::AsyncNoSpan([&pool, &order] {
+    auto conn = pool->Acquire(
+        engine::Deadline::FromDuration(utest::kMaxTestWaitTime / 2));
+    order.push_back(1);
+  });
+  engine::SleepFor(std::chrono::milliseconds{10});
+  EXPECT_EQ(2, pool->GetStatistics().connection.waiting);
+
+  UEXPECT_NO_THROW(trx.Commit());
+  UEXPECT_NO_THROW(late.Get());
+  UEXPECT_NO_THROW(early.Get());
+  EXPECT_EQ((std::vector<int>{1, 2}), order);
+}
+
 USERVER_NAMESPACE_END
@@ -2,6 +2,7 @@
 
 #include <storages/postgres/detail/connection.hpp>
 #include <storages/postgres/detail/topology/hot_standby.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/storages/postgres/exceptions.hpp>
 
 #include <storages/postgres/tests/util_pgtest.hpp>
@@ -49,4 +50,30 @@ UTEST_F(HotStandby, ReplicationLag) {
   EXPECT_EQ(0, hosts->count(pg::ClusterHostType::kSlave));
 }
 
+UTEST_F(HotStandby, TriggeredDiscovery) {
+  const auto& dsns = GetDsnListFromEnv();
+  if (dsns.empty()) return;
+
+  pg::detail::topology::HotStandby qcc(
+      GetTaskProcessor(), dsns, nullptr,
+      pg::TopologySettings{utest::kMaxTestWaitTime}, pg::ConnectionSettings{},
+      GetTestCmdCtls(), testsuite::PostgresControl{},
+      error_injection::Settings{});
+  const auto trigger = qcc.GetRediscoveryTrigger();
+  ASSERT_TRUE(trigger);
+  trigger();
+
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  while (qcc.GetTopologyStatistics().triggered_checks == 0 &&
+         !deadline.IsReached()) {
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+  const auto stats = qcc.GetTopologyStatistics();
+  EXPECT_LT(0, stats.triggered_checks);
+  EXPECT_EQ(0, stats.master_changes);
+
+  auto hosts = qcc.GetDsnIndicesByType();
+  EXPECT_EQ(1, hosts->count(pg::ClusterHostType::kMaster));
+}
+
 USERVER_NAMESPACE_END
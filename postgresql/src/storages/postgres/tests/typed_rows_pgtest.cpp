@@ -25,6 +25,12 @@ struct MyAggregateStruct {
 
 static_assert(boost::pfr::tuple_size_v<MyAggregateStruct> == 3);
 
+struct MyBorrowingStruct {
+  int int_member;
+  std::string_view string_member;
+  std::optional<std::string_view> optional_member;
+};
+
 struct MyStructWithOptional {
   std::optional<int> int_member;
   std::optional<std::string> string_member;
@@ -233,6 +239,38 @@ UTEST_P(PostgreConnection, TypedResultTupleSample) {
   /// [RowTagSippet]
 }
 
+UTEST_P(PostgreConnection, BorrowedTypedResult) {
+  using MyStruct = static_test::MyBorrowingStruct;
+
+  CheckConnection(GetConn());
+
+  pg::BorrowedContainer<std::vector<MyStruct>> structs = [&] {
+    const auto res = GetConn()->Execute(
+        "select i, 'str' || i::text, case when i % 2 = 0 then 'even' end "
+        "from generate_series(1, 100) i");
+    return res.AsBorrowedContainer<std::vector<MyStruct>>(pg::kRowTag);
+  }();
+  ASSERT_EQ(100, structs.size());
+  int i = 0;
+  for (const auto& s : structs) {
+    ++i;
+    EXPECT_EQ(i, s.int_member);
+    EXPECT_EQ("str" + std::to_string(i), s.string_member);
+    if (i % 2 == 0) {
+      EXPECT_EQ("even", s.optional_member);
+    } else {
+      EXPECT_FALSE(s.optional_member);
+    }
+  }
+
+  auto views = [&] {
+    return GetConn()
+        ->Execute("select 'foo' union all select 'bar'")
+        .AsBorrowedContainer<std::vector<std::string_view>>();
+  }();
+  EXPECT_EQ((std::vector<std::string_view>{"foo", "bar"}), views.Get());
+}
+
 }  // namespace
 
 USERVER_NAMESPACE_END
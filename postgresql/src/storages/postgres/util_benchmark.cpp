@@ -1,6 +1,9 @@
 #include <storages/postgres/util_benchmark.hpp>
 
 #include <userver/engine/task/task.hpp>
+#include <userver/error_injection/settings.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/testsuite/postgres_control.hpp>
 
 #include <storages/postgres/default_command_controls.hpp>
 #include <storages/postgres/detail/connection.hpp>
@@ -60,6 +63,50 @@ bool PgConnection::IsConnectionValid() const {
   return conn_ && conn_->IsConnected();
 }
 
+ClusterSettings MakeClusterSettings(std::size_t pool_size,
+                                    PipelineMode pipeline_mode) {
+  ClusterSettings settings;
+  settings.pool_settings.min_size = pool_size;
+  settings.pool_settings.max_size = pool_size;
+  settings.conn_settings.pipeline_mode = pipeline_mode;
+  settings.init_mode = InitMode::kSync;
+  return settings;
+}
+
+void PgCluster::RunStandalone(benchmark::State& state,
+                              std::function<void()> payload) {
+  RunStandalone(state, 1, MakeClusterSettings(1, PipelineMode::kDisabled),
+                std::move(payload));
+}
+
+void PgCluster::RunStandalone(benchmark::State& state,
+                              std::size_t thread_count,
+                              const ClusterSettings& settings,
+                              std::function<void()> payload) {
+  engine::RunStandalone(thread_count, [&] {
+    auto dsn = GetDsnFromEnv();
+    if (!dsn.empty()) {
+      try {
+        cluster_ = std::make_unique<Cluster>(
+            DsnList{dsn}, nullptr, engine::current_task::GetTaskProcessor(),
+            settings, DefaultCommandControls(kBenchCmdCtl, {}, {}),
+            testsuite::PostgresControl{}, error_injection::Settings{});
+      } catch (const std::exception& e) {
+        LOG_ERROR() << "Failed to create a cluster: " << e;
+      }
+    }
+
+    if (!cluster_) {
+      state.SkipWithError("Database not connected");
+      return;
+    }
+
+    payload();
+
+    cluster_.reset();
+  });
+}
+
 }  // namespace storages::postgres::bench
 
 USERVER_NAMESPACE_END
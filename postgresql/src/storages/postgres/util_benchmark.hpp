@@ -1,9 +1,11 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 
 #include <benchmark/benchmark.h>
 
+#include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/options.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -33,6 +35,27 @@ class PgConnection : public benchmark::Fixture {
   std::unique_ptr<detail::Connection> conn_;
 };
 
+/// Settings of a single host cluster with a fixed size pool
+ClusterSettings MakeClusterSettings(std::size_t pool_size,
+                                    PipelineMode pipeline_mode);
+
+/// Measures the whole path from Cluster::Execute to the ResultSet parsing
+class PgCluster : public benchmark::Fixture {
+ protected:
+  Cluster& GetCluster() const noexcept { return *cluster_; }
+
+  // Should be used for starting the benchmark's coroutine environment instead
+  // of engine::RunStandalone
+  void RunStandalone(benchmark::State& state, std::function<void()> payload);
+
+  void RunStandalone(benchmark::State& state, std::size_t thread_count,
+                     const ClusterSettings& settings,
+                     std::function<void()> payload);
+
+ private:
+  std::unique_ptr<Cluster> cluster_;
+};
+
 }  // namespace storages::postgres::bench
 
 USERVER_NAMESPACE_END
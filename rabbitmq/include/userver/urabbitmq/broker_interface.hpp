@@ -4,6 +4,7 @@
 /// @brief A bunch of interface classes
 
 #include <string>
+#include <string_view>
 
 #include <userver/engine/deadline.hpp>
 #include <userver/utils/flags.hpp>
@@ -89,18 +90,19 @@ class IChannelInterface {
   ///
   /// @param exchange the exchange to publish to
   /// @param routing_key the routing key
-  /// @param message the message to send
+  /// @param message the message to send, it is only copied into the AMQP
+  /// frames
   /// @param deadline execution deadline
   ///
   /// @note This method is `fire and forget` (no delivery guarantees),
   /// use `PublishReliable` for delivery guarantees.
   virtual void Publish(const Exchange& exchange, const std::string& routing_key,
-                       const std::string& message, MessageType type,
+                       std::string_view message, MessageType type,
                        engine::Deadline deadline) = 0;
 
   /// @brief overload of Publish
   virtual void Publish(const Exchange& exchange, const std::string& routing_key,
-                       const std::string& message,
+                       std::string_view message,
                        engine::Deadline deadline) = 0;
 
  protected:
@@ -121,17 +123,18 @@ class IReliableChannelInterface {
   ///
   /// @param exchange the exchange to publish to
   /// @param routing_key the routing key
-  /// @param message the message to send
+  /// @param message the message to send, it is only copied into the AMQP
+  /// frames
   /// @param deadline execution deadline
   virtual void PublishReliable(const Exchange& exchange,
                                const std::string& routing_key,
-                               const std::string& message, MessageType type,
+                               std::string_view message, MessageType type,
                                engine::Deadline deadline) = 0;
 
   /// @brief overload of PublishReliable
   virtual void PublishReliable(const Exchange& exchange,
                                const std::string& routing_key,
-                               const std::string& message,
+                               std::string_view message,
                                engine::Deadline deadline) = 0;
 
  protected:
@@ -4,6 +4,7 @@
 /// @brief Publisher interface for the broker.
 
 #include <memory>
+#include <vector>
 
 #include <userver/utils/fast_pimpl.hpp>
 
@@ -15,6 +16,32 @@ namespace urabbitmq {
 
 class ConnectionPtr;
 
+namespace impl {
+class ResponseAwaiter;
+}
+
+/// @brief A pending publisher confirm of a single message, returned by
+/// `ReliableChannel::PublishReliableAsync`.
+///
+/// Holds one of the `max_in_flight_requests` slots of the connection until
+/// awaited or destroyed.
+class PublishConfirmation final {
+ public:
+  PublishConfirmation(impl::ResponseAwaiter&& awaiter);
+  ~PublishConfirmation();
+
+  PublishConfirmation(PublishConfirmation&& other) noexcept;
+
+  /// @brief Wait for the broker to confirm the message.
+  /// Throws if the message was nacked, the connection broke or the deadline
+  /// expired.
+  void Wait(engine::Deadline deadline);
+
+ private:
+  utils::FastPimpl<impl::ResponseAwaiter, 72, 8> impl_;
+  bool awaited_{false};
+};
+
 /// @brief Publisher interface for the broker.
 /// You may use this class to publish your messages.
 ///
@@ -33,11 +60,11 @@ class Channel final : IChannelInterface {
   Channel(Channel&& other) noexcept;
 
   void Publish(const Exchange& exchange, const std::string& routing_key,
-               const std::string& message, MessageType type,
+               std::string_view message, MessageType type,
                engine::Deadline deadline) override;
 
   void Publish(const Exchange& exchange, const std::string& routing_key,
-               const std::string& message, engine::Deadline deadline) override {
+               std::string_view message, engine::Deadline deadline) override {
     Publish(exchange, routing_key, message, MessageType::kTransient, deadline);
   };
 
@@ -64,16 +91,50 @@ class ReliableChannel final : IReliableChannelInterface {
   ReliableChannel(ReliableChannel&& other) noexcept;
 
   void PublishReliable(const Exchange& exchange, const std::string& routing_key,
-                       const std::string& message, MessageType type,
+                       std::string_view message, MessageType type,
                        engine::Deadline deadline) override;
 
   void PublishReliable(const Exchange& exchange, const std::string& routing_key,
-                       const std::string& message,
+                       std::string_view message,
                        engine::Deadline deadline) override {
     PublishReliable(exchange, routing_key, message, MessageType::kTransient,
                     deadline);
   }
 
+  /// @brief Publish a message without waiting for the broker confirm.
+  ///
+  /// Publishing several messages before awaiting their confirmations keeps
+  /// them in flight at once instead of paying a round-trip per message.
+  /// At most `max_in_flight_requests` (see `PoolSettings`) messages are
+  /// unconfirmed at a time: past that the call waits for a free slot up to
+  /// `deadline`, so await the earlier confirmations before publishing more.
+  ///
+  /// @param exchange exchange to publish to
+  /// @param routing_key routing key
+  /// @param message message
+  /// @param type message type
+  /// @param deadline deadline for the publish and the free slot
+  [[nodiscard]] PublishConfirmation PublishReliableAsync(
+      const Exchange& exchange, const std::string& routing_key,
+      std::string_view message, MessageType type, engine::Deadline deadline);
+
+  /// @brief Reliably publish a batch of messages.
+  ///
+  /// Keeps up to `max_in_flight_requests` messages unconfirmed at a time and
+  /// returns once every message is confirmed by the broker.
+  /// Throws on the first message that is not confirmed, the messages after it
+  /// might have been published nevertheless.
+  ///
+  /// @param exchange exchange to publish to
+  /// @param routing_key routing key
+  /// @param messages messages in the order of publishing
+  /// @param type message type
+  /// @param deadline deadline for the whole batch
+  void PublishReliableBatch(const Exchange& exchange,
+                            const std::string& routing_key,
+                            const std::vector<std::string>& messages,
+                            MessageType type, engine::Deadline deadline);
+
  private:
   utils::FastPimpl<ConnectionPtr, 32, 8> impl_;
 };
@@ -74,11 +74,11 @@ class Client : public std::enable_shared_from_this<Client>,
   AdminChannel GetAdminChannel(engine::Deadline deadline);
 
   void Publish(const Exchange& exchange, const std::string& routing_key,
-               const std::string& message, MessageType type,
+               std::string_view message, MessageType type,
                engine::Deadline deadline) override;
 
   void Publish(const Exchange& exchange, const std::string& routing_key,
-               const std::string& message, engine::Deadline deadline) override {
+               std::string_view message, engine::Deadline deadline) override {
     Publish(exchange, routing_key, message, MessageType::kTransient, deadline);
   };
 
@@ -88,11 +88,11 @@ class Client : public std::enable_shared_from_this<Client>,
   Channel GetChannel(engine::Deadline deadline);
 
   void PublishReliable(const Exchange& exchange, const std::string& routing_key,
-                       const std::string& message, MessageType type,
+                       std::string_view message, MessageType type,
                        engine::Deadline deadline) override;
 
   void PublishReliable(const Exchange& exchange, const std::string& routing_key,
-                       const std::string& message,
+                       std::string_view message,
                        engine::Deadline deadline) override {
     PublishReliable(exchange, routing_key, message, MessageType::kTransient,
                     deadline);
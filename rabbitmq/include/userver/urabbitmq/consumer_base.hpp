@@ -4,6 +4,8 @@
 /// @brief Base class for your consumers.
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <userver/utils/periodic_task.hpp>
 
@@ -22,6 +24,9 @@ class ConsumerBaseImpl;
 /// You should derive from it and override `Process` method, which gets called
 /// when a new message arrives from the broker.
 ///
+/// With `ConsumerSettings::max_batch_size` set the messages are handed over to
+/// `ProcessBatch` instead, which you may override to handle them at once.
+///
 /// If your configuration is known upfront and doesn't change ar runtime
 /// consider using `ConsumerComponentBase` instead.
 ///
@@ -68,7 +73,19 @@ class ConsumerBase {
   /// that `ack` ever reached the broker (network issues or unexpected shutdown,
   /// for example).
   /// It is however guaranteed for message to be requeued if `Process` fails.
-  virtual void Process(std::string message) = 0;
+  ///
+  /// The default implementation throws: override either this method or
+  /// `ProcessBatch`.
+  virtual void Process(std::string message);
+
+  /// @brief Override this method in derived class to handle the messages
+  /// in batches, used when `ConsumerSettings::max_batch_size` is set.
+  ///
+  /// If this method returns successfully the whole batch would be acked
+  /// (best effort), if it throws the whole batch would be requeued.
+  ///
+  /// The default implementation calls `Process` for every message.
+  virtual void ProcessBatch(std::vector<std::string> messages);
 
  private:
   std::shared_ptr<Client> client_;
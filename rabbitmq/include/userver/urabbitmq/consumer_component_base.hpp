@@ -4,6 +4,8 @@
 /// @brief Base component for your consumers.
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <userver/components/loggable_component_base.hpp>
 
@@ -34,10 +36,14 @@ namespace urabbitmq {
 /// @snippet samples/rabbitmq_service/static_config.yaml  RabbitMQ consumer sample - static config
 ///
 /// ## Static options:
-/// Name             | Description
-/// rabbit_name      | Name of the RabbitMQ component to use for consumption
-/// queue            | Name of the queue to consume from
-/// prefetch_count   | prefetch_count for the consumer, limits the amount of in-flight messages
+/// Name                   | Description                                                                  | Default value
+/// ---------------------- | ---------------------------------------------------------------------------- | -------------
+/// rabbit_name            | Name of the RabbitMQ component to use for consumption                        | --
+/// queue                  | Name of the queue to consume from                                            | --
+/// prefetch_count         | prefetch_count for the consumer, limits the amount of in-flight messages     | --
+/// max_batch_size         | hand the messages to ProcessBatch in batches of up to this size, 0 to disable | 0
+/// max_batch_delay        | hand a batch over once its first message waited this long                    | 100ms
+/// max_concurrent_batches | limit for the batches processed concurrently                                 | 1
 ///
 // clang-format on
 class ConsumerComponentBase : public components::LoggableComponentBase {
@@ -64,7 +70,19 @@ class ConsumerComponentBase : public components::LoggableComponentBase {
   /// that `ack` ever reached the broker (network issues or unexpected shutdown,
   /// for example).
   /// It is however guaranteed for message to be requeued if `Process` fails.
-  virtual void Process(std::string message) = 0;
+  ///
+  /// The default implementation throws: override either this method or
+  /// `ProcessBatch`.
+  virtual void Process(std::string message);
+
+  /// @brief Override this method in derived class to handle the messages
+  /// in batches, used when `max_batch_size` is set in the static config.
+  ///
+  /// If this method returns successfully the whole batch would be acked
+  /// (best effort), if it throws the whole batch would be requeued.
+  ///
+  /// The default implementation calls `Process` for every message.
+  virtual void ProcessBatch(std::vector<std::string> messages);
 
  private:
   // This is actually just a subclass of `ConsumerBase`
@@ -3,6 +3,7 @@
 /// @file userver/urabbitmq/consumer_settings.hpp
 /// @brief Consumer settings.
 
+#include <chrono>
 #include <cstddef>
 
 #include <userver/urabbitmq/typedefs.hpp>
@@ -24,6 +25,21 @@ struct ConsumerSettings final {
   /// Settings this value to 1 basically makes a consumer synchronous, which
   /// could be of use for some workloads
   std::uint16_t prefetch_count;
+
+  /// Hand the messages over to `ConsumerBase::ProcessBatch` in batches of up
+  /// to this size and acknowledge them with a single `multiple` ack.
+  /// Zero keeps the per-message `Process` mode.
+  ///
+  /// No more than `prefetch_count` messages are ever unacked, so a batch
+  /// can't be larger than that
+  std::size_t max_batch_size{0};
+
+  /// Hand a batch over once its first message waited this long, even if the
+  /// batch is not full
+  std::chrono::milliseconds max_batch_delay{100};
+
+  /// Limit for the batches processed concurrently
+  std::size_t max_concurrent_batches{1};
 };
 
 }  // namespace urabbitmq
@@ -1,8 +1,12 @@
 #include "utils_rmqtest.hpp"
 
+#include <algorithm>
 #include <optional>
 
+#include <userver/engine/async.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+#include <userver/formats/json.hpp>
 #include <userver/utils/uuid4.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -75,6 +79,46 @@ class ThrowingConsumer final : public urabbitmq::ConsumerBase {
   engine::ConditionVariable cond_;
 };
 
+class BatchConsumer final : public urabbitmq::ConsumerBase {
+ public:
+  using urabbitmq::ConsumerBase::ConsumerBase;
+  ~BatchConsumer() override { Stop(); }
+
+  void ProcessBatch(std::vector<std::string> messages) override {
+    size_t consumed = 0;
+    {
+      auto locked = messages_.Lock();
+      max_batch_size_ = std::max(max_batch_size_.load(), messages.size());
+      for (auto& message : messages) locked->emplace_back(std::move(message));
+      consumed = locked->size();
+    }
+
+    if (consumed >= expected_consumed_) {
+      event_.Send();
+    }
+  }
+
+  void ExpectConsume(size_t count) { expected_consumed_ = count; }
+
+  std::vector<std::string> Wait() {
+    [[maybe_unused]] auto res = event_.WaitForEventFor(utest::kMaxTestWaitTime);
+    return Get();
+  }
+
+  std::vector<std::string> Get() {
+    auto locked = messages_.Lock();
+    return *locked;
+  }
+
+  size_t GetMaxBatchSize() const { return max_batch_size_; }
+
+ private:
+  concurrent::Variable<std::vector<std::string>> messages_;
+  std::atomic<size_t> max_batch_size_{0};
+  std::atomic<size_t> expected_consumed_{0};
+  engine::SingleConsumerEvent event_;
+};
+
 }  // namespace
 
 UTEST(Consumer, CreateOnInvalidQueueWorks) {
@@ -113,6 +157,34 @@ UTEST(Consumer, ConsumeWorks) {
   EXPECT_EQ(consumed[0], message);
 }
 
+UTEST(Consumer, ConsumesLargeAndSmallMessages) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+  const urabbitmq::ConsumerSettings settings{client.GetQueue(), 10};
+
+  const std::string large(1024 * 1024, 'x');
+  const std::string_view small{"small"};
+  client->PublishReliable(client.GetExchange(), client.GetRoutingKey(), large,
+                          urabbitmq::MessageType::kTransient,
+                          client.GetDeadline());
+  client->PublishReliable(client.GetExchange(), client.GetRoutingKey(), small,
+                          urabbitmq::MessageType::kTransient,
+                          client.GetDeadline());
+
+  Consumer consumer{client.Get(), settings};
+  consumer.ExpectConsume(2);
+  consumer.Start();
+  auto consumed = consumer.Wait();
+
+  ASSERT_EQ(consumed.size(), 2);
+  std::sort(consumed.begin(), consumed.end(),
+            [](const auto& lhs, const auto& rhs) {
+              return lhs.size() > rhs.size();
+            });
+  EXPECT_EQ(consumed[0], large);
+  EXPECT_EQ(consumed[1], small);
+}
+
 UTEST(Consumer, ExhaustesQueue) {
   ClientWrapper client{};
   client.SetupRmqEntities();
@@ -133,6 +205,110 @@ UTEST(Consumer, ExhaustesQueue) {
   consumer.Wait();
 }
 
+UTEST(Consumer, ConsumesPipelinedPublishes) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+  const urabbitmq::ConsumerSettings settings{client.GetQueue(), 10};
+
+  const size_t messages_count = 1000;
+  std::vector<std::string> messages;
+  for (size_t i = 0; i < messages_count; ++i) {
+    messages.push_back(std::to_string(i));
+  }
+  {
+    auto channel = client->GetReliableChannel(client.GetDeadline());
+    channel.PublishReliableBatch(client.GetExchange(), client.GetRoutingKey(),
+                                 messages, urabbitmq::MessageType::kTransient,
+                                 client.GetDeadline());
+
+    auto first = channel.PublishReliableAsync(
+        client.GetExchange(), client.GetRoutingKey(), "first",
+        urabbitmq::MessageType::kTransient, client.GetDeadline());
+    auto second = channel.PublishReliableAsync(
+        client.GetExchange(), client.GetRoutingKey(), "second",
+        urabbitmq::MessageType::kTransient, client.GetDeadline());
+    first.Wait(client.GetDeadline());
+    second.Wait(client.GetDeadline());
+  }
+  messages.emplace_back("first");
+  messages.emplace_back("second");
+
+  Consumer consumer{client.Get(), settings};
+  consumer.ExpectConsume(messages.size());
+  consumer.Start();
+
+  auto consumed = consumer.Wait();
+  std::sort(consumed.begin(), consumed.end());
+  std::sort(messages.begin(), messages.end());
+  EXPECT_EQ(consumed, messages);
+}
+
+UTEST(Consumer, ConsumesInBatches) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+  urabbitmq::ConsumerSettings settings{client.GetQueue(), 100};
+  settings.max_batch_size = 10;
+  settings.max_batch_delay = std::chrono::milliseconds{50};
+  settings.max_concurrent_batches = 2;
+
+  const size_t messages_count = 1000;
+  std::vector<std::string> messages;
+  for (size_t i = 0; i < messages_count; ++i) {
+    messages.push_back(std::to_string(i));
+  }
+  client->GetReliableChannel(client.GetDeadline())
+      .PublishReliableBatch(client.GetExchange(), client.GetRoutingKey(),
+                            messages, urabbitmq::MessageType::kTransient,
+                            client.GetDeadline());
+
+  BatchConsumer consumer{client.Get(), settings};
+  consumer.ExpectConsume(messages_count);
+  consumer.Start();
+
+  auto consumed = consumer.Wait();
+  consumer.Stop();
+
+  std::sort(consumed.begin(), consumed.end());
+  std::sort(messages.begin(), messages.end());
+  EXPECT_EQ(consumed, messages);
+  EXPECT_LE(consumer.GetMaxBatchSize(), settings.max_batch_size);
+
+  // Everything got acked, so nothing is redelivered to a new consumer
+  BatchConsumer second_consumer{client.Get(), settings};
+  second_consumer.Start();
+  engine::SleepFor(std::chrono::milliseconds{200});
+  second_consumer.Stop();
+  EXPECT_TRUE(second_consumer.Get().empty());
+}
+
+UTEST_MT(Client, ConcurrentPublishersSettleAllRequests, 4) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+
+  const size_t publishers_count = 8;
+  const size_t messages_per_publisher = 100;
+  std::vector<engine::TaskWithResult<void>> publishers;
+  for (size_t i = 0; i < publishers_count; ++i) {
+    publishers.push_back(engine::AsyncNoSpan([&client] {
+      for (size_t j = 0; j < messages_per_publisher; ++j) {
+        client->PublishReliable(client.GetExchange(), client.GetRoutingKey(),
+                                std::to_string(j),
+                                urabbitmq::MessageType::kTransient,
+                                client.GetDeadline());
+      }
+    }));
+  }
+  engine::WaitAllChecked(publishers);
+
+  size_t published = 0;
+  for (const auto& [host, stats] :
+       formats::json::Items(client->GetStatistics())) {
+    published += stats["messages_published"].As<size_t>();
+    EXPECT_EQ(stats["requests_in_flight"].As<size_t>(), 0) << host;
+  }
+  EXPECT_EQ(published, publishers_count * messages_per_publisher);
+}
+
 UTEST(Consumer, ThrowsReturnsToQueue) {
   ClientWrapper client{};
   client.SetupRmqEntities();
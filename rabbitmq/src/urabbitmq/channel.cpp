@@ -1,5 +1,9 @@
 #include <userver/urabbitmq/channel.hpp>
 
+#include <deque>
+#include <utility>
+
+#include <urabbitmq/connection.hpp>
 #include <urabbitmq/connection_helper.hpp>
 #include <urabbitmq/connection_ptr.hpp>
 
@@ -7,6 +11,27 @@ USERVER_NAMESPACE_BEGIN
 
 namespace urabbitmq {
 
+PublishConfirmation::PublishConfirmation(impl::ResponseAwaiter&& awaiter)
+    : impl_{std::move(awaiter)} {}
+
+PublishConfirmation::~PublishConfirmation() {
+  if (awaited_) return;
+  // Nobody is interested in the confirm anymore, just give the slot back
+  try {
+    impl_->Wait(engine::Deadline::Passed());
+  } catch (const std::exception&) {
+  }
+}
+
+PublishConfirmation::PublishConfirmation(PublishConfirmation&& other) noexcept
+    : impl_{std::move(*other.impl_)},
+      awaited_{std::exchange(other.awaited_, true)} {}
+
+void PublishConfirmation::Wait(engine::Deadline deadline) {
+  awaited_ = true;
+  impl_->Wait(deadline);
+}
+
 Channel::Channel(ConnectionPtr&& channel) : impl_{std::move(channel)} {}
 
 Channel::~Channel() = default;
@@ -14,7 +39,7 @@ Channel::~Channel() = default;
 Channel::Channel(Channel&& other) noexcept = default;
 
 void Channel::Publish(const Exchange& exchange, const std::string& routing_key,
-                      const std::string& message, MessageType type,
+                      std::string_view message, MessageType type,
                       engine::Deadline deadline) {
   ConnectionHelper::Publish(*impl_, exchange, routing_key, message, type,
                             deadline);
@@ -29,7 +54,7 @@ ReliableChannel::ReliableChannel(ReliableChannel&& other) noexcept = default;
 
 void ReliableChannel::PublishReliable(const Exchange& exchange,
                                       const std::string& routing_key,
-                                      const std::string& message,
+                                      std::string_view message,
                                       MessageType type,
                                       engine::Deadline deadline) {
   ConnectionHelper::PublishReliable(*impl_, exchange, routing_key, message,
@@ -37,6 +62,33 @@ void ReliableChannel::PublishReliable(const Exchange& exchange,
       .Wait(deadline);
 }
 
+PublishConfirmation ReliableChannel::PublishReliableAsync(
+    const Exchange& exchange, const std::string& routing_key,
+    std::string_view message, MessageType type, engine::Deadline deadline) {
+  return ConnectionHelper::PublishReliable(*impl_, exchange, routing_key,
+                                           message, type, deadline);
+}
+
+void ReliableChannel::PublishReliableBatch(
+    const Exchange& exchange, const std::string& routing_key,
+    const std::vector<std::string>& messages, MessageType type,
+    engine::Deadline deadline) {
+  // The connection is owned by the channel, so all the in-flight slots are ours
+  const auto window = (*impl_)->GetMaxInFlightRequests();
+
+  std::deque<PublishConfirmation> in_flight;
+  for (const auto& message : messages) {
+    if (in_flight.size() >= window) {
+      in_flight.front().Wait(deadline);
+      in_flight.pop_front();
+    }
+    in_flight.push_back(
+        PublishReliableAsync(exchange, routing_key, message, type, deadline));
+  }
+
+  for (auto& confirmation : in_flight) confirmation.Wait(deadline);
+}
+
 }  // namespace urabbitmq
 
 USERVER_NAMESPACE_END
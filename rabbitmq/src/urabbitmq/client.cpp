@@ -61,7 +61,7 @@ void Client::RemoveQueue(const Queue& queue, engine::Deadline deadline) {
 }
 
 void Client::Publish(const Exchange& exchange, const std::string& routing_key,
-                     const std::string& message, MessageType type,
+                     std::string_view message, MessageType type,
                      engine::Deadline deadline) {
   ConnectionHelper::Publish(impl_->GetConnection(deadline), exchange,
                             routing_key, message, type, deadline);
@@ -69,7 +69,7 @@ void Client::Publish(const Exchange& exchange, const std::string& routing_key,
 
 void Client::PublishReliable(const Exchange& exchange,
                              const std::string& routing_key,
-                             const std::string& message, MessageType type,
+                             std::string_view message, MessageType type,
                              engine::Deadline deadline) {
   auto awaiter = ConnectionHelper::PublishReliable(
       impl_->GetConnection(deadline), exchange, routing_key, message, type,
@@ -25,6 +25,14 @@ impl::AmqpReliableChannel& Connection::GetReliableChannel() {
 
 bool Connection::IsBroken() const { return handler_.IsBroken(); }
 
+size_t Connection::GetMaxInFlightRequests() const {
+  return connection_.GetMaxInFlightRequests();
+}
+
+size_t Connection::GetFreeInFlightSlotsApprox() const {
+  return connection_.GetFreeInFlightSlotsApprox();
+}
+
 void Connection::EnsureUsable() const {
   if (IsBroken()) {
     throw std::runtime_error{"Connection is broken"};
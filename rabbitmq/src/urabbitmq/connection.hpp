@@ -35,6 +35,10 @@ class Connection final {
 
   bool IsBroken() const;
 
+  size_t GetMaxInFlightRequests() const;
+  // The requests of the previous leaseholders might still be awaited
+  size_t GetFreeInFlightSlotsApprox() const;
+
   void EnsureUsable() const;
 
  private:
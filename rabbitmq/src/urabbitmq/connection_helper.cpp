@@ -54,7 +54,7 @@ impl::ResponseAwaiter ConnectionHelper::RemoveQueue(
 void ConnectionHelper::Publish(const ConnectionPtr& connection,
                                const Exchange& exchange,
                                const std::string& routing_key,
-                               const std::string& message, MessageType type,
+                               std::string_view message, MessageType type,
                                engine::Deadline deadline) {
   tracing::Span span{"publish"};
   connection->GetChannel().Publish(exchange, routing_key, message, type,
@@ -63,7 +63,7 @@ void ConnectionHelper::Publish(const ConnectionPtr& connection,
 
 impl::ResponseAwaiter ConnectionHelper::PublishReliable(
     const ConnectionPtr& connection, const Exchange& exchange,
-    const std::string& routing_key, const std::string& message,
+    const std::string& routing_key, std::string_view message,
     MessageType type, engine::Deadline deadline) {
   return WithSpan("reliable_publish", [&] {
     return connection->GetReliableChannel().Publish(exchange, routing_key,
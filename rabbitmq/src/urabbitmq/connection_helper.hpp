@@ -1,5 +1,8 @@
 #pragma once
 
+#include <string>
+#include <string_view>
+
 #include <userver/engine/deadline.hpp>
 #include <userver/urabbitmq/typedefs.hpp>
 #include <userver/utils/flags.hpp>
@@ -44,12 +47,12 @@ class ConnectionHelper final {
 
   static void Publish(const ConnectionPtr& connection, const Exchange& exchange,
                       const std::string& routing_key,
-                      const std::string& message, MessageType type,
+                      std::string_view message, MessageType type,
                       engine::Deadline deadline);
 
   [[nodiscard]] static impl::ResponseAwaiter PublishReliable(
       const ConnectionPtr& connection, const Exchange& exchange,
-      const std::string& routing_key, const std::string& message,
+      const std::string& routing_key, std::string_view message,
       MessageType type, engine::Deadline deadline);
 
  private:
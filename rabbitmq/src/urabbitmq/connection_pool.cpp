@@ -21,6 +21,9 @@ constexpr std::chrono::milliseconds kPoolMonitorInterval{1000};
 
 constexpr size_t kMaxSimultaneouslyConnectingClients{5};
 
+// How many idle connections to look through for the least loaded one
+constexpr size_t kMaxSelectionCandidates{4};
+
 }  // namespace
 
 std::shared_ptr<ConnectionPool> ConnectionPool::Create(
@@ -94,8 +97,10 @@ void ConnectionPool::Release(std::unique_ptr<Connection> connection) {
   UASSERT(connection);
 
   auto* ptr = connection.release();
-  if (ptr->IsBroken() || !queue_.bounded_push(ptr)) {
+  if (ptr->IsBroken()) {
     Drop(ptr);
+  } else {
+    PushBack(ptr);
   }
 
   given_away_semaphore_.unlock_shared();
@@ -137,21 +142,44 @@ std::unique_ptr<Connection> ConnectionPool::Pop(engine::Deadline deadline) {
 }
 
 std::unique_ptr<Connection> ConnectionPool::TryPop() {
-  Connection* conn{nullptr};
-  if (!queue_.pop(conn)) {
-    return nullptr;
+  // Idle connections might still be busy with the responses for their previous
+  // leaseholders, so we prefer the one with the most free in-flight slots
+  // instead of blocking on a saturated connection while others are idle.
+  Connection* best{nullptr};
+  size_t best_free_slots{0};
+  for (size_t i = 0; i < kMaxSelectionCandidates; ++i) {
+    Connection* conn{nullptr};
+    if (!queue_.pop(conn)) {
+      break;
+    }
+
+    const auto free_slots = conn->GetFreeInFlightSlotsApprox();
+    if (best == nullptr || free_slots > best_free_slots) {
+      std::swap(best, conn);
+      best_free_slots = free_slots;
+    }
+    if (conn != nullptr) {
+      PushBack(conn);
+    }
+
+    if (best_free_slots >= best->GetMaxInFlightRequests()) {
+      break;
+    }
   }
 
-  return std::unique_ptr<Connection>(conn);
+  return std::unique_ptr<Connection>(best);
 }
 
-void ConnectionPool::PushConnection(engine::Deadline deadline) {
-  auto* ptr = CreateConnection(deadline).release();
-  if (!queue_.bounded_push(ptr)) {
-    Drop(ptr);
+void ConnectionPool::PushBack(Connection* connection) noexcept {
+  if (!queue_.bounded_push(connection)) {
+    Drop(connection);
   }
 }
 
+void ConnectionPool::PushConnection(engine::Deadline deadline) {
+  PushBack(CreateConnection(deadline).release());
+}
+
 std::unique_ptr<Connection> ConnectionPool::CreateConnection(
     engine::Deadline deadline) {
   auto conn =
@@ -44,6 +44,7 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
  private:
   std::unique_ptr<Connection> Pop(engine::Deadline deadline);
   std::unique_ptr<Connection> TryPop();
+  void PushBack(Connection* connection) noexcept;
 
   void PushConnection(engine::Deadline deadline);
   std::unique_ptr<Connection> CreateConnection(engine::Deadline deadline);
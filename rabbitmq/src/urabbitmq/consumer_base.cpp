@@ -1,5 +1,7 @@
 #include <userver/urabbitmq/consumer_base.hpp>
 
+#include <stdexcept>
+
 #include <userver/engine/async.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/urabbitmq/client.hpp>
@@ -16,15 +18,16 @@ namespace {
 constexpr std::chrono::milliseconds kConnectionAcquisitionTimeout{1000};
 constexpr std::chrono::seconds kMonitorInterval{1};
 
-template <typename OnMessage>
+template <typename OnMessage, typename OnBatch>
 std::unique_ptr<ConsumerBaseImpl> CreateAndStartConsumerImpl(
     ClientImpl& client_impl, const ConsumerSettings& settings,
-    OnMessage&& on_message) {
+    OnMessage&& on_message, OnBatch&& on_batch) {
   auto impl = std::make_unique<ConsumerBaseImpl>(
       client_impl.GetConnection(
           engine::Deadline::FromDuration(kConnectionAcquisitionTimeout)),
       settings);
-  impl->Start(std::forward<OnMessage>(on_message));
+  impl->Start(std::forward<OnMessage>(on_message),
+              std::forward<OnBatch>(on_batch));
 
   return impl;
 }
@@ -51,7 +54,10 @@ void ConsumerBase::Start() {
   try {
     impl_ = CreateAndStartConsumerImpl(
         *client_->impl_, settings_,
-        [this](std::string message) { Process(std::move(message)); });
+        [this](std::string message) { Process(std::move(message)); },
+        [this](std::vector<std::string> messages) {
+          ProcessBatch(std::move(messages));
+        });
   } catch (const std::exception& ex) {
     LOG_WARNING() << "Failed to start a consumer: '" << ex.what()
                   << "'; will try to start again";
@@ -72,7 +78,10 @@ void ConsumerBase::Start() {
             impl_.reset();
             impl_ = CreateAndStartConsumerImpl(
                 *client_->impl_, settings_,
-                [this](std::string message) { Process(std::move(message)); });
+                [this](std::string message) { Process(std::move(message)); },
+                [this](std::vector<std::string> messages) {
+                  ProcessBatch(std::move(messages));
+                });
             LOG_INFO() << "Restarted successfully";
           } catch (const std::exception& ex) {
             LOG_WARNING() << "Failed to restart a consumer: '" << ex.what()
@@ -87,6 +96,15 @@ void ConsumerBase::Stop() {
   impl_.reset();
 }
 
+void ConsumerBase::Process(std::string) {
+  throw std::logic_error{
+      "Neither Process nor ProcessBatch is overridden by the consumer"};
+}
+
+void ConsumerBase::ProcessBatch(std::vector<std::string> messages) {
+  for (auto& message : messages) Process(std::move(message));
+}
+
 }  // namespace urabbitmq
 
 USERVER_NAMESPACE_END
@@ -1,10 +1,13 @@
 #include "consumer_base_impl.hpp"
 
+#include <algorithm>
+#include <iterator>
 #include <string>
 
 #include <fmt/format.h>
 
 #include <userver/concurrent/background_task_storage.hpp>
+#include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/task.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/span.hpp>
@@ -22,6 +25,12 @@ namespace {
 
 constexpr std::chrono::milliseconds kStartTimeout{2000};
 
+std::chrono::milliseconds GetLag(
+    std::chrono::steady_clock::time_point delivered_at) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - delivered_at);
+}
+
 }  // namespace
 
 ConsumerBaseImpl::ConsumerBaseImpl(ConnectionPtr&& connection,
@@ -29,6 +38,9 @@ ConsumerBaseImpl::ConsumerBaseImpl(ConnectionPtr&& connection,
     : dispatcher_{engine::current_task::GetTaskProcessor()},
       queue_name_{settings.queue.GetUnderlying()},
       prefetch_count_{settings.prefetch_count},
+      max_batch_size_{settings.max_batch_size},
+      max_batch_delay_{settings.max_batch_delay},
+      batches_sema_{std::max<std::size_t>(settings.max_concurrent_batches, 1)},
       connection_ptr_{std::move(connection)},
       channel_{connection_ptr_->GetChannel()} {
   // We take ownership of the connection, because if it remains pooled
@@ -38,11 +50,17 @@ ConsumerBaseImpl::ConsumerBaseImpl(ConnectionPtr&& connection,
 
 ConsumerBaseImpl::~ConsumerBaseImpl() { Stop(); }
 
-void ConsumerBaseImpl::Start(DispatchCallback cb) {
+void ConsumerBaseImpl::Start(DispatchCallback cb,
+                             BatchDispatchCallback batch_cb) {
   const auto start_deadline = engine::Deadline::FromDuration(kStartTimeout);
   channel_.SetQos(prefetch_count_, start_deadline);
 
   dispatch_callback_ = std::move(cb);
+  batch_dispatch_callback_ = std::move(batch_cb);
+  if (max_batch_size_ != 0) {
+    bts_->Detach(
+        engine::AsyncNoSpan(dispatcher_, [this] { RunBatchDispatcher(); }));
+  }
 
   LOG_INFO() << "Starting a consumer for '" << queue_name_ << "' queue";
 
@@ -60,7 +78,10 @@ void ConsumerBaseImpl::Start(DispatchCallback cb) {
       [this](const AMQP::Message& message, uint64_t delivery_tag, bool) {
         // We received a message but won't ack it, so it will be requeued
         // at some point
-        if (!stopped_) {
+        if (stopped_) return;
+        if (max_batch_size_ != 0) {
+          OnBatchMessage(message, delivery_tag);
+        } else {
           OnMessage(message, delivery_tag);
         }
       },
@@ -98,11 +119,13 @@ void ConsumerBaseImpl::OnMessage(const AMQP::Message& message,
                                     consumer_tag_.value_or("ctag:unknown"))};
   std::string trace_id = message.headers().get("u-trace-id");
   std::string message_data{message.body(), message.bodySize()};
+  const auto delivered_at = std::chrono::steady_clock::now();
 
   bts_->Detach(engine::AsyncNoSpan(
-      dispatcher_, [this, message = std::move(message_data),
-                    span_name = std::move(span_name),
-                    trace_id = std::move(trace_id), delivery_tag]() mutable {
+      dispatcher_,
+      [this, message = std::move(message_data),
+       span_name = std::move(span_name), trace_id = std::move(trace_id),
+       delivery_tag, delivered_at]() mutable {
         auto span = tracing::Span::MakeSpan(std::move(span_name), trace_id, {});
 
         bool success = false;
@@ -117,7 +140,7 @@ void ConsumerBaseImpl::OnMessage(const AMQP::Message& message,
         try {
           if (success) {
             channel_.Ack(delivery_tag, {});
-            channel_.AccountMessageConsumed();
+            channel_.AccountMessageConsumed(GetLag(delivered_at));
           } else {
             channel_.Reject(delivery_tag, true, {});
           }
@@ -129,6 +152,113 @@ void ConsumerBaseImpl::OnMessage(const AMQP::Message& message,
       }));
 }
 
+void ConsumerBaseImpl::OnBatchMessage(const AMQP::Message& message,
+                                      uint64_t delivery_tag) {
+  {
+    std::lock_guard lock{acks_mutex_};
+    unsettled_tags_.insert(delivery_tag);
+  }
+
+  std::lock_guard lock{batch_mutex_};
+  batch_.push_back({std::string{message.body(), message.bodySize()},
+                    delivery_tag, std::chrono::steady_clock::now()});
+  if (batch_.size() == 1 || batch_.size() >= max_batch_size_) {
+    batch_cv_.NotifyOne();
+  }
+}
+
+void ConsumerBaseImpl::RunBatchDispatcher() {
+  std::unique_lock lock{batch_mutex_};
+  while (!engine::current_task::ShouldCancel()) {
+    if (batch_.empty()) {
+      [[maybe_unused]] const bool ok =
+          batch_cv_.Wait(lock, [this] { return !batch_.empty(); });
+      continue;
+    }
+
+    // Lets the batch fill up to max_batch_size or max_batch_delay,
+    // whichever comes first
+    [[maybe_unused]] const bool ok = batch_cv_.WaitUntil(
+        lock, batch_.front().delivered_at + max_batch_delay_,
+        [this] { return batch_.size() >= max_batch_size_; });
+    if (engine::current_task::ShouldCancel()) break;
+
+    std::vector<Delivery> batch;
+    if (batch_.size() <= max_batch_size_) {
+      batch.swap(batch_);
+    } else {
+      const auto batch_end = batch_.begin() + max_batch_size_;
+      batch.assign(std::make_move_iterator(batch_.begin()),
+                   std::make_move_iterator(batch_end));
+      batch_.erase(batch_.begin(), batch_end);
+    }
+    lock.unlock();
+
+    // The messages we give up on are requeued once the channel is closed
+    engine::SemaphoreLock slot{batches_sema_, engine::Deadline{}};
+    if (!slot.OwnsLock()) break;
+
+    bts_->Detach(engine::AsyncNoSpan(
+        dispatcher_, [this, batch = std::move(batch),
+                      slot = std::move(slot)]() mutable {
+          DispatchBatch(std::move(batch));
+        }));
+    lock.lock();
+  }
+}
+
+void ConsumerBaseImpl::DispatchBatch(std::vector<Delivery>&& batch) {
+  tracing::Span span{fmt::format("consume_batch_{}_{}", queue_name_,
+                                 consumer_tag_.value_or("ctag:unknown"))};
+  span.AddTag("batch_size", batch.size());
+
+  std::vector<std::string> messages;
+  messages.reserve(batch.size());
+  for (auto& delivery : batch) messages.push_back(std::move(delivery.message));
+
+  bool success = false;
+  try {
+    batch_dispatch_callback_(std::move(messages));
+    success = true;
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to process the consumed batch of " << batch.size()
+                << " messages, " << ex.what() << "; would requeue";
+  }
+
+  try {
+    SettleBatch(batch, success);
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Failed to " << (success ? "ack" : "requeue")
+                  << " the batch, it will be requeued by RabbitMQ at some "
+                     "point";
+  }
+}
+
+void ConsumerBaseImpl::SettleBatch(const std::vector<Delivery>& batch,
+                                   bool success) {
+  std::lock_guard lock{acks_mutex_};
+  for (const auto& delivery : batch) {
+    unsettled_tags_.erase(delivery.delivery_tag);
+    if (success) {
+      processed_tags_.insert(delivery.delivery_tag);
+      channel_.AccountMessageConsumed(GetLag(delivery.delivered_at));
+    } else {
+      channel_.Reject(delivery.delivery_tag, true, {});
+    }
+  }
+
+  // Batches may complete out of order, so only the processed messages that
+  // precede every unsettled one are acked. A `multiple` ack must name an
+  // unacked tag, hence the largest processed one is used.
+  auto ack_end = unsettled_tags_.empty()
+                     ? processed_tags_.end()
+                     : processed_tags_.lower_bound(*unsettled_tags_.begin());
+  if (ack_end == processed_tags_.begin()) return;
+
+  channel_.AckMultiple(*std::prev(ack_end), {});
+  processed_tags_.erase(processed_tags_.begin(), ack_end);
+}
+
 }  // namespace urabbitmq
 
 USERVER_NAMESPACE_END
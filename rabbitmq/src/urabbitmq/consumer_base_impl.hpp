@@ -1,8 +1,14 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <set>
+#include <vector>
 
 #include <userver/concurrent/background_task_storage_fwd.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/semaphore.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 
 #include <urabbitmq/connection_ptr.hpp>
@@ -26,25 +32,53 @@ class ConsumerBaseImpl final {
   ~ConsumerBaseImpl();
 
   using DispatchCallback = std::function<void(std::string message)>;
+  using BatchDispatchCallback =
+      std::function<void(std::vector<std::string> messages)>;
 
-  void Start(DispatchCallback cb);
+  void Start(DispatchCallback cb, BatchDispatchCallback batch_cb);
 
   bool IsBroken() const;
 
  private:
+  struct Delivery final {
+    std::string message;
+    uint64_t delivery_tag;
+    std::chrono::steady_clock::time_point delivered_at;
+  };
+
   void OnMessage(const AMQP::Message& message, uint64_t delivery_tag);
+  void OnBatchMessage(const AMQP::Message& message, uint64_t delivery_tag);
+  void RunBatchDispatcher();
+  void DispatchBatch(std::vector<Delivery>&& batch);
+  void SettleBatch(const std::vector<Delivery>& batch, bool success);
   void Stop();
 
   engine::TaskProcessor& dispatcher_;
   const std::string queue_name_;
   uint16_t prefetch_count_;
 
+  const std::size_t max_batch_size_;
+  const std::chrono::milliseconds max_batch_delay_;
+  engine::Semaphore batches_sema_;
+
+  engine::Mutex batch_mutex_;
+  engine::ConditionVariable batch_cv_;
+  std::vector<Delivery> batch_;
+
+  // Delivered messages that are neither acked nor rejected yet. A `multiple`
+  // ack covers every unacked message up to the tag, so it may never reach
+  // past the smallest of these.
+  engine::Mutex acks_mutex_;
+  std::set<uint64_t> unsettled_tags_;
+  std::set<uint64_t> processed_tags_;
+
   ConnectionPtr connection_ptr_;
   impl::AmqpChannel& channel_;
 
   std::optional<std::string> consumer_tag_;
 
   DispatchCallback dispatch_callback_;
+  BatchDispatchCallback batch_dispatch_callback_;
 
   std::atomic<bool> stopped_{false};
 
@@ -1,5 +1,7 @@
 #include <userver/urabbitmq/consumer_component_base.hpp>
 
+#include <stdexcept>
+
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
@@ -17,7 +19,16 @@ ConsumerSettings Parse(const yaml_config::YamlConfig& config,
   settings.queue = Queue{config["queue"].As<std::string>()};
   settings.prefetch_count = config["prefetch_count"].As<uint16_t>();
 
+  settings.max_batch_size =
+      config["max_batch_size"].As<std::size_t>(settings.max_batch_size);
+  settings.max_batch_delay = config["max_batch_delay"].As<
+      std::chrono::milliseconds>(settings.max_batch_delay);
+  settings.max_concurrent_batches = config["max_concurrent_batches"].As<
+      std::size_t>(settings.max_concurrent_batches);
+
   UINVARIANT(settings.prefetch_count > 0, "prefetch_count is set to zero");
+  UINVARIANT(settings.max_concurrent_batches > 0,
+             "max_concurrent_batches is set to zero");
 
   return settings;
 }
@@ -40,6 +51,11 @@ class ConsumerComponentBase::Impl final : public ConsumerBase {
     parent_->Process(std::move(message));
   }
 
+  void ProcessBatch(std::vector<std::string> messages) override {
+    UASSERT(parent_ != nullptr);
+    parent_->ProcessBatch(std::move(messages));
+  }
+
  private:
   ConsumerComponentBase* parent_{nullptr};
 };
@@ -61,6 +77,15 @@ void ConsumerComponentBase::OnAllComponentsLoaded() { impl_->Start(this); }
 
 void ConsumerComponentBase::OnAllComponentsAreStopping() { impl_->Stop(); }
 
+void ConsumerComponentBase::Process(std::string) {
+  throw std::logic_error{
+      "Neither Process nor ProcessBatch is overridden by the consumer"};
+}
+
+void ConsumerComponentBase::ProcessBatch(std::vector<std::string> messages) {
+  for (auto& message : messages) Process(std::move(message));
+}
+
 yaml_config::Schema ConsumerComponentBase::GetStaticConfigSchema() {
   return yaml_config::MergeSchemas<components::LoggableComponentBase>(R"(
 type: object
@@ -76,6 +101,20 @@ properties:
     prefetch_count:
         type: integer
         description: prefetch_count for the consumer
+    max_batch_size:
+        type: integer
+        description: |
+            hand the messages over to ProcessBatch in batches of up to this
+            size, 0 to use Process for every message
+        defaultDescription: 0
+    max_batch_delay:
+        type: string
+        description: hand a batch over once its first message waited this long
+        defaultDescription: 100ms
+    max_concurrent_batches:
+        type: integer
+        description: limit for the batches processed concurrently
+        defaultDescription: 1
 )");
 }
 
@@ -70,6 +70,22 @@ AMQP::Table CreateHeaders() {
   return headers;
 }
 
+// Sends the method, header and body frames of a message with a single write
+// where possible, must be created under the connection lock
+class WritesBatchGuard final {
+ public:
+  explicit WritesBatchGuard(AmqpConnection& conn) : conn_{conn} {
+    conn_.StartWritesBatch();
+  }
+  ~WritesBatchGuard() { conn_.FlushWritesBatch(); }
+
+  WritesBatchGuard(const WritesBatchGuard&) = delete;
+  WritesBatchGuard& operator=(const WritesBatchGuard&) = delete;
+
+ private:
+  AmqpConnection& conn_;
+};
+
 }  // namespace
 
 AmqpChannel::AmqpChannel(AmqpConnection& conn) : conn_{conn} {}
@@ -146,7 +162,7 @@ ResponseAwaiter AmqpChannel::RemoveQueue(const Queue& queue,
 
 void AmqpChannel::Publish(const Exchange& exchange,
                           const std::string& routing_key,
-                          const std::string& message, MessageType type,
+                          std::string_view message, MessageType type,
                           engine::Deadline deadline) {
   AMQP::Envelope envelope{message.data(), message.size()};
   envelope.setPersistent(type == MessageType::kPersistent);
@@ -154,6 +170,7 @@ void AmqpChannel::Publish(const Exchange& exchange,
 
   {
     auto channel = conn_.GetChannel(deadline);
+    const WritesBatchGuard writes_batch{conn_};
 
     // We don't care about the result here,
     // even thought publish() could fail synchronously (connection breakage,
@@ -170,6 +187,12 @@ void AmqpChannel::Ack(uint64_t delivery_tag, engine::Deadline deadline) {
   channel->ack(delivery_tag);
 }
 
+void AmqpChannel::AckMultiple(uint64_t delivery_tag,
+                              engine::Deadline deadline) {
+  auto channel = conn_.GetChannel(deadline);
+  channel->ack(delivery_tag, AMQP::multiple);
+}
+
 void AmqpChannel::Reject(uint64_t delivery_tag, bool requeue,
                          engine::Deadline deadline) {
   // No way to acknowledge success, no way to handle synchronous errors
@@ -209,8 +232,9 @@ void AmqpChannel::CancelConsumer(
   }
 }
 
-void AmqpChannel::AccountMessageConsumed() {
-  conn_.GetStatistics().AccountMessageConsumed();
+void AmqpChannel::AccountMessageConsumed(
+    std::chrono::milliseconds processing_lag) {
+  conn_.GetStatistics().AccountMessageConsumed(processing_lag);
 }
 
 AmqpReliableChannel::AmqpReliableChannel(AmqpConnection& conn) : conn_{conn} {}
@@ -219,7 +243,7 @@ AmqpReliableChannel::~AmqpReliableChannel() = default;
 
 ResponseAwaiter AmqpReliableChannel::Publish(const Exchange& exchange,
                                              const std::string& routing_key,
-                                             const std::string& message,
+                                             std::string_view message,
                                              MessageType type,
                                              engine::Deadline deadline) {
   AMQP::Envelope envelope{message.data(), message.size()};
@@ -230,6 +254,7 @@ ResponseAwaiter AmqpReliableChannel::Publish(const Exchange& exchange,
 
   {
     auto reliable = conn_.GetReliableChannel(deadline);
+    const WritesBatchGuard writes_batch{conn_};
 
     reliable->publish(exchange.GetUnderlying(), routing_key, envelope)
         .onAck([this, deferred = awaiter.GetWrapper()] {
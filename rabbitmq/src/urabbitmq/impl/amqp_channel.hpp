@@ -1,7 +1,10 @@
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <string>
+#include <string_view>
 
 #include <userver/engine/deadline.hpp>
 #include <userver/utils/assert.hpp>
@@ -51,10 +54,12 @@ class AmqpChannel final {
   ResponseAwaiter RemoveQueue(const Queue& queue, engine::Deadline deadline);
 
   void Publish(const Exchange& exchange, const std::string& routing_key,
-               const std::string& message, MessageType type,
+               std::string_view message, MessageType type,
                engine::Deadline deadline);
 
   void Ack(uint64_t delivery_tag, engine::Deadline deadline);
+  // Acks every unacked message up to and including `delivery_tag`
+  void AckMultiple(uint64_t delivery_tag, engine::Deadline deadline);
 
   void Reject(uint64_t delivery_tag, bool requeue, engine::Deadline deadline);
 
@@ -70,7 +75,7 @@ class AmqpChannel final {
   void CancelConsumer(const std::optional<std::string>& consumer_tag);
 
  private:
-  void AccountMessageConsumed();
+  void AccountMessageConsumed(std::chrono::milliseconds processing_lag);
 
   friend class urabbitmq::ConsumerBaseImpl;
 
@@ -84,7 +89,7 @@ class AmqpReliableChannel final {
 
   ResponseAwaiter Publish(const Exchange& exchange,
                           const std::string& routing_key,
-                          const std::string& message, MessageType type,
+                          std::string_view message, MessageType type,
                           engine::Deadline deadline);
 
  private:
@@ -71,6 +71,10 @@ void AmqpConnection::SetOperationDeadline(engine::Deadline deadline) {
   handler_.SetOperationDeadline(deadline);
 }
 
+void AmqpConnection::StartWritesBatch() { handler_.StartWritesBatch(); }
+
+void AmqpConnection::FlushWritesBatch() { handler_.FlushWritesBatch(&conn_); }
+
 statistics::ConnectionStatistics& AmqpConnection::GetStatistics() {
   return handler_.GetStatistics();
 }
@@ -92,7 +96,15 @@ ResponseAwaiter AmqpConnection::GetAwaiter(engine::Deadline deadline) {
         "Failed to acquire a connection within specified deadline"};
   }
 
-  return ResponseAwaiter{std::move(lock)};
+  return ResponseAwaiter{std::move(lock), GetStatistics()};
+}
+
+size_t AmqpConnection::GetMaxInFlightRequests() const {
+  return waiters_sema_.GetCapacity();
+}
+
+size_t AmqpConnection::GetFreeInFlightSlotsApprox() const {
+  return waiters_sema_.RemainingApprox();
 }
 
 ConnectionLock AmqpConnection::Lock(engine::Deadline deadline) {
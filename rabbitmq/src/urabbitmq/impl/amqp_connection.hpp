@@ -58,6 +58,9 @@ class AmqpConnection final {
 
   void SetOperationDeadline(engine::Deadline deadline);
 
+  void StartWritesBatch();
+  void FlushWritesBatch();
+
   statistics::ConnectionStatistics& GetStatistics();
 
   LockedChannelProxy<AMQP::Channel> GetChannel(engine::Deadline deadline);
@@ -68,6 +71,9 @@ class AmqpConnection final {
 
   ResponseAwaiter GetAwaiter(engine::Deadline deadline);
 
+  size_t GetMaxInFlightRequests() const;
+  size_t GetFreeInFlightSlotsApprox() const;
+
  private:
   friend class AmqpConnectionLocker;
   [[nodiscard]] ConnectionLock Lock(engine::Deadline deadline);
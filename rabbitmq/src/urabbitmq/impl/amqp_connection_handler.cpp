@@ -19,6 +19,10 @@ namespace urabbitmq::impl {
 
 namespace {
 
+// Larger frames (message bodies, mostly) are written right away instead of
+// being copied into the batch
+constexpr size_t kMaxBatchedWriteSize = 16 * 1024;
+
 engine::io::Socket CreateSocket(engine::io::Sockaddr& addr,
                                 engine::Deadline deadline) {
   engine::io::Socket socket{addr.Domain(), engine::io::SocketType::kTcp};
@@ -73,6 +77,7 @@ AmqpConnectionHandler::AmqpConnectionHandler(
     statistics::ConnectionStatistics& stats, engine::Deadline deadline)
     : address_{ToAmqpAddress(endpoint, auth_settings, secure)},
       socket_{CreateSocketPtr(resolver, address_, deadline)},
+      plain_socket_{dynamic_cast<engine::io::Socket*>(socket_.get())},
       reader_{*this, *socket_},
       stats_{stats} {}
 
@@ -92,14 +97,57 @@ void AmqpConnectionHandler::onData(AMQP::Connection* connection,
     return;
   }
 
+  if (batching_writes_ &&
+      pending_writes_.size() + size <= kMaxBatchedWriteSize) {
+    pending_writes_.append(buffer, size);
+    return;
+  }
+
+  Write(connection, buffer, size);
+}
+
+void AmqpConnectionHandler::StartWritesBatch() { batching_writes_ = true; }
+
+void AmqpConnectionHandler::FlushWritesBatch(AMQP::Connection* connection) {
+  batching_writes_ = false;
+  if (pending_writes_.empty()) return;
+
+  if (IsBroken()) {
+    pending_writes_.clear();
+    return;
+  }
+  Write(connection, nullptr, 0);
+}
+
+void AmqpConnectionHandler::Write(AMQP::Connection* connection,
+                                  const char* buffer, size_t size) {
+  const auto total_size = pending_writes_.size() + size;
   try {
-    const auto sent = socket_->WriteAll(buffer, size, operation_deadline_);
-    if (sent != size) {
+    size_t sent = 0;
+    if (pending_writes_.empty()) {
+      sent = socket_->WriteAll(buffer, size, operation_deadline_);
+    } else if (size == 0) {
+      sent = socket_->WriteAll(pending_writes_.data(), pending_writes_.size(),
+                               operation_deadline_);
+    } else if (plain_socket_ != nullptr) {
+      sent = plain_socket_->SendAll(
+          {{pending_writes_.data(), pending_writes_.size()}, {buffer, size}},
+          operation_deadline_);
+    } else {
+      sent = socket_->WriteAll(pending_writes_.data(), pending_writes_.size(),
+                               operation_deadline_);
+      if (sent == pending_writes_.size()) {
+        sent += socket_->WriteAll(buffer, size, operation_deadline_);
+      }
+    }
+    pending_writes_.clear();
+    if (sent != total_size) {
       throw std::runtime_error{"Connection reset by peer"};
     }
 
-    AccountWrite(size);
+    AccountWrite(total_size);
   } catch (const std::exception& ex) {
+    pending_writes_.clear();
     LOG_ERROR() << "Failed to send data to socket: " << ex;
     Invalidate();
 
@@ -16,6 +16,7 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::io {
 class RwBase;
+class Socket;
 }
 
 namespace urabbitmq {
@@ -69,6 +70,11 @@ class AmqpConnectionHandler final : public AMQP::ConnectionHandler {
 
   void SetOperationDeadline(engine::Deadline deadline);
 
+  // The frames sent until the flush are coalesced into as few socket writes
+  // as possible. Both are to be called under the connection lock.
+  void StartWritesBatch();
+  void FlushWritesBatch(AMQP::Connection* connection);
+
   void AccountRead(size_t size);
   void AccountWrite(size_t size);
 
@@ -77,8 +83,12 @@ class AmqpConnectionHandler final : public AMQP::ConnectionHandler {
   const AMQP::Address& GetAddress() const;
 
  private:
+  void Write(AMQP::Connection* connection, const char* buffer, size_t size);
+
   AMQP::Address address_;
   std::unique_ptr<engine::io::RwBase> socket_;
+  // Set for non-TLS connections, which support vectored writes
+  engine::io::Socket* plain_socket_;
   io::SocketReader reader_;
 
   engine::SingleConsumerEvent connection_ready_event_;
@@ -88,6 +98,9 @@ class AmqpConnectionHandler final : public AMQP::ConnectionHandler {
 
   engine::Deadline operation_deadline_ = engine::Deadline::Passed();
 
+  bool batching_writes_{false};
+  std::string pending_writes_;
+
   std::atomic<bool> is_ready_{false};
   std::optional<std::string> error_;
 };
@@ -1,28 +1,44 @@
 #include "response_awaiter.hpp"
 
+#include <utility>
+
 #ifndef NDEBUG
 #include <userver/utils/assert.hpp>
 #endif
 
 #include <urabbitmq/impl/deferred_wrapper.hpp>
+#include <urabbitmq/statistics/connection_statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace urabbitmq::impl {
 
-ResponseAwaiter::ResponseAwaiter(engine::SemaphoreLock&& lock)
-    : lock_{std::move(lock)}, wrapper_{DeferredWrapper::Create()} {}
+ResponseAwaiter::ResponseAwaiter(engine::SemaphoreLock&& lock,
+                                 statistics::ConnectionStatistics& stats)
+    : lock_{std::move(lock)},
+      stats_{&stats},
+      wrapper_{DeferredWrapper::Create()} {
+  stats_->AccountRequestStarted();
+}
 
-#ifndef NDEBUG
 ResponseAwaiter::~ResponseAwaiter() {
+#ifndef NDEBUG
   UASSERT_MSG(awaited_,
               "ResponseAwaiter dropped without waiting, shouldn't happen");
-}
-#else
-ResponseAwaiter::~ResponseAwaiter() = default;
 #endif
+  if (stats_) stats_->AccountRequestFinished();
+}
 
-ResponseAwaiter::ResponseAwaiter(ResponseAwaiter&& other) noexcept = default;
+ResponseAwaiter::ResponseAwaiter(ResponseAwaiter&& other) noexcept
+    :
+#ifndef NDEBUG
+      // a moved-out awaiter has nothing to wait for
+      awaited_{std::exchange(other.awaited_, true)},
+#endif
+      span_{std::move(other.span_)},
+      lock_{std::move(other.lock_)},
+      stats_{std::exchange(other.stats_, nullptr)},
+      wrapper_{std::move(other.wrapper_)} {}
 
 void ResponseAwaiter::SetSpan(tracing::Span&& span) {
   span_.emplace(std::move(span));
@@ -8,13 +8,18 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace urabbitmq::statistics {
+class ConnectionStatistics;
+}
+
 namespace urabbitmq::impl {
 
 class DeferredWrapper;
 
 class ResponseAwaiter final {
  public:
-  ResponseAwaiter(engine::SemaphoreLock&& lock);
+  ResponseAwaiter(engine::SemaphoreLock&& lock,
+                  statistics::ConnectionStatistics& stats);
   ~ResponseAwaiter();
 
   ResponseAwaiter(const ResponseAwaiter& other) = delete;
@@ -32,6 +37,7 @@ class ResponseAwaiter final {
 
   std::optional<tracing::Span> span_;
   engine::SemaphoreLock lock_;
+  statistics::ConnectionStatistics* stats_;
   std::shared_ptr<DeferredWrapper> wrapper_;
 };
 
@@ -20,9 +20,17 @@ void ConnectionStatistics::AccountRead(size_t bytes_read) {
   bytes_read_ += bytes_read;
 }
 
+void ConnectionStatistics::AccountRequestStarted() { ++requests_in_flight_; }
+
+void ConnectionStatistics::AccountRequestFinished() { --requests_in_flight_; }
+
 void ConnectionStatistics::AccountMessagePublished() { ++messages_published_; }
 
-void ConnectionStatistics::AccountMessageConsumed() { ++messages_consumed_; }
+void ConnectionStatistics::AccountMessageConsumed(
+    std::chrono::milliseconds processing_lag) {
+  ++messages_consumed_;
+  processing_lag_ms_ += processing_lag.count();
+}
 
 ConnectionStatistics::Frozen ConnectionStatistics::Get() const {
   Frozen result{};
@@ -32,6 +40,8 @@ ConnectionStatistics::Frozen ConnectionStatistics::Get() const {
   result.bytes_read = bytes_read_.Load();
   result.messages_published = messages_published_.Load();
   result.messages_consumed = messages_consumed_.Load();
+  result.processing_lag_ms = processing_lag_ms_.Load();
+  result.requests_in_flight = requests_in_flight_.Load();
 
   return result;
 }
@@ -44,6 +54,8 @@ ConnectionStatistics::Frozen& ConnectionStatistics::Frozen::operator+=(
   bytes_read += other.bytes_read;
   messages_published += other.messages_published;
   messages_consumed += other.messages_consumed;
+  processing_lag_ms += other.processing_lag_ms;
+  requests_in_flight += other.requests_in_flight;
 
   return *this;
 }
@@ -57,6 +69,8 @@ formats::json::Value Serialize(const ConnectionStatistics::Frozen& value,
   builder["bytes_read"] = value.bytes_read;
   builder["messages_published"] = value.messages_published;
   builder["messages_consumed"] = value.messages_consumed;
+  builder["processing_lag_ms"] = value.processing_lag_ms;
+  builder["requests_in_flight"] = value.requests_in_flight;
 
   return builder.ExtractValue();
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 
 #include <userver/formats/json/serialize.hpp>
@@ -17,8 +18,12 @@ class ConnectionStatistics final {
   void AccountWrite(size_t bytes_written);
   void AccountRead(size_t bytes_read);
 
+  void AccountRequestStarted();
+  void AccountRequestFinished();
+
   void AccountMessagePublished();
-  void AccountMessageConsumed();
+  // `processing_lag` is the time from the delivery to the ack
+  void AccountMessageConsumed(std::chrono::milliseconds processing_lag);
 
   struct Frozen final {
     Frozen& operator+=(const Frozen& other);
@@ -31,6 +36,9 @@ class ConnectionStatistics final {
 
     size_t messages_published{0};
     size_t messages_consumed{0};
+    size_t processing_lag_ms{0};
+
+    size_t requests_in_flight{0};
   };
   Frozen Get() const;
 
@@ -43,6 +51,9 @@ class ConnectionStatistics final {
 
   utils::statistics::RelaxedCounter<size_t> messages_published_{0};
   utils::statistics::RelaxedCounter<size_t> messages_consumed_{0};
+  utils::statistics::RelaxedCounter<size_t> processing_lag_ms_{0};
+
+  utils::statistics::RelaxedCounter<size_t> requests_in_flight_{0};
 };
 
 formats::json::Value Serialize(const ConnectionStatistics::Frozen& value,
@@ -4,8 +4,12 @@
 /// @brief @copybrief storages::redis::Client
 
 #include <chrono>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <userver/storages/redis/impl/base.hpp>
 #include <userver/storages/redis/impl/wait_connected_mode.hpp>
@@ -30,6 +34,25 @@ using RetryNilFromMaster = USERVER_NAMESPACE::redis::RetryNilFromMaster;
 
 inline constexpr RetryNilFromMaster kRetryNilFromMaster{};
 
+/// @brief Result of Client::MgetAcrossShards
+struct MgetAcrossShardsResult {
+  /// Values in the order of the requested keys, std::nullopt for the missing
+  /// keys and for the keys of the failed requests
+  std::vector<std::optional<std::string>> values;
+  /// Indices of the keys of the failed requests, in ascending order
+  std::vector<size_t> failed_keys;
+
+  bool IsComplete() const { return failed_keys.empty(); }
+};
+
+/// @brief Result of Client::MsetAcrossShards
+struct MsetAcrossShardsResult {
+  /// Indices of the keys of the failed requests, in ascending order
+  std::vector<size_t> failed_keys;
+
+  bool IsComplete() const { return failed_keys.empty(); }
+};
+
 /// @ingroup userver_clients
 ///
 /// @brief Redis client.
@@ -47,6 +70,10 @@ class Client {
 
   virtual size_t ShardByKey(const std::string& key) const = 0;
 
+  /// @returns true if the client works with a redis cluster, where the keys
+  /// of a multi-key command must belong to the same hash slot
+  virtual bool IsInClusterMode() const { return false; }
+
   void CheckShardIdx(size_t shard_idx) const;
 
   virtual const std::string& GetAnyKeyForShard(size_t shard_idx) const = 0;
@@ -447,6 +474,37 @@ class Client {
 
   RequestZscan Zscan(std::string key, const CommandControl& command_control);
 
+  /// @brief MGET of the keys of any shards.
+  ///
+  /// Unlike Mget, the keys are not required to belong to the same shard: they
+  /// are grouped by shards (by hash slots in the cluster mode), the requests
+  /// to the groups are sent at once and the values are returned in the order
+  /// of the keys. A failed request does not fail the call, its keys are
+  /// reported in MgetAcrossShardsResult::failed_keys.
+  MgetAcrossShardsResult MgetAcrossShards(
+      std::vector<std::string> keys, const CommandControl& command_control);
+
+  /// @brief MSET of the keys of any shards.
+  ///
+  /// The keys are grouped the same way as in MgetAcrossShards, the keys of
+  /// the failed requests are reported in MsetAcrossShardsResult::failed_keys.
+  /// @note The values are set atomically only within a group.
+  MsetAcrossShardsResult MsetAcrossShards(
+      std::vector<std::pair<std::string, std::string>> key_values,
+      const CommandControl& command_control);
+
+  /// @brief SCAN of all the shards, up to `max_concurrency` shards are
+  /// scanned at once.
+  ///
+  /// Each shard is scanned with Scan(), which requests the next page as soon
+  /// as the current one is received. `on_key` is called for every key, it is
+  /// called concurrently for the keys of the different shards.
+  /// @throws the first error of the shard scans, the rest of the scans are
+  /// cancelled
+  void ScanAllShards(ScanOptions options, size_t max_concurrency,
+                     const std::function<void(std::string key)>& on_key,
+                     const CommandControl& command_control);
+
  protected:
   virtual RequestEvalCommon EvalCommon(
       std::string script, std::vector<std::string> keys,
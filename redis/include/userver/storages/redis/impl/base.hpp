@@ -261,12 +261,16 @@ struct MetricsSettings {
   bool command_timings_enabled{false};
   bool request_sizes_enabled{false};
   bool reply_sizes_enabled{false};
+  bool batch_sizes_enabled{false};
+  bool pipeline_depth_enabled{false};
 
   constexpr bool operator==(const MetricsSettings& rhs) const {
     return timings_enabled == rhs.timings_enabled &&
            command_timings_enabled == rhs.command_timings_enabled &&
            request_sizes_enabled == rhs.request_sizes_enabled &&
-           reply_sizes_enabled == rhs.reply_sizes_enabled;
+           reply_sizes_enabled == rhs.reply_sizes_enabled &&
+           batch_sizes_enabled == rhs.batch_sizes_enabled &&
+           pipeline_depth_enabled == rhs.pipeline_depth_enabled;
   }
 
   constexpr bool operator!=(const MetricsSettings& rhs) const {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <chrono>
@@ -10,6 +11,7 @@
 #include <userver/storages/redis/impl/base.hpp>
 #include <userver/storages/redis/impl/types.hpp>
 #include <userver/utils/statistics/aggregated_values.hpp>
+#include <userver/utils/statistics/hdr_histogram.hpp>
 #include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
 
@@ -31,11 +33,16 @@ class Statistics {
 
   void AccountStateChanged(RedisState new_state);
   void AccountCommandSent(const CommandPtr& cmd);
+  void AccountCommandsBatch(size_t commands_count);
   void AccountReplyReceived(const ReplyPtr& reply, const CommandPtr& cmd);
   void AccountPing(std::chrono::milliseconds ping);
   void AccountError(int code);
 
+#ifdef USERVER_FEATURE_HDR_HISTOGRAM_TIMINGS
+  using Percentile = utils::statistics::HdrHistogram<>;
+#else
   using Percentile = utils::statistics::Percentile<2048>;
+#endif
   using RecentPeriod =
       utils::statistics::RecentPeriod<Percentile, Percentile,
                                       utils::datetime::SteadyClock>;
@@ -45,6 +52,7 @@ class Statistics {
   std::atomic<std::chrono::milliseconds> session_start_time{};
   RecentPeriod request_size_percentile;
   RecentPeriod reply_size_percentile;
+  RecentPeriod batch_size_percentile;
   RecentPeriod timings_percentile;
   std::unordered_map<std::string_view, RecentPeriod> command_timings_percentile;
   std::atomic_llong last_ping_ms{};
@@ -63,6 +71,7 @@ struct InstanceStatistics {
         request_size_percentile(
             other.request_size_percentile.GetStatsForPeriod()),
         reply_size_percentile(other.reply_size_percentile.GetStatsForPeriod()),
+        batch_size_percentile(other.batch_size_percentile.GetStatsForPeriod()),
         timings_percentile(other.timings_percentile.GetStatsForPeriod()),
         last_ping_ms(other.last_ping_ms.load(std::memory_order_relaxed)),
         is_syncing(other.is_syncing.load(std::memory_order_relaxed)),
@@ -81,8 +90,13 @@ struct InstanceStatistics {
 
   void Add(const InstanceStatistics& other) {
     reconnects += other.reconnects;
+    connections += other.connections;
+    pending_commands += other.pending_commands;
+    max_pending_commands =
+        std::max(max_pending_commands, other.max_pending_commands);
     request_size_percentile.Add(other.request_size_percentile);
     reply_size_percentile.Add(other.reply_size_percentile);
+    batch_size_percentile.Add(other.batch_size_percentile);
     timings_percentile.Add(other.timings_percentile);
 
     for (size_t i = 0; i < error_count.size(); i++)
@@ -97,12 +111,18 @@ struct InstanceStatistics {
   std::chrono::milliseconds session_start_time;
   Statistics::Percentile request_size_percentile;
   Statistics::Percentile reply_size_percentile;
+  Statistics::Percentile batch_size_percentile;
   Statistics::Percentile timings_percentile;
   std::unordered_map<std::string, Statistics::Percentile>
       command_timings_percentile;
   long long last_ping_ms;
   bool is_syncing;
   long long offset_from_master;
+  // Number of the connections to the instance and the numbers of the commands
+  // sent to them and waiting for the replies
+  size_t connections{0};
+  size_t pending_commands{0};
+  size_t max_pending_commands{0};
 
   std::array<long long, REDIS_ERR_MAX + 1> error_count{{}};
 };
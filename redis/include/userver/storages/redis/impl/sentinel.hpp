@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -103,6 +104,9 @@ class Sentinel {
 
   size_t ShardByKey(const std::string& key) const;
   size_t ShardsCount() const;
+  bool IsInClusterMode() const;
+  // Hash slot of the key in the redis cluster mode
+  static size_t HashSlot(const std::string& key);
   void CheckShardIdx(size_t shard_idx) const;
   static void CheckShardIdx(size_t shard_idx, size_t shard_count);
 
@@ -116,6 +120,10 @@ class Sentinel {
       CommandsBufferingSettings commands_buffering_settings);
   void SetReplicationMonitoringSettings(
       const ReplicationMonitoringSettings& replication_monitoring_settings);
+  /// Sets the number of the connections to each master and slave, the
+  /// connections are spread over the redis thread pool and the commands are
+  /// sent to the connection with the least commands in flight
+  void SetConnectionsPerInstance(size_t connections_per_instance);
 
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
   boost::signals2::signal<void(size_t shard)> signal_instances_changed;
@@ -157,6 +165,14 @@ class Sentinel {
       std::function<void(const std::string& pattern, const std::string& channel,
                          const std::string& message)>;
 
+  /// Message buffer shared by all the local subscribers of a channel
+  using SharedMessage = std::shared_ptr<const std::string>;
+  using UserSharedMessageCallback = std::function<void(
+      const std::string& channel, const SharedMessage& message)>;
+  using UserSharedPmessageCallback = std::function<void(
+      const std::string& pattern, const std::string& channel,
+      const SharedMessage& message)>;
+
   using MessageCallback =
       std::function<void(ServerId server_id, const std::string& channel,
                          const std::string& message)>;
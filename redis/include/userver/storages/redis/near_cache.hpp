@@ -0,0 +1,95 @@
+#pragma once
+
+/// @file userver/storages/redis/near_cache.hpp
+/// @brief @copybrief storages::redis::NearCache
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <userver/cache/expirable_lru_cache.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/storages/redis/client_fwd.hpp>
+#include <userver/storages/redis/command_options.hpp>
+#include <userver/storages/redis/subscription_token.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+struct NearCacheSettings {
+  /// Number of the independently locked parts of the cache
+  size_t ways{16};
+  /// Max number of the keys in each way
+  size_t way_size{1024};
+  /// Upper bound of the staleness of a value: the value is refetched after
+  /// this time even if no invalidation was received, e.g. due to a
+  /// resubscription
+  std::chrono::milliseconds max_lifetime{1000};
+  /// Prefix of the cached keys, the keyspace notifications are received for
+  /// the keys with this prefix only
+  std::string key_prefix;
+  /// Number of the redis database of the keys
+  size_t db{0};
+};
+
+/// @brief Per-process cache of the GET results of the hot redis keys.
+///
+/// A key is dropped from the cache when a keyspace notification of the key
+/// modification is received from any shard. The notifications must be enabled
+/// on the redis servers, e.g. with `notify-keyspace-events K$gxe` for the
+/// string keys. If a notification is lost, the value is still refetched after
+/// NearCacheSettings::max_lifetime.
+///
+/// A value fetched concurrently with an invalidation is not cached, so the
+/// cache never returns a value older than the last received invalidation.
+///
+/// @code
+/// storages::redis::NearCache cache{client, subscribe_client, settings};
+/// const auto value = cache.Get("prefix:key", command_control);
+/// @endcode
+class NearCache final {
+ public:
+  NearCache(ClientPtr client, SubscribeClientPtr subscribe_client,
+            const NearCacheSettings& settings);
+  ~NearCache();
+
+  NearCache(const NearCache&) = delete;
+  NearCache& operator=(const NearCache&) = delete;
+
+  /// @brief GET of the key, served from the cache if the key is there.
+  /// @note The keys that do not start with NearCacheSettings::key_prefix are
+  /// never cached
+  std::optional<std::string> Get(const std::string& key,
+                                 const CommandControl& command_control);
+
+  /// Drops the key from the cache
+  void InvalidateByKey(const std::string& key);
+
+  /// Drops all the keys from the cache
+  void Invalidate();
+
+  /// Cache statistics in the format of the LRU cache components, with the
+  /// received invalidations count and the staleness bound
+  formats::json::Value GetStatisticsAsJson() const;
+
+ private:
+  void OnKeyspaceNotification(const std::string& channel);
+
+  ClientPtr client_;
+  const std::string key_prefix_;
+  const std::string channel_prefix_;
+  cache::ExpirableLruCache<std::string, std::optional<std::string>> cache_;
+  // Bumped on every invalidation, a value is stored only if no invalidation
+  // happened while it was fetched
+  std::atomic<std::size_t> invalidation_epoch_{0};
+  std::atomic<std::size_t> invalidations_{0};
+  SubscriptionToken subscription_;
+};
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
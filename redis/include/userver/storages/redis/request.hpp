@@ -52,6 +52,12 @@ class USERVER_NODISCARD Request final {
   std::unique_ptr<RequestDataBase<ReplyType>> impl_;
 };
 
+/// @brief Iterates over the keys or the elements returned by the SCAN family
+/// commands.
+///
+/// The request for the next page is sent as soon as the current page is
+/// received, so the next page is usually ready by the time the current one is
+/// consumed.
 template <ScanTag scan_tag>
 class ScanRequest final {
  public:
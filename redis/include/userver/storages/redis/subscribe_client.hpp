@@ -32,6 +32,12 @@ namespace storages::redis {
 /// Some messages may be lost (it's a redis limitation).
 /// @note The first callback execution can happen before `Subscribe()` or
 /// `Psubscribe()` return as it happens in a separate task.
+///
+/// On a hot channel use `SubscribeBatched()` or `PsubscribeBatched()`: the
+/// callback receives all the messages queued since its previous call at once,
+/// and may be called from several tasks concurrently if
+/// SubscriptionBatchSettings::workers_count is more than one. The message
+/// buffers are shared with the other local subscribers of the channel.
 /// @note a good GMock-based mock for this class can be found here:
 /// userver/storages/redis/mock_subscribe_client.hpp
 class SubscribeClient {
@@ -55,6 +61,20 @@ class SubscribeClient {
                                SubscriptionToken::OnPmessageCb on_pmessage_cb) {
     return Psubscribe(std::move(pattern), std::move(on_pmessage_cb), {});
   }
+
+  /// The default implementation delivers the messages one by one through
+  /// `Subscribe()`
+  virtual SubscriptionToken SubscribeBatched(
+      std::string channel, SubscriptionToken::OnMessagesCb on_messages_cb,
+      const SubscriptionBatchSettings& batch_settings,
+      const USERVER_NAMESPACE::redis::CommandControl& command_control);
+
+  /// The default implementation delivers the messages one by one through
+  /// `Psubscribe()`
+  virtual SubscriptionToken PsubscribeBatched(
+      std::string pattern, SubscriptionToken::OnPmessagesCb on_pmessages_cb,
+      const SubscriptionBatchSettings& batch_settings,
+      const USERVER_NAMESPACE::redis::CommandControl& command_control);
 };
 
 }  // namespace storages::redis
@@ -3,6 +3,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -13,6 +14,17 @@ class SubscribeSentinel;
 
 namespace storages::redis {
 
+/// Settings of the batched message delivery, see
+/// SubscribeClient::SubscribeBatched()
+struct SubscriptionBatchSettings {
+  /// Max number of the messages passed to a single callback call
+  size_t max_batch_size{100};
+  /// Number of the tasks calling the callback concurrently, each task takes
+  /// its own batches of the messages. With more than one task the batches are
+  /// processed in an unspecified order.
+  size_t workers_count{1};
+};
+
 /// You can inherit from this class to provide your own subscription
 /// token implementation. Although it is useful only in mocks and tests.
 /// All standard implementations for redis and so on are provided by userver and
@@ -36,6 +48,20 @@ class SubscriptionToken {
       std::function<void(const std::string& pattern, const std::string& channel,
                          const std::string& message)>;
 
+  /// Message buffer shared by all the local subscribers of a channel
+  using SharedMessage = std::shared_ptr<const std::string>;
+
+  struct PatternMessage {
+    std::string channel;
+    SharedMessage message;
+  };
+
+  using OnMessagesCb = std::function<void(
+      const std::string& channel, const std::vector<SharedMessage>& messages)>;
+  using OnPmessagesCb =
+      std::function<void(const std::string& pattern,
+                         const std::vector<PatternMessage>& messages)>;
+
   SubscriptionToken();
   SubscriptionToken(SubscriptionToken&&) noexcept;
 
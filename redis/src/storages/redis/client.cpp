@@ -1,11 +1,55 @@
 #include <userver/storages/redis/client.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+
+#include <userver/engine/wait_all_checked.hpp>
+#include <userver/logging/log.hpp>
 #include <userver/storages/redis/impl/sentinel.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace storages::redis {
 
+namespace {
+
+// (shard, hash slot) -> indices of the keys
+using KeyGroups = std::map<std::pair<size_t, size_t>, std::vector<size_t>>;
+
+template <typename GetKey>
+KeyGroups GroupKeys(const Client& client, size_t keys_count,
+                    const GetKey& get_key,
+                    const CommandControl& command_control) {
+  const bool is_cluster = client.IsInClusterMode();
+  KeyGroups groups;
+  for (size_t i = 0; i < keys_count; ++i) {
+    const auto& key = get_key(i);
+    const auto shard = command_control.force_shard_idx
+                           ? *command_control.force_shard_idx
+                           : client.ShardByKey(key);
+    const auto slot =
+        is_cluster ? USERVER_NAMESPACE::redis::Sentinel::HashSlot(key) : 0;
+    groups[{shard, slot}].push_back(i);
+  }
+  return groups;
+}
+
+CommandControl ForShard(const CommandControl& command_control, size_t shard) {
+  auto result = command_control;
+  result.force_shard_idx = shard;
+  return result;
+}
+
+void AddFailedKeys(std::vector<size_t>& failed_keys,
+                   const std::vector<size_t>& indices) {
+  failed_keys.insert(failed_keys.end(), indices.begin(), indices.end());
+}
+
+}  // namespace
+
 std::string CreateTmpKey(const std::string& key, std::string prefix) {
   return USERVER_NAMESPACE::redis::Sentinel::CreateTmpKey(key,
                                                           std::move(prefix));
@@ -59,6 +103,128 @@ ScanRequest<ScanTag::kZscan> Client::Zscan(
   return Zscan(std::move(key), {}, command_control);
 }
 
+MgetAcrossShardsResult Client::MgetAcrossShards(
+    std::vector<std::string> keys, const CommandControl& command_control) {
+  MgetAcrossShardsResult result;
+  result.values.resize(keys.size());
+  if (keys.empty()) return result;
+
+  const auto groups = GroupKeys(
+      *this, keys.size(), [&keys](size_t i) -> const auto& { return keys[i]; },
+      command_control);
+
+  // All the requests are sent before waiting for any of them
+  std::vector<std::optional<RequestMget>> requests;
+  requests.reserve(groups.size());
+  for (const auto& [shard_slot, indices] : groups) {
+    std::vector<std::string> group_keys;
+    group_keys.reserve(indices.size());
+    for (const auto i : indices) group_keys.push_back(keys[i]);
+    try {
+      requests.emplace_back(Mget(std::move(group_keys),
+                                 ForShard(command_control, shard_slot.first)));
+    } catch (const std::exception& e) {
+      LOG_LIMITED_WARNING() << "Failed to send MGET to shard "
+                            << shard_slot.first << ": " << e;
+      requests.emplace_back();
+    }
+  }
+
+  auto request_it = requests.begin();
+  for (const auto& [shard_slot, indices] : groups) {
+    auto& request = *request_it++;
+    if (!request) {
+      AddFailedKeys(result.failed_keys, indices);
+      continue;
+    }
+    try {
+      auto values = request->Get();
+      UINVARIANT(values.size() == indices.size(),
+                 "Unexpected number of MGET values");
+      for (size_t i = 0; i < indices.size(); ++i) {
+        result.values[indices[i]] = std::move(values[i]);
+      }
+    } catch (const std::exception& e) {
+      LOG_LIMITED_WARNING() << "MGET to shard " << shard_slot.first
+                            << " failed: " << e;
+      AddFailedKeys(result.failed_keys, indices);
+    }
+  }
+  std::sort(result.failed_keys.begin(), result.failed_keys.end());
+  return result;
+}
+
+MsetAcrossShardsResult Client::MsetAcrossShards(
+    std::vector<std::pair<std::string, std::string>> key_values,
+    const CommandControl& command_control) {
+  MsetAcrossShardsResult result;
+  if (key_values.empty()) return result;
+
+  const auto groups = GroupKeys(
+      *this, key_values.size(),
+      [&key_values](size_t i) -> const auto& { return key_values[i].first; },
+      command_control);
+
+  std::vector<std::optional<RequestMset>> requests;
+  requests.reserve(groups.size());
+  for (const auto& [shard_slot, indices] : groups) {
+    std::vector<std::pair<std::string, std::string>> group_key_values;
+    group_key_values.reserve(indices.size());
+    for (const auto i : indices) {
+      group_key_values.push_back(std::move(key_values[i]));
+    }
+    try {
+      requests.emplace_back(Mset(std::move(group_key_values),
+                                 ForShard(command_control, shard_slot.first)));
+    } catch (const std::exception& e) {
+      LOG_LIMITED_WARNING() << "Failed to send MSET to shard "
+                            << shard_slot.first << ": " << e;
+      requests.emplace_back();
+    }
+  }
+
+  auto request_it = requests.begin();
+  for (const auto& [shard_slot, indices] : groups) {
+    auto& request = *request_it++;
+    if (!request) {
+      AddFailedKeys(result.failed_keys, indices);
+      continue;
+    }
+    try {
+      request->Get();
+    } catch (const std::exception& e) {
+      LOG_LIMITED_WARNING() << "MSET to shard " << shard_slot.first
+                            << " failed: " << e;
+      AddFailedKeys(result.failed_keys, indices);
+    }
+  }
+  std::sort(result.failed_keys.begin(), result.failed_keys.end());
+  return result;
+}
+
+void Client::ScanAllShards(ScanOptions options, size_t max_concurrency,
+                           const std::function<void(std::string key)>& on_key,
+                           const CommandControl& command_control) {
+  const auto shards_count = ShardsCount();
+  const auto workers_count =
+      std::min(std::max<size_t>(max_concurrency, 1), shards_count);
+  std::atomic<size_t> next_shard{0};
+
+  std::vector<engine::TaskWithResult<void>> workers;
+  workers.reserve(workers_count);
+  for (size_t i = 0; i < workers_count; ++i) {
+    workers.push_back(utils::Async("redis_scan_all_shards", [&] {
+      for (auto shard = next_shard++; shard < shards_count;
+           shard = next_shard++) {
+        for (auto& key : Scan(shard, options, command_control)) {
+          on_key(std::move(key));
+        }
+      }
+    }));
+  }
+  engine::WaitAllChecked(workers);
+}
+
 }  // namespace storages::redis
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <storages/redis/mock_server_benchmark.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/storages/redis/client.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis::bench {
+
+namespace {
+
+// End-to-end benchmarks of the Client against the in-process MockServer
+// instances, no redis is required. The arguments are:
+//  0: connections per redis instance
+//  1: value size
+//  2: percent of the requests to a single hot key, the other requests are
+//     distributed uniformly over kKeysCount keys
+constexpr std::size_t kShardsCount = 4;
+constexpr std::size_t kKeysCount = 10'000;
+constexpr std::size_t kMgetKeysCount = 10;
+constexpr std::size_t kInFlightRequests = 32;
+constexpr std::size_t kWorkerThreads = 2;
+
+class KeyGenerator final {
+ public:
+  explicit KeyGenerator(std::size_t hot_key_percent)
+      : hot_key_percent_(hot_key_percent) {}
+
+  std::string operator()() const {
+    if (utils::RandRange(std::size_t{100}) < hot_key_percent_) return "key0";
+    return "key" + std::to_string(utils::RandRange(kKeysCount));
+  }
+
+ private:
+  const std::size_t hot_key_percent_;
+};
+
+struct Get {
+  using RequestType = RequestGet;
+  ClientPtr client;
+  KeyGenerator key_generator;
+  std::size_t value_size;
+
+  RequestType operator()() { return client->Get(key_generator(), {}); }
+};
+
+struct Set {
+  using RequestType = RequestSet;
+  ClientPtr client;
+  KeyGenerator key_generator;
+  std::size_t value_size;
+
+  RequestType operator()() {
+    return client->Set(key_generator(), std::string(value_size, 'x'), {});
+  }
+};
+
+// The keys of a request share a hash tag, and so a shard
+struct Mget {
+  using RequestType = RequestMget;
+  ClientPtr client;
+  KeyGenerator key_generator;
+  std::size_t value_size;
+
+  RequestType operator()() {
+    const auto tag = '{' + key_generator() + '}';
+    std::vector<std::string> keys;
+    keys.reserve(kMgetKeysCount);
+    for (std::size_t i = 0; i < kMgetKeysCount; ++i) {
+      keys.push_back(tag + std::to_string(i));
+    }
+    return client->Mget(std::move(keys), {});
+  }
+};
+
+struct EvalSha {
+  using RequestType = RequestEvalSha<std::string>;
+  ClientPtr client;
+  KeyGenerator key_generator;
+  std::size_t value_size;
+
+  RequestType operator()() {
+    return client->EvalSha<std::string>(
+        "e0e1f9fabfc9d4800c877a703b823ac0578ff8db", {key_generator()},
+        {std::string(value_size, 'x')}, {});
+  }
+};
+
+void SetLatencyCounters(benchmark::State& state,
+                        std::vector<std::chrono::nanoseconds>& latencies) {
+  if (latencies.empty()) return;
+  const auto percentile = [&latencies](std::size_t percent) {
+    auto it = latencies.begin() + (latencies.size() - 1) * percent / 100;
+    std::nth_element(latencies.begin(), it, latencies.end());
+    return std::chrono::duration<double, std::micro>(*it).count();
+  };
+  state.counters["p50_us"] = percentile(50);
+  state.counters["p99_us"] = percentile(99);
+}
+
+void MockArguments(benchmark::internal::Benchmark* b) {
+  for (const long connections : {1, 4}) {
+    for (const long value_size : {16, 4096}) {
+      for (const long hot_key_percent : {0, 90}) {
+        b->Args({connections, value_size, hot_key_percent});
+      }
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void MockThroughput(benchmark::State& state) {
+  engine::RunStandalone(kWorkerThreads, [&state] {
+    const auto value_size = static_cast<std::size_t>(state.range(1));
+    MockCluster cluster{kShardsCount, static_cast<std::size_t>(state.range(0)),
+                        value_size};
+    T request_generator{cluster.GetClient(),
+                        KeyGenerator{static_cast<std::size_t>(state.range(2))},
+                        value_size};
+
+    using Clock = std::chrono::steady_clock;
+    std::deque<std::pair<typename T::RequestType, Clock::time_point>> requests;
+    for (std::size_t i = 0; i < kInFlightRequests; ++i) {
+      requests.emplace_back(request_generator(), Clock::now());
+    }
+
+    std::vector<std::chrono::nanoseconds> latencies;
+    for (auto _ : state) {
+      auto& [request, start] = requests.front();
+      request.Get();
+      latencies.push_back(Clock::now() - start);
+      requests.pop_front();
+      requests.emplace_back(request_generator(), Clock::now());
+    }
+
+    for (; !requests.empty(); requests.pop_front()) {
+      requests.front().first.Get();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    SetLatencyCounters(state, latencies);
+  });
+}
+
+BENCHMARK_TEMPLATE(MockThroughput, Get)->Apply(MockArguments);
+BENCHMARK_TEMPLATE(MockThroughput, Set)->Apply(MockArguments);
+BENCHMARK_TEMPLATE(MockThroughput, Mget)->Apply(MockArguments);
+BENCHMARK_TEMPLATE(MockThroughput, EvalSha)->Apply(MockArguments);
+
+}  // namespace storages::redis::bench
+
+USERVER_NAMESPACE_END
@@ -49,6 +49,10 @@ size_t ClientImpl::ShardByKey(const std::string& key) const {
   return redis_client_->ShardByKey(key);
 }
 
+bool ClientImpl::IsInClusterMode() const {
+  return redis_client_->IsInClusterMode();
+}
+
 const std::string& ClientImpl::GetAnyKeyForShard(size_t shard_idx) const {
   return redis_client_->GetAnyKeyForShard(shard_idx);
 }
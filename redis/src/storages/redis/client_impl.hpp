@@ -38,6 +38,8 @@ class ClientImpl final : public Client,
 
   size_t ShardByKey(const std::string& key) const override;
 
+  bool IsInClusterMode() const override;
+
   const std::string& GetAnyKeyForShard(size_t shard_idx) const override;
 
   std::shared_ptr<Client> GetClientForShard(size_t shard_idx) override;
@@ -1,6 +1,7 @@
 #include <userver/utest/utest.hpp>
 
 #include <memory>
+#include <set>
 #include <string>
 
 #include <userver/engine/task/cancel.hpp>
@@ -118,4 +119,42 @@ UTEST(RedisClient, Mget) {
   EXPECT_EQ(*result[1], "bar");
 }
 
+UTEST(RedisClient, MgetMsetAcrossShards) {
+  auto client = GetClient();
+  client->Set("key1", "old", {}).Get();
+
+  auto set_result = client->MsetAcrossShards(
+      {{"key0", "foo"}, {"key2", "baz"}, {"key1", "bar"}}, {});
+  EXPECT_TRUE(set_result.IsComplete());
+
+  auto result = client->MgetAcrossShards({"key2", "key3", "key0", "key1"}, {});
+  EXPECT_TRUE(result.IsComplete());
+  ASSERT_EQ(result.values.size(), 4);
+  EXPECT_EQ(result.values[0], "baz");
+  EXPECT_FALSE(result.values[1]);
+  EXPECT_EQ(result.values[2], "foo");
+  EXPECT_EQ(result.values[3], "bar");
+
+  EXPECT_TRUE(client->MgetAcrossShards({}, {}).values.empty());
+}
+
+UTEST(RedisClient, ScanAllShards) {
+  auto client = GetClient();
+  constexpr int kKeysCount = 100;
+  for (int i = 0; i < kKeysCount; ++i) {
+    client->Set("scan_key" + std::to_string(i), "value", {}).Get();
+  }
+  client->Set("other_key", "value", {}).Get();
+
+  storages::redis::ScanOptions options{
+      storages::redis::ScanOptions::Match{"scan_key*"},
+      storages::redis::ScanOptions::Count{10}};
+  std::set<std::string> keys;
+  client->ScanAllShards(
+      options, 4, [&keys](std::string key) { keys.insert(std::move(key)); },
+      {});
+  EXPECT_EQ(keys.size(), kKeysCount);
+  EXPECT_EQ(keys.count("other_key"), 0);
+}
+
 USERVER_NAMESPACE_END
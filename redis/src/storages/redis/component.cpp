@@ -55,6 +55,16 @@ formats::json::ValueBuilder InstanceStatisticsToJson(
         utils::statistics::PercentileToJson(stats.reply_size_percentile);
     utils::statistics::SolomonSkip(result["reply_sizes"]["1min"]);
   }
+  if (metrics_settings.batch_sizes_enabled) {
+    result["batch_sizes"]["1min"] =
+        utils::statistics::PercentileToJson(stats.batch_size_percentile);
+    utils::statistics::SolomonSkip(result["batch_sizes"]["1min"]);
+  }
+  if (metrics_settings.pipeline_depth_enabled) {
+    result["connections"] = stats.connections;
+    result["pending_commands"] = stats.pending_commands;
+    result["max_pending_commands"] = stats.max_pending_commands;
+  }
   if (metrics_settings.timings_enabled) {
     result["timings"]["1min"] =
         utils::statistics::PercentileToJson(stats.timings_percentile);
@@ -246,6 +256,7 @@ struct RedisGroup {
   std::string config_name;
   std::string sharding_strategy;
   bool allow_reads_from_master{false};
+  size_t connections_per_instance{1};
 };
 
 RedisGroup Parse(const yaml_config::YamlConfig& value,
@@ -256,6 +267,8 @@ RedisGroup Parse(const yaml_config::YamlConfig& value,
   config.sharding_strategy = value["sharding_strategy"].As<std::string>("");
   config.allow_reads_from_master =
       value["allow_reads_from_master"].As<bool>(false);
+  config.connections_per_instance =
+      value["connections_per_instance"].As<size_t>(1);
   return config;
 }
 
@@ -368,6 +381,7 @@ void Redis::Connect(const ComponentConfig& config,
         redis::KeyShardFactory{redis_group.sharding_strategy}, command_control,
         testsuite_redis_control);
     if (sentinel) {
+      sentinel->SetConnectionsPerInstance(redis_group.connections_per_instance);
       sentinels_.emplace(redis_group.db, sentinel);
       const auto& client =
           std::make_shared<storages::redis::ClientImpl>(sentinel);
@@ -531,6 +545,11 @@ properties:
                     type: boolean
                     description: allows read requests from master instance
                     defaultDescription: false
+                connections_per_instance:
+                    type: integer
+                    description: number of connections to each master and slave, spread over the redis thread pool
+                    defaultDescription: 1
+                    minimum: 1
     subscribe_groups:
         type: array
         description: array of redis clusters to work with in subscribe mode
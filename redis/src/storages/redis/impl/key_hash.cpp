@@ -0,0 +1,112 @@
+#include <storages/redis/impl/key_hash.hpp>
+
+#include <array>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+namespace {
+
+// The tables are indexed by the distance of the byte from the end of an
+// 8-byte block, so a block is processed with 8 independent lookups
+// ("slice-by-8") instead of 8 dependent ones.
+constexpr std::size_t kSlices = 8;
+
+template <typename T>
+using CrcTables = std::array<std::array<T, 256>, kSlices>;
+
+constexpr CrcTables<std::uint32_t> MakeCrc32Tables() {
+  constexpr std::uint32_t kReflectedPoly = 0xEDB88320;
+
+  CrcTables<std::uint32_t> tables{};
+  for (std::uint32_t i = 0; i < 256; ++i) {
+    std::uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ ((crc & 1) ? kReflectedPoly : 0);
+    }
+    tables[0][i] = crc;
+  }
+  for (std::size_t slice = 1; slice < kSlices; ++slice) {
+    for (std::size_t i = 0; i < 256; ++i) {
+      const auto prev = tables[slice - 1][i];
+      tables[slice][i] = (prev >> 8) ^ tables[0][prev & 0xFF];
+    }
+  }
+  return tables;
+}
+
+constexpr CrcTables<std::uint16_t> MakeCrc16Tables() {
+  constexpr std::uint16_t kPoly = 0x1021;
+
+  CrcTables<std::uint16_t> tables{};
+  for (std::uint32_t i = 0; i < 256; ++i) {
+    auto crc = static_cast<std::uint16_t>(i << 8);
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc << 1) ^ ((crc & 0x8000) ? kPoly : 0);
+    }
+    tables[0][i] = crc;
+  }
+  for (std::size_t slice = 1; slice < kSlices; ++slice) {
+    for (std::size_t i = 0; i < 256; ++i) {
+      const auto prev = tables[slice - 1][i];
+      tables[slice][i] = (prev << 8) ^ tables[0][prev >> 8];
+    }
+  }
+  return tables;
+}
+
+constexpr auto kCrc32Tables = MakeCrc32Tables();
+constexpr auto kCrc16Tables = MakeCrc16Tables();
+
+}  // namespace
+
+std::string_view GetHashedKeyPart(std::string_view key) noexcept {
+  const auto start = key.find('{');
+  if (start == std::string_view::npos) return key;
+
+  const auto end = key.find('}', start + 1);
+  if (end == std::string_view::npos || end == start + 1) return key;
+
+  return key.substr(start + 1, end - start - 1);
+}
+
+std::uint32_t Crc32(std::string_view data) noexcept {
+  const auto& t = kCrc32Tables;
+  const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+  auto size = data.size();
+
+  std::uint32_t crc = 0xFFFFFFFF;
+  for (; size >= kSlices; size -= kSlices, p += kSlices) {
+    crc ^= static_cast<std::uint32_t>(p[0]) |
+           (static_cast<std::uint32_t>(p[1]) << 8) |
+           (static_cast<std::uint32_t>(p[2]) << 16) |
+           (static_cast<std::uint32_t>(p[3]) << 24);
+    crc = t[7][crc & 0xFF] ^ t[6][(crc >> 8) & 0xFF] ^
+          t[5][(crc >> 16) & 0xFF] ^ t[4][crc >> 24] ^ t[3][p[4]] ^
+          t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+  }
+  for (; size > 0; --size, ++p) {
+    crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xFF];
+  }
+  return crc ^ 0xFFFFFFFF;
+}
+
+std::uint16_t Crc16(std::string_view data) noexcept {
+  const auto& t = kCrc16Tables;
+  const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+  auto size = data.size();
+
+  std::uint16_t crc = 0;
+  for (; size >= kSlices; size -= kSlices, p += kSlices) {
+    crc = t[7][p[0] ^ (crc >> 8)] ^ t[6][p[1] ^ (crc & 0xFF)] ^ t[5][p[2]] ^
+          t[4][p[3]] ^ t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+  }
+  for (; size > 0; --size, ++p) {
+    crc = (crc << 8) ^ t[0][(crc >> 8) ^ *p];
+  }
+  return crc;
+}
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
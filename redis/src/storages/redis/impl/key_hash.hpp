@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+
+/// Returns the part of the key that defines the shard: the content of the
+/// first `{...}` hashtag if it is not empty, the whole key otherwise.
+/// See https://redis.io/topics/cluster-spec
+std::string_view GetHashedKeyPart(std::string_view key) noexcept;
+
+/// CRC-32 (IEEE 802.3), the same as boost::crc_32_type
+std::uint32_t Crc32(std::string_view data) noexcept;
+
+/// CRC-16 (XMODEM), the same as boost::crc_optimal<16, 0x1021>, used for the
+/// Redis Cluster hash slots
+std::uint16_t Crc16(std::string_view data) noexcept;
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
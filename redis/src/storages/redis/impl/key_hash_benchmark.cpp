@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <boost/crc.hpp>
+
+#include <storages/redis/impl/key_hash.hpp>
+#include <storages/redis/impl/keyshard_impl.hpp>
+#include <userver/storages/redis/impl/sentinel.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kKeysCount = 1000;
+
+std::vector<std::string> MakeKeys(std::size_t key_size) {
+  std::vector<std::string> keys;
+  keys.reserve(kKeysCount);
+  for (std::size_t i = 0; i < kKeysCount; ++i) {
+    auto key = "user:" + std::to_string(i) + ':';
+    key.resize(std::max(key.size(), key_size), 'x');
+    keys.push_back(std::move(key));
+  }
+  return keys;
+}
+
+void RedisCrc32Boost(benchmark::State& state) {
+  const auto keys = MakeKeys(state.range(0));
+  for (auto _ : state) {
+    for (const auto& key : keys) {
+      boost::crc_32_type crc;
+      crc.process_bytes(key.data(), key.size());
+      benchmark::DoNotOptimize(crc.checksum());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+void RedisCrc32(benchmark::State& state) {
+  const auto keys = MakeKeys(state.range(0));
+  for (auto _ : state) {
+    for (const auto& key : keys) {
+      benchmark::DoNotOptimize(redis::Crc32(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+void RedisKeyShardCrc32(benchmark::State& state) {
+  const auto keys = MakeKeys(state.range(0));
+  const redis::KeyShardCrc32 key_shard{16};
+  for (auto _ : state) {
+    for (const auto& key : keys) {
+      benchmark::DoNotOptimize(key_shard.ShardByKey(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+void RedisClusterHashSlot(benchmark::State& state) {
+  const auto keys = MakeKeys(state.range(0));
+  for (auto _ : state) {
+    for (const auto& key : keys) {
+      benchmark::DoNotOptimize(redis::Sentinel::HashSlot(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+}  // namespace
+
+BENCHMARK(RedisCrc32Boost)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(RedisCrc32)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(RedisKeyShardCrc32)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(RedisClusterHashSlot)->RangeMultiplier(4)->Range(16, 1024);
+
+USERVER_NAMESPACE_END
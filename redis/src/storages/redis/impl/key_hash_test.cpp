@@ -0,0 +1,55 @@
+#include "key_hash.hpp"
+
+#include <string>
+
+#include <boost/crc.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string MakeData(std::size_t size) {
+  std::string result(size, '\0');
+  for (std::size_t i = 0; i < size; ++i) {
+    result[i] = static_cast<char>(i * 37 + 11);
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(KeyHash, HashedKeyPart) {
+  EXPECT_EQ(redis::GetHashedKeyPart("key"), "key");
+  EXPECT_EQ(redis::GetHashedKeyPart("{user1000}.following"), "user1000");
+  EXPECT_EQ(redis::GetHashedKeyPart("foo{}{bar}"), "foo{}{bar}");
+  EXPECT_EQ(redis::GetHashedKeyPart("foo{{bar}}zap"), "{bar");
+  EXPECT_EQ(redis::GetHashedKeyPart("foo{bar}{zap}"), "bar");
+  EXPECT_EQ(redis::GetHashedKeyPart("foo{bar"), "foo{bar");
+  EXPECT_EQ(redis::GetHashedKeyPart(""), "");
+}
+
+TEST(KeyHash, Crc32) {
+  EXPECT_EQ(redis::Crc32("123456789"), 0xCBF43926);
+
+  for (std::size_t size = 0; size < 100; ++size) {
+    const auto data = MakeData(size);
+    boost::crc_32_type expected;
+    expected.process_bytes(data.data(), data.size());
+    EXPECT_EQ(redis::Crc32(data), expected.checksum()) << size;
+  }
+}
+
+TEST(KeyHash, Crc16) {
+  EXPECT_EQ(redis::Crc16("123456789"), 0x31C3);
+
+  for (std::size_t size = 0; size < 100; ++size) {
+    const auto data = MakeData(size);
+    boost::crc_optimal<16, 0x1021> expected;
+    expected.process_bytes(data.data(), data.size());
+    EXPECT_EQ(redis::Crc16(data), expected.checksum()) << size;
+  }
+}
+
+USERVER_NAMESPACE_END
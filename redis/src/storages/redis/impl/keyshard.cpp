@@ -1,16 +1,15 @@
 #include "keyshard_impl.hpp"
 
-#include <algorithm>
 #include <cassert>
 #include <vector>
 
 #include <boost/algorithm/string/split.hpp>
-#include <boost/crc.hpp>
-#include <boost/range/algorithm/for_each.hpp>
 
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <storages/redis/impl/key_hash.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace redis {
@@ -22,34 +21,9 @@ const std::string kTaximeterCrcKeyEncoding = "WINDOWS-1252//TRANSLIT";
 }  // namespace
 
 void GetRedisKey(const std::string& key, size_t* key_start, size_t* key_len) {
-  // see https://redis.io/topics/cluster-spec
-
-  const char* str = key.data();
-  size_t len = key.size();
-  size_t start = 0;  // start-end indexes
-  size_t end = 0;    // of '{' and '}'
-
-  *key_start = 0;
-  *key_len = len;
-
-  /* Search the first occurrence of '{'. */
-  for (start = 0; start < len; start++)
-    if (str[start] == '{') break;
-
-  /* No '{' ? Hash the whole key. This is the base case. */
-  if (start == len) return;
-
-  /* '{' found? Check if we have the corresponding '}'. */
-  for (end = start + 1; end < len; end++)
-    if (str[end] == '}') break;
-
-  /* No '}' or nothing between {} ? Hash the whole key. */
-  if (end == len || end == start + 1) return;
-
-  /* If we are here there is both a { and a  } on its right. Hash
-   * what is in the middle between { and  }. */
-  *key_start = start + 1;
-  *key_len = end - start - 1;
+  const auto hashed = GetHashedKeyPart(key);
+  *key_start = hashed.data() - key.data();
+  *key_len = hashed.size();
 }
 
 KeyShardTaximeterCrc32::KeyShardTaximeterCrc32(size_t shard_count)
@@ -58,13 +32,7 @@ KeyShardTaximeterCrc32::KeyShardTaximeterCrc32(size_t shard_count)
 
 size_t KeyShardCrc32::ShardByKey(const std::string& key) const {
   UASSERT(shard_count_ > 0);
-  size_t start = 0;
-  size_t len = 0;
-  GetRedisKey(key, &start, &len);
-
-  return std::for_each(key.data() + start, key.data() + start + len,
-                       boost::crc_32_type())() %
-         shard_count_;
+  return Crc32(GetHashedKeyPart(key)) % shard_count_;
 }
 
 bool KeyShardTaximeterCrc32::NeedConvertEncoding(const std::string& key,
@@ -83,20 +51,15 @@ size_t KeyShardTaximeterCrc32::ShardByKey(const std::string& key) const {
   std::vector<char> converted;
   if (NeedConvertEncoding(key, start, len) &&
       converter_.Convert(key.data() + start, len, converted))
-    return std::for_each(converted.begin(), converted.end(),
-                         boost::crc_32_type())() %
-           shard_count_;
+    return Crc32({converted.data(), converted.size()}) % shard_count_;
   else
-    return std::for_each(key.data() + start, key.data() + start + len,
-                         boost::crc_32_type())() %
-           shard_count_;
+    return Crc32({key.data() + start, len}) % shard_count_;
 }
 
 size_t KeyShardGpsStorageDriver::ShardByKey(const std::string& key) const {
   const auto path = Parse(key);
   const auto& driver_id = path.value_or(key);
-  boost::crc_32_type crc{};
-  return boost::for_each(driver_id, crc)() % shard_count_;
+  return Crc32(driver_id) % shard_count_;
 }
 
 std::optional<std::string> KeyShardGpsStorageDriver::Parse(
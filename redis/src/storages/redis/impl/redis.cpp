@@ -872,6 +872,9 @@ void Redis::RedisImpl::CommandLoopImpl() {
     std::swap(commands_, commands);
   }
   LOG_TRACE() << "commands size=" << commands.size();
+  // hiredis writes the commands of a batch to the socket at once, when the
+  // socket becomes writable on the next iteration of the event loop
+  if (!commands.empty()) statistics_.AccountCommandsBatch(commands.size());
   for (auto& command : commands) {
     ProcessCommand(command);
   }
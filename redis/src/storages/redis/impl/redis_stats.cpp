@@ -124,6 +124,10 @@ void Statistics::AccountCommandSent(const CommandPtr& cmd) {
   }
 }
 
+void Statistics::AccountCommandsBatch(size_t commands_count) {
+  batch_size_percentile.GetCurrentCounter().Account(commands_count);
+}
+
 void Statistics::AccountReplyReceived(const ReplyPtr& reply,
                                       const CommandPtr& cmd) {
   reply_size_percentile.GetCurrentCounter().Account(reply->data.GetSize());
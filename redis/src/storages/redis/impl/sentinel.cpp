@@ -1,5 +1,6 @@
 #include <userver/storages/redis/impl/sentinel.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
 
@@ -7,6 +8,7 @@
 
 #include <engine/ev/thread_control.hpp>
 #include <userver/engine/task/cancel.hpp>
+#include <userver/server/request/task_inherited_data.hpp>
 #include <userver/testsuite/testsuite_support.hpp>
 #include <userver/utils/assert.hpp>
 
@@ -31,6 +33,25 @@ void ThrowIfCancelled() {
   }
 }
 
+// Limits the timeouts by the deadline of the handled request
+CommandControl ApplyTaskDataDeadline(CommandControl cc) {
+  if (!engine::current_task::GetTaskProcessorOptional()) return cc;
+  const auto* task_data = server::request::kTaskInheritedData.GetOptional();
+  if (!task_data || !task_data->deadline.IsReachable()) return cc;
+
+  // Zero timeouts are treated as not set, so at least a millisecond is left
+  const auto time_left = std::max(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          task_data->deadline.TimeLeft()),
+      std::chrono::milliseconds{1});
+  const auto limit = [time_left](std::chrono::milliseconds timeout) {
+    return timeout.count() > 0 ? std::min(timeout, time_left) : time_left;
+  };
+  cc.timeout_all = limit(cc.timeout_all);
+  cc.timeout_single = limit(cc.timeout_single);
+  return cc;
+}
+
 }  // namespace
 
 Sentinel::Sentinel(
@@ -241,6 +262,12 @@ size_t Sentinel::ShardByKey(const std::string& key) const {
 
 size_t Sentinel::ShardsCount() const { return impl_->ShardsCount(); }
 
+bool Sentinel::IsInClusterMode() const { return impl_->IsInClusterMode(); }
+
+size_t Sentinel::HashSlot(const std::string& key) {
+  return SentinelImpl::HashSlot(key);
+}
+
 void Sentinel::CheckShardIdx(size_t shard_idx) const {
   CheckShardIdx(shard_idx, ShardsCount());
 }
@@ -270,6 +297,10 @@ void Sentinel::SetReplicationMonitoringSettings(
   impl_->SetReplicationMonitoringSettings(replication_monitoring_settings);
 }
 
+void Sentinel::SetConnectionsPerInstance(size_t connections_per_instance) {
+  impl_->SetConnectionsPerInstance(connections_per_instance);
+}
+
 std::vector<Request> Sentinel::MakeRequests(
     CmdArgs&& args, bool master, const CommandControl& command_control,
     size_t replies_to_skip) {
@@ -328,10 +359,10 @@ void Sentinel::OnPsubscribeReply(const PmessageCallback pmessage_callback,
 }
 
 CommandControl Sentinel::GetCommandControl(const CommandControl& cc) const {
-  return secdist_default_command_control_
-      .MergeWith(*config_default_command_control_.Get())
-      .MergeWith(cc)
-      .MergeWith(testsuite_redis_control_);
+  const auto merged = secdist_default_command_control_
+                          .MergeWith(*config_default_command_control_.Get())
+                          .MergeWith(cc);
+  return ApplyTaskDataDeadline(merged).MergeWith(testsuite_redis_control_);
 }
 
 void Sentinel::SetConfigDefaultCommandControl(
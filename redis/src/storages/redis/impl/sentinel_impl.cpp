@@ -5,7 +5,6 @@
 #include <thread>
 
 #include <boost/algorithm/string.hpp>
-#include <boost/crc.hpp>
 
 #include <fmt/format.h>
 
@@ -15,6 +14,7 @@
 #include <userver/utils/assert.hpp>
 
 #include <storages/redis/impl/command.hpp>
+#include <storages/redis/impl/key_hash.hpp>
 #include <storages/redis/impl/keyshard_impl.hpp>
 #include <userver/storages/redis/impl/exception.hpp>
 #include <userver/storages/redis/impl/reply.hpp>
@@ -182,6 +182,7 @@ void SentinelImpl::InitShards(
     shard_options.shard_name = shard;
     shard_options.shard_group_name = shard_group_name_;
     shard_options.cluster_mode = IsInClusterMode();
+    shard_options.connections_per_instance = connections_per_instance_;
     shard_options.ready_change_callback = [i, shard,
                                            ready_callback](bool ready) {
       if (ready_callback) ready_callback(i, shard, ready);
@@ -496,6 +497,15 @@ void SentinelImpl::SetReplicationMonitoringSettings(
     shard->SetReplicationMonitoringSettings(replication_monitoring_settings);
 }
 
+void SentinelImpl::SetConnectionsPerInstance(size_t connections_per_instance) {
+  if (connections_per_instance_.exchange(connections_per_instance) ==
+      connections_per_instance)
+    return;
+  for (auto& shard : master_shards_)
+    shard->SetConnectionsPerInstance(connections_per_instance);
+  ForceUpdateHosts();
+}
+
 void SentinelImpl::RequestUpdateClusterSlots(size_t shard) {
   current_slots_shard_ = shard;
   ev_thread_.Send(watch_cluster_slots_);
@@ -859,12 +869,7 @@ size_t SentinelImpl::ParseMovedShard(const std::string& err_string) {
 }
 
 size_t SentinelImpl::HashSlot(const std::string& key) {
-  size_t start = 0;
-  size_t len = 0;
-  GetRedisKey(key, &start, &len);
-  return std::for_each(key.data() + start, key.data() + start + len,
-                       boost::crc_optimal<16, 0x1021>())() &
-         0x3fff;
+  return Crc16(GetHashedKeyPart(key)) & 0x3fff;
 }
 
 SentinelImpl::SlotInfo::SlotInfo() {
@@ -88,11 +88,13 @@ class SentinelImpl {
 
   std::vector<std::shared_ptr<const Shard>> GetMasterShards() const;
   bool IsInClusterMode() const;
+  static size_t HashSlot(const std::string& key);
 
   void SetCommandsBufferingSettings(
       CommandsBufferingSettings commands_buffering_settings);
   void SetReplicationMonitoringSettings(
       const ReplicationMonitoringSettings& replication_monitoring_settings);
+  void SetConnectionsPerInstance(size_t connections_per_instance);
 
  private:
   static constexpr const std::chrono::milliseconds cluster_slots_timeout_ =
@@ -186,8 +188,6 @@ class SentinelImpl {
                   std::vector<std::shared_ptr<Shard>>& shard_objects,
                   const ReadyChangeCallback& ready_callback);
 
-  static size_t HashSlot(const std::string& key);
-
   void ProcessWaitingCommands();
 
   Sentinel& sentinel_obj_;
@@ -227,6 +227,7 @@ class SentinelImpl {
   SentinelStatisticsInternal statistics_internal_;
   utils::SwappingSmart<KeysForShards> keys_for_shards_;
   std::optional<CommandsBufferingSettings> commands_buffering_settings_;
+  std::atomic<size_t> connections_per_instance_{1};
 };
 
 }  // namespace redis
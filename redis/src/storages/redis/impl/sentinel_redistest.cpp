@@ -1,5 +1,6 @@
 #include <userver/utest/utest.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 
@@ -105,4 +106,30 @@ UTEST_F(SentinelTest, ForceNonExistingServerId) {
   EXPECT_FALSE(reply2->IsOk());
 }
 
+UTEST_F(SentinelTest, ConnectionsPerInstance) {
+  constexpr size_t kConnections = 3;
+  auto sentinel = GetSentinel();
+  sentinel->SetConnectionsPerInstance(kConnections);
+
+  const auto get_connections = [&sentinel] {
+    size_t connections = 0;
+    for (const auto& [name, shard] : sentinel->GetStatistics().masters) {
+      for (const auto& [instance, stats] : shard.instances) {
+        connections = std::max(connections, stats.connections);
+      }
+    }
+    return connections;
+  };
+  const auto deadline =
+      engine::Deadline::FromDuration(std::chrono::seconds{10});
+  while (get_connections() < kConnections && !deadline.IsReached()) {
+    engine::SleepFor(std::chrono::milliseconds(100));
+  }
+  EXPECT_EQ(get_connections(), kConnections);
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(sentinel->MakeRequest({"ping"}, 0).Get()->IsOk());
+  }
+}
+
 USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include <storages/redis/impl/shard.hpp>
 
+#include <algorithm>
+
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
@@ -47,12 +49,19 @@ ConnectionSecurity ConnectionInfoInt::GetConnectionSecurity() const {
 
 const std::string& ConnectionInfoInt::Fulltext() const { return fulltext_; }
 
+size_t ConnectionInfoInt::ConnectionIdx() const { return connection_idx_; }
+
+void ConnectionInfoInt::SetConnectionIdx(size_t connection_idx) {
+  connection_idx_ = connection_idx;
+}
+
 void ConnectionInfoInt::Connect(Redis& instance) const {
   instance.Connect(conn_info_.host, conn_info_.port, conn_info_.password);
 }
 
 bool operator==(const ConnectionInfoInt& lhs, const ConnectionInfoInt& rhs) {
-  return lhs.Fulltext() == rhs.Fulltext();
+  return lhs.Fulltext() == rhs.Fulltext() &&
+         lhs.ConnectionIdx() == rhs.ConnectionIdx();
 }
 
 bool operator!=(const ConnectionInfoInt& lhs, const ConnectionInfoInt& rhs) {
@@ -60,12 +69,15 @@ bool operator!=(const ConnectionInfoInt& lhs, const ConnectionInfoInt& rhs) {
 }
 
 bool operator<(const ConnectionInfoInt& lhs, const ConnectionInfoInt& rhs) {
-  return lhs.Fulltext() < rhs.Fulltext();
+  if (lhs.Fulltext() != rhs.Fulltext()) return lhs.Fulltext() < rhs.Fulltext();
+  return lhs.ConnectionIdx() < rhs.ConnectionIdx();
 }
 
 Shard::Shard(Options options)
     : shard_name_(std::move(options.shard_name)),
       shard_group_name_(std::move(options.shard_group_name)),
+      connections_per_instance_(
+          std::max<size_t>(options.connections_per_instance, 1)),
       ready_change_callback_(std::move(options.ready_change_callback)),
       cluster_mode_(options.cluster_mode) {
   for (const auto& conn : options.connection_infos) {
@@ -140,7 +152,7 @@ std::vector<unsigned char> Shard::GetAvailableServers(
 std::vector<unsigned char> Shard::GetNearestServersPing(
     const CommandControl& command_control, bool with_masters,
     bool with_slaves) const {
-  auto count = command_control.best_dc_count;
+  auto count = command_control.best_dc_count * connections_per_instance_;
   if (count == 0) count = instances_.size();
 
   using PairPingNum = std::pair<size_t, size_t>;
@@ -391,9 +403,15 @@ ShardStatistics Shard::GetStatistics(bool master) const {
 
   for (const auto& instance : instances_) {
     if (!instance.instance || instance.info.IsReadOnly() == master) continue;
-    stats.instances.emplace(
-        instance.info.Fulltext(),
-        redis::InstanceStatistics(instance.instance->GetStatistics()));
+    redis::InstanceStatistics instance_stats(
+        instance.instance->GetStatistics());
+    instance_stats.connections = 1;
+    instance_stats.pending_commands = instance.instance->GetRunningCommands();
+    instance_stats.max_pending_commands = instance_stats.pending_commands;
+    // The connections to the same server are reported as one instance
+    auto [it, inserted] =
+        stats.instances.try_emplace(instance.info.Fulltext(), instance_stats);
+    if (!inserted) it->second.Add(instance_stats);
     if (instance.instance->GetState() == Redis::State::kConnected) {
       stats.is_ready = true;
     }
@@ -455,10 +473,22 @@ void Shard::SetReplicationMonitoringSettings(
   }
 }
 
+void Shard::SetConnectionsPerInstance(size_t connections_per_instance) {
+  std::unique_lock lock(mutex_);
+  connections_per_instance_ = std::max<size_t>(connections_per_instance, 1);
+}
+
 std::vector<ConnectionInfoInt> Shard::GetConnectionInfosToCreate() const {
   std::shared_lock lock(mutex_);
 
-  auto need_to_create = connection_infos_;
+  std::vector<ConnectionInfoInt> need_to_create;
+  need_to_create.reserve(connection_infos_.size() * connections_per_instance_);
+  for (const auto& info : connection_infos_) {
+    for (size_t idx = 0; idx < connections_per_instance_; ++idx) {
+      need_to_create.push_back(info);
+      need_to_create.back().SetConnectionIdx(idx);
+    }
+  }
 
   for (const auto& instance : instances_)
     utils::Erase(need_to_create, instance.info);
@@ -481,11 +511,15 @@ bool Shard::UpdateCleanWaitQueue(
     // NOLINTNEXTLINE(readability-qualified-auto)
     for (auto instance_iterator = instances_.begin();
          instance_iterator != instances_.end();) {
+      const auto& info = instance_iterator->info;
       // NOLINTNEXTLINE(readability-qualified-auto)
-      auto conn_info =
-          std::find(connection_infos_.begin(), connection_infos_.end(),
-                    instance_iterator->info);
-      if (conn_info == connection_infos_.end()) {
+      auto conn_info = std::find_if(
+          connection_infos_.begin(), connection_infos_.end(),
+          [&info](const auto& conn) {
+            return conn.Fulltext() == info.Fulltext();
+          });
+      if (conn_info == connection_infos_.end() ||
+          info.ConnectionIdx() >= connections_per_instance_) {
         erase_instance.emplace_back(std::move(*instance_iterator));
         instance_iterator = instances_.erase(instance_iterator);
         instances_changed = true;
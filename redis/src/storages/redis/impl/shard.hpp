@@ -36,12 +36,17 @@ class ConnectionInfoInt {
 
   const std::string& Fulltext() const;
 
+  // Index of the connection among the connections to the same server
+  size_t ConnectionIdx() const;
+  void SetConnectionIdx(size_t);
+
   void Connect(Redis&) const;
 
  private:
   ConnectionInfo conn_info_;
   std::string name_;
   std::string fulltext_;
+  size_t connection_idx_{0};
 };
 
 bool operator==(const ConnectionInfoInt&, const ConnectionInfoInt&);
@@ -65,6 +70,7 @@ class Shard {
     bool cluster_mode{false};
     std::function<void(bool ready)> ready_change_callback;
     std::vector<ConnectionInfo> connection_infos;
+    size_t connections_per_instance{1};
   };
 
   explicit Shard(Options options);
@@ -98,6 +104,7 @@ class Shard {
       CommandsBufferingSettings commands_buffering_settings);
   void SetReplicationMonitoringSettings(
       const ReplicationMonitoringSettings& replication_monitoring_settings);
+  void SetConnectionsPerInstance(size_t connections_per_instance);
 
  private:
   std::vector<unsigned char> GetAvailableServers(
@@ -116,6 +123,7 @@ class Shard {
 
   mutable std::shared_mutex mutex_;
   std::vector<ConnectionInfoInt> connection_infos_;
+  size_t connections_per_instance_;
   std::vector<ConnectionStatus> instances_;
   std::vector<ConnectionStatus> clean_wait_;
   std::chrono::steady_clock::time_point last_connected_time_;
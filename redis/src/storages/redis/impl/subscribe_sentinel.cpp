@@ -112,16 +112,42 @@ SubscriptionToken SubscribeSentinel::Subscribe(
     const std::string& channel,
     const Sentinel::UserMessageCallback& message_callback,
     CommandControl control) {
-  auto token = storage_->Subscribe(channel, message_callback,
+  return Subscribe(
+      channel,
+      [message_callback](const std::string& channel,
+                         const Sentinel::SharedMessage& message) {
+        message_callback(channel, *message);
+      },
+      control);
+}
+
+SubscriptionToken SubscribeSentinel::Psubscribe(
+    const std::string& pattern,
+    const Sentinel::UserPmessageCallback& message_callback,
+    CommandControl control) {
+  return Psubscribe(
+      pattern,
+      [message_callback](const std::string& pattern, const std::string& channel,
+                         const Sentinel::SharedMessage& message) {
+        message_callback(pattern, channel, *message);
+      },
+      control);
+}
+
+SubscriptionToken SubscribeSentinel::Subscribe(
+    const std::string& channel,
+    Sentinel::UserSharedMessageCallback message_callback,
+    CommandControl control) {
+  auto token = storage_->Subscribe(channel, std::move(message_callback),
                                    GetCommandControl(control));
   return token;
 }
 
 SubscriptionToken SubscribeSentinel::Psubscribe(
     const std::string& pattern,
-    const Sentinel::UserPmessageCallback& message_callback,
+    Sentinel::UserSharedPmessageCallback message_callback,
     CommandControl control) {
-  auto token = storage_->Psubscribe(pattern, message_callback,
+  auto token = storage_->Psubscribe(pattern, std::move(message_callback),
                                     GetCommandControl(control));
   return token;
 }
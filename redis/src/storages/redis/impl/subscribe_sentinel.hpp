@@ -48,6 +48,17 @@ class SubscribeSentinel : protected Sentinel {
       const Sentinel::UserPmessageCallback& message_callback,
       CommandControl control = CommandControl());
 
+  /// The message buffer is shared with the other local subscribers of the
+  /// channel instead of being copied for each of them
+  SubscriptionToken Subscribe(
+      const std::string& channel,
+      Sentinel::UserSharedMessageCallback message_callback,
+      CommandControl control = CommandControl());
+  SubscriptionToken Psubscribe(
+      const std::string& pattern,
+      Sentinel::UserSharedPmessageCallback message_callback,
+      CommandControl control = CommandControl());
+
   PubsubClusterStatistics GetSubscriberStatistics() const;
 
   void RebalanceSubscriptions(size_t shard_idx);
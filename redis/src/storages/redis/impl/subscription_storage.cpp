@@ -1,5 +1,6 @@
 #include "subscription_storage.hpp"
 
+#include <memory>
 #include <stdexcept>
 
 #include <userver/logging/log.hpp>
@@ -67,7 +68,7 @@ void SubscriptionStorage::SetUnsubscribeCallback(CommandCb cb) {
 }
 
 SubscriptionToken SubscriptionStorage::Subscribe(
-    const std::string& channel, Sentinel::UserMessageCallback cb,
+    const std::string& channel, Sentinel::UserSharedMessageCallback cb,
     CommandControl control) {
   std::lock_guard<std::mutex> lock(mutex_);
   auto id = GetNextSubscriptionId();
@@ -110,7 +111,7 @@ SubscriptionToken SubscriptionStorage::Subscribe(
 }
 
 SubscriptionToken SubscriptionStorage::Psubscribe(
-    const std::string& pattern, Sentinel::UserPmessageCallback cb,
+    const std::string& pattern, Sentinel::UserSharedPmessageCallback cb,
     CommandControl control) {
   std::lock_guard<std::mutex> lock(mutex_);
   auto id = GetNextSubscriptionId();
@@ -608,9 +609,11 @@ void SubscriptionStorage::OnMessage(ServerId server_id,
   try {
     std::lock_guard<std::mutex> lock(mutex_);
     auto& m = callback_map_.at(channel);
+    // A single copy of the message is shared by all the subscribers
+    const auto shared_message = std::make_shared<const std::string>(message);
     for (const auto& it : m.callbacks) {
       try {
-        it.second(channel, message);
+        it.second(channel, shared_message);
       } catch (const std::exception& e) {
         LOG_ERROR() << "Unhandled exception in subscriber: " << e.what();
       }
@@ -631,9 +634,10 @@ void SubscriptionStorage::OnPmessage(ServerId server_id,
   try {
     std::lock_guard<std::mutex> lock(mutex_);
     auto& m = pattern_callback_map_.at(pattern);
+    const auto shared_message = std::make_shared<const std::string>(message);
     for (const auto& it : m.callbacks) {
       try {
-        it.second(pattern, channel, message);
+        it.second(pattern, channel, shared_message);
       } catch (const std::exception& e) {
         LOG_ERROR() << "Unhandled exception in subscriber: " << e.what();
       }
@@ -55,10 +55,10 @@ class SubscriptionStorage
   void SetUnsubscribeCallback(CommandCb);
 
   SubscriptionToken Subscribe(const std::string& channel,
-                              Sentinel::UserMessageCallback cb,
+                              Sentinel::UserSharedMessageCallback cb,
                               CommandControl control);
   SubscriptionToken Psubscribe(const std::string& pattern,
-                               Sentinel::UserPmessageCallback cb,
+                               Sentinel::UserSharedPmessageCallback cb,
                                CommandControl control);
 
   void Unsubscribe(SubscriptionId subscription_id);
@@ -177,14 +177,14 @@ class SubscriptionStorage
    * independent Fsms for distinct channels.
    */
   struct ChannelInfo {
-    std::map<SubscriptionId, Sentinel::UserMessageCallback> callbacks;
+    std::map<SubscriptionId, Sentinel::UserSharedMessageCallback> callbacks;
     CommandControl control;
     // shard -> Fsm
     std::vector<ShardChannelInfo> info;
     size_t active_fsm_count{0};
   };
   struct PChannelInfo {
-    std::map<SubscriptionId, Sentinel::UserPmessageCallback> callbacks;
+    std::map<SubscriptionId, Sentinel::UserSharedPmessageCallback> callbacks;
     CommandControl control;
     // shard -> Fsm
     std::vector<ShardChannelInfo> info;
@@ -0,0 +1,248 @@
+#include <storages/redis/mock_server_benchmark.hpp>
+
+#include <cctype>
+#include <chrono>
+#include <stdexcept>
+#include <string_view>
+
+#include <hiredis/hiredis.h>
+
+#include <storages/redis/client_impl.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/redis/impl/secdist_redis.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis::bench {
+
+namespace {
+
+namespace io = boost::asio;
+
+const std::string kLocalhost = "127.0.0.1";
+constexpr std::string_view kCrlf = "\r\n";
+
+void AppendBulk(std::string& out, std::string_view value) {
+  out += '$';
+  out += std::to_string(value.size());
+  out += kCrlf;
+  out += value;
+  out += kCrlf;
+}
+
+void AppendArrayHeader(std::string& out, std::size_t size) {
+  out += '*';
+  out += std::to_string(size);
+  out += kCrlf;
+}
+
+bool IsCommand(const redisReply& arg, std::string_view name) {
+  if (arg.type != REDIS_REPLY_STRING || arg.len != name.size()) return false;
+  for (std::size_t i = 0; i < name.size(); ++i) {
+    if (std::toupper(static_cast<unsigned char>(arg.str[i])) != name[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string MakeMastersReply(
+    const std::vector<MockServer::MasterInfo>& masters) {
+  std::string result;
+  AppendArrayHeader(result, masters.size());
+  for (const auto& master : masters) {
+    AppendArrayHeader(result, 8);
+    AppendBulk(result, "name");
+    AppendBulk(result, master.name);
+    AppendBulk(result, "ip");
+    AppendBulk(result, kLocalhost);
+    AppendBulk(result, "port");
+    AppendBulk(result, std::to_string(master.port));
+    AppendBulk(result, "flags");
+    AppendBulk(result, "master");
+  }
+  return result;
+}
+
+}  // namespace
+
+class MockServer::Session final
+    : public std::enable_shared_from_this<Session> {
+ public:
+  Session(const MockServer& server, io::ip::tcp::socket socket)
+      : server_(server),
+        socket_(std::move(socket)),
+        reader_(redisReaderCreate(), &redisReaderFree) {
+    socket_.set_option(io::ip::tcp::no_delay(true));
+  }
+
+  void Start() { DoRead(); }
+
+ private:
+  void DoRead() {
+    socket_.async_read_some(
+        io::buffer(read_buffer_),
+        [self = shared_from_this()](boost::system::error_code ec,
+                                    std::size_t count) {
+          self->OnRead(ec, count);
+        });
+  }
+
+  void OnRead(boost::system::error_code ec, std::size_t count) {
+    // The session is destroyed once no handlers hold it
+    if (ec) return;
+
+    if (redisReaderFeed(reader_.get(), read_buffer_.data(), count) !=
+        REDIS_OK) {
+      LOG_ERROR() << "Invalid command: " << reader_->errstr;
+      return;
+    }
+    void* command = nullptr;
+    while (redisReaderGetReply(reader_.get(), &command) == REDIS_OK &&
+           command) {
+      server_.AppendReply(command, pending_);
+      freeReplyObject(command);
+      command = nullptr;
+    }
+
+    DoWrite();
+    DoRead();
+  }
+
+  // The replies to the commands read while a write is in progress are sent
+  // with the next write
+  void DoWrite() {
+    if (is_writing_ || pending_.empty()) return;
+    is_writing_ = true;
+    std::swap(pending_, writing_);
+    io::async_write(socket_, io::buffer(writing_),
+                    [self = shared_from_this()](boost::system::error_code ec,
+                                                std::size_t) {
+                      self->is_writing_ = false;
+                      self->writing_.clear();
+                      if (!ec) self->DoWrite();
+                    });
+  }
+
+  const MockServer& server_;
+  io::ip::tcp::socket socket_;
+  std::unique_ptr<redisReader, decltype(&redisReaderFree)> reader_;
+  std::array<char, 16 * 1024> read_buffer_{};
+  std::string pending_;
+  std::string writing_;
+  bool is_writing_{false};
+};
+
+MockServer::MockServer(std::size_t value_size,
+                       const std::vector<MasterInfo>& masters)
+    : acceptor_(io_context_,
+                io::ip::tcp::endpoint(io::ip::make_address(kLocalhost), 0)),
+      masters_reply_(MakeMastersReply(masters)) {
+  AppendBulk(value_reply_, std::string(value_size, 'x'));
+  Accept();
+  thread_ = std::thread([this] { io_context_.run(); });
+}
+
+MockServer::~MockServer() {
+  io_context_.stop();
+  if (thread_.joinable()) thread_.join();
+}
+
+int MockServer::GetPort() const { return acceptor_.local_endpoint().port(); }
+
+void MockServer::Accept() {
+  acceptor_.async_accept(
+      [this](boost::system::error_code ec, io::ip::tcp::socket socket) {
+        if (ec) return;
+        std::make_shared<Session>(*this, std::move(socket))->Start();
+        Accept();
+      });
+}
+
+void MockServer::AppendReply(const void* command, std::string& out) const {
+  const auto& reply = *static_cast<const redisReply*>(command);
+  if (reply.type != REDIS_REPLY_ARRAY || reply.elements == 0) {
+    out += "-ERR unexpected command\r\n";
+    return;
+  }
+  const auto& name = *reply.element[0];
+
+  if (IsCommand(name, "GET") || IsCommand(name, "EVALSHA")) {
+    out += value_reply_;
+  } else if (IsCommand(name, "MGET")) {
+    AppendArrayHeader(out, reply.elements - 1);
+    for (std::size_t i = 1; i < reply.elements; ++i) out += value_reply_;
+  } else if (IsCommand(name, "PING")) {
+    out += "+PONG\r\n";
+  } else if (IsCommand(name, "INFO")) {
+    AppendBulk(out, "role:master\r\n");
+  } else if (IsCommand(name, "SENTINEL") && reply.elements > 1) {
+    if (IsCommand(*reply.element[1], "MASTERS")) {
+      out += masters_reply_;
+    } else {
+      // No replicas
+      AppendArrayHeader(out, 0);
+    }
+  } else {
+    out += "+OK\r\n";
+  }
+}
+
+MockCluster::MockCluster(std::size_t shards_count,
+                         std::size_t connections_per_instance,
+                         std::size_t value_size)
+    : thread_pools_(std::make_shared<USERVER_NAMESPACE::redis::ThreadPools>(
+          USERVER_NAMESPACE::redis::kDefaultSentinelThreadPoolSize,
+          USERVER_NAMESPACE::redis::kDefaultRedisThreadPoolSize)) {
+  USERVER_NAMESPACE::secdist::RedisSettings settings;
+  std::vector<MockServer::MasterInfo> master_infos;
+  for (std::size_t i = 0; i < shards_count; ++i) {
+    masters_.push_back(std::make_unique<MockServer>(value_size));
+    master_infos.push_back(
+        {"shard" + std::to_string(i), masters_.back()->GetPort()});
+    settings.shards.push_back(master_infos.back().name);
+  }
+  sentinel_ = std::make_unique<MockServer>(value_size, master_infos);
+  settings.sentinels.emplace_back(kLocalhost, sentinel_->GetPort());
+
+  USERVER_NAMESPACE::redis::CommandControl command_control{
+      std::chrono::seconds{10}, std::chrono::seconds{10}, 1};
+  command_control.force_request_to_master = true;
+  auto sentinel = USERVER_NAMESPACE::redis::Sentinel::CreateSentinel(
+      thread_pools_, settings, "bench", "bench",
+      USERVER_NAMESPACE::redis::KeyShardFactory{""}, command_control);
+  sentinel->SetConnectionsPerInstance(connections_per_instance);
+  sentinel->WaitConnectedDebug(/*allow_empty_slaves=*/true);
+
+  // The additional connections are created after the first one
+  const auto is_connected = [&sentinel, connections_per_instance] {
+    for (const auto& [name, shard] : sentinel->GetStatistics().masters) {
+      for (const auto& [instance, stats] : shard.instances) {
+        if (stats.connections < connections_per_instance) return false;
+      }
+    }
+    return true;
+  };
+  const auto deadline =
+      engine::Deadline::FromDuration(std::chrono::seconds{10});
+  while (!is_connected()) {
+    if (deadline.IsReached()) {
+      throw std::runtime_error("Failed to connect to the mock redis servers");
+    }
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+
+  client_ = std::make_shared<ClientImpl>(std::move(sentinel));
+}
+
+MockCluster::~MockCluster() {
+  client_.reset();
+  sentinel_.reset();
+  masters_.clear();
+}
+
+}  // namespace storages::redis::bench
+
+USERVER_NAMESPACE_END
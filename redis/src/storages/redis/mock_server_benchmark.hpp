@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include <userver/storages/redis/client_fwd.hpp>
+#include <userver/storages/redis/impl/sentinel.hpp>
+#include <userver/storages/redis/impl/thread_pools.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis::bench {
+
+/// @brief In-process redis server for the driver benchmarks.
+///
+/// Unlike the MockRedisServer of the unit tests, serves any number of
+/// connections and pipelines the replies. GET, MGET and EVALSHA are replied
+/// with a constant value of the configured size, SET and the unknown
+/// commands with OK. May also act as a sentinel reporting the given masters.
+class MockServer final {
+ public:
+  struct MasterInfo {
+    std::string name;
+    int port;
+  };
+
+  explicit MockServer(std::size_t value_size,
+                      const std::vector<MasterInfo>& masters = {});
+  ~MockServer();
+
+  MockServer(const MockServer&) = delete;
+  MockServer& operator=(const MockServer&) = delete;
+
+  int GetPort() const;
+
+ private:
+  class Session;
+
+  void Accept();
+  void AppendReply(const void* command, std::string& out) const;
+
+  boost::asio::io_context io_context_;
+  boost::asio::ip::tcp::acceptor acceptor_;
+  std::string value_reply_;
+  std::string masters_reply_;
+  std::thread thread_;
+};
+
+/// Redis client for the shards served by the MockServer instances
+class MockCluster final {
+ public:
+  MockCluster(std::size_t shards_count, std::size_t connections_per_instance,
+              std::size_t value_size);
+  ~MockCluster();
+
+  ClientPtr GetClient() const { return client_; }
+
+ private:
+  std::vector<std::unique_ptr<MockServer>> masters_;
+  std::unique_ptr<MockServer> sentinel_;
+  std::shared_ptr<USERVER_NAMESPACE::redis::ThreadPools> thread_pools_;
+  ClientPtr client_;
+};
+
+}  // namespace storages::redis::bench
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,103 @@
+#include <userver/storages/redis/near_cache.hpp>
+
+#include <userver/cache/lru_cache_component_base.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/redis/client.hpp>
+#include <userver/storages/redis/subscribe_client.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+namespace {
+
+constexpr const char* kStatisticsNameInvalidations = "invalidations";
+constexpr const char* kStatisticsNameMaxLifetime = "max-lifetime-ms";
+
+std::string MakeChannelPrefix(size_t db) {
+  return "__keyspace@" + std::to_string(db) + "__:";
+}
+
+// Escapes the glob special characters of PSUBSCRIBE
+std::string EscapePattern(const std::string& str) {
+  std::string result;
+  result.reserve(str.size());
+  for (const char c : str) {
+    if (c == '*' || c == '?' || c == '[' || c == ']' || c == '\\') {
+      result.push_back('\\');
+    }
+    result.push_back(c);
+  }
+  return result;
+}
+
+}  // namespace
+
+NearCache::NearCache(ClientPtr client, SubscribeClientPtr subscribe_client,
+                     const NearCacheSettings& settings)
+    : client_(std::move(client)),
+      key_prefix_(settings.key_prefix),
+      channel_prefix_(MakeChannelPrefix(settings.db)),
+      cache_(settings.ways, settings.way_size) {
+  UINVARIANT(client_, "No redis client for the near cache");
+  UINVARIANT(subscribe_client, "No redis subscribe client for the near cache");
+  cache_.SetMaxLifetime(settings.max_lifetime);
+
+  subscription_ = subscribe_client->Psubscribe(
+      channel_prefix_ + EscapePattern(key_prefix_) + '*',
+      [this](const std::string&, const std::string& channel,
+             const std::string&) { OnKeyspaceNotification(channel); });
+}
+
+NearCache::~NearCache() { subscription_.Unsubscribe(); }
+
+std::optional<std::string> NearCache::Get(
+    const std::string& key, const CommandControl& command_control) {
+  if (key.compare(0, key_prefix_.size(), key_prefix_) != 0) {
+    return client_->Get(key, command_control).Get();
+  }
+
+  if (auto cached = cache_.GetOptionalNoUpdate(key)) return std::move(*cached);
+
+  const auto epoch = invalidation_epoch_.load();
+  auto value = client_->Get(key, command_control).Get();
+  // The value may be older than an invalidation received during the request
+  if (invalidation_epoch_.load() == epoch) cache_.Put(key, value);
+  return value;
+}
+
+void NearCache::InvalidateByKey(const std::string& key) {
+  ++invalidation_epoch_;
+  ++invalidations_;
+  cache_.InvalidateByKey(key);
+}
+
+void NearCache::Invalidate() {
+  ++invalidation_epoch_;
+  ++invalidations_;
+  cache_.Invalidate();
+}
+
+formats::json::Value NearCache::GetStatisticsAsJson() const {
+  formats::json::ValueBuilder builder{
+      cache::impl::GetCacheStatisticsAsJson(cache_)};
+  builder[kStatisticsNameInvalidations] = invalidations_.load();
+  builder[kStatisticsNameMaxLifetime] = cache_.GetMaxLifetime().count();
+  return builder.ExtractValue();
+}
+
+void NearCache::OnKeyspaceNotification(const std::string& channel) {
+  if (channel.compare(0, channel_prefix_.size(), channel_prefix_) != 0) {
+    LOG_LIMITED_WARNING() << "Unexpected keyspace notification channel: "
+                          << channel;
+    Invalidate();
+    return;
+  }
+  InvalidateByKey(channel.substr(channel_prefix_.size()));
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,93 @@
+#include <userver/utest/utest.hpp>
+
+#include <memory>
+#include <string>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/formats/json/value.hpp>
+
+#include <storages/redis/client_impl.hpp>
+#include <storages/redis/impl/subscribe_sentinel.hpp>
+#include <storages/redis/subscribe_client_impl.hpp>
+#include <storages/redis/util_redistest.hpp>
+#include <userver/storages/redis/impl/sentinel.hpp>
+#include <userver/storages/redis/impl/thread_pools.hpp>
+#include <userver/storages/redis/near_cache.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+auto GetThreadPools() {
+  return std::make_shared<redis::ThreadPools>(
+      redis::kDefaultSentinelThreadPoolSize,
+      redis::kDefaultRedisThreadPoolSize);
+}
+
+std::shared_ptr<storages::redis::Client> GetClient() {
+  auto sentinel = redis::Sentinel::CreateSentinel(
+      GetThreadPools(), GetTestsuiteRedisSettings(), "none", "pub",
+      redis::KeyShardFactory{""});
+  sentinel->WaitConnectedDebug();
+
+  sentinel->MakeRequest({"FLUSHDB"}, "none").Get();
+  sentinel->MakeRequest({"CONFIG", "SET", "notify-keyspace-events", "K$g"},
+                        "none")
+      .Get();
+
+  return std::make_shared<storages::redis::ClientImpl>(std::move(sentinel));
+}
+
+storages::redis::SubscribeClientPtr GetSubscribeClient() {
+  auto sentinel = redis::SubscribeSentinel::Create(
+      GetThreadPools(), GetTestsuiteRedisSettings(), "none", "sub", false, {});
+  sentinel->WaitConnectedDebug();
+
+  return std::make_shared<storages::redis::SubscribeClientImpl>(
+      std::move(sentinel));
+}
+
+}  // namespace
+
+UTEST(RedisNearCache, InvalidatedByKeyspaceNotifications) {
+  auto client = GetClient();
+  storages::redis::NearCacheSettings settings;
+  settings.max_lifetime = std::chrono::minutes{1};
+  settings.key_prefix = "near:";
+  storages::redis::NearCache cache{client, GetSubscribeClient(), settings};
+  // Lets the subscription be established
+  engine::SleepFor(std::chrono::milliseconds{100});
+
+  client->Set("near:key", "old", {}).Get();
+  EXPECT_EQ(cache.Get("near:key", {}), "old");
+  EXPECT_EQ(cache.Get("near:key", {}), "old");
+  EXPECT_FALSE(cache.Get("near:missing", {}));
+
+  client->Set("near:key", "new", {}).Get();
+  const auto deadline =
+      engine::Deadline::FromDuration(std::chrono::seconds{5});
+  while (cache.Get("near:key", {}) != "new" && !deadline.IsReached()) {
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+  EXPECT_EQ(cache.Get("near:key", {}), "new");
+
+  const auto stats = cache.GetStatisticsAsJson();
+  EXPECT_GE(stats["hits"].As<std::size_t>(), 1);
+  EXPECT_GE(stats["invalidations"].As<std::size_t>(), 1);
+  EXPECT_EQ(stats["max-lifetime-ms"].As<std::int64_t>(), 60000);
+}
+
+UTEST(RedisNearCache, KeysWithoutPrefixAreNotCached) {
+  auto client = GetClient();
+  storages::redis::NearCacheSettings settings;
+  settings.key_prefix = "near:";
+  storages::redis::NearCache cache{client, GetSubscribeClient(), settings};
+
+  client->Set("far:key", "old", {}).Get();
+  EXPECT_EQ(cache.Get("far:key", {}), "old");
+  client->Set("far:key", "new", {}).Get();
+  EXPECT_EQ(cache.Get("far:key", {}), "new");
+}
+
+USERVER_NAMESPACE_END
@@ -106,6 +106,10 @@ MetricsSettings Parse(const formats::json::Value& elem,
       elem["request-sizes-enabled"].As<bool>(result.request_sizes_enabled);
   result.reply_sizes_enabled =
       elem["reply-sizes-enabled"].As<bool>(result.reply_sizes_enabled);
+  result.batch_sizes_enabled =
+      elem["batch-sizes-enabled"].As<bool>(result.batch_sizes_enabled);
+  result.pipeline_depth_enabled =
+      elem["pipeline-depth-enabled"].As<bool>(result.pipeline_depth_enabled);
   return result;
 }
 
@@ -0,0 +1,43 @@
+#include <userver/storages/redis/subscribe_client.hpp>
+
+#include <memory>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+SubscriptionToken SubscribeClient::SubscribeBatched(
+    std::string channel, SubscriptionToken::OnMessagesCb on_messages_cb,
+    const SubscriptionBatchSettings& /*batch_settings*/,
+    const USERVER_NAMESPACE::redis::CommandControl& command_control) {
+  return Subscribe(
+      std::move(channel),
+      [on_messages_cb = std::move(on_messages_cb)](const std::string& channel,
+                                                   const std::string& message) {
+        const std::vector<SubscriptionToken::SharedMessage> messages{
+            std::make_shared<const std::string>(message)};
+        on_messages_cb(channel, messages);
+      },
+      command_control);
+}
+
+SubscriptionToken SubscribeClient::PsubscribeBatched(
+    std::string pattern, SubscriptionToken::OnPmessagesCb on_pmessages_cb,
+    const SubscriptionBatchSettings& /*batch_settings*/,
+    const USERVER_NAMESPACE::redis::CommandControl& command_control) {
+  return Psubscribe(
+      std::move(pattern),
+      [on_pmessages_cb = std::move(on_pmessages_cb)](
+          const std::string& pattern, const std::string& channel,
+          const std::string& message) {
+        const std::vector<SubscriptionToken::PatternMessage> messages{
+            {channel, std::make_shared<const std::string>(message)}};
+        on_pmessages_cb(pattern, messages);
+      },
+      command_control);
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
@@ -28,6 +28,24 @@ SubscriptionToken SubscribeClientImpl::Psubscribe(
       command_control)};
 }
 
+SubscriptionToken SubscribeClientImpl::SubscribeBatched(
+    std::string channel, SubscriptionToken::OnMessagesCb on_messages_cb,
+    const SubscriptionBatchSettings& batch_settings,
+    const USERVER_NAMESPACE::redis::CommandControl& command_control) {
+  return {std::make_unique<SubscriptionTokenImpl>(
+      *redis_client_, std::move(channel), std::move(on_messages_cb),
+      batch_settings, command_control)};
+}
+
+SubscriptionToken SubscribeClientImpl::PsubscribeBatched(
+    std::string pattern, SubscriptionToken::OnPmessagesCb on_pmessages_cb,
+    const SubscriptionBatchSettings& batch_settings,
+    const USERVER_NAMESPACE::redis::CommandControl& command_control) {
+  return {std::make_unique<PsubscriptionTokenImpl>(
+      *redis_client_, std::move(pattern), std::move(on_pmessages_cb),
+      batch_settings, command_control)};
+}
+
 void SubscribeClientImpl::WaitConnectedOnce(
     USERVER_NAMESPACE::redis::RedisWaitConnected wait_connected) {
   redis_client_->WaitConnectedOnce(wait_connected);
@@ -43,6 +43,16 @@ class SubscribeClientImpl final : public SubscribeClient {
       std::string pattern, SubscriptionToken::OnPmessageCb on_pmessage_cb,
       const USERVER_NAMESPACE::redis::CommandControl& command_control) override;
 
+  SubscriptionToken SubscribeBatched(
+      std::string channel, SubscriptionToken::OnMessagesCb on_messages_cb,
+      const SubscriptionBatchSettings& batch_settings,
+      const USERVER_NAMESPACE::redis::CommandControl& command_control) override;
+
+  SubscriptionToken PsubscribeBatched(
+      std::string pattern, SubscriptionToken::OnPmessagesCb on_pmessages_cb,
+      const SubscriptionBatchSettings& batch_settings,
+      const USERVER_NAMESPACE::redis::CommandControl& command_control) override;
+
   void WaitConnectedOnce(
       USERVER_NAMESPACE::redis::RedisWaitConnected wait_connected);
 
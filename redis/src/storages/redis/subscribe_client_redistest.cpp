@@ -0,0 +1,152 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/sleep.hpp>
+
+#include <storages/redis/client_impl.hpp>
+#include <storages/redis/impl/subscribe_sentinel.hpp>
+#include <storages/redis/subscribe_client_impl.hpp>
+#include <storages/redis/util_redistest.hpp>
+#include <userver/storages/redis/impl/sentinel.hpp>
+#include <userver/storages/redis/impl/thread_pools.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr size_t kMessagesCount = 100;
+const std::string kChannel = "batched_channel";
+
+auto GetThreadPools() {
+  return std::make_shared<redis::ThreadPools>(
+      redis::kDefaultSentinelThreadPoolSize,
+      redis::kDefaultRedisThreadPoolSize);
+}
+
+std::shared_ptr<storages::redis::Client> GetClient() {
+  auto sentinel = redis::Sentinel::CreateSentinel(
+      GetThreadPools(), GetTestsuiteRedisSettings(), "none", "pub",
+      redis::KeyShardFactory{""});
+  sentinel->WaitConnectedDebug();
+  return std::make_shared<storages::redis::ClientImpl>(std::move(sentinel));
+}
+
+storages::redis::SubscribeClientPtr GetSubscribeClient() {
+  auto sentinel = redis::SubscribeSentinel::Create(
+      GetThreadPools(), GetTestsuiteRedisSettings(), "none", "sub", false, {});
+  sentinel->WaitConnectedDebug();
+
+  return std::make_shared<storages::redis::SubscribeClientImpl>(
+      std::move(sentinel));
+}
+
+void WaitForCount(const std::atomic<size_t>& counter, size_t count) {
+  const auto deadline =
+      engine::Deadline::FromDuration(std::chrono::seconds{5});
+  while (counter.load() < count && !deadline.IsReached()) {
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+}
+
+}  // namespace
+
+UTEST(RedisSubscribeClient, SubscribeBatched) {
+  auto client = GetClient();
+  auto subscribe_client = GetSubscribeClient();
+
+  std::atomic<size_t> received{0};
+  std::atomic<size_t> calls{0};
+  engine::Mutex mutex;
+  std::set<std::string> messages;
+  // Addresses of the buffers seen by the first subscriber
+  std::set<const std::string*> buffers;
+  std::atomic<size_t> shared_buffers{0};
+
+  storages::redis::SubscriptionBatchSettings batch_settings;
+  batch_settings.max_batch_size = 10;
+  batch_settings.workers_count = 2;
+
+  auto token1 = subscribe_client->SubscribeBatched(
+      kChannel,
+      [&](const std::string& channel,
+          const std::vector<storages::redis::SubscriptionToken::SharedMessage>&
+              batch) {
+        EXPECT_EQ(channel, kChannel);
+        EXPECT_LE(batch.size(), batch_settings.max_batch_size);
+        std::lock_guard<engine::Mutex> lock(mutex);
+        for (const auto& message : batch) {
+          messages.insert(*message);
+          buffers.insert(message.get());
+        }
+        ++calls;
+        received += batch.size();
+      },
+      batch_settings, {});
+  std::atomic<size_t> received2{0};
+  auto token2 = subscribe_client->SubscribeBatched(
+      kChannel,
+      [&](const std::string&,
+          const std::vector<storages::redis::SubscriptionToken::SharedMessage>&
+              batch) {
+        std::lock_guard<engine::Mutex> lock(mutex);
+        for (const auto& message : batch) {
+          if (buffers.count(message.get())) ++shared_buffers;
+        }
+        received2 += batch.size();
+      },
+      {}, {});
+  // Lets the subscriptions be established
+  engine::SleepFor(std::chrono::milliseconds{100});
+
+  for (size_t i = 0; i < kMessagesCount; ++i) {
+    client->Publish(kChannel, std::to_string(i), {});
+  }
+  WaitForCount(received, kMessagesCount);
+  WaitForCount(received2, kMessagesCount);
+
+  EXPECT_EQ(received.load(), kMessagesCount);
+  EXPECT_EQ(received2.load(), kMessagesCount);
+  EXPECT_EQ(messages.size(), kMessagesCount);
+  EXPECT_LE(calls.load(), kMessagesCount);
+  EXPECT_GT(shared_buffers.load(), 0);
+
+  token1.Unsubscribe();
+  token2.Unsubscribe();
+}
+
+UTEST(RedisSubscribeClient, PsubscribeBatched) {
+  auto client = GetClient();
+  auto subscribe_client = GetSubscribeClient();
+
+  std::atomic<size_t> received{0};
+  auto token = subscribe_client->PsubscribeBatched(
+      "batched_*",
+      [&](const std::string& pattern,
+          const std::vector<storages::redis::SubscriptionToken::PatternMessage>&
+              batch) {
+        EXPECT_EQ(pattern, "batched_*");
+        for (const auto& message : batch) {
+          EXPECT_EQ(message.channel, kChannel);
+          EXPECT_EQ(*message.message, "message");
+        }
+        received += batch.size();
+      },
+      {}, {});
+  engine::SleepFor(std::chrono::milliseconds{100});
+
+  for (size_t i = 0; i < kMessagesCount; ++i) {
+    client->Publish(kChannel, "message", {});
+  }
+  WaitForCount(received, kMessagesCount);
+  EXPECT_EQ(received.load(), kMessagesCount);
+}
+
+USERVER_NAMESPACE_END
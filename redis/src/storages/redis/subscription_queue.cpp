@@ -1,5 +1,7 @@
 #include "subscription_queue.hpp"
 
+#include <mutex>
+
 #include <userver/logging/log.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -29,8 +31,16 @@ void SubscriptionQueue<Item>::SetMaxLength(size_t length) {
 }
 
 template <typename Item>
-bool SubscriptionQueue<Item>::PopMessage(std::unique_ptr<Item>& msg_ptr) {
-  return consumer_.Pop(msg_ptr);
+bool SubscriptionQueue<Item>::PopMessages(std::vector<Item>& messages,
+                                          size_t max_count) {
+  std::lock_guard<engine::Mutex> lock(consumer_mutex_);
+  std::unique_ptr<Item> msg_ptr;
+  if (!consumer_.Pop(msg_ptr)) return false;
+  messages.push_back(std::move(*msg_ptr));
+  while (messages.size() < max_count && consumer_.PopNoblock(msg_ptr)) {
+    messages.push_back(std::move(*msg_ptr));
+  }
+  return true;
 }
 
 template <typename Item>
@@ -48,12 +58,13 @@ SubscriptionQueue<Item>::GetSubscriptionToken(
     const USERVER_NAMESPACE::redis::CommandControl& command_control) {
   return subscribe_sentinel.Subscribe(
       channel,
-      [this](const std::string& channel, const std::string& message) {
+      [this](const std::string& channel,
+             const SubscriptionToken::SharedMessage& message) {
         if (!producer_.PushNoblock(std::make_unique<Item>(message))) {
           // Use SubscriptionQueue::SetMaxLength() or
           // SubscriptionToken::SetMaxQueueLength() if limit is too low
           LOG_ERROR()
-              << "failed to push message '" << message << "' from channel '"
+              << "failed to push message '" << *message << "' from channel '"
               << channel
               << "' into subscription queue due to overflow (max length="
               << queue_->GetSoftMaxSize() << ')';
@@ -73,12 +84,13 @@ SubscriptionQueue<Item>::GetSubscriptionToken(
   return subscribe_sentinel.Psubscribe(
       pattern,
       [this](const std::string& pattern, const std::string& channel,
-             const std::string& message) {
-        if (!producer_.PushNoblock(std::make_unique<Item>(channel, message))) {
+             const SubscriptionToken::SharedMessage& message) {
+        if (!producer_.PushNoblock(
+                std::make_unique<Item>(Item{channel, message}))) {
           // Use SubscriptionQueue::SetMaxLength() or
           // SubscriptionToken::SetMaxQueueLength() if limit is too low
           LOG_ERROR()
-              << "failed to push pmessage '" << message << "' from channel '"
+              << "failed to push pmessage '" << *message << "' from channel '"
               << channel << "' from pattern '" << pattern
               << "' into subscription queue due to overflow (max length="
               << queue_->GetSoftMaxSize() << ')';
@@ -2,30 +2,19 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <storages/redis/impl/subscribe_sentinel.hpp>
 #include <userver/engine/mpsc_queue.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/storages/redis/subscription_token.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace storages::redis {
 
-struct ChannelSubscriptionQueueItem {
-  std::string message;
-
-  ChannelSubscriptionQueueItem() = default;
-  explicit ChannelSubscriptionQueueItem(std::string message)
-      : message(std::move(message)) {}
-};
-
-struct PatternSubscriptionQueueItem {
-  std::string channel;
-  std::string message;
-
-  PatternSubscriptionQueueItem() = default;
-  PatternSubscriptionQueueItem(std::string channel, std::string message)
-      : channel(std::move(channel)), message(std::move(message)) {}
-};
+using ChannelSubscriptionQueueItem = SubscriptionToken::SharedMessage;
+using PatternSubscriptionQueueItem = SubscriptionToken::PatternMessage;
 
 template <typename Item>
 class SubscriptionQueue {
@@ -41,7 +30,11 @@ class SubscriptionQueue {
 
   void SetMaxLength(size_t length);
 
-  bool PopMessage(std::unique_ptr<Item>& msg_ptr);
+  /// Waits for a message and appends it to `messages` along with the already
+  /// queued ones, up to `max_count` messages in total. May be called from
+  /// several tasks concurrently.
+  /// @returns false if the subscription is over
+  bool PopMessages(std::vector<Item>& messages, size_t max_count);
 
   void Unsubscribe();
 
@@ -67,6 +60,8 @@ class SubscriptionQueue {
   std::shared_ptr<Queue> queue_;
   typename Queue::Producer producer_;
   typename Queue::Consumer consumer_;
+  // Serializes the batch pops of the several consumer tasks
+  engine::Mutex consumer_mutex_;
   std::unique_ptr<USERVER_NAMESPACE::redis::SubscriptionToken> token_;
 };
 
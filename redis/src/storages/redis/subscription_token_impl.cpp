@@ -4,6 +4,7 @@
 
 #include <userver/engine/task/task_with_result.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/async.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -16,18 +17,65 @@ const std::string kSubscribeToPatternPrefix = "redis-pattern-subscriber-";
 const std::string kProcessRedisSubscriptionMessage =
     "process redis subscription message";
 
+// Keeps the per message callbacks sequential, one call per message
+constexpr SubscriptionBatchSettings kSingleMessageBatches{1, 1};
+
+void CheckBatchSettings(const SubscriptionBatchSettings& batch_settings) {
+  UINVARIANT(batch_settings.max_batch_size > 0,
+             "Subscription batch size must be positive");
+  UINVARIANT(batch_settings.workers_count > 0,
+             "Subscription workers count must be positive");
+}
+
+SubscriptionToken::OnMessagesCb ToBatchedCallback(
+    SubscriptionToken::OnMessageCb on_message_cb) {
+  if (!on_message_cb) return {};
+  return [on_message_cb = std::move(on_message_cb)](
+             const std::string& channel,
+             const std::vector<SubscriptionToken::SharedMessage>& messages) {
+    for (const auto& message : messages) on_message_cb(channel, *message);
+  };
+}
+
+SubscriptionToken::OnPmessagesCb ToBatchedCallback(
+    SubscriptionToken::OnPmessageCb on_pmessage_cb) {
+  if (!on_pmessage_cb) return {};
+  return [on_pmessage_cb = std::move(on_pmessage_cb)](
+             const std::string& pattern,
+             const std::vector<SubscriptionToken::PatternMessage>& messages) {
+    for (const auto& message : messages) {
+      on_pmessage_cb(pattern, message.channel, *message.message);
+    }
+  };
+}
+
 }  // namespace
 
 SubscriptionTokenImpl::SubscriptionTokenImpl(
     USERVER_NAMESPACE::redis::SubscribeSentinel& subscribe_sentinel,
     std::string channel, OnMessageCb on_message_cb,
     const USERVER_NAMESPACE::redis::CommandControl& command_control)
+    : SubscriptionTokenImpl(subscribe_sentinel, std::move(channel),
+                            ToBatchedCallback(std::move(on_message_cb)),
+                            kSingleMessageBatches, command_control) {}
+
+SubscriptionTokenImpl::SubscriptionTokenImpl(
+    USERVER_NAMESPACE::redis::SubscribeSentinel& subscribe_sentinel,
+    std::string channel, OnMessagesCb on_messages_cb,
+    const SubscriptionBatchSettings& batch_settings,
+    const USERVER_NAMESPACE::redis::CommandControl& command_control)
     : channel_(std::move(channel)),
       queue_(std::make_unique<SubscriptionQueue<ChannelSubscriptionQueueItem>>(
           subscribe_sentinel, channel_, command_control)),
-      on_message_cb_(std::move(on_message_cb)),
-      subscriber_task_(utils::Async(kSubscribeToChannelPrefix + channel_,
-                                    [this] { ProcessMessages(); })) {}
+      on_messages_cb_(std::move(on_messages_cb)),
+      max_batch_size_(batch_settings.max_batch_size) {
+  CheckBatchSettings(batch_settings);
+  subscriber_tasks_.reserve(batch_settings.workers_count);
+  for (size_t i = 0; i < batch_settings.workers_count; ++i) {
+    subscriber_tasks_.push_back(utils::Async(
+        kSubscribeToChannelPrefix + channel_, [this] { ProcessMessages(); }));
+  }
+}
 
 SubscriptionTokenImpl::~SubscriptionTokenImpl() { Unsubscribe(); }
 
@@ -37,14 +85,16 @@ void SubscriptionTokenImpl::SetMaxQueueLength(size_t length) {
 
 void SubscriptionTokenImpl::Unsubscribe() {
   queue_->Unsubscribe();
-  subscriber_task_.SyncCancel();
+  for (auto& task : subscriber_tasks_) task.SyncCancel();
 }
 
 void SubscriptionTokenImpl::ProcessMessages() {
-  std::unique_ptr<ChannelSubscriptionQueueItem> msg;
-  while (queue_->PopMessage(msg)) {
+  std::vector<ChannelSubscriptionQueueItem> messages;
+  messages.reserve(max_batch_size_);
+  while (queue_->PopMessages(messages, max_batch_size_)) {
     tracing::Span span(kProcessRedisSubscriptionMessage);
-    if (on_message_cb_) on_message_cb_(channel_, msg->message);
+    if (on_messages_cb_) on_messages_cb_(channel_, messages);
+    messages.clear();
   }
 }
 
@@ -52,12 +102,27 @@ PsubscriptionTokenImpl::PsubscriptionTokenImpl(
     USERVER_NAMESPACE::redis::SubscribeSentinel& subscribe_sentinel,
     std::string pattern, OnPmessageCb on_pmessage_cb,
     const USERVER_NAMESPACE::redis::CommandControl& command_control)
+    : PsubscriptionTokenImpl(subscribe_sentinel, std::move(pattern),
+                             ToBatchedCallback(std::move(on_pmessage_cb)),
+                             kSingleMessageBatches, command_control) {}
+
+PsubscriptionTokenImpl::PsubscriptionTokenImpl(
+    USERVER_NAMESPACE::redis::SubscribeSentinel& subscribe_sentinel,
+    std::string pattern, OnPmessagesCb on_pmessages_cb,
+    const SubscriptionBatchSettings& batch_settings,
+    const USERVER_NAMESPACE::redis::CommandControl& command_control)
     : pattern_(std::move(pattern)),
       queue_(std::make_unique<SubscriptionQueue<PatternSubscriptionQueueItem>>(
           subscribe_sentinel, pattern_, command_control)),
-      on_pmessage_cb_(std::move(on_pmessage_cb)),
-      subscriber_task_(utils::Async(kSubscribeToPatternPrefix + pattern_,
-                                    [this] { ProcessMessages(); })) {}
+      on_pmessages_cb_(std::move(on_pmessages_cb)),
+      max_batch_size_(batch_settings.max_batch_size) {
+  CheckBatchSettings(batch_settings);
+  subscriber_tasks_.reserve(batch_settings.workers_count);
+  for (size_t i = 0; i < batch_settings.workers_count; ++i) {
+    subscriber_tasks_.push_back(utils::Async(
+        kSubscribeToPatternPrefix + pattern_, [this] { ProcessMessages(); }));
+  }
+}
 
 PsubscriptionTokenImpl::~PsubscriptionTokenImpl() { Unsubscribe(); }
 
@@ -67,14 +132,16 @@ void PsubscriptionTokenImpl::SetMaxQueueLength(size_t length) {
 
 void PsubscriptionTokenImpl::Unsubscribe() {
   queue_->Unsubscribe();
-  subscriber_task_.SyncCancel();
+  for (auto& task : subscriber_tasks_) task.SyncCancel();
 }
 
 void PsubscriptionTokenImpl::ProcessMessages() {
-  std::unique_ptr<PatternSubscriptionQueueItem> msg;
-  while (queue_->PopMessage(msg)) {
+  std::vector<PatternSubscriptionQueueItem> messages;
+  messages.reserve(max_batch_size_);
+  while (queue_->PopMessages(messages, max_batch_size_)) {
     tracing::Span span(kProcessRedisSubscriptionMessage);
-    if (on_pmessage_cb_) on_pmessage_cb_(pattern_, msg->channel, msg->message);
+    if (on_pmessages_cb_) on_pmessages_cb_(pattern_, messages);
+    messages.clear();
   }
 }
 
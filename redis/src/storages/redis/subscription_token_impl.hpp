@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdexcept>
+#include <vector>
 
 #include <userver/engine/task/task_with_result.hpp>
 #include <userver/storages/redis/subscription_token.hpp>
@@ -14,12 +15,19 @@ namespace storages::redis {
 class SubscriptionTokenImpl : public SubscriptionTokenImplBase {
  public:
   using OnMessageCb = SubscriptionToken::OnMessageCb;
+  using OnMessagesCb = SubscriptionToken::OnMessagesCb;
 
   SubscriptionTokenImpl(
       USERVER_NAMESPACE::redis::SubscribeSentinel& subscribe_sentinel,
       std::string channel, OnMessageCb on_message_cb,
       const USERVER_NAMESPACE::redis::CommandControl& command_control);
 
+  SubscriptionTokenImpl(
+      USERVER_NAMESPACE::redis::SubscribeSentinel& subscribe_sentinel,
+      std::string channel, OnMessagesCb on_messages_cb,
+      const SubscriptionBatchSettings& batch_settings,
+      const USERVER_NAMESPACE::redis::CommandControl& command_control);
+
   ~SubscriptionTokenImpl() override;
 
   void SetMaxQueueLength(size_t length) override;
@@ -31,19 +39,27 @@ class SubscriptionTokenImpl : public SubscriptionTokenImplBase {
 
   std::string channel_;
   std::unique_ptr<SubscriptionQueue<ChannelSubscriptionQueueItem>> queue_;
-  OnMessageCb on_message_cb_;
-  engine::TaskWithResult<void> subscriber_task_;
+  OnMessagesCb on_messages_cb_;
+  size_t max_batch_size_;
+  std::vector<engine::TaskWithResult<void>> subscriber_tasks_;
 };
 
 class PsubscriptionTokenImpl : public SubscriptionTokenImplBase {
  public:
   using OnPmessageCb = SubscriptionToken::OnPmessageCb;
+  using OnPmessagesCb = SubscriptionToken::OnPmessagesCb;
 
   PsubscriptionTokenImpl(
       USERVER_NAMESPACE::redis::SubscribeSentinel& subscribe_sentinel,
       std::string pattern, OnPmessageCb on_pmessage_cb,
       const USERVER_NAMESPACE::redis::CommandControl& command_control);
 
+  PsubscriptionTokenImpl(
+      USERVER_NAMESPACE::redis::SubscribeSentinel& subscribe_sentinel,
+      std::string pattern, OnPmessagesCb on_pmessages_cb,
+      const SubscriptionBatchSettings& batch_settings,
+      const USERVER_NAMESPACE::redis::CommandControl& command_control);
+
   ~PsubscriptionTokenImpl() override;
 
   void SetMaxQueueLength(size_t length) override;
@@ -55,8 +71,9 @@ class PsubscriptionTokenImpl : public SubscriptionTokenImplBase {
 
   std::string pattern_;
   std::unique_ptr<SubscriptionQueue<PatternSubscriptionQueueItem>> queue_;
-  OnPmessageCb on_pmessage_cb_;
-  engine::TaskWithResult<void> subscriber_task_;
+  OnPmessagesCb on_pmessages_cb_;
+  size_t max_batch_size_;
+  std::vector<engine::TaskWithResult<void>> subscriber_tasks_;
 };
 
 }  // namespace storages::redis
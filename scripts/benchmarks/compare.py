@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+
+"""
+Compares two google-benchmark JSON reports, e.g. the ones written by the
+userver-benchmarks-report target before and after a change.
+
+Usage:
+    compare.py old.json new.json
+    compare.py old-benchmark-results/ new-benchmark-results/
+"""
+
+import argparse
+import json
+import os
+import sys
+
+TIME_UNIT_TO_NS = {'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+
+
+def load_report(path):
+    with open(path) as report_file:
+        report = json.load(report_file)
+
+    results = {}
+    for benchmark in report.get('benchmarks', []):
+        if 'error_occurred' in benchmark:
+            continue
+        scale = TIME_UNIT_TO_NS[benchmark.get('time_unit', 'ns')]
+        results[benchmark['name']] = {
+            'cpu_time': benchmark['cpu_time'] * scale,
+            'allocs_per_iter': benchmark.get('allocs_per_iter'),
+        }
+    return results
+
+
+def load_reports(path):
+    if not os.path.isdir(path):
+        return {'': load_report(path)}
+    return {
+        name: load_report(os.path.join(path, name))
+        for name in sorted(os.listdir(path))
+        if name.endswith('.json')
+    }
+
+
+def format_time(ns):
+    for unit, scale in (('s', 1e9), ('ms', 1e6), ('us', 1e3)):
+        if ns >= scale:
+            return '{:.2f}{}'.format(ns / scale, unit)
+    return '{:.1f}ns'.format(ns)
+
+
+def format_allocs(allocs):
+    return '-' if allocs is None else '{:.1f}'.format(allocs)
+
+
+def compare(old, new, threshold):
+    regressions = 0
+    row = '{:<60} {:>10} {:>10} {:>8} {:>8} {:>8}'
+    print(row.format('benchmark', 'old', 'new', 'diff', 'allocs', 'allocs'))
+    for report_name in sorted(set(old) & set(new)):
+        old_results = old[report_name]
+        new_results = new[report_name]
+        for name in sorted(set(old_results) & set(new_results)):
+            old_result = old_results[name]
+            new_result = new_results[name]
+            diff = (
+                new_result['cpu_time'] / old_result['cpu_time'] - 1
+                if old_result['cpu_time']
+                else 0
+            )
+            is_regression = threshold is not None and diff * 100 > threshold
+            regressions += is_regression
+            print(
+                row.format(
+                    name[:60],
+                    format_time(old_result['cpu_time']),
+                    format_time(new_result['cpu_time']),
+                    '{:+.1%}'.format(diff),
+                    format_allocs(old_result['allocs_per_iter']),
+                    format_allocs(new_result['allocs_per_iter']),
+                )
+                + (' REGRESSION' if is_regression else ''),
+            )
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip())
+    parser.add_argument('old', help='old JSON report or directory of them')
+    parser.add_argument('new', help='new JSON report or directory of them')
+    parser.add_argument(
+        '--threshold',
+        type=float,
+        help='fail if the CPU time of a benchmark grows by more percents',
+    )
+    args = parser.parse_args()
+
+    regressions = compare(
+        load_reports(args.old), load_reports(args.new), args.threshold,
+    )
+    if regressions:
+        print('{} benchmarks regressed'.format(regressions), file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
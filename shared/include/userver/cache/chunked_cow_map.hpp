@@ -0,0 +1,241 @@
+#pragma once
+
+/// @file userver/cache/chunked_cow_map.hpp
+/// @brief @copybrief cache::ChunkedCowMap
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @ingroup userver_containers
+///
+/// @brief Hash map that shares the unchanged data between its copies.
+///
+/// The elements are split into `ChunksCount` chunks by the key hash. A copy of
+/// the map only copies the pointers to the chunks, a modification copies the
+/// chunk of the modified element if the chunk is shared with another copy.
+///
+/// Useful as a container of the caches with incremental updates: the
+/// components::PostgreCache and components::MongoCache copy the cache data
+/// on each incremental update, with this container the update costs
+/// O(ChunksCount + changes * chunk size) instead of O(size).
+///
+/// @snippet shared/src/cache/chunked_cow_map_test.cpp  ChunkedCowMap usage
+///
+/// Different copies may be used concurrently, a single copy has the same
+/// thread safety guarantees as std::unordered_map. Iterators are invalidated
+/// by any modification of the map.
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>, std::size_t ChunksCount = 1024>
+class ChunkedCowMap final {
+  static_assert(ChunksCount > 0);
+
+  using Chunk = std::unordered_map<Key, Value, Hash, Equal>;
+  using ChunkPtr = std::shared_ptr<Chunk>;
+  using Chunks = std::vector<ChunkPtr>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = typename Chunk::value_type;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = Equal;
+
+  class const_iterator;
+  using iterator = const_iterator;
+
+  ChunkedCowMap() : chunks_(ChunksCount) {}
+
+  /// Shares all the chunks with `other`
+  ChunkedCowMap(const ChunkedCowMap& other) = default;
+  ChunkedCowMap(ChunkedCowMap&&) noexcept = default;
+  ChunkedCowMap& operator=(const ChunkedCowMap& other) = default;
+  ChunkedCowMap& operator=(ChunkedCowMap&&) noexcept = default;
+
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  const_iterator begin() const { return {chunks_.begin(), chunks_.end()}; }
+  const_iterator end() const { return {chunks_.end(), chunks_.end()}; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  const_iterator find(const Key& key) const;
+  size_type count(const Key& key) const { return find(key) == end() ? 0 : 1; }
+  bool contains(const Key& key) const { return find(key) != end(); }
+
+  /// @returns a reference to the value of the key, inserts a default
+  /// constructed value if there is none
+  Value& operator[](const Key& key);
+
+  template <typename K, typename V>
+  std::pair<const_iterator, bool> insert_or_assign(K&& key, V&& value);
+
+  size_type erase(const Key& key);
+  void clear();
+
+ private:
+  size_type GetChunkIndex(const Key& key) const {
+    return Hash{}(key) % ChunksCount;
+  }
+
+  // Copies the chunk if it is shared with other maps
+  Chunk& GetMutableChunk(size_type index);
+
+  const_iterator MakeIterator(size_type index,
+                              typename Chunk::const_iterator it) const {
+    return {chunks_.begin() + index, chunks_.end(), it};
+  }
+
+  Chunks chunks_;
+  size_type size_{0};
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal,
+          std::size_t ChunksCount>
+class ChunkedCowMap<Key, Value, Hash, Equal, ChunksCount>::const_iterator
+    final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = typename Chunk::value_type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const value_type*;
+  using reference = const value_type&;
+
+  const_iterator() = default;
+
+  reference operator*() const { return *it_; }
+  pointer operator->() const { return &*it_; }
+
+  const_iterator& operator++() {
+    ++it_;
+    SkipEmptyChunks();
+    return *this;
+  }
+
+  const_iterator operator++(int) {
+    auto copy = *this;
+    ++*this;
+    return copy;
+  }
+
+  bool operator==(const const_iterator& other) const {
+    return chunk_ == other.chunk_ &&
+           (chunk_ == chunks_end_ || it_ == other.it_);
+  }
+  bool operator!=(const const_iterator& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  friend class ChunkedCowMap;
+  using ChunksIterator = typename Chunks::const_iterator;
+
+  const_iterator(ChunksIterator chunk, ChunksIterator chunks_end)
+      : chunk_(chunk), chunks_end_(chunks_end) {
+    if (chunk_ != chunks_end_ && *chunk_) it_ = (*chunk_)->begin();
+    SkipEmptyChunks();
+  }
+
+  const_iterator(ChunksIterator chunk, ChunksIterator chunks_end,
+                 typename Chunk::const_iterator it)
+      : chunk_(chunk), chunks_end_(chunks_end), it_(it) {}
+
+  void SkipEmptyChunks() {
+    while (chunk_ != chunks_end_ && (!*chunk_ || it_ == (*chunk_)->end())) {
+      ++chunk_;
+      if (chunk_ != chunks_end_ && *chunk_) it_ = (*chunk_)->begin();
+    }
+  }
+
+  ChunksIterator chunk_{};
+  ChunksIterator chunks_end_{};
+  typename Chunk::const_iterator it_{};
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal,
+          std::size_t ChunksCount>
+auto ChunkedCowMap<Key, Value, Hash, Equal, ChunksCount>::find(
+    const Key& key) const -> const_iterator {
+  const auto index = GetChunkIndex(key);
+  const auto& chunk = chunks_[index];
+  if (!chunk) return end();
+
+  const auto it = chunk->find(key);
+  if (it == chunk->end()) return end();
+  return MakeIterator(index, it);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal,
+          std::size_t ChunksCount>
+Value& ChunkedCowMap<Key, Value, Hash, Equal, ChunksCount>::operator[](
+    const Key& key) {
+  auto& chunk = GetMutableChunk(GetChunkIndex(key));
+  const auto old_size = chunk.size();
+  auto& value = chunk[key];
+  size_ += chunk.size() - old_size;
+  return value;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal,
+          std::size_t ChunksCount>
+template <typename K, typename V>
+auto ChunkedCowMap<Key, Value, Hash, Equal, ChunksCount>::insert_or_assign(
+    K&& key, V&& value) -> std::pair<const_iterator, bool> {
+  const auto index = GetChunkIndex(key);
+  auto [it, inserted] = GetMutableChunk(index).insert_or_assign(
+      std::forward<K>(key), std::forward<V>(value));
+  if (inserted) ++size_;
+  return {MakeIterator(index, it), inserted};
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal,
+          std::size_t ChunksCount>
+auto ChunkedCowMap<Key, Value, Hash, Equal, ChunksCount>::erase(const Key& key)
+    -> size_type {
+  const auto index = GetChunkIndex(key);
+  const auto& chunk = chunks_[index];
+  // do not copy the chunk if there is nothing to erase
+  if (!chunk || chunk->find(key) == chunk->end()) return 0;
+
+  GetMutableChunk(index).erase(key);
+  --size_;
+  return 1;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal,
+          std::size_t ChunksCount>
+void ChunkedCowMap<Key, Value, Hash, Equal, ChunksCount>::clear() {
+  for (auto& chunk : chunks_) chunk.reset();
+  size_ = 0;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal,
+          std::size_t ChunksCount>
+auto ChunkedCowMap<Key, Value, Hash, Equal, ChunksCount>::GetMutableChunk(
+    size_type index) -> Chunk& {
+  auto& chunk = chunks_[index];
+  if (!chunk) {
+    chunk = std::make_shared<Chunk>();
+  } else if (chunk.use_count() > 1) {
+    chunk = std::make_shared<Chunk>(*chunk);
+  } else {
+    // synchronizes with the release of the chunk by the other copies
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  return *chunk;
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Count-min sketch of the access frequencies with 4-bit counters, that are
+/// halved after each `10 * capacity` increments to forget the old accesses
+class FrequencySketch final {
+ public:
+  /// Resizes the table for `capacity` elements, forgets the frequencies
+  void SetCapacity(std::size_t capacity);
+
+  void Increment(std::size_t hash) noexcept;
+
+  /// @returns the estimated frequency in [0, 15]
+  std::uint32_t Estimate(std::size_t hash) const noexcept;
+
+ private:
+  void Age() noexcept;
+
+  std::vector<std::uint64_t> table_;
+  std::size_t additions_{0};
+  std::size_t sample_size_{0};
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <memory>
+#include <type_traits>
 #include <vector>
 
 #include <boost/intrusive/link_mode.hpp>
@@ -8,6 +11,9 @@
 #include <boost/intrusive/unordered_set.hpp>
 #include <boost/intrusive/unordered_set_hook.hpp>
 
+#include <userver/cache/impl/frequency_sketch.hpp>
+#include <userver/cache/policy.hpp>
+#include <userver/cache/size_of.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/impl/intrusive_link_mode.hpp>
 
@@ -21,6 +27,13 @@ using LinkMode = utils::impl::IntrusiveLinkMode;
 using LruListHook = boost::intrusive::list_base_hook<LinkMode>;
 using LruHashSetHook = boost::intrusive::unordered_set_base_hook<LinkMode>;
 
+// The list that holds a node, see CachePolicy
+enum class LruSegment : unsigned char {
+  kMain,  // the whole LRU for kLRU, the probation segment for kTinyLFU
+  kWindow,
+  kProtected,
+};
+
 template <class Key, class Value>
 // NOLINTNEXTLINE(fuchsia-multiple-inheritance)
 class LruNode final : public LruListHook, public LruHashSetHook {
@@ -37,9 +50,14 @@ class LruNode final : public LruListHook, public LruHashSetHook {
   const Value& GetValue() const noexcept { return value_; }
   Value& GetValue() noexcept { return value_; }
 
+  void SetSegment(LruSegment segment) noexcept { segment_ = segment; }
+
+  LruSegment GetSegment() const noexcept { return segment_; }
+
  private:
   Key key_;
   Value value_;
+  LruSegment segment_{LruSegment::kMain};
 };
 
 template <class Key>
@@ -61,8 +79,13 @@ class LruNode<Key, EmptyPlaceholder> final : public LruListHook,
     return kValue;
   }
 
+  void SetSegment(LruSegment segment) noexcept { segment_ = segment; }
+
+  LruSegment GetSegment() const noexcept { return segment_; }
+
  private:
   Key key_;
+  LruSegment segment_{LruSegment::kMain};
 };
 
 template <class Key, class Value>
@@ -79,16 +102,34 @@ template <typename T, typename U, typename Hash = std::hash<T>,
           typename Equal = std::equal_to<T>>
 class LruBase final {
  public:
-  explicit LruBase(size_t max_size, const Hash& hash, const Equal& equal);
+  using Node = LruNode<T, U>;
+
+  explicit LruBase(size_t max_size, const Hash& hash, const Equal& equal,
+                   CachePolicy policy = CachePolicy::kLRU);
   ~LruBase() { Clear(); }
 
   LruBase(LruBase&& other) noexcept
       : buckets_(std::move(other.buckets_)),
         map_(std::move(other.map_)),
-        list_(std::move(other.list_)) {
+        list_(std::move(other.list_)),
+        window_(std::move(other.window_)),
+        protected_(std::move(other.protected_)),
+        window_size_(other.window_size_),
+        window_max_size_(other.window_max_size_),
+        protected_size_(other.protected_size_),
+        protected_max_size_(other.protected_max_size_),
+        size_in_bytes_(other.size_in_bytes_),
+        max_size_in_bytes_(other.max_size_in_bytes_),
+        policy_(other.policy_),
+        sketch_(std::move(other.sketch_)) {
     other.buckets_.clear();
     other.map_.clear();
     other.list_.clear();
+    other.window_.clear();
+    other.protected_.clear();
+    other.window_size_ = 0;
+    other.protected_size_ = 0;
+    other.size_in_bytes_ = 0;
   }
 
   LruBase& operator=(LruBase&& other) noexcept {
@@ -97,6 +138,16 @@ class LruBase final {
     swap(other.buckets_, buckets_);
     swap(other.map_, map_);
     swap(other.list_, list_);
+    swap(other.window_, window_);
+    swap(other.protected_, protected_);
+    std::swap(other.window_size_, window_size_);
+    std::swap(other.window_max_size_, window_max_size_);
+    std::swap(other.protected_size_, protected_size_);
+    std::swap(other.protected_max_size_, protected_max_size_);
+    std::swap(other.size_in_bytes_, size_in_bytes_);
+    std::swap(other.max_size_in_bytes_, max_size_in_bytes_);
+    std::swap(other.policy_, policy_);
+    std::swap(other.sketch_, sketch_);
 
     return *this;
   }
@@ -119,6 +170,8 @@ class LruBase final {
 
   void SetMaxSize(size_t new_max_size);
 
+  void SetMaxSizeInBytes(size_t max_size_in_bytes);
+
   void Clear() noexcept;
 
   template <typename Function>
@@ -129,8 +182,17 @@ class LruBase final {
 
   size_t GetSize() const;
 
+  size_t GetSizeInBytes() const noexcept;
+
+  CachePolicy GetPolicy() const noexcept { return policy_; }
+
+  // Lookup without the usage update, safe for concurrent calls
+  const Node* Find(const T& key) const;
+
+  // Updates the usage of the node returned by Find()
+  void Touch(const Node& node);
+
  private:
-  using Node = LruNode<T, U>;
   using List =
       boost::intrusive::list<Node, boost::intrusive::constant_time_size<false>>;
 
@@ -162,28 +224,65 @@ class LruBase final {
 
   U& Add(const T& key, U value);
   void MarkRecentlyUsed(Node& node) noexcept;
-  std::unique_ptr<Node> ExtractNode(typename List::iterator it) noexcept;
+  std::unique_ptr<Node> ExtractNode(Node& node) noexcept;
   Node& InsertNode(std::unique_ptr<Node>&& node) noexcept;
 
+  List& GetList(LruSegment segment) noexcept;
+  size_t* GetSegmentSize(LruSegment segment) noexcept;
+  void MoveToSegment(Node& node, LruSegment segment) noexcept;
+  Node* GetLeastUsedNode() noexcept;
+  Node& PickVictim();
+  void ShrinkSegments() noexcept;
+  void RecordAccess(const T& key) noexcept;
+  std::uint32_t EstimateFrequency(const Node& node) const noexcept;
+  void ResizePolicy(size_t max_size);
+  static size_t GetNodeSizeInBytes(const Node& node) noexcept;
+  void AddSizeInBytes(size_t added, size_t removed) noexcept;
+  void EvictOversized(const Node* keep) noexcept;
+
   std::vector<BucketType> buckets_;
   Map map_;
+  // the main LRU, contains all the elements in the kLRU mode
   List list_;
+
+  // kTinyLFU: new elements get into the window, the ones evicted from it may
+  // get into the probation segment (list_), and the ones accessed in probation
+  // are moved to the protected segment.
+  List window_;
+  List protected_;
+  size_t window_size_{0};
+  size_t window_max_size_{0};
+  size_t protected_size_{0};
+  size_t protected_max_size_{0};
+
+  // SizeOf of all the nodes, the limit is disabled if zero
+  size_t size_in_bytes_{0};
+  size_t max_size_in_bytes_{0};
+
+  CachePolicy policy_;
+  FrequencySketch sketch_;
 };
 
 template <typename T, typename U, typename Hash, typename Equal>
 LruBase<T, U, Hash, Equal>::LruBase(size_t max_size, const Hash& hash,
-                                    const Equal& eq)
+                                    const Equal& eq, CachePolicy policy)
     : buckets_(max_size ? max_size : 1),
-      map_(BucketTraits(buckets_.data(), buckets_.size()), hash, eq) {
+      map_(BucketTraits(buckets_.data(), buckets_.size()), hash, eq),
+      policy_(policy) {
   UASSERT(max_size > 0);
+  ResizePolicy(buckets_.size());
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 bool LruBase<T, U, Hash, Eq>::Put(const T& key, U value) {
+  RecordAccess(key);
   auto it = map_.find(key, map_.hash_function(), map_.key_eq());
   if (it != map_.end()) {
+    const auto old_size = GetNodeSizeInBytes(*it);
     it->SetValue(std::move(value));
+    AddSizeInBytes(GetNodeSizeInBytes(*it), old_size);
     MarkRecentlyUsed(*it);
+    EvictOversized(&*it);
     return false;
   }
 
@@ -203,27 +302,42 @@ template <typename T, typename U, typename Hash, typename Eq>
 void LruBase<T, U, Hash, Eq>::Erase(const T& key) {
   auto it = map_.find(key, map_.hash_function(), map_.key_eq());
   if (it == map_.end()) return;
-  ExtractNode(list_.iterator_to(*it));
+  ExtractNode(*it);
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 U* LruBase<T, U, Hash, Eq>::Get(const T& key) {
+  // misses are counted too, so that a repeatedly requested key gets admitted
+  RecordAccess(key);
   auto it = map_.find(key, map_.hash_function(), map_.key_eq());
   if (it == map_.end()) return nullptr;
   MarkRecentlyUsed(*it);
   return &it->GetValue();
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+const LruNode<T, U>* LruBase<T, U, Hash, Eq>::Find(const T& key) const {
+  auto it = map_.find(key, map_.hash_function(), map_.key_eq());
+  if (it == map_.end()) return nullptr;
+  return &*it;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void LruBase<T, U, Hash, Eq>::Touch(const Node& node) {
+  RecordAccess(node.GetKey());
+  MarkRecentlyUsed(const_cast<Node&>(node));
+}
+
 template <typename T, typename U, typename Hash, typename Eq>
 const T* LruBase<T, U, Hash, Eq>::GetLeastUsedKey() {
-  if (list_.empty()) return nullptr;
-  return &list_.front().GetKey();
+  auto* node = GetLeastUsedNode();
+  return node ? &node->GetKey() : nullptr;
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 U* LruBase<T, U, Hash, Eq>::GetLeastUsedValue() {
-  if (list_.empty()) return nullptr;
-  return &list_.front().GetValue();
+  auto* node = GetLeastUsedNode();
+  return node ? &node->GetValue() : nullptr;
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
@@ -236,18 +350,34 @@ void LruBase<T, U, Hash, Eq>::SetMaxSize(size_t new_max_size) {
   }
 
   while (map_.size() > new_max_size) {
-    ExtractNode(list_.begin());
+    ExtractNode(*GetLeastUsedNode());
   }
 
   std::vector<BucketType> new_buckets(new_max_size);
   map_.rehash(BucketTraits(new_buckets.data(), new_max_size));
   buckets_.swap(new_buckets);
+
+  ResizePolicy(new_max_size);
+  ShrinkSegments();
+  EvictOversized(nullptr);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void LruBase<T, U, Hash, Eq>::SetMaxSizeInBytes(size_t max_size_in_bytes) {
+  max_size_in_bytes_ = max_size_in_bytes;
+  EvictOversized(nullptr);
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void LruBase<T, U, Hash, Eq>::Clear() noexcept {
   while (!list_.empty()) {
-    ExtractNode(list_.begin());
+    ExtractNode(list_.front());
+  }
+  while (!window_.empty()) {
+    ExtractNode(window_.front());
+  }
+  while (!protected_.empty()) {
+    ExtractNode(protected_.front());
   }
 }
 
@@ -272,32 +402,51 @@ size_t LruBase<T, U, Hash, Eq>::GetSize() const {
   return map_.size();
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+size_t LruBase<T, U, Hash, Eq>::GetSizeInBytes() const noexcept {
+  return size_in_bytes_ + buckets_.size() * sizeof(BucketType);
+}
+
 template <typename T, typename U, typename Hash, typename Eq>
 U& LruBase<T, U, Hash, Eq>::Add(const T& key, U value) {
   if (map_.size() < buckets_.size()) {
     auto node = std::make_unique<Node>(T{key}, std::move(value));
-    return InsertNode(std::move(node)).GetValue();
+    auto& inserted = InsertNode(std::move(node));
+    ShrinkSegments();
+    EvictOversized(&inserted);
+    return inserted.GetValue();
   }
 
-  auto node = ExtractNode(list_.begin());
+  auto node = ExtractNode(PickVictim());
   node->SetKey(key);
   node->SetValue(std::move(value));
-  return InsertNode(std::move(node)).GetValue();
+  auto& inserted = InsertNode(std::move(node));
+  EvictOversized(&inserted);
+  return inserted.GetValue();
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void LruBase<T, U, Hash, Eq>::MarkRecentlyUsed(Node& node) noexcept {
-  list_.splice(list_.end(), list_, list_.iterator_to(node));
+  if (policy_ == CachePolicy::kTinyLFU &&
+      node.GetSegment() == LruSegment::kMain) {
+    MoveToSegment(node, LruSegment::kProtected);
+    ShrinkSegments();
+    return;
+  }
+
+  auto& list = GetList(node.GetSegment());
+  list.splice(list.end(), list, list.iterator_to(node));
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 std::unique_ptr<LruNode<T, U>> LruBase<T, U, Hash, Eq>::ExtractNode(
-    typename List::iterator it) noexcept {
-  UASSERT(it != list_.end());
-
-  std::unique_ptr<Node> ret(&*it);
-  map_.erase(map_.iterator_to(*it));
-  list_.erase(it);
+    Node& node) noexcept {
+  std::unique_ptr<Node> ret(&node);
+  map_.erase(map_.iterator_to(node));
+  auto& list = GetList(node.GetSegment());
+  list.erase(list.iterator_to(node));
+  if (auto* size = GetSegmentSize(node.GetSegment())) --*size;
+  AddSizeInBytes(0, GetNodeSizeInBytes(node));
   return ret;
 }
 
@@ -308,11 +457,142 @@ LruNode<T, U>& LruBase<T, U, Hash, Eq>::InsertNode(
 
   auto [it, ok] = map_.insert(*node);  // noexcept
   UASSERT(ok);
-  list_.insert(list_.end(), *node);  // noexcept
+  const auto segment = policy_ == CachePolicy::kTinyLFU ? LruSegment::kWindow
+                                                        : LruSegment::kMain;
+  node->SetSegment(segment);
+  GetList(segment).push_back(*node);  // noexcept
+  if (auto* size = GetSegmentSize(segment)) ++*size;
+  AddSizeInBytes(GetNodeSizeInBytes(*node), 0);
 
   return *node.release();
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+typename LruBase<T, U, Hash, Eq>::List& LruBase<T, U, Hash, Eq>::GetList(
+    LruSegment segment) noexcept {
+  if (segment == LruSegment::kWindow) return window_;
+  if (segment == LruSegment::kProtected) return protected_;
+  return list_;
+}
+
+// The main segment needs no counter, its size is never limited on its own
+template <typename T, typename U, typename Hash, typename Eq>
+size_t* LruBase<T, U, Hash, Eq>::GetSegmentSize(LruSegment segment) noexcept {
+  if (segment == LruSegment::kWindow) return &window_size_;
+  if (segment == LruSegment::kProtected) return &protected_size_;
+  return nullptr;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void LruBase<T, U, Hash, Eq>::MoveToSegment(Node& node,
+                                            LruSegment segment) noexcept {
+  auto& from = GetList(node.GetSegment());
+  from.erase(from.iterator_to(node));
+  if (auto* size = GetSegmentSize(node.GetSegment())) --*size;
+
+  node.SetSegment(segment);
+  GetList(segment).push_back(node);
+  if (auto* size = GetSegmentSize(segment)) ++*size;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+LruNode<T, U>* LruBase<T, U, Hash, Eq>::GetLeastUsedNode() noexcept {
+  for (auto* list : {&list_, &protected_, &window_}) {
+    if (!list->empty()) return &list->front();
+  }
+  return nullptr;
+}
+
+// Picks the node to evict to make room for a new one, that is going to be
+// inserted into the window
+template <typename T, typename U, typename Hash, typename Eq>
+LruNode<T, U>& LruBase<T, U, Hash, Eq>::PickVictim() {
+  UASSERT(map_.size() > 0);
+  if (policy_ == CachePolicy::kLRU || window_size_ < window_max_size_) {
+    return *GetLeastUsedNode();
+  }
+
+  auto& candidate = window_.front();
+  auto& main = list_.empty() ? protected_ : list_;
+  if (main.empty()) return candidate;
+
+  auto& victim = main.front();
+  if (EstimateFrequency(candidate) > EstimateFrequency(victim)) {
+    MoveToSegment(candidate, LruSegment::kMain);
+    return victim;
+  }
+  return candidate;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void LruBase<T, U, Hash, Eq>::ShrinkSegments() noexcept {
+  while (window_size_ > window_max_size_) {
+    MoveToSegment(window_.front(), LruSegment::kMain);
+  }
+  while (protected_size_ > protected_max_size_) {
+    MoveToSegment(protected_.front(), LruSegment::kMain);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+size_t LruBase<T, U, Hash, Eq>::GetNodeSizeInBytes(const Node& node) noexcept {
+  auto result = sizeof(Node) - sizeof(T) + SizeOf<T>{}(node.GetKey());
+  if constexpr (!std::is_same_v<U, EmptyPlaceholder>) {
+    result += SizeOf<U>{}(node.GetValue()) - sizeof(U);
+  }
+  return result;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void LruBase<T, U, Hash, Eq>::AddSizeInBytes(size_t added,
+                                             size_t removed) noexcept {
+  size_in_bytes_ += added;
+  // values changed in place through VisitAll are not accounted
+  size_in_bytes_ -= std::min(removed, size_in_bytes_);
+}
+
+// Evicts the least used nodes except `keep` until the size in bytes fits
+template <typename T, typename U, typename Hash, typename Eq>
+void LruBase<T, U, Hash, Eq>::EvictOversized(const Node* keep) noexcept {
+  while (max_size_in_bytes_ != 0 && GetSizeInBytes() > max_size_in_bytes_) {
+    Node* victim = nullptr;
+    for (auto* list : {&list_, &protected_, &window_}) {
+      auto it = list->begin();
+      if (it != list->end() && &*it == keep) ++it;
+      if (it != list->end()) {
+        victim = &*it;
+        break;
+      }
+    }
+    if (!victim) return;
+    ExtractNode(*victim);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void LruBase<T, U, Hash, Eq>::RecordAccess(const T& key) noexcept {
+  if (policy_ == CachePolicy::kTinyLFU) {
+    sketch_.Increment(map_.hash_function()(key));
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+std::uint32_t LruBase<T, U, Hash, Eq>::EstimateFrequency(
+    const Node& node) const noexcept {
+  return sketch_.Estimate(map_.hash_function()(node.GetKey()));
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void LruBase<T, U, Hash, Eq>::ResizePolicy(size_t max_size) {
+  if (policy_ != CachePolicy::kTinyLFU) return;
+
+  // 1% of the cache for the window and 80% of the rest for the protected
+  // segment, as in the W-TinyLFU paper
+  window_max_size_ = std::max(max_size / 100, size_t{1});
+  protected_max_size_ = (max_size - window_max_size_) * 4 / 5;
+  sketch_.SetCapacity(max_size);
+}
+
 }  // namespace cache::impl
 
 USERVER_NAMESPACE_END
@@ -4,6 +4,7 @@
 /// @brief @copybrief cache::LruMap
 
 #include <userver/cache/impl/lru.hpp>
+#include <userver/cache/policy.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -13,7 +14,7 @@ namespace cache {
 /// @ingroup userver_containers
 ///
 /// LRU key value storage (LRU cache), thread safety matches Standard Library
-/// thread safety
+/// thread safety. The eviction policy is set by cache::CachePolicy.
 template <typename T, typename U, typename Hash = std::hash<T>,
           typename Equal = std::equal_to<T>>
 class LruMap final {
@@ -22,6 +23,10 @@ class LruMap final {
                   const Equal& equal = Equal())
       : impl_(max_size, hash, equal) {}
 
+  LruMap(size_t max_size, CachePolicy policy, const Hash& hash = Hash(),
+         const Equal& equal = Equal())
+      : impl_(max_size, hash, equal, policy) {}
+
   LruMap(LruMap&& lru) noexcept = default;
   LruMap(const LruMap& lru) = delete;
   LruMap& operator=(LruMap&& lru) noexcept = default;
@@ -65,6 +70,15 @@ class LruMap final {
     return impl_.SetMaxSize(new_max_size);
   }
 
+  /// @brief Limits the memory usage of the LRU, see cache::SizeOf; zero
+  /// disables the limit.
+  ///
+  /// The least used elements are evicted to fit the limit, except for the
+  /// last added or updated one. The table of `max_size` buckets counts too.
+  void SetMaxSizeInBytes(size_t max_size_in_bytes) {
+    impl_.SetMaxSizeInBytes(max_size_in_bytes);
+  }
+
   /// Removes all the elements
   void Clear() { return impl_.Clear(); }
 
@@ -82,6 +96,23 @@ class LruMap final {
 
   size_t GetSize() const { return impl_.GetSize(); }
 
+  /// Returns the memory usage of the elements and of the table, see
+  /// cache::SizeOf
+  size_t GetSizeInBytes() const { return impl_.GetSizeInBytes(); }
+
+  CachePolicy GetPolicy() const noexcept { return impl_.GetPolicy(); }
+
+  /// @cond
+  // Lookup without the usage update for the concurrent reads of
+  // cache::NWayLRU. The node stays valid until the map is modified.
+  using NodeHandle = const impl::LruNode<T, U>*;
+
+  NodeHandle Peek(const T& key) const { return impl_.Find(key); }
+
+  // Updates the usage of the node returned by Peek()
+  void Touch(NodeHandle node) { impl_.Touch(*node); }
+  /// @endcond
+
  private:
   impl::LruBase<T, U, Hash, Equal> impl_;
 };
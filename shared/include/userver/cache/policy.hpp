@@ -0,0 +1,24 @@
+#pragma once
+
+/// @file userver/cache/policy.hpp
+/// @brief @copybrief cache::CachePolicy
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @brief Eviction policy of cache::LruMap, cache::NWayLRU and of the caches
+/// built on top of them
+enum class CachePolicy {
+  /// Evicts the least recently used element
+  kLRU,
+
+  /// W-TinyLFU: new elements get into a small LRU window, and an element
+  /// evicted from the window replaces the LRU victim of the main part only
+  /// if it was accessed more frequently. Keeps the hot set on one-off scans.
+  kTinyLFU,
+};
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,59 @@
+#pragma once
+
+/// @file userver/cache/size_of.hpp
+/// @brief @copybrief cache::SizeOf
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @brief Memory usage of a value in bytes, including `sizeof(T)`, for the
+/// caches limited in bytes, see cache::LruMap::SetMaxSizeInBytes
+///
+/// Specialize it for the types that own dynamic memory:
+/// @code
+/// template <>
+/// struct cache::SizeOf<MyValue> {
+///   std::size_t operator()(const MyValue& value) const noexcept {
+///     return sizeof(value) + value.blob.capacity();
+///   }
+/// };
+/// @endcode
+///
+/// The result must not change while the value is stored in a cache.
+template <typename T>
+struct SizeOf {
+  std::size_t operator()(const T& value) const noexcept {
+    return sizeof(value);
+  }
+};
+
+template <typename Char, typename Traits, typename Allocator>
+struct SizeOf<std::basic_string<Char, Traits, Allocator>> {
+  std::size_t operator()(
+      const std::basic_string<Char, Traits, Allocator>& value) const noexcept {
+    const auto* object = reinterpret_cast<const char*>(&value);
+    const auto* data = reinterpret_cast<const char*>(value.data());
+    const bool is_small = data >= object && data < object + sizeof(value);
+    return sizeof(value) +
+           (is_small ? 0 : (value.capacity() + 1) * sizeof(Char));
+  }
+};
+
+template <typename T, typename Allocator>
+struct SizeOf<std::vector<T, Allocator>> {
+  std::size_t operator()(const std::vector<T, Allocator>& value) const {
+    std::size_t result =
+        sizeof(value) + (value.capacity() - value.size()) * sizeof(T);
+    for (const auto& item : value) result += SizeOf<T>{}(item);
+    return result;
+  }
+};
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
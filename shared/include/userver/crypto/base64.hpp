@@ -3,6 +3,8 @@
 /// @file userver/crypto/base64.hpp
 /// @brief @copybrief crypto::base64
 
+#include <cstddef>
+#include <string>
 #include <string_view>
 
 USERVER_NAMESPACE_BEGIN
@@ -12,6 +14,18 @@ namespace crypto::base64 {
 
 enum class Pad { kWith, kWithout };
 
+/// @brief Returns the length of `size` bytes encoded to Base64
+constexpr std::size_t Base64EncodedSize(std::size_t size,
+                                        Pad pad = Pad::kWith) noexcept {
+  return pad == Pad::kWith ? (size + 2) / 3 * 4 : (size * 4 + 2) / 3;
+}
+
+/// @brief Returns the upper limit on the length of `size` Base64 characters
+/// after being decoded
+constexpr std::size_t Base64DecodedSizeUpperBound(std::size_t size) noexcept {
+  return size / 4 * 3 + size % 4 * 3 / 4;
+}
+
 /// @brief Encodes data to Base64, add padding by default
 /// @param pad controls if pad should be added or not
 /// @throws CryptoException internal library exception
@@ -21,6 +35,19 @@ std::string Base64Encode(std::string_view data, Pad pad = Pad::kWith);
 /// @throws CryptoException internal library exception
 std::string Base64Decode(std::string_view data);
 
+/// @brief Encodes data to Base64 into the caller-provided buffer
+/// @param out must have room for Base64EncodedSize(data.size(), pad) chars
+/// @returns the number of characters written
+std::size_t Base64EncodeInto(std::string_view data, char* out,
+                             Pad pad = Pad::kWith) noexcept;
+
+/// @brief Decodes data from Base64 into the caller-provided buffer, the
+/// characters out of the Base64 alphabet are skipped
+/// @param out must have room for Base64DecodedSizeUpperBound(data.size())
+/// bytes
+/// @returns the number of bytes written
+std::size_t Base64DecodeInto(std::string_view data, char* out) noexcept;
+
 #ifndef USERVER_NO_CRYPTOPP_BASE64_URL
 
 /// @brief Encodes data to Base64 (using URL alphabet), add padding by default
@@ -32,6 +59,20 @@ std::string Base64UrlEncode(std::string_view data, Pad pad = Pad::kWith);
 /// @throws CryptoException internal library exception
 std::string Base64UrlDecode(std::string_view data);
 
+/// @brief Encodes data to Base64 (using URL alphabet) into the
+/// caller-provided buffer
+/// @param out must have room for Base64EncodedSize(data.size(), pad) chars
+/// @returns the number of characters written
+std::size_t Base64UrlEncodeInto(std::string_view data, char* out,
+                                Pad pad = Pad::kWith) noexcept;
+
+/// @brief Decodes data from Base64 (using URL alphabet) into the
+/// caller-provided buffer, the characters out of the alphabet are skipped
+/// @param out must have room for Base64DecodedSizeUpperBound(data.size())
+/// bytes
+/// @returns the number of bytes written
+std::size_t Base64UrlDecodeInto(std::string_view data, char* out) noexcept;
+
 #endif
 
 }  // namespace crypto::base64
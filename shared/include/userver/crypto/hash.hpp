@@ -3,6 +3,9 @@
 /// @file userver/crypto/hash.hpp
 /// @brief @copybrief crypto::hash
 
+#include <cstddef>
+#include <memory>
+#include <string>
 #include <string_view>
 
 USERVER_NAMESPACE_BEGIN
@@ -88,6 +91,94 @@ std::string HmacSha384(std::string_view key, std::string_view message,
 std::string HmacSha512(std::string_view key, std::string_view message,
                        OutputEncoding encoding = OutputEncoding::kHex);
 
+/// Hash functions of the streaming Hasher and Hmac
+enum class Algorithm {
+  kSha1,
+  kSha224,
+  kSha256,
+  kSha384,
+  kSha512,
+#ifndef USERVER_NO_CRYPTOPP_BLAKE2
+  kBlake2b128,
+#endif
+};
+
+/// @brief Calculates a hash of the data passed in chunks, so that the data
+/// does not have to be contiguous in memory.
+///
+/// Starts a new message after each Finalize(), so a single hasher may be
+/// reused for many messages without reallocations. Not thread safe.
+///
+/// @snippet crypto/hash_test.cpp Streaming hash
+class Hasher final {
+ public:
+  /// @throws CryptoException internal library exception
+  explicit Hasher(Algorithm algorithm);
+  ~Hasher();
+
+  Hasher(Hasher&&) noexcept;
+  Hasher& operator=(Hasher&&) noexcept;
+
+  /// Appends the data to the message
+  /// @throws CryptoException internal library exception
+  void Update(std::string_view data);
+
+  /// Size of the binary digest in bytes
+  std::size_t GetDigestSize() const;
+
+  /// @brief Writes the binary digest of the message to `output` and starts a
+  /// new message
+  /// @returns the number of bytes written, GetDigestSize()
+  /// @throws CryptoException if `size` is less than GetDigestSize()
+  std::size_t Finalize(char* output, std::size_t size);
+
+  /// @brief Returns the digest of the message and starts a new message
+  /// @param encoding result could be returned as binary string or encoded
+  /// @throws CryptoException internal library exception
+  std::string Finalize(OutputEncoding encoding = OutputEncoding::kHex);
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/// @brief Calculates HMAC of the data passed in chunks, so that the data does
+/// not have to be contiguous in memory.
+///
+/// Keeps the key for the next messages after each Finalize(), so a single
+/// object may sign many messages. Not thread safe.
+class Hmac final {
+ public:
+  /// @throws CryptoException internal library exception
+  Hmac(Algorithm algorithm, std::string_view key);
+  ~Hmac();
+
+  Hmac(Hmac&&) noexcept;
+  Hmac& operator=(Hmac&&) noexcept;
+
+  /// Appends the data to the message
+  /// @throws CryptoException internal library exception
+  void Update(std::string_view data);
+
+  /// Size of the binary MAC in bytes
+  std::size_t GetDigestSize() const;
+
+  /// @brief Writes the binary MAC of the message to `output` and starts a new
+  /// message
+  /// @returns the number of bytes written, GetDigestSize()
+  /// @throws CryptoException if `size` is less than GetDigestSize()
+  std::size_t Finalize(char* output, std::size_t size);
+
+  /// @brief Returns the MAC of the message and starts a new message
+  /// @param encoding result could be returned as binary string or encoded
+  /// @throws CryptoException internal library exception
+  std::string Finalize(OutputEncoding encoding = OutputEncoding::kHex);
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
 /// Broken cryptographic hashes, must not be used except for compatibility
 namespace weak {
 
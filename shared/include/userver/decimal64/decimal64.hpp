@@ -1229,6 +1229,16 @@ void TrimTrailingZeros(int64_t& after, int& after_precision);
 std::string ToString(int64_t before, int64_t after, int precision,
                      const FormatOptions& format_options);
 
+/// Sign, 19 digits before the dot, the dot and 18 digits after it, and the
+/// room for writing the digits 8 at a time
+inline constexpr std::size_t kWriteBufferSize = 39 + 7;
+
+/// Writes the unpacked Decimal with `precision` digits after the dot to `out`,
+/// which must have at least kWriteBufferSize chars. Returns the number of
+/// chars written.
+std::size_t WriteDecimal(char* out, int64_t before, int64_t after,
+                         int precision, bool trim_trailing_zeros) noexcept;
+
 }  // namespace impl
 
 template <int Prec, typename RoundPolicy>
@@ -1268,7 +1278,10 @@ Decimal<Prec, RoundPolicy>::FromStringPermissive(std::string_view input) {
 /// @see ToStringFixed
 template <int Prec, typename RoundPolicy>
 std::string ToString(Decimal<Prec, RoundPolicy> dec) {
-  return fmt::to_string(dec);
+  const auto [before, after] = impl::AsUnpacked(dec);
+  char buffer[impl::kWriteBufferSize];
+  const auto size = impl::WriteDecimal(buffer, before, after, Prec, true);
+  return std::string(buffer, size);
 }
 
 /// @brief Converts Decimal to a string
@@ -1303,7 +1316,10 @@ std::string ToString(const Decimal<Prec, RoundPolicy>& dec,
 /// @see ToStringFixed
 template <int Prec, typename RoundPolicy>
 std::string ToStringTrailingZeros(Decimal<Prec, RoundPolicy> dec) {
-  return fmt::format(FMT_COMPILE("{:f}"), dec);
+  const auto [before, after] = impl::AsUnpacked(dec);
+  char buffer[impl::kWriteBufferSize];
+  const auto size = impl::WriteDecimal(buffer, before, after, Prec, false);
+  return std::string(buffer, size);
 }
 
 /// @brief Converts Decimal to a string with exactly `NewPrec` decimal digits
@@ -1461,6 +1477,16 @@ class fmt::formatter<USERVER_NAMESPACE::decimal64::Decimal<Prec, RoundPolicy>,
   auto format(
       const USERVER_NAMESPACE::decimal64::Decimal<Prec, RoundPolicy>& dec,
       FormatContext& ctx) const {
+    if (!custom_precision_) {
+      const auto [before, after] =
+          USERVER_NAMESPACE::decimal64::impl::AsUnpacked(dec);
+      char buffer[USERVER_NAMESPACE::decimal64::impl::kWriteBufferSize];
+      const auto size = USERVER_NAMESPACE::decimal64::impl::WriteDecimal(
+          buffer, before, after, Prec, remove_trailing_zeros_);
+      return fmt::format_to(ctx.out(), FMT_COMPILE("{}"),
+                            std::string_view{buffer, size});
+    }
+
     int after_digits = custom_precision_.value_or(Prec);
     auto [before, after] =
         USERVER_NAMESPACE::decimal64::impl::AsUnpacked(dec, after_digits);
@@ -0,0 +1,177 @@
+#pragma once
+
+/// @file userver/formats/json/aggregates.hpp
+/// @brief JSON serialization and parsing of aggregates without handwritten
+/// Serialize/Parse/WriteToStream functions
+///
+/// @ingroup userver_formats_serialize userver_formats_parse
+/// userver_formats_serialize_sax
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <boost/pfr/core.hpp>
+#include <boost/pfr/tuple_size.hpp>
+
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/formats/parse/to.hpp>
+#include <userver/formats/serialize/to.hpp>
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+
+/// @brief Specialize with the names of the fields to enable JSON support for
+/// an aggregate:
+///
+/// @code
+/// template <>
+/// struct formats::json::AggregateFieldNames<MyStruct> {
+///   static constexpr std::string_view kNames[] = {"id", "name"};
+/// };
+/// @endcode
+///
+/// Names go in the order of the fields declaration.
+template <typename T>
+struct AggregateFieldNames {};
+
+namespace impl {
+
+template <typename T>
+using HasAggregateFieldNames = decltype(AggregateFieldNames<T>::kNames);
+
+template <typename T>
+constexpr bool IsJsonAggregate() {
+  if constexpr (std::is_aggregate_v<T> &&
+                meta::kIsDetected<HasAggregateFieldNames, T>) {
+    static_assert(std::size(AggregateFieldNames<T>::kNames) ==
+                      boost::pfr::tuple_size_v<T>,
+                  "formats::json::AggregateFieldNames must contain a name "
+                  "for each field of the aggregate");
+    return true;
+  } else {
+    return false;
+  }
+}
+
+inline constexpr char kHexDigits[] = "0123456789abcdef";
+
+constexpr std::size_t QuotedSize(std::string_view name) {
+  std::size_t size = 2;
+  for (const char c : name) {
+    if (c == '"' || c == '\\') {
+      size += 2;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      size += 6;
+    } else {
+      ++size;
+    }
+  }
+  return size;
+}
+
+template <std::size_t Size>
+constexpr std::array<char, Size> Quote(std::string_view name) {
+  std::array<char, Size> result{};
+  std::size_t pos = 0;
+  result[pos++] = '"';
+  for (const char c : name) {
+    const auto code = static_cast<unsigned char>(c);
+    if (c == '"' || c == '\\') {
+      result[pos++] = '\\';
+      result[pos++] = c;
+    } else if (code < 0x20) {
+      result[pos++] = '\\';
+      result[pos++] = 'u';
+      result[pos++] = '0';
+      result[pos++] = '0';
+      result[pos++] = kHexDigits[code >> 4];
+      result[pos++] = kHexDigits[code & 0xf];
+    } else {
+      result[pos++] = c;
+    }
+  }
+  result[pos++] = '"';
+  return result;
+}
+
+// Quoted and escaped name of the field, computed at compile time
+template <typename T, std::size_t Index>
+struct QuotedFieldName {
+  static constexpr std::string_view kName =
+      AggregateFieldNames<T>::kNames[Index];
+  static constexpr auto kData = Quote<QuotedSize(kName)>(kName);
+  static constexpr std::string_view kValue{kData.data(), kData.size()};
+};
+
+template <typename T, std::size_t... Indices>
+void WriteAggregate(const T& value, StringBuilder& sw,
+                    std::index_sequence<Indices...>) {
+  StringBuilder::ObjectGuard guard{sw};
+  ((sw.RawKey(QuotedFieldName<T, Indices>::kValue),
+    WriteToStream(boost::pfr::get<Indices>(value), sw)),
+   ...);
+}
+
+template <typename T, std::size_t... Indices>
+T ParseAggregate(const formats::json::Value& value,
+                 std::index_sequence<Indices...>) {
+  // `As`s are guaranteed to occur left-to-right in brace-init
+  return T{value[AggregateFieldNames<T>::kNames[Indices]]
+               .template As<boost::pfr::tuple_element_t<Indices, T>>()...};
+}
+
+template <typename T, std::size_t... Indices>
+formats::json::Value SerializeAggregate(const T& value,
+                                         std::index_sequence<Indices...>) {
+  ValueBuilder builder{formats::json::Type::kObject};
+  ((builder[std::string{AggregateFieldNames<T>::kNames[Indices]}] =
+        boost::pfr::get<Indices>(value)),
+   ...);
+  return builder.ExtractValue();
+}
+
+}  // namespace impl
+
+/// @brief Writes the aggregate as a JSON object in one pass, the keys are
+/// escaped at compile time.
+///
+/// Enabled by the formats::json::AggregateFieldNames specialization.
+template <typename T>
+std::enable_if_t<impl::IsJsonAggregate<T>()> WriteToStream(const T& value,
+                                                           StringBuilder& sw) {
+  impl::WriteAggregate(value, sw,
+                       std::make_index_sequence<boost::pfr::tuple_size_v<T>>{});
+}
+
+/// @brief Parses the aggregate from a JSON object, a missing member is parsed
+/// as a missing formats::json::Value, e.g. is allowed for std::optional.
+///
+/// Enabled by the formats::json::AggregateFieldNames specialization.
+template <typename T>
+std::enable_if_t<impl::IsJsonAggregate<T>(), T> Parse(const Value& value,
+                                                      parse::To<T>) {
+  return impl::ParseAggregate<T>(
+      value, std::make_index_sequence<boost::pfr::tuple_size_v<T>>{});
+}
+
+/// @brief Serializes the aggregate into a JSON object
+///
+/// Enabled by the formats::json::AggregateFieldNames specialization.
+template <typename T>
+std::enable_if_t<impl::IsJsonAggregate<T>(), Value> Serialize(
+    const T& value, serialize::To<Value>) {
+  return impl::SerializeAggregate(
+      value, std::make_index_sequence<boost::pfr::tuple_size_v<T>>{});
+}
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
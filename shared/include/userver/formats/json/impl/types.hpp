@@ -25,11 +25,14 @@ using formats::common::Type;
 class Value;
 
 namespace impl {
+class Allocator;
+class Arena;
+
 // rapidjson integration
 using UTF8 = ::rapidjson::UTF8<char>;
-using Value = ::rapidjson::GenericValue<UTF8, ::rapidjson::CrtAllocator>;
-using Document = ::rapidjson::GenericDocument<UTF8, ::rapidjson::CrtAllocator,
-                                              ::rapidjson::CrtAllocator>;
+using Value = ::rapidjson::GenericValue<UTF8, Allocator>;
+using Document =
+    ::rapidjson::GenericDocument<UTF8, Allocator, ::rapidjson::CrtAllocator>;
 
 class VersionedValuePtr final {
  public:
@@ -61,6 +64,13 @@ class VersionedValuePtr final {
   size_t Version() const;
   void BumpVersion();
 
+  /// For the documents that allocate their nodes from the Arena
+  Arena& GetArena();
+
+  /// Whether the nodes are owned by the Arena. Such documents must not be
+  /// modified and their nodes must not be moved to other documents.
+  bool IsArenaBacked() const;
+
  private:
   struct Data;
 
@@ -0,0 +1,170 @@
+#pragma once
+
+/// @file userver/formats/json/lazy_value.hpp
+/// @brief @copybrief formats::json::LazyValue
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/string_builder_fwd.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/serialize/to.hpp>
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+
+namespace impl {
+struct LazyDocument;
+}  // namespace impl
+
+// clang-format off
+
+/// @ingroup userver_containers userver_formats
+///
+/// @brief Read-only JSON document that builds the values only for the
+/// accessed subtrees.
+///
+/// Construction validates the whole document like formats::json::FromString
+/// does, duplicate keys included, but only records the positions of the
+/// values in the text. `operator[]` walks that index without allocations,
+/// and `As<T>()` parses just the subtree of the value.
+///
+/// Useful for the handlers that read a few fields of a large document or
+/// pass its parts through: WriteToStream of a LazyValue copies its text as
+/// is.
+///
+/// Numbers are validated syntactically during construction, so an overflow
+/// like `1e400` is reported only when such a value is parsed. Paths in the
+/// exceptions of `As<T>()` are relative to the parsed value.
+///
+/// ## Example usage:
+///
+/// @snippet formats/json/lazy_value_test.cpp  Sample formats::json::LazyValue usage
+
+// clang-format on
+
+class LazyValue final {
+ public:
+  /// @brief Validates and indexes the JSON document
+  /// @throw ParseException if the document is not a valid JSON
+  explicit LazyValue(std::string json);
+
+  LazyValue(const LazyValue&) = default;
+  LazyValue(LazyValue&&) noexcept = default;
+  LazyValue& operator=(const LazyValue&) = default;
+  LazyValue& operator=(LazyValue&&) noexcept = default;
+  ~LazyValue();
+
+  /// @brief Access member by key for read.
+  /// @throw TypeMismatchException if not a missing value, an object or null.
+  LazyValue operator[](std::string_view key) const;
+
+  /// @brief Access array member by index for read.
+  /// @throw TypeMismatchException if not an array value.
+  /// @throw OutOfBoundsException if index is greater or equal than size.
+  LazyValue operator[](std::size_t index) const;
+
+  /// @brief Returns array size, object members count, or 0 for null.
+  /// @throw TypeMismatchException if not an array, object, or null.
+  std::size_t GetSize() const;
+
+  /// @brief Returns true if *this holds a `key`.
+  /// @throw TypeMismatchException if `*this` is not a map or null.
+  bool HasMember(std::string_view key) const;
+
+  bool IsMissing() const noexcept;
+  bool IsNull() const noexcept;
+  bool IsBool() const noexcept;
+  bool IsNumber() const noexcept;
+  bool IsString() const noexcept;
+  bool IsArray() const noexcept;
+  bool IsObject() const noexcept;
+
+  /// @brief Returns value of *this converted to T, only the subtree of *this
+  /// is parsed.
+  /// @throw Anything derived from std::exception.
+  template <typename T>
+  T As() const;
+
+  /// @brief Returns value of *this converted to T or T(args) if
+  /// this->IsMissing() or this->IsNull().
+  /// @throw Anything derived from std::exception.
+  template <typename T, typename First, typename... Rest>
+  T As(First&& default_arg, Rest&&... more_default_args) const;
+
+  /// @brief Returns value of *this converted to T or T() if
+  /// this->IsMissing() or this->IsNull().
+  /// @throw Anything derived from std::exception.
+  /// @note Use as `value.As<T>({})`
+  template <typename T>
+  T As(Value::DefaultConstructed) const;
+
+  /// @brief Parses the subtree of *this into a formats::json::Value.
+  /// @throw MemberMissingException if `this->IsMissing()`.
+  Value Materialize() const;
+
+  /// @brief Returns the text of the value, without the surrounding
+  /// whitespaces. Valid while any LazyValue of the document is alive.
+  /// @throw MemberMissingException if `this->IsMissing()`.
+  std::string_view GetRawJson() const;
+
+  /// @brief Returns full path to this value.
+  std::string GetPath() const;
+
+  /// @throw MemberMissingException if `this->IsMissing()`.
+  void CheckNotMissing() const;
+
+ private:
+  LazyValue(std::shared_ptr<const impl::LazyDocument> document,
+            std::uint32_t node);
+  LazyValue(std::shared_ptr<const impl::LazyDocument> document,
+            std::string missing_path);
+
+  char GetFirstChar() const noexcept;
+  int GetExtendedType() const;
+
+  std::shared_ptr<const impl::LazyDocument> document_;
+  std::uint32_t node_;
+  std::string missing_path_;
+};
+
+template <typename T>
+T LazyValue::As() const {
+  if constexpr (meta::kIsOptional<T>) {
+    if (IsMissing() || IsNull()) return std::nullopt;
+  }
+  return Materialize().As<T>();
+}
+
+template <typename T, typename First, typename... Rest>
+T LazyValue::As(First&& default_arg, Rest&&... more_default_args) const {
+  if (IsMissing() || IsNull()) {
+    // intended raw ctor call, sometimes casts
+    // NOLINTNEXTLINE(google-readability-casting)
+    return T(std::forward<First>(default_arg),
+             std::forward<Rest>(more_default_args)...);
+  }
+  return As<T>();
+}
+
+template <typename T>
+T LazyValue::As(Value::DefaultConstructed) const {
+  return (IsMissing() || IsNull()) ? T() : As<T>();
+}
+
+/// Copies the text of the value into the builder without parsing it
+void WriteToStream(const LazyValue& value, StringBuilder& sw);
+
+Value Serialize(const LazyValue& value, formats::serialize::To<Value>);
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
@@ -23,6 +23,36 @@ namespace formats::json {
 /// Parse JSON from string
 formats::json::Value FromString(std::string_view doc);
 
+/// @brief Parse JSON from string into a document that takes the memory for
+/// all of its nodes from a few big blocks.
+///
+/// Big documents are parsed faster than with formats::json::FromString and
+/// are released at once when the last formats::json::Value referencing them
+/// is destroyed, so any part of the document keeps the whole memory alive.
+/// formats::json::ValueBuilder copies such documents on construction.
+formats::json::Value FromStringWithArena(std::string_view doc);
+
+/// @brief Parse JSON from string, the object keys are shared with the other
+/// documents parsed by this function instead of being copied into each object.
+///
+/// Saves memory for documents with many objects of the same structure, like
+/// the contents of caches. Only the keys that do not fit into the node itself
+/// are shared. The shared keys are never released, so when a few MiB of
+/// distinct keys are collected, the new ones are copied as usual.
+formats::json::Value FromStringWithInternedKeys(std::string_view doc);
+
+/// @brief Returns the key shared by formats::json::FromStringWithInternedKeys
+/// documents, or `key` itself if it is not shared.
+///
+/// Member lookups with the shared key compare the pointers of keys before
+/// comparing their contents. Store the result to avoid locking the table of
+/// keys on each lookup:
+/// @code
+/// static const auto kKey = formats::json::InternKey("long_name_of_the_field");
+/// const auto value = doc[kKey];
+/// @endcode
+std::string_view InternKey(std::string_view key);
+
 /// Parse JSON from stream
 formats::json::Value FromStream(std::istream& is);
 
@@ -67,6 +67,10 @@ class StringBuilder final : public serialize::SaxStream {
   std::string GetString() const;
   std::string_view GetStringView() const;
 
+  /// @return JSON written since the previous call, the builder remains with
+  /// the same open arrays and objects. Allows sending the JSON by parts.
+  std::string ExtractString();
+
   void WriteNull();
   void WriteString(std::string_view value);
   void WriteBool(bool value);
@@ -77,6 +81,9 @@ class StringBuilder final : public serialize::SaxStream {
   /// ONLY for objects/dicts: write key
   void Key(std::string_view sw);
 
+  /// ONLY for objects/dicts: write key that is already quoted and escaped
+  void RawKey(std::string_view quoted_key);
+
   /// Appends raw data
   void WriteRawString(std::string_view value);
 
@@ -21,6 +21,10 @@ namespace logging {
 class LogHelper;
 }  // namespace logging
 
+namespace formats::msgpack::impl {
+struct JsonAccess;
+}  // namespace formats::msgpack::impl
+
 namespace formats::json {
 namespace impl {
 class InlineObjectBuilder;
@@ -268,8 +272,11 @@ class Value final {
   friend class impl::MutableValueWrapper;
   friend class parser::JsonValueParser;
   friend class impl::StringBuffer;
+  friend struct msgpack::impl::JsonAccess;
 
   friend formats::json::Value FromString(std::string_view);
+  friend formats::json::Value FromStringWithArena(std::string_view);
+  friend formats::json::Value FromStringWithInternedKeys(std::string_view);
   friend formats::json::Value FromStream(std::istream&);
   friend void Serialize(const formats::json::Value&, std::ostream&);
   friend std::string ToString(const formats::json::Value&);
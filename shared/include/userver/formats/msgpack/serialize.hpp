@@ -0,0 +1,35 @@
+#pragma once
+
+/// @file userver/formats/msgpack/serialize.hpp
+/// @brief MessagePack parsers and serializers of formats::json::Value
+
+#include <string>
+#include <string_view>
+
+#include <userver/formats/json/value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+/// @brief MessagePack encoding of the JSON values
+///
+/// The documents are represented by formats::json::Value and
+/// formats::json::ValueBuilder, so the Parse and Serialize functions written
+/// for JSON work with MessagePack as is.
+namespace formats::msgpack {
+
+/// @brief Parse MessagePack into a JSON value.
+///
+/// `bin` values are read as strings. Extension types, non-string keys,
+/// duplicate keys and non-finite floats are not representable in JSON and are
+/// reported as errors.
+/// @throw formats::json::ParseException if the data is not a valid
+/// MessagePack or cannot be represented as JSON
+formats::json::Value FromBinaryString(std::string_view data);
+
+/// @brief Serialize JSON value to MessagePack using the shortest encoding of
+/// each value.
+std::string ToBinaryString(const formats::json::Value& value);
+
+}  // namespace formats::msgpack
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,122 @@
+#pragma once
+
+/// @file userver/formats/msgpack/string_builder.hpp
+/// @brief @copybrief formats::msgpack::StringBuilder
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/serialize/to.hpp>
+#include <userver/formats/serialize/write_to_stream.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::msgpack {
+
+// clang-format off
+
+/// @ingroup userver_containers userver_formats userver_formats_serialize_sax
+///
+/// @brief SAX like builder of MessagePack, the binary counterpart of
+/// formats::json::StringBuilder.
+///
+/// Prefer using WriteToStream function to add data to the StringBuilder. The
+/// types without WriteToStream for this builder are serialized with their
+/// `Serialize(const T&, formats::serialize::To<formats::json::Value>)`.
+///
+/// MessagePack puts the element count before the array or object, so the
+/// headers of the open containers are patched in GetString().
+///
+/// ## Example usage:
+///
+/// @snippet formats/msgpack/string_builder_test.cpp  Sample formats::msgpack::StringBuilder usage
+///
+/// @see @ref md_en_userver_formats
+
+// clang-format on
+
+class StringBuilder final : public serialize::SaxStream {
+ public:
+  // Required by the WriteToStream fallback to Serialize
+  using Value = formats::json::Value;
+
+  StringBuilder();
+  ~StringBuilder();
+
+  /// Construct this guard on new object start and its destructor will end the
+  /// object
+  class ObjectGuard final {
+   public:
+    explicit ObjectGuard(StringBuilder& sw);
+    ~ObjectGuard();
+
+   private:
+    StringBuilder& sw_;
+  };
+
+  /// Construct this guard on new array start and its destructor will end the
+  /// array
+  class ArrayGuard final {
+   public:
+    explicit ArrayGuard(StringBuilder& sw);
+    ~ArrayGuard();
+
+   private:
+    StringBuilder& sw_;
+  };
+
+  /// @return MessagePack data, all the guards must be destroyed by now
+  std::string GetString() const;
+
+  void WriteNull();
+  void WriteString(std::string_view value);
+  void WriteBool(bool value);
+  void WriteInt64(int64_t value);
+  void WriteUInt64(uint64_t value);
+  void WriteDouble(double value);
+
+  /// ONLY for objects/dicts: write key
+  void Key(std::string_view key);
+
+  void WriteValue(const Value& value);
+
+ private:
+  struct Container {
+    std::size_t header_pos;
+    std::uint32_t size;
+    bool is_object;
+  };
+
+  void StartContainer(bool is_object);
+  void EndContainer();
+  void OnValue();
+
+  std::string data_;
+  // in the order of their headers in data_
+  std::vector<Container> containers_;
+  // indices of the open containers in containers_
+  std::vector<std::size_t> open_;
+};
+
+void WriteToStream(bool value, StringBuilder& sw);
+void WriteToStream(long long value, StringBuilder& sw);
+void WriteToStream(unsigned long long value, StringBuilder& sw);
+void WriteToStream(int value, StringBuilder& sw);
+void WriteToStream(unsigned value, StringBuilder& sw);
+void WriteToStream(long value, StringBuilder& sw);
+void WriteToStream(unsigned long value, StringBuilder& sw);
+void WriteToStream(double value, StringBuilder& sw);
+void WriteToStream(const char* value, StringBuilder& sw);
+void WriteToStream(std::string_view value, StringBuilder& sw);
+void WriteToStream(const formats::json::Value& value, StringBuilder& sw);
+void WriteToStream(const std::string& value, StringBuilder& sw);
+
+void WriteToStream(std::chrono::system_clock::time_point tp, StringBuilder& sw);
+
+}  // namespace formats::msgpack
+
+USERVER_NAMESPACE_END
@@ -71,6 +71,8 @@ inline constexpr char kUserAgent[] = "User-Agent";
 inline constexpr char kXTaxi[] = "X-Taxi";
 inline constexpr char kXRequestedUri[] = "X-Requested-Uri";
 inline constexpr char kXRequestApplication[] = "X-Request-Application";
+inline constexpr char kXForwardedFor[] = "X-Forwarded-For";
+inline constexpr char kXRealIp[] = "X-Real-IP";
 /// @}
 
 // Response Header Fields
@@ -110,6 +112,7 @@ inline constexpr char kServer[] = "Server";
 /// @name Cookie
 /// @{
 inline constexpr char kSetCookie[] = "Set-Cookie";
+inline constexpr char kCookie[] = "Cookie";
 /// @}
 
 /// @name Extra headers
@@ -122,6 +125,8 @@ inline constexpr char kConnection[] = "Connection";
 inline constexpr char kXYaRequestId[] = "X-YaRequestId";
 inline constexpr char kXYaTraceId[] = "X-YaTraceId";
 inline constexpr char kXYaSpanId[] = "X-YaSpanId";
+/// "1" if the trace is sampled, "0" otherwise, see tracing::Span::IsSampled
+inline constexpr char kXYaSampled[] = "X-YaSampled";
 inline constexpr char kXRequestId[] = "X-RequestId";
 inline constexpr char kXBackendServer[] = "X-Backend-Server";
 inline constexpr char kXTaxiEnvoyProxyDstVhost[] = "X-Taxi-EnvoyProxy-DstVhost";
@@ -152,7 +157,9 @@ inline constexpr char kMaxResponseSizeInFlight[] =
     "max-response-size-in-flight";
 inline constexpr char kMaxPendingResponses[] = "too-many-pending-responses";
 inline constexpr char kGlobal[] = "global-ratelimit";
+inline constexpr char kClient[] = "client-ratelimit";
 inline constexpr char kInFlight[] = "max-requests-in-flight";
+inline constexpr char kAdaptiveConcurrency[] = "adaptive-concurrency-limit";
 }  // namespace ratelimit_reason
 /// @}
 
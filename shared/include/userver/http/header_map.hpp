@@ -0,0 +1,141 @@
+#pragma once
+
+/// @file userver/http/header_map.hpp
+/// @brief @copybrief http::headers::HeaderMap
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <userver/utils/str_icase.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace http::headers {
+
+/// @brief Well-known headers, HeaderMap keeps them in fixed slots and finds
+/// them without hashing.
+enum class PredefinedHeader : std::uint8_t {
+  kHost,
+  kUserAgent,
+  kAccept,
+  kAcceptEncoding,
+  kAcceptLanguage,
+  kAuthorization,
+  kConnection,
+  kContentEncoding,
+  kContentLength,
+  kContentType,
+  kCookie,
+  kReferer,
+  kXForwardedFor,
+  kXRealIp,
+  kXRequestId,
+  kXYaRequestId,
+  kXYaTraceId,
+  kXYaSpanId,
+  kXYaSampled,
+  kXYaTaxiClientTimeoutMs,
+  kApiKey,
+};
+
+inline constexpr std::size_t kPredefinedHeadersCount =
+    static_cast<std::size_t>(PredefinedHeader::kApiKey) + 1;
+
+/// @returns the header name as in http/common_headers.hpp
+std::string_view ToStringView(PredefinedHeader header) noexcept;
+
+/// @returns the predefined header with the case insensitively equal name, if
+/// any
+std::optional<PredefinedHeader> FindPredefinedHeader(
+    std::string_view name) noexcept;
+
+/// @ingroup userver_containers
+///
+/// @brief Map of the HTTP headers with case insensitive names
+///
+/// The PredefinedHeader ones are stored in fixed slots, the rest are found
+/// in an open addressing table with the hashes of names computed once on
+/// insertion. Iteration order is the order of insertion.
+class HeaderMap final {
+ public:
+  using key_type = std::string;
+  using mapped_type = std::string;
+  using value_type = std::pair<const std::string, std::string>;
+  using iterator = std::vector<value_type>::iterator;
+  using const_iterator = std::vector<value_type>::const_iterator;
+
+  HeaderMap();
+
+  /// Reserves space for `capacity` headers and uses `hash` for names of the
+  /// non-predefined headers
+  HeaderMap(std::size_t capacity, utils::StrIcaseHash hash);
+
+  HeaderMap(const HeaderMap&) = default;
+  HeaderMap(HeaderMap&&) noexcept = default;
+  HeaderMap& operator=(const HeaderMap& other);
+  HeaderMap& operator=(HeaderMap&&) noexcept = default;
+
+  iterator find(std::string_view name) noexcept;
+  const_iterator find(std::string_view name) const noexcept;
+
+  iterator find(PredefinedHeader header) noexcept;
+  const_iterator find(PredefinedHeader header) const noexcept;
+
+  std::size_t count(std::string_view name) const noexcept {
+    return find(name) != end();
+  }
+
+  /// Inserts the header if there is no header with the same name
+  std::pair<iterator, bool> emplace(std::string name, std::string value);
+
+  /// @returns the value of the header, inserting an empty one if there is no
+  /// header with the name
+  std::string& operator[](std::string_view name);
+
+  std::size_t size() const noexcept { return entries_.size(); }
+  bool empty() const noexcept { return entries_.empty(); }
+
+  iterator begin() noexcept { return entries_.begin(); }
+  iterator end() noexcept { return entries_.end(); }
+  const_iterator begin() const noexcept { return entries_.begin(); }
+  const_iterator end() const noexcept { return entries_.end(); }
+  const_iterator cbegin() const noexcept { return entries_.cbegin(); }
+  const_iterator cend() const noexcept { return entries_.cend(); }
+
+  void reserve(std::size_t capacity);
+
+  void clear() noexcept;
+
+ private:
+  // Index in entries_ plus one, zero for an empty slot
+  using Index = std::uint32_t;
+
+  struct OtherSlot {
+    std::size_t hash{0};
+    Index index{0};
+  };
+
+  const OtherSlot& FindOtherSlot(std::string_view name,
+                                 std::size_t hash) const noexcept;
+  Index FindIndex(std::string_view name) const noexcept;
+  // Returns the slot of the name, the caller must fill a zero one
+  Index& PrepareSlot(std::string_view name);
+  void GrowOthers();
+
+  std::vector<value_type> entries_;
+  std::array<Index, kPredefinedHeadersCount> predefined_{};
+  // Open addressing table with linear probing, its size is a power of two
+  std::vector<OtherSlot> others_;
+  std::size_t others_count_{0};
+  utils::StrIcaseHash hash_;
+};
+
+}  // namespace http::headers
+
+USERVER_NAMESPACE_END
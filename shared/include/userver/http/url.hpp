@@ -6,6 +6,8 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <userver/utils/str_icase.hpp>
 
@@ -22,6 +24,11 @@ std::string UrlEncode(std::string_view input_string);
 
 using Args = std::unordered_map<std::string, std::string, utils::StrCaseHash>;
 
+/// Query arguments that refer to the caller's strings, to build a query
+/// without copying the keys and values into an Args
+using QueryArgViews =
+    std::vector<std::pair<std::string_view, std::string_view>>;
+
 /// @brief Make an URL query
 std::string MakeQuery(const Args& query_args);
 
@@ -34,6 +41,9 @@ std::string MakeQuery(
     std::initializer_list<std::pair<std::string_view, std::string_view>>
         query_args);
 
+/// @brief Make an URL query
+std::string MakeQuery(const QueryArgViews& query_args);
+
 /// @brief Make an URL with query arguments
 std::string MakeUrl(std::string_view path, const Args& query_args);
 
@@ -48,6 +58,9 @@ std::string MakeUrl(
     std::initializer_list<std::pair<std::string_view, std::string_view>>
         query_args);
 
+/// @brief Make an URL with query arguments
+std::string MakeUrl(std::string_view path, const QueryArgViews& query_args);
+
 /// @brief Returns URL part before the first '?' character
 std::string ExtractMetaTypeFromUrl(const std::string& url);
 
@@ -3,6 +3,9 @@
 /// @file userver/utils/boost_uuid4.hpp
 /// @brief @copybrief utils::generators::GenerateBoostUuid()
 
+#include <cstddef>
+#include <vector>
+
 #include <boost/uuid/uuid.hpp>
 
 #include <fmt/core.h>
@@ -18,6 +21,9 @@ namespace generators {
 /// Generates UUID
 boost::uuids::uuid GenerateBoostUuid();
 
+/// Generates `count` UUIDs at once, faster than GenerateBoostUuid() in a loop
+std::vector<boost::uuids::uuid> GenerateBoostUuids(std::size_t count);
+
 }  // namespace generators
 
 /// Parse string into boost::uuids::uuid
@@ -52,6 +52,16 @@ std::chrono::system_clock::time_point Epoch() noexcept;
 /// of your own code. Otherwise this will break your service in production.
 std::chrono::steady_clock::time_point SteadyNow() noexcept;
 
+/// @brief SteadyNow() that may lag behind by up to a few milliseconds, but
+/// is cheaper to obtain
+///
+/// Suitable for the timeouts and expiration periods that are much longer
+/// than utils::datetime::SteadyCoarseClock::resolution().
+///
+/// @warning Same as for SteadyNow(), the time points MUST NOT be passed
+/// outside of your own code.
+std::chrono::steady_clock::time_point SteadyCoarseNow() noexcept;
+
 // See the comment to SteadyNow()
 class SteadyClock : public std::chrono::steady_clock {
  public:
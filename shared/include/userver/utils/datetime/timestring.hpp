@@ -0,0 +1,50 @@
+#pragma once
+
+/// @file userver/utils/datetime/timestring.hpp
+/// @brief Fast formatting of time points in the common formats
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::datetime {
+
+/// @brief Common timestamp formats that are formatted without parsing a
+/// format string
+enum class TimestringFormat {
+  /// kRfc3339Format in UTC, e.g. "2023-01-02T03:04:05.123456+00:00"
+  kRfc3339,
+  /// kDefaultFormat in UTC, e.g. "2023-01-02T03:04:05.123456+0000"
+  kDefault,
+  /// kTaximeterFormat, ISO8601 with microseconds in UTC, e.g.
+  /// "2023-01-02T03:04:05.123456Z"
+  kIsoMicros,
+  /// Timestamp of the TSKV logs in the local timezone, e.g.
+  /// "2023-01-02T03:04:05.123456"
+  kTskvLocal,
+};
+
+/// Enough chars for a time point in any of the TimestringFormat
+inline constexpr std::size_t kMaxTimestringSize = 64;
+
+/// @brief Returns the time point in the specified format, the same as
+/// Timestring() with the matching format string would.
+///
+/// The date and time up to seconds are cached per thread, formatting the
+/// time points from the same second, e.g. the current time, only formats the
+/// fraction of a second.
+std::string Timestring(std::chrono::system_clock::time_point tp,
+                       TimestringFormat format);
+
+/// @brief Writes the time point in the specified format to `out`, which must
+/// have at least kMaxTimestringSize chars. Returns the number of chars
+/// written.
+/// @see Timestring
+std::size_t TimestringInto(char* out, std::chrono::system_clock::time_point tp,
+                           TimestringFormat format);
+
+}  // namespace utils::datetime
+
+USERVER_NAMESPACE_END
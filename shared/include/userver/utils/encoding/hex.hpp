@@ -39,6 +39,11 @@ constexpr size_t FromHexUpperBound(size_t size) noexcept {
   return size / 2;
 }
 
+/// @brief Converts input to hex and writes data to the caller-provided buffer
+/// @param input bytes to convert
+/// @param out must have room for LengthInHexForm(input) characters
+void ToHexInto(std::string_view input, char* out) noexcept;
+
 /// @brief Converts input to hex and writes data to output \p out
 /// @param input bytes to convert
 /// @param out string to write data. out will be cleared
@@ -60,6 +65,15 @@ inline std::string ToHex(const void* encoded, size_t len) noexcept {
   return ToHex(std::string_view{chars, len});
 }
 
+/// @brief Converts as much of input from hex as possible and writes data
+/// into the caller-provided buffer.
+///
+/// @param encoded input range to convert
+/// @param out must have room for FromHexUpperBound(encoded.size()) bytes
+/// @returns Number of characters successfully parsed, the number of bytes
+/// written is half of it.
+size_t FromHexInto(std::string_view encoded, char* out) noexcept;
+
 /// @brief Converts as much of input from hex as possible and writes data
 /// into \p out.
 ///
@@ -3,8 +3,11 @@
 /// @file userver/utils/encoding/tskv.hpp
 /// @brief Encoders, decoders and helpers for TSKV representations
 
+#include <cstring>
 #include <ostream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -24,6 +27,27 @@ struct TypeNeedsEncodeTskv
     : std::integral_constant<bool, std::is_same<T, char>::value ||
                                        !std::is_arithmetic<T>::value> {};
 
+namespace impl {
+
+/// Returns the first character that EncodeTskv changes in `mode` or `end`.
+/// Scans 16 or 32 bytes at a time if the CPU allows.
+const char* FindTskvSpecialChar(const char* begin, const char* end,
+                                EncodeTskvMode mode) noexcept;
+
+// Appends the characters that need no escaping at once if `put_char` allows
+template <typename T, typename EncodeTskvPutChar>
+void PutTskvRun(T& to, const char* first, const char* last,
+                const EncodeTskvPutChar& put_char) {
+  if constexpr (std::is_invocable_v<const EncodeTskvPutChar&, T&, const char*,
+                                    const char*>) {
+    if (first != last) put_char(to, first, last);
+  } else {
+    for (; first != last; ++first) put_char(to, *first);
+  }
+}
+
+}  // namespace impl
+
 template <typename T>
 class EncodeTskvPutCharDefault final {
  public:
@@ -34,12 +58,18 @@ template <>
 class EncodeTskvPutCharDefault<std::ostream> final {
  public:
   void operator()(std::ostream& to, char ch) const { to.put(ch); }
+  void operator()(std::ostream& to, const char* first, const char* last) const {
+    to.write(first, last - first);
+  }
 };
 
 template <>
 class EncodeTskvPutCharDefault<std::string> final {
  public:
   void operator()(std::string& to, char ch) const { to.push_back(ch); }
+  void operator()(std::string& to, const char* first, const char* last) const {
+    to.append(first, last);
+  }
 };
 
 /// @brief Encode according to the TSKV rules, but without escaping the
@@ -122,23 +152,37 @@ typename std::enable_if<std::is_same<Char, char>::value, void>::type EncodeTskv(
   }
 }
 
-template <typename T, typename EncodeTskvPutChar = EncodeTskvPutCharDefault<T>>
-void EncodeTskv(T& to, const std::string& str, EncodeTskvMode mode,
+template <typename T, typename EncodeTskvPutChar = EncodeTskvPutCharDefault<T>,
+          typename It>
+void EncodeTskv(T& to, It first, It last, EncodeTskvMode mode,
                 const EncodeTskvPutChar& put_char = EncodeTskvPutChar()) {
-  EncodeTskv(to, str.cbegin(), str.cend(), mode, put_char);
+  if constexpr (std::is_same_v<It, const char*> || std::is_same_v<It, char*>) {
+    const char* pos = first;
+    while (pos != last) {
+      const char* special = impl::FindTskvSpecialChar(pos, last, mode);
+      impl::PutTskvRun(to, pos, special, put_char);
+      if (special == last) break;
+
+      EncodeTskv(to, *special, mode, put_char);
+      pos = special + 1;
+    }
+  } else {
+    for (auto it = first; it != last; ++it) {
+      EncodeTskv(to, *it, mode, put_char);
+    }
+  }
 }
 
 template <typename T, typename EncodeTskvPutChar = EncodeTskvPutCharDefault<T>>
-void EncodeTskv(T& to, const char* str, EncodeTskvMode mode,
+void EncodeTskv(T& to, const std::string& str, EncodeTskvMode mode,
                 const EncodeTskvPutChar& put_char = EncodeTskvPutChar()) {
-  for (const auto* ptr = str; *ptr; ++ptr) EncodeTskv(to, *ptr, mode, put_char);
+  EncodeTskv(to, str.data(), str.data() + str.size(), mode, put_char);
 }
 
-template <typename T, typename EncodeTskvPutChar = EncodeTskvPutCharDefault<T>,
-          typename It>
-void EncodeTskv(T& to, It first, It last, EncodeTskvMode mode,
+template <typename T, typename EncodeTskvPutChar = EncodeTskvPutCharDefault<T>>
+void EncodeTskv(T& to, const char* str, EncodeTskvMode mode,
                 const EncodeTskvPutChar& put_char = EncodeTskvPutChar()) {
-  for (auto it = first; it != last; ++it) EncodeTskv(to, *it, mode, put_char);
+  EncodeTskv(to, str, str + std::strlen(str), mode, put_char);
 }
 
 template <typename T, typename EncodeTskvPutChar = EncodeTskvPutCharDefault<T>>
@@ -149,38 +193,15 @@ void EncodeTskv(T& to, const char* str, size_t size, EncodeTskvMode mode,
 /// @}
 
 inline bool ShouldValueBeEscaped(std::string_view key) {
-  for (char ch : key) {
-    switch (ch) {
-      case '\t':
-      case '\r':
-      case '\n':
-      case '\0':
-      case '\\':
-        return true;
-      default:
-        break;
-    }
-  }
-  return false;
+  const char* end = key.data() + key.size();
+  return impl::FindTskvSpecialChar(key.data(), end, EncodeTskvMode::kValue) !=
+         end;
 }
 
 inline bool ShouldKeyBeEscaped(std::string_view key) {
-  for (char ch : key) {
-    switch (ch) {
-      case '\t':
-      case '\r':
-      case '\n':
-      case '\0':
-      case '\\':
-      case '.':
-      case '=':
-        return true;
-      default:
-        if ('A' <= ch && ch <= 'Z') return true;
-        break;
-    }
-  }
-  return false;
+  const char* end = key.data() + key.size();
+  return impl::FindTskvSpecialChar(key.data(), end,
+                                   EncodeTskvMode::kKeyReplacePeriod) != end;
 }
 
 }  // namespace utils::encoding
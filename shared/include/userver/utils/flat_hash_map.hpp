@@ -0,0 +1,685 @@
+#pragma once
+
+/// @file userver/utils/flat_hash_map.hpp
+/// @brief @copybrief utils::FlatHashMap
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>  // std::allocator
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+namespace impl::flat_hash_map {
+
+// The control byte of a slot: kEmpty, kDeleted, kSentinel or 7 bits of the
+// key hash for the full slots
+using Ctrl = std::int8_t;
+
+inline constexpr Ctrl kEmpty = -128;
+inline constexpr Ctrl kDeleted = -2;
+inline constexpr Ctrl kSentinel = -1;
+
+constexpr bool IsFull(Ctrl ctrl) noexcept { return ctrl >= 0; }
+constexpr bool IsEmptyOrDeleted(Ctrl ctrl) noexcept { return ctrl < kSentinel; }
+
+// Positions of the matched control bytes in a group of `Width` bytes, each
+// byte is represented by `1 << Shift` bits
+template <typename T, std::size_t Width, int Shift>
+class BitMask final {
+ public:
+  explicit BitMask(T mask) noexcept : mask_(mask) {}
+
+  explicit operator bool() const noexcept { return mask_ != 0; }
+
+  std::size_t LowestBitSet() const noexcept {
+    if constexpr (sizeof(T) > sizeof(unsigned)) {
+      return __builtin_ctzll(mask_) >> Shift;
+    } else {
+      return __builtin_ctz(mask_) >> Shift;
+    }
+  }
+
+  // the count of the unmatched bytes at the end of the group
+  std::size_t LeadingZeros() const noexcept {
+    if (mask_ == 0) return Width;
+    constexpr std::size_t kExtraBits = sizeof(T) * 8 - (Width << Shift);
+    if constexpr (sizeof(T) > sizeof(unsigned)) {
+      return (__builtin_clzll(mask_) - kExtraBits) >> Shift;
+    } else {
+      return (__builtin_clz(mask_) - kExtraBits) >> Shift;
+    }
+  }
+
+  void ClearLowestBit() noexcept { mask_ &= mask_ - 1; }
+
+ private:
+  T mask_;
+};
+
+#if defined(__SSE2__)
+
+// Matches 16 control bytes at once
+class Group final {
+ public:
+  static constexpr std::size_t kWidth = 16;
+  using Mask = BitMask<std::uint32_t, kWidth, 0>;
+
+  explicit Group(const Ctrl* pos) noexcept
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+  Mask Match(Ctrl hash) const noexcept {
+    return Mask(static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(hash), ctrl_))));
+  }
+
+  Mask MaskEmpty() const noexcept { return Match(kEmpty); }
+
+  Mask MaskEmptyOrDeleted() const noexcept {
+    return Mask(static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(kSentinel), ctrl_))));
+  }
+
+ private:
+  __m128i ctrl_;
+};
+
+#else
+
+// Matches 8 control bytes at once using the arithmetic on a 64-bit word
+class Group final {
+ public:
+  static constexpr std::size_t kWidth = 8;
+  using Mask = BitMask<std::uint64_t, kWidth, 3>;
+
+  explicit Group(const Ctrl* pos) noexcept {
+    std::memcpy(&ctrl_, pos, sizeof(ctrl_));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    ctrl_ = __builtin_bswap64(ctrl_);
+#endif
+  }
+
+  // May report false positives for the bytes next to a match, they are
+  // filtered out by the key comparison
+  Mask Match(Ctrl hash) const noexcept {
+    const auto x = ctrl_ ^ (kLsbs * static_cast<std::uint8_t>(hash));
+    return Mask((x - kLsbs) & ~x & kMsbs);
+  }
+
+  Mask MaskEmpty() const noexcept {
+    return Mask((ctrl_ & (~ctrl_ << 6)) & kMsbs);
+  }
+
+  Mask MaskEmptyOrDeleted() const noexcept {
+    return Mask((ctrl_ & (~ctrl_ << 7)) & kMsbs);
+  }
+
+ private:
+  static constexpr std::uint64_t kMsbs = 0x8080808080808080ULL;
+  static constexpr std::uint64_t kLsbs = 0x0101010101010101ULL;
+
+  std::uint64_t ctrl_;
+};
+
+#endif
+
+// Control bytes of a map without slots, every lookup stops at the first group
+alignas(16) inline constexpr Ctrl kEmptyGroup[Group::kWidth] = {
+    kSentinel, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty,
+#if defined(__SSE2__)
+    kEmpty,    kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty,
+#endif
+};
+
+// std::hash of integers is an identity, so the hash is mixed for the low and
+// high bits to be usable as H1 and H2
+constexpr std::size_t MixHash(std::size_t hash) noexcept {
+  const auto mixed = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+  return static_cast<std::size_t>(mixed ^ (mixed >> 32));
+}
+
+constexpr std::size_t H1(std::size_t hash) noexcept { return hash >> 7; }
+constexpr Ctrl H2(std::size_t hash) noexcept {
+  return static_cast<Ctrl>(hash & 0x7F);
+}
+
+// Max load factor is 7/8. At least one slot is left empty for the lookups of
+// the missing keys to stop.
+constexpr std::size_t CapacityToGrowth(std::size_t capacity) noexcept {
+  if (Group::kWidth == 8 && capacity == 7) return 6;
+  return capacity - capacity / 8;
+}
+
+// Capacity is 2^N - 1
+constexpr std::size_t NormalizeCapacity(std::size_t size) noexcept {
+  std::size_t capacity = 1;
+  while (CapacityToGrowth(capacity) < size) capacity = capacity * 2 + 1;
+  return capacity;
+}
+
+}  // namespace impl::flat_hash_map
+
+/// @ingroup userver_containers
+///
+/// @brief Open addressing hash map that stores the elements in a single
+/// array, a replacement for std::unordered_map with a faster lookup and a
+/// lower memory usage.
+///
+/// The map follows the SwissTable design: each slot has a control byte with 7
+/// bits of the key hash, and the lookup compares a group of 16 control bytes
+/// with a single SIMD instruction (SSE2, or 8 bytes with the integer
+/// arithmetic on the other platforms). Only the slots with matching control
+/// bytes are compared with the key, so a lookup usually costs one cache miss.
+///
+/// @snippet shared/src/utils/flat_hash_map_test.cpp  FlatHashMap usage
+///
+/// Unlike std::unordered_map, an insertion that grows the map invalidates all
+/// the iterators and the references to the elements. Erase invalidates only
+/// the erased element.
+///
+/// The map supports dump::Read and dump::Write and could be used as a
+/// container of caches, e.g. as CacheContainer of components::PostgreCache or
+/// DataType of components::MongoCache.
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class FlatHashMap final {
+  template <bool IsConst>
+  class Iterator;
+
+  using Ctrl = impl::flat_hash_map::Ctrl;
+  using Group = impl::flat_hash_map::Group;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const Key, Value>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = Equal;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  FlatHashMap() noexcept = default;
+
+  explicit FlatHashMap(size_type bucket_count, const Hash& hash = Hash{},
+                       const Equal& equal = Equal{})
+      : hash_(hash), equal_(equal) {
+    reserve(bucket_count);
+  }
+
+  FlatHashMap(std::initializer_list<value_type> init) {
+    reserve(init.size());
+    for (const auto& value : init) insert(value);
+  }
+
+  template <typename InputIt>
+  FlatHashMap(InputIt first, InputIt last) {
+    for (; first != last; ++first) insert(*first);
+  }
+
+  FlatHashMap(const FlatHashMap& other)
+      : hash_(other.hash_), equal_(other.equal_) {
+    reserve(other.size());
+    for (const auto& value : other) Insert(value.first, value);
+  }
+
+  FlatHashMap(FlatHashMap&& other) noexcept
+      : ctrl_(std::exchange(other.ctrl_, EmptyCtrl())),
+        slots_(std::exchange(other.slots_, nullptr)),
+        capacity_(std::exchange(other.capacity_, 0)),
+        size_(std::exchange(other.size_, 0)),
+        growth_left_(std::exchange(other.growth_left_, 0)),
+        hash_(std::move(other.hash_)),
+        equal_(std::move(other.equal_)) {}
+
+  FlatHashMap& operator=(const FlatHashMap& other) {
+    if (this != &other) {
+      FlatHashMap copy{other};
+      swap(copy);
+    }
+    return *this;
+  }
+
+  FlatHashMap& operator=(FlatHashMap&& other) noexcept {
+    if (this != &other) {
+      FlatHashMap moved{std::move(other)};
+      swap(moved);
+    }
+    return *this;
+  }
+
+  ~FlatHashMap() { Deallocate(); }
+
+  iterator begin() noexcept { return iterator{ctrl_, slots_}; }
+  iterator end() noexcept { return MakeIterator(capacity_); }
+  const_iterator begin() const noexcept {
+    return const_iterator{ctrl_, slots_};
+  }
+  const_iterator end() const noexcept { return MakeIterator(capacity_); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  /// Count of the slots, including the empty ones
+  size_type capacity() const noexcept { return capacity_; }
+
+  /// Allocates the slots for at least `count` elements
+  void reserve(size_type count) {
+    if (count > size_ + growth_left_) {
+      Resize(impl::flat_hash_map::NormalizeCapacity(count));
+    }
+  }
+
+  /// Destroys the elements, keeps the allocated slots
+  void clear() noexcept;
+
+  iterator find(const Key& key) noexcept { return MakeIterator(Find(key)); }
+  const_iterator find(const Key& key) const noexcept {
+    return MakeIterator(Find(key));
+  }
+
+  size_type count(const Key& key) const noexcept {
+    return Find(key) == capacity_ ? 0 : 1;
+  }
+  bool contains(const Key& key) const noexcept {
+    return Find(key) != capacity_;
+  }
+
+  /// @throws std::out_of_range if there is no such key
+  Value& at(const Key& key);
+  const Value& at(const Key& key) const;
+
+  Value& operator[](const Key& key) { return try_emplace(key).first->second; }
+  Value& operator[](Key&& key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return Insert(value.first, value);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return Insert(value.first, std::move(value));
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) insert(*first);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    return Insert(key, std::piecewise_construct, std::forward_as_tuple(key),
+                  std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+    return Insert(key, std::piecewise_construct,
+                  std::forward_as_tuple(std::move(key)),
+                  std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename K, typename V>
+  std::pair<iterator, bool> insert_or_assign(K&& key, V&& value);
+
+  size_type erase(const Key& key);
+  iterator erase(const_iterator it);
+  iterator erase(iterator it) { return erase(const_iterator{it}); }
+
+  void swap(FlatHashMap& other) noexcept;
+
+  bool operator==(const FlatHashMap& other) const;
+  bool operator!=(const FlatHashMap& other) const { return !(*this == other); }
+
+ private:
+  using SlotAllocator = std::allocator<value_type>;
+
+  static Ctrl* EmptyCtrl() noexcept {
+    // never written: the empty map has no slots and grows before an insertion
+    return const_cast<Ctrl*>(impl::flat_hash_map::kEmptyGroup);
+  }
+
+  std::size_t HashOf(const Key& key) const noexcept {
+    return impl::flat_hash_map::MixHash(hash_(key));
+  }
+
+  iterator MakeIterator(size_type index) noexcept {
+    return iterator{ctrl_ + index, slots_ + index, SkipTag{}};
+  }
+  const_iterator MakeIterator(size_type index) const noexcept {
+    return const_iterator{ctrl_ + index, slots_ + index, SkipTag{}};
+  }
+
+  // @returns the index of the key or capacity_ if there is none
+  size_type Find(const Key& key) const noexcept;
+
+  // @returns the index of the first empty or deleted slot for the hash
+  size_type FindInsertPosition(std::size_t hash) const noexcept;
+
+  template <typename... Args>
+  std::pair<iterator, bool> Insert(const Key& key, Args&&... args);
+
+  void SetCtrl(size_type index, Ctrl ctrl) noexcept;
+  void Resize(size_type new_capacity);
+  void DestroySlots() noexcept;
+  void Deallocate() noexcept;
+
+  struct SkipTag {};
+
+  Ctrl* ctrl_{EmptyCtrl()};
+  value_type* slots_{nullptr};
+  size_type capacity_{0};
+  size_type size_{0};
+  size_type growth_left_{0};
+  Hash hash_{};
+  Equal equal_{};
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <bool IsConst>
+class FlatHashMap<Key, Value, Hash, Equal>::Iterator final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = typename FlatHashMap::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+  using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+
+  Iterator() noexcept = default;
+
+  template <bool OtherIsConst,
+            typename = std::enable_if_t<IsConst && !OtherIsConst>>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  Iterator(const Iterator<OtherIsConst>& other) noexcept
+      : ctrl_(other.ctrl_), slot_(other.slot_) {}
+
+  reference operator*() const noexcept { return *slot_; }
+  pointer operator->() const noexcept { return slot_; }
+
+  Iterator& operator++() noexcept {
+    ++ctrl_;
+    ++slot_;
+    SkipEmptyOrDeleted();
+    return *this;
+  }
+
+  Iterator operator++(int) noexcept {
+    auto copy = *this;
+    ++*this;
+    return copy;
+  }
+
+  bool operator==(const Iterator& other) const noexcept {
+    return ctrl_ == other.ctrl_;
+  }
+  bool operator!=(const Iterator& other) const noexcept {
+    return ctrl_ != other.ctrl_;
+  }
+
+ private:
+  friend class FlatHashMap;
+  friend class Iterator<!IsConst>;
+
+  Iterator(const Ctrl* ctrl, pointer slot) noexcept
+      : ctrl_(ctrl), slot_(slot) {
+    SkipEmptyOrDeleted();
+  }
+
+  Iterator(const Ctrl* ctrl, pointer slot, SkipTag) noexcept
+      : ctrl_(ctrl), slot_(slot) {}
+
+  // stops at the sentinel after the last slot
+  void SkipEmptyOrDeleted() noexcept {
+    while (impl::flat_hash_map::IsEmptyOrDeleted(*ctrl_)) {
+      ++ctrl_;
+      ++slot_;
+    }
+  }
+
+  const Ctrl* ctrl_{nullptr};
+  pointer slot_{nullptr};
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void FlatHashMap<Key, Value, Hash, Equal>::clear() noexcept {
+  if (capacity_ == 0) return;
+  DestroySlots();
+  std::memset(ctrl_, impl::flat_hash_map::kEmpty,
+              capacity_ + Group::kWidth);
+  ctrl_[capacity_] = impl::flat_hash_map::kSentinel;
+  size_ = 0;
+  growth_left_ = impl::flat_hash_map::CapacityToGrowth(capacity_);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+Value& FlatHashMap<Key, Value, Hash, Equal>::at(const Key& key) {
+  const auto index = Find(key);
+  if (index == capacity_) throw std::out_of_range("FlatHashMap::at");
+  return slots_[index].second;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+const Value& FlatHashMap<Key, Value, Hash, Equal>::at(const Key& key) const {
+  const auto index = Find(key);
+  if (index == capacity_) throw std::out_of_range("FlatHashMap::at");
+  return slots_[index].second;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename K, typename V>
+auto FlatHashMap<Key, Value, Hash, Equal>::insert_or_assign(K&& key, V&& value)
+    -> std::pair<iterator, bool> {
+  auto result = try_emplace(std::forward<K>(key), std::forward<V>(value));
+  if (!result.second) result.first->second = std::forward<V>(value);
+  return result;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto FlatHashMap<Key, Value, Hash, Equal>::erase(const Key& key) -> size_type {
+  const auto index = Find(key);
+  if (index == capacity_) return 0;
+  erase(MakeIterator(index));
+  return 1;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto FlatHashMap<Key, Value, Hash, Equal>::erase(const_iterator it)
+    -> iterator {
+  UASSERT(it != end());
+  const auto index = static_cast<size_type>(it.ctrl_ - ctrl_);
+  SlotAllocator allocator;
+  std::allocator_traits<SlotAllocator>::destroy(allocator, slots_ + index);
+  --size_;
+
+  // The slot may be marked empty only if no probe sequence has passed it,
+  // i.e. no group containing the slot has ever been full
+  const auto empty_after = Group{ctrl_ + index}.MaskEmpty();
+  const auto empty_before =
+      Group{ctrl_ + ((index - Group::kWidth) & capacity_)}.MaskEmpty();
+  if (empty_before && empty_after &&
+      empty_after.LowestBitSet() + empty_before.LeadingZeros() <
+          Group::kWidth) {
+    SetCtrl(index, impl::flat_hash_map::kEmpty);
+    ++growth_left_;
+  } else {
+    SetCtrl(index, impl::flat_hash_map::kDeleted);
+  }
+
+  auto next = MakeIterator(index);
+  ++next;
+  return next;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void FlatHashMap<Key, Value, Hash, Equal>::swap(FlatHashMap& other) noexcept {
+  using std::swap;
+  swap(ctrl_, other.ctrl_);
+  swap(slots_, other.slots_);
+  swap(capacity_, other.capacity_);
+  swap(size_, other.size_);
+  swap(growth_left_, other.growth_left_);
+  swap(hash_, other.hash_);
+  swap(equal_, other.equal_);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool FlatHashMap<Key, Value, Hash, Equal>::operator==(
+    const FlatHashMap& other) const {
+  if (size_ != other.size_) return false;
+  for (const auto& [key, value] : *this) {
+    const auto it = other.find(key);
+    if (it == other.end() || !(it->second == value)) return false;
+  }
+  return true;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto FlatHashMap<Key, Value, Hash, Equal>::Find(const Key& key) const noexcept
+    -> size_type {
+  const auto hash = HashOf(key);
+  const auto h2 = impl::flat_hash_map::H2(hash);
+  auto offset = impl::flat_hash_map::H1(hash) & capacity_;
+  for (size_type step = Group::kWidth;; step += Group::kWidth) {
+    const Group group{ctrl_ + offset};
+    for (auto match = group.Match(h2); match; match.ClearLowestBit()) {
+      const auto index = (offset + match.LowestBitSet()) & capacity_;
+      if (equal_(slots_[index].first, key)) return index;
+    }
+    if (group.MaskEmpty()) return capacity_;
+    offset = (offset + step) & capacity_;
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto FlatHashMap<Key, Value, Hash, Equal>::FindInsertPosition(
+    std::size_t hash) const noexcept -> size_type {
+  auto offset = impl::flat_hash_map::H1(hash) & capacity_;
+  for (size_type step = Group::kWidth;; step += Group::kWidth) {
+    const auto mask = Group{ctrl_ + offset}.MaskEmptyOrDeleted();
+    if (mask) return (offset + mask.LowestBitSet()) & capacity_;
+    offset = (offset + step) & capacity_;
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename... Args>
+auto FlatHashMap<Key, Value, Hash, Equal>::Insert(const Key& key,
+                                                  Args&&... args)
+    -> std::pair<iterator, bool> {
+  if (const auto index = Find(key); index != capacity_) {
+    return {MakeIterator(index), false};
+  }
+
+  const auto hash = HashOf(key);
+  auto index = FindInsertPosition(hash);
+  if (growth_left_ == 0 && ctrl_[index] != impl::flat_hash_map::kDeleted) {
+    // many deleted slots are reclaimed without growing
+    const bool has_many_deleted =
+        capacity_ > Group::kWidth && size_ * 32 <= capacity_ * 25;
+    Resize(has_many_deleted ? capacity_ : capacity_ * 2 + 1);
+    index = FindInsertPosition(hash);
+  }
+
+  SlotAllocator allocator;
+  std::allocator_traits<SlotAllocator>::construct(
+      allocator, slots_ + index, std::forward<Args>(args)...);
+  if (ctrl_[index] == impl::flat_hash_map::kEmpty) --growth_left_;
+  SetCtrl(index, impl::flat_hash_map::H2(hash));
+  ++size_;
+  return {MakeIterator(index), true};
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void FlatHashMap<Key, Value, Hash, Equal>::SetCtrl(size_type index,
+                                                   Ctrl ctrl) noexcept {
+  ctrl_[index] = ctrl;
+  // the first bytes are cloned after the sentinel for the group loads that
+  // wrap around the end
+  if (index < Group::kWidth - 1) ctrl_[capacity_ + 1 + index] = ctrl;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void FlatHashMap<Key, Value, Hash, Equal>::Resize(size_type new_capacity) {
+  UASSERT(((new_capacity + 1) & new_capacity) == 0);
+  UASSERT(impl::flat_hash_map::CapacityToGrowth(new_capacity) >= size_);
+
+  SlotAllocator allocator;
+  auto* new_slots = allocator.allocate(new_capacity);
+  auto* new_ctrl = new Ctrl[new_capacity + Group::kWidth];
+  std::memset(new_ctrl, impl::flat_hash_map::kEmpty,
+              new_capacity + Group::kWidth);
+  new_ctrl[new_capacity] = impl::flat_hash_map::kSentinel;
+
+  auto* old_ctrl = std::exchange(ctrl_, new_ctrl);
+  auto* old_slots = std::exchange(slots_, new_slots);
+  const auto old_capacity = std::exchange(capacity_, new_capacity);
+  growth_left_ = impl::flat_hash_map::CapacityToGrowth(new_capacity) - size_;
+
+  for (size_type i = 0; i < old_capacity; ++i) {
+    if (!impl::flat_hash_map::IsFull(old_ctrl[i])) continue;
+    auto& old_value = old_slots[i];
+    const auto hash = HashOf(old_value.first);
+    const auto index = FindInsertPosition(hash);
+    // the old slot is destroyed right away, so its key could be moved out
+    std::allocator_traits<SlotAllocator>::construct(
+        allocator, new_slots + index,
+        std::move(const_cast<Key&>(old_value.first)),
+        std::move(old_value.second));
+    std::allocator_traits<SlotAllocator>::destroy(allocator, &old_value);
+    SetCtrl(index, impl::flat_hash_map::H2(hash));
+  }
+
+  if (old_capacity != 0) {
+    allocator.deallocate(old_slots, old_capacity);
+    delete[] old_ctrl;
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void FlatHashMap<Key, Value, Hash, Equal>::DestroySlots() noexcept {
+  if constexpr (!std::is_trivially_destructible_v<value_type>) {
+    SlotAllocator allocator;
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (impl::flat_hash_map::IsFull(ctrl_[i])) {
+        std::allocator_traits<SlotAllocator>::destroy(allocator, slots_ + i);
+      }
+    }
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void FlatHashMap<Key, Value, Hash, Equal>::Deallocate() noexcept {
+  if (capacity_ == 0) return;
+  DestroySlots();
+  SlotAllocator{}.deallocate(slots_, capacity_);
+  delete[] ctrl_;
+}
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -13,6 +13,7 @@ namespace utils::datetime {
 
 std::chrono::system_clock::time_point MockNow() noexcept;
 std::chrono::steady_clock::time_point MockSteadyNow() noexcept;
+std::chrono::steady_clock::time_point MockSteadyCoarseNow() noexcept;
 void MockNowSet(std::chrono::system_clock::time_point new_mocked_now);
 void MockSleep(std::chrono::seconds duration);
 void MockSleep(std::chrono::milliseconds duration);
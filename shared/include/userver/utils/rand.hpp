@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <limits>
 #include <random>
 
 #include <userver/utils/assert.hpp>
@@ -26,11 +28,67 @@ class RandomBase {
   static constexpr result_type max() { return std::mt19937::max(); }
 };
 
+/// @brief Fast non-virtual UniformRandomBitGenerator (xoshiro256++)
+///
+/// Has only 32 bytes of state, so it is cheap to seed and to keep per thread.
+/// Not thread safe.
+/// @note Not cryptographically secure
+class FastRandom final {
+ public:
+  using result_type = std::uint64_t;
+
+  /// Seeds the generator from std::random_device
+  FastRandom();
+
+  /// Seeds the generator deterministically
+  explicit FastRandom(std::uint64_t seed) noexcept {
+    // SplitMix64, the recommended way to fill the xoshiro state
+    for (auto& word : state_) {
+      seed += 0x9e3779b97f4a7c15;
+      auto z = seed;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+      word = z ^ (z >> 31);
+    }
+  }
+
+  result_type operator()() noexcept {
+    const auto result = RotateLeft(state_[0] + state_[3], 23) + state_[0];
+    const auto t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = RotateLeft(state_[3], 45);
+    return result;
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+ private:
+  static constexpr std::uint64_t RotateLeft(std::uint64_t x, int k) noexcept {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  std::array<std::uint64_t, 4> state_{};
+};
+
 /// @brief Returns a thread-local UniformRandomBitGenerator
 /// @note The provided `Random` instance is not cryptographically secure
 /// @warning Don't pass the returned `Random` across thread boundaries
 RandomBase& DefaultRandom();
 
+/// @brief Returns a thread-local FastRandom, for the hot paths that need many
+/// random numbers at once
+/// @note The provided instance is not cryptographically secure
+/// @warning Don't pass the returned instance across thread boundaries, don't
+/// keep it across the coroutine suspension points
+FastRandom& DefaultFastRandom();
+
 /// @brief Generates a random number in range [from, to)
 /// @note The used random generator is not cryptographically secure
 /// @note `from_inclusive` must be less than `to_exclusive`
@@ -3,7 +3,9 @@
 /// @file userver/utils/trivial_map.hpp
 /// @brief Bidirectional map|sets over string literals or other trivial types.
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -272,6 +274,255 @@ class CaseFirstDescriber final {
   std::string description_{};
 };
 
+// Compilers turn the chains of string comparisons into a switch by length,
+// until the chain becomes too long to inline. Integral chains stay linear,
+// a hash table is faster for them much sooner. See trivial_map_benchmark.cpp
+template <typename T>
+inline constexpr std::size_t kSearchTableThreshold =
+    std::is_same_v<T, std::string_view> ? 48 : 16;
+
+template <std::size_t Count>
+class TypedCaseCounter final {
+ public:
+  static constexpr std::size_t kCount = Count;
+
+  template <typename First, typename Second>
+  constexpr TypedCaseCounter<Count + 1> Case(First, Second) const noexcept {
+    return {};
+  }
+
+  template <typename First>
+  constexpr TypedCaseCounter<Count + 1> Case(First) const noexcept {
+    return {};
+  }
+};
+
+struct TypedCaseCounterFactory final {
+  constexpr TypedCaseCounter<0> operator()() const noexcept { return {}; }
+};
+
+template <typename BuilderFunc>
+inline constexpr std::size_t kCaseCount =
+    std::invoke_result_t<const BuilderFunc&, TypedCaseCounterFactory>::kCount;
+
+template <typename T>
+inline constexpr bool kIsSearchTableKey =
+    std::is_integral_v<T> || std::is_enum_v<T> ||
+    std::is_same_v<T, std::string_view>;
+
+template <typename T>
+constexpr bool UseSearchTable(std::size_t size) noexcept {
+  if constexpr (kIsSearchTableKey<T>) {
+    return size > kSearchTableThreshold<T>;
+  } else {
+    return false;
+  }
+}
+
+// Compilers merge the byte loads into a single load
+constexpr std::uint64_t LoadBytes(const char* data, std::size_t size) noexcept {
+  std::uint64_t result = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    result |= std::uint64_t{static_cast<unsigned char>(data[i])} << (i * 8);
+  }
+  return result;
+}
+
+// Reads at most 16 bytes of the string, the keys are mostly short
+constexpr std::uint64_t SearchTableHash(std::string_view value) noexcept {
+  const auto* data = value.data();
+  const auto size = value.size();
+  std::uint64_t first = 0;
+  std::uint64_t last = 0;
+  if (size >= 8) {
+    first = impl::LoadBytes(data, 8);
+    last = impl::LoadBytes(data + size - 8, 8);
+  } else if (size >= 4) {
+    first = impl::LoadBytes(data, 4);
+    last = impl::LoadBytes(data + size - 4, 4);
+  } else if (size > 0) {
+    first = impl::LoadBytes(data, 1) |
+            (impl::LoadBytes(data + size / 2, 1) << 8);
+    last = impl::LoadBytes(data + size - 1, 1);
+  }
+  const auto mixed = (first ^ size) * 0x9e3779b97f4a7c15;
+  return (mixed ^ (mixed >> 29) ^ last) * 0xbf58476d1ce4e5b9;
+}
+
+template <typename T>
+constexpr std::uint64_t SearchTableHash(T value) noexcept {
+  if constexpr (std::is_enum_v<T>) {
+    return impl::SearchTableHash(static_cast<std::underlying_type_t<T>>(value));
+  } else {
+    return static_cast<std::uint64_t>(value) * 0x9e3779b97f4a7c15;
+  }
+}
+
+constexpr std::size_t SearchTableBuckets(std::size_t size) noexcept {
+  std::size_t buckets = 1;
+  while (buckets < size * 2) buckets *= 2;
+  return buckets;
+}
+
+constexpr int Log2(std::size_t value) noexcept {
+  int result = 0;
+  while (value > 1) {
+    value /= 2;
+    ++result;
+  }
+  return result;
+}
+
+template <typename First, typename Second, std::size_t Size>
+class CaseCollector final {
+ public:
+  struct Entry {
+    First first{};
+    Second second{};
+  };
+
+  constexpr CaseCollector& Case(First first, Second second) noexcept {
+    entries_[size_++] = Entry{first, second};
+    return *this;
+  }
+
+  [[nodiscard]] constexpr const std::array<Entry, Size>& Extract()
+      const noexcept {
+    return entries_;
+  }
+
+ private:
+  std::array<Entry, Size> entries_{};
+  std::size_t size_{0};
+};
+
+template <typename First, std::size_t Size>
+class CaseCollector<First, void, Size> final {
+ public:
+  struct Entry {
+    First first{};
+  };
+
+  constexpr CaseCollector& Case(First first) noexcept {
+    entries_[size_++] = Entry{first};
+    return *this;
+  }
+
+  [[nodiscard]] constexpr const std::array<Entry, Size>& Extract()
+      const noexcept {
+    return entries_;
+  }
+
+ private:
+  std::array<Entry, Size> entries_{};
+  std::size_t size_{0};
+};
+
+/// Open addressing hash table built at compile time, with the values of the
+/// same Case statements. Value is void for sets.
+template <typename Key, typename Value, std::size_t Size>
+class SearchTable final {
+ public:
+  /// `Projection` selects the key and the value from the collected entry
+  template <typename Entries, typename Projection>
+  constexpr SearchTable(const Entries& entries,
+                        Projection projection) noexcept {
+    std::size_t size = 0;
+    for (const auto& entry : entries) {
+      const auto projected = projection(entry);
+      auto bucket = BucketOf(projected.first);
+      // the first Case statement wins for equal keys, as with the chain of
+      // comparisons
+      for (; buckets_[bucket] != kEmpty; bucket = (bucket + 1) % kBuckets) {
+        if (keys_[buckets_[bucket] - 1] == projected.first) break;
+      }
+      if (buckets_[bucket] != kEmpty) continue;
+
+      keys_[size] = projected.first;
+      if constexpr (!std::is_void_v<Value>) values_[size] = projected.second;
+      buckets_[bucket] = static_cast<Index>(++size);
+    }
+  }
+
+  /// Returns the index of the key, or Size
+  constexpr std::size_t FindIndex(Key key) const noexcept {
+    for (auto bucket = BucketOf(key);; bucket = (bucket + 1) % kBuckets) {
+      const std::size_t index = buckets_[bucket];
+      if (index == kEmpty) return Size;
+      if (keys_[index - 1] == key) return index - 1;
+    }
+  }
+
+  constexpr bool Contains(Key key) const noexcept {
+    return FindIndex(key) != Size;
+  }
+
+  template <typename V = Value>
+  constexpr std::optional<V> Find(Key key) const noexcept {
+    const auto index = FindIndex(key);
+    if (index == Size) return std::nullopt;
+    return values_[index];
+  }
+
+ private:
+  // at most half of the buckets are used, so the probe sequences are short
+  static constexpr std::size_t kBuckets = impl::SearchTableBuckets(Size);
+  static constexpr int kHashShift = 64 - impl::Log2(kBuckets);
+
+  // 1-based indices of the keys, 0 is for the empty buckets
+  static_assert(Size < 65535, "Too many Case statements");
+  using Index = std::conditional_t<(Size < 255), std::uint8_t, std::uint16_t>;
+  static constexpr Index kEmpty = 0;
+
+  using Values = std::conditional_t<std::is_void_v<Value>, std::array<Key, 0>,
+                                    std::array<Value, Size>>;
+
+  static constexpr std::size_t BucketOf(Key key) noexcept {
+    // the upper bits of the multiplicative hash are the best mixed ones
+    return (kBuckets == 1) ? 0 : impl::SearchTableHash(key) >> kHashShift;
+  }
+
+  std::array<Index, kBuckets> buckets_{};
+  std::array<Key, Size> keys_{};
+  Values values_{};
+};
+
+/// Used instead of SearchTable for small maps and unhashable keys
+struct NoSearchTable final {};
+
+template <bool Enabled, typename Key, typename Value, std::size_t Size>
+using SearchTableIf = std::conditional_t<Enabled, SearchTable<Key, Value, Size>,
+                                         NoSearchTable>;
+
+template <typename First, typename Second>
+struct Projected {
+  First first;
+  Second second;
+};
+
+struct ByFirst final {
+  template <typename Entry>
+  constexpr auto operator()(const Entry& entry) const noexcept {
+    return Projected<decltype(entry.first), decltype(entry.second)>{
+        entry.first, entry.second};
+  }
+};
+
+struct BySecond final {
+  template <typename Entry>
+  constexpr auto operator()(const Entry& entry) const noexcept {
+    return Projected<decltype(entry.second), decltype(entry.first)>{
+        entry.second, entry.first};
+  }
+};
+
+struct KeyOnly final {
+  template <typename Entry>
+  constexpr auto operator()(const Entry& entry) const noexcept {
+    return Projected<decltype(entry.first), bool>{entry.first, false};
+  }
+};
+
 }  // namespace impl
 
 /// @ingroup userver_containers
@@ -294,6 +545,11 @@ class CaseFirstDescriber final {
 /// The same story with integral or enum mappings - compiler optimizes them
 /// into a switch and it usually takes O(1) to find the match.
 ///
+/// Maps with more than 48 Case statements of string keys or more than 16
+/// Case statements of integral or enum keys are searched in a hash table
+/// built at compile time, in O(1). Declare such maps `constexpr` at namespace
+/// scope or `static constexpr`, so that the table is built only once.
+///
 /// @snippet shared/src/utils/trivial_map_test.cpp  sample bidir bimap
 ///
 /// For a single value Case statements see @ref utils::TrivialSet.
@@ -306,7 +562,10 @@ class TrivialBiMap final {
   using First = typename TypesPair::first_type;
   using Second = typename TypesPair::second_type;
 
-  constexpr TrivialBiMap(BuilderFunc&& func) noexcept : func_(std::move(func)) {
+  constexpr TrivialBiMap(BuilderFunc&& func) noexcept
+      : func_(std::move(func)),
+        by_first_(MakeTable<FirstTable>(func_, impl::ByFirst{})),
+        by_second_(MakeTable<SecondTable>(func_, impl::BySecond{})) {
     static_assert(std::is_empty_v<BuilderFunc>,
                   "Mapping function should not capture variables");
     static_assert(std::is_trivially_copyable_v<First>,
@@ -319,15 +578,25 @@ class TrivialBiMap final {
   }
 
   constexpr std::optional<Second> TryFindByFirst(First value) const noexcept {
-    return func_(
-               [value]() { return impl::SwitchByFirst<First, Second>{value}; })
-        .Extract();
+    if constexpr (kSearchByFirst) {
+      return by_first_.Find(value);
+    } else {
+      return func_([value]() {
+               return impl::SwitchByFirst<First, Second>{value};
+             })
+          .Extract();
+    }
   }
 
   constexpr std::optional<First> TryFindBySecond(Second value) const noexcept {
-    return func_(
-               [value]() { return impl::SwitchBySecond<First, Second>{value}; })
-        .Extract();
+    if constexpr (kSearchBySecond) {
+      return by_second_.Find(value);
+    } else {
+      return func_([value]() {
+               return impl::SwitchBySecond<First, Second>{value};
+             })
+          .Extract();
+    }
   }
 
   template <class T>
@@ -385,7 +654,29 @@ class TrivialBiMap final {
   }
 
  private:
+  static constexpr std::size_t kSize = impl::kCaseCount<BuilderFunc>;
+  static constexpr bool kSearchByFirst = impl::UseSearchTable<First>(kSize);
+  static constexpr bool kSearchBySecond = impl::UseSearchTable<Second>(kSize);
+
+  using FirstTable = impl::SearchTableIf<kSearchByFirst, First, Second, kSize>;
+  using SecondTable =
+      impl::SearchTableIf<kSearchBySecond, Second, First, kSize>;
+
+  template <typename Table, typename Projection>
+  static constexpr Table MakeTable(const BuilderFunc& func,
+                                   Projection projection) noexcept {
+    if constexpr (std::is_same_v<Table, impl::NoSearchTable>) {
+      return {};
+    } else {
+      const auto cases = func(
+          []() { return impl::CaseCollector<First, Second, kSize>{}; });
+      return Table{cases.Extract(), projection};
+    }
+  }
+
   const BuilderFunc func_;
+  const FirstTable by_first_;
+  const SecondTable by_second_;
 };
 
 /// @ingroup userver_containers
@@ -403,7 +694,8 @@ class TrivialSet final {
   using First = typename TypesPair::first_type;
   using Second = typename TypesPair::second_type;
 
-  constexpr TrivialSet(BuilderFunc&& func) noexcept : func_(std::move(func)) {
+  constexpr TrivialSet(BuilderFunc&& func) noexcept
+      : func_(std::move(func)), table_(MakeTable(func_)) {
     static_assert(std::is_empty_v<BuilderFunc>,
                   "Mapping function should not capture variables");
     static_assert(std::is_trivially_copyable_v<First>,
@@ -413,9 +705,14 @@ class TrivialSet final {
   }
 
   constexpr bool Contains(First value) const noexcept {
-    return func_(
-               [value]() { return impl::SwitchByFirst<First, Second>{value}; })
-        .Extract();
+    if constexpr (kSearch) {
+      return table_.Contains(value);
+    } else {
+      return func_([value]() {
+               return impl::SwitchByFirst<First, Second>{value};
+             })
+          .Extract();
+    }
   }
 
   constexpr bool ContainsICase(std::string_view value) const noexcept {
@@ -440,7 +737,23 @@ class TrivialSet final {
   }
 
  private:
+  static constexpr std::size_t kSize = impl::kCaseCount<BuilderFunc>;
+  static constexpr bool kSearch = impl::UseSearchTable<First>(kSize);
+
+  using Table = impl::SearchTableIf<kSearch, First, void, kSize>;
+
+  static constexpr Table MakeTable(const BuilderFunc& func) noexcept {
+    if constexpr (std::is_same_v<Table, impl::NoSearchTable>) {
+      return {};
+    } else {
+      const auto cases =
+          func([]() { return impl::CaseCollector<First, void, kSize>{}; });
+      return Table{cases.Extract(), impl::KeyOnly{}};
+    }
+  }
+
   const BuilderFunc func_;
+  const Table table_;
 };
 
 }  // namespace utils
@@ -3,7 +3,9 @@
 /// @file utils/uuid4.hpp
 /// @brief @copybrief utils::generators::GenerateUuid
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -12,6 +14,10 @@ namespace utils::generators {
 /// @brief Generate a UUID string
 std::string GenerateUuid();
 
+/// @brief Generate `count` UUID strings at once, faster than GenerateUuid()
+/// in a loop
+std::vector<std::string> GenerateUuids(std::size_t count);
+
 }  // namespace utils::generators
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+
+#include <userver/cache/chunked_cow_map.hpp>
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Map = cache::ChunkedCowMap<int, std::string>;
+
+std::map<int, std::string> ToStdMap(const Map& map) {
+  return {map.begin(), map.end()};
+}
+
+}  // namespace
+
+static_assert(meta::kIsMap<Map>);
+
+TEST(ChunkedCowMap, Empty) {
+  const Map map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.find(1), map.end());
+  EXPECT_EQ(map.count(1), 0);
+}
+
+TEST(ChunkedCowMap, Modification) {
+  Map map;
+  EXPECT_TRUE(map.insert_or_assign(1, "a").second);
+  EXPECT_FALSE(map.insert_or_assign(1, "b").second);
+  map[2] = "c";
+  map[2] += "d";
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(ToStdMap(map), (std::map<int, std::string>{{1, "b"}, {2, "cd"}}));
+
+  ASSERT_NE(map.find(2), map.end());
+  EXPECT_EQ(map.find(2)->second, "cd");
+  EXPECT_TRUE(map.contains(1));
+
+  EXPECT_EQ(map.erase(3), 0);
+  EXPECT_EQ(map.erase(1), 1);
+  EXPECT_EQ(map.size(), 1);
+  EXPECT_FALSE(map.contains(1));
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(ChunkedCowMap, Iteration) {
+  using SmallMap =
+      cache::ChunkedCowMap<int, int, std::hash<int>, std::equal_to<>, 4>;
+  SmallMap map;
+  std::map<int, int> expected;
+  for (int i = 0; i < 100; i += 3) {
+    map.insert_or_assign(i, i * i);
+    expected.emplace(i, i * i);
+  }
+  EXPECT_EQ(map.size(), expected.size());
+  EXPECT_EQ((std::map<int, int>{map.begin(), map.end()}), expected);
+}
+
+TEST(ChunkedCowMap, Copy) {
+  /// [ChunkedCowMap usage]
+  Map map;
+  for (int i = 0; i < 10000; ++i) map.insert_or_assign(i, std::to_string(i));
+
+  // O(ChunksCount), the data is shared
+  Map copy = map;
+  copy.insert_or_assign(1, "changed");
+  copy.erase(2);
+  copy[10000] = "new";
+
+  EXPECT_EQ(map.find(1)->second, "1");
+  EXPECT_TRUE(map.contains(2));
+  EXPECT_FALSE(map.contains(10000));
+  EXPECT_EQ(map.size(), 10000);
+  /// [ChunkedCowMap usage]
+
+  EXPECT_EQ(copy.find(1)->second, "changed");
+  EXPECT_FALSE(copy.contains(2));
+  EXPECT_EQ(copy.find(10000)->second, "new");
+  EXPECT_EQ(copy.size(), 10000);
+
+  // the unchanged chunks are shared
+  EXPECT_EQ(&map.find(3)->second, &copy.find(3)->second);
+  EXPECT_NE(&map.find(1)->second, &copy.find(1)->second);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,94 @@
+#include <userver/cache/impl/frequency_sketch.hpp>
+
+#include <algorithm>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+namespace {
+
+constexpr std::size_t kDepth = 4;
+constexpr std::uint64_t kSeeds[kDepth] = {
+    0xc3a5c85c97cb3127ULL,
+    0xb492b66fbe98f273ULL,
+    0x9ae16a3b2f90404fULL,
+    0xcbf29ce484222325ULL,
+};
+constexpr std::uint64_t kCounterMax = 15;
+constexpr std::uint64_t kAgeMask = 0x7777777777777777ULL;
+constexpr std::size_t kSampleSizeFactor = 10;
+
+// std::hash of integers is identity, mix the bits before using them
+std::uint64_t Spread(std::uint64_t x) noexcept {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+struct CounterPosition {
+  std::size_t index;
+  unsigned offset;
+};
+
+CounterPosition GetPosition(std::uint64_t spread, std::size_t row,
+                            std::size_t mask) noexcept {
+  auto h = (spread + kSeeds[row]) * kSeeds[row];
+  h ^= h >> 29;
+  // 16 counters of 4 bits in each word
+  return {static_cast<std::size_t>(h >> 4) & mask,
+          static_cast<unsigned>(h & 15) * 4};
+}
+
+}  // namespace
+
+void FrequencySketch::SetCapacity(std::size_t capacity) {
+  std::size_t size = 1;
+  while (size < capacity) size *= 2;
+
+  table_.assign(size, 0);
+  additions_ = 0;
+  sample_size_ = std::max(capacity, std::size_t{1}) * kSampleSizeFactor;
+}
+
+void FrequencySketch::Increment(std::size_t hash) noexcept {
+  if (table_.empty()) return;
+
+  const auto spread = Spread(hash);
+  const auto mask = table_.size() - 1;
+  bool added = false;
+  for (std::size_t row = 0; row < kDepth; ++row) {
+    const auto [index, offset] = GetPosition(spread, row, mask);
+    if (((table_[index] >> offset) & kCounterMax) != kCounterMax) {
+      table_[index] += std::uint64_t{1} << offset;
+      added = true;
+    }
+  }
+
+  if (added && ++additions_ >= sample_size_) Age();
+}
+
+std::uint32_t FrequencySketch::Estimate(std::size_t hash) const noexcept {
+  if (table_.empty()) return 0;
+
+  const auto spread = Spread(hash);
+  const auto mask = table_.size() - 1;
+  auto result = kCounterMax;
+  for (std::size_t row = 0; row < kDepth; ++row) {
+    const auto [index, offset] = GetPosition(spread, row, mask);
+    result = std::min(result, (table_[index] >> offset) & kCounterMax);
+  }
+  return static_cast<std::uint32_t>(result);
+}
+
+void FrequencySketch::Age() noexcept {
+  for (auto& word : table_) word = (word >> 1) & kAgeMask;
+  additions_ /= 2;
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,32 @@
+#include <userver/cache/impl/frequency_sketch.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(FrequencySketch, Estimate) {
+  cache::impl::FrequencySketch sketch;
+  sketch.Increment(1);
+  EXPECT_EQ(sketch.Estimate(1), 0) << "no capacity";
+
+  sketch.SetCapacity(1000);
+  EXPECT_EQ(sketch.Estimate(1), 0);
+  for (unsigned i = 1; i <= 20; ++i) {
+    sketch.Increment(1);
+    EXPECT_EQ(sketch.Estimate(1), std::min(i, 15u));
+  }
+  EXPECT_EQ(sketch.Estimate(2), 0);
+}
+
+TEST(FrequencySketch, Aging) {
+  cache::impl::FrequencySketch sketch;
+  sketch.SetCapacity(10);
+  for (int i = 0; i < 8; ++i) sketch.Increment(1);
+  EXPECT_EQ(sketch.Estimate(1), 8);
+
+  // the counters are halved after 10 * capacity increments
+  for (std::size_t i = 0; i < 100 - 8; ++i) sketch.Increment(1000 + i);
+  EXPECT_EQ(sketch.Estimate(1), 4);
+}
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,9 @@
 #include <benchmark/benchmark.h>
 
+#include <random>
+#include <vector>
+
+#include <userver/cache/lru_map.hpp>
 #include <userver/cache/lru_set.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -19,6 +23,75 @@ Lru FillLru(unsigned elements_count) {
   return lru;
 }
 
+constexpr std::size_t kTraceCacheSize = 1000;
+constexpr std::size_t kTraceKeysCount = 100'000;
+constexpr std::size_t kTraceSize = 1'000'000;
+
+using Trace = std::vector<unsigned>;
+
+// Zipf distribution with s = 1 over kTraceKeysCount keys
+class ZipfGenerator final {
+ public:
+  ZipfGenerator() {
+    std::vector<double> weights(kTraceKeysCount);
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+      weights[i] = 1.0 / static_cast<double>(i + 1);
+    }
+    distribution_ = {weights.begin(), weights.end()};
+  }
+
+  unsigned operator()() { return distribution_(engine_); }
+
+ private:
+  std::mt19937 engine_{42};
+  std::discrete_distribution<unsigned> distribution_;
+};
+
+Trace MakeZipfTrace() {
+  ZipfGenerator generator;
+  Trace trace(kTraceSize);
+  for (auto& key : trace) key = generator();
+  return trace;
+}
+
+// Zipfian requests interleaved with one-off scans of 5 cache sizes
+Trace MakeScanTrace() {
+  ZipfGenerator generator;
+  Trace trace;
+  trace.reserve(kTraceSize);
+  unsigned next_scan_key = kTraceKeysCount;
+  while (trace.size() < kTraceSize) {
+    for (std::size_t i = 0; i < 10 * kTraceCacheSize; ++i) {
+      trace.push_back(generator());
+    }
+    for (std::size_t i = 0; i < 5 * kTraceCacheSize; ++i) {
+      trace.push_back(next_scan_key++);
+    }
+  }
+  return trace;
+}
+
+void ReplayTrace(benchmark::State& state, const Trace& trace) {
+  const auto policy = static_cast<cache::CachePolicy>(state.range(0));
+  std::size_t hits = 0;
+  std::size_t requests = 0;
+  for (auto _ : state) {
+    cache::LruMap<unsigned, unsigned> lru(kTraceCacheSize, policy);
+    for (const auto key : trace) {
+      if (lru.Get(key)) {
+        ++hits;
+      } else {
+        lru.Put(key, key);
+      }
+    }
+    requests += trace.size();
+    benchmark::DoNotOptimize(lru);
+  }
+  state.SetItemsProcessed(requests);
+  state.counters["hit-rate"] =
+      static_cast<double>(hits) / static_cast<double>(requests ? requests : 1);
+}
+
 }  // namespace
 
 void LruPut(benchmark::State& state) {
@@ -51,4 +124,22 @@ void LruPutOverflow(benchmark::State& state) {
 }
 BENCHMARK(LruPutOverflow);
 
+void LruZipfTrace(benchmark::State& state) {
+  static const auto trace = MakeZipfTrace();
+  ReplayTrace(state, trace);
+}
+BENCHMARK(LruZipfTrace)
+    ->Arg(static_cast<int>(cache::CachePolicy::kLRU))
+    ->Arg(static_cast<int>(cache::CachePolicy::kTinyLFU))
+    ->Unit(benchmark::kMillisecond);
+
+void LruScanTrace(benchmark::State& state) {
+  static const auto trace = MakeScanTrace();
+  ReplayTrace(state, trace);
+}
+BENCHMARK(LruScanTrace)
+    ->Arg(static_cast<int>(cache::CachePolicy::kLRU))
+    ->Arg(static_cast<int>(cache::CachePolicy::kTinyLFU))
+    ->Unit(benchmark::kMillisecond);
+
 USERVER_NAMESPACE_END
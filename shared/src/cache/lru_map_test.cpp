@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <userver/cache/lru_map.hpp>
 
@@ -169,4 +172,111 @@ TEST(Lru, GetLeastUsed) {
   EXPECT_EQ(*cache.GetLeastUsed(), 20);
 }
 
+TEST(Lru, TinyLfuSetGet) {
+  Lru cache(10, cache::CachePolicy::kTinyLFU);
+  EXPECT_EQ(cache.GetPolicy(), cache::CachePolicy::kTinyLFU);
+  EXPECT_EQ(nullptr, cache.Get(1));
+  EXPECT_TRUE(cache.Put(1, 2));
+  EXPECT_EQ(2, cache.GetOr(1, -1));
+  EXPECT_FALSE(cache.Put(1, 3));
+  EXPECT_EQ(3, cache.GetOr(1, -1));
+  cache.Erase(1);
+  EXPECT_EQ(nullptr, cache.Get(1));
+  EXPECT_EQ(cache.GetSize(), 0);
+}
+
+TEST(Lru, TinyLfuOverflow) {
+  Lru cache(10, cache::CachePolicy::kTinyLFU);
+  for (int i = 0; i < 100; ++i) {
+    cache.Put(i, i);
+    EXPECT_EQ(cache.GetSize(), std::min(i + 1, 10));
+  }
+
+  cache.SetMaxSize(3);
+  EXPECT_EQ(cache.GetSize(), 3);
+  cache.SetMaxSize(20);
+  for (int i = 100; i < 200; ++i) cache.Put(i, i);
+  EXPECT_EQ(cache.GetSize(), 20);
+
+  Lru moved = std::move(cache);
+  EXPECT_EQ(moved.GetSize(), 20);
+  moved.Clear();
+  EXPECT_EQ(moved.GetSize(), 0);
+  EXPECT_EQ(moved.GetLeastUsed(), nullptr);
+}
+
+TEST(Lru, TinyLfuScanResistance) {
+  constexpr int kHotCount = 50;
+  const auto count_hot = [](cache::CachePolicy policy) {
+    Lru cache(100, policy);
+    for (int i = 0; i < kHotCount; ++i) cache.Put(i, i);
+    for (int access = 0; access < 5; ++access) {
+      for (int i = 0; i < kHotCount; ++i) cache.Get(i);
+    }
+
+    // one-off scan
+    for (int i = kHotCount; i < 1000; ++i) cache.Put(i, i);
+
+    int hot = 0;
+    cache.VisitAll([&hot](int key, int) { hot += key < kHotCount; });
+    return hot;
+  };
+
+  EXPECT_EQ(count_hot(cache::CachePolicy::kLRU), 0);
+  EXPECT_EQ(count_hot(cache::CachePolicy::kTinyLFU), kHotCount);
+}
+
+TEST(Lru, SizeInBytes) {
+  cache::LruMap<int, std::string> cache(100);
+  const auto empty_size = cache.GetSizeInBytes();
+  EXPECT_GT(empty_size, 0);
+
+  const std::string value(1000, 'x');
+  cache.Put(1, value);
+  const auto node_size = cache.GetSizeInBytes() - empty_size;
+  EXPECT_GT(node_size, value.size());
+
+  cache.Put(2, value);
+  cache.Put(3, value);
+  EXPECT_EQ(cache.GetSizeInBytes(), empty_size + 3 * node_size);
+
+  // the least used ones are evicted
+  cache.Get(1);
+  cache.SetMaxSizeInBytes(empty_size + 2 * node_size);
+  EXPECT_EQ(cache.GetSize(), 2);
+  EXPECT_EQ(cache.Get(2), nullptr);
+
+  cache.Put(4, value);
+  EXPECT_EQ(cache.GetSize(), 2);
+  EXPECT_EQ(cache.Get(3), nullptr);
+
+  // an update that does not fit evicts the rest
+  cache.Put(4, std::string(10000, 'x'));
+  EXPECT_EQ(cache.GetSize(), 1);
+  EXPECT_NE(cache.Get(4), nullptr);
+
+  cache.Erase(4);
+  EXPECT_EQ(cache.GetSizeInBytes(), empty_size);
+
+  cache.SetMaxSizeInBytes(0);
+  for (int i = 0; i < 10; ++i) cache.Put(i, value);
+  EXPECT_EQ(cache.GetSize(), 10);
+  cache.Clear();
+  EXPECT_EQ(cache.GetSizeInBytes(), empty_size);
+}
+
+TEST(Lru, SizeOf) {
+  EXPECT_EQ(cache::SizeOf<int>{}(1), sizeof(int));
+
+  const std::string small = "a";
+  EXPECT_EQ(cache::SizeOf<std::string>{}(small), sizeof(std::string));
+  const std::string large(1000, 'x');
+  EXPECT_GT(cache::SizeOf<std::string>{}(large), sizeof(std::string) + 1000);
+
+  const std::vector<std::string> vector{small, large};
+  EXPECT_EQ(cache::SizeOf<std::vector<std::string>>{}(vector),
+            sizeof(vector) + cache::SizeOf<std::string>{}(small) +
+                cache::SizeOf<std::string>{}(large));
+}
+
 USERVER_NAMESPACE_END
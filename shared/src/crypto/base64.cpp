@@ -1,11 +1,11 @@
 #include <userver/crypto/base64.hpp>
 
-#include <cryptopp/base64.h>
+#include <array>
+#include <cstdint>
+#include <cstring>
 
-#include <userver/crypto/exception.hpp>
-
-#ifdef CRYPTOPP_NO_GLOBAL_BYTE
-using CryptoPP::byte;
+#ifdef __SSSE3__
+#include <tmmintrin.h>
 #endif
 
 USERVER_NAMESPACE_BEGIN
@@ -14,53 +14,244 @@ namespace crypto::base64 {
 
 namespace {
 
-template <typename Base64Encoder>
-std::string Base64Encode(std::string_view data, Pad pad) {
-  std::string response;
-  try {
-    Base64Encoder encoder(new CryptoPP::StringSink(response));
-    CryptoPP::AlgorithmParameters params =
-        CryptoPP::MakeParameters(CryptoPP::Name::Pad(), Pad::kWith == pad)(
-            CryptoPP::Name::InsertLineBreaks(), false);
-    encoder.IsolatedInitialize(params);
-    encoder.PutMessageEnd(reinterpret_cast<const byte*>(data.data()),
-                          data.size());
-  } catch (const CryptoPP::Exception& exc) {
-    throw crypto::CryptoException(exc.what());
+struct Alphabet {
+  std::string_view chars;
+  // Characters of the alphabet that are not letters or digits
+  char index62;
+  char index63;
+};
+
+constexpr Alphabet kStandard{
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/", '+',
+    '/'};
+constexpr Alphabet kUrl{
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_", '-',
+    '_'};
+
+constexpr std::uint8_t kInvalid = 0xff;
+
+using DecodingTable = std::array<std::uint8_t, 256>;
+
+constexpr DecodingTable MakeDecodingTable(const Alphabet& alphabet) {
+  DecodingTable table{};
+  for (auto& value : table) value = kInvalid;
+  for (std::size_t i = 0; i < alphabet.chars.size(); ++i) {
+    table[static_cast<unsigned char>(alphabet.chars[i])] = i;
   }
-  return response;
+  return table;
 }
 
-template <typename Base64Decoder>
-std::string Base64Decode(std::string_view data) {
-  std::string response;
-  try {
-    Base64Decoder decoder(new CryptoPP::StringSink(response));
-    decoder.PutMessageEnd(reinterpret_cast<const byte*>(data.data()),
-                          data.size());
-  } catch (const CryptoPP::Exception& exc) {
-    throw crypto::CryptoException(exc.what());
+constexpr DecodingTable kStandardDecodingTable = MakeDecodingTable(kStandard);
+constexpr DecodingTable kUrlDecodingTable = MakeDecodingTable(kUrl);
+
+#ifdef __SSSE3__
+// Encodes 12 bytes into 16 characters, reads 16 bytes of input.
+// See http://0x80.pl/notesen/2016-01-12-sse-base64-encoding.html
+__m128i EncodeBlock(__m128i input, const Alphabet& alphabet) {
+  // 3 input bytes per 32-bit lane, in the order that keeps the sextets within
+  // the 16-bit halves of the lane
+  input = _mm_shuffle_epi8(
+      input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+  // move each of the 4 sextets to its own byte
+  const auto t0 = _mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00));
+  const auto t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const auto t2 = _mm_and_si128(input, _mm_set1_epi32(0x003f03f0));
+  const auto t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  const auto indices = _mm_or_si128(t1, t3);
+
+  // the offset of the character from its sextet depends on the range of the
+  // sextet: A-Z, a-z, 0-9, 62 or 63
+  auto ranges = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const auto is_upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  ranges = _mm_or_si128(ranges, _mm_and_si128(is_upper, _mm_set1_epi8(13)));
+  const auto offsets = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, alphabet.index62 - 62,
+      alphabet.index63 - 63, 'A', 0, 0);
+  return _mm_add_epi8(_mm_shuffle_epi8(offsets, ranges), indices);
+}
+
+__m128i InRange(__m128i chars, char first, char last) {
+  return _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8(first - 1)),
+                       _mm_cmplt_epi8(chars, _mm_set1_epi8(last + 1)));
+}
+
+// Decodes 16 characters into 12 bytes, returns false if any of the characters
+// is out of the alphabet
+bool DecodeBlock(const char* input, char* output, const Alphabet& alphabet) {
+  const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+
+  const auto is_upper = InRange(chars, 'A', 'Z');
+  const auto is_lower = InRange(chars, 'a', 'z');
+  const auto is_digit = InRange(chars, '0', '9');
+  const auto is_62 = _mm_cmpeq_epi8(chars, _mm_set1_epi8(alphabet.index62));
+  const auto is_63 = _mm_cmpeq_epi8(chars, _mm_set1_epi8(alphabet.index63));
+  const auto is_letter = _mm_or_si128(is_upper, is_lower);
+  const auto is_other = _mm_or_si128(is_62, is_63);
+  const auto is_valid =
+      _mm_or_si128(_mm_or_si128(is_letter, is_digit), is_other);
+  if (_mm_movemask_epi8(is_valid) != 0xffff) return false;
+
+  auto sextets =
+      _mm_and_si128(is_upper, _mm_sub_epi8(chars, _mm_set1_epi8('A')));
+  sextets = _mm_or_si128(
+      sextets,
+      _mm_and_si128(is_lower, _mm_sub_epi8(chars, _mm_set1_epi8('a' - 26))));
+  sextets = _mm_or_si128(
+      sextets,
+      _mm_and_si128(is_digit, _mm_add_epi8(chars, _mm_set1_epi8(52 - '0'))));
+  sextets = _mm_or_si128(sextets, _mm_and_si128(is_62, _mm_set1_epi8(62)));
+  sextets = _mm_or_si128(sextets, _mm_and_si128(is_63, _mm_set1_epi8(63)));
+
+  // pack 4 sextets of each 32-bit lane into 3 bytes in the big endian order
+  const auto pairs = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+  const auto triples = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+  const auto bytes = _mm_shuffle_epi8(
+      triples,
+      _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+  alignas(16) std::array<char, 16> buffer;
+  _mm_store_si128(reinterpret_cast<__m128i*>(buffer.data()), bytes);
+  std::memcpy(output, buffer.data(), 12);
+  return true;
+}
+#endif
+
+std::size_t Encode(std::string_view data, char* out, Pad pad,
+                   const Alphabet& alphabet) noexcept {
+  const auto* input = reinterpret_cast<const unsigned char*>(data.data());
+  auto size = data.size();
+  char* output = out;
+
+#ifdef __SSSE3__
+  // the block reads 16 bytes but consumes only 12 of them
+  for (; size >= 16; input += 12, size -= 12, output += 16) {
+    const auto chars = EncodeBlock(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input)), alphabet);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output), chars);
+  }
+#endif
+
+  const auto& chars = alphabet.chars;
+  for (; size >= 3; input += 3, size -= 3) {
+    const std::uint32_t triple = (input[0] << 16) | (input[1] << 8) | input[2];
+    *output++ = chars[triple >> 18];
+    *output++ = chars[(triple >> 12) & 0x3f];
+    *output++ = chars[(triple >> 6) & 0x3f];
+    *output++ = chars[triple & 0x3f];
+  }
+
+  if (size == 1) {
+    *output++ = chars[input[0] >> 2];
+    *output++ = chars[(input[0] & 0x3) << 4];
+    if (pad == Pad::kWith) {
+      *output++ = '=';
+      *output++ = '=';
+    }
+  } else if (size == 2) {
+    *output++ = chars[input[0] >> 2];
+    *output++ = chars[((input[0] & 0x3) << 4) | (input[1] >> 4)];
+    *output++ = chars[(input[1] & 0xf) << 2];
+    if (pad == Pad::kWith) *output++ = '=';
   }
+  return output - out;
+}
+
+// Skips the characters out of the alphabet, including the padding, the same
+// way the CryptoPP decoders did
+std::size_t Decode(std::string_view data, char* out, const Alphabet& alphabet,
+                   const DecodingTable& table) noexcept {
+  const char* input = data.data();
+  const char* const end = input + data.size();
+  char* output = out;
+
+  std::uint32_t accumulator = 0;
+  int sextets = 0;
+  while (input != end) {
+#ifdef __SSSE3__
+    if (sextets == 0 && end - input >= 16 &&
+        DecodeBlock(input, output, alphabet)) {
+      input += 16;
+      output += 12;
+      continue;
+    }
+#else
+    static_cast<void>(alphabet);
+#endif
+
+    const auto value = table[static_cast<unsigned char>(*input++)];
+    if (value == kInvalid) continue;
+
+    accumulator = (accumulator << 6) | value;
+    if (++sextets == 4) {
+      *output++ = static_cast<char>(accumulator >> 16);
+      *output++ = static_cast<char>(accumulator >> 8);
+      *output++ = static_cast<char>(accumulator);
+      accumulator = 0;
+      sextets = 0;
+    }
+  }
+
+  // a single trailing sextet does not make a byte
+  if (sextets == 2) {
+    *output++ = static_cast<char>(accumulator >> 4);
+  } else if (sextets == 3) {
+    *output++ = static_cast<char>(accumulator >> 10);
+    *output++ = static_cast<char>(accumulator >> 2);
+  }
+  return output - out;
+}
+
+std::string EncodeToString(std::string_view data, Pad pad,
+                           const Alphabet& alphabet) {
+  std::string response(Base64EncodedSize(data.size(), pad), '\0');
+  Encode(data, response.data(), pad, alphabet);
+  return response;
+}
+
+std::string DecodeToString(std::string_view data, const Alphabet& alphabet,
+                           const DecodingTable& table) {
+  std::string response(Base64DecodedSizeUpperBound(data.size()), '\0');
+  response.resize(Decode(data, response.data(), alphabet, table));
   return response;
 }
 
 }  // namespace
 
 std::string Base64Encode(std::string_view data, Pad pad) {
-  return Base64Encode<CryptoPP::Base64Encoder>(data, pad);
+  return EncodeToString(data, pad, kStandard);
 }
 
 std::string Base64Decode(std::string_view data) {
-  return Base64Decode<CryptoPP::Base64Decoder>(data);
+  return DecodeToString(data, kStandard, kStandardDecodingTable);
+}
+
+std::size_t Base64EncodeInto(std::string_view data, char* out,
+                             Pad pad) noexcept {
+  return Encode(data, out, pad, kStandard);
+}
+
+std::size_t Base64DecodeInto(std::string_view data, char* out) noexcept {
+  return Decode(data, out, kStandard, kStandardDecodingTable);
 }
 
 #ifndef USERVER_NO_CRYPTOPP_BASE64_URL
 std::string Base64UrlEncode(std::string_view data, Pad pad) {
-  return Base64Encode<CryptoPP::Base64URLEncoder>(data, pad);
+  return EncodeToString(data, pad, kUrl);
 }
 
 std::string Base64UrlDecode(std::string_view data) {
-  return Base64Decode<CryptoPP::Base64URLDecoder>(data);
+  return DecodeToString(data, kUrl, kUrlDecodingTable);
+}
+
+std::size_t Base64UrlEncodeInto(std::string_view data, char* out,
+                                Pad pad) noexcept {
+  return Encode(data, out, pad, kUrl);
+}
+
+std::size_t Base64UrlDecodeInto(std::string_view data, char* out) noexcept {
+  return Decode(data, out, kUrl, kUrlDecodingTable);
 }
 #endif
 
@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <userver/crypto/base64.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string GenerateSource(std::size_t size) {
+  std::string source;
+  source.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    source.push_back(static_cast<char>(i * 7));
+  }
+  return source;
+}
+
+}  // namespace
+
+void base64_encode(benchmark::State& state) {
+  const auto source = GenerateSource(state.range(0));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(crypto::base64::Base64Encode(source));
+  }
+  state.SetBytesProcessed(state.iterations() * source.size());
+}
+BENCHMARK(base64_encode)->RangeMultiplier(16)->Range(16, 4 << 20);
+
+void base64_encode_into(benchmark::State& state) {
+  const auto source = GenerateSource(state.range(0));
+  std::string out(crypto::base64::Base64EncodedSize(source.size()), '\0');
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        crypto::base64::Base64EncodeInto(source, out.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * source.size());
+}
+BENCHMARK(base64_encode_into)->RangeMultiplier(16)->Range(16, 4 << 20);
+
+void base64_decode(benchmark::State& state) {
+  const auto encoded =
+      crypto::base64::Base64Encode(GenerateSource(state.range(0)));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(crypto::base64::Base64Decode(encoded));
+  }
+  state.SetBytesProcessed(state.iterations() * encoded.size());
+}
+BENCHMARK(base64_decode)->RangeMultiplier(16)->Range(16, 4 << 20);
+
+void base64_decode_into(benchmark::State& state) {
+  const auto encoded =
+      crypto::base64::Base64Encode(GenerateSource(state.range(0)));
+  std::string out(crypto::base64::Base64DecodedSizeUpperBound(encoded.size()),
+                  '\0');
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        crypto::base64::Base64DecodeInto(encoded, out.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * encoded.size());
+}
+BENCHMARK(base64_decode_into)->RangeMultiplier(16)->Range(16, 4 << 20);
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <string>
+#include <string_view>
+
 #include <userver/crypto/base64.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -17,6 +20,40 @@ TEST(Crypto, Base64) {
   EXPECT_EQ("U/8=", crypto::base64::Base64Encode("S\xff"));
 }
 
+TEST(Crypto, Base64Long) {
+  // long enough for the vectorized blocks
+  std::string data;
+  for (int i = 0; i < 256; ++i) data.push_back(static_cast<char>(i));
+  const auto encoded = crypto::base64::Base64Encode(data);
+  EXPECT_EQ(crypto::base64::Base64EncodedSize(data.size()), encoded.size());
+  EXPECT_EQ("AAECAwQFBgcICQoLDA0ODxAREhMUFRYXGBkaGxwdHh8gISIjJCUmJygpKissLS4v",
+            encoded.substr(0, 64));
+  EXPECT_EQ("/P3+/w==", encoded.substr(encoded.size() - 8));
+  EXPECT_EQ(data, crypto::base64::Base64Decode(encoded));
+
+  // the characters out of the alphabet are skipped
+  std::string with_line_breaks = encoded;
+  with_line_breaks.insert(76, "\r\n");
+  with_line_breaks.insert(20, " ");
+  EXPECT_EQ(data, crypto::base64::Base64Decode(with_line_breaks));
+}
+
+TEST(Crypto, Base64IntoBuffer) {
+  constexpr std::string_view kData = "some longer test data";
+  std::string encoded(crypto::base64::Base64EncodedSize(
+                          kData.size(), crypto::base64::Pad::kWithout),
+                      '\0');
+  EXPECT_EQ(encoded.size(),
+            crypto::base64::Base64EncodeInto(kData, encoded.data(),
+                                             crypto::base64::Pad::kWithout));
+  EXPECT_EQ("c29tZSBsb25nZXIgdGVzdCBkYXRh", encoded);
+
+  std::string decoded(
+      crypto::base64::Base64DecodedSizeUpperBound(encoded.size()), '\0');
+  decoded.resize(crypto::base64::Base64DecodeInto(encoded, decoded.data()));
+  EXPECT_EQ(kData, decoded);
+}
+
 #ifndef USERVER_NO_CRYPTOPP_BASE64_URL
 TEST(Crypto, Base64Url) {
   EXPECT_EQ("U_8=", crypto::base64::Base64UrlEncode("S\xff"));
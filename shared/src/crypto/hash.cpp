@@ -1,17 +1,19 @@
 #include <userver/crypto/hash.hpp>
 
 #include <array>
+#include <memory>
+#include <string>
+#include <utility>
 
-#include <cryptopp/base64.h>
 #ifndef USERVER_NO_CRYPTOPP_BLAKE2
 #include <cryptopp/blake2.h>
 #endif
-#include <cryptopp/filters.h>
-#include <cryptopp/hex.h>
 #include <cryptopp/hmac.h>
 #include <cryptopp/sha.h>
 
+#include <userver/crypto/base64.hpp>
 #include <userver/crypto/exception.hpp>
+#include <userver/utils/assert.hpp>
 
 #include <cryptopp/md5.h>
 
@@ -41,42 +43,40 @@ std::string EncodeArray(const byte* ptr, size_t length,
       break;
     }
     case crypto::hash::OutputEncoding::kBase16: {
-      CryptoPP::HexEncoder encoder(new CryptoPP::StringSink(response), false);
-      encoder.PutMessageEnd(ptr, length);
+      // Avoids the allocations of the CryptoPP filters chain
+      static constexpr char kDigits[] = "0123456789abcdef";
+      response.resize(length * 2);
+      for (size_t i = 0; i < length; ++i) {
+        response[2 * i] = kDigits[ptr[i] >> 4];
+        response[2 * i + 1] = kDigits[ptr[i] & 0xf];
+      }
       break;
     }
     case crypto::hash::OutputEncoding::kBase64: {
-      CryptoPP::Base64Encoder encoder(new CryptoPP::StringSink(response),
-                                      false);
-      encoder.PutMessageEnd(ptr, length);
+      response.resize(crypto::base64::Base64EncodedSize(length));
+      crypto::base64::Base64EncodeInto(
+          {reinterpret_cast<const char*>(ptr), length}, response.data());
       break;
     }
   }
   return response;
 }
 
-std::string EncodeString(std::string_view data,
-                         crypto::hash::OutputEncoding encoding) {
-  return EncodeArray(reinterpret_cast<const byte*>(data.data()), data.size(),
-                     encoding);
-}
-
 template <typename HashAlgorithm>
 std::string CalculateHmac(std::string_view key, std::string_view data,
                           crypto::hash::OutputEncoding encoding) {
-  std::string mac;
-
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init): performance
+  std::array<byte, HashAlgorithm::DIGESTSIZE> mac;
   try {
     CryptoPP::HMAC<HashAlgorithm> hmac(
         reinterpret_cast<const byte*>(key.data()), key.size());
-    CryptoPP::StringSource ss_key(
-        reinterpret_cast<const byte*>(data.data()), data.size(), true,
-        new CryptoPP::HashFilter(hmac, new CryptoPP::StringSink(mac)));
+    hmac.CalculateDigest(mac.data(), reinterpret_cast<const byte*>(data.data()),
+                         data.size());
   } catch (const CryptoPP::Exception& exc) {
     throw crypto::CryptoException(exc.what());
   }
 
-  return EncodeString(mac, encoding);
+  return EncodeArray(mac.data(), mac.size(), encoding);
 }
 
 template <typename HashAlgorithm>
@@ -95,6 +95,107 @@ std::string CalculateHash(std::string_view data,
   return EncodeArray(digest.data(), digest.size(), encoding);
 }
 
+// SHA-512 has the largest digest
+constexpr size_t kMaxDigestSize = CryptoPP::SHA512::DIGESTSIZE;
+
+using Transformation = std::unique_ptr<CryptoPP::HashTransformation>;
+
+Transformation MakeHash(crypto::hash::Algorithm algorithm) {
+  using crypto::hash::Algorithm;
+  switch (algorithm) {
+    case Algorithm::kSha1:
+      return std::make_unique<CryptoPP::SHA1>();
+    case Algorithm::kSha224:
+      return std::make_unique<CryptoPP::SHA224>();
+    case Algorithm::kSha256:
+      return std::make_unique<CryptoPP::SHA256>();
+    case Algorithm::kSha384:
+      return std::make_unique<CryptoPP::SHA384>();
+    case Algorithm::kSha512:
+      return std::make_unique<CryptoPP::SHA512>();
+#ifndef USERVER_NO_CRYPTOPP_BLAKE2
+    case Algorithm::kBlake2b128:
+      return std::make_unique<AlgoBlake2b128>();
+#endif
+  }
+  throw crypto::CryptoException("Unknown hash algorithm");
+}
+
+template <typename HashAlgorithm>
+Transformation MakeHmac(std::string_view key) {
+  return std::make_unique<CryptoPP::HMAC<HashAlgorithm>>(
+      reinterpret_cast<const byte*>(key.data()), key.size());
+}
+
+Transformation MakeHmac(crypto::hash::Algorithm algorithm,
+                        std::string_view key) {
+  using crypto::hash::Algorithm;
+  switch (algorithm) {
+    case Algorithm::kSha1:
+      return MakeHmac<CryptoPP::SHA1>(key);
+    case Algorithm::kSha224:
+      return MakeHmac<CryptoPP::SHA224>(key);
+    case Algorithm::kSha256:
+      return MakeHmac<CryptoPP::SHA256>(key);
+    case Algorithm::kSha384:
+      return MakeHmac<CryptoPP::SHA384>(key);
+    case Algorithm::kSha512:
+      return MakeHmac<CryptoPP::SHA512>(key);
+#ifndef USERVER_NO_CRYPTOPP_BLAKE2
+    case Algorithm::kBlake2b128:
+      // Blake2b is a keyed hash on its own
+      throw crypto::CryptoException("HMAC is not supported for Blake2b-128");
+#endif
+  }
+  throw crypto::CryptoException("Unknown hash algorithm");
+}
+
+template <typename MakeFunc>
+Transformation MakeTransformation(MakeFunc make_func) {
+  try {
+    return make_func();
+  } catch (const CryptoPP::Exception& exc) {
+    throw crypto::CryptoException(exc.what());
+  }
+}
+
+void UpdateTransformation(CryptoPP::HashTransformation& hash,
+                          std::string_view data) {
+  try {
+    hash.Update(reinterpret_cast<const byte*>(data.data()), data.size());
+  } catch (const CryptoPP::Exception& exc) {
+    throw crypto::CryptoException(exc.what());
+  }
+}
+
+// Final() restarts the transformation for the next message
+size_t FinalizeTransformation(CryptoPP::HashTransformation& hash,
+                              byte* output, size_t size) {
+  const size_t digest_size = hash.DigestSize();
+  if (size < digest_size) {
+    throw crypto::CryptoException("Output buffer of " + std::to_string(size) +
+                                  " bytes is too small for " +
+                                  std::to_string(digest_size) +
+                                  " bytes digest");
+  }
+  try {
+    hash.Final(output);
+  } catch (const CryptoPP::Exception& exc) {
+    throw crypto::CryptoException(exc.what());
+  }
+  return digest_size;
+}
+
+std::string FinalizeTransformation(CryptoPP::HashTransformation& hash,
+                                   crypto::hash::OutputEncoding encoding) {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init): performance
+  std::array<byte, kMaxDigestSize> digest;
+  UASSERT(hash.DigestSize() <= digest.size());
+  const auto digest_size =
+      FinalizeTransformation(hash, digest.data(), digest.size());
+  return EncodeArray(digest.data(), digest_size, encoding);
+}
+
 }  // namespace
 
 namespace crypto::hash {
@@ -145,6 +246,70 @@ std::string HmacSha1(std::string_view key, std::string_view message,
   return CalculateHmac<CryptoPP::SHA1>(key, message, encoding);
 }
 
+class Hasher::Impl final {
+ public:
+  explicit Impl(Transformation&& hash) : hash(std::move(hash)) {}
+
+  const Transformation hash;
+};
+
+Hasher::Hasher(Algorithm algorithm)
+    : impl_(std::make_unique<Impl>(
+          MakeTransformation([algorithm] { return MakeHash(algorithm); }))) {}
+
+Hasher::~Hasher() = default;
+
+Hasher::Hasher(Hasher&&) noexcept = default;
+
+Hasher& Hasher::operator=(Hasher&&) noexcept = default;
+
+void Hasher::Update(std::string_view data) {
+  UpdateTransformation(*impl_->hash, data);
+}
+
+std::size_t Hasher::GetDigestSize() const { return impl_->hash->DigestSize(); }
+
+std::size_t Hasher::Finalize(char* output, std::size_t size) {
+  return FinalizeTransformation(*impl_->hash, reinterpret_cast<byte*>(output),
+                                size);
+}
+
+std::string Hasher::Finalize(OutputEncoding encoding) {
+  return FinalizeTransformation(*impl_->hash, encoding);
+}
+
+class Hmac::Impl final {
+ public:
+  explicit Impl(Transformation&& hmac) : hmac(std::move(hmac)) {}
+
+  const Transformation hmac;
+};
+
+Hmac::Hmac(Algorithm algorithm, std::string_view key)
+    : impl_(std::make_unique<Impl>(MakeTransformation(
+          [algorithm, key] { return MakeHmac(algorithm, key); }))) {}
+
+Hmac::~Hmac() = default;
+
+Hmac::Hmac(Hmac&&) noexcept = default;
+
+Hmac& Hmac::operator=(Hmac&&) noexcept = default;
+
+void Hmac::Update(std::string_view data) {
+  UpdateTransformation(*impl_->hmac, data);
+}
+
+std::size_t Hmac::GetDigestSize() const { return impl_->hmac->DigestSize(); }
+
+std::size_t Hmac::Finalize(char* output, std::size_t size) {
+  return FinalizeTransformation(*impl_->hmac, reinterpret_cast<byte*>(output),
+                                size);
+}
+
+std::string Hmac::Finalize(OutputEncoding encoding) {
+  return FinalizeTransformation(*impl_->hmac, encoding);
+}
+
 namespace weak {
 
 std::string Md5(std::string_view data, OutputEncoding encoding) {
@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+#include <userver/crypto/hash.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kChunkSize = 4096;
+
+std::vector<std::string> MakeChunks(std::size_t size) {
+  std::vector<std::string> chunks;
+  for (std::size_t offset = 0; offset < size; offset += kChunkSize) {
+    chunks.emplace_back(std::min(kChunkSize, size - offset), 'a');
+  }
+  return chunks;
+}
+
+}  // namespace
+
+void sha256_contiguous(benchmark::State& state) {
+  const auto chunks = MakeChunks(state.range(0));
+  for (auto _ : state) {
+    // the whole message has to be gathered first
+    std::string message;
+    for (const auto& chunk : chunks) message += chunk;
+    auto digest = crypto::hash::Sha256(message);
+    benchmark::DoNotOptimize(digest);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(sha256_contiguous)->RangeMultiplier(16)->Range(64, 4 * 1024 * 1024);
+
+void sha256_streaming(benchmark::State& state) {
+  const auto chunks = MakeChunks(state.range(0));
+  crypto::hash::Hasher hasher{crypto::hash::Algorithm::kSha256};
+  std::array<char, 32> digest{};
+  for (auto _ : state) {
+    for (const auto& chunk : chunks) hasher.Update(chunk);
+    benchmark::DoNotOptimize(hasher.Finalize(digest.data(), digest.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(sha256_streaming)->RangeMultiplier(16)->Range(64, 4 * 1024 * 1024);
+
+void hmac_sha256_oneshot(benchmark::State& state) {
+  const std::string message(state.range(0), 'a');
+  for (auto _ : state) {
+    auto mac = crypto::hash::HmacSha256("secret", message);
+    benchmark::DoNotOptimize(mac);
+  }
+}
+BENCHMARK(hmac_sha256_oneshot)->Range(64, 4096);
+
+void hmac_sha256_reused(benchmark::State& state) {
+  const std::string message(state.range(0), 'a');
+  crypto::hash::Hmac hmac{crypto::hash::Algorithm::kSha256, "secret"};
+  for (auto _ : state) {
+    hmac.Update(message);
+    auto mac = hmac.Finalize();
+    benchmark::DoNotOptimize(mac);
+  }
+}
+BENCHMARK(hmac_sha256_reused)->Range(64, 4096);
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <array>
+#include <string_view>
+
+#include <userver/crypto/exception.hpp>
 #include <userver/crypto/hash.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -94,6 +98,49 @@ TEST(Crypto, Hmac) {
                                crypto::hash::OutputEncoding::kHex));
 }
 
+TEST(Crypto, StreamingHash) {
+  /// [Streaming hash]
+  crypto::hash::Hasher hasher{crypto::hash::Algorithm::kSha256};
+  hasher.Update("te");
+  hasher.Update("st");
+  EXPECT_EQ("9f86d081884c7d659a2feaa0c55ad015a3bf4f1b2b0b822cd15d6c15b0f00a08",
+            hasher.Finalize());
+  /// [Streaming hash]
+
+  // The hasher starts a new message after Finalize()
+  hasher.Update("test\n");
+  std::array<char, 32> digest{};
+  ASSERT_EQ(digest.size(), hasher.GetDigestSize());
+  ASSERT_EQ(digest.size(), hasher.Finalize(digest.data(), digest.size()));
+  EXPECT_EQ(
+      crypto::hash::Sha256("test\n", crypto::hash::OutputEncoding::kBinary),
+      std::string_view(digest.data(), digest.size()));
+
+  EXPECT_EQ(crypto::hash::Sha256({}), hasher.Finalize());
+  EXPECT_THROW(hasher.Finalize(digest.data(), digest.size() - 1),
+               crypto::CryptoException);
+
+  crypto::hash::Hasher sha1{crypto::hash::Algorithm::kSha1};
+  sha1.Update("test");
+  EXPECT_EQ(crypto::hash::Sha1("test", crypto::hash::OutputEncoding::kBase64),
+            sha1.Finalize(crypto::hash::OutputEncoding::kBase64));
+}
+
+TEST(Crypto, StreamingHmac) {
+  crypto::hash::Hmac hmac{crypto::hash::Algorithm::kSha512, "test"};
+  hmac.Update("te");
+  hmac.Update("");
+  hmac.Update("st");
+  EXPECT_EQ(crypto::hash::HmacSha512("test", "test"), hmac.Finalize());
+
+  // The key is kept for the next message
+  hmac.Update("other");
+  EXPECT_EQ(crypto::hash::HmacSha512("test", "other"), hmac.Finalize());
+
+  crypto::hash::Hmac hmac384{crypto::hash::Algorithm::kSha384, "secret"};
+  EXPECT_EQ(crypto::hash::HmacSha384("secret", ""), hmac384.Finalize());
+}
+
 #ifndef USERVER_NO_CRYPTOPP_BLAKE2
 TEST(Crypto, Blake2b128) {
   EXPECT_EQ("e9a804b2e527fd3601d2ffc0bb023cd6",
@@ -101,6 +148,11 @@ TEST(Crypto, Blake2b128) {
                                      crypto::hash::OutputEncoding::kHex));
   EXPECT_EQ("cae66941d9efbd404e4d88758ea67670",
             crypto::hash::Blake2b128("", crypto::hash::OutputEncoding::kHex));
+
+  crypto::hash::Hasher hasher{crypto::hash::Algorithm::kBlake2b128};
+  hasher.Update("hello ");
+  hasher.Update("world");
+  EXPECT_EQ("e9a804b2e527fd3601d2ffc0bb023cd6", hasher.Finalize());
 }
 #endif
 
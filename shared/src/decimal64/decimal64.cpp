@@ -1,7 +1,9 @@
 #include <userver/decimal64/decimal64.hpp>
 
+#include <cstring>
 #include <string_view>
 
+#include <boost/endian/conversion.hpp>
 #include <fmt/format.h>
 
 USERVER_NAMESPACE_BEGIN
@@ -41,6 +43,54 @@ std::string_view ErrorDescription(ParseErrorCode error_code) {
   UINVARIANT(false, "Unexpected decimal64 error code");
 }
 
+// Converts `value` < 10^8 to 8 ASCII digits, the first digit in the lowest
+// byte, with the SWAR technique by Paul Khuong
+uint64_t EncodeEightDigits(uint32_t value) noexcept {
+  const uint64_t merged = (value / 10000) | (uint64_t{value % 10000} << 32);
+  const uint64_t top = ((merged * 10486) >> 20) & ((0x7fULL << 32) | 0x7fULL);
+  const uint64_t bottom = merged - 100 * top;
+  const uint64_t hundreds = (bottom << 16) + top;
+  uint64_t tens = (hundreds * 103) >> 10;
+  tens &= (0xfULL << 48) | (0xfULL << 32) | (0xfULL << 16) | 0xfULL;
+  tens += (hundreds - 10 * tens) << 8;
+  return tens + 0x3030303030303030;
+}
+
+// Writes 8 chars, the first char from the lowest byte
+void StoreEightChars(char* out, uint64_t chars) noexcept {
+  chars = boost::endian::native_to_little(chars);
+  std::memcpy(out, &chars, sizeof(chars));
+}
+
+// Writes exactly `width` last digits of `value` < 10^19, zero-padded. Writes
+// up to 7 more chars past them.
+void WriteFixedDigits(char* out, uint64_t value, int width) noexcept {
+  UASSERT(width > 0 && width <= kMaxDecimalDigits + 1);
+  const uint32_t chunks[] = {
+      static_cast<uint32_t>(value % kPow10<8>),
+      static_cast<uint32_t>(value / kPow10<8> % kPow10<8>),
+      static_cast<uint32_t>(value / kPow10<16>),
+  };
+  int chunk = (width - 1) / 8;
+  const int head_width = width - chunk * 8;
+  StoreEightChars(out, EncodeEightDigits(chunks[chunk]) >>
+                           ((8 - head_width) * 8));
+  out += head_width;
+  while (chunk-- > 0) {
+    StoreEightChars(out, EncodeEightDigits(chunks[chunk]));
+    out += 8;
+  }
+}
+
+int CountDigits(uint64_t value) noexcept {
+  // an estimate by the bit width, see "Bit Twiddling Hacks"
+  const int estimate = (64 - __builtin_clzll(value | 1)) * 1233 >> 12;
+  // all the 64-bit wide values up to 2^63 have 19 digits
+  if (estimate == kMaxDecimalDigits + 1) return estimate;
+  return estimate +
+         ((value | 1) >= static_cast<uint64_t>(kPowSeries10[estimate]));
+}
+
 }  // namespace
 
 std::string GetErrorMessage(std::string_view source, std::string_view path,
@@ -78,6 +128,31 @@ void TrimTrailingZeros(int64_t& after, int& after_precision) {
   }
 }
 
+std::size_t WriteDecimal(char* out, int64_t before, int64_t after,
+                         int precision, bool trim_trailing_zeros) noexcept {
+  UASSERT(precision >= 0 && precision <= kMaxDecimalDigits);
+  char* const begin = out;
+  // the negation is safe for uint64_t, even for kMinInt64
+  auto abs_before = static_cast<uint64_t>(before);
+  if (before < 0 || after < 0) {
+    *out++ = '-';
+    abs_before = -abs_before;
+    after = -after;
+  }
+
+  const auto before_digits = CountDigits(abs_before);
+  WriteFixedDigits(out, abs_before, before_digits);
+  out += before_digits;
+
+  if (trim_trailing_zeros) TrimTrailingZeros(after, precision);
+  if (precision > 0) {
+    *out++ = '.';
+    WriteFixedDigits(out, after, precision);
+    out += precision;
+  }
+  return out - begin;
+}
+
 std::string ToString(int64_t before, int64_t after, int precision,
                      const FormatOptions& format_options) {
   if (!format_options.is_fixed) {
@@ -0,0 +1,95 @@
+#include <userver/decimal64/decimal64.hpp>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Dec4 = decimal64::Decimal<4>;
+
+constexpr std::size_t kValuesCount = 1024;
+
+// Amounts of money from cents to millions, all digit counts are mixed
+std::vector<Dec4> MakeDecimals() {
+  std::mt19937_64 generator{42};
+  std::vector<Dec4> result;
+  result.reserve(kValuesCount);
+  for (std::size_t i = 0; i < kValuesCount; ++i) {
+    const auto digits = 1 + generator() % 12;
+    const auto value = static_cast<std::int64_t>(
+        generator() % decimal64::impl::kPowSeries10[digits]);
+    result.push_back(Dec4::FromUnbiased(i % 2 ? value : -value));
+  }
+  return result;
+}
+
+std::vector<std::string> MakeStrings() {
+  std::vector<std::string> result;
+  result.reserve(kValuesCount);
+  for (const auto& dec : MakeDecimals()) {
+    result.push_back(decimal64::ToStringTrailingZeros(dec));
+  }
+  return result;
+}
+
+void Decimal64Parse(benchmark::State& state) {
+  const auto strings = MakeStrings();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Dec4{strings[i++ % kValuesCount]});
+  }
+}
+BENCHMARK(Decimal64Parse);
+
+void Decimal64ParsePermissive(benchmark::State& state) {
+  const auto strings = MakeStrings();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        Dec4::FromStringPermissive(strings[i++ % kValuesCount]));
+  }
+}
+BENCHMARK(Decimal64ParsePermissive);
+
+void Decimal64ToString(benchmark::State& state) {
+  const auto decimals = MakeDecimals();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(decimal64::ToString(decimals[i++ % kValuesCount]));
+  }
+}
+BENCHMARK(Decimal64ToString);
+
+void Decimal64ToStringTrailingZeros(benchmark::State& state) {
+  const auto decimals = MakeDecimals();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        decimal64::ToStringTrailingZeros(decimals[i++ % kValuesCount]));
+  }
+}
+BENCHMARK(Decimal64ToStringTrailingZeros);
+
+void Decimal64Format(benchmark::State& state) {
+  const auto decimals = MakeDecimals();
+  fmt::memory_buffer buffer;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    buffer.clear();
+    fmt::format_to(std::back_inserter(buffer), "{}",
+                   decimals[i++ % kValuesCount]);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+}
+BENCHMARK(Decimal64Format);
+
+}  // namespace
+
+USERVER_NAMESPACE_END
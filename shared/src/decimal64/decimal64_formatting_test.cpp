@@ -1,5 +1,7 @@
 #include <userver/decimal64/decimal64.hpp>
 
+#include <limits>
+#include <random>
 #include <sstream>
 
 #include <gtest/gtest.h>
@@ -178,4 +180,32 @@ TEST(Decimal64, ToStream) {
   EXPECT_EQ(os.str(), "12.3");
 }
 
+TEST(Decimal64, ToStringDigitBlocks) {
+  using Dec0 = decimal64::Decimal<0>;
+  using Dec18 = decimal64::Decimal<18>;
+  constexpr auto kMax = std::numeric_limits<int64_t>::max();
+  constexpr auto kMin = std::numeric_limits<int64_t>::min();
+
+  EXPECT_EQ(ToString(Dec0::FromUnbiased(kMax)), "9223372036854775807");
+  EXPECT_EQ(ToString(Dec0::FromUnbiased(kMin)), "-9223372036854775808");
+  EXPECT_EQ(ToString(Dec4::FromUnbiased(kMin)), "-922337203685477.5808");
+  EXPECT_EQ(ToString(Dec18::FromUnbiased(kMax)), "9.223372036854775807");
+  EXPECT_EQ(ToString(Dec18::FromUnbiased(-1)), "-0.000000000000000001");
+  EXPECT_EQ(ToStringTrailingZeros(Dec18{"-0.1"}), "-0.100000000000000000");
+  EXPECT_EQ(ToStringTrailingZeros(Dec0{"12345678"}), "12345678");
+  EXPECT_EQ(ToStringTrailingZeros(Dec4{"12345678.9"}), "12345678.9000");
+  EXPECT_EQ(fmt::format("{}", Dec4{"-12345678.9"}), "-12345678.9");
+  EXPECT_EQ(fmt::format("{:f}", Dec4{"-12345678.9"}), "-12345678.9000");
+
+  std::mt19937_64 generator{42};
+  for (int i = 0; i < 10000; ++i) {
+    const auto value = static_cast<int64_t>(generator()) >> (i % 64);
+    const auto dec = Dec4::FromUnbiased(value);
+    // the custom precision is formatted separately
+    EXPECT_EQ(ToStringTrailingZeros(dec), fmt::format("{:.4}", dec)) << value;
+    EXPECT_EQ(ToString(dec), ToString(dec, decimal64::FormatOptions{}))
+        << value;
+  }
+}
+
 USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #include <userver/decimal64/decimal64.hpp>
 
 #include <ios>
+#include <random>
 #include <sstream>
 
 #include <gtest/gtest.h>
@@ -259,4 +260,14 @@ TEST(Decimal64, RoundPolicies) {
   EXPECT_EQ(Down::FromStringPermissive("-0.000099999999999999"), Down{0});
 }
 
+TEST(Decimal64, ParseToStringRoundtrip) {
+  std::mt19937_64 generator{42};
+  for (int i = 0; i < 10000; ++i) {
+    const auto value = static_cast<int64_t>(generator()) >> (i % 64);
+    const auto dec = Dec4::FromUnbiased(value);
+    EXPECT_EQ(Dec4{decimal64::ToString(dec)}, dec) << value;
+    EXPECT_EQ(Dec4{decimal64::ToStringTrailingZeros(dec)}, dec) << value;
+  }
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,212 @@
+#pragma once
+
+// Documents for the benchmarks of formats, the same ones for all the formats.
+//
+// The documents are generated deterministically, so the results may be
+// compared across releases. The benchmarks are named
+// `formats_corpus/<format>/<operation>/<document>`, track them with
+//   --benchmark_filter='^formats_corpus/' --benchmark_format=json
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include <userver/formats/parse/common_containers.hpp>
+#include <userver/formats/parse/to.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::corpus {
+
+enum class DocumentKind {
+  kDeepNesting,
+  kWideObject,
+  kNumberHeavy,
+  kStringHeavy,
+  kUnicodeEscapes,
+};
+
+struct Document {
+  DocumentKind kind;
+  std::string_view name;
+  // All the documents are objects, for BSON
+  std::string json;
+};
+
+namespace impl {
+
+// Trees of kDepth nodes with a few leaves at each level
+inline std::string MakeDeepNesting() {
+  constexpr int kTrees = 40;
+  constexpr int kDepth = 24;
+
+  std::string result = R"({"items":[)";
+  for (int tree = 0; tree < kTrees; ++tree) {
+    if (tree != 0) result += ',';
+    for (int level = 0; level < kDepth; ++level) {
+      result += fmt::format(R"({{"id":{},"children":[)", tree * kDepth + level);
+      result += R"({"id":-1,"children":[]},{"id":-2,"children":[]},)";
+    }
+    result += R"({"id":-3,"children":[]})";
+    for (int level = 0; level < kDepth; ++level) result += "]}";
+  }
+  result += "]}";
+  return result;
+}
+
+inline std::string MakeWideObject() {
+  constexpr int kFields = 5000;
+
+  std::string result = "{";
+  for (int i = 0; i < kFields; ++i) {
+    if (i != 0) result += ',';
+    result += fmt::format(R"("field_{:05}":{})", i, i * 7919 % 100003);
+  }
+  result += '}';
+  return result;
+}
+
+inline std::string MakeNumberHeavy() {
+  constexpr int kRows = 2000;
+  constexpr int kColumns = 10;
+
+  std::string result = R"({"rows":[)";
+  for (int row = 0; row < kRows; ++row) {
+    if (row != 0) result += ',';
+    result += '[';
+    for (int column = 0; column < kColumns; ++column) {
+      if (column != 0) result += ',';
+      if (column % 2 == 0) {
+        result += fmt::format("{}", row * 1'000'003 - column * 999'983);
+      } else {
+        result += fmt::format("{}", row * 0.37 + column / 7.0);
+      }
+    }
+    result += ']';
+  }
+  result += "]}";
+  return result;
+}
+
+inline std::string MakeStringHeavy() {
+  constexpr int kItems = 1000;
+
+  std::string result = R"({"items":[)";
+  for (int i = 0; i < kItems; ++i) {
+    if (i != 0) result += ',';
+    result += fmt::format(
+        R"({{"id":"item-{:06}","title":"The title of the item number {}",)"
+        R"("description":"A longer text that describes the item {} in )"
+        R"(detail, with \"quotes\", a\ttab and a\nnew line. It is about )"
+        R"(as long as a real description in a catalogue would be."}})",
+        i, i, i);
+  }
+  result += "]}";
+  return result;
+}
+
+inline std::string MakeUnicodeEscapes() {
+  constexpr int kStrings = 2000;
+  // Cyrillic, CJK, Latin-1 and the characters outside of BMP
+  constexpr std::array<std::string_view, 4> kTexts{
+      R"(\u041f\u0440\u0438\u0432\u0435\u0442, \u043c\u0438\u0440)",
+      R"(\u4f60\u597d\uff0c\u4e16\u754c)",
+      R"(\u00e9t\u00e9 \u00e0 l'h\u00f4tel)",
+      R"(emoji \ud83d\ude00\ud83d\ude80 in text)",
+  };
+
+  std::string result = R"({"strings":[)";
+  for (int i = 0; i < kStrings; ++i) {
+    if (i != 0) result += ',';
+    result += fmt::format(R"("{} #{}")", kTexts[i % kTexts.size()], i);
+  }
+  result += "]}";
+  return result;
+}
+
+}  // namespace impl
+
+inline const std::vector<Document>& GetCorpus() {
+  static const std::vector<Document> corpus{
+      {DocumentKind::kDeepNesting, "deep_nesting", impl::MakeDeepNesting()},
+      {DocumentKind::kWideObject, "wide_object", impl::MakeWideObject()},
+      {DocumentKind::kNumberHeavy, "number_heavy", impl::MakeNumberHeavy()},
+      {DocumentKind::kStringHeavy, "string_heavy", impl::MakeStringHeavy()},
+      {DocumentKind::kUnicodeEscapes, "unicode_escapes",
+       impl::MakeUnicodeEscapes()},
+  };
+  return corpus;
+}
+
+// The structs the documents are parsed into
+
+struct Node {
+  std::int64_t id;
+  std::vector<Node> children;
+};
+
+struct Item {
+  std::string id;
+  std::string title;
+  std::string description;
+};
+
+template <typename Value>
+Node Parse(const Value& value, formats::parse::To<Node>) {
+  return {value["id"].template As<std::int64_t>(),
+          value["children"].template As<std::vector<Node>>()};
+}
+
+template <typename Value>
+Item Parse(const Value& value, formats::parse::To<Item>) {
+  return {value["id"].template As<std::string>(),
+          value["title"].template As<std::string>(),
+          value["description"].template As<std::string>()};
+}
+
+/// Parses the document into the structs, returns the count of top level
+/// elements
+template <typename Value>
+std::size_t ParseToStructs(DocumentKind kind, const Value& value) {
+  switch (kind) {
+    case DocumentKind::kDeepNesting:
+      return value["items"].template As<std::vector<Node>>().size();
+    case DocumentKind::kWideObject:
+      return value
+          .template As<std::unordered_map<std::string, std::int64_t>>()
+          .size();
+    case DocumentKind::kNumberHeavy:
+      return value["rows"]
+          .template As<std::vector<std::vector<double>>>()
+          .size();
+    case DocumentKind::kStringHeavy:
+      return value["items"].template As<std::vector<Item>>().size();
+    case DocumentKind::kUnicodeEscapes:
+      return value["strings"].template As<std::vector<std::string>>().size();
+  }
+  return 0;
+}
+
+/// Registers `formats_corpus/<format>/<operation>/<document>` benchmarks,
+/// `run(state, document)` runs the iterations for a document
+template <typename Run>
+void RegisterBenchmarks(std::string_view format, std::string_view operation,
+                        Run run) {
+  for (const auto& document : GetCorpus()) {
+    const auto name = fmt::format("formats_corpus/{}/{}/{}", format, operation,
+                                  document.name);
+    benchmark::RegisterBenchmark(
+        name.c_str(),
+        [&document, run](benchmark::State& state) { run(state, document); });
+  }
+}
+
+}  // namespace formats::corpus
+
+USERVER_NAMESPACE_END
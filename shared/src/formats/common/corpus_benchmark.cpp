@@ -0,0 +1,129 @@
+#include <benchmark/benchmark.h>
+
+#include <formats/common/benchmark_corpus.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/formats/yaml/serialize.hpp>
+#include <userver/formats/yaml/value.hpp>
+#include <userver/formats/yaml/value_builder.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using formats::corpus::Document;
+using formats::corpus::RegisterBenchmarks;
+
+formats::yaml::Value ToYaml(const formats::json::Value& json) {
+  formats::yaml::ValueBuilder builder;
+  if (json.IsObject()) {
+    builder = formats::common::Type::kObject;
+    for (auto it = json.begin(); it != json.end(); ++it) {
+      builder[it.GetName()] = ToYaml(*it);
+    }
+  } else if (json.IsArray()) {
+    builder = formats::common::Type::kArray;
+    for (const auto& element : json) builder.PushBack(ToYaml(element));
+  } else if (json.IsString()) {
+    builder = json.As<std::string>();
+  } else if (json.IsInt64()) {
+    builder = json.As<std::int64_t>();
+  } else if (json.IsDouble()) {
+    builder = json.As<double>();
+  } else if (json.IsBool()) {
+    builder = json.As<bool>();
+  }
+  return builder.ExtractValue();
+}
+
+std::string ToYamlString(const Document& document) {
+  return formats::yaml::ToString(
+      ToYaml(formats::json::FromString(document.json)));
+}
+
+template <typename Function>
+void RunIterations(benchmark::State& state, std::size_t bytes,
+                   Function function) {
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(function());
+  }
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+void RegisterJsonBenchmarks() {
+  RegisterBenchmarks(
+      "json", "parse", [](benchmark::State& state, const Document& document) {
+        RunIterations(state, document.json.size(), [&document] {
+          return formats::json::FromString(document.json);
+        });
+      });
+  RegisterBenchmarks(
+      "json", "serialize",
+      [](benchmark::State& state, const Document& document) {
+        const auto value = formats::json::FromString(document.json);
+        RunIterations(state, document.json.size(),
+                      [&value] { return formats::json::ToString(value); });
+      });
+  RegisterBenchmarks(
+      "json", "value_builder_roundtrip",
+      [](benchmark::State& state, const Document& document) {
+        const auto value = formats::json::FromString(document.json);
+        RunIterations(state, document.json.size(), [&value] {
+          return formats::json::ValueBuilder{value}.ExtractValue();
+        });
+      });
+  RegisterBenchmarks(
+      "json", "parse_to_struct",
+      [](benchmark::State& state, const Document& document) {
+        const auto value = formats::json::FromString(document.json);
+        RunIterations(state, document.json.size(), [&value, &document] {
+          return formats::corpus::ParseToStructs(document.kind, value);
+        });
+      });
+}
+
+void RegisterYamlBenchmarks() {
+  RegisterBenchmarks(
+      "yaml", "parse", [](benchmark::State& state, const Document& document) {
+        const auto yaml = ToYamlString(document);
+        RunIterations(state, yaml.size(),
+                      [&yaml] { return formats::yaml::FromString(yaml); });
+      });
+  RegisterBenchmarks(
+      "yaml", "serialize",
+      [](benchmark::State& state, const Document& document) {
+        const auto yaml = ToYamlString(document);
+        const auto value = formats::yaml::FromString(yaml);
+        RunIterations(state, yaml.size(),
+                      [&value] { return formats::yaml::ToString(value); });
+      });
+  RegisterBenchmarks(
+      "yaml", "value_builder_roundtrip",
+      [](benchmark::State& state, const Document& document) {
+        const auto yaml = ToYamlString(document);
+        const auto value = formats::yaml::FromString(yaml);
+        RunIterations(state, yaml.size(), [&value] {
+          return formats::yaml::ValueBuilder{value}.ExtractValue();
+        });
+      });
+  RegisterBenchmarks(
+      "yaml", "parse_to_struct",
+      [](benchmark::State& state, const Document& document) {
+        const auto yaml = ToYamlString(document);
+        const auto value = formats::yaml::FromString(yaml);
+        RunIterations(state, yaml.size(), [&value, &document] {
+          return formats::corpus::ParseToStructs(document.kind, value);
+        });
+      });
+}
+
+[[maybe_unused]] const bool kRegistered = [] {
+  RegisterJsonBenchmarks();
+  RegisterYamlBenchmarks();
+  return true;
+}();
+
+}  // namespace
+
+USERVER_NAMESPACE_END
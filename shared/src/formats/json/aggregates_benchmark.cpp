@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <userver/formats/json/aggregates.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/formats/serialize/common_containers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Item {
+  int id;
+  std::string name;
+  double weight;
+  bool is_active;
+};
+
+}  // namespace
+
+template <>
+struct formats::json::AggregateFieldNames<Item> {
+  static constexpr std::string_view kNames[] = {"id", "name", "weight",
+                                                "is_active"};
+};
+
+namespace {
+
+std::vector<Item> MakeItems(std::size_t size) {
+  std::vector<Item> result;
+  result.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    result.push_back({static_cast<int>(i), "item " + std::to_string(i),
+                      i * 0.5, i % 2 == 0});
+  }
+  return result;
+}
+
+}  // namespace
+
+void JsonAggregatesSerialize(benchmark::State& state) {
+  const auto items = MakeItems(state.range(0));
+  for (auto _ : state) {
+    const auto json = formats::json::ValueBuilder{items}.ExtractValue();
+    const auto res = formats::json::ToString(json);
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(JsonAggregatesSerialize)->RangeMultiplier(8)->Range(1, 4096);
+
+void JsonAggregatesWriteToStream(benchmark::State& state) {
+  const auto items = MakeItems(state.range(0));
+  for (auto _ : state) {
+    formats::json::StringBuilder sb;
+    WriteToStream(items, sb);
+    benchmark::DoNotOptimize(sb.GetStringView());
+  }
+}
+BENCHMARK(JsonAggregatesWriteToStream)->RangeMultiplier(8)->Range(1, 4096);
+
+USERVER_NAMESPACE_END
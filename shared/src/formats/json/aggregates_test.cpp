@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/formats/json/aggregates.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+#include <userver/formats/serialize/common_containers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+/// [Sample formats::json::AggregateFieldNames usage]
+namespace {
+
+struct Inner {
+  int id;
+  std::optional<std::string> comment;
+};
+
+}  // namespace
+
+template <>
+struct formats::json::AggregateFieldNames<Inner> {
+  static constexpr std::string_view kNames[] = {"id", "comment"};
+};
+/// [Sample formats::json::AggregateFieldNames usage]
+
+namespace {
+
+struct Outer {
+  std::string name;
+  std::vector<Inner> items;
+  double weight;
+};
+
+struct TrickyNames {
+  int quote;
+  int backslash;
+  int newline;
+};
+
+}  // namespace
+
+template <>
+struct formats::json::AggregateFieldNames<Outer> {
+  static constexpr std::string_view kNames[] = {"name", "items", "weight"};
+};
+
+template <>
+struct formats::json::AggregateFieldNames<TrickyNames> {
+  static constexpr std::string_view kNames[] = {"a\"b", "c\\d", "e\nf"};
+};
+
+namespace {
+
+const Outer kOuter{"outer", {{1, "first"}, {2, std::nullopt}}, 1.5};
+
+constexpr std::string_view kOuterJson =
+    R"({"name":"outer","items":[{"id":1,"comment":"first"},)"
+    R"({"id":2,"comment":null}],"weight":1.5})";
+
+}  // namespace
+
+TEST(FormatsJsonAggregates, WriteToStream) {
+  formats::json::StringBuilder sb;
+  WriteToStream(kOuter, sb);
+  EXPECT_EQ(sb.GetStringView(), kOuterJson);
+}
+
+TEST(FormatsJsonAggregates, WriteToStreamEscapedNames) {
+  formats::json::StringBuilder sb;
+  WriteToStream(TrickyNames{1, 2, 3}, sb);
+  EXPECT_EQ(sb.GetStringView(), R"({"a\"b":1,"c\\d":2,"e\u000af":3})");
+
+  const auto json = formats::json::FromString(sb.GetStringView());
+  EXPECT_EQ(json["a\"b"].As<int>(), 1);
+  EXPECT_EQ(json["c\\d"].As<int>(), 2);
+  EXPECT_EQ(json["e\nf"].As<int>(), 3);
+}
+
+TEST(FormatsJsonAggregates, Parse) {
+  const auto json = formats::json::FromString(kOuterJson);
+  const auto outer = json.As<Outer>();
+  EXPECT_EQ(outer.name, "outer");
+  ASSERT_EQ(outer.items.size(), 2);
+  EXPECT_EQ(outer.items[0].id, 1);
+  EXPECT_EQ(outer.items[0].comment, "first");
+  EXPECT_EQ(outer.items[1].id, 2);
+  EXPECT_EQ(outer.items[1].comment, std::nullopt);
+  EXPECT_EQ(outer.weight, 1.5);
+}
+
+TEST(FormatsJsonAggregates, ParseMissing) {
+  const auto inner = formats::json::FromString(R"({"id":3})").As<Inner>();
+  EXPECT_EQ(inner.id, 3);
+  EXPECT_EQ(inner.comment, std::nullopt);
+
+  EXPECT_THROW(formats::json::FromString(R"({"comment":"x"})").As<Inner>(),
+               formats::json::MemberMissingException);
+}
+
+TEST(FormatsJsonAggregates, Serialize) {
+  const auto json = formats::json::ValueBuilder{kOuter}.ExtractValue();
+  EXPECT_EQ(json, formats::json::FromString(kOuterJson));
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,94 @@
+#include <formats/json/impl/allocator.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::impl {
+
+namespace {
+
+constexpr std::size_t kAlignment = alignof(std::max_align_t);
+
+constexpr std::size_t AlignUp(std::size_t size) noexcept {
+  return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+}  // namespace
+
+Arena::~Arena() {
+  while (blocks_) {
+    auto* next = blocks_->next;
+    std::free(blocks_);
+    blocks_ = next;
+  }
+}
+
+void Arena::Reserve(std::size_t size) noexcept {
+  next_block_size_ = std::clamp(AlignUp(size), kMinBlockSize, kMaxBlockSize);
+}
+
+void* Arena::Allocate(std::size_t size) {
+  size = AlignUp(size);
+  if (static_cast<std::size_t>(end_ - current_) < size) {
+    // Big allocations get their own blocks, so that the rest of the current
+    // block is not wasted
+    if (size > next_block_size_ / 2) return AllocateBlock(size);
+
+    current_ = static_cast<char*>(AllocateBlock(next_block_size_));
+    end_ = current_ + next_block_size_;
+    next_block_size_ = std::min(next_block_size_ * 2, kMaxBlockSize);
+  }
+
+  auto* ptr = current_;
+  current_ += size;
+  return ptr;
+}
+
+void* Arena::AllocateBlock(std::size_t size) {
+  constexpr std::size_t kHeaderSize = AlignUp(sizeof(Block));
+
+  auto* block = static_cast<Block*>(std::malloc(kHeaderSize + size));
+  if (!block) throw std::bad_alloc();
+  block->next = blocks_;
+  blocks_ = block;
+  return reinterpret_cast<char*>(block) + kHeaderSize;
+}
+
+thread_local bool Allocator::free_suppressed_ = false;
+
+void* Allocator::Malloc(std::size_t size) {
+  // the behavior of malloc(0) is implementation defined
+  if (!size) return nullptr;
+  return arena_ ? arena_->Allocate(size) : std::malloc(size);
+}
+
+void* Allocator::Realloc(void* original_ptr, std::size_t original_size,
+                         std::size_t new_size) {
+  if (!arena_) {
+    if (!new_size) {
+      Free(original_ptr);
+      return nullptr;
+    }
+    return std::realloc(original_ptr, new_size);
+  }
+
+  if (new_size <= original_size) return new_size ? original_ptr : nullptr;
+  auto* ptr = arena_->Allocate(new_size);
+  if (original_size) std::memcpy(ptr, original_ptr, original_size);
+  return ptr;
+}
+
+Allocator::FreeSuppressor::FreeSuppressor() noexcept
+    : was_suppressed_(std::exchange(free_suppressed_, true)) {}
+
+Allocator::FreeSuppressor::~FreeSuppressor() {
+  free_suppressed_ = was_suppressed_;
+}
+
+}  // namespace formats::json::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+
+#include <userver/formats/json/impl/types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::impl {
+
+/// Bump-pointer memory of a parsed document, all of it is released at once
+class Arena final {
+ public:
+  Arena() noexcept = default;
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  ~Arena();
+
+  /// Sets the size of the next memory block to allocate
+  void Reserve(std::size_t size) noexcept;
+
+  /// @returns memory aligned as malloc's, valid until the Arena is destroyed
+  void* Allocate(std::size_t size);
+
+  bool IsEmpty() const noexcept { return blocks_ == nullptr; }
+
+ private:
+  static constexpr std::size_t kMinBlockSize = 4096;
+  static constexpr std::size_t kMaxBlockSize = 1024 * 1024;
+
+  struct Block {
+    Block* next;
+  };
+
+  void* AllocateBlock(std::size_t size);
+
+  Block* blocks_{nullptr};
+  char* current_{nullptr};
+  char* end_{nullptr};
+  std::size_t next_block_size_{kMinBlockSize};
+};
+
+/// rapidjson allocator that takes memory from the heap or from an Arena.
+///
+/// A default constructed allocator has no state and may be used from any
+/// thread, like rapidjson::CrtAllocator.
+class Allocator final {
+ public:
+  static constexpr bool kNeedFree = true;
+
+  Allocator() noexcept = default;
+  explicit Allocator(Arena& arena) noexcept : arena_(&arena) {}
+
+  void* Malloc(std::size_t size);
+
+  void* Realloc(void* original_ptr, std::size_t original_size,
+                std::size_t new_size);
+
+  static void Free(void* ptr) noexcept {
+    if (!free_suppressed_) std::free(ptr);
+  }
+
+  /// Turns Free into no-op in the current thread while alive, for the values
+  /// allocated from an Arena that are destroyed by rapidjson internals
+  class FreeSuppressor final {
+   public:
+    FreeSuppressor() noexcept;
+    FreeSuppressor(const FreeSuppressor&) = delete;
+    FreeSuppressor& operator=(const FreeSuppressor&) = delete;
+    ~FreeSuppressor();
+
+   private:
+    const bool was_suppressed_;
+  };
+
+ private:
+  static thread_local bool free_suppressed_;
+
+  Arena* arena_{nullptr};
+};
+
+}  // namespace formats::json::impl
+
+USERVER_NAMESPACE_END
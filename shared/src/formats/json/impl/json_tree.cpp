@@ -7,6 +7,8 @@
 #include <userver/formats/json/impl/types.hpp>
 
 #include <cstddef>
+#include <string>
+#include <string_view>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -17,6 +19,10 @@ using Value = formats::json::impl::Value;
 using Member = formats::json::impl::Value::MemberIterator::value_type;
 using TreeIterFrame = formats::json::impl::TreeIterFrame;
 
+std::string_view AsStringView(const Value& jval) {
+  return {jval.GetString(), jval.GetStringLength()};
+}
+
 /// Use pointer arithmetic to get `rapidjson::GenericMember` out of `Value`
 const Member* MemberFromValue(const Value* val) {
   return reinterpret_cast<const Member*>(reinterpret_cast<const char*>(val) -
@@ -110,6 +116,47 @@ std::string ExtractPath(const std::vector<TreeIterFrame>& stack) {
 
   return path.empty() ? common::kPathRoot : path;
 }
+
+void CheckKeyUniqueness(const Value* root) {
+  std::vector<TreeIterFrame> stack;
+  const Value* value = root;
+
+  stack.reserve(kInitialStackDepth);
+  stack.emplace_back();  // fake "top" frame to avoid extra checks for an empty
+                         // stack inside walker loop
+
+  for (;;) {
+    stack.back().Advance();
+    if (value->IsObject()) {
+      // O(n²) just because our json objects are (hopefully) small
+      const int count = value->MemberCount();
+      const auto begin = value->MemberBegin();
+      for (int i = 1; i < count; i++) {
+        const std::string_view i_key = AsStringView(begin[i].name);
+        for (int j = 0; j < i; j++) {
+          const std::string_view j_key = AsStringView(begin[j].name);
+          if (i_key == j_key)
+            // TODO: add object path to message in TAXICOMMON-1658
+            throw ParseException("Duplicate key: " + std::string(i_key) +
+                                 " at " + ExtractPath(stack));
+        }
+      }
+    }
+
+    if ((value->IsObject() && value->MemberCount() > 0) ||
+        (value->IsArray() && value->Size() > 0)) {
+      // descend
+      stack.emplace_back(value);
+    } else {
+      while (!stack.back().HasMoreElements()) {
+        stack.pop_back();
+        if (stack.empty()) return;
+      }
+    }
+
+    value = stack.back().CurrentValue();
+  }
+}
 }  // namespace formats::json::impl
 
 USERVER_NAMESPACE_END
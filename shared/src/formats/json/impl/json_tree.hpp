@@ -7,6 +7,8 @@
 #include <userver/formats/json/impl/types.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <formats/json/impl/allocator.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace formats::json::impl {
@@ -70,6 +72,8 @@ class TreeIterFrame {
 std::string MakePath(const Value* root, const Value* node, int node_depth);
 /// Transform nodes onto stack into string
 std::string ExtractPath(const std::vector<TreeIterFrame>& stack);
+/// Throws ParseException if any object in the tree has duplicate keys
+void CheckKeyUniqueness(const Value* root);
 }  // namespace formats::json::impl
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,87 @@
+#include <formats/json/impl/key_table.hpp>
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::impl {
+
+namespace {
+
+constexpr std::size_t kBlockSize = 64 * 1024;
+// 4MiB of keys
+constexpr std::size_t kMaxBlocks = 64;
+
+static_assert(kMaxInternedKeySize < kBlockSize);
+
+class KeyTable final {
+ public:
+  const char* Intern(std::string_view key) {
+    const std::lock_guard lock{mutex_};
+    if (const auto it = keys_.find(key); it != keys_.end()) {
+      return it->data();
+    }
+
+    if (key.size() + 1 > static_cast<std::size_t>(end_ - current_)) {
+      if (blocks_.size() == kMaxBlocks) return nullptr;
+      blocks_.push_back(std::make_unique<char[]>(kBlockSize));
+      current_ = blocks_.back().get();
+      end_ = current_ + kBlockSize;
+    }
+
+    char* copy = current_;
+    std::memcpy(copy, key.data(), key.size());
+    copy[key.size()] = '\0';
+    current_ += key.size() + 1;
+    keys_.emplace(copy, key.size());
+    return copy;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_set<std::string_view> keys_;
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char* current_{nullptr};
+  char* end_{nullptr};
+};
+
+KeyTable& GetKeyTable() {
+  // Never destroyed, the documents may reference the keys till the very exit
+  static auto& table = *new KeyTable();
+  return table;
+}
+
+}  // namespace
+
+const char* InternKey(std::string_view key) {
+  if (key.size() <= kMaxInlineKeySize || key.size() > kMaxInternedKeySize) {
+    return nullptr;
+  }
+  return GetKeyTable().Intern(key);
+}
+
+const char* KeyInterner::Intern(std::string_view key) {
+  if (key.size() <= kMaxInlineKeySize || key.size() > kMaxInternedKeySize) {
+    return nullptr;
+  }
+
+  const auto it = keys_.find(key);
+  if (it != keys_.end()) return it->second;
+  if (is_table_full_) return nullptr;
+
+  const char* interned = GetKeyTable().Intern(key);
+  if (!interned) {
+    is_table_full_ = true;
+    return nullptr;
+  }
+  keys_.emplace(std::string_view{interned, key.size()}, interned);
+  return interned;
+}
+
+}  // namespace formats::json::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <unordered_map>
+
+#include <rapidjson/document.h>
+
+#include <userver/formats/json/impl/types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::impl {
+
+/// Keys of this size and shorter are stored inside rapidjson values
+inline constexpr std::size_t kMaxInlineKeySize = sizeof(Value) - 3;
+
+/// Longer keys are likely to be data rather than names of fields
+inline constexpr std::size_t kMaxInternedKeySize = 256;
+
+/// @returns null-terminated copy of the key in the process wide table, the
+/// same one for the equal keys. The copies are never released, so nullptr is
+/// returned when the table is full or the key does not need to be interned.
+const char* InternKey(std::string_view key);
+
+/// The keys interned during the parsing of a single document, avoids locking
+/// the process wide table for each key
+class KeyInterner final {
+ public:
+  const char* Intern(std::string_view key);
+
+ private:
+  std::unordered_map<std::string_view, const char*> keys_;
+  bool is_table_full_{false};
+};
+
+}  // namespace formats::json::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,68 @@
+#include <formats/json/impl/string_scan.hpp>
+
+#include <rapidjson/rapidjson.h>
+
+#if defined(RAPIDJSON_SSE2)
+#include <emmintrin.h>
+#elif defined(RAPIDJSON_NEON)
+#include <arm_neon.h>
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::impl {
+
+namespace {
+
+constexpr std::size_t kChunkSize = 16;
+
+bool NeedsEscaping(unsigned char c) noexcept {
+  return c < 0x20 || c == '"' || c == '\\';
+}
+
+}  // namespace
+
+std::size_t FindCharToEscape(std::string_view str) noexcept {
+  const auto* data = reinterpret_cast<const unsigned char*>(str.data());
+  const auto size = str.size();
+  std::size_t i = 0;
+
+#if defined(RAPIDJSON_SSE2)
+  const auto quote = _mm_set1_epi8('"');
+  const auto backslash = _mm_set1_epi8('\\');
+  const auto control_max = _mm_set1_epi8(0x1f);
+  for (; i + kChunkSize <= size; i += kChunkSize) {
+    const auto chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    const auto is_control =
+        _mm_cmpeq_epi8(_mm_min_epu8(chunk, control_max), chunk);
+    const auto mask = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                     _mm_cmpeq_epi8(chunk, backslash)),
+        is_control);
+    const auto bits = _mm_movemask_epi8(mask);
+    if (bits != 0) return i + __builtin_ctz(bits);
+  }
+#elif defined(RAPIDJSON_NEON)
+  const auto quote = vdupq_n_u8('"');
+  const auto backslash = vdupq_n_u8('\\');
+  const auto control_max = vdupq_n_u8(0x1f);
+  for (; i + kChunkSize <= size; i += kChunkSize) {
+    const auto chunk = vld1q_u8(data + i);
+    const auto mask = vorrq_u8(
+        vorrq_u8(vceqq_u8(chunk, quote), vceqq_u8(chunk, backslash)),
+        vcleq_u8(chunk, control_max));
+    // the exact position is found by the loop below
+    if (vmaxvq_u8(mask) != 0) break;
+  }
+#endif
+
+  for (; i < size; ++i) {
+    if (NeedsEscaping(data[i])) return i;
+  }
+  return std::string_view::npos;
+}
+
+}  // namespace formats::json::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::impl {
+
+/// @returns position of the first character that needs escaping in a JSON
+/// string (a quote, a backslash or a control character) or
+/// std::string_view::npos.
+///
+/// Checks 16 bytes at a time if rapidjson was built with SIMD support.
+std::size_t FindCharToEscape(std::string_view str) noexcept;
+
+}  // namespace formats::json::impl
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include <formats/json/impl/types_impl.hpp>
 
+#include <new>
+
 #include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -10,9 +12,16 @@ VersionedValuePtr::Data::Data(Document&& doc)
     : Data(static_cast<Value&&>(doc)) {
   static_assert(
       // NOLINTNEXTLINE(misc-redundant-expression)
-      std::is_same_v<::rapidjson::CrtAllocator, Value::AllocatorType> &&
-          std::is_same_v<::rapidjson::CrtAllocator, Document::AllocatorType>,
-      "Both Document and Value must use CrtAllocator for the fast move");
+      std::is_same_v<Allocator, Value::AllocatorType> &&
+          std::is_same_v<Allocator, Document::AllocatorType>,
+      "Both Document and Value must use the same allocator for the fast move");
+}
+
+VersionedValuePtr::Data::~Data() {
+  if (!arena.IsEmpty()) {
+    // The nodes are released with the arena at once, so the tree is not walked
+    new (&native) Value{};
+  }
 }
 
 VersionedValuePtr::VersionedValuePtr() noexcept = default;
@@ -52,6 +61,15 @@ size_t VersionedValuePtr::Version() const {
 
 void VersionedValuePtr::BumpVersion() { ++data_->version; }
 
+Arena& VersionedValuePtr::GetArena() {
+  UASSERT(data_);
+  return data_->arena;
+}
+
+bool VersionedValuePtr::IsArenaBacked() const {
+  return data_ && !data_->arena.IsEmpty();
+}
+
 }  // namespace formats::json::impl
 
 USERVER_NAMESPACE_END
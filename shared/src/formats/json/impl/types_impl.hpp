@@ -6,6 +6,8 @@
 
 #include <userver/formats/json/impl/types.hpp>
 
+#include <formats/json/impl/allocator.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace formats::json::impl {
@@ -18,6 +20,11 @@ struct VersionedValuePtr::Data {
   // https://github.com/Tencent/rapidjson/issues/387
   explicit Data(Document&&);
 
+  ~Data();
+
+  // memory of the nodes of an immutable parsed document, must outlive `native`
+  Arena arena;
+
   // native rapidjson value
   Value native;
 
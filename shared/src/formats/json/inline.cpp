@@ -1,14 +1,12 @@
 #include <userver/formats/json/inline.hpp>
 
-#include <type_traits>
-
 #include <rapidjson/allocators.h>
 #include <rapidjson/document.h>
 #include <rapidjson/rapidjson.h>
 
 #include <userver/formats/json/exception.hpp>
 #include <userver/utils/assert.hpp>
-#include <userver/utils/datetime.hpp>
+#include <userver/utils/datetime/timestring.hpp>
 
 #include <formats/common/validations.hpp>
 #include <formats/json/impl/types_impl.hpp>
@@ -18,10 +16,8 @@ USERVER_NAMESPACE_BEGIN
 namespace formats::json::impl {
 namespace {
 
-::rapidjson::CrtAllocator g_allocator;
-
-static_assert(std::is_empty_v<::rapidjson::CrtAllocator>,
-              "allocator has no state");
+// heap allocator has no state
+Allocator g_allocator;
 
 impl::Value WrapStringView(std::string_view key) {
   // GenericValue ctor has an invalid type for size
@@ -31,8 +27,8 @@ impl::Value WrapStringView(std::string_view key) {
 }
 
 std::string FormatTimePoint(std::chrono::system_clock::time_point value) {
-  return utils::datetime::Timestring(value, "UTC",
-                                     utils::datetime::kRfc3339Format);
+  return utils::datetime::Timestring(
+      value, utils::datetime::TimestringFormat::kRfc3339);
 }
 
 }  // namespace
@@ -0,0 +1,573 @@
+#include <userver/formats/json/lazy_value.hpp>
+
+#include <limits>
+#include <vector>
+
+#include <fmt/format.h>
+#include <rapidjson/error/en.h>
+
+#include <userver/formats/common/path.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/string_builder.hpp>
+
+#include <formats/json/impl/exttypes.hpp>
+#include <formats/json/impl/string_scan.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+
+namespace impl {
+
+// Values in the order of their appearance in the text. A member of an object
+// is stored as a node of its key followed by the node of its value.
+struct LazyNode {
+  static constexpr std::uint32_t kNoEscapedKey =
+      std::numeric_limits<std::uint32_t>::max();
+
+  std::uint32_t begin;
+  std::uint32_t end;
+  // Index of the node after the subtree of this one
+  std::uint32_t next;
+  // Index in LazyDocument::escaped_keys for the keys with escapes
+  std::uint32_t escaped_key;
+};
+
+struct LazyDocument {
+  std::string text;
+  std::vector<LazyNode> nodes;
+  std::vector<std::string> escaped_keys;
+
+  std::string_view GetText(std::uint32_t node) const {
+    const auto& n = nodes[node];
+    return std::string_view{text}.substr(n.begin, n.end - n.begin);
+  }
+
+  std::string_view GetKey(std::uint32_t node) const {
+    const auto& n = nodes[node];
+    if (n.escaped_key != LazyNode::kNoEscapedKey) {
+      return escaped_keys[n.escaped_key];
+    }
+    return std::string_view{text}.substr(n.begin + 1, n.end - n.begin - 2);
+  }
+};
+
+}  // namespace impl
+
+namespace {
+
+constexpr auto kMissingNode = std::numeric_limits<std::uint32_t>::max();
+
+void AppendUtf8(std::string& out, std::uint32_t codepoint) {
+  if (codepoint < 0x80) {
+    out += static_cast<char>(codepoint);
+  } else if (codepoint < 0x800) {
+    out += static_cast<char>(0xc0 | (codepoint >> 6));
+    out += static_cast<char>(0x80 | (codepoint & 0x3f));
+  } else if (codepoint < 0x10000) {
+    out += static_cast<char>(0xe0 | (codepoint >> 12));
+    out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f));
+    out += static_cast<char>(0x80 | (codepoint & 0x3f));
+  } else {
+    out += static_cast<char>(0xf0 | (codepoint >> 18));
+    out += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3f));
+    out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f));
+    out += static_cast<char>(0x80 | (codepoint & 0x3f));
+  }
+}
+
+int HexValue(char c) noexcept {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+bool IsDigit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+// Validates the document with the JSON grammar in a single pass and records
+// the positions of the values. Only the keys with escapes are decoded.
+class IndexBuilder final {
+ public:
+  explicit IndexBuilder(impl::LazyDocument& document)
+      : document_(document), text_(document.text) {}
+
+  void Build() {
+    SkipWhitespace();
+    // iterative, so that deeply nested documents do not overflow the stack
+    while (true) {
+      ParseValue();
+      if (!ParseAfterValue()) break;
+    }
+    SkipWhitespace();
+    if (pos_ != text_.size()) {
+      Fail(rapidjson::kParseErrorDocumentRootNotSingular);
+    }
+  }
+
+ private:
+  [[noreturn]] void Fail(rapidjson::ParseErrorCode code) const {
+    Fail(rapidjson::GetParseError_En(code));
+  }
+
+  [[noreturn]] void Fail(std::string_view error) const {
+    throw ParseException(
+        fmt::format("JSON parse error at offset {}: {}", pos_, error));
+  }
+
+  char Peek() const noexcept { return pos_ < text_.size() ? text_[pos_] : 0; }
+
+  void SkipWhitespace() noexcept {
+    while (pos_ < text_.size()) {
+      const char c = text_[pos_];
+      if (c != ' ' && c != '\n' && c != '\r' && c != '\t') break;
+      ++pos_;
+    }
+  }
+
+  void AddNode(std::uint32_t begin,
+               std::uint32_t escaped_key = impl::LazyNode::kNoEscapedKey) {
+    auto& nodes = document_.nodes;
+    const std::uint32_t index = nodes.size();
+    nodes.push_back({begin, static_cast<std::uint32_t>(pos_), index + 1,
+                     escaped_key});
+  }
+
+  void ParseValue() {
+    const std::uint32_t begin = pos_;
+    switch (Peek()) {
+      case '{':
+      case '[':
+        open_containers_.push_back(document_.nodes.size());
+        document_.nodes.push_back(
+            {begin, 0, 0, impl::LazyNode::kNoEscapedKey});
+        ++pos_;
+        return;
+      case '"':
+        SkipString();
+        break;
+      case 't':
+        SkipLiteral("true");
+        break;
+      case 'f':
+        SkipLiteral("false");
+        break;
+      case 'n':
+        SkipLiteral("null");
+        break;
+      default:
+        SkipNumber();
+        break;
+    }
+    AddNode(begin);
+  }
+
+  // Closes the finished containers and moves to the next value.
+  // @returns false if the document is over.
+  bool ParseAfterValue() {
+    while (!open_containers_.empty()) {
+      const auto container = open_containers_.back();
+      const bool is_object = text_[document_.nodes[container].begin] == '{';
+      const bool is_empty = container + 1 == document_.nodes.size();
+      SkipWhitespace();
+
+      const char close = is_object ? '}' : ']';
+      if (Peek() == close) {
+        ++pos_;
+        auto& node = document_.nodes[container];
+        node.end = pos_;
+        node.next = document_.nodes.size();
+        open_containers_.pop_back();
+        if (is_object) CheckKeyUniqueness(container);
+        continue;
+      }
+
+      if (!is_empty) {
+        if (Peek() != ',') {
+          Fail(is_object ? rapidjson::kParseErrorObjectMissCommaOrCurlyBracket
+                         : rapidjson::kParseErrorArrayMissCommaOrSquareBracket);
+        }
+        ++pos_;
+        SkipWhitespace();
+      }
+
+      if (is_object) ParseKey();
+      return true;
+    }
+    return false;
+  }
+
+  void ParseKey() {
+    if (Peek() != '"') Fail(rapidjson::kParseErrorObjectMissName);
+
+    const std::uint32_t begin = pos_;
+    auto escaped_key = impl::LazyNode::kNoEscapedKey;
+    if (SkipString()) {
+      escaped_key = document_.escaped_keys.size();
+      document_.escaped_keys.push_back(
+          Unescape(text_.substr(begin + 1, pos_ - begin - 2)));
+    }
+    AddNode(begin, escaped_key);
+
+    SkipWhitespace();
+    if (Peek() != ':') Fail(rapidjson::kParseErrorObjectMissColon);
+    ++pos_;
+    SkipWhitespace();
+  }
+
+  // @returns whether the string has escapes
+  bool SkipString() {
+    ++pos_;  // opening quote
+    bool has_escapes = false;
+    while (true) {
+      const auto special = impl::FindCharToEscape(text_.substr(pos_));
+      if (special == std::string_view::npos) {
+        pos_ = text_.size();
+        Fail(rapidjson::kParseErrorStringMissQuotationMark);
+      }
+      pos_ += special;
+
+      const char c = text_[pos_];
+      if (c == '"') {
+        ++pos_;
+        return has_escapes;
+      }
+      if (c != '\\') Fail(rapidjson::kParseErrorStringInvalidEncoding);
+
+      has_escapes = true;
+      ++pos_;
+      switch (Peek()) {
+        case '"':
+        case '\\':
+        case '/':
+        case 'b':
+        case 'f':
+        case 'n':
+        case 'r':
+        case 't':
+          ++pos_;
+          break;
+        case 'u':
+          SkipUnicodeEscape();
+          break;
+        default:
+          Fail(rapidjson::kParseErrorStringEscapeInvalid);
+      }
+    }
+  }
+
+  // Validates \uXXXX with a possible surrogate pair, pos_ is at 'u'
+  void SkipUnicodeEscape() {
+    const auto codepoint = ParseHex4();
+    if (codepoint >= 0xd800 && codepoint <= 0xdbff) {
+      if (text_.substr(pos_, 2) != "\\u") {
+        Fail(rapidjson::kParseErrorStringUnicodeSurrogateInvalid);
+      }
+      ++pos_;
+      const auto trail = ParseHex4();
+      if (trail < 0xdc00 || trail > 0xdfff) {
+        Fail(rapidjson::kParseErrorStringUnicodeSurrogateInvalid);
+      }
+    }
+  }
+
+  // pos_ is at 'u'
+  std::uint32_t ParseHex4() {
+    ++pos_;
+    std::uint32_t result = 0;
+    for (int i = 0; i < 4; ++i) {
+      const auto digit = HexValue(Peek());
+      if (digit < 0) Fail(rapidjson::kParseErrorStringUnicodeEscapeInvalidHex);
+      result = result * 16 + digit;
+      ++pos_;
+    }
+    return result;
+  }
+
+  void SkipLiteral(std::string_view literal) {
+    if (text_.substr(pos_, literal.size()) != literal) {
+      Fail(rapidjson::kParseErrorValueInvalid);
+    }
+    pos_ += literal.size();
+  }
+
+  void SkipNumber() {
+    if (Peek() == '-') ++pos_;
+    if (Peek() == '0') {
+      ++pos_;
+    } else if (IsDigit(Peek())) {
+      while (IsDigit(Peek())) ++pos_;
+    } else {
+      Fail(rapidjson::kParseErrorValueInvalid);
+    }
+
+    if (Peek() == '.') {
+      ++pos_;
+      if (!IsDigit(Peek())) Fail(rapidjson::kParseErrorNumberMissFraction);
+      while (IsDigit(Peek())) ++pos_;
+    }
+
+    if (Peek() == 'e' || Peek() == 'E') {
+      ++pos_;
+      if (Peek() == '+' || Peek() == '-') ++pos_;
+      if (!IsDigit(Peek())) Fail(rapidjson::kParseErrorNumberMissExponent);
+      while (IsDigit(Peek())) ++pos_;
+    }
+  }
+
+  // The escapes are already validated by SkipString
+  static std::string Unescape(std::string_view raw) {
+    std::string result;
+    result.reserve(raw.size());
+    for (std::size_t i = 0; i < raw.size(); ++i) {
+      if (raw[i] != '\\') {
+        result += raw[i];
+        continue;
+      }
+
+      const char c = raw[++i];
+      switch (c) {
+        case 'b':
+          result += '\b';
+          break;
+        case 'f':
+          result += '\f';
+          break;
+        case 'n':
+          result += '\n';
+          break;
+        case 'r':
+          result += '\r';
+          break;
+        case 't':
+          result += '\t';
+          break;
+        case 'u': {
+          const auto hex4 = [&raw](std::size_t pos) {
+            std::uint32_t value = 0;
+            for (int j = 0; j < 4; ++j) {
+              value = value * 16 + HexValue(raw[pos + j]);
+            }
+            return value;
+          };
+          auto codepoint = hex4(i + 1);
+          i += 4;
+          if (codepoint >= 0xd800 && codepoint <= 0xdbff) {
+            const auto trail = hex4(i + 3);
+            codepoint = 0x10000 + ((codepoint - 0xd800) << 10) +
+                        (trail - 0xdc00);
+            i += 6;
+          }
+          AppendUtf8(result, codepoint);
+          break;
+        }
+        default:  // quote, backslash or slash
+          result += c;
+          break;
+      }
+    }
+    return result;
+  }
+
+  void CheckKeyUniqueness(std::uint32_t object) const {
+    // O(n²) just because our json objects are (hopefully) small, like in
+    // formats::json::FromString
+    const auto& nodes = document_.nodes;
+    for (auto i = object + 1; i < nodes[object].next; i = nodes[i + 1].next) {
+      const auto i_key = document_.GetKey(i);
+      for (auto j = object + 1; j < i; j = nodes[j + 1].next) {
+        if (i_key == document_.GetKey(j)) {
+          Fail("Duplicate key: " + std::string{i_key});
+        }
+      }
+    }
+  }
+
+  impl::LazyDocument& document_;
+  const std::string_view text_;
+  std::vector<std::uint32_t> open_containers_;
+  std::size_t pos_{0};
+};
+
+std::shared_ptr<const impl::LazyDocument> BuildDocument(std::string json) {
+  if (json.empty()) throw ParseException("JSON document is empty");
+  if (json.size() >= std::numeric_limits<std::uint32_t>::max()) {
+    throw ParseException("JSON document is too big for the lazy parsing");
+  }
+
+  auto document = std::make_shared<impl::LazyDocument>();
+  document->text = std::move(json);
+  IndexBuilder{*document}.Build();
+  return document;
+}
+
+}  // namespace
+
+LazyValue::LazyValue(std::string json)
+    : LazyValue(BuildDocument(std::move(json)), 0) {}
+
+LazyValue::LazyValue(std::shared_ptr<const impl::LazyDocument> document,
+                     std::uint32_t node)
+    : document_(std::move(document)), node_(node) {}
+
+LazyValue::LazyValue(std::shared_ptr<const impl::LazyDocument> document,
+                     std::string missing_path)
+    : document_(std::move(document)),
+      node_(kMissingNode),
+      missing_path_(std::move(missing_path)) {}
+
+LazyValue::~LazyValue() = default;
+
+LazyValue LazyValue::operator[](std::string_view key) const {
+  if (IsMissing() || IsNull()) {
+    return {document_, common::MakeChildPath(GetPath(), key)};
+  }
+  if (!IsObject()) {
+    throw TypeMismatchException(GetExtendedType(), impl::objectValue,
+                                GetPath());
+  }
+
+  const auto& nodes = document_->nodes;
+  for (auto i = node_ + 1; i < nodes[node_].next; i = nodes[i + 1].next) {
+    if (document_->GetKey(i) == key) return {document_, i + 1};
+  }
+  return {document_, common::MakeChildPath(GetPath(), key)};
+}
+
+LazyValue LazyValue::operator[](std::size_t index) const {
+  CheckNotMissing();
+  if (!IsArray()) {
+    throw TypeMismatchException(GetExtendedType(), impl::arrayValue,
+                                GetPath());
+  }
+
+  const auto& nodes = document_->nodes;
+  std::size_t current = 0;
+  for (auto i = node_ + 1; i < nodes[node_].next; i = nodes[i].next) {
+    if (current++ == index) return {document_, i};
+  }
+  throw OutOfBoundsException(index, current, GetPath());
+}
+
+std::size_t LazyValue::GetSize() const {
+  CheckNotMissing();
+  if (IsNull()) return 0;
+  if (!IsArray() && !IsObject()) {
+    throw TypeMismatchException(GetExtendedType(), impl::arrayValue,
+                                GetPath());
+  }
+
+  const auto& nodes = document_->nodes;
+  // a member of an object is a key node followed by the value
+  const auto step = IsObject() ? 1 : 0;
+  std::size_t size = 0;
+  for (auto i = node_ + 1; i < nodes[node_].next; i = nodes[i + step].next) {
+    ++size;
+  }
+  return size;
+}
+
+bool LazyValue::HasMember(std::string_view key) const {
+  return !(*this)[key].IsMissing();
+}
+
+bool LazyValue::IsMissing() const noexcept {
+  return node_ == kMissingNode;
+}
+
+bool LazyValue::IsNull() const noexcept { return GetFirstChar() == 'n'; }
+
+bool LazyValue::IsBool() const noexcept {
+  const auto c = GetFirstChar();
+  return c == 't' || c == 'f';
+}
+
+bool LazyValue::IsNumber() const noexcept {
+  const auto c = GetFirstChar();
+  return c == '-' || (c >= '0' && c <= '9');
+}
+
+bool LazyValue::IsString() const noexcept { return GetFirstChar() == '"'; }
+
+bool LazyValue::IsArray() const noexcept { return GetFirstChar() == '['; }
+
+bool LazyValue::IsObject() const noexcept { return GetFirstChar() == '{'; }
+
+Value LazyValue::Materialize() const { return FromString(GetRawJson()); }
+
+std::string_view LazyValue::GetRawJson() const {
+  CheckNotMissing();
+  return document_->GetText(node_);
+}
+
+std::string LazyValue::GetPath() const {
+  if (IsMissing()) return missing_path_;
+
+  // descend from the root to the child that holds the node
+  const auto& nodes = document_->nodes;
+  std::string path;
+  std::uint32_t current = 0;
+  while (current != node_) {
+    const bool is_object = document_->text[nodes[current].begin] == '{';
+    std::size_t index = 0;
+    auto child = current + 1;
+    while (true) {
+      const auto value = is_object ? child + 1 : child;
+      if (node_ < nodes[value].next) {
+        if (is_object) {
+          common::AppendPath(path, document_->GetKey(child));
+        } else {
+          common::AppendPath(path, index);
+        }
+        current = value;
+        break;
+      }
+      child = nodes[value].next;
+      ++index;
+    }
+  }
+
+  if (path.empty()) return common::kPathRoot;
+  return path;
+}
+
+void LazyValue::CheckNotMissing() const {
+  if (IsMissing()) {
+    throw MemberMissingException(GetPath());
+  }
+}
+
+char LazyValue::GetFirstChar() const noexcept {
+  if (IsMissing()) return '\0';
+  return document_->text[document_->nodes[node_].begin];
+}
+
+int LazyValue::GetExtendedType() const {
+  switch (GetFirstChar()) {
+    case 'n':
+      return impl::nullValue;
+    case 't':
+    case 'f':
+      return impl::booleanValue;
+    case '"':
+      return impl::stringValue;
+    case '[':
+      return impl::arrayValue;
+    case '{':
+      return impl::objectValue;
+    default:
+      return impl::realValue;
+  }
+}
+
+void WriteToStream(const LazyValue& value, StringBuilder& sw) {
+  sw.WriteRawString(value.GetRawJson());
+}
+
+Value Serialize(const LazyValue& value, formats::serialize::To<Value>) {
+  return value.Materialize();
+}
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
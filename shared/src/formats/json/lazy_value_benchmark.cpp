@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <fmt/format.h>
+
+#include <userver/formats/json/lazy_value.hpp>
+#include <userver/formats/json/serialize.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// A request with a few fields that are read and a big payload that is not
+std::string MakeRequest(std::size_t items) {
+  std::string payload = "[";
+  for (std::size_t i = 0; i < items; ++i) {
+    if (i != 0) payload += ',';
+    payload += fmt::format(
+        R"({{"id":{},"name":"the name of the item number {}",)"
+        R"("tags":["some rather long tag","another long tag"]}})",
+        i, i);
+  }
+  payload += ']';
+
+  return fmt::format(
+      R"({{"user_id":"some-user","locale":"en","limit":10,"payload":{}}})",
+      payload);
+}
+
+}  // namespace
+
+void JsonReadFewFieldsDom(benchmark::State& state) {
+  const auto request = MakeRequest(state.range(0));
+  for (auto _ : state) {
+    const auto json = formats::json::FromString(request);
+    benchmark::DoNotOptimize(json["user_id"].As<std::string>());
+    benchmark::DoNotOptimize(json["locale"].As<std::string>());
+    benchmark::DoNotOptimize(json["limit"].As<int>());
+  }
+  state.SetBytesProcessed(state.iterations() * request.size());
+}
+BENCHMARK(JsonReadFewFieldsDom)->RangeMultiplier(10)->Range(1, 10'000);
+
+void JsonReadFewFieldsLazy(benchmark::State& state) {
+  const auto request = MakeRequest(state.range(0));
+  for (auto _ : state) {
+    const formats::json::LazyValue json{request};
+    benchmark::DoNotOptimize(json["user_id"].As<std::string>());
+    benchmark::DoNotOptimize(json["locale"].As<std::string>());
+    benchmark::DoNotOptimize(json["limit"].As<int>());
+  }
+  state.SetBytesProcessed(state.iterations() * request.size());
+}
+BENCHMARK(JsonReadFewFieldsLazy)->RangeMultiplier(10)->Range(1, 10'000);
+
+USERVER_NAMESPACE_END
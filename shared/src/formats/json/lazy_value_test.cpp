@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/lazy_value.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using formats::json::LazyValue;
+
+namespace {
+
+constexpr std::string_view kDoc = R"({
+  "id": 42,
+  "name" : "lazy",
+  "tags": [ "a", "b",  "c" ],
+  "nested": {"inner": {"value": 1.5}, "flag": true},
+  "nothing": null,
+  "escaped": "\"quoted\""
+})";
+
+}  // namespace
+
+/// [Sample formats::json::LazyValue usage]
+TEST(FormatsJsonLazyValue, Sample) {
+  const LazyValue json{std::string{kDoc}};
+
+  // only the accessed values are parsed
+  EXPECT_EQ(json["id"].As<int>(), 42);
+  EXPECT_EQ(json["nested"]["inner"]["value"].As<double>(), 1.5);
+
+  // the unread subtrees are written as is
+  formats::json::StringBuilder sb;
+  WriteToStream(json["tags"], sb);
+  EXPECT_EQ(sb.GetString(), R"([ "a", "b",  "c" ])");
+}
+/// [Sample formats::json::LazyValue usage]
+
+TEST(FormatsJsonLazyValue, Access) {
+  const LazyValue json{std::string{kDoc}};
+
+  EXPECT_TRUE(json.IsObject());
+  EXPECT_EQ(json.GetSize(), 6);
+  EXPECT_EQ(json["name"].As<std::string>(), "lazy");
+  EXPECT_EQ(json["tags"].GetSize(), 3);
+  EXPECT_EQ(json["tags"][2].As<std::string>(), "c");
+  EXPECT_EQ(json["tags"].As<std::vector<std::string>>(),
+            (std::vector<std::string>{"a", "b", "c"}));
+  EXPECT_TRUE(json["nested"]["flag"].As<bool>());
+  EXPECT_EQ(json["escaped"].As<std::string>(), "\"quoted\"");
+  EXPECT_EQ(json["escaped"].GetRawJson(), R"("\"quoted\"")");
+
+  EXPECT_TRUE(json["id"].IsNumber());
+  EXPECT_TRUE(json["name"].IsString());
+  EXPECT_TRUE(json["tags"].IsArray());
+  EXPECT_TRUE(json["nested"]["flag"].IsBool());
+  EXPECT_TRUE(json["nothing"].IsNull());
+  EXPECT_EQ(json["nothing"].GetSize(), 0);
+}
+
+TEST(FormatsJsonLazyValue, Missing) {
+  const LazyValue json{std::string{kDoc}};
+
+  EXPECT_TRUE(json.HasMember("id"));
+  EXPECT_FALSE(json.HasMember("unknown"));
+  EXPECT_TRUE(json["unknown"]["deeper"].IsMissing());
+  EXPECT_TRUE(json["nothing"]["deeper"].IsMissing());
+
+  EXPECT_EQ(json["unknown"].As<std::optional<int>>(), std::nullopt);
+  EXPECT_EQ(json["nothing"].As<std::optional<int>>(), std::nullopt);
+  EXPECT_EQ(json["unknown"].As<int>(7), 7);
+  EXPECT_EQ(json["nothing"].As<int>({}), 0);
+
+  EXPECT_THROW(json["unknown"].As<int>(),
+               formats::json::MemberMissingException);
+  EXPECT_THROW(json["unknown"].GetRawJson(),
+               formats::json::MemberMissingException);
+  EXPECT_THROW(json["id"]["key"], formats::json::TypeMismatchException);
+  EXPECT_THROW(json["tags"][3], formats::json::OutOfBoundsException);
+  EXPECT_THROW(json["name"][0], formats::json::TypeMismatchException);
+}
+
+TEST(FormatsJsonLazyValue, Path) {
+  const LazyValue json{std::string{kDoc}};
+
+  EXPECT_EQ(json.GetPath(), "/");
+  EXPECT_EQ(json["tags"][1].GetPath(), "tags[1]");
+  EXPECT_EQ(json["nested"]["inner"]["value"].GetPath(), "nested.inner.value");
+  EXPECT_EQ(json["escaped"].GetPath(), "escaped");
+  EXPECT_EQ(json["nested"]["unknown"].GetPath(), "nested.unknown");
+}
+
+TEST(FormatsJsonLazyValue, Materialize) {
+  const LazyValue json{std::string{kDoc}};
+
+  EXPECT_EQ(json.Materialize(), formats::json::FromString(kDoc));
+  EXPECT_EQ(
+      json["nested"].Materialize(),
+      formats::json::FromString(R"({"inner":{"value":1.5},"flag":true})"));
+  EXPECT_EQ(formats::json::ValueBuilder{json["id"]}.ExtractValue().As<int>(),
+            42);
+}
+
+TEST(FormatsJsonLazyValue, Scalars) {
+  EXPECT_EQ(LazyValue{" 12 "}.As<int>(), 12);
+  EXPECT_EQ(LazyValue{"-0.5e+2"}.As<double>(), -50);
+  EXPECT_EQ(LazyValue{R"(["\"a\\"])"}[0].As<std::string>(), "\"a\\");
+  EXPECT_FALSE(LazyValue{"[false]"}[0].As<bool>());
+  EXPECT_EQ(LazyValue{" 12 "}.GetRawJson(), "12");
+  EXPECT_EQ(LazyValue{"[]"}.GetSize(), 0);
+  EXPECT_EQ(LazyValue{"{}"}.GetSize(), 0);
+  EXPECT_EQ(LazyValue{"[[],{},[1]]"}[2][0].As<int>(), 1);
+}
+
+TEST(FormatsJsonLazyValue, EscapedKeys) {
+  const LazyValue json{
+      R"({"a\u0062": {"c\nd": 1}, "ab\"": 2, "\u0444\ud83d\ude00": 3})"};
+  EXPECT_EQ(json["ab"]["c\nd"].As<int>(), 1);
+  EXPECT_EQ(json["ab\""].As<int>(), 2);
+  EXPECT_EQ(json["\xd1\x84\xf0\x9f\x98\x80"].As<int>(), 3);
+  EXPECT_EQ(json["ab"]["c\nd"].GetPath(), "ab.c\nd");
+
+  EXPECT_THROW(LazyValue{R"({"ab":1,"a\u0062":2})"},
+               formats::json::ParseException);
+}
+
+TEST(FormatsJsonLazyValue, Invalid) {
+  using formats::json::ParseException;
+
+  EXPECT_THROW(LazyValue{""}, ParseException);
+  EXPECT_THROW(LazyValue{"{"}, ParseException);
+  EXPECT_THROW(LazyValue{"[1,]"}, ParseException);
+  EXPECT_THROW(LazyValue{"[1] 2"}, ParseException);
+  EXPECT_THROW(LazyValue{R"({"a":1,"b":{"c":1,"c":2}})"}, ParseException);
+  EXPECT_THROW(LazyValue{R"({"ab":1,"ab":2})"}, ParseException);
+  EXPECT_THROW(LazyValue{R"({"a":1,})"}, ParseException);
+  EXPECT_THROW(LazyValue{R"({"a" 1})"}, ParseException);
+  EXPECT_THROW(LazyValue{R"(["a" "b"])"}, ParseException);
+  EXPECT_THROW(LazyValue{R"(["\x"])"}, ParseException);
+  EXPECT_THROW(LazyValue{R"(["\u12g4"])"}, ParseException);
+  EXPECT_THROW(LazyValue{R"(["\ud800"])"}, ParseException);
+  EXPECT_THROW(LazyValue{"[\"a\nb\"]"}, ParseException);
+  EXPECT_THROW(LazyValue{R"(["abc)"}, ParseException);
+  EXPECT_THROW(LazyValue{"[01]"}, ParseException);
+  EXPECT_THROW(LazyValue{"[1.]"}, ParseException);
+  EXPECT_THROW(LazyValue{"[1e]"}, ParseException);
+  EXPECT_THROW(LazyValue{"[-]"}, ParseException);
+  EXPECT_THROW(LazyValue{"[nul]"}, ParseException);
+}
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #include <benchmark/benchmark.h>
 
 #include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/parser/parser.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/formats/json/value_builder.hpp>
 
@@ -98,6 +99,28 @@ void json_path_long_and_deeply_nested(benchmark::State& state) {
 }
 BENCHMARK(json_path_long_and_deeply_nested);
 
+void json_parse_and_access_dom(benchmark::State& state) {
+  for (auto _ : state) {
+    const auto json = formats::json::FromString(bench_json_data);
+    const auto res = (json["short"].As<std::string>() == "1");
+    benchmark::DoNotOptimize(res);
+    if (!res) throw std::runtime_error("unexpected");
+  }
+}
+BENCHMARK(json_parse_and_access_dom);
+
+void json_parse_and_access_sax(benchmark::State& state) {
+  for (auto _ : state) {
+    const auto json = formats::json::parser::ParseToType<
+        formats::json::Value, formats::json::parser::JsonValueParser>(
+        bench_json_data);
+    const auto res = (json["short"].As<std::string>() == "1");
+    benchmark::DoNotOptimize(res);
+    if (!res) throw std::runtime_error("unexpected");
+  }
+}
+BENCHMARK(json_parse_and_access_sax);
+
 formats::json::ValueBuilder Build(size_t count) {
   formats::json::ValueBuilder builder;
   for (size_t i = 0; i < count; i++) builder[std::to_string(i)] = i;
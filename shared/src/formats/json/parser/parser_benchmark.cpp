@@ -30,6 +30,22 @@ std::string BuildArray(size_t len) {
   return r;
 }
 
+// The same array as BuildArray, indented as by a pretty printer
+std::string BuildPrettyArray(size_t len) {
+  std::string r = "[\n";
+  for (size_t i = 0; i < len; i++) {
+    if (i > 0) r += ",\n";
+    r += "    [\n";
+    for (size_t j = 0; j < len; j++) {
+      if (j > 0) r += ",\n";
+      r += "        1";
+    }
+    r += "\n    ]";
+  }
+  r += "\n]";
+  return r;
+}
+
 auto ParseDom(const formats::json::Value& value) {
   return value.As<std::vector<std::vector<int64_t>>>();
 }
@@ -67,6 +83,36 @@ void JsonParseArraySax(benchmark::State& state) {
 }
 BENCHMARK(JsonParseArraySax)->RangeMultiplier(4)->Range(1, 1024);
 
+void JsonParsePrettyArrayDom(benchmark::State& state) {
+  const auto input = BuildPrettyArray(state.range(0));
+  for (auto _ : state) {
+    auto json = formats::json::FromString(input);
+    const auto res = ParseDom(json);
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(JsonParsePrettyArrayDom)->RangeMultiplier(4)->Range(1, 1024);
+
+void JsonParsePrettyArraySax(benchmark::State& state) {
+  const auto input = BuildPrettyArray(state.range(0));
+  for (auto _ : state) {
+    using Int64Parser = formats::json::parser::Int64Parser;
+    Int64Parser int_parser;
+    using ArrayParser =
+        formats::json::parser::ArrayParser<int64_t, Int64Parser>;
+
+    ArrayParser array_parser(int_parser);
+    formats::json::parser::ArrayParser<std::vector<int64_t>, ArrayParser>
+        parser(array_parser);
+    parser.Reset();
+
+    formats::json::parser::ParserState state;
+    state.PushParser(parser);
+    state.ProcessInput(input);
+  }
+}
+BENCHMARK(JsonParsePrettyArraySax)->RangeMultiplier(4)->Range(1, 1024);
+
 std::string BuildObject(size_t level) {
   if (level == 0) {
     return R"({"k": 123, "v": 1.11, "s": "some string"})";
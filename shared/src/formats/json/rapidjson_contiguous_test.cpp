@@ -7,6 +7,8 @@
 
 #include <userver/formats/json/impl/types.hpp>
 
+#include <formats/json/impl/allocator.hpp>
+
 // These tests ensure that array/object members are internally stored in plain
 // contiguous array. This assumption used in `json::Value::GetPath` to find
 // element pointer in O(1) instead of naive O(n) search.
@@ -14,7 +16,7 @@
 USERVER_NAMESPACE_BEGIN
 
 namespace {
-::rapidjson::CrtAllocator g_allocator;
+formats::json::impl::Allocator g_allocator;
 }  // namespace
 
 // Ensure contiguous allocation in rapidjson arrays
@@ -7,8 +7,10 @@
 
 #include <fmt/format.h>
 #include <rapidjson/document.h>
+#include <rapidjson/encodedstream.h>
 #include <rapidjson/error/en.h>
 #include <rapidjson/istreamwrapper.h>
+#include <rapidjson/memorystream.h>
 #include <rapidjson/ostreamwrapper.h>
 #include <rapidjson/writer.h>
 
@@ -18,6 +20,7 @@
 #include <userver/utils/assert.hpp>
 
 #include <formats/json/impl/json_tree.hpp>
+#include <formats/json/impl/key_table.hpp>
 #include <formats/json/impl/types_impl.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -26,55 +29,10 @@ namespace formats::json {
 
 namespace {
 
-::rapidjson::CrtAllocator g_allocator;
-
-std::string_view AsStringView(const impl::Value& jval) {
-  return {jval.GetString(), jval.GetStringLength()};
-}
-
-void CheckKeyUniqueness(const impl::Value* root) {
-  std::vector<impl::TreeIterFrame> stack;
-  const impl::Value* value = root;
-
-  stack.reserve(impl::kInitialStackDepth);
-  stack.emplace_back();  // fake "top" frame to avoid extra checks for an empty
-                         // stack inside walker loop
-
-  for (;;) {
-    stack.back().Advance();
-    if (value->IsObject()) {
-      // O(n²) just because our json objects are (hopefully) small
-      const int count = value->MemberCount();
-      const auto begin = value->MemberBegin();
-      for (int i = 1; i < count; i++) {
-        const std::string_view i_key = AsStringView(begin[i].name);
-        for (int j = 0; j < i; j++) {
-          const std::string_view j_key = AsStringView(begin[j].name);
-          if (i_key == j_key)
-            // TODO: add object path to message in TAXICOMMON-1658
-            throw ParseException("Duplicate key: " + std::string(i_key) +
-                                 " at " + impl::ExtractPath(stack));
-        }
-      }
-    }
-
-    if ((value->IsObject() && value->MemberCount() > 0) ||
-        (value->IsArray() && value->Size() > 0)) {
-      // descend
-      stack.emplace_back(value);
-    } else {
-      while (!stack.back().HasMoreElements()) {
-        stack.pop_back();
-        if (stack.empty()) return;
-      }
-    }
-
-    value = stack.back().CurrentValue();
-  }
-}
+impl::Allocator g_allocator;
 
 impl::VersionedValuePtr EnsureValid(impl::Document&& json) {
-  CheckKeyUniqueness(&json);
+  impl::CheckKeyUniqueness(&json);
 
   return impl::VersionedValuePtr::Create(std::move(json));
 }
@@ -116,34 +74,134 @@ bool AcceptStable(const impl::Value& origin, Handler& handler) {
   }
 }
 
-}  // namespace
+constexpr unsigned kParseFlags = rapidjson::kParseDefaultFlags |
+                                 rapidjson::kParseIterativeFlag |
+                                 rapidjson::kParseFullPrecisionFlag;
 
-Value FromString(std::string_view doc) {
+void CheckNotEmpty(std::string_view doc) {
   if (doc.empty()) {
     throw ParseException("JSON document is empty");
   }
+}
+
+[[noreturn]] void ThrowParseError(std::string_view doc,
+                                  rapidjson::ParseResult result) {
+  const auto offset = result.Offset();
+  const auto line = 1 + std::count(doc.begin(), doc.begin() + offset, '\n');
+  // Some versions of libstdc++ have runtime isues in
+  // string_view::find_last_of("\n", 0, offset) implementation.
+  const auto from_pos = doc.substr(0, offset).find_last_of('\n');
+  const auto column = offset > from_pos ? offset - from_pos : offset + 1;
+
+  throw ParseException(
+      fmt::format("JSON parse error at line {} column {}: {}", line, column,
+                  rapidjson::GetParseError_En(result.Code())));
+}
+
+void Parse(impl::Document& json, std::string_view doc) {
+  CheckNotEmpty(doc);
 
-  impl::Document json{&g_allocator};
   rapidjson::ParseResult ok =
-      json.Parse<rapidjson::kParseDefaultFlags |
-                 rapidjson::kParseIterativeFlag |
-                 rapidjson::kParseFullPrecisionFlag>(doc.data(), doc.size());
-  if (!ok) {
-    const auto offset = ok.Offset();
-    const auto line = 1 + std::count(doc.begin(), doc.begin() + offset, '\n');
-    // Some versions of libstdc++ have runtime isues in
-    // string_view::find_last_of("\n", 0, offset) implementation.
-    const auto from_pos = doc.substr(0, offset).find_last_of('\n');
-    const auto column = offset > from_pos ? offset - from_pos : offset + 1;
+      json.Parse<kParseFlags>(doc.data(), doc.size());
+  if (!ok) ThrowParseError(doc, ok);
+}
 
-    throw ParseException(
-        fmt::format("JSON parse error at line {} column {}: {}", line, column,
-                    rapidjson::GetParseError_En(ok.Code())));
+// Passes the parsed values to the document, the keys are interned
+class InterningHandler final {
+ public:
+  explicit InterningHandler(impl::Document& document) : document_(document) {}
+
+  bool Null() { return document_.Null(); }
+  bool Bool(bool value) { return document_.Bool(value); }
+  bool Int(int value) { return document_.Int(value); }
+  bool Uint(unsigned value) { return document_.Uint(value); }
+  bool Int64(int64_t value) { return document_.Int64(value); }
+  bool Uint64(uint64_t value) { return document_.Uint64(value); }
+  bool Double(double value) { return document_.Double(value); }
+
+  bool RawNumber(const char* str, rapidjson::SizeType length, bool copy) {
+    return document_.RawNumber(str, length, copy);
+  }
+
+  bool String(const char* str, rapidjson::SizeType length, bool copy) {
+    return document_.String(str, length, copy);
   }
 
+  bool Key(const char* str, rapidjson::SizeType length, bool copy) {
+    if (const char* interned = interner_.Intern({str, length})) {
+      // references the key instead of copying it
+      return document_.Key(interned, length, false);
+    }
+    return document_.Key(str, length, copy);
+  }
+
+  bool StartObject() { return document_.StartObject(); }
+  bool EndObject(rapidjson::SizeType count) {
+    return document_.EndObject(count);
+  }
+  bool StartArray() { return document_.StartArray(); }
+  bool EndArray(rapidjson::SizeType count) { return document_.EndArray(count); }
+
+ private:
+  impl::Document& document_;
+  impl::KeyInterner interner_;
+};
+
+void ParseWithInternedKeys(impl::Document& json, std::string_view doc) {
+  CheckNotEmpty(doc);
+
+  rapidjson::ParseResult ok;
+  const auto generator = [doc, &ok](impl::Document& document) {
+    rapidjson::MemoryStream memory_stream{doc.data(), doc.size()};
+    rapidjson::EncodedInputStream<impl::UTF8, rapidjson::MemoryStream> stream{
+        memory_stream};
+    InterningHandler handler{document};
+    rapidjson::GenericReader<impl::UTF8, impl::UTF8> reader;
+    ok = reader.Parse<kParseFlags>(stream, handler);
+    return !ok.IsError();
+  };
+  json.Populate(generator);
+  if (!ok) ThrowParseError(doc, ok);
+}
+
+}  // namespace
+
+Value FromString(std::string_view doc) {
+  impl::Document json{&g_allocator};
+  Parse(json, doc);
   return Value{EnsureValid(std::move(json))};
 }
 
+Value FromStringWithArena(std::string_view doc) {
+  auto root = impl::VersionedValuePtr::Create();
+  auto& arena = root.GetArena();
+  // the tree is usually about the size of the text
+  arena.Reserve(doc.size());
+
+  impl::Allocator allocator{arena};
+  impl::Document json{&allocator};
+  {
+    // rapidjson destroys the partially parsed values on errors
+    const impl::Allocator::FreeSuppressor free_suppressor;
+    Parse(json, doc);
+  }
+  *root = std::move(static_cast<impl::Value&>(json));
+
+  impl::CheckKeyUniqueness(root.Get());
+  return Value{std::move(root)};
+}
+
+Value FromStringWithInternedKeys(std::string_view doc) {
+  impl::Document json{&g_allocator};
+  ParseWithInternedKeys(json, doc);
+  return Value{EnsureValid(std::move(json))};
+}
+
+std::string_view InternKey(std::string_view key) {
+  const char* interned = impl::InternKey(key);
+  return interned ? std::string_view{interned, key.size()} : key;
+}
+
 Value FromStream(std::istream& is) {
   if (!is) {
     throw BadStreamException(is);
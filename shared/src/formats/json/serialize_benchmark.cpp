@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <fmt/format.h>
+
+#include <userver/formats/json/serialize.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string MakeDocument(std::size_t size) {
+  std::string result = "[";
+  for (std::size_t i = 0; i < size; ++i) {
+    if (i != 0) result += ',';
+    result += fmt::format(
+        R"({{"id":{},"name":"the name of the item number {}",)"
+        R"("tags":["some rather long tag","another long tag"]}})",
+        i, i);
+  }
+  result += ']';
+  return result;
+}
+
+// Objects of the same structure with the keys too long to be stored inline
+std::string MakeDocumentWithLongKeys(std::size_t size) {
+  std::string result = "[";
+  for (std::size_t i = 0; i < size; ++i) {
+    if (i != 0) result += ',';
+    result += fmt::format(
+        R"({{"identifier_of_item":{},"human_readable_name":"item {}",)"
+        R"("last_update_timestamp":{},"is_available_for_order":true}})",
+        i, i, i * 1000);
+  }
+  result += ']';
+  return result;
+}
+
+template <formats::json::Value (*Parse)(std::string_view),
+          std::string (*MakeDoc)(std::size_t) = &MakeDocument>
+void ParseAndDestroy(benchmark::State& state) {
+  const auto doc = MakeDoc(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(Parse(doc));
+  }
+  state.SetBytesProcessed(state.iterations() * doc.size());
+}
+
+}  // namespace
+
+void json_from_string(benchmark::State& state) {
+  ParseAndDestroy<&formats::json::FromString>(state);
+}
+BENCHMARK(json_from_string)->RangeMultiplier(10)->Range(10, 100'000);
+
+void json_from_string_with_arena(benchmark::State& state) {
+  ParseAndDestroy<&formats::json::FromStringWithArena>(state);
+}
+BENCHMARK(json_from_string_with_arena)->RangeMultiplier(10)->Range(10, 100'000);
+
+void json_from_string_long_keys(benchmark::State& state) {
+  ParseAndDestroy<&formats::json::FromString, &MakeDocumentWithLongKeys>(state);
+}
+BENCHMARK(json_from_string_long_keys)->RangeMultiplier(10)->Range(10, 100'000);
+
+void json_from_string_with_interned_keys(benchmark::State& state) {
+  ParseAndDestroy<&formats::json::FromStringWithInternedKeys,
+                  &MakeDocumentWithLongKeys>(state);
+}
+BENCHMARK(json_from_string_with_interned_keys)
+    ->RangeMultiplier(10)
+    ->Range(10, 100'000);
+
+template <bool kInternedKeys>
+void json_member_lookup(benchmark::State& state) {
+  const auto doc = MakeDocumentWithLongKeys(1000);
+  const auto value = kInternedKeys
+                         ? formats::json::FromStringWithInternedKeys(doc)
+                         : formats::json::FromString(doc);
+  const std::string key = "is_available_for_order";
+  const auto lookup_key = kInternedKeys ? formats::json::InternKey(key)
+                                        : std::string_view{key};
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto& item : value) {
+      benchmark::DoNotOptimize(item[lookup_key]);
+    }
+  }
+}
+BENCHMARK_TEMPLATE(json_member_lookup, false);
+BENCHMARK_TEMPLATE(json_member_lookup, true);
+
+USERVER_NAMESPACE_END
@@ -78,6 +78,102 @@ TEST(FormatsJson, ParseFromBadFile) {
   }
 }
 
+TEST(FormatsJson, FromStringWithArena) {
+  std::string doc = R"({"key":"long enough string to be allocated","arr":[)";
+  for (int i = 0; i < 10000; ++i) {
+    doc += fmt::format(R"({}{{"i":{},"s":"string number {}"}})", i ? "," : "",
+                       i, i);
+  }
+  doc += "]}";
+
+  const auto arena_value = formats::json::FromStringWithArena(doc);
+  const auto value = formats::json::FromString(doc);
+  EXPECT_EQ(arena_value, value);
+  EXPECT_EQ(formats::json::ToString(arena_value),
+            formats::json::ToString(value));
+
+  // a part of the document keeps the memory alive
+  auto element = formats::json::FromStringWithArena(doc)["arr"][9999];
+  EXPECT_EQ(element["s"].As<std::string>(), "string number 9999");
+
+  const auto truncated = doc.substr(0, doc.size() / 2);
+  EXPECT_THROW(formats::json::FromStringWithArena(truncated),
+               formats::json::ParseException);
+  EXPECT_THROW(formats::json::FromStringWithArena(
+                   R"({"a":"long string 1","a":"long string 2"})"),
+               formats::json::ParseException);
+  EXPECT_THROW(formats::json::FromStringWithArena(""),
+               formats::json::ParseException);
+}
+
+TEST(FormatsJson, FromStringWithArenaToBuilder) {
+  auto value = formats::json::FromStringWithArena(
+      R"({"key":"long enough string to be allocated","arr":[1,2]})");
+  formats::json::ValueBuilder copy{value};
+  formats::json::ValueBuilder moved{std::move(value)};
+
+  moved["arr"].PushBack(3);
+  moved["key"] = "another long enough string to be allocated";
+  moved["new"] = formats::json::FromStringWithArena(R"(["a","b"])");
+  EXPECT_EQ(moved.ExtractValue(),
+            formats::json::FromString(
+                R"({"key":"another long enough string to be allocated",)"
+                R"("arr":[1,2,3],"new":["a","b"]})"));
+
+  copy["arr"].PushBack(4);
+  EXPECT_EQ(copy.ExtractValue()["arr"], formats::json::FromString("[1,2,4]"));
+}
+
+TEST(FormatsJson, FromStringWithInternedKeys) {
+  std::string doc = "[";
+  for (int i = 0; i < 1000; ++i) {
+    doc += fmt::format(
+        R"({}{{"i":{},"long_field_name":"value {}","escaped_\"key\"":1}})",
+        i ? "," : "", i, i);
+  }
+  doc += "]";
+
+  const auto interned_value = formats::json::FromStringWithInternedKeys(doc);
+  const auto value = formats::json::FromString(doc);
+  EXPECT_EQ(interned_value, value);
+  EXPECT_EQ(formats::json::ToString(interned_value),
+            formats::json::ToString(value));
+  EXPECT_EQ(formats::json::ToStableString(interned_value),
+            formats::json::ToStableString(value));
+
+  const auto key = formats::json::InternKey("long_field_name");
+  EXPECT_EQ(key, "long_field_name");
+  EXPECT_EQ(key.data(),
+            formats::json::InternKey(std::string{"long_field_name"}).data());
+  EXPECT_EQ(interned_value[999][key].As<std::string>(), "value 999");
+  EXPECT_EQ(interned_value[999]["escaped_\"key\""].As<int>(), 1);
+  EXPECT_EQ(interned_value[0].GetSize(), 3);
+
+  // the copies refer to the shared keys
+  formats::json::ValueBuilder builder{interned_value[5]};
+  builder["i"] = 42;
+  EXPECT_EQ(builder.ExtractValue(),
+            formats::json::FromString(R"({"i":42,)"
+                                      R"("long_field_name":"value 5",)"
+                                      R"("escaped_\"key\"":1})"));
+
+  EXPECT_THROW(formats::json::FromStringWithInternedKeys(
+                   doc.substr(0, doc.size() / 2)),
+               formats::json::ParseException);
+  EXPECT_THROW(formats::json::FromStringWithInternedKeys(
+                   R"({"long_field_name":1,"long_field_name":2})"),
+               formats::json::ParseException);
+  EXPECT_THROW(formats::json::FromStringWithInternedKeys(""),
+               formats::json::ParseException);
+  EXPECT_THROW(formats::json::FromStringWithInternedKeys("[1] [2]"),
+               formats::json::ParseException);
+}
+
+TEST(FormatsJson, InternKeyShort) {
+  const std::string_view key = "short";
+  EXPECT_EQ(formats::json::InternKey(key).data(), key.data());
+}
+
 class FmtFormatterParameterized : public testing::TestWithParam<std::string> {};
 
 TEST_P(FmtFormatterParameterized, FormatsJsonFmt) {
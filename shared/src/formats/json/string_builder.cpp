@@ -1,14 +1,16 @@
 #include <userver/formats/json/string_builder.hpp>
 
 #include <cmath>
+#include <cstring>
 #include <stdexcept>
 
 #include <userver/formats/json/impl/types.hpp>
 #include <userver/formats/json/value.hpp>
-#include <userver/utils/datetime.hpp>
+#include <userver/utils/datetime/timestring.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 
 #include <formats/common/validations.hpp>
+#include <formats/json/impl/string_scan.hpp>
 
 #include <rapidjson/document.h>
 #include <rapidjson/stringbuffer.h>
@@ -18,9 +20,51 @@ USERVER_NAMESPACE_BEGIN
 
 namespace formats::json {
 
+namespace {
+
+bool HasCharsToEscape(std::string_view str) noexcept {
+#if defined(RAPIDJSON_SSE2) || defined(RAPIDJSON_NEON)
+  return impl::FindCharToEscape(str) != std::string_view::npos;
+#else
+  // Without SIMD the scan would only duplicate the one of rapidjson
+  static_cast<void>(str);
+  return true;
+#endif
+}
+
+// rapidjson::Writer that copies the data without escapes in bulk
+class Writer final : public rapidjson::Writer<rapidjson::StringBuffer> {
+ public:
+  using rapidjson::Writer<rapidjson::StringBuffer>::Writer;
+
+  void WriteString(std::string_view value) {
+    if (!value.empty() && HasCharsToEscape(value)) {
+      String(value.data(), value.size());
+      return;
+    }
+
+    Prefix(rapidjson::kStringType);
+    auto* out = os_->Push(value.size() + 2);
+    *out++ = '"';
+    if (!value.empty()) std::memcpy(out, value.data(), value.size());
+    out[value.size()] = '"';
+    EndValue(true);
+  }
+
+  void WriteRaw(std::string_view json, rapidjson::Type type) {
+    Prefix(type);
+    if (!json.empty()) {
+      std::memcpy(os_->Push(json.size()), json.data(), json.size());
+    }
+    EndValue(true);
+  }
+};
+
+}  // namespace
+
 struct StringBuilder::Impl {
   rapidjson::StringBuffer buffer;
-  rapidjson::Writer<rapidjson::StringBuffer> writer{buffer};
+  Writer writer{buffer};
 
   Impl() = default;
 };
@@ -38,10 +82,16 @@ std::string StringBuilder::GetString() const {
   return std::string{GetStringView()};
 }
 
+std::string StringBuilder::ExtractString() {
+  auto result = GetString();
+  impl_->buffer.Clear();
+  return result;
+}
+
 void StringBuilder::WriteNull() { impl_->writer.Null(); }
 
 void StringBuilder::WriteString(std::string_view value) {
-  impl_->writer.String(value.data(), value.size());
+  impl_->writer.WriteString(value);
 }
 
 void StringBuilder::WriteBool(bool value) { impl_->writer.Bool(value); }
@@ -59,8 +109,12 @@ void StringBuilder::Key(std::string_view sw) {
   impl_->writer.Key(sw.data(), sw.size());
 }
 
+void StringBuilder::RawKey(std::string_view quoted_key) {
+  impl_->writer.WriteRaw(quoted_key, rapidjson::kStringType);
+}
+
 void StringBuilder::WriteRawString(std::string_view value) {
-  impl_->writer.RawValue(value.data(), value.size(), {});
+  impl_->writer.WriteRaw(value, {});
 }
 
 void StringBuilder::WriteValue(const formats::json::Value& value) {
@@ -105,9 +159,10 @@ void WriteToStream(const std::string& value, StringBuilder& sw) {
 
 void WriteToStream(std::chrono::system_clock::time_point tp,
                    StringBuilder& sw) {
-  WriteToStream(
-      utils::datetime::Timestring(tp, "UTC", utils::datetime::kRfc3339Format),
-      sw);
+  char buffer[utils::datetime::kMaxTimestringSize];
+  const auto size = utils::datetime::TimestringInto(
+      buffer, tp, utils::datetime::TimestringFormat::kRfc3339);
+  WriteToStream(std::string_view{buffer, size}, sw);
 }
 
 StringBuilder::ObjectGuard::ObjectGuard(StringBuilder& sw) : sw_(sw) {
@@ -1,7 +1,12 @@
 #include <benchmark/benchmark.h>
 
+#include <string>
+#include <vector>
+
+#include <userver/formats/json/serialize.hpp>
 #include <userver/formats/json/string_builder.hpp>
 #include <userver/formats/json/value_builder.hpp>
+#include <userver/formats/serialize/common_containers.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -73,4 +78,66 @@ void JsonStringBuilder(benchmark::State& state) {
 }
 BENCHMARK(JsonStringBuilder)->RangeMultiplier(4)->Range(1, 1024);
 
+// Log-like records: the strings of the given length, every 8th of them needs
+// escaping
+std::vector<std::string> MakeStrings(std::size_t length) {
+  std::vector<std::string> result;
+  for (std::size_t i = 0; i < 256; ++i) {
+    std::string str(length, 'a' + i % 26);
+    if (i % 8 == 0) str[length / 2] = '"';
+    result.push_back(std::move(str));
+  }
+  return result;
+}
+
+std::vector<double> MakeDoubles() {
+  std::vector<double> result;
+  for (int i = 0; i < 256; ++i) result.push_back(i * 1.37 + 0.001 / (i + 1));
+  return result;
+}
+
+void JsonSerializeStrings(benchmark::State& state) {
+  const auto json = ValueBuilder{MakeStrings(state.range(0))}.ExtractValue();
+  for (auto _ : state) {
+    const auto res = ToString(json);
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(JsonSerializeStrings)->RangeMultiplier(4)->Range(4, 1024);
+
+void JsonStringBuilderStrings(benchmark::State& state) {
+  const auto strings = MakeStrings(state.range(0));
+  for (auto _ : state) {
+    StringBuilder sw;
+    {
+      StringBuilder::ArrayGuard guard(sw);
+      for (const auto& str : strings) sw.WriteString(str);
+    }
+    benchmark::DoNotOptimize(sw.GetStringView());
+  }
+}
+BENCHMARK(JsonStringBuilderStrings)->RangeMultiplier(4)->Range(4, 1024);
+
+void JsonSerializeDoubles(benchmark::State& state) {
+  const auto json = ValueBuilder{MakeDoubles()}.ExtractValue();
+  for (auto _ : state) {
+    const auto res = ToString(json);
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(JsonSerializeDoubles);
+
+void JsonStringBuilderDoubles(benchmark::State& state) {
+  const auto doubles = MakeDoubles();
+  for (auto _ : state) {
+    StringBuilder sw;
+    {
+      StringBuilder::ArrayGuard guard(sw);
+      for (const auto value : doubles) sw.WriteDouble(value);
+    }
+    benchmark::DoNotOptimize(sw.GetStringView());
+  }
+}
+BENCHMARK(JsonStringBuilderDoubles);
+
 USERVER_NAMESPACE_END
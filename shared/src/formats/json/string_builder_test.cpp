@@ -181,6 +181,35 @@ TEST(JsonStringBuilder, String) {
   EXPECT_EQ(sw.GetString(), "\"some string\"");
 }
 
+TEST(JsonStringBuilder, StringEscapes) {
+  for (const char special : {'"', '\\', '\n', '\x01', '\x1f'}) {
+    for (std::size_t size = 1; size < 40; ++size) {
+      for (std::size_t pos = 0; pos < size; ++pos) {
+        std::string value(size, 'a');
+        value[pos] = special;
+
+        StringBuilder sw;
+        WriteToStream(value, sw);
+        EXPECT_EQ(sw.GetString(), ToString(ValueBuilder{value}.ExtractValue()))
+            << "size=" << size << " pos=" << pos;
+        EXPECT_EQ(FromString(sw.GetString()).As<std::string>(), value);
+      }
+    }
+  }
+}
+
+TEST(JsonStringBuilder, StringWithoutEscapes) {
+  StringBuilder sw;
+  {
+    StringBuilder::ArrayGuard guard(sw);
+    WriteToStream(std::string_view{}, sw);
+    WriteToStream(std::string(40, 'a'), sw);
+    WriteToStream("\x7f\xd0\xb9", sw);
+  }
+  EXPECT_EQ(sw.GetString(),
+            "[\"\",\"" + std::string(40, 'a') + "\",\"\x7f\xd0\xb9\"]");
+}
+
 TEST(JsonStringBuilder, VectorBool) {
   std::vector<bool> v = {true, false};
   StringBuilder sw;
@@ -218,6 +247,25 @@ TEST(JsonStringBuilder, FilledOptional) {
   EXPECT_EQ(sw.GetString(), "42");
 }
 
+TEST(JsonStringBuilder, ExtractString) {
+  StringBuilder sw;
+  std::string result;
+  {
+    StringBuilder::ArrayGuard guard{sw};
+    WriteToStream(1, sw);
+    result += sw.ExtractString();
+    EXPECT_EQ(sw.GetString(), "");
+
+    WriteToStream("two", sw);
+    WriteToStream(std::vector<int>{3}, sw);
+    result += sw.ExtractString();
+  }
+  result += sw.ExtractString();
+
+  EXPECT_EQ(result, R"([1,"two",[3]])");
+  EXPECT_EQ(formats::json::FromString(result)[1].As<std::string>(), "two");
+}
+
 template <typename T>
 class JsonStringBuilderIntegralTypes : public ::testing::Test {};
 
@@ -7,7 +7,7 @@
 
 #include <userver/formats/json/exception.hpp>
 #include <userver/utils/assert.hpp>
-#include <userver/utils/datetime.hpp>
+#include <userver/utils/datetime/timestring.hpp>
 
 #include <formats/common/validations.hpp>
 #include <formats/json/impl/types_impl.hpp>
@@ -33,7 +33,7 @@ rapidjson::Type ToNativeType(Type type) {
   }
 }
 
-::rapidjson::CrtAllocator g_allocator;
+impl::Allocator g_allocator;
 
 }  // namespace
 
@@ -113,7 +113,8 @@ ValueBuilder::ValueBuilder(const formats::json::Value& other) {
 ValueBuilder::ValueBuilder(formats::json::Value&& other) {
   // As we have new native object created,
   // we fill it with the other's native object.
-  if (other.IsUniqueReference())
+  // The nodes of an arena document must stay in its arena.
+  if (other.IsUniqueReference() && !other.root_.IsArenaBacked())
     value_->GetNative() = std::move(other.GetNative());
   else
     // rapidjson uses move semantics in assignment
@@ -283,8 +284,8 @@ impl::Value& ValueBuilder::AddMember(const std::string& key,
 
 Value Serialize(std::chrono::system_clock::time_point tp,
                 formats::serialize::To<Value>) {
-  json::ValueBuilder builder =
-      utils::datetime::Timestring(tp, "UTC", utils::datetime::kRfc3339Format);
+  json::ValueBuilder builder = utils::datetime::Timestring(
+      tp, utils::datetime::TimestringFormat::kRfc3339);
   return builder.ExtractValue();
 }
 
@@ -0,0 +1,51 @@
+#include <formats/msgpack/encoder.hpp>
+
+#include <rapidjson/document.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::msgpack::impl {
+
+void WriteJson(std::string& out, const json::impl::Value& value) {
+  switch (value.GetType()) {
+    case rapidjson::kNullType:
+      WriteNil(out);
+      break;
+    case rapidjson::kFalseType:
+      WriteBool(out, false);
+      break;
+    case rapidjson::kTrueType:
+      WriteBool(out, true);
+      break;
+    case rapidjson::kNumberType:
+      if (value.IsUint64()) {
+        WriteUInt64(out, value.GetUint64());
+      } else if (value.IsInt64()) {
+        WriteInt64(out, value.GetInt64());
+      } else {
+        WriteDouble(out, value.GetDouble());
+      }
+      break;
+    case rapidjson::kStringType:
+      WriteString(out, {value.GetString(), value.GetStringLength()});
+      break;
+    case rapidjson::kArrayType:
+      WriteContainerHeader(out, value.Size(), false);
+      for (const auto& element : value.GetArray()) {
+        WriteJson(out, element);
+      }
+      break;
+    case rapidjson::kObjectType:
+      WriteContainerHeader(out, value.MemberCount(), true);
+      for (const auto& member : value.GetObject()) {
+        WriteString(out, {member.name.GetString(),
+                          member.name.GetStringLength()});
+        WriteJson(out, member.value);
+      }
+      break;
+  }
+}
+
+}  // namespace formats::msgpack::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <boost/endian/conversion.hpp>
+
+#include <userver/formats/json/impl/types.hpp>
+#include <userver/formats/json/value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::msgpack::impl {
+
+// https://github.com/msgpack/msgpack/blob/master/spec.md
+namespace marker {
+inline constexpr std::uint8_t kPositiveFixint = 0x00;
+inline constexpr std::uint8_t kFixmap = 0x80;
+inline constexpr std::uint8_t kFixarray = 0x90;
+inline constexpr std::uint8_t kFixstr = 0xa0;
+inline constexpr std::uint8_t kNil = 0xc0;
+inline constexpr std::uint8_t kNeverUsed = 0xc1;
+inline constexpr std::uint8_t kFalse = 0xc2;
+inline constexpr std::uint8_t kTrue = 0xc3;
+inline constexpr std::uint8_t kBin8 = 0xc4;
+inline constexpr std::uint8_t kBin16 = 0xc5;
+inline constexpr std::uint8_t kBin32 = 0xc6;
+inline constexpr std::uint8_t kExt8 = 0xc7;
+inline constexpr std::uint8_t kExt16 = 0xc8;
+inline constexpr std::uint8_t kExt32 = 0xc9;
+inline constexpr std::uint8_t kFloat32 = 0xca;
+inline constexpr std::uint8_t kFloat64 = 0xcb;
+inline constexpr std::uint8_t kUint8 = 0xcc;
+inline constexpr std::uint8_t kUint16 = 0xcd;
+inline constexpr std::uint8_t kUint32 = 0xce;
+inline constexpr std::uint8_t kUint64 = 0xcf;
+inline constexpr std::uint8_t kInt8 = 0xd0;
+inline constexpr std::uint8_t kInt16 = 0xd1;
+inline constexpr std::uint8_t kInt32 = 0xd2;
+inline constexpr std::uint8_t kInt64 = 0xd3;
+inline constexpr std::uint8_t kFixext1 = 0xd4;
+inline constexpr std::uint8_t kFixext16 = 0xd8;
+inline constexpr std::uint8_t kStr8 = 0xd9;
+inline constexpr std::uint8_t kStr16 = 0xda;
+inline constexpr std::uint8_t kStr32 = 0xdb;
+inline constexpr std::uint8_t kArray16 = 0xdc;
+inline constexpr std::uint8_t kArray32 = 0xdd;
+inline constexpr std::uint8_t kMap16 = 0xde;
+inline constexpr std::uint8_t kMap32 = 0xdf;
+inline constexpr std::uint8_t kNegativeFixint = 0xe0;
+}  // namespace marker
+
+/// Size of the array32/map32 header, the longest container header
+inline constexpr std::size_t kMaxContainerHeaderSize = 5;
+
+/// Access to the internals of formats::json::Value
+struct JsonAccess final {
+  static const json::impl::Value& GetNative(const json::Value& value) {
+    return value.GetNative();
+  }
+
+  static json::Value MakeValue(json::impl::VersionedValuePtr root) {
+    return json::Value{std::move(root)};
+  }
+};
+
+template <typename T>
+void AppendWithMarker(std::string& out, std::uint8_t marker, T value) {
+  char buffer[1 + sizeof(T)];
+  buffer[0] = static_cast<char>(marker);
+  value = boost::endian::native_to_big(value);
+  std::memcpy(buffer + 1, &value, sizeof(T));
+  out.append(buffer, sizeof(buffer));
+}
+
+inline void AppendMarker(std::string& out, std::uint8_t marker) {
+  out.push_back(static_cast<char>(marker));
+}
+
+inline void WriteNil(std::string& out) { AppendMarker(out, marker::kNil); }
+
+inline void WriteBool(std::string& out, bool value) {
+  AppendMarker(out, value ? marker::kTrue : marker::kFalse);
+}
+
+inline void WriteUInt64(std::string& out, std::uint64_t value) {
+  if (value < 0x80) {
+    AppendMarker(out,
+                 marker::kPositiveFixint | static_cast<std::uint8_t>(value));
+  } else if (value <= UINT8_MAX) {
+    AppendWithMarker(out, marker::kUint8, static_cast<std::uint8_t>(value));
+  } else if (value <= UINT16_MAX) {
+    AppendWithMarker(out, marker::kUint16, static_cast<std::uint16_t>(value));
+  } else if (value <= UINT32_MAX) {
+    AppendWithMarker(out, marker::kUint32, static_cast<std::uint32_t>(value));
+  } else {
+    AppendWithMarker(out, marker::kUint64, value);
+  }
+}
+
+inline void WriteInt64(std::string& out, std::int64_t value) {
+  if (value >= 0) {
+    WriteUInt64(out, static_cast<std::uint64_t>(value));
+  } else if (value >= -32) {
+    AppendMarker(out, static_cast<std::uint8_t>(value));
+  } else if (value >= INT8_MIN) {
+    AppendWithMarker(
+        out, marker::kInt8,
+        static_cast<std::uint8_t>(static_cast<std::int8_t>(value)));
+  } else if (value >= INT16_MIN) {
+    AppendWithMarker(
+        out, marker::kInt16,
+        static_cast<std::uint16_t>(static_cast<std::int16_t>(value)));
+  } else if (value >= INT32_MIN) {
+    AppendWithMarker(
+        out, marker::kInt32,
+        static_cast<std::uint32_t>(static_cast<std::int32_t>(value)));
+  } else {
+    AppendWithMarker(out, marker::kInt64, static_cast<std::uint64_t>(value));
+  }
+}
+
+inline void WriteDouble(std::string& out, double value) {
+  std::uint64_t bits{};
+  std::memcpy(&bits, &value, sizeof(bits));
+  AppendWithMarker(out, marker::kFloat64, bits);
+}
+
+inline void WriteString(std::string& out, std::string_view value) {
+  const auto size = value.size();
+  if (size < 32) {
+    AppendMarker(out, marker::kFixstr | static_cast<std::uint8_t>(size));
+  } else if (size <= UINT8_MAX) {
+    AppendWithMarker(out, marker::kStr8, static_cast<std::uint8_t>(size));
+  } else if (size <= UINT16_MAX) {
+    AppendWithMarker(out, marker::kStr16, static_cast<std::uint16_t>(size));
+  } else {
+    AppendWithMarker(out, marker::kStr32, static_cast<std::uint32_t>(size));
+  }
+  out.append(value);
+}
+
+inline void WriteContainerHeader(std::string& out, std::uint32_t size,
+                                 bool is_object) {
+  if (size < 16) {
+    AppendMarker(out, (is_object ? marker::kFixmap : marker::kFixarray) |
+                          static_cast<std::uint8_t>(size));
+  } else if (size <= UINT16_MAX) {
+    AppendWithMarker(out, is_object ? marker::kMap16 : marker::kArray16,
+                     static_cast<std::uint16_t>(size));
+  } else {
+    AppendWithMarker(out, is_object ? marker::kMap32 : marker::kArray32, size);
+  }
+}
+
+/// Writes the JSON tree in the shortest encoding
+void WriteJson(std::string& out, const json::impl::Value& value);
+
+}  // namespace formats::msgpack::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,290 @@
+#include <userver/formats/msgpack/serialize.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <boost/endian/conversion.hpp>
+#include <fmt/format.h>
+#include <rapidjson/document.h>
+
+#include <userver/formats/json/exception.hpp>
+
+#include <formats/json/impl/allocator.hpp>
+#include <formats/json/impl/json_tree.hpp>
+#include <formats/msgpack/encoder.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::msgpack {
+
+namespace {
+
+json::impl::Allocator g_allocator;
+
+/// rapidjson generator that reads MessagePack without recursion
+class Reader final {
+ public:
+  explicit Reader(std::string_view data) : data_(data) {}
+
+  template <typename Handler>
+  bool operator()(Handler& handler) {
+    std::vector<Frame> stack;
+    bool expect_key = false;
+
+    for (;;) {
+      const auto offset = pos_;
+      const auto marker = ReadByte();
+
+      if (expect_key) {
+        const auto key = ReadString(marker, offset);
+        handler.Key(key.data(), key.size(), true);
+        expect_key = false;
+        continue;
+      }
+
+      std::uint32_t size = 0;
+      bool is_object = false;
+      if (ReadContainerHeader(marker, size, is_object)) {
+        if (is_object) {
+          handler.StartObject();
+        } else {
+          handler.StartArray();
+        }
+        if (size > 0) {
+          stack.push_back({size, size, is_object});
+          expect_key = is_object;
+          continue;
+        }
+        if (is_object) {
+          handler.EndObject(0);
+        } else {
+          handler.EndArray(0);
+        }
+      } else {
+        ReadScalar(marker, offset, handler);
+      }
+
+      // the value is complete, close the containers that are complete too
+      for (;;) {
+        if (stack.empty()) {
+          if (pos_ != data_.size()) Fail(pos_, "unexpected data after value");
+          return true;
+        }
+        auto& top = stack.back();
+        if (--top.remaining > 0) {
+          expect_key = top.is_object;
+          break;
+        }
+        if (top.is_object) {
+          handler.EndObject(top.size);
+        } else {
+          handler.EndArray(top.size);
+        }
+        stack.pop_back();
+      }
+    }
+  }
+
+ private:
+  struct Frame {
+    std::uint32_t size;
+    std::uint32_t remaining;
+    bool is_object;
+  };
+
+  [[noreturn]] static void Fail(std::size_t offset, std::string_view message) {
+    throw json::ParseException(fmt::format(
+        "MessagePack parse error at offset {}: {}", offset, message));
+  }
+
+  void CheckAvailable(std::size_t size) const {
+    if (data_.size() - pos_ < size) Fail(pos_, "unexpected end of data");
+  }
+
+  std::uint8_t ReadByte() {
+    CheckAvailable(1);
+    return static_cast<std::uint8_t>(data_[pos_++]);
+  }
+
+  template <typename T>
+  T ReadBigEndian() {
+    CheckAvailable(sizeof(T));
+    T value{};
+    std::memcpy(&value, data_.data() + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return boost::endian::big_to_native(value);
+  }
+
+  std::string_view ReadBytes(std::size_t size) {
+    CheckAvailable(size);
+    const auto result = data_.substr(pos_, size);
+    pos_ += size;
+    return result;
+  }
+
+  std::string_view ReadString(std::uint8_t marker, std::size_t offset) {
+    if ((marker & 0xe0) == impl::marker::kFixstr) {
+      return ReadBytes(marker & 0x1f);
+    }
+    switch (marker) {
+      case impl::marker::kStr8:
+      case impl::marker::kBin8:
+        return ReadBytes(ReadBigEndian<std::uint8_t>());
+      case impl::marker::kStr16:
+      case impl::marker::kBin16:
+        return ReadBytes(ReadBigEndian<std::uint16_t>());
+      case impl::marker::kStr32:
+      case impl::marker::kBin32:
+        return ReadBytes(ReadBigEndian<std::uint32_t>());
+      default:
+        Fail(offset, "object keys must be strings");
+    }
+  }
+
+  bool ReadContainerHeader(std::uint8_t marker, std::uint32_t& size,
+                           bool& is_object) {
+    if ((marker & 0xf0) == impl::marker::kFixmap ||
+        (marker & 0xf0) == impl::marker::kFixarray) {
+      size = marker & 0x0f;
+      is_object = (marker & 0xf0) == impl::marker::kFixmap;
+      return true;
+    }
+    switch (marker) {
+      case impl::marker::kArray16:
+      case impl::marker::kMap16:
+        size = ReadBigEndian<std::uint16_t>();
+        is_object = marker == impl::marker::kMap16;
+        return true;
+      case impl::marker::kArray32:
+      case impl::marker::kMap32:
+        size = ReadBigEndian<std::uint32_t>();
+        is_object = marker == impl::marker::kMap32;
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  template <typename Handler>
+  void ReadScalar(std::uint8_t marker, std::size_t offset, Handler& handler) {
+    if (marker < 0x80) {
+      handler.Uint64(marker);
+      return;
+    }
+    if (marker >= impl::marker::kNegativeFixint) {
+      handler.Int64(static_cast<std::int8_t>(marker));
+      return;
+    }
+    if ((marker & 0xe0) == impl::marker::kFixstr) {
+      const auto value = ReadBytes(marker & 0x1f);
+      handler.String(value.data(), value.size(), true);
+      return;
+    }
+
+    switch (marker) {
+      case impl::marker::kNil:
+        handler.Null();
+        return;
+      case impl::marker::kFalse:
+        handler.Bool(false);
+        return;
+      case impl::marker::kTrue:
+        handler.Bool(true);
+        return;
+      case impl::marker::kUint8:
+        handler.Uint64(ReadBigEndian<std::uint8_t>());
+        return;
+      case impl::marker::kUint16:
+        handler.Uint64(ReadBigEndian<std::uint16_t>());
+        return;
+      case impl::marker::kUint32:
+        handler.Uint64(ReadBigEndian<std::uint32_t>());
+        return;
+      case impl::marker::kUint64:
+        handler.Uint64(ReadBigEndian<std::uint64_t>());
+        return;
+      case impl::marker::kInt8:
+        handler.Int64(static_cast<std::int8_t>(ReadBigEndian<std::uint8_t>()));
+        return;
+      case impl::marker::kInt16:
+        handler.Int64(
+            static_cast<std::int16_t>(ReadBigEndian<std::uint16_t>()));
+        return;
+      case impl::marker::kInt32:
+        handler.Int64(
+            static_cast<std::int32_t>(ReadBigEndian<std::uint32_t>()));
+        return;
+      case impl::marker::kInt64:
+        handler.Int64(
+            static_cast<std::int64_t>(ReadBigEndian<std::uint64_t>()));
+        return;
+      case impl::marker::kFloat32: {
+        const auto bits = ReadBigEndian<std::uint32_t>();
+        float value{};
+        std::memcpy(&value, &bits, sizeof(value));
+        handler.Double(CheckFinite(value, offset));
+        return;
+      }
+      case impl::marker::kFloat64: {
+        const auto bits = ReadBigEndian<std::uint64_t>();
+        double value{};
+        std::memcpy(&value, &bits, sizeof(value));
+        handler.Double(CheckFinite(value, offset));
+        return;
+      }
+      case impl::marker::kStr8:
+      case impl::marker::kStr16:
+      case impl::marker::kStr32:
+      case impl::marker::kBin8:
+      case impl::marker::kBin16:
+      case impl::marker::kBin32: {
+        const auto value = ReadString(marker, offset);
+        handler.String(value.data(), value.size(), true);
+        return;
+      }
+      case impl::marker::kNeverUsed:
+        Fail(offset, "invalid marker 0xc1");
+      default:
+        // kExt8..kExt32 and kFixext1..kFixext16
+        Fail(offset, "extension types are not supported");
+    }
+  }
+
+  static double CheckFinite(double value, std::size_t offset) {
+    if (!std::isfinite(value)) {
+      Fail(offset, "non-finite floats are not supported");
+    }
+    return value;
+  }
+
+  const std::string_view data_;
+  std::size_t pos_{0};
+};
+
+}  // namespace
+
+formats::json::Value FromBinaryString(std::string_view data) {
+  if (data.empty()) {
+    throw json::ParseException("MessagePack document is empty");
+  }
+
+  json::impl::Document document{&g_allocator};
+  Reader reader{data};
+  document.Populate(reader);
+  json::impl::CheckKeyUniqueness(&document);
+
+  return impl::JsonAccess::MakeValue(
+      json::impl::VersionedValuePtr::Create(std::move(document)));
+}
+
+std::string ToBinaryString(const formats::json::Value& value) {
+  std::string result;
+  impl::WriteJson(result, impl::JsonAccess::GetNative(value));
+  return result;
+}
+
+}  // namespace formats::msgpack
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <fmt/format.h>
+
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/formats/msgpack/serialize.hpp>
+#include <userver/formats/msgpack/string_builder.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+formats::json::Value MakeDocument(std::size_t size) {
+  std::string result = "[";
+  for (std::size_t i = 0; i < size; ++i) {
+    if (i != 0) result += ',';
+    result += fmt::format(
+        R"({{"id":{},"name":"the name of the item number {}",)"
+        R"("price":{}.25,"count":{},"available":true,)"
+        R"("tags":["some rather long tag","another long tag"]}})",
+        i * 1000, i, i, i % 7);
+  }
+  result += ']';
+  return formats::json::FromString(result);
+}
+
+template <typename StringBuilder>
+std::string WriteDocument(std::size_t size) {
+  StringBuilder sb;
+  {
+    typename StringBuilder::ArrayGuard array{sb};
+    for (std::size_t i = 0; i < size; ++i) {
+      typename StringBuilder::ObjectGuard object{sb};
+      sb.Key("id");
+      WriteToStream(i * 1000, sb);
+      sb.Key("name");
+      WriteToStream("the name of the item", sb);
+      sb.Key("price");
+      WriteToStream(i + 0.25, sb);
+      sb.Key("tags");
+      typename StringBuilder::ArrayGuard tags{sb};
+      WriteToStream("some rather long tag", sb);
+      WriteToStream("another long tag", sb);
+    }
+  }
+  return sb.GetString();
+}
+
+}  // namespace
+
+void json_parse(benchmark::State& state) {
+  const auto doc = formats::json::ToString(MakeDocument(state.range(0)));
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(formats::json::FromString(doc));
+  }
+  state.counters["size"] = doc.size();
+}
+BENCHMARK(json_parse)->RangeMultiplier(10)->Range(10, 10'000);
+
+void msgpack_parse(benchmark::State& state) {
+  const auto doc =
+      formats::msgpack::ToBinaryString(MakeDocument(state.range(0)));
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(formats::msgpack::FromBinaryString(doc));
+  }
+  state.counters["size"] = doc.size();
+}
+BENCHMARK(msgpack_parse)->RangeMultiplier(10)->Range(10, 10'000);
+
+void json_serialize(benchmark::State& state) {
+  const auto value = MakeDocument(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(formats::json::ToString(value));
+  }
+}
+BENCHMARK(json_serialize)->RangeMultiplier(10)->Range(10, 10'000);
+
+void msgpack_serialize(benchmark::State& state) {
+  const auto value = MakeDocument(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(formats::msgpack::ToBinaryString(value));
+  }
+}
+BENCHMARK(msgpack_serialize)->RangeMultiplier(10)->Range(10, 10'000);
+
+void json_string_builder(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(
+        WriteDocument<formats::json::StringBuilder>(state.range(0)));
+  }
+}
+BENCHMARK(json_string_builder)->RangeMultiplier(10)->Range(10, 10'000);
+
+void msgpack_string_builder(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(
+        WriteDocument<formats::msgpack::StringBuilder>(state.range(0)));
+  }
+}
+BENCHMARK(msgpack_string_builder)->RangeMultiplier(10)->Range(10, 10'000);
+
+USERVER_NAMESPACE_END
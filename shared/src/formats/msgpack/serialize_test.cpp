@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/formats/msgpack/serialize.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+#include <userver/formats/serialize/common_containers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using formats::json::ParseException;
+using formats::msgpack::FromBinaryString;
+using formats::msgpack::ToBinaryString;
+
+namespace {
+
+using namespace std::string_literals;
+
+std::string Encode(std::string_view json) {
+  return ToBinaryString(formats::json::FromString(json));
+}
+
+}  // namespace
+
+TEST(FormatsMsgpack, Encoding) {
+  EXPECT_EQ(Encode("null"), "\xc0");
+  EXPECT_EQ(Encode("[true,false]"), "\x92\xc3\xc2");
+  EXPECT_EQ(Encode(R"({"a":1})"), "\x81\xa1" "a\x01");
+  EXPECT_EQ(Encode("127"), "\x7f");
+  EXPECT_EQ(Encode("128"), "\xcc\x80");
+  EXPECT_EQ(Encode("65536"), "\xce\x00\x01\x00\x00"s);
+  EXPECT_EQ(Encode("18446744073709551615"),
+            "\xcf\xff\xff\xff\xff\xff\xff\xff\xff");
+  EXPECT_EQ(Encode("-1"), "\xff");
+  EXPECT_EQ(Encode("-32"), "\xe0");
+  EXPECT_EQ(Encode("-33"), "\xd0\xdf");
+  EXPECT_EQ(Encode("-129"), "\xd1\xff\x7f");
+  EXPECT_EQ(Encode("1.5"), "\xcb\x3f\xf8\x00\x00\x00\x00\x00\x00"s);
+  EXPECT_EQ(Encode(R"("")"), "\xa0");
+  EXPECT_EQ(Encode('"' + std::string(32, 'x') + '"'),
+            "\xd9\x20" + std::string(32, 'x'));
+  EXPECT_EQ(Encode("[0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0]"),
+            "\xdc\x00\x10"s + std::string(16, '\0'));
+}
+
+TEST(FormatsMsgpack, RoundTrip) {
+  const auto json = formats::json::FromString(R"({
+    "int": -100000, "uint": 4294967296, "double": -0.25, "empty": {},
+    "string": "строка с \"кавычками\"",
+    "nested": [[], [null, {"a": [1]}]],
+    "min": -9223372036854775808, "max": 18446744073709551615
+  })");
+  const auto binary = ToBinaryString(json);
+  EXPECT_LT(binary.size(), formats::json::ToString(json).size());
+
+  const auto parsed = FromBinaryString(binary);
+  EXPECT_EQ(parsed, json);
+  EXPECT_EQ(parsed["min"].As<std::int64_t>(),
+            std::numeric_limits<std::int64_t>::min());
+  EXPECT_EQ(parsed["max"].As<std::uint64_t>(),
+            std::numeric_limits<std::uint64_t>::max());
+  EXPECT_EQ(parsed["nested"][1][1]["a"].GetPath(), "nested[1][1].a");
+}
+
+TEST(FormatsMsgpack, ExistingSerializers) {
+  using Data = std::map<std::string, std::vector<int>>;
+  const Data data{{"a", {1, 2}}, {"b", {}}};
+
+  const auto binary =
+      ToBinaryString(formats::json::ValueBuilder{data}.ExtractValue());
+  EXPECT_EQ(FromBinaryString(binary).As<Data>(), data);
+}
+
+TEST(FormatsMsgpack, Decoding) {
+  EXPECT_EQ(FromBinaryString("\xca\x3f\xc0\x00\x00"s).As<double>(), 1.5);
+  EXPECT_EQ(FromBinaryString("\xc4\x02\x00\x01"s).As<std::string>(),
+            "\x00\x01"s);
+  EXPECT_EQ(FromBinaryString("\xd3\xff\xff\xff\xff\xff\xff\xff\xfe"s)
+                .As<std::int64_t>(),
+            -2);
+  EXPECT_EQ(FromBinaryString("\xdf\x00\x00\x00\x01\xa1k\x90"s),
+            formats::json::FromString(R"({"k":[]})"));
+}
+
+TEST(FormatsMsgpack, Invalid) {
+  EXPECT_THROW(FromBinaryString(""), ParseException);
+  EXPECT_THROW(FromBinaryString("\x92\xc0"), ParseException);
+  EXPECT_THROW(FromBinaryString("\xa2x"), ParseException);
+  EXPECT_THROW(FromBinaryString("\xcd\x01"), ParseException);
+  EXPECT_THROW(FromBinaryString("\xc0\xc0"), ParseException);
+  EXPECT_THROW(FromBinaryString("\xc1"), ParseException);
+  EXPECT_THROW(FromBinaryString("\xd4\x01\x00"s), ParseException);
+  EXPECT_THROW(FromBinaryString("\x81\x01\x01"), ParseException);
+  EXPECT_THROW(FromBinaryString("\x82\xa1k\x01\xa1k\x02"), ParseException);
+  EXPECT_THROW(FromBinaryString("\xcb\x7f\xf8\x00\x00\x00\x00\x00\x00"s),
+               ParseException);
+  EXPECT_THROW(FromBinaryString("\xdd\xff\xff\xff\xff"), ParseException);
+}
+
+USERVER_NAMESPACE_END
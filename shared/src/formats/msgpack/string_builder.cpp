@@ -0,0 +1,159 @@
+#include <userver/formats/msgpack/string_builder.hpp>
+
+#include <limits>
+#include <stdexcept>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/datetime/timestring.hpp>
+
+#include <formats/common/validations.hpp>
+#include <formats/msgpack/encoder.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::msgpack {
+
+StringBuilder::StringBuilder() = default;
+
+StringBuilder::~StringBuilder() = default;
+
+StringBuilder::ObjectGuard::ObjectGuard(StringBuilder& sw) : sw_(sw) {
+  sw_.StartContainer(true);
+}
+
+StringBuilder::ObjectGuard::~ObjectGuard() { sw_.EndContainer(); }
+
+StringBuilder::ArrayGuard::ArrayGuard(StringBuilder& sw) : sw_(sw) {
+  sw_.StartContainer(false);
+}
+
+StringBuilder::ArrayGuard::~ArrayGuard() { sw_.EndContainer(); }
+
+std::string StringBuilder::GetString() const {
+  UASSERT_MSG(open_.empty(), "Not all the arrays and objects are finished");
+
+  // Replaces the reserved container headers with the shortest ones
+  std::string result;
+  result.reserve(data_.size());
+  std::size_t pos = 0;
+  for (const auto& container : containers_) {
+    result.append(data_, pos, container.header_pos - pos);
+    impl::WriteContainerHeader(result, container.size, container.is_object);
+    pos = container.header_pos + impl::kMaxContainerHeaderSize;
+  }
+  result.append(data_, pos, std::string::npos);
+  return result;
+}
+
+void StringBuilder::WriteNull() {
+  OnValue();
+  impl::WriteNil(data_);
+}
+
+void StringBuilder::WriteString(std::string_view value) {
+  OnValue();
+  impl::WriteString(data_, value);
+}
+
+void StringBuilder::WriteBool(bool value) {
+  OnValue();
+  impl::WriteBool(data_, value);
+}
+
+void StringBuilder::WriteInt64(int64_t value) {
+  OnValue();
+  impl::WriteInt64(data_, value);
+}
+
+void StringBuilder::WriteUInt64(uint64_t value) {
+  OnValue();
+  impl::WriteUInt64(data_, value);
+}
+
+void StringBuilder::WriteDouble(double value) {
+  formats::common::ValidateFloat<std::runtime_error>(value);
+  OnValue();
+  impl::WriteDouble(data_, value);
+}
+
+void StringBuilder::Key(std::string_view key) {
+  UASSERT_MSG(!open_.empty() && containers_[open_.back()].is_object,
+              "Key() may be called only inside an object");
+  ++containers_[open_.back()].size;
+  impl::WriteString(data_, key);
+}
+
+void StringBuilder::WriteValue(const Value& value) {
+  OnValue();
+  impl::WriteJson(data_, impl::JsonAccess::GetNative(value));
+}
+
+void StringBuilder::StartContainer(bool is_object) {
+  OnValue();
+  open_.push_back(containers_.size());
+  containers_.push_back({data_.size(), 0, is_object});
+  data_.append(impl::kMaxContainerHeaderSize, '\0');
+}
+
+void StringBuilder::EndContainer() {
+  UASSERT(!open_.empty());
+  open_.pop_back();
+}
+
+void StringBuilder::OnValue() {
+  if (open_.empty()) return;
+  auto& container = containers_[open_.back()];
+  if (!container.is_object) {
+    UASSERT_MSG(container.size < std::numeric_limits<std::uint32_t>::max(),
+                "Too many elements in the array");
+    ++container.size;
+  }
+}
+
+void WriteToStream(bool value, StringBuilder& sw) { sw.WriteBool(value); }
+
+void WriteToStream(long long value, StringBuilder& sw) { sw.WriteInt64(value); }
+
+void WriteToStream(unsigned long long value, StringBuilder& sw) {
+  sw.WriteUInt64(value);
+}
+
+void WriteToStream(int value, StringBuilder& sw) { sw.WriteInt64(value); }
+
+void WriteToStream(unsigned value, StringBuilder& sw) { sw.WriteUInt64(value); }
+
+void WriteToStream(long value, StringBuilder& sw) { sw.WriteInt64(value); }
+
+void WriteToStream(unsigned long value, StringBuilder& sw) {
+  sw.WriteUInt64(value);
+}
+
+void WriteToStream(double value, StringBuilder& sw) { sw.WriteDouble(value); }
+
+void WriteToStream(const char* value, StringBuilder& sw) {
+  WriteToStream(std::string_view{value}, sw);
+}
+
+void WriteToStream(std::string_view value, StringBuilder& sw) {
+  sw.WriteString(value);
+}
+
+void WriteToStream(const formats::json::Value& value, StringBuilder& sw) {
+  sw.WriteValue(value);
+}
+
+void WriteToStream(const std::string& value, StringBuilder& sw) {
+  WriteToStream(std::string_view{value}, sw);
+}
+
+void WriteToStream(std::chrono::system_clock::time_point tp,
+                   StringBuilder& sw) {
+  char buffer[utils::datetime::kMaxTimestringSize];
+  const auto size = utils::datetime::TimestringInto(
+      buffer, tp, utils::datetime::TimestringFormat::kRfc3339);
+  WriteToStream(std::string_view{buffer, size}, sw);
+}
+
+}  // namespace formats::msgpack
+
+USERVER_NAMESPACE_END
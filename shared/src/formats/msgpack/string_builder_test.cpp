@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/formats/msgpack/serialize.hpp>
+#include <userver/formats/msgpack/string_builder.hpp>
+#include <userver/formats/serialize/common_containers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using formats::msgpack::FromBinaryString;
+using formats::msgpack::StringBuilder;
+
+namespace {
+
+struct Item {
+  int id;
+  std::string name;
+};
+
+// Only the DOM serializer, as the most of the existing types have
+formats::json::Value Serialize(const Item& item,
+                               formats::serialize::To<formats::json::Value>) {
+  formats::json::ValueBuilder builder;
+  builder["id"] = item.id;
+  builder["name"] = item.name;
+  return builder.ExtractValue();
+}
+
+std::string WriteArray(std::size_t size) {
+  StringBuilder sb;
+  {
+    StringBuilder::ArrayGuard guard{sb};
+    for (std::size_t i = 0; i < size; ++i) WriteToStream(i, sb);
+  }
+  return sb.GetString();
+}
+
+}  // namespace
+
+/// [Sample formats::msgpack::StringBuilder usage]
+TEST(FormatsMsgpackStringBuilder, Sample) {
+  StringBuilder sb;
+  {
+    StringBuilder::ObjectGuard guard{sb};
+    sb.Key("ids");
+    WriteToStream(std::vector<int>{1, 2, 3}, sb);
+    sb.Key("item");
+    WriteToStream(Item{42, "answer"}, sb);
+  }
+  const std::string binary = sb.GetString();
+
+  EXPECT_EQ(FromBinaryString(binary), formats::json::FromString(R"({
+    "ids": [1, 2, 3], "item": {"id": 42, "name": "answer"}
+  })"));
+}
+/// [Sample formats::msgpack::StringBuilder usage]
+
+TEST(FormatsMsgpackStringBuilder, SameAsDom) {
+  const auto json = formats::json::FromString(
+      R"({"a": [0.5, -7, "x", null, true, {}], "b": {"c": []}})");
+
+  StringBuilder sb;
+  {
+    StringBuilder::ObjectGuard guard{sb};
+    sb.Key("a");
+    {
+      StringBuilder::ArrayGuard array{sb};
+      sb.WriteDouble(0.5);
+      sb.WriteInt64(-7);
+      sb.WriteString("x");
+      WriteToStream(std::optional<int>{}, sb);
+      sb.WriteBool(true);
+      StringBuilder::ObjectGuard empty{sb};
+    }
+    sb.Key("b");
+    WriteToStream(json["b"], sb);
+  }
+
+  EXPECT_EQ(sb.GetString(), formats::msgpack::ToBinaryString(json));
+}
+
+TEST(FormatsMsgpackStringBuilder, ContainerHeaders) {
+  EXPECT_EQ(WriteArray(0), "\x90");
+  EXPECT_EQ(WriteArray(15).substr(0, 1), "\x9f");
+  EXPECT_EQ(WriteArray(16).substr(0, 3), std::string_view("\xdc\x00\x10", 3));
+  EXPECT_EQ(WriteArray(70000).substr(0, 5),
+            std::string_view("\xdd\x00\x01\x11\x70", 5));
+  EXPECT_EQ(FromBinaryString(WriteArray(70000)).GetSize(), 70000);
+}
+
+USERVER_NAMESPACE_END
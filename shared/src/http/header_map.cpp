@@ -0,0 +1,216 @@
+#include <userver/http/header_map.hpp>
+
+#include <userver/http/common_headers.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace http::headers {
+
+namespace {
+
+// In the order of PredefinedHeader
+constexpr std::string_view kPredefinedNames[] = {
+    kHost,
+    kUserAgent,
+    kAccept,
+    kAcceptEncoding,
+    kAcceptLanguage,
+    kAuthorization,
+    kConnection,
+    kContentEncoding,
+    kContentLength,
+    kContentType,
+    kCookie,
+    kReferer,
+    kXForwardedFor,
+    kXRealIp,
+    kXRequestId,
+    kXYaRequestId,
+    kXYaTraceId,
+    kXYaSpanId,
+    kXYaSampled,
+    kXYaTaxiClientTimeoutMs,
+    kApiKey,
+};
+static_assert(std::size(kPredefinedNames) == kPredefinedHeadersCount);
+
+constexpr std::size_t kPerfectTableSize = 64;
+constexpr std::uint8_t kNoPredefined = 0xFF;
+
+constexpr char ToLower(char c) noexcept {
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c | 32) : c;
+}
+
+// The multipliers are picked to have no collisions for kPredefinedNames, see
+// the static_assert below. `name` must not be empty.
+constexpr std::size_t PerfectHash(std::string_view name) noexcept {
+  return (name.size() * 5 + ToLower(name.back()) * 49 +
+          ToLower(name[name.size() / 2])) %
+         kPerfectTableSize;
+}
+
+constexpr auto MakePerfectTable() noexcept {
+  std::array<std::uint8_t, kPerfectTableSize> table{};
+  for (auto& index : table) index = kNoPredefined;
+  for (std::size_t i = 0; i < kPredefinedHeadersCount; ++i) {
+    table[PerfectHash(kPredefinedNames[i])] = static_cast<std::uint8_t>(i);
+  }
+  return table;
+}
+
+constexpr auto kPerfectTable = MakePerfectTable();
+
+constexpr bool IsPerfectTable() noexcept {
+  for (std::size_t i = 0; i < kPredefinedHeadersCount; ++i) {
+    if (kPerfectTable[PerfectHash(kPredefinedNames[i])] != i) return false;
+  }
+  return true;
+}
+static_assert(IsPerfectTable(),
+              "PerfectHash has collisions, pick other multipliers");
+
+constexpr std::size_t kMinOthersSize = 16;
+
+}  // namespace
+
+std::string_view ToStringView(PredefinedHeader header) noexcept {
+  const auto index = static_cast<std::size_t>(header);
+  UASSERT(index < kPredefinedHeadersCount);
+  return kPredefinedNames[index];
+}
+
+std::optional<PredefinedHeader> FindPredefinedHeader(
+    std::string_view name) noexcept {
+  if (name.empty()) return std::nullopt;
+  const auto index = kPerfectTable[PerfectHash(name)];
+  if (index == kNoPredefined ||
+      !utils::StrIcaseEqual{}(name, kPredefinedNames[index])) {
+    return std::nullopt;
+  }
+  return static_cast<PredefinedHeader>(index);
+}
+
+HeaderMap::HeaderMap() = default;
+
+HeaderMap::HeaderMap(std::size_t capacity, utils::StrIcaseHash hash)
+    : hash_(hash) {
+  reserve(capacity);
+}
+
+HeaderMap& HeaderMap::operator=(const HeaderMap& other) {
+  // std::pair<const std::string, std::string> is not copy assignable
+  if (this != &other) *this = HeaderMap(other);
+  return *this;
+}
+
+HeaderMap::iterator HeaderMap::find(std::string_view name) noexcept {
+  const auto index = FindIndex(name);
+  return index ? begin() + (index - 1) : end();
+}
+
+HeaderMap::const_iterator HeaderMap::find(
+    std::string_view name) const noexcept {
+  const auto index = FindIndex(name);
+  return index ? begin() + (index - 1) : end();
+}
+
+HeaderMap::iterator HeaderMap::find(PredefinedHeader header) noexcept {
+  const auto index = predefined_[static_cast<std::size_t>(header)];
+  return index ? begin() + (index - 1) : end();
+}
+
+HeaderMap::const_iterator HeaderMap::find(
+    PredefinedHeader header) const noexcept {
+  const auto index = predefined_[static_cast<std::size_t>(header)];
+  return index ? begin() + (index - 1) : end();
+}
+
+std::pair<HeaderMap::iterator, bool> HeaderMap::emplace(std::string name,
+                                                        std::string value) {
+  auto& slot = PrepareSlot(name);
+  if (slot) return {begin() + (slot - 1), false};
+
+  entries_.emplace_back(std::move(name), std::move(value));
+  slot = static_cast<Index>(entries_.size());
+  return {std::prev(end()), true};
+}
+
+std::string& HeaderMap::operator[](std::string_view name) {
+  auto& slot = PrepareSlot(name);
+  if (slot) return entries_[slot - 1].second;
+
+  entries_.emplace_back(std::string{name}, std::string{});
+  slot = static_cast<Index>(entries_.size());
+  return entries_.back().second;
+}
+
+void HeaderMap::reserve(std::size_t capacity) {
+  entries_.reserve(capacity);
+  auto others_size = others_.empty() ? kMinOthersSize : others_.size();
+  while (others_size < capacity * 2) others_size *= 2;
+  while (others_.size() < others_size) GrowOthers();
+}
+
+void HeaderMap::clear() noexcept {
+  entries_.clear();
+  predefined_.fill(0);
+  for (auto& other : others_) other = OtherSlot{};
+  others_count_ = 0;
+}
+
+const HeaderMap::OtherSlot& HeaderMap::FindOtherSlot(
+    std::string_view name, std::size_t hash) const noexcept {
+  UASSERT(!others_.empty());
+  const auto mask = others_.size() - 1;
+  for (auto pos = hash & mask;; pos = (pos + 1) & mask) {
+    const auto& other = others_[pos];
+    if (!other.index) return other;
+    if (other.hash == hash &&
+        utils::StrIcaseEqual{}(entries_[other.index - 1].first, name)) {
+      return other;
+    }
+  }
+}
+
+HeaderMap::Index HeaderMap::FindIndex(std::string_view name) const noexcept {
+  if (const auto predefined = FindPredefinedHeader(name)) {
+    return predefined_[static_cast<std::size_t>(*predefined)];
+  }
+  if (others_count_ == 0) return 0;
+  return FindOtherSlot(name, hash_(name)).index;
+}
+
+HeaderMap::Index& HeaderMap::PrepareSlot(std::string_view name) {
+  if (const auto predefined = FindPredefinedHeader(name)) {
+    return predefined_[static_cast<std::size_t>(*predefined)];
+  }
+
+  // keeps the load factor below 1/2
+  if ((others_count_ + 1) * 2 > others_.size()) GrowOthers();
+
+  const auto hash = hash_(name);
+  auto& other = const_cast<OtherSlot&>(FindOtherSlot(name, hash));
+  if (!other.index) {
+    other.hash = hash;
+    ++others_count_;
+  }
+  return other.index;
+}
+
+void HeaderMap::GrowOthers() {
+  std::vector<OtherSlot> others(
+      others_.empty() ? kMinOthersSize : others_.size() * 2);
+  const auto mask = others.size() - 1;
+  for (const auto& other : others_) {
+    if (!other.index) continue;
+    auto pos = other.hash & mask;
+    while (others[pos].index) pos = (pos + 1) & mask;
+    others[pos] = other;
+  }
+  others_ = std::move(others);
+}
+
+}  // namespace http::headers
+
+USERVER_NAMESPACE_END
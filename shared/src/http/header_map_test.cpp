@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <cctype>
+#include <string>
+#include <unordered_map>
+
+#include <userver/http/common_headers.hpp>
+#include <userver/http/header_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using http::headers::HeaderMap;
+using http::headers::PredefinedHeader;
+
+std::string ToUpper(std::string_view name) {
+  std::string result{name};
+  for (auto& c : result) c = std::toupper(c);
+  return result;
+}
+
+}  // namespace
+
+TEST(HeaderMap, PredefinedHeaders) {
+  for (std::size_t i = 0; i < http::headers::kPredefinedHeadersCount; ++i) {
+    const auto header = static_cast<PredefinedHeader>(i);
+    const auto name = http::headers::ToStringView(header);
+    EXPECT_EQ(http::headers::FindPredefinedHeader(name), header);
+    EXPECT_EQ(http::headers::FindPredefinedHeader(ToUpper(name)), header);
+  }
+
+  EXPECT_EQ(http::headers::FindPredefinedHeader(http::headers::kXRealIp),
+            PredefinedHeader::kXRealIp);
+  EXPECT_FALSE(http::headers::FindPredefinedHeader(""));
+  EXPECT_FALSE(http::headers::FindPredefinedHeader("Hos"));
+  EXPECT_FALSE(http::headers::FindPredefinedHeader("Hosts"));
+  EXPECT_FALSE(http::headers::FindPredefinedHeader("Content-Typo"));
+  EXPECT_FALSE(http::headers::FindPredefinedHeader("\xff\xfe"));
+}
+
+TEST(HeaderMap, Basic) {
+  HeaderMap map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.find("Host"), map.end());
+  EXPECT_EQ(map.find("X-Custom"), map.end());
+
+  EXPECT_TRUE(map.emplace("host", "example.com").second);
+  EXPECT_TRUE(map.emplace("X-Custom", "1").second);
+  EXPECT_FALSE(map.emplace("HOST", "other.com").second);
+  EXPECT_FALSE(map.emplace("x-custom", "2").second);
+  EXPECT_EQ(map.size(), 2);
+
+  ASSERT_NE(map.find("Host"), map.end());
+  EXPECT_EQ(map.find("Host")->first, "host");
+  EXPECT_EQ(map.find("Host")->second, "example.com");
+  EXPECT_EQ(map.find(PredefinedHeader::kHost), map.find("hOsT"));
+  EXPECT_EQ(map.find(PredefinedHeader::kCookie), map.end());
+  EXPECT_EQ(map.find("X-CUSTOM")->second, "1");
+  EXPECT_EQ(map.count("x-custom"), 1);
+  EXPECT_EQ(map.count("x-custom2"), 0);
+
+  map["Cookie"] = "a=b";
+  map["X-CUSTOM"] += ",2";
+  EXPECT_EQ(map.find(PredefinedHeader::kCookie)->second, "a=b");
+  EXPECT_EQ(map["x-custom"], "1,2");
+  EXPECT_EQ(map.size(), 3);
+
+  const auto copy = map;
+  EXPECT_EQ(copy.find("X-Custom")->second, "1,2");
+  EXPECT_EQ(copy.find(PredefinedHeader::kHost)->second, "example.com");
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.find("Host"), map.end());
+  EXPECT_EQ(map.find("X-Custom"), map.end());
+  EXPECT_EQ(copy.size(), 3);
+}
+
+TEST(HeaderMap, InsertionOrder) {
+  HeaderMap map;
+  map["X-B"] = "1";
+  map["Host"] = "2";
+  map["X-A"] = "3";
+  map["Accept"] = "4";
+
+  std::string names;
+  for (const auto& [name, value] : map) names += name + '=' + value + ';';
+  EXPECT_EQ(names, "X-B=1;Host=2;X-A=3;Accept=4;");
+}
+
+TEST(HeaderMap, ManyHeaders) {
+  HeaderMap map{4, utils::StrIcaseHash{42}};
+  std::unordered_map<std::string, std::string> expected;
+  for (int i = 0; i < 1000; ++i) {
+    const auto name = "X-Header-" + std::to_string(i);
+    map.emplace(name, std::to_string(i));
+    expected.emplace(name, std::to_string(i));
+  }
+  for (std::size_t i = 0; i < http::headers::kPredefinedHeadersCount; ++i) {
+    const auto name = std::string{
+        http::headers::ToStringView(static_cast<PredefinedHeader>(i))};
+    map.emplace(name, name);
+    expected.emplace(name, name);
+  }
+
+  EXPECT_EQ(map.size(), expected.size());
+  for (const auto& [name, value] : expected) {
+    const auto it = map.find(ToUpper(name));
+    ASSERT_NE(it, map.end()) << name;
+    EXPECT_EQ(it->second, value);
+  }
+
+  auto other = HeaderMap{};
+  other = map;
+  EXPECT_EQ(other.size(), expected.size());
+  EXPECT_EQ(other.find("X-HEADER-999")->second, "999");
+}
+
+USERVER_NAMESPACE_END
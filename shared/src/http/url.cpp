@@ -1,6 +1,12 @@
 #include <userver/http/url.hpp>
 
 #include <array>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <emmintrin.h>
+#define USERVER_IMPL_URL_SIMD 1
+#endif
 
 USERVER_NAMESPACE_BEGIN
 
@@ -10,43 +16,104 @@ namespace {
 
 const std::string_view kSchemaSeparator = "://";
 
-void UrlEncodeTo(std::string_view input_string, std::string& result) {
-  for (char symbol : input_string) {
-    if (isalnum(symbol)) {
-      result.append(1, symbol);
-      continue;
-    }
-    switch (symbol) {
-      case '-':
-      case '_':
-      case '.':
-      case '!':
-      case '~':
-      case '*':
-      case '(':
-      case ')':
-      case '\'':
-        result.append(1, symbol);
-        break;
-      default:
-        std::array<char, 3> bytes = {'%', 0, 0};
-        bytes[1] = (symbol & 0xF0) / 16;
-        bytes[1] += (bytes[1] > 9) ? 'A' - 10 : '0';
-        bytes[2] = symbol & 0x0F;
-        bytes[2] += (bytes[2] > 9) ? 'A' - 10 : '0';
-        result.append(bytes.data(), bytes.size());
-        break;
-    }
+using CharTable = std::array<bool, 256>;
+
+// Must match the characters FindUnsafeCharSse2 treats as safe
+constexpr CharTable MakeSafeCharsTable() {
+  CharTable table{};
+  for (int c = '0'; c <= '9'; ++c) table[c] = true;
+  for (int c = 'A'; c <= 'Z'; ++c) table[c] = true;
+  for (int c = 'a'; c <= 'z'; ++c) table[c] = true;
+  for (const unsigned char c : {'-', '_', '.', '!', '~', '*', '(', ')', '\''}) {
+    table[c] = true;
+  }
+  return table;
+}
+
+constexpr CharTable kSafeChars = MakeSafeCharsTable();
+
+constexpr std::string_view kHexDigits = "0123456789ABCDEF";
+
+bool IsSafeChar(char c) noexcept {
+  return kSafeChars[static_cast<unsigned char>(c)];
+}
+
+#ifdef USERVER_IMPL_URL_SIMD
+// Returns the mask of bytes in [lo, hi]: the range is shifted to the lowest
+// signed values, so a single signed comparison is enough
+__m128i InRange(__m128i data, char lo, char hi) noexcept {
+  const auto shifted =
+      _mm_add_epi8(data, _mm_set1_epi8(static_cast<char>(-128 - lo)));
+  return _mm_cmplt_epi8(shifted,
+                        _mm_set1_epi8(static_cast<char>(-128 + hi - lo + 1)));
+}
+
+// SSE2 is in the x86_64 baseline, no need for a runtime check
+const char* FindUnsafeCharSse2(const char* begin, const char* end) noexcept {
+  while (end - begin >= 16) {
+    const __m128i data =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    const __m128i safe = _mm_or_si128(
+        _mm_or_si128(
+            _mm_or_si128(InRange(data, '0', '9'), InRange(data, 'A', 'Z')),
+            _mm_or_si128(InRange(data, 'a', 'z'), InRange(data, '\'', ')'))),
+        _mm_or_si128(
+            _mm_or_si128(InRange(data, '-', '.'),
+                         _mm_cmpeq_epi8(data, _mm_set1_epi8('!'))),
+            _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8('_')),
+                         _mm_cmpeq_epi8(data, _mm_set1_epi8('~')))));
+
+    const auto mask = static_cast<unsigned>(_mm_movemask_epi8(safe));
+    if (mask != 0xFFFF) return begin + __builtin_ctz(~mask);
+    begin += 16;
+  }
+  return begin;
+}
+#endif
+
+const char* FindUnsafeChar(const char* begin, const char* end) noexcept {
+#ifdef USERVER_IMPL_URL_SIMD
+  begin = FindUnsafeCharSse2(begin, end);
+#endif
+  while (begin != end && IsSafeChar(*begin)) ++begin;
+  return begin;
+}
+
+std::size_t GetEncodedSize(std::string_view input) noexcept {
+  auto size = input.size();
+  const auto* const end = input.data() + input.size();
+  for (const auto* it = FindUnsafeChar(input.data(), end); it != end;
+       it = FindUnsafeChar(it + 1, end)) {
+    size += 2;
+  }
+  return size;
+}
+
+// `out` must have at least GetEncodedSize(input) bytes
+char* UrlEncodeTo(std::string_view input, char* out) noexcept {
+  const auto* it = input.data();
+  const auto* const end = input.data() + input.size();
+  while (it != end) {
+    const auto* const unsafe = FindUnsafeChar(it, end);
+    std::memcpy(out, it, unsafe - it);
+    out += unsafe - it;
+    if (unsafe == end) break;
+
+    const auto symbol = static_cast<unsigned char>(*unsafe);
+    out[0] = '%';
+    out[1] = kHexDigits[symbol >> 4];
+    out[2] = kHexDigits[symbol & 0x0F];
+    out += 3;
+    it = unsafe + 1;
   }
+  return out;
 }
 
 }  // namespace
 
 std::string UrlEncode(std::string_view input_string) {
-  std::string result;
-  result.reserve(3 * input_string.size());
-
-  UrlEncodeTo(input_string, result);
+  std::string result(GetEncodedSize(input_string), '\0');
+  UrlEncodeTo(input_string, result.data());
   return result;
 }
 
@@ -82,49 +149,44 @@ std::string UrlDecode(std::string_view range) {
 
 namespace {
 
+// The query is built in two passes: the exact size is computed first, so the
+// result is allocated once and the arguments are encoded right into it
 template <typename T>
-std::size_t GetInitialQueryCapacity(T begin, T end) {
-  std::size_t capacity = 1;
+std::size_t GetQuerySize(T begin, T end) noexcept {
+  std::size_t size = 0;
   for (auto it = begin; it != end; ++it) {
-    // Maximal query result size is 3 * input.size. Coefficient 3 / 2 guarantee
-    // no more than one reallocation.
-    capacity += 1 + (it->first.size() + it->second.size()) * 3 / 2 + 1;
+    if (it != begin) ++size;  // '&'
+    size += GetEncodedSize(it->first) + 1 + GetEncodedSize(it->second);
   }
-  return capacity;
+  return size;
 }
 
 template <typename T>
-void DoMakeQueryTo(T begin, T end, std::string& result) {
-  bool first = true;
+char* DoMakeQueryTo(T begin, T end, char* out) noexcept {
   for (auto it = begin; it != end; ++it) {
-    if (!first) {
-      result.append(1, '&');
-    } else {
-      first = false;
-    }
-    UrlEncodeTo(it->first, result);
-    result.append(1, '=');
-    UrlEncodeTo(it->second, result);
+    if (it != begin) *out++ = '&';
+    out = UrlEncodeTo(it->first, out);
+    *out++ = '=';
+    out = UrlEncodeTo(it->second, out);
   }
+  return out;
 }
 
 template <typename T>
 std::string DoMakeQuery(T begin, T end) {
-  std::string result;
-  result.reserve(GetInitialQueryCapacity(begin, end));
-
-  DoMakeQueryTo(begin, end, result);
+  std::string result(GetQuerySize(begin, end), '\0');
+  DoMakeQueryTo(begin, end, result.data());
   return result;
 }
 
 template <typename T>
 std::string MakeUrl(std::string_view path, T begin, T end) {
-  std::string result;
-  result.reserve(path.size() + 1 + GetInitialQueryCapacity(begin, end));
-
-  result.append(path);
-  result.append(1, '?');
-  DoMakeQueryTo(begin, end, result);
+  std::string result(path.size() + 1 + GetQuerySize(begin, end), '\0');
+  auto* out = result.data();
+  std::memcpy(out, path.data(), path.size());
+  out += path.size();
+  *out++ = '?';
+  DoMakeQueryTo(begin, end, out);
   return result;
 }
 
@@ -147,6 +209,10 @@ std::string MakeUrl(
   return MakeUrl(path, query_args.begin(), query_args.end());
 }
 
+std::string MakeUrl(std::string_view path, const QueryArgViews& query_args) {
+  return MakeUrl(path, query_args.begin(), query_args.end());
+}
+
 std::string MakeQuery(const Args& query_args) {
   return DoMakeQuery(query_args.begin(), query_args.end());
 }
@@ -162,6 +228,10 @@ std::string MakeQuery(
   return DoMakeQuery(query_args.begin(), query_args.end());
 }
 
+std::string MakeQuery(const QueryArgViews& query_args) {
+  return DoMakeQuery(query_args.begin(), query_args.end());
+}
+
 std::string ExtractMetaTypeFromUrl(const std::string& url) {
   auto pos = url.find('?');
   if (pos == std::string::npos) return url;
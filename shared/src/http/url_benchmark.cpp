@@ -1,5 +1,8 @@
 #include <benchmark/benchmark.h>
 
+#include <string>
+#include <vector>
+
 #include <userver/http/url.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -26,6 +29,19 @@ BENCHMARK(make_url_small);
 void make_url_big(benchmark::State& state) { make_url(state, 5000); }
 BENCHMARK(make_url_big);
 
+void url_encode(benchmark::State& state) {
+  std::string input;
+  for (std::size_t i = 0; input.size() < std::size_t(state.range(0)); ++i) {
+    input += (i % 8 == 7) ? ' ' : 'a';
+  }
+  for (auto _ : state) {
+    const auto result = http::UrlEncode(input);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(url_encode)->RangeMultiplier(8)->Range(8, 8 << 10);
+
 void make_query(benchmark::State& state) {
   http::Args query_args;
   const auto agrs_count = state.range(0);
@@ -40,4 +56,20 @@ void make_query(benchmark::State& state) {
 }
 BENCHMARK(make_query)->RangeMultiplier(2)->Range(1, 256);
 
+void make_query_views(benchmark::State& state) {
+  std::vector<std::string> storage;
+  const auto agrs_count = state.range(0);
+  for (int i = 0; i < agrs_count; i++) {
+    storage.push_back("arg" + std::to_string(i));
+  }
+  http::QueryArgViews query_args;
+  for (const auto& str : storage) query_args.emplace_back(str, str);
+
+  for (auto _ : state) {
+    const auto result = http::MakeQuery(query_args);
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(make_query_views)->RangeMultiplier(2)->Range(1, 256);
+
 USERVER_NAMESPACE_END
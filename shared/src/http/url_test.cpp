@@ -21,6 +21,15 @@ TEST(UrlEncode, Special) {
   EXPECT_EQ("Text%20with%20spaces%2C%3F%26%3D", UrlEncode(str));
 }
 
+TEST(UrlEncode, Long) {
+  // crosses the boundaries of the vectorized chunks
+  const std::string str = std::string(20, 'a') + "~*()'-_.!" + " /" +
+                          std::string(17, 'Z') + "\xFF";
+  EXPECT_EQ(std::string(20, 'a') + "~*()'-_.!" + "%20%2F" +
+                std::string(17, 'Z') + "%FF",
+            UrlEncode(str));
+}
+
 TEST(UrlDecode, Empty) { EXPECT_EQ("", UrlDecode("")); }
 
 TEST(UrlDecode, Latin) {
@@ -59,6 +68,12 @@ TEST(MakeUrl, InitializerList2) {
             http::MakeUrl("path", {{"a", value}, {"c", "d"}}));
 }
 
+TEST(MakeQuery, ArgViews) {
+  const std::string value = "with space";
+  EXPECT_EQ("a=with%20space&b%26=", http::MakeQuery(http::QueryArgViews{
+                                        {"a", value}, {"b&", ""}}));
+}
+
 TEST(ExtractMetaTypeFromUrl, Emtpy) {
   EXPECT_EQ("", http::ExtractMetaTypeFromUrl(""));
 }
@@ -1,8 +1,9 @@
 #include <userver/utils/boost_uuid4.hpp>
 
 #include <array>
+#include <cstdint>
+#include <cstring>
 
-#include <boost/uuid/random_generator.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_io.hpp>
 
@@ -49,6 +50,20 @@ unsigned char GetValue(char c) {
   return kValues[pos];
 }
 
+// Same as boost::uuids::basic_random_generator, but without a virtual call
+// per 32 bits
+boost::uuids::uuid GenerateUuid(FastRandom& random) {
+  const std::array<std::uint64_t, 2> words{random(), random()};
+  boost::uuids::uuid uuid;
+  static_assert(sizeof(uuid.data) == sizeof(words));
+  std::memcpy(uuid.data, words.data(), sizeof(words));
+
+  // version 4 (random), variant 1 (RFC 4122)
+  uuid.data[6] = (uuid.data[6] & 0x0f) | 0x40;
+  uuid.data[8] = (uuid.data[8] & 0x3f) | 0x80;
+  return uuid;
+}
+
 boost::uuids::uuid FromChars(const char* begin, const char* end) {
   auto c = GetNextChar(begin, end);
   bool has_open_brace = IsOpenBrace(c);
@@ -105,9 +120,17 @@ boost::uuids::uuid FromChars(const char* begin, const char* end) {
 namespace generators {
 
 boost::uuids::uuid GenerateBoostUuid() {
-  thread_local boost::uuids::basic_random_generator<RandomBase> generator(
-      DefaultRandom());
-  return generator();
+  return GenerateUuid(DefaultFastRandom());
+}
+
+std::vector<boost::uuids::uuid> GenerateBoostUuids(std::size_t count) {
+  std::vector<boost::uuids::uuid> uuids;
+  uuids.reserve(count);
+  auto& random = DefaultFastRandom();
+  for (std::size_t i = 0; i < count; ++i) {
+    uuids.push_back(GenerateUuid(random));
+  }
+  return uuids;
 }
 
 }  // namespace generators
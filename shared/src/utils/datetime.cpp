@@ -10,8 +10,11 @@
 #include <boost/lexical_cast.hpp>
 
 #include <userver/utils/assert.hpp>
+#include <userver/utils/datetime/timestring.hpp>
 #include <userver/utils/mock_now.hpp>
 
+#include <utils/datetime/parse_rfc3339.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace utils::datetime {
@@ -47,6 +50,17 @@ const cctz::time_zone& GetLocalTimezone() {
 std::optional<std::chrono::system_clock::time_point> OptionalStringtime(
     const std::string& timestring, const cctz::time_zone& timezone,
     const std::string& format) {
+  // the offset is always present in these formats, the timezone is unused
+  if (format == kRfc3339Format) {
+    const auto tp = impl::ParseRfc3339TimePoint(
+        timestring, impl::OffsetFormat::kWithColon);
+    if (tp) return tp;
+  } else if (format == kDefaultFormat) {
+    const auto tp = impl::ParseRfc3339TimePoint(
+        timestring, impl::OffsetFormat::kWithoutColon);
+    if (tp) return tp;
+  }
+
   std::chrono::system_clock::time_point tp;
   if (cctz::parse(format, timestring, timezone, &tp)) {
     return tp;
@@ -104,6 +118,15 @@ bool IsTimeBetween(int hour, int min, int hour_from, int min_from, int hour_to,
 
 std::string Timestring(std::chrono::system_clock::time_point tp,
                        const std::string& timezone, const std::string& format) {
+  if (timezone == "UTC") {
+    if (format == kRfc3339Format) {
+      return Timestring(tp, TimestringFormat::kRfc3339);
+    } else if (format == kDefaultFormat) {
+      return Timestring(tp, TimestringFormat::kDefault);
+    } else if (format == kTaximeterFormat) {
+      return Timestring(tp, TimestringFormat::kIsoMicros);
+    }
+  }
   return cctz::format(format, tp, GetTimezone(timezone));
 }
 
@@ -220,6 +243,10 @@ std::chrono::steady_clock::time_point SteadyNow() noexcept {
   return MockSteadyNow();
 }
 
+std::chrono::steady_clock::time_point SteadyCoarseNow() noexcept {
+  return MockSteadyCoarseNow();
+}
+
 std::chrono::system_clock::time_point Now() noexcept { return MockNow(); }
 
 std::chrono::system_clock::time_point Epoch() noexcept {
@@ -1,5 +1,8 @@
+#pragma once
+
 #include <userver/utils/datetime/steady_coarse_clock.hpp>
 
+#include <chrono>
 #include <ctime>
 
 #include <userver/utils/assert.hpp>
@@ -50,6 +53,18 @@ Duration CoarseResolution() noexcept {
   return cached_resolution;
 }
 
+// CLOCK_MONOTONIC_COARSE lags behind the CLOCK_MONOTONIC that is used by
+// std::chrono::steady_clock, so their time points may be compared.
+inline std::chrono::steady_clock::time_point
+SteadyCoarseNowAsSteady() noexcept {
+#if defined(CLOCK_MONOTONIC_COARSE) && defined(__linux__)
+  return CoarseNow<std::chrono::steady_clock::time_point,
+                   kCoarseSteadyClockNativeFlag>();
+#else
+  return std::chrono::steady_clock::now();
+#endif
+}
+
 }  // namespace utils::datetime
 
 USERVER_NAMESPACE_END
@@ -4,6 +4,8 @@
 
 #include <userver/utils/datetime.hpp>
 
+#include <utils/datetime/parse_rfc3339.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace utils::datetime {
@@ -36,8 +38,15 @@ std::chrono::system_clock::time_point FromStringSaturating(
   // reimplement cctz::parse() because we cannot distinguish overflow otherwise
   cctz::time_point<cctz::seconds> tp_seconds;
   cctz::detail::femtoseconds femtoseconds;
-  if (!cctz::detail::parse(format, timestring, cctz::utc_time_zone(),
-                           &tp_seconds, &femtoseconds)) {
+  const auto fast_parsed =
+      format == kRfc3339Format
+          ? impl::ParseRfc3339(timestring, impl::OffsetFormat::kWithColon)
+          : std::nullopt;
+  if (fast_parsed) {
+    tp_seconds = decltype(tp_seconds){fast_parsed->seconds};
+    femtoseconds = fast_parsed->subseconds;
+  } else if (!cctz::detail::parse(format, timestring, cctz::utc_time_zone(),
+                                  &tp_seconds, &femtoseconds)) {
     throw DateParseError(timestring);
   }
 
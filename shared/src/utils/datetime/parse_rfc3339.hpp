@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::datetime::impl {
+
+struct SplitTimePoint {
+  std::chrono::seconds seconds;
+  std::chrono::nanoseconds subseconds;
+};
+
+enum class OffsetFormat {
+  kWithColon,     // %Ez, "+03:00"
+  kWithoutColon,  // %z, "+0300"
+};
+
+/// Parses the strings like "2023-01-02T03:04:05.123+03:00" or
+/// "2023-01-02T03:04:05Z" without cctz. Returns std::nullopt on anything
+/// else, including the strings that cctz accepts in other forms, so the
+/// caller falls back to cctz::parse.
+std::optional<SplitTimePoint> ParseRfc3339(std::string_view timestring,
+                                           OffsetFormat offset_format);
+
+/// Same as ParseRfc3339, also returns std::nullopt if the result does not fit
+/// into std::chrono::system_clock::time_point
+std::optional<std::chrono::system_clock::time_point> ParseRfc3339TimePoint(
+    std::string_view timestring, OffsetFormat offset_format);
+
+}  // namespace utils::datetime::impl
+
+USERVER_NAMESPACE_END
@@ -4,6 +4,8 @@
 
 #include <benchmark/benchmark.h>
 
+#include <userver/utils/datetime.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 void steady_clock_benchmark(benchmark::State& state) {
@@ -20,4 +22,18 @@ void steady_coarse_clock_benchmark(benchmark::State& state) {
 }
 BENCHMARK(steady_coarse_clock_benchmark);
 
+void steady_now_benchmark(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utils::datetime::SteadyNow());
+  }
+}
+BENCHMARK(steady_now_benchmark);
+
+void steady_coarse_now_benchmark(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utils::datetime::SteadyCoarseNow());
+  }
+}
+BENCHMARK(steady_coarse_now_benchmark);
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,333 @@
+#include <userver/utils/datetime/timestring.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include <cctz/time_zone.h>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/datetime.hpp>
+
+#include <utils/datetime/parse_rfc3339.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::datetime {
+
+namespace {
+
+using SystemClock = std::chrono::system_clock;
+
+constexpr std::int64_t kSecondsPerDay = 24 * 60 * 60;
+
+// Days between 0000-03-01 and 1970-01-01
+constexpr std::int64_t kEpochShift = 719468;
+constexpr std::int64_t kDaysPerEra = 146097;
+
+// "YYYY-MM-DDTHH:MM:SS"
+constexpr std::size_t kDateTimeSize = 19;
+
+constexpr int kMinFastYear = 1000;
+constexpr int kMaxFastYear = 9999;
+
+const std::string kTskvLocalFormat = "%Y-%m-%dT%H:%M:%E6S";
+
+struct CivilTime {
+  std::int64_t year;
+  int month;
+  int day;
+  int hour;
+  int minute;
+  int second;
+};
+
+// See https://howardhinnant.github.io/date_algorithms.html
+CivilTime ToCivilUtc(std::int64_t seconds) noexcept {
+  auto days = seconds / kSecondsPerDay;
+  auto day_seconds = seconds % kSecondsPerDay;
+  if (day_seconds < 0) {
+    day_seconds += kSecondsPerDay;
+    --days;
+  }
+
+  days += kEpochShift;
+  const auto era = (days >= 0 ? days : days - kDaysPerEra + 1) / kDaysPerEra;
+  const auto day_of_era = days - era * kDaysPerEra;
+  const auto year_of_era = (day_of_era - day_of_era / 1460 +
+                            day_of_era / 36524 - day_of_era / 146096) /
+                           365;
+  const auto day_of_year =
+      day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+  // months starting from March
+  const auto shifted_month = (5 * day_of_year + 2) / 153;
+  const auto month = static_cast<int>(shifted_month < 10 ? shifted_month + 3
+                                                         : shifted_month - 9);
+
+  return {
+      year_of_era + era * 400 + (month <= 2),
+      month,
+      static_cast<int>(day_of_year - (153 * shifted_month + 2) / 5 + 1),
+      static_cast<int>(day_seconds / 3600),
+      static_cast<int>(day_seconds / 60 % 60),
+      static_cast<int>(day_seconds % 60),
+  };
+}
+
+std::int64_t DaysFromCivil(std::int64_t year, int month, int day) noexcept {
+  year -= month <= 2;
+  const auto era = (year >= 0 ? year : year - 399) / 400;
+  const auto year_of_era = year - era * 400;
+  const auto day_of_year =
+      (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  const auto day_of_era =
+      year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  return era * kDaysPerEra + day_of_era - kEpochShift;
+}
+
+bool IsLeapYear(int year) noexcept {
+  return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+int DaysInMonth(int year, int month) noexcept {
+  constexpr int kDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  return month == 2 && IsLeapYear(year) ? 29 : kDays[month - 1];
+}
+
+char* WriteDigits(char* out, std::uint32_t value, int width) noexcept {
+  for (int i = width - 1; i >= 0; --i) {
+    out[i] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+  return out + width;
+}
+
+void WriteDateTime(char* out, const CivilTime& time) noexcept {
+  out = WriteDigits(out, static_cast<std::uint32_t>(time.year), 4);
+  *out++ = '-';
+  out = WriteDigits(out, time.month, 2);
+  *out++ = '-';
+  out = WriteDigits(out, time.day, 2);
+  *out++ = 'T';
+  out = WriteDigits(out, time.hour, 2);
+  *out++ = ':';
+  out = WriteDigits(out, time.minute, 2);
+  *out++ = ':';
+  WriteDigits(out, time.second, 2);
+}
+
+struct DateTimeCache {
+  std::int64_t seconds{std::numeric_limits<std::int64_t>::min()};
+  bool is_fast_year{false};
+  char date_time[kDateTimeSize]{};
+};
+
+// Returns the date and time of the second, formatting them only once the
+// second changes
+const DateTimeCache& GetDateTime(std::int64_t seconds, bool is_local) {
+  thread_local DateTimeCache caches[2];
+  auto& cache = caches[is_local];
+  if (cache.seconds == seconds) return cache;
+
+  CivilTime time{};
+  if (is_local) {
+    static const auto kLocalTz = cctz::local_time_zone();
+    const auto local = cctz::convert(
+        cctz::time_point<cctz::seconds>{cctz::seconds{seconds}}, kLocalTz);
+    time = {local.year(),   local.month(),  local.day(),
+            local.hour(),   local.minute(), local.second()};
+  } else {
+    time = ToCivilUtc(seconds);
+  }
+
+  cache.seconds = seconds;
+  cache.is_fast_year = time.year >= kMinFastYear && time.year <= kMaxFastYear;
+  if (cache.is_fast_year) WriteDateTime(cache.date_time, time);
+  return cache;
+}
+
+std::size_t FormatWithCctz(char* out, SystemClock::time_point tp,
+                           TimestringFormat format) {
+  const auto result = [&] {
+    switch (format) {
+      case TimestringFormat::kRfc3339:
+        return cctz::format(kRfc3339Format, tp, cctz::utc_time_zone());
+      case TimestringFormat::kDefault:
+        return cctz::format(kDefaultFormat, tp, cctz::utc_time_zone());
+      case TimestringFormat::kIsoMicros:
+        return cctz::format(kTaximeterFormat, tp, cctz::utc_time_zone());
+      case TimestringFormat::kTskvLocal:
+        return cctz::format(kTskvLocalFormat, tp, cctz::local_time_zone());
+    }
+    UINVARIANT(false, "Unexpected timestring format");
+  }();
+  UINVARIANT(result.size() <= kMaxTimestringSize, "Too long timestring");
+  std::memcpy(out, result.data(), result.size());
+  return result.size();
+}
+
+}  // namespace
+
+std::string Timestring(SystemClock::time_point tp, TimestringFormat format) {
+  char buffer[kMaxTimestringSize];
+  return std::string(buffer, TimestringInto(buffer, tp, format));
+}
+
+std::size_t TimestringInto(char* out, SystemClock::time_point tp,
+                           TimestringFormat format) {
+  // not std::chrono::floor, it overflows near time_point::min()
+  auto seconds =
+      std::chrono::duration_cast<std::chrono::seconds>(tp.time_since_epoch());
+  auto subseconds = tp.time_since_epoch() -
+                    std::chrono::duration_cast<SystemClock::duration>(seconds);
+  if (subseconds.count() < 0) {
+    seconds -= std::chrono::seconds{1};
+    subseconds += std::chrono::seconds{1};
+  }
+
+  const auto& date_time =
+      GetDateTime(seconds.count(), format == TimestringFormat::kTskvLocal);
+  if (!date_time.is_fast_year) return FormatWithCctz(out, tp, format);
+
+  char* const begin = out;
+  std::memcpy(out, date_time.date_time, kDateTimeSize);
+  out += kDateTimeSize;
+
+  auto nanoseconds = static_cast<std::uint32_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(subseconds)
+          .count());
+  switch (format) {
+    case TimestringFormat::kRfc3339:
+    case TimestringFormat::kDefault:
+      // %E*S, the fraction without the trailing zeros
+      if (nanoseconds != 0) {
+        int width = 9;
+        for (; nanoseconds % 10 == 0; --width) nanoseconds /= 10;
+        *out++ = '.';
+        out = WriteDigits(out, nanoseconds, width);
+      }
+      if (format == TimestringFormat::kRfc3339) {
+        std::memcpy(out, "+00:00", 6);
+        out += 6;
+      } else {
+        std::memcpy(out, "+0000", 5);
+        out += 5;
+      }
+      break;
+    case TimestringFormat::kIsoMicros:
+    case TimestringFormat::kTskvLocal:
+      *out++ = '.';
+      out = WriteDigits(out, nanoseconds / 1000, 6);
+      if (format == TimestringFormat::kIsoMicros) *out++ = 'Z';
+      break;
+  }
+  return out - begin;
+}
+
+namespace impl {
+
+namespace {
+
+bool ParseDigits(std::string_view input, std::size_t pos, std::size_t count,
+                 int& value) noexcept {
+  value = 0;
+  for (std::size_t i = pos; i < pos + count; ++i) {
+    if (input[i] < '0' || input[i] > '9') return false;
+    value = value * 10 + (input[i] - '0');
+  }
+  return true;
+}
+
+}  // namespace
+
+std::optional<SplitTimePoint> ParseRfc3339(std::string_view timestring,
+                                           OffsetFormat offset_format) {
+  const auto size = timestring.size();
+  if (size <= kDateTimeSize || timestring[4] != '-' || timestring[7] != '-' ||
+      timestring[10] != 'T' || timestring[13] != ':' || timestring[16] != ':') {
+    return std::nullopt;
+  }
+
+  int year = 0;
+  int month = 0;
+  int day = 0;
+  int hour = 0;
+  int minute = 0;
+  int second = 0;
+  if (!ParseDigits(timestring, 0, 4, year) ||
+      !ParseDigits(timestring, 5, 2, month) ||
+      !ParseDigits(timestring, 8, 2, day) ||
+      !ParseDigits(timestring, 11, 2, hour) ||
+      !ParseDigits(timestring, 14, 2, minute) ||
+      !ParseDigits(timestring, 17, 2, second)) {
+    return std::nullopt;
+  }
+  // leap seconds and the invalid dates are left to cctz
+  if (month < 1 || month > 12 || day < 1 || day > DaysInMonth(year, month) ||
+      hour > 23 || minute > 59 || second > 59) {
+    return std::nullopt;
+  }
+
+  auto pos = kDateTimeSize;
+  std::int64_t nanoseconds = 0;
+  if (timestring[pos] == '.') {
+    const auto fraction_begin = ++pos;
+    for (; pos < size && timestring[pos] >= '0' && timestring[pos] <= '9';
+         ++pos) {
+      // the digits beyond nanoseconds are truncated
+      if (pos - fraction_begin < 9) {
+        nanoseconds = nanoseconds * 10 + (timestring[pos] - '0');
+      }
+    }
+    if (pos == fraction_begin) return std::nullopt;
+    for (auto i = pos - fraction_begin; i < 9; ++i) nanoseconds *= 10;
+  }
+
+  if (pos == size) return std::nullopt;
+  int offset = 0;
+  const char sign = timestring[pos++];
+  if (sign == '+' || sign == '-') {
+    const bool with_colon = offset_format == OffsetFormat::kWithColon;
+    int offset_hours = 0;
+    int offset_minutes = 0;
+    if (size - pos != (with_colon ? 5 : 4) ||
+        !ParseDigits(timestring, pos, 2, offset_hours) ||
+        (with_colon && timestring[pos + 2] != ':') ||
+        !ParseDigits(timestring, size - 2, 2, offset_minutes) ||
+        offset_hours > 23 || offset_minutes > 59) {
+      return std::nullopt;
+    }
+    offset = (offset_hours * 60 + offset_minutes) * 60;
+    if (sign == '-') offset = -offset;
+  } else if (sign != 'Z' || pos != size) {
+    return std::nullopt;
+  }
+
+  const auto seconds = DaysFromCivil(year, month, day) * kSecondsPerDay +
+                       hour * 3600 + minute * 60 + second - offset;
+  return SplitTimePoint{std::chrono::seconds{seconds},
+                        std::chrono::nanoseconds{nanoseconds}};
+}
+
+std::optional<SystemClock::time_point> ParseRfc3339TimePoint(
+    std::string_view timestring, OffsetFormat offset_format) {
+  const auto parsed = ParseRfc3339(timestring, offset_format);
+  if (!parsed) return std::nullopt;
+
+  constexpr auto kMaxSeconds =
+      std::chrono::floor<std::chrono::seconds>(SystemClock::duration::max());
+  constexpr auto kMinSeconds =
+      std::chrono::ceil<std::chrono::seconds>(SystemClock::duration::min());
+  if (parsed->seconds >= kMaxSeconds || parsed->seconds < kMinSeconds) {
+    return std::nullopt;
+  }
+  return SystemClock::time_point{
+      std::chrono::duration_cast<SystemClock::duration>(parsed->seconds) +
+      std::chrono::duration_cast<SystemClock::duration>(parsed->subseconds)};
+}
+
+}  // namespace impl
+
+}  // namespace utils::datetime
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,117 @@
+#include <userver/utils/datetime/timestring.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <cctz/time_zone.h>
+
+#include <userver/utils/datetime.hpp>
+
+#include <utils/datetime/parse_rfc3339.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace dt = utils::datetime;
+
+using SystemClock = std::chrono::system_clock;
+
+constexpr std::size_t kTimePointsCount = 1024;
+
+std::vector<SystemClock::time_point> MakeTimePoints() {
+  std::mt19937_64 generator{42};
+  // from 2000 to 2038
+  std::uniform_int_distribution<std::int64_t> seconds{946684800, 2147483647};
+  std::uniform_int_distribution<std::int64_t> microseconds{0, 999'999};
+  std::vector<SystemClock::time_point> result;
+  result.reserve(kTimePointsCount);
+  for (std::size_t i = 0; i < kTimePointsCount; ++i) {
+    result.emplace_back(std::chrono::seconds{seconds(generator)} +
+                        std::chrono::microseconds{microseconds(generator)});
+  }
+  return result;
+}
+
+std::vector<std::string> MakeTimestrings() {
+  std::vector<std::string> result;
+  result.reserve(kTimePointsCount);
+  for (const auto tp : MakeTimePoints()) {
+    result.push_back(
+        cctz::format(dt::kRfc3339Format, tp, cctz::utc_time_zone()));
+  }
+  return result;
+}
+
+void TimestringCctzNow(benchmark::State& state) {
+  const auto tz = cctz::utc_time_zone();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        cctz::format(dt::kRfc3339Format, SystemClock::now(), tz));
+  }
+}
+BENCHMARK(TimestringCctzNow);
+
+void TimestringNow(benchmark::State& state) {
+  const auto format = static_cast<dt::TimestringFormat>(state.range(0));
+  char buffer[dt::kMaxTimestringSize];
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        dt::TimestringInto(buffer, SystemClock::now(), format));
+  }
+}
+BENCHMARK(TimestringNow)
+    ->Arg(static_cast<int>(dt::TimestringFormat::kRfc3339))
+    ->Arg(static_cast<int>(dt::TimestringFormat::kIsoMicros))
+    ->Arg(static_cast<int>(dt::TimestringFormat::kTskvLocal));
+
+void TimestringCctzRandom(benchmark::State& state) {
+  const auto time_points = MakeTimePoints();
+  const auto tz = cctz::utc_time_zone();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cctz::format(
+        dt::kRfc3339Format, time_points[i++ % kTimePointsCount], tz));
+  }
+}
+BENCHMARK(TimestringCctzRandom);
+
+void TimestringRandom(benchmark::State& state) {
+  const auto time_points = MakeTimePoints();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dt::Timestring(
+        time_points[i++ % kTimePointsCount], dt::TimestringFormat::kRfc3339));
+  }
+}
+BENCHMARK(TimestringRandom);
+
+void StringtimeCctz(benchmark::State& state) {
+  const auto timestrings = MakeTimestrings();
+  const auto tz = cctz::utc_time_zone();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    SystemClock::time_point tp;
+    benchmark::DoNotOptimize(cctz::parse(
+        dt::kRfc3339Format, timestrings[i++ % kTimePointsCount], tz, &tp));
+    benchmark::DoNotOptimize(tp);
+  }
+}
+BENCHMARK(StringtimeCctz);
+
+void StringtimeRfc3339(benchmark::State& state) {
+  const auto timestrings = MakeTimestrings();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dt::impl::ParseRfc3339TimePoint(
+        timestrings[i++ % kTimePointsCount],
+        dt::impl::OffsetFormat::kWithColon));
+  }
+}
+BENCHMARK(StringtimeRfc3339);
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,183 @@
+#include <userver/utils/datetime/timestring.hpp>
+
+#include <random>
+
+#include <cctz/time_zone.h>
+#include <gtest/gtest.h>
+
+#include <userver/utils/datetime.hpp>
+#include <userver/utils/datetime/from_string_saturating.hpp>
+
+#include <utils/datetime/parse_rfc3339.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace dt = utils::datetime;
+
+using SystemClock = std::chrono::system_clock;
+
+constexpr std::pair<dt::TimestringFormat, const char*> kFormats[] = {
+    {dt::TimestringFormat::kRfc3339, "%Y-%m-%dT%H:%M:%E*S%Ez"},
+    {dt::TimestringFormat::kDefault, "%Y-%m-%dT%H:%M:%E*S%z"},
+    {dt::TimestringFormat::kIsoMicros, "%Y-%m-%dT%H:%M:%E6SZ"},
+    {dt::TimestringFormat::kTskvLocal, "%Y-%m-%dT%H:%M:%E6S"},
+};
+
+std::string FormatWithCctz(SystemClock::time_point tp,
+                           dt::TimestringFormat format) {
+  for (const auto& [timestring_format, cctz_format] : kFormats) {
+    if (timestring_format != format) continue;
+    return cctz::format(cctz_format, tp,
+                        format == dt::TimestringFormat::kTskvLocal
+                            ? cctz::local_time_zone()
+                            : cctz::utc_time_zone());
+  }
+  ADD_FAILURE() << "Unknown format";
+  return {};
+}
+
+void ExpectSameAsCctz(SystemClock::time_point tp) {
+  for (const auto& [format, cctz_format] : kFormats) {
+    EXPECT_EQ(dt::Timestring(tp, format), FormatWithCctz(tp, format))
+        << cctz_format << ' ' << tp.time_since_epoch().count();
+  }
+}
+
+std::optional<SystemClock::time_point> ParseWithCctz(
+    const std::string& timestring, dt::impl::OffsetFormat offset_format) {
+  SystemClock::time_point tp;
+  const auto& format = offset_format == dt::impl::OffsetFormat::kWithColon
+                           ? dt::kRfc3339Format
+                           : dt::kDefaultFormat;
+  if (!cctz::parse(format, timestring, cctz::utc_time_zone(), &tp)) {
+    return std::nullopt;
+  }
+  return tp;
+}
+
+// from 1900 to 2100
+SystemClock::time_point MakeRandomTimePoint(std::mt19937_64& generator) {
+  std::uniform_int_distribution<std::int64_t> seconds{-2208988800,
+                                                      4102444800};
+  std::uniform_int_distribution<std::int64_t> nanoseconds{0, 999'999'999};
+  return SystemClock::time_point{std::chrono::duration_cast<
+      SystemClock::duration>(std::chrono::seconds{seconds(generator)} +
+                             std::chrono::nanoseconds{nanoseconds(generator)})};
+}
+
+}  // namespace
+
+TEST(Timestring, Formats) {
+  const auto tp = dt::Stringtime("2023-01-02T03:04:05.123456+0000");
+  EXPECT_EQ(dt::Timestring(tp, dt::TimestringFormat::kRfc3339),
+            "2023-01-02T03:04:05.123456+00:00");
+  EXPECT_EQ(dt::Timestring(tp, dt::TimestringFormat::kDefault),
+            "2023-01-02T03:04:05.123456+0000");
+  EXPECT_EQ(dt::Timestring(tp, dt::TimestringFormat::kIsoMicros),
+            "2023-01-02T03:04:05.123456Z");
+  EXPECT_EQ(dt::Timestring(tp, "UTC", dt::kTaximeterFormat),
+            "2023-01-02T03:04:05.123456Z");
+}
+
+TEST(Timestring, SameAsCctz) {
+  ExpectSameAsCctz(SystemClock::time_point{});
+  ExpectSameAsCctz(dt::Stringtime("2023-01-02T03:04:05+0000"));
+  ExpectSameAsCctz(dt::Stringtime("2023-01-02T03:04:05.1+0000"));
+  ExpectSameAsCctz(dt::Stringtime("2024-02-29T23:59:59.000000001+0000"));
+  ExpectSameAsCctz(dt::Stringtime("1969-12-31T23:59:59.999+0000"));
+  ExpectSameAsCctz(dt::Stringtime("1700-01-01T00:00:00+0000"));
+  ExpectSameAsCctz(SystemClock::time_point::min());
+  ExpectSameAsCctz(SystemClock::time_point::max());
+}
+
+TEST(Timestring, RandomSameAsCctz) {
+  std::mt19937_64 generator{42};
+  for (int i = 0; i < 10000; ++i) {
+    const auto tp = MakeRandomTimePoint(generator);
+    ExpectSameAsCctz(tp);
+    // the cached date and time of the second
+    ExpectSameAsCctz(tp + std::chrono::microseconds{1});
+  }
+}
+
+TEST(Timestring, ParseRfc3339) {
+  using dt::impl::OffsetFormat;
+  const std::pair<std::string, OffsetFormat> kParsed[] = {
+      {"2023-01-02T03:04:05Z", OffsetFormat::kWithColon},
+      {"2023-01-02T03:04:05Z", OffsetFormat::kWithoutColon},
+      {"2023-01-02T03:04:05.123456+03:00", OffsetFormat::kWithColon},
+      {"2023-01-02T03:04:05.123456-03:30", OffsetFormat::kWithColon},
+      {"2023-01-02T03:04:05.123456+0300", OffsetFormat::kWithoutColon},
+      {"2023-01-02T03:04:05.1234567891234+00:00", OffsetFormat::kWithColon},
+      {"2024-02-29T00:00:00.000000001Z", OffsetFormat::kWithColon},
+      {"1969-12-31T23:59:59.9Z", OffsetFormat::kWithColon},
+      {"1900-01-01T00:00:00+23:59", OffsetFormat::kWithColon},
+      {"1700-01-01T00:00:00Z", OffsetFormat::kWithColon},
+  };
+  for (const auto& [timestring, offset_format] : kParsed) {
+    const auto tp = dt::impl::ParseRfc3339TimePoint(timestring, offset_format);
+    ASSERT_TRUE(tp) << timestring;
+    EXPECT_EQ(tp, ParseWithCctz(timestring, offset_format)) << timestring;
+  }
+
+  // left to cctz
+  const std::pair<std::string, OffsetFormat> kNotParsed[] = {
+      {"2023-01-02T03:04:05+0300", OffsetFormat::kWithColon},
+      {"2023-01-02T03:04:05+03:00", OffsetFormat::kWithoutColon},
+      {"2023-01-02T03:04:05+03", OffsetFormat::kWithColon},
+      {"2023-01-02T03:04:60Z", OffsetFormat::kWithColon},
+      {"2023-02-29T03:04:05Z", OffsetFormat::kWithColon},
+      {"2023-01-02T24:00:00Z", OffsetFormat::kWithColon},
+      {"2023-13-02T03:04:05Z", OffsetFormat::kWithColon},
+      {"2023-01-02T03:04:05.Z", OffsetFormat::kWithColon},
+      {"2023-01-02T03:04:05", OffsetFormat::kWithColon},
+      {"2023-01-02T03:04:05Z ", OffsetFormat::kWithColon},
+      {" 2023-01-02T03:04:05Z", OffsetFormat::kWithColon},
+      {"2023-01-02 03:04:05Z", OffsetFormat::kWithColon},
+      {"2023-01-02T03:04:05+24:00", OffsetFormat::kWithColon},
+      {"10000-01-02T03:04:05Z", OffsetFormat::kWithColon},
+      {"2023-1-02T03:04:05Z", OffsetFormat::kWithColon},
+  };
+  for (const auto& [timestring, offset_format] : kNotParsed) {
+    EXPECT_FALSE(dt::impl::ParseRfc3339(timestring, offset_format))
+        << timestring;
+  }
+}
+
+TEST(Timestring, RandomParseSameAsCctz) {
+  std::mt19937_64 generator{42};
+  std::uniform_int_distribution<int> offset_minutes{-23 * 60, 23 * 60};
+  for (int i = 0; i < 10000; ++i) {
+    const auto tp = MakeRandomTimePoint(generator);
+    const auto tz = cctz::fixed_time_zone(
+        std::chrono::minutes{offset_minutes(generator)});
+    for (const auto offset_format : {dt::impl::OffsetFormat::kWithColon,
+                                     dt::impl::OffsetFormat::kWithoutColon}) {
+      const auto timestring = cctz::format(
+          offset_format == dt::impl::OffsetFormat::kWithColon
+              ? dt::kRfc3339Format
+              : dt::kDefaultFormat,
+          tp, tz);
+      EXPECT_EQ(dt::impl::ParseRfc3339TimePoint(timestring, offset_format), tp)
+          << timestring;
+    }
+  }
+}
+
+TEST(Timestring, Stringtime) {
+  EXPECT_EQ(dt::Stringtime("2023-01-02T03:04:05.5+03:00", "UTC",
+                           dt::kRfc3339Format),
+            dt::Stringtime("2023-01-02T00:04:05.5+0000"));
+  // left to cctz
+  EXPECT_EQ(dt::Stringtime("2023-01-02T03:04:05+0300", "UTC",
+                           dt::kRfc3339Format),
+            dt::Stringtime("2023-01-02T00:04:05+0000"));
+  EXPECT_THROW(dt::Stringtime("2023-02-29T03:04:05+0000"),
+               dt::DateParseError);
+  EXPECT_EQ(dt::FromRfc3339StringSaturating("2023-01-02T03:04:05.5+03:00"),
+            dt::Stringtime("2023-01-02T00:04:05.5+0000"));
+}
+
+USERVER_NAMESPACE_END
@@ -109,6 +109,35 @@ bool IsXDigit(unsigned char x_digit) noexcept {
 const auto kLow4BitsMask = _mm_set1_epi8(0xf);
 const auto kDigitsMask = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
                                        '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+
+__m128i InRange(__m128i chars, char first, char last) {
+  return _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8(first - 1)),
+                       _mm_cmplt_epi8(chars, _mm_set1_epi8(last + 1)));
+}
+
+// Converts 16 hex characters into 8 bytes, returns false if any of the
+// characters is not a hex digit
+bool FromHexBlock(const char* input, char* output) noexcept {
+  const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+  const auto lowercase = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+
+  const auto is_digit = InRange(chars, '0', '9');
+  const auto is_letter = InRange(lowercase, 'a', 'f');
+  if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xffff) {
+    return false;
+  }
+
+  const auto values = _mm_or_si128(
+      _mm_and_si128(is_digit, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+      _mm_and_si128(is_letter,
+                    _mm_sub_epi8(lowercase, _mm_set1_epi8('a' - 10))));
+
+  // high * 16 + low for each pair of the characters
+  const auto bytes = _mm_maddubs_epi16(values, _mm_set1_epi16(0x0110));
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(output),
+                   _mm_packus_epi16(bytes, bytes));
+  return true;
+}
 #endif
 
 }  // namespace detail
@@ -133,10 +162,14 @@ std::string_view GetHexPart(std::string_view encoded) noexcept {
 
 void ToHex(std::string_view input, std::string& out) noexcept {
   out.clear();
-  out.resize(input.size() * 2);
+  out.resize(LengthInHexForm(input));
+  ToHexInto(input, out.data());
+}
+
+void ToHexInto(std::string_view input, char* out) noexcept {
   const auto* first = input.data();
   const auto* last = input.data() + input.size();
-  auto* dst = out.data();
+  auto* dst = out;
 
 #ifdef __SSSE3__
   while (last - first >= 8) {
@@ -186,10 +219,26 @@ bool IsHexData(std::string_view encoded) noexcept {
 }
 
 size_t FromHex(std::string_view encoded, std::string& out) noexcept {
+  const auto old_size = out.size();
+  out.resize(old_size + FromHexUpperBound(encoded.size()));
+  const auto parsed = FromHexInto(encoded, out.data() + old_size);
+  out.resize(old_size + parsed / 2);
+  return parsed;
+}
+
+size_t FromHexInto(std::string_view encoded, char* out) noexcept {
   // we need to read in pairs
   const char* first = encoded.data();
   const char* pair_ptr = first;
   const char* last = first + encoded.size();
+
+#ifdef __SSSE3__
+  for (; last - pair_ptr >= 16; pair_ptr += 16, out += 8) {
+    // the rest is parsed below up to the first non-hex character
+    if (!detail::FromHexBlock(pair_ptr, out)) break;
+  }
+#endif
+
   for (; pair_ptr != last; pair_ptr += 2) {
     if (!detail::IsXDigit(pair_ptr[0])) {
       break;
@@ -203,8 +252,8 @@ size_t FromHex(std::string_view encoded, std::string& out) noexcept {
       break;
     }
 
-    out.push_back((detail::GetXDigitValue(pair_ptr[0]) << 4) |
-                  (detail::GetXDigitValue(pair_ptr[1])));
+    *(out++) = (detail::GetXDigitValue(pair_ptr[0]) << 4) |
+               (detail::GetXDigitValue(pair_ptr[1]));
   }
 
   return static_cast<size_t>(std::distance(first, pair_ptr));
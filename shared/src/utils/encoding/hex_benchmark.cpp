@@ -42,4 +42,40 @@ void to_hex_benchmark_no_alloc(benchmark::State& state) {
 }
 BENCHMARK(to_hex_benchmark_no_alloc)->RangeMultiplier(2)->Range(8, 512);
 
+void to_hex_benchmark_into(benchmark::State& state) {
+  const auto source = GenerateSource(state.range(0));
+  std::string out(utils::encoding::LengthInHexForm(source), '\0');
+
+  for (auto _ : state) {
+    utils::encoding::ToHexInto(source, out.data());
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetBytesProcessed(state.iterations() * source.size());
+}
+BENCHMARK(to_hex_benchmark_into)->RangeMultiplier(8)->Range(8, 1 << 20);
+
+void from_hex_benchmark(benchmark::State& state) {
+  const auto encoded =
+      utils::encoding::ToHex(GenerateSource(state.range(0) / 2));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utils::encoding::FromHex(encoded));
+  }
+  state.SetBytesProcessed(state.iterations() * encoded.size());
+}
+BENCHMARK(from_hex_benchmark)->RangeMultiplier(8)->Range(8, 1 << 20);
+
+void from_hex_benchmark_into(benchmark::State& state) {
+  const auto encoded =
+      utils::encoding::ToHex(GenerateSource(state.range(0) / 2));
+  std::string out(utils::encoding::FromHexUpperBound(encoded.size()), '\0');
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        utils::encoding::FromHexInto(encoded, out.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * encoded.size());
+}
+BENCHMARK(from_hex_benchmark_into)->RangeMultiplier(8)->Range(8, 1 << 20);
+
 USERVER_NAMESPACE_END
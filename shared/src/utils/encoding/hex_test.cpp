@@ -138,6 +138,21 @@ TEST(Hex, GetHexPart) {
   }
 }
 
+TEST(Hex, IntoBuffer) {
+  constexpr std::string_view data{"21e30c92afe54396_+=156"};
+  std::string hex(LengthInHexForm(data), '\0');
+  ToHexInto(data, hex.data());
+  EXPECT_EQ(ToHex(data), hex);
+
+  // upper case and an invalid character after the SIMD-sized prefix
+  const std::string encoded = "32316533306339326166653534333936" "5F2B3D!3";
+  std::string decoded(FromHexUpperBound(encoded.size()), '\0');
+  const auto parsed = FromHexInto(encoded, decoded.data());
+  EXPECT_EQ(38, parsed);
+  decoded.resize(parsed / 2);
+  EXPECT_EQ("21e30c92afe54396_+=", decoded);
+}
+
 }  // namespace utils::encoding
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,138 @@
+#include <userver/utils/encoding/tskv.hpp>
+
+#include <array>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define USERVER_IMPL_TSKV_SIMD 1
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::encoding::impl {
+
+namespace {
+
+using CharTable = std::array<bool, 256>;
+
+// Must match the characters EncodeTskv(T&, char, ...) changes
+constexpr CharTable MakeSpecialCharsTable(EncodeTskvMode mode) {
+  CharTable table{};
+  for (const unsigned char c : {'\t', '\r', '\n', '\0', '\\'}) table[c] = true;
+
+  if (mode != EncodeTskvMode::kValue) {
+    table['='] = true;
+    for (int c = 'A'; c <= 'Z'; ++c) table[c] = true;
+  }
+  if (mode == EncodeTskvMode::kKeyReplacePeriod) table['.'] = true;
+
+  return table;
+}
+
+template <EncodeTskvMode Mode>
+constexpr CharTable kSpecialChars = MakeSpecialCharsTable(Mode);
+
+#ifdef USERVER_IMPL_TSKV_SIMD
+// The upper case letters map to the lowest signed values after the shift
+constexpr char kUpperShift = static_cast<char>(128 - 'A');
+constexpr char kUpperBound = static_cast<char>(-128 + 26);
+
+// SSE2 is in the x86_64 baseline, no need for a runtime check
+template <EncodeTskvMode Mode>
+const char* FindSpecialCharSse2(const char* begin, const char* end) {
+  while (end - begin >= 16) {
+    const __m128i data =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    __m128i special = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8('\t')),
+                     _mm_cmpeq_epi8(data, _mm_set1_epi8('\r'))),
+        _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8('\n')),
+                     _mm_cmpeq_epi8(data, _mm_setzero_si128())));
+    special = _mm_or_si128(special, _mm_cmpeq_epi8(data, _mm_set1_epi8('\\')));
+
+    if constexpr (Mode != EncodeTskvMode::kValue) {
+      const __m128i shifted = _mm_add_epi8(data, _mm_set1_epi8(kUpperShift));
+      special = _mm_or_si128(
+          _mm_or_si128(special, _mm_cmpeq_epi8(data, _mm_set1_epi8('='))),
+          _mm_cmplt_epi8(shifted, _mm_set1_epi8(kUpperBound)));
+    }
+    if constexpr (Mode == EncodeTskvMode::kKeyReplacePeriod) {
+      special = _mm_or_si128(special, _mm_cmpeq_epi8(data, _mm_set1_epi8('.')));
+    }
+
+    const auto mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+    if (mask != 0) return begin + __builtin_ctz(mask);
+    begin += 16;
+  }
+  return begin;
+}
+
+template <EncodeTskvMode Mode>
+__attribute__((target("avx2"))) const char* FindSpecialCharAvx2(
+    const char* begin, const char* end) {
+  while (end - begin >= 32) {
+    const __m256i data =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    __m256i special = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(data, _mm256_set1_epi8('\t')),
+                        _mm256_cmpeq_epi8(data, _mm256_set1_epi8('\r'))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(data, _mm256_set1_epi8('\n')),
+                        _mm256_cmpeq_epi8(data, _mm256_setzero_si256())));
+    special = _mm256_or_si256(special,
+                              _mm256_cmpeq_epi8(data, _mm256_set1_epi8('\\')));
+
+    if constexpr (Mode != EncodeTskvMode::kValue) {
+      const __m256i shifted =
+          _mm256_add_epi8(data, _mm256_set1_epi8(kUpperShift));
+      special = _mm256_or_si256(
+          _mm256_or_si256(special,
+                          _mm256_cmpeq_epi8(data, _mm256_set1_epi8('='))),
+          _mm256_cmpgt_epi8(_mm256_set1_epi8(kUpperBound), shifted));
+    }
+    if constexpr (Mode == EncodeTskvMode::kKeyReplacePeriod) {
+      special = _mm256_or_si256(special,
+                                _mm256_cmpeq_epi8(data, _mm256_set1_epi8('.')));
+    }
+
+    const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(special));
+    if (mask != 0) return begin + __builtin_ctz(mask);
+    begin += 32;
+  }
+  return begin;
+}
+
+const bool kHasAvx2 = [] {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+}();
+#endif
+
+template <EncodeTskvMode Mode>
+const char* FindSpecialChar(const char* begin, const char* end) {
+#ifdef USERVER_IMPL_TSKV_SIMD
+  if (kHasAvx2) begin = FindSpecialCharAvx2<Mode>(begin, end);
+  begin = FindSpecialCharSse2<Mode>(begin, end);
+#endif
+  const auto& table = kSpecialChars<Mode>;
+  while (begin != end && !table[static_cast<unsigned char>(*begin)]) ++begin;
+  return begin;
+}
+
+}  // namespace
+
+const char* FindTskvSpecialChar(const char* begin, const char* end,
+                                EncodeTskvMode mode) noexcept {
+  switch (mode) {
+    case EncodeTskvMode::kKey:
+      return FindSpecialChar<EncodeTskvMode::kKey>(begin, end);
+    case EncodeTskvMode::kValue:
+      return FindSpecialChar<EncodeTskvMode::kValue>(begin, end);
+    case EncodeTskvMode::kKeyReplacePeriod:
+      return FindSpecialChar<EncodeTskvMode::kKeyReplacePeriod>(begin, end);
+  }
+  return begin;
+}
+
+}  // namespace utils::encoding::impl
+
+USERVER_NAMESPACE_END
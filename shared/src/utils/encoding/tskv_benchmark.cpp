@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <userver/utils/encoding/tskv.hpp>
+#include <utils/encoding/tskv_testdata_bin.hpp>
+
+#include <string>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string GenerateText(size_t size) {
+  std::string source;
+  source.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    source.push_back('a' + i % 26);
+  }
+
+  return source;
+}
+
+void EncodeBenchmark(benchmark::State& state, std::string_view source,
+                     utils::encoding::EncodeTskvMode mode) {
+  std::string out;
+  out.reserve(source.size() * 2);
+
+  for (auto _ : state) {
+    out.clear();
+    utils::encoding::EncodeTskv(out, source.data(),
+                                source.data() + source.size(), mode);
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetBytesProcessed(state.iterations() * source.size());
+}
+
+}  // namespace
+
+void tskv_encode_value_clean(benchmark::State& state) {
+  const auto source = GenerateText(state.range(0));
+  EncodeBenchmark(state, source, utils::encoding::EncodeTskvMode::kValue);
+}
+BENCHMARK(tskv_encode_value_clean)->RangeMultiplier(4)->Range(8, 8192);
+
+void tskv_encode_key_clean(benchmark::State& state) {
+  const auto source = GenerateText(state.range(0));
+  EncodeBenchmark(state, source,
+                  utils::encoding::EncodeTskvMode::kKeyReplacePeriod);
+}
+BENCHMARK(tskv_encode_key_clean)->RangeMultiplier(4)->Range(8, 512);
+
+void tskv_encode_value_binary(benchmark::State& state) {
+  const std::string_view source{
+      reinterpret_cast<const char*>(tskv_test::data_bin),
+      sizeof(tskv_test::data_bin)};
+  EncodeBenchmark(state, source, utils::encoding::EncodeTskvMode::kValue);
+}
+BENCHMARK(tskv_encode_value_binary);
+
+void tskv_should_value_be_escaped(benchmark::State& state) {
+  const auto source = GenerateText(state.range(0));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utils::encoding::ShouldValueBeEscaped(source));
+  }
+  state.SetBytesProcessed(state.iterations() * source.size());
+}
+BENCHMARK(tskv_should_value_be_escaped)->RangeMultiplier(4)->Range(8, 8192);
+
+USERVER_NAMESPACE_END
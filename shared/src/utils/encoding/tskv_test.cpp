@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <string>
 
 #include <gtest/gtest.h>
 
@@ -35,4 +36,34 @@ TEST(tskv, TAXICOMMON1362) {
       << "Result: " << result;
 }
 
+TEST(tskv, SpecialCharsAtEveryPosition) {
+  using utils::encoding::EncodeTskvMode;
+
+  // Covers the vectorized scan strides and the scalar tail
+  for (const char special : {'\t', '\r', '\n', '\0', '\\', '=', '.', 'Q'}) {
+    for (std::size_t size = 1; size <= 70; ++size) {
+      for (std::size_t pos = 0; pos < size; ++pos) {
+        std::string source(size, 'x');
+        source[pos] = special;
+
+        for (auto mode : {EncodeTskvMode::kKey, EncodeTskvMode::kValue,
+                          EncodeTskvMode::kKeyReplacePeriod}) {
+          std::string expected;
+          for (const char c : source) {
+            utils::encoding::EncodeTskv(expected, c, mode);
+          }
+
+          std::string result;
+          utils::encoding::EncodeTskv(result, source, mode);
+          ASSERT_EQ(result, expected) << "size=" << size << " pos=" << pos;
+        }
+
+        EXPECT_EQ(utils::encoding::ShouldValueBeEscaped(source),
+                  special != '=' && special != '.' && special != 'Q');
+        EXPECT_TRUE(utils::encoding::ShouldKeyBeEscaped(source));
+      }
+    }
+  }
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,107 @@
+#include <userver/utils/flat_hash_map.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// A typical value of a cache
+struct Value {
+  std::int64_t id{0};
+  std::int64_t revision{0};
+};
+
+using StdMap = std::unordered_map<std::string, Value>;
+using FlatMap = utils::FlatHashMap<std::string, Value>;
+
+std::vector<std::string> MakeKeys(std::size_t count) {
+  std::vector<std::string> keys;
+  keys.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    keys.push_back("key_" + std::to_string(i));
+  }
+  return keys;
+}
+
+template <typename Map>
+Map MakeMap(const std::vector<std::string>& keys) {
+  Map map;
+  map.reserve(keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    map[keys[i]] = Value{static_cast<std::int64_t>(i), 0};
+  }
+  return map;
+}
+
+template <typename Map>
+void HashMapInsert(benchmark::State& state) {
+  const auto keys = MakeKeys(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    Map map;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      map[keys[i]] = Value{static_cast<std::int64_t>(i), 0};
+    }
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Map>
+void HashMapFind(benchmark::State& state) {
+  auto keys = MakeKeys(state.range(0));
+  const auto map = MakeMap<Map>(keys);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937{42});
+
+  std::size_t i = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(map.find(keys[i]));
+    if (++i == keys.size()) i = 0;
+  }
+}
+
+template <typename Map>
+void HashMapFindMissing(benchmark::State& state) {
+  const auto map = MakeMap<Map>(MakeKeys(state.range(0)));
+  std::vector<std::string> missing;
+  for (std::size_t i = 0; i < 1024; ++i) {
+    missing.push_back("missing_" + std::to_string(i));
+  }
+
+  std::size_t i = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(map.find(missing[i]));
+    if (++i == missing.size()) i = 0;
+  }
+}
+
+template <typename Map>
+void HashMapIterate(benchmark::State& state) {
+  const auto map = MakeMap<Map>(MakeKeys(state.range(0)));
+  for ([[maybe_unused]] auto _ : state) {
+    std::int64_t sum = 0;
+    for (const auto& [key, value] : map) sum += value.id;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * map.size());
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(HashMapInsert, StdMap)->Range(1000, 10'000'000);
+BENCHMARK_TEMPLATE(HashMapInsert, FlatMap)->Range(1000, 10'000'000);
+BENCHMARK_TEMPLATE(HashMapFind, StdMap)->Range(1000, 10'000'000);
+BENCHMARK_TEMPLATE(HashMapFind, FlatMap)->Range(1000, 10'000'000);
+BENCHMARK_TEMPLATE(HashMapFindMissing, StdMap)->Range(1000, 10'000'000);
+BENCHMARK_TEMPLATE(HashMapFindMissing, FlatMap)->Range(1000, 10'000'000);
+BENCHMARK_TEMPLATE(HashMapIterate, StdMap)->Range(1000, 10'000'000);
+BENCHMARK_TEMPLATE(HashMapIterate, FlatMap)->Range(1000, 10'000'000);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,165 @@
+#include <userver/utils/flat_hash_map.hpp>
+
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Map = utils::FlatHashMap<int, std::string>;
+
+std::map<int, std::string> ToStdMap(const Map& map) {
+  return {map.begin(), map.end()};
+}
+
+// All the keys collide
+struct BadHash {
+  std::size_t operator()(int) const noexcept { return 42; }
+};
+
+}  // namespace
+
+static_assert(meta::kIsMap<Map>);
+
+TEST(FlatHashMap, Sample) {
+  /// [FlatHashMap usage]
+  utils::FlatHashMap<std::string, int> map;
+  map.reserve(2);
+  map["a"] = 1;
+  EXPECT_TRUE(map.try_emplace("b", 2).second);
+  EXPECT_FALSE(map.try_emplace("b", 3).second);
+
+  EXPECT_EQ(map.at("b"), 2);
+  EXPECT_EQ(map.find("c"), map.end());
+  EXPECT_EQ(map.erase("a"), 1);
+  EXPECT_EQ(map.size(), 1);
+  /// [FlatHashMap usage]
+}
+
+TEST(FlatHashMap, Empty) {
+  const Map map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_EQ(map.capacity(), 0);
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.find(1), map.end());
+  EXPECT_EQ(map.count(1), 0);
+  EXPECT_THROW(map.at(1), std::out_of_range);
+}
+
+TEST(FlatHashMap, Modification) {
+  Map map;
+  EXPECT_TRUE(map.insert_or_assign(1, "a").second);
+  EXPECT_FALSE(map.insert_or_assign(1, "b").second);
+  map[2] = "c";
+  map[2] += "d";
+  EXPECT_TRUE(map.emplace(3, "e").second);
+  EXPECT_FALSE(map.insert({3, "f"}).second);
+  EXPECT_EQ(ToStdMap(map),
+            (std::map<int, std::string>{{1, "b"}, {2, "cd"}, {3, "e"}}));
+
+  EXPECT_EQ(map.erase(2), 1);
+  EXPECT_EQ(map.erase(2), 0);
+  EXPECT_FALSE(map.contains(2));
+  EXPECT_EQ(ToStdMap(map), (std::map<int, std::string>{{1, "b"}, {3, "e"}}));
+
+  const auto capacity = map.capacity();
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.capacity(), capacity);
+}
+
+TEST(FlatHashMap, EraseIterator) {
+  Map map;
+  for (int i = 0; i < 100; ++i) map[i] = std::to_string(i);
+
+  for (auto it = map.begin(); it != map.end();) {
+    if (it->first % 2 == 0) {
+      it = map.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  EXPECT_EQ(map.size(), 50);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(map.contains(i), i % 2 == 1) << i;
+  }
+}
+
+TEST(FlatHashMap, CopyAndMove) {
+  Map map{{1, "a"}, {2, "b"}};
+  Map copy{map};
+  EXPECT_EQ(copy, map);
+  copy[3] = "c";
+  EXPECT_NE(copy, map);
+  EXPECT_EQ(map.size(), 2);
+
+  Map moved{std::move(copy)};
+  EXPECT_EQ(moved.size(), 3);
+  // NOLINTNEXTLINE(bugprone-use-after-move)
+  EXPECT_TRUE(copy.empty());
+  copy[4] = "d";
+  EXPECT_EQ(copy.size(), 1);
+
+  moved = map;
+  EXPECT_EQ(moved, map);
+  map = std::move(copy);
+  EXPECT_EQ(ToStdMap(map), (std::map<int, std::string>{{4, "d"}}));
+}
+
+TEST(FlatHashMap, Collisions) {
+  utils::FlatHashMap<int, int, BadHash> map;
+  for (int i = 0; i < 100; ++i) map[i] = i;
+  for (int i = 0; i < 100; i += 3) map.erase(i);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(map.contains(i), i % 3 != 0) << i;
+  }
+  EXPECT_EQ(map.size(), 66);
+}
+
+TEST(FlatHashMap, MoveOnly) {
+  utils::FlatHashMap<std::string, std::unique_ptr<int>> map;
+  for (int i = 0; i < 100; ++i) {
+    map.try_emplace(std::to_string(i), std::make_unique<int>(i));
+  }
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(map.at(std::to_string(i)));
+    EXPECT_EQ(*map.at(std::to_string(i)), i);
+  }
+}
+
+TEST(FlatHashMap, Random) {
+  Map map;
+  std::unordered_map<int, std::string> expected;
+  std::minstd_rand rand;
+  for (int i = 0; i < 100000; ++i) {
+    const auto key = static_cast<int>(rand() % 1000);
+    switch (rand() % 4) {
+      case 0:
+        EXPECT_EQ(map.erase(key), expected.erase(key));
+        break;
+      case 1:
+        EXPECT_EQ(map.contains(key), expected.count(key) == 1);
+        break;
+      default:
+        map[key] = std::to_string(i);
+        expected[key] = std::to_string(i);
+    }
+    ASSERT_EQ(map.size(), expected.size());
+  }
+  EXPECT_EQ(ToStdMap(map),
+            (std::map<int, std::string>{expected.begin(), expected.end()}));
+  // growth is limited by the reclaiming of the deleted slots
+  EXPECT_LE(map.capacity(), 4095);
+}
+
+USERVER_NAMESPACE_END
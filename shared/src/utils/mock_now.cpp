@@ -5,6 +5,8 @@
 #include <userver/utils/assert.hpp>
 #include <userver/utils/atomic.hpp>
 
+#include <utils/datetime/coarse_clock_gettime.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace utils::datetime {
@@ -35,6 +37,14 @@ std::chrono::steady_clock::time_point MockSteadyNow() noexcept {
                    mocked_now_value.time_since_epoch()};
 }
 
+std::chrono::steady_clock::time_point MockSteadyCoarseNow() noexcept {
+  const auto mocked_now_value = now.load();
+  return mocked_now_value == kNotMocked
+             ? SteadyCoarseNowAsSteady()
+             : std::chrono::steady_clock::time_point{
+                   mocked_now_value.time_since_epoch()};
+}
+
 void MockNowSet(std::chrono::system_clock::time_point new_mocked_now) {
   UINVARIANT(new_mocked_now != kNotMocked,
              "This mocked time value is reserved, "
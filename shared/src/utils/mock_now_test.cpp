@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <userver/utils/datetime.hpp>
+#include <userver/utils/datetime/steady_coarse_clock.hpp>
 #include <userver/utils/mock_now.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -38,6 +39,24 @@ TEST(MockNow, Timer) {
 }
 /// [Mocked time sample]
 
+TEST(MockNow, SteadyCoarseNow) {
+  const auto before = utils::datetime::SteadyNow();
+  const auto coarse = utils::datetime::SteadyCoarseNow();
+  const auto after = utils::datetime::SteadyNow();
+  EXPECT_LE(coarse, after);
+  EXPECT_GE(coarse + 2 * utils::datetime::SteadyCoarseClock::resolution(),
+            before);
+
+  utils::datetime::MockNowSet(
+      utils::datetime::Stringtime("2000-01-01T00:00:00+0000"));
+  EXPECT_EQ(utils::datetime::SteadyCoarseNow(),
+            utils::datetime::SteadyNow());
+  utils::datetime::MockSleep(10ms);
+  EXPECT_EQ(utils::datetime::SteadyCoarseNow(),
+            utils::datetime::SteadyNow());
+  utils::datetime::MockNowUnset();
+}
+
 }  // namespace
 
 USERVER_NAMESPACE_END
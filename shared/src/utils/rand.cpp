@@ -1,6 +1,7 @@
 #include <userver/utils/rand.hpp>
 
-#include <array>
+#include <cstdint>
+#include <limits>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -8,37 +9,45 @@ namespace utils {
 
 namespace {
 
-// 256 bits of randomness is enough for everyone
-constexpr std::size_t kRandomSeedInts = 8;
-
+// The state is small enough to be seeded on every thread quickly, unlike the
+// 2.5KB of std::mt19937
 class RandomImpl final : public RandomBase {
  public:
-  // NOLINTNEXTLINE(cert-msc51-cpp)
-  RandomImpl() {
-    std::random_device device;
-
-    std::array<std::seed_seq::result_type, kRandomSeedInts> random_chunks{};
-    for (auto& random_chunk : random_chunks) {
-      random_chunk = device();
-    }
-
-    std::seed_seq seed(random_chunks.begin(), random_chunks.end());
-    gen_.seed(seed);
+  result_type operator()() override {
+    // the upper bits of xoshiro256++ are of a better quality
+    return static_cast<result_type>(gen_() >> 32);
   }
 
-  result_type operator()() override { return gen_(); }
-
  private:
-  std::mt19937 gen_;
+  FastRandom gen_;
 };
 
+static_assert(RandomBase::min() == 0 &&
+              RandomBase::max() == std::numeric_limits<std::uint32_t>::max());
+
 }  // namespace
 
+// NOLINTNEXTLINE(cert-msc51-cpp)
+FastRandom::FastRandom() {
+  // 256 bits of randomness is enough for everyone
+  std::random_device device;
+  for (auto& word : state_) {
+    word = (std::uint64_t{device()} << 32) | device();
+  }
+  // xoshiro would never leave the all-zero state
+  if (state_ == decltype(state_){}) state_[0] = 1;
+}
+
 RandomBase& DefaultRandom() {
   thread_local RandomImpl random;
   return random;
 }
 
+FastRandom& DefaultFastRandom() {
+  thread_local FastRandom random;
+  return random;
+}
+
 uint32_t Rand() {
   return std::uniform_int_distribution<uint32_t>{0}(DefaultRandom());
 }
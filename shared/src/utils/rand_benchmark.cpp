@@ -0,0 +1,52 @@
+#include <userver/utils/rand.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/utils/uuid4.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+void RandomDefault(benchmark::State& state) {
+  auto& random = utils::DefaultRandom();
+  for (auto _ : state) benchmark::DoNotOptimize(random());
+}
+BENCHMARK(RandomDefault);
+
+void RandomFast(benchmark::State& state) {
+  auto& random = utils::DefaultFastRandom();
+  for (auto _ : state) benchmark::DoNotOptimize(random());
+}
+BENCHMARK(RandomFast);
+
+void UuidSingle(benchmark::State& state) {
+  const auto count = state.range(0);
+  for (auto _ : state) {
+    std::vector<std::string> uuids;
+    uuids.reserve(count);
+    for (std::int64_t i = 0; i < count; ++i) {
+      uuids.push_back(utils::generators::GenerateUuid());
+    }
+    benchmark::DoNotOptimize(uuids);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(UuidSingle)->Arg(1)->Arg(64);
+
+void UuidBatch(benchmark::State& state) {
+  const auto count = state.range(0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utils::generators::GenerateUuids(count));
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(UuidBatch)->Arg(1)->Arg(64);
+
+}  // namespace
+
+USERVER_NAMESPACE_END
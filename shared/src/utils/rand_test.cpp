@@ -1,6 +1,7 @@
 #include <userver/utils/rand.hpp>
 
 #include <random>
+#include <set>
 #include <type_traits>
 
 #include <gtest/gtest.h>
@@ -36,4 +37,31 @@ TEST(Random, RandRange) {
   }
 }
 
+TEST(Random, FastRandomSeed) {
+  utils::FastRandom first{42};
+  utils::FastRandom second{42};
+  utils::FastRandom other{43};
+  for (int iter = 0; iter < kIterations; ++iter) {
+    const auto x = first();
+    EXPECT_EQ(x, second());
+    EXPECT_NE(x, other());
+  }
+}
+
+TEST(Random, DefaultFastRandom) {
+  auto& random = utils::DefaultFastRandom();
+  EXPECT_EQ(&random, &utils::DefaultFastRandom());
+
+  std::set<std::uint64_t> values;
+  for (int iter = 0; iter < kIterations; ++iter) values.insert(random());
+  EXPECT_EQ(values.size(), kIterations);
+
+  std::uniform_int_distribution distribution{1, 6};
+  for (int iter = 0; iter < kIterations; ++iter) {
+    const auto x = distribution(random);
+    EXPECT_GE(x, 1);
+    EXPECT_LE(x, 6);
+  }
+}
+
 USERVER_NAMESPACE_END
@@ -1,8 +1,10 @@
 #include <userver/utils/trivial_map.hpp>
 
+#include <cstddef>
 #include <mutex>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -293,4 +295,163 @@ void MappingHugeUnorderedLast(benchmark::State& state) {
 }
 BENCHMARK(MappingHugeUnorderedLast);
 
+// Keys of different lengths, like the option names usually are
+#define CASES_8(prefix, value)            \
+  .Case(prefix "a", value)                \
+      .Case(prefix "bb", value + 1)       \
+      .Case(prefix "ccc", value + 2)      \
+      .Case(prefix "dddd", value + 3)     \
+      .Case(prefix "eeeee", value + 4)    \
+      .Case(prefix "ffffff", value + 5)   \
+      .Case(prefix "ggggggg", value + 6)  \
+      .Case(prefix "hhhhhhhh", value + 7)
+#define CASES_16(prefix, value) \
+  CASES_8(prefix "a_", value) CASES_8(prefix "bb_", value + 8)
+#define CASES_32(prefix, value) \
+  CASES_16(prefix "a_", value) CASES_16(prefix "bb_", value + 16)
+#define CASES_64(prefix, value) \
+  CASES_32(prefix "a_", value) CASES_32(prefix "bb_", value + 32)
+#define CASES_128(prefix, value) \
+  CASES_64(prefix "a_", value) CASES_64(prefix "bb_", value + 64)
+
+template <std::size_t Size>
+struct SizedBuilder;
+
+template <>
+struct SizedBuilder<16> {
+  template <typename Selector>
+  constexpr auto operator()(Selector selector) const {
+    return selector() CASES_16("option_", 0);
+  }
+};
+
+template <>
+struct SizedBuilder<32> {
+  template <typename Selector>
+  constexpr auto operator()(Selector selector) const {
+    return selector() CASES_32("option_", 0);
+  }
+};
+
+template <>
+struct SizedBuilder<64> {
+  template <typename Selector>
+  constexpr auto operator()(Selector selector) const {
+    return selector() CASES_64("option_", 0);
+  }
+};
+
+template <>
+struct SizedBuilder<128> {
+  template <typename Selector>
+  constexpr auto operator()(Selector selector) const {
+    return selector() CASES_128("option_", 0);
+  }
+};
+
+template <std::size_t Size>
+constexpr auto CollectCases() {
+  return SizedBuilder<Size>{}([] {
+           return utils::impl::CaseCollector<std::string_view, int, Size>{};
+         })
+      .Extract();
+}
+
+template <std::size_t Size>
+constexpr utils::impl::SearchTable<std::string_view, int, Size>
+    kStringSearchTable{CollectCases<Size>(), utils::impl::ByFirst{}};
+
+template <std::size_t Size>
+constexpr utils::impl::SearchTable<int, std::string_view, Size>
+    kIntSearchTable{CollectCases<Size>(), utils::impl::BySecond{}};
+
+template <std::size_t Size>
+std::vector<std::string_view> StringKeys() {
+  std::vector<std::string_view> keys;
+  for (const auto& entry : CollectCases<Size>()) {
+    keys.push_back(MyLaunder(entry.first));
+  }
+  keys.push_back(MyLaunder("option_missing"));
+  return keys;
+}
+
+template <std::size_t Size>
+std::vector<int> IntKeys() {
+  std::vector<int> keys;
+  for (std::size_t i = 0; i <= Size; ++i) {
+    keys.push_back(Launder(static_cast<int>(i * 7 % (Size + 1))));
+  }
+  return keys;
+}
+
+// The chain of comparisons, used by TrivialBiMap for small maps
+template <std::size_t Size>
+void MappingSizeStringComparisons(benchmark::State& state) {
+  const auto keys = StringKeys<Size>();
+  for (auto _ : state) {
+    for (const auto key : keys) {
+      benchmark::DoNotOptimize(SizedBuilder<Size>{}([key] {
+                                 return utils::impl::SwitchByFirst<
+                                     std::string_view, int>{key};
+                               }).Extract());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// The hash table built at compile time, used by TrivialBiMap for large maps
+template <std::size_t Size>
+void MappingSizeStringSearchTable(benchmark::State& state) {
+  const auto keys = StringKeys<Size>();
+  for (auto _ : state) {
+    for (const auto key : keys) {
+      benchmark::DoNotOptimize(kStringSearchTable<Size>.Find(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <std::size_t Size>
+void MappingSizeIntComparisons(benchmark::State& state) {
+  const auto keys = IntKeys<Size>();
+  for (auto _ : state) {
+    for (const auto key : keys) {
+      benchmark::DoNotOptimize(SizedBuilder<Size>{}([key] {
+                                 return utils::impl::SwitchBySecond<
+                                     std::string_view, int>{key};
+                               }).Extract());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <std::size_t Size>
+void MappingSizeIntSearchTable(benchmark::State& state) {
+  const auto keys = IntKeys<Size>();
+  for (auto _ : state) {
+    for (const auto key : keys) {
+      benchmark::DoNotOptimize(kIntSearchTable<Size>.Find(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+BENCHMARK_TEMPLATE(MappingSizeStringComparisons, 16);
+BENCHMARK_TEMPLATE(MappingSizeStringSearchTable, 16);
+BENCHMARK_TEMPLATE(MappingSizeStringComparisons, 32);
+BENCHMARK_TEMPLATE(MappingSizeStringSearchTable, 32);
+BENCHMARK_TEMPLATE(MappingSizeStringComparisons, 64);
+BENCHMARK_TEMPLATE(MappingSizeStringSearchTable, 64);
+BENCHMARK_TEMPLATE(MappingSizeStringComparisons, 128);
+BENCHMARK_TEMPLATE(MappingSizeStringSearchTable, 128);
+
+BENCHMARK_TEMPLATE(MappingSizeIntComparisons, 16);
+BENCHMARK_TEMPLATE(MappingSizeIntSearchTable, 16);
+BENCHMARK_TEMPLATE(MappingSizeIntComparisons, 32);
+BENCHMARK_TEMPLATE(MappingSizeIntSearchTable, 32);
+BENCHMARK_TEMPLATE(MappingSizeIntComparisons, 64);
+BENCHMARK_TEMPLATE(MappingSizeIntSearchTable, 64);
+BENCHMARK_TEMPLATE(MappingSizeIntComparisons, 128);
+BENCHMARK_TEMPLATE(MappingSizeIntSearchTable, 128);
+
 USERVER_NAMESPACE_END
@@ -31,6 +31,162 @@ TEST(TrivialBiMap, StringBasicDescribe) {
   EXPECT_EQ(kToInt.DescribeFirst(), "'zero', 'one', 'two', 'three', 'four'");
 }
 
+// Above the size threshold, searched in a table sorted at compile time
+constexpr utils::TrivialBiMap kManyToInt = [](auto selector) {
+  return selector()
+      .Case("zero", 0)
+      .Case("one", 1)
+      .Case("two", 2)
+      .Case("three", 3)
+      .Case("four", 4)
+      .Case("five", 5)
+      .Case("six", 6)
+      .Case("seven", 7)
+      .Case("eight", 8)
+      .Case("nine", 9)
+      .Case("ten", 10)
+      .Case("eleven", 11)
+      .Case("twelve", 12)
+      .Case("thirteen", 13)
+      .Case("fourteen", 14)
+      .Case("fifteen", 15)
+      .Case("sixteen", 16)
+      .Case("seventeen", 17)
+      .Case("eighteen", 18)
+      .Case("nineteen", 19)
+      .Case("twenty", 20)
+      .Case("twenty one", 21)
+      .Case("twenty two", 22)
+      .Case("twenty three", 23)
+      .Case("twenty four", 24)
+      .Case("twenty five", 25)
+      .Case("twenty six", 26)
+      .Case("twenty seven", 27)
+      .Case("twenty eight", 28)
+      .Case("twenty nine", 29)
+      .Case("thirty", 30)
+      .Case("thirty one", 31)
+      .Case("thirty two", 32)
+      .Case("thirty three", 33)
+      .Case("thirty four", 34)
+      .Case("thirty five", 35)
+      .Case("thirty six", 36)
+      .Case("thirty seven", 37)
+      .Case("thirty eight", 38)
+      .Case("thirty nine", 39)
+      .Case("forty", 40)
+      .Case("forty one", 41)
+      .Case("forty two", 42)
+      .Case("forty three", 43)
+      .Case("forty four", 44)
+      .Case("forty five", 45)
+      .Case("forty six", 46)
+      .Case("forty seven", 47)
+      .Case("forty eight", 48)
+      .Case("forty nine", 49)
+      .Case("fifty", 50)
+      .Case("fifty one", 51)
+      .Case("fifty two", 52)
+      .Case("fifty three", 53)
+      .Case("fifty four", 54)
+      .Case("fifty five", 55)
+      .Case("fifty six", 56)
+      .Case("fifty seven", 57)
+      .Case("fifty eight", 58)
+      .Case("fifty nine", 59)
+      .Case("sixty", 60)
+      .Case("sixty one", 61)
+      .Case("sixty two", 62)
+      .Case("sixty three", 63)
+      .Case("sixty four", 64)
+      .Case("sixty five", 65)
+      .Case("sixty six", 66)
+      .Case("sixty seven", 67)
+      .Case("sixty eight", 68)
+      .Case("sixty nine", 69)
+      .Case("zero again", 0);
+};
+
+static_assert(kManyToInt.TryFind("twenty two") == 22);
+static_assert(kManyToInt.TryFind(65) == std::string_view{"sixty five"});
+
+TEST(TrivialBiMap, StringMany) {
+  EXPECT_EQ(kManyToInt.size(), 71);
+
+  for (int i = 0; i < 70; ++i) {
+    const auto name = kManyToInt.TryFind(i);
+    ASSERT_TRUE(name);
+    EXPECT_EQ(kManyToInt.TryFind(*name), i);
+  }
+  EXPECT_EQ(kManyToInt.TryFind("zero again"), 0);
+  // the first Case statement wins, as for the small maps
+  EXPECT_EQ(kManyToInt.TryFind(0), "zero");
+
+  EXPECT_FALSE(kManyToInt.TryFind(70));
+  EXPECT_FALSE(kManyToInt.TryFind(-1));
+  EXPECT_FALSE(kManyToInt.TryFind(""));
+  EXPECT_FALSE(kManyToInt.TryFind("seventy"));
+  EXPECT_FALSE(kManyToInt.TryFind("Twenty two"));
+  EXPECT_EQ(kManyToInt.TryFindICase("Twenty two"), 22);
+}
+
+constexpr utils::TrivialSet kManyPrimes = [](auto selector) {
+  return selector()
+      .Case(173)
+      .Case(167)
+      .Case(163)
+      .Case(157)
+      .Case(151)
+      .Case(149)
+      .Case(139)
+      .Case(137)
+      .Case(131)
+      .Case(127)
+      .Case(113)
+      .Case(109)
+      .Case(107)
+      .Case(103)
+      .Case(101)
+      .Case(97)
+      .Case(89)
+      .Case(83)
+      .Case(79)
+      .Case(73)
+      .Case(71)
+      .Case(67)
+      .Case(61)
+      .Case(59)
+      .Case(53)
+      .Case(47)
+      .Case(43)
+      .Case(41)
+      .Case(37)
+      .Case(31)
+      .Case(29)
+      .Case(23)
+      .Case(19)
+      .Case(17)
+      .Case(13)
+      .Case(11)
+      .Case(7)
+      .Case(5)
+      .Case(3)
+      .Case(2);
+};
+
+TEST(TrivialSet, IntsMany) {
+  EXPECT_EQ(kManyPrimes.size(), 40);
+
+  int primes_count = 0;
+  for (int i = -1; i < 200; ++i) {
+    if (kManyPrimes.Contains(i)) ++primes_count;
+  }
+  EXPECT_EQ(primes_count, 40);
+  EXPECT_TRUE(kManyPrimes.Contains(2));
+  EXPECT_TRUE(kManyPrimes.Contains(173));
+  EXPECT_FALSE(kManyPrimes.Contains(179));
+}
+
 /// [sample bidir bimap]
 enum class Colors { kRed, kOrange, kYellow, kGreen, kBlue, kViolet };
 enum ThirdPartyColor { kGreen, kBlue, kViolet, kRed, kOrange, kYellow };
@@ -12,6 +12,18 @@ std::string GenerateUuid() {
   return encoding::ToHex(val.begin(), val.size());
 }
 
+std::vector<std::string> GenerateUuids(std::size_t count) {
+  std::vector<std::string> result;
+  result.reserve(count);
+  for (const auto& val : GenerateBoostUuids(count)) {
+    auto& uuid =
+        result.emplace_back(encoding::LengthInHexForm(val.size()), '\0');
+    encoding::ToHexInto(
+        {reinterpret_cast<const char*>(val.begin()), val.size()}, uuid.data());
+  }
+  return result;
+}
+
 }  // namespace utils::generators
 
 USERVER_NAMESPACE_END
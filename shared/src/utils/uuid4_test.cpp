@@ -1,5 +1,7 @@
 #include <userver/utils/uuid4.hpp>
 
+#include <set>
+
 #include <gtest/gtest.h>
 
 USERVER_NAMESPACE_BEGIN
@@ -14,4 +16,19 @@ TEST(UUID, String) {
             utils::generators::GenerateUuid());
 }
 
+TEST(UUID, Batch) {
+  constexpr std::size_t kCount = 100;
+  const auto uuids = utils::generators::GenerateUuids(kCount);
+  ASSERT_EQ(uuids.size(), kCount);
+  EXPECT_EQ(std::set(uuids.begin(), uuids.end()).size(), kCount);
+
+  for (const auto& uuid : uuids) {
+    ASSERT_EQ(uuid.size(), 32);
+    EXPECT_EQ(uuid[12], '4');
+    EXPECT_NE(std::string{"89ab"}.find(uuid[16]), std::string::npos);
+  }
+
+  EXPECT_TRUE(utils::generators::GenerateUuids(0).empty());
+}
+
 USERVER_NAMESPACE_END
@@ -133,6 +133,28 @@ class MetricsSnapshot:
 
         return next(iter(entry)).value
 
+    def difference(self, before: 'MetricsSnapshot') -> 'MetricsSnapshot':
+        """
+        Returns the change of the metrics since the `before` snapshot: the
+        values of the metrics with the same path and labels are subtracted,
+        the metrics that are missing in `before` are taken as is.
+        """
+        result = {}
+        for path, metrics_set in self._values.items():
+            before_values = {
+                metric.get_labels_tuple(): metric.value
+                for metric in before.get(path, set())
+            }
+            result[path] = {
+                Metric(
+                    labels=metric.labels,
+                    value=metric.value
+                    - before_values.get(metric.get_labels_tuple(), 0),
+                )
+                for metric in metrics_set
+            }
+        return MetricsSnapshot(result)
+
     @staticmethod
     def from_json(json_str: str) -> 'MetricsSnapshot':
         """
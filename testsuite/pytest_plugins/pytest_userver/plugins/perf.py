@@ -0,0 +1,258 @@
+"""
+Performance mode of the testsuite: open-loop load generation against the
+service and the metrics of the scenarios.
+
+@ingroup userver_testsuite_fixtures
+"""
+
+# pylint: disable=redefined-outer-name
+import asyncio
+import dataclasses
+import math
+import typing
+
+import aiohttp
+import pytest
+
+from testsuite.utils import compat
+
+from pytest_userver import metrics as metric_module
+
+USERVER_CONFIG_HOOKS = ['userver_config_perf']
+
+_PERF_MARKER = 'perf'
+
+
+@dataclasses.dataclass(frozen=True)
+class LoadResult:
+    """
+    Result of a LoadGenerator run. Latencies are measured from the moment
+    the request was scheduled to be sent, so a slow service does not hide its
+    latency by slowing down the load (no coordinated omission).
+
+    @ingroup userver_testsuite
+    """
+
+    requests: int
+    errors: int
+    duration: float
+    latencies: typing.List[float]
+
+    @property
+    def rps(self) -> float:
+        """ Achieved requests per second """
+        return self.requests / self.duration if self.duration else 0.0
+
+    def percentile(self, percent: float) -> float:
+        """ Returns the latency percentile in seconds, `percent` in [0, 100] """
+        if not self.latencies:
+            return 0.0
+        index = math.ceil(len(self.latencies) * percent / 100) - 1
+        return self.latencies[min(max(index, 0), len(self.latencies) - 1)]
+
+
+class LoadGenerator:
+    """
+    Open-loop (wrk2-style) HTTP load generator: requests are sent at a fixed
+    rate regardless of the service response times, typically retrieved from
+    the @ref pytest_userver.plugins.perf.load_generator "load_generator"
+    fixture.
+
+    @ingroup userver_testsuite
+    """
+
+    def __init__(self, base_url: str):
+        self._base_url = base_url.rstrip('/')
+
+    async def run(
+            self,
+            path: str,
+            *,
+            rps: float,
+            duration: float,
+            method: str = 'GET',
+            connections: int = 64,
+            timeout: float = 10.0,
+            **request_kwargs,
+    ) -> LoadResult:
+        """
+        Sends `rps * duration` requests to `path` evenly spread over
+        `duration` seconds.
+
+        @param connections Maximum count of the concurrent connections, the
+               requests beyond it wait in the queue and their latency grows
+        @param timeout Request timeout in seconds, timed out requests are
+               counted as errors
+        @param request_kwargs Extra arguments for aiohttp request, e.g. `json`
+        """
+        assert rps > 0 and duration > 0, 'rps and duration must be positive'
+
+        url = f'{self._base_url}/{path.lstrip("/")}'
+        total = max(int(rps * duration), 1)
+        loop = asyncio.get_running_loop()
+        latencies: typing.List[float] = []
+        errors = 0
+
+        async def send(session, scheduled: float) -> None:
+            nonlocal errors
+            try:
+                async with session.request(
+                        method, url, **request_kwargs,
+                ) as response:
+                    await response.read()
+                    if response.status >= 500:
+                        errors += 1
+            except (aiohttp.ClientError, asyncio.TimeoutError):
+                errors += 1
+            latencies.append(loop.time() - scheduled)
+
+        async with aiohttp.ClientSession(
+                connector=aiohttp.TCPConnector(limit=connections),
+                timeout=aiohttp.ClientTimeout(total=timeout),
+        ) as session:
+            start = loop.time()
+            tasks = []
+            for i in range(total):
+                scheduled = start + i / rps
+                delay = scheduled - loop.time()
+                if delay > 0:
+                    await asyncio.sleep(delay)
+                tasks.append(asyncio.create_task(send(session, scheduled)))
+            await asyncio.gather(*tasks)
+            elapsed = loop.time() - start
+
+        return LoadResult(
+            requests=total,
+            errors=errors,
+            duration=elapsed,
+            latencies=sorted(latencies),
+        )
+
+
+@dataclasses.dataclass
+class PerfScenario:
+    """
+    Metrics of the service around a scenario, see
+    @ref pytest_userver.plugins.perf.perf_scenario "perf_scenario".
+
+    @ingroup userver_testsuite
+    """
+
+    metrics_before: metric_module.MetricsSnapshot
+    metrics_after: typing.Optional[metric_module.MetricsSnapshot] = None
+
+    @property
+    def metrics_diff(self) -> metric_module.MetricsSnapshot:
+        """ Returns the change of the metrics during the scenario """
+        assert self.metrics_after is not None, 'The scenario is not finished'
+        return self.metrics_after.difference(self.metrics_before)
+
+
+def pytest_addoption(parser) -> None:
+    group = parser.getgroup('userver')
+    group.addoption(
+        '--perf',
+        action='store_true',
+        help=(
+            'Run only the tests marked with @pytest.mark.perf, with the '
+            'service logging only warnings and errors and without the logs '
+            'capture.'
+        ),
+    )
+
+
+def pytest_configure(config) -> None:
+    config.addinivalue_line(
+        'markers',
+        f'{_PERF_MARKER}: performance test, runs only with --perf option',
+    )
+
+
+def pytest_collection_modifyitems(config, items) -> None:
+    perf_mode = config.option.perf
+    for item in items:
+        is_perf = item.get_closest_marker(_PERF_MARKER) is not None
+        if is_perf and not perf_mode:
+            item.add_marker(pytest.mark.skip(reason='requires --perf option'))
+        elif not is_perf and perf_mode:
+            item.add_marker(pytest.mark.skip(reason='not a perf test'))
+
+
+@pytest.fixture(scope='session')
+def userver_perf_mode(pytestconfig) -> bool:
+    """
+    Returns True if the tests run with the `--perf` option.
+
+    @ingroup userver_testsuite_fixtures
+    """
+    return pytestconfig.option.perf
+
+
+@pytest.fixture(scope='session')
+def userver_config_perf(userver_perf_mode):
+    """
+    Returns a function that adjusts the static configuration file for the
+    performance mode: the loggers write only warnings and errors and do not
+    duplicate the logs to the testsuite logs capture. Testpoints stay
+    configured, but are not enabled by the perf tests and cost nothing.
+
+    @ingroup userver_testsuite_fixtures
+    """
+
+    def _patch_config(config_yaml, config_vars):
+        if not userver_perf_mode:
+            return
+        components = config_yaml['components_manager']['components']
+        if 'logging' in components:
+            for logger in components['logging']['loggers'].values():
+                logger['level'] = 'warning'
+                logger.pop('testsuite-capture', None)
+        config_vars['logger_level'] = 'warning'
+
+    return _patch_config
+
+
+@pytest.fixture
+def load_generator(service_client, service_baseurl) -> LoadGenerator:
+    """
+    Returns a LoadGenerator for the main listener of the started service.
+
+    @code
+    @pytest.mark.perf
+    async def test_ping_load(load_generator):
+        result = await load_generator.run('/ping', rps=1000, duration=10)
+        assert result.errors == 0
+        assert result.percentile(99) < 0.05
+    @endcode
+
+    @ingroup userver_testsuite_fixtures
+    """
+    return LoadGenerator(service_baseurl)
+
+
+@pytest.fixture
+def perf_scenario(monitor_client):
+    """
+    Returns an async context manager that takes the service metrics before
+    and after the scenario.
+
+    @code
+    @pytest.mark.perf
+    async def test_ping_load(load_generator, perf_scenario):
+        async with perf_scenario(prefix='http') as scenario:
+            await load_generator.run('/ping', rps=1000, duration=10)
+        diff = scenario.metrics_diff
+    @endcode
+
+    @ingroup userver_testsuite_fixtures
+    """
+
+    @compat.asynccontextmanager
+    async def scenario(*, prefix: typing.Optional[str] = None):
+        result = PerfScenario(
+            metrics_before=await monitor_client.metrics(prefix=prefix),
+        )
+        yield result
+        result.metrics_after = await monitor_client.metrics(prefix=prefix)
+
+    return scenario
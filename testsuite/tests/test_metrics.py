@@ -171,3 +171,30 @@ def test_handmade_metrics_to_json():
         "tcp-echo.sockets.closed": [{"labels": {"label":"b"}, "value": 2}]
     }"""
     assert values == metrics.MetricsSnapshot.from_json(json)
+
+
+def test_metrics_difference():
+    before = metrics.MetricsSnapshot(
+        {
+            'requests': {
+                metrics.Metric(labels={'path': '/a'}, value=10),
+                metrics.Metric(labels={'path': '/b'}, value=5),
+            },
+        },
+    )
+    after = metrics.MetricsSnapshot(
+        {
+            'requests': {
+                metrics.Metric(labels={'path': '/a'}, value=15),
+                metrics.Metric(labels={'path': '/b'}, value=5),
+                metrics.Metric(labels={'path': '/c'}, value=2),
+            },
+            'errors': {metrics.Metric(labels={}, value=1)},
+        },
+    )
+
+    diff = after.difference(before)
+    assert diff.value_at('requests', {'path': '/a'}) == 5
+    assert diff.value_at('requests', {'path': '/b'}) == 0
+    assert diff.value_at('requests', {'path': '/c'}) == 2
+    assert diff.value_at('errors') == 1
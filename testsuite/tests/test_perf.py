@@ -0,0 +1,21 @@
+from pytest_userver.plugins import perf  # pylint: disable=import-error
+
+
+def test_load_result_percentile():
+    result = perf.LoadResult(
+        requests=10,
+        errors=0,
+        duration=2.0,
+        latencies=[i / 1000 for i in range(1, 11)],
+    )
+    assert result.rps == 5.0
+    assert result.percentile(0) == 0.001
+    assert result.percentile(50) == 0.005
+    assert result.percentile(90) == 0.009
+    assert result.percentile(100) == 0.010
+
+
+def test_load_result_empty():
+    result = perf.LoadResult(requests=0, errors=0, duration=0, latencies=[])
+    assert result.rps == 0.0
+    assert result.percentile(99) == 0.0
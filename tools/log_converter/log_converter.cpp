@@ -0,0 +1,124 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <logging/binary_format.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/logging/format.hpp>
+#include <userver/logging/level.hpp>
+#include <userver/utils/datetime.hpp>
+
+#include <userver/utest/using_namespace_userver.hpp>
+
+namespace {
+
+namespace binary = logging::impl::binary;
+
+struct Config {
+  std::string format = "tskv";
+  std::vector<std::string> files;
+};
+
+Config ParseConfig(int argc, char** argv) {
+  namespace po = boost::program_options;
+
+  Config config;
+  po::options_description desc(
+      "Converts the logs written in the 'binary' format to text.\n"
+      "Reads the standard input if no files are given.\n\n"
+      "Allowed options");
+  desc.add_options()("help,h", "produce help message")(
+      "format,f", po::value(&config.format)->default_value(config.format),
+      "output format: tskv, ltsv, raw or json")(
+      "files", po::value(&config.files), "binary log files to convert");
+
+  po::positional_options_description pos_desc;
+  pos_desc.add("files", -1);
+
+  po::variables_map vm;
+  try {
+    po::store(po::command_line_parser(argc, argv)
+                  .options(desc)
+                  .positional(pos_desc)
+                  .run(),
+              vm);
+    po::notify(vm);
+  } catch (const std::exception& ex) {
+    std::cerr << "Cannot parse command line: " << ex.what() << '\n';
+    exit(1);
+  }
+
+  if (vm.count("help")) {
+    std::cout << desc << '\n';
+    exit(0);
+  }
+
+  return config;
+}
+
+void RenderJson(const binary::Record& record, std::string& out) {
+  formats::json::ValueBuilder json(formats::json::Type::kObject);
+  json["timestamp"] = utils::datetime::LocalTimezoneTimestring(
+      record.timestamp, "%Y-%m-%dT%H:%M:%E6S");
+  json["level"] = logging::ToString(record.level);
+  for (const auto& field : record.fields) {
+    json[std::string{field.key}] = std::string{field.value};
+  }
+
+  out.append(formats::json::ToString(json.ExtractValue()));
+  out.push_back('\n');
+}
+
+void Convert(std::istream& in, const std::string& format) {
+  const bool is_json = format == "json";
+  const auto text_format =
+      is_json ? logging::Format::kTskv : logging::FormatFromString(format);
+
+  std::string buffer;
+  std::string line;
+  while (binary::ReadRecord(in, buffer)) {
+    const auto record = binary::ParseRecord(buffer);
+
+    line.clear();
+    if (is_json) {
+      RenderJson(record, line);
+    } else {
+      binary::RenderRecord(record, text_format, line);
+    }
+    std::cout << line;
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto config = ParseConfig(argc, argv);
+  if (config.format != "tskv" && config.format != "ltsv" &&
+      config.format != "raw" && config.format != "json") {
+    std::cerr << "Unknown output format '" << config.format << "'\n";
+    return 1;
+  }
+
+  try {
+    if (config.files.empty()) {
+      Convert(std::cin, config.format);
+    }
+
+    for (const auto& file : config.files) {
+      std::ifstream in(file, std::ios::binary);
+      if (!in) {
+        std::cerr << "Cannot open '" << file << "'\n";
+        return 1;
+      }
+      Convert(in, config.format);
+    }
+  } catch (const std::exception& ex) {
+    std::cerr << "Failed to convert the logs: " << ex.what() << '\n';
+    return 1;
+  }
+}